@@ -239,6 +239,7 @@ void BandMatrix<scalar_t>::lowerBandwidth(int64_t kl)
         this->kl_ = kl;
     else
         this->ku_ = kl;
+    this->growBand();
 }
 
 //------------------------------------------------------------------------------
@@ -258,6 +259,7 @@ void BandMatrix<scalar_t>::upperBandwidth(int64_t ku)
         this->ku_ = ku;
     else
         this->kl_ = ku;
+    this->growBand();
 }
 
 } // namespace slate
@@ -57,13 +57,26 @@ public:
     void    allocateBatchArrays(int64_t batch_size=0, int64_t num_arrays=1);
     void    reserveDeviceWorkspace();
 
+    void compactBand(bool compact = true);
+
+    /// @return whether broadcasts send only the band part of tiles.
+    bool bandCompacted() const
+    {
+        return this->storage_->bandCompacted();
+    }
+
     // sub-matrix
     Matrix<scalar_t> sub(int64_t i1, int64_t i2,
                          int64_t j1, int64_t j2);
 
     void tileUpdateAllOrigin();
 
+    using BaseMatrix<scalar_t>::tileLayoutReset;
+    void tileLayoutReset();
+
 protected:
+    void growBand();
+
     int64_t kl_, ku_;
 };
 
@@ -185,6 +198,51 @@ void swap(BaseBandMatrix<scalar_t>& A, BaseBandMatrix<scalar_t>& B)
     swap(A.ku_, B.ku_);
 }
 
+//------------------------------------------------------------------------------
+/// Enables or disables compact band transfers. When enabled, broadcasts
+/// of tiles that cross the edge of the band send only the part of the tile
+/// containing the band, and receivers set the rest of the tile to zero,
+/// which cuts the communication of gbmm, hbmm, gbtrf, pbtrf, tbsm, etc.,
+/// when the bandwidth is not a multiple of the tile size.
+/// Tiles keep their full storage; entries outside the band must be zero,
+/// as they are assumed to be.
+///
+/// Must be called on all ranks, on the whole matrix, not a view. Since it
+/// is a property of the storage, it applies to all views of the matrix.
+/// Do not enable it on a band view of a general matrix, since broadcasts
+/// of the general matrix would also drop entries outside the band.
+/// Increasing the bandwidth afterwards, e.g., for fill-in, widens the band
+/// sent.
+///
+template <typename scalar_t>
+void BaseBandMatrix<scalar_t>::compactBand(bool compact)
+{
+    if (compact) {
+        slate_assert( this->ioffset() == 0 && this->joffset() == 0
+                      && this->row0_offset() == 0
+                      && this->col0_offset() == 0 );
+        int64_t mt = (this->op() == Op::NoTrans ? this->mt() : this->nt());
+        int64_t nt = (this->op() == Op::NoTrans ? this->nt() : this->mt());
+        this->storage_->setBand( kl_, ku_, mt, nt );
+    }
+    else {
+        this->storage_->clearBand();
+    }
+}
+
+//------------------------------------------------------------------------------
+/// [internal]
+/// Widens the band of compact transfers to include this matrix's band,
+/// after its bandwidth changes.
+/// @see compactBand
+///
+template <typename scalar_t>
+void BaseBandMatrix<scalar_t>::growBand()
+{
+    if (this->storage_->bandCompacted() && this->ioffset() == this->joffset())
+        this->storage_->growBand( kl_, ku_ );
+}
+
 //------------------------------------------------------------------------------
 /// Returns sub-matrix that is a shallow copy view of the
 /// parent matrix, A[ i1:i2, j1:j2 ].
@@ -363,6 +421,69 @@ void BaseBandMatrix<scalar_t>::tileUpdateAllOrigin()
     }
 }
 
+//------------------------------------------------------------------------------
+/// Converts all origin tiles inside the band into current matrix-layout.
+/// This overrides BaseMatrix::tileLayoutReset, which visits all tiles,
+/// including those outside the band that do not exist.
+/// Operates in batch mode.
+///
+// todo: Assuming fixed size, square tiles for simplicity, should generalize
+template <typename scalar_t>
+void BaseBandMatrix<scalar_t>::tileLayoutReset()
+{
+    int64_t mt = this->mt();
+    int64_t nt = this->nt();
+    int64_t klt = ceildiv(
+            this->op() == Op::NoTrans ? this->kl_ : this->ku_, this->tileNb(0));
+    int64_t kut = ceildiv(
+            this->op() == Op::NoTrans ? this->ku_ : this->kl_, this->tileNb(0));
+
+    std::set<ij_tuple> tiles_set_host;
+    std::vector< std::set<ij_tuple> > tiles_set_dev(this->num_devices());
+
+    for (int64_t j = 0; j < nt; ++j) {
+        int64_t istart = blas::max( 0, j-kut );
+        int64_t iend   = blas::min( j+klt+1, mt );
+        for (int64_t i = istart; i < iend; ++i) {
+            if (this->tileIsLocal(i, j)) {
+                auto tile = this->tileUpdateOrigin(i, j);
+                if (tile.layout() != this->layout()) {
+                    assert(tile.isTransposable());
+                }
+
+                if (tile.device() == HostNum) {
+                    tiles_set_host.insert({i, j});
+                }
+                else {
+                    tiles_set_dev[tile.device()].insert({i, j});
+                }
+            }
+        }
+    }
+
+    #pragma omp taskgroup
+    {
+        if (! tiles_set_host.empty()) {
+            auto layout = this->layout();
+            #pragma omp task slate_omp_default_none \
+                firstprivate( layout ) shared( tiles_set_host )
+            {
+                this->tileLayoutReset( tiles_set_host, HostNum, layout );
+            }
+        }
+        for (int d = 0; d < this->num_devices(); ++d) {
+            if (! tiles_set_dev[d].empty()) {
+                auto layout = this->layout();
+                #pragma omp task slate_omp_default_none \
+                    firstprivate( d, layout ) shared( tiles_set_dev )
+                {
+                    this->tileLayoutReset( tiles_set_dev[d], d, layout );
+                }
+            }
+        }
+    }
+}
+
 } // namespace slate
 
 #endif // SLATE_BASE_BAND_MATRIX_HH
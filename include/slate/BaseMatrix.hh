@@ -21,7 +21,9 @@
 #include <algorithm>
 #include <memory>
 #include <set>
+#include <limits>
 #include <list>
+#include <map>
 #include <tuple>
 #include <utility>
 #include <vector>
@@ -125,6 +127,8 @@ public:
     template <typename out_scalar_t>
     BaseMatrix<out_scalar_t> baseEmptyLike(int64_t mb, int64_t nb, Op deepOp);
 
+    BaseMatrix<scalar_t> baseSnapshot();
+
 private:
     void initSubmatrix(
         int64_t i1, int64_t i2,
@@ -225,6 +229,9 @@ public:
         return storage_->tileIsLocal(globalIndex(i, j));
     }
 
+    void tileLocalRows( int64_t j, int64_t i_begin, int64_t i_end,
+                        int device, std::vector<int64_t>& rows ) const;
+
     /// Returns whether op(A) is logically Lower, Upper, or General.
     Uplo uplo() const { return uploLogical(); }
     Uplo uploLogical() const;
@@ -361,6 +368,20 @@ public:
 
     void tileGetForReading(std::set<ij_tuple>& tile_set, int device, LayoutConvert layout);
 
+    TileGetToken tileGetForReadingAsync(
+        int64_t i, int64_t j, int device, LayoutConvert layout );
+
+    TileGetToken tileGetForReadingAsync(
+        std::set<ij_tuple>& tile_set, int device, LayoutConvert layout );
+
+    /// Queues copies of a set of tiles to device for reading, without
+    /// layout conversion, to overlap the transfer with other work.
+    /// @see tileGetForReadingAsync
+    TileGetToken tilePrefetch( std::set<ij_tuple>& tile_set, int device )
+    {
+        return tileGetForReadingAsync( tile_set, device, LayoutConvert::None );
+    }
+
     /// Gets tile(i, j) for reading on host.
     /// @see tileGetForReading
     void tileGetForReading(int64_t i, int64_t j, LayoutConvert layout)
@@ -478,6 +499,56 @@ public:
         storage_->tileDecrementReceiveCount( globalIndex( i, j ), release_count );
     }
 
+    /// Enables or disables tracking of structurally zero tiles,
+    /// which broadcasts and gemm-based updates then skip.
+    /// Must be called on all ranks; disabling forgets which tiles are zero.
+    /// Zero tiles are known on all ranks, including remote tiles. They are
+    /// maintained by set, copy, and the internal gemm and herk updates,
+    /// which track fill-in; other routines that fill zero tiles,
+    /// e.g., with row pivoting, require disabling tracking first.
+    void trackZeroTiles(bool track = true)
+    {
+        storage_->trackZeroTiles( track );
+    }
+
+    /// @return whether structurally zero tiles are tracked.
+    bool zeroTilesTracked() const
+    {
+        return storage_->zeroTilesTracked();
+    }
+
+    /// @return whether tile {i, j} of op(A) is marked as structurally zero.
+    bool tileIsZero(int64_t i, int64_t j) const
+    {
+        return storage_->tileIsZero( globalIndex( i, j ) );
+    }
+
+    /// Marks tile {i, j} of op(A) as structurally zero, or not.
+    /// Must be called on all ranks, for local and remote tiles alike.
+    /// Marking a tile does not change its data: a zero tile must hold zeros,
+    /// e.g., from set. Marking a tile as zero enables tracking.
+    void tileSetZero(int64_t i, int64_t j, bool is_zero = true)
+    {
+        storage_->tileSetZero( globalIndex( i, j ), is_zero );
+    }
+
+    /// @return whether local tile {i, j} of op(A) is a lazy zero tile,
+    /// not yet allocated. @see Matrix::insertLocalTilesZero
+    bool tileIsLazyZero(int64_t i, int64_t j) const
+    {
+        return storage_->tileIsLazyZero( globalIndex( i, j ) );
+    }
+
+    void tileMaterialize(int64_t i, int64_t j, bool fill_zero = true);
+
+    /// @return whether local tile {i, j} of op(A) still shares its data
+    /// with a copy-on-write snapshot or the matrix it is a snapshot of.
+    /// @see baseSnapshot
+    bool tileIsCowShared(int64_t i, int64_t j) const
+    {
+        return storage_->tileIsCowShared( globalIndex( i, j ) );
+    }
+
     void tileErase( int64_t i, int64_t j, int device=HostNum );
 
     void tileRelease( int64_t i, int64_t j, int device=HostNum );
@@ -495,6 +566,8 @@ public:
     void tileIsend(int64_t i, int64_t j, int dst_rank,
                    int tag, MPI_Request* request);
 
+    int tileSourceDevice(int64_t i, int64_t j);
+
     template <Target target = Target::Host>
     void tileRecv(int64_t i, int64_t j, int dst_rank,
                   Layout layout, int tag = 0);
@@ -503,6 +576,27 @@ public:
     void tileIrecv(int64_t i, int64_t j, int dst_rank,
                   Layout layout, int tag, MPI_Request* request);
 
+    // One-sided access: ranks fetch remote tiles with MPI_Get,
+    // without the owners taking part.
+    void rmaOpen();
+    void rmaClose();
+    void tileGetRemote(int64_t i, int64_t j);
+
+    /// @return whether an RMA window is open; @see rmaOpen.
+    bool rmaActive() const
+    {
+        return storage_->rmaActive();
+    }
+
+    void compressTransfers(Compression compression, double tol = 0);
+
+    /// @return compression of tiles sent by listBcast;
+    /// @see compressTransfers.
+    Compression transferCompression() const
+    {
+        return storage_->compression();
+    }
+
     template <Target target = Target::Host>
     void tileBcast(int64_t i, int64_t j, BaseMatrix const& B,
                    Layout layout, int tag = 0);
@@ -541,6 +635,21 @@ public:
         listBcastMT( bcast_list, layout, is_shared );
     }
 
+    // These variants pack all tiles with the same root and set of ranks
+    // into one message per hop, instead of one message per tile,
+    // and optionally send them in a lower precision.
+    template <Target target = Target::Host>
+    void listBcastPacked( BcastList& bcast_list, Layout layout, int tag = 0,
+                          bool is_shared = false,
+                          BcastPrecision precision = BcastPrecision::Native,
+                          bool partitioned = false );
+
+    template <Target target = Target::Host>
+    void listBcastPacked( BcastListTag& bcast_list, Layout layout,
+                          bool is_shared = false,
+                          BcastPrecision precision = BcastPrecision::Native,
+                          bool partitioned = false );
+
     template <Target target = Target::Host>
     void listReduce(ReduceList& reduce_list, Layout layout, int tag = 0);
 
@@ -607,11 +716,18 @@ protected:
     void tileBcastToSet(int64_t i, int64_t j, std::set<int> const& bcast_set);
     void tileBcastToSet(int64_t i, int64_t j, std::set<int> const& bcast_set,
                         int radix, int tag, Layout layout,
-                        Target target);
+                        Target target, int64_t segment_bytes = -1);
     void tileIbcastToSet(int64_t i, int64_t j, std::set<int> const& bcast_set,
                         int radix, int tag, Layout layout,
                         std::vector<MPI_Request>& send_requests,
-                        Target target);
+                        Target target, int64_t segment_bytes = -1);
+    bool tileBcastPattern(int64_t i, int64_t j, std::set<int> const& bcast_set,
+                          int radix, std::vector<int>& new_vec,
+                          std::list<int>& recv_from, std::list<int>& send_to);
+    int tileStagingDevice(int64_t i, int64_t j, Layout layout);
+
+    bool tileBandPart(int64_t i, int64_t j, int device, Tile<scalar_t>* part);
+    void tileBandZero(int64_t i, int64_t j, int device);
 
 public:
     // todo: should this be private?
@@ -627,6 +743,26 @@ public:
     int       mpiRank()  const { return mpi_rank_; }
     MPI_Group mpiGroup() const { return mpi_group_; }
 
+    /// [internal]
+    /// Makes this matrix a non-owning view of its storage: it still shares
+    /// the tiles with its parent, but holds no reference on the storage.
+    /// Copies and sub-matrices of it then don't update the atomic reference
+    /// count, which threads creating many sub-matrices contend on.
+    /// The caller must ensure an owning matrix outlives this one and all
+    /// matrices derived from it.
+    /// @see internal::nonowning_view
+    void dropStorageOwnership()
+    {
+        storage_ = std::shared_ptr< MatrixStorage<scalar_t> >(
+            std::shared_ptr< MatrixStorage<scalar_t> >(), storage_.get() );
+    }
+
+    /// @return whether this matrix holds a reference on its storage.
+    bool ownsStorage() const
+    {
+        return storage_.use_count() > 0;
+    }
+
     /// Removes all tiles from matrix.
     /// WARNING: currently this clears the entire parent matrix,
     /// not just a sub-matrix.
@@ -646,6 +782,102 @@ public:
         storage_->releaseWorkspace();
     }
 
+    /// Uses device memory as a cache of at most about num_tiles tiles per
+    /// device, evicting least-recently-used tiles when it is full.
+    /// @see MatrixStorage::enableTileCache
+    void enableTileCache( int64_t num_tiles )
+    {
+        storage_->enableTileCache( num_tiles );
+    }
+
+    /// Stops using device memory as a tile cache.
+    void disableTileCache()
+    {
+        storage_->disableTileCache();
+    }
+
+    /// Pins tiles on device, so the tile cache doesn't evict them while
+    /// kernels use them. Call before getting the tiles on the device.
+    /// @see MatrixStorage::tileCachePin
+    void tileCachePin( std::set<ij_tuple> const& tile_set, int device )
+    {
+        for (auto ij : tile_set)
+            storage_->tileCachePin(
+                globalIndex( std::get<0>( ij ), std::get<1>( ij ) ), device );
+    }
+
+    /// Releases pins from tileCachePin, after the kernels have finished.
+    void tileCacheUnpin( std::set<ij_tuple> const& tile_set, int device )
+    {
+        for (auto ij : tile_set)
+            storage_->tileCacheUnpin(
+                globalIndex( std::get<0>( ij ), std::get<1>( ij ) ), device );
+    }
+
+    /// @return tile cache hit, miss, eviction, and write-back counters
+    /// on device.
+    TileCacheStats tileCacheStats( int device )
+    {
+        return storage_->tileCacheStats( device );
+    }
+
+    /// @return MOSI coherence counters of this matrix's storage, shared
+    /// with matrices derived from it: tileGet hits, tiles copied to device
+    /// and to host, layout conversions, and invalidations by tileModified.
+    /// All zero unless SLATE is compiled with SLATE_COHERENCE_COUNTERS.
+    CoherenceStats coherenceStats() const
+    {
+        return storage_->coherenceStats();
+    }
+
+    /// Resets MOSI coherence counters of this matrix's storage.
+    void coherenceResetStats()
+    {
+        storage_->coherenceResetStats();
+    }
+
+    /// @return current and peak memory use on device, which can be host,
+    /// for this matrix's storage, shared with matrices derived from it.
+    /// For memory summed over all matrices, use Memory::totalStats.
+    MemoryStats memoryStats( int device ) const
+    {
+        return storage_->memoryStats( device );
+    }
+
+    /// Resets high-water marks of this matrix's memory on device.
+    void resetMemoryPeak( int device )
+    {
+        storage_->resetMemoryPeak( device );
+    }
+
+    void tilePrefetchMapped( int64_t i, int64_t j );
+    void tileFlushMapped( int64_t i, int64_t j );
+    void prefetchMapped();
+    void flushMapped();
+
+    /// Writes all memory-mapped origin tiles back to their files,
+    /// waiting for completion.
+    void syncMapped()
+    {
+        storage_->syncMappedFiles();
+    }
+
+    /// @return start of the contiguous host arena holding this rank's
+    /// origin tiles, in column-major ScaLAPACK order, or nullptr if tiles
+    /// were not inserted with Option::HostTileArena.
+    /// Shared with matrices derived from this one.
+    scalar_t* arenaData() const
+    {
+        return storage_->arenaData();
+    }
+
+    /// @return leading dimension of the host arena.
+    /// @see arenaData
+    int64_t arenaStride() const
+    {
+        return storage_->arenaStride();
+    }
+
     void releaseLocalWorkspaceTile( int64_t i, int64_t j );
     void releaseLocalWorkspace();
     void releaseLocalWorkspace( std::set<ij_tuple>& tile_set );
@@ -662,6 +894,49 @@ public:
         storage_->clearWorkspace();
     }
 
+    /// Opens a workspace session on the matrix, shared with matrices
+    /// derived from it. In a session, remote tiles received by broadcasts
+    /// stay valid on the receiving ranks across routines, e.g.,
+    /// potrf, potrs, then gemm on the same A, and later broadcasts of them
+    /// skip those ranks. Sessions nest; tiles are kept until the outermost
+    /// session ends.
+    ///
+    /// Tiles of the matrix must not be modified after they are broadcast
+    /// in the session, which holds for factors used read-only. Routines
+    /// overwriting the matrix, such as potrf and getrf, forget what was
+    /// broadcast before them; otherwise, call invalidateWorkspaceSession
+    /// after modifying the matrix.
+    ///
+    /// Collective: all ranks of the matrix must call the session routines,
+    /// in the same order with respect to SLATE routines on the matrix.
+    ///
+    void beginWorkspaceSession()
+    {
+        storage_->sessionBegin();
+    }
+
+    /// Closes a workspace session. Closing the outermost session releases
+    /// the remote tiles it kept. @see beginWorkspaceSession
+    void endWorkspaceSession()
+    {
+        storage_->sessionEnd();
+    }
+
+    /// Releases the remote tiles kept by the workspace session, which stays
+    /// open, for when the matrix was modified. No-op without a session.
+    /// @see beginWorkspaceSession
+    void invalidateWorkspaceSession()
+    {
+        if (storage_->sessionActive())
+            storage_->sessionClear();
+    }
+
+    /// @return whether a workspace session is open on the matrix.
+    bool workspaceSessionActive() const
+    {
+        return storage_->sessionActive();
+    }
+
     /// Allocates batch arrays and BLAS++ queues for all devices.
     /// Matrix classes override this with versions that can also allocate based
     /// on the number of local tiles.
@@ -687,6 +962,63 @@ public:
         storage_->clearBatchArrays();
     }
 
+    /// Sets the stream priorities of the compute queues. With
+    /// QueuePriority::Lookahead, queues [high_begin, high_end), used by the
+    /// panel and lookahead updates, have high priority, so their kernels
+    /// preempt the trailing update; the rest have default priority.
+    /// Allocate the queues with allocateBatchArrays first.
+    /// WARNING: this sets the queues of the entire parent matrix.
+    void setComputeQueuePriorities(
+        QueuePriority mapping, int high_begin, int high_end )
+    {
+        int num_queues = storage_->num_compute_queues();
+        for (int queue_index = 0; queue_index < num_queues; ++queue_index) {
+            storage_->setComputeQueuePriority(
+                queue_index,
+                mapping == QueuePriority::Lookahead
+                && high_begin <= queue_index && queue_index < high_end );
+        }
+    }
+
+    /// Sets the compute mode of compute queues [begin, end), used by
+    /// the updates that accept lower accuracy; other queues are unchanged.
+    /// On devices, allocate the queues with allocateBatchArrays first;
+    /// host tasks read the mode of their queue_index with computePrecision.
+    /// Drivers restore ComputePrecision::Native on their queues before
+    /// returning.
+    /// WARNING: this sets the queues of the entire parent matrix.
+    void setComputePrecisions(
+        ComputePrecision precision, int begin, int end )
+    {
+        for (int queue_index = begin; queue_index < end; ++queue_index)
+            storage_->setComputeQueuePrecision( queue_index, precision );
+    }
+
+    /// @return compute mode of compute queues queue_index, e.g., to select
+    /// the 3M algorithm in host tasks (@see ComputePrecision).
+    ComputePrecision computePrecision( int64_t queue_index )
+    {
+        return storage_->computeQueuePrecision( queue_index );
+    }
+
+    /// Sets whether the batched gemm and herk updates on devices balance
+    /// the local tiles of each batch across the devices, instead of
+    /// updating each tile on its tileDevice (@see Option::DeviceStealing).
+    /// Tiles updated on another device are moved there by the MOSI
+    /// protocol, with peer copies where available.
+    /// Drivers restore false before returning.
+    /// WARNING: this sets the mode of the entire parent matrix.
+    void setDeviceStealing( bool stealing )
+    {
+        storage_->setDeviceStealing( stealing );
+    }
+
+    /// @return whether batched updates balance tiles across devices.
+    bool deviceStealing() const
+    {
+        return storage_->deviceStealing();
+    }
+
     /// @return currently allocated batch array size
     int64_t batchArraySize()
     {
@@ -707,6 +1039,35 @@ public:
         return storage_->batchArrayDevice( device, batch_arrays_index );
     }
 
+    //--------------------------------------------------------------------------
+    /// @return batch dimensions array on host, to send to device,
+    /// for variable-size batches
+    int64_t* dims_host(int device, int64_t batch_arrays_index=0)
+    {
+        return storage_->batchDimsHost( device, batch_arrays_index );
+    }
+
+    //--------------------------------------------------------------------------
+    /// @return batch dimensions array on device
+    int64_t* dims_device(int device, int64_t batch_arrays_index=0)
+    {
+        return storage_->batchDimsDevice( device, batch_arrays_index );
+    }
+
+    //--------------------------------------------------------------------------
+    /// Copies count pointers from src to the batch array on device,
+    /// unless they are unchanged since the last upload.
+    /// @see MatrixStorage::batchArrayUpload
+    /// @return true if the copy was queued.
+    bool batchArrayUpload(
+        int device, int64_t batch_arrays_index,
+        scalar_t* const* src, int64_t count, blas::Queue& queue,
+        int64_t offset = 0 )
+    {
+        return storage_->batchArrayUpload(
+            device, batch_arrays_index, src, count, queue, offset );
+    }
+
     //--------------------------------------------------------------------------
     /// @return BLAS++ communication queues
     ///
@@ -740,6 +1101,21 @@ public:
         return storage_->num_compute_queues();
     }
 
+    //--------------------------------------------------------------------------
+    /// @return whether B is the same view as this matrix:
+    /// the same region of the same tiles, with the same op.
+    ///
+    bool sameView( BaseMatrix const& B ) const
+    {
+        return storage_ == B.storage_
+               && op_ == B.op_
+               && ioffset_ == B.ioffset_ && joffset_ == B.joffset_
+               && mt_ == B.mt_ && nt_ == B.nt_
+               && row0_offset_ == B.row0_offset_
+               && col0_offset_ == B.col0_offset_
+               && last_mb_ == B.last_mb_ && last_nb_ == B.last_nb_;
+    }
+
 protected:
     std::tuple<int64_t, int64_t>
         globalIndex(int64_t i, int64_t j) const;
@@ -765,6 +1141,9 @@ protected:
     /// block col offset with respect to original matrix
     int64_t joffset() const { return joffset_; }
 
+    void firstTouchHostTiles( std::vector<ij_tuple> const& tiles );
+    void insertHostTilesArena( std::vector<ij_tuple> const& tiles );
+
 private:
     //--------------------------------------------------------------------------
     int64_t row0_offset_;  ///< row offset in first block row
@@ -928,6 +1307,11 @@ BaseMatrix<scalar_t>::BaseMatrix(
         MPI_Comm_rank(mpi_comm_, &mpi_rank_));
     slate_mpi_call(
         MPI_Comm_group(mpi_comm_, &mpi_group_));
+
+    // Node topology and NCCL/RCCL communicators for broadcasts;
+    // collective on first use of mpi_comm.
+    internal::commInitNodes( mpi_comm_ );
+    internal::commInitNccl( mpi_comm_, num_devices() );
 }
 
 //------------------------------------------------------------------------------
@@ -991,6 +1375,11 @@ BaseMatrix<scalar_t>::BaseMatrix(
         MPI_Comm_rank(mpi_comm_, &mpi_rank_));
     slate_mpi_call(
         MPI_Comm_group(mpi_comm_, &mpi_group_));
+
+    // Node topology and NCCL/RCCL communicators for broadcasts;
+    // collective on first use of mpi_comm.
+    internal::commInitNodes( mpi_comm_ );
+    internal::commInitNccl( mpi_comm_, num_devices() );
 }
 
 //------------------------------------------------------------------------------
@@ -1288,6 +1677,49 @@ BaseMatrix<out_scalar_t> BaseMatrix<scalar_t>::baseEmptyLike(
     return B;
 }
 
+//------------------------------------------------------------------------------
+/// [internal]
+/// Returns a copy-on-write snapshot with the same structure as this matrix,
+/// whose local origin tiles share the data of this matrix's origin tiles.
+/// Before a tile is first written on either side, e.g., by
+/// tileGetForWriting, tileModified, or a layout conversion, the snapshot's
+/// tile gets its own copy, allocated by SLATE, so the snapshot keeps the
+/// values from when it was taken, and memory grows only with the tiles
+/// that are changed. Tiles modified by writing their data directly, without
+/// marking them modified, e.g., in the user's array, are not detected.
+/// @see Matrix::snapshot
+///
+template <typename scalar_t>
+BaseMatrix<scalar_t> BaseMatrix<scalar_t>::baseSnapshot()
+{
+    auto B = this->template baseEmptyLike<scalar_t>( 0, 0, Op::NoTrans );
+    if (B.m() != this->m() || B.n() != this->n())
+        slate_not_implemented( "snapshot of a sliced matrix" );
+    B.origin_ = origin_;
+
+    for (int64_t j = 0; j < nt(); ++j) {
+        for (int64_t i = 0; i < mt(); ++i) {
+            if (! tileIsLocal( i, j ))
+                continue;
+
+            // Share an up-to-date origin in the matrix layout.
+            Tile<scalar_t> T = tileUpdateOrigin( i, j );
+            int device = T.device();
+            if (T.layout() != layout() || T.extended()) {
+                tileLayoutReset( i, j, device, layout() );
+                T = *storage_->at( globalIndex( i, j, device ) );
+            }
+
+            B.storage_->tileInsert( B.globalIndex( i, j, device ),
+                                    T.data(), T.stride(), T.layout() );
+            B.storage_->tileShareCow( B.globalIndex( i, j ), device );
+            storage_->tileAddCowSnapshot( globalIndex( i, j ), B.storage_,
+                                          B.globalIndex( i, j ) );
+        }
+    }
+    return B;
+}
+
 //------------------------------------------------------------------------------
 /// Swap contents of matrices A and B.
 template <typename scalar_t>
@@ -1382,6 +1814,8 @@ template <typename scalar_t>
 Tile<scalar_t> BaseMatrix<scalar_t>::operator()(
     int64_t i, int64_t j, int device)
 {
+    if (storage_->hasLazyZeroTiles())
+        tileMaterialize( i, j );
     if (op_ != Op::NoTrans) {
         std::swap( i, j );
     }
@@ -1428,6 +1862,33 @@ Uplo BaseMatrix<scalar_t>::uploLogical() const
         return Uplo::Upper;
 }
 
+//------------------------------------------------------------------------------
+/// [internal]
+/// Appends to rows the block rows i in [ i_begin, i_end ) of block column j
+/// of op(A) whose tiles are local and on device, in ascending order.
+/// If op(A) is not transposed, uses the storage's cached local rows (see
+/// MatrixStorage::tileLocalRows); otherwise, checks each tile.
+///
+template <typename scalar_t>
+void BaseMatrix<scalar_t>::tileLocalRows(
+    int64_t j, int64_t i_begin, int64_t i_end,
+    int device, std::vector<int64_t>& rows ) const
+{
+    if (op_ == Op::NoTrans) {
+        size_t first = rows.size();
+        storage_->tileLocalRows( device, joffset_ + j, ioffset_ + i_begin,
+                                 ioffset_ + i_end, rows );
+        for (size_t k = first; k < rows.size(); ++k)
+            rows[ k ] -= ioffset_;
+    }
+    else {
+        for (int64_t i = i_begin; i < i_end; ++i) {
+            if (tileIsLocal( i, j ) && tileDevice( i, j ) == device)
+                rows.push_back( i );
+        }
+    }
+}
+
 //------------------------------------------------------------------------------
 /// Returns whether A is physically Lower, Upper, or General storage,
 /// ignoring the transposition operation.
@@ -1633,6 +2094,10 @@ Tile<scalar_t> BaseMatrix<scalar_t>::tileInsert(
 template <typename scalar_t>
 void BaseMatrix<scalar_t>::tileErase(int64_t i, int64_t j, int device)
 {
+    // Snapshots sharing the origin copy it before it is freed.
+    if (storage_->hasCowTiles() && tileIsLocal( i, j ))
+        storage_->tileCowDetach( globalIndex( i, j ) );
+
     if (device == AllDevices) {
         storage_->erase(globalIndex(i, j));
     }
@@ -1718,6 +2183,8 @@ void BaseMatrix<scalar_t>::tileUnsetHoldAllOnDevices()
 template <typename scalar_t>
 void BaseMatrix<scalar_t>::tileModified(int64_t i, int64_t j, int device, bool permissive)
 {
+    storage_->tileCowDetach( globalIndex( i, j ) );
+
     auto& tile_node = storage_->at(globalIndex(i, j));
 
     LockGuard guard(tile_node.getLock());
@@ -1735,6 +2202,7 @@ void BaseMatrix<scalar_t>::tileModified(int64_t i, int64_t j, int device, bool p
             if (! permissive)
                 slate_assert(tile_node[d]->stateOn(MOSI::Modified) == false);
             tile_node[d]->state(MOSI::Invalid);
+            storage_->coherenceCount( CoherenceEvent::Invalidation );
         }
     }
 }
@@ -1764,7 +2232,46 @@ void BaseMatrix<scalar_t>::tileSend(
 {
     MPI_Request request;
     tileIsend( i, j, dst_rank, tag, &request );
-    slate_mpi_call( MPI_Wait( &request, MPI_STATUS_IGNORE ) );
+    internal::wait( &request );
+}
+
+//------------------------------------------------------------------------------
+/// Returns the device to send tile {i, j} of op(A) from, which can be host.
+/// The host is used if it has a valid (Modified or Shared) instance.
+/// Otherwise, with GPU-aware MPI, a device with a valid instance is used,
+/// so the tile is sent without a copy to host. Without GPU-aware MPI, the
+/// host is used and the tile's bytes are counted in
+/// internal::hostStagedBytes, as they must be copied to host to be sent.
+///
+/// @param[in] i
+///     Tile's block row index. 0 <= i < mt.
+///
+/// @param[in] j
+///     Tile's block column index. 0 <= j < nt.
+///
+template <typename scalar_t>
+int BaseMatrix<scalar_t>::tileSourceDevice(int64_t i, int64_t j)
+{
+    auto& tile_node = storage_->at(globalIndex(i, j));
+    // acquire read access to the (i, j) TileNode
+    LockGuard guard(tile_node.getLock());
+
+    if (tile_node.existsOn(HostNum)
+        && tile_node[HostNum]->state() != MOSI::Invalid) {
+        return HostNum;
+    }
+    // find a valid source (Modified/Shared) tile
+    for (int d = 0; d < num_devices(); ++d) {
+        if (tile_node.existsOn(d)
+            && tile_node[d]->state() != MOSI::Invalid) {
+            if (gpu_aware_mpi())
+                return d;
+            internal::addHostStagedBytes(
+                tileMb(i) * tileNb(j) * sizeof(scalar_t) );
+            break;
+        }
+    }
+    return HostNum;
 }
 
 //------------------------------------------------------------------------------
@@ -1796,24 +2303,8 @@ void BaseMatrix<scalar_t>::tileIsend(
     if (dst_rank != mpiRank()) {
         //todo: need to acquire read access lock to TileNode(i, j)
 
-        int send_dev = HostNum;
-        if (gpu_aware_mpi()) {
-            // If we have GPU aware MPI, we can use any existing valid tile
-            auto& tile_node = storage_->at(globalIndex(i, j));
-            // acquire read access to the (i, j) TileNode
-            LockGuard guard(tile_node.getLock());
-
-            // find a valid source (Modified/Shared) tile
-            for (int d = HostNum; d < num_devices(); ++d) {
-                if (tile_node.existsOn(d)) {
-                    if (tile_node[d]->state() != MOSI::Invalid) {
-                        send_dev = d;
-                        break;
-                    }
-                }
-            }
-        }
-        else {
+        int send_dev = tileSourceDevice( i, j );
+        if (send_dev == HostNum) {
             tileGetForReading(i, j, LayoutConvert::None);
         }
 
@@ -1912,8 +2403,12 @@ void BaseMatrix<scalar_t>::tileIrecv(
 {
     if (src_rank != mpiRank()) {
         int recv_dev = HostNum;
-        if (target == Target::Devices && gpu_aware_mpi()) {
-            recv_dev = tileDevice( i, j );
+        if (target == Target::Devices) {
+            if (gpu_aware_mpi())
+                recv_dev = tileDevice( i, j );
+            else
+                internal::addHostStagedBytes(
+                    tileMb(i) * tileNb(j) * sizeof(scalar_t) );
         }
 
         storage_->tilePrepareToReceive( globalIndex( i, j ), recv_dev, layout );
@@ -1931,6 +2426,195 @@ void BaseMatrix<scalar_t>::tileIrecv(
     }
 }
 
+//------------------------------------------------------------------------------
+/// Opens an MPI RMA window exposing the local host tiles of the matrix,
+/// so any rank can then fetch remote tiles with tileGetRemote(), without
+/// matching sends on the owners. This suits irregular access patterns,
+/// where setting up matching sends and receives is awkward.
+///
+/// Local tiles are first brought to host in column-major layout. While the
+/// window is open, they must not be erased, reallocated, or converted;
+/// writing to them must be separated from remote reads by a
+/// synchronization, e.g., MPI_Barrier. The window is shared with
+/// sub-matrices of the matrix, which can fetch the tiles of the matrix
+/// it was opened on.
+///
+/// Collective: all ranks of the matrix must call it. Call rmaClose()
+/// before the matrix is destroyed.
+///
+template <typename scalar_t>
+void BaseMatrix<scalar_t>::rmaOpen()
+{
+    slate_assert( ! storage_->rmaActive() );
+    trace::Block trace_block( "rmaOpen" );
+
+    MPI_Win win;
+    slate_mpi_call(
+        MPI_Win_create_dynamic( MPI_INFO_NULL, mpiComm(), &win ) );
+
+    // Address and stride of each tile, set by its owner;
+    // the all-reduce then gives every rank all of them.
+    std::vector<int64_t> table( 2*mt()*nt(), 0 );
+    std::vector<void*> attached;
+    for (int64_t j = 0; j < nt(); ++j) {
+        for (int64_t i = 0; i < mt(); ++i) {
+            if (! tileIsLocal( i, j ) || ! tileExists( i, j, AnyDevice ))
+                continue;
+            tileGetForReading( i, j, HostNum, LayoutConvert::ColMajor );
+            auto T = at( i, j, HostNum );
+            T.op( Op::NoTrans );  // use the stored dimensions
+            MPI_Aint size = T.stride() * (T.nb() - 1) + T.mb();
+            slate_mpi_call(
+                MPI_Win_attach( win, T.data(), size * sizeof(scalar_t) ) );
+            attached.push_back( T.data() );
+
+            MPI_Aint address;
+            slate_mpi_call( MPI_Get_address( T.data(), &address ) );
+            table[ 2*(i + j*mt()) ]     = int64_t( address );
+            table[ 2*(i + j*mt()) + 1 ] = T.stride();
+        }
+    }
+    slate_mpi_call(
+        MPI_Allreduce( MPI_IN_PLACE, table.data(), table.size(),
+                       MPI_INT64_T, MPI_SUM, mpiComm() ) );
+
+    std::map< ij_tuple, typename MatrixStorage<scalar_t>::RmaTile > tiles;
+    for (int64_t j = 0; j < nt(); ++j) {
+        for (int64_t i = 0; i < mt(); ++i) {
+            int64_t stride = table[ 2*(i + j*mt()) + 1 ];
+            if (stride > 0) {
+                tiles[ globalIndex( i, j ) ]
+                    = { MPI_Aint( table[ 2*(i + j*mt()) ] ), stride };
+            }
+        }
+    }
+
+    // One passive target epoch for the life of the window.
+    slate_mpi_call( MPI_Win_lock_all( MPI_MODE_NOCHECK, win ) );
+    storage_->rmaSet( win, std::move( attached ), std::move( tiles ) );
+}
+
+//------------------------------------------------------------------------------
+/// Closes the RMA window opened by rmaOpen(). Tiles fetched by
+/// tileGetRemote() stay as workspace tiles, as received tiles do.
+///
+/// Collective: all ranks of the matrix must call it, once they are done
+/// fetching tiles.
+///
+template <typename scalar_t>
+void BaseMatrix<scalar_t>::rmaClose()
+{
+    slate_assert( storage_->rmaActive() );
+
+    std::vector<void*> attached;
+    MPI_Win win = storage_->rmaReset( &attached );
+    slate_mpi_call( MPI_Win_unlock_all( win ) );
+    // Owners must not detach memory others may still read.
+    slate_mpi_call( MPI_Barrier( mpiComm() ) );
+    for (void* data : attached)
+        slate_mpi_call( MPI_Win_detach( win, data ) );
+    slate_mpi_call( MPI_Win_free( &win ) );
+}
+
+//------------------------------------------------------------------------------
+/// Fetches tile {i, j} of op(A) from its owner into a host workspace tile,
+/// with a passive target MPI_Get on the window opened by rmaOpen().
+/// The owner doesn't take part, so ranks can fetch tiles in any order.
+/// If the tile is local, this is a no-op. Blocks until the tile arrived.
+///
+/// Tiles are fetched to host, even with GPU-aware MPI, since only host
+/// tiles are exposed in the window.
+///
+/// @param[in] i
+///     Tile's block row index. 0 <= i < mt.
+///
+/// @param[in] j
+///     Tile's block column index. 0 <= j < nt.
+///
+template <typename scalar_t>
+void BaseMatrix<scalar_t>::tileGetRemote(int64_t i, int64_t j)
+{
+    slate_assert( storage_->rmaActive() );
+
+    int src_rank = tileRank( i, j );
+    if (src_rank == mpiRank())
+        return;
+
+    auto remote = storage_->rmaTile( globalIndex( i, j ) );
+    slate_assert( remote != nullptr );
+
+    trace::Block trace_block( "MPI_Get" );
+    storage_->tilePrepareToReceive( globalIndex( i, j ), HostNum,
+                                    Layout::ColMajor );
+    tileAcquire( i, j, HostNum, Layout::ColMajor );
+    auto T = at( i, j, HostNum );
+    T.op( Op::NoTrans );  // use the stored dimensions
+    internal::count( internal::Count::BytesRecv,
+                     T.mb() * T.nb() * sizeof(scalar_t) );
+
+    bool origin_cached, target_cached;
+    MPI_Datatype origin_type = internal::vectorType(
+        T.nb(), T.mb(), T.stride(), mpi_type<scalar_t>::value,
+        &origin_cached );
+    MPI_Datatype target_type = internal::vectorType(
+        T.nb(), T.mb(), remote->stride, mpi_type<scalar_t>::value,
+        &target_cached );
+
+    MPI_Win win = storage_->rmaWindow();
+    {
+        internal::MpiGuard mpi_guard;
+        slate_mpi_call(
+            MPI_Get( T.data(), 1, origin_type, src_rank, remote->address,
+                     1, target_type, win ) );
+        slate_mpi_call( MPI_Win_flush( src_rank, win ) );
+    }
+    if (! origin_cached)
+        slate_mpi_call( MPI_Type_free( &origin_type ) );
+    if (! target_cached)
+        slate_mpi_call( MPI_Type_free( &target_type ) );
+
+    tileModified( i, j, HostNum, true );
+}
+
+//------------------------------------------------------------------------------
+/// Sets compression of the tiles that listBcast and listBcastMT send
+/// between ranks, to cut traffic on bandwidth-bound networks.
+/// Each tile is compressed once by its root into a host buffer, sent to
+/// the ranks it is forwarded to, and decompressed by each receiver.
+/// Tiles that don't compress are sent raw, so at most the codec time is
+/// lost. The bytes before and after, and the codec times, are reported
+/// by Counters (@see PhaseCounters::compressionRatio).
+///
+/// Compressed tiles go through host memory: with NCCL or GPU-aware MPI,
+/// device tiles are sent uncompressed. Segmented broadcasts of large
+/// tiles are not pipelined while compression is on, and band parts of
+/// compact band matrices are sent uncompressed.
+///
+/// Must be called on all ranks. Since it is a property of the storage,
+/// it applies to all views of the matrix.
+///
+/// @param[in] compression
+///     - None: send tiles as is [default].
+///     - Lossless: byte shuffle and run-length encoding. Effective for
+///       tiles with many exact zeros or repeated values.
+///     - ErrorBounded: round mantissas so each entry has relative error at
+///       most tol, then as Lossless. Only for routines that tolerate
+///       perturbations of the tiles they broadcast, e.g., inside an
+///       iterative refinement.
+///
+/// @param[in] tol
+///     With ErrorBounded, relative error tolerance of each real entry,
+///     and of the real and imaginary parts of complex entries,
+///     e.g., 1e-6. Subnormal entries have absolute error at most tol
+///     times the smallest normal number.
+///
+template <typename scalar_t>
+void BaseMatrix<scalar_t>::compressTransfers(Compression compression, double tol)
+{
+    slate_error_if( compression == Compression::ErrorBounded && ! (tol > 0) );
+    storage_->setCompression( compression, tol );
+}
+
 //------------------------------------------------------------------------------
 /// Send tile {i, j} of op(A) to all MPI ranks in matrix B.
 /// If target is Devices, also copies tile to all devices on each MPI rank.
@@ -1972,6 +2656,7 @@ void BaseMatrix<scalar_t>::tileBcast(
 /// Send tile {i, j} of op(A) to all MPI ranks in the list of submatrices
 /// bcast_list.
 /// Data received must be in 'layout' (ColMajor/RowMajor) major.
+/// Structurally zero tiles are not sent; @see trackZeroTiles.
 ///
 /// @tparam target
 ///     Destination to target; either Host (default) or Device.
@@ -2018,31 +2703,126 @@ void BaseMatrix<scalar_t>::listBcast(
 
     std::vector<MPI_Request> send_requests;
 
+    // Without GPU-aware MPI, root tiles valid only on a device are staged
+    // through host buffers, rotating over the staging slots of the device,
+    // so the device-to-host copy of each tile overlaps the sends of the
+    // previous one, instead of copying and sending one tile at a time.
+    // Receivers already overlap receives with the copies to devices.
+    struct StagedTile {
+        int device;
+        int slot;
+        scalar_t* buffer;
+        int count;
+        std::vector<int> dsts;
+    };
+    std::vector<StagedTile> staged;             // copy queued, not yet sent
+    std::vector<scalar_t*> staged_buffers;      // sent, released at the end
+    std::vector<int> next_slot( num_devices(), 0 );
+
+    // Sends the staged tiles once their copies are done. This rank must
+    // flush before blocking in a receive, which a rank it sends to may be
+    // blocked in as well.
+    auto flush_staged = [&]( int tag ) {
+        for (auto& st : staged) {
+            storage_->staging_queue( st.device, st.slot )->sync();
+            for (int dst : st.dsts) {
+                trace::Block trace_block_send( "MPI_Isend" );
+                internal::count_message( dst, st.count * sizeof(scalar_t) );
+                MPI_Request request;
+                slate_mpi_call(
+                    MPI_Isend( st.buffer, st.count, mpi_type<scalar_t>::value,
+                               dst, tag, mpi_comm_, &request ) );
+                send_requests.push_back( request );
+            }
+            staged_buffers.push_back( st.buffer );
+        }
+        staged.clear();
+    };
+
+    // Queues the copy of tile {i, j} from device to a host buffer,
+    // then sends the previously staged tile.
+    auto stage_tile = [&]( int64_t i, int64_t j, int device,
+                           std::set<int> const& bcast_set, int radix,
+                           int tag ) {
+        std::vector<int> new_vec;
+        std::list<int> recv_from;
+        std::list<int> send_to;
+        tileBcastPattern( i, j, bcast_set, radix, new_vec, recv_from, send_to );
+        std::vector<int> dsts;
+        for (int dst : send_to)
+            dsts.push_back( new_vec[ dst ] );
+
+        auto Aij = at( i, j, device );
+        Aij.op( Op::NoTrans );  // use the stored dimensions
+        int64_t mb = Aij.layout() == Layout::ColMajor ? Aij.mb() : Aij.nb();
+        int64_t nb = Aij.layout() == Layout::ColMajor ? Aij.nb() : Aij.mb();
+        int64_t tile_bytes = mb * nb * sizeof(scalar_t);
+        internal::count( internal::Count::TilesToHost );
+        internal::count( internal::Count::BytesToHost, tile_bytes );
+        internal::addHostStagedBytes( tile_bytes );
+
+        int slot = next_slot[ device ];
+        next_slot[ device ] = (slot + 1) % storage_->num_staging_slots;
+        scalar_t* buffer = storage_->allocWorkspaceBuffer( HostNum, mb*nb );
+        blas::device_memcpy_2d<scalar_t>(
+            buffer, mb, Aij.data(), Aij.stride(), mb, nb,
+            *storage_->staging_queue( device, slot ) );
+
+        flush_staged( tag );
+        staged.push_back( { device, slot, buffer, int( mb*nb ),
+                            std::move( dsts ) } );
+    };
+
     for (auto bcast : bcast_list) {
 
         auto i = std::get<0>(bcast);
         auto j = std::get<1>(bcast);
         auto submatrices_list = std::get<2>(bcast);
 
+        // Structurally zero tiles are skipped by their consumers,
+        // and all ranks know them, so none send or receive them.
+        if (tileIsZero(i, j))
+            continue;
+
         // Find the set of participating ranks.
+        int root = tileRank(i, j);
         std::set<int> bcast_set;
-        bcast_set.insert(tileRank(i, j));       // Insert root.
+        bcast_set.insert(root);                 // Insert root.
         for (auto submatrix : submatrices_list) // Insert destinations.
             submatrix.getRanks(&bcast_set);
 
+        // In a workspace session, skip ranks still holding the tile.
+        storage_->sessionFilter( globalIndex( i, j ), root, bcast_set );
+
         // If this rank is in the set.
         if (bcast_set.find(mpi_rank_) != bcast_set.end()) {
             // If receiving the tile.
             int device = HostNum;
-            if (target == Target::Devices && gpu_aware_mpi()) {
+            if (target == Target::Devices
+                && (gpu_aware_mpi() || internal::ncclEnabled())) {
                 device = tileDevice( i, j );
             }
             storage_->tilePrepareToReceive( globalIndex( i, j ), device, layout_ );
 
             // Send across MPI ranks.
             // Previous used MPI bcast: tileBcastToSet(i, j, bcast_set);
-            // Currently uses 2D hypercube p2p send.
-            tileIbcastToSet(i, j, bcast_set, 2, tag, layout, send_requests, target);
+            // Currently uses 2D hypercube p2p send, unless set by bcast_radix.
+            int radix = (bcast_radix() > 0 ? bcast_radix() : 2);
+            int staging_device = HostNum;
+            if (mpi_rank_ == root && bcast_set.size() > 1)
+                staging_device = tileStagingDevice( i, j, layout );
+            if (staging_device != HostNum) {
+                stage_tile( i, j, staging_device, bcast_set, radix, tag );
+            }
+            else {
+                if (mpi_rank_ != root)
+                    flush_staged( tag );
+                tileIbcastToSet(i, j, bcast_set, radix, tag, layout,
+                                send_requests, target);
+            }
+
+            if (mpi_rank_ != root)
+                storage_->sessionHold( globalIndex( i, j, device ) );
         }
 
         // Copy to devices.
@@ -2059,18 +2839,15 @@ void BaseMatrix<scalar_t>::listBcast(
                     tile_set[device].insert({i, j});
             }
             else {
+                // Queue copies without waiting; see sync below.
                 #pragma omp taskgroup
                 for (auto device : dev_set) {
                     // note: dev_set structure is released after the if-target block
                     #pragma omp task slate_omp_default_none \
                         firstprivate( i, j, device, is_shared )
                     {
-                        if (is_shared) {
-                            tileGetAndHold(i, j, device, LayoutConvert::None);
-                        }
-                        else {
-                            tileGetForReading(i, j, device, LayoutConvert::None);
-                        }
+                        tileGet( i, j, device, LayoutConvert::None,
+                                 false, is_shared, true );
                     }
                 }
             }
@@ -2085,19 +2862,24 @@ void BaseMatrix<scalar_t>::listBcast(
                     #pragma omp task slate_omp_default_none \
                         firstprivate( d, is_shared ) shared( tile_set )
                     {
-                        if (is_shared) {
-                            tileGetAndHold(tile_set[d], d, LayoutConvert::None);
-                        }
-                        else {
-                            tileGetForReading(tile_set[d], d, LayoutConvert::None);
-                        }
+                        tileGet( tile_set[d], d, LayoutConvert::None,
+                                 false, is_shared, true );
                     }
                 }
             }
         }
     }
-    slate_mpi_call(
-        MPI_Waitall(send_requests.size(), send_requests.data(), MPI_STATUSES_IGNORE));
+    flush_staged( tag );
+    internal::waitall( send_requests );
+    for (scalar_t* buffer : staged_buffers)
+        storage_->releaseWorkspaceBuffer( buffer, HostNum );
+
+    // Copies to devices were queued asynchronously, so they overlap with
+    // each other and with the MPI traffic; wait for them once here.
+    if (target == Target::Devices) {
+        for (int d = 0; d < num_devices(); ++d)
+            comm_queue( d )->sync();
+    }
 }
 
 //------------------------------------------------------------------------------
@@ -2164,30 +2946,43 @@ void BaseMatrix<scalar_t>::listBcastMT(
         auto tagij = std::get<3>(bcast);
         int tag = int(tagij) % 32768;  // MPI_TAG_UB is at least 32767
 
+        // Skip structurally zero tiles, as in listBcast.
+        if (tileIsZero(i, j))
+            continue;
+
         {
             trace::Block trace_block(
                 std::string("listBcast("+std::to_string(i)+","+std::to_string(j)+")").c_str());
 
             // Find the set of participating ranks.
+            int root = tileRank(i, j);
             std::set<int> bcast_set;
-            bcast_set.insert(tileRank(i, j));       // Insert root.
+            bcast_set.insert(root);                 // Insert root.
             for (auto submatrix : submatrices_list) // Insert destinations.
                 submatrix.getRanks(&bcast_set);
 
+            // In a workspace session, skip ranks still holding the tile.
+            storage_->sessionFilter( globalIndex( i, j ), root, bcast_set );
+
             // If this rank is in the set.
             if (bcast_set.find(mpi_rank_) != bcast_set.end()) {
                 // If receiving the tile.
                 int device = HostNum;
-                if (target == Target::Devices && gpu_aware_mpi()) {
+                if (target == Target::Devices
+                    && (gpu_aware_mpi() || internal::ncclEnabled())) {
                     device = tileDevice( i, j );
                 }
                 storage_->tilePrepareToReceive( globalIndex( i, j ), device, layout_ );
 
                 // Send across MPI ranks.
                 // Previous used MPI bcast: tileBcastToSet(i, j, bcast_set);
-                // Currently uses radix-D hypercube p2p send.
-                int radix = 4; // bcast_set.size(); // 2;
+                // Currently uses radix-4 hypercube p2p send,
+                // unless set by bcast_radix.
+                int radix = (bcast_radix() > 0 ? bcast_radix() : 4);
                 tileBcastToSet(i, j, bcast_set, radix, tag, layout, target);
+
+                if (mpi_rank_ != root)
+                    storage_->sessionHold( globalIndex( i, j, device ) );
             }
 
             // Copy to devices.
@@ -2199,17 +2994,410 @@ void BaseMatrix<scalar_t>::listBcastMT(
                 for (auto submatrix : submatrices_list)
                     submatrix.getLocalDevices(&dev_set);
 
-                // #pragma omp taskgroup
+                // Queue copies without waiting; see sync below.
                 for (auto dev : dev_set) {
-                    //todo: test #pragma omp task default(none) firstprivate(i,j,dev,is_shared) if (mpi_size == 1)
-                    if (is_shared)
-                        tileGetAndHold(i, j, dev, LayoutConvert::None);
-                    else
-                        tileGetForReading(i, j, dev, LayoutConvert::None);
+                    tileGet( i, j, dev, LayoutConvert::None,
+                             false, is_shared, true );
                 }
             } // paren added for the trace_block label
         }
     }
+
+    // Copies to devices were queued asynchronously, so copies of different
+    // tiles overlap; wait for them once here.
+    if (target == Target::Devices) {
+        for (int d = 0; d < num_devices(); ++d)
+            comm_queue( d )->sync();
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Send tiles {i, j} of op(A) to all MPI ranks in the list of submatrices
+/// bcast_list, packing all tiles that have the same root and the same set
+/// of participating ranks into one message per hop of the hypercube.
+/// This reduces the number of messages when many small tiles follow the
+/// same pattern, e.g., a block column sent across process rows.
+/// Tiles are packed in host memory; for target Devices, they are then
+/// copied to the devices as in listBcast.
+/// Data received must be in 'layout' (ColMajor/RowMajor) major.
+///
+/// With a wire precision lower than the matrix precision, the root
+/// converts tiles to it when packing and receivers convert them back when
+/// unpacking, so receivers get rounded copies; the root's tiles are
+/// unchanged. This halves or quarters the bytes sent, for routines that
+/// tolerate the rounding.
+///
+/// @tparam target
+///     Destination to target; either Host (default) or Device.
+///
+/// @param[in] bcast_list
+///     List of submatrices defining the MPI ranks to send to.
+///
+/// @param[in] layout
+///     Indicates the Layout (ColMajor/RowMajor) of the broadcasted data.
+///
+/// @param[in] tag
+///     MPI tag, default 0.
+///
+/// @param[in] is_shared
+///     A flag to get and hold the broadcasted (prefetched) tiles on the
+///     devices. @see listBcast
+///
+/// @param[in] precision
+///     Precision of the tiles on the wire, default Native.
+///
+/// @param[in] partitioned
+///     Whether to send each packed message with MPI 4 partitioned
+///     communication, one partition per tile, default false. Tiles are
+///     then forwarded and unpacked one by one as they arrive, instead of
+///     once the whole message has arrived. All ranks must pass the same
+///     value. Ignored if MPI is older than version 4.
+///
+template <typename scalar_t>
+template <Target target>
+void BaseMatrix<scalar_t>::listBcastPacked(
+    BcastList& bcast_list, Layout layout, int tag, bool is_shared,
+    BcastPrecision precision, bool partitioned )
+{
+    BcastListTag bcast_list_tag;
+    bcast_list_tag.reserve( bcast_list.size() );
+    for (auto& bcast : bcast_list) {
+        bcast_list_tag.push_back( { std::get<0>( bcast ), std::get<1>( bcast ),
+                                    std::get<2>( bcast ), tag } );
+    }
+    listBcastPacked<target>( bcast_list_tag, layout, is_shared, precision,
+                             partitioned );
+}
+
+//------------------------------------------------------------------------------
+/// Variant of listBcastPacked where each tile {i, j} has a message tag in
+/// the bcast_list. A packed message uses the tag of its first tile.
+///
+template <typename scalar_t>
+template <Target target>
+void BaseMatrix<scalar_t>::listBcastPacked(
+    BcastListTag& bcast_list, Layout layout, bool is_shared,
+    BcastPrecision precision, bool partitioned )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    if (target == Target::Devices) {
+        assert(num_devices() > 0);
+    }
+
+    // Partitioned communication needs MPI 4.
+    #if MPI_VERSION < 4
+        partitioned = false;
+    #endif
+
+    // Complex tiles are converted as real matrices with twice the rows.
+    const int64_t reals = is_complex ? 2 : 1;
+    const int64_t wire_bytes = internal::wireBytes( precision, sizeof(real_t) );
+    const bool lower = wire_bytes < int64_t( sizeof(real_t) );
+
+    // Tiles sharing the same root and set of ranks, hence the same
+    // send/recv pattern. All ranks visit the groups in the same order.
+    struct BcastGroup {
+        int root;
+        std::set<int> bcast_set;
+        int tag;
+        std::vector<ij_tuple> tiles;
+        std::vector< std::set<int> > dev_sets;
+    };
+    std::vector<BcastGroup> groups;
+    std::map< std::pair< int, std::set<int> >, size_t > group_index;
+
+    for (auto& bcast : bcast_list) {
+        auto i = std::get<0>(bcast);
+        auto j = std::get<1>(bcast);
+        auto& submatrices_list = std::get<2>(bcast);
+
+        // Skip structurally zero tiles, as in listBcast.
+        if (tileIsZero(i, j))
+            continue;
+
+        // Find the set of participating ranks.
+        int root = tileRank(i, j);
+        std::set<int> bcast_set;
+        bcast_set.insert(root);                 // Insert root.
+        for (auto submatrix : submatrices_list) // Insert destinations.
+            submatrix.getRanks(&bcast_set);
+
+        // In a workspace session, skip ranks still holding the tile,
+        // unless sending rounded copies. A rank holding it goes in a group
+        // of its own, to still copy it to its devices.
+        bool in_set = bcast_set.find(mpi_rank_) != bcast_set.end();
+        if (! lower)
+            storage_->sessionFilter( globalIndex( i, j ), root, bcast_set );
+
+        // Skip if this rank is not in the set.
+        if (! in_set)
+            continue;
+        if (bcast_set.find(mpi_rank_) == bcast_set.end())
+            bcast_set = { mpi_rank_ };
+
+        auto key = std::make_pair( root, bcast_set );
+        auto iter = group_index.find( key );
+        if (iter == group_index.end()) {
+            int tag = int( std::get<3>(bcast) ) % 32768;  // MPI_TAG_UB >= 32767
+            iter = group_index.emplace( key, groups.size() ).first;
+            groups.push_back( { root, bcast_set, tag, {}, {} } );
+        }
+        BcastGroup& group = groups[ iter->second ];
+        group.tiles.push_back( { i, j } );
+
+        std::set<int> dev_set;
+        if (target == Target::Devices) {
+            for (auto submatrix : submatrices_list)
+                submatrix.getLocalDevices(&dev_set);
+        }
+        group.dev_sets.push_back( std::move( dev_set ) );
+    }
+
+    // Buffers must live until the sends complete.
+    std::vector< std::vector<scalar_t> > buffers( groups.size() );
+    std::vector<MPI_Request> send_requests;
+    // Persistent partitioned sends, freed once complete.
+    std::vector<MPI_Request> partitioned_requests;
+
+    for (size_t g = 0; g < groups.size(); ++g) {
+        BcastGroup& group = groups[ g ];
+        if (group.bcast_set.size() == 1)
+            continue;
+
+        trace::Block trace_block( "listBcastPacked" );
+
+        // Shift root to position zero, as in tileIbcastToSet.
+        std::vector<int> bcast_vec( group.bcast_set.begin(),
+                                    group.bcast_set.end() );
+        auto root_iter = std::find( bcast_vec.begin(), bcast_vec.end(),
+                                    group.root );
+        std::vector<int> new_vec( root_iter, bcast_vec.end() );
+        new_vec.insert( new_vec.end(), bcast_vec.begin(), root_iter );
+        auto rank_iter = std::find( new_vec.begin(), new_vec.end(), mpi_rank_ );
+        int new_rank = std::distance( new_vec.begin(), rank_iter );
+
+        std::list<int> recv_from;
+        std::list<int> send_to;
+        bool two_level = internal::bcastPattern(
+            mpi_comm_, new_vec, new_rank, 2, recv_from, send_to );
+        trace::Block trace_block_pattern(
+            two_level ? "bcast_2level" : "bcast_cube" );
+
+        // Offsets of the tiles in the packed buffer.
+        std::vector<int64_t> offsets( group.tiles.size() + 1, 0 );
+        for (size_t t = 0; t < group.tiles.size(); ++t) {
+            int64_t i = std::get<0>( group.tiles[ t ] );
+            int64_t j = std::get<1>( group.tiles[ t ] );
+            offsets[ t+1 ] = offsets[ t ] + tileMb( i ) * tileNb( j );
+        }
+        // With partitioned communication, one partition per tile.
+        // Partitions all have the same size, so tiles are padded to the
+        // largest one, usually only the last block row or column is smaller.
+        int partitions = 0;
+        if (partitioned) {
+            partitions = group.tiles.size();
+            int64_t max_size = 0;
+            for (int t = 0; t < partitions; ++t)
+                max_size = std::max( max_size, offsets[ t+1 ] - offsets[ t ] );
+            for (int t = 0; t <= partitions; ++t)
+                offsets[ t ] = t * max_size;
+        }
+        // In lower precision, count is in bytes.
+        int64_t count = offsets.back();
+        MPI_Datatype wire_type = mpi_type<scalar_t>::value;
+        if (lower) {
+            count *= reals * wire_bytes;
+            wire_type = MPI_BYTE;
+        }
+        slate_assert( count <= std::numeric_limits<int>::max() );
+        int64_t bytes = lower ? count : count * sizeof(scalar_t);
+        std::vector<scalar_t>& buffer = buffers[ g ];
+        buffer.resize( lower ? ceildiv( count, int64_t( sizeof(scalar_t) ) )
+                             : count );
+        char* wire = reinterpret_cast<char*>( buffer.data() );
+
+        // Unpacks tile t of the group from the buffer.
+        auto unpack_tile = [&]( size_t t ) {
+            int64_t i = std::get<0>( group.tiles[ t ] );
+            int64_t j = std::get<1>( group.tiles[ t ] );
+            storage_->tilePrepareToReceive( globalIndex( i, j ), HostNum,
+                                            layout_ );
+            tileAcquire( i, j, HostNum, layout );
+            auto T = at( i, j, HostNum );
+            T.op( Op::NoTrans );  // use the stored dimensions
+            int64_t mb = T.layout() == Layout::ColMajor ? T.mb() : T.nb();
+            int64_t nb = T.layout() == Layout::ColMajor ? T.nb() : T.mb();
+            if (lower) {
+                internal::wireUnpack(
+                    precision, reals*mb, nb,
+                    &wire[ offsets[ t ] * reals * wire_bytes ],
+                    reinterpret_cast<real_t*>( T.data() ),
+                    reals*T.stride() );
+            }
+            else {
+                lapack::lacpy( lapack::MatrixType::General, mb, nb,
+                               &buffer[ offsets[ t ] ], mb,
+                               T.data(), T.stride() );
+            }
+            tileModified( i, j, HostNum, true );
+            if (! lower)
+                storage_->sessionHold( globalIndex( i, j, HostNum ) );
+        };
+
+        // Packs tile t of the group into the buffer. Packing is always done
+        // on host, so device tiles are staged even with GPU-aware MPI.
+        auto pack_tile = [&]( size_t t ) {
+            int64_t i = std::get<0>( group.tiles[ t ] );
+            int64_t j = std::get<1>( group.tiles[ t ] );
+            if (tileSourceDevice( i, j ) != HostNum) {
+                internal::addHostStagedBytes(
+                    tileMb( i ) * tileNb( j ) * sizeof(scalar_t) );
+            }
+            tileGetForReading( i, j, HostNum, LayoutConvert( layout ) );
+            auto T = at( i, j, HostNum );
+            T.op( Op::NoTrans );  // use the stored dimensions
+            int64_t mb = T.layout() == Layout::ColMajor ? T.mb() : T.nb();
+            int64_t nb = T.layout() == Layout::ColMajor ? T.nb() : T.mb();
+            if (lower) {
+                internal::wirePack(
+                    precision, reals*mb, nb,
+                    reinterpret_cast<real_t const*>( T.data() ),
+                    reals*T.stride(),
+                    &wire[ offsets[ t ] * reals * wire_bytes ] );
+            }
+            else {
+                lapack::lacpy( lapack::MatrixType::General, mb, nb,
+                               T.data(), T.stride(),
+                               &buffer[ offsets[ t ] ], mb );
+            }
+        };
+
+        if (partitions > 0) {
+            #if MPI_VERSION >= 4
+                // Each tile is marked ready as soon as it is packed, or has
+                // arrived, so forwarding pipelines tile by tile down the
+                // tree, and receivers unpack tiles while the rest arrive.
+                trace::Block trace_block_part( "MPI_Partitioned" );
+                MPI_Count part_count = count / partitions;
+                MPI_Request recv_request = MPI_REQUEST_NULL;
+                if (! recv_from.empty()) {
+                    internal::count( internal::Count::BytesRecv, bytes );
+                    slate_mpi_call(
+                        MPI_Precv_init( buffer.data(), partitions, part_count,
+                                        wire_type, new_vec[ recv_from.front() ],
+                                        group.tag, mpi_comm_, MPI_INFO_NULL,
+                                        &recv_request ) );
+                    slate_mpi_call( MPI_Start( &recv_request ) );
+                }
+                size_t first_send = partitioned_requests.size();
+                for (int dst : send_to) {
+                    internal::count_message( new_vec[ dst ], bytes );
+                    MPI_Request request;
+                    slate_mpi_call(
+                        MPI_Psend_init( buffer.data(), partitions, part_count,
+                                        wire_type, new_vec[ dst ], group.tag,
+                                        mpi_comm_, MPI_INFO_NULL, &request ) );
+                    slate_mpi_call( MPI_Start( &request ) );
+                    partitioned_requests.push_back( request );
+                }
+                for (int t = 0; t < partitions; ++t) {
+                    if (recv_request != MPI_REQUEST_NULL) {
+                        int arrived = 0;
+                        while (! arrived) {
+                            slate_mpi_call(
+                                MPI_Parrived( recv_request, t, &arrived ) );
+                        }
+                    }
+                    else {
+                        pack_tile( t );
+                    }
+                    for (size_t r = first_send;
+                         r < partitioned_requests.size(); ++r)
+                    {
+                        slate_mpi_call(
+                            MPI_Pready( t, partitioned_requests[ r ] ) );
+                    }
+                    if (recv_request != MPI_REQUEST_NULL)
+                        unpack_tile( t );
+                }
+                if (recv_request != MPI_REQUEST_NULL) {
+                    slate_mpi_call( MPI_Wait( &recv_request, MPI_STATUS_IGNORE ) );
+                    slate_mpi_call( MPI_Request_free( &recv_request ) );
+                    if (target == Target::Devices)
+                        internal::addHostStagedBytes( bytes );
+                }
+            #endif
+            continue;
+        }
+
+        if (! recv_from.empty()) {
+            // Receive the packed tiles, then unpack them.
+            {
+                trace::Block trace_block_recv( "MPI_Recv" );
+                internal::count( internal::Count::BytesRecv, bytes );
+                slate_mpi_call(
+                    MPI_Recv( buffer.data(), count, wire_type,
+                              new_vec[ recv_from.front() ], group.tag,
+                              mpi_comm_, MPI_STATUS_IGNORE ) );
+            }
+            for (size_t t = 0; t < group.tiles.size(); ++t)
+                unpack_tile( t );
+            if (target == Target::Devices) {
+                // Received on host, to be copied to devices.
+                internal::addHostStagedBytes( bytes );
+            }
+        }
+        else {
+            // Root packs its tiles.
+            for (size_t t = 0; t < group.tiles.size(); ++t)
+                pack_tile( t );
+        }
+
+        // Forward the packed buffer as is.
+        for (int dst : send_to) {
+            trace::Block trace_block_send( "MPI_Isend" );
+            internal::count_message( new_vec[ dst ], bytes );
+            MPI_Request request;
+            slate_mpi_call(
+                MPI_Isend( buffer.data(), count, wire_type,
+                           new_vec[ dst ], group.tag, mpi_comm_, &request ) );
+            send_requests.push_back( request );
+        }
+    }
+
+    // Copy to devices. Queue copies without waiting; see sync below.
+    if (target == Target::Devices) {
+        #pragma omp taskgroup
+        for (auto& group : groups) {
+            for (size_t t = 0; t < group.tiles.size(); ++t) {
+                int64_t i = std::get<0>( group.tiles[ t ] );
+                int64_t j = std::get<1>( group.tiles[ t ] );
+                for (int device : group.dev_sets[ t ]) {
+                    #pragma omp task slate_omp_default_none \
+                        firstprivate( i, j, device, is_shared )
+                    {
+                        tileGet( i, j, device, LayoutConvert::None,
+                                 false, is_shared, true );
+                    }
+                }
+            }
+        }
+    }
+
+    internal::waitall( send_requests );
+    if (! partitioned_requests.empty()) {
+        slate_mpi_call(
+            MPI_Waitall( partitioned_requests.size(),
+                         partitioned_requests.data(), MPI_STATUSES_IGNORE ) );
+        for (auto& request : partitioned_requests)
+            slate_mpi_call( MPI_Request_free( &request ) );
+    }
+
+    if (target == Target::Devices) {
+        for (int d = 0; d < num_devices(); ++d)
+            comm_queue( d )->sync();
+    }
 }
 
 //------------------------------------------------------------------------------
@@ -2236,19 +3424,19 @@ void BaseMatrix<scalar_t>::listReduce(ReduceList& reduce_list, Layout layout, in
             || reduce_set.find(mpi_rank_) != reduce_set.end()) {
 
             // Reduce across MPI ranks.
-            // Uses 2D hypercube p2p send.
-            tileReduceFromSet(i, j, root_rank, reduce_set, 2, tag, layout);
+            // Uses 2D hypercube p2p send, unless set by bcast_radix.
+            int radix = (bcast_radix() > 0 ? bcast_radix() : 2);
+            tileReduceFromSet(i, j, root_rank, reduce_set, radix, tag, layout);
 
             // If not the tile owner.
+            // The root's tile was marked Modified on the host or device
+            // where tileReduceFromSet accumulated it.
             if (! tileIsLocal(i, j)) {
 
                 // Destroy the tile.
                 // todo: should it be a tileRelease()?
                 if (mpi_rank_ != root_rank)
-                    tileErase( i, j, HostNum );
-            }
-            else if (root_rank == mpi_rank_ && reduce_set.size() > 1) {
-                tileModified( i, j );
+                    tileErase( i, j, AllDevices );
             }
         }
     }
@@ -2280,16 +3468,101 @@ void BaseMatrix<scalar_t>::listReduce(ReduceList& reduce_list, Layout layout, in
 /// @param[in] layout
 ///     Indicates the Layout (ColMajor/RowMajor) of the received data.
 ///
+/// @param[in] segment_bytes
+///     Segment size for pipelining; @see tileIbcastToSet.
+///
 template <typename scalar_t>
 void BaseMatrix<scalar_t>::tileBcastToSet(
     int64_t i, int64_t j, std::set<int> const& bcast_set,
-    int radix, int tag, Layout layout, Target target)
+    int radix, int tag, Layout layout, Target target, int64_t segment_bytes)
 {
     std::vector<MPI_Request> requests;
     requests.reserve(radix);
 
-    tileIbcastToSet(i, j, bcast_set, radix, tag, layout, requests, target);
-    slate_mpi_call(MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE));
+    tileIbcastToSet(i, j, bcast_set, radix, tag, layout, requests, target,
+                    segment_bytes);
+    internal::waitall( requests );
+}
+
+//------------------------------------------------------------------------------
+/// [internal]
+/// Gets the send/recv pattern of this rank in the broadcast of tile {i, j}
+/// to bcast_set, topology-aware if the ranks span nodes.
+///
+/// @param[out] new_vec
+///     Ranks of bcast_set, shifted so the root is first; recv_from and
+///     send_to index into it.
+///
+/// @param[out] recv_from
+///     Rank to receive from, empty for the root.
+///
+/// @param[out] send_to
+///     Ranks to send to.
+///
+/// @return whether the pattern is two-level (across, then within nodes).
+///
+template <typename scalar_t>
+bool BaseMatrix<scalar_t>::tileBcastPattern(
+    int64_t i, int64_t j, std::set<int> const& bcast_set, int radix,
+    std::vector<int>& new_vec,
+    std::list<int>& recv_from, std::list<int>& send_to)
+{
+    // Convert the set to a vector.
+    std::vector<int> bcast_vec(bcast_set.begin(), bcast_set.end());
+
+    // TODO: std::set is already sorted (it's really an ordered_set), no need to sort again?
+    // Sort the ranks.
+    std::sort(bcast_vec.begin(), bcast_vec.end());
+
+    // Find root.
+    int root_rank = tileRank(i, j);
+    auto root_iter = std::find(bcast_vec.begin(), bcast_vec.end(), root_rank);
+
+    // Shift root to position zero.
+    new_vec.assign(root_iter, bcast_vec.end());
+    new_vec.insert(new_vec.end(), bcast_vec.begin(), root_iter);
+
+    // Find the new rank.
+    auto rank_iter = std::find(new_vec.begin(), new_vec.end(), mpi_rank_);
+    int new_rank = std::distance(new_vec.begin(), rank_iter);
+
+    return internal::bcastPattern(
+        mpi_comm_, new_vec, new_rank, radix, recv_from, send_to );
+}
+
+//------------------------------------------------------------------------------
+/// [internal]
+/// @return the device to stage tile {i, j} from through host buffers in
+/// listBcast, or HostNum to send it as usual. A tile is staged if its only
+/// valid instances are on devices, in the given layout, MPI isn't GPU-aware,
+/// and the tile is sent whole, not in segments, band parts, or compressed.
+///
+template <typename scalar_t>
+int BaseMatrix<scalar_t>::tileStagingDevice(
+    int64_t i, int64_t j, Layout layout)
+{
+    if (num_devices() == 0 || gpu_aware_mpi() || internal::ncclEnabled()
+        || storage_->bandCompacted()
+        || storage_->compression() != Compression::None
+        || internal::bcastSegmentBytes(
+               tileMb(i) * tileNb(j) * sizeof(scalar_t) ) > 0)
+        return HostNum;
+
+    auto& tile_node = storage_->at(globalIndex(i, j));
+    // acquire read access to the (i, j) TileNode
+    LockGuard guard(tile_node.getLock());
+
+    if (tile_node.existsOn(HostNum)
+        && tile_node[HostNum]->state() != MOSI::Invalid) {
+        return HostNum;
+    }
+    for (int d = 0; d < num_devices(); ++d) {
+        if (tile_node.existsOn(d)
+            && tile_node[d]->state() != MOSI::Invalid) {
+            return tile_node[d]->layout() == layout ? d : HostNum;
+        }
+    }
+    return HostNum;
 }
 
 //------------------------------------------------------------------------------
@@ -2322,45 +3595,220 @@ void BaseMatrix<scalar_t>::tileBcastToSet(
 /// @param[in,out] send_requests
 ///     Vector where requests for this bcast are appended.
 ///
+/// @param[in] segment_bytes
+///     If > 0, the tile is split into segments of about segment_bytes,
+///     and each receiver forwards a segment as soon as it arrives, while
+///     the next segments are still in flight. This pipelines the hops of
+///     the tree, so a deep tree costs about one tile transfer instead of
+///     one per hop. If 0, the whole tile is sent in one message.
+///     If < 0 (default), chosen from the tile size by
+///     internal::bcastSegmentBytes. All ranks in bcast_set must pass
+///     the same value.
+///
 template <typename scalar_t>
 void BaseMatrix<scalar_t>::tileIbcastToSet(
     int64_t i, int64_t j, std::set<int> const& bcast_set,
     int radix, int tag, Layout layout,
     std::vector<MPI_Request>& send_requests,
-    Target target)
+    Target target, int64_t segment_bytes)
 {
     // Quit if only root in the broadcast set.
     if (bcast_set.size() == 1)
         return;
 
-    // Convert the set to a vector.
-    std::vector<int> bcast_vec(bcast_set.begin(), bcast_set.end());
+    std::vector<int> new_vec;
+    std::list<int> recv_from;
+    std::list<int> send_to;
+    bool two_level = tileBcastPattern(
+        i, j, bcast_set, radix, new_vec, recv_from, send_to );
+    trace::Block trace_block( two_level ? "bcast_2level" : "bcast_cube" );
 
-    // TODO: std::set is already sorted (it's really an ordered_set), no need to sort again?
-    // Sort the ranks.
-    std::sort(bcast_vec.begin(), bcast_vec.end());
+    int device = HostNum;
+    if (target == Target::Devices
+        && (gpu_aware_mpi() || internal::ncclEnabled())) {
+        device = tileDevice( i, j );
+    }
 
-    // Find root.
-    int root_rank = tileRank(i, j);
-    auto root_iter = std::find(bcast_vec.begin(), bcast_vec.end(), root_rank);
+    // With NCCL/RCCL, device tiles are sent and received on the device's
+    // comm queue, ordered with the copies that produce and consume them,
+    // without a host round trip or stream synchronize per message.
+    // Callers sync the comm queues, as listBcast does.
+    if (target == Target::Devices && internal::ncclEnabled()) {
+        trace::Block trace_block_nccl("tileIbcastToSet_nccl");
+
+        blas::Queue* queue = comm_queue( device );
+        size_t bytes = tileMb(i) * tileNb(j) * sizeof(scalar_t);
+
+        if (! recv_from.empty()) {
+            // Received tiles are workspace, hence contiguous.
+            tileAcquire(i, j, device, layout);
+            auto Aij = at(i, j, device);
+            assert( Aij.isContiguous() );
+            internal::ncclRecv( Aij.data(), bytes, new_vec[recv_from.front()],
+                                mpi_comm_, *queue );
+            tileModified(i, j, device, true);
+        }
+        else {
+            tileGetForReading(i, j, device, LayoutConvert(layout));
+        }
 
-    // Shift root to position zero.
-    std::vector<int> new_vec(root_iter, bcast_vec.end());
-    new_vec.insert(new_vec.end(), bcast_vec.begin(), root_iter);
+        if (! send_to.empty()) {
+            auto Aij = at(i, j, device);
+            scalar_t* data = Aij.data();
+
+            // Pack a strided (user-owned) tile into a contiguous buffer.
+            scalar_t* buffer = nullptr;
+            if (! Aij.isContiguous()) {
+                Aij.op( Op::NoTrans );  // use the stored dimensions
+                int64_t mb = Aij.layout() == Layout::ColMajor ? Aij.mb() : Aij.nb();
+                int64_t nb = Aij.layout() == Layout::ColMajor ? Aij.nb() : Aij.mb();
+                buffer = storage_->allocWorkspaceBuffer( device, mb*nb );
+                blas::device_memcpy_2d<scalar_t>(
+                    buffer, mb, data, Aij.stride(), mb, nb, *queue );
+                data = buffer;
+            }
 
-    // Find the new rank.
-    auto rank_iter = std::find(new_vec.begin(), new_vec.end(), mpi_rank_);
-    int new_rank = std::distance(new_vec.begin(), rank_iter);
+            for (int dst : send_to) {
+                internal::ncclSend( data, bytes, new_vec[dst], mpi_comm_,
+                                    *queue );
+            }
 
-    // Get the send/recv pattern.
-    std::list<int> recv_from;
-    std::list<int> send_to;
-    internal::cubeBcastPattern(new_vec.size(), new_rank, radix,
-                               recv_from, send_to);
+            if (buffer != nullptr) {
+                queue->sync();
+                storage_->releaseWorkspaceBuffer( buffer, device );
+            }
+        }
+        return;
+    }
 
-    int device = HostNum;
-    if (target == Target::Devices && gpu_aware_mpi()) {
-        device = tileDevice( i, j );
+    // Whether to compress host tiles; decided before the root picks the
+    // device to send from, so all ranks agree.
+    bool compressed = storage_->compression() != Compression::None
+                      && device == HostNum;
+
+    // With compact band transfers, send only the band part of tiles
+    // that cross the band edge; the rest of the received tile is zero.
+    if (storage_->bandCompacted()) {
+        if (recv_from.empty() && device == HostNum)
+            device = tileSourceDevice( i, j );
+
+        if (! recv_from.empty())
+            tileAcquire(i, j, device, layout);
+        else
+            tileGetForReading(i, j, device, LayoutConvert(layout));
+
+        Tile<scalar_t> part;
+        if (tileBandPart( i, j, device, &part )) {
+            trace::Block trace_block_band("tileIbcastToSet_band");
+            bool empty = part.mb() == 0 || part.nb() == 0;
+            if (! recv_from.empty()) {
+                tileBandZero( i, j, device );
+                if (! empty)
+                    part.recv( new_vec[ recv_from.front() ], mpi_comm_,
+                               layout, tag );
+                tileModified(i, j, device, true);
+            }
+            if (! empty) {
+                for (int dst : send_to) {
+                    MPI_Request request;
+                    part.isend( new_vec[ dst ], mpi_comm_, tag, &request );
+                    send_requests.push_back( request );
+                }
+            }
+            return;
+        }
+    }
+
+    // With compressed transfers, the root compresses the tile once, and
+    // each receiver decompresses the message and forwards it as received.
+    // Messages are sent from a local buffer, so the sends complete here.
+    if (compressed) {
+        trace::Block trace_block_compressed("tileIbcastToSet_compressed");
+
+        std::vector<char> message;
+        if (! recv_from.empty()) {
+            tileAcquire(i, j, HostNum, layout);
+            at(i, j, HostNum).recvCompressed(
+                new_vec[ recv_from.front() ], mpi_comm_, layout, tag, message );
+            tileModified(i, j, HostNum, true);
+        }
+        else {
+            tileGetForReading(i, j, HostNum, LayoutConvert(layout));
+            at(i, j, HostNum).compress(
+                storage_->compression(), storage_->compressionTolerance(),
+                message );
+        }
+
+        std::vector<MPI_Request> requests;
+        for (int dst : send_to) {
+            trace::Block trace_block_send( "MPI_Isend" );
+            internal::count_message( new_vec[ dst ], message.size() );
+            MPI_Request request;
+            slate_mpi_call(
+                MPI_Isend( message.data(), message.size(), MPI_BYTE,
+                           new_vec[ dst ], tag, mpi_comm_, &request ) );
+            requests.push_back( request );
+        }
+        internal::waitall( requests );
+        return;
+    }
+
+    // Number of segments to pipeline. Segments are made of whole columns
+    // or rows, so there are at most min(mb, nb) of them.
+    int64_t num_segments = 1;
+    int64_t tile_bytes = tileMb(i) * tileNb(j) * sizeof(scalar_t);
+    if (segment_bytes < 0)
+        segment_bytes = internal::bcastSegmentBytes( tile_bytes );
+    if (segment_bytes > 0) {
+        num_segments = ceildiv( tile_bytes, segment_bytes );
+        num_segments = std::min( { num_segments, tileMb(i), tileNb(j) } );
+    }
+
+    if (recv_from.empty()) {
+        // With GPU-aware MPI, the root sends from a valid device instance
+        // rather than copying it to host.
+        if (device == HostNum)
+            device = tileSourceDevice( i, j );
+    }
+    else if (target == Target::Devices && device == HostNum) {
+        // Received on host, to be copied to devices.
+        internal::addHostStagedBytes( tile_bytes );
+    }
+
+    if (num_segments > 1) {
+        trace::Block trace_block_pipelined("tileIbcastToSet_pipelined");
+
+        if (! recv_from.empty()) {
+            tileAcquire(i, j, device, layout);
+        }
+        else {
+            tileGetForReading(i, j, device, LayoutConvert(layout));
+        }
+        auto Aij = at(i, j, device);
+
+        // Post all receives, then forward each segment as it arrives.
+        std::vector<MPI_Request> recv_requests( num_segments, MPI_REQUEST_NULL );
+        if (! recv_from.empty()) {
+            for (int64_t s = 0; s < num_segments; ++s) {
+                Aij.irecvSegment( new_vec[ recv_from.front() ], mpi_comm_,
+                                  layout, tag, s, num_segments,
+                                  &recv_requests[ s ] );
+            }
+        }
+        for (int64_t s = 0; s < num_segments; ++s) {
+            slate_mpi_call(
+                MPI_Wait( &recv_requests[ s ], MPI_STATUS_IGNORE ));
+            for (int dst : send_to) {
+                MPI_Request request;
+                Aij.isendSegment( new_vec[ dst ], mpi_comm_, tag,
+                                  s, num_segments, &request );
+                send_requests.push_back( request );
+            }
+        }
+
+        if (! recv_from.empty())
+            tileModified(i, j, device, true);
+        return;
     }
 
     // Receive.
@@ -2386,6 +3834,115 @@ void BaseMatrix<scalar_t>::tileIbcastToSet(
     }
 }
 
+//------------------------------------------------------------------------------
+/// [internal]
+/// Gets the part of tile {i, j} on device that contains its entries within
+/// the band, if compact band transfers are enabled and the part is smaller
+/// than the tile. Only whole stored tiles are compacted, not tiles cut by a
+/// sub-matrix view. The tile must exist on device.
+/// @see MatrixStorage::tileBandBox
+///
+/// @param[out] part
+///     View of the band part of the tile, possibly empty.
+///
+/// @return true if part is set, false if the whole tile must be sent.
+///
+template <typename scalar_t>
+bool BaseMatrix<scalar_t>::tileBandPart(
+    int64_t i, int64_t j, int device, Tile<scalar_t>* part)
+{
+    if (! storage_->bandCompacted())
+        return false;
+
+    // Indices in the (not transposed) view.
+    int64_t ii = (op_ == Op::NoTrans ? i : j);
+    int64_t jj = (op_ == Op::NoTrans ? j : i);
+    if ((ii == 0 && row0_offset_ != 0) || (jj == 0 && col0_offset_ != 0)
+        || tileMbInternal( ii ) != storage_->tileMb( ioffset_ + ii )
+        || tileNbInternal( jj ) != storage_->tileNb( joffset_ + jj ))
+        return false;
+
+    int64_t i0, mb, j0, nb;
+    if (! storage_->tileBandBox( globalIndex( i, j ), &i0, &mb, &j0, &nb ))
+        return false;
+
+    auto* tile = storage_->at( globalIndex( i, j, device ) );
+    *part = tile->slice( op_, i0, j0, mb, nb, Uplo::General );
+    return true;
+}
+
+//------------------------------------------------------------------------------
+/// [internal]
+/// Sets tile {i, j} on device to zero, before receiving its band part.
+/// @see tileBandPart
+///
+template <typename scalar_t>
+void BaseMatrix<scalar_t>::tileBandZero(int64_t i, int64_t j, int device)
+{
+    const scalar_t zero = 0.0;
+
+    auto* tile = storage_->at( globalIndex( i, j, device ) );
+    // Stored dimensions.
+    int64_t mb = tile->layout() == Layout::ColMajor ? tile->mb() : tile->nb();
+    int64_t nb = tile->layout() == Layout::ColMajor ? tile->nb() : tile->mb();
+    if (device == HostNum) {
+        lapack::laset( lapack::MatrixType::General, mb, nb, zero, zero,
+                       tile->data(), tile->stride() );
+    }
+    else {
+        blas::Queue* queue = comm_queue( device );
+        device::geset( mb, nb, zero, zero, tile->data(), tile->stride(),
+                       *queue );
+        queue->sync();
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Allocates lazy zero tile {i, j} of op(A), if it is one, on its origin.
+/// Called on first access by tileGet and operator(); does nothing for
+/// tiles that are allocated already.
+/// @see Matrix::insertLocalTilesZero
+///
+/// @param[in] i
+///     Tile's block row index. 0 <= i < mt.
+///
+/// @param[in] j
+///     Tile's block column index. 0 <= j < nt.
+///
+/// @param[in] fill_zero
+///     true: sets the tile to zero.
+///     false: leaves it uninitialized, when the caller overwrites all of
+///     it, e.g., gemm with beta = 0.
+///
+template <typename scalar_t>
+void BaseMatrix<scalar_t>::tileMaterialize(int64_t i, int64_t j, bool fill_zero)
+{
+    if (! storage_->hasLazyZeroTiles())
+        return;
+
+    const scalar_t zero = 0.0;
+
+    storage_->tileMaterialize(
+        globalIndex( i, j ), layout_,
+        [&]( Tile<scalar_t>* tile ) {
+            if (! fill_zero)
+                return;
+            // Stored dimensions.
+            int64_t mb = tile->layout() == Layout::ColMajor ? tile->mb() : tile->nb();
+            int64_t nb = tile->layout() == Layout::ColMajor ? tile->nb() : tile->mb();
+            if (tile->device() == HostNum) {
+                lapack::laset( lapack::MatrixType::General, mb, nb, zero, zero,
+                               tile->data(), tile->stride() );
+            }
+            else {
+                blas::Queue* queue = comm_queue( tile->device() );
+                device::geset( mb, nb, zero, zero, tile->data(), tile->stride(),
+                               *queue );
+                queue->sync();
+            }
+        } );
+}
+
 //------------------------------------------------------------------------------
 /// [internal]
 /// WARNING: Sent and received tiles are converted to 'layout' major.
@@ -2420,13 +3977,47 @@ void BaseMatrix<scalar_t>::tileReduceFromSet(
     auto rank_iter = std::find(new_vec.begin(), new_vec.end(), mpi_rank_);
     int new_rank = std::distance(new_vec.begin(), rank_iter);
 
-    // Get the send/recv pattern.
+    // Get the send/recv pattern, topology-aware if the ranks span nodes.
     std::list<int> recv_from;
     std::list<int> send_to;
-    internal::cubeReducePattern(new_vec.size(), new_rank, radix,
-                                recv_from, send_to);
+    bool two_level = internal::reducePattern(
+        mpi_comm_, new_vec, new_rank, radix, recv_from, send_to );
+    trace::Block trace_block( two_level ? "reduce_2level" : "reduce_cube" );
 
     if (! (send_to.empty() && recv_from.empty())) {
+        // With GPU-aware MPI, reduce on the device holding a valid instance,
+        // rather than copying it to host.
+        int device = tileSourceDevice( i, j );
+        if (device != HostNum) {
+            tileGetForReading(i, j, device, LayoutConvert(layout));
+
+            auto Aij = at(i, j, device);
+            blas::Queue* queue = comm_queue( device );
+
+            // Stored dimensions.
+            bool is_col = (Aij.op() == Op::NoTrans)
+                          == (Aij.layout() == Layout::ColMajor);
+            int64_t mb = is_col ? Aij.mb() : Aij.nb();
+            int64_t nb = is_col ? Aij.nb() : Aij.mb();
+            scalar_t* data = storage_->allocWorkspaceBuffer( device, mb*nb );
+            Tile<scalar_t> tile( Aij, data, mb, TileKind::Workspace );
+
+            // Receive, accumulate.
+            for (int src : recv_from) {
+                tile.recv(new_vec[src], mpi_comm_, layout, tag);
+                tileGetForWriting(i, j, device, LayoutConvert(layout));
+                device::geadd( mb, nb, one, data, mb,
+                               one, Aij.data(), Aij.stride(), *queue );
+                queue->sync();
+            }
+            storage_->releaseWorkspaceBuffer( data, device );
+
+            // Forward.
+            if (! send_to.empty())
+                Aij.send(new_vec[send_to.front()], mpi_comm_, tag);
+            return;
+        }
+
         // read tile on host memory
         tileGetForReading(i, j, LayoutConvert(layout));
 
@@ -2475,8 +4066,22 @@ void BaseMatrix<scalar_t>::tileCopyDataLayout(Tile<scalar_t>* src_tile,
     int dst_device = dst_tile->device();
     int work_device = ( dst_device == HostNum ? src_device : dst_device );
 
+    int64_t tile_bytes = mb * nb * sizeof( scalar_t );
+    if (dst_device != HostNum) {
+        internal::count( internal::Count::TilesToDevice );
+        internal::count( internal::Count::BytesToDevice, tile_bytes );
+        storage_->coherenceCount( CoherenceEvent::ToDevice );
+    }
+    else if (src_device != HostNum) {
+        internal::count( internal::Count::TilesToHost );
+        internal::count( internal::Count::BytesToHost, tile_bytes );
+        storage_->coherenceCount( CoherenceEvent::ToHost );
+    }
+
     Layout src_layout = src_tile->layout();
     bool need_convert = src_layout != target_layout;
+    if (need_convert)
+        storage_->coherenceCount( CoherenceEvent::LayoutConversion );
 
     // A race condition can occur when doing GPU->GPU transfers because we only
     // use the queue for one of the devices
@@ -2587,6 +4192,9 @@ template <typename scalar_t>
 void BaseMatrix<scalar_t>::tileAcquire(int64_t i, int64_t j, int device,
                                        Layout layout)
 {
+    // The received data may overwrite an existing instance.
+    storage_->tileCowDetach( globalIndex( i, j ) );
+
     auto tile = storage_->tileInsert( globalIndex(i, j, device),
                                       TileKind::Workspace, layout );
 
@@ -2644,6 +4252,10 @@ void BaseMatrix<scalar_t>::tileGet(int64_t i, int64_t j, int dst_device,
     // todo: need to acquire read access to the TilesMap
     // LockGuard guard2(storage_->getTilesMapLock());
 
+    tileMaterialize( i, j );
+    if (modify)
+        storage_->tileCowDetach( globalIndex( i, j ) );
+
     Tile<scalar_t>* src_tile = nullptr;
     // default value to silence compiler warning will be overridden below
     Layout target_layout = Layout::ColMajor;
@@ -2657,14 +4269,18 @@ void BaseMatrix<scalar_t>::tileGet(int64_t i, int64_t j, int dst_device,
     // acquire write access to the (i, j) TileNode
     LockGuard guard(tile_node.getLock());
 
-    if ((! tile_node.existsOn(dst_device)) ||
-        (  tile_node[dst_device]->state() == MOSI::Invalid)) {
+    bool hit = tile_node.existsOn(dst_device)
+               && tile_node[dst_device]->state() != MOSI::Invalid;
+    storage_->tileCacheAccess( globalIndex(i, j, dst_device), hit );
+    if (hit)
+        storage_->coherenceCount( CoherenceEvent::Hit );
+
+    if (! hit) {
 
-        // find a valid source (Modified/Shared) tile
-        for (int d = num_devices()-1; d >= HostNum; --d) {
-            // Most current systems have higher GPU->GPU than GPU->CPU
-            // TODO Poll hardware topolgy to determine order
-            if (d != dst_device && tile_node.existsOn(d)) {
+        // find a valid source (Modified/Shared) tile, nearest first:
+        // peer devices by link speed, then host, then other devices.
+        for (int d : internal::peer_source_order( dst_device )) {
+            if (tile_node.existsOn(d)) {
                 if (tile_node[d]->state() != MOSI::Invalid) {
                     src_device = d;
                     src_tile = tile_node[d];
@@ -2837,6 +4453,70 @@ void BaseMatrix<scalar_t>::tileGetForReading(std::set<ij_tuple>& tile_set,
     tileGet(tile_set, device, layout, false, false, false);
 }
 
+//------------------------------------------------------------------------------
+/// Gets tile(i, j) for reading on device, like tileGetForReading, but
+/// returns once the copy is queued, without waiting for it.
+/// The tile is marked valid on the device immediately, so the caller must
+/// wait on the returned token before the tile is used, e.g., at the end of
+/// the task that other tasks depend on.
+///
+/// @param[in] i
+///     Tile's block row index. 0 <= i < mt.
+///
+/// @param[in] j
+///     Tile's block column index. 0 <= j < nt.
+///
+/// @param[in] device
+///     Tile's destination: host or device ID.
+///
+/// @param[in] layout
+///     Indicates whether to convert the Layout of the received data:
+///     - ColMajor: convert layout to column major.
+///     - RowMajor: convert layout to row major.
+///     - None: do not convert layout.
+///
+/// @return token to wait on for the copy to complete.
+///     For host, copies are synchronous and the token is already complete.
+///
+template <typename scalar_t>
+TileGetToken BaseMatrix<scalar_t>::tileGetForReadingAsync(
+    int64_t i, int64_t j, int device, LayoutConvert layout )
+{
+    tileGet( i, j, device, layout, false, false, true );
+    if (device == HostNum)
+        return TileGetToken();
+    return TileGetToken( comm_queue( device ) );
+}
+
+//------------------------------------------------------------------------------
+/// Gets a set of tiles for reading on device, returning once the copies
+/// are queued, without waiting for them.
+/// @see tileGetForReadingAsync
+///
+/// @param[in] tile_set
+///     Set of (i, j) tuples indicating indices of Tiles' to be acquired.
+///
+/// @param[in] device
+///     Tile's destination: host or device ID.
+///
+/// @param[in] layout
+///     Indicates whether to convert the Layout of the received data:
+///     - ColMajor: convert layout to column major.
+///     - RowMajor: convert layout to row major.
+///     - None: do not convert layout.
+///
+/// @return token to wait on for the copies to complete.
+///
+template <typename scalar_t>
+TileGetToken BaseMatrix<scalar_t>::tileGetForReadingAsync(
+    std::set<ij_tuple>& tile_set, int device, LayoutConvert layout )
+{
+    tileGet( tile_set, device, layout, false, false, true );
+    if (device == HostNum)
+        return TileGetToken();
+    return TileGetToken( comm_queue( device ) );
+}
+
 //------------------------------------------------------------------------------
 /// Gets tile(i, j) for writing on device.
 /// Sets destination tile's state to MOSI::Modified.
@@ -3193,6 +4873,10 @@ Tile<scalar_t> BaseMatrix<scalar_t>::tileUpdateOrigin(int64_t i, int64_t j)
 template <typename scalar_t>
 void BaseMatrix<scalar_t>::tileUpdateAllOrigin()
 {
+    // End of a routine: broadcasts so far may be skipped from now on.
+    if (! omp_in_parallel())
+        storage_->sessionCommit();
+
     std::set<ij_tuple> tiles_set_host;
     std::vector< std::set<ij_tuple> > tiles_set_dev(num_devices());
     for (int64_t j = 0; j < this->nt(); ++j) {
@@ -3299,6 +4983,9 @@ void BaseMatrix<scalar_t>::tileLayoutConvert(
     LockGuard guard( tile_node.getLock() );
     auto tile = tile_node[ device ];
     if (tile->layout() != layout) {
+        // Converting in place would change data shared by a snapshot.
+        storage_->tileCowDetach( globalIndex( i, j ) );
+        storage_->coherenceCount( CoherenceEvent::LayoutConversion );
         if (! tile->isTransposable()) {
             assert(! reset); // Can't change to ext buffer then reset
             storage_->tileMakeTransposable(tile);
@@ -3312,7 +4999,15 @@ void BaseMatrix<scalar_t>::tileLayoutConvert(
             work_data = storage_->allocWorkspaceBuffer(tile->device(),
                                                        tile->mb()*tile->nb());
 
-        if (tile->device() == HostNum) {
+        if (need_workspace && tile->device() != HostNum
+            && tile->allocated() && tile->isUserContiguous()) {
+            // transpose into the workspace, which becomes the tile's buffer;
+            // the old buffer is released once the kernel finishes
+            lapack::Queue* queue = comm_queue(tile->device());
+            work_data = tile->layoutConvertInto(work_data, *queue);
+            queue->sync();
+        }
+        else if (tile->device() == HostNum) {
             tile->layoutConvert(work_data);
         }
         else {
@@ -3386,6 +5081,9 @@ void BaseMatrix<scalar_t>::tileLayoutConvert(
 
         BatchedTilesBuckets tilesBuckets;
 
+        // workspaces and old tile buffers, released once the kernels finish
+        std::vector<scalar_t*> release_data;
+
         for (auto iter = tile_set.begin(); iter != tile_set.end(); ++iter) {
             int64_t i = std::get<0>(*iter);
             int64_t j = std::get<1>(*iter);
@@ -3395,32 +5093,57 @@ void BaseMatrix<scalar_t>::tileLayoutConvert(
 
             // if we need to convert layout
             if (tile->layout() != layout) {
+                // Converting in place would change data shared by a snapshot.
+                storage_->tileCowDetach( globalIndex( i, j ) );
+
                 // make sure tile is transposable
                 if (! tile->isTransposable()) {
                     storage_->tileMakeTransposable(tile);
                 }
+                // Rectangular SLATE allocated tiles are transposed
+                // out-of-place into a new buffer, which replaces the
+                // tile's buffer, instead of copying to a workspace and
+                // transposing back.
+                bool swap = mb != nb && ! tile->extended()
+                            && tile->allocated() && tile->isUserContiguous();
+                scalar_t* old_data = tile->data();
+
                 tile->setLayout( layout );
 
                 int64_t work_stride = (layout == Layout::ColMajor) ? nb : mb;
 
                 // bucket index
-                mnss_tuple mns = {mb, nb, tile->extended(), tile->stride(),
+                mnss_tuple mns = {mb, nb, tile->extended() || swap,
+                                  tile->stride(),
                                   mb != nb
                                     ? (tile->extended()
                                         ? tile->layoutBackStride() : work_stride)
                                     : 0};
 
+                if (swap) {
+                    tile->replaceData(
+                        storage_->allocWorkspaceBuffer(device, mb*nb) );
+                    release_data.push_back( old_data );
+                }
+
                 // add this tile's data to the corrsponding bucket of batch array
                 tilesBuckets[mns].first.push_back(tile->data());
 
                 // if rectangular, prepare a workspace
                 if (mb != nb) {
-                    if (tile->extended())
+                    if (swap) {
+                        tilesBuckets[mns].second.push_back( old_data );
+                    }
+                    else if (tile->extended()) {
                         tilesBuckets[mns].second.push_back(
                             tile->layoutBackData());
-                    else
-                        tilesBuckets[mns].second.push_back(
-                            storage_->allocWorkspaceBuffer(device, mb*nb) );
+                    }
+                    else {
+                        scalar_t* work_data
+                            = storage_->allocWorkspaceBuffer(device, mb*nb);
+                        tilesBuckets[mns].second.push_back( work_data );
+                        release_data.push_back( work_data );
+                    }
                 }
             }
         }
@@ -3463,8 +5186,10 @@ void BaseMatrix<scalar_t>::tileLayoutConvert(
             // }
             // else
 
-            blas::device_memcpy<scalar_t*>(
-                array_dev, bucket->second.first.data(), batch_count, *queue );
+            storage_->batchArrayUpload(
+                device, 0, bucket->second.first.data(), batch_count, *queue );
+            storage_->coherenceCount( CoherenceEvent::LayoutConversion,
+                                      batch_count );
 
             if (mb == nb) {
                 // in-place transpose
@@ -3475,9 +5200,9 @@ void BaseMatrix<scalar_t>::tileLayoutConvert(
             }
             else {
                 // rectangular tiles: out-of-place transpose
-                blas::device_memcpy<scalar_t*>(
-                    work_array_dev, bucket->second.second.data(),
-                    batch_count, *queue );
+                storage_->batchArrayUpload(
+                    device, 0, bucket->second.second.data(),
+                    batch_count, *queue, batch_count );
 
                 if (! extended) {
                     // copy back to data buffer
@@ -3496,20 +5221,14 @@ void BaseMatrix<scalar_t>::tileLayoutConvert(
                                         batch_count, *queue);
             }
 
-            // release workspace buffer if allocated
-            if ((mb != nb) && (! extended)) {
-                queue->sync();
-
-                for (auto iter  = bucket->second.second.begin();
-                          iter != bucket->second.second.end();
-                          ++iter) {
-                    storage_->releaseWorkspaceBuffer(*iter, device);
-                }
-            }
         }
 
         queue->sync();
 
+        for (auto data : release_data) {
+            storage_->releaseWorkspaceBuffer(data, device);
+        }
+
         if (reset) {
             for (auto iter = tile_set.begin(); iter != tile_set.end(); ++iter) {
                 // #pragma omp task default(none)
@@ -3884,6 +5603,150 @@ void BaseMatrix<scalar_t>::releaseLocalWorkspaceTile(int64_t i, int64_t j)
     }
 }
 
+//------------------------------------------------------------------------------
+/// If tile(i, j) is a memory-mapped origin tile (TileKind::FileMapped),
+/// starts reading it from its file asynchronously, ahead of its use.
+/// No-op for other tiles.
+///
+/// @param[in] i
+///     Tile's block row index. 0 <= i < mt.
+///
+/// @param[in] j
+///     Tile's block column index. 0 <= j < nt.
+///
+template <typename scalar_t>
+void BaseMatrix<scalar_t>::tilePrefetchMapped( int64_t i, int64_t j )
+{
+    if (storage_->hasMappedFiles() && tileIsLocal( i, j )
+        && tileExists( i, j, HostNum )) {
+        storage_->tilePrefetchMapped( storage_->at( globalIndex( i, j, HostNum ) ) );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// If tile(i, j) is a memory-mapped origin tile (TileKind::FileMapped),
+/// starts writing it back to its file and lets the OS drop it from memory,
+/// after its last use for a while. The tile remains valid.
+/// No-op for other tiles.
+///
+/// @param[in] i
+///     Tile's block row index. 0 <= i < mt.
+///
+/// @param[in] j
+///     Tile's block column index. 0 <= j < nt.
+///
+template <typename scalar_t>
+void BaseMatrix<scalar_t>::tileFlushMapped( int64_t i, int64_t j )
+{
+    if (storage_->hasMappedFiles() && tileIsLocal( i, j )
+        && tileExists( i, j, HostNum )) {
+        storage_->tileFlushMapped( storage_->at( globalIndex( i, j, HostNum ) ) );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Prefetches all local memory-mapped tiles.
+/// @see tilePrefetchMapped
+///
+template <typename scalar_t>
+void BaseMatrix<scalar_t>::prefetchMapped()
+{
+    if (! storage_->hasMappedFiles())
+        return;
+    for (int64_t j = 0; j < this->nt(); ++j) {
+        for (int64_t i = 0; i < this->mt(); ++i) {
+            tilePrefetchMapped( i, j );
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Flushes all local memory-mapped tiles.
+/// @see tileFlushMapped
+///
+template <typename scalar_t>
+void BaseMatrix<scalar_t>::flushMapped()
+{
+    if (! storage_->hasMappedFiles())
+        return;
+    for (int64_t j = 0; j < this->nt(); ++j) {
+        for (int64_t i = 0; i < this->mt(); ++i) {
+            tileFlushMapped( i, j );
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Zeros the given host tiles in parallel, so that under the OS's first-touch
+/// policy each tile's pages are placed in the NUMA domain of the thread that
+/// touched it. Tiles are split into contiguous chunks over threads, so with
+/// OMP_PROC_BIND=close or spread, neighboring tiles share a NUMA domain.
+/// Tiles must not have been written yet.
+///
+template <typename scalar_t>
+void BaseMatrix<scalar_t>::firstTouchHostTiles(
+    std::vector<ij_tuple> const& tiles )
+{
+    int64_t ntiles = tiles.size();
+
+    #pragma omp parallel for schedule(static)
+    for (int64_t t = 0; t < ntiles; ++t) {
+        int64_t i = std::get<0>( tiles[ t ] );
+        int64_t j = std::get<1>( tiles[ t ] );
+        Tile<scalar_t> T = at( i, j, HostNum );
+        // by stored (column-major) columns; tiles in an arena have stride > mb
+        int64_t mb = T.op() == Op::NoTrans ? T.mb() : T.nb();
+        int64_t nb = T.op() == Op::NoTrans ? T.nb() : T.mb();
+        for (int64_t jj = 0; jj < nb; ++jj)
+            std::fill_n( T.data() + jj*T.stride(), mb, scalar_t( 0 ) );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Inserts the given local tiles on host in one contiguous arena,
+/// allocated by MatrixStorage::allocArena, laid out like a ScaLAPACK local
+/// matrix: column-major, with the local block rows stacked in order and
+/// the local block columns side by side in order, so tile (i, j) starts at
+/// row offset of block row i plus arenaStride() times column offset of
+/// block column j. Tiles are user-owned views into the arena.
+/// Requires op(A) = NoTrans and column-major layout.
+///
+template <typename scalar_t>
+void BaseMatrix<scalar_t>::insertHostTilesArena(
+    std::vector<ij_tuple> const& tiles )
+{
+    slate_assert( op() == Op::NoTrans );
+    slate_assert( layout() == Layout::ColMajor );
+    if (tiles.empty())
+        return;
+
+    // Offsets of local block rows and cols, in index order.
+    std::map< int64_t, int64_t > row_offset, col_offset;
+    for (auto ij : tiles) {
+        row_offset[ std::get<0>( ij ) ] = 0;
+        col_offset[ std::get<1>( ij ) ] = 0;
+    }
+    int64_t lld = 0;
+    for (auto& row : row_offset) {
+        row.second = lld;
+        lld += tileMb( row.first );
+    }
+    int64_t nloc = 0;
+    for (auto& col : col_offset) {
+        col.second = nloc;
+        nloc += tileNb( col.first );
+    }
+    lld = std::max( lld, int64_t( 1 ) );
+
+    scalar_t* data = storage_->allocArena( lld * nloc, lld );
+    for (auto ij : tiles) {
+        int64_t i = std::get<0>( ij );
+        int64_t j = std::get<1>( ij );
+        tileInsert( i, j, HostNum,
+                    &data[ row_offset[ i ] + col_offset[ j ]*lld ], lld );
+    }
+}
+
 //------------------------------------------------------------------------------
 /// Erases all local workspace tiles, if not on hold or modified.
 ///
@@ -3946,6 +5809,10 @@ void BaseMatrix<scalar_t>::releaseRemoteWorkspaceTile(
 template <typename scalar_t>
 void BaseMatrix<scalar_t>::releaseRemoteWorkspace( int64_t release_count )
 {
+    // End of a routine: broadcasts so far may be skipped from now on.
+    if (! omp_in_parallel())
+        storage_->sessionCommit();
+
     for (int64_t j = 0; j < nt(); ++j) {
         for (int64_t i = 0; i < mt(); ++i) {
             releaseRemoteWorkspaceTile( i, j, release_count );
@@ -93,12 +93,17 @@ public:
     int64_t getMaxHostTiles();
     int64_t getMaxDeviceTiles(int device);
     int64_t getMaxDeviceTiles();
+    std::vector<int64_t> getLocalDeviceTiles();
     void allocateBatchArrays(int64_t batch_size=0, int64_t num_arrays=1);
     void reserveHostWorkspace();
+    void reserveHostWorkspace(int64_t num_tiles);
     void reserveDeviceWorkspace();
+    void reserveDeviceWorkspace(std::vector<int64_t> const& num_tiles);
     void gather(scalar_t* A, int64_t lda);
     Uplo uplo_logical() const { return this->uploLogical(); }  ///< @deprecated
-    void insertLocalTiles(Target origin=Target::Host);
+    void insertLocalTiles(Target origin=Target::Host,
+                          Options const& opts = Options());
+    void insertLocalTilesMapped(std::string const& filename);
     void insertLocalTiles(bool on_devices);
 
     void tileGetAllForReading(int device, LayoutConvert layout);
@@ -596,9 +601,20 @@ int64_t BaseTrapezoidMatrix<scalar_t>::getMaxDeviceTiles(int device)
 }
 
 //------------------------------------------------------------------------------
-/// Returns number of local tiles of the matrix on this rank and given device.
+/// Returns the largest number of local tiles of the matrix on this rank for
+/// any devices.
 template <typename scalar_t>
 int64_t BaseTrapezoidMatrix<scalar_t>::getMaxDeviceTiles()
+{
+    std::vector<int64_t> num_tiles = getLocalDeviceTiles();
+    return *std::max_element( num_tiles.begin(), num_tiles.end() );
+}
+
+//------------------------------------------------------------------------------
+/// Returns the number of local tiles of the matrix on this rank for
+/// each device, inside the upper or lower trapezoid.
+template <typename scalar_t>
+std::vector<int64_t> BaseTrapezoidMatrix<scalar_t>::getLocalDeviceTiles()
 {
     std::vector<int64_t> num_tiles( this->num_devices() );
     if (this->uplo() == Uplo::Lower) {
@@ -613,7 +629,7 @@ int64_t BaseTrapezoidMatrix<scalar_t>::getMaxDeviceTiles()
                 if (this->tileIsLocal(i, j))
                     num_tiles[ this->tileDevice( i, j ) ] += 1;
     }
-    return *std::max_element( num_tiles.begin(), num_tiles.end() );
+    return num_tiles;
 }
 
 //------------------------------------------------------------------------------
@@ -649,11 +665,32 @@ void BaseTrapezoidMatrix<scalar_t>::reserveHostWorkspace()
 }
 
 //------------------------------------------------------------------------------
-/// Reserve space for temporary workspace tiles on all GPU devices.
+/// Reserve space for num_tiles temporary workspace tiles on host.
+/// If there are GPU devices, these are in pinned memory, for staging
+/// asynchronous transfers to and from devices.
+template <typename scalar_t>
+void BaseTrapezoidMatrix<scalar_t>::reserveHostWorkspace(int64_t num_tiles)
+{
+    this->storage_->reserveHostWorkspace( num_tiles );
+}
+
+//------------------------------------------------------------------------------
+/// Reserve space for temporary workspace tiles on all GPU devices,
+/// as many on each device as its local tiles.
 template <typename scalar_t>
 void BaseTrapezoidMatrix<scalar_t>::reserveDeviceWorkspace()
 {
-    this->storage_->reserveDeviceWorkspace( getMaxDeviceTiles() );
+    this->storage_->reserveDeviceWorkspace( getLocalDeviceTiles() );
+}
+
+//------------------------------------------------------------------------------
+/// Reserve space for num_tiles[ device ] temporary workspace tiles on each
+/// GPU device, e.g., as planned by slate::plan.
+template <typename scalar_t>
+void BaseTrapezoidMatrix<scalar_t>::reserveDeviceWorkspace(
+    std::vector<int64_t> const& num_tiles)
+{
+    this->storage_->reserveDeviceWorkspace( num_tiles );
 }
 
 //------------------------------------------------------------------------------
@@ -847,23 +884,104 @@ void BaseTrapezoidMatrix<scalar_t>::tileUpdateAllOrigin()
 ///     - if target = Devices, inserts tiles on appropriate GPU devices, or
 ///     - if target = Host,    inserts tiles on CPU host.
 ///
+/// @param[in] opts
+///     Additional options, as map of name = value pairs. Possible options:
+///     - Option::HostFirstTouch:
+///       Whether to zero host tiles in parallel, so each is first touched,
+///       and hence placed in the NUMA domain of, one of the threads that
+///       later update it, instead of all by the calling thread.
+///       Default false.
+///     - Option::HostTileArena:
+///       Whether to put host tiles in one contiguous arena, in column-major
+///       ScaLAPACK order, instead of allocating each tile separately.
+///       @see arenaData. Default false.
+///
 template <typename scalar_t>
-void BaseTrapezoidMatrix<scalar_t>::insertLocalTiles(Target origin)
+void BaseTrapezoidMatrix<scalar_t>::insertLocalTiles(Target origin, Options const& opts)
 {
     this->origin_ = origin;
     bool on_devices = (origin == Target::Devices);
     if (on_devices)
         reserveDeviceWorkspace();
 
+    bool first_touch = ! on_devices
+                       && get_option( opts, Option::HostFirstTouch, false );
+    bool arena = ! on_devices
+                 && get_option( opts, Option::HostTileArena, false );
+    std::vector< ij_tuple > host_tiles;
+
+    int64_t mt = this->mt();
+    for (int64_t j = 0; j < this->nt(); ++j) {
+        int64_t istart = (this->uplo() == Uplo::Lower ? j : 0);
+        int64_t iend   = (this->uplo() == Uplo::Lower ? mt : std::min( j+1, mt ));
+        for (int64_t i = istart; i < iend; ++i) {
+            if (this->tileIsLocal(i, j)) {
+                if (arena) {
+                    // inserted below, once the arena size is known
+                    host_tiles.push_back( { i, j } );
+                }
+                else {
+                    int dev = (on_devices ? this->tileDevice(i, j)
+                                          : HostNum);
+                    this->tileInsert(i, j, dev);
+                    if (first_touch)
+                        host_tiles.push_back( { i, j } );
+                }
+            }
+        }
+    }
+
+    if (arena)
+        this->insertHostTilesArena( host_tiles );
+    if (first_touch)
+        this->firstTouchHostTiles( host_tiles );
+}
+
+//------------------------------------------------------------------------------
+/// Inserts all local tiles into an empty matrix, as origin tiles in a
+/// memory-mapped file on host (TileKind::FileMapped), so the matrix can
+/// exceed host memory. Pages are read from the file when tiles are first
+/// accessed; tilePrefetchMapped and tileFlushMapped help overlap the I/O.
+/// Each rank maps its own file, filename.rank, which is created if it does
+/// not exist. Existing contents are kept, so a matrix can be mapped again,
+/// with the same dimensions and distribution, to read it back.
+/// Each local tile occupies a slot of the largest tile size, in
+/// column-major order of tiles; elements within a tile are column major.
+///
+/// @param[in] filename
+///     Prefix of file name.
+///
+template <typename scalar_t>
+void BaseTrapezoidMatrix<scalar_t>::insertLocalTilesMapped(std::string const& filename)
+{
+    this->origin_ = Target::Host;
+
+    int64_t num_tiles = 0;
     int64_t mt = this->mt();
+    for (int64_t j = 0; j < this->nt(); ++j) {
+        int64_t istart = (this->uplo() == Uplo::Lower ? j : 0);
+        int64_t iend   = (this->uplo() == Uplo::Lower ? mt : std::min( j+1, mt ));
+        for (int64_t i = istart; i < iend; ++i) {
+            num_tiles += this->tileIsLocal(i, j);
+        }
+    }
+    if (num_tiles == 0)
+        return;
+
+    std::string rank_filename = filename + "." + std::to_string( this->mpiRank() );
+    scalar_t* data = this->storage_->mapFile( rank_filename, num_tiles );
+    int64_t slot = this->storage_->maxTileSize();
     for (int64_t j = 0; j < this->nt(); ++j) {
         int64_t istart = (this->uplo() == Uplo::Lower ? j : 0);
         int64_t iend   = (this->uplo() == Uplo::Lower ? mt : std::min( j+1, mt ));
         for (int64_t i = istart; i < iend; ++i) {
             if (this->tileIsLocal(i, j)) {
-                int dev = (on_devices ? this->tileDevice(i, j)
-                                      : HostNum);
-                this->tileInsert(i, j, dev);
+                auto index = this->globalIndex( i, j );
+                int64_t lda = this->layout() == Layout::ColMajor
+                            ? this->storage_->tileMb( std::get<0>( index ) )
+                            : this->storage_->tileNb( std::get<1>( index ) );
+                this->storage_->tileInsertMapped( index, data, lda, this->layout() );
+                data += slot;
             }
         }
     }
@@ -211,6 +211,7 @@ void BaseTriangularBandMatrix<scalar_t>::bandwidth(int64_t kd)
         this->kl_ = kd;
     else
         this->ku_ = kd;
+    this->growBand();
 }
 
 //------------------------------------------------------------------------------
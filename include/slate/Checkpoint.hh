@@ -0,0 +1,87 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef SLATE_CHECKPOINT_HH
+#define SLATE_CHECKPOINT_HH
+
+#include <cstdint>
+#include <exception>
+#include <string>
+#include <thread>
+
+#include "slate/internal/mpi.hh"
+#include "slate/types.hh"
+
+namespace slate {
+
+template <typename scalar_t>
+class BaseMatrix;
+
+//------------------------------------------------------------------------------
+/// Checkpoint and restart of factorizations in progress. Pass a pointer
+/// in Options to getrf (partial pivoting) or potrf:
+///
+///     slate::Checkpoint checkpoint( "/scratch/lu.ckpt", 16 );
+///     slate::getrf( A, pivots, {{ slate::Option::Checkpoint, &checkpoint }} );
+///
+/// Every interval block steps, the routine waits for the steps so far to
+/// finish, copies the matrix to host memory, and writes it in the SLATE
+/// matrix file format (@see write) with the pivots and step in a
+/// separate thread, while the next steps compute. Files alternate between
+/// filename.0 and filename.1; filename.meta, replaced last, names the
+/// complete one, so a failure while writing leaves the previous
+/// checkpoint intact.
+///
+/// If filename.meta exists when the routine starts, the matrix, pivots,
+/// and step are restored from the checkpoint, and the factorization
+/// continues from the step after the last checkpoint. The matrix must
+/// have the same size and tiles as when checkpointed; its initial values
+/// are ignored. Files are removed when the routine finishes.
+///
+/// Writes use a duplicate of the matrix's MPI communicator, so they
+/// overlap the routine's own communication.
+///
+class Checkpoint {
+public:
+    Checkpoint( std::string const& filename, int64_t interval );
+    ~Checkpoint();
+
+    Checkpoint( Checkpoint const& ) = delete;
+    Checkpoint& operator = ( Checkpoint const& ) = delete;
+
+    std::string const& filename() const { return filename_; }
+    int64_t interval() const { return interval_; }
+
+    /// @return whether to checkpoint before block step k.
+    bool due( int64_t k ) const
+    {
+        return interval_ > 0 && k > 0 && k % interval_ == 0;
+    }
+
+    template <typename scalar_t>
+    int64_t restore( BaseMatrix<scalar_t>& A, Pivots* pivots, int64_t* info );
+
+    template <typename scalar_t>
+    void save( BaseMatrix<scalar_t>& A, Pivots const* pivots,
+               int64_t k, int64_t info );
+
+    void wait();
+
+    void remove( MPI_Comm mpi_comm );
+
+private:
+    MPI_Comm writerComm( MPI_Comm mpi_comm );
+
+    std::string filename_;
+    int64_t interval_;
+    int generation_;
+    MPI_Comm comm_;
+    std::thread writer_;
+    std::exception_ptr error_;
+};
+
+} // namespace slate
+
+#endif // SLATE_CHECKPOINT_HH
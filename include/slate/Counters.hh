@@ -0,0 +1,354 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef SLATE_COUNTERS_HH
+#define SLATE_COUNTERS_HH
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "slate/internal/mpi.hh"
+
+namespace slate {
+
+//------------------------------------------------------------------------------
+/// Performance counters of one phase of a routine, e.g., "gesv::getrf".
+/// @see Counters
+///
+struct PhaseCounters {
+    /// @return rate in Gflop/s, or 0 if no time was recorded.
+    double gflops() const
+    {
+        return time > 0 ? flops / time * 1e-9 : 0;
+    }
+
+    /// @return bytes moved: received over MPI or NCCL (each message is
+    /// counted once, by its receiver), plus copied between host and devices.
+    int64_t bytesMoved() const
+    {
+        return bytes_recv + bytes_to_device + bytes_to_host;
+    }
+
+    /// @return rate of bytes moved in Gbyte/s, or 0 if no time was recorded.
+    double gbytes() const
+    {
+        return time > 0 ? bytesMoved() / time * 1e-9 : 0;
+    }
+
+    /// @return arithmetic intensity, in flops per byte moved, or 0 if no
+    /// bytes were moved. Bytes moved are communication and host-device
+    /// transfers, not memory traffic within a node, so this is the
+    /// intensity with respect to the network and the host-device links.
+    double intensity() const
+    {
+        return bytesMoved() > 0 ? flops / bytesMoved() : 0;
+    }
+
+    /// @return average number of tiles per batched BLAS launch.
+    double batchSizeAvg() const
+    {
+        return batch_launches > 0 ? double( batch_tiles ) / batch_launches : 0;
+    }
+
+    /// @return average size in bytes of the messages sent, or 0 if none.
+    double messageSizeAvg() const
+    {
+        return messages_sent > 0 ? double( bytes_sent ) / messages_sent : 0;
+    }
+
+    /// @return ratio of raw to sent bytes of compressed tiles, or 0 if none.
+    double compressionRatio() const
+    {
+        return compress_wire_bytes > 0
+               ? double( compress_raw_bytes ) / compress_wire_bytes : 0;
+    }
+
+    /// @return rate of compression, in Gbyte/s of raw tiles per rank,
+    /// or 0 if no time was recorded.
+    double compressGbytes() const
+    {
+        return compress_time > 0 ? compress_raw_bytes / compress_time * 1e-9 : 0;
+    }
+
+    /// @return rate of decompression, in Gbyte/s of raw tiles per rank,
+    /// or 0 if no time was recorded.
+    double decompressGbytes() const
+    {
+        return decompress_time > 0 ? decompress_bytes / decompress_time * 1e-9
+                                   : 0;
+    }
+
+    /// Accumulates other, e.g., from another call of the same phase.
+    PhaseCounters& operator += ( PhaseCounters const& other )
+    {
+        calls              += other.calls;
+        time               += other.time;
+        flops              += other.flops;
+        bytes_sent         += other.bytes_sent;
+        bytes_recv         += other.bytes_recv;
+        messages_sent      += other.messages_sent;
+        tiles_to_device    += other.tiles_to_device;
+        tiles_to_host      += other.tiles_to_host;
+        bytes_to_device    += other.bytes_to_device;
+        bytes_to_host      += other.bytes_to_host;
+        layout_conversions += other.layout_conversions;
+        layout_avoided     += other.layout_avoided;
+        batch_launches     += other.batch_launches;
+        batch_tiles        += other.batch_tiles;
+        tile_hits          += other.tile_hits;
+        tile_invalidations += other.tile_invalidations;
+        compress_raw_bytes  += other.compress_raw_bytes;
+        compress_wire_bytes += other.compress_wire_bytes;
+        compress_time       += other.compress_time;
+        decompress_bytes    += other.decompress_bytes;
+        decompress_time     += other.decompress_time;
+        return *this;
+    }
+
+    int64_t calls              = 0; ///< number of times the phase ran
+    double  time               = 0; ///< wall time, in seconds
+    double  flops              = 0; ///< flops of the whole distributed operation
+    int64_t bytes_sent         = 0; ///< bytes sent over MPI or NCCL
+    int64_t bytes_recv         = 0; ///< bytes received over MPI or NCCL
+    int64_t messages_sent      = 0; ///< point-to-point messages sent over
+                                    ///< MPI or NCCL
+    int64_t tiles_to_device    = 0; ///< tiles copied host to device
+    int64_t tiles_to_host      = 0; ///< tiles copied device to host
+    int64_t bytes_to_device    = 0; ///< bytes copied host to device
+    int64_t bytes_to_host      = 0; ///< bytes copied device to host
+    int64_t layout_conversions = 0; ///< tile layout conversions
+    int64_t layout_avoided     = 0; ///< tile layout conversions avoided by
+                                    ///< computing on row-major tiles
+    int64_t batch_launches     = 0; ///< batched BLAS launches
+    int64_t batch_tiles        = 0; ///< tiles in batched BLAS launches
+    int64_t tile_hits          = 0; ///< tileGet found the tile valid; needs
+                                    ///< SLATE_COHERENCE_COUNTERS
+    int64_t tile_invalidations = 0; ///< instances invalidated by tileModified;
+                                    ///< needs SLATE_COHERENCE_COUNTERS
+    int64_t compress_raw_bytes  = 0; ///< raw bytes of compressed tiles sent
+    int64_t compress_wire_bytes = 0; ///< bytes of those tiles on the wire
+    double  compress_time       = 0; ///< time compressing, in seconds,
+                                     ///< summed over threads and ranks
+    int64_t decompress_bytes    = 0; ///< raw bytes of compressed tiles received
+    double  decompress_time     = 0; ///< time decompressing, in seconds,
+                                     ///< summed over threads and ranks
+};
+
+//------------------------------------------------------------------------------
+/// Performance counters of SLATE routines, by phase. Pass a pointer in
+/// Options to collect them:
+///
+///     slate::Counters counters;
+///     slate::gesv( A, pivots, B, {{ slate::Option::Counters, &counters }} );
+///     counters.merge( MPI_COMM_WORLD );
+///     if (mpi_rank == 0)
+///         counters.print();
+///
+/// Phases are named like timers, e.g., "gesv", "gesv::getrf".
+/// Factorizations also count the phases of their steps, e.g.,
+/// "getrf::panel", "getrf::bcast", and "getrf::update", summed over steps.
+/// Counts of MPI bytes, tile transfers, etc., are process wide, so routines
+/// and phases running concurrently in different threads, e.g., the panel
+/// of step k+1 and the trailing update of step k, are counted in each
+/// other's phases. Phases running as several concurrent tasks, e.g., the
+/// trailing update, sum the time of the tasks.
+/// Counters are local to each rank until merged.
+///
+/// With logMessages( true ), the counters also log the destination and
+/// size of each point-to-point message, from Tile::isend, the tile
+/// broadcasts and reductions, and redistribute, giving a message size
+/// histogram and, after merge, the rank-by-rank communication matrix:
+///
+///     counters.logMessages( true );
+///     slate::gesv( A, pivots, B, {{ slate::Option::Counters, &counters }} );
+///     counters.merge( MPI_COMM_WORLD );
+///     if (mpi_rank == 0)
+///         counters.printMessages();
+///
+/// Ranks are those of the matrices' communicator, which must be the comm
+/// passed to merge. MPI_Bcast of Tile::bcast is collective, so it is
+/// counted in the bytes sent, but not logged as messages.
+///
+class Counters {
+public:
+    using PhaseMap = std::map< std::string, PhaseCounters >;
+
+    /// Number of bins of the message size histogram; bin k counts
+    /// messages of [ 2^k, 2^(k+1) ) bytes, bin 0 also empty messages, and
+    /// the last bin all larger messages.
+    static const int num_size_bins = 48;
+
+    /// @return counters of phase, added if needed.
+    PhaseCounters& operator [] ( std::string const& phase )
+    {
+        return phases_[ phase ];
+    }
+
+    PhaseMap const& phases() const { return phases_; }
+
+    void clear()
+    {
+        phases_.clear();
+        bytes_to_.clear();
+        comm_matrix_.clear();
+        size_histogram_.assign( num_size_bins, 0 );
+    }
+
+    /// Enables logging messages (see above). Default off.
+    void logMessages( bool enable ) { log_messages_ = enable; }
+
+    /// @return true if messages are logged.
+    bool logMessages() const { return log_messages_; }
+
+    /// Logs a message of bytes sent to rank dst; thread safe.
+    /// For internal use by internal::count_message.
+    void addMessage( int dst, int64_t bytes )
+    {
+        int bin = 0;
+        while (bin < num_size_bins - 1 && (bytes >> (bin + 1)) > 0)
+            ++bin;
+        std::lock_guard< std::mutex > guard( mutex_ );
+        bytes_to_[ dst ] += bytes;
+        size_histogram_[ bin ] += 1;
+    }
+
+    /// @return bytes this rank sent to each rank, by destination rank.
+    std::map< int, int64_t > const& bytesTo() const { return bytes_to_; }
+
+    /// @return message size histogram, num_size_bins counts; after merge,
+    /// summed over ranks.
+    std::vector< int64_t > const& sizeHistogram() const
+    {
+        return size_histogram_;
+    }
+
+    /// @return after merge, the p-by-p communication matrix, row-major:
+    /// entry ( src, dst ) is the bytes rank src sent to rank dst;
+    /// empty if messages are not logged.
+    std::vector< int64_t > const& commMatrix() const { return comm_matrix_; }
+
+    /// Adds counts to phase; thread safe, for phases counted in tasks.
+    void add( std::string const& phase, PhaseCounters const& counts )
+    {
+        std::lock_guard< std::mutex > guard( mutex_ );
+        phases_[ phase ] += counts;
+    }
+
+    void merge( MPI_Comm comm );
+
+    void print( FILE* file = stdout,
+                double peak_gflops = 0, double peak_gbytes = 0 ) const;
+
+    void printMessages( FILE* file = stdout ) const;
+
+private:
+    PhaseMap phases_;
+    std::mutex mutex_;
+    bool log_messages_ = false;
+    std::map< int, int64_t > bytes_to_;
+    std::vector< int64_t > size_histogram_ =
+        std::vector< int64_t >( num_size_bins, 0 );
+    std::vector< int64_t > comm_matrix_;
+};
+
+namespace internal {
+
+//------------------------------------------------------------------------------
+/// [internal]
+/// Process-wide counts, sampled by CounterPhase.
+///
+enum class Count {
+    BytesSent,
+    BytesRecv,
+    MessagesSent,
+    TilesToDevice,
+    TilesToHost,
+    BytesToDevice,
+    BytesToHost,
+    LayoutConversions,
+    LayoutConversionsAvoided,
+    BatchLaunches,
+    BatchTiles,
+    TileHits,
+    TileInvalidations,
+    CompressRawBytes,
+    CompressWireBytes,
+    CompressNanoseconds,
+    DecompressBytes,
+    DecompressNanoseconds,
+    NumCounts,
+};
+
+const int num_counts = int( Count::NumCounts );
+
+/// Number of active CounterPhase objects; counting is skipped if 0.
+extern std::atomic<int> counts_active;
+
+extern std::atomic<int64_t> counts[ num_counts ];
+
+/// Counters that log messages, set by the outermost CounterPhase of
+/// Counters with logMessages(); null if none.
+extern std::atomic<Counters*> message_log;
+
+//------------------------------------------------------------------------------
+/// [internal]
+/// Adds n to count kind, if any phase is being counted.
+///
+inline void count( Count kind, int64_t n = 1 )
+{
+    if (counts_active.load( std::memory_order_relaxed ) > 0)
+        counts[ int( kind ) ].fetch_add( n, std::memory_order_relaxed );
+}
+
+//------------------------------------------------------------------------------
+/// [internal]
+/// Counts a point-to-point message of bytes sent to rank dst, if any
+/// phase is being counted, and logs it if messages are logged.
+///
+inline void count_message( int dst, int64_t bytes )
+{
+    if (counts_active.load( std::memory_order_relaxed ) > 0) {
+        counts[ int( Count::BytesSent ) ].fetch_add(
+            bytes, std::memory_order_relaxed );
+        counts[ int( Count::MessagesSent ) ].fetch_add(
+            1, std::memory_order_relaxed );
+        Counters* log = message_log.load( std::memory_order_acquire );
+        if (log != nullptr)
+            log->addMessage( dst, bytes );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// [internal]
+/// Counts one phase of a routine: from construction to destruction,
+/// adds its wall time, flops, and the change in process-wide counts to
+/// counters[ phase ]. Does nothing if counters is null.
+///
+class CounterPhase {
+public:
+    CounterPhase( Counters* counters, char const* phase, double flops = 0 );
+    ~CounterPhase();
+
+    CounterPhase( CounterPhase const& ) = delete;
+    CounterPhase& operator = ( CounterPhase const& ) = delete;
+
+private:
+    Counters* counters_;
+    char const* phase_;
+    double flops_;
+    double start_;
+    int64_t start_counts_[ num_counts ];
+    bool logs_messages_;  ///< whether this phase set message_log
+};
+
+} // namespace internal
+} // namespace slate
+
+#endif // SLATE_COUNTERS_HH
@@ -0,0 +1,92 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef SLATE_DEVICE_GRAPH_HH
+#define SLATE_DEVICE_GRAPH_HH
+
+#include <blas.hh>
+
+#include <cstdint>
+
+namespace slate {
+
+//------------------------------------------------------------------------------
+/// CUDA or HIP graph of the work enqueued on one device queue, captured
+/// once and replayed with a single launch. Capturing removes the per-call
+/// host cost of building the work, e.g., kernel launches and batch arrays,
+/// for work repeated with the same shapes and pointers, such as device
+/// tile kernels or blas::batch calls on a matrix's compute queue.
+///
+/// Capturing again updates the launchable graph in place, if its topology
+/// is unchanged, which is much cheaper than instantiating it; this is how
+/// to replay the same work with new data pointers.
+///
+/// Work captured must be enqueued from the calling thread, on queue, and
+/// must not synchronize the queue, copy pageable host memory, or
+/// allocate memory. Hence SLATE drivers, which order their queues from
+/// host tasks and synchronize them, cannot be captured whole.
+///
+/// Example:
+///
+///     slate::DeviceGraph graph;
+///     graph.capture( queue, [&] {
+///         blas::batch::gemm( ..., queue );
+///     });
+///     for (int step = 0; step < num_steps; ++step) {
+///         // ... update data in place ...
+///         graph.launch( queue );
+///     }
+///     queue.sync();
+///
+class DeviceGraph {
+public:
+    DeviceGraph();
+    ~DeviceGraph();
+
+    DeviceGraph( DeviceGraph const& ) = delete;
+    DeviceGraph& operator = ( DeviceGraph const& ) = delete;
+
+    /// Captures the work func enqueues on queue, replacing or updating
+    /// the previous capture.
+    template <typename Func>
+    void capture( blas::Queue& queue, Func&& func )
+    {
+        beginCapture( queue );
+        try {
+            func();
+        }
+        catch (...) {
+            abortCapture( queue );
+            throw;
+        }
+        endCapture( queue );
+    }
+
+    void beginCapture( blas::Queue& queue );
+    void endCapture( blas::Queue& queue );
+    void launch( blas::Queue& queue );
+    void clear();
+
+    /// @return true if there is no captured graph to launch.
+    bool empty() const { return exec_ == nullptr; }
+
+    /// @return number of captures that updated the graph in place,
+    /// instead of instantiating it.
+    int64_t numUpdates() const { return num_updates_; }
+
+    static bool supported();
+
+private:
+    void abortCapture( blas::Queue& queue );
+
+    /// cudaGraphExec_t or hipGraphExec_t, kept opaque so this header
+    /// doesn't need the CUDA or HIP runtime headers.
+    void* exec_;
+    int64_t num_updates_;
+};
+
+} // namespace slate
+
+#endif // SLATE_DEVICE_GRAPH_HH
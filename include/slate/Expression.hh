@@ -0,0 +1,251 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef SLATE_EXPRESSION_HH
+#define SLATE_EXPRESSION_HH
+
+#include "slate/Matrix.hh"
+#include "slate/types.hh"
+
+#include <vector>
+
+namespace slate {
+
+//------------------------------------------------------------------------------
+/// One element-wise operation on a matrix B:
+///     B = alpha A + beta B,  if has_A and beta != 0;
+///     B = alpha A,           if has_A and beta == 0, without reading B;
+///     B = beta B,            if not has_A.
+/// @see elementwise
+///
+template <typename scalar_t>
+struct ElementwiseOp {
+    scalar_t alpha;
+    Matrix<scalar_t> A;
+    scalar_t beta;
+    Matrix<scalar_t> B;
+    bool has_A;
+};
+
+//------------------------------------------------------------------------------
+/// Runs a sequence of element-wise operations in one tile-wise pass:
+/// each local tile position (i, j) applies all the operations in order,
+/// after fetching the tiles once. All matrices must conform: the same
+/// tiles, on the same ranks and devices.
+///
+template <typename scalar_t>
+void elementwise(
+    std::vector< ElementwiseOp<scalar_t> >& ops,
+    Options const& opts = Options());
+
+namespace impl {
+
+//------------------------------------------------------------------------------
+/// @internal
+/// @return whether A and B have the same tiles, on the same ranks
+/// and devices, so a tile-wise pass can run over both.
+///
+template <typename scalar_t>
+bool elementwise_conforming( Matrix<scalar_t>& A, Matrix<scalar_t>& B )
+{
+    if (A.m() != B.m() || A.n() != B.n()
+        || A.mt() != B.mt() || A.nt() != B.nt())
+        return false;
+    for (int64_t i = 0; i < A.mt(); ++i) {
+        if (A.tileMb( i ) != B.tileMb( i ))
+            return false;
+    }
+    for (int64_t j = 0; j < A.nt(); ++j) {
+        if (A.tileNb( j ) != B.tileNb( j ))
+            return false;
+        for (int64_t i = 0; i < A.mt(); ++i) {
+            if (A.tileRank( i, j ) != B.tileRank( i, j )
+                || A.tileDevice( i, j ) != B.tileDevice( i, j ))
+                return false;
+        }
+    }
+    return true;
+}
+
+} // namespace impl
+
+//==============================================================================
+/// Lazy expression of BLAS-3 and element-wise operations on Matrix objects.
+/// The operations are recorded, then run by execute, in order, as if each
+/// were called separately, but with fewer passes over the matrices:
+///
+/// - Consecutive element-wise operations, add, scale, and copy, on
+///   conforming matrices run in one tile-wise pass (see elementwise),
+///   with one OpenMP region, each tile fetched once, and, on devices,
+///   the kernels queued back to back with one synchronization.
+///
+/// - Element-wise operations after a gemm that update its output C are
+///   fused into it: scale( s, C ) multiplies the gemm's alpha and beta,
+///   and add( a, E, b, C ) runs, with its coefficient, in the element-wise
+///   pass before the gemm, C = a E + (b beta) C, instead of in a pass after
+///   it, and the gemm then accumulates into C.
+///
+/// Matrices are shallow copied, so they must not be freed before execute.
+/// Outputs of one operation may be inputs of later ones.
+///
+/// Example, C = alpha A B + beta C; D = C + E; D = s D:
+///
+///     slate::Expression<double> expr;
+///     expr.gemm( alpha, A, B, beta, C )
+///         .copy( C, D )
+///         .add( 1.0, E, 1.0, D )
+///         .scale( s, D );
+///     expr.execute( opts );
+///
+/// Here the copy, add, and scale run in one pass after the gemm.
+///
+template <typename scalar_t>
+class Expression {
+public:
+    /// Records C = alpha A B + beta C, as slate::gemm.
+    Expression& gemm(
+        scalar_t alpha, Matrix<scalar_t>& A, Matrix<scalar_t>& B,
+        scalar_t beta,  Matrix<scalar_t>& C )
+    {
+        Step step;
+        step.is_gemm = true;
+        step.gemm = { alpha, A, B, beta, C };
+        steps_.push_back( step );
+        return *this;
+    }
+
+    /// Records B = alpha A + beta B, as slate::add.
+    Expression& add(
+        scalar_t alpha, Matrix<scalar_t>& A,
+        scalar_t beta,  Matrix<scalar_t>& B )
+    {
+        return push( { alpha, A, beta, B, true } );
+    }
+
+    /// Records A = alpha A, as slate::scale, with alpha possibly complex.
+    Expression& scale( scalar_t alpha, Matrix<scalar_t>& A )
+    {
+        return push( { scalar_t( 0.0 ), Matrix<scalar_t>(), alpha, A, false } );
+    }
+
+    /// Records B = A, as slate::copy.
+    Expression& copy( Matrix<scalar_t>& A, Matrix<scalar_t>& B )
+    {
+        return push( { scalar_t( 1.0 ), A, scalar_t( 0.0 ), B, true } );
+    }
+
+    /// @return number of recorded operations not yet executed.
+    size_t size() const { return steps_.size(); }
+
+    //--------------------------------------------------------------------------
+    /// Runs the recorded operations, then clears them.
+    ///
+    /// @param[in] opts
+    ///     Additional options, as map of name = value pairs, for gemm
+    ///     and elementwise, e.g., Option::Target.
+    ///
+    void execute( Options const& opts = Options() )
+    {
+        const scalar_t zero = 0.0;
+        const scalar_t one  = 1.0;
+
+        std::vector< ElementwiseOp<scalar_t> > run;
+        size_t s = 0;
+        while (s < steps_.size()) {
+            if (! steps_[ s ].is_gemm) {
+                append( run, steps_[ s ].op, opts );
+                ++s;
+                continue;
+            }
+
+            Gemm g = steps_[ s ].gemm;
+            ++s;
+
+            // Fuse the element-wise updates of C that follow: after each,
+            // C = alpha A B + beta C_in + sum_i pre[ i ].alpha E_i.
+            std::vector< ElementwiseOp<scalar_t> > pre;
+            for (; s < steps_.size() && ! steps_[ s ].is_gemm; ++s) {
+                ElementwiseOp<scalar_t>& op = steps_[ s ].op;
+                if (! op.B.sameView( g.C ) || op.beta == zero)
+                    break;
+                scalar_t factor = op.beta;
+                bool reads_C = op.has_A && op.A.sameView( g.C );
+                if (reads_C)
+                    factor += op.alpha;
+                g.alpha *= factor;
+                g.beta  *= factor;
+                for (auto& p : pre)
+                    p.alpha *= factor;
+                if (op.has_A && ! reads_C)
+                    pre.push_back( { op.alpha, op.A, one, g.C, true } );
+            }
+            if (! pre.empty()) {
+                pre[ 0 ].beta = g.beta;
+                g.beta = one;
+                for (auto& p : pre)
+                    append( run, p, opts );
+            }
+            flush( run, opts );
+
+            slate::gemm( g.alpha, g.A, g.B, g.beta, g.C, opts );
+        }
+        flush( run, opts );
+        steps_.clear();
+    }
+
+private:
+    struct Gemm {
+        scalar_t alpha;
+        Matrix<scalar_t> A;
+        Matrix<scalar_t> B;
+        scalar_t beta;
+        Matrix<scalar_t> C;
+    };
+
+    struct Step {
+        bool is_gemm = false;
+        Gemm gemm;
+        ElementwiseOp<scalar_t> op;
+    };
+
+    Expression& push( ElementwiseOp<scalar_t> const& op )
+    {
+        Step step;
+        step.op = op;
+        steps_.push_back( step );
+        return *this;
+    }
+
+    /// Appends op to the current pass, first running the pass if op
+    /// doesn't conform with it.
+    static void append(
+        std::vector< ElementwiseOp<scalar_t> >& run,
+        ElementwiseOp<scalar_t>& op, Options const& opts )
+    {
+        if (! run.empty()) {
+            bool ok = impl::elementwise_conforming( run[ 0 ].B, op.B )
+                      && (! op.has_A
+                          || impl::elementwise_conforming( run[ 0 ].B, op.A ));
+            if (! ok)
+                flush( run, opts );
+        }
+        run.push_back( op );
+    }
+
+    static void flush(
+        std::vector< ElementwiseOp<scalar_t> >& run, Options const& opts )
+    {
+        if (! run.empty()) {
+            elementwise( run, opts );
+            run.clear();
+        }
+    }
+
+    std::vector<Step> steps_;
+};
+
+} // namespace slate
+
+#endif // SLATE_EXPRESSION_HH
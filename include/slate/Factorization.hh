@@ -0,0 +1,338 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef SLATE_FACTORIZATION_HH
+#define SLATE_FACTORIZATION_HH
+
+#include <algorithm>
+#include <vector>
+
+namespace slate {
+
+namespace impl {
+
+//------------------------------------------------------------------------------
+/// @internal
+/// Broadcasts the tiles of the triangular op( T ) that trsm( Side::Left,
+/// T, B ) uses to update block row i of B, i.e., the tiles of block row i
+/// of op( T ), to the ranks (and, for Target::Devices, the devices) of
+/// block row i of B, as work::trsm does one block column at a time.
+/// Afterwards, trsm with Option::FactorsResident solves with T on B,
+/// or on any block columns of B, without broadcasting T.
+/// The copies are freed by T.releaseRemoteWorkspace() and
+/// T.releaseLocalWorkspace().
+///
+template <typename scalar_t>
+void trsm_resident_bcast(
+    TriangularMatrix<scalar_t>& T, Matrix<scalar_t>& B, Target target )
+{
+    using BcastList = typename Matrix<scalar_t>::BcastList;
+
+    int64_t mt = T.mt();
+    int64_t nt = B.nt();
+    bool lower = T.uplo() == Uplo::Lower;
+
+    BcastList bcast_list;
+    for (int64_t i = 0; i < mt; ++i) {
+        int64_t k1 = lower ? 0 : i;
+        int64_t k2 = lower ? i : mt-1;
+        for (int64_t k = k1; k <= k2; ++k)
+            bcast_list.push_back( { i, k, { B.sub( i, i, 0, nt-1 ) } } );
+    }
+
+    if (target == Target::Devices)
+        T.template listBcast<Target::Devices>( bcast_list, Layout::ColMajor );
+    else
+        T.template listBcast<Target::HostTask>( bcast_list, Layout::ColMajor );
+}
+
+} // namespace impl
+
+//==============================================================================
+/// Base of the factorization handles for repeated solves, LUFactorization,
+/// CholeskyFactorization, and QRFactorization. A handle factors A once,
+/// then each solve( B ) reuses the factors, pivots, and triangular factors.
+///
+/// On the first solve, each tile of the triangular factors is broadcast,
+/// once, to the ranks of the block row of B that trsm updates with it, and
+/// kept there, with its device copies, until the handle releases it.
+/// Later solves with B distributed the same way then communicate only B,
+/// with no panel broadcasts, and are done with Option::FactorsResident.
+/// A B distributed differently, e.g., with more block columns over more
+/// ranks, re-broadcasts the factors for its distribution.
+/// Likewise, rcond keeps the factors on the ranks of the estimate's
+/// n-by-t block of vectors, for all of its solves.
+///
+/// Keeping the factors costs memory: each rank keeps the tiles of the
+/// block rows of A for which it has a tile of B, e.g., B with one block
+/// column keeps about one extra copy of A over all ranks, and B spread over
+/// all q columns of a p-by-q grid keeps about q copies.
+///
+/// The handle shallow copies A, so A must not be modified or freed while
+/// the handle is in use.
+///
+template <typename scalar_t>
+class Factorization {
+public:
+    /// @return info from the factorization: 0 if successful.
+    int64_t info() const { return info_; }
+
+    /// Frees the copies of the factors kept on other ranks and on devices.
+    /// The next solve broadcasts them again.
+    void release()
+    {
+        if (B_mt_ >= 0) {
+            A_.releaseRemoteWorkspace();
+            A_.releaseLocalWorkspace();
+            B_mt_ = -1;
+        }
+    }
+
+protected:
+    Factorization( Matrix<scalar_t> const& A, Options const& opts )
+        : A_( A ),
+          opts_( opts ),
+          info_( 0 ),
+          B_mt_( -1 ),
+          B_nt_( 0 )
+    {
+        opts_[ Option::MethodTrsm ] = MethodTrsm::B;
+        opts_[ Option::FactorsResident ] = true;
+    }
+
+    ~Factorization()
+    {
+        release();
+    }
+
+    //--------------------------------------------------------------------------
+    /// @return whether the factors were broadcast for B's distribution.
+    /// If not, records B's distribution, freeing any copies of the
+    /// factors sent for another distribution.
+    bool isResident( Matrix<scalar_t>& B )
+    {
+        std::vector<int> ranks;
+        for (int64_t i = 0; i < B.mt(); ++i) {
+            for (int64_t j = 0; j < B.nt(); ++j)
+                ranks.push_back( B.tileRank( i, j ) );
+        }
+        if (B_mt_ == B.mt() && B_nt_ == B.nt() && B_ranks_ == ranks)
+            return true;
+
+        release();
+        B_mt_ = B.mt();
+        B_nt_ = B.nt();
+        B_ranks_ = std::move( ranks );
+        return false;
+    }
+
+    //--------------------------------------------------------------------------
+    /// Broadcasts the tiles of op( T ) to the ranks of B that trsm uses
+    /// them on. @see impl::trsm_resident_bcast
+    void residentBcast( TriangularMatrix<scalar_t>& T, Matrix<scalar_t>& B )
+    {
+        Target target = get_option( opts_, Option::Target, Target::HostTask );
+        impl::trsm_resident_bcast( T, B, target );
+    }
+
+    //--------------------------------------------------------------------------
+    /// @return an n-by-t matrix, without tiles, distributed as X in the
+    /// block estimate of gecondest and pocondest, for which rcond keeps
+    /// the factors resident.
+    Matrix<scalar_t> estimateMatrix()
+    {
+        int64_t n = A_.n();
+        int64_t t = get_option<int64_t>( opts_, Option::EstimateColumns, 2 );
+        t = std::max( int64_t( 1 ), std::min( t, n ) );
+        auto tileMb = A_.tileMbFunc();
+        auto tileNb = func::uniform_blocksize( t, t );
+        auto tileRank = A_.tileRankFunc();
+        auto tileDevice = A_.tileDeviceFunc();
+        return Matrix<scalar_t>( n, t, tileMb, tileNb,
+                                 tileRank, tileDevice, A_.mpiComm() );
+    }
+
+    Matrix<scalar_t> A_;
+    Options opts_;
+    int64_t info_;
+
+    // Distribution of B the factors were broadcast for; B_mt_ = -1 if none.
+    int64_t B_mt_;
+    int64_t B_nt_;
+    std::vector<int> B_ranks_;
+};
+
+//==============================================================================
+/// LU factorization handle for repeated solves $A X = B$.
+/// Factors $A = P L U$ by getrf, then each solve( B ) does getrs, with
+/// the factors kept resident as in Factorization.
+///
+///     slate::LUFactorization<double> F( A, opts );
+///     if (F.info() != 0) { ... }
+///     for (int step = 0; step < nsteps; ++step) {
+///         // ... update B ...
+///         F.solve( B );
+///     }
+///
+template <typename scalar_t>
+class LUFactorization : public Factorization<scalar_t> {
+public:
+    /// Factors the n-by-n matrix A by getrf, overwriting A with L and U.
+    /// Options are as for getrf and getrs.
+    LUFactorization( Matrix<scalar_t>& A, Options const& opts = Options() )
+        : Factorization<scalar_t>( A, opts )
+    {
+        slate_assert( A.op() == Op::NoTrans );
+        this->info_ = getrf( A, pivots_, opts );
+    }
+
+    /// @return the pivots from getrf.
+    Pivots& pivots() { return pivots_; }
+
+    /// Solves $A X = B$, overwriting B with X.
+    void solve( Matrix<scalar_t>& B )
+    {
+        auto& A = this->A_;
+        if (! this->isResident( B )) {
+            auto L = TriangularMatrix<scalar_t>( Uplo::Lower, Diag::Unit, A );
+            auto U = TriangularMatrix<scalar_t>( Uplo::Upper, Diag::NonUnit, A );
+            this->residentBcast( L, B );
+            this->residentBcast( U, B );
+        }
+        getrs( A, pivots_, B, this->opts_ );
+    }
+
+    /// @return an estimate of the reciprocal of the condition number of A,
+    /// as gecondest. The factors are broadcast once for the estimate and
+    /// kept, as for solve, so rcond again reuses them.
+    blas::real_type<scalar_t> rcond(
+        Norm in_norm, blas::real_type<scalar_t> Anorm )
+    {
+        auto& A = this->A_;
+        auto X = this->estimateMatrix();
+        if (! this->isResident( X )) {
+            auto L = TriangularMatrix<scalar_t>( Uplo::Lower, Diag::Unit, A );
+            auto U = TriangularMatrix<scalar_t>( Uplo::Upper, Diag::NonUnit, A );
+            auto UH = conj_transpose( U );
+            auto LH = conj_transpose( L );
+            this->residentBcast( L,  X );
+            this->residentBcast( U,  X );
+            this->residentBcast( UH, X );
+            this->residentBcast( LH, X );
+        }
+        return gecondest( in_norm, A, Anorm, this->opts_ );
+    }
+
+private:
+    Pivots pivots_;
+};
+
+//==============================================================================
+/// Cholesky factorization handle for repeated solves $A X = B$,
+/// with A Hermitian positive definite.
+/// Factors $A = L L^H$ (or $U^H U$) by potrf, then each solve( B ) does
+/// potrs, with the factors kept resident as in Factorization.
+///
+template <typename scalar_t>
+class CholeskyFactorization : public Factorization<scalar_t> {
+public:
+    /// Factors the n-by-n Hermitian matrix A by potrf, overwriting A.
+    /// Options are as for potrf and potrs.
+    CholeskyFactorization( HermitianMatrix<scalar_t>& A,
+                           Options const& opts = Options() )
+        : Factorization<scalar_t>(
+              Matrix<scalar_t>( A, 0, A.mt()-1, 0, A.nt()-1 ), opts ),
+          AH_( A )
+    {
+        this->info_ = potrf( AH_, opts );
+    }
+
+    /// Solves $A X = B$, overwriting B with X.
+    void solve( Matrix<scalar_t>& B )
+    {
+        if (! this->isResident( B )) {
+            // As in potrs, solve with L and L^H.
+            auto A_lower = AH_;
+            if (A_lower.uplo() == Uplo::Upper)
+                A_lower = conj_transpose( A_lower );
+            auto L = TriangularMatrix<scalar_t>( Diag::NonUnit, A_lower );
+            auto LH = conj_transpose( L );
+            this->residentBcast( L, B );
+            this->residentBcast( LH, B );
+        }
+        potrs( AH_, B, this->opts_ );
+    }
+
+    /// @return an estimate of the reciprocal of the condition number of A,
+    /// as pocondest. The factors are broadcast once for the estimate and
+    /// kept, as for solve, so rcond again reuses them.
+    blas::real_type<scalar_t> rcond(
+        Norm in_norm, blas::real_type<scalar_t> Anorm )
+    {
+        auto X = this->estimateMatrix();
+        if (! this->isResident( X )) {
+            auto A_lower = AH_;
+            if (A_lower.uplo() == Uplo::Upper)
+                A_lower = conj_transpose( A_lower );
+            auto L = TriangularMatrix<scalar_t>( Diag::NonUnit, A_lower );
+            auto LH = conj_transpose( L );
+            this->residentBcast( L,  X );
+            this->residentBcast( LH, X );
+        }
+        return pocondest( in_norm, AH_, Anorm, this->opts_ );
+    }
+
+private:
+    HermitianMatrix<scalar_t> AH_;
+};
+
+//==============================================================================
+/// QR factorization handle for repeated least squares solves
+/// $\min \| A X - B \|_F$, with A m-by-n, m >= n.
+/// Factors $A = Q R$ by geqrf, then each solve( B ) applies $Q^H$ by unmqr
+/// and solves with R, with R kept resident as in Factorization.
+/// The Householder panels of unmqr are still broadcast in each solve.
+///
+template <typename scalar_t>
+class QRFactorization : public Factorization<scalar_t> {
+public:
+    /// Factors the m-by-n matrix A, m >= n, by geqrf, overwriting A.
+    /// Options are as for geqrf, unmqr, and trsm.
+    QRFactorization( Matrix<scalar_t>& A, Options const& opts = Options() )
+        : Factorization<scalar_t>( A, opts )
+    {
+        slate_assert( A.op() == Op::NoTrans );
+        slate_assert( A.m() >= A.n() );
+        geqrf( A, T_, opts );
+    }
+
+    /// @return the triangular factors from geqrf.
+    TriangularFactors<scalar_t>& factors() { return T_; }
+
+    /// Solves $\min \| A X - B \|_F$ for the m-by-nrhs B.
+    /// On exit, the first n rows of B have X, as in gels.
+    void solve( Matrix<scalar_t>& B )
+    {
+        const scalar_t one = 1.0;
+
+        auto& A = this->A_;
+        int64_t n = A.n();
+        auto R_ = A.slice( 0, n-1, 0, n-1 );
+        auto R = TriangularMatrix<scalar_t>( Uplo::Upper, Diag::NonUnit, R_ );
+        auto X = B.slice( 0, n-1, 0, B.n()-1 );
+        if (! this->isResident( X ))
+            this->residentBcast( R, X );
+
+        unmqr( Side::Left, Op::ConjTrans, A, T_, B, this->opts_ );
+        trsm( Side::Left, one, R, X, this->opts_ );
+    }
+
+private:
+    TriangularFactors<scalar_t> T_;
+};
+
+} // namespace slate
+
+#endif // SLATE_FACTORIZATION_HH
@@ -0,0 +1,98 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef SLATE_GROWTH_STATS_HH
+#define SLATE_GROWTH_STATS_HH
+
+#include <atomic>
+#include <cmath>
+#include <limits>
+
+namespace slate {
+
+//------------------------------------------------------------------------------
+/// Element growth statistics of an LU factorization, to judge whether
+/// getrf with MethodLU::NoPiv, or gesv_rbt, is trustworthy without
+/// computing norm( A ) before and norm( U ) after it. Pass a pointer in
+/// Options to getrf, getrf_nopiv, gesv, gesv_nopiv, or gesv_rbt:
+///
+///     slate::GrowthStats growth;
+///     slate::Options opts = {{ slate::Option::GrowthStats, &growth }};
+///     slate::getrf_nopiv( A, opts );
+///     if (growth.growth() > 1e3) { ... }
+///
+/// The factorization takes the local maxima in the tasks that already
+/// touch the tiles: max |a_ij| of A when its tiles are first updated, and
+/// max |u_ij| of U when each panel and block row of U are done. The maxima
+/// are reduced over the ranks together with info, in the same reduction,
+/// so the stability check costs no extra pass over A or synchronization.
+/// With Option::InfoRequest, they are complete after InfoRequest::wait(),
+/// and this object must live until then.
+///
+/// Each factorization resets the statistics. Not for MethodLU::CALU, nor
+/// for a factorization restarted from an Option::Checkpoint, which leave
+/// max_A zero.
+///
+class GrowthStats {
+public:
+    GrowthStats()
+        : max_A_( 0 ),
+          max_U_( 0 )
+    {}
+
+    GrowthStats( GrowthStats const& ) = delete;
+    GrowthStats& operator = ( GrowthStats const& ) = delete;
+
+    /// @return max_{i,j} |a_ij| of A on entry.
+    double maxA() const { return max_A_.load(); }
+
+    /// @return max_{i,j} |u_ij| of the computed U.
+    double maxU() const { return max_U_.load(); }
+
+    /// @return growth factor max |u_ij| / max |a_ij|, or 0 if A is zero.
+    double growth() const
+    {
+        double max_A = maxA();
+        return max_A > 0 ? maxU() / max_A : 0;
+    }
+
+    /// Sets both maxima to zero.
+    void reset()
+    {
+        max_A_.store( 0 );
+        max_U_.store( 0 );
+    }
+
+    /// Updates max |a_ij| with a local max. Thread safe.
+    void updateA( double value ) { update( max_A_, value ); }
+
+    /// Updates max |u_ij| with a local max. Thread safe.
+    void updateU( double value ) { update( max_U_, value ); }
+
+    /// Sets both maxima, e.g., after reducing them over the ranks.
+    void set( double max_A, double max_U )
+    {
+        max_A_.store( max_A );
+        max_U_.store( max_U );
+    }
+
+private:
+    /// x = max( x, value ), propagating NaN.
+    static void update( std::atomic<double>& x, double value )
+    {
+        double old = x.load();
+        while (! std::isnan( old ) && (std::isnan( value ) || value > old)) {
+            if (x.compare_exchange_weak( old, value ))
+                break;
+        }
+    }
+
+    std::atomic<double> max_A_;
+    std::atomic<double> max_U_;
+};
+
+} // namespace slate
+
+#endif // SLATE_GROWTH_STATS_HH
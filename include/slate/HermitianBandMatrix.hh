@@ -303,7 +303,8 @@ void HermitianBandMatrix<scalar_t>::gatherAll(std::set<int>& rank_set, int tag)
 
 //------------------------------------------------------------------------------
 /// Gather the distributed triangular band portion of a HermitianMatrix A
-//  to HermitianBandMatrix B on MPI rank 0.
+/// to this HermitianBandMatrix B, on the ranks owning the tiles of B,
+/// e.g., on MPI rank 0 for a 1-by-1 grid.
 /// Primarily for EVD code
 ///
 template <typename scalar_t>
@@ -323,7 +324,7 @@ void HermitianBandMatrix<scalar_t>::he2hbGather(HermitianMatrix<scalar_t>& A)
         int64_t iend   = upper ? j : blas::min( j+kdt, mt-1 );
         for (int64_t i = 0; i < mt; ++i) {
             if (i >= istart && i <= iend) {
-                if (this->mpi_rank_ == 0) {
+                if (this->tileIsLocal(i, j)) {
                     if (! A.tileIsLocal(i, j)) {
                         this->tileInsert( i, j, HostNum );
                         auto Bij = this->at(i, j);
@@ -343,7 +344,7 @@ void HermitianBandMatrix<scalar_t>::he2hbGather(HermitianMatrix<scalar_t>& A)
                 else if (A.tileIsLocal(i, j)) {
                     A.tileGetForReading(i, j, LayoutConvert(this->layout()));
                     auto Aij = A(i, j);
-                    Aij.send(0, this->mpi_comm_);
+                    Aij.send(this->tileRank(i, j), this->mpi_comm_);
                 }
             }
         }
@@ -0,0 +1,77 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef SLATE_INFO_REQUEST_HH
+#define SLATE_INFO_REQUEST_HH
+
+#include <cstdint>
+
+#include "slate/internal/mpi.hh"
+
+namespace slate {
+
+class GrowthStats;
+
+//------------------------------------------------------------------------------
+/// Deferred reduction of the info of a factorization. Pass a pointer in
+/// Options to getrf, potrf, hetrf, and the other factorizations that
+/// return info:
+///
+///     slate::InfoRequest request;
+///     slate::Options opts = {{ slate::Option::InfoRequest, &request }};
+///     slate::getrf( A, pivots, opts );
+///     slate::getrs( A, pivots, B, opts );
+///     int64_t info = request.wait();
+///
+/// Instead of a blocking MPI_Allreduce at its end, the routine starts an
+/// MPI_Iallreduce and returns at once, so the next routine, e.g., getrs,
+/// starts without a global synchronization. The routine then returns only
+/// this rank's info, which is zero except on the ranks where the error
+/// occurred. wait() returns the same info as the routine would without
+/// the request, on all ranks.
+///
+/// The reduction uses the matrix's MPI communicator; like other
+/// collectives, it has to be completed by wait() on all its ranks, each
+/// request ordered the same, before the request is reused or destroyed.
+/// The destructor waits for a pending reduction.
+///
+/// With Option::GrowthStats, the same reduction carries the growth
+/// statistics, which wait() stores in the GrowthStats.
+///
+class InfoRequest {
+public:
+    InfoRequest();
+    ~InfoRequest();
+
+    InfoRequest( InfoRequest const& ) = delete;
+    InfoRequest& operator = ( InfoRequest const& ) = delete;
+
+    void start( int64_t info, MPI_Comm mpi_comm,
+                GrowthStats* growth = nullptr );
+
+    /// @return whether a reduction was started and wait() hasn't
+    /// completed it yet.
+    bool pending() const { return pending_; }
+
+    bool test();
+
+    int64_t wait();
+
+private:
+    void finish();
+
+    MPI_Request request_;
+    int64_t send_info_;
+    int64_t recv_info_;
+    int64_t info_;
+    double send_growth_[ 3 ];
+    double recv_growth_[ 3 ];
+    GrowthStats* growth_;
+    bool pending_;
+};
+
+} // namespace slate
+
+#endif // SLATE_INFO_REQUEST_HH
@@ -0,0 +1,301 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef SLATE_LOW_RANK_TILE_HH
+#define SLATE_LOW_RANK_TILE_HH
+
+#include "slate/Exception.hh"
+#include "slate/internal/Trace.hh"
+#include "slate/types.hh"
+
+#include <blas.hh>
+#include <lapack.hh>
+
+#include <algorithm>
+#include <vector>
+
+namespace slate {
+
+//==============================================================================
+/// Low-rank mb-by-nb tile, $A = U V^H$, with U mb-by-rank and V nb-by-rank,
+/// both stored column-major and contiguous in host memory: U with leading
+/// dimension mb, followed by V with leading dimension nb.
+/// Unlike Tile, the rank varies per tile, so the tile owns its data,
+/// (mb + nb) rank entries instead of mb nb, and is not managed by
+/// MatrixStorage.
+///
+/// Used for the off-diagonal tiles of a TLRMatrix.
+///
+template <typename scalar_t>
+class LowRankTile {
+public:
+    using real_t = blas::real_type<scalar_t>;
+
+    /// Empty 0-by-0 tile.
+    LowRankTile()
+        : mb_( 0 ), nb_( 0 ), rank_( 0 )
+    {}
+
+    /// mb-by-nb tile of the given rank, with U and V uninitialized.
+    LowRankTile( int64_t mb, int64_t nb, int64_t rank )
+        : mb_( mb ), nb_( nb ), rank_( rank ),
+          data_( (mb + nb) * rank )
+    {}
+
+    /// Number of rows.
+    int64_t mb() const { return mb_; }
+
+    /// Number of columns.
+    int64_t nb() const { return nb_; }
+
+    /// Rank, the number of columns of U and V.
+    int64_t rank() const { return rank_; }
+
+    /// Number of entries stored, (mb + nb) rank.
+    int64_t size() const { return (mb_ + nb_) * rank_; }
+
+    /// U and V, contiguous, e.g., to send in one message.
+    scalar_t*       data()       { return data_.data(); }
+    scalar_t const* data() const { return data_.data(); }
+
+    /// The mb-by-rank factor U.
+    scalar_t*       U()       { return data_.data(); }
+    scalar_t const* U() const { return data_.data(); }
+    int64_t ldu() const { return std::max( mb_, int64_t( 1 ) ); }
+
+    /// The nb-by-rank factor V.
+    scalar_t*       V()       { return data_.data() + mb_*rank_; }
+    scalar_t const* V() const { return data_.data() + mb_*rank_; }
+    int64_t ldv() const { return std::max( nb_, int64_t( 1 ) ); }
+
+    void compress( int64_t mb, int64_t nb, scalar_t const* A, int64_t lda,
+                   real_t tol );
+
+    void recompress( real_t tol );
+
+    void append( scalar_t alpha, int64_t rank,
+                 scalar_t const* U, int64_t ldu,
+                 scalar_t const* V, int64_t ldv );
+
+    void toDense( scalar_t* A, int64_t lda ) const;
+
+private:
+    static int64_t truncatedRank( std::vector<real_t> const& S, real_t tol );
+
+    int64_t mb_, nb_, rank_;
+    std::vector<scalar_t> data_;
+};
+
+//------------------------------------------------------------------------------
+/// @return number of singular values S, sorted in decreasing order,
+/// that are greater than tol.
+///
+template <typename scalar_t>
+int64_t LowRankTile<scalar_t>::truncatedRank(
+    std::vector<real_t> const& S, real_t tol )
+{
+    int64_t rank = 0;
+    while (rank < int64_t( S.size() ) && S[ rank ] > tol)
+        ++rank;
+    return rank;
+}
+
+//------------------------------------------------------------------------------
+/// Sets this tile to the compression of the dense mb-by-nb matrix A:
+/// with the SVD $A = W \Sigma Z^H$, keeps the singular values greater than
+/// tol, setting $U = W_r \Sigma_r$ and $V = Z_r$. The error is
+/// $\| A - U V^H \|_2 \le$ tol.
+///
+/// @param[in] mb
+///     Number of rows of A.
+///
+/// @param[in] nb
+///     Number of columns of A.
+///
+/// @param[in] A
+///     The mb-by-nb column-major matrix A.
+///
+/// @param[in] lda
+///     Leading dimension of A, lda >= max( 1, mb ).
+///
+/// @param[in] tol
+///     Absolute truncation tolerance, tol >= 0.
+///
+template <typename scalar_t>
+void LowRankTile<scalar_t>::compress(
+    int64_t mb, int64_t nb, scalar_t const* A, int64_t lda, real_t tol )
+{
+    trace::Block trace_block( "lapack::gesdd" );
+
+    int64_t k = std::min( mb, nb );
+    mb_ = mb;
+    nb_ = nb;
+    if (k == 0) {
+        rank_ = 0;
+        data_.clear();
+        return;
+    }
+
+    std::vector<scalar_t> Acopy( mb*nb ), W( mb*k ), Zh( k*nb );
+    std::vector<real_t> S( k );
+    lapack::lacpy( lapack::MatrixType::General, mb, nb, A, lda,
+                   Acopy.data(), mb );
+    lapack::gesdd( lapack::Job::SomeVec, mb, nb, Acopy.data(), mb,
+                   S.data(), W.data(), mb, Zh.data(), k );
+
+    rank_ = truncatedRank( S, tol );
+    data_.resize( (mb_ + nb_) * rank_ );
+    scalar_t* U_ = U();
+    scalar_t* V_ = V();
+    for (int64_t l = 0; l < rank_; ++l) {
+        for (int64_t i = 0; i < mb_; ++i)
+            U_[ i + l*mb_ ] = S[ l ] * W[ i + l*mb ];
+        for (int64_t j = 0; j < nb_; ++j)
+            V_[ j + l*nb_ ] = blas::conj( Zh[ l + j*k ] );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Recompresses the tile to tolerance tol, reducing its rank.
+/// With the QR factorizations $U = Q_u R_u$ and $V = Q_v R_v$, and the SVD
+/// $R_u R_v^H = W \Sigma Z^H$, keeps the singular values greater than tol,
+/// setting $U = Q_u W_r \Sigma_r$ and $V = Q_v Z_r$.
+/// This costs $O( (mb + nb) rank^2 )$ flops, without forming $U V^H$.
+/// Used after append() to truncate the rank of an updated tile.
+///
+/// @param[in] tol
+///     Absolute truncation tolerance, tol >= 0.
+///
+template <typename scalar_t>
+void LowRankTile<scalar_t>::recompress( real_t tol )
+{
+    trace::Block trace_block( "slate::LowRankTile::recompress" );
+
+    const scalar_t zero = 0.0, one = 1.0;
+
+    int64_t r = rank_;
+    if (r == 0)
+        return;
+
+    int64_t ku = std::min( mb_, r );
+    int64_t kv = std::min( nb_, r );
+
+    // Q_u R_u = U and Q_v R_v = V.
+    std::vector<scalar_t> Qu( U(), U() + mb_*r ), Qv( V(), V() + nb_*r );
+    std::vector<scalar_t> tau_u( ku ), tau_v( kv );
+    std::vector<scalar_t> Ru( ku*r, zero ), Rv( kv*r, zero );
+    lapack::geqrf( mb_, r, Qu.data(), mb_, tau_u.data() );
+    lapack::geqrf( nb_, r, Qv.data(), nb_, tau_v.data() );
+    lapack::lacpy( lapack::MatrixType::Upper, ku, r, Qu.data(), mb_,
+                   Ru.data(), ku );
+    lapack::lacpy( lapack::MatrixType::Upper, kv, r, Qv.data(), nb_,
+                   Rv.data(), kv );
+    lapack::ungqr( mb_, ku, ku, Qu.data(), mb_, tau_u.data() );
+    lapack::ungqr( nb_, kv, kv, Qv.data(), nb_, tau_v.data() );
+
+    // W Sigma Z^H = R_u R_v^H, which is ku-by-kv.
+    int64_t k = std::min( ku, kv );
+    std::vector<scalar_t> M( ku*kv ), W( ku*k ), Zh( k*kv );
+    std::vector<real_t> S( k );
+    blas::gemm( blas::Layout::ColMajor, Op::NoTrans, Op::ConjTrans,
+                ku, kv, r,
+                one,  Ru.data(), ku,
+                      Rv.data(), kv,
+                zero, M.data(), ku );
+    lapack::gesdd( lapack::Job::SomeVec, ku, kv, M.data(), ku,
+                   S.data(), W.data(), ku, Zh.data(), k );
+
+    int64_t rank = truncatedRank( S, tol );
+    for (int64_t l = 0; l < rank; ++l)
+        blas::scal( ku, scalar_t( S[ l ] ), &W[ l*ku ], 1 );
+
+    rank_ = rank;
+    data_.resize( (mb_ + nb_) * rank_ );
+    if (rank_ == 0)
+        return;
+
+    // U = Q_u W_r Sigma_r and V = Q_v Z_r.
+    blas::gemm( blas::Layout::ColMajor, Op::NoTrans, Op::NoTrans,
+                mb_, rank_, ku,
+                one,  Qu.data(), mb_,
+                      W.data(),  ku,
+                zero, U(), ldu() );
+    blas::gemm( blas::Layout::ColMajor, Op::NoTrans, Op::ConjTrans,
+                nb_, rank_, kv,
+                one,  Qv.data(), nb_,
+                      Zh.data(), k,
+                zero, V(), ldv() );
+}
+
+//------------------------------------------------------------------------------
+/// Adds a low-rank term, $U V^H \leftarrow U V^H + \alpha U_2 V_2^H$,
+/// by concatenating the factors, $U = [ U, \alpha U_2 ]$ and
+/// $V = [ V, V_2 ]$. The rank grows to rank + rank2; call recompress()
+/// afterwards to truncate it.
+///
+/// @param[in] alpha
+///     The scalar alpha.
+///
+/// @param[in] rank2
+///     Rank of the term, the number of columns of U2 and V2.
+///
+/// @param[in] U2
+///     The mb-by-rank2 matrix U2, with leading dimension ldu2.
+///
+/// @param[in] V2
+///     The nb-by-rank2 matrix V2, with leading dimension ldv2.
+///
+template <typename scalar_t>
+void LowRankTile<scalar_t>::append(
+    scalar_t alpha, int64_t rank2,
+    scalar_t const* U2, int64_t ldu2,
+    scalar_t const* V2, int64_t ldv2 )
+{
+    if (rank2 == 0)
+        return;
+
+    int64_t rank = rank_ + rank2;
+    std::vector<scalar_t> data( (mb_ + nb_) * rank );
+    scalar_t* Unew = data.data();
+    scalar_t* Vnew = data.data() + mb_*rank;
+    lapack::lacpy( lapack::MatrixType::General, mb_, rank_, U(), ldu(),
+                   Unew, mb_ );
+    lapack::lacpy( lapack::MatrixType::General, nb_, rank_, V(), ldv(),
+                   Vnew, nb_ );
+    for (int64_t l = 0; l < rank2; ++l) {
+        for (int64_t i = 0; i < mb_; ++i)
+            Unew[ i + (rank_ + l)*mb_ ] = alpha * U2[ i + l*ldu2 ];
+    }
+    lapack::lacpy( lapack::MatrixType::General, nb_, rank2, V2, ldv2,
+                   &Vnew[ rank_*nb_ ], nb_ );
+
+    rank_ = rank;
+    data_.swap( data );
+}
+
+//------------------------------------------------------------------------------
+/// Expands the tile into the dense mb-by-nb column-major matrix
+/// $A = U V^H$, with leading dimension lda >= max( 1, mb ).
+///
+template <typename scalar_t>
+void LowRankTile<scalar_t>::toDense( scalar_t* A, int64_t lda ) const
+{
+    const scalar_t zero = 0.0, one = 1.0;
+
+    if (rank_ == 0) {
+        lapack::laset( lapack::MatrixType::General, mb_, nb_, zero, zero,
+                       A, lda );
+        return;
+    }
+    blas::gemm( blas::Layout::ColMajor, Op::NoTrans, Op::ConjTrans,
+                mb_, nb_, rank_,
+                one,  U(), ldu(),
+                      V(), ldv(),
+                zero, A, lda );
+}
+
+} // namespace slate
+
+#endif // SLATE_LOW_RANK_TILE_HH
@@ -112,6 +112,35 @@ public:
         return fromDevices(m, n, Aarray, num_devices, lda, nb, nb, p, q, mpi_comm);
     }
 
+    //----------
+    static
+    Matrix fromScaLAPACKDevice(
+        int64_t m, int64_t n,
+        scalar_t* A, int64_t lda, int64_t mb, int64_t nb,
+        GridOrder order, int p, int q, MPI_Comm mpi_comm,
+        int device, Layout layout=Layout::ColMajor );
+
+    /// With order = Col.
+    static
+    Matrix fromScaLAPACKDevice(
+        int64_t m, int64_t n,
+        scalar_t* A, int64_t lda, int64_t mb, int64_t nb,
+        int p, int q, MPI_Comm mpi_comm,
+        int device, Layout layout=Layout::ColMajor )
+    {
+        return fromScaLAPACKDevice( m, n, A, lda, mb, nb,
+                                    GridOrder::Col, p, q, mpi_comm,
+                                    device, layout );
+    }
+
+    static
+    std::vector< Matrix > fromScaLAPACKDeviceBatch(
+        int64_t batch_count, int64_t stride,
+        int64_t m, int64_t n,
+        scalar_t* A, int64_t lda, int64_t mb, int64_t nb,
+        GridOrder order, int p, int q, MPI_Comm mpi_comm,
+        int device, Layout layout=Layout::ColMajor );
+
     //----------
     template <typename out_scalar_t=scalar_t>
     Matrix<out_scalar_t> emptyLike(int64_t mb=0, int64_t nb=0,
@@ -122,6 +151,8 @@ public:
     Matrix<out_scalar_t> emptyLike(BaseMatrix<scalar_t>& orig, int64_t mb=0,
                                    int64_t nb=0, Op deepOp=Op::NoTrans);
 
+    Matrix snapshot();
+
     // conversion sub-matrix
     Matrix(BaseMatrix<scalar_t>& orig,
            int64_t i1, int64_t i2,
@@ -150,6 +181,12 @@ protected:
            int num_devices, int64_t lda, int64_t mb, int64_t nb,
            int p, int q, MPI_Comm mpi_comm);
 
+    // used by fromScaLAPACKDevice
+    Matrix(int64_t m, int64_t n,
+           scalar_t* A, int64_t lda, int64_t mb, int64_t nb,
+           GridOrder order, int p, int q, MPI_Comm mpi_comm,
+           int device, Layout layout);
+
 public:
     template <typename T>
     friend void swap(Matrix<T>& A, Matrix<T>& B);
@@ -157,11 +194,17 @@ public:
     int64_t getMaxHostTiles();
     int64_t getMaxDeviceTiles(int device);
     int64_t getMaxDeviceTiles();
+    std::vector<int64_t> getLocalDeviceTiles();
     void allocateBatchArrays(int64_t batch_size=0, int64_t num_arrays=1);
     void reserveHostWorkspace();
+    void reserveHostWorkspace(int64_t num_tiles);
     void reserveDeviceWorkspace();
+    void reserveDeviceWorkspace(std::vector<int64_t> const& num_tiles);
     void gather(scalar_t* A, int64_t lda);
-    void insertLocalTiles(Target origin=Target::Host);
+    void insertLocalTiles(Target origin=Target::Host,
+                          Options const& opts = Options());
+    void insertLocalTilesZero(Target origin=Target::Host);
+    void insertLocalTilesMapped(std::string const& filename);
 };
 
 //------------------------------------------------------------------------------
@@ -403,6 +446,108 @@ Matrix<scalar_t> Matrix<scalar_t>::fromDevices(
                             p, q, mpi_comm);
 }
 
+//------------------------------------------------------------------------------
+/// [static]
+/// Named constructor returns a new Matrix from data in GPU device memory,
+/// already in the ScaLAPACK 2D block-cyclic layout. This is the device
+/// analogue of fromScaLAPACK: the local array of this MPI rank, on one
+/// device, is wrapped as UserOwned device tiles without copying it and
+/// without host tiles, so device-native codes can call SLATE on their data
+/// in place. Host tiles are allocated only as workspace, if needed.
+///
+/// @param[in] m
+///     Number of rows of the matrix. m >= 0.
+///
+/// @param[in] n
+///     Number of columns of the matrix. n >= 0.
+///
+/// @param[in,out] A
+///     The local portion of the 2D block cyclic distribution of
+///     the m-by-n matrix A, in the memory of device, with local leading
+///     dimension lda.
+///
+/// @param[in] lda
+///     Local leading dimension of the array A.
+///     If layout = ColMajor, lda >= local number of rows;
+///     if layout = RowMajor, lda >= local number of columns.
+///
+/// @param[in] mb
+///     Row block size in 2D block-cyclic distribution. mb > 0.
+///
+/// @param[in] nb
+///     Column block size in 2D block-cyclic distribution. nb > 0.
+///
+/// @param[in] order
+///     Order to map MPI processes to tile grid,
+///     GridOrder::ColMajor (default) or GridOrder::RowMajor.
+///
+/// @param[in] p
+///     Number of block rows in 2D block-cyclic distribution. p > 0.
+///
+/// @param[in] q
+///     Number of block columns of 2D block-cyclic distribution. q > 0.
+///
+/// @param[in] mpi_comm
+///     MPI communicator to distribute matrix across.
+///     p*q == MPI_Comm_size(mpi_comm).
+///
+/// @param[in] device
+///     Device holding A; all local tiles are on this device.
+///     0 <= device < num_devices.
+///
+/// @param[in] layout
+///     Layout of the local array A:
+///     - Layout::ColMajor (default): entry (i, j) is A[ i + j*lda ];
+///     - Layout::RowMajor: entry (i, j) is A[ i*lda + j ].
+///
+template <typename scalar_t>
+Matrix<scalar_t> Matrix<scalar_t>::fromScaLAPACKDevice(
+    int64_t m, int64_t n,
+    scalar_t* A, int64_t lda, int64_t mb, int64_t nb,
+    GridOrder order, int p, int q, MPI_Comm mpi_comm,
+    int device, Layout layout)
+{
+    return Matrix<scalar_t>( m, n, A, lda, mb, nb, order, p, q, mpi_comm,
+                             device, layout );
+}
+
+//------------------------------------------------------------------------------
+/// [static]
+/// Named constructor returns batch_count matrices from a strided batch in
+/// GPU device memory, each in the ScaLAPACK 2D block-cyclic layout.
+/// Matrix k wraps the local array A + k*stride, without copying.
+/// @see fromScaLAPACKDevice
+///
+/// @param[in] batch_count
+///     Number of matrices. batch_count >= 0.
+///
+/// @param[in] stride
+///     Distance, in elements, between the local arrays of consecutive
+///     matrices. stride >= lda * (local number of columns), or
+///     lda * (local number of rows) if layout = RowMajor.
+///
+/// Other arguments are as in fromScaLAPACKDevice, the same for all matrices.
+///
+template <typename scalar_t>
+std::vector< Matrix<scalar_t> > Matrix<scalar_t>::fromScaLAPACKDeviceBatch(
+    int64_t batch_count, int64_t stride,
+    int64_t m, int64_t n,
+    scalar_t* A, int64_t lda, int64_t mb, int64_t nb,
+    GridOrder order, int p, int q, MPI_Comm mpi_comm,
+    int device, Layout layout)
+{
+    slate_error_if( batch_count < 0 );
+
+    std::vector< Matrix<scalar_t> > batch;
+    batch.reserve( batch_count );
+    for (int64_t k = 0; k < batch_count; ++k) {
+        batch.push_back( Matrix<scalar_t>( m, n, &A[ k*stride ], lda, mb, nb,
+                                           order, p, q, mpi_comm,
+                                           device, layout ) );
+    }
+    return batch;
+}
+
 //------------------------------------------------------------------------------
 /// Named constructor returns a new, empty Matrix with the same structure
 /// (distribution and number of tiles) as this matrix. Tiles are not allocated.
@@ -436,6 +581,23 @@ Matrix<out_scalar_t> Matrix<scalar_t>::emptyLike(
     return Matrix<out_scalar_t>(B, 0, B.mt()-1, 0, B.nt()-1);
 }
 
+//------------------------------------------------------------------------------
+/// Named constructor returns a copy-on-write snapshot of this matrix, with
+/// the same structure and values. Instead of allocating and copying all
+/// tiles, as emptyLike followed by copy does, tiles share their data until
+/// the first tileGetForWriting on either matrix, which copies only that
+/// tile. Useful to keep A before it is overwritten, e.g., by a
+/// factorization, for refinement or condition estimation.
+/// Not collective: each rank shares its own local tiles.
+/// @see BaseMatrix::baseSnapshot
+///
+template <typename scalar_t>
+Matrix<scalar_t> Matrix<scalar_t>::snapshot()
+{
+    auto B = this->baseSnapshot();
+    return Matrix<scalar_t>(B, 0, B.mt()-1, 0, B.nt()-1);
+}
+
 //------------------------------------------------------------------------------
 /// Named constructor returns a new, empty Matrix with the same structure
 /// (size and distribution) as the matrix orig. Tiles are not allocated.
@@ -562,6 +724,50 @@ Matrix<scalar_t>::Matrix(
     }
 }
 
+//------------------------------------------------------------------------------
+/// [internal]
+/// @see fromScaLAPACKDevice
+///
+template <typename scalar_t>
+Matrix<scalar_t>::Matrix(
+    int64_t m, int64_t n,
+    scalar_t* A, int64_t lda, int64_t mb, int64_t nb,
+    GridOrder order, int p, int q, MPI_Comm mpi_comm,
+    int device, Layout layout)
+    : BaseMatrix<scalar_t>( m, n, mb, nb, order, p, q, mpi_comm )
+{
+    slate_error_if( device < 0 || device >= this->num_devices() );
+
+    this->origin_ = Target::Devices;
+    this->layout_ = layout;
+
+    // All local tiles are on device.
+    this->storage_->tileDevice = [device](ij_tuple ij) { return device; };
+
+    // ii, jj are row, col indices
+    // ii_local and jj_local are the local array indices in A
+    // block-cyclic layout (indxg2l)
+    // i, j are tile (block row, block col) indices
+    int64_t jj = 0;
+    for (int64_t j = 0; j < this->nt(); ++j) {
+        int64_t jb = this->tileNb(j);
+        int64_t jj_local = global2local( jj, nb, q );
+        int64_t ii = 0;
+        for (int64_t i = 0; i < this->mt(); ++i) {
+            int64_t ib = this->tileMb(i);
+            if (this->tileIsLocal(i, j)) {
+                int64_t ii_local = global2local( ii, mb, p );
+                int64_t offset = layout == Layout::ColMajor
+                               ? ii_local + jj_local*lda
+                               : ii_local*lda + jj_local;
+                this->tileInsert( i, j, device, &A[ offset ], lda );
+            }
+            ii += ib;
+        }
+        jj += jb;
+    }
+}
+
 //------------------------------------------------------------------------------
 /// Sub-matrix constructor creates shallow copy view of parent matrix,
 /// A[ i1:i2, j1:j2 ].
@@ -709,17 +915,29 @@ int64_t Matrix<scalar_t>::getMaxDeviceTiles(int device)
 }
 
 //------------------------------------------------------------------------------
-/// Returns the largest number of local tiles of the matrix on this rank for
-/// any devices.
+/// Returns the number of local tiles of the matrix on this rank for
+/// each device.
 template <typename scalar_t>
-int64_t Matrix<scalar_t>::getMaxDeviceTiles()
+std::vector<int64_t> Matrix<scalar_t>::getLocalDeviceTiles()
 {
+    std::vector<int64_t> num_tiles( this->num_devices() );
     if (this->num_devices() > 0) {
-        std::vector<int64_t> num_tiles( this->num_devices() );
         for (int64_t j = 0; j < this->nt(); ++j)
             for (int64_t i = 0; i < this->mt(); ++i)
                 if (this->tileIsLocal(i, j))
                     num_tiles[ this->tileDevice( i, j ) ] += 1;
+    }
+    return num_tiles;
+}
+
+//------------------------------------------------------------------------------
+/// Returns the largest number of local tiles of the matrix on this rank for
+/// any devices.
+template <typename scalar_t>
+int64_t Matrix<scalar_t>::getMaxDeviceTiles()
+{
+    if (this->num_devices() > 0) {
+        std::vector<int64_t> num_tiles = getLocalDeviceTiles();
         return *std::max_element( num_tiles.begin(), num_tiles.end() );
     }
     else {
@@ -760,11 +978,32 @@ void Matrix<scalar_t>::reserveHostWorkspace()
 }
 
 //------------------------------------------------------------------------------
-/// Reserve space for temporary workspace tiles on all GPU devices.
+/// Reserve space for num_tiles temporary workspace tiles on host.
+/// If there are GPU devices, these are in pinned memory, for staging
+/// asynchronous transfers to and from devices.
+template <typename scalar_t>
+void Matrix<scalar_t>::reserveHostWorkspace(int64_t num_tiles)
+{
+    this->storage_->reserveHostWorkspace( num_tiles );
+}
+
+//------------------------------------------------------------------------------
+/// Reserve space for temporary workspace tiles on all GPU devices,
+/// as many on each device as its local tiles.
 template <typename scalar_t>
 void Matrix<scalar_t>::reserveDeviceWorkspace()
 {
-    this->storage_->reserveDeviceWorkspace( getMaxDeviceTiles() );
+    this->storage_->reserveDeviceWorkspace( getLocalDeviceTiles() );
+}
+
+//------------------------------------------------------------------------------
+/// Reserve space for num_tiles[ device ] temporary workspace tiles on each
+/// GPU device, e.g., as planned by slate::plan.
+template <typename scalar_t>
+void Matrix<scalar_t>::reserveDeviceWorkspace(
+    std::vector<int64_t> const& num_tiles)
+{
+    this->storage_->reserveDeviceWorkspace( num_tiles );
 }
 
 //------------------------------------------------------------------------------
@@ -828,8 +1067,20 @@ void Matrix<scalar_t>::gather(scalar_t* A, int64_t lda)
 ///     - if target = Devices, inserts tiles on appropriate GPU devices, or
 ///     - if target = Host,    inserts tiles on CPU host.
 ///
+/// @param[in] opts
+///     Additional options, as map of name = value pairs. Possible options:
+///     - Option::HostFirstTouch:
+///       Whether to zero host tiles in parallel, so each is first touched,
+///       and hence placed in the NUMA domain of, one of the threads that
+///       later update it, instead of all by the calling thread.
+///       Default false.
+///     - Option::HostTileArena:
+///       Whether to put host tiles in one contiguous arena, in column-major
+///       ScaLAPACK order, instead of allocating each tile separately.
+///       @see arenaData. Default false.
+///
 template <typename scalar_t>
-void Matrix<scalar_t>::insertLocalTiles(Target origin)
+void Matrix<scalar_t>::insertLocalTiles(Target origin, Options const& opts)
 {
     this->origin_ = origin;
 
@@ -837,12 +1088,113 @@ void Matrix<scalar_t>::insertLocalTiles(Target origin)
     if (on_devices)
         reserveDeviceWorkspace();
 
+    bool first_touch = ! on_devices
+                       && get_option( opts, Option::HostFirstTouch, false );
+    bool arena = ! on_devices
+                 && get_option( opts, Option::HostTileArena, false );
+    std::vector< ij_tuple > host_tiles;
+
     for (int64_t j = 0; j < this->nt(); ++j) {
         for (int64_t i = 0; i < this->mt(); ++i) {
             if (this->tileIsLocal(i, j)) {
-                int dev = (on_devices ? this->tileDevice(i, j)
+                if (arena) {
+                    // inserted below, once the arena size is known
+                    host_tiles.push_back( { i, j } );
+                }
+                else {
+                    int dev = (on_devices ? this->tileDevice(i, j)
+                                          : HostNum);
+                    this->tileInsert(i, j, dev);
+                    if (first_touch)
+                        host_tiles.push_back( { i, j } );
+                }
+            }
+        }
+    }
+
+    if (arena)
+        this->insertHostTilesArena( host_tiles );
+    if (first_touch)
+        this->firstTouchHostTiles( host_tiles );
+}
+
+//------------------------------------------------------------------------------
+/// Inserts all local tiles into an empty matrix as lazy zero tiles, which
+/// is the same as insertLocalTiles followed by set( zero, A ), except each
+/// tile is allocated and zeroed only when first accessed, by tileGet or
+/// operator(). A gemm with beta = 0 allocates tiles of C without zeroing
+/// them. If zero tiles are tracked (@see trackZeroTiles), all tiles are
+/// also marked as structurally zero, so broadcasts and multiplies skip
+/// them until they are updated.
+///
+/// @param[in] origin
+///     - if origin = Devices, tiles are allocated on appropriate GPU devices, or
+///     - if origin = Host,    tiles are allocated on CPU host.
+///
+template <typename scalar_t>
+void Matrix<scalar_t>::insertLocalTilesZero(Target origin)
+{
+    this->origin_ = origin;
+
+    bool on_devices = (origin == Target::Devices);
+    if (on_devices)
+        reserveDeviceWorkspace();
+
+    bool track = this->zeroTilesTracked();
+    for (int64_t j = 0; j < this->nt(); ++j) {
+        for (int64_t i = 0; i < this->mt(); ++i) {
+            if (this->tileIsLocal( i, j )) {
+                int dev = (on_devices ? this->tileDevice( i, j )
                                       : HostNum);
-                this->tileInsert(i, j, dev);
+                this->storage_->tileInsertLazyZero(
+                    this->globalIndex( i, j ), dev );
+            }
+            if (track)
+                this->tileSetZero( i, j );
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Inserts all local tiles into an empty matrix, as origin tiles in a
+/// memory-mapped file on host (TileKind::FileMapped), so the matrix can
+/// exceed host memory. Pages are read from the file when tiles are first
+/// accessed; tilePrefetchMapped and tileFlushMapped help overlap the I/O.
+/// Each rank maps its own file, filename.rank, which is created if it does
+/// not exist. Existing contents are kept, so a matrix can be mapped again,
+/// with the same dimensions and distribution, to read it back.
+/// Each local tile occupies a slot of the largest tile size, in
+/// column-major order of tiles; elements within a tile are column major.
+///
+/// @param[in] filename
+///     Prefix of file name.
+///
+template <typename scalar_t>
+void Matrix<scalar_t>::insertLocalTilesMapped(std::string const& filename)
+{
+    this->origin_ = Target::Host;
+
+    int64_t num_tiles = 0;
+    for (int64_t j = 0; j < this->nt(); ++j) {
+        for (int64_t i = 0; i < this->mt(); ++i) {
+            num_tiles += this->tileIsLocal(i, j);
+        }
+    }
+    if (num_tiles == 0)
+        return;
+
+    std::string rank_filename = filename + "." + std::to_string( this->mpiRank() );
+    scalar_t* data = this->storage_->mapFile( rank_filename, num_tiles );
+    int64_t slot = this->storage_->maxTileSize();
+    for (int64_t j = 0; j < this->nt(); ++j) {
+        for (int64_t i = 0; i < this->mt(); ++i) {
+            if (this->tileIsLocal(i, j)) {
+                auto index = this->globalIndex( i, j );
+                int64_t lda = this->layout() == Layout::ColMajor
+                            ? this->storage_->tileMb( std::get<0>( index ) )
+                            : this->storage_->tileNb( std::get<1>( index ) );
+                this->storage_->tileInsertMapped( index, data, lda, this->layout() );
+                data += slot;
             }
         }
     }
@@ -0,0 +1,62 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef SLATE_PANEL_CALLBACK_HH
+#define SLATE_PANEL_CALLBACK_HH
+
+#include <cstdint>
+#include <functional>
+
+namespace slate {
+
+//------------------------------------------------------------------------------
+/// Callback that a factorization calls as each block column of its result
+/// becomes final, so applications can use the columns, e.g., write them
+/// out, while the rest of the factorization runs. Pass a pointer in
+/// Options to potrf or geqrf:
+///
+///     slate::PanelCallback done( [&]( int64_t k ) {
+///         // A( :, k ) is final; read this rank's local tiles.
+///     } );
+///     slate::Options opts = {{ slate::Option::PanelCallback, &done }};
+///     slate::potrf( A, opts );
+///
+/// Block column k is final once its panel is factored and all its updates
+/// are applied: for potrf, L( k:nt-1, k ), or U( k, k:nt-1 ) if A is upper;
+/// for geqrf, R( 0:k, k ), the reflectors V( k:mt-1, k ), and T( :, k ).
+///
+/// Each rank calls it once per block column, in order of k, from a
+/// low-priority task that has updated the origin of its local tiles of the
+/// column, so the callback may read those tiles on the host. It must not
+/// write to the matrix, call MPI collectives, or block on other ranks.
+/// Calls of the same rank don't overlap, but run concurrently with the
+/// factorization on other threads. The object must live until the
+/// factorization returns.
+///
+class PanelCallback {
+public:
+    using Function = std::function< void (int64_t k) >;
+
+    explicit PanelCallback( Function func )
+        : func_( func )
+    {}
+
+    PanelCallback( PanelCallback const& ) = delete;
+    PanelCallback& operator = ( PanelCallback const& ) = delete;
+
+    /// Reports that block column k is final.
+    void operator () ( int64_t k ) const
+    {
+        if (func_)
+            func_( k );
+    }
+
+private:
+    Function func_;
+};
+
+} // namespace slate
+
+#endif // SLATE_PANEL_CALLBACK_HH
@@ -0,0 +1,269 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef SLATE_TLR_MATRIX_HH
+#define SLATE_TLR_MATRIX_HH
+
+#include "slate/HermitianMatrix.hh"
+#include "slate/LowRankTile.hh"
+#include "slate/types.hh"
+
+#include <algorithm>
+#include <list>
+#include <map>
+#include <set>
+#include <tuple>
+#include <vector>
+
+#include "slate/internal/comm.hh"
+#include "slate/internal/mpi.hh"
+
+namespace slate {
+
+//==============================================================================
+/// Hermitian, n-by-n, distributed, tile low-rank (TLR) matrix, stored lower.
+/// Diagonal tiles are dense, kept in a HermitianMatrix; off-diagonal tiles
+/// (i, j), i > j, are LowRankTile, compressed to the absolute tolerance
+/// tolerance(). Tiles are distributed as in the HermitianMatrix the TLRMatrix
+/// was created from.
+///
+/// For data-sparse matrices, such as covariance or boundary element matrices,
+/// where off-diagonal tiles have numerical rank r << nb, this stores
+/// $O( n nb + n^2 r / nb )$ instead of $O( n^2 )$ entries.
+///
+/// @see compress, potrf, gemm, trsm for TLRMatrix.
+///
+template <typename scalar_t>
+class TLRMatrix {
+public:
+    using real_t = blas::real_type<scalar_t>;
+    using ij_tuple = typename BaseMatrix<scalar_t>::ij_tuple;
+
+    /// List of tiles {i, j} to broadcast, each with its set of MPI ranks.
+    using BcastList = std::vector< std::tuple< int64_t, int64_t,
+                                               std::set<int> > >;
+
+    /// Default constructor creates an empty matrix.
+    TLRMatrix()
+        : tol_( 0 )
+    {}
+
+    TLRMatrix( HermitianMatrix<scalar_t>& A, real_t tol );
+
+    /// @return number of rows and columns.
+    int64_t n() const { return D_.n(); }
+
+    /// @return number of block rows and block columns.
+    int64_t nt() const { return D_.nt(); }
+
+    /// @return number of rows and columns in block row i.
+    int64_t tileNb( int64_t i ) const { return D_.tileMb( i ); }
+
+    /// @return MPI rank of tile {i, j}.
+    int tileRank( int64_t i, int64_t j ) const { return D_.tileRank( i, j ); }
+
+    /// @return whether tile {i, j} is local to this MPI rank.
+    bool tileIsLocal( int64_t i, int64_t j ) const
+    {
+        return D_.tileIsLocal( i, j );
+    }
+
+    MPI_Comm mpiComm() const { return D_.mpiComm(); }
+    int      mpiRank() const { return D_.mpiRank(); }
+
+    /// @return absolute tolerance of the low-rank tiles.
+    real_t tolerance() const { return tol_; }
+
+    /// @return Hermitian matrix holding the dense diagonal tiles.
+    /// Its off-diagonal tiles are not used.
+    HermitianMatrix<scalar_t>& diag() { return D_; }
+
+    /// @return whether low-rank tile {i, j} exists on this MPI rank,
+    /// either local or received.
+    bool tileExists( int64_t i, int64_t j ) const
+    {
+        return tiles_.find( { i, j } ) != tiles_.end();
+    }
+
+    /// @return low-rank tile {i, j}, i > j, which must exist.
+    LowRankTile<scalar_t>& tile( int64_t i, int64_t j )
+    {
+        return tiles_.at( { i, j } );
+    }
+
+    /// Inserts low-rank tile {i, j}, i > j, replacing any existing one.
+    /// Not thread safe.
+    void tileInsert( int64_t i, int64_t j, LowRankTile<scalar_t>&& T )
+    {
+        slate_assert( i > j );
+        tiles_[ { i, j } ] = std::move( T );
+    }
+
+    void tileBcast( int64_t i, int64_t j, std::set<int> const& bcast_set,
+                    int tag = 0 );
+
+    void listBcast( BcastList const& bcast_list, int tag = 0 );
+
+    void releaseRemoteTiles();
+
+    int64_t maxRank();
+
+private:
+    HermitianMatrix<scalar_t> D_;
+    std::map< ij_tuple, LowRankTile<scalar_t> > tiles_;
+    real_t tol_;
+};
+
+//------------------------------------------------------------------------------
+/// Creates an empty TLR matrix with the same dimensions and distribution
+/// as A, without tiles. Use compress() to fill it from A.
+///
+/// @param[in] A
+///     Hermitian matrix, stored lower.
+///
+/// @param[in] tol
+///     Absolute tolerance of the low-rank tiles, tol >= 0.
+///
+template <typename scalar_t>
+TLRMatrix<scalar_t>::TLRMatrix( HermitianMatrix<scalar_t>& A, real_t tol )
+    : D_( A.emptyLike() ),
+      tol_( tol )
+{
+    if (A.uplo() != Uplo::Lower)
+        slate_not_implemented( "TLRMatrix: only Uplo::Lower is supported" );
+    slate_assert( tol >= 0 );
+}
+
+//------------------------------------------------------------------------------
+/// Broadcasts low-rank tile {i, j} from its owner to the MPI ranks in
+/// bcast_set, sending its rank, then its factors U and V in one message,
+/// $(mb + nb) rank$ entries instead of the $mb nb$ of a dense tile.
+/// Received tiles are inserted as workspace; see releaseRemoteTiles().
+/// Uses a hypercube pattern, as BaseMatrix::tileBcast.
+/// All ranks in bcast_set must call it, in the same order for all tiles.
+///
+/// @param[in] i, j
+///     Tile to broadcast, i > j.
+///
+/// @param[in] bcast_set
+///     Set of MPI ranks to broadcast to. The owner is added if missing.
+///
+/// @param[in] tag
+///     MPI tag, default 0.
+///
+template <typename scalar_t>
+void TLRMatrix<scalar_t>::tileBcast(
+    int64_t i, int64_t j, std::set<int> const& bcast_set, int tag )
+{
+    int root = tileRank( i, j );
+    int mpi_rank = mpiRank();
+    if (mpi_rank != root && bcast_set.count( mpi_rank ) == 0)
+        return;
+
+    std::set<int> ranks( bcast_set );
+    ranks.insert( root );
+    if (ranks.size() == 1)
+        return;
+
+    trace::Block trace_block( "TLRMatrix::tileBcast" );
+
+    // Shift root to position zero, as in tileIbcastToSet.
+    std::vector<int> bcast_vec( ranks.begin(), ranks.end() );
+    auto root_iter = std::find( bcast_vec.begin(), bcast_vec.end(), root );
+    std::rotate( bcast_vec.begin(), root_iter, bcast_vec.end() );
+    auto rank_iter = std::find( bcast_vec.begin(), bcast_vec.end(), mpi_rank );
+    int new_rank = std::distance( bcast_vec.begin(), rank_iter );
+
+    std::list<int> recv_from;
+    std::list<int> send_to;
+    internal::cubeBcastPattern( bcast_vec.size(), new_rank, 2,
+                                recv_from, send_to );
+
+    MPI_Comm mpi_comm = mpiComm();
+    int64_t rank;
+    if (! recv_from.empty()) {
+        int src = bcast_vec[ recv_from.front() ];
+        slate_mpi_call(
+            MPI_Recv( &rank, 1, mpi_type<int64_t>::value, src, tag,
+                      mpi_comm, MPI_STATUS_IGNORE ) );
+        LowRankTile<scalar_t> T( tileNb( i ), tileNb( j ), rank );
+        if (rank > 0) {
+            slate_assert( T.size() <= std::numeric_limits<int>::max() );
+            slate_mpi_call(
+                MPI_Recv( T.data(), T.size(), mpi_type<scalar_t>::value,
+                          src, tag, mpi_comm, MPI_STATUS_IGNORE ) );
+        }
+        tiles_[ { i, j } ] = std::move( T );
+    }
+
+    LowRankTile<scalar_t>& T = tile( i, j );
+    rank = T.rank();
+    for (int dst : send_to) {
+        slate_mpi_call(
+            MPI_Send( &rank, 1, mpi_type<int64_t>::value,
+                      bcast_vec[ dst ], tag, mpi_comm ) );
+        if (rank > 0) {
+            slate_assert( T.size() <= std::numeric_limits<int>::max() );
+            slate_mpi_call(
+                MPI_Send( T.data(), T.size(), mpi_type<scalar_t>::value,
+                          bcast_vec[ dst ], tag, mpi_comm ) );
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Broadcasts each low-rank tile in bcast_list to its set of MPI ranks.
+/// @see tileBcast
+///
+template <typename scalar_t>
+void TLRMatrix<scalar_t>::listBcast( BcastList const& bcast_list, int tag )
+{
+    for (auto const& bcast : bcast_list) {
+        tileBcast( std::get<0>( bcast ), std::get<1>( bcast ),
+                   std::get<2>( bcast ), tag );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Erases low-rank and diagonal tiles that are not local to this MPI rank,
+/// i.e., workspace received by tileBcast or listBcast.
+///
+template <typename scalar_t>
+void TLRMatrix<scalar_t>::releaseRemoteTiles()
+{
+    for (auto iter = tiles_.begin(); iter != tiles_.end(); ) {
+        if (tileIsLocal( std::get<0>( iter->first ),
+                         std::get<1>( iter->first ) ))
+            ++iter;
+        else
+            iter = tiles_.erase( iter );
+    }
+    for (int64_t i = 0; i < nt(); ++i) {
+        if (! D_.tileIsLocal( i, i ) && D_.tileExists( i, i, AnyDevice ))
+            D_.tileRelease( i, i, AllDevices );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// @return maximum rank of the local low-rank tiles over all MPI ranks.
+/// All ranks must call it.
+///
+template <typename scalar_t>
+int64_t TLRMatrix<scalar_t>::maxRank()
+{
+    int64_t local_max = 0, max_rank;
+    for (auto const& iter : tiles_) {
+        if (tileIsLocal( std::get<0>( iter.first ), std::get<1>( iter.first ) ))
+            local_max = std::max( local_max, iter.second.rank() );
+    }
+    slate_mpi_call(
+        MPI_Allreduce( &local_max, &max_rank, 1, mpi_type<int64_t>::value,
+                       MPI_MAX, mpiComm() ) );
+    return max_rank;
+}
+
+} // namespace slate
+
+#endif // SLATE_TLR_MATRIX_HH
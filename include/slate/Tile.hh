@@ -6,9 +6,12 @@
 #ifndef SLATE_TILE_HH
 #define SLATE_TILE_HH
 
+#include "slate/Counters.hh"
 #include "slate/internal/Memory.hh"
 #include "slate/internal/Trace.hh"
+#include "slate/internal/compress.hh"
 #include "slate/internal/device.hh"
+#include "slate/internal/peer.hh"
 #include "slate/types.hh"
 #include "slate/Exception.hh"
 #include "slate/Tile_aux.hh"
@@ -21,6 +24,7 @@
 #include <cassert>
 #include <cstring>
 #include <memory>
+#include <vector>
 
 #include "slate/internal/mpi.hh"
 #include "slate/internal/openmp.hh"
@@ -98,6 +102,7 @@ enum class TileKind : char {
     Workspace  = 'w',  ///< SLATE allocated workspace tile
     SlateOwned = 'o',  ///< SLATE allocated origin tile
     UserOwned  = 'u',  ///< User owned origin tile
+    FileMapped = 'f',  ///< SLATE origin tile in a memory-mapped file
 };
 
 //------------------------------------------------------------------------------
@@ -132,6 +137,19 @@ public:
     void isend(int dst, MPI_Comm mpi_comm, int tag, MPI_Request *req) const;
     void recv(int src, MPI_Comm mpi_comm, Layout layout, int tag = 0);
     void irecv(int src, MPI_Comm mpi_comm, Layout layout, int tag, MPI_Request *req);
+    void isendSegment(int dst, MPI_Comm mpi_comm, int tag,
+                      int64_t segment, int64_t num_segments,
+                      MPI_Request *req) const;
+    void irecvSegment(int src, MPI_Comm mpi_comm, Layout layout, int tag,
+                      int64_t segment, int64_t num_segments,
+                      MPI_Request *req);
+    void compress(Compression compression, double tol,
+                  std::vector<char>& message) const;
+    void decompress(std::vector<char> const& message, Layout layout);
+    void sendCompressed(int dst, MPI_Comm mpi_comm, int tag,
+                        Compression compression, double tol = 0) const;
+    void recvCompressed(int src, MPI_Comm mpi_comm, Layout layout, int tag,
+                        std::vector<char>& message);
     void bcast(int bcast_root, MPI_Comm mpi_comm);
 
     /// Returns shallow copy of tile that is transposed.
@@ -195,8 +213,15 @@ public:
 
     /// Returns true if SLATE allocated this tile's memory,
     /// false if the user provided the tile's memory,
-    /// e.g., via a fromScaLAPACK constructor.
-    bool allocated() const { return kind_ != TileKind::UserOwned; }
+    /// e.g., via a fromScaLAPACK constructor,
+    /// or if the tile is in a memory-mapped file.
+    bool allocated() const
+    {
+        return kind_ == TileKind::Workspace || kind_ == TileKind::SlateOwned;
+    }
+
+    /// Returns true if this tile is in a memory-mapped file.
+    bool mapped() const { return kind_ == TileKind::FileMapped; }
 
     /// Returns the TileKind of this tile
     TileKind kind()
@@ -256,7 +281,7 @@ public:
     {
         return    extended()                    // already extended buffer
                || mb_ == nb_                    // square tile
-               || kind_ != TileKind::UserOwned  // SLATE allocated
+               || allocated()                   // SLATE allocated
                || isContiguous();               // contiguous
     }
 
@@ -303,6 +328,8 @@ public:
         layoutConvert(nullptr, queue, async);
     }
 
+    scalar_t* layoutConvertInto(scalar_t* new_data, blas::Queue& queue);
+
     void set(scalar_t alpha);
     void set(scalar_t alpha, scalar_t beta);
 
@@ -349,6 +376,18 @@ protected:
     template <typename T>
     friend class MatrixStorage;
 
+    /// Replaces the buffer of a SLATE allocated, contiguous tile, e.g.,
+    /// after transposing it out-of-place into new_data.
+    /// @return Pointer to the previous buffer.
+    scalar_t* replaceData(scalar_t* new_data)
+    {
+        assert(allocated() && isUserContiguous() && ! extended());
+        scalar_t* old_data = data_;
+        data_ = new_data;
+        user_data_ = new_data;
+        return old_data;
+    }
+
     void state(MOSI_State stateIn)
     {
         switch (stateIn) {
@@ -793,6 +832,7 @@ void Tile<scalar_t>::layoutConvert(scalar_t* work_data)
     slate_assert(isTransposable());
 
     trace::Block trace_block("slate::convertLayout");
+    internal::count( internal::Count::LayoutConversions );
 
     auto old_layout = layout();
     setLayout( old_layout == Layout::RowMajor ? Layout::ColMajor : Layout::RowMajor );
@@ -867,6 +907,7 @@ void Tile<scalar_t>::layoutConvert(
     slate_assert(device_ != HostNum);
 
     trace::Block trace_block("slate::convertLayout");
+    internal::count( internal::Count::LayoutConversions );
 
     auto old_layout = layout();
     setLayout( old_layout == Layout::RowMajor ? Layout::ColMajor : Layout::RowMajor );
@@ -903,6 +944,51 @@ void Tile<scalar_t>::layoutConvert(
         queue.sync();
 }
 
+//------------------------------------------------------------------------------
+/// Convert layout (Column / Row major) of this rectangular, SLATE allocated
+/// device tile, with a single out-of-place transpose into new_data, which
+/// then becomes the tile's buffer. Unlike layoutConvert with a workspace,
+/// this does not copy the tile back into its old buffer.
+/// Asynchronous: the caller frees the returned old buffer once the queue
+/// finishes.
+///
+/// @param[in] new_data
+///     Pointer to a device buffer of mb*nb scalars, e.g., from the
+///     matrix's memory pool.
+///
+/// @param[in] queue
+///     BLAS++ queue to run the kernel on the device.
+///
+/// @return Pointer to the tile's previous buffer.
+///
+template <typename scalar_t>
+scalar_t* Tile<scalar_t>::layoutConvertInto(
+    scalar_t* new_data, blas::Queue& queue)
+{
+    slate_assert(device_ != HostNum);
+    slate_assert(allocated() && isUserContiguous() && ! extended());
+    slate_assert(mb_ != nb_);
+
+    trace::Block trace_block("slate::convertLayout");
+    internal::count( internal::Count::LayoutConversions );
+
+    auto old_layout = layout();
+    int64_t old_mb = old_layout == Layout::ColMajor ? mb_ : nb_;
+    int64_t old_nb = old_layout == Layout::ColMajor ? nb_ : mb_;
+    scalar_t* old_data = data_;
+    int64_t old_stride = stride_;
+
+    setLayout( old_layout == Layout::RowMajor ? Layout::ColMajor : Layout::RowMajor );
+    replaceData( new_data );
+
+    device::transpose(
+        false,
+        old_mb, old_nb,
+        old_data, old_stride, data_, stride_, queue);
+
+    return old_data;
+}
+
 //------------------------------------------------------------------------------
 /// Copies data from this tile to dst_tile (host to host implementation).
 /// WARNING: device ID set in device_ of both tiles should be properly set.
@@ -959,16 +1045,29 @@ void Tile<scalar_t>::copyData(
         // (host or device) to (host or device)
         dst_tile->setLayout( this->layout() );
 
+        bool peer = this->device_ != HostNum && dst_tile->device() != HostNum
+                    && this->device_ != dst_tile->device();
+
         // If no stride on both sides.
-        if (this->isContiguous() && dst_tile->isContiguous()) {
+        if (peer && this->isContiguous() && dst_tile->isContiguous()) {
+            // Device to device: copy directly, e.g., over NVLink.
+            trace::Block trace_block( "internal::peer_memcpy" );
+            trace::DeviceBlock trace_device( "internal::peer_memcpy", queue );
+            internal::peer_memcpy( dst_tile->data_, dst_tile->device(),
+                                   data_, this->device_,
+                                   size() * sizeof(scalar_t), queue );
+        }
+        else if (this->isContiguous() && dst_tile->isContiguous()) {
             // Use simple copy.
             trace::Block trace_block( "blas::device_memcpy" );
+            trace::DeviceBlock trace_device( "blas::device_memcpy", queue );
             blas::device_memcpy<scalar_t>(
                 dst_tile->data_, data_, size(), queue );
         }
         else {
             // Otherwise, use 2D copy.
             trace::Block trace_block( "blas::device_memcpy_2d" );
+            trace::DeviceBlock trace_device( "blas::device_memcpy_2d", queue );
             blas::device_memcpy_2d<scalar_t>(
                 dst_tile->data_, dst_tile->stride_,
                 data_, stride_,
@@ -1024,6 +1123,7 @@ template <typename scalar_t>
 void Tile<scalar_t>::isend(int dst, MPI_Comm mpi_comm, int tag, MPI_Request *request) const
 {
     trace::Block trace_block("MPI_Isend");
+    internal::count_message( dst, mb_*nb_*sizeof(scalar_t) );
 
     // If no stride.
     if (this->isContiguous()) {
@@ -1039,15 +1139,13 @@ void Tile<scalar_t>::isend(int dst, MPI_Comm mpi_comm, int tag, MPI_Request *req
         int count = layout_ == Layout::ColMajor ? nb_ : mb_;
         int blocklength = layout_ == Layout::ColMajor ? mb_ : nb_;
         int stride = stride_;
-        MPI_Datatype newtype;
+        bool cached;
+        MPI_Datatype newtype = internal::vectorType(
+            count, blocklength, stride, mpi_type<scalar_t>::value, &cached );
 
-        slate_mpi_call(
-            MPI_Type_vector(count, blocklength, stride,
-                            mpi_type<scalar_t>::value, &newtype));
-
-        slate_mpi_call(MPI_Type_commit(&newtype));
         slate_mpi_call(MPI_Isend(data_, 1, newtype, dst, tag, mpi_comm, request));
-        slate_mpi_call(MPI_Type_free(&newtype));
+        if (! cached)
+            slate_mpi_call(MPI_Type_free(&newtype));
     }
     // todo: would specializing to Triangular / Band tiles improve performance
     // by receiving less / compacted data
@@ -1103,6 +1201,7 @@ void Tile<scalar_t>::irecv(int src, MPI_Comm mpi_comm, Layout layout,
                            int tag, MPI_Request* request)
 {
     trace::Block trace_block("MPI_Irecv");
+    internal::count( internal::Count::BytesRecv, mb_*nb_*sizeof(scalar_t) );
 
     this->setLayout( layout );
 
@@ -1120,25 +1219,292 @@ void Tile<scalar_t>::irecv(int src, MPI_Comm mpi_comm, Layout layout,
         int count = layout_ == Layout::ColMajor ? nb_ : mb_;
         int blocklength = layout_ == Layout::ColMajor ? mb_ : nb_;
         int stride = stride_;
-        MPI_Datatype newtype;
-
-        slate_mpi_call(
-            MPI_Type_vector(
-                count, blocklength, stride, mpi_type<scalar_t>::value,
-                &newtype));
-
-        slate_mpi_call(MPI_Type_commit(&newtype));
+        bool cached;
+        MPI_Datatype newtype = internal::vectorType(
+            count, blocklength, stride, mpi_type<scalar_t>::value, &cached );
 
         slate_mpi_call(
             MPI_Irecv(data_, 1, newtype, src, tag, mpi_comm,
                       request));
 
-        slate_mpi_call(MPI_Type_free(&newtype));
+        if (! cached)
+            slate_mpi_call(MPI_Type_free(&newtype));
     }
     // todo: would specializing to Triangular / Band tiles improve performance
     // by receiving less / compacted data
 }
 
+namespace internal {
+
+//------------------------------------------------------------------------------
+/// [internal]
+/// Creates an MPI datatype for segment out of num_segments of a tile.
+/// The tile is split into segments of whole columns (ColMajor) or
+/// rows (RowMajor), so each segment is a strided vector, or contiguous
+/// if the tile is contiguous.
+///
+/// @param[in] layout, mb, nb, stride
+///     Layout, stored dimensions, and stride of the tile.
+///
+/// @param[in] segment
+///     Index of the segment. 0 <= segment < num_segments.
+///
+/// @param[in] num_segments
+///     Number of segments. 1 <= num_segments <= number of columns (ColMajor)
+///     or rows (RowMajor).
+///
+/// @param[out] offset
+///     Offset of the segment in the tile's data.
+///
+/// @param[out] newtype
+///     Committed datatype of the segment, from the cache of vectorType().
+///
+/// @param[out] cached
+///     False if newtype isn't cached and must be freed by the caller.
+///
+template <typename scalar_t>
+void tileSegmentType(
+    Layout layout, int64_t mb, int64_t nb, int64_t stride,
+    int64_t segment, int64_t num_segments,
+    int64_t* offset, MPI_Datatype* newtype, bool* cached)
+{
+    int64_t num_vectors = layout == Layout::ColMajor ? nb : mb;
+    int blocklength = layout == Layout::ColMajor ? mb : nb;
+    int64_t begin = segment * num_vectors / num_segments;
+    int64_t end = (segment + 1) * num_vectors / num_segments;
+    *offset = begin * stride;
+
+    *newtype = vectorType(
+        end - begin, blocklength, stride, mpi_type<scalar_t>::value, cached );
+}
+
+} // namespace internal
+
+//------------------------------------------------------------------------------
+/// Sends one segment of the tile to MPI rank dst, using immediate mode.
+/// Used to pipeline broadcasts of large tiles.
+/// @see internal::tileSegmentType
+///
+/// @param[in] dst
+///     Destination MPI rank in mpi_comm.
+///
+/// @param[in] mpi_comm
+///     MPI communicator.
+///
+/// @param[in] tag
+///     MPI tag
+///
+/// @param[in] segment
+///     Index of the segment. 0 <= segment < num_segments.
+///
+/// @param[in] num_segments
+///     Number of segments the tile is split into.
+///
+/// @param[out] request
+///     MPI Request object
+///
+template <typename scalar_t>
+void Tile<scalar_t>::isendSegment(
+    int dst, MPI_Comm mpi_comm, int tag,
+    int64_t segment, int64_t num_segments, MPI_Request* request) const
+{
+    trace::Block trace_block("MPI_Isend");
+
+    int64_t offset;
+    MPI_Datatype newtype;
+    bool cached;
+    internal::tileSegmentType<scalar_t>(
+        layout_, mb_, nb_, stride_, segment, num_segments,
+        &offset, &newtype, &cached );
+    int bytes;
+    slate_mpi_call(MPI_Type_size(newtype, &bytes));
+    internal::count_message( dst, bytes );
+    slate_mpi_call(
+        MPI_Isend(data_ + offset, 1, newtype, dst, tag, mpi_comm, request));
+    if (! cached)
+        slate_mpi_call(MPI_Type_free(&newtype));
+}
+
+//------------------------------------------------------------------------------
+/// Receives one segment of the tile from MPI rank src, using immediate mode.
+/// Used to pipeline broadcasts of large tiles.
+/// @see internal::tileSegmentType
+///
+/// @param[in] src
+///     Source MPI rank in mpi_comm.
+///
+/// @param[in] mpi_comm
+///     MPI communicator.
+///
+/// @param[in] layout
+///     Indicates the Layout (ColMajor/RowMajor) of the received data.
+///
+/// @param[in] tag
+///     MPI tag
+///
+/// @param[in] segment
+///     Index of the segment. 0 <= segment < num_segments.
+///
+/// @param[in] num_segments
+///     Number of segments the tile is split into.
+///
+/// @param[out] request
+///     MPI request object
+///
+template <typename scalar_t>
+void Tile<scalar_t>::irecvSegment(
+    int src, MPI_Comm mpi_comm, Layout layout, int tag,
+    int64_t segment, int64_t num_segments, MPI_Request* request)
+{
+    trace::Block trace_block("MPI_Irecv");
+
+    this->setLayout( layout );
+
+    int64_t offset;
+    MPI_Datatype newtype;
+    bool cached;
+    internal::tileSegmentType<scalar_t>(
+        layout_, mb_, nb_, stride_, segment, num_segments,
+        &offset, &newtype, &cached );
+    int bytes;
+    slate_mpi_call(MPI_Type_size(newtype, &bytes));
+    internal::count( internal::Count::BytesRecv, bytes );
+    slate_mpi_call(
+        MPI_Irecv(data_ + offset, 1, newtype, src, tag, mpi_comm, request));
+    if (! cached)
+        slate_mpi_call(MPI_Type_free(&newtype));
+}
+
+//------------------------------------------------------------------------------
+/// Compresses the tile into a message for sendCompressed or MPI_Send
+/// with MPI_BYTE. The message is either compressed, or, if that wouldn't
+/// make it shorter, the raw entries packed contiguously.
+/// @see internal::compress
+///
+/// @param[in] compression
+///     Lossless or ErrorBounded; @see BaseMatrix::compressTransfers.
+///
+/// @param[in] tol
+///     With ErrorBounded, relative error tolerance of each real entry.
+///
+/// @param[out] message
+///     The message, resized to its length.
+///
+template <typename scalar_t>
+void Tile<scalar_t>::compress(
+    Compression compression, double tol, std::vector<char>& message) const
+{
+    using real_t = blas::real_type<scalar_t>;
+    trace::Block trace_block("internal::compress");
+
+    // Complex entries are compressed as pairs of real entries.
+    const int64_t reals = is_complex ? 2 : 1;
+    int64_t vector_len  = layout_ == Layout::ColMajor ? mb_ : nb_;
+    int64_t num_vectors = layout_ == Layout::ColMajor ? nb_ : mb_;
+    internal::compress<real_t>(
+        compression, tol, (real_t const*) data_, reals*vector_len,
+        num_vectors, reals*stride_, message );
+}
+
+//------------------------------------------------------------------------------
+/// Decompresses a message made by compress into the tile.
+///
+/// @param[in] message
+///     The message.
+///
+/// @param[in] layout
+///     Indicates the Layout (ColMajor/RowMajor) of the compressed data.
+///
+template <typename scalar_t>
+void Tile<scalar_t>::decompress(std::vector<char> const& message, Layout layout)
+{
+    using real_t = blas::real_type<scalar_t>;
+    trace::Block trace_block("internal::decompress");
+
+    this->setLayout( layout );
+
+    const int64_t reals = is_complex ? 2 : 1;
+    int64_t vector_len  = layout_ == Layout::ColMajor ? mb_ : nb_;
+    int64_t num_vectors = layout_ == Layout::ColMajor ? nb_ : mb_;
+    internal::decompress<real_t>(
+        message.data(), message.size(), (real_t*) data_, reals*vector_len,
+        num_vectors, reals*stride_ );
+}
+
+//------------------------------------------------------------------------------
+/// Compresses and sends tile to MPI rank dst, which must receive it with
+/// recvCompressed, since the length of the message varies.
+///
+/// @param[in] dst
+///     Destination MPI rank in mpi_comm.
+///
+/// @param[in] mpi_comm
+///     MPI communicator.
+///
+/// @param[in] tag
+///     MPI tag
+///
+/// @param[in] compression, tol
+///     As in compress.
+///
+template <typename scalar_t>
+void Tile<scalar_t>::sendCompressed(
+    int dst, MPI_Comm mpi_comm, int tag,
+    Compression compression, double tol) const
+{
+    thread_local std::vector<char> message;
+    compress( compression, tol, message );
+
+    trace::Block trace_block("MPI_Send");
+    internal::count_message( dst, message.size() );
+    slate_mpi_call(
+        MPI_Send( message.data(), message.size(), MPI_BYTE, dst, tag,
+                  mpi_comm ) );
+}
+
+//------------------------------------------------------------------------------
+/// Receives tile compressed by sendCompressed or compress from MPI rank src,
+/// and decompresses it. The message is matched with MPI_Mprobe, so another
+/// thread can't receive it between finding its length and receiving it.
+///
+/// @param[in] src
+///     Source MPI rank in mpi_comm.
+///
+/// @param[in] mpi_comm
+///     MPI communicator.
+///
+/// @param[in] layout
+///     Indicates the Layout (ColMajor/RowMajor) of the received data.
+///
+/// @param[in] tag
+///     MPI tag
+///
+/// @param[out] message
+///     The message received, e.g., to forward it without compressing again.
+///
+template <typename scalar_t>
+void Tile<scalar_t>::recvCompressed(
+    int src, MPI_Comm mpi_comm, Layout layout, int tag,
+    std::vector<char>& message)
+{
+    {
+        trace::Block trace_block("MPI_Recv");
+
+        MPI_Message mpi_message;
+        MPI_Status status;
+        slate_mpi_call(
+            MPI_Mprobe( src, tag, mpi_comm, &mpi_message, &status ) );
+        int len;
+        slate_mpi_call( MPI_Get_count( &status, MPI_BYTE, &len ) );
+        message.resize( len );
+        slate_mpi_call(
+            MPI_Mrecv( message.data(), len, MPI_BYTE, &mpi_message,
+                       MPI_STATUS_IGNORE ) );
+        internal::count( internal::Count::BytesRecv, len );
+    }
+    decompress( message, layout );
+}
+
 //------------------------------------------------------------------------------
 /// Broadcasts tile from MPI rank bcast_root, using given communicator.
 ///
@@ -1172,34 +1538,56 @@ void Tile<scalar_t>::bcast(int bcast_root, MPI_Comm mpi_comm)
     {
         // Otherwise, use strided bcast.
         trace::Block trace_block("MPI_Bcast");
+        int mpi_rank;
+        MPI_Comm_rank(mpi_comm, &mpi_rank);
+        internal::count( mpi_rank == bcast_root ? internal::Count::BytesSent
+                                                : internal::Count::BytesRecv,
+                         mb_*nb_*sizeof(scalar_t) );
         // todo: layout
         int count = layout_ == Layout::ColMajor ? nb_ : mb_;
         int blocklength = layout_ == Layout::ColMajor ? mb_ : nb_;
         int stride = stride_;
-        MPI_Datatype newtype;
 
-        #pragma omp critical(slate_mpi)
-        {
-            slate_mpi_call(
-                MPI_Type_vector(
-                    count, blocklength, stride, mpi_type<scalar_t>::value,
-                    &newtype));
+        if (internal::mpiPackTiles()) {
+            // All ranks send a contiguous buffer, so they agree on the
+            // bcast algorithm. Strided tiles are packed in a buffer
+            // reused by later broadcasts on this thread.
+            scalar_t* buffer = data_;
+            thread_local std::vector<scalar_t> pack_buffer;
+            if (! isContiguous()) {
+                pack_buffer.resize( mb_*nb_ );
+                buffer = pack_buffer.data();
+                if (mpi_rank == bcast_root) {
+                    lapack::lacpy( lapack::MatrixType::General,
+                                   blocklength, count,
+                                   data_, stride,
+                                   buffer, blocklength );
+                }
+            }
+            {
+                internal::MpiGuard mpi_guard;
+                slate_mpi_call(
+                    MPI_Bcast(buffer, mb_*nb_, mpi_type<scalar_t>::value,
+                              bcast_root, mpi_comm));
+            }
+            if (buffer != data_ && mpi_rank != bcast_root) {
+                lapack::lacpy( lapack::MatrixType::General,
+                               blocklength, count,
+                               buffer, blocklength,
+                               data_, stride );
+            }
+            return;
         }
 
-        #pragma omp critical(slate_mpi)
-        {
-            slate_mpi_call(
-                MPI_Type_commit(&newtype));
-        }
+        bool cached;
+        MPI_Datatype newtype = internal::vectorType(
+            count, blocklength, stride, mpi_type<scalar_t>::value, &cached );
 
-        #pragma omp critical(slate_mpi)
-        {
-            slate_mpi_call(
-                MPI_Bcast(data_, 1, newtype, bcast_root, mpi_comm));
-        }
+        internal::MpiGuard mpi_guard;
+        slate_mpi_call(
+            MPI_Bcast(data_, 1, newtype, bcast_root, mpi_comm));
 
-        #pragma omp critical(slate_mpi)
-        {
+        if (! cached) {
             slate_mpi_call(
                 MPI_Type_free(&newtype));
         }
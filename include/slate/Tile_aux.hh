@@ -18,8 +18,110 @@ class Tile;
 
 namespace tile {
 
+//------------------------------------------------------------------------------
+/// @return whether tiles A and B are stored with the same layout, and both
+/// contiguously, so their entries can be processed as one flat array of
+/// mb*nb entries.
+///
+template <typename scalar_a, typename scalar_b>
+bool contiguous_same_layout(Tile<scalar_a> const& A, Tile<scalar_b> const& B)
+{
+    int64_t col_inc = A.colIncrement();
+    int64_t row_inc = A.rowIncrement();
+    return col_inc == B.colIncrement() && row_inc == B.rowIncrement()
+           && ((col_inc == 1 && row_inc == A.mb())
+               || (row_inc == 1 && col_inc == A.nb()));
+}
+
+//------------------------------------------------------------------------------
+/// Copy, precision conversion, and scaling, B = alpha A.
+/// Contiguous tiles with the same layout are processed as one flat,
+/// vectorized loop; column-major tiles one vectorized column at a time.
+/// @ingroup copy_tile
+///
+template <typename src_scalar_t, typename dst_scalar_t>
+void gecopy(
+    dst_scalar_t alpha, Tile<src_scalar_t> const& A, Tile<dst_scalar_t>& B)
+{
+    using blas::conj;
+
+    assert(A.mb() == B.mb());
+    assert(A.nb() == B.nb());
+    // Quick return
+    if (A.mb() == 0 || A.nb() == 0)
+        return;
+
+    const src_scalar_t* A00 = &A.at(0, 0);
+    int64_t a_col_inc = A.colIncrement();
+    int64_t a_row_inc = A.rowIncrement();
+    dst_scalar_t* B00 = &B.at(0, 0);
+    int64_t b_col_inc = B.colIncrement();
+    int64_t b_row_inc = B.rowIncrement();
+    int64_t mb = B.mb();
+    int64_t nb = B.nb();
+
+    // (A is conj) xor (B is conj)
+    bool is_conj = (A.op() == Op::ConjTrans) != (B.op() == Op::ConjTrans);
+    if (B.op() == Op::ConjTrans)
+        alpha = conj( alpha );
+
+    if (contiguous_same_layout( A, B )) {
+        int64_t len = mb*nb;
+        if (is_conj) {
+            #pragma omp simd
+            for (int64_t k = 0; k < len; ++k)
+                B00[ k ] = alpha * dst_scalar_t( conj( A00[ k ] ) );
+        }
+        else {
+            #pragma omp simd
+            for (int64_t k = 0; k < len; ++k)
+                B00[ k ] = alpha * dst_scalar_t( A00[ k ] );
+        }
+    }
+    else if (a_col_inc == 1 && b_col_inc == 1) {
+        for (int64_t j = 0; j < nb; ++j) {
+            const src_scalar_t* Aj = &A00[j*a_row_inc];
+            dst_scalar_t* Bj = &B00[j*b_row_inc];
+            if (is_conj) {
+                #pragma omp simd
+                for (int64_t i = 0; i < mb; ++i)
+                    Bj[ i ] = alpha * dst_scalar_t( conj( Aj[ i ] ) );
+            }
+            else {
+                #pragma omp simd
+                for (int64_t i = 0; i < mb; ++i)
+                    Bj[ i ] = alpha * dst_scalar_t( Aj[ i ] );
+            }
+        }
+    }
+    else {
+        for (int64_t j = 0; j < nb; ++j) {
+            const src_scalar_t* Aj = &A00[j*a_row_inc];
+            dst_scalar_t* Bj = &B00[j*b_row_inc];
+            for (int64_t i = 0; i < mb; ++i) {
+                Bj[i*b_col_inc] = is_conj
+                                ? alpha * dst_scalar_t( conj( Aj[i*a_col_inc] ) )
+                                : alpha * dst_scalar_t( Aj[i*a_col_inc] );
+            }
+        }
+    }
+}
+
+//-----------------------------------------
+/// Converts rvalue refs to lvalue refs.
+/// @ingroup copy_tile
+///
+template <typename src_scalar_t, typename dst_scalar_t>
+void gecopy(
+    dst_scalar_t alpha, Tile<src_scalar_t> const&& A, Tile<dst_scalar_t>&& B)
+{
+    gecopy(alpha, A, B);
+}
+
 //------------------------------------------------------------------------------
 /// Copy and precision conversion, copying tile A to B.
+/// Contiguous tiles with the same layout are copied as one flat,
+/// vectorized loop; column-major tiles one vectorized column at a time.
 /// @ingroup copy_tile
 ///
 template <typename src_scalar_t, typename dst_scalar_t>
@@ -44,14 +146,35 @@ void gecopy(Tile<src_scalar_t> const& A, Tile<dst_scalar_t>& B)
     bool A_is_conj = A.op() == Op::ConjTrans;
     bool B_is_conj = B.op() == Op::ConjTrans;
 
-    if (A_is_conj != B_is_conj) {
+    if (contiguous_same_layout( A, B )) {
+        int64_t len = B.mb() * B.nb();
+        if (A_is_conj != B_is_conj) {
+            #pragma omp simd
+            for (int64_t k = 0; k < len; ++k)
+                B00[ k ] = conj( A00[ k ] );
+        }
+        else {
+            #pragma omp simd
+            for (int64_t k = 0; k < len; ++k)
+                B00[ k ] = A00[ k ];
+        }
+    }
+    else if (A_is_conj != B_is_conj) {
         // (A is conj) xor (B is conj)
         for (int64_t j = 0; j < B.nb(); ++j) {
             const src_scalar_t* Aj = &A00[j*a_row_inc];
             dst_scalar_t* Bj = &B00[j*b_row_inc];
 
-            for (int64_t i = 0; i < B.mb(); ++i) {
-                Bj[i*b_col_inc] = conj( Aj[i*a_col_inc] );
+            if (a_col_inc == 1 && b_col_inc == 1) {
+                #pragma omp simd
+                for (int64_t i = 0; i < B.mb(); ++i) {
+                    Bj[i] = conj( Aj[i] );
+                }
+            }
+            else {
+                for (int64_t i = 0; i < B.mb(); ++i) {
+                    Bj[i*b_col_inc] = conj( Aj[i*a_col_inc] );
+                }
             }
         }
     }
@@ -60,8 +183,16 @@ void gecopy(Tile<src_scalar_t> const& A, Tile<dst_scalar_t>& B)
             const src_scalar_t* Aj = &A00[j*a_row_inc];
             dst_scalar_t* Bj = &B00[j*b_row_inc];
 
-            for (int64_t i = 0; i < B.mb(); ++i) {
-                Bj[i*b_col_inc] = Aj[i*a_col_inc];
+            if (a_col_inc == 1 && b_col_inc == 1) {
+                #pragma omp simd
+                for (int64_t i = 0; i < B.mb(); ++i) {
+                    Bj[i] = Aj[i];
+                }
+            }
+            else {
+                for (int64_t i = 0; i < B.mb(); ++i) {
+                    Bj[i*b_col_inc] = Aj[i*a_col_inc];
+                }
             }
         }
     }
@@ -78,6 +209,66 @@ void gecopy(Tile<src_scalar_t> const&& A, Tile<dst_scalar_t>&& B)
     gecopy(A, B);
 }
 
+//------------------------------------------------------------------------------
+/// Add and precision conversion, setting $B = \alpha A + \beta B$,
+/// where A may be in a lower precision than B. This reads A once,
+/// instead of first copying it to a temporary in B's precision.
+/// Assumes A and B have the same op; column-major tiles are added one
+/// vectorized column at a time.
+/// @ingroup geadd_tile
+///
+template <typename src_scalar_t, typename dst_scalar_t>
+void geadd(
+    dst_scalar_t alpha, Tile<src_scalar_t> const& A,
+    dst_scalar_t beta,  Tile<dst_scalar_t>& B)
+{
+//  trace::Block trace_block("aux::add");
+
+    assert(A.op() == B.op());
+    assert(A.mb() == B.mb());
+    assert(A.nb() == B.nb());
+    // Quick return
+    if (A.mb() == 0 || A.nb() == 0)
+        return;
+
+    const src_scalar_t* A00 = &A.at(0, 0);
+    int64_t a_col_inc = A.colIncrement();
+    int64_t a_row_inc = A.rowIncrement();
+    dst_scalar_t* B00 = &B.at(0, 0);
+    int64_t b_col_inc = B.colIncrement();
+    int64_t b_row_inc = B.rowIncrement();
+
+    for (int64_t j = 0; j < B.nb(); ++j) {
+        const src_scalar_t* Aj = &A00[j*a_row_inc];
+        dst_scalar_t* Bj = &B00[j*b_row_inc];
+
+        if (a_col_inc == 1 && b_col_inc == 1) {
+            #pragma omp simd
+            for (int64_t i = 0; i < B.mb(); ++i) {
+                Bj[i] = alpha * dst_scalar_t( Aj[i] ) + beta * Bj[i];
+            }
+        }
+        else {
+            for (int64_t i = 0; i < B.mb(); ++i) {
+                Bj[i*b_col_inc] = alpha * dst_scalar_t( Aj[i*a_col_inc] )
+                                + beta * Bj[i*b_col_inc];
+            }
+        }
+    }
+}
+
+//-----------------------------------------
+/// Converts rvalue refs to lvalue refs.
+/// @ingroup geadd_tile
+///
+template <typename src_scalar_t, typename dst_scalar_t>
+void geadd(
+    dst_scalar_t alpha, Tile<src_scalar_t> const&& A,
+    dst_scalar_t beta,  Tile<dst_scalar_t>&& B)
+{
+    geadd( alpha, A, beta, B );
+}
+
 //------------------------------------------------------------------------------
 /// Copy and precision conversion.
 /// @ingroup copy_tile
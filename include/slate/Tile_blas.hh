@@ -12,27 +12,154 @@
 #include "slate/internal/util.hh"
 #include "slate/internal/device.hh"
 
+#include <complex>
 #include <list>
+#include <vector>
 
 namespace slate {
 
 namespace tile {
 
+//------------------------------------------------------------------------------
+/// Copies the real and imaginary parts of op(A), m-by-n, into the
+/// column-major m-by-n arrays Ar and Ai.
+///
+template <typename real_t>
+void gemm3m_split(
+    Op op, int64_t m, int64_t n,
+    std::complex<real_t> const* A, int64_t lda,
+    real_t* Ar, real_t* Ai )
+{
+    for (int64_t j = 0; j < n; ++j) {
+        for (int64_t i = 0; i < m; ++i) {
+            std::complex<real_t> a = op == Op::NoTrans
+                                   ? A[ i + j*lda ] : A[ j + i*lda ];
+            Ar[ i + j*m ] = a.real();
+            Ai[ i + j*m ] = op == Op::ConjTrans ? -a.imag() : a.imag();
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Complex matrix multiply, $C = \alpha op(A) op(B) + \beta C$, with the
+/// 3M (Gauss) algorithm: with $op(A) = A_r + i A_i$ and
+/// $op(B) = B_r + i B_i$, the product is
+/// $T_1 - T_2 + i (T_3 - T_1 - T_2)$, where $T_1 = A_r B_r$,
+/// $T_2 = A_i B_i$, and $T_3 = (A_r + A_i) (B_r + B_i)$,
+/// i.e., 3 real gemms instead of the 4 real-equivalent products of
+/// complex gemm: 25% fewer flops, at the cost of a copy of A and B and
+/// 3 real m-by-n workspaces.
+///
+/// The error is bounded normwise, $\|E\| \le c \epsilon \|A\| \|B\|$,
+/// as for complex gemm, but not componentwise: the imaginary part loses
+/// relative accuracy when it is much smaller than the real part
+/// (Higham, Accuracy and Stability of Numerical Algorithms, sec. 23.2.4).
+/// @see ComputePrecision::Complex3M
+/// @ingroup gemm_tile
+///
+template <typename real_t>
+void gemm3m(
+    Layout layout, Op opA, Op opB,
+    int64_t m, int64_t n, int64_t k,
+    std::complex<real_t> alpha, std::complex<real_t> const* A, int64_t lda,
+                                std::complex<real_t> const* B, int64_t ldb,
+    std::complex<real_t> beta,  std::complex<real_t>* C, int64_t ldc )
+{
+    using std::swap;
+    const std::complex<real_t> zero = 0.0;
+    const real_t one = 1.0, rzero = 0.0;
+
+    // Row-major C^T = op(B)^T op(A)^T is column-major.
+    if (layout == Layout::RowMajor) {
+        swap( opA, opB );
+        swap( m, n );
+        swap( A, B );
+        swap( lda, ldb );
+    }
+
+    if (m == 0 || n == 0)
+        return;
+
+    std::vector<real_t> work( 2*m*k + 2*k*n + 3*m*n );
+    real_t* Ar = work.data();
+    real_t* Ai = Ar + m*k;
+    real_t* Br = Ai + m*k;
+    real_t* Bi = Br + k*n;
+    real_t* T1 = Bi + k*n;
+    real_t* T2 = T1 + m*n;
+    real_t* T3 = T2 + m*n;
+
+    if (k > 0) {
+        gemm3m_split( opA, m, k, A, lda, Ar, Ai );
+        gemm3m_split( opB, k, n, B, ldb, Br, Bi );
+
+        blas::gemm( Layout::ColMajor, Op::NoTrans, Op::NoTrans, m, n, k,
+                    one, Ar, m, Br, k, rzero, T1, m );
+        blas::gemm( Layout::ColMajor, Op::NoTrans, Op::NoTrans, m, n, k,
+                    one, Ai, m, Bi, k, rzero, T2, m );
+        for (int64_t i = 0; i < m*k; ++i)
+            Ar[ i ] += Ai[ i ];
+        for (int64_t i = 0; i < k*n; ++i)
+            Br[ i ] += Bi[ i ];
+        blas::gemm( Layout::ColMajor, Op::NoTrans, Op::NoTrans, m, n, k,
+                    one, Ar, m, Br, k, rzero, T3, m );
+    }
+
+    for (int64_t j = 0; j < n; ++j) {
+        for (int64_t i = 0; i < m; ++i) {
+            int64_t ij = i + j*m;
+            std::complex<real_t> p( T1[ ij ] - T2[ ij ],
+                                    T3[ ij ] - T1[ ij ] - T2[ ij ] );
+            std::complex<real_t>& c = C[ i + j*ldc ];
+            // With beta = 0, C is set, not scaled, so NaN in C is ignored.
+            c = beta == zero ? alpha*p : alpha*p + beta*c;
+        }
+    }
+}
+
+//-----------------------------------------
+/// Real gemm3m is the real gemm.
+/// @ingroup gemm_tile
+///
+template <typename scalar_t>
+void gemm3m(
+    Layout layout, Op opA, Op opB,
+    int64_t m, int64_t n, int64_t k,
+    scalar_t alpha, scalar_t const* A, int64_t lda,
+                    scalar_t const* B, int64_t ldb,
+    scalar_t beta,  scalar_t* C, int64_t ldc )
+{
+    blas::gemm( layout, opA, opB, m, n, k,
+                alpha, A, lda, B, ldb, beta, C, ldc );
+}
+
 //------------------------------------------------------------------------------
 /// General matrix multiply: $op(C) = \alpha op(A) op(B) + \beta C$.
 /// Use transpose() or conj_transpose() to set $op(A)$, $op(B)$, and $op(C)$.
 /// In the complex case,
 /// if $op(C)$ is transpose, then $op(A)$ and $op(B)$ cannot be conj_transpose;
 /// if $op(C)$ is conj_transpose, then $op(A)$ and $op(B)$ cannot be transpose.
+/// With precision ComputePrecision::Complex3M, complex tiles are
+/// multiplied with gemm3m.
 /// @ingroup gemm_tile
 ///
 template <typename scalar_t>
 void gemm(
     scalar_t alpha, Tile<scalar_t> const& A,
                     Tile<scalar_t> const& B,
-    scalar_t beta,  Tile<scalar_t>& C)
+    scalar_t beta,  Tile<scalar_t>& C,
+    ComputePrecision precision = ComputePrecision::Native)
 {
-    trace::Block trace_block("blas::gemm");
+    trace::Block trace_block(
+        precision == ComputePrecision::Complex3M ? "blas::gemm3m"
+                                                 : "blas::gemm");
+
+    auto gemm_ = [precision]( auto... args ) {
+        if (precision == ComputePrecision::Complex3M)
+            gemm3m( args... );
+        else
+            blas::gemm( args... );
+    };
 
     using blas::conj;
 
@@ -47,12 +174,12 @@ void gemm(
 
     if (C.op() == Op::NoTrans) {
         // C = opA(A) opB(B) + C
-        blas::gemm(C.layout(),
-                   A.op(), B.op(),
-                   C.mb(), C.nb(), A.nb(),
-                   alpha, A.data(), A.stride(),
-                          B.data(), B.stride(),
-                   beta,  C.data(), C.stride());
+        gemm_(C.layout(),
+              A.op(), B.op(),
+              C.mb(), C.nb(), A.nb(),
+              alpha, A.data(), A.stride(),
+                     B.data(), B.stride(),
+              beta,  C.data(), C.stride());
     }
     else {
         // opC is Trans or ConjTrans
@@ -86,12 +213,12 @@ void gemm(
             beta  = conj(beta);
         }
 
-        blas::gemm(C.layout(),
-                   opB, opA,
-                   C.nb(), C.mb(), A.nb(),
-                   alpha, B.data(), B.stride(),
-                          A.data(), A.stride(),
-                   beta,  C.data(), C.stride());
+        gemm_(C.layout(),
+              opB, opA,
+              C.nb(), C.mb(), A.nb(),
+              alpha, B.data(), B.stride(),
+                     A.data(), A.stride(),
+              beta,  C.data(), C.stride());
     }
 }
 
@@ -103,9 +230,10 @@ template <typename scalar_t>
 void gemm(
     scalar_t alpha, Tile<scalar_t> const&& A,
                     Tile<scalar_t> const&& B,
-    scalar_t beta,  Tile<scalar_t>&& C)
+    scalar_t beta,  Tile<scalar_t>&& C,
+    ComputePrecision precision = ComputePrecision::Native)
 {
-    gemm(alpha, A, B, beta, C);
+    gemm(alpha, A, B, beta, C, precision);
 }
 
 //------------------------------------------------------------------------------
@@ -279,10 +407,11 @@ void herk(
     assert(A.uploPhysical() == Uplo::General);
     assert(C.mb() == C.nb());  // square
     assert(C.mb() == A.mb());  // n
+    assert(A.layout() == C.layout());
     if (C.is_complex && C.op() == Op::Trans)
         throw std::exception();
 
-    blas::herk(blas::Layout::ColMajor,
+    blas::herk(C.layout(),
                C.uploPhysical(), A.op(),
                C.nb(), A.nb(),
                alpha, A.data(), A.stride(),
@@ -692,8 +821,9 @@ void trsm(
     assert(A.mb() == A.nb());  // square
     assert(side == Side::Left ? A.mb() == B.mb()    // m
                               : A.mb() == B.nb());  // n
+    assert(A.layout() == B.layout());
     if (B.op() == Op::NoTrans) {
-        blas::trsm(blas::Layout::ColMajor,
+        blas::trsm(B.layout(),
                    side, A.uploPhysical(), A.op(), diag,
                    B.mb(), B.nb(),
                    alpha, A.data(), A.stride(),
@@ -719,7 +849,7 @@ void trsm(
         if (B.op() == Op::ConjTrans)
             alpha = conj(alpha);
 
-        blas::trsm(blas::Layout::ColMajor,
+        blas::trsm(B.layout(),
                    side2, A.uploPhysical(), opA, diag,
                    B.nb(), B.mb(),
                    alpha, A.data(), A.stride(),
@@ -757,7 +887,11 @@ void scale(
     int64_t col_inc = A.colIncrement();
     int64_t row_inc = A.rowIncrement();
     scalar_t* A00 = &A.at(0, 0);
-    if (col_inc == 1) {
+    if (contiguous_same_layout( A, A )) {
+        // whole tile at once
+        blas::scal(A.mb() * A.nb(), alpha, A00, 1);
+    }
+    else if (col_inc == 1) {
         // one column at a time
         for (int64_t j = 0; j < A.nb(); ++j)
             blas::scal(A.mb(), alpha, &A00[j*row_inc], col_inc);
@@ -803,7 +937,11 @@ void add(
     int64_t x_row_inc = X.rowIncrement();
     const scalar_t* X00 = &X.at(0, 0);
 
-    if (y_col_inc == 1) {
+    if (X.mb() == Y.mb() && X.nb() == Y.nb() && contiguous_same_layout( X, Y )) {
+        // whole tile at once
+        blas::axpy( Y.mb() * Y.nb(), alpha, X00, 1, Y00, 1 );
+    }
+    else if (y_col_inc == 1) {
         // one column of y at a time
         int64_t m = std::min(X.mb(), Y.mb());
         for (int64_t j = 0; j < std::min(X.nb(), Y.nb()); ++j) {
@@ -857,9 +995,27 @@ void add(
     int64_t x_row_inc = X.rowIncrement();
     const scalar_t* X00 = &X.at(0, 0);
 
-    // Process uplo --> col/row, then scale y=b*y and add y=ax+y
+    // Process uplo --> col/row, then y = a*x + b*y in one pass
     if (X.uploPhysical() == Uplo::General) {
-        if (y_col_inc == 1) {
+        if (contiguous_same_layout( X, Y )) {
+            // whole tile at once
+            int64_t len = Y.mb() * Y.nb();
+            #pragma omp simd
+            for (int64_t k = 0; k < len; ++k)
+                Y00[ k ] = beta * Y00[ k ] + alpha * X00[ k ];
+        }
+        else if (y_col_inc == 1 && x_col_inc == 1) {
+            // one column of y at a time
+            int64_t m = std::min(X.mb(), Y.mb());
+            for (int64_t j = 0; j < std::min(X.nb(), Y.nb()); ++j) {
+                scalar_t* Yj = &Y00[j*y_row_inc];
+                const scalar_t* Xj = &X00[j*x_row_inc];
+                #pragma omp simd
+                for (int64_t i = 0; i < m; ++i)
+                    Yj[ i ] = beta * Yj[ i ] + alpha * Xj[ i ];
+            }
+        }
+        else if (y_col_inc == 1) {
             // one column of y at a time
             int64_t m = std::min(X.mb(), Y.mb());
             for (int64_t j = 0; j < std::min(X.nb(), Y.nb()); ++j) {
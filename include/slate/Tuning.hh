@@ -0,0 +1,140 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef SLATE_TUNING_HH
+#define SLATE_TUNING_HH
+
+#include "slate/types.hh"
+
+#include <complex>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace slate {
+
+//------------------------------------------------------------------------------
+/// Key of tuned parameters: routine, precision, target, size class, and
+/// MPI grid shape.
+/// @see TuningDB
+///
+struct TuningKey {
+    std::string routine;    ///< routine, e.g., "getrf"
+    char precision;         ///< 's', 'd', 'c', or 'z'
+    Target target;          ///< Option::Target
+    int64_t size_class;     ///< floor( log2( max( m, n ) ) ); @see sizeClass
+    int p, q;               ///< MPI grid, or -1 if not 2D block cyclic
+
+    bool operator < ( TuningKey const& other ) const;
+};
+
+//------------------------------------------------------------------------------
+/// Tuned parameters of one key, and the rate measured with them.
+/// Values <= 0 are not tuned, except lookahead, which may be
+/// LookaheadAuto; it is not tuned if < LookaheadAuto.
+///
+struct TuningEntry {
+    int64_t nb            = 0;  ///< block size: Option::BlockSize
+    int64_t ib            = 0;  ///< Option::InnerBlocking
+    int64_t lookahead     = -2; ///< Option::Lookahead
+    int64_t panel_threads = 0;  ///< Option::MaxPanelThreads
+    double gflops         = 0;  ///< measured rate
+};
+
+//------------------------------------------------------------------------------
+/// Persistent database of tuned parameters, by routine, precision, target,
+/// size class, and grid shape. The process-wide instance is loaded on first
+/// use from the file named by the environment variable SLATE_TUNING_DB,
+/// if set. getrf, potrf, and geqrf look up the options a caller didn't
+/// set; the LAPACK API also looks up the block size nb. The tester
+/// populates the database with --tune, benchmarking candidates given by
+/// its --nb, --ib, --lookahead, and --panel-threads lists.
+///
+/// The file has one line per key, with fields separated by spaces:
+///
+///     # routine precision target size_class p q nb ib lookahead panel_threads gflops
+///     getrf d T 13 2 2 256 32 1 4 812.5
+///
+class TuningDB {
+public:
+    static TuningDB& instance();
+
+    void load( std::string const& path );
+    void save( std::string const& path ) const;
+
+    bool lookup( TuningKey const& key, TuningEntry* entry ) const;
+    bool record( TuningKey const& key, TuningEntry const& entry );
+
+    /// @return true if there are no entries.
+    bool empty() const
+    {
+        std::lock_guard<std::mutex> guard( mutex_ );
+        return entries_.empty();
+    }
+
+    /// @return file name from SLATE_TUNING_DB, or empty.
+    std::string const& path() const { return path_; }
+
+    void clear();
+
+    static int64_t sizeClass( int64_t n );
+
+    Options tunedOptions( TuningKey const& key, Options const& opts ) const;
+
+private:
+    mutable std::mutex mutex_;      ///< guards entries_
+    std::map< TuningKey, TuningEntry > entries_;
+    std::string path_;
+};
+
+namespace internal {
+
+//------------------------------------------------------------------------------
+/// [internal]
+/// @return precision character for scalar_t: 's', 'd', 'c', or 'z'.
+///
+template <typename scalar_t>
+char precision_char();
+
+template <> inline char precision_char< float >() { return 's'; }
+template <> inline char precision_char< double >() { return 'd'; }
+template <> inline char precision_char< std::complex<float> >() { return 'c'; }
+template <> inline char precision_char< std::complex<double> >() { return 'z'; }
+
+//------------------------------------------------------------------------------
+/// [internal]
+/// @return opts, with the options the caller didn't set taken from the
+/// tuning database for routine on matrix A, if it has an entry.
+/// The tuned options are stored in tuned; if the database is empty,
+/// opts itself is returned, without copying the map.
+///
+template <typename matrix_type>
+Options const& tuned_options(
+    char const* routine, matrix_type& A, Options const& opts,
+    Options& tuned )
+{
+    using scalar_t = typename matrix_type::value_type;
+
+    TuningDB& db = TuningDB::instance();
+    if (db.empty())
+        return opts;
+
+    GridOrder order;
+    int p, q, myrow, mycol;
+    A.gridinfo( &order, &p, &q, &myrow, &mycol );
+
+    TuningKey key = {
+        routine, precision_char<scalar_t>(),
+        get_option<Option::Target>( opts, Target::HostTask ),
+        TuningDB::sizeClass( std::max( A.m(), A.n() ) ), p, q };
+    tuned = db.tunedOptions( key, opts );
+    return tuned;
+}
+
+} // namespace internal
+} // namespace slate
+
+#endif // SLATE_TUNING_HH
@@ -0,0 +1,211 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef SLATE_ASYNC_HH
+#define SLATE_ASYNC_HH
+
+#include <functional>
+#include <future>
+#include <utility>
+
+namespace slate {
+
+//------------------------------------------------------------------------------
+/// Asynchronous drivers. Each call starts the driver on its own thread and
+/// returns a std::future, so the application can run several independent
+/// drivers concurrently, e.g., one solve per sub-domain, and overlap its own
+/// work before waiting:
+///
+///     auto f1 = slate::async::gesv( A1, pivots1, B1 );
+///     auto f2 = slate::async::gesv( A2, pivots2, B2 );
+///     // ... other work ...
+///     int64_t info1 = f1.get();
+///     int64_t info2 = f2.get();
+///
+/// The threads of the calling team are divided among the calls in flight
+/// when each call starts, so concurrent calls share the cores instead of
+/// oversubscribing them. GPU queues are per matrix, so calls on different
+/// matrices use separate queues on the same devices.
+///
+/// Matrices are shallow copied, so the call sees the caller's data;
+/// the data, pivots, and eigenvalue vectors must not be modified or freed
+/// until the future is ready. Concurrent calls must use matrices on
+/// different MPI communicators, e.g., from MPI_Comm_dup, since SLATE's
+/// message tags are unique only within one call; starting a call on a
+/// communicator in use by another call in flight throws an Exception.
+/// Exceptions thrown by a driver are rethrown by the future's get().
+///
+namespace async {
+
+namespace internal {
+
+int start( MPI_Comm mpi_comm );
+void finish( MPI_Comm mpi_comm );
+
+//------------------------------------------------------------------------------
+/// [internal]
+/// Releases the communicator of a call when the call finishes, even if
+/// it throws.
+///
+class CallGuard {
+public:
+    CallGuard( MPI_Comm mpi_comm )
+        : mpi_comm_( mpi_comm )
+    {}
+
+    ~CallGuard()
+    {
+        finish( mpi_comm_ );
+    }
+
+    CallGuard( CallGuard const& ) = delete;
+    CallGuard& operator = ( CallGuard const& ) = delete;
+
+private:
+    MPI_Comm mpi_comm_;
+};
+
+} // namespace internal
+
+//------------------------------------------------------------------------------
+/// Starts func() on its own thread, with its share of the OpenMP threads,
+/// as a call on mpi_comm.
+///
+/// @return future of func's result.
+///
+template <typename Func>
+auto launch( MPI_Comm mpi_comm, Func&& func )
+    -> std::future< decltype( func() ) >
+{
+    int num_threads = internal::start( mpi_comm );
+    try {
+        return std::async(
+            std::launch::async,
+            [mpi_comm, num_threads, func = std::forward<Func>( func )]()
+                mutable
+            {
+                internal::CallGuard guard( mpi_comm );
+                omp_set_num_threads( num_threads );
+                return func();
+            });
+    }
+    catch (...) {
+        internal::finish( mpi_comm );
+        throw;
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Asynchronous slate::gemm.
+template <typename scalar_t>
+std::future<void> gemm(
+    scalar_t alpha, Matrix<scalar_t>& A,
+                    Matrix<scalar_t>& B,
+    scalar_t beta,  Matrix<scalar_t>& C,
+    Options const& opts = Options())
+{
+    return launch( C.mpiComm(), [=]() mutable {
+        slate::gemm( alpha, A, B, beta, C, opts );
+    });
+}
+
+//------------------------------------------------------------------------------
+/// Asynchronous slate::gesv. pivots must outlive the future.
+template <typename scalar_t>
+std::future<int64_t> gesv(
+    Matrix<scalar_t>& A, Pivots& pivots,
+    Matrix<scalar_t>& B,
+    Options const& opts = Options())
+{
+    Pivots* pivots_ptr = &pivots;
+    return launch( A.mpiComm(), [=]() mutable {
+        return slate::gesv( A, *pivots_ptr, B, opts );
+    });
+}
+
+//------------------------------------------------------------------------------
+/// Asynchronous slate::getrf. pivots must outlive the future.
+template <typename scalar_t>
+std::future<int64_t> getrf(
+    Matrix<scalar_t>& A, Pivots& pivots,
+    Options const& opts = Options())
+{
+    Pivots* pivots_ptr = &pivots;
+    return launch( A.mpiComm(), [=]() mutable {
+        return slate::getrf( A, *pivots_ptr, opts );
+    });
+}
+
+//------------------------------------------------------------------------------
+/// Asynchronous slate::getrs. pivots must outlive the future.
+template <typename scalar_t>
+std::future<void> getrs(
+    Matrix<scalar_t>& A, Pivots& pivots,
+    Matrix<scalar_t>& B,
+    Options const& opts = Options())
+{
+    Pivots* pivots_ptr = &pivots;
+    return launch( A.mpiComm(), [=]() mutable {
+        slate::getrs( A, *pivots_ptr, B, opts );
+    });
+}
+
+//------------------------------------------------------------------------------
+/// Asynchronous slate::posv.
+template <typename scalar_t>
+std::future<int64_t> posv(
+    HermitianMatrix<scalar_t>& A,
+             Matrix<scalar_t>& B,
+    Options const& opts = Options())
+{
+    return launch( A.mpiComm(), [=]() mutable {
+        return slate::posv( A, B, opts );
+    });
+}
+
+//------------------------------------------------------------------------------
+/// Asynchronous slate::potrf.
+template <typename scalar_t>
+std::future<int64_t> potrf(
+    HermitianMatrix<scalar_t>& A,
+    Options const& opts = Options())
+{
+    return launch( A.mpiComm(), [=]() mutable {
+        return slate::potrf( A, opts );
+    });
+}
+
+//------------------------------------------------------------------------------
+/// Asynchronous slate::potrs.
+template <typename scalar_t>
+std::future<void> potrs(
+    HermitianMatrix<scalar_t>& A,
+             Matrix<scalar_t>& B,
+    Options const& opts = Options())
+{
+    return launch( A.mpiComm(), [=]() mutable {
+        slate::potrs( A, B, opts );
+    });
+}
+
+//------------------------------------------------------------------------------
+/// Asynchronous slate::heev. Lambda must outlive the future.
+template <typename scalar_t>
+std::future<void> heev(
+    HermitianMatrix<scalar_t>& A,
+    std::vector< blas::real_type<scalar_t> >& Lambda,
+    Matrix<scalar_t>& Z,
+    Options const& opts = Options())
+{
+    auto* Lambda_ptr = &Lambda;
+    return launch( A.mpiComm(), [=]() mutable {
+        slate::heev( A, *Lambda_ptr, Z, opts );
+    });
+}
+
+} // namespace async
+} // namespace slate
+
+#endif // SLATE_ASYNC_HH
@@ -0,0 +1,103 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef SLATE_BATCH_HH
+#define SLATE_BATCH_HH
+
+#include "slate/Tile.hh"
+#include "slate/types.hh"
+
+#include <vector>
+
+namespace slate {
+
+//------------------------------------------------------------------------------
+/// Batched drivers for many small, independent problems, each held in one
+/// tile, e.g., 10^4 problems of size 64 to 512 per node. Unlike the
+/// distributed drivers, no Matrix, MPI communication, or task graph is
+/// created per problem.
+///
+/// Tiles may differ in size. Tiles in host memory are solved in parallel by
+/// the OpenMP threads, largest first, with one LAPACK call each. Tiles in
+/// device memory, e.g., created with a device, are solved on a queue per
+/// device, with launches queued back to back and one synchronization per
+/// call, overlapping the host tiles. Tiles must be ColMajor.
+///
+/// The info of each problem is returned in info[ i ], as from LAPACK.
+///
+/// Example:
+///
+///     std::vector< slate::Tile<double> > A( batch );
+///     for (int64_t i = 0; i < batch; ++i)
+///         A[ i ] = slate::Tile<double>( n[ i ], n[ i ], data[ i ], lda[ i ],
+///                                       slate::HostNum,
+///                                       slate::TileKind::UserOwned );
+///     std::vector<int64_t> info;
+///     slate::batch::posv( slate::Uplo::Lower, A, B, info );
+///
+namespace batch {
+
+//------------------------------------------------------------------------------
+// Cholesky; potrf and potrs also support device tiles.
+template <typename scalar_t>
+void potrf(
+    Uplo uplo,
+    std::vector< Tile<scalar_t> >& A,
+    std::vector<int64_t>& info,
+    Options const& opts = Options());
+
+template <typename scalar_t>
+void potrs(
+    Uplo uplo,
+    std::vector< Tile<scalar_t> >& A,
+    std::vector< Tile<scalar_t> >& B,
+    Options const& opts = Options());
+
+template <typename scalar_t>
+void posv(
+    Uplo uplo,
+    std::vector< Tile<scalar_t> >& A,
+    std::vector< Tile<scalar_t> >& B,
+    std::vector<int64_t>& info,
+    Options const& opts = Options());
+
+//------------------------------------------------------------------------------
+// LU with partial pivoting; host tiles only.
+template <typename scalar_t>
+void getrf(
+    std::vector< Tile<scalar_t> >& A,
+    std::vector< std::vector<int64_t> >& pivots,
+    std::vector<int64_t>& info,
+    Options const& opts = Options());
+
+template <typename scalar_t>
+void getrs(
+    std::vector< Tile<scalar_t> >& A,
+    std::vector< std::vector<int64_t> >& pivots,
+    std::vector< Tile<scalar_t> >& B,
+    Options const& opts = Options());
+
+template <typename scalar_t>
+void gesv(
+    std::vector< Tile<scalar_t> >& A,
+    std::vector< std::vector<int64_t> >& pivots,
+    std::vector< Tile<scalar_t> >& B,
+    std::vector<int64_t>& info,
+    Options const& opts = Options());
+
+//------------------------------------------------------------------------------
+// Hermitian eigenvalues; host tiles only.
+template <typename scalar_t>
+void heev(
+    Job jobz, Uplo uplo,
+    std::vector< Tile<scalar_t> >& A,
+    std::vector< std::vector< blas::real_type<scalar_t> > >& Lambda,
+    std::vector<int64_t>& info,
+    Options const& opts = Options());
+
+} // namespace batch
+} // namespace slate
+
+#endif // SLATE_BATCH_HH
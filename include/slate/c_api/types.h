@@ -19,6 +19,7 @@ typedef char slate_TileKind; /* enum */               ///< slate::TileKind
 const slate_TileKind slate_TileKind_Workspace  = 'w'; ///< slate::TileKind::Workspace
 const slate_TileKind slate_TileKind_SlateOwned = 'o'; ///< slate::TileKind::SlateOwned
 const slate_TileKind slate_TileKind_UserOwned  = 'u'; ///< slate::TileKind::UserOwned
+const slate_TileKind slate_TileKind_FileMapped = 'f'; ///< slate::TileKind::FileMapped
 // end slate_TileKind
 
 //------------------------------------------------------------------------------
@@ -30,6 +31,7 @@ const slate_Target slate_Target_HostTask    = 'T'; ///< slate::Target::HostTask
 const slate_Target slate_Target_HostNest    = 'N'; ///< slate::Target::HostNest
 const slate_Target slate_Target_HostBatch   = 'B'; ///< slate::Target::HostBatch
 const slate_Target slate_Target_Devices     = 'D'; ///< slate::Target::Devices
+const slate_Target slate_Target_Hybrid      = 'Y'; ///< slate::Target::Hybrid
 // end slate_Target
 
 typedef char slate_MethodTrsm; /* enum */           ///< slate::MethodTrsm
@@ -42,6 +44,7 @@ typedef char slate_MethodGemm; /* enum */           ///< slate::MethodGemm
 const slate_MethodGemm slate_MethodGemm_Auto = '*'; ///< slate::MethodGemm::Auto
 const slate_MethodGemm slate_MethodGemm_A    = 'A'; ///< slate::MethodGemm::A
 const slate_MethodGemm slate_MethodGemm_C    = 'C'; ///< slate::MethodGemm::C
+const slate_MethodGemm slate_MethodGemm_Layered = 'L'; ///< slate::MethodGemm::Layered
 // end slate_MethodGemm
 
 typedef char slate_MethodHemm; /* enum */           ///< slate::MethodHemm
@@ -62,6 +65,9 @@ typedef char slate_MethodGels; /* enum */             ///< slate::MethodGels
 const slate_MethodGels slate_MethodGels_Auto   = '*'; ///< slate::MethodGels::Auto
 const slate_MethodGels slate_MethodGels_QR     = 'Q'; ///< slate::MethodGels::QR
 const slate_MethodGels slate_MethodGels_CholQR = 'C'; ///< slate::MethodGels::CholQR
+const slate_MethodGels slate_MethodGels_CholQR2 = '2'; ///< slate::MethodGels::CholQR2
+const slate_MethodGels slate_MethodGels_CholQR3 = '3'; ///< slate::MethodGels::CholQR3
+const slate_MethodGels slate_MethodGels_Sketch = 'S'; ///< slate::MethodGels::Sketch
 // end slate_MethodGels
 
 typedef char slate_MethodLU; /* enum */       ///< slate::MethodLU
@@ -79,6 +85,7 @@ const slate_MethodEig slate_MethodEig_QR        = 'Q'; ///< slate::MethodEig::QR
 const slate_MethodEig slate_MethodEig_DC        = 'D'; ///< slate::MethodEig::DC
 const slate_MethodEig slate_MethodEig_Bisection = 'B'; ///< slate::MethodEig::Bisection
 const slate_MethodEig slate_MethodEig_MRRR      = 'M'; ///< slate::MethodEig::MRRR
+const slate_MethodEig slate_MethodEig_QDWH      = 'W'; ///< slate::MethodEig::QDWH
 // end slate_MethodEig
 
 typedef char slate_MethodSVD; /* enum */               ///< slate::MethodSVD
@@ -86,8 +93,32 @@ const slate_MethodSVD slate_MethodSVD_Auto      = '*'; ///< slate::MethodSVD::Au
 const slate_MethodSVD slate_MethodSVD_QR        = 'Q'; ///< slate::MethodSVD::QR
 const slate_MethodSVD slate_MethodSVD_DC        = 'D'; ///< slate::MethodSVD::DC
 const slate_MethodSVD slate_MethodSVD_Bisection = 'B'; ///< slate::MethodSVD::Bisection
+const slate_MethodSVD slate_MethodSVD_QDWH      = 'W'; ///< slate::MethodSVD::QDWH
 // end slate_MethodSVD
 
+typedef char slate_BcastPrecision; /* enum */                    ///< slate::BcastPrecision
+const slate_BcastPrecision slate_BcastPrecision_Native   = 'N'; ///< slate::BcastPrecision::Native
+const slate_BcastPrecision slate_BcastPrecision_Single   = 'S'; ///< slate::BcastPrecision::Single
+const slate_BcastPrecision slate_BcastPrecision_BFloat16 = 'B'; ///< slate::BcastPrecision::BFloat16
+const slate_BcastPrecision slate_BcastPrecision_Half     = 'H'; ///< slate::BcastPrecision::Half
+// end slate_BcastPrecision
+
+typedef char slate_TaskRuntime; /* enum */                      ///< slate::TaskRuntime
+const slate_TaskRuntime slate_TaskRuntime_OpenMP       = 'O'; ///< slate::TaskRuntime::OpenMP
+const slate_TaskRuntime slate_TaskRuntime_WorkStealing = 'W'; ///< slate::TaskRuntime::WorkStealing
+// end slate_TaskRuntime
+
+typedef char slate_QueuePriority; /* enum */                   ///< slate::QueuePriority
+const slate_QueuePriority slate_QueuePriority_Uniform   = 'U'; ///< slate::QueuePriority::Uniform
+const slate_QueuePriority slate_QueuePriority_Lookahead = 'L'; ///< slate::QueuePriority::Lookahead
+// end slate_QueuePriority
+
+typedef char slate_ComputePrecision; /* enum */                ///< slate::ComputePrecision
+const slate_ComputePrecision slate_ComputePrecision_Native    = 'N'; ///< slate::ComputePrecision::Native
+const slate_ComputePrecision slate_ComputePrecision_TF32      = 'T'; ///< slate::ComputePrecision::TF32
+const slate_ComputePrecision slate_ComputePrecision_Complex3M = '3'; ///< slate::ComputePrecision::Complex3M
+// end slate_ComputePrecision
+
 // todo: auto sync with include/slate/enums.hh
 typedef char slate_Option; /* enum */                      ///< slate::Option
 const slate_Option slate_Option_ChunkSize            =  0; ///< slate::Option::ChunkSize
@@ -102,10 +133,31 @@ const slate_Option slate_Option_Depth                =  8; ///< slate::Option::H
 const slate_Option slate_Option_MaxIterations        =  9; ///< slate::Option::HoldLocalWorkspace
 const slate_Option slate_Option_UseFallbackSolver    = 10; ///< slate::Option::HoldLocalWorkspace
 const slate_Option slate_Option_PivotThreshold       = 11; ///< slate::Option::PivotThreshold
+const slate_Option slate_Option_HostWorkspaceTiles   = 12; ///< slate::Option::HostWorkspaceTiles
+const slate_Option slate_Option_DeviceCacheTiles     = 13; ///< slate::Option::DeviceCacheTiles
+const slate_Option slate_Option_HostFirstTouch       = 14; ///< slate::Option::HostFirstTouch
+const slate_Option slate_Option_HostTileArena        = 15; ///< slate::Option::HostTileArena
+const slate_Option slate_Option_BcastPacked          = 16; ///< slate::Option::BcastPacked
+const slate_Option slate_Option_ProgressThread       = 17; ///< slate::Option::ProgressThread
+const slate_Option slate_Option_BcastPrecision       = 18; ///< slate::Option::BcastPrecision
+const slate_Option slate_Option_Counters             = 19; ///< slate::Option::Counters
+const slate_Option slate_Option_TaskRuntime          = 20; ///< slate::Option::TaskRuntime
+const slate_Option slate_Option_MaxLookahead         = 21; ///< slate::Option::MaxLookahead
+const slate_Option slate_Option_QueuePriority        = 22; ///< slate::Option::QueuePriority
+const slate_Option slate_Option_PanelTarget          = 23; ///< slate::Option::PanelTarget
+const slate_Option slate_Option_ComputePrecision     = 24; ///< slate::Option::ComputePrecision
+const slate_Option slate_Option_Layers               = 25; ///< slate::Option::Layers
+const slate_Option slate_Option_TreeArity            = 26; ///< slate::Option::TreeArity
+const slate_Option slate_Option_Oversampling         = 27; ///< slate::Option::Oversampling
+const slate_Option slate_Option_PowerIterations      = 28; ///< slate::Option::PowerIterations
+const slate_Option slate_Option_FactorsResident      = 29; ///< slate::Option::FactorsResident
+const slate_Option slate_Option_EstimateColumns      = 30; ///< slate::Option::EstimateColumns
+const slate_Option slate_Option_Checkpoint           = 31; ///< slate::Option::Checkpoint
 const slate_Option slate_Option_PrintVerbose         = 50; ///< slate::Option::PrintVerbose
 const slate_Option slate_Option_PrintEdgeItems       = 51; ///< slate::Option::PrintEdgeItems
 const slate_Option slate_Option_PrintWidth           = 52; ///< slate::Option::PrintWidth
 const slate_Option slate_Option_PrintPrecision       = 53; ///< slate::Option::PrintPrecision
+const slate_Option slate_Option_PrintBinary          = 54; ///< slate::Option::PrintBinary
 const slate_Option slate_Option_MethodCholQR         = 60; ///< slate::Option::MethodCholQR
 const slate_Option slate_Option_MethodEig            = 61; ///< slate::Option::MethodEig
 const slate_Option slate_Option_MethodGels           = 62; ///< slate::Option::MethodGels
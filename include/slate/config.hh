@@ -73,6 +73,68 @@ inline void gpu_aware_mpi( bool value )
     return GPU_Aware_MPI::value( value );
 }
 
+//------------------------------------------------------------------------------
+/// Radix of the broadcast and reduction trees across MPI ranks.
+class Bcast_Radix
+{
+public:
+    /// @see int bcast_radix()
+    static int value()
+    {
+        return get().radix_;
+    }
+
+    /// @see void bcast_radix( int )
+    static void value( int val )
+    {
+        get().radix_ = val;
+    }
+
+private:
+    /// @return Bcast_Radix singleton.
+    /// Uses thread-safe Scott Meyers' singleton to query on first call only.
+    static Bcast_Radix& get()
+    {
+        static Bcast_Radix singleton;
+        return singleton;
+    }
+
+    /// Constructor checks $SLATE_BCAST_RADIX.
+    Bcast_Radix()
+    {
+        const char* env = getenv( "SLATE_BCAST_RADIX" );
+        radix_ = env != nullptr ? atoi( env ) : 0;
+        if (radix_ < 2)
+            radix_ = 0;
+    }
+
+    //----------------------------------------
+    // Data
+
+    /// Cached radix, or 0 for each routine's default.
+    int radix_;
+};
+
+//------------------------------------------------------------------------------
+/// @return radix of the broadcast and reduction trees across MPI ranks
+/// (listBcast, listBcastMT, listReduce), or 0 if each routine uses its
+/// default (2 for listBcast and listReduce, 4 for listBcastMT).
+/// Initially set by environment variable $SLATE_BCAST_RADIX, if >= 2.
+/// Can be overridden by bcast_radix( int ).
+inline int bcast_radix()
+{
+    return Bcast_Radix::value();
+}
+
+//------------------------------------------------------------------------------
+/// Set the radix of the broadcast and reduction trees across MPI ranks.
+/// Overrides $SLATE_BCAST_RADIX. All ranks must set the same radix.
+/// @param[in] value: radix >= 2, or 0 for each routine's default.
+inline void bcast_radix( int value )
+{
+    return Bcast_Radix::value( value >= 2 ? value : 0 );
+}
+
 }  // namespace slate
 
 #endif // SLATE_CONFIG_HH
@@ -30,6 +30,7 @@ using lapack::Norm;
 using lapack::Direction;
 
 using lapack::Job;
+using lapack::Range;
 
 //------------------------------------------------------------------------------
 /// Location and method of computation.
@@ -41,6 +42,7 @@ enum class Target : char {
     HostNest  = 'N',    ///< computation using OpenMP nested parallel for loops on host
     HostBatch = 'B',    ///< computation using batch BLAS on host (Intel MKL)
     Devices   = 'D',    ///< computation using batch BLAS on devices (cuBLAS)
+    Hybrid    = 'Y',    ///< as Devices, but trailing updates split with host
 };
 
 namespace internal {
@@ -62,6 +64,7 @@ enum class MethodTrsm : char {
     Auto      = '*',    ///< Let SLATE decide
     A         = 'A',    ///< Matrix A is stationary, B is sent; use when B is small
     B         = 'B',    ///< Matrix B is stationary, A is sent; use when B is large
+    Inv       = 'I',    ///< Diagonal blocks of A inverted, B sent in groups; use when B has few columns
     TrsmA [[deprecated("Use A. To be removed 2025-05.")]] = 'A',
     TrsmB [[deprecated("Use B. To be removed 2025-05.")]] = 'B',
 };
@@ -75,6 +78,7 @@ inline const char* to_c_string( MethodTrsm value )
         case MethodTrsm::Auto: return "auto";
         case MethodTrsm::A:    return "A";
         case MethodTrsm::B:    return "B";
+        case MethodTrsm::Inv:  return "Inv";
     }
     return "?";
 }
@@ -97,6 +101,8 @@ inline void from_string( std::string const& str, MethodTrsm* val )
         *val = MethodTrsm::A;
     else if (str_ == "b" || str_ == "trsmb")
         *val = MethodTrsm::B;
+    else if (str_ == "inv" || str_ == "trsminv")
+        *val = MethodTrsm::Inv;
     else
         throw Exception( "unknown trsm method: " + str );
 }
@@ -109,6 +115,8 @@ enum class MethodGemm : char {
     Auto      = '*',    ///< Let SLATE decide
     A         = 'A',    ///< Matrix A is stationary, C is sent; use when C is small
     C         = 'C',    ///< Matrix C is stationary, A is sent; use when C is large
+    Layered   = 'L',    ///< 2.5D: gemmC on layers of ranks, each with a slice
+                        ///< of k; use at large rank counts (@see Option::Layers)
     GemmA [[deprecated("Use A. To be removed 2025-05.")]] = 'A',
     GemmC [[deprecated("Use C. To be removed 2025-05.")]] = 'C',
 };
@@ -119,9 +127,10 @@ extern const char* MethodGemm_help;
 inline const char* to_c_string( MethodGemm value )
 {
     switch (value) {
-        case MethodGemm::Auto: return "auto";
-        case MethodGemm::A:    return "A";
-        case MethodGemm::C:    return "C";
+        case MethodGemm::Auto:    return "auto";
+        case MethodGemm::A:       return "A";
+        case MethodGemm::C:       return "C";
+        case MethodGemm::Layered: return "L";
     }
     return "?";
 }
@@ -144,6 +153,8 @@ inline void from_string( std::string const& str, MethodGemm* val )
         *val = MethodGemm::A;
     else if (str_ == "c" || str_ == "gemmc")
         *val = MethodGemm::C;
+    else if (str_ == "l" || str_ == "layered" || str_ == "2.5d")
+        *val = MethodGemm::Layered;
     else
         throw Exception( "unknown gemm method: " + str );
 }
@@ -203,7 +214,7 @@ enum class MethodCholQR : char {
     Auto      = '*',    ///< Let SLATE decide
     GemmA     = 'A',    ///< Use gemm-A algorithm to compute A^H A
     GemmC     = 'C',    ///< Use gemm-C algorithm to compute A^H A
-    HerkA     = 'R',    ///< Use herk-A algorithm to compute A^H A; not yet implemented
+    HerkA     = 'R',    ///< Use herk-A algorithm to compute A^H A
     HerkC     = 'K',    ///< Use herk-C algorithm to compute A^H A
 };
 
@@ -256,6 +267,11 @@ enum class MethodGels : char {
     Auto      = '*',    ///< Let SLATE decide
     QR        = 'Q',    ///< Use Householder QR factorization
     CholQR    = 'C',    ///< Use Cholesky QR factorization; use when A is well-conditioned
+    CholQR2   = '2',    ///< Use Cholesky QR twice; use when cond( A ) < u^{-1/2}
+    CholQR3   = '3',    ///< Use shifted Cholesky QR, then CholQR2;
+                        ///< use when cond( A ) < u^{-1}
+    Sketch    = 'S',    ///< Use CGLS preconditioned by the QR of a sparse
+                        ///< sketch of A; use when m >> n
     Geqrf  [[deprecated("Use QR. To be removed 2025-05.")]] = 'Q',
     Cholqr [[deprecated("Use CholQR. To be removed 2025-05.")]] = 'C',
 };
@@ -269,6 +285,9 @@ inline const char* to_c_string( MethodGels value )
         case MethodGels::Auto:   return "auto";
         case MethodGels::QR:     return "QR";
         case MethodGels::CholQR: return "CholQR";
+        case MethodGels::CholQR2: return "CholQR2";
+        case MethodGels::CholQR3: return "CholQR3";
+        case MethodGels::Sketch: return "Sketch";
     }
     return "?";
 }
@@ -291,6 +310,12 @@ inline void from_string( std::string const& str, MethodGels* val )
         *val = MethodGels::QR;
     else if (str_ == "cholqr")
         *val = MethodGels::CholQR;
+    else if (str_ == "cholqr2")
+        *val = MethodGels::CholQR2;
+    else if (str_ == "cholqr3" || str_ == "scholqr3")
+        *val = MethodGels::CholQR3;
+    else if (str_ == "sketch")
+        *val = MethodGels::Sketch;
     else
         throw Exception( "unknown least squares (gels) method: " + str );
 }
@@ -360,8 +385,9 @@ enum class MethodEig : char {
     Auto      = '*',    ///< Let SLATE decide
     QR        = 'Q',    ///< QR iteration
     DC        = 'D',    ///< Divide and conquer
-    Bisection = 'B',    ///< Bisection; not yet implemented
+    Bisection = 'B',    ///< Bisection and inverse iteration
     MRRR      = 'M',    ///< Multiple Relatively Robust Representations (MRRR); not yet implemented
+    QDWH      = 'W',    ///< QDWH-based spectral divide and conquer
 };
 
 extern const char* MethodEig_help;
@@ -375,6 +401,7 @@ inline const char* to_c_string( MethodEig value )
         case MethodEig::DC:        return "DC";
         case MethodEig::Bisection: return "Bisection";
         case MethodEig::MRRR:      return "MRRR";
+        case MethodEig::QDWH:      return "QDWH";
     }
     return "?";
 }
@@ -401,6 +428,8 @@ inline void from_string( std::string const& str, MethodEig* val )
         *val = MethodEig::Bisection;
     else if (str_ == "mrrr")
         *val = MethodEig::MRRR;
+    else if (str_ == "qdwh")
+        *val = MethodEig::QDWH;
     else
         throw Exception( "unknown eig method: " + str );
 }
@@ -412,8 +441,9 @@ inline void from_string( std::string const& str, MethodEig* val )
 enum class MethodSVD : char {
     Auto      = '*',    ///< Let SLATE decide
     QR        = 'Q',    ///< QR iteration
-    DC        = 'D',    ///< Divide and conquer; not yet implemented
-    Bisection = 'B',    ///< Bisection; not yet implemented
+    DC        = 'D',    ///< Divide and conquer
+    Bisection = 'B',    ///< Bisection and inverse iteration
+    QDWH      = 'W',    ///< QDWH polar decomposition, then QDWH eigensolver
 };
 
 extern const char* MethodSVD_help;
@@ -426,6 +456,7 @@ inline const char* to_c_string( MethodSVD value )
         case MethodSVD::QR:        return "QR";
         case MethodSVD::DC:        return "DC";
         case MethodSVD::Bisection: return "Bisection";
+        case MethodSVD::QDWH:      return "QDWH";
     }
     return "?";
 }
@@ -450,17 +481,303 @@ inline void from_string( std::string const& str, MethodSVD* val )
         *val = MethodSVD::DC;
     else if (str_ == "bisection")
         *val = MethodSVD::Bisection;
+    else if (str_ == "qdwh")
+        *val = MethodSVD::QDWH;
     else
         throw Exception( "unknown SVD method: " + str );
 }
 
+//------------------------------------------------------------------------------
+/// Precision of tiles on the wire in broadcasts.
+/// Tiles are converted to the lower precision by the sender and back
+/// by the receivers, so receivers get rounded copies. Only for routines
+/// that tolerate it, e.g., factorizations used as preconditioners.
+/// A precision at or above the matrix precision is Native.
+/// @ingroup enum
+///
+enum class BcastPrecision : char {
+    Native    = 'N',    ///< Matrix precision
+    Single    = 'S',    ///< IEEE single precision (FP32)
+    BFloat16  = 'B',    ///< bfloat16: FP32 exponent range, 8-bit significand
+    Half      = 'H',    ///< IEEE half (FP16): 11-bit significand,
+                        ///< overflows above 65504
+};
+
+extern const char* BcastPrecision_help;
+
+//-----------------------------------
+inline const char* to_c_string( BcastPrecision value )
+{
+    switch (value) {
+        case BcastPrecision::Native:   return "native";
+        case BcastPrecision::Single:   return "single";
+        case BcastPrecision::BFloat16: return "bf16";
+        case BcastPrecision::Half:     return "half";
+    }
+    return "?";
+}
+
+//-----------------------------------
+inline std::string to_string( BcastPrecision value )
+{
+    return to_c_string( value );
+}
+
+//-----------------------------------
+inline void from_string( std::string const& str, BcastPrecision* val )
+{
+    std::string str_ = str;
+    std::transform( str_.begin(), str_.end(), str_.begin(), ::tolower );
+
+    if (str_ == "native" || str_ == "n")
+        *val = BcastPrecision::Native;
+    else if (str_ == "single" || str_ == "s" || str_ == "fp32")
+        *val = BcastPrecision::Single;
+    else if (str_ == "bf16" || str_ == "b" || str_ == "bfloat16")
+        *val = BcastPrecision::BFloat16;
+    else if (str_ == "half" || str_ == "h" || str_ == "fp16")
+        *val = BcastPrecision::Half;
+    else
+        throw Exception( "unknown broadcast precision: " + str );
+}
+
+//------------------------------------------------------------------------------
+/// Task runtime that schedules the tile algorithm of factorizations.
+/// @ingroup enum
+///
+enum class TaskRuntime : char {
+    OpenMP       = 'O',     ///< OpenMP tasks with depend clauses on block columns
+    WorkStealing = 'W',     ///< work-stealing scheduler with a tile-level DAG
+                            ///< (internal::TaskGraph)
+};
+
+extern const char* TaskRuntime_help;
+
+//-----------------------------------
+inline const char* to_c_string( TaskRuntime value )
+{
+    switch (value) {
+        case TaskRuntime::OpenMP:       return "openmp";
+        case TaskRuntime::WorkStealing: return "ws";
+    }
+    return "?";
+}
+
+//-----------------------------------
+inline std::string to_string( TaskRuntime value )
+{
+    return to_c_string( value );
+}
+
+//-----------------------------------
+inline void from_string( std::string const& str, TaskRuntime* val )
+{
+    std::string str_ = str;
+    std::transform( str_.begin(), str_.end(), str_.begin(), ::tolower );
+
+    if (str_ == "openmp" || str_ == "omp" || str_ == "o")
+        *val = TaskRuntime::OpenMP;
+    else if (str_ == "ws" || str_ == "w" || str_ == "workstealing")
+        *val = TaskRuntime::WorkStealing;
+    else
+        throw Exception( "unknown task runtime: " + str );
+}
+
+//------------------------------------------------------------------------------
+/// Stream priorities of the device compute queues of factorizations.
+/// @ingroup enum
+///
+enum class QueuePriority : char {
+    Uniform   = 'U',    ///< all queues at the default priority
+    Lookahead = 'L',    ///< panel and lookahead queues at high priority, so
+                        ///< their kernels preempt the trailing update
+};
+
+extern const char* QueuePriority_help;
+
+//-----------------------------------
+inline const char* to_c_string( QueuePriority value )
+{
+    switch (value) {
+        case QueuePriority::Uniform:   return "uniform";
+        case QueuePriority::Lookahead: return "lookahead";
+    }
+    return "?";
+}
+
+//-----------------------------------
+inline std::string to_string( QueuePriority value )
+{
+    return to_c_string( value );
+}
+
+//-----------------------------------
+inline void from_string( std::string const& str, QueuePriority* val )
+{
+    std::string str_ = str;
+    std::transform( str_.begin(), str_.end(), str_.begin(), ::tolower );
+
+    if (str_ == "uniform" || str_ == "u")
+        *val = QueuePriority::Uniform;
+    else if (str_ == "lookahead" || str_ == "l")
+        *val = QueuePriority::Lookahead;
+    else
+        throw Exception( "unknown queue priority: " + str );
+}
+
+//------------------------------------------------------------------------------
+/// Compute mode of BLAS in the updates of gemm and factorizations,
+/// trading accuracy for throughput.
+/// TF32 affects only single precision (float and complex<float>) on
+/// devices; Complex3M only complex precisions, on the host and on devices.
+/// @ingroup enum
+///
+enum class ComputePrecision : char {
+    Native    = 'N',    ///< full precision of the matrix type
+    TF32      = 'T',    ///< TensorFloat-32 tensor cores: inputs rounded to
+                        ///< 11-bit significands, FP32 accumulation
+                        ///< (cuBLAS TF32 math mode; rocBLAS xf32)
+    Complex3M = '3',    ///< complex gemm as 3 real gemms (Gauss, 3M),
+                        ///< 25% fewer flops, normwise accurate only
+};
+
+extern const char* ComputePrecision_help;
+
+//-----------------------------------
+inline const char* to_c_string( ComputePrecision value )
+{
+    switch (value) {
+        case ComputePrecision::Native:    return "native";
+        case ComputePrecision::TF32:      return "tf32";
+        case ComputePrecision::Complex3M: return "3m";
+    }
+    return "?";
+}
+
+//-----------------------------------
+inline std::string to_string( ComputePrecision value )
+{
+    return to_c_string( value );
+}
+
+//-----------------------------------
+inline void from_string( std::string const& str, ComputePrecision* val )
+{
+    std::string str_ = str;
+    std::transform( str_.begin(), str_.end(), str_.begin(), ::tolower );
+
+    if (str_ == "native" || str_ == "n")
+        *val = ComputePrecision::Native;
+    else if (str_ == "tf32" || str_ == "t" || str_ == "xf32")
+        *val = ComputePrecision::TF32;
+    else if (str_ == "3m" || str_ == "3" || str_ == "complex3m")
+        *val = ComputePrecision::Complex3M;
+    else
+        throw Exception( "unknown compute precision: " + str );
+}
+
+//------------------------------------------------------------------------------
+/// Precision in which cholqr computes the Gram matrix A^H A.
+/// With Single, a double precision cholqr computes A^H A in single
+/// precision, factors it and updates A in double precision, then repeats
+/// one Cholesky QR pass entirely in double precision to restore the
+/// orthogonality of Q (mixed-precision CholQR2). On devices, Single can be
+/// combined with ComputePrecision::TF32 for the Gram matrix product.
+/// A precision at or above the matrix precision is Native.
+/// @ingroup enum
+///
+enum class GramPrecision : char {
+    Native    = 'N',    ///< Matrix precision
+    Single    = 'S',    ///< IEEE single precision (FP32), then a pass in
+                        ///< the matrix precision
+};
+
+extern const char* GramPrecision_help;
+
+//-----------------------------------
+inline const char* to_c_string( GramPrecision value )
+{
+    switch (value) {
+        case GramPrecision::Native: return "native";
+        case GramPrecision::Single: return "single";
+    }
+    return "?";
+}
+
+//-----------------------------------
+inline std::string to_string( GramPrecision value )
+{
+    return to_c_string( value );
+}
+
+//-----------------------------------
+inline void from_string( std::string const& str, GramPrecision* val )
+{
+    std::string str_ = str;
+    std::transform( str_.begin(), str_.end(), str_.begin(), ::tolower );
+
+    if (str_ == "native" || str_ == "n")
+        *val = GramPrecision::Native;
+    else if (str_ == "single" || str_ == "s" || str_ == "fp32")
+        *val = GramPrecision::Single;
+    else
+        throw Exception( "unknown Gram matrix precision: " + str );
+}
+
+//------------------------------------------------------------------------------
+/// Compression of tiles sent by listBcast.
+/// @see BaseMatrix::compressTransfers
+/// @ingroup enum
+///
+enum class Compression : char {
+    None         = 'N', ///< Tiles sent as is
+    Lossless     = 'L', ///< Byte shuffle and run-length encoding; exact
+    ErrorBounded = 'E', ///< Mantissas rounded to a relative error
+                        ///< tolerance, then as Lossless
+};
+
+extern const char* Compression_help;
+
+//-----------------------------------
+inline const char* to_c_string( Compression value )
+{
+    switch (value) {
+        case Compression::None:         return "none";
+        case Compression::Lossless:     return "lossless";
+        case Compression::ErrorBounded: return "error-bounded";
+    }
+    return "?";
+}
+
+//-----------------------------------
+inline std::string to_string( Compression value )
+{
+    return to_c_string( value );
+}
+
+//-----------------------------------
+inline void from_string( std::string const& str, Compression* val )
+{
+    std::string str_ = str;
+    std::transform( str_.begin(), str_.end(), str_.begin(), ::tolower );
+
+    if (str_ == "none" || str_ == "n")
+        *val = Compression::None;
+    else if (str_ == "lossless" || str_ == "l")
+        *val = Compression::Lossless;
+    else if (str_ == "error-bounded" || str_ == "e" || str_ == "lossy")
+        *val = Compression::ErrorBounded;
+    else
+        throw Exception( "unknown compression: " + str );
+}
+
 //------------------------------------------------------------------------------
 /// Keys for options to pass to SLATE routines.
 /// @ingroup enum
 ///
 enum class Option : char {
     ChunkSize,          ///< chunk size, >= 1
-    Lookahead,          ///< lookahead depth, >= 0
+    Lookahead,          ///< lookahead depth, >= 0; or LookaheadAuto
     BlockSize,          ///< block size, >= 1
     InnerBlocking,      ///< inner blocking size, >= 1
     MaxPanelThreads,    ///< max number of threads for panel, >= 1
@@ -472,6 +789,79 @@ enum class Option : char {
     MaxIterations,      ///< maximum iteration count
     UseFallbackSolver,  ///< whether to fallback to a robust solver if iterations do not converge
     PivotThreshold,     ///< threshold for pivoting, >= 0, <= 1
+    HostWorkspaceTiles, ///< number of pinned host workspace tiles to reserve
+                        ///< for staging device transfers, >= 0
+    DeviceCacheTiles,   ///< max number of tiles per device per matrix, using
+                        ///< device memory as an LRU tile cache, >= 0; 0: off
+    HostFirstTouch,     ///< whether insertLocalTiles first touches host tiles
+                        ///< in parallel, to spread them over NUMA domains
+    HostTileArena,      ///< whether insertLocalTiles puts host tiles in one
+                        ///< contiguous column-major arena, like ScaLAPACK
+    BcastPacked,        ///< whether broadcasts pack tiles with the same
+                        ///< pattern into one message (listBcastPacked)
+    ProgressThread,     ///< whether a thread drives outstanding MPI sends,
+                        ///< so broadcasts overlap computation
+    BcastPrecision,     ///< precision of panel broadcasts in factorizations
+                        ///< (@see BcastPrecision)
+    Counters,           ///< pointer to Counters to collect performance
+                        ///< counters in; null: off (@see Counters)
+    TaskRuntime,        ///< task runtime of factorizations (@see TaskRuntime)
+    MaxLookahead,       ///< max lookahead depth for LookaheadAuto, >= 1,
+                        ///< limiting the workspace of panels in flight
+    QueuePriority,      ///< stream priorities of device compute queues
+                        ///< (@see QueuePriority)
+    PanelTarget,        ///< where getrf and potrf with Target::Devices
+                        ///< factor panels: HostTask or Devices
+    ComputePrecision,   ///< compute mode of device gemm updates
+                        ///< (@see ComputePrecision)
+    Layers,             ///< number of layers of ranks for MethodGemm::Layered,
+                        ///< dividing the number of ranks; 0: auto
+    TreeArity,          ///< arity of the QR reduction tree across ranks
+                        ///< in geqrf and unmqr, >= 2
+    Oversampling,       ///< number of extra sketch columns in svd_rand
+    PowerIterations,    ///< number of power iterations in svd_rand
+    FactorsResident,    ///< whether trsm can use the tiles of A already on the
+                        ///< ranks of B, from Factorization::solve
+    EstimateColumns,    ///< number of columns t of the block 1-norm estimator
+                        ///< in gecondest, pocondest, trcondest, >= 1
+    Checkpoint,         ///< pointer to Checkpoint to checkpoint and restart
+                        ///< getrf and potrf in; null: off (@see Checkpoint)
+    SmallTiles,         ///< max number of tiles of matrices on one rank for
+                        ///< potrf, getrf, gemm, trsm to call host LAPACK or
+                        ///< BLAS instead of tasks, >= 0; 0: off
+    TrailingBlock,      ///< number of block columns per trailing update task
+                        ///< in potrf, getrf, geqrf on the host, >= 1
+    GMRESSteps,         ///< number of Arnoldi steps between reductions
+                        ///< in gesv_mixed_gmres, posv_mixed_gmres, >= 1;
+                        ///< 1: classical GMRES
+    BcastPartitioned,   ///< whether packed panel broadcasts in getrf and potrf
+                        ///< use MPI 4 partitioned sends, one partition per tile
+    TailShrink,         ///< number of trailing block columns at which getrf
+                        ///< gathers the rest of A onto a smaller process grid
+                        ///< to finish the factorization, >= 0; 0: off
+    Equilibrate,        ///< whether gesv and posv scale badly scaled systems,
+                        ///< with scale factors from geequ or poequ
+    InfoRequest,        ///< pointer to InfoRequest in which factorizations
+                        ///< reduce info without blocking; null: blocking
+                        ///< (@see InfoRequest)
+    PanelSubTile,       ///< size of the sub-tiles on which potrf on the host
+                        ///< factors each diagonal tile, < nb; 0: off
+    GrowthStats,        ///< pointer to GrowthStats in which getrf and
+                        ///< getrf_nopiv accumulate max |a_ij| and max |u_ij|;
+                        ///< null: off (@see GrowthStats)
+    PanelCores,         ///< number of cores getrf reserves for panel and
+                        ///< communication threads, the first of the
+                        ///< process's affinity mask; 0: off
+    FusedSolve,         ///< whether gesv and posv apply the forward
+                        ///< substitution on B within getrf and potrf,
+                        ///< reusing the broadcast L panels
+    PanelCallback,      ///< pointer to PanelCallback that potrf and geqrf
+                        ///< call as each block column is final; null: off
+                        ///< (@see PanelCallback)
+    GramPrecision,      ///< precision of A^H A in cholqr (@see GramPrecision)
+    DeviceStealing,     ///< whether devices of a rank with fewer tiles of a
+                        ///< batched trailing update in potrf and trtri take
+                        ///< tiles from devices with more
 
     // Printing parameters
     PrintVerbose = 50,  ///< verbose, 0: no printing,
@@ -485,6 +875,7 @@ enum class Option : char {
     PrintWidth,         ///< width print format specifier
     PrintPrecision,     ///< precision print format specifier
                         ///< For correct printing, PrintWidth = PrintPrecision + 6.
+    PrintBinary,        ///< whether dump writes binary files, instead of text
 
     // Methods, listed alphabetically.
     MethodCholQR = 60,  ///< Select the algorithm to compute A^H A
@@ -532,6 +923,12 @@ const int HostNum = -1;
 const int AllDevices = -2;
 const int AnyDevice  = -3;
 
+//------------------------------------------------------------------------------
+/// Option::Lookahead value that adapts the lookahead depth during a
+/// factorization, from measured panel and update times,
+/// up to Option::MaxLookahead.
+const int64_t LookaheadAuto = -1;
+
 //------------------------------------------------------------------------------
 /// A tile state in the MOSI coherency protocol
 enum MOSI {
@@ -7,8 +7,14 @@
 #define SLATE_FUNC_HH
 
 #include "slate/enums.hh"
+#include "slate/internal/mpi.hh"
 
+#include <algorithm>
+#include <cmath>
 #include <functional>
+#include <numeric>
+#include <string>
+#include <vector>
 
 namespace slate {
 
@@ -215,6 +221,300 @@ inline std::function<int(ij_tuple)> process_1d_grid(GridOrder order, int size)
     }
 }
 
+//------------------------------------------------------------------------------
+/// Distributes tiles to processes in a symmetric block cyclic fashion, for
+/// Hermitian, symmetric, and triangular matrices of which only one triangle
+/// is referenced.
+///
+/// The tiles are cut into r-by-r patterns. Each of the r (r-1) / 2
+/// processes owns one off-diagonal pattern cell (a, b), a > b, and its
+/// mirror (b, a), so each triangle of a pattern holds one tile of every
+/// process.
+/// Diagonal cell (a, a) cycles, pattern by pattern, over the r-1 processes
+/// of pattern row a, which already receive the panel tiles of block row a.
+/// Tiles (i, j) and (j, i) are always on the same process.
+/// Compared to process_2d_grid with about as many processes, this gives each
+/// process tiles in fewer block rows and columns, so fewer broadcasts of
+/// potrf, trtri, and he2hb reach it.
+///
+/// Local tiles can be distributed across devices with
+/// device_1d_grid( GridOrder::Row, r, num_devices ).
+///
+/// @param[in] r
+///     The size of the pattern, r >= 2. It distributes to r (r-1) / 2
+///     processes.
+///
+/// @return The distribution function
+///
+/// @ingroup func
+///
+inline std::function<int(ij_tuple)> symmetric_2d_grid(int64_t r)
+{
+    slate_assert( r >= 2 );
+    return [r]( ij_tuple ij ) {
+        int64_t i = std::get<0>( ij );
+        int64_t j = std::get<1>( ij );
+        int64_t a = i % r;
+        int64_t b = j % r;
+        if (a == b) {
+            // c-th cell (a, b), b != a, of pattern row a
+            int64_t c = (std::max( i, j ) / r) % (r-1);
+            b = c < a ? c : c+1;
+        }
+        int64_t hi = std::max( a, b );
+        int64_t lo = std::min( a, b );
+        return int( hi*(hi-1)/2 + lo );
+    };
+}
+
+
+//------------------------------------------------------------------------------
+// Weighted distributions
+
+//------------------------------------------------------------------------------
+/// Interleaves members by weight: returns a pattern of sum( weights )
+/// entries in which d appears weights[ d ] times, evenly spread, using
+/// smooth weighted round robin.
+///
+/// @param[in] weights
+///     The weight of each member, weights[ d ] >= 0, with sum > 0.
+///
+/// @return The pattern of members
+///
+/// @ingroup func
+///
+inline std::vector<int> weighted_pattern(std::vector<int64_t> const& weights)
+{
+    int64_t total = 0;
+    for (int64_t w : weights) {
+        slate_assert( w >= 0 );
+        total += w;
+    }
+    slate_assert( total > 0 );
+
+    std::vector<int> pattern( total );
+    std::vector<int64_t> current( weights.size(), 0 );
+    for (int64_t k = 0; k < total; ++k) {
+        int pick = 0;
+        for (int d = 0; d < int( weights.size() ); ++d) {
+            current[ d ] += weights[ d ];
+            if (current[ d ] > current[ pick ])
+                pick = d;
+        }
+        current[ pick ] -= total;
+        pattern[ k ] = pick;
+    }
+    return pattern;
+}
+
+//------------------------------------------------------------------------------
+/// Distributes tiles to devices or processes in a 1d block-cyclic fashion,
+/// where member d gets weights[ d ] blocks out of every sum( weights ).
+/// With equal weights, this is device_1d_grid.
+/// Use it, e.g., for the devices of a node whose GPUs differ in speed, with
+/// weights from weights_from_rates( device_gemm_rates() ).
+///
+/// @param[in] order
+///     Col distributes a single column across multiple members.
+///     Row distributes a single row across multiple members.
+///
+/// @param[in] block_size
+///     The number of rows or columns in the process grid
+///
+/// @param[in] weights
+///     The weight of each device or process.
+///
+/// @return The distribution function
+///
+/// @ingroup func
+///
+inline std::function<int(ij_tuple)>
+weighted_1d_grid(GridOrder order, int64_t block_size,
+                 std::vector<int64_t> const& weights)
+{
+    slate_assert( order != GridOrder::Unknown );
+    std::vector<int> pattern = weighted_pattern( weights );
+    int64_t period = pattern.size();
+    if (order == GridOrder::Col) {
+        return [block_size, pattern, period]( ij_tuple ij ) {
+            int64_t i = std::get<0>( ij ) / block_size;
+            return pattern[ i % period ];
+        };
+    }
+    else {
+        return [block_size, pattern, period]( ij_tuple ij ) {
+            int64_t j = std::get<1>( ij ) / block_size;
+            return pattern[ j % period ];
+        };
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Distributes tiles to processes in a heterogeneous 2d cyclic fashion:
+/// process row r gets p_weights[ r ] block rows out of every
+/// sum( p_weights ), and process column c gets q_weights[ c ] block columns
+/// out of every sum( q_weights ). With equal weights, this is
+/// process_2d_grid( order, p, q ).
+///
+/// @param[in] order
+///     Whether to use a column major or a row major grid
+///
+/// @param[in] p_weights
+///     The weight of each of the p process rows.
+///
+/// @param[in] q_weights
+///     The weight of each of the q process columns.
+///
+/// @return The distribution function
+///
+/// @ingroup func
+///
+inline std::function<int(ij_tuple)>
+weighted_2d_grid(GridOrder order, std::vector<int64_t> const& p_weights,
+                 std::vector<int64_t> const& q_weights)
+{
+    slate_assert( order != GridOrder::Unknown );
+    std::vector<int> p_pattern = weighted_pattern( p_weights );
+    std::vector<int> q_pattern = weighted_pattern( q_weights );
+    int p = p_weights.size();
+    int q = q_weights.size();
+    return [order, p_pattern, q_pattern, p, q]( ij_tuple ij ) {
+        int64_t i = std::get<0>( ij );
+        int64_t j = std::get<1>( ij );
+        int prow = p_pattern[ i % p_pattern.size() ];
+        int pcol = q_pattern[ j % q_pattern.size() ];
+        if (order == GridOrder::Col)
+            return prow + pcol*p;
+        else
+            return prow*q + pcol;
+    };
+}
+
+//------------------------------------------------------------------------------
+/// Converts measured rates, e.g., from device_gemm_rates, into weights for
+/// weighted_1d_grid and weighted_2d_grid. The fastest member gets
+/// max_weight, the others proportionally less, at least 1, reduced by
+/// their greatest common divisor to keep the pattern short.
+///
+/// @param[in] rates
+///     The rate of each member, rates[ d ] > 0.
+///
+/// @param[in] max_weight
+///     The weight of the fastest member, before reduction, max_weight >= 1.
+///     Larger values follow the rates more closely, with a longer pattern.
+///
+/// @return The weights
+///
+/// @ingroup func
+///
+inline std::vector<int64_t> weights_from_rates(
+    std::vector<double> const& rates, int64_t max_weight = 8)
+{
+    slate_assert( max_weight >= 1 );
+    double max_rate = 0;
+    for (double rate : rates) {
+        slate_assert( rate > 0 );
+        max_rate = std::max( max_rate, rate );
+    }
+    std::vector<int64_t> weights( rates.size() );
+    int64_t divisor = 0;
+    for (size_t d = 0; d < rates.size(); ++d) {
+        int64_t w = std::llround( max_weight * rates[ d ] / max_rate );
+        weights[ d ] = std::max( w, int64_t( 1 ) );
+        divisor = std::gcd( divisor, weights[ d ] );
+    }
+    for (int64_t& w : weights)
+        w /= divisor;
+    return weights;
+}
+
+//------------------------------------------------------------------------------
+/// Calibrates devices for weighted distributions: measures the rate of
+/// an nb-by-nb double precision gemm on each device of this process.
+/// Devices are timed one at a time.
+///
+/// @param[in] nb
+///     Size of the gemm, about the tile size to be used.
+///
+/// @param[in] repeat
+///     Number of timed gemms per device, after one warm up.
+///
+/// @return The Gflop/s of each device; empty if there are no devices.
+///
+/// @ingroup func
+///
+std::vector<double> device_gemm_rates(int64_t nb = 1024, int repeat = 3);
+
+//------------------------------------------------------------------------------
+// Process grid selection
+
+//------------------------------------------------------------------------------
+/// Chooses the process grid for routine on an m-by-n matrix with nb-by-nb
+/// tiles, given the node of each rank, e.g., from MPI_Comm_split_type.
+/// Grid positions are filled node by node, so with GridOrder::Row, process
+/// rows of q ranks within a node broadcast the panel within the node, and
+/// with GridOrder::Col, process columns do.
+/// Each p-by-q grid and order is rated by the words and messages one rank
+/// receives per step, at the node bandwidth and latency for broadcasts
+/// inside a node and at the network's otherwise: the panel is broadcast
+/// along process rows, (m/p) nb words, and the top row along process
+/// columns, (n/q) nb words, as in getrf, geqrf, potrf, and gemm. getrf and
+/// geqrf also reduce across the p ranks of the panel's process column, for
+/// each of nb columns. Grids with more process rows or columns than tiles
+/// are avoided.
+///
+/// The network defaults to 10 GB/s and 2 us per message, overridden by
+/// $SLATE_NETWORK_GBPS and $SLATE_NETWORK_LATENCY_US; within a node to
+/// 40 GB/s and 0.5 us, overridden by $SLATE_NODE_GBPS and
+/// $SLATE_NODE_LATENCY_US.
+///
+/// @param[in] routine
+///     Routine to choose for, e.g., "getrf", "geqrf", "potrf", "gemm".
+///     Others use the gemm model.
+///
+/// @param[in] m
+///     Number of rows of the matrix.
+///
+/// @param[in] n
+///     Number of columns of the matrix.
+///
+/// @param[in] nb
+///     Tile size.
+///
+/// @param[in] nodes
+///     Node of each rank; ranks with the same value share a node.
+///
+/// @param[out] order
+///     Grid order of the chosen grid.
+///
+/// @param[out] p
+///     Number of process rows of the chosen grid.
+///
+/// @param[out] q
+///     Number of process columns of the chosen grid.
+///
+/// @return The tile distribution function, mapping tiles to ranks.
+///     If ranks are numbered node by node, this is
+///     process_2d_grid( order, p, q ).
+///
+/// @ingroup func
+///
+std::function<int(ij_tuple)> topology_grid(
+    std::string const& routine, int64_t m, int64_t n, int64_t nb,
+    std::vector<int> const& nodes,
+    GridOrder* order, int* p, int* q);
+
+//------------------------------------------------------------------------------
+/// Chooses the process grid for routine on an m-by-n matrix with nb-by-nb
+/// tiles, from the node layout of mpi_comm. Collective over mpi_comm.
+/// @see topology_grid above for the model.
+///
+/// @ingroup func
+///
+std::function<int(ij_tuple)> topology_grid(
+    std::string const& routine, int64_t m, int64_t n, int64_t nb,
+    MPI_Comm mpi_comm,
+    GridOrder* order, int* p, int* q);
 
 //------------------------------------------------------------------------------
 /// Transposes the given tile distribution function for processes or devices.
@@ -0,0 +1,73 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+//------------------------------------------------------------------------------
+/// @file
+///
+#ifndef SLATE_INTERNAL_AFFINITY_HH
+#define SLATE_INTERNAL_AFFINITY_HH
+
+#include <cstdint>
+#include <vector>
+
+namespace slate {
+namespace internal {
+
+//------------------------------------------------------------------------------
+/// [internal]
+/// Splits the cores of this process between panel and update threads,
+/// for Option::PanelCores. The constructor reserves the first panel_cores
+/// cores of the process's affinity mask for panels and communication,
+/// binds the threads of the OpenMP team to the other cores, and makes
+/// PanelBinding bind the threads of panel tasks, and the MPI progress
+/// thread, to the reserved cores. The destructor restores the masks.
+///
+/// The first cores of the mask are those a launcher binding each rank
+/// near its GPU and NIC, e.g., with test/gpu_bind.sh and a mapping by
+/// socket or NUMA domain, lists first.
+///
+/// Construct it outside parallel regions. Disabled if panel_cores is 0,
+/// the mask doesn't leave an update core, another CoreAffinity is active,
+/// or the platform has no thread affinity API (only Linux is supported).
+///
+class CoreAffinity {
+public:
+    explicit CoreAffinity( int64_t panel_cores );
+    ~CoreAffinity();
+
+    CoreAffinity( CoreAffinity const& ) = delete;
+    CoreAffinity& operator = ( CoreAffinity const& ) = delete;
+
+    /// @return true if the cores are split.
+    bool enabled() const { return enabled_; }
+
+private:
+    bool enabled_;
+    std::vector<int> process_cores_;  ///< mask on entry, restored on exit
+};
+
+//------------------------------------------------------------------------------
+/// [internal]
+/// Binds the calling thread to the panel cores of the active CoreAffinity,
+/// if any, for its lifetime; the destructor restores the thread's mask.
+/// Declare one at the top of each panel thread's work.
+///
+class PanelBinding {
+public:
+    PanelBinding();
+    ~PanelBinding();
+
+    PanelBinding( PanelBinding const& ) = delete;
+    PanelBinding& operator = ( PanelBinding const& ) = delete;
+
+private:
+    bool bound_;
+    std::vector<int> thread_cores_;  ///< mask on entry, restored on exit
+};
+
+} // namespace internal
+} // namespace slate
+
+#endif // SLATE_INTERNAL_AFFINITY_HH
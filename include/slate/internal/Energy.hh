@@ -0,0 +1,55 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef SLATE_ENERGY_HH
+#define SLATE_ENERGY_HH
+
+#include <string>
+#include <vector>
+
+namespace slate {
+namespace trace {
+
+//------------------------------------------------------------------------------
+/// Energy sampler of this node: a thread that periodically reads the
+/// cumulative energy counters of the CPU packages and DRAM (Linux RAPL,
+/// via /sys/class/powercap), and of the GPUs, with NVML if compiled with
+/// SLATE_HAVE_NVML, or ROCm SMI if compiled with SLATE_HAVE_ROCM_SMI.
+/// Samples are on the trace::now() clock, so energy can be attributed to
+/// trace Blocks and timed regions:
+///
+///     slate::trace::Energy::start();
+///     double t0 = slate::trace::now();
+///     slate::gesv( A, pivots, B );
+///     double t1 = slate::trace::now();
+///     slate::trace::Energy::stop();
+///     double joules = slate::trace::Energy::joules( t0, t1 );
+///
+/// Counters are per node, so on nodes with several ranks, only one rank
+/// per node should report, or energy is counted several times.
+/// Counter resolution is about 1 ms for RAPL and 10--100 ms for GPUs;
+/// regions shorter than the sampling interval are interpolated.
+///
+class Energy {
+public:
+    static void start( double interval = 0.01 );
+    static void stop();
+
+    /// @return whether the sampler thread is running.
+    static bool running();
+
+    /// @return names of the energy counters found, e.g., "rapl:package-0",
+    /// "nvml:0"; empty if none are readable, e.g., without permission.
+    static std::vector< std::string > sources();
+
+    static bool sampled();
+
+    static double joules( double t0, double t1 );
+};
+
+} // namespace trace
+} // namespace slate
+
+#endif // SLATE_ENERGY_HH
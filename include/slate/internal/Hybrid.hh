@@ -0,0 +1,64 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+//------------------------------------------------------------------------------
+/// @file
+///
+#ifndef SLATE_INTERNAL_HYBRID_HH
+#define SLATE_INTERNAL_HYBRID_HH
+
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace slate {
+namespace internal {
+
+//------------------------------------------------------------------------------
+/// [internal]
+/// Splits the trailing update of each step of a factorization with
+/// Target::Hybrid between the devices and the host. The devices update
+/// the first block-columns of the trailing submatrix, and the host the
+/// last ones, which are the last to be needed by the panels.
+///
+/// Tasks report the flops and times of both parts with done(), and
+/// split() balances the predicted times of the next step from the
+/// measured rates. Until both rates are measured, the host gets only the
+/// last block-column. The split is local to each rank and covers only
+/// local computation, so ranks may split differently.
+///
+/// The tiles of each part are fetched with tileGetForWriting on the host
+/// or a device, so moving the split between steps moves tiles between
+/// the host and devices following the MOSI protocol.
+///
+class HybridSplit {
+public:
+    explicit HybridSplit( bool enabled );
+
+    HybridSplit( HybridSplit const& ) = delete;
+    HybridSplit& operator = ( HybridSplit const& ) = delete;
+
+    /// @return true if the trailing updates are split.
+    bool enabled() const { return enabled_; }
+
+    int64_t split( std::vector<double> const& flops ) const;
+
+    void done( double host_flops, double host_time,
+               double device_flops, double device_time );
+
+    double hostFraction() const;
+
+private:
+    bool enabled_;
+
+    mutable std::mutex mutex_;  ///< guards rates
+    double host_rate_;          ///< flop/s of the host part, 0 until measured
+    double device_rate_;        ///< flop/s of the device part, 0 until measured
+};
+
+} // namespace internal
+} // namespace slate
+
+#endif // SLATE_INTERNAL_HYBRID_HH
@@ -0,0 +1,74 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+//------------------------------------------------------------------------------
+/// @file
+///
+#ifndef SLATE_INTERNAL_LOOKAHEAD_HH
+#define SLATE_INTERNAL_LOOKAHEAD_HH
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+namespace slate {
+namespace internal {
+
+//------------------------------------------------------------------------------
+/// [internal]
+/// Chooses the lookahead depth of each step k of a right-looking
+/// factorization. For a fixed Option::Lookahead, every step uses it.
+/// For LookaheadAuto, tasks report their times with panelDone() and
+/// updateDone(), and step() sets the depth of step k to
+/// 1 + (panel time) / (trailing update time), both predicted for step k
+/// from the measured rates, so the depth grows in the tail of the
+/// factorization, where the panel becomes the bottleneck.
+///
+/// The depth changes by at most 1 per step, so the trailing submatrix of
+/// step k+1 is inside that of step k, and at most max() steps run ahead,
+/// bounding workspace and device queues as a fixed lookahead of max() would.
+///
+class AdaptiveLookahead {
+public:
+    AdaptiveLookahead( int64_t lookahead, int64_t max_lookahead );
+
+    AdaptiveLookahead( AdaptiveLookahead const& ) = delete;
+    AdaptiveLookahead& operator = ( AdaptiveLookahead const& ) = delete;
+
+    /// @return true if the depth adapts at runtime.
+    bool isAuto() const { return auto_; }
+
+    /// @return largest depth step() returns: use it to size queues and
+    /// workspace.
+    int64_t max() const { return max_; }
+
+    /// Starts at step k, as if panels 0, ..., k-1 were done,
+    /// e.g., when restarting from a Checkpoint.
+    void resume( int64_t k ) { last_panel_.store( k - 1 ); }
+
+    int64_t step( int64_t k, double panel_flops, double update_flops );
+
+    void wait( int64_t k );
+
+    void panelDone( int64_t k, double flops, double time );
+
+    void updateDone( double flops, double time );
+
+private:
+    bool auto_;
+    int64_t max_;
+    int64_t depth_;             ///< depth of the previous step
+
+    std::mutex mutex_;          ///< guards rates
+    double panel_rate_;         ///< seconds per flop of the last panel
+    double update_rate_;        ///< seconds per flop of the last update
+
+    std::atomic<int64_t> last_panel_;
+};
+
+} // namespace internal
+} // namespace slate
+
+#endif // SLATE_INTERNAL_LOOKAHEAD_HH
@@ -0,0 +1,70 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef SLATE_MAPPED_FILE_HH
+#define SLATE_MAPPED_FILE_HH
+
+#include <cstddef>
+#include <string>
+
+namespace slate {
+
+//------------------------------------------------------------------------------
+/// File mapped into host memory, holding tiles of an out-of-core matrix.
+/// Pages are read from the file when first accessed, and modified pages
+/// are written back to the file by the OS, so resident memory is bounded by
+/// the pages in use rather than the file size.
+/// prefetch and release give the OS hints to read pages ahead of their use
+/// and to drop them after their last use.
+///
+class MappedFile {
+public:
+    MappedFile(std::string const& filename, size_t size);
+    ~MappedFile();
+
+    //--------------------------------------------------------------------------
+    // 2. copy constructor -- not allowed; object owns the mapping
+    // 3. move constructor -- not allowed; object owns the mapping
+    // 4. copy assignment  -- not allowed; object owns the mapping
+    // 5. move assignment  -- not allowed; object owns the mapping
+    MappedFile(MappedFile&  orig) = delete;
+    MappedFile(MappedFile&& orig) = delete;
+    MappedFile& operator = (MappedFile&  orig) = delete;
+    MappedFile& operator = (MappedFile&& orig) = delete;
+
+    /// @return start of the mapped memory.
+    void* data() const { return data_; }
+
+    /// @return size of the mapping in bytes.
+    size_t size() const { return size_; }
+
+    /// @return name of the mapped file.
+    std::string const& filename() const { return filename_; }
+
+    /// @return whether ptr is within the mapping.
+    bool contains(void const* ptr) const
+    {
+        char const* p = (char const*) ptr;
+        char const* begin = (char const*) data_;
+        return begin <= p && p < begin + size_;
+    }
+
+    void prefetch(void const* ptr, size_t bytes);
+    void release(void const* ptr, size_t bytes);
+    void sync();
+
+private:
+    void page_range(void const* ptr, size_t bytes,
+                    char** begin, size_t* length) const;
+
+    std::string filename_;
+    size_t size_;
+    int fd_;
+    void* data_;
+};
+
+} // namespace slate
+
+#endif // SLATE_MAPPED_FILE_HH
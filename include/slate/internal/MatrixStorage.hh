@@ -6,8 +6,12 @@
 #ifndef SLATE_STORAGE_HH
 #define SLATE_STORAGE_HH
 
+#include "slate/Counters.hh"
 #include "slate/func.hh"
+#include "slate/internal/MappedFile.hh"
 #include "slate/internal/Memory.hh"
+#include "slate/internal/peer.hh"
+#include "slate/internal/queue.hh"
 #include "slate/Tile.hh"
 #include "slate/types.hh"
 #include "slate/internal/util.hh"
@@ -17,9 +21,14 @@
 #include "lapack/device.hh"
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <functional>
+#include <list>
+#include <map>
 #include <memory>
 #include <set>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -142,6 +151,77 @@ public:
     }
 };
 
+//------------------------------------------------------------------------------
+/// Counters for the device tile cache, per device.
+/// @see MatrixStorage::enableTileCache
+///
+struct TileCacheStats {
+    int64_t hits       = 0;  ///< tileGet found a valid instance on the device
+    int64_t misses     = 0;  ///< tileGet had to copy the tile to the device
+    int64_t evictions  = 0;  ///< instances evicted to free device memory
+    int64_t writebacks = 0;  ///< evicted instances first copied to host
+};
+
+//------------------------------------------------------------------------------
+/// MOSI coherence events of a matrix's tiles, counted only if SLATE is
+/// compiled with SLATE_COHERENCE_COUNTERS.
+/// @see MatrixStorage::coherenceCount
+///
+enum class CoherenceEvent {
+    Hit,                ///< tileGet found a valid instance on the destination
+    ToDevice,           ///< tileGet copied a tile to a device
+    ToHost,             ///< tileGet copied a tile to host
+    LayoutConversion,   ///< a tile instance was converted to another layout
+    Invalidation,       ///< tileModified invalidated another instance
+    NumEvents,
+};
+
+//------------------------------------------------------------------------------
+/// Counts of MOSI coherence events of a matrix's tiles, on all devices.
+/// All zero unless SLATE is compiled with SLATE_COHERENCE_COUNTERS.
+/// @see BaseMatrix::coherenceStats
+///
+struct CoherenceStats {
+    int64_t hits               = 0;  ///< tileGet found the tile valid
+    int64_t to_device          = 0;  ///< tiles copied host or device to device
+    int64_t to_host            = 0;  ///< tiles copied device to host
+    int64_t layout_conversions = 0;  ///< tiles converted to another layout
+    int64_t invalidations      = 0;  ///< instances invalidated by tileModified
+};
+
+//------------------------------------------------------------------------------
+/// Completion token for tile copies queued by
+/// BaseMatrix::tileGetForReadingAsync.
+/// BLAS++ queues do not expose device events, so wait() synchronizes the
+/// queue the copies were issued on, which also completes copies queued
+/// on it earlier.
+///
+class TileGetToken {
+public:
+    TileGetToken()
+        : queue_( nullptr )
+    {}
+
+    explicit TileGetToken( blas::Queue* queue )
+        : queue_( queue )
+    {}
+
+    /// Waits for the copies to complete. Calling it again does nothing.
+    void wait()
+    {
+        if (queue_ != nullptr) {
+            queue_->sync();
+            queue_ = nullptr;
+        }
+    }
+
+    /// @return whether copies may still be pending.
+    bool pending() const { return queue_ != nullptr; }
+
+private:
+    blas::Queue* queue_;
+};
+
 //------------------------------------------------------------------------------
 /// Slate::MatrixStorage class
 /// Used to store the map of distributed tiles.
@@ -200,6 +280,19 @@ public:
         return comm_queues_.at( device );
     }
 
+    /// Number of host staging slots per device, @see staging_queue.
+    static constexpr int num_staging_slots = 2;
+
+    lapack::Queue* staging_queue( int device, int slot );
+
+    /// @return queue used to pin and unpin the host workspace pool,
+    /// or nullptr if there are no devices, in which case the
+    /// host workspace is pageable.
+    lapack::Queue* host_queue()
+    {
+        return num_devices() > 0 ? comm_queues_[ 0 ] : nullptr;
+    }
+
     /// @return BLAS++ compute queues
     ///
     /// @param[in] device
@@ -219,6 +312,25 @@ public:
         return int(compute_queues_.size());
     }
 
+    void setComputeQueuePriority( int queue_index, bool high_priority );
+    void setComputeQueuePrecision( int queue_index, ComputePrecision precision );
+
+    /// @return compute mode of the compute queues with queue_index,
+    /// Native if it was never set.
+    ComputePrecision computeQueuePrecision( int queue_index )
+    {
+        if (queue_index < 0
+            || queue_index >= int( compute_queue_precision_.size() ))
+            return ComputePrecision::Native;
+        return compute_queue_precision_[ queue_index ];
+    }
+
+    /// @see BaseMatrix::setDeviceStealing
+    void setDeviceStealing( bool stealing ) { device_stealing_ = stealing; }
+
+    /// @return whether batched updates balance tiles across devices.
+    bool deviceStealing() const { return device_stealing_; }
+
     //--------------------------------------------------------------------------
     // batch arrays
     void allocateBatchArrays(int64_t batch_size, int64_t num_arrays);
@@ -244,10 +356,35 @@ public:
         return array_dev_.at( batch_arrays_index ).at( device );
     }
 
+    bool batchArrayUpload(
+        int device, int64_t batch_arrays_index,
+        scalar_t* const* src, int64_t count, blas::Queue& queue,
+        int64_t offset = 0 );
+
+    /// @return the batch dimensions array on host, of
+    /// batch_dims_per_tile * batchArraySize() entries, to send to device
+    int64_t* batchDimsHost( int device, int64_t batch_arrays_index )
+    {
+        assert(batch_arrays_index >= 0);
+        return dims_host_.at( batch_arrays_index ).at( device );
+    }
+
+    /// @return the batch dimensions array on device
+    int64_t* batchDimsDevice( int device, int64_t batch_arrays_index )
+    {
+        assert(batch_arrays_index >= 0);
+        return dims_dev_.at( batch_arrays_index ).at( device );
+    }
+
+    /// Number of dimensions per tile in the batch dimensions arrays,
+    /// for variable-size batches: m, n, k, lda, ldb, ldc.
+    static constexpr int64_t batch_dims_per_tile = 6;
+
     //--------------------------------------------------------------------------
     // workspace
     void reserveHostWorkspace(int64_t num_tiles);
     void reserveDeviceWorkspace(int64_t num_tiles);
+    void reserveDeviceWorkspace(std::vector<int64_t> const& num_tiles);
     void ensureDeviceWorkspace(int device, int64_t num_tiles);
     void clearWorkspace();
     void releaseWorkspace();
@@ -255,43 +392,293 @@ public:
     scalar_t* allocWorkspaceBuffer(int device, int size);
     void      releaseWorkspaceBuffer(scalar_t* data, int device);
 
-private:
-    // Iterator routines should be called only within a Tiles Map LockGuard.
-    // Otherwise, there may be race conditions with the returned iterator.
+    //--------------------------------------------------------------------------
+    // device tile cache
+    void enableTileCache(int64_t num_tiles);
+    void disableTileCache();
+
+    /// @return whether device memory is used as a tile cache.
+    bool tileCacheEnabled() const
+    {
+        return cache_tiles_ > 0;
+    }
+
+    void tileCacheAccess(ijdev_tuple ijdev, bool hit);
+    void tileCachePin(ij_tuple ij, int device);
+    void tileCacheUnpin(ij_tuple ij, int device);
+    TileCacheStats tileCacheStats(int device);
+    void tileCacheResetStats();
 
     //--------------------------------------------------------------------------
-    /// @return TileNode(i, j) if it has instance on device, end() otherwise
-    typename TilesMap::iterator find(ijdev_tuple ijdev)
+    // MOSI coherence counters
+
+    /// Counts n coherence events; compiles to nothing unless
+    /// SLATE_COHERENCE_COUNTERS is defined. Hits and invalidations are
+    /// also added to the process-wide counts of Option::Counters phases,
+    /// which count transfers and conversions regardless.
+    void coherenceCount(CoherenceEvent event, int64_t n = 1)
     {
-        int64_t i  = std::get<0>(ijdev);
-        int64_t j  = std::get<1>(ijdev);
-        int device = std::get<2>(ijdev);
-        auto it = tiles_.find({i, j});
-        if (it != tiles_.end() && it->second->existsOn(device))
-            return it;
-        else
-            return tiles_.end();
+    #if defined( SLATE_COHERENCE_COUNTERS )
+        coherence_counts_[ int( event ) ].fetch_add(
+            n, std::memory_order_relaxed );
+        if (event == CoherenceEvent::Hit)
+            internal::count( internal::Count::TileHits, n );
+        else if (event == CoherenceEvent::Invalidation)
+            internal::count( internal::Count::TileInvalidations, n );
+    #else
+        (void) event;
+        (void) n;
+    #endif
+    }
+
+    CoherenceStats coherenceStats() const;
+    void coherenceResetStats();
+
+    //--------------------------------------------------------------------------
+    // memory statistics
+
+    /// @return memory statistics of device, which can be host,
+    /// including workspace, tiles, and batch arrays.
+    MemoryStats memoryStats(int device) const
+    {
+        return memory_.stats( device );
+    }
+
+    /// Resets high-water marks of device's memory to the current use.
+    void resetMemoryPeak(int device)
+    {
+        memory_.resetPeak( device );
+    }
+
+    //--------------------------------------------------------------------------
+    // structurally zero tiles
+
+    /// @return whether structurally zero tiles are tracked.
+    bool zeroTilesTracked() const
+    {
+        return track_zero_tiles_;
+    }
+
+    void trackZeroTiles(bool track);
+    bool tileIsZero(ij_tuple ij);
+    void tileSetZero(ij_tuple ij, bool is_zero);
+
+    //--------------------------------------------------------------------------
+    // lazy zero tiles
+
+    /// @return whether any local tile is a lazy zero tile; no locking,
+    /// so the check is cheap when there are none.
+    bool hasLazyZeroTiles() const
+    {
+        return num_lazy_zero_.load( std::memory_order_acquire ) > 0;
+    }
+
+    void tileInsertLazyZero(ij_tuple ij, int device);
+    bool tileIsLazyZero(ij_tuple ij);
+    bool tileMaterialize(
+        ij_tuple ij, Layout layout,
+        std::function< void (Tile<scalar_t>*) > const& fill);
+
+    //--------------------------------------------------------------------------
+    // copy-on-write snapshots
+
+    /// @return whether any local tile shares its data with another matrix;
+    /// no locking, so the check is cheap when none does.
+    bool hasCowTiles() const
+    {
+        return num_cow_.load( std::memory_order_acquire ) > 0;
+    }
+
+    void tileShareCow(ij_tuple ij, int device);
+    void tileAddCowSnapshot(
+        ij_tuple ij, std::weak_ptr< MatrixStorage > snapshot,
+        ij_tuple snapshot_ij);
+    bool tileIsCowShared(ij_tuple ij);
+    void tileCowDetach(ij_tuple ij);
+    void cowDetachAll();
+
+    //--------------------------------------------------------------------------
+    // compact band transfers
+
+    /// @return whether broadcasts send only the band part of tiles.
+    bool bandCompacted() const
+    {
+        return band_compact_;
+    }
+
+    void setBand(int64_t kl, int64_t ku, int64_t mt, int64_t nt);
+    void clearBand();
+
+    //--------------------------------------------------------------------------
+    // compressed transfers
+
+    /// @return compression of tiles sent by broadcasts.
+    Compression compression() const
+    {
+        return compression_;
+    }
+
+    /// @return relative error tolerance of Compression::ErrorBounded.
+    double compressionTolerance() const
+    {
+        return compression_tol_;
+    }
+
+    /// Sets compression of tiles sent by broadcasts.
+    void setCompression(Compression compression, double tol)
+    {
+        compression_ = compression;
+        compression_tol_ = tol;
+    }
+
+    //--------------------------------------------------------------------------
+    // workspace sessions
+
+    /// @return whether a workspace session is open.
+    bool sessionActive() const
+    {
+        return session_depth_ > 0;
+    }
+
+    void sessionBegin();
+    void sessionEnd();
+    void sessionClear();
+    void sessionCommit();
+    void sessionFilter(ij_tuple ij, int root, std::set<int>& bcast_set);
+    void sessionHold(ijdev_tuple ijdev);
+
+    //--------------------------------------------------------------------------
+    // one-sided (RMA) tile access, @see BaseMatrix::rmaOpen
+
+    /// Address in the RMA window and column stride of a host tile.
+    struct RmaTile {
+        MPI_Aint address;
+        int64_t stride;
+    };
+
+    /// @return whether an RMA window exposes the local host tiles.
+    bool rmaActive() const
+    {
+        return rma_win_ != MPI_WIN_NULL;
+    }
+
+    /// @return the RMA window, or MPI_WIN_NULL if none is open.
+    MPI_Win rmaWindow() const
+    {
+        return rma_win_;
+    }
+
+    /// Records the RMA window, the local memory attached to it,
+    /// and the remote address of each tile exposed in it.
+    void rmaSet(MPI_Win win, std::vector<void*>&& attached,
+                std::map< ij_tuple, RmaTile >&& tiles)
+    {
+        rma_win_ = win;
+        rma_attached_ = std::move( attached );
+        rma_tiles_ = std::move( tiles );
+    }
+
+    /// Forgets the RMA window, returning it and the memory attached to it,
+    /// for the caller to detach and free.
+    MPI_Win rmaReset(std::vector<void*>* attached)
+    {
+        MPI_Win win = rma_win_;
+        *attached = std::move( rma_attached_ );
+        rma_win_ = MPI_WIN_NULL;
+        rma_attached_.clear();
+        rma_tiles_.clear();
+        return win;
+    }
+
+    /// @return the address of tile ij in the RMA window, or nullptr if the
+    /// tile isn't exposed in it.
+    RmaTile const* rmaTile(ij_tuple ij) const
+    {
+        auto iter = rma_tiles_.find( ij );
+        return iter != rma_tiles_.end() ? &iter->second : nullptr;
+    }
+
+private:
+    /// Forgets the session records, without releasing tiles,
+    /// for when tiles are erased anyway.
+    void sessionForget()
+    {
+        LockGuard guard( &session_lock_ );
+        session_holders_.clear();
+        session_pending_.clear();
+        session_held_.clear();
+    }
+
+public:
+
+    /// Widens the band of compact transfers to at least kl sub-diagonals
+    /// and ku super-diagonals, e.g., for fill-in. Never narrows it, since
+    /// views sharing the storage, such as the triangular factors of a
+    /// band LU, may have narrower bands than the matrix.
+    void growBand(int64_t kl, int64_t ku)
+    {
+        band_kl_ = std::max( band_kl_, kl );
+        band_ku_ = std::max( band_ku_, ku );
     }
+    bool tileBandBox(ij_tuple ij, int64_t* i0, int64_t* mb,
+                     int64_t* j0, int64_t* nb);
+
+private:
+    //--------------------------------------------------------------------------
+    /// One shard of the tiles map, with its own lock.
+    /// Tile (i, j) is stored in shard (i + j) mod num_shards, so tiles in
+    /// the same block row or block column are spread over all shards and
+    /// threads updating different tiles rarely contend for the same lock.
+    struct TilesShard {
+        TilesShard()  { omp_init_nest_lock( &lock ); }
+        ~TilesShard() { omp_destroy_nest_lock( &lock ); }
+
+        TilesShard( TilesShard const& ) = delete;
+        TilesShard& operator = ( TilesShard const& ) = delete;
+
+        TilesMap tiles;
+        mutable omp_nest_lock_t lock;
+    };
+
+    static constexpr int num_shards_ = 64;
 
     //--------------------------------------------------------------------------
-    /// @return TileNode(i, j) if found, end() otherwise
-    typename TilesMap::iterator find(ij_tuple ij)
+    /// @return shard holding TileNode(i, j).
+    TilesShard& shard( ij_tuple ij )
     {
-        return tiles_.find(ij);
+        int64_t i = std::get<0>( ij );
+        int64_t j = std::get<1>( ij );
+        return shards_[ (i + j) % num_shards_ ];
     }
 
+    // Lookup routines should be called only within the shard's LockGuard,
+    // or within the Tiles Map LockGuard, which blocks insertion and erasure.
+    // Otherwise, there may be race conditions with the returned pointer.
+
     //--------------------------------------------------------------------------
-    /// @return begin iterator of TileNode map
-    typename TilesMap::iterator begin()
+    /// @return TileNode(i, j) if it has instance on device, nullptr otherwise
+    TileNode_t* find( ijdev_tuple ijdev )
     {
-        return tiles_.begin();
+        int64_t i  = std::get<0>( ijdev );
+        int64_t j  = std::get<1>( ijdev );
+        int device = std::get<2>( ijdev );
+        TileNode_t* tile_node = find( { i, j } );
+        if (tile_node != nullptr && tile_node->existsOn( device ))
+            return tile_node;
+        else
+            return nullptr;
     }
 
     //--------------------------------------------------------------------------
-    /// @return begin iterator of TileNode map
-    typename TilesMap::iterator end()
+    /// @return TileNode(i, j) if found, nullptr otherwise
+    TileNode_t* find( ij_tuple ij )
     {
-        return tiles_.end();
+        auto& tiles = shard( ij ).tiles;
+        auto iter = tiles.find( ij );
+        if (iter != tiles.end())
+            return iter->second.get();
+        else
+            return nullptr;
     }
 
 public:
@@ -301,8 +688,9 @@ public:
     // at() doesn't create new (null) entries in map as operator[] would
     TileNode_t& at(ij_tuple ij)
     {
-        LockGuard guard(getTilesMapLock());
-        return *(tiles_.at(ij));
+        auto& sh = shard( ij );
+        LockGuard guard( &sh.lock );
+        return *(sh.tiles.at( ij ));
     }
 
     /// @return pointer to an actual Tile object
@@ -323,18 +711,34 @@ public:
     void erase(ij_tuple ij);
     void release(ijdev_tuple ijdev);
 private:
-    void release(typename TilesMap::iterator iter, int device);
+    void release(ij_tuple ij, TileNode_t& tile_node, int device);
+    void tileCacheReserve(int device, int64_t num_tiles);
+    bool tileCacheEvict(int device);
+    void tileCacheErase(ij_tuple ij, int device);
 public:
     void freeTileMemory(Tile<scalar_t>* tile);
     void clear();
 
     //--------------------------------------------------------------------------
-    /// Return pointer to tiles-map OMP lock
+    /// Return pointer to tiles-map OMP lock.
+    /// Holding it excludes insertion and erasure of tile nodes by other
+    /// threads. It is not needed for lookups or MOSI changes of existing
+    /// tiles, which take only the lock of the shard holding the tile.
     omp_nest_lock_t* getTilesMapLock()
     {
         return &lock_;
     }
 
+    /// @return number of tile nodes in the map.
+    size_t size()
+    {
+        LockGuard guard( getTilesMapLock() );
+        size_t count = 0;
+        for (auto& sh : shards_)
+            count += sh.tiles.size();
+        return count;
+    }
+
     //--------------------------------------------------------------------------
     std::function<int64_t (int64_t i)> tileMb;
     std::function<int64_t (int64_t j)> tileNb;
@@ -348,27 +752,92 @@ public:
         return tileRank(ij) == mpi_rank_;
     }
 
+    //--------------------------------------------------------------------------
+    /// Appends to rows the block rows i in [ i_begin, i_end ) of block
+    /// column j whose tiles are local and on device, in ascending order.
+    /// Each column is walked once and cached, so repeated calls, e.g., for
+    /// the batch regions of each step of a factorization, cost only the
+    /// local rows. Assumes tileRank and tileDevice are not changed after
+    /// the first call.
+    void tileLocalRows(
+        int device, int64_t j, int64_t i_begin, int64_t i_end,
+        std::vector<int64_t>& rows )
+    {
+        LockGuard guard( &local_rows_lock_ );
+        LocalRows& cached = local_rows_[ { device, j } ];
+        // Extend the cache to cover i_end.
+        for (int64_t i = cached.extent; i < i_end; ++i) {
+            if (tileIsLocal( { i, j } ) && tileDevice( { i, j } ) == device)
+                cached.rows.push_back( i );
+        }
+        cached.extent = std::max( cached.extent, i_end );
+
+        auto first = std::lower_bound( cached.rows.begin(), cached.rows.end(),
+                                       i_begin );
+        auto last  = std::lower_bound( first, cached.rows.end(), i_end );
+        rows.insert( rows.end(), first, last );
+    }
+
     Tile<scalar_t>* tileInsert(
         ijdev_tuple ijdev, TileKind, Layout layout=Layout::ColMajor);
     Tile<scalar_t>* tileInsert(
         ijdev_tuple ijdev, scalar_t* data, int64_t lda,
         Layout layout=Layout::ColMajor);
+    Tile<scalar_t>* tileInsertMapped(
+        ij_tuple ij, scalar_t* data, int64_t lda,
+        Layout layout=Layout::ColMajor);
 private:
     Tile<scalar_t>* tileInsert(
         ijdev_tuple ijdev, scalar_t* data, int64_t lda,
         TileKind kind, Layout layout);
+public:
+    //--------------------------------------------------------------------------
+    // memory-mapped files
+    scalar_t* mapFile(std::string const& filename, int64_t num_tiles);
+    void tilePrefetchMapped(Tile<scalar_t>* tile);
+    void tileFlushMapped(Tile<scalar_t>* tile);
+    void syncMappedFiles();
+
+    /// @return number of elements in the largest tile.
+    int64_t maxTileSize() const
+    {
+        return memory_.block_size() / sizeof(scalar_t);
+    }
+
+    /// @return whether any tiles are in memory-mapped files.
+    bool hasMappedFiles() const
+    {
+        return ! mapped_files_.empty();
+    }
+
+private:
+    MappedFile* findMappedFile(Tile<scalar_t>* tile);
+public:
+    //--------------------------------------------------------------------------
+    // host tile arena
+    scalar_t* allocArena(int64_t size, int64_t lld);
+
+    /// @return start of the host arena holding local origin tiles,
+    /// or nullptr if there is none.
+    scalar_t* arenaData() const { return arena_; }
+
+    /// @return leading dimension of the host arena.
+    int64_t arenaStride() const { return arena_lld_; }
+
+private:
+    void freeArena();
 public:
     bool tileExists( ijdev_tuple ijdev )
     {
-        LockGuard guard( getTilesMapLock() );
         int64_t i  = std::get<0>(ijdev);
         int64_t j  = std::get<1>(ijdev);
         int device = std::get<2>(ijdev);
+        LockGuard guard( &shard( {i, j} ).lock );
         if (device == AnyDevice) {
-            return find( {i, j} ) != end();
+            return find( {i, j} ) != nullptr;
         }
         else {
-            return find( ijdev ) != end();
+            return find( ijdev ) != nullptr;
         }
     }
 
@@ -379,24 +848,27 @@ public:
     /// @return tile's receive counter.
     int64_t tileReceiveCount(ij_tuple ij)
     {
-        LockGuard guard( getTilesMapLock() );
-        return tiles_.at( ij )->receiveCount();
+        auto& sh = shard( ij );
+        LockGuard guard( &sh.lock );
+        return sh.tiles.at( ij )->receiveCount();
     }
 
     //--------------------------------------------------------------------------
     /// Increment tile's receive counter.
     void tileIncrementReceiveCount(ij_tuple ij)
     {
-        LockGuard guard( getTilesMapLock() );
-        tiles_.at( ij )->receiveCount()++;
+        auto& sh = shard( ij );
+        LockGuard guard( &sh.lock );
+        sh.tiles.at( ij )->receiveCount()++;
     }
 
     //--------------------------------------------------------------------------
     /// Decrement tile's receive counter.
     void tileDecrementReceiveCount( ij_tuple ij, int64_t release_count = 1 )
     {
-        LockGuard guard( getTilesMapLock() );
-        tiles_.at( ij )->receiveCount() -= release_count;
+        auto& sh = shard( ij );
+        LockGuard guard( &sh.lock );
+        sh.tiles.at( ij )->receiveCount() -= release_count;
     }
 
     /// Ensures the tile node exists and increments the receive count.
@@ -411,9 +883,7 @@ public:
             int64_t i  = std::get<0>( ij );
             int64_t j  = std::get<1>( ij );
 
-            auto iter = find( ij );
-
-            if (iter == end())
+            if (! tileExists( {i, j, AnyDevice} ))
                 tileInsert( {i, j, device}, TileKind::Workspace, layout );
             tileIncrementReceiveCount( ij );
         }
@@ -423,39 +893,43 @@ public:
     /// Gets the state of the given tile
     MOSI tileState(ijdev_tuple ijdev)
     {
-        LockGuard guard( getTilesMapLock() );
-        auto iter = find( ijdev );
-        assert(iter != end());
-
         int device = std::get<2>(ijdev);
-        return iter->second->at(device)->state();
+        auto& sh = shard( { std::get<0>(ijdev), std::get<1>(ijdev) } );
+        LockGuard guard( &sh.lock );
+        auto tile_node = find( ijdev );
+        assert(tile_node != nullptr);
+
+        return tile_node->at(device)->state();
     }
 
     /// Checks whether the given tile is on hold
-    MOSI tileOnHold(ijdev_tuple ijdev)
+    bool tileOnHold(ijdev_tuple ijdev)
     {
-        LockGuard guard( getTilesMapLock() );
-        auto iter = find( ijdev );
-        assert(iter != end());
-
         int device = std::get<2>(ijdev);
-        return iter->second->at(device)->stateOn(MOSI::OnHold);
+        auto& sh = shard( { std::get<0>(ijdev), std::get<1>(ijdev) } );
+        LockGuard guard( &sh.lock );
+        auto tile_node = find( ijdev );
+        assert(tile_node != nullptr);
+
+        return tile_node->at(device)->stateOn(MOSI::OnHold);
     }
 
     /// Unsets any hold on the given tile
     void tileUnsetHold(ijdev_tuple ijdev)
     {
-        LockGuard guard( getTilesMapLock() );
-        auto iter = find( ijdev );
-        if (iter != end()) {
-            int device = std::get<2>(ijdev);
-            iter->second->at(device)->state(~MOSI::OnHold);
+        int device = std::get<2>(ijdev);
+        auto& sh = shard( { std::get<0>(ijdev), std::get<1>(ijdev) } );
+        LockGuard guard( &sh.lock );
+        auto tile_node = find( ijdev );
+        if (tile_node != nullptr) {
+            tile_node->at(device)->state(~MOSI::OnHold);
         }
     }
 
 private:
-    TilesMap tiles_;        ///< map of tiles and associated states
-    mutable omp_nest_lock_t lock_;  ///< TilesMap lock
+    /// map of tiles and associated states, split into shards
+    std::array< TilesShard, num_shards_ > shards_;
+    mutable omp_nest_lock_t lock_;  ///< TilesMap insert/erase lock
     slate::Memory memory_;  ///< memory allocator
 
     int mpi_rank_;
@@ -464,14 +938,120 @@ private:
 
     // BLAS++ communication queues
     std::vector< lapack::Queue* > comm_queues_;
+    // BLAS++ queues of the host staging slots, created on first use
+    std::vector< std::array< lapack::Queue*, num_staging_slots > > staging_queues_;
     // BLAS++ compute queues
     std::vector< std::vector< lapack::Queue* > > compute_queues_;
+    // whether each set of compute queues has high stream priority
+    std::vector<bool> compute_queue_high_;
+    // compute mode of each set of compute queues
+    std::vector<ComputePrecision> compute_queue_precision_;
+    // whether batched updates balance tiles across devices
+    bool device_stealing_ = false;
 
     // host pointers arrays for batch GEMM
     std::vector< std::vector< scalar_t** > > array_host_;
 
     // device pointers arrays for batch GEMM
     std::vector< std::vector< scalar_t** > > array_dev_;
+
+    // host copies of the leading entries of array_dev_ known to be uploaded,
+    // to skip uploading unchanged batch arrays
+    std::vector< std::vector< std::vector< scalar_t* > > > array_uploaded_;
+
+    // host and device dimension arrays for variable-size batches
+    std::vector< std::vector< int64_t* > > dims_host_;
+    std::vector< std::vector< int64_t* > > dims_dev_;
+
+    //--------------------------------------------------------------------------
+    /// Device tile cache, with instances in least-recently-used order.
+    struct TileCache {
+        std::list< ij_tuple > lru;  ///< front is least recently used
+        std::map< ij_tuple, typename std::list< ij_tuple >::iterator > position;
+        std::map< ij_tuple, int64_t > pins;  ///< tiles in use by kernels
+        TileCacheStats stats;
+    };
+
+    /// contiguous host memory holding local origin tiles, from allocArena
+    scalar_t* arena_ = nullptr;
+    int64_t arena_size_ = 0;  ///< in elements
+    int64_t arena_lld_ = 0;
+    bool arena_pinned_ = false;
+
+    /// files holding FileMapped origin tiles
+    std::vector< std::unique_ptr< MappedFile > > mapped_files_;
+
+    /// max number of tiles per device if caching; 0 if not caching
+    int64_t cache_tiles_;
+    std::vector< TileCache > tile_cache_;  ///< tile cache per device
+
+    /// coherence counts, indexed by CoherenceEvent
+    std::atomic<int64_t> coherence_counts_[ int( CoherenceEvent::NumEvents ) ] {};
+    mutable omp_nest_lock_t cache_lock_;   ///< tile_cache_ lock
+
+    /// Structurally zero tiles, on all ranks, including remote tiles,
+    /// so all ranks agree on which tiles are skipped.
+    bool track_zero_tiles_ = false;
+    std::set< ij_tuple > zero_tiles_;
+    mutable omp_nest_lock_t zero_lock_;    ///< zero_tiles_ lock
+
+    /// Local tiles that are logically zero but not yet allocated, with the
+    /// device of their origin; also under zero_lock_.
+    /// @see BaseMatrix::tileMaterialize
+    std::map< ij_tuple, int > lazy_zero_tiles_;
+    std::atomic<int64_t> num_lazy_zero_ { 0 };
+
+    /// Copy-on-write: local tiles whose origin instance still points to the
+    /// data of another matrix's tile, with the device of that instance.
+    std::map< ij_tuple, int > cow_shared_;
+    /// Copy-on-write: snapshots sharing the data of local tiles, with the
+    /// tile index in the snapshot.
+    std::multimap< ij_tuple,
+                   std::pair< std::weak_ptr< MatrixStorage >, ij_tuple > >
+        cow_snapshots_;
+    std::atomic<int64_t> num_cow_ { 0 };
+    mutable omp_nest_lock_t cow_lock_;     ///< cow_shared_, cow_snapshots_ lock
+
+    /// Band of the matrix, in stored (not transposed) coordinates, with
+    /// the first row of each block row and column, for compact transfers
+    /// of the band part of tiles. @see tileBandBox
+    /// Workspace session, @see BaseMatrix::beginWorkspaceSession.
+    /// session_holders_ has, for each tile, the ranks holding a valid copy,
+    /// identical on all ranks; session_pending_ has holders of broadcasts
+    /// since the last serial point, not yet used to skip broadcasts, since
+    /// concurrent broadcasts of a tile may be recorded in different orders
+    /// on different ranks. session_held_ has the tile instances this rank
+    /// holds, to release when the session ends.
+    int session_depth_ = 0;
+    std::map< ij_tuple, std::set<int> > session_holders_;
+    std::map< ij_tuple, std::set<int> > session_pending_;
+    std::set< ijdev_tuple > session_held_;
+    mutable omp_nest_lock_t session_lock_;  ///< session lock
+
+    /// Local block rows of each block column on each device, for
+    /// tileLocalRows; extent is the number of block rows walked.
+    struct LocalRows {
+        int64_t extent = 0;
+        std::vector<int64_t> rows;
+    };
+    std::map< std::pair<int, int64_t>, LocalRows > local_rows_;
+    mutable omp_nest_lock_t local_rows_lock_;  ///< local_rows_ lock
+
+    /// RMA window exposing local host tiles, @see BaseMatrix::rmaOpen.
+    /// rma_tiles_ has the address of every tile exposed, on all ranks.
+    /// It is written only by the collective rmaOpen and rmaClose.
+    MPI_Win rma_win_ = MPI_WIN_NULL;
+    std::vector< void* > rma_attached_;
+    std::map< ij_tuple, RmaTile > rma_tiles_;
+
+    bool band_compact_ = false;
+    int64_t band_kl_ = 0;
+    int64_t band_ku_ = 0;
+    std::vector< int64_t > band_row0_;
+    std::vector< int64_t > band_col0_;
+
+    Compression compression_ = Compression::None;
+    double compression_tol_ = 0;
 };
 
 //------------------------------------------------------------------------------
@@ -479,7 +1059,7 @@ template <typename scalar_t>
 MatrixStorage<scalar_t>::MatrixStorage(
     int64_t m, int64_t n, int64_t mb, int64_t nb,
     GridOrder order, int p, int q, MPI_Comm mpi_comm)
-    : tiles_(),
+    : shards_(),
       memory_(sizeof(scalar_t) * mb * nb),  // block size in bytes
       batch_array_size_(0)
 {
@@ -512,6 +1092,14 @@ MatrixStorage<scalar_t>::MatrixStorage(
 
     initQueues();
     omp_init_nest_lock(&lock_);
+
+    cache_tiles_ = 0;
+    tile_cache_.resize( num_devices() );
+    omp_init_nest_lock( &cache_lock_ );
+    omp_init_nest_lock( &zero_lock_ );
+    omp_init_nest_lock( &cow_lock_ );
+    omp_init_nest_lock( &session_lock_ );
+    omp_init_nest_lock( &local_rows_lock_ );
 }
 
 //------------------------------------------------------------------------------
@@ -528,7 +1116,7 @@ MatrixStorage<scalar_t>::MatrixStorage(
       tileNb(inTileNb),
       tileRank(inTileRank),
       tileDevice(inTileDevice),
-      tiles_(),
+      shards_(),
       memory_(sizeof(scalar_t) * func::max_blocksize(mt, inTileMb) // block size in bytes
                                * func::max_blocksize(nt, inTileNb)),
       batch_array_size_(0)
@@ -538,6 +1126,14 @@ MatrixStorage<scalar_t>::MatrixStorage(
 
     initQueues();
     omp_init_nest_lock(&lock_);
+
+    cache_tiles_ = 0;
+    tile_cache_.resize( num_devices() );
+    omp_init_nest_lock( &cache_lock_ );
+    omp_init_nest_lock( &zero_lock_ );
+    omp_init_nest_lock( &cow_lock_ );
+    omp_init_nest_lock( &session_lock_ );
+    omp_init_nest_lock( &local_rows_lock_ );
 }
 
 //------------------------------------------------------------------------------
@@ -549,14 +1145,20 @@ MatrixStorage<scalar_t>::~MatrixStorage()
     try {
         clear();
         clearBatchArrays();
+        freeArena();  // must occur before destroyQueues
         // Clear all host and device memory allocations
-        memory_.clearHostBlocks();
+        memory_.clearHostBlocks( host_queue() );
         for (int device = 0; device < num_devices(); ++device) {
             blas::Queue* queue = comm_queues_[device];
             memory_.clearDeviceBlocks(device, queue);
         }
         destroyQueues(); // must occur after clearBatchArrays
         omp_destroy_nest_lock(&lock_);
+        omp_destroy_nest_lock( &cache_lock_ );
+        omp_destroy_nest_lock( &zero_lock_ );
+        omp_destroy_nest_lock( &cow_lock_ );
+        omp_destroy_nest_lock( &session_lock_ );
+        omp_destroy_nest_lock( &local_rows_lock_ );
     }
     catch (std::exception const& ex) {
         // If debugging, die on exceptions.
@@ -567,26 +1169,40 @@ MatrixStorage<scalar_t>::~MatrixStorage()
 
 //------------------------------------------------------------------------------
 /// Initializes BLAS++ compute and communication queues on each device.
-/// Also initializes the host and device batch arrays.
+/// Also initializes the host and device batch arrays, and enables peer
+/// access between devices (once per process).
 /// Called in constructor.
 ///
 template <typename scalar_t>
 void MatrixStorage<scalar_t>::initQueues()
 {
+    internal::peer_init();
+
     comm_queues_.resize(num_devices());
+    staging_queues_.assign( num_devices(), {} );
 
     compute_queues_.resize(1);
     compute_queues_.at(0).resize(num_devices(), nullptr);
+    compute_queue_high_.assign( 1, false );
+    compute_queue_precision_.assign( 1, ComputePrecision::Native );
     for (int device = 0; device < num_devices(); ++device) {
         comm_queues_        [ device ] = new lapack::Queue( device );
-        compute_queues_[ 0 ][ device ] = new lapack::Queue( device );
+        compute_queues_[ 0 ][ device ] = internal::new_queue( device, false );
+        trace::Trace::nameQueue( comm_queues_[ device ], "comm" );
+        trace::Trace::nameQueue( compute_queues_[ 0 ][ device ], "compute 0" );
     }
 
     array_host_.resize(1);
     array_dev_ .resize(1);
+    array_uploaded_.resize(1);
+    dims_host_ .resize(1);
+    dims_dev_  .resize(1);
 
     array_host_.at(0).resize(num_devices(), nullptr);
     array_dev_ .at(0).resize(num_devices(), nullptr);
+    array_uploaded_.at(0).resize(num_devices());
+    dims_host_ .at(0).resize(num_devices(), nullptr);
+    dims_dev_  .at(0).resize(num_devices(), nullptr);
 }
 
 //------------------------------------------------------------------------------
@@ -598,16 +1214,45 @@ void MatrixStorage<scalar_t>::destroyQueues()
 {
     int num_queues = int(compute_queues_.size());
     for (int device = 0; device < num_devices(); ++device) {
+        trace::Trace::unnameQueue( comm_queues_[device] );
         delete comm_queues_[device];
                comm_queues_[device] = nullptr;
 
+        for (auto& queue : staging_queues_[device]) {
+            delete queue;
+            queue = nullptr;
+        }
+
         for (int queue = 0; queue < num_queues; ++queue) {
-            delete compute_queues_.at(queue)[device];
+            trace::Trace::unnameQueue( compute_queues_.at(queue)[device] );
+            internal::delete_queue( compute_queues_.at(queue)[device] );
                    compute_queues_.at(queue)[device] = nullptr;
         }
     }
 }
 
+//------------------------------------------------------------------------------
+/// @return BLAS++ queue of a host staging slot of device, created on first
+/// use. Each slot has its own queue, so the copy into one slot can be waited
+/// for while the copy into the next slot proceeds.
+/// @see BaseMatrix::listBcast
+///
+/// @param[in] device
+///     Device ID.
+///
+/// @param[in] slot
+///     Staging slot. 0 <= slot < num_staging_slots.
+///
+template <typename scalar_t>
+lapack::Queue* MatrixStorage<scalar_t>::staging_queue( int device, int slot )
+{
+    LockGuard guard( &lock_ );
+    lapack::Queue*& queue = staging_queues_.at( device ).at( slot );
+    if (queue == nullptr)
+        queue = new lapack::Queue( device );
+    return queue;
+}
+
 //------------------------------------------------------------------------------
 /// Allocates batch arrays and BLAS++ queues for all devices.
 /// If arrays are already allocated, frees and reallocates the arrays only if
@@ -640,11 +1285,20 @@ void MatrixStorage<scalar_t>::allocateBatchArrays(
 
         array_host_    .resize(num_arrays);
         array_dev_     .resize(num_arrays);
+        array_uploaded_.resize(num_arrays);
+        dims_host_     .resize(num_arrays);
+        dims_dev_      .resize(num_arrays);
         compute_queues_.resize(num_arrays);
+        compute_queue_high_.resize( num_arrays, false );
+        if (int64_t( compute_queue_precision_.size() ) < num_arrays)
+            compute_queue_precision_.resize( num_arrays, ComputePrecision::Native );
 
         for (int64_t i = i_begin; i < num_arrays; ++i) {
             array_host_    .at(i).resize(num_devices(), nullptr);
             array_dev_     .at(i).resize(num_devices(), nullptr);
+            array_uploaded_.at(i).resize(num_devices());
+            dims_host_     .at(i).resize(num_devices(), nullptr);
+            dims_dev_      .at(i).resize(num_devices(), nullptr);
             compute_queues_.at(i).resize(num_devices(), nullptr);
         }
         is_resized = true;
@@ -670,14 +1324,46 @@ void MatrixStorage<scalar_t>::allocateBatchArrays(
                 blas::Queue* queue = comm_queues_[device];
 
                 // Free host arrays.
+                if (array_host_[i][device] != nullptr) {
+                    memory_.removeExternal(
+                        HostNum, sizeof(scalar_t*) * batch_array_size_*3 );
+                }
                 blas::host_free_pinned(array_host_[i][device], *queue);
 
                 // Free device arrays.
+                if (array_dev_[i][device] != nullptr) {
+                    memory_.removeExternal(
+                        device, sizeof(scalar_t*) * batch_array_size_*3 );
+                }
                 blas::device_free(array_dev_[i][device], *queue);
+                array_uploaded_[i][device].clear();
+
+                // Free dimension arrays.
+                if (dims_host_[i][device] != nullptr) {
+                    memory_.removeExternal(
+                        HostNum, sizeof(int64_t) * batch_array_size_
+                                                 * batch_dims_per_tile );
+                    memory_.removeExternal(
+                        device, sizeof(int64_t) * batch_array_size_
+                                                * batch_dims_per_tile );
+                }
+                blas::host_free_pinned(dims_host_[i][device], *queue);
+                blas::device_free(dims_dev_[i][device], *queue);
 
                 if (compute_queues_[ i ][ device ] == nullptr) {
                     // Allocate queues.
-                    compute_queues_[ i ][ device ] = new lapack::Queue( device );
+                    compute_queues_[ i ][ device ]
+                        = internal::new_queue( device, compute_queue_high_[ i ] );
+                    trace::Trace::nameQueue( compute_queues_[ i ][ device ],
+                                             "compute " + std::to_string( i )
+                                             + (compute_queue_high_[ i ]
+                                                ? " high" : "") );
+                    if (compute_queue_precision_[ i ]
+                        != ComputePrecision::Native) {
+                        internal::set_compute_precision(
+                            compute_queues_[ i ][ device ],
+                            compute_queue_precision_[ i ] );
+                    }
                 }
 
                 // Allocate host arrays;
@@ -688,6 +1374,19 @@ void MatrixStorage<scalar_t>::allocateBatchArrays(
                 array_dev_[i][device]
                     = blas::device_malloc<scalar_t*>(batch_size*3, *queue);
 
+                // Allocate dimension arrays.
+                int64_t dims_size = batch_size * batch_dims_per_tile;
+                dims_host_[i][device]
+                    = blas::host_malloc_pinned<int64_t>(dims_size, *queue);
+                dims_dev_[i][device]
+                    = blas::device_malloc<int64_t>(dims_size, *queue);
+
+                // Account for both in memory statistics.
+                memory_.addExternal( HostNum, sizeof(scalar_t*) * batch_size*3 );
+                memory_.addExternal( device,  sizeof(scalar_t*) * batch_size*3 );
+                memory_.addExternal( HostNum, sizeof(int64_t) * dims_size );
+                memory_.addExternal( device,  sizeof(int64_t) * dims_size );
+
             }
         }
 
@@ -695,6 +1394,47 @@ void MatrixStorage<scalar_t>::allocateBatchArrays(
     }
 }
 
+//------------------------------------------------------------------------------
+/// Copies count pointers from src on host to the device batch array,
+/// starting at entry offset, on the given queue.
+/// Skips the copy if the device array already holds exactly those pointers
+/// from an earlier upload, e.g., when the same tiles of the same matrix are
+/// launched again, so repeated calls on small matrices avoid re-uploading.
+/// All writes to device batch arrays must go through this, so the record of
+/// their contents stays accurate; earlier uploads on other queues must have
+/// completed, as they do when call sites sync before returning.
+///
+/// @return true if the copy was queued, false if it was skipped.
+///
+template <typename scalar_t>
+bool MatrixStorage<scalar_t>::batchArrayUpload(
+    int device, int64_t batch_arrays_index,
+    scalar_t* const* src, int64_t count, blas::Queue& queue,
+    int64_t offset )
+{
+    assert( offset >= 0 && count >= 0 );
+    assert( offset + count <= batch_array_size_*3 );
+
+    auto& uploaded = array_uploaded_.at( batch_arrays_index ).at( device );
+    int64_t end = offset + count;
+    if (end <= int64_t( uploaded.size() )
+        && std::equal( src, src + count, uploaded.begin() + offset )) {
+        return false;
+    }
+
+    blas::device_memcpy<scalar_t*>(
+        array_dev_[ batch_arrays_index ][ device ] + offset, src, count, queue );
+
+    // Entries beyond a gap would be unknown, so only extend the record
+    // when it is contiguous.
+    if (offset <= int64_t( uploaded.size() )) {
+        if (end > int64_t( uploaded.size() ))
+            uploaded.resize( end );
+        std::copy( src, src + count, uploaded.begin() + offset );
+    }
+    return true;
+}
+
 //------------------------------------------------------------------------------
 /// Frees device batch arrays that were allocated by allocateBatchArrays().
 ///
@@ -715,26 +1455,130 @@ void MatrixStorage<scalar_t>::clearBatchArrays()
             if (array_host_[i][device] != nullptr) {
                 blas::host_free_pinned(array_host_[i][device], *queue);
                 array_host_[i][device] = nullptr;
+                memory_.removeExternal(
+                    HostNum, sizeof(scalar_t*) * batch_array_size_*3 );
             }
 
             // Free device arrays.
             if (array_dev_[i][device] != nullptr) {
                 blas::device_free(array_dev_[i][device], *queue);
                 array_dev_[i][device] = nullptr;
+                array_uploaded_[i][device].clear();
+                memory_.removeExternal(
+                    device, sizeof(scalar_t*) * batch_array_size_*3 );
+            }
+
+            // Free dimension arrays.
+            if (dims_host_[i][device] != nullptr) {
+                blas::host_free_pinned(dims_host_[i][device], *queue);
+                dims_host_[i][device] = nullptr;
+                memory_.removeExternal(
+                    HostNum, sizeof(int64_t) * batch_array_size_
+                                             * batch_dims_per_tile );
+            }
+            if (dims_dev_[i][device] != nullptr) {
+                blas::device_free(dims_dev_[i][device], *queue);
+                dims_dev_[i][device] = nullptr;
+                memory_.removeExternal(
+                    device, sizeof(int64_t) * batch_array_size_
+                                            * batch_dims_per_tile );
             }
         }
     }
     batch_array_size_ = 0;
 }
 
+//------------------------------------------------------------------------------
+/// Sets the stream priority of the compute queues with queue_index on all
+/// devices, recreating them if their priority changes. Drivers put the
+/// panel and lookahead queues at high priority, so their kernels preempt the
+/// trailing update's. Call only when no tasks use the queues, e.g., before
+/// the task graph of a driver.
+///
+/// @param[in] queue_index
+///     Index of the set of queues, < num_compute_queues().
+///
+/// @param[in] high_priority
+///     Whether the queues have the device's highest stream priority;
+///     otherwise they have the default priority.
+///
+template <typename scalar_t>
+void MatrixStorage<scalar_t>::setComputeQueuePriority(
+    int queue_index, bool high_priority )
+{
+    assert( queue_index >= 0 && queue_index < num_compute_queues() );
+    if (compute_queue_high_[ queue_index ] == high_priority)
+        return;
+
+    std::string name = "compute " + std::to_string( queue_index );
+    if (high_priority)
+        name += " high";
+
+    for (int device = 0; device < num_devices(); ++device) {
+        lapack::Queue*& queue = compute_queues_[ queue_index ][ device ];
+        if (queue != nullptr) {
+            queue->sync();
+            trace::Trace::unnameQueue( queue );
+            internal::delete_queue( queue );
+            queue = internal::new_queue( device, high_priority );
+            trace::Trace::nameQueue( queue, name );
+            if (compute_queue_precision_[ queue_index ]
+                != ComputePrecision::Native) {
+                internal::set_compute_precision(
+                    queue, compute_queue_precision_[ queue_index ] );
+            }
+        }
+    }
+    compute_queue_high_[ queue_index ] = high_priority;
+}
+
+//------------------------------------------------------------------------------
+/// Sets the compute mode of the BLAS handles of the compute queues with
+/// queue_index on all devices, e.g., so single precision gemm on them
+/// uses TF32 tensor cores. Call only when no tasks use the queues.
+/// Host tasks given queue_index read the mode with computeQueuePrecision,
+/// e.g., for ComputePrecision::Complex3M, so it is kept also for indices
+/// without device queues.
+///
+/// @param[in] queue_index
+///     Index of the set of queues, >= 0.
+///
+/// @param[in] precision
+///     Compute mode of the queues.
+///
+template <typename scalar_t>
+void MatrixStorage<scalar_t>::setComputeQueuePrecision(
+    int queue_index, ComputePrecision precision )
+{
+    assert( queue_index >= 0 );
+    if (queue_index >= int( compute_queue_precision_.size() )) {
+        compute_queue_precision_.resize(
+            queue_index + 1, ComputePrecision::Native );
+    }
+    if (compute_queue_precision_[ queue_index ] == precision)
+        return;
+
+    for (int device = 0; queue_index < num_compute_queues()
+                         && device < num_devices(); ++device) {
+        lapack::Queue* queue = compute_queues_[ queue_index ][ device ];
+        if (queue != nullptr) {
+            queue->sync();
+            internal::set_compute_precision( queue, precision );
+        }
+    }
+    compute_queue_precision_[ queue_index ] = precision;
+}
+
 //------------------------------------------------------------------------------
 /// Reserves num_tiles on host in allocator.
+/// If there are devices, the host blocks are pinned, so transfers between
+/// host workspace tiles and devices on the comm_queue are asynchronous.
 template <typename scalar_t>
 void MatrixStorage<scalar_t>::reserveHostWorkspace(int64_t num_tiles)
 {
     int64_t n = num_tiles - memory_.capacity( HostNum );
     if (n > 0) {
-        memory_.addHostBlocks(n);
+        memory_.addHostBlocks( n, host_queue() );
         // Usually now capacity == num_tiles, but if multiple
         // threads reserve memory, capacity >= num_tiles.
     }
@@ -756,12 +1600,33 @@ void MatrixStorage<scalar_t>::reserveDeviceWorkspace(int64_t num_tiles)
     }
 }
 
+//------------------------------------------------------------------------------
+/// Reserves num_tiles[ device ] on each device in allocator, for
+/// distributions that put more tiles on some devices than on others.
+template <typename scalar_t>
+void MatrixStorage<scalar_t>::reserveDeviceWorkspace(
+    std::vector<int64_t> const& num_tiles)
+{
+    assert( int( num_tiles.size() ) == num_devices() );
+    for (int device = 0; device < num_devices(); ++device) {
+        int64_t n = num_tiles[ device ] - memory_.capacity( device );
+        if (n > 0) {
+            blas::Queue* queue = comm_queues_[ device ];
+            memory_.addDeviceBlocks( device, n, queue );
+        }
+    }
+}
+
 //------------------------------------------------------------------------------
 /// Ensures there is unoccupied workspace for num_tiles on device in allocator.
 template <typename scalar_t>
 void MatrixStorage<scalar_t>::ensureDeviceWorkspace(int device, int64_t num_tiles)
 {
     slate_assert( device != HostNum );
+    if (tileCacheEnabled()) {
+        tileCacheReserve( device, num_tiles );
+        return;
+    }
     int64_t n = num_tiles - memory_.available( device );
     if (n > 0) {
         blas::Queue* queue = comm_queues_[ device ];
@@ -769,6 +1634,721 @@ void MatrixStorage<scalar_t>::ensureDeviceWorkspace(int device, int64_t num_tile
     }
 }
 
+//------------------------------------------------------------------------------
+/// Uses device memory as a cache of tiles, holding at most about num_tiles
+/// tiles per device. When the device pool is full, tileInsert evicts the
+/// least-recently-used workspace instance that is not OnHold, and whose
+/// tile node is not locked by another thread. If the evicted instance is
+/// Modified, or is the last valid instance, it is first written back to host.
+/// This lets routines run with Target::Devices on matrices larger than
+/// device memory. If every instance on a device is OnHold, the pool grows
+/// beyond num_tiles.
+///
+/// Tiles in use by device kernels must not be evicted: internal routines
+/// pin their operands with tileCachePin before getting them on the device,
+/// and unpin them after their queue syncs. Before writing back or freeing
+/// an instance, eviction also syncs the device's compute queues, so no
+/// kernel enqueued earlier still reads or writes it.
+/// Cached instances are tracked by tileCacheAccess, which
+/// BaseMatrix::tileGet calls.
+///
+/// @param[in] num_tiles
+///     Max number of tiles per device. num_tiles >= 1.
+///
+template <typename scalar_t>
+void MatrixStorage<scalar_t>::enableTileCache(int64_t num_tiles)
+{
+    slate_assert( num_tiles >= 1 );
+    LockGuard guard( &cache_lock_ );
+    cache_tiles_ = num_tiles;
+}
+
+//------------------------------------------------------------------------------
+/// Stops evicting device tiles; the device pool again grows as needed.
+/// Keeps the counters.
+template <typename scalar_t>
+void MatrixStorage<scalar_t>::disableTileCache()
+{
+    LockGuard guard( &cache_lock_ );
+    cache_tiles_ = 0;
+    for (auto& cache : tile_cache_) {
+        cache.lru.clear();
+        cache.position.clear();
+        cache.pins.clear();
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Records an access to tile {i, j} on device, marking it most recently used.
+/// No-op for host or if the cache is not enabled.
+///
+/// @param[in] ijdev
+///     Tile's indices and device.
+///
+/// @param[in] hit
+///     Whether a valid instance already existed on the device.
+///
+template <typename scalar_t>
+void MatrixStorage<scalar_t>::tileCacheAccess(ijdev_tuple ijdev, bool hit)
+{
+    int device = std::get<2>( ijdev );
+    if (device == HostNum || ! tileCacheEnabled())
+        return;
+
+    ij_tuple ij = { std::get<0>( ijdev ), std::get<1>( ijdev ) };
+    LockGuard guard( &cache_lock_ );
+    auto& cache = tile_cache_[ device ];
+    if (hit)
+        ++cache.stats.hits;
+    else
+        ++cache.stats.misses;
+
+    auto iter = cache.position.find( ij );
+    if (iter != cache.position.end()) {
+        cache.lru.splice( cache.lru.end(), cache.lru, iter->second );
+    }
+    else {
+        cache.position[ ij ] = cache.lru.insert( cache.lru.end(), ij );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Pins tile {i, j} on device, so it isn't evicted while kernels use it.
+/// Pins are counted, so concurrent tasks can pin the same tile; the tile
+/// need not exist yet. Call before getting the tile on the device.
+/// No-op for host or if the cache is not enabled.
+///
+template <typename scalar_t>
+void MatrixStorage<scalar_t>::tileCachePin(ij_tuple ij, int device)
+{
+    if (device == HostNum || ! tileCacheEnabled())
+        return;
+
+    LockGuard guard( &cache_lock_ );
+    ++tile_cache_[ device ].pins[ ij ];
+}
+
+//------------------------------------------------------------------------------
+/// Releases a pin on tile {i, j} on device from tileCachePin.
+/// Call after the kernels using the tile have finished.
+///
+template <typename scalar_t>
+void MatrixStorage<scalar_t>::tileCacheUnpin(ij_tuple ij, int device)
+{
+    if (device == HostNum || ! tileCacheEnabled())
+        return;
+
+    LockGuard guard( &cache_lock_ );
+    auto& pins = tile_cache_[ device ].pins;
+    auto iter = pins.find( ij );
+    if (iter != pins.end() && --iter->second <= 0)
+        pins.erase( iter );
+}
+
+//------------------------------------------------------------------------------
+/// @return tile cache counters for device.
+template <typename scalar_t>
+TileCacheStats MatrixStorage<scalar_t>::tileCacheStats(int device)
+{
+    LockGuard guard( &cache_lock_ );
+    return tile_cache_.at( device ).stats;
+}
+
+//------------------------------------------------------------------------------
+/// Resets tile cache counters on all devices.
+template <typename scalar_t>
+void MatrixStorage<scalar_t>::tileCacheResetStats()
+{
+    LockGuard guard( &cache_lock_ );
+    for (auto& cache : tile_cache_)
+        cache.stats = TileCacheStats();
+}
+
+//------------------------------------------------------------------------------
+/// @return MOSI coherence counters of all tiles, summed over devices.
+/// All zero unless SLATE is compiled with SLATE_COHERENCE_COUNTERS.
+template <typename scalar_t>
+CoherenceStats MatrixStorage<scalar_t>::coherenceStats() const
+{
+    auto get = [this]( CoherenceEvent event ) {
+        return coherence_counts_[ int( event ) ].load( std::memory_order_relaxed );
+    };
+    CoherenceStats stats;
+    stats.hits               = get( CoherenceEvent::Hit );
+    stats.to_device          = get( CoherenceEvent::ToDevice );
+    stats.to_host            = get( CoherenceEvent::ToHost );
+    stats.layout_conversions = get( CoherenceEvent::LayoutConversion );
+    stats.invalidations      = get( CoherenceEvent::Invalidation );
+    return stats;
+}
+
+//------------------------------------------------------------------------------
+/// Resets MOSI coherence counters.
+template <typename scalar_t>
+void MatrixStorage<scalar_t>::coherenceResetStats()
+{
+    for (auto& count : coherence_counts_)
+        count.store( 0, std::memory_order_relaxed );
+}
+
+//------------------------------------------------------------------------------
+/// Enables or disables tracking of structurally zero tiles.
+/// Disabling forgets which tiles are zero.
+/// @see BaseMatrix::trackZeroTiles
+///
+template <typename scalar_t>
+void MatrixStorage<scalar_t>::trackZeroTiles(bool track)
+{
+    LockGuard guard( &zero_lock_ );
+    track_zero_tiles_ = track;
+    if (! track)
+        zero_tiles_.clear();
+}
+
+//------------------------------------------------------------------------------
+/// @return whether tile {i, j} is marked as structurally zero.
+/// False if zero tiles are not tracked.
+///
+template <typename scalar_t>
+bool MatrixStorage<scalar_t>::tileIsZero(ij_tuple ij)
+{
+    if (! track_zero_tiles_)
+        return false;
+
+    LockGuard guard( &zero_lock_ );
+    return zero_tiles_.count( ij ) > 0;
+}
+
+//------------------------------------------------------------------------------
+/// Records local tile {i, j} as a lazy zero tile, with its origin to be
+/// allocated on device when first accessed. The tile must not exist.
+/// @see BaseMatrix::tileMaterialize
+///
+template <typename scalar_t>
+void MatrixStorage<scalar_t>::tileInsertLazyZero(ij_tuple ij, int device)
+{
+    slate_assert( HostNum <= device && device < num_devices() );
+    slate_assert( find( ij ) == nullptr );
+
+    LockGuard guard( &zero_lock_ );
+    if (lazy_zero_tiles_.insert( { ij, device } ).second)
+        num_lazy_zero_.fetch_add( 1, std::memory_order_release );
+}
+
+//------------------------------------------------------------------------------
+/// @return whether tile {i, j} is a lazy zero tile, not yet allocated.
+///
+template <typename scalar_t>
+bool MatrixStorage<scalar_t>::tileIsLazyZero(ij_tuple ij)
+{
+    if (! hasLazyZeroTiles())
+        return false;
+
+    LockGuard guard( &zero_lock_ );
+    return lazy_zero_tiles_.count( ij ) > 0;
+}
+
+//------------------------------------------------------------------------------
+/// If tile {i, j} is a lazy zero tile, inserts its origin tile, in layout,
+/// on the device recorded for it and calls fill on it, e.g., to set it to
+/// zero. Other threads see the tile only after fill returns.
+/// @return true if the tile was materialized.
+///
+template <typename scalar_t>
+bool MatrixStorage<scalar_t>::tileMaterialize(
+    ij_tuple ij, Layout layout,
+    std::function< void (Tile<scalar_t>*) > const& fill)
+{
+    LockGuard guard( &zero_lock_ );
+    auto iter = lazy_zero_tiles_.find( ij );
+    if (iter == lazy_zero_tiles_.end())
+        return false;
+
+    int device = iter->second;
+    Tile<scalar_t>* tile = tileInsert(
+        { std::get<0>( ij ), std::get<1>( ij ), device },
+        TileKind::SlateOwned, layout );
+    if (fill)
+        fill( tile );
+
+    lazy_zero_tiles_.erase( iter );
+    num_lazy_zero_.fetch_sub( 1, std::memory_order_release );
+    return true;
+}
+
+//------------------------------------------------------------------------------
+/// Records that the origin instance of local tile {i, j}, on device, points
+/// to the data of another matrix's tile, so it has to be copied before
+/// either is written. @see BaseMatrix::tileGet, tileCowDetach
+///
+template <typename scalar_t>
+void MatrixStorage<scalar_t>::tileShareCow(ij_tuple ij, int device)
+{
+    LockGuard guard( &cow_lock_ );
+    if (cow_shared_.insert( { ij, device } ).second)
+        num_cow_.fetch_add( 1, std::memory_order_release );
+}
+
+//------------------------------------------------------------------------------
+/// Records that tile snapshot_ij of snapshot shares the data of local
+/// tile {i, j}, so the snapshot is detached before tile {i, j} is written.
+///
+template <typename scalar_t>
+void MatrixStorage<scalar_t>::tileAddCowSnapshot(
+    ij_tuple ij, std::weak_ptr< MatrixStorage > snapshot, ij_tuple snapshot_ij)
+{
+    LockGuard guard( &cow_lock_ );
+    cow_snapshots_.insert( { ij, { snapshot, snapshot_ij } } );
+    num_cow_.fetch_add( 1, std::memory_order_release );
+}
+
+//------------------------------------------------------------------------------
+/// @return whether local tile {i, j} still shares the data of another
+/// matrix's tile.
+///
+template <typename scalar_t>
+bool MatrixStorage<scalar_t>::tileIsCowShared(ij_tuple ij)
+{
+    if (! hasCowTiles())
+        return false;
+
+    LockGuard guard( &cow_lock_ );
+    return cow_shared_.count( ij ) > 0;
+}
+
+//------------------------------------------------------------------------------
+/// Called before local tile {i, j} is written or its origin is freed.
+/// Snapshots sharing its data copy it first, then, if the tile itself
+/// shares another matrix's data, its origin instance gets its own copy,
+/// allocated by SLATE. This keeps the Tile object, so pointers to it stay
+/// valid. Does nothing for tiles that are not shared.
+///
+/// Holds only cow_lock_, locking snapshots' cow_lock_ in turn, never a
+/// TileNode lock; callers may hold the TileNode lock.
+///
+template <typename scalar_t>
+void MatrixStorage<scalar_t>::tileCowDetach(ij_tuple ij)
+{
+    if (! hasCowTiles())
+        return;
+
+    LockGuard guard( &cow_lock_ );
+
+    auto range = cow_snapshots_.equal_range( ij );
+    for (auto iter = range.first; iter != range.second; ++iter) {
+        auto snapshot = iter->second.first.lock();
+        if (snapshot)
+            snapshot->tileCowDetach( iter->second.second );
+        num_cow_.fetch_sub( 1, std::memory_order_release );
+    }
+    cow_snapshots_.erase( range.first, range.second );
+
+    auto iter = cow_shared_.find( ij );
+    if (iter == cow_shared_.end())
+        return;
+
+    int device = iter->second;
+    Tile<scalar_t>* tile = at( { std::get<0>( ij ), std::get<1>( ij ), device } );
+    slate_assert( tile != nullptr && ! tile->extended() );
+
+    // Stored dimensions.
+    int64_t mb = tile->layout() == Layout::ColMajor ? tile->mb() : tile->nb();
+    int64_t nb = tile->layout() == Layout::ColMajor ? tile->nb() : tile->mb();
+    blas::Queue* queue = (device == HostNum) ? nullptr : comm_queues_[ device ];
+    scalar_t* data = (scalar_t*) memory_.alloc(
+        device, sizeof(scalar_t) * mb * nb, queue );
+    if (device == HostNum) {
+        lapack::lacpy( lapack::MatrixType::General, mb, nb,
+                       tile->data(), tile->stride(), data, mb );
+    }
+    else {
+        blas::device_copy_matrix( mb, nb, tile->data(), tile->stride(),
+                                  data, mb, *queue );
+        queue->sync();
+    }
+    tile->data_ = data;
+    tile->user_data_ = data;
+    tile->stride_ = mb;
+    tile->user_stride_ = mb;
+    tile->kind_ = TileKind::SlateOwned;
+
+    cow_shared_.erase( iter );
+    num_cow_.fetch_sub( 1, std::memory_order_release );
+}
+
+//------------------------------------------------------------------------------
+/// Detaches all snapshots sharing local tiles, before the tiles are freed,
+/// and forgets tiles shared with other matrices, without copying them.
+/// Called by clear().
+///
+template <typename scalar_t>
+void MatrixStorage<scalar_t>::cowDetachAll()
+{
+    if (! hasCowTiles())
+        return;
+
+    LockGuard guard( &cow_lock_ );
+    for (auto& entry : cow_snapshots_) {
+        auto snapshot = entry.second.first.lock();
+        if (snapshot)
+            snapshot->tileCowDetach( entry.second.second );
+    }
+    cow_snapshots_.clear();
+    cow_shared_.clear();
+    num_cow_.store( 0, std::memory_order_release );
+}
+
+//------------------------------------------------------------------------------
+/// Opens a workspace session, or nests in the open one.
+/// @see BaseMatrix::beginWorkspaceSession
+///
+template <typename scalar_t>
+void MatrixStorage<scalar_t>::sessionBegin()
+{
+    LockGuard guard( &session_lock_ );
+    ++session_depth_;
+}
+
+//------------------------------------------------------------------------------
+/// Closes a workspace session. Closing the outermost one releases the
+/// tiles it holds.
+/// @see BaseMatrix::endWorkspaceSession
+///
+template <typename scalar_t>
+void MatrixStorage<scalar_t>::sessionEnd()
+{
+    bool outermost;
+    {
+        LockGuard guard( &session_lock_ );
+        assert( session_depth_ > 0 );
+        outermost = --session_depth_ == 0;
+    }
+    if (outermost)
+        sessionClear();
+}
+
+//------------------------------------------------------------------------------
+/// Forgets which ranks hold which tiles, and unholds and releases the
+/// tiles this rank holds. The session, if open, stays open.
+/// Must be called on all ranks in the same order with respect to
+/// broadcasts, e.g., outside parallel regions.
+///
+template <typename scalar_t>
+void MatrixStorage<scalar_t>::sessionClear()
+{
+    std::set< ijdev_tuple > held;
+    {
+        LockGuard guard( &session_lock_ );
+        held.swap( session_held_ );
+        sessionForget();
+    }
+    for (auto& ijdev : held) {
+        tileUnsetHold( ijdev );
+        release( ijdev );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Makes the holders of broadcasts since the last serial point usable to
+/// skip later broadcasts. Called at serial points, i.e., outside parallel
+/// regions, which all ranks reach in the same order with respect to
+/// broadcasts.
+///
+template <typename scalar_t>
+void MatrixStorage<scalar_t>::sessionCommit()
+{
+    LockGuard guard( &session_lock_ );
+    for (auto& entry : session_pending_)
+        session_holders_[ entry.first ].insert( entry.second.begin(),
+                                                entry.second.end() );
+    session_pending_.clear();
+}
+
+//------------------------------------------------------------------------------
+/// In a workspace session, removes from the broadcast set of tile ij the
+/// ranks already holding it, other than root, and records the ranks of
+/// the set as holding the tile. Every rank calls it for every broadcast,
+/// whether in the set or not, so the records agree on all ranks.
+///
+/// @param[in] ij
+///     Tile index, in storage.
+///
+/// @param[in] root
+///     Rank owning the tile, which sends it.
+///
+/// @param[in,out] bcast_set
+///     On entry, ranks of the broadcast, including root.
+///     On exit, ranks that still need to receive it, including root.
+///
+template <typename scalar_t>
+void MatrixStorage<scalar_t>::sessionFilter(
+    ij_tuple ij, int root, std::set<int>& bcast_set)
+{
+    if (! sessionActive())
+        return;
+
+    LockGuard guard( &session_lock_ );
+    auto& pending = session_pending_[ ij ];
+    pending.insert( bcast_set.begin(), bcast_set.end() );
+
+    auto iter = session_holders_.find( ij );
+    if (iter == session_holders_.end())
+        return;
+    for (int rank : iter->second) {
+        if (rank != root)
+            bcast_set.erase( rank );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// In a workspace session, places a hold on a received tile instance, so
+/// releasing workspace keeps it until the session ends.
+///
+template <typename scalar_t>
+void MatrixStorage<scalar_t>::sessionHold(ijdev_tuple ijdev)
+{
+    if (! sessionActive())
+        return;
+
+    {
+        auto& sh = shard( { std::get<0>( ijdev ), std::get<1>( ijdev ) } );
+        LockGuard shard_guard( &sh.lock );
+        auto tile_node = find( ijdev );
+        if (tile_node == nullptr)
+            return;
+        (*tile_node)[ std::get<2>( ijdev ) ]->state( MOSI::OnHold );
+    }
+    LockGuard guard( &session_lock_ );
+    session_held_.insert( ijdev );
+}
+
+//------------------------------------------------------------------------------
+/// Enables compact transfers of the band of a band matrix with kl
+/// sub-diagonals and ku super-diagonals, in stored coordinates, and
+/// mt-by-nt tiles. Broadcasts then send only the part of each tile
+/// containing the band; @see tileBandBox.
+/// Must be called on all ranks, before tiles are broadcast.
+/// @see BaseBandMatrix::compactBand
+///
+template <typename scalar_t>
+void MatrixStorage<scalar_t>::setBand(
+    int64_t kl, int64_t ku, int64_t mt, int64_t nt)
+{
+    band_kl_ = kl;
+    band_ku_ = ku;
+    band_row0_.assign( mt + 1, 0 );
+    for (int64_t i = 0; i < mt; ++i)
+        band_row0_[ i+1 ] = band_row0_[ i ] + tileMb( i );
+    band_col0_.assign( nt + 1, 0 );
+    for (int64_t j = 0; j < nt; ++j)
+        band_col0_[ j+1 ] = band_col0_[ j ] + tileNb( j );
+    band_compact_ = true;
+}
+
+//------------------------------------------------------------------------------
+/// Disables compact band transfers; broadcasts send whole tiles.
+///
+template <typename scalar_t>
+void MatrixStorage<scalar_t>::clearBand()
+{
+    band_compact_ = false;
+    band_row0_.clear();
+    band_col0_.clear();
+}
+
+//------------------------------------------------------------------------------
+/// Gets the smallest block of stored tile {i, j} that contains all its
+/// entries within the band, as rows [i0, i0 + mb) and columns
+/// [j0, j0 + nb) of the tile. The block is empty (mb = 0 or nb = 0) if the
+/// tile is outside the band.
+///
+/// @return true if compact band transfers are enabled and the block is
+/// smaller than the tile, i.e., it is worth sending only the block;
+/// false otherwise, and the outputs are not set.
+///
+template <typename scalar_t>
+bool MatrixStorage<scalar_t>::tileBandBox(
+    ij_tuple ij, int64_t* i0, int64_t* mb, int64_t* j0, int64_t* nb)
+{
+    if (! band_compact_)
+        return false;
+
+    int64_t i = std::get<0>( ij );
+    int64_t j = std::get<1>( ij );
+    if (i + 1 >= int64_t( band_row0_.size() )
+        || j + 1 >= int64_t( band_col0_.size() ))
+        return false;
+
+    // Entry (r, c) of the tile, at (row0 + r, col0 + c) in the matrix,
+    // is in the band if -ku <= row0 + r - col0 - c <= kl.
+    int64_t row0 = band_row0_[ i ];
+    int64_t col0 = band_col0_[ j ];
+    int64_t tile_mb = band_row0_[ i+1 ] - row0;
+    int64_t tile_nb = band_col0_[ j+1 ] - col0;
+    int64_t r_begin = std::max( int64_t( 0 ), col0 - band_ku_ - row0 );
+    int64_t r_end   = std::min( tile_mb, col0 + tile_nb + band_kl_ - row0 );
+    int64_t c_begin = std::max( int64_t( 0 ), row0 - band_kl_ - col0 );
+    int64_t c_end   = std::min( tile_nb, row0 + tile_mb + band_ku_ - col0 );
+
+    if (r_begin >= r_end || c_begin >= c_end) {
+        *i0 = 0;
+        *mb = 0;
+        *j0 = 0;
+        *nb = 0;
+        return true;
+    }
+    if (r_end - r_begin == tile_mb && c_end - c_begin == tile_nb)
+        return false;
+
+    *i0 = r_begin;
+    *mb = r_end - r_begin;
+    *j0 = c_begin;
+    *nb = c_end - c_begin;
+    return true;
+}
+
+//------------------------------------------------------------------------------
+/// Marks tile {i, j} as structurally zero or not.
+/// Marking a tile as zero enables tracking of zero tiles.
+///
+template <typename scalar_t>
+void MatrixStorage<scalar_t>::tileSetZero(ij_tuple ij, bool is_zero)
+{
+    LockGuard guard( &zero_lock_ );
+    if (is_zero) {
+        track_zero_tiles_ = true;
+        zero_tiles_.insert( ij );
+    }
+    else {
+        zero_tiles_.erase( ij );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Ensures there are num_tiles free blocks on device, growing the pool up
+/// to the cache size, then evicting tiles.
+/// Stops early if no tile can be evicted.
+template <typename scalar_t>
+void MatrixStorage<scalar_t>::tileCacheReserve(int device, int64_t num_tiles)
+{
+    LockGuard guard( getTilesMapLock() );
+
+    int64_t need = num_tiles - memory_.available( device );
+    int64_t room = cache_tiles_ - memory_.capacity( device );
+    int64_t grow = std::min( need, room );
+    if (grow > 0) {
+        memory_.addDeviceBlocks( device, grow, comm_queues_[ device ] );
+        need -= grow;
+    }
+    while (need > 0 && tileCacheEvict( device )) {
+        need = num_tiles - memory_.available( device );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Evicts the least-recently-used evictable tile instance on device,
+/// writing it back to host if needed.
+/// Must be called within the TilesMap LockGuard, which excludes other
+/// erasures. Tile nodes locked by other threads are skipped, rather than
+/// waited on, since they are locked before the TilesMap lock in tileGet.
+///
+/// @return true if a tile was evicted.
+///
+template <typename scalar_t>
+bool MatrixStorage<scalar_t>::tileCacheEvict(int device)
+{
+    LockGuard guard( getTilesMapLock() );
+    LockGuard cache_guard( &cache_lock_ );
+    auto& cache = tile_cache_[ device ];
+
+    for (auto iter = cache.lru.begin(); iter != cache.lru.end(); /* below */) {
+        ij_tuple ij = *iter;
+        ++iter;
+
+        LockGuard shard_guard( &shard( ij ).lock );
+        TileNode_t* tile_node = find( { std::get<0>( ij ), std::get<1>( ij ),
+                                        device } );
+        if (tile_node == nullptr) {
+            // stale entry
+            tileCacheErase( ij, device );
+            continue;
+        }
+        if (! omp_test_nest_lock( tile_node->getLock() ))
+            continue;
+
+        Tile<scalar_t>* tile = (*tile_node)[ device ];
+        bool evicted = false;
+        if (tile->workspace() && ! tile->stateOn( MOSI::OnHold )
+            && cache.pins.count( ij ) == 0) {
+            // Find whether another instance is valid.
+            bool last_valid = ! tile->stateOn( MOSI::Invalid );
+            for (int d = HostNum; last_valid && d < num_devices(); ++d) {
+                if (d != device && tile_node->existsOn( d )
+                    && ! (*tile_node)[ d ]->stateOn( MOSI::Invalid ))
+                    last_valid = false;
+            }
+
+            Tile<scalar_t>* host_tile = nullptr;
+            if (last_valid) {
+                host_tile = (*tile_node)[ HostNum ];
+                if (host_tile == nullptr) {
+                    host_tile = tileInsert(
+                        { std::get<0>( ij ), std::get<1>( ij ), HostNum },
+                        TileKind::Workspace, tile->layout() );
+                }
+            }
+            // Writing back can't change the host layout of a
+            // non-square tile.
+            if (host_tile == nullptr
+                || host_tile->layout() == tile->layout()
+                || tile->mb() == tile->nb()) {
+
+                // Kernels enqueued earlier may still read or write it.
+                for (auto& queues : compute_queues_) {
+                    if (queues[ device ] != nullptr)
+                        queues[ device ]->sync();
+                }
+                if (host_tile != nullptr) {
+                    MOSI state = tile->state();
+                    tile->copyData( host_tile, *comm_queues_[ device ] );
+                    host_tile->state( state );
+                    ++cache.stats.writebacks;
+                }
+                freeTileMemory( tile );
+                tile_node->eraseOn( device );
+                tileCacheErase( ij, device );
+                ++cache.stats.evictions;
+                evicted = true;
+            }
+        }
+        omp_unset_nest_lock( tile_node->getLock() );
+        if (evicted) {
+            if (tile_node->empty())
+                erase( ij );
+            return true;
+        }
+    }
+    return false;
+}
+
+//------------------------------------------------------------------------------
+/// Removes tile {i, j} on device from the cache's LRU order.
+/// Called when the instance is erased.
+template <typename scalar_t>
+void MatrixStorage<scalar_t>::tileCacheErase(ij_tuple ij, int device)
+{
+    if (device == HostNum || ! tileCacheEnabled())
+        return;
+
+    LockGuard guard( &cache_lock_ );
+    auto& cache = tile_cache_[ device ];
+    auto iter = cache.position.find( ij );
+    if (iter != cache.position.end()) {
+        cache.lru.erase( iter->second );
+        cache.position.erase( iter );
+    }
+}
+
 //------------------------------------------------------------------------------
 /// Return tiles allocated memory and extended memory to the memory factory
 template <typename scalar_t>
@@ -789,28 +2369,33 @@ template <typename scalar_t>
 void MatrixStorage<scalar_t>::clearWorkspace()
 {
     LockGuard guard(getTilesMapLock());
-    for (auto iter = begin(); iter != end(); /* incremented below */) {
-        auto& tile_node = *(iter->second);
-        for (int d = HostNum; d < num_devices(); ++d) {
-            if (tile_node.existsOn(d) &&
-                tile_node[d]->workspace())
-            {
-                freeTileMemory(tile_node[d]);
-                tile_node.eraseOn(d);
+    sessionForget();
+    for (auto& sh : shards_) {
+        LockGuard shard_guard( &sh.lock );
+        for (auto iter = sh.tiles.begin(); iter != sh.tiles.end(); /* incremented below */) {
+            auto& tile_node = *(iter->second);
+            for (int d = HostNum; d < num_devices(); ++d) {
+                if (tile_node.existsOn(d) &&
+                    tile_node[d]->workspace())
+                {
+                    freeTileMemory(tile_node[d]);
+                    tile_node.eraseOn(d);
+                    tileCacheErase( iter->first, d );
+                }
             }
+            if (tile_node.empty())
+                // Since we can't increment the iterator after deleting the
+                // element, use post-fix iter++ to increment it but
+                // erase the current value.
+                erase((iter++)->first);
+            else
+                ++iter;
         }
-        if (tile_node.empty())
-            // Since we can't increment the iterator after deleting the
-            // element, use post-fix iter++ to increment it but
-            // erase the current value.
-            erase((iter++)->first);
-        else
-            ++iter;
     }
     // Free host & device memory only if there are no unallocated blocks
     // from non-workspace (SlateOwned) tiles.
     if (memory_.allocated( HostNum ) == 0) {
-        memory_.clearHostBlocks();
+        memory_.clearHostBlocks( host_queue() );
     }
 
     for (int device = 0; device < num_devices(); ++device) {
@@ -832,16 +2417,23 @@ template <typename scalar_t>
 void MatrixStorage<scalar_t>::releaseWorkspace()
 {
     LockGuard guard(getTilesMapLock());
-    for (auto iter = begin(); iter != end(); /* incremented below */) {
-        // Since we can't increment the iterator after deleting the element
-        // and release deletes empty nodes, use post-fix iter++ to
-        // increment it but pass the current value to release.
-        release(iter++, AllDevices);
+    // End of a routine: broadcasts so far may be skipped from now on.
+    if (! omp_in_parallel())
+        sessionCommit();
+    for (auto& sh : shards_) {
+        LockGuard shard_guard( &sh.lock );
+        for (auto iter = sh.tiles.begin(); iter != sh.tiles.end(); /* incremented below */) {
+            // Since we can't increment the iterator after deleting the element
+            // and release deletes empty nodes, use post-fix iter++ to
+            // increment it but pass the current value to release.
+            auto curr = iter++;
+            release( curr->first, *(curr->second), AllDevices );
+        }
     }
     // Free host & device memory only if there are no unallocated blocks
     // from non-workspace (SlateOwned) tiles.
     if (memory_.allocated( HostNum ) == 0) {
-        memory_.clearHostBlocks();
+        memory_.clearHostBlocks( host_queue() );
     }
     for (int device = 0; device < num_devices(); ++device) {
         if (memory_.allocated(device) == 0) {
@@ -863,17 +2455,19 @@ void MatrixStorage<scalar_t>::erase(ijdev_tuple ijdev)
 {
     LockGuard guard(getTilesMapLock());
 
-    auto iter = find(ijdev);
-    if (iter != end()) {
+    int64_t i  = std::get<0>(ijdev);
+    int64_t j  = std::get<1>(ijdev);
+    int device = std::get<2>(ijdev);
 
-        auto& tile_node = *(iter->second);
+    LockGuard shard_guard( &shard( {i, j} ).lock );
+    auto tile_node_ptr = find(ijdev);
+    if (tile_node_ptr != nullptr) {
 
-        int64_t i  = std::get<0>(ijdev);
-        int64_t j  = std::get<1>(ijdev);
-        int device = std::get<2>(ijdev);
+        auto& tile_node = *tile_node_ptr;
 
         freeTileMemory(tile_node[device]);
         tile_node.eraseOn(device);
+        tileCacheErase( {i, j}, device );
 
         if (tile_node.empty())
             erase({i, j});
@@ -892,11 +2486,8 @@ void MatrixStorage<scalar_t>::erase(ijdev_tuple ijdev)
 /// releaseWorkspace.
 template <typename scalar_t>
 void MatrixStorage<scalar_t>::release(
-    typename MatrixStorage<scalar_t>::TilesMap::iterator iter,
-    int device)
+    ij_tuple ij, TileNode_t& tile_node, int device)
 {
-    auto& tile_node = *(iter->second);
-
     int begin = device;
     int end   = device + 1;
     if (device == AllDevices) {
@@ -906,7 +2497,7 @@ void MatrixStorage<scalar_t>::release(
 
     // Don't release tiles if it'd delete the last valid copy
     // Remote tiles never have the last valid copy
-    bool last_valid = tileIsLocal( iter->first );
+    bool last_valid = tileIsLocal( ij );
     for (int dev = HostNum; dev < num_devices(); ++dev) {
         if (tile_node.existsOn( dev )
             && (dev < begin || dev >= end || tile_node[ dev ]->origin())
@@ -926,10 +2517,11 @@ void MatrixStorage<scalar_t>::release(
 
             freeTileMemory( tile_node[ dev ] );
             tile_node.eraseOn( dev );
+            tileCacheErase( ij, dev );
         }
     }
     if (tile_node.empty())
-        erase( iter->first );
+        erase( ij );
 }
 
 //------------------------------------------------------------------------------
@@ -954,9 +2546,11 @@ void MatrixStorage<scalar_t>::release(ijdev_tuple ijdev)
     int64_t i  = std::get<0>(ijdev);
     int64_t j  = std::get<1>(ijdev);
     int device = std::get<2>(ijdev);
-    auto iter = find( { i, j } ); // not device, to allow AllDevices
-    if (iter != end()) {
-        release(iter, device);
+
+    LockGuard shard_guard( &shard( {i, j} ).lock );
+    auto tile_node = find( { i, j } ); // not device, to allow AllDevices
+    if (tile_node != nullptr) {
+        release( { i, j }, *tile_node, device );
     }
 }
 
@@ -972,8 +2566,16 @@ void MatrixStorage<scalar_t>::erase(ij_tuple ij)
 {
     LockGuard guard(getTilesMapLock());
 
-    auto iter = tiles_.find(ij);
-    if (iter != tiles_.end()) {
+    if (hasLazyZeroTiles()) {
+        LockGuard zero_guard( &zero_lock_ );
+        if (lazy_zero_tiles_.erase( ij ) > 0)
+            num_lazy_zero_.fetch_sub( 1, std::memory_order_release );
+    }
+
+    auto& sh = shard( ij );
+    LockGuard shard_guard( &sh.lock );
+    auto iter = sh.tiles.find(ij);
+    if (iter != sh.tiles.end()) {
 
         auto& tile_node = iter->second;
 
@@ -981,9 +2583,10 @@ void MatrixStorage<scalar_t>::erase(ij_tuple ij)
             if (tile_node->existsOn(d)) {
                 freeTileMemory(tile_node->at(d));
                 tile_node->eraseOn(d);
+                tileCacheErase( ij, d );
             }
         }
-        tiles_.erase(ij);
+        sh.tiles.erase(ij);
     }
 }
 
@@ -992,16 +2595,26 @@ void MatrixStorage<scalar_t>::erase(ij_tuple ij)
 template <typename scalar_t>
 void MatrixStorage<scalar_t>::clear()
 {
+    // Snapshots sharing tiles get their own copies before tiles are freed.
+    cowDetachAll();
+
     LockGuard guard(getTilesMapLock());
+    sessionForget();
 
-    for (auto iter = begin(); iter != end(); /* incremented below */) {
-        // erasing the element invalidates the iterator,
-        // so use iter++ to erase the current value but increment it first.
-        erase((iter++)->first); // todo: in-efficient
+    for (auto& sh : shards_) {
+        for (auto iter = sh.tiles.begin(); iter != sh.tiles.end(); /* incremented below */) {
+            // erasing the element invalidates the iterator,
+            // so use iter++ to erase the current value but increment it first.
+            erase((iter++)->first); // todo: in-efficient
+        }
     }
 
     // todo: what if some tiles were not erased
-    slate_assert(tiles_.size() == 0);  // should be empty now
+    slate_assert(size() == 0);  // should be empty now
+
+    LockGuard zero_guard( &zero_lock_ );
+    lazy_zero_tiles_.clear();
+    num_lazy_zero_.store( 0, std::memory_order_release );
 }
 
 //------------------------------------------------------------------------------
@@ -1071,6 +2684,22 @@ Tile<scalar_t>* MatrixStorage<scalar_t>::tileInsert(
 }
 
 
+//------------------------------------------------------------------------------
+/// This is intended for inserting the original matrix out-of-core.
+/// Inserts tile {i, j} on host, wrapping memory in a file mapped by mapFile.
+/// Sets tile kind = TileKind::FileMapped.
+/// This will be the origin tile, thus TileNode(i, j) should not pre-exist.
+/// @return Pointer to newly inserted Tile.
+///
+template <typename scalar_t>
+Tile<scalar_t>* MatrixStorage<scalar_t>::tileInsertMapped(
+    ij_tuple ij, scalar_t* data, int64_t lda, Layout layout)
+{
+    slate_assert( data != nullptr );
+    return tileInsert( { std::get<0>( ij ), std::get<1>( ij ), HostNum },
+                       data, lda, TileKind::FileMapped, layout );
+}
+
 //------------------------------------------------------------------------------
 /// shared logic of tileInsert
 template <typename scalar_t>
@@ -1084,12 +2713,18 @@ Tile<scalar_t>* MatrixStorage<scalar_t>::tileInsert(
 
     LockGuard guard(getTilesMapLock());
 
-    if (find({i, j}) == end()) {
+    auto& sh = shard( {i, j} );
+    LockGuard shard_guard( &sh.lock );
+
+    TileNode_t* tile_node_ptr = find( {i, j} );
+    if (tile_node_ptr == nullptr) {
         // insert new-entry in map
-        tiles_[{i, j}] = std::make_shared<TileNode_t>( num_devices() );
+        auto new_node = std::make_shared<TileNode_t>( num_devices() );
+        tile_node_ptr = new_node.get();
+        sh.tiles[{i, j}] = std::move( new_node );
     }
 
-    auto& tile_node = this->at({i, j});
+    auto& tile_node = *tile_node_ptr;
 
     // if tile instance does not exist, insert new instance
     if (! tile_node.existsOn(device)) {
@@ -1098,7 +2733,14 @@ Tile<scalar_t>* MatrixStorage<scalar_t>::tileInsert(
         if (data == nullptr) {
             // if device==HostNum (-1) use nullptr as queue (not comm_queues_[-1])
             blas::Queue* queue = (device == HostNum) ? nullptr : comm_queues_[device];
-            data = (scalar_t*) memory_.alloc(device, sizeof(scalar_t) * mb * nb, queue);
+            size_t size = sizeof(scalar_t) * mb * nb;
+            if (device != HostNum && tileCacheEnabled()) {
+                // Cached tiles take full blocks, so the cache holds
+                // num_tiles of them regardless of their sizes.
+                size = memory_.block_size();
+                tileCacheReserve( device, 1 );
+            }
+            data = (scalar_t*) memory_.alloc(device, size, queue);
             lda = (layout == Layout::ColMajor) ? mb : nb;
         }
         Tile<scalar_t>* tile
@@ -1111,6 +2753,133 @@ Tile<scalar_t>* MatrixStorage<scalar_t>::tileInsert(
     return tile_node[device];
 }
 
+//------------------------------------------------------------------------------
+/// Maps a file into memory with space for num_tiles tiles of the
+/// largest tile size, to hold origin tiles inserted by tileInsertMapped.
+/// The file is kept and synced when the matrix storage is destroyed.
+/// @return start of mapped memory.
+///
+/// @param[in] filename
+///     Name of file, which is created if it does not exist.
+///
+/// @param[in] num_tiles
+///     Number of tiles. num_tiles > 0.
+///
+template <typename scalar_t>
+scalar_t* MatrixStorage<scalar_t>::mapFile(
+    std::string const& filename, int64_t num_tiles)
+{
+    slate_assert( num_tiles > 0 );
+    LockGuard guard( getTilesMapLock() );
+    mapped_files_.push_back( std::make_unique< MappedFile >(
+        filename, memory_.block_size() * num_tiles ) );
+    return (scalar_t*) mapped_files_.back()->data();
+}
+
+//------------------------------------------------------------------------------
+/// Allocates one contiguous host arena of size elements, to hold all local
+/// origin tiles, inserted as user-owned tiles pointing into it.
+/// The arena is pinned if there are devices, so whole local panels can be
+/// copied to devices in one transfer. It is freed when the matrix storage is
+/// destroyed. A storage has at most one arena.
+/// @return start of the arena.
+///
+/// @param[in] size
+///     Number of elements. size >= 0.
+///
+/// @param[in] lld
+///     Leading dimension of the arena, recorded for arenaStride.
+///
+template <typename scalar_t>
+scalar_t* MatrixStorage<scalar_t>::allocArena(int64_t size, int64_t lld)
+{
+    slate_assert( size >= 0 );
+    LockGuard guard( getTilesMapLock() );
+    slate_assert( arena_ == nullptr );
+
+    blas::Queue* queue = host_queue();
+    if (queue != nullptr)
+        arena_ = blas::host_malloc_pinned<scalar_t>( size, *queue );
+    else
+        arena_ = new scalar_t[ size ];
+    arena_size_ = size;
+    arena_lld_ = lld;
+    arena_pinned_ = queue != nullptr;
+    memory_.addExternal( HostNum, sizeof(scalar_t) * size );
+    return arena_;
+}
+
+//------------------------------------------------------------------------------
+/// Frees the host arena allocated by allocArena, if any.
+/// Tiles in it must already be erased.
+///
+template <typename scalar_t>
+void MatrixStorage<scalar_t>::freeArena()
+{
+    if (arena_ == nullptr)
+        return;
+
+    if (arena_pinned_)
+        blas::host_free_pinned( arena_, *host_queue() );
+    else
+        delete[] arena_;
+    memory_.removeExternal( HostNum, sizeof(scalar_t) * arena_size_ );
+    arena_ = nullptr;
+    arena_size_ = 0;
+    arena_lld_ = 0;
+    arena_pinned_ = false;
+}
+
+//------------------------------------------------------------------------------
+/// @return mapped file holding tile's data, or nullptr if tile isn't mapped.
+template <typename scalar_t>
+MappedFile* MatrixStorage<scalar_t>::findMappedFile(Tile<scalar_t>* tile)
+{
+    if (! tile->mapped())
+        return nullptr;
+    for (auto& file : mapped_files_) {
+        if (file->contains( tile->data() ))
+            return file.get();
+    }
+    return nullptr;
+}
+
+//------------------------------------------------------------------------------
+/// For a FileMapped tile, starts reading its data from the file
+/// asynchronously, so it is in memory when accessed. No-op for other tiles.
+template <typename scalar_t>
+void MatrixStorage<scalar_t>::tilePrefetchMapped(Tile<scalar_t>* tile)
+{
+    MappedFile* file = findMappedFile( tile );
+    if (file != nullptr) {
+        int64_t cols = tile->layout() == Layout::ColMajor ? tile->nb() : tile->mb();
+        file->prefetch( tile->data(), sizeof(scalar_t) * tile->stride() * cols );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// For a FileMapped tile, starts writing its data back to the file and
+/// lets the OS drop it from memory, after its last use for a while.
+/// The tile remains valid. No-op for other tiles.
+template <typename scalar_t>
+void MatrixStorage<scalar_t>::tileFlushMapped(Tile<scalar_t>* tile)
+{
+    MappedFile* file = findMappedFile( tile );
+    if (file != nullptr) {
+        int64_t cols = tile->layout() == Layout::ColMajor ? tile->nb() : tile->mb();
+        file->release( tile->data(), sizeof(scalar_t) * tile->stride() * cols );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Writes all FileMapped tiles back to their files, waiting for completion.
+template <typename scalar_t>
+void MatrixStorage<scalar_t>::syncMappedFiles()
+{
+    for (auto& file : mapped_files_)
+        file->sync();
+}
+
 //------------------------------------------------------------------------------
 /// Makes tile layout convertible by extending its data buffer.
 /// Attaches an auxiliary buffer to hold the transposed data when needed.
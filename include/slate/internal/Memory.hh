@@ -14,6 +14,8 @@
 
 #include <map>
 #include <stack>
+#include <unordered_map>
+#include <vector>
 
 #include "blas.hh"
 
@@ -22,18 +24,69 @@
 
 namespace slate {
 
+//------------------------------------------------------------------------------
+/// Statistics of a device's memory pool, used to measure fragmentation
+/// and memory use.
+/// Host blocks allocated on-the-fly, outside the pool, count as both
+/// reserved and in use while handed out.
+struct MemoryStats {
+    size_t  reserved    = 0;  ///< bytes allocated from the device by the pool
+    size_t  in_use      = 0;  ///< bytes of blocks currently handed out
+    size_t  requested   = 0;  ///< bytes requested for blocks handed out
+    size_t  external    = 0;  ///< bytes allocated outside the pool,
+                              ///< e.g., batch arrays
+    size_t  peak        = 0;  ///< high-water mark of current()
+    size_t  peak_in_use = 0;  ///< high-water mark of in_use + external
+    int64_t num_allocs  = 0;  ///< number of blocks handed out, in total
+    int64_t num_mallocs = 0;  ///< number of allocations from the device
+
+    /// @return bytes currently allocated from the device,
+    /// including free blocks in the pool.
+    size_t current() const
+    {
+        return reserved + external;
+    }
+
+    /// @return fraction of in-use bytes lost to rounding up to a size class.
+    double internalFragmentation() const
+    {
+        return in_use == 0 ? 0. : double(in_use - requested) / in_use;
+    }
+
+    /// @return fraction of reserved bytes sitting idle in free blocks.
+    double externalFragmentation() const
+    {
+        return reserved == 0 ? 0. : double(reserved - in_use) / reserved;
+    }
+};
+
 //------------------------------------------------------------------------------
 /// Allocates workspace blocks for host and GPU devices.
-/// Currently assumes a fixed-size block of block_size bytes,
-/// e.g., block_size = sizeof(scalar_t) * mb * nb.
+/// Blocks come in a few size classes: the full block of block_size bytes,
+/// e.g., block_size = sizeof(scalar_t) * mb * nb, and blocks of 1/2, 1/4,
+/// 1/8 the size, so edge tiles and non-uniform tiles are served without
+/// wasting a full block. Smaller blocks are carved out of slabs of
+/// block_size bytes, so a miss costs one device allocation per slab,
+/// not per block.
+///
+/// The host pool holds only full-size blocks reserved by addHostBlocks,
+/// in pinned memory if a queue is given, so host workspace tiles can be
+/// copied to and from devices asynchronously. When the host pool is
+/// empty, host blocks are allocated on-the-fly in pageable memory.
+///
+/// Per-device data is indexed by device+1, so host (HostNum = -1) is 0.
 class Memory {
 public:
     friend class Debug;
 
+    /// Maximum number of size classes.
+    static constexpr int max_size_classes = 4;
+
     static struct StaticConstructor {
         StaticConstructor()
         {
             num_devices_ = blas::get_device_count();
+            totals_.resize( num_devices_ + 1 );
         }
     } static_constructor_;
 
@@ -41,63 +94,115 @@ public:
     ~Memory();
 
     // todo: change add* to reserve*?
-    void addHostBlocks(int64_t num_blocks) { /* No host pool currently */ }
+    void addHostBlocks(int64_t num_blocks, blas::Queue *queue = nullptr);
     void addDeviceBlocks(int device, int64_t num_blocks, blas::Queue *queue);
 
-    void clearHostBlocks() { /* No host pool currently */ }
+    void clearHostBlocks(blas::Queue *queue = nullptr);
     void clearDeviceBlocks(int device, blas::Queue *queue);
 
     void* alloc(int device, size_t size, blas::Queue *queue);
     void free(void* block, int device);
 
-    /// @return number of available free blocks in device's memory pool,
-    /// which can be host.
+    /// @return size in bytes of full-size blocks.
+    size_t block_size() const
+    {
+        return block_size_;
+    }
+
+    /// @return number of available free full-size blocks in device's
+    /// memory pool, which can be host.
     size_t available(int device) const
     {
-        if (device == HostNum)
-            return 0;
-        else
-            return free_blocks_.at(device).size();
+        return free_blocks_.at( device+1 ).at( 0 ).size();
     }
 
-    /// @return total number of blocks in device's memory pool,
+    /// @return total number of full-size blocks in device's memory pool,
     /// which can be host.
     size_t capacity(int device) const
     {
-        if (device == HostNum)
-            return 0;
-        else
-            return capacity_.at(device);
+        return capacity_.at( device+1 );
     }
 
-    /// @return total number of allocated blocks from device's memory pool,
-    /// which can be host.
+    /// @return total number of allocated blocks, of any size class,
+    /// from device's memory pool, which can be host.
+    /// For host, includes blocks allocated on-the-fly.
     size_t allocated(int device) const
     {
-        return capacity(device) - available(device);
+        return block_info_.at( device+1 ).size();
     }
 
+    /// @return number of size classes.
+    int num_size_classes() const { return int( class_size_.size() ); }
+
+    /// @return block size in bytes of the given size class.
+    size_t class_size(int size_class) const
+    {
+        return class_size_.at( size_class );
+    }
+
+    int size_class(size_t size) const;
+
+    /// @return statistics of device's memory pool, which can be host.
+    MemoryStats stats(int device) const
+    {
+        return stats_.at( device+1 );
+    }
+
+    /// @return whether the host pool is in pinned memory.
+    bool host_pinned() const { return host_pinned_; }
+
+    void addExternal(int device, size_t size);
+    void removeExternal(int device, size_t size);
+    void resetPeak(int device);
+
+    static MemoryStats totalStats(int device);
+    static void resetTotalPeak(int device);
+
     // ----------------------------------------
     // public static variables
     static int num_devices_;
 
 private:
     void* allocBlock(int device, blas::Queue *queue);
+    void  addSlab(int device, int size_class, blas::Queue *queue);
 
-    void* allocHostMemory(size_t size);
+    void* allocHostMemory(size_t size, blas::Queue *queue);
     void* allocDeviceMemory(int device, size_t size, blas::Queue *queue);
 
-    void freeHostMemory(void* host_mem);
+    void freeHostMemory(void* host_mem, blas::Queue *queue);
     void freeDeviceMemory(int device, void* dev_mem, blas::Queue *queue);
 
+    void updateStats(int device, int64_t reserved, int64_t in_use,
+                     int64_t requested, int64_t external);
+
+    /// Size class and requested size of a block that is handed out.
+    struct BlockInfo {
+        int size_class;
+        size_t size;
+    };
+
     // ----------------------------------------
     // member variables
     size_t block_size_;
 
-    // map device number to stack of blocks
-    std::vector< std::stack<void*> > free_blocks_;
+    // block size of each size class, in decreasing order
+    std::vector< size_t > class_size_;
+
+    // map device+1 to stack of free blocks for each size class
+    std::vector< std::vector< std::stack<void*> > > free_blocks_;
+    // map device+1 to stack of allocations (full blocks and slabs)
     std::vector< std::stack<void*> > allocated_mem_;
+    // map device+1 to blocks handed out from the pool
+    std::vector< std::unordered_map< void*, BlockInfo > > block_info_;
+    // map device+1 to number of full-size blocks
     std::vector< size_t > capacity_;
+    std::vector< MemoryStats > stats_;
+
+    // whether host pool allocations are pinned
+    bool host_pinned_;
+
+    // map device+1 to statistics summed over all Memory objects
+    static std::vector< MemoryStats > totals_;
 };
 
 } // namespace slate
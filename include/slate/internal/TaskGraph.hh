@@ -0,0 +1,114 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+//------------------------------------------------------------------------------
+/// @file
+///
+#ifndef SLATE_INTERNAL_TASKGRAPH_HH
+#define SLATE_INTERNAL_TASKGRAPH_HH
+
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace slate {
+namespace internal {
+
+//------------------------------------------------------------------------------
+/// [internal]
+/// Work-stealing task runtime with an explicit task DAG, an alternative to
+/// OpenMP tasks with depend clauses (@see TaskRuntime).
+///
+/// One thread submits tasks in program order, each with keys it reads (in)
+/// and keys it writes (inout), which give the same dependencies as
+/// OpenMP's depend(in:) and depend(inout:). Keys are arbitrary, e.g.,
+/// one per tile, so independent tiles of later steps can start before
+/// an earlier step finishes. All threads of an OpenMP parallel region
+/// execute ready tasks: each has its own ready queue, ordered by priority,
+/// then submission order; idle threads steal the highest priority task
+/// from other threads' queues.
+///
+/// Tasks may use OpenMP tasks internally, e.g., internal::gemm<HostTask>;
+/// idle threads yield to OpenMP to help execute them.
+///
+/// Communicating tasks must be submitted on all ranks, with the same keys,
+/// so the MPI tags they use are protected by the same dependencies on all
+/// ranks, as in the OpenMP implementation.
+///
+///     TaskGraph graph;
+///     graph.run( [&]( TaskGraph& g ) {
+///         g.add( 1, { key_A }, { key_B }, [&] { ... } );
+///     });
+///
+class TaskGraph {
+public:
+    //--------------------------------------------------------------------------
+    /// Dependency key, e.g., { 'A', i, j } for tile A(i, j).
+    struct Key {
+        int64_t space, i, j;
+
+        bool operator < ( Key const& other ) const
+        {
+            return space != other.space ? space < other.space
+                 : i     != other.i     ? i     < other.i
+                 :                        j     < other.j;
+        }
+    };
+
+    TaskGraph();
+    ~TaskGraph();
+
+    TaskGraph( TaskGraph const& ) = delete;
+    TaskGraph& operator = ( TaskGraph const& ) = delete;
+
+    void run( std::function< void (TaskGraph&) > submit );
+
+    void add( int priority,
+              std::vector<Key> const& in,
+              std::vector<Key> const& inout,
+              std::function< void () > body );
+
+    /// @return number of tasks executed by run().
+    int64_t num_tasks() const { return num_tasks_; }
+
+    /// @return number of tasks stolen from another thread's queue.
+    int64_t num_steals() const { return num_steals_; }
+
+private:
+    struct Task;
+    struct ReadyQueue;
+    struct KeyState {
+        Task* writer = nullptr;
+        std::vector< Task* > readers;
+    };
+
+    void addEdge( Task* pred, Task* task );
+    void push( Task* task, int thread );
+    Task* pop( int thread );
+    void execute( Task* task, int thread );
+    void work();
+
+    std::vector< std::unique_ptr< Task > > tasks_;
+    std::map< Key, KeyState > keys_;
+    std::vector< std::unique_ptr< ReadyQueue > > queues_;
+
+    std::atomic<int64_t> pending_;
+    std::atomic<bool> closed_;
+    std::atomic<int64_t> num_steals_;
+    int64_t num_tasks_;
+
+    std::mutex error_mutex_;    ///< guards error_
+    std::exception_ptr error_;
+};
+
+} // namespace internal
+} // namespace slate
+
+#endif // SLATE_INTERNAL_TASKGRAPH_HH
@@ -6,6 +6,7 @@
 #ifndef SLATE_TRACE_HH
 #define SLATE_TRACE_HH
 
+#include <chrono>
 #include <map>
 #include <set>
 #include <vector>
@@ -16,9 +17,23 @@
 #include "slate/internal/mpi.hh"
 #include "slate/internal/openmp.hh"
 
+namespace blas {
+class Queue;
+}
+
 namespace slate {
 namespace trace {
 
+//------------------------------------------------------------------------------
+/// Returns time in seconds from a steady clock. Inlined, so recording
+/// an event doesn't call into the OpenMP runtime as omp_get_wtime does.
+///
+inline double now()
+{
+    return std::chrono::duration<double>(
+        std::chrono::steady_clock::now().time_since_epoch() ).count();
+}
+
 //------------------------------------------------------------------------------
 ///
 class Event {
@@ -29,7 +44,7 @@ public:
     {}
 
     Event(const char* name, int index, int nest)
-        : start_(omp_get_wtime()),
+        : start_(now()),
           index_( index ),
           nest_(nest)
     {
@@ -38,7 +53,7 @@ public:
         name_[30]='\0';
     }
 
-    void stop() { stop_ = omp_get_wtime(); }
+    void stop() { stop_ = now(); }
 
 private:
     char name_[31];
@@ -52,9 +67,18 @@ private:
 class Trace {
 public:
     friend class Block;
+    friend class DeviceBlock;
+
+    /// Output format of finish().
+    enum class Format {
+        SVG,    ///< SVG timeline, gathered on rank 0 (default)
+        JSON,   ///< Chrome trace JSON, for Perfetto or chrome://tracing
+        None,   ///< no file, e.g., for only the analysis()
+    };
 
     static void on() { tracing_ = true; }
     static void off() { tracing_ = false; }
+    static bool tracing() { return tracing_; }
 
     static void insert(Event event);
     static void finish();
@@ -68,7 +92,52 @@ public:
     static double pixels_per_second() { return hscale_; }
     static void   pixels_per_second(double s) { hscale_ = s; }
 
+    static Format format() { return format_; }
+    static void   format(Format f) { format_ = f; }
+
+    // For JSON, whether each rank writes its own file,
+    // instead of sending its events to rank 0.
+    static bool per_rank() { return per_rank_; }
+    static void per_rank(bool p) { per_rank_ = p; }
+
+    // Per-thread ring buffer capacity, in events; 0 is unbounded (default).
+    // With a capacity, the oldest events are overwritten.
+    static int64_t capacity() { return capacity_; }
+    static void    capacity(int64_t n);
+
+    // Flight recorder: keep only events that ended in the last
+    // window seconds; 0 keeps all (default). Set a capacity to bound memory.
+    static double window() { return window_; }
+    static void   window(double seconds) { window_ = seconds; }
+
+    // Whether finish() prints a critical-path, idle-time, and overlap
+    // analysis of factorization k-loops, from blocks named "routine::panel",
+    // etc., and, if an Energy sampler ran, the energy of each block name.
+    static bool analysis() { return analysis_; }
+    static void analysis(bool a) { analysis_ = a; }
+
+    // Write this rank's events without MPI, e.g., when the job is killed.
+    static void dump();
+    static void dumpOnSignal(int signum);
+
+    // Name of a device queue's track, e.g., "compute 0" or "comm".
+    static void nameQueue(blas::Queue* queue, std::string const& name);
+    static void unnameQueue(blas::Queue* queue);
+
 private:
+    static void* recordDeviceEvent(blas::Queue& queue);
+    static void insertDevice(Event event, blas::Queue& queue, void* start);
+    static void resolveDevice(bool wait);
+    template <typename Func>
+    static void forEachEvent(Func func);
+
+    static void collect(bool device=true);
+    static std::vector< std::vector<Event> const* > deviceTracks();
+    static void analyze();
+    static void analyzeEnergy();
+    static void clear();
+    static void finishJSON();
+    static void printJSONEvents(int mpi_rank, FILE* trace_file, bool& first);
     static double getTimeSpan();
     static void printProcEvents(int mpi_rank, int mpi_size,
                                 double timespan, FILE* trace_file);
@@ -95,6 +164,14 @@ private:
     static bool tracing_;
     static int num_threads_;
 
+    static Format format_;
+    static bool per_rank_;
+
+    static int64_t capacity_;
+    static double window_;
+    static bool analysis_;
+    static int dump_rank_;
+
     static std::vector<std::vector<Event>> events_;
 };
 
@@ -109,6 +186,26 @@ private:
     Event event_;
 };
 
+//------------------------------------------------------------------------------
+/// Times work queued on a device queue with device (CUDA or HIP) events,
+/// as a Block times only the host launch. The events are resolved
+/// asynchronously; each queue is its own track in the trace.
+/// Without GPU support, this does nothing.
+///
+class DeviceBlock {
+public:
+    DeviceBlock( const char* name, blas::Queue& queue, int64_t index=0 );
+    ~DeviceBlock();
+
+    DeviceBlock( DeviceBlock const& ) = delete;
+    DeviceBlock& operator = ( DeviceBlock const& ) = delete;
+
+private:
+    Event event_;
+    blas::Queue* queue_;
+    void* start_;
+};
+
 } // namespace trace
 } // namespace slate
 
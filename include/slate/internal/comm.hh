@@ -9,11 +9,19 @@
 #ifndef SLATE_INTERNAL_COMM_HH
 #define SLATE_INTERNAL_COMM_HH
 
+#include <cstddef>
+#include <cstdint>
 #include <list>
 #include <set>
+#include <vector>
 
+#include "slate/enums.hh"
 #include "slate/internal/mpi.hh"
 
+namespace blas {
+    class Queue;
+}
+
 namespace slate {
 namespace internal {
 
@@ -21,12 +29,101 @@ MPI_Comm commFromSet(const std::set<int>& bcast_set,
                      MPI_Comm mpi_comm, MPI_Group mpi_group,
                      const int in_rank, int& out_rank, int tag = 0);
 
+int64_t commCacheCapacity();
+
+int64_t commCacheCapacity(int64_t capacity);
+
+int64_t bcastSegmentBytes(int64_t tile_bytes);
+
+size_t wireBytes(BcastPrecision precision, size_t real_bytes);
+
+void wirePack(BcastPrecision precision, int64_t m, int64_t n,
+              float const* A, int64_t lda, void* buffer);
+
+void wirePack(BcastPrecision precision, int64_t m, int64_t n,
+              double const* A, int64_t lda, void* buffer);
+
+void wireUnpack(BcastPrecision precision, int64_t m, int64_t n,
+                void const* buffer, float* A, int64_t lda);
+
+void wireUnpack(BcastPrecision precision, int64_t m, int64_t n,
+                void const* buffer, double* A, int64_t lda);
+
+int64_t hostStagedBytes();
+
+void resetHostStagedBytes();
+
+void addHostStagedBytes(int64_t bytes);
+
+bool topoBcastEnabled();
+
+bool ncclEnabled();
+
+void commInitNccl(MPI_Comm mpi_comm, int num_devices);
+
+void ncclSend(void const* data, size_t bytes, int dst, MPI_Comm mpi_comm,
+              blas::Queue& queue);
+
+void ncclRecv(void* data, size_t bytes, int src, MPI_Comm mpi_comm,
+              blas::Queue& queue);
+
+void commInitNodes(MPI_Comm mpi_comm);
+
+void topoBcastPattern(std::vector<int> const& nodes, int rank, int radix,
+                      std::list<int>& recv_from, std::list<int>& send_to);
+
+bool bcastPattern(MPI_Comm mpi_comm, std::vector<int> const& ranks,
+                  int rank, int radix,
+                  std::list<int>& recv_from, std::list<int>& send_to);
+
+bool reducePattern(MPI_Comm mpi_comm, std::vector<int> const& ranks,
+                   int rank, int radix,
+                   std::list<int>& recv_from, std::list<int>& send_to);
+
 void cubeBcastPattern(int size, int rank, int radix,
                       std::list<int>& recv_from, std::list<int>& send_to);
 
 void cubeReducePattern(int size, int rank, int radix,
                        std::list<int>& recv_from, std::list<int>& send_to);
 
+void progressStart();
+
+void progressStop();
+
+bool progressActive();
+
+void waitall(std::vector<MPI_Request>& requests);
+
+void wait(MPI_Request* request);
+
+//------------------------------------------------------------------------------
+/// Constructor starts the MPI progress thread, if enabled;
+/// destructor stops it. This provides safety in case an exception is thrown,
+/// which would otherwise by-pass the stop.
+/// @see progressStart
+///
+class ProgressThread {
+public:
+    ProgressThread(bool enable)
+        : enabled_( enable )
+    {
+        if (enabled_)
+            progressStart();
+    }
+
+    ~ProgressThread()
+    {
+        if (enabled_)
+            progressStop();
+    }
+
+    ProgressThread(ProgressThread const&) = delete;
+    ProgressThread& operator=(ProgressThread const&) = delete;
+
+private:
+    bool enabled_;
+};
+
 } // namespace internal
 } // namespace slate
 
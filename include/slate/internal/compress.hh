@@ -0,0 +1,54 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef SLATE_COMPRESS_HH
+#define SLATE_COMPRESS_HH
+
+#include "slate/enums.hh"
+
+#include <cstdint>
+#include <vector>
+
+namespace slate {
+namespace internal {
+
+//------------------------------------------------------------------------------
+/// [internal]
+/// Codec of tile messages. A tile is num_vectors columns (ColMajor) or
+/// rows (RowMajor) of vector_len real entries each, vectors stride entries
+/// apart; complex entries count as two real entries.
+///
+/// The message is either the raw entries, packed contiguously, or a
+/// compressed stream strictly shorter than that, so its length tells the
+/// receiver which it is, without a header:
+/// - The entries are byte-shuffled: byte k of every entry goes to plane k,
+///   so the sign and exponent bytes, which vary slowly, and the low
+///   mantissa bytes, zero in exact or rounded data, form runs.
+/// - The planes are run-length encoded as tokens of literal bytes
+///   followed by a run of one repeated byte.
+///
+/// With Compression::ErrorBounded, mantissas are first rounded to the
+/// fewest bits that keep each normal entry within relative error tol,
+/// which makes the low planes zero. Lossless keeps all bits.
+///
+/// @return length in bytes of the message written to message.
+///
+template <typename real_t>
+int64_t compress(
+    Compression compression, double tol,
+    real_t const* data, int64_t vector_len, int64_t num_vectors,
+    int64_t stride, std::vector<char>& message);
+
+template <typename real_t>
+void decompress(
+    char const* message, int64_t message_len,
+    real_t* data, int64_t vector_len, int64_t num_vectors, int64_t stride);
+
+int mantissa_bits_kept(double tol, int mantissa_bits);
+
+} // namespace internal
+} // namespace slate
+
+#endif // SLATE_COMPRESS_HH
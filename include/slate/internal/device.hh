@@ -147,6 +147,15 @@ void geset(
     scalar_t* A, int64_t lda,
     blas::Queue& queue);
 
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void generate_random(
+    int64_t dist, int64_t seed,
+    int64_t m, int64_t n, int64_t ioffset, int64_t joffset,
+    blas::real_type<scalar_t> diag_value, blas::real_type<scalar_t> scale,
+    scalar_t* A, int64_t lda,
+    blas::Queue& queue );
+
 //------------------------------------------------------------------------------
 template <typename scalar_t>
 void tzset(
@@ -156,6 +165,81 @@ void tzset(
     scalar_t* A, int64_t lda,
     blas::Queue& queue );
 
+//------------------------------------------------------------------------------
+/// Maximum number of butterfly levels that gerbt_left and gerbt apply
+/// in one pass, holding 2^depth, respectively 4^depth, entries per thread.
+const int64_t gerbt_left_max_depth = 4;
+const int64_t gerbt_max_depth = 2;
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void gerbt_left(
+    blas::Op trans, int64_t depth, int64_t n,
+    int64_t const* mb, scalar_t* const* Barray, int64_t const* ldb,
+    scalar_t const* const* Uarray,
+    blas::Queue& queue );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void gerbt(
+    int64_t depth,
+    int64_t const* mb, int64_t const* nb,
+    scalar_t* const* Aarray, int64_t const* lda,
+    scalar_t const* const* Uarray, scalar_t const* const* Varray,
+    blas::Queue& queue );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void hb2st_wave(
+    int64_t n, int64_t band,
+    int64_t wave, int64_t sweep_begin, int64_t sweep_count,
+    scalar_t* A, int64_t lda,
+    scalar_t* V, int64_t ldv, int64_t vgroup_stride, int64_t vgroups,
+    scalar_t* work,
+    blas::Queue& queue );
+
+//------------------------------------------------------------------------------
+template <typename real_t>
+void stedc_secular_roots(
+    int64_t n, int64_t nroots, int64_t const* roots,
+    real_t const* D, real_t const* z, real_t rho,
+    real_t* Lambda, real_t* Delta, int64_t ldd,
+    blas::Queue& queue );
+
+//------------------------------------------------------------------------------
+template <typename real_t>
+void stedc_secular_ztilde(
+    int64_t n, int64_t nroots, int64_t const* roots,
+    real_t const* D, real_t const* Delta, int64_t ldd,
+    real_t* ztilde,
+    blas::Queue& queue );
+
+//------------------------------------------------------------------------------
+template <typename real_t>
+void stedc_secular_vectors(
+    int64_t n, int64_t ncols,
+    real_t const* ztilde, real_t* Delta, int64_t ldd,
+    blas::Queue& queue );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void norm1est_sign(
+    int64_t m, scalar_t* x, scalar_t* s, int64_t* nchanged,
+    blas::Queue& queue );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void norm1est_amax(
+    int64_t m, scalar_t const* x,
+    blas::real_type<scalar_t>* amax, int64_t* index,
+    blas::Queue& queue );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void norm1est_altsgn(
+    int64_t m, int64_t ioffset, int64_t n, scalar_t* x,
+    blas::Queue& queue );
+
 namespace batch {
 
 //------------------------------------------------------------------------------
@@ -183,6 +267,57 @@ void geadd(
     scalar_t const& beta, scalar_t** Barray, int64_t ldb,
     int64_t batch_count, blas::Queue& queue);
 
+//------------------------------------------------------------------------------
+/// Add with precision conversion of A, as used in mixed-precision
+/// iterative refinement.
+template <typename src_scalar_t, typename dst_scalar_t>
+void geadd(
+    int64_t m, int64_t n,
+    dst_scalar_t const& alpha, src_scalar_t const* const* Aarray, int64_t lda,
+    dst_scalar_t const& beta, dst_scalar_t** Barray, int64_t ldb,
+    int64_t batch_count, blas::Queue& queue);
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void geequ_vbatch(
+    RowCol rowcol, int64_t const* dims,
+    scalar_t const* const* Aarray,
+    blas::real_type<scalar_t> const* R,
+    blas::real_type<scalar_t>* values,
+    int64_t batch_count, blas::Queue& queue );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void gemm_vbatch(
+    blas::Op opA, blas::Op opB,
+    int64_t max_m, int64_t max_n, int64_t const* dims,
+    scalar_t const& alpha, scalar_t** Aarray,
+                           scalar_t** Barray,
+    scalar_t const& beta,  scalar_t** Carray,
+    int64_t batch_count, blas::Queue& queue );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void gemmt_diag(
+    blas::Uplo uplo, blas::Op opA, blas::Op opB,
+    int64_t n, int64_t k, int64_t nb_diag,
+    scalar_t const& alpha, scalar_t** Aarray, int64_t lda,
+                           scalar_t** Barray, int64_t ldb,
+    scalar_t const& beta,  scalar_t** Carray, int64_t ldc,
+    int64_t batch_count, blas::Queue& queue );
+
+//------------------------------------------------------------------------------
+/// Max thread blocks of genorm_vbatch with NormScope::Matrix,
+/// which sizes its values workspace.
+const int64_t genorm_vbatch_blocks = 256;
+
+template <typename scalar_t>
+void genorm_vbatch(
+    NormScope scope, int64_t* dims,
+    scalar_t const* const* Aarray,
+    blas::real_type<scalar_t>* values,
+    int64_t batch_count, blas::Queue& queue );
+
 
 //------------------------------------------------------------------------------
 template <typename scalar_t>
@@ -201,6 +336,30 @@ void tzset(
     scalar_t** Aarray, int64_t lda,
     int64_t batch_count, blas::Queue& queue );
 
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void tzset_vbatch(
+    int64_t const* dims,
+    scalar_t const& offdiag_value, scalar_t const& diag_value,
+    scalar_t** Aarray,
+    int64_t batch_count, blas::Queue& queue );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void swap_rows(
+    int64_t n, int64_t nswaps,
+    scalar_t** rows1, scalar_t** rows2,
+    int64_t batch_count, blas::Queue& queue );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void potrf_update_apply(
+    blas::Op op, int sign, int64_t m, int64_t n, int64_t k,
+    scalar_t const* R, int64_t ldr,
+    scalar_t** Aarray, int64_t lda,
+    scalar_t** Varray, int64_t ldv,
+    int64_t batch_count, blas::Queue& queue );
+
 } // namespace batch
 
 //------------------------------------------------------------------------------
@@ -11,6 +11,8 @@
 
 #include "slate/Exception.hh"
 
+#include <mutex>
+
 #ifndef SLATE_NO_MPI
     #include <mpi.h>
 #else
@@ -19,13 +21,18 @@ typedef int MPI_Comm;
 typedef int MPI_Datatype;
 typedef int MPI_Group;
 typedef int MPI_Request;
+typedef int MPI_Message;
 typedef int MPI_Status;
 typedef int MPI_Op;
 typedef int MPI_Fint;
+typedef int MPI_Info;
+typedef int MPI_File;
+typedef long MPI_Aint;
 
 enum {
     MPI_COMM_NULL,
     MPI_COMM_WORLD,
+    MPI_COMM_SELF,
 
     MPI_BYTE,
     MPI_CHAR,
@@ -45,11 +52,26 @@ enum {
 
     MPI_MAX,
     MPI_MAXLOC,
+    MPI_MIN,
     MPI_SUM,
 
     MPI_SUCCESS,
     MPI_THREAD_MULTIPLE,
     MPI_THREAD_SERIALIZED,
+
+    MPI_KEYVAL_INVALID,
+
+    MPI_COMM_TYPE_SHARED,
+    MPI_INFO_NULL,
+
+    MPI_UNDEFINED,
+
+    MPI_IDENT,
+    MPI_CONGRUENT,
+
+    MPI_MODE_CREATE = 0x100,
+    MPI_MODE_RDONLY = 0x200,
+    MPI_MODE_WRONLY = 0x400,
 };
 
 #define MPI_MAX_ERROR_STRING 512
@@ -61,12 +83,25 @@ extern int* MPI_STATUS_IGNORE;
 typedef void (MPI_User_function) (void* a,
                                   void* b, int* len, MPI_Datatype* type);
 
+typedef int (MPI_Comm_copy_attr_function) (MPI_Comm comm, int keyval,
+                                           void* extra, void* attr_in,
+                                           void* attr_out, int* flag);
+
+typedef int (MPI_Comm_delete_attr_function) (MPI_Comm comm, int keyval,
+                                             void* attr, void* extra);
+
+#define MPI_COMM_NULL_COPY_FN ((MPI_Comm_copy_attr_function*) 0)
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
 int MPI_Type_contiguous(int count, MPI_Datatype oldtype, MPI_Datatype* newtype);
 
+int MPI_Allgather(const void* sendbuf, int sendcount, MPI_Datatype sendtype,
+                  void* recvbuf, int recvcount, MPI_Datatype recvtype,
+                  MPI_Comm comm);
+
 int MPI_Allreduce(const void* sendbuf, void* recvbuf, int count,
                   MPI_Datatype datatype, MPI_Op op, MPI_Comm comm);
 
@@ -78,12 +113,41 @@ int MPI_Bcast(void* buffer, int count, MPI_Datatype datatype, int root,
 int MPI_Comm_create_group(MPI_Comm comm, MPI_Group group, int tag,
                           MPI_Comm* newcomm);
 
+int MPI_Comm_create_keyval(MPI_Comm_copy_attr_function* copy_fn,
+                           MPI_Comm_delete_attr_function* delete_fn,
+                           int* keyval, void* extra);
+
+int MPI_Comm_delete_attr(MPI_Comm comm, int keyval);
+
+int MPI_Comm_compare(MPI_Comm comm1, MPI_Comm comm2, int* result);
+int MPI_Comm_dup(MPI_Comm comm, MPI_Comm* newcomm);
 int MPI_Comm_free(MPI_Comm* comm);
+int MPI_Comm_free_keyval(int* keyval);
+int MPI_Comm_get_attr(MPI_Comm comm, int keyval, void* attr, int* flag);
 int MPI_Comm_group(MPI_Comm comm, MPI_Group* group);
 int MPI_Comm_rank(MPI_Comm comm, int* rank);
+int MPI_Comm_set_attr(MPI_Comm comm, int keyval, void* attr);
 int MPI_Comm_size(MPI_Comm comm, int* size);
+int MPI_Comm_split_type(MPI_Comm comm, int split_type, int key,
+                        MPI_Info info, MPI_Comm* newcomm);
 MPI_Fint MPI_Comm_f2c(MPI_Comm comm);
 
+int MPI_File_close(MPI_File* fh);
+int MPI_File_open(MPI_Comm comm, const char* filename, int amode,
+                  MPI_Info info, MPI_File* fh);
+int MPI_File_read_all(MPI_File fh, void* buf, int count,
+                      MPI_Datatype datatype, MPI_Status* status);
+int MPI_File_read_at(MPI_File fh, long long offset, void* buf, int count,
+                     MPI_Datatype datatype, MPI_Status* status);
+int MPI_File_set_size(MPI_File fh, long long size);
+int MPI_File_set_view(MPI_File fh, long long disp, MPI_Datatype etype,
+                      MPI_Datatype filetype, const char* datarep,
+                      MPI_Info info);
+int MPI_File_write_all(MPI_File fh, const void* buf, int count,
+                       MPI_Datatype datatype, MPI_Status* status);
+int MPI_File_write_at(MPI_File fh, long long offset, const void* buf,
+                      int count, MPI_Datatype datatype, MPI_Status* status);
+
 int MPI_Group_free(MPI_Group* group);
 
 int MPI_Group_incl(MPI_Group group, int n, const int ranks[],
@@ -96,6 +160,13 @@ int MPI_Init(int* argc, char*** argv);
 
 int MPI_Init_thread(int* argc, char*** argv, int required, int* provided);
 
+int MPI_Get_count(const MPI_Status* status, MPI_Datatype datatype,
+                  int* count);
+
+int MPI_Iallreduce(const void* sendbuf, void* recvbuf, int count,
+                   MPI_Datatype datatype, MPI_Op op, MPI_Comm comm,
+                   MPI_Request* request);
+
 int MPI_Initialized(int* flag);
 
 int MPI_Irecv(void* buf, int count, MPI_Datatype datatype, int source,
@@ -104,6 +175,14 @@ int MPI_Irecv(void* buf, int count, MPI_Datatype datatype, int source,
 int MPI_Isend(const void* buf, int count, MPI_Datatype datatype, int dest,
               int tag, MPI_Comm comm, MPI_Request* request);
 
+int MPI_Mprobe(int source, int tag, MPI_Comm comm, MPI_Message* message,
+               MPI_Status* status);
+
+int MPI_Mrecv(void* buf, int count, MPI_Datatype datatype,
+              MPI_Message* message, MPI_Status* status);
+
+int MPI_Query_thread(int* provided);
+
 int MPI_Recv(void* buf, int count, MPI_Datatype datatype, int source,
              int tag, MPI_Comm comm, MPI_Status* status);
 
@@ -124,10 +203,21 @@ int MPI_Sendrecv(const void* sendbuf, int sendcount, MPI_Datatype sendtype,
                  MPI_Datatype recvtype, int source, int recvtag,
                  MPI_Comm comm, MPI_Status *status);
 
+int MPI_Test(MPI_Request* request, int* flag, MPI_Status* status);
+
+int MPI_Testsome(int incount, MPI_Request requests[], int* outcount,
+                 int indices[], MPI_Status statuses[]);
+
 int MPI_Type_commit(MPI_Datatype* datatype);
 
+int MPI_Type_create_hindexed(int count, const int blocklengths[],
+                             const MPI_Aint displacements[],
+                             MPI_Datatype oldtype, MPI_Datatype* newtype);
+
 int MPI_Type_free(MPI_Datatype* datatype);
 
+int MPI_Type_size(MPI_Datatype datatype, int* size);
+
 int MPI_Type_vector(int count, int blocklength, int stride,
                     MPI_Datatype oldtype, MPI_Datatype* newtype);
 
@@ -135,10 +225,15 @@ int MPI_Wait(MPI_Request* request, MPI_Status* status);
 
 int MPI_Waitall(int count, MPI_Request requests[], MPI_Status statuses[]);
 
+int MPI_Waitany(int count, MPI_Request requests[], int* index,
+                MPI_Status* status);
+
 int MPI_Error_string(int errorcode, char* string, int* resultlen);
 
 int MPI_Finalize(void);
 
+int MPI_Finalized(int* flag);
+
 #ifdef __cplusplus
 }
 #endif
@@ -187,6 +282,54 @@ public:
                 #call, slate_mpi_call_, __func__, __FILE__, __LINE__); \
     } while(0)
 
+namespace internal {
+
+bool mpiSerialized();
+bool mpiSerialized(int serialize);
+std::mutex& mpiMutex();
+
+MPI_Datatype vectorType(
+    int count, int blocklength, int stride, MPI_Datatype base_type,
+    bool* cached);
+int64_t vectorTypeCacheSize();
+bool mpiPackTiles();
+bool mpiPackTiles(int pack);
+
+//------------------------------------------------------------------------------
+/// [internal]
+/// Serializes the MPI calls in its scope with those in other MpiGuard
+/// scopes, if mpiSerialized(); otherwise, with MPI_THREAD_MULTIPLE,
+/// does nothing, so threads call MPI concurrently.
+///
+///     {
+///         MpiGuard mpi_guard;
+///         slate_mpi_call( MPI_Bcast( ... ) );
+///     }
+///
+class MpiGuard {
+public:
+    MpiGuard()
+        : locked_( mpiSerialized() )
+    {
+        if (locked_)
+            mpiMutex().lock();
+    }
+
+    ~MpiGuard()
+    {
+        if (locked_)
+            mpiMutex().unlock();
+    }
+
+    MpiGuard( MpiGuard const& ) = delete;
+    MpiGuard& operator = ( MpiGuard const& ) = delete;
+
+private:
+    bool locked_;
+};
+
+} // namespace internal
+
 } // namespace slate
 
 #endif // SLATE_MPI_HH
@@ -21,6 +21,16 @@
 #define slate_omp_default_none
 #endif
 
+// OpenMP 5.0 affinity clause, hinting that a task should run near the
+// given data, e.g., on a thread in the NUMA domain holding an output tile.
+// Older OpenMP versions lack the clause, so it expands to nothing.
+//
+#if _OPENMP >= 201811
+#define slate_omp_affinity( ... ) affinity( __VA_ARGS__ )
+#else
+#define slate_omp_affinity( ... )
+#endif
+
 // Include OpenMP headers
 //
 // Note: There is no _OPENMP guard because SLATE requires OpenMP and
@@ -0,0 +1,36 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef SLATE_INTERNAL_PEER_HH
+#define SLATE_INTERNAL_PEER_HH
+
+#include "blas/device.hh"
+
+#include <cstddef>
+#include <vector>
+
+namespace slate {
+namespace internal {
+
+//------------------------------------------------------------------------------
+// Peer-to-peer access between the devices of a node, e.g., over NVLink or
+// Infinity Fabric, so device-to-device tile copies don't bounce through
+// the host. peer_init enables access between every pair of devices that
+// supports it, once per process, and records the node's topology.
+
+void peer_init();
+
+bool peer_access( int src_device, int dst_device );
+
+std::vector<int> const& peer_source_order( int dst_device );
+
+void peer_memcpy( void* dst, int dst_device,
+                  void const* src, int src_device,
+                  size_t bytes, blas::Queue& queue );
+
+} // namespace internal
+} // namespace slate
+
+#endif // SLATE_INTERNAL_PEER_HH
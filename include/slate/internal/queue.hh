@@ -0,0 +1,59 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef SLATE_INTERNAL_QUEUE_HH
+#define SLATE_INTERNAL_QUEUE_HH
+
+#include "slate/enums.hh"
+
+#include "lapack/device.hh"
+
+#include <complex>
+
+namespace slate {
+namespace internal {
+
+//------------------------------------------------------------------------------
+// Creates and destroys device queues, optionally on a stream with the
+// device's highest priority, so its kernels are scheduled ahead of kernels
+// on default priority streams as soon as resources free up.
+// Queues from new_queue must be destroyed with delete_queue.
+
+lapack::Queue* new_queue( int device, bool high_priority );
+
+void delete_queue( lapack::Queue* queue );
+
+//------------------------------------------------------------------------------
+// Sets the compute mode of the queue's BLAS handle, e.g., to let
+// single precision gemm use TF32 tensor cores.
+
+void set_compute_precision( lapack::Queue* queue, ComputePrecision precision );
+
+//------------------------------------------------------------------------------
+// Complex gemm with the 3M algorithm of the vendor BLAS, for
+// ComputePrecision::Complex3M; available only with cuBLAS.
+
+bool device_gemm3m_available();
+
+void device_gemm3m(
+    Layout layout, Op opA, Op opB,
+    int64_t m, int64_t n, int64_t k,
+    std::complex<float> alpha, std::complex<float> const* A, int64_t lda,
+                               std::complex<float> const* B, int64_t ldb,
+    std::complex<float> beta,  std::complex<float>* C, int64_t ldc,
+    lapack::Queue& queue );
+
+void device_gemm3m(
+    Layout layout, Op opA, Op opB,
+    int64_t m, int64_t n, int64_t k,
+    std::complex<double> alpha, std::complex<double> const* A, int64_t lda,
+                                std::complex<double> const* B, int64_t ldb,
+    std::complex<double> beta,  std::complex<double>* C, int64_t ldc,
+    lapack::Queue& queue );
+
+} // namespace internal
+} // namespace slate
+
+#endif // SLATE_INTERNAL_QUEUE_HH
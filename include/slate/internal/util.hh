@@ -11,6 +11,7 @@
 
 #include "slate/internal/mpi.hh"
 
+#include <algorithm>
 #include <cmath>
 
 #include <blas.hh>
@@ -129,27 +130,68 @@ inline /*constexpr*/ double cabs1(std::complex<double> x)
 }
 
 //------------------------------------------------------------------------------
+/// Barrier for the threads of a panel kernel, e.g., tile::getrf, tile::geqrf.
+/// Threads spin for spin_count polls, which covers the short waits of
+/// panel-sized work without a system call, then yield, then sleep on a
+/// futex (on Linux), so that when cores are oversubscribed or shared by
+/// hyperthreads, waiting threads give up their cores to the threads they
+/// wait for and to other tasks, such as the trailing update.
+///
 class ThreadBarrier {
 public:
-    ThreadBarrier()
-        : count_(0),
-          passed_(0)
+    /// Default number of polls before yielding; a few microseconds.
+    static constexpr int default_spin_count = 2000;
+
+    /// Number of yields before sleeping.
+    static constexpr int yield_count = 16;
+
+    ThreadBarrier( int spin_count = default_spin_count )
+        : count_( 0 ),
+          passed_( 0 ),
+          sleepers_( 0 ),
+          spin_count_( spin_count )
     {}
 
-    void wait(int size)
+    /// Waits until size threads reach the barrier.
+    void wait( int size )
     {
-        int passed_old = passed_;
+        int passed_old = passed_.load();
+
+        if (count_.fetch_add( 1 ) == size - 1) {
+            // Last thread: reset for the next use, then release the others.
+            count_.store( 0, std::memory_order_relaxed );
+            passed_.fetch_add( 1 );
+            if (sleepers_.load() > 0)
+                wake();
+            return;
+        }
 
-        __sync_fetch_and_add(&count_, 1);
-        if (__sync_bool_compare_and_swap(&count_, size, 0))
-            ++passed_;
-        else
-            while (passed_ == passed_old) {}
+        for (int i = 0; i < spin_count_; ++i) {
+            if (passed_.load( std::memory_order_acquire ) != passed_old)
+                return;
+            pause();
+        }
+        block( passed_old );
     }
 
 private:
-    int count_;
+    /// Hints to the CPU that it is in a spin loop.
+    static void pause()
+    {
+        #if defined( __x86_64__ ) || defined( __i386__ )
+            __builtin_ia32_pause();
+        #elif defined( __aarch64__ )
+            asm volatile( "yield" ::: "memory" );
+        #endif
+    }
+
+    void block( int passed_old );
+    void wake();
+
+    std::atomic<int> count_;
     std::atomic<int> passed_;
+    std::atomic<int> sleepers_;
+    int spin_count_;
 };
 
 //------------------------------------------------------------------------------
@@ -262,6 +304,72 @@ inline int64_t num_local_rows_cols(
 /// Use to silence compiler warnings regarding an unused variable var.
 #define SLATE_UNUSED(var)  ((void)var)
 
+namespace internal {
+
+//------------------------------------------------------------------------------
+/// [internal]
+/// Splits the trailing update of a right-looking factorization into tasks
+/// on blocks of block columns, instead of one task on the whole trailing
+/// submatrix. Block c is block columns c*size, ..., (c+1)*size - 1, the
+/// same at every step, so the task of block c at step k+1 waits only for
+/// the task of block c at step k, and the rest of the trailing update of
+/// step k overlaps with the panel and lookahead of step k+1.
+///
+/// At step k, with trailing submatrix j0, ..., nt-1, the task of block c
+/// updates block columns first( c, j0 ), ..., last( c ), and depends on
+/// the sentinels of those two columns, as the task on the whole trailing
+/// submatrix did on j0 and nt-1. Tasks of block c at consecutive steps
+/// share the sentinel last( c ). A column j leaving the trailing submatrix,
+/// e.g., into the lookahead, depends on sentinel( j, j0 ) of the previous
+/// step.
+///
+class ColumnBlocks {
+public:
+    /// @param[in] nt
+    ///     Number of block columns.
+    ///
+    /// @param[in] size
+    ///     Number of block columns per block. Values < 1 are taken as 1;
+    ///     values >= nt give one block, as without blocking.
+    ///
+    ColumnBlocks( int64_t nt, int64_t size )
+        : nt_( nt ),
+          size_( std::max( std::min( size, nt ), int64_t( 1 ) ) )
+    {}
+
+    /// @return number of blocks.
+    int64_t count() const { return ceildiv( nt_, size_ ); }
+
+    /// @return block containing block column j.
+    int64_t block( int64_t j ) const { return j / size_; }
+
+    /// @return first block column of block c in the trailing submatrix
+    /// j0, ..., nt-1.
+    int64_t first( int64_t c, int64_t j0 ) const
+    {
+        return std::max( c * size_, j0 );
+    }
+
+    /// @return last block column of block c.
+    int64_t last( int64_t c ) const
+    {
+        return std::min( (c + 1) * size_, nt_ ) - 1;
+    }
+
+    /// @return block column whose sentinel the task updating column j in
+    /// the trailing submatrix j0, ..., nt-1 depends on.
+    int64_t sentinel( int64_t j, int64_t j0 ) const
+    {
+        return first( block( j ), j0 );
+    }
+
+private:
+    int64_t nt_;
+    int64_t size_;
+};
+
+} // namespace internal
+
 //------------------------------------------------------------------------------
 /// Simple class around wall-clock timer; currently uses MPI_Wtime.
 class Timer
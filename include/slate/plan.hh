@@ -0,0 +1,374 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef SLATE_PLAN_HH
+#define SLATE_PLAN_HH
+
+#include "slate/Matrix.hh"
+#include "slate/HermitianMatrix.hh"
+#include "slate/types.hh"
+
+#include <algorithm>
+#include <vector>
+
+namespace slate {
+
+//------------------------------------------------------------------------------
+/// @namespace slate::plan
+/// Workspace planning: the memory a driver needs on this rank for a given
+/// matrix, distribution, and Options, computed before it starts, so the
+/// driver can reserve it once up front and callers can check it fits.
+///
+namespace plan {
+
+//------------------------------------------------------------------------------
+/// Peak workspace of a driver on this MPI rank.
+///
+/// Device and host workspace tiles come from the matrix's memory pool;
+/// reserving them up front avoids growing the pool with allocDeviceMemory
+/// in the middle of a factorization. Workspace of other matrices the
+/// driver creates internally, e.g., the triangular factors of geqrf, and
+/// device panel workspace of Option::PanelTarget = Devices, are not included.
+///
+struct Workspace {
+    /// Tiles on each device: its local tiles plus copies of panel tiles
+    /// it receives within the lookahead window.
+    std::vector<int64_t> device_tiles;
+
+    /// Host tiles: panel tiles received from other ranks within the
+    /// lookahead window, or Option::HostWorkspaceTiles if larger.
+    int64_t host_tiles = 0;
+
+    /// Bytes of one tile, the largest tile of the matrix.
+    int64_t tile_bytes = 0;
+
+    /// Size and number of the batch arrays on each device.
+    int64_t batch_size = 0;
+    int64_t num_batch_arrays = 0;
+
+    /// Other host memory, e.g., pivots.
+    int64_t host_extra_bytes = 0;
+
+    /// @return bytes of the batch arrays on one device, mirrored in
+    /// pinned host memory.
+    int64_t batchBytes() const
+    {
+        return num_batch_arrays * batch_size
+               * (3*sizeof(void*) + 6*sizeof(int64_t));
+    }
+
+    /// @return bytes of workspace on the given device.
+    int64_t deviceBytes( int device ) const
+    {
+        return device_tiles.at( device ) * tile_bytes + batchBytes();
+    }
+
+    /// @return bytes of workspace on the device that needs the most.
+    int64_t maxDeviceBytes() const
+    {
+        int64_t bytes = 0;
+        for (int device = 0; device < int( device_tiles.size() ); ++device)
+            bytes = std::max( bytes, deviceBytes( device ) );
+        return bytes;
+    }
+
+    /// @return bytes of workspace on the host, including pinned batch arrays.
+    int64_t hostBytes() const
+    {
+        return host_tiles * tile_bytes
+               + int64_t( device_tiles.size() ) * batchBytes()
+               + host_extra_bytes;
+    }
+};
+
+//------------------------------------------------------------------------------
+/// [internal]
+/// Counts the tiles of a right-looking factorization that each device and
+/// the host hold at once, into workspace.
+///
+/// At step k, the trailing update of tile (i, j) on a device needs the
+/// panel tiles (i, k), and (k, j) if row_panel, or for a lower Hermitian
+/// matrix (i, k) and (j, k). Panel tiles that are not already on the
+/// device are copied there; panel tiles from other ranks are received on
+/// the host. Tiles of lookahead+1 steps are held at once.
+///
+/// @param[in] A
+///     Matrix; for lower, only its lower triangle is referenced.
+///
+/// @param[in] steps
+///     Number of steps, usually min( mt, nt ).
+///
+/// @param[in] lookahead
+///     Largest lookahead depth.
+///
+/// @param[in] lower
+///     Whether A is a lower Hermitian matrix, as in potrf.
+///
+/// @param[in] row_panel
+///     Whether the top row of each trailing submatrix is broadcast down
+///     columns, as in getrf.
+///
+/// @param[in] devices
+///     Whether the driver runs on devices.
+///
+/// @param[in,out] ws
+///     On exit, device_tiles, host_tiles, tile_bytes, and batch_size set.
+///
+template <typename scalar_t, typename matrix_t>
+void panel_tiles(
+    matrix_t const& A, int64_t steps, int64_t lookahead,
+    bool lower, bool row_panel, bool devices, Workspace* ws )
+{
+    int64_t mt = A.mt();
+    int64_t nt = A.nt();
+    int num_devices = devices ? A.num_devices() : 0;
+
+    // Location num_devices is the rank, i.e., any of its devices.
+    int num_loc = num_devices + 1;
+    auto owns = [&]( int loc, int64_t i, int64_t j ) {
+        return A.tileIsLocal( i, j )
+               && (loc == num_devices || A.tileDevice( i, j ) == loc);
+    };
+
+    // Last tile column of each row and last tile row of each column that
+    // each location owns, and its number of tiles.
+    std::vector< std::vector<int64_t> > last_col(
+        num_loc, std::vector<int64_t>( mt, -1 ) );
+    std::vector< std::vector<int64_t> > last_row(
+        num_loc, std::vector<int64_t>( nt, -1 ) );
+    std::vector<int64_t> local_tiles( num_loc, 0 );
+    int64_t mb_max = 0, nb_max = 0;
+    for (int64_t j = 0; j < nt; ++j) {
+        nb_max = std::max( nb_max, A.tileNb( j ) );
+        for (int64_t i = (lower ? j : 0); i < mt; ++i) {
+            if (A.tileIsLocal( i, j )) {
+                int dev = num_devices > 0 ? A.tileDevice( i, j ) : num_devices;
+                for (int loc : { dev, num_devices }) {
+                    last_col[ loc ][ i ] = std::max( last_col[ loc ][ i ], j );
+                    last_row[ loc ][ j ] = std::max( last_row[ loc ][ j ], i );
+                    ++local_tiles[ loc ];
+                    if (dev == num_devices)
+                        break;
+                }
+            }
+        }
+    }
+    for (int64_t i = 0; i < mt; ++i)
+        mb_max = std::max( mb_max, A.tileMb( i ) );
+
+    // Panel tiles each location needs at each step.
+    std::vector< std::vector<int64_t> > need(
+        num_loc, std::vector<int64_t>( steps, 0 ) );
+    for (int loc = 0; loc < num_loc; ++loc) {
+        for (int64_t k = 0; k < steps; ++k) {
+            int64_t count = 0;
+            for (int64_t i = k; i < mt; ++i) {
+                if (owns( loc, i, k ))
+                    continue;
+                bool needed;
+                if (! lower)
+                    needed = last_col[ loc ][ i ] > k;
+                else if (i == k)
+                    needed = last_row[ loc ][ k ] > k;
+                else
+                    needed = last_col[ loc ][ i ] > k
+                             || (i < nt && last_row[ loc ][ i ] >= i);
+                if (needed)
+                    ++count;
+            }
+            if (row_panel && ! lower) {
+                for (int64_t j = k+1; j < nt; ++j) {
+                    if (! owns( loc, k, j ) && last_row[ loc ][ j ] > k)
+                        ++count;
+                }
+            }
+            need[ loc ][ k ] = count;
+        }
+    }
+
+    // Largest sum over lookahead+1 consecutive steps.
+    std::vector<int64_t> peak( num_loc, 0 );
+    for (int loc = 0; loc < num_loc; ++loc) {
+        int64_t window = 0;
+        for (int64_t k = 0; k < steps; ++k) {
+            window += need[ loc ][ k ];
+            if (k > lookahead)
+                window -= need[ loc ][ k - lookahead - 1 ];
+            peak[ loc ] = std::max( peak[ loc ], window );
+        }
+    }
+
+    ws->device_tiles.assign( A.num_devices(), 0 );
+    ws->batch_size = 0;
+    for (int dev = 0; dev < num_devices; ++dev) {
+        ws->device_tiles[ dev ] = local_tiles[ dev ] + peak[ dev ];
+        ws->batch_size = std::max( ws->batch_size, local_tiles[ dev ] );
+    }
+    ws->host_tiles = peak[ num_devices ];
+    ws->tile_bytes = mb_max * nb_max * sizeof(scalar_t);
+}
+
+//------------------------------------------------------------------------------
+/// [internal]
+/// Applies the options that override the planned tile counts.
+///
+inline void apply_options(
+    ResolvedOptions const& ropts, bool devices, Workspace* ws )
+{
+    int64_t host_ws = ropts.get<Option::HostWorkspaceTiles>( 0 );
+    ws->host_tiles = std::max( ws->host_tiles, host_ws );
+
+    // A tile cache bounds the tiles on each device.
+    int64_t cache_tiles = ropts.get<Option::DeviceCacheTiles>( 0 );
+    if (devices && cache_tiles > 0)
+        ws->device_tiles.assign( ws->device_tiles.size(), cache_tiles );
+    if (! devices)
+        ws->num_batch_arrays = 0;
+}
+
+//------------------------------------------------------------------------------
+/// Workspace of getrf (partial pivoting) for A, for the given target.
+/// Drivers use this to reserve workspace.
+///
+/// @ingroup gesv_computational
+///
+template <typename scalar_t>
+Workspace getrf(
+    Matrix<scalar_t> const& A, Options const& opts, Target target )
+{
+    ResolvedOptions const ropts( opts );
+    int64_t lookahead = ropts.get<Option::Lookahead>( 1 );
+    int64_t max_lookahead = ropts.get<Option::MaxLookahead>( 4 );
+    if (lookahead == LookaheadAuto)
+        lookahead = max_lookahead;
+    Target panel_target = ropts.get<Option::PanelTarget>( Target::HostTask );
+    bool devices = target == Target::Devices || target == Target::Hybrid;
+
+    Workspace ws;
+    int64_t min_mt_nt = std::min( A.mt(), A.nt() );
+    panel_tiles<scalar_t>( A, min_mt_nt, lookahead, false, true, devices, &ws );
+    ws.num_batch_arrays = 2 + lookahead
+                          + (panel_target == Target::Devices ? 1 : 0);
+    ws.host_extra_bytes = std::min( A.m(), A.n() ) * sizeof(Pivot);
+    apply_options( ropts, devices, &ws );
+    return ws;
+}
+
+//------------------------------------------------------------------------------
+/// Workspace of getrf (partial pivoting) for A, for Option::Target.
+///
+/// @param[in] A
+///     The m-by-n matrix A, distributed as it will be factored.
+///
+/// @param[in] opts
+///     The options that will be passed to getrf.
+///
+/// @return Peak workspace of getrf on this rank.
+///
+/// @ingroup gesv_computational
+///
+template <typename scalar_t>
+Workspace getrf( Matrix<scalar_t> const& A, Options const& opts = Options() )
+{
+    return getrf( A, opts, get_option<Option::Target>( opts, Target::HostTask ) );
+}
+
+//------------------------------------------------------------------------------
+/// Workspace of potrf for A, for the given target.
+/// Drivers use this to reserve workspace.
+///
+/// @ingroup posv_computational
+///
+template <typename scalar_t>
+Workspace potrf(
+    HermitianMatrix<scalar_t> const& A, Options const& opts, Target target )
+{
+    ResolvedOptions const ropts( opts );
+    int64_t lookahead = ropts.get<Option::Lookahead>( 1 );
+    int64_t max_lookahead = ropts.get<Option::MaxLookahead>( 4 );
+    if (lookahead == LookaheadAuto)
+        lookahead = max_lookahead;
+    bool devices = target == Target::Devices || target == Target::Hybrid;
+
+    // Plan for the lower triangle, as potrf factors.
+    HermitianMatrix<scalar_t> A_lower = A;
+    if (A_lower.uplo() == Uplo::Upper)
+        A_lower = conj_transpose( A_lower );
+
+    Workspace ws;
+    panel_tiles<scalar_t>( A_lower, A_lower.nt(), lookahead, true, false,
+                           devices, &ws );
+    ws.num_batch_arrays = 3 + lookahead;
+    apply_options( ropts, devices, &ws );
+    return ws;
+}
+
+//------------------------------------------------------------------------------
+/// Workspace of potrf for A, for Option::Target.
+///
+/// @param[in] A
+///     The n-by-n Hermitian matrix A, distributed as it will be factored.
+///
+/// @param[in] opts
+///     The options that will be passed to potrf.
+///
+/// @return Peak workspace of potrf on this rank.
+///
+/// @ingroup posv_computational
+///
+template <typename scalar_t>
+Workspace potrf(
+    HermitianMatrix<scalar_t> const& A, Options const& opts = Options() )
+{
+    return potrf( A, opts, get_option<Option::Target>( opts, Target::HostTask ) );
+}
+
+//------------------------------------------------------------------------------
+/// Workspace of geqrf for A, for the given target.
+/// Drivers use this to reserve workspace.
+///
+/// @ingroup geqrf_computational
+///
+template <typename scalar_t>
+Workspace geqrf(
+    Matrix<scalar_t> const& A, Options const& opts, Target target )
+{
+    ResolvedOptions const ropts( opts );
+    int64_t lookahead = get_lookahead( opts );
+    bool devices = target == Target::Devices || target == Target::Hybrid;
+
+    // The V panel is broadcast along rows, and the triangle-triangle
+    // reductions exchange tiles of the top row down columns.
+    Workspace ws;
+    int64_t min_mt_nt = std::min( A.mt(), A.nt() );
+    panel_tiles<scalar_t>( A, min_mt_nt, lookahead, false, true, devices, &ws );
+    ws.num_batch_arrays = 3 + lookahead;
+    apply_options( ropts, devices, &ws );
+    return ws;
+}
+
+//------------------------------------------------------------------------------
+/// Workspace of geqrf for A, for Option::Target.
+///
+/// @param[in] A
+///     The m-by-n matrix A, distributed as it will be factored.
+///
+/// @param[in] opts
+///     The options that will be passed to geqrf.
+///
+/// @return Peak workspace of geqrf on this rank, for A only.
+///
+/// @ingroup geqrf_computational
+///
+template <typename scalar_t>
+Workspace geqrf( Matrix<scalar_t> const& A, Options const& opts = Options() )
+{
+    return geqrf( A, opts, get_option<Option::Target>( opts, Target::HostTask ) );
+}
+
+} // namespace plan
+} // namespace slate
+
+#endif // SLATE_PLAN_HH
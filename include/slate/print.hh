@@ -115,6 +115,15 @@ void print(
     std::vector<scalar_type> const& x,
     slate::Options const& opts = Options());
 
+//------------------------------------------------------------------------------
+// Per-rank files
+template <typename scalar_t>
+void dump(
+    const char* label,
+    slate::BaseMatrix<scalar_t>& A,
+    std::string const& prefix,
+    slate::Options const& opts = Options());
+
 } // namespace slate
 
 #endif // SLATE_PRINT_HH
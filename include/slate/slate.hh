@@ -15,7 +15,17 @@
 #include "slate/TriangularBandMatrix.hh"
 #include "slate/HermitianBandMatrix.hh"
 
+#include "slate/TLRMatrix.hh"
+
+#include "slate/Checkpoint.hh"
+#include "slate/Counters.hh"
+#include "slate/InfoRequest.hh"
+#include "slate/GrowthStats.hh"
+#include "slate/PanelCallback.hh"
+#include "slate/DeviceGraph.hh"
+#include "slate/Tuning.hh"
 #include "slate/func.hh"
+#include "slate/plan.hh"
 #include "slate/types.hh"
 #include "slate/print.hh"
 
@@ -48,6 +58,13 @@ void add(
     scalar_t beta,  Matrix<scalar_t>& B,
     Options const& opts = Options());
 
+// Mixed precision: A in lower precision than B.
+template <typename src_scalar_t, typename scalar_t>
+void add(
+    scalar_t alpha, Matrix<src_scalar_t>& A,
+    scalar_t beta,  Matrix<scalar_t>& B,
+    Options const& opts = Options());
+
 template <typename scalar_t>
 void add(
      scalar_t alpha, BaseTrapezoidMatrix<scalar_t>& A,
@@ -113,6 +130,13 @@ void scale_row_col(
     Matrix<scalar_t>& A,
     Options const& opts = Options());
 
+// Hermitian matrix, A = diag(S) A diag(S).
+template <typename scalar_t, typename scalar_t2>
+void scale_row_col(
+    std::vector< scalar_t2 > const& S,
+    HermitianMatrix<scalar_t>& A,
+    Options const& opts = Options());
+
 //-----------------------------------------
 // set()
 template <typename scalar_t>
@@ -167,11 +191,13 @@ void set(
 template<typename scalar_t>
 void gerbt(Matrix<scalar_t>& U,
            Matrix<scalar_t>& A,
-           Matrix<scalar_t>& V);
+           Matrix<scalar_t>& V,
+           Options const& opts = Options());
 
 template<typename scalar_t>
 void gerbt(Matrix<scalar_t>& U,
-           Matrix<scalar_t>& A);
+           Matrix<scalar_t>& A,
+           Options const& opts = Options());
 
 //-----------------------------------------
 // gbmm()
@@ -209,6 +235,24 @@ void gemmC(
     scalar_t beta,  Matrix<scalar_t>& C,
     Options const& opts = Options());
 
+//-----------------------------------------
+// gemmLayered()
+template <typename scalar_t>
+void gemmLayered(
+    scalar_t alpha, Matrix<scalar_t>& A,
+                    Matrix<scalar_t>& B,
+    scalar_t beta,  Matrix<scalar_t>& C,
+    Options const& opts = Options());
+
+//-----------------------------------------
+// gemmGrouped()
+template <typename scalar_t>
+void gemmGrouped(
+    std::vector<scalar_t> const& alpha, std::vector< Matrix<scalar_t> >& A,
+                                        std::vector< Matrix<scalar_t> >& B,
+    std::vector<scalar_t> const& beta,  std::vector< Matrix<scalar_t> >& C,
+    Options const& opts = Options());
+
 //-----------------------------------------
 // hbmm()
 template <typename scalar_t>
@@ -341,6 +385,15 @@ void trsmB(
                               Matrix<scalar_t>& B,
     Options const& opts = Options());
 
+//-----------------------------------------
+// trsmInv()
+template <typename scalar_t>
+void trsmInv(
+    Side side,
+    scalar_t alpha, TriangularMatrix<scalar_t>& A,
+                              Matrix<scalar_t>& B,
+    Options const& opts = Options());
+
 //-----------------------------------------
 // trtri()
 template <typename scalar_t>
@@ -428,6 +481,32 @@ void redistribute(
     Matrix<scalar_t>& B,
     Options const& opts = Options());
 
+//-----------------------------------------
+// transpose(), conj_transpose()
+template <typename scalar_t>
+void transpose(
+    Matrix<scalar_t>& A,
+    Matrix<scalar_t>& B,
+    Options const& opts = Options());
+
+template <typename scalar_t>
+void conj_transpose(
+    Matrix<scalar_t>& A,
+    Matrix<scalar_t>& B,
+    Options const& opts = Options());
+
+//-----------------------------------------
+// read(), write()
+template <typename scalar_t>
+void read(
+    std::string const& filename, Matrix<scalar_t>& A,
+    Options const& opts = Options());
+
+template <typename scalar_t>
+void write(
+    std::string const& filename, Matrix<scalar_t>& A,
+    Options const& opts = Options());
+
 //-----------------------------------------
 // syr2k()
 template <typename scalar_t>
@@ -475,6 +554,16 @@ norm(
     return norm< TrapezoidMatrix<scalar_t> >( trnorm, A, opts );
 }
 
+//-----------------------------------------
+// norms()
+// several norms of a general matrix together
+template <typename scalar_t>
+void norms(
+    std::vector<Norm> const& in_norms,
+    Matrix<scalar_t>& A,
+    blas::real_type<scalar_t>* values,
+    Options const& opts = Options());
+
 //-----------------------------------------
 // colNorms()
 // all cols max norm
@@ -485,6 +574,27 @@ void colNorms(
     blas::real_type<typename matrix_type::value_type>* values,
     Options const& opts = Options());
 
+//-----------------------------------------
+// geequ(), poequ()
+// row and column scaling factors to equilibrate A
+template <typename scalar_t>
+int64_t geequ(
+    Matrix<scalar_t>& A,
+    std::vector< blas::real_type<scalar_t> >& R,
+    std::vector< blas::real_type<scalar_t> >& C,
+    blas::real_type<scalar_t>& rowcnd,
+    blas::real_type<scalar_t>& colcnd,
+    blas::real_type<scalar_t>& amax,
+    Options const& opts = Options());
+
+template <typename scalar_t>
+int64_t poequ(
+    HermitianMatrix<scalar_t>& A,
+    std::vector< blas::real_type<scalar_t> >& S,
+    blas::real_type<scalar_t>& scond,
+    blas::real_type<scalar_t>& amax,
+    Options const& opts = Options());
+
 //------------------------------------------------------------------------------
 // Linear systems
 
@@ -576,6 +686,12 @@ int64_t getrf(
     Matrix<scalar_t>& A, Pivots& pivots,
     Options const& opts = Options());
 
+template <typename scalar_t>
+int64_t getrf(
+    Matrix<scalar_t>& A, Pivots& pivots,
+    Matrix<scalar_t>& B,
+    Options const& opts = Options());
+
 //-----------------------------------------
 // getrf_nopiv()
 template <typename scalar_t>
@@ -716,6 +832,12 @@ int64_t potrf(
     HermitianMatrix<scalar_t>& A,
     Options const& opts = Options());
 
+template <typename scalar_t>
+int64_t potrf(
+    HermitianMatrix<scalar_t>& A,
+    Matrix<scalar_t>& B,
+    Options const& opts = Options());
+
 // forward real-symmetric matrices to potrf;
 // disabled for complex
 template <typename scalar_t>
@@ -728,6 +850,15 @@ int64_t potrf(
     return potrf( AH, opts );
 }
 
+//-----------------------------------------
+// potrf_update()
+template <typename scalar_t>
+int64_t potrf_update(
+    HermitianMatrix<scalar_t>& A,
+    Matrix<scalar_t>& V,
+    int sign,
+    Options const& opts = Options());
+
 //-----------------------------------------
 // pbtrs()
 template <typename scalar_t>
@@ -768,6 +899,42 @@ void potri(
 // forward real-symmetric matrices to potrs;
 // disabled for complex
 
+//-----------------------------------------
+// Tile low-rank (TLR) Cholesky
+
+//-----------------------------------------
+// compress()
+template <typename scalar_t>
+void compress(
+    HermitianMatrix<scalar_t>& A,
+    TLRMatrix<scalar_t>& T,
+    Options const& opts = Options());
+
+//-----------------------------------------
+// potrf()
+template <typename scalar_t>
+int64_t potrf(
+    TLRMatrix<scalar_t>& A,
+    Options const& opts = Options());
+
+//-----------------------------------------
+// trsm()
+template <typename scalar_t>
+void trsm(
+    Op op, scalar_t alpha,
+    TLRMatrix<scalar_t>& L,
+       Matrix<scalar_t>& B,
+    Options const& opts = Options());
+
+//-----------------------------------------
+// gemm()
+template <typename scalar_t>
+void gemm(
+    scalar_t alpha, TLRMatrix<scalar_t>& A,
+                       Matrix<scalar_t>& B,
+    scalar_t beta,     Matrix<scalar_t>& C,
+    Options const& opts = Options());
+
 //-----------------------------------------
 // Symmetric indefinite -- block Aasen's
 
@@ -876,6 +1043,28 @@ void gels_cholqr(
     Matrix<scalar_t>& BX,
     Options const& opts = Options());
 
+// Using CGLS preconditioned by a sketch
+template <typename scalar_t>
+void gels_sketch(
+    Matrix<scalar_t>& A,
+    Matrix<scalar_t>& BX,
+    Options const& opts = Options());
+
+// Using low precision QR and iterative refinement
+template <typename scalar_t>
+void gels_mixed(
+    Matrix<scalar_t>& A,
+    Matrix<scalar_t>& BX,
+    int& iter,
+    Options const& opts = Options());
+
+template <typename scalar_hi, typename scalar_lo>
+void gels_mixed(
+    Matrix<scalar_hi>& A,
+    Matrix<scalar_hi>& BX,
+    int& iter,
+    Options const& opts = Options());
+
 // Routine selection
 template <typename scalar_t>
 void gels(
@@ -902,6 +1091,25 @@ void unmqr(
     Matrix<scalar_t>& C,
     Options const& opts = Options());
 
+//-----------------------------------------
+// geqrf_add_cols(), geqrf_delete_cols(), geqrf_add_rows()
+template <typename scalar_t>
+void geqrf_add_cols(
+    Matrix<scalar_t>& A, TriangularFactors<scalar_t>& T,
+    Matrix<scalar_t>& B, TriangularFactors<scalar_t>& TB,
+    Options const& opts = Options());
+
+template <typename scalar_t>
+void geqrf_delete_cols(
+    Matrix<scalar_t>& A, int64_t j1, int64_t j2,
+    Matrix<scalar_t>& R, TriangularFactors<scalar_t>& TR,
+    Options const& opts = Options());
+
+template <typename scalar_t>
+void geqrf_add_rows(
+    Matrix<scalar_t>& A, Matrix<scalar_t>& C,
+    Options const& opts = Options());
+
 //-----------------------------------------
 // cholQR
 template <typename scalar_t>
@@ -962,6 +1170,58 @@ void svd_vals(
     svd( A, Sigma, opts );
 }
 
+/// Partial SVD, computing singular values il to iu, largest first,
+/// by bisection and inverse iteration.
+template <typename scalar_t>
+void svdx(
+    int64_t il, int64_t iu,
+    Matrix<scalar_t> A,
+    std::vector< blas::real_type<scalar_t> >& Sigma,
+    Matrix<scalar_t>& U,
+    Matrix<scalar_t>& VT,
+    Options const& opts = Options());
+
+/// Without U and VT, compute only singular values il to iu.
+template <typename scalar_t>
+void svdx(
+    int64_t il, int64_t iu,
+    Matrix<scalar_t> A,
+    std::vector< blas::real_type<scalar_t> >& Sigma,
+    Options const& opts = Options())
+{
+    Matrix<scalar_t> U;
+    Matrix<scalar_t> VT;
+    svdx( il, iu, A, Sigma, U, VT, opts );
+}
+
+/// Randomized truncated SVD, computing the k largest singular values.
+template <typename scalar_t>
+void svd_rand(
+    Matrix<scalar_t>& A, int64_t k,
+    std::vector< blas::real_type<scalar_t> >& Sigma,
+    Matrix<scalar_t>& U,
+    Matrix<scalar_t>& VT,
+    Options const& opts = Options());
+
+/// Without U and VT, compute only the k largest singular values.
+template <typename scalar_t>
+void svd_rand(
+    Matrix<scalar_t>& A, int64_t k,
+    std::vector< blas::real_type<scalar_t> >& Sigma,
+    Options const& opts = Options())
+{
+    Matrix<scalar_t> U;
+    Matrix<scalar_t> VT;
+    svd_rand( A, k, Sigma, U, VT, opts );
+}
+
+/// Polar decomposition A = U_p H, by the QDWH iteration.
+template <typename scalar_t>
+void polar(
+    Matrix<scalar_t>& A,
+    Matrix<scalar_t>& H,
+    Options const& opts = Options());
+
 template <typename scalar_t>
 [[deprecated( "Use svd instead. To be removed 2024-07." )]]
 void gesvd(
@@ -1047,6 +1307,50 @@ void heev(
     heev( A, Lambda, Z, opts );
 }
 
+//-----------------------------------------
+// heev_mixed: low precision heev, refined in high precision.
+template <typename scalar_t>
+void heev_mixed(
+    HermitianMatrix<scalar_t>& A,
+    std::vector< blas::real_type<scalar_t> >& Lambda,
+    Matrix<scalar_t>& Z,
+    int& iter,
+    Options const& opts = Options());
+
+template <typename scalar_hi, typename scalar_lo>
+void heev_mixed(
+    HermitianMatrix<scalar_hi>& A,
+    std::vector< blas::real_type<scalar_hi> >& Lambda,
+    Matrix<scalar_hi>& Z,
+    int& iter,
+    Options const& opts = Options());
+
+//-----------------------------------------
+// heevx: selected eigenvalues, by index or value range.
+template <typename scalar_t>
+void heevx(
+    Range range,
+    blas::real_type<scalar_t> vl, blas::real_type<scalar_t> vu,
+    int64_t il, int64_t iu,
+    HermitianMatrix<scalar_t>& A,
+    std::vector< blas::real_type<scalar_t> >& Lambda,
+    Matrix<scalar_t>& Z,
+    Options const& opts = Options());
+
+/// Without Z, compute only eigenvalues.
+template <typename scalar_t>
+void heevx(
+    Range range,
+    blas::real_type<scalar_t> vl, blas::real_type<scalar_t> vu,
+    int64_t il, int64_t iu,
+    HermitianMatrix<scalar_t>& A,
+    std::vector< blas::real_type<scalar_t> >& Lambda,
+    Options const& opts = Options())
+{
+    Matrix<scalar_t> Z;
+    heevx( range, vl, vu, il, iu, A, Lambda, Z, opts );
+}
+
 //-----------------------------------------
 // forward real-symmetric matrices to heev;
 // disabled for complex
@@ -1242,6 +1546,18 @@ void stedc_secular(
     int64_t* itype,
     Options const& opts = Options() );
 
+template <typename real_t>
+void stedc_secular(
+    int64_t nsecular, int64_t n,
+    real_t rho,
+    real_t* D,
+    real_t* z,
+    real_t* Lambda,
+    Matrix<real_t>& U,
+    int64_t* itype,
+    MPI_Comm comm,
+    Options const& opts = Options() );
+
 template <typename real_t>
 void stedc_solve(
     std::vector<real_t>& D, std::vector<real_t>& E,
@@ -1263,6 +1579,13 @@ void stedc_z_vector(
     std::vector<real_t>& z,
     Options const& opts = Options());
 
+template <typename real_t>
+void stedc_z_vector(
+    Matrix<real_t>& Q,
+    std::vector<real_t>& z,
+    MPI_Comm comm,
+    Options const& opts = Options());
+
 //-----------------------------------------
 // unmbr_tb2bd()
 template <typename scalar_t>
@@ -1280,6 +1603,27 @@ void sterf(
     std::vector< scalar_t >& E,
     Options const& opts = Options());
 
+//-----------------------------------------
+// stebz()
+template <typename real_t>
+void stebz(
+    Range range, real_t vl, real_t vu, int64_t il, int64_t iu,
+    std::vector<real_t> const& D,
+    std::vector<real_t> const& E,
+    std::vector<real_t>& Lambda,
+    int64_t& il_out,
+    Options const& opts = Options());
+
+//-----------------------------------------
+// stein()
+template <typename scalar_t>
+void stein(
+    std::vector< blas::real_type<scalar_t> > const& D,
+    std::vector< blas::real_type<scalar_t> > const& E,
+    std::vector< blas::real_type<scalar_t> > const& Lambda,
+    Matrix<scalar_t>& Z,
+    Options const& opts = Options());
+
 //-----------------------------------------
 // steqr2()
 template <typename scalar_t>
@@ -1350,4 +1694,20 @@ void trcondest(
 // Simplified C++ API
 #include "simplified_api.hh"
 
+//-----------------------------------------
+// Asynchronous API
+#include "slate/async.hh"
+
+//-----------------------------------------
+// Batched API for many small problems
+#include "slate/batch.hh"
+
+//-----------------------------------------
+// Factorization handles for repeated solves
+#include "slate/Factorization.hh"
+
+//-----------------------------------------
+// Lazy expressions of fused operations
+#include "slate/Expression.hh"
+
 #endif // SLATE_HH
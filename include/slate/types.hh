@@ -20,6 +20,12 @@
 
 namespace slate {
 
+class Checkpoint;
+class Counters;
+class InfoRequest;
+class GrowthStats;
+class PanelCallback;
+
 //------------------------------------------------------------------------------
 /// Values for options to pass to SLATE routines.
 /// Value can be:
@@ -27,6 +33,11 @@ namespace slate {
 /// - int64_t
 /// - double
 /// - Target enum
+/// - Counters pointer
+/// - Checkpoint pointer
+/// - InfoRequest pointer
+/// - GrowthStats pointer
+/// - PanelCallback pointer
 /// @see Option
 ///
 class OptionValue {
@@ -71,6 +82,41 @@ public:
     OptionValue( MethodSVD m ) : i_( int( m ) )
     {}
 
+    OptionValue( BcastPrecision m ) : i_( int( m ) )
+    {}
+
+    OptionValue( TaskRuntime m ) : i_( int( m ) )
+    {}
+
+    OptionValue( QueuePriority m ) : i_( int( m ) )
+    {}
+
+    OptionValue( ComputePrecision m ) : i_( int( m ) )
+    {}
+
+    OptionValue( GramPrecision m ) : i_( int( m ) )
+    {}
+
+    OptionValue( Counters* counters )
+        : i_( reinterpret_cast<intptr_t>( counters ) )
+    {}
+
+    OptionValue( Checkpoint* checkpoint )
+        : i_( reinterpret_cast<intptr_t>( checkpoint ) )
+    {}
+
+    OptionValue( InfoRequest* request )
+        : i_( reinterpret_cast<intptr_t>( request ) )
+    {}
+
+    OptionValue( GrowthStats* growth )
+        : i_( reinterpret_cast<intptr_t>( growth ) )
+    {}
+
+    OptionValue( PanelCallback* callback )
+        : i_( reinterpret_cast<intptr_t>( callback ) )
+    {}
+
     union {
         int64_t i_;
         double d_;
@@ -209,7 +255,7 @@ struct is_complex< std::complex<T> >:
 ///     Default option value if option is not found in map.
 ///
 template <typename T>
-T get_option( Options opts, Option option, T defval )
+T get_option( Options const& opts, Option option, T defval )
 {
     T retval;
     auto search = opts.find( option );
@@ -224,7 +270,7 @@ T get_option( Options opts, Option option, T defval )
 //----------------------------
 /// Specialization for double.
 template <>
-inline double get_option<double>( Options opts, Option option, double defval )
+inline double get_option<double>( Options const& opts, Option option, double defval )
 {
     double retval;
     auto search = opts.find( option );
@@ -251,10 +297,45 @@ template<> struct OptValueType<Option::Depth>              { using T = int64_t;
 template<> struct OptValueType<Option::MaxIterations>      { using T = int64_t; };
 template<> struct OptValueType<Option::UseFallbackSolver>  { using T = bool; };
 template<> struct OptValueType<Option::PivotThreshold>     { using T = double; };
+template<> struct OptValueType<Option::HostWorkspaceTiles> { using T = int64_t; };
+template<> struct OptValueType<Option::DeviceCacheTiles>   { using T = int64_t; };
+template<> struct OptValueType<Option::HostFirstTouch>     { using T = bool; };
+template<> struct OptValueType<Option::HostTileArena>      { using T = bool; };
+template<> struct OptValueType<Option::BcastPacked>        { using T = bool; };
+template<> struct OptValueType<Option::ProgressThread>     { using T = bool; };
+template<> struct OptValueType<Option::BcastPrecision>     { using T = BcastPrecision; };
+template<> struct OptValueType<Option::Counters>           { using T = Counters*; };
+template<> struct OptValueType<Option::TaskRuntime>        { using T = TaskRuntime; };
+template<> struct OptValueType<Option::MaxLookahead>       { using T = int64_t; };
+template<> struct OptValueType<Option::Layers>             { using T = int64_t; };
+template<> struct OptValueType<Option::TreeArity>          { using T = int64_t; };
+template<> struct OptValueType<Option::Oversampling>       { using T = int64_t; };
+template<> struct OptValueType<Option::PowerIterations>    { using T = int64_t; };
+template<> struct OptValueType<Option::FactorsResident>    { using T = bool; };
+template<> struct OptValueType<Option::EstimateColumns>    { using T = int64_t; };
+template<> struct OptValueType<Option::Checkpoint>         { using T = Checkpoint*; };
+template<> struct OptValueType<Option::SmallTiles>         { using T = int64_t; };
+template<> struct OptValueType<Option::TrailingBlock>      { using T = int64_t; };
+template<> struct OptValueType<Option::GMRESSteps>         { using T = int64_t; };
+template<> struct OptValueType<Option::BcastPartitioned>   { using T = bool; };
+template<> struct OptValueType<Option::TailShrink>         { using T = int64_t; };
+template<> struct OptValueType<Option::Equilibrate>        { using T = bool; };
+template<> struct OptValueType<Option::InfoRequest>        { using T = InfoRequest*; };
+template<> struct OptValueType<Option::PanelSubTile>       { using T = int64_t; };
+template<> struct OptValueType<Option::GrowthStats>        { using T = GrowthStats*; };
+template<> struct OptValueType<Option::PanelCores>         { using T = int64_t; };
+template<> struct OptValueType<Option::FusedSolve>         { using T = bool; };
+template<> struct OptValueType<Option::PanelCallback>      { using T = PanelCallback*; };
+template<> struct OptValueType<Option::GramPrecision>      { using T = GramPrecision; };
+template<> struct OptValueType<Option::DeviceStealing>     { using T = bool; };
+template<> struct OptValueType<Option::QueuePriority>      { using T = QueuePriority; };
+template<> struct OptValueType<Option::PanelTarget>        { using T = Target; };
+template<> struct OptValueType<Option::ComputePrecision>   { using T = ComputePrecision; };
 template<> struct OptValueType<Option::PrintVerbose>       { using T = int; };
 template<> struct OptValueType<Option::PrintEdgeItems>     { using T = int; };
 template<> struct OptValueType<Option::PrintWidth>         { using T = int; };
 template<> struct OptValueType<Option::PrintPrecision>     { using T = int; };
+template<> struct OptValueType<Option::PrintBinary>        { using T = bool; };
 template<> struct OptValueType<Option::MethodCholQR>       { using T = MethodCholQR; };
 template<> struct OptValueType<Option::MethodEig>          { using T = MethodEig; };
 template<> struct OptValueType<Option::MethodGels>         { using T = MethodGels; };
@@ -265,11 +346,93 @@ template<> struct OptValueType<Option::MethodTrsm>         { using T = MethodTrs
 template<> struct OptValueType<Option::MethodSVD>          { using T = MethodSVD; };
 
 template <slate::Option option>
-auto get_option( Options opts, typename OptValueType<option>::T defval )
+auto get_option( Options const& opts, typename OptValueType<option>::T defval )
 {
     return get_option<typename OptValueType<option>::T>( opts, option, defval );
 }
 
+//------------------------------------------------------------------------------
+/// @return Option::Lookahead, for routines with a fixed lookahead depth;
+/// LookaheadAuto, which only getrf and potrf adapt, gives the default.
+///
+inline int64_t get_lookahead( Options const& opts, int64_t defval = 1 )
+{
+    int64_t lookahead = get_option<Option::Lookahead>( opts, defval );
+    return lookahead == LookaheadAuto ? defval : lookahead;
+}
+
+//------------------------------------------------------------------------------
+/// @return Option::Target, for routines without a hybrid implementation;
+/// Target::Hybrid, which only getrf, potrf, and geqrf split between the
+/// host and devices, gives Target::Devices.
+///
+inline Target get_target( Options const& opts,
+                          Target defval = Target::HostTask )
+{
+    Target target = get_option<Option::Target>( opts, defval );
+    return target == Target::Hybrid ? Target::Devices : target;
+}
+
+//------------------------------------------------------------------------------
+/// Options resolved from an Options map in one pass into a flat array
+/// indexed by Option, for drivers that read many options.
+/// Each get is then an array access, with no map traversal, and
+/// resolving allocates nothing.
+///
+/// Example:
+///
+///     ResolvedOptions const ropts( opts );
+///     int64_t lookahead = ropts.get<Option::Lookahead>( 1 );
+///
+class ResolvedOptions {
+public:
+    explicit ResolvedOptions( Options const& opts )
+    {
+        for (bool& s : is_set_)
+            s = false;
+        for (auto const& opt : opts) {
+            int index = int( opt.first );
+            if (0 <= index && index < num_options) {
+                values_[ index ] = opt.second;
+                is_set_[ index ] = true;
+            }
+        }
+    }
+
+    /// @return whether the option was set in the map.
+    bool isSet( Option option ) const
+    {
+        return is_set_[ int( option ) ];
+    }
+
+    /// @return the option's value, or defval if it was not set,
+    /// as get_option< option >( opts, defval ) returns.
+    template <Option option>
+    typename OptValueType<option>::T get(
+        typename OptValueType<option>::T defval ) const
+    {
+        using T = typename OptValueType<option>::T;
+        if (! isSet( option ))
+            return defval;
+        return value<T>( values_[ int( option ) ] );
+    }
+
+private:
+    template <typename T>
+    static T value( OptionValue const& v ) { return T( v.i_ ); }
+
+    static constexpr int num_options = int( Option::MethodSVD ) + 1;
+
+    OptionValue values_[ num_options ];
+    bool is_set_[ num_options ];
+};
+
+template <>
+inline double ResolvedOptions::value<double>( OptionValue const& v )
+{
+    return v.d_;
+}
+
 //------------------------------------------------------------------------------
 // For %lld printf-style printing, cast to llong; guaranteed >= 64 bits.
 using llong = long long;
@@ -0,0 +1,36 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack_cache.hh"
+
+namespace slate {
+namespace lapack_api {
+
+// -----------------------------------------------------------------------------
+// C interfaces (FORTRAN_UPPER, FORTRAN_LOWER, FORTRAN_UNDERSCORE)
+
+#define slate_lapack_cache_invalidate BLAS_FORTRAN_NAME( slate_lapack_cache_invalidate, SLATE_LAPACK_CACHE_INVALIDATE )
+#define slate_lapack_cache_clear BLAS_FORTRAN_NAME( slate_lapack_cache_clear, SLATE_LAPACK_CACHE_CLEAR )
+
+/// Drops cached device copies of arrays containing address a. Call after
+/// changing an array that later calls read, if the change may be too
+/// small for the cache's checksum to detect.
+extern "C" void slate_lapack_cache_invalidate(void* a)
+{
+    char const* begin = static_cast<char const*>( a );
+    cache_invalidate( begin, begin + 1 );
+}
+
+/// Drops all cached device copies, freeing their device memory.
+extern "C" void slate_lapack_cache_clear()
+{
+    MatrixCache< float >::instance().clear();
+    MatrixCache< double >::instance().clear();
+    MatrixCache< std::complex<float> >::instance().clear();
+    MatrixCache< std::complex<double> >::instance().clear();
+}
+
+} // namespace lapack_api
+} // namespace slate
@@ -0,0 +1,207 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef SLATE_LAPACK_API_CACHE_HH
+#define SLATE_LAPACK_API_CACHE_HH
+
+#include "lapack_slate.hh"
+
+#include <cstring>
+#include <list>
+#include <mutex>
+#include <tuple>
+
+namespace slate {
+namespace lapack_api {
+
+//------------------------------------------------------------------------------
+/// @return max number of input matrices kept resident on the devices
+/// between calls, from env SLATE_LAPACK_CACHE; default 0 disables the cache.
+inline int64_t slate_lapack_set_cache()
+{
+    int64_t num_entries = 0;
+    char* cachestr = std::getenv("SLATE_LAPACK_CACHE");
+    if (cachestr)
+        num_entries = std::max( (int64_t)strtol(cachestr, NULL, 0), int64_t(0) );
+    return num_entries;
+}
+
+//------------------------------------------------------------------------------
+/// @return dimension up to which routines call the vendor BLAS or LAPACK
+/// directly instead of SLATE, from env SLATE_LAPACK_SMALL; default 64.
+/// 0 always uses SLATE.
+inline int64_t slate_lapack_set_small()
+{
+    int64_t small = 64;
+    char* smallstr = std::getenv("SLATE_LAPACK_SMALL");
+    if (smallstr)
+        small = std::max( (int64_t)strtol(smallstr, NULL, 0), int64_t(0) );
+    return small;
+}
+
+//------------------------------------------------------------------------------
+/// Cache of SLATE matrices wrapping LAPACK arrays that routines only read,
+/// such as A and B in gemm or the LU factors in getrs, with their tiles
+/// held on the devices. A later call on the same array, with the same
+/// dimensions, lda, and nb, reuses the device tiles instead of copying
+/// the array to the devices again.
+///
+/// The cache cannot see when the application changes an array, so an
+/// entry is dropped when:
+/// - a sampled checksum of the array differs from when it was cached,
+///   which catches most updates, but not changes to a few unsampled
+///   entries;
+/// - a lapack_api routine writes memory overlapping the array;
+/// - the application calls slate_lapack_cache_invalidate() on the array,
+///   or slate_lapack_cache_clear().
+/// Least recently used entries are dropped beyond SLATE_LAPACK_CACHE
+/// entries per precision.
+///
+template <typename scalar_t>
+class MatrixCache {
+public:
+    static MatrixCache& instance()
+    {
+        static MatrixCache cache;
+        return cache;
+    }
+
+    //--------------------------------------------------------------------------
+    /// @return matrix wrapping the m-by-n array a, with local tiles on
+    /// the devices if target is Devices. Reuses the cached matrix if a is
+    /// unchanged; creates and caches it otherwise.
+    /// If the cache is disabled or the target is not Devices, returns
+    /// Matrix::fromLAPACK.
+    slate::Matrix<scalar_t> get(
+        int64_t m, int64_t n, scalar_t* a, int64_t lda, int64_t nb,
+        slate::Target target )
+    {
+        if (max_entries_ == 0 || target != slate::Target::Devices
+            || m == 0 || n == 0) {
+            return slate::Matrix<scalar_t>::fromLAPACK(
+                m, n, a, lda, nb, 1, 1, MPI_COMM_WORLD );
+        }
+
+        Key key = { a, m, n, lda, nb };
+        uint64_t sum = checksum( m, n, a, lda );
+
+        std::lock_guard<std::mutex> guard( lock_ );
+        for (auto iter = entries_.begin(); iter != entries_.end(); ++iter) {
+            if (iter->key == key) {
+                if (iter->checksum == sum) {
+                    // move to the front as most recently used
+                    entries_.splice( entries_.begin(), entries_, iter );
+                    return iter->A;
+                }
+                entries_.erase( iter );
+                break;
+            }
+        }
+
+        auto A = slate::Matrix<scalar_t>::fromLAPACK(
+            m, n, a, lda, nb, 1, 1, MPI_COMM_WORLD );
+        // Tiles on hold survive the routines' release of workspace.
+        A.tileGetAndHoldAllOnDevices( slate::LayoutConvert::ColMajor );
+
+        entries_.push_front( { key, sum, A } );
+        while (int64_t( entries_.size() ) > max_entries_)
+            entries_.pop_back();
+        return A;
+    }
+
+    //--------------------------------------------------------------------------
+    /// Drops entries for arrays overlapping memory [begin, end).
+    void invalidate( void const* begin, void const* end )
+    {
+        std::lock_guard<std::mutex> guard( lock_ );
+        entries_.remove_if( [begin, end]( Entry const& entry ) {
+            auto a = std::get<0>( entry.key );
+            auto a_end = a + std::get<3>( entry.key )*(std::get<2>( entry.key ) - 1)
+                           + std::get<1>( entry.key );
+            return (void const*) a < end && begin < (void const*) a_end;
+        });
+    }
+
+    //--------------------------------------------------------------------------
+    /// Drops all entries, freeing their device memory.
+    void clear()
+    {
+        std::lock_guard<std::mutex> guard( lock_ );
+        entries_.clear();
+    }
+
+private:
+    MatrixCache()
+        : max_entries_( slate_lapack_set_cache() )
+    {}
+
+    //--------------------------------------------------------------------------
+    /// @return hash of up to 32-by-32 entries of the m-by-n array a,
+    /// sampled evenly over rows and columns, always including the last.
+    static uint64_t checksum(
+        int64_t m, int64_t n, scalar_t const* a, int64_t lda )
+    {
+        const int64_t samples = 32;
+        int64_t istep = std::max( m / samples, int64_t(1) );
+        int64_t jstep = std::max( n / samples, int64_t(1) );
+
+        // FNV-1a over the bytes of the sampled entries
+        uint64_t sum = 14695981039346656037ull;
+        auto add = [&sum]( scalar_t value ) {
+            unsigned char bytes[ sizeof( scalar_t ) ];
+            std::memcpy( bytes, &value, sizeof( scalar_t ) );
+            for (unsigned char byte : bytes) {
+                sum ^= byte;
+                sum *= 1099511628211ull;
+            }
+        };
+        for (int64_t j = 0; j < n; j += jstep) {
+            for (int64_t i = 0; i < m; i += istep)
+                add( a[ i + j*lda ] );
+            add( a[ (m - 1) + j*lda ] );
+        }
+        for (int64_t i = 0; i < m; i += istep)
+            add( a[ i + (n - 1)*lda ] );
+        return sum;
+    }
+
+    using Key = std::tuple< scalar_t const*, int64_t, int64_t, int64_t, int64_t >;
+
+    struct Entry {
+        Key key;
+        uint64_t checksum;
+        slate::Matrix<scalar_t> A;
+    };
+
+    int64_t max_entries_;
+    std::list<Entry> entries_;  ///< most recently used first
+    std::mutex lock_;
+};
+
+//------------------------------------------------------------------------------
+/// Drops cache entries of all precisions for arrays overlapping
+/// memory [begin, end).
+inline void cache_invalidate( void const* begin, void const* end )
+{
+    MatrixCache< float >::instance().invalidate( begin, end );
+    MatrixCache< double >::instance().invalidate( begin, end );
+    MatrixCache< std::complex<float> >::instance().invalidate( begin, end );
+    MatrixCache< std::complex<double> >::instance().invalidate( begin, end );
+}
+
+//------------------------------------------------------------------------------
+/// Drops cache entries for arrays overlapping the m-by-n array a, which
+/// the caller has written.
+template <typename scalar_t>
+void cache_written( int64_t m, int64_t n, scalar_t const* a, int64_t lda )
+{
+    if (m > 0 && n > 0)
+        cache_invalidate( a, a + lda*(n - 1) + m );
+}
+
+} // namespace lapack_api
+} // namespace slate
+
+#endif // SLATE_LAPACK_API_CACHE_HH
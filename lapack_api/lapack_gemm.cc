@@ -4,6 +4,7 @@
 // the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
 
 #include "lapack_slate.hh"
+#include "lapack_cache.hh"
 
 namespace slate {
 namespace lapack_api {
@@ -53,50 +54,62 @@ void slate_gemm(const char* transastr, const char* transbstr, int m, int n, int
     double timestart = 0.0;
     if (verbose) timestart = omp_get_wtime();
 
-    // Need a dummy MPI_Init for SLATE to proceed
-    int initialized, provided;
-    MPI_Initialized(&initialized);
-    if (! initialized)
-        MPI_Init_thread(nullptr, nullptr, MPI_THREAD_SERIALIZED, &provided);
-
-    int64_t p = 1;
-    int64_t q = 1;
-    int64_t lookahead = 1;
-    static slate::Target target = slate_lapack_set_target();
-
     Op transA{};
     Op transB{};
     from_string( std::string( 1, transastr[0] ), &transA );
     from_string( std::string( 1, transbstr[0] ), &transB );
 
-    // sizes
-    int64_t Am = (transA == blas::Op::NoTrans ? m : k);
-    int64_t An = (transA == blas::Op::NoTrans ? k : m);
-    int64_t Bm = (transB == blas::Op::NoTrans ? k : n);
-    int64_t Bn = (transB == blas::Op::NoTrans ? n : k);
-    int64_t Cm = m;
-    int64_t Cn = n;
+    static slate::Target target = slate_lapack_set_target();
     static int64_t nb = slate_lapack_set_nb(target);
-
-    // create SLATE matrices from the Lapack layouts
-    auto A = slate::Matrix<scalar_t>::fromLAPACK(Am, An, a, lda, nb, p, q, MPI_COMM_WORLD);
-    auto B = slate::Matrix<scalar_t>::fromLAPACK(Bm, Bn, b, ldb, nb, p, q, MPI_COMM_WORLD);
-    auto C = slate::Matrix<scalar_t>::fromLAPACK(Cm, Cn, c, ldc, nb, p, q, MPI_COMM_WORLD);
-
-    if (transA == blas::Op::Trans)
-        A = transpose(A);
-    else if (transA == blas::Op::ConjTrans)
-        A = conj_transpose( A );
-
-    if (transB == blas::Op::Trans)
-        B = transpose(B);
-    else if (transB == blas::Op::ConjTrans)
-        B = conj_transpose( B );
-
-    slate::gemm(alpha, A, B, beta, C, {
-        {slate::Option::Lookahead, lookahead},
-        {slate::Option::Target, target}
-    });
+    static int64_t small = slate_lapack_set_small();
+
+    if (std::max( { m, n, k } ) <= small) {
+        // small problems are faster in the vendor BLAS than in SLATE
+        blas::gemm(blas::Layout::ColMajor, transA, transB, m, n, k, alpha, a, lda, b, ldb, beta, c, ldc);
+        cache_written( m, n, c, ldc );
+    }
+    else {
+        // Need a dummy MPI_Init for SLATE to proceed
+        int initialized, provided;
+        MPI_Initialized(&initialized);
+        if (! initialized)
+            MPI_Init_thread(nullptr, nullptr, MPI_THREAD_SERIALIZED, &provided);
+
+        int64_t p = 1;
+        int64_t q = 1;
+        int64_t lookahead = 1;
+
+        // sizes
+        int64_t Am = (transA == blas::Op::NoTrans ? m : k);
+        int64_t An = (transA == blas::Op::NoTrans ? k : m);
+        int64_t Bm = (transB == blas::Op::NoTrans ? k : n);
+        int64_t Bn = (transB == blas::Op::NoTrans ? n : k);
+        int64_t Cm = m;
+        int64_t Cn = n;
+
+        // create SLATE matrices from the Lapack layouts,
+        // reusing device copies of A and B from earlier calls
+        auto& cache = MatrixCache<scalar_t>::instance();
+        auto A = cache.get(Am, An, a, lda, nb, target);
+        auto B = cache.get(Bm, Bn, b, ldb, nb, target);
+        auto C = slate::Matrix<scalar_t>::fromLAPACK(Cm, Cn, c, ldc, nb, p, q, MPI_COMM_WORLD);
+
+        if (transA == blas::Op::Trans)
+            A = transpose(A);
+        else if (transA == blas::Op::ConjTrans)
+            A = conj_transpose( A );
+
+        if (transB == blas::Op::Trans)
+            B = transpose(B);
+        else if (transB == blas::Op::ConjTrans)
+            B = conj_transpose( B );
+
+        slate::gemm(alpha, A, B, beta, C, {
+            {slate::Option::Lookahead, lookahead},
+            {slate::Option::Target, target}
+        });
+        cache_written( Cm, Cn, c, ldc );
+    }
 
     if (verbose) std::cout << "slate_lapack_api: " << slate_lapack_scalar_t_to_char(a) << "gemm(" << transastr[0] << "," << transbstr[0] << "," <<  m << "," <<  n << "," <<  k << "," <<  alpha << "," << (void*)a << "," <<  lda << "," << (void*)b << "," << ldb << "," << beta << "," << (void*)c << "," << ldc << ") " << (omp_get_wtime()-timestart) << " sec " << "nb:" << nb << " max_threads:" << omp_get_max_threads() << "\n";
 
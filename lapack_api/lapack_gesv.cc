@@ -70,8 +70,10 @@ void slate_gesv(const int n, const int nrhs, scalar_t* a, const int lda, int* ip
     // sizes
     int64_t Am = n, An = n;
     int64_t Bm = n, Bn = nrhs;
-    static int64_t nb = slate_lapack_set_nb(target);
-    static int64_t ib = std::min({slate_lapack_set_ib(), nb});
+    static int64_t nb_default = slate_lapack_set_nb(target);
+    int64_t nb = slate_lapack_tuned_nb( "getrf", a, target, Am, An, nb_default );
+    static int64_t ib_default = slate_lapack_set_ib();
+    int64_t ib = std::min( ib_default, nb );
     slate::Pivots pivots;
 
     // create SLATE matrices from the LAPACK data
@@ -4,6 +4,7 @@
 // the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
 
 #include "lapack_slate.hh"
+#include "lapack_cache.hh"
 
 namespace slate {
 namespace lapack_api {
@@ -81,8 +82,10 @@ void slate_getrf(const int m, const int n, scalar_t* a, const int lda, int* ipiv
 
     int64_t Am = m;
     int64_t An = n;
-    static int64_t nb = slate_lapack_set_nb(target);
-    static int64_t ib = std::min({slate_lapack_set_ib(), nb});
+    static int64_t nb_default = slate_lapack_set_nb(target);
+    int64_t nb = slate_lapack_tuned_nb( "getrf", a, target, Am, An, nb_default );
+    static int64_t ib_default = slate_lapack_set_ib();
+    int64_t ib = std::min( ib_default, nb );
     slate::Pivots pivots;
 
     // create SLATE matrices from the Lapack layouts
@@ -95,6 +98,7 @@ void slate_getrf(const int m, const int n, scalar_t* a, const int lda, int* ipiv
         {slate::Option::MaxPanelThreads, panel_threads},
         {slate::Option::InnerBlocking, ib}
     });
+    cache_written( Am, An, a, lda );
 
     // extract pivots from SLATE's Pivots structure into LAPACK ipiv array
     {
@@ -4,6 +4,7 @@
 // the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
 
 #include "lapack_slate.hh"
+#include "lapack_cache.hh"
 
 namespace slate {
 namespace lapack_api {
@@ -52,68 +53,80 @@ void slate_getrs(const char* transstr, const int n, const int nrhs, scalar_t* a,
     double timestart = 0.0;
     if (verbose) timestart = omp_get_wtime();
 
-    // Check and initialize MPI, else SLATE calls to MPI will fail
-    int initialized, provided;
-    MPI_Initialized(&initialized);
-    if (! initialized)
-        MPI_Init_thread(nullptr, nullptr, MPI_THREAD_MULTIPLE, &provided);
-
-    int64_t lookahead = 1;
-    int64_t p = 1;
-    int64_t q = 1;
-    static slate::Target target = slate_lapack_set_target();
-
     Op trans{};
     from_string( std::string( 1, transstr[0] ), &trans );
 
-    // sizes
-    int64_t Am = n, An = n;
-    int64_t Bm = n, Bn = nrhs;
+    static slate::Target target = slate_lapack_set_target();
     static int64_t nb = slate_lapack_set_nb(target);
+    static int64_t small = slate_lapack_set_small();
 
-    // create SLATE matrices from the LAPACK data
-    auto A = slate::Matrix<scalar_t>::fromLAPACK(Am, An, a, lda, nb, p, q, MPI_COMM_WORLD);
-    auto B = slate::Matrix<scalar_t>::fromLAPACK(Bm, Bn, b, ldb, nb, p, q, MPI_COMM_WORLD);
-
-    // extract pivots from LAPACK ipiv to SLATES pivot structure
-    slate::Pivots pivots; // std::vector< std::vector<Pivot> >
-    {
-        // allocate pivots
-        int64_t min_mt_nt = std::min(A.mt(), A.nt());
-        pivots.resize(min_mt_nt);
-        for (int64_t k = 0; k < min_mt_nt; ++k) {
-            int64_t diag_len = std::min(A.tileMb(k), A.tileNb(k));
-            pivots.at(k).resize(diag_len);
-        }
-        // transfer ipiv to pivots
-        int64_t p_count = 0;
-        int64_t t_iter_add = 0;
-        for (auto t_iter = pivots.begin(); t_iter != pivots.end(); ++t_iter) {
-            for (auto p_iter = t_iter->begin(); p_iter != t_iter->end(); ++p_iter) {
-                int64_t tileIndex = (ipiv[p_count] - 1 - t_iter_add) / nb;
-                int64_t elementOffset = (ipiv[p_count] - 1 - t_iter_add) % nb;
-                *p_iter = Pivot(tileIndex, elementOffset);
-                ++p_count;
+    if (std::max( n, nrhs ) <= small) {
+        // small problems are faster in the vendor LAPACK than in SLATE
+        std::vector<int64_t> ipiv64( ipiv, ipiv + n );
+        *info = lapack::getrs(trans, n, nrhs, a, lda, ipiv64.data(), b, ldb);
+        cache_written( n, nrhs, b, ldb );
+    }
+    else {
+        // Check and initialize MPI, else SLATE calls to MPI will fail
+        int initialized, provided;
+        MPI_Initialized(&initialized);
+        if (! initialized)
+            MPI_Init_thread(nullptr, nullptr, MPI_THREAD_MULTIPLE, &provided);
+
+        int64_t lookahead = 1;
+        int64_t p = 1;
+        int64_t q = 1;
+
+        // sizes
+        int64_t Am = n, An = n;
+        int64_t Bm = n, Bn = nrhs;
+
+        // create SLATE matrices from the LAPACK data,
+        // reusing device copies of the LU factors from earlier calls
+        auto A = MatrixCache<scalar_t>::instance().get(Am, An, a, lda, nb, target);
+        auto B = slate::Matrix<scalar_t>::fromLAPACK(Bm, Bn, b, ldb, nb, p, q, MPI_COMM_WORLD);
+
+        // extract pivots from LAPACK ipiv to SLATES pivot structure
+        slate::Pivots pivots; // std::vector< std::vector<Pivot> >
+        {
+            // allocate pivots
+            int64_t min_mt_nt = std::min(A.mt(), A.nt());
+            pivots.resize(min_mt_nt);
+            for (int64_t k = 0; k < min_mt_nt; ++k) {
+                int64_t diag_len = std::min(A.tileMb(k), A.tileNb(k));
+                pivots.at(k).resize(diag_len);
+            }
+            // transfer ipiv to pivots
+            int64_t p_count = 0;
+            int64_t t_iter_add = 0;
+            for (auto t_iter = pivots.begin(); t_iter != pivots.end(); ++t_iter) {
+                for (auto p_iter = t_iter->begin(); p_iter != t_iter->end(); ++p_iter) {
+                    int64_t tileIndex = (ipiv[p_count] - 1 - t_iter_add) / nb;
+                    int64_t elementOffset = (ipiv[p_count] - 1 - t_iter_add) % nb;
+                    *p_iter = Pivot(tileIndex, elementOffset);
+                    ++p_count;
+                }
+                t_iter_add += nb;
             }
-            t_iter_add += nb;
         }
-    }
 
-    // apply operator to A
-    auto opA = A;
-    if (trans == slate::Op::Trans)
-        opA = transpose(A);
-    else if (trans == slate::Op::ConjTrans)
-        opA = conj_transpose( A );
-
-    // solve
-    slate::getrs(opA, pivots, B, {
-        {slate::Option::Lookahead, lookahead},
-        {slate::Option::Target, target}
-    });
-
-    // todo:  get a real value for info
-    *info = 0;
+        // apply operator to A
+        auto opA = A;
+        if (trans == slate::Op::Trans)
+            opA = transpose(A);
+        else if (trans == slate::Op::ConjTrans)
+            opA = conj_transpose( A );
+
+        // solve
+        slate::getrs(opA, pivots, B, {
+            {slate::Option::Lookahead, lookahead},
+            {slate::Option::Target, target}
+        });
+
+        // todo:  get a real value for info
+        *info = 0;
+        cache_written( Bm, Bn, b, ldb );
+    }
 
     if (verbose) std::cout << "slate_lapack_api: " << slate_lapack_scalar_t_to_char(a) << "getrs(" <<  transstr[0] << "," << n << "," <<  nrhs << "," << (void*)a << "," <<  lda << "," << (void*)ipiv << "," << (void*)b << "," << ldb << "," << *info << ") " << (omp_get_wtime()-timestart) << " sec " << "nb:" << nb << " max_threads:" << omp_get_max_threads() << "\n";
 }
@@ -68,7 +68,8 @@ void slate_posv(const char* uplostr, const int n, const int nrhs, scalar_t* a, c
     int64_t p = 1;
     int64_t q = 1;
     static slate::Target target = slate_lapack_set_target();
-    static int64_t nb = slate_lapack_set_nb(target);
+    static int64_t nb_default = slate_lapack_set_nb(target);
+    int64_t nb = slate_lapack_tuned_nb( "potrf", a, target, n, n, nb_default );
     slate::Pivots pivots;
 
     // create SLATE matrices from the LAPACK data
@@ -66,7 +66,8 @@ void slate_potrf(const char* uplostr, const int n, scalar_t* a, const int lda, i
     int64_t p = 1;
     int64_t q = 1;
     static slate::Target target = slate_lapack_set_target();
-    static int64_t nb = slate_lapack_set_nb(target);
+    static int64_t nb_default = slate_lapack_set_nb(target);
+    int64_t nb = slate_lapack_tuned_nb( "potrf", a, target, n, n, nb_default );
 
     // sizes of data
     int64_t An = n;
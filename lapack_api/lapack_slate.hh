@@ -38,6 +38,7 @@ inline slate::Target slate_lapack_set_target()
         else if (targetchar == 'N') target = slate::Target::HostNest;
         else if (targetchar == 'B') target = slate::Target::HostBatch;
         else if (targetchar == 'C') target = slate::Target::Devices;
+        else if (targetchar == 'I') target = slate::Target::Hybrid;
         return target;
     }
     // todo: should the device be set to cude automatically
@@ -101,6 +102,27 @@ inline int64_t slate_lapack_set_nb(slate::Target target)
     return 256;
 }
 
+//------------------------------------------------------------------------------
+/// @return nb tuned for routine on an m-by-n matrix on one process, from
+/// the tuning database (@see slate::TuningDB); or nb_default if
+/// SLATE_LAPACK_NB is set, or the database has no entry.
+template <typename scalar_t>
+inline int64_t slate_lapack_tuned_nb(
+    char const* routine, scalar_t* a, slate::Target target,
+    int64_t m, int64_t n, int64_t nb_default )
+{
+    if (std::getenv("SLATE_LAPACK_NB"))
+        return nb_default;
+
+    slate::TuningKey key = {
+        routine, slate_lapack_scalar_t_to_char(a), target,
+        slate::TuningDB::sizeClass( std::max( m, n ) ), 1, 1 };
+    slate::TuningEntry entry;
+    if (slate::TuningDB::instance().lookup( key, &entry ) && entry.nb > 0)
+        return entry.nb;
+    return nb_default;
+}
+
 } // namespace lapack_api
 } // namespace slate
 
@@ -9,6 +9,7 @@
 #include "generate_matrix_utils.hh"
 #include "generate_type_geev.hh"
 #include "generate_type_heev.hh"
+#include "generate_type_householder.hh"
 #include "generate_type_rand.hh"
 #include "generate_sigma.hh"
 #include "generate_type_svd.hh"
@@ -64,8 +65,10 @@ void generate_matrix(
     real_t sigma_max;
     bool dominant;
     int64_t zero_col;
+    int64_t num_reflectors;
     decode_matrix<scalar_t>(
-        params, A, type, dist, cond, condD, sigma_max, dominant, zero_col );
+        params, A, type, dist, cond, condD, sigma_max, dominant, zero_col,
+        num_reflectors );
 
     int64_t seed = configure_seed(A.mpiComm(), params.seed);
 
@@ -266,17 +269,29 @@ void generate_matrix(
         }
 
         case TestMatrixType::svd: {
-            generate_svd( params, dist, cond, condD, sigma_max, A, Sigma, seed, opts );
+            if (num_reflectors > 0)
+                generate_householder( params, dist, false, false, cond, sigma_max,
+                                      A, Sigma, seed, num_reflectors, opts );
+            else
+                generate_svd( params, dist, cond, condD, sigma_max, A, Sigma, seed, opts );
             break;
         }
 
         case TestMatrixType::poev: {
-            generate_heev( params, dist, false, cond, condD, sigma_max, A, Sigma, seed, opts );
+            if (num_reflectors > 0)
+                generate_householder( params, dist, false, true, cond, sigma_max,
+                                      A, Sigma, seed, num_reflectors, opts );
+            else
+                generate_heev( params, dist, false, cond, condD, sigma_max, A, Sigma, seed, opts );
             break;
         }
 
         case TestMatrixType::heev: {
-            generate_heev( params, dist, true, cond, condD, sigma_max, A, Sigma, seed, opts );
+            if (num_reflectors > 0)
+                generate_householder( params, dist, true, true, cond, sigma_max,
+                                      A, Sigma, seed, num_reflectors, opts );
+            else
+                generate_heev( params, dist, true, cond, condD, sigma_max, A, Sigma, seed, opts );
             break;
         }
 
@@ -60,8 +60,10 @@ void generate_matrix(
     real_t sigma_max;
     bool dominant;
     int64_t zero_col;
+    int64_t num_reflectors;
     decode_matrix<scalar_t>(
-        params, A, type, dist, cond, condD, sigma_max, dominant, zero_col );
+        params, A, type, dist, cond, condD, sigma_max, dominant, zero_col,
+        num_reflectors );
 
     int64_t seed = configure_seed(A.mpiComm(), params.seed);
 
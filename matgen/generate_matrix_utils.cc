@@ -133,6 +133,10 @@ void generate_matrix_usage()
     "_zerocolFRAC    |  set column N = FRAC * (n-1) to zero, 0 <= FRAC <= 1.0\n"
     "                |  For Hermitian and symmetric matrices (and currently any\n"
     "                |  trapezoid matrix), sets row and column N to zero.\n"
+    "_house          |  for svd, poev, heev: instead of dense random unitary\n"
+    "_houseN         |  factors, use products of N Householder reflectors\n"
+    "                |  (default 4), generated in O(N n^2) with no\n"
+    "                |  communication; for large benchmark matrices.\n"
     "\n",
         ansi_bold, ansi_normal,
         ansi_bold, ansi_normal,
@@ -159,7 +163,8 @@ void decode_matrix(
     blas::real_type<scalar_t>& condD,
     blas::real_type<scalar_t>& sigma_max,
     bool& dominant,
-    int64_t& zero_col )
+    int64_t& zero_col,
+    int64_t& num_reflectors )
 {
     using real_t = blas::real_type<scalar_t>;
 
@@ -241,6 +246,7 @@ void decode_matrix(
     sigma_max = 1;
     dominant  = false;
     zero_col  = -1;
+    num_reflectors = 0;
 
     while (token_iter != tokens.end()) {
         token = *token_iter;
@@ -296,6 +302,21 @@ void decode_matrix(
                 throw std::runtime_error( msg );
             }
         }
+        else if (token.find( "house" ) == 0) {
+            // house or houseN for integer N
+            token = token.substr( 5 );  // skip "house"
+            num_reflectors = 4;
+            if (! token.empty()) {
+                size_t pos;
+                num_reflectors = std::stoi( token, &pos, 10 );
+                if (pos < token.size() || num_reflectors < 1) {
+                    snprintf( msg, sizeof( msg ),
+                              "in '%s': can't parse number >= 1 after 'house'",
+                              kind.c_str() );
+                    throw std::runtime_error( msg );
+                }
+            }
+        }
         else {
             snprintf( msg, sizeof( msg ), "in '%s': unknown suffix '%s'",
                       kind.c_str(), token.c_str() );
@@ -361,6 +382,23 @@ void decode_matrix(
         throw std::runtime_error( msg );
     }
 
+    // Error if matrix type doesn't support Householder generation.
+    if (num_reflectors > 0
+        && ! (type == TestMatrixType::svd
+              || type == TestMatrixType::poev
+              || type == TestMatrixType::heev))
+    {
+        snprintf( msg, sizeof( msg ),
+                  "in '%s': matrix '%s' doesn't support house",
+                  kind.c_str(), base.c_str() );
+        throw std::runtime_error( msg );
+    }
+    if (num_reflectors > 0 && ! condD_default) {
+        snprintf( msg, sizeof( msg ),
+                  "in '%s': house doesn't support condD", kind.c_str() );
+        throw std::runtime_error( msg );
+    }
+
     // ----- check compatability of options
     if (A.m() != A.n()
         && (type == TestMatrixType::poev
@@ -444,7 +482,8 @@ void decode_matrix(
     blas::real_type<float>& condD,
     blas::real_type<float>& sigma_max,
     bool& dominant,
-    int64_t& zero_col );
+    int64_t& zero_col,
+    int64_t& num_reflectors );
 
 template
 void decode_matrix(
@@ -456,7 +495,8 @@ void decode_matrix(
     blas::real_type<double>& condD,
     blas::real_type<double>& sigma_max,
     bool& dominant,
-    int64_t& zero_col );
+    int64_t& zero_col,
+    int64_t& num_reflectors );
 
 template
 void decode_matrix(
@@ -468,7 +508,8 @@ void decode_matrix(
     blas::real_type<std::complex<float>>& condD,
     blas::real_type<std::complex<float>>& sigma_max,
     bool& dominant,
-    int64_t& zero_col );
+    int64_t& zero_col,
+    int64_t& num_reflectors );
 
 template
 void decode_matrix(
@@ -480,6 +521,7 @@ void decode_matrix(
     blas::real_type<std::complex<double>>& condD,
     blas::real_type<std::complex<double>>& sigma_max,
     bool& dominant,
-    int64_t& zero_col );
+    int64_t& zero_col,
+    int64_t& num_reflectors );
 
 } // namespace slate
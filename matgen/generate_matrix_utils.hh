@@ -84,7 +84,8 @@ void decode_matrix(
     blas::real_type<scalar_t>& condD,
     blas::real_type<scalar_t>& sigma_max,
     bool& dominant,
-    int64_t& zero_col );
+    int64_t& zero_col,
+    int64_t& num_reflectors );
 
 void generate_matrix_usage();
 
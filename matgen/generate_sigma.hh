@@ -26,31 +26,24 @@
 namespace slate {
 
 //------------------------------------------------------------------------------
-/// Generates Sigma vector of singular or eigenvalues, according to distribution.
+/// Generates the min_mn values of the Sigma vector of singular or
+/// eigenvalues, according to distribution, without setting a matrix.
 ///
-/// Internal function, called from generate_matrix().
+/// Internal function, called from generate_sigma() and
+/// generate_householder().
 ///
 /// @ingroup generate_matrix
 ///
-template <typename matrix_type>
-void generate_sigma(
+template <typename real_t>
+void generate_sigma_values(
     MatgenParams& params,
     TestMatrixDist dist, bool rand_sign,
-    blas::real_type<typename matrix_type::value_type> cond,
-    blas::real_type<typename matrix_type::value_type> sigma_max,
-    matrix_type& A,
-    std::vector< blas::real_type<typename matrix_type::value_type> >& Sigma,
+    real_t cond,
+    real_t sigma_max,
+    int64_t min_mn,
+    std::vector< real_t >& Sigma,
     int64_t seed )
 {
-    using scalar_t = typename matrix_type::value_type;
-    using real_t = blas::real_type<scalar_t>;
-
-    // Constants
-    const scalar_t zero = 0.0;
-
-    // locals
-    int64_t min_mn = std::min( A.m(), A.n() );
-
     // Ensure Sigma is allocated
     if (Sigma.size() == 0) {
         Sigma.resize(min_mn);
@@ -165,6 +158,33 @@ void generate_sigma(
         }
     }
 
+}
+
+//------------------------------------------------------------------------------
+/// Generates Sigma vector of singular or eigenvalues, according to distribution.
+///
+/// Internal function, called from generate_matrix().
+///
+/// @ingroup generate_matrix
+///
+template <typename matrix_type>
+void generate_sigma(
+    MatgenParams& params,
+    TestMatrixDist dist, bool rand_sign,
+    blas::real_type<typename matrix_type::value_type> cond,
+    blas::real_type<typename matrix_type::value_type> sigma_max,
+    matrix_type& A,
+    std::vector< blas::real_type<typename matrix_type::value_type> >& Sigma,
+    int64_t seed )
+{
+    using scalar_t = typename matrix_type::value_type;
+
+    // Constants
+    const scalar_t zero = 0.0;
+
+    generate_sigma_values( params, dist, rand_sign, cond, sigma_max,
+                           std::min( A.m(), A.n() ), Sigma, seed );
+
     // copy Sigma => A
     int64_t min_mt_nt = std::min(A.mt(), A.nt());
     set(zero, zero, A);
@@ -8,6 +8,7 @@
 
 #include "slate/slate.hh"
 #include "slate/generate_matrix.hh"
+#include "generate_type_rand.hh"
 #include "random.hh"
 
 #include <exception>
@@ -53,6 +54,11 @@ void generate_heev(
     U.insertLocalTiles();
     slate::TriangularFactors<scalar_t> T;
 
+    // With Target::Devices, generate U on the devices; geqrf and
+    // unmqr then apply it with device gemms.
+    Target target = get_option( opts, Option::Target, Target::HostTask );
+    bool on_devices = target == Target::Devices && A.num_devices() > 0;
+
     // ----------
     generate_sigma( params, dist, rand_sign, cond, sigma_max, A, Sigma, seed );
     seed += 1;
@@ -61,27 +67,33 @@ void generate_heev(
     int64_t nt = U.nt();
     int64_t mt = U.mt();
 
-    #pragma omp parallel
-    #pragma omp master
-    {
-        int64_t j_global = 0;
-        for (int64_t j = 0; j < nt; ++j) {
-            int64_t i_global = 0;
-            for (int64_t i = 0; i < mt; ++i) {
-                if (A.tileIsLocal(i, j)) {
-                    #pragma omp task slate_omp_default_none shared( U ) \
-                        firstprivate( i, j, i_global, j_global, seed )
-                    {
-                        U.tileGetForWriting( i, j, LayoutConvert::ColMajor );
-                        auto Uij = U(i, j);
-                        slate::random::generate(slate::random::Dist::Normal, seed,
-                                                Uij.mb(), Uij.nb(), i_global, j_global,
-                                                Uij.data(), Uij.stride());
+    if (on_devices) {
+        generate_rand_devices( U, generate_local_tiles( U ),
+                               slate::random::Dist::Normal, seed, 0, 1 );
+    }
+    else {
+        #pragma omp parallel
+        #pragma omp master
+        {
+            int64_t j_global = 0;
+            for (int64_t j = 0; j < nt; ++j) {
+                int64_t i_global = 0;
+                for (int64_t i = 0; i < mt; ++i) {
+                    if (A.tileIsLocal(i, j)) {
+                        #pragma omp task slate_omp_default_none shared( U ) \
+                            firstprivate( i, j, i_global, j_global, seed )
+                        {
+                            U.tileGetForWriting( i, j, LayoutConvert::ColMajor );
+                            auto Uij = U(i, j);
+                            slate::random::generate(slate::random::Dist::Normal, seed,
+                                                    Uij.mb(), Uij.nb(), i_global, j_global,
+                                                    Uij.data(), Uij.stride());
+                        }
                     }
+                    i_global += A.tileMb(i);
                 }
-                i_global += A.tileMb(i);
+                j_global += A.tileNb(j);
             }
-            j_global += A.tileNb(j);
         }
     }
     seed += 1;
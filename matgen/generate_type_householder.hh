@@ -0,0 +1,298 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef SLATE_GENERATE_TYPE_HOUSEHOLDER_HH
+#define SLATE_GENERATE_TYPE_HOUSEHOLDER_HH
+
+#include "slate/slate.hh"
+#include "slate/generate_matrix.hh"
+#include "generate_sigma.hh"
+#include "generate_type_rand.hh"
+#include "random.hh"
+
+#include <array>
+#include <complex>
+#include <vector>
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <utility>
+
+namespace slate {
+
+//------------------------------------------------------------------------------
+/// Generates k random Householder vectors, the columns of the m-by-k
+/// matrix V, and the k-by-k upper triangular T, such that
+/// $Q = H_1 H_2 \cdots H_k = I - V T V^H$, with
+/// $H_l = I - \tau_l v_l v_l^H$ and $\tau_l = 2 / (v_l^H v_l)$,
+/// so Q is unitary. V is random normal, generated from its global indices,
+/// so every rank gets the same V.
+///
+/// Internal function, called from generate_householder().
+///
+/// @ingroup generate_matrix
+template <typename scalar_t>
+void generate_householder_factors(
+    int64_t m, int64_t k, int64_t seed,
+    std::vector<scalar_t>& V,
+    std::vector<scalar_t>& T )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    const scalar_t zero = 0;
+    const scalar_t one  = 1;
+
+    V.resize( m*k );
+    T.assign( k*k, zero );
+    slate::random::generate( slate::random::Dist::Normal, seed,
+                             m, k, 0, 0, V.data(), m );
+
+    // Gram matrix G = V^H V.
+    std::vector<scalar_t> G( k*k );
+    blas::gemm( Layout::ColMajor, Op::ConjTrans, Op::NoTrans, k, k, m,
+                one, V.data(), m, V.data(), m, zero, G.data(), k );
+
+    // As in larft, forward, columnwise, but for dense v_l:
+    // T( 0:l-1, l ) = -tau_l T( 0:l-1, 0:l-1 ) G( 0:l-1, l ), T( l, l ) = tau_l.
+    for (int64_t l = 0; l < k; ++l) {
+        scalar_t tau = real_t( 2 ) / std::real( G[ l + l*k ] );
+        for (int64_t r = 0; r < l; ++r) {
+            scalar_t sum = zero;
+            for (int64_t c = r; c < l; ++c)
+                sum += T[ r + c*k ] * G[ c + l*k ];
+            T[ r + l*k ] = -tau * sum;
+        }
+        T[ l + l*k ] = tau;
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Generates matrix $A = Q_U Sigma Q_V^H$, where Q_U and Q_V are products
+/// of k random Householder reflectors, instead of the dense random unitary
+/// factors of generate_svd() and generate_heev(). Sigma is as in
+/// generate_sigma(), so the singular values, or eigenvalues if hermitian,
+/// and the condition number are known.
+/// If hermitian, Q_V = Q_U, and with rand_sign the eigenvalues have mixed
+/// signs.
+///
+/// With $Q_U = I - U T_U U^H$ and $Q_V = I - W T_W W^H$ (U is m-by-k,
+/// W is n-by-k),
+/// $A = Sigma + U X - S Y$, where
+/// $S = Sigma W$,
+/// $Y = T_W^H W^H$, and
+/// $X = T_U (U^H S Y - U^H Sigma)$
+/// are m-by-k and k-by-n. Every rank generates U and W, in O( (m + n) k )
+/// and computes X, Y, and S in O( (m + n) k^2 ), then each tile of A is
+/// two rank-k gemms, in O( m n k ) total, with no communication.
+/// With Target::Devices, the tiles are generated on the devices.
+///
+/// Internal function, called from generate_matrix().
+///
+/// @ingroup generate_matrix
+template <typename scalar_t>
+void generate_householder(
+    MatgenParams& params,
+    TestMatrixDist dist, bool rand_sign, bool hermitian,
+    blas::real_type<scalar_t> cond,
+    blas::real_type<scalar_t> sigma_max,
+    slate::Matrix<scalar_t>& A,
+    std::vector< blas::real_type<scalar_t> >& Sigma,
+    int64_t seed, int64_t k,
+    slate::Options const& opts )
+{
+    const scalar_t zero = 0;
+    const scalar_t one  = 1;
+
+    // check inputs
+    assert( ! hermitian || A.m() == A.n() );
+
+    // locals
+    int64_t m = A.m();
+    int64_t n = A.n();
+    int64_t min_mn = std::min( m, n );
+
+    Target target = get_option( opts, Option::Target, Target::HostTask );
+    bool on_devices = target == Target::Devices && A.num_devices() > 0;
+
+    // ----------
+    generate_sigma_values( params, dist, rand_sign, cond, sigma_max,
+                           min_mn, Sigma, seed );
+    seed += 1;
+
+    std::vector<scalar_t> U, TU, W, TW;
+    generate_householder_factors( m, k, seed, U, TU );
+    seed += 1;
+    if (hermitian) {
+        W  = U;
+        TW = TU;
+    }
+    else {
+        generate_householder_factors( n, k, seed, W, TW );
+    }
+    seed += 1;
+
+    // S = Sigma W, m-by-k; rows >= min_mn are zero.
+    std::vector<scalar_t> S( m*k, zero );
+    for (int64_t l = 0; l < k; ++l)
+        for (int64_t i = 0; i < min_mn; ++i)
+            S[ i + l*m ] = Sigma[ i ] * W[ i + l*n ];
+
+    // C = U^H S, k-by-k.
+    std::vector<scalar_t> C( k*k );
+    blas::gemm( Layout::ColMajor, Op::ConjTrans, Op::NoTrans, k, k, min_mn,
+                one, U.data(), m, S.data(), m, zero, C.data(), k );
+
+    // Y = T_W^H W^H, k-by-n.
+    std::vector<scalar_t> Y( k*n );
+    blas::gemm( Layout::ColMajor, Op::ConjTrans, Op::ConjTrans, k, n, k,
+                one, TW.data(), k, W.data(), n, zero, Y.data(), k );
+
+    // Z = C Y - U^H Sigma, k-by-n; columns >= min_mn of U^H Sigma are zero.
+    std::vector<scalar_t> Z( k*n, zero );
+    for (int64_t j = 0; j < min_mn; ++j)
+        for (int64_t l = 0; l < k; ++l)
+            Z[ l + j*k ] = -blas::conj( U[ j + l*m ] ) * Sigma[ j ];
+    blas::gemm( Layout::ColMajor, Op::NoTrans, Op::NoTrans, k, n, k,
+                one, C.data(), k, Y.data(), k, one, Z.data(), k );
+
+    // X = T_U Z, k-by-n.
+    std::vector<scalar_t> X( k*n );
+    blas::gemm( Layout::ColMajor, Op::NoTrans, Op::NoTrans, k, n, k,
+                one, TU.data(), k, Z.data(), k, zero, X.data(), k );
+
+    auto tiles = generate_local_tiles( A );
+
+    if (on_devices) {
+        std::vector<scalar_t> Sigma_s( Sigma.begin(), Sigma.end() );
+
+        #pragma omp parallel
+        #pragma omp master
+        #pragma omp taskgroup
+        for (int device = 0; device < A.num_devices(); ++device) {
+            #pragma omp task slate_omp_default_none \
+                shared( A, tiles, U, S, X, Y, Sigma_s ) \
+                firstprivate( device, m, n, k, min_mn, zero, one )
+            {
+                blas::Queue* queue = A.compute_queue( device, 0 );
+                scalar_t* dU = blas::device_malloc<scalar_t>( m*k, *queue );
+                scalar_t* dS = blas::device_malloc<scalar_t>( m*k, *queue );
+                scalar_t* dX = blas::device_malloc<scalar_t>( k*n, *queue );
+                scalar_t* dY = blas::device_malloc<scalar_t>( k*n, *queue );
+                scalar_t* dSigma
+                    = blas::device_malloc<scalar_t>( min_mn, *queue );
+                blas::device_memcpy<scalar_t>( dU, U.data(), m*k, *queue );
+                blas::device_memcpy<scalar_t>( dS, S.data(), m*k, *queue );
+                blas::device_memcpy<scalar_t>( dX, X.data(), k*n, *queue );
+                blas::device_memcpy<scalar_t>( dY, Y.data(), k*n, *queue );
+                blas::device_memcpy<scalar_t>( dSigma, Sigma_s.data(),
+                                               min_mn, *queue );
+
+                for (auto const& tile : tiles) {
+                    int64_t i = tile[ 0 ];
+                    int64_t j = tile[ 1 ];
+                    int64_t i_global = tile[ 2 ];
+                    int64_t j_global = tile[ 3 ];
+                    if (A.tileDevice( i, j ) != device)
+                        continue;
+
+                    // Every entry is overwritten, so don't copy the tile in.
+                    A.tileAcquire( i, j, device, Layout::ColMajor );
+                    A.tileModified( i, j, device, true );
+                    auto Aij = A( i, j, device );
+                    int64_t ld = Aij.stride();
+
+                    // Aij = U_I X_J - S_I Y_J
+                    blas::gemm( Layout::ColMajor, Op::NoTrans, Op::NoTrans,
+                                Aij.mb(), Aij.nb(), k,
+                                one, &dU[ i_global ], m,
+                                     &dX[ j_global*k ], k,
+                                zero, Aij.data(), ld, *queue );
+                    blas::gemm( Layout::ColMajor, Op::NoTrans, Op::NoTrans,
+                                Aij.mb(), Aij.nb(), k,
+                                -one, &dS[ i_global ], m,
+                                      &dY[ j_global*k ], k,
+                                one,  Aij.data(), ld, *queue );
+
+                    // Add the part of Sigma's diagonal in this tile.
+                    int64_t g0 = std::max( i_global, j_global );
+                    int64_t g1 = std::min( std::min( i_global + Aij.mb(),
+                                                     j_global + Aij.nb() ),
+                                           min_mn );
+                    if (g1 > g0) {
+                        blas::axpy( g1 - g0, one, &dSigma[ g0 ], 1,
+                                    &Aij.data()[ (g0 - i_global)
+                                                 + (g0 - j_global)*ld ],
+                                    ld + 1, *queue );
+                    }
+                }
+                queue->sync();
+
+                blas::device_free( dU, *queue );
+                blas::device_free( dS, *queue );
+                blas::device_free( dX, *queue );
+                blas::device_free( dY, *queue );
+                blas::device_free( dSigma, *queue );
+            }
+        }
+    }
+    else {
+        #pragma omp parallel
+        #pragma omp master
+        for (auto const& tile : tiles) {
+            #pragma omp task slate_omp_default_none \
+                shared( A, U, S, X, Y, Sigma ) \
+                firstprivate( tile, m, k, min_mn, zero, one )
+            {
+                int64_t i = tile[ 0 ];
+                int64_t j = tile[ 1 ];
+                int64_t i_global = tile[ 2 ];
+                int64_t j_global = tile[ 3 ];
+
+                A.tileGetForWriting( i, j, LayoutConvert::ColMajor );
+                auto Aij = A( i, j );
+
+                // Aij = U_I X_J - S_I Y_J
+                blas::gemm( Layout::ColMajor, Op::NoTrans, Op::NoTrans,
+                            Aij.mb(), Aij.nb(), k,
+                            one, &U[ i_global ], m, &X[ j_global*k ], k,
+                            zero, Aij.data(), Aij.stride() );
+                blas::gemm( Layout::ColMajor, Op::NoTrans, Op::NoTrans,
+                            Aij.mb(), Aij.nb(), k,
+                            -one, &S[ i_global ], m, &Y[ j_global*k ], k,
+                            one,  Aij.data(), Aij.stride() );
+
+                // Add the part of Sigma's diagonal in this tile.
+                int64_t g0 = std::max( i_global, j_global );
+                int64_t g1 = std::min( std::min( i_global + Aij.mb(),
+                                                 j_global + Aij.nb() ),
+                                       min_mn );
+                for (int64_t g = g0; g < g1; ++g)
+                    Aij.at( g - i_global, g - j_global ) += Sigma[ g ];
+            }
+        }
+    }
+
+    if (hermitian) {
+        // make diagonal real
+        // usually LAPACK ignores imaginary part anyway, but Matlab doesn't
+        int64_t min_mt_nt = std::min( A.mt(), A.nt() );
+        #pragma omp parallel for
+        for (int64_t i = 0; i < min_mt_nt; ++i) {
+            if (A.tileIsLocal( i, i )) {
+                A.tileGetForWriting( i, i, LayoutConvert::ColMajor );
+                auto Aii = A( i, i );
+                int64_t bound = std::min( Aii.mb(), Aii.nb() );
+                for (int64_t ii = 0; ii < bound; ++ii) {
+                    Aii.at( ii, ii ) = std::real( Aii.at( ii, ii ) );
+                }
+            }
+        }
+    }
+}
+
+} // namespace slate
+
+#endif // SLATE_GENERATE_TYPE_HOUSEHOLDER_HH
@@ -10,6 +10,7 @@
 #include "slate/generate_matrix.hh"
 #include "random.hh"
 
+#include <array>
 #include <exception>
 #include <string>
 #include <vector>
@@ -24,6 +25,80 @@
 
 namespace slate {
 
+//------------------------------------------------------------------------------
+/// @return { i, j, i_global, j_global } for each local tile (i, j) of A,
+/// where i_global and j_global are the global indices of its first entry.
+///
+/// Internal function, called from generate_rand_devices() callers.
+///
+/// @ingroup generate_matrix
+template <typename scalar_t>
+std::vector< std::array<int64_t, 4> > generate_local_tiles(
+    BaseMatrix<scalar_t>& A )
+{
+    std::vector< std::array<int64_t, 4> > tiles;
+    int64_t j_global = 0;
+    for (int64_t j = 0; j < A.nt(); ++j) {
+        int64_t i_global = 0;
+        for (int64_t i = 0; i < A.mt(); ++i) {
+            if (A.tileIsLocal( i, j ))
+                tiles.push_back( { i, j, i_global, j_global } );
+            i_global += A.tileMb( i );
+        }
+        j_global += A.tileNb( j );
+    }
+    return tiles;
+}
+
+//------------------------------------------------------------------------------
+/// Generates random tiles of A directly on the devices of the tiles,
+/// with the same Philox sequence as slate::random::generate on the host,
+/// so no tiles are generated on the host and copied to the devices.
+/// Each entry of tile { i, j, i_global, j_global } in tiles is generated
+/// from its global index, then, for the diagonal tiles (i == j),
+/// diag_value is added to the diagonal, then the tile is scaled by scale.
+/// @see device::generate_random
+///
+/// Internal function, called from generate_rand(), generate_svd(), and
+/// generate_heev().
+///
+/// @ingroup generate_matrix
+template <typename scalar_t>
+void generate_rand_devices(
+    BaseMatrix<scalar_t>& A,
+    std::vector< std::array<int64_t, 4> > const& tiles,
+    random::Dist rand_dist, int64_t seed,
+    blas::real_type<scalar_t> diag_value, blas::real_type<scalar_t> scale )
+{
+    #pragma omp parallel
+    #pragma omp master
+    #pragma omp taskgroup
+    for (int device = 0; device < A.num_devices(); ++device) {
+        #pragma omp task slate_omp_default_none shared( A, tiles ) \
+            firstprivate( device, rand_dist, seed, diag_value, scale )
+        {
+            blas::Queue* queue = A.compute_queue( device, 0 );
+            for (auto const& tile : tiles) {
+                int64_t i = tile[ 0 ];
+                int64_t j = tile[ 1 ];
+                if (A.tileDevice( i, j ) != device)
+                    continue;
+
+                // Every entry is overwritten, so don't copy the tile in.
+                A.tileAcquire( i, j, device, Layout::ColMajor );
+                A.tileModified( i, j, device, true );
+                auto Aij = A( i, j, device );
+                device::generate_random(
+                    int64_t( rand_dist ), seed,
+                    Aij.mb(), Aij.nb(), tile[ 2 ], tile[ 3 ],
+                    i == j ? diag_value : 0, scale,
+                    Aij.data(), Aij.stride(), *queue );
+            }
+            queue->sync();
+        }
+    }
+}
+
 //------------------------------------------------------------------------------
 /// Generates matrix using either:
 /// random uniform entries on (0, 1)
@@ -48,6 +123,13 @@ void generate_rand(
 
     auto rand_dist = slate::random::Dist(int(type));
 
+    Target target = get_option( opt, Option::Target, Target::HostTask );
+    if (target == Target::Devices && A.num_devices() > 0) {
+        generate_rand_devices( A, generate_local_tiles( A ), rand_dist, seed,
+                               dominant ? n : 0, sigma_max );
+        return;
+    }
+
     #pragma omp parallel
     #pragma omp master
     {
@@ -103,6 +185,26 @@ void generate_rand(
 
     auto rand_dist = slate::random::Dist(int(type));
 
+    Target target = get_option( opt, Option::Target, Target::HostTask );
+    if (target == Target::Devices && A.num_devices() > 0) {
+        std::vector< std::array<int64_t, 4> > tiles;
+        int64_t j_global = 0;
+        for (int64_t j = 0; j < nt; ++j) {
+            int64_t i_global = 0;
+            int64_t i_start = A.uplo() == Uplo::Lower ? j  : 0;
+            int64_t i_end   = A.uplo() == Uplo::Lower ? mt : std::min( j+1, mt );
+            for (int64_t i = 0; i < i_end; ++i) {
+                if (i >= i_start && A.tileIsLocal( i, j ))
+                    tiles.push_back( { i, j, i_global, j_global } );
+                i_global += A.tileMb( i );
+            }
+            j_global += A.tileNb( j );
+        }
+        generate_rand_devices( A, tiles, rand_dist, seed,
+                               dominant ? n : 0, sigma_max );
+        return;
+    }
+
     #pragma omp parallel
     #pragma omp master
     {
@@ -9,6 +9,7 @@
 #include "slate/slate.hh"
 #include "slate/generate_matrix.hh"
 #include "generate_sigma.hh"
+#include "generate_type_rand.hh"
 #include "random.hh"
 
 #include <exception>
@@ -56,6 +57,11 @@ void generate_svd(
     U.insertLocalTiles();
     slate::TriangularFactors<scalar_t> T;
 
+    // With Target::Devices, generate U and V on the devices; geqrf and
+    // unmqr then apply them with device gemms.
+    Target target = get_option( opts, Option::Target, Target::HostTask );
+    bool on_devices = target == Target::Devices && A.num_devices() > 0;
+
     // ----------
     generate_sigma( params, dist, false, cond, sigma_max, A, Sigma, seed );
     seed += 1;
@@ -88,27 +94,33 @@ void generate_svd(
     }
 
     // random U, m-by-min_mn
-    #pragma omp parallel
-    #pragma omp master
-    {
-        int64_t j_global = 0;
-        for (int64_t j = 0; j < nt; ++j) {
-            int64_t i_global = 0;
-            for (int64_t i = 0; i < mt; ++i) {
-                if (A.tileIsLocal(i, j)) {
-                    #pragma omp task slate_omp_default_none shared( U ) \
-                        firstprivate( i, j, i_global, j_global, seed )
-                    {
-                        U.tileGetForWriting( i, j, LayoutConvert::ColMajor );
-                        auto Uij = U(i, j);
-                        slate::random::generate(slate::random::Dist::Normal, seed,
-                                                Uij.mb(), Uij.nb(), i_global, j_global,
-                                                Uij.data(), Uij.stride());
+    if (on_devices) {
+        generate_rand_devices( U, generate_local_tiles( U ),
+                               slate::random::Dist::Normal, seed, 0, 1 );
+    }
+    else {
+        #pragma omp parallel
+        #pragma omp master
+        {
+            int64_t j_global = 0;
+            for (int64_t j = 0; j < nt; ++j) {
+                int64_t i_global = 0;
+                for (int64_t i = 0; i < mt; ++i) {
+                    if (A.tileIsLocal(i, j)) {
+                        #pragma omp task slate_omp_default_none shared( U ) \
+                            firstprivate( i, j, i_global, j_global, seed )
+                        {
+                            U.tileGetForWriting( i, j, LayoutConvert::ColMajor );
+                            auto Uij = U(i, j);
+                            slate::random::generate(slate::random::Dist::Normal, seed,
+                                                    Uij.mb(), Uij.nb(), i_global, j_global,
+                                                    Uij.data(), Uij.stride());
+                        }
                     }
+                    i_global += A.tileMb(i);
                 }
-                i_global += A.tileMb(i);
+                j_global += A.tileNb(j);
             }
-            j_global += A.tileNb(j);
         }
     }
     seed += 1;
@@ -126,27 +138,33 @@ void generate_svd(
     auto V = U.slice(0, n-1, 0, n-1);
     int64_t V_mt = V.mt();
     int64_t V_nt = V.nt();
-    #pragma omp parallel
-    #pragma omp master
-    {
-        int64_t j_global = 0;
-        for (int64_t j = 0; j < V_nt; ++j) {
-            int64_t i_global = 0;
-            for (int64_t i = 0; i < V_mt; ++i) {
-                if (A.tileIsLocal(i, j)) {
-                    #pragma omp task slate_omp_default_none shared( V ) \
-                        firstprivate( i, j, i_global, j_global, seed )
-                    {
-                        V.tileGetForWriting( i, j, LayoutConvert::ColMajor );
-                        auto Vij = V(i, j);
-                        slate::random::generate(slate::random::Dist::Normal, seed,
-                                                Vij.mb(), Vij.nb(), i_global, j_global,
-                                                Vij.data(), Vij.stride());
+    if (on_devices) {
+        generate_rand_devices( V, generate_local_tiles( V ),
+                               slate::random::Dist::Normal, seed, 0, 1 );
+    }
+    else {
+        #pragma omp parallel
+        #pragma omp master
+        {
+            int64_t j_global = 0;
+            for (int64_t j = 0; j < V_nt; ++j) {
+                int64_t i_global = 0;
+                for (int64_t i = 0; i < V_mt; ++i) {
+                    if (A.tileIsLocal(i, j)) {
+                        #pragma omp task slate_omp_default_none shared( V ) \
+                            firstprivate( i, j, i_global, j_global, seed )
+                        {
+                            V.tileGetForWriting( i, j, LayoutConvert::ColMajor );
+                            auto Vij = V(i, j);
+                            slate::random::generate(slate::random::Dist::Normal, seed,
+                                                    Vij.mb(), Vij.nb(), i_global, j_global,
+                                                    Vij.data(), Vij.stride());
+                        }
                     }
+                    i_global += A.tileMb(i);
                 }
-                i_global += A.tileMb(i);
+                j_global += A.tileNb(j);
             }
-            j_global += A.tileNb(j);
         }
     }
     seed += 1;
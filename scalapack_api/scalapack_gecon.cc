@@ -99,7 +99,6 @@ void slate_pgecon(const char* normstr, int n, scalar_t* a, int ia, int ja, int*
     static int64_t lookahead = slate_scalapack_set_lookahead();
     static int64_t panel_threads = slate_scalapack_set_panelthreads();
     static int64_t ib = slate_scalapack_set_ib();
-    slate::GridOrder grid_order = slate_scalapack_blacs_grid_order();
 
     // todo: extract the real info from getrf
     *info = 0;
@@ -125,7 +124,7 @@ void slate_pgecon(const char* normstr, int n, scalar_t* a, int ia, int ja, int*
     int64_t An = n;
 
     // create SLATE matrices from the ScaLAPACK layouts
-    auto A = slate::Matrix<scalar_t>::fromScaLAPACK(desc_M(desca), desc_N(desca), a, desc_LLD(desca), desc_MB(desca), desc_NB(desca), grid_order, nprow, npcol, MPI_COMM_WORLD);
+    auto A = slate_scalapack_matrix(desc_M(desca), desc_N(desca), a, desca, desc_MB(desca), desc_NB(desca));
     A = slate_scalapack_submatrix(Am, An, A, ia, ja, desca);
 
     *rcond = slate::gecondest(norm, A, anorm, {
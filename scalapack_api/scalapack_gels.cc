@@ -109,7 +109,6 @@ void slate_pgels(const char* transstr, int m, int n, int nrhs, scalar_t* a, int
     static int64_t panel_threads = slate_scalapack_set_panelthreads();
     static int64_t inner_blocking = slate_scalapack_set_ib();
     static int64_t lookahead = slate_scalapack_set_lookahead();
-    slate::GridOrder grid_order = slate_scalapack_blacs_grid_order();
 
     // A is m-by-n, BX is max(m, n)-by-nrhs.
     // If op == NoTrans, op(A) is m-by-n, B is m-by-nrhs
@@ -122,12 +121,12 @@ void slate_pgels(const char* transstr, int m, int n, int nrhs, scalar_t* a, int
     // create SLATE matrices from the ScaLAPACK layouts
     int nprow, npcol, myprow, mypcol;
     Cblacs_gridinfo(desc_CTXT(desca), &nprow, &npcol, &myprow, &mypcol);
-    auto A = slate::Matrix<scalar_t>::fromScaLAPACK(desc_M(desca), desc_N(desca), a, desc_LLD(desca), desc_MB(desca), desc_NB(desca), grid_order, nprow, npcol, MPI_COMM_WORLD);
-    A = slate_scalapack_submatrix(Am, An, A, ia, ja, desca);
+    auto Afull = slate_scalapack_matrix(desc_M(desca), desc_N(desca), a, desca, desc_MB(desca), desc_NB(desca));
+    auto A = slate_scalapack_submatrix(Am, An, Afull, ia, ja, desca);
 
     Cblacs_gridinfo(desc_CTXT(descb), &nprow, &npcol, &myprow, &mypcol);
-    auto B = slate::Matrix<scalar_t>::fromScaLAPACK(desc_M(descb), desc_N(descb), b, desc_LLD(descb), desc_MB(descb), desc_NB(descb), grid_order, nprow, npcol, MPI_COMM_WORLD);
-    B = slate_scalapack_submatrix(Bm, Bn, B, ib, jb, descb);
+    auto Bfull = slate_scalapack_matrix(desc_M(descb), desc_N(descb), b, descb, desc_MB(descb), desc_NB(descb));
+    auto B = slate_scalapack_submatrix(Bm, Bn, Bfull, ib, jb, descb);
 
     // Apply transpose
     auto opA = A;
@@ -145,6 +144,8 @@ void slate_pgels(const char* transstr, int m, int n, int nrhs, scalar_t* a, int
         {slate::Option::MaxPanelThreads, panel_threads},
         {slate::Option::InnerBlocking, inner_blocking}
     });
+    slate_scalapack_submatrix_update(A, Am, An, Afull, ia, ja, desca);
+    slate_scalapack_submatrix_update(B, Bm, Bn, Bfull, ib, jb, descb);
 
     // todo: extract the real info
     *info = 0;
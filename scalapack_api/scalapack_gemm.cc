@@ -124,7 +124,6 @@ void slate_pgemm(const char* transastr, const char* transbstr, int m, int n, int
     static slate::Target target = slate_scalapack_set_target();
     static int verbose = slate_scalapack_set_verbose();
     static int64_t lookahead = slate_scalapack_set_lookahead();
-    slate::GridOrder grid_order = slate_scalapack_blacs_grid_order();
 
     // sizes of A and B
     int64_t Am = (transA == blas::Op::NoTrans ? m : k);
@@ -137,16 +136,16 @@ void slate_pgemm(const char* transastr, const char* transbstr, int m, int n, int
     // create SLATE matrices from the ScaLAPACK layouts
     int nprow, npcol, myprow, mypcol;
     Cblacs_gridinfo(desc_CTXT(desca), &nprow, &npcol, &myprow, &mypcol);
-    auto A = slate::Matrix<scalar_t>::fromScaLAPACK(desc_M(desca), desc_N(desca), a, desc_LLD(desca), desc_MB(desca), desc_NB(desca), grid_order, nprow, npcol, MPI_COMM_WORLD);
+    auto A = slate_scalapack_matrix(desc_M(desca), desc_N(desca), a, desca, desc_MB(desca), desc_NB(desca));
     A = slate_scalapack_submatrix(Am, An, A, ia, ja, desca);
 
     Cblacs_gridinfo(desc_CTXT(descb), &nprow, &npcol, &myprow, &mypcol);
-    auto B = slate::Matrix<scalar_t>::fromScaLAPACK(desc_M(descb), desc_N(descb), b, desc_LLD(descb), desc_MB(descb), desc_NB(descb), grid_order, nprow, npcol, MPI_COMM_WORLD);
+    auto B = slate_scalapack_matrix(desc_M(descb), desc_N(descb), b, descb, desc_MB(descb), desc_NB(descb));
     B = slate_scalapack_submatrix(Bm, Bn, B, ib, jb, descb);
 
     Cblacs_gridinfo(desc_CTXT(descc), &nprow, &npcol, &myprow, &mypcol);
-    auto C = slate::Matrix<scalar_t>::fromScaLAPACK(desc_M(descc), desc_N(descc), c, desc_LLD(descc), desc_MB(descc), desc_NB(descc), grid_order, nprow, npcol, MPI_COMM_WORLD);
-    C = slate_scalapack_submatrix(Cm, Cn, C, ic, jc, descc);
+    auto Cfull = slate_scalapack_matrix(desc_M(descc), desc_N(descc), c, descc, desc_MB(descc), desc_NB(descc));
+    auto C = slate_scalapack_submatrix(Cm, Cn, Cfull, ic, jc, descc);
 
     if (transA == blas::Op::Trans)
         A = transpose(A);
@@ -165,6 +164,7 @@ void slate_pgemm(const char* transastr, const char* transbstr, int m, int n, int
         {slate::Option::Lookahead, lookahead},
         {slate::Option::Target, target}
     });
+    slate_scalapack_submatrix_update(C, Cm, Cn, Cfull, ic, jc, descc);
 }
 
 } // namespace scalapack_api
@@ -96,7 +96,6 @@ void slate_pgesv(int n, int nrhs, scalar_t* a, int ia, int ja, int* desca, int*
     static int64_t lookahead = slate_scalapack_set_lookahead();
     static int64_t panel_threads = slate_scalapack_set_panelthreads();
     static int64_t inner_blocking = slate_scalapack_set_ib();
-    slate::GridOrder grid_order = slate_scalapack_blacs_grid_order();
 
     // Matrix sizes
     int64_t Am = n;
@@ -108,12 +107,14 @@ void slate_pgesv(int n, int nrhs, scalar_t* a, int ia, int ja, int* desca, int*
     // create SLATE matrices from the ScaLAPACK layouts
     int nprow, npcol, myprow, mypcol;
     Cblacs_gridinfo(desc_CTXT(desca), &nprow, &npcol, &myprow, &mypcol);
-    auto A = slate::Matrix<scalar_t>::fromScaLAPACK(desc_M(desca), desc_N(desca), a, desc_LLD(desca), desc_MB(desca), desc_NB(desca), grid_order, nprow, npcol, MPI_COMM_WORLD);
+    auto A = slate_scalapack_matrix(desc_M(desca), desc_N(desca), a, desca, desc_MB(desca), desc_NB(desca));
+    // pivots are converted assuming A starts and ends on tile boundaries
+    assert(slate_scalapack_aligned(Am, An, ia, ja, desca));
     A = slate_scalapack_submatrix(Am, An, A, ia, ja, desca);
 
     Cblacs_gridinfo(desc_CTXT(descb), &nprow, &npcol, &myprow, &mypcol);
-    auto B = slate::Matrix<scalar_t>::fromScaLAPACK(desc_M(descb), desc_N(descb), b, desc_LLD(descb), desc_MB(descb), desc_NB(descb), grid_order, nprow, npcol, MPI_COMM_WORLD);
-    B = slate_scalapack_submatrix(Bm, Bn, B, ib, jb, descb);
+    auto Bfull = slate_scalapack_matrix(desc_M(descb), desc_N(descb), b, descb, desc_MB(descb), desc_NB(descb));
+    auto B = slate_scalapack_submatrix(Bm, Bn, Bfull, ib, jb, descb);
 
     if (verbose && myprow == 0 && mypcol == 0)
         logprintf("%s\n", "gesv");
@@ -124,6 +125,7 @@ void slate_pgesv(int n, int nrhs, scalar_t* a, int ia, int ja, int* desca, int*
         {slate::Option::MaxPanelThreads, panel_threads},
         {slate::Option::InnerBlocking, inner_blocking}
     });
+    slate_scalapack_submatrix_update(B, Bm, Bn, Bfull, ib, jb, descb);
 
     // Extract pivots from SLATE's global Pivots structure into ScaLAPACK local ipiv array
     {
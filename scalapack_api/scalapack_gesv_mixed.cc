@@ -66,7 +66,6 @@ void slate_pgesv_mixed(int n, int nrhs, scalar_t* a, int ia, int ja, int* desca,
     static int64_t lookahead = slate_scalapack_set_lookahead();
     static int64_t panel_threads = slate_scalapack_set_panelthreads();
     static int64_t inner_blocking = slate_scalapack_set_ib();
-    slate::GridOrder grid_order = slate_scalapack_blacs_grid_order();
 
     // Matrix sizes
     int64_t Am = n;
@@ -80,16 +79,18 @@ void slate_pgesv_mixed(int n, int nrhs, scalar_t* a, int ia, int ja, int* desca,
     // create SLATE matrices from the ScaLAPACK layouts
     int nprow, npcol, myprow, mypcol;
     Cblacs_gridinfo(desc_CTXT(desca), &nprow, &npcol, &myprow, &mypcol);
-    auto A = slate::Matrix<scalar_t>::fromScaLAPACK(desc_M(desca), desc_N(desca), a, desc_LLD(desca), desc_MB(desca), desc_NB(desca), grid_order, nprow, npcol, MPI_COMM_WORLD);
+    auto A = slate_scalapack_matrix(desc_M(desca), desc_N(desca), a, desca, desc_MB(desca), desc_NB(desca));
+    // pivots are converted assuming A starts and ends on tile boundaries
+    assert(slate_scalapack_aligned(Am, An, ia, ja, desca));
     A = slate_scalapack_submatrix(Am, An, A, ia, ja, desca);
 
     Cblacs_gridinfo(desc_CTXT(descb), &nprow, &npcol, &myprow, &mypcol);
-    auto B = slate::Matrix<scalar_t>::fromScaLAPACK(desc_M(descb), desc_N(descb), b, desc_LLD(descb), desc_MB(descb), desc_NB(descb), grid_order, nprow, npcol, MPI_COMM_WORLD);
+    auto B = slate_scalapack_matrix(desc_M(descb), desc_N(descb), b, descb, desc_MB(descb), desc_NB(descb));
     B = slate_scalapack_submatrix(Bm, Bn, B, ib, jb, descb);
 
     Cblacs_gridinfo(desc_CTXT(descx), &nprow, &npcol, &myprow, &mypcol);
-    auto X = slate::Matrix<scalar_t>::fromScaLAPACK(desc_M(descx), desc_N(descx), x, desc_LLD(descx), desc_MB(descx), desc_NB(descb), grid_order, nprow, npcol, MPI_COMM_WORLD);
-    X = slate_scalapack_submatrix(Xm, Xn, X, ix, jx, descx);
+    auto Xfull = slate_scalapack_matrix(desc_M(descx), desc_N(descx), x, descx, desc_MB(descx), desc_NB(descb));
+    auto X = slate_scalapack_submatrix(Xm, Xn, Xfull, ix, jx, descx);
 
     if (verbose && myprow == 0 && mypcol == 0)
         logprintf("%s\n", "gesv_mixed");
@@ -102,6 +103,7 @@ void slate_pgesv_mixed(int n, int nrhs, scalar_t* a, int ia, int ja, int* desca,
             {slate::Option::MaxPanelThreads, panel_threads},
             {slate::Option::InnerBlocking, inner_blocking}
         });
+        slate_scalapack_submatrix_update(X, Xm, Xn, Xfull, ix, jx, descx);
     }
 
     // Extract pivots from SLATE's global Pivots structure into ScaLAPACK local ipiv array
@@ -107,7 +107,6 @@ void slate_pgesvd(const char* jobustr, const char* jobvtstr, int m, int n, scala
     static int64_t lookahead = slate_scalapack_set_lookahead();
     static int64_t panel_threads = slate_scalapack_set_panelthreads();
     static int64_t ib = slate_scalapack_set_ib();
-    slate::GridOrder grid_order = slate_scalapack_blacs_grid_order();
 
     // todo: extract the real info from gesvd
     *info = 0;
@@ -134,21 +133,21 @@ void slate_pgesvd(const char* jobustr, const char* jobvtstr, int m, int n, scala
     int64_t VTn = n;
 
     // create SLATE matrices from the ScaLAPACK layouts
-    auto A = slate::Matrix<scalar_t>::fromScaLAPACK(desc_M(desca), desc_N(desca), a, desc_LLD(desca), desc_MB(desca), desc_NB(desca), grid_order, nprow, npcol, MPI_COMM_WORLD);
+    auto A = slate_scalapack_matrix(desc_M(desca), desc_N(desca), a, desca, desc_MB(desca), desc_NB(desca));
     A = slate_scalapack_submatrix(Am, An, A, ia, ja, desca);
 
-    slate::Matrix<scalar_t> U;
+    slate::Matrix<scalar_t> Ufull, U;
     if (jobu == lapack::Job::Vec) {
         Cblacs_gridinfo(desc_CTXT(descu), &nprow, &npcol, &myprow, &mypcol);
-        U = slate::Matrix<scalar_t>::fromScaLAPACK(desc_M(descu), desc_N(descu), u, desc_LLD(descu), desc_MB(descu), desc_NB(descu), grid_order, nprow, npcol, MPI_COMM_WORLD);
-        U = slate_scalapack_submatrix(Um, Un, U, iu, ju, descu);
+        Ufull = slate_scalapack_matrix(desc_M(descu), desc_N(descu), u, descu, desc_MB(descu), desc_NB(descu));
+        U = slate_scalapack_submatrix(Um, Un, Ufull, iu, ju, descu);
     }
 
-    slate::Matrix<scalar_t> VT;
+    slate::Matrix<scalar_t> VTfull, VT;
     if (jobvt == lapack::Job::Vec) {
         Cblacs_gridinfo(desc_CTXT(descvt), &nprow, &npcol, &myprow, &mypcol);
-        VT = slate::Matrix<scalar_t>::fromScaLAPACK(desc_M(descvt), desc_N(descvt), vt, desc_LLD(descvt), desc_MB(descvt), desc_NB(descvt), grid_order, nprow, npcol, MPI_COMM_WORLD);
-        VT = slate_scalapack_submatrix(VTm, VTn, VT, ivt, jvt, descvt);
+        VTfull = slate_scalapack_matrix(desc_M(descvt), desc_N(descvt), vt, descvt, desc_MB(descvt), desc_NB(descvt));
+        VT = slate_scalapack_submatrix(VTm, VTn, VTfull, ivt, jvt, descvt);
     }
 
     std::vector< blas::real_type<scalar_t> > Sigma_( n );
@@ -159,6 +158,10 @@ void slate_pgesvd(const char* jobustr, const char* jobvtstr, int m, int n, scala
         {slate::Option::MaxPanelThreads, panel_threads},
         {slate::Option::InnerBlocking, ib}
     });
+    if (jobu == lapack::Job::Vec)
+        slate_scalapack_submatrix_update(U, Um, Un, Ufull, iu, ju, descu);
+    if (jobvt == lapack::Job::Vec)
+        slate_scalapack_submatrix_update(VT, VTm, VTn, VTfull, ivt, jvt, descvt);
 
     std::copy(Sigma_.begin(), Sigma_.end(), s);
 }
@@ -94,7 +94,6 @@ void slate_pgetrs(const char* transstr, int n, int nrhs, scalar_t* a, int ia, in
     static slate::Target target = slate_scalapack_set_target();
     static int verbose = slate_scalapack_set_verbose();
     static int64_t lookahead = slate_scalapack_set_lookahead();
-    slate::GridOrder grid_order = slate_scalapack_blacs_grid_order();
 
     slate::Options const opts =  {
         {slate::Option::Lookahead, lookahead},
@@ -113,12 +112,14 @@ void slate_pgetrs(const char* transstr, int n, int nrhs, scalar_t* a, int ia, in
     // create SLATE matrices from the ScaLAPACK layouts
     int nprow, npcol, myprow, mypcol;
     Cblacs_gridinfo(desc_CTXT(desca), &nprow, &npcol, &myprow, &mypcol);
-    auto A = slate::Matrix<scalar_t>::fromScaLAPACK(desc_M(desca), desc_N(desca), a, desc_LLD(desca), desc_MB(desca), desc_NB(desca), grid_order, nprow, npcol, MPI_COMM_WORLD);
+    auto A = slate_scalapack_matrix(desc_M(desca), desc_N(desca), a, desca, desc_MB(desca), desc_NB(desca));
+    // pivots are converted assuming A starts and ends on tile boundaries
+    assert(slate_scalapack_aligned(Am, An, ia, ja, desca));
     A = slate_scalapack_submatrix(Am, An, A, ia, ja, desca);
 
     Cblacs_gridinfo(desc_CTXT(descb), &nprow, &npcol, &myprow, &mypcol);
-    auto B = slate::Matrix<scalar_t>::fromScaLAPACK(desc_M(descb), desc_N(descb), b, desc_LLD(descb), desc_MB(descb), desc_NB(descb), grid_order, nprow, npcol, MPI_COMM_WORLD);
-    B = slate_scalapack_submatrix(Bm, Bn, B, ib, jb, descb);
+    auto Bfull = slate_scalapack_matrix(desc_M(descb), desc_N(descb), b, descb, desc_MB(descb), desc_NB(descb));
+    auto B = slate_scalapack_submatrix(Bm, Bn, Bfull, ib, jb, descb);
 
     if (verbose && myprow == 0 && mypcol == 0)
         logprintf("%s\n", "getrs");
@@ -184,6 +185,7 @@ void slate_pgetrs(const char* transstr, int n, int nrhs, scalar_t* a, int ia, in
 
     // call the SLATE getrs routine
     slate::getrs(opA, pivots, B, opts);
+    slate_scalapack_submatrix_update(B, Bm, Bn, Bfull, ib, jb, descb);
 
     // todo: extract the real info from getrs
     *info = 0;
@@ -107,7 +107,6 @@ void slate_pheev(const char* jobzstr, const char* uplostr, int n, scalar_t* a, i
     static int64_t lookahead = slate_scalapack_set_lookahead();
     static int64_t panel_threads = slate_scalapack_set_panelthreads();
     static int64_t ib = slate_scalapack_set_ib();
-    slate::GridOrder grid_order = slate_scalapack_blacs_grid_order();
 
     // todo: extract the real info from heev
     *info = 0;
@@ -130,14 +129,15 @@ void slate_pheev(const char* jobzstr, const char* uplostr, int n, scalar_t* a, i
     int64_t Zn = n;
 
     // create SLATE matrices from the ScaLAPACK layouts
-    auto A = slate::HermitianMatrix<scalar_t>::fromScaLAPACK(uplo, desc_N(desca), a, desc_LLD(desca), desc_NB(desca), grid_order, nprow, npcol, MPI_COMM_WORLD);
+    auto Afull = slate_scalapack_matrix(desc_N(desca), desc_N(desca), a, desca, desc_NB(desca), desc_NB(desca));
+    slate::HermitianMatrix<scalar_t> A(uplo, Afull);
     A = slate_scalapack_submatrix(Am, An, A, ia, ja, desca);
 
-    slate::Matrix<scalar_t> Z;
+    slate::Matrix<scalar_t> Zfull, Z;
     if (jobz == lapack::Job::Vec) {
         Cblacs_gridinfo(desc_CTXT(descz), &nprow, &npcol, &myprow, &mypcol);
-        Z = slate::Matrix<scalar_t>::fromScaLAPACK(desc_M(descz), desc_N(descz), z, desc_LLD(descz), desc_MB(descz), desc_NB(descz), grid_order, nprow, npcol, MPI_COMM_WORLD);
-        Z = slate_scalapack_submatrix(Zm, Zn, Z, iz, jz, descz);
+        Zfull = slate_scalapack_matrix(desc_M(descz), desc_N(descz), z, descz, desc_MB(descz), desc_NB(descz));
+        Z = slate_scalapack_submatrix(Zm, Zn, Zfull, iz, jz, descz);
     }
 
     std::vector< blas::real_type<scalar_t> > Lambda_( n );
@@ -149,6 +149,8 @@ void slate_pheev(const char* jobzstr, const char* uplostr, int n, scalar_t* a, i
         {slate::Option::MaxPanelThreads, panel_threads},
         {slate::Option::InnerBlocking, ib}
     });
+    if (jobz == lapack::Job::Vec)
+        slate_scalapack_submatrix_update(Z, Zm, Zn, Zfull, iz, jz, descz);
 
     std::copy(Lambda_.begin(), Lambda_.end(), w);
 }
@@ -83,7 +83,6 @@ void slate_phemm(const char* sidestr, const char* uplostr, int m, int n, scalar_
     static slate::Target target = slate_scalapack_set_target();
     static int verbose = slate_scalapack_set_verbose();
     static int64_t lookahead = slate_scalapack_set_lookahead();
-    slate::GridOrder grid_order = slate_scalapack_blacs_grid_order();
 
     int64_t An = (side == blas::Side::Left ? m : n);
     int64_t Am = An;
@@ -95,16 +94,17 @@ void slate_phemm(const char* sidestr, const char* uplostr, int m, int n, scalar_
     // create SLATE matrices from the ScaLAPACK layouts
     int nprow, npcol, myprow, mypcol;
     Cblacs_gridinfo(desc_CTXT(desca), &nprow, &npcol, &myprow, &mypcol);
-    auto AH = slate::HermitianMatrix<scalar_t>::fromScaLAPACK(uplo, desc_N(desca), a, desc_LLD(desca), desc_NB(desca), grid_order, nprow, npcol, MPI_COMM_WORLD);
+    auto AHfull = slate_scalapack_matrix(desc_N(desca), desc_N(desca), a, desca, desc_NB(desca), desc_NB(desca));
+    slate::HermitianMatrix<scalar_t> AH(uplo, AHfull);
     AH = slate_scalapack_submatrix(Am, An, AH, ia, ja, desca);
 
     Cblacs_gridinfo(desc_CTXT(descb), &nprow, &npcol, &myprow, &mypcol);
-    auto B = slate::Matrix<scalar_t>::fromScaLAPACK(desc_M(descb), desc_N(descb), b, desc_LLD(descb), desc_MB(descb), desc_NB(descb), grid_order, nprow, npcol, MPI_COMM_WORLD);
+    auto B = slate_scalapack_matrix(desc_M(descb), desc_N(descb), b, descb, desc_MB(descb), desc_NB(descb));
     B = slate_scalapack_submatrix(Bm, Bn, B, ib, jb, descb);
 
     Cblacs_gridinfo(desc_CTXT(descc), &nprow, &npcol, &myprow, &mypcol);
-    auto C = slate::Matrix<scalar_t>::fromScaLAPACK(desc_M(descc), desc_N(descc), c, desc_LLD(descc), desc_MB(descc), desc_NB(descc), grid_order, nprow, npcol, MPI_COMM_WORLD);
-    C = slate_scalapack_submatrix(Cm, Cn, C, ic, jc, descc);
+    auto Cfull = slate_scalapack_matrix(desc_M(descc), desc_N(descc), c, descc, desc_MB(descc), desc_NB(descc));
+    auto C = slate_scalapack_submatrix(Cm, Cn, Cfull, ic, jc, descc);
 
     if (side == blas::Side::Left)
         assert(AH.mt() == C.mt());
@@ -120,6 +120,7 @@ void slate_phemm(const char* sidestr, const char* uplostr, int m, int n, scalar_
         {slate::Option::Lookahead, lookahead},
         {slate::Option::Target, target}
     });
+    slate_scalapack_submatrix_update(C, Cm, Cn, Cfull, ic, jc, descc);
 }
 
 } // namespace scalapack_api
@@ -67,7 +67,6 @@ blas::real_type<scalar_t> slate_planhe(const char* normstr, const char* uplostr,
     static slate::Target target = slate_scalapack_set_target();
     static int verbose = slate_scalapack_set_verbose();
     static int64_t lookahead = slate_scalapack_set_lookahead();
-    slate::GridOrder grid_order = slate_scalapack_blacs_grid_order();
 
     // Matrix sizes
     int64_t Am = n;
@@ -76,7 +75,8 @@ blas::real_type<scalar_t> slate_planhe(const char* normstr, const char* uplostr,
     // create SLATE matrices from the ScaLAPACK layouts
     int nprow, npcol, myprow, mypcol;
     Cblacs_gridinfo(desc_CTXT(desca), &nprow, &npcol, &myprow, &mypcol);
-    auto A = slate::HermitianMatrix<scalar_t>::fromScaLAPACK(uplo, desc_N(desca), a, desc_LLD(desca), desc_NB(desca), grid_order, nprow, npcol, MPI_COMM_WORLD);
+    auto Afull = slate_scalapack_matrix(desc_N(desca), desc_N(desca), a, desca, desc_NB(desca), desc_NB(desca));
+    slate::HermitianMatrix<scalar_t> A(uplo, Afull);
     A = slate_scalapack_submatrix(Am, An, A, ia, ja, desca);
 
     if (verbose && myprow == 0 && mypcol == 0)
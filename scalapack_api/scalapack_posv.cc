@@ -100,7 +100,6 @@ void slate_pposv(const char* uplostr, int n, int nrhs, scalar_t* a, int ia, int
     static slate::Target target = slate_scalapack_set_target();
     static int verbose = slate_scalapack_set_verbose();
     static int64_t lookahead = slate_scalapack_set_lookahead();
-    slate::GridOrder grid_order = slate_scalapack_blacs_grid_order();
 
     // Matrix sizes
     int64_t Am = n;
@@ -112,12 +111,13 @@ void slate_pposv(const char* uplostr, int n, int nrhs, scalar_t* a, int ia, int
     // create SLATE matrices from the ScaLAPACK layouts
     int nprow, npcol, myprow, mypcol;
     Cblacs_gridinfo(desc_CTXT(desca), &nprow, &npcol, &myprow, &mypcol);
-    auto A = slate::HermitianMatrix<scalar_t>::fromScaLAPACK(uplo, desc_N(desca), a, desc_LLD(desca), desc_NB(desca), grid_order, nprow, npcol, MPI_COMM_WORLD);
+    auto Afull = slate_scalapack_matrix(desc_N(desca), desc_N(desca), a, desca, desc_NB(desca), desc_NB(desca));
+    slate::HermitianMatrix<scalar_t> A(uplo, Afull);
     A = slate_scalapack_submatrix(Am, An, A, ia, ja, desca);
 
     Cblacs_gridinfo(desc_CTXT(descb), &nprow, &npcol, &myprow, &mypcol);
-    auto B = slate::Matrix<scalar_t>::fromScaLAPACK(desc_M(descb), desc_N(descb), b, desc_LLD(descb), desc_MB(descb), desc_NB(descb), grid_order, nprow, npcol, MPI_COMM_WORLD);
-    B = slate_scalapack_submatrix(Bm, Bn, B, ib, jb, descb);
+    auto Bfull = slate_scalapack_matrix(desc_M(descb), desc_N(descb), b, descb, desc_MB(descb), desc_NB(descb));
+    auto B = slate_scalapack_submatrix(Bm, Bn, Bfull, ib, jb, descb);
 
     if (verbose && myprow == 0 && mypcol == 0)
         logprintf("%s\n", "posv");
@@ -126,6 +126,7 @@ void slate_pposv(const char* uplostr, int n, int nrhs, scalar_t* a, int ia, int
         {slate::Option::Lookahead, lookahead},
         {slate::Option::Target, target},
     });
+    slate_scalapack_submatrix_update(B, Bm, Bn, Bfull, ib, jb, descb);
 
     // todo: extract the real info
     *info = 0;
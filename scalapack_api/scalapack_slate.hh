@@ -14,8 +14,12 @@
 extern "C" void Cblacs_pinfo(int* mypnum, int* nprocs);
 extern "C" void Cblacs_pcoord(int icontxt, int pnum, int* prow, int* pcol);
 extern "C" void Cblacs_get(int icontxt, int what, int* val);
+extern "C" void Cblacs_gridinfo(int context, int* np_row, int* np_col, int* my_row, int* my_col);
 
 #include <complex>
+#include <list>
+#include <mutex>
+#include <tuple>
 
 namespace slate {
 namespace scalapack_api {
@@ -57,7 +61,7 @@ inline int desc_LLD(int* desca)
     return (desca[0] == BLOCK_CYCLIC_2D) ? desca[LLD_] : desca[LLD_INB];
 }
 
-inline slate::GridOrder slate_scalapack_blacs_grid_order()
+inline slate::GridOrder slate_scalapack_blacs_grid_order_query()
 {
     // if nprocs == 1, the grid layout is irrelevant, all-OK
     // if nprocs > 1 check the grid location of process-number-1 pnum(1).
@@ -77,20 +81,159 @@ inline slate::GridOrder slate_scalapack_blacs_grid_order()
     }
 }
 
+/// @return grid order of the BLACS system context, queried on the first
+/// call only, since it is fixed for the run.
+inline slate::GridOrder slate_scalapack_blacs_grid_order()
+{
+    static slate::GridOrder grid_order = slate_scalapack_blacs_grid_order_query();
+    return grid_order;
+}
+
+inline int64_t slate_scalapack_set_cache()
+{
+    // max number of matrix wrappers kept between calls; 0 disables the cache
+    int64_t num_entries = 16;
+    char* cachestr = std::getenv("SLATE_SCALAPACK_CACHE");
+    if (cachestr)
+        num_entries = std::max( (int64_t)strtol(cachestr, NULL, 0), int64_t(0) );
+    return num_entries;
+}
+
+//------------------------------------------------------------------------------
+/// Cache of SLATE matrices wrapping ScaLAPACK arrays, so repeated calls on
+/// the same array and descriptor reuse the wrapper and its tile map instead
+/// of rebuilding them. Wrappers point to the application's memory, so a
+/// reused wrapper always sees the array's current values.
+/// Least recently used entries are dropped beyond SLATE_SCALAPACK_CACHE
+/// entries per precision.
+///
+template <typename scalar_t>
+class MatrixCache {
+public:
+    static MatrixCache& instance()
+    {
+        static MatrixCache cache;
+        return cache;
+    }
+
+    //--------------------------------------------------------------------------
+    /// @return matrix wrapping the m-by-n local array a, with mb-by-nb
+    /// tiles, on the grid of the BLACS context of desca.
+    slate::Matrix<scalar_t> get(
+        int64_t m, int64_t n, scalar_t* a, int* desca, int64_t mb, int64_t nb )
+    {
+        slate::GridOrder grid_order = slate_scalapack_blacs_grid_order();
+        int nprow, npcol, myprow, mypcol;
+        Cblacs_gridinfo( desc_CTXT( desca ), &nprow, &npcol, &myprow, &mypcol );
+        int64_t lld = desc_LLD( desca );
+
+        if (max_entries_ == 0) {
+            return slate::Matrix<scalar_t>::fromScaLAPACK(
+                m, n, a, lld, mb, nb, grid_order, nprow, npcol, MPI_COMM_WORLD );
+        }
+
+        Key key = { a, m, n, lld, mb, nb, grid_order,
+                    nprow, npcol, myprow, mypcol };
+
+        std::lock_guard<std::mutex> guard( lock_ );
+        for (auto iter = entries_.begin(); iter != entries_.end(); ++iter) {
+            if (iter->first == key) {
+                // move to the front as most recently used
+                entries_.splice( entries_.begin(), entries_, iter );
+                // Drop device copies an earlier call left, since the
+                // application may have changed the array since.
+                iter->second.releaseWorkspace();
+                return iter->second;
+            }
+        }
+
+        auto A = slate::Matrix<scalar_t>::fromScaLAPACK(
+            m, n, a, lld, mb, nb, grid_order, nprow, npcol, MPI_COMM_WORLD );
+        entries_.emplace_front( key, A );
+        while (int64_t( entries_.size() ) > max_entries_)
+            entries_.pop_back();
+        return A;
+    }
+
+private:
+    MatrixCache()
+        : max_entries_( slate_scalapack_set_cache() )
+    {}
+
+    using Key = std::tuple< scalar_t*, int64_t, int64_t, int64_t, int64_t,
+                            int64_t, slate::GridOrder, int, int, int, int >;
+
+    int64_t max_entries_;
+    std::list< std::pair< Key, slate::Matrix<scalar_t> > > entries_;
+    std::mutex lock_;
+};
+
+//------------------------------------------------------------------------------
+/// @return matrix wrapping the ScaLAPACK array a with descriptor desca,
+/// as m-by-n with mb-by-nb tiles, reusing the wrapper from an earlier call.
+/// @see MatrixCache
+template <typename scalar_t>
+inline slate::Matrix<scalar_t> slate_scalapack_matrix(
+    int64_t m, int64_t n, scalar_t* a, int* desca, int64_t mb, int64_t nb )
+{
+    return MatrixCache<scalar_t>::instance().get( m, n, a, desca, mb, nb );
+}
+
+//------------------------------------------------------------------------------
+/// @return whether the Am-by-An submatrix at (ia, ja) starts on a tile
+/// boundary and ends on one or at the last row and column of the matrix,
+/// so it is a set of whole tiles.
+inline bool slate_scalapack_aligned(int Am, int An, int ia, int ja, int* desca)
+{
+    int mb = desc_MB(desca);
+    int nb = desc_NB(desca);
+    return (ia-1) % mb == 0 && (ja-1) % nb == 0
+           && (Am % mb == 0 || ia-1 + Am == desc_M(desca))
+           && (An % nb == 0 || ja-1 + An == desc_N(desca));
+}
+
+//------------------------------------------------------------------------------
+/// @return the Am-by-An submatrix of A at (ia, ja). If it is a set of whole
+/// tiles, returns a view of them. Otherwise, returns a copy with regular
+/// tiles on the same grid, redistributed from only the submatrix, not all
+/// of A; routines that write it must then call
+/// slate_scalapack_submatrix_update.
 template< typename scalar_t >
 inline slate::Matrix<scalar_t> slate_scalapack_submatrix(int Am, int An, slate::Matrix<scalar_t>& A, int ia, int ja, int* desca)
 {
     // logprintf("Am %d An %d ia %d ja %d desc_MB(desca) %d desc_NB(desca) %d A.m() %ld A.n() %ld \n", Am, An, ia, ja, desc_MB(desca), desc_NB(desca), A.m(), A.n());
     if (ia == 1 && ja == 1 && Am == A.m() && An == A.n()) return A;
-    assert((ia-1) % desc_MB(desca) == 0);
-    assert((ja-1) % desc_NB(desca) == 0);
-    assert(Am % desc_MB(desca) == 0);
-    assert(An % desc_NB(desca) == 0);
-    int64_t i1 = (ia-1)/desc_MB(desca);
-    int64_t i2 = i1 + (Am/desc_MB(desca)) - 1;
-    int64_t j1 = (ja-1)/desc_NB(desca);
-    int64_t j2 = j1 + (An/desc_NB(desca)) - 1;
-    return A.sub(i1, i2, j1, j2);
+    if (Am == 0 || An == 0 || slate_scalapack_aligned(Am, An, ia, ja, desca)) {
+        int64_t i1 = (ia-1)/desc_MB(desca);
+        int64_t i2 = i1 + ceildiv( int64_t( Am ), int64_t( desc_MB(desca) ) ) - 1;
+        int64_t j1 = (ja-1)/desc_NB(desca);
+        int64_t j2 = j1 + ceildiv( int64_t( An ), int64_t( desc_NB(desca) ) ) - 1;
+        return A.sub(i1, i2, j1, j2);
+    }
+
+    slate::GridOrder grid_order;
+    int nprow, npcol, myprow, mypcol;
+    A.gridinfo( &grid_order, &nprow, &npcol, &myprow, &mypcol );
+    slate::Matrix<scalar_t> Asub( Am, An, desc_MB(desca), desc_NB(desca),
+                                  grid_order, nprow, npcol, A.mpiComm() );
+    Asub.insertLocalTiles();
+    auto A_slice = A.slice( ia-1, ia-1 + Am-1, ja-1, ja-1 + An-1 );
+    slate::redistribute( A_slice, Asub );
+    return Asub;
+}
+
+//------------------------------------------------------------------------------
+/// Copies Asub, from slate_scalapack_submatrix, back into the Am-by-An
+/// submatrix of A at (ia, ja), if it is a copy rather than a view.
+template< typename scalar_t >
+inline void slate_scalapack_submatrix_update(slate::Matrix<scalar_t>& Asub, int Am, int An, slate::Matrix<scalar_t>& A, int ia, int ja, int* desca)
+{
+    if (ia == 1 && ja == 1 && Am == A.m() && An == A.n()) return;
+    if (Am == 0 || An == 0 || slate_scalapack_aligned(Am, An, ia, ja, desca))
+        return;
+
+    auto A_slice = A.slice( ia-1, ia-1 + Am-1, ja-1, ja-1 + An-1 );
+    slate::redistribute( Asub, A_slice );
 }
 
 template< typename scalar_t >
@@ -141,7 +284,7 @@ inline slate::HermitianMatrix<scalar_t> slate_scalapack_submatrix(int Am, int An
 inline slate::Target slate_scalapack_set_target()
 {
     // set the SLATE default computational target
-    // 5th character from: hostTask hostNest hostBatch deviCes
+    // 5th character from: hostTask hostNest hostBatch deviCes hybrId
     slate::Target target = slate::Target::HostTask;
     char* targetstr = std::getenv("SLATE_SCALAPACK_TARGET");
     if (targetstr) {
@@ -150,6 +293,7 @@ inline slate::Target slate_scalapack_set_target()
         else if (targetchar == 'N') target = slate::Target::HostNest;
         else if (targetchar == 'B') target = slate::Target::HostBatch;
         else if (targetchar == 'C') target = slate::Target::Devices;
+        else if (targetchar == 'I') target = slate::Target::Hybrid;
     }
     return target;
 }
@@ -103,7 +103,6 @@ void slate_ptrcon(const char* normstr, const char* uplostr, const char* diagstr,
     static int64_t lookahead = slate_scalapack_set_lookahead();
     static int64_t panel_threads = slate_scalapack_set_panelthreads();
     static int64_t ib = slate_scalapack_set_ib();
-    slate::GridOrder grid_order = slate_scalapack_blacs_grid_order();
 
     // todo: extract the real info from getrf
     *info = 0;
@@ -129,7 +128,8 @@ void slate_ptrcon(const char* normstr, const char* uplostr, const char* diagstr,
     int64_t An = n;
 
     // create SLATE matrices from the ScaLAPACK layouts
-    auto AT = slate::TriangularMatrix<scalar_t>::fromScaLAPACK(uplo, diag, desc_N(desca), a, desc_LLD(desca), desc_NB(desca), grid_order, nprow, npcol, MPI_COMM_WORLD);
+    auto ATfull = slate_scalapack_matrix(desc_N(desca), desc_N(desca), a, desca, desc_NB(desca), desc_NB(desca));
+    slate::TriangularMatrix<scalar_t> AT(uplo, diag, ATfull);
     AT = slate_scalapack_submatrix(Am, An, AT, ia, ja, desca);
 
     blas::real_type<scalar_t> anorm = slate::norm( norm, AT, {
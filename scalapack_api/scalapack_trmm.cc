@@ -108,7 +108,6 @@ void slate_ptrmm(const char* sidestr, const char* uplostr, const char* transastr
     static slate::Target target = slate_scalapack_set_target();
     static int verbose = slate_scalapack_set_verbose();
     static int64_t lookahead = slate_scalapack_set_lookahead();
-    slate::GridOrder grid_order = slate_scalapack_blacs_grid_order();
 
     // setup so op(B) is m-by-n
     int64_t An = (side == blas::Side::Left ? m : n);
@@ -119,12 +118,13 @@ void slate_ptrmm(const char* sidestr, const char* uplostr, const char* transastr
     // create SLATE matrices from the ScaLAPACK layouts
     int nprow, npcol, myprow, mypcol;
     Cblacs_gridinfo(desc_CTXT(desca), &nprow, &npcol, &myprow, &mypcol);
-    auto AT = slate::TriangularMatrix<scalar_t>::fromScaLAPACK(uplo, diag, desc_N(desca), a, desc_LLD(desca), desc_NB(desca), grid_order, nprow, npcol, MPI_COMM_WORLD);
+    auto ATfull = slate_scalapack_matrix(desc_N(desca), desc_N(desca), a, desca, desc_NB(desca), desc_NB(desca));
+    slate::TriangularMatrix<scalar_t> AT(uplo, diag, ATfull);
     AT = slate_scalapack_submatrix(Am, An, AT, ia, ja, desca);
 
     Cblacs_gridinfo(desc_CTXT(descb), &nprow, &npcol, &myprow, &mypcol);
-    auto B = slate::Matrix<scalar_t>::fromScaLAPACK(desc_M(descb), desc_N(descb), b, desc_LLD(descb), desc_MB(descb), desc_NB(descb), grid_order, nprow, npcol, MPI_COMM_WORLD);
-    B = slate_scalapack_submatrix(Bm, Bn, B, ib, jb, descb);
+    auto Bfull = slate_scalapack_matrix(desc_M(descb), desc_N(descb), b, descb, desc_MB(descb), desc_NB(descb));
+    auto B = slate_scalapack_submatrix(Bm, Bn, Bfull, ib, jb, descb);
 
     if (transA == Op::Trans)
         AT = transpose(AT);
@@ -138,6 +138,7 @@ void slate_ptrmm(const char* sidestr, const char* uplostr, const char* transastr
         {slate::Option::Lookahead, lookahead},
         {slate::Option::Target, target}
     });
+    slate_scalapack_submatrix_update(B, Bm, Bn, Bfull, ib, jb, descb);
 }
 
 } // namespace scalapack_api
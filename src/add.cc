@@ -94,7 +94,7 @@ void add(
     scalar_t beta,  Matrix<scalar_t>& B,
     Options const& opts )
 {
-    Target target = get_option( opts, Option::Target, Target::HostTask );
+    Target target = get_target( opts, Target::HostTask );
 
     switch (target) {
         case Target::Host:
@@ -111,6 +111,7 @@ void add(
             break;
 
         case Target::Devices:
+        case Target::Hybrid:
             impl::add<Target::Devices>( alpha, A, beta, B, opts );
             break;
     }
@@ -142,6 +143,125 @@ void add< std::complex<double> >(
     std::complex<double> beta,  Matrix< std::complex<double> >& B,
     Options const& opts);
 
+//==============================================================================
+// Mixed precision, for Matrix.
+//==============================================================================
+
+namespace impl {
+
+//------------------------------------------------------------------------------
+template <Target target, typename src_scalar_t, typename scalar_t>
+void add(
+    scalar_t alpha, Matrix<src_scalar_t>& A,
+    scalar_t beta,  Matrix<scalar_t>& B,
+    Options const& opts )
+{
+    // As in copy, A provides its own batch arrays because of the
+    // different types.
+    if (target == Target::Devices) {
+        A.allocateBatchArrays();
+        B.allocateBatchArrays();
+        B.reserveDeviceWorkspace();
+    }
+
+    bool hold_local_workspace = get_option<bool>(
+            opts, Option::HoldLocalWorkspace, 0 );
+
+    #pragma omp parallel
+    #pragma omp master
+    {
+        internal::add<target>(alpha, std::move(A),
+                                beta, std::move(B) );
+        #pragma omp taskwait
+        B.tileUpdateAllOrigin();
+    }
+
+    if (hold_local_workspace == false) {
+        B.releaseWorkspace();
+    }
+}
+
+} // namespace impl
+
+//------------------------------------------------------------------------------
+/// Distributed parallel general matrix-matrix addition with precision
+/// conversion of A.
+/// Performs the matrix-matrix operation
+/// \[
+///     B = \alpha A + \beta B,
+/// \]
+/// where A is in a lower precision than B, e.g., float and double.
+/// Each element of A is read once and converted on the fly, which saves a
+/// full pass over the matrix compared to copy to a temporary followed by
+/// add; see the refinement update in gesv_mixed and posv_mixed.
+///
+/// @tparam src_scalar_t
+///         One of float, std::complex<float>.
+///
+/// @tparam scalar_t
+///         One of double, std::complex<double>, respectively.
+///
+/// @param[in] alpha
+///         The scalar alpha.
+///
+/// @param[in] A
+///         The m-by-n matrix A, with the same distribution as B.
+///
+/// @param[in] beta
+///         The scalar beta.
+///
+/// @param[in,out] B
+///         On entry, the m-by-n matrix B.
+///         On exit, overwritten by the result $\alpha A + \beta B$.
+///
+/// @param[in] opts
+///         Additional options, as map of name = value pairs. Possible options:
+///         - Option::Target:
+///           Implementation to target. Possible values:
+///           - HostTask:  OpenMP tasks on CPU host [default].
+///           - HostNest:  same as HostTask.
+///           - HostBatch: same as HostTask.
+///           - Devices:   batched kernel on GPU device.
+///
+/// @ingroup add
+///
+template <typename src_scalar_t, typename scalar_t>
+void add(
+    scalar_t alpha, Matrix<src_scalar_t>& A,
+    scalar_t beta,  Matrix<scalar_t>& B,
+    Options const& opts )
+{
+    Target target = get_target( opts, Target::HostTask );
+
+    switch (target) {
+        case Target::Host:
+        case Target::HostTask:
+        case Target::HostNest:
+        case Target::HostBatch:
+            impl::add<Target::HostTask>( alpha, A, beta, B, opts );
+            break;
+
+        case Target::Devices:
+        case Target::Hybrid:
+            impl::add<Target::Devices>( alpha, A, beta, B, opts );
+            break;
+    }
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void add<float, double>(
+    double alpha, Matrix<float>& A,
+    double beta,  Matrix<double>& B,
+    Options const& opts);
+
+template
+void add< std::complex<float>, std::complex<double> >(
+    std::complex<double> alpha, Matrix< std::complex<float> >& A,
+    std::complex<double> beta,  Matrix< std::complex<double> >& B,
+    Options const& opts);
+
 //==============================================================================
 // For BaseTrapezoidMatrix.
 //==============================================================================
@@ -231,7 +351,7 @@ void add(
     scalar_t beta,  BaseTrapezoidMatrix<scalar_t>& B,
     Options const& opts)
 {
-    Target target = get_option( opts, Option::Target, Target::HostTask );
+    Target target = get_target( opts, Target::HostTask );
 
     switch (target) {
         case Target::Host:
@@ -248,6 +368,7 @@ void add(
             break;
 
         case Target::Devices:
+        case Target::Hybrid:
             impl::add<Target::Devices>( alpha, A, beta, B, opts );
             break;
     }
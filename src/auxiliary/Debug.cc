@@ -67,21 +67,23 @@ void Debug::checkTilesLives( BaseMatrix<scalar_t> const& A )
 {
     if (! debug_) return;
     // i, j are global indices
-    for (auto iter = A.storage_->tiles_.begin();
-              iter != A.storage_->tiles_.end(); ++iter) {
-        int64_t i = std::get<0>(iter->first);
-        int64_t j = std::get<1>(iter->first);
-
-        if (! A.tileIsLocal(i, j)) {
-            if (! iter->second->empty()) {
-
-                std::cout << "RANK "  << std::setw(3) << A.mpi_rank_
-                          << " TILE " << std::setw(3) << std::get<0>(iter->first)
-                          << " "      << std::setw(3) << std::get<1>(iter->first);
-                for (int d = HostNum; d < A.num_devices(); ++d) {
-                    if (iter->second->existsOn(d)) {
-                        std::cout << " DEV "  << d
-                                  << " data " << iter->second->at(d)->data() << "\n";
+    LockGuard guard( A.storage_->getTilesMapLock() );
+    for (auto& shard : A.storage_->shards_) {
+        for (auto iter = shard.tiles.begin(); iter != shard.tiles.end(); ++iter) {
+            int64_t i = std::get<0>(iter->first);
+            int64_t j = std::get<1>(iter->first);
+
+            if (! A.tileIsLocal(i, j)) {
+                if (! iter->second->empty()) {
+
+                    std::cout << "RANK "  << std::setw(3) << A.mpi_rank_
+                              << " TILE " << std::setw(3) << std::get<0>(iter->first)
+                              << " "      << std::setw(3) << std::get<1>(iter->first);
+                    for (int d = HostNum; d < A.num_devices(); ++d) {
+                        if (iter->second->existsOn(d)) {
+                            std::cout << " DEV "  << d
+                                      << " data " << iter->second->at(d)->data() << "\n";
+                        }
                     }
                 }
             }
@@ -101,17 +103,14 @@ bool Debug::checkTilesLayout( BaseMatrix<scalar_t> const& A )
     // i, j are tile indices
     // if (A.mpi_rank_ == 0)
     {
-        auto index = A.globalIndex(0, 0);
-        auto tmp_tile = A.storage_->tiles_.find(index);
-        auto tile_end = A.storage_->tiles_.end();
+        LockGuard guard( A.storage_->getTilesMapLock() );
 
         for (int64_t i = 0; i < A.mt(); ++i) {
             for (int64_t j = 0; j < A.nt(); ++j) {
-                index = A.globalIndex(i, j);
-                tmp_tile = A.storage_->tiles_.find(index);
-                if (tmp_tile != tile_end
-                    && tmp_tile->second->at( HostNum ) != nullptr
-                    && tmp_tile->second->at( HostNum )->layout() != A.layout()) {
+                auto tile_node = A.storage_->find( A.globalIndex(i, j) );
+                if (tile_node != nullptr
+                    && tile_node->at( HostNum ) != nullptr
+                    && tile_node->at( HostNum )->layout() != A.layout()) {
                     return false;
                 }
             }
@@ -193,15 +192,15 @@ void Debug::printTiles_(
                     msg += ' ';
 
                 LockGuard guard(A.storage_->getTilesMapLock());
-                auto iter = A.storage_->find( A.globalIndex( i, j, device ) );
-                if (iter != A.storage_->end()) {
-                    auto tile = iter->second->at( device );
+                auto tile_node = A.storage_->find( A.globalIndex( i, j, device ) );
+                if (tile_node != nullptr) {
+                    auto tile = tile_node->at( device );
                     if (do_kind) {
                         msg += char(tile->kind());
                     }
                     if (do_mosi) {
-                        char ch = to_char( iter->second->at( device )->state() );
-                        if (iter->second->at( device )->stateOn( MOSI::OnHold ))
+                        char ch = to_char( tile->state() );
+                        if (tile->stateOn( MOSI::OnHold ))
                             ch = toupper( ch );
                         msg += ch;
                     }
@@ -284,54 +283,66 @@ void Debug::printTiles_(
 }
 
 //------------------------------------------------------------------------------
-/// Prints the number of free blocks for each device.
+/// Prints the number of free blocks in each size class for host and
+/// each device.
 void Debug::printNumFreeMemBlocks(Memory const& m)
 {
     if (! debug_) return;
     printf("\n");
-    for (int dev = 0; dev < m.num_devices_; ++dev) {
-        printf("\tdevice: %d\tfree blocks: %lu\n",
-               dev, m.free_blocks_[dev].size());
+    for (int dev = HostNum; dev < m.num_devices_; ++dev) {
+        printf("\tdevice: %d\tfree blocks:", dev);
+        for (int k = 0; k < m.num_size_classes(); ++k) {
+            printf(" %lu (%lu bytes)",
+                   m.free_blocks_[dev+1][k].size(), m.class_size_[k]);
+        }
+        printf("\n");
     }
 }
 
 //------------------------------------------------------------------------------
-/// Checks whether blocks were leaked or freed too many times, for host.
+/// Prints the memory pool statistics, including fragmentation,
+/// for host and each device.
+void Debug::printMemoryStats(Memory const& m)
+{
+    if (! debug_) return;
+    printf("\n");
+    for (int dev = HostNum; dev < m.num_devices_; ++dev) {
+        MemoryStats stats = m.stats( dev );
+        printf("\tdevice: %d\treserved: %lu\tin use: %lu\trequested: %lu"
+               "\texternal: %lu\tpeak: %lu\tpeak in use: %lu"
+               "\tallocs: %lld\tmallocs: %lld"
+               "\tinternal frag: %.3f\texternal frag: %.3f\n",
+               dev, stats.reserved, stats.in_use, stats.requested,
+               stats.external, stats.peak, stats.peak_in_use,
+               llong( stats.num_allocs ), llong( stats.num_mallocs ),
+               stats.internalFragmentation(), stats.externalFragmentation());
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Checks whether blocks were leaked, for host.
 void Debug::checkHostMemoryLeaks(Memory const& m)
 {
     using llu = long long unsigned;
     if (! debug_) return;
-    if (m.free_blocks_.at( HostNum ).size() < m.capacity_.at( HostNum )) {
-        fprintf(stderr,
-                "Error: memory leak: freed %llu of %llu blocks on host\n",
-                (llu) m.free_blocks_.at( HostNum ).size(),
-                (llu) m.capacity_.at( HostNum ));
-    }
-    else if (m.free_blocks_.at( HostNum ).size() > m.capacity_.at( HostNum )) {
+    if (m.allocated( HostNum ) > 0) {
         fprintf(stderr,
-                "Error: freed too many: %llu of %llu blocks on host\n",
-                (llu) m.free_blocks_.at( HostNum ).size(),
-                (llu) m.capacity_.at( HostNum ));
+                "Error: memory leak: %llu blocks not freed on host\n",
+                (llu) m.allocated( HostNum ));
     }
 }
 
 //------------------------------------------------------------------------------
-/// Checks whether blocks were leaked or freed too many times, for device.
+/// Checks whether blocks were leaked, for device.
+/// Freeing a block twice is caught by Memory::free.
 void Debug::checkDeviceMemoryLeaks(Memory const& m, int device)
 {
     using llu = long long unsigned;
     if (! debug_) return;
-    if (m.free_blocks_.at(device).size() < m.capacity_.at(device)) {
-        fprintf(stderr,
-                "Error: memory leak: freed %llu of %llu blocks on device %d\n",
-                (llu) m.free_blocks_.at(device).size(),
-                (llu) m.capacity_.at(device), device);
-    }
-    else if (m.free_blocks_.at(device).size() > m.capacity_.at(device)) {
+    if (m.allocated( device ) > 0) {
         fprintf(stderr,
-                "Error: freed too many: %llu of %llu blocks on device %d\n",
-                (llu) m.free_blocks_.at(device).size(),
-                (llu) m.capacity_.at(device), device);
+                "Error: memory leak: %llu blocks not freed on device %d\n",
+                (llu) m.allocated( device ), device);
     }
 }
 
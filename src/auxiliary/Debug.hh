@@ -59,6 +59,7 @@ public:
     //-------------
     // Memory class
     static void printNumFreeMemBlocks( Memory const& m );
+    static void printMemoryStats( Memory const& m );
     static void checkHostMemoryLeaks( Memory const& m );
     static void checkDeviceMemoryLeaks( Memory const& m, int device );
 
@@ -68,6 +69,12 @@ public:
         printNumFreeMemBlocks( A.storage_->memory_ );
     }
 
+    template <typename scalar_t>
+    static void printMemoryStats( BaseMatrix<scalar_t> const& A )
+    {
+        printMemoryStats( A.storage_->memory_ );
+    }
+
 private:
     static bool debug_;
 };
@@ -0,0 +1,333 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/internal/Energy.hh"
+#include "slate/internal/Trace.hh"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#if defined( SLATE_HAVE_NVML )
+    #include <nvml.h>
+#endif
+
+#if defined( SLATE_HAVE_ROCM_SMI )
+    #include <rocm_smi/rocm_smi.h>
+#endif
+
+namespace slate {
+namespace trace {
+
+namespace {
+
+//------------------------------------------------------------------------------
+/// Cumulative energy counter, which may wrap around.
+struct Source {
+    std::string name;
+    std::function< bool ( double& ) > read;  ///< reads counter, in joules
+    double range = 0;   ///< counter wraps around after range joules; 0 if not
+    double last  = 0;   ///< last value read
+};
+
+//------------------------------------------------------------------------------
+/// @return whether a number was read from file.
+bool read_number( std::string const& file, double& value )
+{
+    std::ifstream in( file );
+    return bool( in >> value );
+}
+
+//------------------------------------------------------------------------------
+/// Adds RAPL package and DRAM domains. Package domains are
+/// intel-rapl:N (also on AMD CPUs); their subdomains intel-rapl:N:M,
+/// e.g., core, are included in the package, except for DRAM.
+void add_rapl( std::vector< Source >& sources )
+{
+    std::string base = "/sys/class/powercap/intel-rapl:";
+    for (int pkg = 0; ; ++pkg) {
+        std::string pkg_dir = base + std::to_string( pkg );
+        std::vector< std::string > dirs = { pkg_dir };
+        for (int sub = 0; sub < 8; ++sub)
+            dirs.push_back( pkg_dir + "/intel-rapl:" + std::to_string( pkg )
+                            + ":" + std::to_string( sub ) );
+        bool found = false;
+        for (size_t d = 0; d < dirs.size(); ++d) {
+            std::string name;
+            std::ifstream name_file( dirs[ d ] + "/name" );
+            if (! (name_file >> name)) {
+                if (d == 0)
+                    break;  // no package pkg
+                continue;
+            }
+            found = found || d == 0;
+            if (d > 0 && name != "dram")
+                continue;
+
+            Source source;
+            source.name = "rapl:" + name;
+            std::string energy_file = dirs[ d ] + "/energy_uj";
+            source.read = [energy_file]( double& joules ) {
+                double uj;
+                if (! read_number( energy_file, uj ))
+                    return false;
+                joules = uj * 1e-6;
+                return true;
+            };
+            double range_uj;
+            if (read_number( dirs[ d ] + "/max_energy_range_uj", range_uj ))
+                source.range = range_uj * 1e-6;
+            // energy_uj is often readable only by root.
+            if (source.read( source.last ))
+                sources.push_back( source );
+        }
+        if (! found)
+            break;
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Adds NVIDIA GPUs, if compiled with NVML.
+void add_nvml( std::vector< Source >& sources )
+{
+#if defined( SLATE_HAVE_NVML )
+    unsigned int count = 0;
+    if (nvmlInit_v2() != NVML_SUCCESS
+        || nvmlDeviceGetCount_v2( &count ) != NVML_SUCCESS)
+        return;
+
+    for (unsigned int dev = 0; dev < count; ++dev) {
+        nvmlDevice_t handle;
+        if (nvmlDeviceGetHandleByIndex_v2( dev, &handle ) != NVML_SUCCESS)
+            continue;
+        Source source;
+        source.name = "nvml:" + std::to_string( dev );
+        source.read = [handle]( double& joules ) {
+            unsigned long long mj;
+            if (nvmlDeviceGetTotalEnergyConsumption( handle, &mj )
+                != NVML_SUCCESS)
+                return false;
+            joules = mj * 1e-3;
+            return true;
+        };
+        // Volta and later; older GPUs have only instantaneous power.
+        if (source.read( source.last ))
+            sources.push_back( source );
+    }
+#else
+    (void) sources;
+#endif
+}
+
+//------------------------------------------------------------------------------
+/// Adds AMD GPUs, if compiled with ROCm SMI.
+void add_rocm_smi( std::vector< Source >& sources )
+{
+#if defined( SLATE_HAVE_ROCM_SMI )
+    uint32_t count = 0;
+    if (rsmi_init( 0 ) != RSMI_STATUS_SUCCESS
+        || rsmi_num_monitor_devices( &count ) != RSMI_STATUS_SUCCESS)
+        return;
+
+    for (uint32_t dev = 0; dev < count; ++dev) {
+        Source source;
+        source.name = "rocm_smi:" + std::to_string( dev );
+        source.read = [dev]( double& joules ) {
+            uint64_t counter, timestamp;
+            float resolution;  // in microjoules
+            if (rsmi_dev_energy_count_get( dev, &counter, &resolution,
+                                           &timestamp ) != RSMI_STATUS_SUCCESS)
+                return false;
+            joules = counter * double( resolution ) * 1e-6;
+            return true;
+        };
+        if (source.read( source.last ))
+            sources.push_back( source );
+    }
+#else
+    (void) sources;
+#endif
+}
+
+//------------------------------------------------------------------------------
+/// State of the sampler, guarded by mutex.
+struct Sampler {
+    std::vector< Source > sources;
+    bool found = false;     ///< whether sources were looked up
+
+    /// (time, cumulative joules of all sources) since start()
+    std::vector< std::pair< double, double > > samples;
+    double total = 0;
+
+    std::thread thread;
+    bool stopping = false;
+    std::mutex mutex;
+    std::condition_variable wake;
+
+    ~Sampler()
+    {
+        if (thread.joinable()) {
+            {
+                std::lock_guard< std::mutex > guard( mutex );
+                stopping = true;
+            }
+            wake.notify_all();
+            thread.join();
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    /// Reads all sources and appends a sample. Caller holds mutex.
+    void sample()
+    {
+        for (auto& source : sources) {
+            double value;
+            if (! source.read( value ))
+                continue;
+            double delta = value - source.last;
+            if (delta < 0)
+                delta += source.range;  // wrapped around
+            source.last = value;
+            total += std::max( delta, 0.0 );
+        }
+        samples.push_back( { now(), total } );
+    }
+
+    //--------------------------------------------------------------------------
+    /// Sampling loop of the thread.
+    void run( double interval )
+    {
+        std::unique_lock< std::mutex > lock( mutex );
+        auto period = std::chrono::duration< double >( interval );
+        while (! stopping) {
+            wake.wait_for( lock, period );
+            sample();
+        }
+    }
+};
+
+Sampler s_sampler;
+
+//------------------------------------------------------------------------------
+/// Looks up sources, once. Caller holds mutex.
+void find_sources()
+{
+    if (! s_sampler.found) {
+        add_rapl( s_sampler.sources );
+        add_nvml( s_sampler.sources );
+        add_rocm_smi( s_sampler.sources );
+        s_sampler.found = true;
+    }
+}
+
+//------------------------------------------------------------------------------
+/// @return cumulative joules at time t, interpolated between samples,
+/// and clamped to the first and last samples. Caller holds mutex.
+double energy_at( double t )
+{
+    auto& samples = s_sampler.samples;
+    if (samples.empty())
+        return 0;
+    if (t <= samples.front().first)
+        return samples.front().second;
+    if (t >= samples.back().first)
+        return samples.back().second;
+
+    auto iter = std::lower_bound(
+        samples.begin(), samples.end(), t,
+        []( std::pair< double, double > const& sample, double time ) {
+            return sample.first < time;
+        } );
+    auto prev = iter - 1;
+    double dt = iter->first - prev->first;
+    double frac = dt > 0 ? (t - prev->first) / dt : 1;
+    return prev->second + frac * (iter->second - prev->second);
+}
+
+} // anonymous namespace
+
+//------------------------------------------------------------------------------
+/// Starts sampling energy in a thread, discarding earlier samples.
+/// Does nothing if already running, or if no energy counters are readable.
+///
+/// @param[in] interval
+///     Sampling interval, in seconds. Default 10 ms.
+///
+void Energy::start( double interval )
+{
+    std::lock_guard< std::mutex > guard( s_sampler.mutex );
+    find_sources();
+    if (s_sampler.thread.joinable() || s_sampler.sources.empty())
+        return;
+
+    s_sampler.samples.clear();
+    s_sampler.total = 0;
+    s_sampler.stopping = false;
+    s_sampler.sample();
+    s_sampler.thread = std::thread( &Sampler::run, &s_sampler, interval );
+}
+
+//------------------------------------------------------------------------------
+/// Stops the sampler thread, after a last sample. Samples are kept for
+/// joules() until the next start().
+///
+void Energy::stop()
+{
+    {
+        std::lock_guard< std::mutex > guard( s_sampler.mutex );
+        if (! s_sampler.thread.joinable())
+            return;
+        s_sampler.stopping = true;
+    }
+    s_sampler.wake.notify_all();
+    s_sampler.thread.join();
+}
+
+//------------------------------------------------------------------------------
+bool Energy::running()
+{
+    std::lock_guard< std::mutex > guard( s_sampler.mutex );
+    return s_sampler.thread.joinable() && ! s_sampler.stopping;
+}
+
+//------------------------------------------------------------------------------
+std::vector< std::string > Energy::sources()
+{
+    std::lock_guard< std::mutex > guard( s_sampler.mutex );
+    find_sources();
+    std::vector< std::string > names;
+    for (auto& source : s_sampler.sources)
+        names.push_back( source.name );
+    return names;
+}
+
+//------------------------------------------------------------------------------
+/// @return whether there are samples since the last start().
+bool Energy::sampled()
+{
+    std::lock_guard< std::mutex > guard( s_sampler.mutex );
+    return s_sampler.samples.size() > 1;
+}
+
+//------------------------------------------------------------------------------
+/// @return joules used by this node in [t0, t1], summed over all sources,
+/// with times from trace::now(). Energy between samples is interpolated
+/// linearly; times outside the sampled span are clamped to it.
+/// Returns 0 if nothing was sampled.
+///
+double Energy::joules( double t0, double t1 )
+{
+    std::lock_guard< std::mutex > guard( s_sampler.mutex );
+    return energy_at( t1 ) - energy_at( t0 );
+}
+
+} // namespace trace
+} // namespace slate
@@ -5,12 +5,22 @@
 
 #include "slate/internal/Trace.hh"
 
+#include "blas.hh"
+
+#if defined( BLAS_HAVE_CUBLAS )
+    #include <cuda_runtime.h>
+#elif defined( BLAS_HAVE_ROCBLAS )
+    #include <hip/hip_runtime.h>
+#endif
+
 #include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <csignal>
 #include <cstdio>
 #include <ctime>
 #include <limits>
+#include <mutex>
 #include <string>
 
 namespace slate {
@@ -179,11 +189,137 @@ double Trace::hscale_ = 100;
 bool Trace::tracing_ = false;
 int Trace::num_threads_ = omp_get_max_threads();
 
+Trace::Format Trace::format_ = Trace::Format::SVG;
+bool Trace::per_rank_ = false;
+
+int64_t Trace::capacity_ = 0;
+double Trace::window_ = 0;
+bool Trace::analysis_ = false;
+int Trace::dump_rank_ = 0;
+
 std::string comment_;
 
 std::vector<std::vector<Event>> Trace::events_ =
     std::vector<std::vector<Event>>(omp_get_max_threads());
 
+// Number of events each thread has inserted into its ring buffer.
+// Each counter is written only by its own thread; padding to a cache line
+// keeps threads from contending for the line.
+struct alignas(64) RingCount {
+    int64_t count = 0;
+};
+
+static std::vector<RingCount> s_ring_counts =
+    std::vector<RingCount>(omp_get_max_threads());
+
+//------------------------------------------------------------------------------
+// Device events, wrapping CUDA or HIP.
+#if defined( BLAS_HAVE_CUBLAS )
+    #define SLATE_TRACE_DEVICE
+
+    using device_event_t = cudaEvent_t;
+
+    static int device_get() { int d = 0; cudaGetDevice( &d ); return d; }
+    static void device_set( int d ) { cudaSetDevice( d ); }
+
+    static device_event_t device_event_create()
+    {
+        cudaEvent_t event = nullptr;
+        cudaEventCreate( &event );
+        return event;
+    }
+    static void device_event_record( device_event_t event, blas::Queue& queue )
+    {
+        cudaEventRecord( event, queue.stream() );
+    }
+    static bool device_event_done( device_event_t event )
+    {
+        return cudaEventQuery( event ) == cudaSuccess;
+    }
+    static void device_event_sync( device_event_t event )
+    {
+        cudaEventSynchronize( event );
+    }
+    /// @return seconds from event begin to event end.
+    static double device_event_elapsed(
+        device_event_t begin, device_event_t end )
+    {
+        float ms = 0;
+        cudaEventElapsedTime( &ms, begin, end );
+        return ms * 1e-3;
+    }
+
+#elif defined( BLAS_HAVE_ROCBLAS )
+    #define SLATE_TRACE_DEVICE
+
+    using device_event_t = hipEvent_t;
+
+    static int device_get() { int d = 0; hipGetDevice( &d ); return d; }
+    static void device_set( int d ) { hipSetDevice( d ); }
+
+    static device_event_t device_event_create()
+    {
+        hipEvent_t event = nullptr;
+        hipEventCreate( &event );
+        return event;
+    }
+    static void device_event_record( device_event_t event, blas::Queue& queue )
+    {
+        hipEventRecord( event, queue.stream() );
+    }
+    static bool device_event_done( device_event_t event )
+    {
+        return hipEventQuery( event ) == hipSuccess;
+    }
+    static void device_event_sync( device_event_t event )
+    {
+        hipEventSynchronize( event );
+    }
+    /// @return seconds from event begin to event end.
+    static double device_event_elapsed(
+        device_event_t begin, device_event_t end )
+    {
+        float ms = 0;
+        hipEventElapsedTime( &ms, begin, end );
+        return ms * 1e-3;
+    }
+#endif
+
+// Track of events on one device queue.
+// Name is fixed length, so tracks can be sent as bytes.
+struct DeviceTrack {
+    blas::Queue* queue;
+    int device;
+    char name[ 32 ];
+    std::vector<Event> events;
+};
+
+#if defined( SLATE_TRACE_DEVICE )
+// Device block whose stop event hasn't been resolved yet.
+struct PendingBlock {
+    Event event;
+    int track;
+    device_event_t start;
+    device_event_t stop;
+};
+
+// Per device, a reference event completed at host time ref_time,
+// which device event times are measured from, and a pool of events.
+struct DeviceClock {
+    device_event_t ref = nullptr;
+    double ref_time = 0;
+    std::vector<device_event_t> free;
+};
+
+static std::vector<PendingBlock> s_pending;
+static std::map<int, DeviceClock> s_clocks;
+#endif
+
+// Guards the device tracks, pending blocks, clocks, and queue names.
+static std::mutex s_device_mutex;
+static std::vector<DeviceTrack> s_device_tracks;
+static std::map<blas::Queue*, std::string> s_queue_names;
+
 std::map<std::string, Color> function_color_ = {
 
     {"blas::add",   Color::LightSkyBlue},
@@ -277,7 +413,357 @@ void Trace::insert(Event event)
 {
     if (tracing_) {
         event.stop();
-        events_[omp_get_thread_num()].push_back(event);
+        int thread = omp_get_thread_num();
+        if (capacity_ > 0) {
+            int64_t k = s_ring_counts[thread].count++;
+            events_[thread][k % capacity_] = event;
+        }
+        else
+            events_[thread].push_back(event);
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Create a device block, which records a start event on queue before the
+/// work in the block is queued.
+///
+DeviceBlock::DeviceBlock( const char* name, blas::Queue& queue, int64_t index )
+    : event_( name, index, 0 ),
+      queue_( &queue ),
+      start_( nullptr )
+{
+    if (Trace::tracing_)
+        start_ = Trace::recordDeviceEvent( queue );
+}
+
+//------------------------------------------------------------------------------
+/// Destroy a device block, which records a stop event on queue after the
+/// work in the block is queued.
+///
+DeviceBlock::~DeviceBlock()
+{
+    if (start_ != nullptr)
+        Trace::insertDevice( event_, *queue_, start_ );
+}
+
+//------------------------------------------------------------------------------
+/// Names queue's track in the trace; the device number is prepended.
+/// Unnamed queues are named "queue".
+///
+void Trace::nameQueue(blas::Queue* queue, std::string const& name)
+{
+    std::lock_guard<std::mutex> guard( s_device_mutex );
+    s_queue_names[ queue ] = name;
+}
+
+//------------------------------------------------------------------------------
+/// Forgets queue's name, when the queue is destroyed.
+///
+void Trace::unnameQueue(blas::Queue* queue)
+{
+    std::lock_guard<std::mutex> guard( s_device_mutex );
+    s_queue_names.erase( queue );
+}
+
+//------------------------------------------------------------------------------
+/// Records a device event on queue, taken from a pool.
+/// When a device is first traced, also records and waits for a reference
+/// event, to relate device times to host times.
+/// @return the event, or nullptr without GPU support.
+///
+void* Trace::recordDeviceEvent(blas::Queue& queue)
+{
+#if defined( SLATE_TRACE_DEVICE )
+    std::lock_guard<std::mutex> guard( s_device_mutex );
+
+    // Events must be created and recorded on the queue's device.
+    int device = queue.device();
+    int current = device_get();
+    device_set( device );
+
+    DeviceClock& clock = s_clocks[ device ];
+    if (clock.ref == nullptr) {
+        clock.ref = device_event_create();
+        device_event_record( clock.ref, queue );
+        device_event_sync( clock.ref );
+        clock.ref_time = now();
+    }
+
+    device_event_t event;
+    if (clock.free.empty()) {
+        event = device_event_create();
+    }
+    else {
+        event = clock.free.back();
+        clock.free.pop_back();
+    }
+    device_event_record( event, queue );
+
+    device_set( current );
+    return event;
+#else
+    return nullptr;
+#endif
+}
+
+//------------------------------------------------------------------------------
+/// Records the stop event of a device block and queues the block to be
+/// resolved. Resolves blocks that have completed meanwhile.
+///
+void Trace::insertDevice(Event event, blas::Queue& queue, void* start)
+{
+#if defined( SLATE_TRACE_DEVICE )
+    void* stop = recordDeviceEvent( queue );
+
+    std::lock_guard<std::mutex> guard( s_device_mutex );
+
+    // Find the queue's track; tracks are few.
+    int track = 0;
+    int num_tracks = int( s_device_tracks.size() );
+    while (track < num_tracks && s_device_tracks[ track ].queue != &queue)
+        ++track;
+    if (track == num_tracks) {
+        auto iter = s_queue_names.find( &queue );
+        DeviceTrack new_track;
+        new_track.queue = &queue;
+        new_track.device = queue.device();
+        snprintf( new_track.name, sizeof(new_track.name), "%s",
+                  iter == s_queue_names.end() ? "queue"
+                                              : iter->second.c_str() );
+        s_device_tracks.push_back( new_track );
+    }
+
+    s_pending.push_back( { event, track, device_event_t( start ),
+                           device_event_t( stop ) } );
+    resolveDevice( false );
+#endif
+}
+
+//------------------------------------------------------------------------------
+/// Moves completed device blocks into their tracks, converting device
+/// times to host times. If wait, first waits for all blocks to complete.
+/// Caller holds s_device_mutex.
+///
+void Trace::resolveDevice(bool wait)
+{
+#if defined( SLATE_TRACE_DEVICE )
+    size_t n = 0;
+    for (auto& block : s_pending) {
+        if (wait)
+            device_event_sync( block.stop );
+        else if (! device_event_done( block.stop )) {
+            s_pending[ n++ ] = block;
+            continue;
+        }
+
+        DeviceTrack& track = s_device_tracks[ block.track ];
+        DeviceClock& clock = s_clocks[ track.device ];
+        block.event.start_
+            = clock.ref_time + device_event_elapsed( clock.ref, block.start );
+        block.event.stop_
+            = clock.ref_time + device_event_elapsed( clock.ref, block.stop );
+        track.events.push_back( block.event );
+
+        // In ring buffer mode, bound device tracks too, dropping the
+        // older half when full.
+        if (capacity_ > 0 && int64_t( track.events.size() ) >= 2*capacity_) {
+            track.events.erase( track.events.begin(),
+                                track.events.begin() + capacity_ );
+        }
+
+        clock.free.push_back( block.start );
+        clock.free.push_back( block.stop );
+    }
+    s_pending.resize( n );
+#endif
+}
+
+//------------------------------------------------------------------------------
+/// Calls func( event ) for all host and device events.
+///
+template <typename Func>
+void Trace::forEachEvent(Func func)
+{
+    for (auto& thread : events_)
+        for (auto& event : thread)
+            func( event );
+    for (auto& track : s_device_tracks)
+        for (auto& event : track.events)
+            func( event );
+}
+
+//------------------------------------------------------------------------------
+/// @return events of each device queue's track; valid until the next
+/// clear(). Call after collect().
+///
+std::vector< std::vector<Event> const* > Trace::deviceTracks()
+{
+    std::vector< std::vector<Event> const* > tracks;
+    for (auto& track : s_device_tracks)
+        tracks.push_back( &track.events );
+    return tracks;
+}
+
+//------------------------------------------------------------------------------
+/// Sets the capacity of each thread's ring buffer, in events; 0 is unbounded.
+/// The buffers are allocated here, so inserting an event never allocates
+/// or locks. Discards events recorded so far; call while tracing is off.
+///
+void Trace::capacity(int64_t n)
+{
+    assert(n >= 0);
+    capacity_ = n;
+    clear();
+}
+
+//------------------------------------------------------------------------------
+/// Discards all events. In ring buffer mode, (re)allocates the buffers.
+///
+void Trace::clear()
+{
+    for (int thread = 0; thread < int(events_.size()); ++thread) {
+        events_[thread].clear();
+        if (capacity_ > 0)
+            events_[thread].resize(capacity_);
+        else
+            events_[thread].shrink_to_fit();
+        s_ring_counts[thread].count = 0;
+    }
+
+    // Discard device events. Reference events are recorded anew
+    // when tracing resumes, so device times don't drift.
+    std::lock_guard<std::mutex> guard( s_device_mutex );
+    #if defined( SLATE_TRACE_DEVICE )
+        for (auto& block : s_pending) {
+            device_event_sync( block.stop );
+            DeviceClock& clock = s_clocks[ s_device_tracks[ block.track ].device ];
+            clock.free.push_back( block.start );
+            clock.free.push_back( block.stop );
+        }
+        s_pending.clear();
+        for (auto& iter : s_clocks) {
+            DeviceClock& clock = iter.second;
+            if (clock.ref != nullptr) {
+                clock.free.push_back( clock.ref );
+                clock.ref = nullptr;
+            }
+        }
+    #endif
+    s_device_tracks.clear();
+}
+
+//------------------------------------------------------------------------------
+/// Puts each thread's events in order, oldest first, as output expects.
+/// In ring buffer mode, this unrolls the ring. If device, waits for and
+/// resolves pending device blocks. Then, in flight recorder mode, drops
+/// events that ended more than window seconds ago.
+///
+void Trace::collect(bool device)
+{
+    if (device) {
+        std::lock_guard<std::mutex> guard( s_device_mutex );
+        resolveDevice( true );
+    }
+
+    auto expired = [cutoff = now() - window_](Event const& event) {
+        return event.stop_ < cutoff;
+    };
+    for (int thread = 0; thread < int(events_.size()); ++thread) {
+        auto& events = events_[thread];
+        if (capacity_ > 0) {
+            int64_t count = s_ring_counts[thread].count;
+            if (count < capacity_)
+                events.resize(count);
+            else
+                std::rotate(events.begin(), events.begin() + count % capacity_,
+                            events.end());
+            s_ring_counts[thread].count = 0;
+        }
+        if (window_ > 0) {
+            events.erase(std::remove_if(events.begin(), events.end(), expired),
+                         events.end());
+        }
+    }
+    if (window_ > 0) {
+        for (auto& track : s_device_tracks) {
+            auto& events = track.events;
+            events.erase(std::remove_if(events.begin(), events.end(), expired),
+                         events.end());
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Signal handler that dumps this rank's events, then re-raises the signal
+/// with its default action, e.g., to terminate.
+///
+extern "C" void trace_dump_signal_handler(int signum)
+{
+    Trace::dump();
+    std::signal(signum, SIG_DFL);
+    std::raise(signum);
+}
+
+//------------------------------------------------------------------------------
+/// Installs a handler that dumps this rank's events when signal signum
+/// (e.g., SIGTERM when the job is killed, or SIGUSR1 on request) arrives.
+/// Records the MPI rank now, since MPI cannot be called from the handler.
+///
+void Trace::dumpOnSignal(int signum)
+{
+    int initialized = 0;
+    MPI_Initialized(&initialized);
+    if (initialized)
+        MPI_Comm_rank(MPI_COMM_WORLD, &dump_rank_);
+    std::signal(signum, trace_dump_signal_handler);
+}
+
+//------------------------------------------------------------------------------
+/// Writes this rank's events to trace_dump_<rank>.json, without MPI, so it
+/// can be called when the job is dying, e.g., from a signal handler.
+/// Device blocks not yet resolved are omitted, to not wait on the device
+/// or take its lock.
+/// Writing files isn't async-signal-safe, so this is best effort.
+/// Times are relative to this rank's earliest event, since ranks aren't
+/// aligned at a barrier as in finish(). Tracing stops, and events are
+/// discarded after writing.
+///
+void Trace::dump()
+{
+    tracing_ = false;
+    collect( false );
+
+    double earliest = std::numeric_limits<double>::max();
+    forEachEvent([&](Event& event) {
+        earliest = std::min(earliest, event.start_);
+    });
+    forEachEvent([&](Event& event) {
+        event.start_ -= earliest;
+        event.stop_  -= earliest;
+    });
+
+    char file_name[ 64 ];
+    snprintf(file_name, sizeof(file_name), "trace_dump_%d.json", dump_rank_);
+    FILE* trace_file = fopen(file_name, "w");
+    if (trace_file == nullptr)
+        return;
+    bool first = true;
+    fprintf(trace_file, "{\"traceEvents\": [\n");
+    printJSONEvents(dump_rank_, trace_file, first);
+    fprintf(trace_file,
+            "\n],\n"
+            "\"displayTimeUnit\": \"ms\"\n"
+            "}\n");
+    fclose(trace_file);
+    fprintf(stderr, "trace file: %s\n", file_name);
+
+    // Discard host events. Device events are left, as the device lock
+    // may be held by the interrupted thread.
+    for (int thread = 0; thread < int(events_.size()); ++thread) {
+        events_[thread].clear();
+        if (capacity_ > 0)
+            events_[thread].resize(capacity_);
+        s_ring_counts[thread].count = 0;
     }
 }
 
@@ -302,6 +788,33 @@ std::string cleanName(std::string const& name)
     return name_cleaned;
 }
 
+//------------------------------------------------------------------------------
+/// Returns str as a quoted JSON string, escaping special characters.
+///
+std::string jsonString(std::string const& str)
+{
+    std::string json = "\"";
+    for (char ch : str) {
+        if (ch == '"' || ch == '\\') {
+            json += '\\';
+            json += ch;
+        }
+        else if (ch == '\n') {
+            json += "\\n";
+        }
+        else if ((unsigned char)ch < 0x20) {
+            char buf[ 8 ];
+            snprintf( buf, sizeof(buf), "\\u%04x", ch );
+            json += buf;
+        }
+        else {
+            json += ch;
+        }
+    }
+    json += '"';
+    return json;
+}
+
 //------------------------------------------------------------------------------
 /// Returns an rgb color darkened by factor, i.e.,
 /// r * factor, g * factor, b * factor.
@@ -358,6 +871,22 @@ const char* gradient =
 ///
 void Trace::finish()
 {
+    collect();
+
+    if (analysis_) {
+        analyze();
+        analyzeEnergy();
+    }
+
+    if (format_ == Format::None) {
+        clear();
+        return;
+    }
+    if (format_ == Format::JSON) {
+        finishJSON();
+        return;
+    }
+
     // Find rank and size.
     int mpi_rank;
     int mpi_size;
@@ -449,8 +978,153 @@ void Trace::finish()
     }
 
     // Clear events.
-    for (auto& thread : events_)
-        thread.clear();
+    clear();
+}
+
+//------------------------------------------------------------------------------
+/// Writes the events in Chrome trace JSON format, which Perfetto
+/// (ui.perfetto.dev) and chrome://tracing open, with MPI rank as pid and
+/// thread as tid. Each event's color from function_color_ is in its args.
+/// Events are gathered on rank 0, one rank at a time, or with per_rank,
+/// each rank writes its own file, trace_<time>_<rank>.json, which
+/// Perfetto can open together.
+///
+void Trace::finishJSON()
+{
+    // Find rank and size.
+    int mpi_rank;
+    int mpi_size;
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpi_rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpi_size);
+    MPI_Barrier(MPI_COMM_WORLD);
+
+    // Clocks on different nodes are not synchronized, so align all ranks
+    // at the barrier above, then shift so the earliest event is at time 0.
+    double barrier_time = now();
+    double earliest = 0;
+    forEachEvent([&](Event& event) {
+        earliest = std::min(earliest, event.start_ - barrier_time);
+    });
+    double temp = -earliest;
+    double shift;
+    MPI_Allreduce(&temp, &shift, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+    forEachEvent([&](Event& event) {
+        event.start_ += shift - barrier_time;
+        event.stop_  += shift - barrier_time;
+    });
+
+    // All ranks use rank 0's time stamp in the file name.
+    long int stamp = time(nullptr);
+    MPI_Bcast(&stamp, 1, MPI_LONG, 0, MPI_COMM_WORLD);
+    std::string file_name("trace_" + std::to_string(stamp));
+    if (per_rank_)
+        file_name += "_" + std::to_string(mpi_rank);
+    file_name += ".json";
+
+    // Print header.
+    FILE* trace_file = nullptr;
+    bool first = true;
+    if (per_rank_ || mpi_rank == 0) {
+        trace_file = fopen(file_name.c_str(), "w");
+        assert(trace_file != nullptr);
+        fprintf(trace_file, "{\"traceEvents\": [\n");
+    }
+
+    // Print the events.
+    if (per_rank_) {
+        printJSONEvents(mpi_rank, trace_file, first);
+    }
+    else if (mpi_rank == 0) {
+        printJSONEvents(0, trace_file, first);
+        for (int rank = 1; rank < mpi_size; ++rank) {
+            recvProcEvents(rank);
+            printJSONEvents(rank, trace_file, first);
+        }
+    }
+    else
+        sendProcEvents();
+
+    // Finish the trace file.
+    if (per_rank_ || mpi_rank == 0) {
+        fprintf(trace_file,
+                "\n],\n"
+                "\"displayTimeUnit\": \"ms\",\n"
+                "\"otherData\": {\"comment\": %s}\n"
+                "}\n",
+                jsonString(comment_).c_str());
+        fclose(trace_file);
+    }
+    if (mpi_rank == 0) {
+        if (per_rank_)
+            fprintf(stderr, "trace files: trace_%ld_*.json\n", stamp);
+        else
+            fprintf(stderr, "trace file: %s\n", file_name.c_str());
+    }
+
+    // Clear events.
+    clear();
+}
+
+//------------------------------------------------------------------------------
+/// Prints the events of one rank as Chrome trace complete ("X") events,
+/// with times in microseconds, preceded by metadata naming the process and
+/// threads. Device queue tracks follow the threads.
+///
+void Trace::printJSONEvents(int mpi_rank, FILE* trace_file, bool& first)
+{
+    using llong = long long;
+
+    fprintf(trace_file,
+            "%s{\"name\": \"process_name\", \"ph\": \"M\", \"pid\": %d, "
+            "\"args\": {\"name\": \"rank %d\"}},\n"
+            "{\"name\": \"process_sort_index\", \"ph\": \"M\", \"pid\": %d, "
+            "\"args\": {\"sort_index\": %d}}",
+            first ? "" : ",\n", mpi_rank, mpi_rank, mpi_rank, mpi_rank);
+    first = false;
+
+    auto print_events = [&](std::vector<Event> const& events, int tid) {
+        for (auto& event : events) {
+            std::string color;
+            auto iter = function_color_.find(event.name_);
+            if (iter != function_color_.end()) {
+                char buf[ 32 ];
+                snprintf(buf, sizeof(buf), ", \"color\": \"#%06x\"",
+                         (unsigned int)iter->second);
+                color = buf;
+            }
+            fprintf(trace_file,
+                    ",\n{\"name\": %s, \"cat\": \"slate\", \"ph\": \"X\", "
+                    "\"pid\": %d, \"tid\": %d, \"ts\": %.3f, \"dur\": %.3f, "
+                    "\"args\": {\"index\": %lld%s}}",
+                    jsonString(event.name_).c_str(), mpi_rank, tid,
+                    event.start_ * 1e6, (event.stop_ - event.start_) * 1e6,
+                    llong( event.index_ ), color.c_str());
+        }
+    };
+
+    for (int thread = 0; thread < num_threads_; ++thread) {
+        fprintf(trace_file,
+                ",\n{\"name\": \"thread_name\", \"ph\": \"M\", "
+                "\"pid\": %d, \"tid\": %d, "
+                "\"args\": {\"name\": \"thread %d\"}}",
+                mpi_rank, thread, thread);
+        print_events(events_[thread], thread);
+    }
+
+    for (int track = 0; track < int(s_device_tracks.size()); ++track) {
+        auto& device_track = s_device_tracks[track];
+        int tid = num_threads_ + track;
+        fprintf(trace_file,
+                ",\n{\"name\": \"thread_name\", \"ph\": \"M\", "
+                "\"pid\": %d, \"tid\": %d, "
+                "\"args\": {\"name\": \"device %d %s\"}},\n"
+                "{\"name\": \"thread_sort_index\", \"ph\": \"M\", "
+                "\"pid\": %d, \"tid\": %d, "
+                "\"args\": {\"sort_index\": %d}}",
+                mpi_rank, tid, device_track.device, device_track.name,
+                mpi_rank, tid, tid);
+        print_events(device_track.events, tid);
+    }
 }
 
 //------------------------------------------------------------------------------
@@ -620,6 +1294,21 @@ void Trace::sendProcEvents()
         MPI_Send(&events_[thread][0], sizeof(Event)*num_events, MPI_BYTE,
                  0, 0, MPI_COMM_WORLD);
     }
+
+    // Send the device tracks: the number of tracks, then for each track,
+    // its device and name, the number of events, and the events.
+    long int num_tracks = s_device_tracks.size();
+    MPI_Send(&num_tracks, 1, MPI_LONG, 0, 0, MPI_COMM_WORLD);
+    for (auto& track : s_device_tracks) {
+        MPI_Send(&track.device, 1, MPI_INT, 0, 0, MPI_COMM_WORLD);
+        MPI_Send(track.name, sizeof(track.name), MPI_CHAR,
+                 0, 0, MPI_COMM_WORLD);
+
+        long int num_events = track.events.size();
+        MPI_Send(&num_events, 1, MPI_LONG, 0, 0, MPI_COMM_WORLD);
+        MPI_Send(track.events.data(), sizeof(Event)*num_events, MPI_BYTE,
+                 0, 0, MPI_COMM_WORLD);
+    }
 }
 
 //------------------------------------------------------------------------------
@@ -638,6 +1327,26 @@ void Trace::recvProcEvents(int rank)
         MPI_Recv(&events_[thread][0], sizeof(Event)*num_events, MPI_BYTE,
                  rank, 0, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
     }
+
+    // Receive the device tracks, replacing this rank's, which were printed.
+    long int num_tracks;
+    MPI_Recv(&num_tracks, 1, MPI_LONG, rank, 0, MPI_COMM_WORLD,
+             MPI_STATUS_IGNORE);
+    s_device_tracks.resize(num_tracks);
+    for (auto& track : s_device_tracks) {
+        track.queue = nullptr;
+        MPI_Recv(&track.device, 1, MPI_INT, rank, 0, MPI_COMM_WORLD,
+                 MPI_STATUS_IGNORE);
+        MPI_Recv(track.name, sizeof(track.name), MPI_CHAR,
+                 rank, 0, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+
+        long int num_events;
+        MPI_Recv(&num_events, 1, MPI_LONG, rank, 0, MPI_COMM_WORLD,
+                 MPI_STATUS_IGNORE);
+        track.events.resize(num_events);
+        MPI_Recv(track.events.data(), sizeof(Event)*num_events, MPI_BYTE,
+                 rank, 0, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+    }
 }
 
 } // namespace trace
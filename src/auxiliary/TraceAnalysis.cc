@@ -0,0 +1,469 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/internal/Trace.hh"
+#include "slate/internal/Energy.hh"
+
+#include <algorithm>
+#include <cstdio>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace slate {
+namespace trace {
+
+namespace {
+
+//------------------------------------------------------------------------------
+/// Phases of a k-loop step, with the suffix of their Block names.
+/// Bcast blocks are nested inside the panel block of the same step.
+///
+enum Phase {
+    Panel,
+    Bcast,
+    Lookahead,
+    Trailing,
+    NumPhases,
+};
+
+const char* phase_suffix[ NumPhases ] = {
+    "::panel", "::bcast", "::lookahead", "::trailing"
+};
+
+const char* phase_label[ NumPhases ] = {
+    "panel", "comm", "lookahead", "trailing"
+};
+
+/// Idle fraction above which a step is considered starved of work.
+const double idle_threshold = 0.25;
+
+//------------------------------------------------------------------------------
+/// Event of a k-loop phase, e.g., "getrf::panel" with index k.
+struct PhaseEvent {
+    std::string routine;
+    int phase;
+    int64_t k;
+    int64_t run;
+    double start;
+    double stop;
+};
+
+//------------------------------------------------------------------------------
+/// One step of the k-loop, from the start of panel k to the start of
+/// panel k+1 (or the end of the run, for the last step).
+/// time[ phase ] splits the step's length along the critical path:
+/// panel compute, then its broadcasts, then the wait for the update of
+/// column k+1, attributed to the lookahead or trailing update that
+/// finished last before panel k+1 started.
+/// Broadcasts are usually nested in the panel block, but may follow it,
+/// as with TaskRuntime::WorkStealing.
+struct Step {
+    std::string routine;
+    int64_t run;
+    int64_t k;
+    double start;
+    double stop;
+    double panel_stop;  ///< end of the panel block
+    double chain_stop;  ///< end of the panel and broadcasts following it
+    double nested;      ///< time of broadcasts nested in the panel block
+    double time[ NumPhases ];
+    double busy;        ///< busy thread time in [start, stop)
+    double capacity;    ///< num_threads * (stop - start)
+    double exposed;     ///< this rank's panel and broadcast time of step k
+    double hidden;      ///< of exposed, overlapped by earlier steps' updates
+    double device_busy; ///< of exposed, overlapped by work on a device queue
+};
+
+//------------------------------------------------------------------------------
+/// @return phase of an event name, setting routine to its prefix;
+/// or -1 if name is not a k-loop phase.
+int phaseOf( char const* name, std::string& routine )
+{
+    std::string str( name );
+    for (int phase = 0; phase < NumPhases; ++phase) {
+        std::string suffix( phase_suffix[ phase ] );
+        if (str.size() > suffix.size()
+            && str.compare( str.size() - suffix.size(), suffix.size(),
+                            suffix ) == 0) {
+            routine = str.substr( 0, str.size() - suffix.size() );
+            return phase;
+        }
+    }
+    return -1;
+}
+
+//------------------------------------------------------------------------------
+/// Sorts intervals, then merges nested and overlapping ones,
+/// so they are disjoint.
+void merge( std::vector< std::pair<double, double> >& intervals )
+{
+    std::sort( intervals.begin(), intervals.end() );
+    size_t n = 0;
+    for (auto& interval : intervals) {
+        if (n > 0 && interval.first <= intervals[ n-1 ].second) {
+            intervals[ n-1 ].second = std::max( intervals[ n-1 ].second,
+                                                interval.second );
+        }
+        else {
+            intervals[ n++ ] = interval;
+        }
+    }
+    intervals.resize( n );
+}
+
+//------------------------------------------------------------------------------
+/// @return length of the overlap of [start, stop) with the sorted,
+/// disjoint intervals.
+double overlap( std::vector< std::pair<double, double> > const& intervals,
+                double start, double stop )
+{
+    auto iter = std::lower_bound(
+        intervals.begin(), intervals.end(), start,
+        [](std::pair<double, double> const& interval, double t) {
+            return interval.second <= t;
+        });
+    double sum = 0;
+    for (; iter != intervals.end() && iter->first < stop; ++iter) {
+        sum += std::min( iter->second, stop ) - std::max( iter->first, start );
+    }
+    return sum;
+}
+
+} // anonymous namespace
+
+//------------------------------------------------------------------------------
+/// Critical-path and idle-time analysis of factorization k-loops,
+/// printed on rank 0 at finish() if analysis() is on.
+///
+/// Drivers mark the tasks of each step k with Blocks named
+/// "routine::panel", "routine::bcast" (inside the panel),
+/// "routine::lookahead", and "routine::trailing", all with index k.
+/// A run of a routine starts at panel 0. For each step, this reports the
+/// critical-path length (panel k start to panel k+1 start), how it splits
+/// into panel compute, broadcasts, and waiting for the update of the next
+/// panel; which of these bounds the step; and the fraction of thread time
+/// spent outside any traced block, i.e., idle.
+///
+/// For overlap, it reports the fraction of each step's panel and broadcast
+/// time that ran while a lookahead or trailing update of an earlier step
+/// was running, i.e., was hidden behind update work, and the fraction that
+/// ran while any device queue was busy, from DeviceBlocks. A pipeline
+/// whose lookahead works hides most of each panel behind the previous
+/// trailing update.
+///
+/// Lengths and phase times are the max over ranks; idle time is summed
+/// over ranks. Ranks must have recorded the same steps, as all ranks
+/// create the same tasks. Collective on MPI_COMM_WORLD.
+///
+void Trace::analyze()
+{
+    int mpi_rank, mpi_size;
+    MPI_Comm_rank( MPI_COMM_WORLD, &mpi_rank );
+    MPI_Comm_size( MPI_COMM_WORLD, &mpi_size );
+
+    // Collect phase events, and each thread's busy intervals.
+    std::vector< PhaseEvent > events;
+    std::vector< std::vector< std::pair<double, double> > > busy( events_.size() );
+    for (size_t thread = 0; thread < events_.size(); ++thread) {
+        auto& intervals = busy[ thread ];
+        for (auto& event : events_[ thread ]) {
+            intervals.push_back( { event.start_, event.stop_ } );
+            std::string routine;
+            int phase = phaseOf( event.name_, routine );
+            if (phase >= 0) {
+                events.push_back( { routine, phase, event.index_, -1,
+                                    event.start_, event.stop_ } );
+            }
+        }
+        // Merge nested and overlapping intervals.
+        merge( intervals );
+    }
+
+    // Busy intervals of all device queues.
+    std::vector< std::pair<double, double> > device;
+    for (auto track : deviceTracks()) {
+        for (auto& event : *track)
+            device.push_back( { event.start_, event.stop_ } );
+    }
+    merge( device );
+    std::sort( events.begin(), events.end(),
+               [](PhaseEvent const& a, PhaseEvent const& b) {
+                   return a.start < b.start;
+               });
+
+    // Panels start steps; a panel 0, or a panel not after the routine's
+    // previous one, starts a new run.
+    std::vector< Step > steps;
+    std::map< std::pair<int64_t, int64_t>, size_t > step_index; // (run, k)
+    std::map< std::string, int64_t > last_run;      // routine => run
+    std::map< std::string, int64_t > last_k;        // routine => k
+    std::vector< double > run_stop;
+    for (auto& event : events) {
+        if (event.phase != Panel)
+            continue;
+        auto iter = last_run.find( event.routine );
+        if (iter == last_run.end() || event.k == 0
+            || event.k <= last_k[ event.routine ]) {
+            last_run[ event.routine ] = run_stop.size();
+            run_stop.push_back( event.stop );
+        }
+        event.run = last_run[ event.routine ];
+        last_k[ event.routine ] = event.k;
+
+        Step step = {};
+        step.routine = event.routine;
+        step.run     = event.run;
+        step.k       = event.k;
+        step.start   = event.start;
+        step.stop    = event.stop;
+        step.panel_stop = event.stop;
+        step.chain_stop = event.stop;
+        step_index[ { step.run, step.k } ] = steps.size();
+        steps.push_back( step );
+    }
+
+    // Assign other phases to the latest run of their routine that started
+    // before them.
+    std::map< std::string, std::vector< std::pair<double, int64_t> > > runs;
+    for (auto& step : steps) {
+        if (runs[ step.routine ].empty()
+            || runs[ step.routine ].back().second != step.run)
+            runs[ step.routine ].push_back( { step.start, step.run } );
+    }
+    for (auto& event : events) {
+        if (event.phase == Panel) {
+            run_stop[ event.run ] = std::max( run_stop[ event.run ], event.stop );
+            continue;
+        }
+        auto& list = runs[ event.routine ];
+        auto iter = std::upper_bound(
+            list.begin(), list.end(), event.start,
+            [](double t, std::pair<double, int64_t> const& run) {
+                return t < run.first;
+            });
+        if (iter == list.begin())
+            continue;  // started before any recorded panel
+        event.run = (iter - 1)->second;
+        run_stop[ event.run ] = std::max( run_stop[ event.run ], event.stop );
+        if (event.phase == Bcast) {
+            auto step = step_index.find( { event.run, event.k } );
+            if (step != step_index.end()) {
+                Step& s = steps[ step->second ];
+                s.time[ Bcast ] += event.stop - event.start;
+                if (event.start >= s.start && event.stop <= s.panel_stop)
+                    s.nested += event.stop - event.start;
+                else
+                    s.chain_stop = std::max( s.chain_stop, event.stop );
+            }
+        }
+    }
+
+    // Panel and broadcast intervals of each step on this rank.
+    std::map< std::pair<int64_t, int64_t>,
+              std::vector< std::pair<double, double> > > exposed; // (run, k)
+    for (auto& event : events) {
+        if (event.run >= 0 && (event.phase == Panel || event.phase == Bcast))
+            exposed[ { event.run, event.k } ].push_back(
+                { event.start, event.stop } );
+    }
+
+    // Split each step along the critical path, and find its idle time
+    // and overlap.
+    for (size_t i = 0; i < steps.size(); ++i) {
+        Step& step = steps[ i ];
+        auto next = step_index.find( { step.run, step.k + 1 } );
+        step.stop = next != step_index.end()
+                  ? steps[ next->second ].start
+                  : run_stop[ step.run ];
+        step.time[ Panel ] = std::max( 0.0, step.panel_stop - step.start
+                                            - step.nested );
+
+        // The update that finished last before the next panel started.
+        int update = Lookahead;
+        double update_stop = -1;
+        for (auto& event : events) {
+            if (event.run == step.run && event.k <= step.k
+                && (event.phase == Lookahead || event.phase == Trailing)
+                && event.stop <= step.stop && event.stop > update_stop) {
+                update = event.phase;
+                update_stop = event.stop;
+            }
+        }
+        step.time[ update ] = std::max( 0.0, step.stop - step.chain_stop );
+
+        for (auto& intervals : busy)
+            step.busy += overlap( intervals, step.start, step.stop );
+        step.capacity = busy.size() * (step.stop - step.start);
+
+        // Panel and broadcasts of step k are hidden where they overlap
+        // the updates of earlier steps, e.g., the trailing update of k-1.
+        auto& intervals = exposed[ { step.run, step.k } ];
+        merge( intervals );
+        std::vector< std::pair<double, double> > updates;
+        for (auto& event : events) {
+            if (event.run == step.run && event.k < step.k
+                && (event.phase == Lookahead || event.phase == Trailing))
+                updates.push_back( { event.start, event.stop } );
+        }
+        merge( updates );
+        for (auto& interval : intervals) {
+            step.exposed += interval.second - interval.first;
+            step.hidden += overlap( updates, interval.first, interval.second );
+            step.device_busy += overlap( device, interval.first,
+                                         interval.second );
+        }
+    }
+
+    // Reduce over ranks, padding missing steps with zeros.
+    int num_steps = steps.size();
+    int max_steps = num_steps;
+    MPI_Allreduce( &num_steps, &max_steps, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD );
+    if (max_steps == 0)
+        return;
+
+    const int num_max = 1 + NumPhases, num_sum = 5;
+    std::vector< double > max_vals( num_max * max_steps, 0 );
+    std::vector< double > sum_vals( num_sum * max_steps, 0 );
+    for (int i = 0; i < num_steps; ++i) {
+        max_vals[ num_max*i ] = steps[ i ].stop - steps[ i ].start;
+        for (int phase = 0; phase < NumPhases; ++phase)
+            max_vals[ num_max*i + 1 + phase ] = steps[ i ].time[ phase ];
+        sum_vals[ num_sum*i + 0 ] = steps[ i ].busy;
+        sum_vals[ num_sum*i + 1 ] = steps[ i ].capacity;
+        sum_vals[ num_sum*i + 2 ] = steps[ i ].exposed;
+        sum_vals[ num_sum*i + 3 ] = steps[ i ].hidden;
+        sum_vals[ num_sum*i + 4 ] = steps[ i ].device_busy;
+    }
+    if (mpi_size > 1) {
+        std::vector< double > max_local( max_vals ), sum_local( sum_vals );
+        MPI_Reduce( max_local.data(), max_vals.data(), max_vals.size(),
+                    MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD );
+        MPI_Reduce( sum_local.data(), sum_vals.data(), sum_vals.size(),
+                    MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD );
+    }
+    if (mpi_rank != 0)
+        return;
+
+    // Print steps, then a summary of each run.
+    printf( "\ntrace analysis: critical path by k-loop step"
+            " (max over ranks), idle thread time (all ranks),\n"
+            "panel+comm time hidden behind earlier updates"
+            " and overlapped by device queues (all ranks)\n"
+            "%-16s %6s %10s %10s %10s %10s %10s %6s %6s %6s  %s\n",
+            "routine", "k", "path (ms)", "panel (ms)", "comm (ms)",
+            "look. (ms)", "trail (ms)", "idle", "hidden", "dev", "bound" );
+    int64_t i = 0;
+    while (i < num_steps) {
+        int64_t begin = i;
+        double run_length = 0, run_busy = 0, run_capacity = 0;
+        double run_exposed = 0, run_hidden = 0, run_device = 0;
+        int bound_count[ NumPhases ] = {};
+        for (; i < num_steps && steps[ i ].run == steps[ begin ].run; ++i) {
+            double* vals = &max_vals[ num_max*i ];
+            double* sums = &sum_vals[ num_sum*i ];
+            double idle = sums[ 1 ] > 0 ? 1 - sums[ 0 ] / sums[ 1 ] : 0;
+            double hidden = sums[ 2 ] > 0 ? sums[ 3 ] / sums[ 2 ] : 0;
+            double dev    = sums[ 2 ] > 0 ? sums[ 4 ] / sums[ 2 ] : 0;
+            int bound = std::max_element( vals + 1, vals + 1 + NumPhases )
+                      - (vals + 1);
+            bound_count[ bound ] += 1;
+            run_length   += vals[ 0 ];
+            run_busy     += sums[ 0 ];
+            run_capacity += sums[ 1 ];
+            run_exposed  += sums[ 2 ];
+            run_hidden   += sums[ 3 ];
+            run_device   += sums[ 4 ];
+            printf( "%-16s %6lld %10.3f %10.3f %10.3f %10.3f %10.3f"
+                    " %5.1f%% %5.1f%% %5.1f%%  %s\n",
+                    steps[ i ].routine.c_str(), (long long) steps[ i ].k,
+                    vals[ 0 ]*1e3, vals[ 1 + Panel ]*1e3, vals[ 1 + Bcast ]*1e3,
+                    vals[ 1 + Lookahead ]*1e3, vals[ 1 + Trailing ]*1e3,
+                    idle*100, hidden*100, dev*100, phase_label[ bound ] );
+        }
+
+        double idle = run_capacity > 0 ? 1 - run_busy / run_capacity : 0;
+        int dominant = std::max_element( bound_count, bound_count + NumPhases )
+                     - bound_count;
+        printf( "%s: %lld steps, path %.3f ms, idle %.1f%%;"
+                " steps bound by panel %d, comm %d, lookahead %d, trailing %d\n",
+                steps[ begin ].routine.c_str(), (long long) (i - begin),
+                run_length*1e3, idle*100,
+                bound_count[ Panel ], bound_count[ Bcast ],
+                bound_count[ Lookahead ], bound_count[ Trailing ] );
+        printf( "    overlap: %.1f%% of panel+comm time hidden behind updates,"
+                " %.1f%% overlapped by device queues\n",
+                run_exposed > 0 ? 100 * run_hidden / run_exposed : 0,
+                run_exposed > 0 ? 100 * run_device / run_exposed : 0 );
+        if (idle < idle_threshold)
+            printf( "    threads are mostly busy:"
+                    " more lookahead or panel threads is unlikely to help\n" );
+        else if (dominant == Panel)
+            printf( "    panel bound with idle threads:"
+                    " more Option::MaxPanelThreads may help\n" );
+        else if (dominant == Trailing)
+            printf( "    waiting on the trailing update:"
+                    " more Option::Lookahead is unlikely to help\n" );
+        else
+            printf( "    waiting on %s with idle threads:"
+                    " more Option::Lookahead may help\n",
+                    phase_label[ dominant ] );
+    }
+    printf( "\n" );
+}
+
+//------------------------------------------------------------------------------
+/// Prints the energy of each block name on rank 0's node, from the
+/// samples of Energy, if it ran: for each name, the joules used while any
+/// block of that name was running on rank 0, and the average power then.
+/// Concurrent blocks of different names each get the node's whole energy
+/// while they overlap, so, like inclusive time, energies of nested or
+/// concurrent blocks don't add up. The node's energy includes other ranks
+/// on the node. Not collective; does nothing if rank 0 has no samples.
+///
+void Trace::analyzeEnergy()
+{
+    int mpi_rank;
+    MPI_Comm_rank( MPI_COMM_WORLD, &mpi_rank );
+    if (mpi_rank != 0 || ! Energy::sampled())
+        return;
+
+    std::map< std::string, std::vector< std::pair<double, double> > > blocks;
+    for (auto& thread : events_)
+        for (auto& event : thread)
+            blocks[ event.name_ ].push_back( { event.start_, event.stop_ } );
+
+    struct Row {
+        std::string name;
+        double time;
+        double joules;
+    };
+    std::vector< Row > rows;
+    for (auto& iter : blocks) {
+        auto& intervals = iter.second;
+        merge( intervals );
+        Row row = { iter.first, 0, 0 };
+        for (auto& interval : intervals) {
+            row.time   += interval.second - interval.first;
+            row.joules += Energy::joules( interval.first, interval.second );
+        }
+        rows.push_back( row );
+    }
+    std::sort( rows.begin(), rows.end(),
+               [](Row const& a, Row const& b) { return a.joules > b.joules; } );
+
+    printf( "\ntrace energy: by block name, on rank 0's node\n"
+            "%-32s %10s %10s %10s\n", "block", "time (ms)", "energy (J)",
+            "power (W)" );
+    for (auto& row : rows) {
+        printf( "%-32s %10.3f %10.3f %10.1f\n", row.name.c_str(),
+                row.time*1e3, row.joules,
+                row.time > 0 ? row.joules / row.time : 0 );
+    }
+    printf( "\n" );
+}
+
+} // namespace trace
+} // namespace slate
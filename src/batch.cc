@@ -0,0 +1,670 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/slate.hh"
+#include "slate/batch.hh"
+#include "slate/internal/Trace.hh"
+
+#include <algorithm>
+#include <memory>
+
+namespace slate {
+namespace batch {
+
+namespace {
+
+//------------------------------------------------------------------------------
+/// [internal]
+/// Problems of a batch, split by location: host problems largest first,
+/// so dynamic scheduling balances the threads, and device problems by
+/// device, each with a queue and device info array.
+///
+template <typename scalar_t>
+class Split {
+public:
+    Split( std::vector< Tile<scalar_t> > const& A, bool device_ok,
+           char const* routine )
+    {
+        int64_t batch_size = A.size();
+        for (int64_t i = 0; i < batch_size; ++i) {
+            slate_assert( A[ i ].layout() == Layout::ColMajor );
+            int device = A[ i ].device();
+            if (device == HostNum) {
+                host.push_back( i );
+            }
+            else {
+                if (! device_ok) {
+                    slate_not_implemented(
+                        ( std::string( "slate::batch::" ) + routine
+                          + " on device tiles" ).c_str() );
+                }
+                if (device >= int( devices.size() ))
+                    devices.resize( device + 1 );
+                devices[ device ].push_back( i );
+            }
+        }
+        std::stable_sort(
+            host.begin(), host.end(),
+            [&A]( int64_t i1, int64_t i2 ) {
+                return A[ i1 ].nb() > A[ i2 ].nb();
+            });
+
+        queues.resize( devices.size() );
+        dinfo.resize( devices.size(), nullptr );
+        for (size_t d = 0; d < devices.size(); ++d) {
+            if (! devices[ d ].empty()) {
+                queues[ d ].reset( new lapack::Queue( d ) );
+                dinfo[ d ] = blas::device_malloc<lapack::device_info_int>(
+                    devices[ d ].size(), *queues[ d ] );
+            }
+        }
+    }
+
+    ~Split()
+    {
+        for (size_t d = 0; d < devices.size(); ++d) {
+            if (dinfo[ d ] != nullptr)
+                blas::device_free( dinfo[ d ], *queues[ d ] );
+        }
+    }
+
+    /// Waits for the device problems, and copies their info.
+    void finish( std::vector<int64_t>* info )
+    {
+        for (size_t d = 0; d < devices.size(); ++d) {
+            if (devices[ d ].empty())
+                continue;
+
+            if (info != nullptr) {
+                std::vector<lapack::device_info_int> host_info(
+                    devices[ d ].size() );
+                blas::device_memcpy( host_info.data(), dinfo[ d ],
+                                     host_info.size(), *queues[ d ] );
+                queues[ d ]->sync();
+                for (size_t k = 0; k < devices[ d ].size(); ++k)
+                    (*info)[ devices[ d ][ k ] ] = host_info[ k ];
+            }
+            else {
+                queues[ d ]->sync();
+            }
+        }
+    }
+
+    std::vector<int64_t> host;
+    std::vector< std::vector<int64_t> > devices;
+    std::vector< std::unique_ptr<lapack::Queue> > queues;
+    std::vector< lapack::device_info_int* > dinfo;
+};
+
+//------------------------------------------------------------------------------
+/// [internal]
+/// Checks each right hand side B[ i ] matches A[ i ]: the same memory
+/// space, n_i rows, ColMajor. Checked before the parallel loops, which
+/// can't throw.
+///
+template <typename scalar_t>
+void check_rhs(
+    std::vector< Tile<scalar_t> > const& A,
+    std::vector< Tile<scalar_t> > const& B )
+{
+    slate_assert( A.size() == B.size() );
+    for (size_t i = 0; i < A.size(); ++i) {
+        slate_assert( B[ i ].device() == A[ i ].device() );
+        slate_assert( B[ i ].mb() == A[ i ].nb() );
+        slate_assert( B[ i ].layout() == Layout::ColMajor );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// [internal]
+/// Checks each A[ i ] is square.
+///
+template <typename scalar_t>
+void check_square( std::vector< Tile<scalar_t> > const& A )
+{
+    for (size_t i = 0; i < A.size(); ++i)
+        slate_assert( A[ i ].mb() == A[ i ].nb() );
+}
+
+} // anonymous namespace
+
+//------------------------------------------------------------------------------
+/// Batched Cholesky factorization of many independent Hermitian positive
+/// definite problems, $A_i = L_i L_i^H$ or $A_i = U_i^H U_i$.
+/// @see batch namespace for how tiles are dispatched.
+///
+//------------------------------------------------------------------------------
+/// @tparam scalar_t
+///     One of float, double, std::complex<float>, std::complex<double>.
+//------------------------------------------------------------------------------
+/// @param[in] uplo
+///     Whether the lower or upper triangle of each $A_i$ is referenced.
+///
+/// @param[in,out] A
+///     On entry, the n_i-by-n_i problems $A_i$, on host or devices.
+///     On exit, if info[ i ] = 0, the factor $L_i$ or $U_i$.
+///
+/// @param[out] info
+///     Resized to the number of problems. info[ i ] = 0 if $A_i$ was
+///     factored; > 0 if its leading minor of order info[ i ] is not
+///     positive definite.
+///
+/// @param[in] opts
+///     Currently no options.
+///
+/// @ingroup posv_computational
+///
+template <typename scalar_t>
+void potrf(
+    Uplo uplo,
+    std::vector< Tile<scalar_t> >& A,
+    std::vector<int64_t>& info,
+    Options const& opts)
+{
+    trace::Block trace_block( "slate::batch::potrf" );
+
+    check_square( A );
+    info.assign( A.size(), 0 );
+    Split<scalar_t> split( A, true, "potrf" );
+
+    // Queue device problems first, to overlap them with the host.
+    for (size_t d = 0; d < split.devices.size(); ++d) {
+        for (size_t k = 0; k < split.devices[ d ].size(); ++k) {
+            Tile<scalar_t>& Ai = A[ split.devices[ d ][ k ] ];
+            lapack::potrf( uplo, Ai.nb(), Ai.data(), Ai.stride(),
+                           &split.dinfo[ d ][ k ], *split.queues[ d ] );
+        }
+    }
+
+    int64_t host_size = split.host.size();
+    #pragma omp parallel for schedule( dynamic, 1 )
+    for (int64_t k = 0; k < host_size; ++k) {
+        int64_t i = split.host[ k ];
+        info[ i ] = lapack::potrf( uplo, A[ i ].nb(),
+                                   A[ i ].data(), A[ i ].stride() );
+    }
+
+    split.finish( &info );
+}
+
+//------------------------------------------------------------------------------
+/// Batched Cholesky solve of many independent problems, $A_i X_i = B_i$,
+/// using the factors from batch::potrf.
+///
+//------------------------------------------------------------------------------
+/// @param[in] uplo
+///     Whether each factor is $L_i$ (Lower) or $U_i$ (Upper).
+///
+/// @param[in] A
+///     The n_i-by-n_i factors from batch::potrf.
+///
+/// @param[in,out] B
+///     On entry, the n_i-by-nrhs_i right hand sides $B_i$, in the same
+///     memory space as $A_i$. On exit, the solutions $X_i$.
+///
+/// @param[in] opts
+///     Currently no options.
+///
+/// @ingroup posv_computational
+///
+template <typename scalar_t>
+void potrs(
+    Uplo uplo,
+    std::vector< Tile<scalar_t> >& A,
+    std::vector< Tile<scalar_t> >& B,
+    Options const& opts)
+{
+    trace::Block trace_block( "slate::batch::potrs" );
+
+    check_rhs( A, B );
+    Split<scalar_t> split( A, true, "potrs" );
+    const scalar_t one = 1.0;
+
+    // Lower: solve L Y = B, then L^H X = Y; Upper: U^H Y = B, then U X = Y.
+    Op op1 = uplo == Uplo::Lower ? Op::NoTrans : Op::ConjTrans;
+    Op op2 = uplo == Uplo::Lower ? Op::ConjTrans : Op::NoTrans;
+    for (size_t d = 0; d < split.devices.size(); ++d) {
+        for (int64_t i : split.devices[ d ]) {
+            for (Op op : { op1, op2 }) {
+                blas::trsm( Layout::ColMajor, Side::Left, uplo, op,
+                            Diag::NonUnit, B[ i ].mb(), B[ i ].nb(),
+                            one, A[ i ].data(), A[ i ].stride(),
+                                 B[ i ].data(), B[ i ].stride(),
+                            *split.queues[ d ] );
+            }
+        }
+    }
+
+    int64_t host_size = split.host.size();
+    #pragma omp parallel for schedule( dynamic, 1 )
+    for (int64_t k = 0; k < host_size; ++k) {
+        int64_t i = split.host[ k ];
+        lapack::potrs( uplo, A[ i ].nb(), B[ i ].nb(),
+                       A[ i ].data(), A[ i ].stride(),
+                       B[ i ].data(), B[ i ].stride() );
+    }
+
+    split.finish( nullptr );
+}
+
+//------------------------------------------------------------------------------
+/// Batched Cholesky solve of many independent Hermitian positive definite
+/// problems, $A_i X_i = B_i$: batch::potrf, then batch::potrs of the
+/// problems with info[ i ] = 0. $B_i$ with info[ i ] > 0 are unchanged.
+///
+/// @ingroup posv
+///
+template <typename scalar_t>
+void posv(
+    Uplo uplo,
+    std::vector< Tile<scalar_t> >& A,
+    std::vector< Tile<scalar_t> >& B,
+    std::vector<int64_t>& info,
+    Options const& opts)
+{
+    check_rhs( A, B );
+    potrf( uplo, A, info, opts );
+
+    bool all_ok = std::all_of( info.begin(), info.end(),
+                               []( int64_t x ) { return x == 0; } );
+    if (all_ok) {
+        potrs( uplo, A, B, opts );
+    }
+    else {
+        std::vector< Tile<scalar_t> > A_ok, B_ok;
+        for (size_t i = 0; i < A.size(); ++i) {
+            if (info[ i ] == 0) {
+                A_ok.push_back( A[ i ] );
+                B_ok.push_back( B[ i ] );
+            }
+        }
+        potrs( uplo, A_ok, B_ok, opts );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Batched LU factorization with partial pivoting of many independent
+/// problems, $P_i A_i = L_i U_i$. Host tiles only.
+///
+//------------------------------------------------------------------------------
+/// @param[in,out] A
+///     On entry, the m_i-by-n_i problems $A_i$.
+///     On exit, the factors $L_i$ and $U_i$.
+///
+/// @param[out] pivots
+///     Resized to the number of problems; pivots[ i ] holds the
+///     min( m_i, n_i ) 1-based LAPACK pivots of $A_i$.
+///
+/// @param[out] info
+///     Resized to the number of problems; info[ i ] as from LAPACK getrf.
+///
+/// @param[in] opts
+///     Currently no options.
+///
+/// @ingroup gesv_computational
+///
+template <typename scalar_t>
+void getrf(
+    std::vector< Tile<scalar_t> >& A,
+    std::vector< std::vector<int64_t> >& pivots,
+    std::vector<int64_t>& info,
+    Options const& opts)
+{
+    trace::Block trace_block( "slate::batch::getrf" );
+
+    info.assign( A.size(), 0 );
+    pivots.resize( A.size() );
+    Split<scalar_t> split( A, false, "getrf" );
+
+    int64_t host_size = split.host.size();
+    #pragma omp parallel for schedule( dynamic, 1 )
+    for (int64_t k = 0; k < host_size; ++k) {
+        int64_t i = split.host[ k ];
+        int64_t m = A[ i ].mb(), n = A[ i ].nb();
+        pivots[ i ].resize( std::min( m, n ) );
+        info[ i ] = lapack::getrf( m, n, A[ i ].data(), A[ i ].stride(),
+                                   pivots[ i ].data() );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Batched LU solve of many independent problems, $A_i X_i = B_i$,
+/// using the factors and pivots from batch::getrf. Host tiles only.
+///
+/// @ingroup gesv_computational
+///
+template <typename scalar_t>
+void getrs(
+    std::vector< Tile<scalar_t> >& A,
+    std::vector< std::vector<int64_t> >& pivots,
+    std::vector< Tile<scalar_t> >& B,
+    Options const& opts)
+{
+    trace::Block trace_block( "slate::batch::getrs" );
+
+    check_rhs( A, B );
+    slate_assert( A.size() == pivots.size() );
+    Split<scalar_t> split( A, false, "getrs" );
+
+    int64_t host_size = split.host.size();
+    #pragma omp parallel for schedule( dynamic, 1 )
+    for (int64_t k = 0; k < host_size; ++k) {
+        int64_t i = split.host[ k ];
+        lapack::getrs( Op::NoTrans, A[ i ].nb(), B[ i ].nb(),
+                       A[ i ].data(), A[ i ].stride(), pivots[ i ].data(),
+                       B[ i ].data(), B[ i ].stride() );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Batched LU solve of many independent problems, $A_i X_i = B_i$:
+/// batch::getrf, then batch::getrs of the problems with info[ i ] = 0.
+/// Host tiles only.
+///
+/// @ingroup gesv
+///
+template <typename scalar_t>
+void gesv(
+    std::vector< Tile<scalar_t> >& A,
+    std::vector< std::vector<int64_t> >& pivots,
+    std::vector< Tile<scalar_t> >& B,
+    std::vector<int64_t>& info,
+    Options const& opts)
+{
+    trace::Block trace_block( "slate::batch::gesv" );
+
+    check_square( A );
+    check_rhs( A, B );
+    info.assign( A.size(), 0 );
+    pivots.resize( A.size() );
+    Split<scalar_t> split( A, false, "gesv" );
+
+    // Factor and solve each problem in one task, for locality.
+    int64_t host_size = split.host.size();
+    #pragma omp parallel for schedule( dynamic, 1 )
+    for (int64_t k = 0; k < host_size; ++k) {
+        int64_t i = split.host[ k ];
+        int64_t n = A[ i ].nb();
+        pivots[ i ].resize( n );
+        info[ i ] = lapack::getrf( n, n, A[ i ].data(), A[ i ].stride(),
+                                   pivots[ i ].data() );
+        if (info[ i ] == 0) {
+            lapack::getrs( Op::NoTrans, n, B[ i ].nb(),
+                           A[ i ].data(), A[ i ].stride(), pivots[ i ].data(),
+                           B[ i ].data(), B[ i ].stride() );
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Batched Hermitian eigenvalue problems, $A_i = Z_i \Lambda_i Z_i^H$.
+/// Host tiles only.
+///
+//------------------------------------------------------------------------------
+/// @param[in] jobz
+///     Job::NoVec: eigenvalues only; Job::Vec: also eigenvectors.
+///
+/// @param[in] uplo
+///     Whether the lower or upper triangle of each $A_i$ is referenced.
+///
+/// @param[in,out] A
+///     On entry, the n_i-by-n_i Hermitian problems $A_i$.
+///     On exit, if jobz = Vec, the orthonormal eigenvectors $Z_i$;
+///     otherwise, destroyed.
+///
+/// @param[out] Lambda
+///     Resized to the number of problems; Lambda[ i ] holds the n_i
+///     eigenvalues of $A_i$ in ascending order.
+///
+/// @param[out] info
+///     Resized to the number of problems; info[ i ] as from LAPACK heev.
+///
+/// @param[in] opts
+///     Currently no options.
+///
+/// @ingroup heev
+///
+template <typename scalar_t>
+void heev(
+    Job jobz, Uplo uplo,
+    std::vector< Tile<scalar_t> >& A,
+    std::vector< std::vector< blas::real_type<scalar_t> > >& Lambda,
+    std::vector<int64_t>& info,
+    Options const& opts)
+{
+    trace::Block trace_block( "slate::batch::heev" );
+
+    check_square( A );
+    info.assign( A.size(), 0 );
+    Lambda.resize( A.size() );
+    Split<scalar_t> split( A, false, "heev" );
+
+    int64_t host_size = split.host.size();
+    #pragma omp parallel for schedule( dynamic, 1 )
+    for (int64_t k = 0; k < host_size; ++k) {
+        int64_t i = split.host[ k ];
+        int64_t n = A[ i ].nb();
+        Lambda[ i ].resize( n );
+        info[ i ] = lapack::heev( jobz, uplo, n, A[ i ].data(), A[ i ].stride(),
+                                  Lambda[ i ].data() );
+    }
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+// ----------------------------------------
+template
+void potrf<float>(
+    Uplo uplo,
+    std::vector< Tile< float > >& A,
+    std::vector<int64_t>& info,
+    Options const& opts);
+
+template
+void potrs<float>(
+    Uplo uplo,
+    std::vector< Tile< float > >& A,
+    std::vector< Tile< float > >& B,
+    Options const& opts);
+
+template
+void posv<float>(
+    Uplo uplo,
+    std::vector< Tile< float > >& A,
+    std::vector< Tile< float > >& B,
+    std::vector<int64_t>& info,
+    Options const& opts);
+
+template
+void getrf<float>(
+    std::vector< Tile< float > >& A,
+    std::vector< std::vector<int64_t> >& pivots,
+    std::vector<int64_t>& info,
+    Options const& opts);
+
+template
+void getrs<float>(
+    std::vector< Tile< float > >& A,
+    std::vector< std::vector<int64_t> >& pivots,
+    std::vector< Tile< float > >& B,
+    Options const& opts);
+
+template
+void gesv<float>(
+    std::vector< Tile< float > >& A,
+    std::vector< std::vector<int64_t> >& pivots,
+    std::vector< Tile< float > >& B,
+    std::vector<int64_t>& info,
+    Options const& opts);
+
+template
+void heev<float>(
+    Job jobz, Uplo uplo,
+    std::vector< Tile< float > >& A,
+    std::vector< std::vector< blas::real_type< float > > >& Lambda,
+    std::vector<int64_t>& info,
+    Options const& opts);
+
+// ----------------------------------------
+template
+void potrf<double>(
+    Uplo uplo,
+    std::vector< Tile< double > >& A,
+    std::vector<int64_t>& info,
+    Options const& opts);
+
+template
+void potrs<double>(
+    Uplo uplo,
+    std::vector< Tile< double > >& A,
+    std::vector< Tile< double > >& B,
+    Options const& opts);
+
+template
+void posv<double>(
+    Uplo uplo,
+    std::vector< Tile< double > >& A,
+    std::vector< Tile< double > >& B,
+    std::vector<int64_t>& info,
+    Options const& opts);
+
+template
+void getrf<double>(
+    std::vector< Tile< double > >& A,
+    std::vector< std::vector<int64_t> >& pivots,
+    std::vector<int64_t>& info,
+    Options const& opts);
+
+template
+void getrs<double>(
+    std::vector< Tile< double > >& A,
+    std::vector< std::vector<int64_t> >& pivots,
+    std::vector< Tile< double > >& B,
+    Options const& opts);
+
+template
+void gesv<double>(
+    std::vector< Tile< double > >& A,
+    std::vector< std::vector<int64_t> >& pivots,
+    std::vector< Tile< double > >& B,
+    std::vector<int64_t>& info,
+    Options const& opts);
+
+template
+void heev<double>(
+    Job jobz, Uplo uplo,
+    std::vector< Tile< double > >& A,
+    std::vector< std::vector< blas::real_type< double > > >& Lambda,
+    std::vector<int64_t>& info,
+    Options const& opts);
+
+// ----------------------------------------
+template
+void potrf< std::complex<float> >(
+    Uplo uplo,
+    std::vector< Tile< std::complex<float> > >& A,
+    std::vector<int64_t>& info,
+    Options const& opts);
+
+template
+void potrs< std::complex<float> >(
+    Uplo uplo,
+    std::vector< Tile< std::complex<float> > >& A,
+    std::vector< Tile< std::complex<float> > >& B,
+    Options const& opts);
+
+template
+void posv< std::complex<float> >(
+    Uplo uplo,
+    std::vector< Tile< std::complex<float> > >& A,
+    std::vector< Tile< std::complex<float> > >& B,
+    std::vector<int64_t>& info,
+    Options const& opts);
+
+template
+void getrf< std::complex<float> >(
+    std::vector< Tile< std::complex<float> > >& A,
+    std::vector< std::vector<int64_t> >& pivots,
+    std::vector<int64_t>& info,
+    Options const& opts);
+
+template
+void getrs< std::complex<float> >(
+    std::vector< Tile< std::complex<float> > >& A,
+    std::vector< std::vector<int64_t> >& pivots,
+    std::vector< Tile< std::complex<float> > >& B,
+    Options const& opts);
+
+template
+void gesv< std::complex<float> >(
+    std::vector< Tile< std::complex<float> > >& A,
+    std::vector< std::vector<int64_t> >& pivots,
+    std::vector< Tile< std::complex<float> > >& B,
+    std::vector<int64_t>& info,
+    Options const& opts);
+
+template
+void heev< std::complex<float> >(
+    Job jobz, Uplo uplo,
+    std::vector< Tile< std::complex<float> > >& A,
+    std::vector< std::vector< blas::real_type< std::complex<float> > > >& Lambda,
+    std::vector<int64_t>& info,
+    Options const& opts);
+
+// ----------------------------------------
+template
+void potrf< std::complex<double> >(
+    Uplo uplo,
+    std::vector< Tile< std::complex<double> > >& A,
+    std::vector<int64_t>& info,
+    Options const& opts);
+
+template
+void potrs< std::complex<double> >(
+    Uplo uplo,
+    std::vector< Tile< std::complex<double> > >& A,
+    std::vector< Tile< std::complex<double> > >& B,
+    Options const& opts);
+
+template
+void posv< std::complex<double> >(
+    Uplo uplo,
+    std::vector< Tile< std::complex<double> > >& A,
+    std::vector< Tile< std::complex<double> > >& B,
+    std::vector<int64_t>& info,
+    Options const& opts);
+
+template
+void getrf< std::complex<double> >(
+    std::vector< Tile< std::complex<double> > >& A,
+    std::vector< std::vector<int64_t> >& pivots,
+    std::vector<int64_t>& info,
+    Options const& opts);
+
+template
+void getrs< std::complex<double> >(
+    std::vector< Tile< std::complex<double> > >& A,
+    std::vector< std::vector<int64_t> >& pivots,
+    std::vector< Tile< std::complex<double> > >& B,
+    Options const& opts);
+
+template
+void gesv< std::complex<double> >(
+    std::vector< Tile< std::complex<double> > >& A,
+    std::vector< std::vector<int64_t> >& pivots,
+    std::vector< Tile< std::complex<double> > >& B,
+    std::vector<int64_t>& info,
+    Options const& opts);
+
+template
+void heev< std::complex<double> >(
+    Job jobz, Uplo uplo,
+    std::vector< Tile< std::complex<double> > >& A,
+    std::vector< std::vector< blas::real_type< std::complex<double> > > >& Lambda,
+    std::vector<int64_t>& info,
+    Options const& opts);
+
+} // namespace batch
+} // namespace slate
@@ -19,7 +19,7 @@ double slate_norm_c64(
 
     auto* A_ = reinterpret_cast<matrix_A_t*>(A);
 
-    slate::Options opts_ = slate::options2cpp( opts );
+    slate::Options const& opts_ = slate::options2cpp( opts );
 
     return slate::norm(slate::norm2cpp(norm), *A_, opts_);
 }
@@ -39,7 +39,7 @@ double slate_band_norm_c64(
 
     auto* A_ = reinterpret_cast<matrix_A_t*>(A);
 
-    slate::Options opts_ = slate::options2cpp( opts );
+    slate::Options const& opts_ = slate::options2cpp( opts );
 
     return slate::norm(slate::norm2cpp(norm), *A_, opts_);
 }
@@ -59,7 +59,7 @@ double slate_hermitian_norm_c64(
 
     auto* A_ = reinterpret_cast<matrix_A_t*>(A);
 
-    slate::Options opts_ = slate::options2cpp( opts );
+    slate::Options const& opts_ = slate::options2cpp( opts );
 
     return slate::norm(slate::norm2cpp(norm), *A_, opts_);
 }
@@ -79,7 +79,7 @@ double slate_hermitian_band_norm_c64(
 
     auto* A_ = reinterpret_cast<matrix_A_t*>(A);
 
-    slate::Options opts_ = slate::options2cpp( opts );
+    slate::Options const& opts_ = slate::options2cpp( opts );
 
     return slate::norm(slate::norm2cpp(norm), *A_, opts_);
 }
@@ -99,7 +99,7 @@ double slate_symmetric_norm_c64(
 
     auto* A_ = reinterpret_cast<matrix_A_t*>(A);
 
-    slate::Options opts_ = slate::options2cpp( opts );
+    slate::Options const& opts_ = slate::options2cpp( opts );
 
     return slate::norm(slate::norm2cpp(norm), *A_, opts_);
 }
@@ -119,7 +119,7 @@ double slate_trapezoid_norm_c64(
 
     auto* A_ = reinterpret_cast<matrix_A_t*>(A);
 
-    slate::Options opts_ = slate::options2cpp( opts );
+    slate::Options const& opts_ = slate::options2cpp( opts );
 
     return slate::norm(slate::norm2cpp(norm), *A_, opts_);
 }
@@ -142,7 +142,7 @@ void slate_copy_c64(
     auto* A_ = reinterpret_cast<matrix_A_t*>(A);
     auto* B_ = reinterpret_cast<matrix_B_t*>(B);
 
-    slate::Options opts_ = slate::options2cpp( opts );
+    slate::Options const& opts_ = slate::options2cpp( opts );
 
     slate::copy(*A_, *B_, opts_);
 }
@@ -165,7 +165,7 @@ void slate_hermitian_copy_c64(
     auto* A_ = reinterpret_cast<matrix_A_t*>(A);
     auto* B_ = reinterpret_cast<matrix_B_t*>(B);
 
-    slate::Options opts_ = slate::options2cpp( opts );
+    slate::Options const& opts_ = slate::options2cpp( opts );
 
     slate::copy(*A_, *B_, opts_);
 }
@@ -188,7 +188,7 @@ void slate_symmetric_copy_c64(
     auto* A_ = reinterpret_cast<matrix_A_t*>(A);
     auto* B_ = reinterpret_cast<matrix_B_t*>(B);
 
-    slate::Options opts_ = slate::options2cpp( opts );
+    slate::Options const& opts_ = slate::options2cpp( opts );
 
     slate::copy(*A_, *B_, opts_);
 }
@@ -211,7 +211,7 @@ void slate_trapezoid_copy_c64(
     auto* A_ = reinterpret_cast<matrix_A_t*>(A);
     auto* B_ = reinterpret_cast<matrix_B_t*>(B);
 
-    slate::Options opts_ = slate::options2cpp( opts );
+    slate::Options const& opts_ = slate::options2cpp( opts );
 
     slate::copy(*A_, *B_, opts_);
 }
@@ -237,7 +237,7 @@ void slate_band_multiply_c64(
     auto* B_ = reinterpret_cast<matrix_B_t*>(B);
     auto* C_ = reinterpret_cast<matrix_C_t*>(C);
 
-    slate::Options opts_ = slate::options2cpp( opts );
+    slate::Options const& opts_ = slate::options2cpp( opts );
 
     slate::multiply<scalar_t>(alpha, *A_, *B_, beta, *C_, opts_);
 }
@@ -263,7 +263,7 @@ void slate_multiply_c64(
     auto* B_ = reinterpret_cast<matrix_B_t*>(B);
     auto* C_ = reinterpret_cast<matrix_C_t*>(C);
 
-    slate::Options opts_ = slate::options2cpp( opts );
+    slate::Options const& opts_ = slate::options2cpp( opts );
 
     slate::multiply<scalar_t>(alpha, *A_, *B_, beta, *C_, opts_);
 }
@@ -289,7 +289,7 @@ void slate_hermitian_band_left_multiply_c64(
     auto* B_ = reinterpret_cast<matrix_B_t*>(B);
     auto* C_ = reinterpret_cast<matrix_C_t*>(C);
 
-    slate::Options opts_ = slate::options2cpp( opts );
+    slate::Options const& opts_ = slate::options2cpp( opts );
 
     slate::multiply<scalar_t>(alpha, *A_, *B_, beta, *C_, opts_);
 }
@@ -315,7 +315,7 @@ void slate_hermitian_band_right_multiply_c64(
     auto* B_ = reinterpret_cast<matrix_B_t*>(B);
     auto* C_ = reinterpret_cast<matrix_C_t*>(C);
 
-    slate::Options opts_ = slate::options2cpp( opts );
+    slate::Options const& opts_ = slate::options2cpp( opts );
 
     slate::multiply<scalar_t>(alpha, *A_, *B_, beta, *C_, opts_);
 }
@@ -341,7 +341,7 @@ void slate_hermitian_left_multiply_c64(
     auto* B_ = reinterpret_cast<matrix_B_t*>(B);
     auto* C_ = reinterpret_cast<matrix_C_t*>(C);
 
-    slate::Options opts_ = slate::options2cpp( opts );
+    slate::Options const& opts_ = slate::options2cpp( opts );
 
     slate::multiply<scalar_t>(alpha, *A_, *B_, beta, *C_, opts_);
 }
@@ -367,7 +367,7 @@ void slate_hermitian_right_multiply_c64(
     auto* B_ = reinterpret_cast<matrix_B_t*>(B);
     auto* C_ = reinterpret_cast<matrix_C_t*>(C);
 
-    slate::Options opts_ = slate::options2cpp( opts );
+    slate::Options const& opts_ = slate::options2cpp( opts );
 
     slate::multiply<scalar_t>(alpha, *A_, *B_, beta, *C_, opts_);
 }
@@ -393,7 +393,7 @@ void slate_symmetric_left_multiply_c64(
     auto* B_ = reinterpret_cast<matrix_B_t*>(B);
     auto* C_ = reinterpret_cast<matrix_C_t*>(C);
 
-    slate::Options opts_ = slate::options2cpp( opts );
+    slate::Options const& opts_ = slate::options2cpp( opts );
 
     slate::multiply<scalar_t>(alpha, *A_, *B_, beta, *C_, opts_);
 }
@@ -419,7 +419,7 @@ void slate_symmetric_right_multiply_c64(
     auto* B_ = reinterpret_cast<matrix_B_t*>(B);
     auto* C_ = reinterpret_cast<matrix_C_t*>(C);
 
-    slate::Options opts_ = slate::options2cpp( opts );
+    slate::Options const& opts_ = slate::options2cpp( opts );
 
     slate::multiply<scalar_t>(alpha, *A_, *B_, beta, *C_, opts_);
 }
@@ -442,7 +442,7 @@ void slate_triangular_left_multiply_c64(
     auto* A_ = reinterpret_cast<matrix_A_t*>(A);
     auto* B_ = reinterpret_cast<matrix_B_t*>(B);
 
-    slate::Options opts_ = slate::options2cpp( opts );
+    slate::Options const& opts_ = slate::options2cpp( opts );
 
     slate::triangular_multiply<scalar_t>(alpha, *A_, *B_, opts_);
 }
@@ -465,7 +465,7 @@ void slate_triangular_right_multiply_c64(
     auto* A_ = reinterpret_cast<matrix_A_t*>(A);
     auto* B_ = reinterpret_cast<matrix_B_t*>(B);
 
-    slate::Options opts_ = slate::options2cpp( opts );
+    slate::Options const& opts_ = slate::options2cpp( opts );
 
     slate::triangular_multiply<scalar_t>(alpha, *A_, *B_, opts_);
 }
@@ -488,7 +488,7 @@ void slate_triangular_band_left_solve_c64(
     auto* A_ = reinterpret_cast<matrix_A_t*>(A);
     auto* B_ = reinterpret_cast<matrix_B_t*>(B);
 
-    slate::Options opts_ = slate::options2cpp( opts );
+    slate::Options const& opts_ = slate::options2cpp( opts );
 
     slate::triangular_solve<scalar_t>(alpha, *A_, *B_, opts_);
 }
@@ -511,7 +511,7 @@ void slate_triangular_band_right_solve_c64(
     auto* A_ = reinterpret_cast<matrix_A_t*>(A);
     auto* B_ = reinterpret_cast<matrix_B_t*>(B);
 
-    slate::Options opts_ = slate::options2cpp( opts );
+    slate::Options const& opts_ = slate::options2cpp( opts );
 
     slate::triangular_solve<scalar_t>(alpha, *A_, *B_, opts_);
 }
@@ -534,7 +534,7 @@ void slate_triangular_left_solve_c64(
     auto* A_ = reinterpret_cast<matrix_A_t*>(A);
     auto* B_ = reinterpret_cast<matrix_B_t*>(B);
 
-    slate::Options opts_ = slate::options2cpp( opts );
+    slate::Options const& opts_ = slate::options2cpp( opts );
 
     slate::triangular_solve<scalar_t>(alpha, *A_, *B_, opts_);
 }
@@ -557,7 +557,7 @@ void slate_triangular_right_solve_c64(
     auto* A_ = reinterpret_cast<matrix_A_t*>(A);
     auto* B_ = reinterpret_cast<matrix_B_t*>(B);
 
-    slate::Options opts_ = slate::options2cpp( opts );
+    slate::Options const& opts_ = slate::options2cpp( opts );
 
     slate::triangular_solve<scalar_t>(alpha, *A_, *B_, opts_);
 }
@@ -580,7 +580,7 @@ void slate_hermitian_rank_k_update_c64(
     auto* A_ = reinterpret_cast<matrix_A_t*>(A);
     auto* C_ = reinterpret_cast<matrix_C_t*>(C);
 
-    slate::Options opts_ = slate::options2cpp( opts );
+    slate::Options const& opts_ = slate::options2cpp( opts );
 
     slate::rank_k_update<scalar_t>(alpha, *A_, beta, *C_, opts_);
 }
@@ -603,7 +603,7 @@ void slate_symmetric_rank_k_update_c64(
     auto* A_ = reinterpret_cast<matrix_A_t*>(A);
     auto* C_ = reinterpret_cast<matrix_C_t*>(C);
 
-    slate::Options opts_ = slate::options2cpp( opts );
+    slate::Options const& opts_ = slate::options2cpp( opts );
 
     slate::rank_k_update<scalar_t>(alpha, *A_, beta, *C_, opts_);
 }
@@ -629,7 +629,7 @@ void slate_hermitian_rank_2k_update_c64(
     auto* B_ = reinterpret_cast<matrix_B_t*>(B);
     auto* C_ = reinterpret_cast<matrix_C_t*>(C);
 
-    slate::Options opts_ = slate::options2cpp( opts );
+    slate::Options const& opts_ = slate::options2cpp( opts );
 
     slate::rank_2k_update<scalar_t>(alpha, *A_, *B_, beta, *C_, opts_);
 }
@@ -655,7 +655,7 @@ void slate_symmetric_rank_2k_update_c64(
     auto* B_ = reinterpret_cast<matrix_B_t*>(B);
     auto* C_ = reinterpret_cast<matrix_C_t*>(C);
 
-    slate::Options opts_ = slate::options2cpp( opts );
+    slate::Options const& opts_ = slate::options2cpp( opts );
 
     slate::rank_2k_update<scalar_t>(alpha, *A_, *B_, beta, *C_, opts_);
 }
@@ -678,7 +678,7 @@ void slate_band_lu_solve_c64(
     auto* A_ = reinterpret_cast<matrix_A_t*>(A);
     auto* B_ = reinterpret_cast<matrix_B_t*>(B);
 
-    slate::Options opts_ = slate::options2cpp( opts );
+    slate::Options const& opts_ = slate::options2cpp( opts );
 
     slate::lu_solve<scalar_t>(*A_, *B_, opts_);
 }
@@ -701,7 +701,7 @@ void slate_lu_solve_c64(
     auto* A_ = reinterpret_cast<matrix_A_t*>(A);
     auto* B_ = reinterpret_cast<matrix_B_t*>(B);
 
-    slate::Options opts_ = slate::options2cpp( opts );
+    slate::Options const& opts_ = slate::options2cpp( opts );
 
     slate::lu_solve<scalar_t>(*A_, *B_, opts_);
 }
@@ -748,7 +748,7 @@ void slate_band_lu_factor_c64(
     auto* A_     = reinterpret_cast<matrix_A_t*>(A);
     auto* pivots_= reinterpret_cast<slate::Pivots*>(pivots);
 
-    slate::Options opts_ = slate::options2cpp( opts );
+    slate::Options const& opts_ = slate::options2cpp( opts );
 
     slate::lu_factor<scalar_t>(*A_, *pivots_, opts_);
 }
@@ -769,7 +769,7 @@ void slate_lu_factor_c64(
     auto* A_     = reinterpret_cast<matrix_A_t*>(A);
     auto* pivots_= reinterpret_cast<slate::Pivots*>(pivots);
 
-    slate::Options opts_ = slate::options2cpp( opts );
+    slate::Options const& opts_ = slate::options2cpp( opts );
 
     slate::lu_factor<scalar_t>(*A_, *pivots_, opts_);
 }
@@ -817,7 +817,7 @@ void slate_band_lu_solve_using_factor_c64(
     auto* B_     = reinterpret_cast<matrix_B_t*>(B);
     auto* pivots_= reinterpret_cast<slate::Pivots*>(pivots);
 
-    slate::Options opts_ = slate::options2cpp( opts );
+    slate::Options const& opts_ = slate::options2cpp( opts );
 
     slate::lu_solve_using_factor<scalar_t>(*A_, *pivots_, *B_, opts_);
 }
@@ -841,7 +841,7 @@ void slate_lu_solve_using_factor_c64(
     auto* B_     = reinterpret_cast<matrix_B_t*>(B);
     auto* pivots_= reinterpret_cast<slate::Pivots*>(pivots);
 
-    slate::Options opts_ = slate::options2cpp( opts );
+    slate::Options const& opts_ = slate::options2cpp( opts );
 
     slate::lu_solve_using_factor<scalar_t>(*A_, *pivots_, *B_, opts_);
 }
@@ -889,7 +889,7 @@ void slate_lu_inverse_using_factor_c64(
     auto* A_     = reinterpret_cast<matrix_A_t*>(A);
     auto* pivots_= reinterpret_cast<slate::Pivots*>(pivots);
 
-    slate::Options opts_ = slate::options2cpp( opts );
+    slate::Options const& opts_ = slate::options2cpp( opts );
 
     slate::lu_inverse_using_factor<scalar_t>(*A_, *pivots_, opts_);
 }
@@ -913,7 +913,7 @@ void slate_lu_inverse_using_factor_out_of_place_c64(
     auto* A_inverse_ = reinterpret_cast<matrix_A_inverse_t*>(A_inverse);
     auto* pivots_    = reinterpret_cast<slate::Pivots*>(pivots);
 
-    slate::Options opts_ = slate::options2cpp( opts );
+    slate::Options const& opts_ = slate::options2cpp( opts );
 
     slate::lu_inverse_using_factor_out_of_place<scalar_t>(
         *A_, *pivots_, *A_inverse_, opts_);
@@ -936,7 +936,7 @@ double slate_lu_rcondest_using_factor_c64(
 
     auto* A_ = reinterpret_cast<matrix_A_t*>(A);
 
-    slate::Options opts_ = slate::options2cpp( opts );
+    slate::Options const& opts_ = slate::options2cpp( opts );
 
     return slate::lu_rcondest_using_factor<scalar_t>( slate::norm2cpp(norm),
                                                       *A_, Anorm, opts_ );
@@ -960,7 +960,7 @@ void slate_band_chol_solve_c64(
     auto* A_ = reinterpret_cast<matrix_A_t*>(A);
     auto* B_ = reinterpret_cast<matrix_B_t*>(B);
 
-    slate::Options opts_ = slate::options2cpp( opts );
+    slate::Options const& opts_ = slate::options2cpp( opts );
 
     slate::chol_solve<scalar_t>(*A_, *B_, opts_);
 }
@@ -983,7 +983,7 @@ void slate_chol_solve_c64(
     auto* A_ = reinterpret_cast<matrix_A_t*>(A);
     auto* B_ = reinterpret_cast<matrix_B_t*>(B);
 
-    slate::Options opts_ = slate::options2cpp( opts );
+    slate::Options const& opts_ = slate::options2cpp( opts );
 
     slate::chol_solve<scalar_t>(*A_, *B_, opts_);
 }
@@ -1003,7 +1003,7 @@ void slate_band_chol_factor_c64(
 
     auto* A_ = reinterpret_cast<matrix_A_t*>(A);
 
-    slate::Options opts_ = slate::options2cpp( opts );
+    slate::Options const& opts_ = slate::options2cpp( opts );
 
     slate::chol_factor<scalar_t>(*A_, opts_);
 }
@@ -1023,7 +1023,7 @@ void slate_chol_factor_c64(
 
     auto* A_ = reinterpret_cast<matrix_A_t*>(A);
 
-    slate::Options opts_ = slate::options2cpp( opts );
+    slate::Options const& opts_ = slate::options2cpp( opts );
 
     slate::chol_factor<scalar_t>(*A_, opts_);
 }
@@ -1046,7 +1046,7 @@ void slate_band_chol_solve_using_factor_c64(
     auto* A_ = reinterpret_cast<matrix_A_t*>(A);
     auto* B_ = reinterpret_cast<matrix_B_t*>(B);
 
-    slate::Options opts_ = slate::options2cpp( opts );
+    slate::Options const& opts_ = slate::options2cpp( opts );
 
     slate::chol_solve_using_factor<scalar_t>(*A_, *B_, opts_);
 }
@@ -1069,7 +1069,7 @@ void slate_chol_solve_using_factor_c64(
     auto* A_ = reinterpret_cast<matrix_A_t*>(A);
     auto* B_ = reinterpret_cast<matrix_B_t*>(B);
 
-    slate::Options opts_ = slate::options2cpp( opts );
+    slate::Options const& opts_ = slate::options2cpp( opts );
 
     slate::chol_solve_using_factor<scalar_t>(*A_, *B_, opts_);
 }
@@ -1089,7 +1089,7 @@ void slate_chol_inverse_using_factor_c64(
 
     auto* A_ = reinterpret_cast<matrix_A_t*>(A);
 
-    slate::Options opts_ = slate::options2cpp( opts );
+    slate::Options const& opts_ = slate::options2cpp( opts );
 
     slate::chol_inverse_using_factor<scalar_t>(*A_, opts_);
 }
@@ -1111,7 +1111,7 @@ double slate_chol_rcondest_using_factor_c64(
 
     auto* A_ = reinterpret_cast<matrix_A_t*>(A);
 
-    slate::Options opts_ = slate::options2cpp( opts );
+    slate::Options const& opts_ = slate::options2cpp( opts );
 
     return slate::chol_rcondest_using_factor<scalar_t>( slate::norm2cpp(norm),
                                                         *A_, Anorm, opts_ );
@@ -1135,7 +1135,7 @@ void slate_indefinite_solve_c64(
     auto* A_ = reinterpret_cast<matrix_A_t*>(A);
     auto* B_ = reinterpret_cast<matrix_B_t*>(B);
 
-    slate::Options opts_ = slate::options2cpp( opts );
+    slate::Options const& opts_ = slate::options2cpp( opts );
 
     slate::indefinite_solve<scalar_t>(*A_, *B_, opts_);
 }
@@ -1163,7 +1163,7 @@ void slate_indefinite_factor_c64(
     auto* pivots_  = reinterpret_cast<slate::Pivots*>(pivots);
     auto* pivots2_ = reinterpret_cast<slate::Pivots*>(pivots2);
 
-    slate::Options opts_ = slate::options2cpp( opts );
+    slate::Options const& opts_ = slate::options2cpp( opts );
 
     slate::indefinite_factor<scalar_t>(
         *A_, *pivots_, *T_, *pivots2_, *H_, opts_);
@@ -1192,7 +1192,7 @@ void slate_indefinite_solve_using_factor_c64(
     auto* pivots_  = reinterpret_cast<slate::Pivots*>(pivots);
     auto* pivots2_ = reinterpret_cast<slate::Pivots*>(pivots2);
 
-    slate::Options opts_ = slate::options2cpp( opts );
+    slate::Options const& opts_ = slate::options2cpp( opts );
 
     slate::indefinite_solve_using_factor<scalar_t>(
         *A_, *pivots_, *T_, *pivots2_, *B_, opts_);
@@ -1216,7 +1216,7 @@ void slate_least_squares_solve_c64(
     auto* A_  = reinterpret_cast<matrix_A_t*>(A);
     auto* BX_ = reinterpret_cast<matrix_BX_t*>(BX);
 
-    slate::Options opts_ = slate::options2cpp( opts );
+    slate::Options const& opts_ = slate::options2cpp( opts );
 
     slate::least_squares_solve<scalar_t>(*A_, *BX_, opts_);
 }
@@ -1238,7 +1238,7 @@ void slate_qr_factor_c64(
     auto* A_ = reinterpret_cast<matrix_A_t*>(A);
     auto* T_ = reinterpret_cast<triangular_factors_T_t*>(T);
 
-    slate::Options opts_ = slate::options2cpp( opts );
+    slate::Options const& opts_ = slate::options2cpp( opts );
 
     slate::qr_factor<scalar_t>(*A_, *T_, opts_);
 }
@@ -1264,7 +1264,7 @@ void slate_qr_multiply_by_q_c64(
     auto* T_ = reinterpret_cast<triangular_factors_T_t*>(T);
     auto* C_ = reinterpret_cast<matrix_C_t*>(C);
 
-    slate::Options opts_ = slate::options2cpp( opts );
+    slate::Options const& opts_ = slate::options2cpp( opts );
 
     slate::qr_multiply_by_q<scalar_t>(
         slate::side2cpp(side), slate::op2cpp(op), *A_, *T_, *C_, opts_);
@@ -1287,7 +1287,7 @@ void slate_lq_factor_c64(
     auto* A_ = reinterpret_cast<matrix_A_t*>(A);
     auto* T_ = reinterpret_cast<triangular_factors_T_t*>(T);
 
-    slate::Options opts_ = slate::options2cpp( opts );
+    slate::Options const& opts_ = slate::options2cpp( opts );
 
     slate::lq_factor<scalar_t>(*A_, *T_, opts_);
 }
@@ -1313,7 +1313,7 @@ void slate_lq_multiply_by_q_c64(
     auto* T_ = reinterpret_cast<triangular_factors_T_t*>(T);
     auto* C_ = reinterpret_cast<matrix_C_t*>(C);
 
-    slate::Options opts_ = slate::options2cpp( opts );
+    slate::Options const& opts_ = slate::options2cpp( opts );
 
     slate::lq_multiply_by_q<scalar_t>(
         slate::side2cpp(side), slate::op2cpp(op), *A_, *T_, *C_, opts_);
@@ -1336,7 +1336,7 @@ double slate_triangular_rcondest_c64(
 
     auto* A_ = reinterpret_cast<matrix_A_t*>(A);
 
-    slate::Options opts_ = slate::options2cpp( opts );
+    slate::Options const& opts_ = slate::options2cpp( opts );
 
     return slate::triangular_rcondest<scalar_t>( slate::norm2cpp(norm),
                                                  *A_, Anorm, opts_ );
@@ -1361,7 +1361,7 @@ void slate_svd_vals_c64(
     int64_t min_mn = std::min( A_->m(), A_->n() );
     std::vector< blas::real_type<scalar_t> > Sigma_( min_mn );
 
-    slate::Options opts_ = slate::options2cpp( opts );
+    slate::Options const& opts_ = slate::options2cpp( opts );
 
     slate::svd_vals<scalar_t>(*A_, Sigma_, opts_);
 
@@ -1393,7 +1393,7 @@ void slate_svd_c64(
     int64_t min_mn = std::min( A_->m(), A_->n() );
     std::vector< blas::real_type<scalar_t> > Sigma_( min_mn );
 
-    slate::Options opts_ = slate::options2cpp( opts );
+    slate::Options const& opts_ = slate::options2cpp( opts );
 
     slate::svd<scalar_t>(*A_, Sigma_, *U_, *VT_, opts_);
 
@@ -1418,7 +1418,7 @@ void slate_hermitian_eig_vals_c64(
 
     std::vector< blas::real_type<scalar_t> > Lambda_(A_->n());
 
-    slate::Options opts_ = slate::options2cpp( opts );
+    slate::Options const& opts_ = slate::options2cpp( opts );
 
     slate::eig_vals<scalar_t>(*A_, Lambda_, opts_);
 
@@ -1446,7 +1446,7 @@ void slate_hermitian_eig_c64(
 
     std::vector< blas::real_type<scalar_t> > Lambda_(A_->n());
 
-    slate::Options opts_ = slate::options2cpp( opts );
+    slate::Options const& opts_ = slate::options2cpp( opts );
 
     slate::eig<scalar_t>(*A_, Lambda_, *Z_, opts_);
 
@@ -1475,7 +1475,7 @@ void slate_generalized_hermitian_eig_vals_c64(
 
     std::vector< blas::real_type<scalar_t> > Lambda_(A_->n());
 
-    slate::Options opts_ = slate::options2cpp( opts );
+    slate::Options const& opts_ = slate::options2cpp( opts );
 
     slate::eig_vals<scalar_t>(itype, *A_, *B_, Lambda_, opts_);
 
@@ -1507,7 +1507,7 @@ void slate_generalized_hermitian_eig_c64(
 
     std::vector< blas::real_type<scalar_t> > Lambda_(A_->n());
 
-    slate::Options opts_ = slate::options2cpp( opts );
+    slate::Options const& opts_ = slate::options2cpp( opts );
 
     slate::eig<scalar_t>(itype, *A_, *B_, Lambda_, *Z_, opts_);
 
@@ -0,0 +1,487 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/slate.hh"
+#include "slate/Checkpoint.hh"
+#include "internal/internal.hh"
+#include "internal/internal_io.hh"
+
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace slate {
+
+namespace impl {
+
+//------------------------------------------------------------------------------
+/// Header of the checkpoint meta file, filename.meta, followed by nsteps
+/// int64_t pivot counts of steps 0, ..., nsteps-1, then their npivots
+/// pivots, as in Pivots.
+///
+struct CheckpointMeta {
+    char    magic[ 8 ];     ///< "SLATECKP"
+    int64_t version;        ///< format version, 1
+    int64_t generation;     ///< matrix file, filename.0 or filename.1
+    int64_t k;              ///< block step to continue from
+    int64_t info;           ///< info of steps 0, ..., k-1
+    int64_t nsteps;         ///< number of steps with pivots
+    int64_t npivots;        ///< total number of pivots
+};
+
+static_assert( sizeof( CheckpointMeta ) == 56,
+               "CheckpointMeta must be 56 bytes" );
+
+const char checkpoint_magic[ 8 ] = { 'S', 'L', 'A', 'T', 'E', 'C', 'K', 'P' };
+const int64_t checkpoint_version = 1;
+
+//------------------------------------------------------------------------------
+/// @return whether to checkpoint tile (i, j) of op(A): all tiles of general
+/// matrices, the tiles in the stored triangle of others.
+template <typename scalar_t>
+bool checkpoint_tile( BaseMatrix<scalar_t>& A, int64_t i, int64_t j )
+{
+    return A.uplo() == Uplo::General
+           || (A.uplo() == Uplo::Lower && i >= j)
+           || (A.uplo() == Uplo::Upper && i <= j);
+}
+
+//------------------------------------------------------------------------------
+/// @return a general matrix with the tiles and distribution of op(A),
+/// not transposed, on mpi_comm, with no tiles inserted.
+template <typename scalar_t>
+Matrix<scalar_t> checkpoint_tiles_like(
+    BaseMatrix<scalar_t>& A, MPI_Comm mpi_comm )
+{
+    using ij_tuple = typename BaseMatrix<scalar_t>::ij_tuple;
+
+    // A is a shallow copy, sharing the tiles' storage.
+    std::function<int64_t (int64_t i)> tileMb
+        = [A]( int64_t i ) { return A.tileMb( i ); };
+    std::function<int64_t (int64_t j)> tileNb
+        = [A]( int64_t j ) { return A.tileNb( j ); };
+    std::function<int (ij_tuple ij)> tileRank
+        = [A]( ij_tuple ij ) {
+            return A.tileRank( std::get<0>( ij ), std::get<1>( ij ) );
+        };
+    std::function<int (ij_tuple ij)> tileDevice
+        = [A]( ij_tuple ij ) {
+            return A.tileDevice( std::get<0>( ij ), std::get<1>( ij ) );
+        };
+    Matrix<scalar_t> B( A.m(), A.n(), tileMb, tileNb, tileRank, tileDevice,
+                        mpi_comm );
+    if (! internal::file_tiles_match( B, B.tileMb( 0 ), B.tileNb( 0 ) ))
+        slate_error( "Checkpoint: tiles must be of one size, "
+                     "except the last block row and column" );
+    return B;
+}
+
+//------------------------------------------------------------------------------
+/// Writes the matrix file of the checkpoint, then replaces the meta file.
+/// Collective over B's MPI communicator.
+///
+template <typename scalar_t>
+void checkpoint_write(
+    Matrix<scalar_t>& B, Uplo uplo,
+    std::string const& filename, int64_t generation, int64_t k, int64_t info,
+    std::vector<int64_t> const& sizes, std::vector<Pivot> const& pivots )
+{
+    MPI_Comm mpi_comm = B.mpiComm();
+
+    // info is set on the ranks where it occurred.
+    internal::reduce_info( &info, mpi_comm );
+
+    std::string data_name = filename + "." + std::to_string( generation );
+    auto header = internal::file_header<scalar_t>(
+                      B.m(), B.n(), B.tileMb( 0 ), B.tileNb( 0 ) );
+    MPI_File fh;
+    slate_mpi_call(
+        MPI_File_open( mpi_comm, data_name.c_str(),
+                       MPI_MODE_CREATE | MPI_MODE_WRONLY,
+                       MPI_INFO_NULL, &fh ) );
+    slate_mpi_call(
+        MPI_File_set_size( fh, 0 ) );
+    if (B.mpiRank() == 0) {
+        slate_mpi_call(
+            MPI_File_write_at( fh, 0, &header, sizeof( header ), MPI_BYTE,
+                               MPI_STATUS_IGNORE ) );
+    }
+    internal::file_tiles( fh, header, B, true, uplo );
+    slate_mpi_call(
+        MPI_File_close( &fh ) );
+
+    // Every rank's tiles are written before the meta file names them.
+    slate_mpi_call(
+        MPI_Barrier( mpi_comm ) );
+
+    if (B.mpiRank() == 0) {
+        CheckpointMeta meta;
+        std::memcpy( meta.magic, checkpoint_magic, sizeof( meta.magic ) );
+        meta.version    = checkpoint_version;
+        meta.generation = generation;
+        meta.k          = k;
+        meta.info       = info;
+        meta.nsteps     = sizes.size();
+        meta.npivots    = pivots.size();
+
+        // Write a temporary file, then rename it, which replaces the
+        // previous meta file atomically.
+        std::string meta_name = filename + ".meta";
+        std::string tmp_name  = meta_name + ".tmp";
+        FILE* file = std::fopen( tmp_name.c_str(), "wb" );
+        if (file == nullptr)
+            slate_error( "Checkpoint: cannot create " + tmp_name );
+        bool ok = std::fwrite( &meta, sizeof( meta ), 1, file ) == 1
+                  && std::fwrite( sizes.data(), sizeof( int64_t ),
+                                  sizes.size(), file ) == sizes.size()
+                  && std::fwrite( pivots.data(), sizeof( Pivot ),
+                                  pivots.size(), file ) == pivots.size();
+        ok = (std::fclose( file ) == 0) && ok;
+        if (! ok || std::rename( tmp_name.c_str(), meta_name.c_str() ) != 0)
+            slate_error( "Checkpoint: cannot write " + meta_name );
+    }
+}
+
+} // namespace impl
+
+//------------------------------------------------------------------------------
+/// Creates a checkpoint.
+///
+/// @param[in] filename
+///     Prefix of the checkpoint files, filename.meta, filename.0, and
+///     filename.1, on a file system shared by all ranks.
+///
+/// @param[in] interval
+///     Number of block steps between checkpoints; 0 only restores.
+///
+Checkpoint::Checkpoint( std::string const& filename, int64_t interval )
+    : filename_( filename ),
+      interval_( interval ),
+      generation_( 0 ),
+      comm_( MPI_COMM_NULL )
+{
+    slate_assert( interval >= 0 );
+}
+
+//------------------------------------------------------------------------------
+/// Waits for the checkpoint in progress, if any, ignoring its errors,
+/// and frees the writer's MPI communicator.
+///
+Checkpoint::~Checkpoint()
+{
+    if (writer_.joinable())
+        writer_.join();
+    if (comm_ != MPI_COMM_NULL) {
+        int finalized;
+        MPI_Finalized( &finalized );
+        if (! finalized)
+            MPI_Comm_free( &comm_ );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// @return the writer's duplicate of mpi_comm, created if needed.
+/// Collective over mpi_comm.
+///
+MPI_Comm Checkpoint::writerComm( MPI_Comm mpi_comm )
+{
+    if (comm_ != MPI_COMM_NULL) {
+        int result;
+        slate_mpi_call(
+            MPI_Comm_compare( comm_, mpi_comm, &result ) );
+        if (result == MPI_CONGRUENT)
+            return comm_;
+        slate_mpi_call(
+            MPI_Comm_free( &comm_ ) );
+    }
+    slate_mpi_call(
+        MPI_Comm_dup( mpi_comm, &comm_ ) );
+    return comm_;
+}
+
+//------------------------------------------------------------------------------
+/// Waits for the checkpoint in progress, if any, to be written.
+/// Throws the error of writing it, if any.
+///
+void Checkpoint::wait()
+{
+    if (writer_.joinable())
+        writer_.join();
+    if (error_) {
+        std::exception_ptr error = error_;
+        error_ = nullptr;
+        std::rethrow_exception( error );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Removes the checkpoint files, after the routine finished.
+/// Collective over mpi_comm.
+///
+void Checkpoint::remove( MPI_Comm mpi_comm )
+{
+    wait();
+    slate_mpi_call(
+        MPI_Barrier( mpi_comm ) );
+    int mpi_rank;
+    slate_mpi_call(
+        MPI_Comm_rank( mpi_comm, &mpi_rank ) );
+    if (mpi_rank == 0) {
+        // Remove the meta file first, so no partial checkpoint is restored.
+        std::remove( (filename_ + ".meta").c_str() );
+        std::remove( (filename_ + ".0").c_str() );
+        std::remove( (filename_ + ".1").c_str() );
+    }
+    generation_ = 0;
+}
+
+//------------------------------------------------------------------------------
+/// Restores op(A), the pivots, and info from the checkpoint, if its meta
+/// file exists. Tiles of A with origin on devices are updated on devices.
+/// Collective over A's MPI communicator.
+///
+/// @param[in,out] A
+///     The matrix being factored. Hermitian and triangular matrices
+///     restore only the tiles of their stored triangle.
+///
+/// @param[out] pivots
+///     If not null, the pivots of steps 0, ..., k-1 are restored.
+///     Must already have at least k steps.
+///
+/// @param[out] info
+///     The info of steps 0, ..., k-1, if restored.
+///
+/// @return the block step k to continue from, or 0 if there is no
+/// checkpoint.
+///
+template <typename scalar_t>
+int64_t Checkpoint::restore(
+    BaseMatrix<scalar_t>& A, Pivots* pivots, int64_t* info )
+{
+    trace::Block trace_block( "Checkpoint::restore" );
+
+    wait();
+
+    MPI_Comm mpi_comm = A.mpiComm();
+    std::string meta_name = filename_ + ".meta";
+
+    impl::CheckpointMeta meta;
+    std::vector<int64_t> sizes;
+    std::vector<Pivot> pivot_list;
+    int found = 0;
+    if (A.mpiRank() == 0) {
+        FILE* file = std::fopen( meta_name.c_str(), "rb" );
+        if (file != nullptr) {
+            bool ok = std::fread( &meta, sizeof( meta ), 1, file ) == 1
+                      && std::memcmp( meta.magic, impl::checkpoint_magic,
+                                      sizeof( meta.magic ) ) == 0
+                      && meta.version == impl::checkpoint_version;
+            if (ok) {
+                sizes.resize( meta.nsteps );
+                pivot_list.resize( meta.npivots );
+                ok = std::fread( sizes.data(), sizeof( int64_t ),
+                                 sizes.size(), file ) == sizes.size()
+                     && std::fread( pivot_list.data(), sizeof( Pivot ),
+                                    pivot_list.size(), file )
+                        == pivot_list.size();
+            }
+            std::fclose( file );
+            found = ok ? 1 : -1;
+        }
+    }
+    slate_mpi_call(
+        MPI_Bcast( &found, 1, MPI_INT, 0, mpi_comm ) );
+    if (found < 0)
+        slate_error( "Checkpoint: " + meta_name + " is not a checkpoint" );
+    if (found == 0)
+        return 0;
+
+    slate_mpi_call(
+        MPI_Bcast( &meta, sizeof( meta ), MPI_BYTE, 0, mpi_comm ) );
+    sizes.resize( meta.nsteps );
+    pivot_list.resize( meta.npivots );
+    slate_mpi_call(
+        MPI_Bcast( sizes.data(), sizes.size(), MPI_INT64_T, 0, mpi_comm ) );
+    slate_mpi_call(
+        MPI_Bcast( pivot_list.data(), sizeof( Pivot ) * pivot_list.size(),
+                   MPI_BYTE, 0, mpi_comm ) );
+
+    if (pivots != nullptr) {
+        int64_t offset = 0;
+        for (int64_t s = 0; s < meta.nsteps; ++s) {
+            pivots->at( s ).assign( pivot_list.data() + offset,
+                                    pivot_list.data() + offset + sizes[ s ] );
+            offset += sizes[ s ];
+        }
+    }
+    *info = meta.info;
+
+    // Read the matrix file into host tiles like A's.
+    auto B = impl::checkpoint_tiles_like( A, mpi_comm );
+    for (int64_t j = 0; j < A.nt(); ++j) {
+        for (int64_t i = 0; i < A.mt(); ++i) {
+            if (A.tileIsLocal( i, j ) && impl::checkpoint_tile( A, i, j ))
+                B.tileInsert( i, j );
+        }
+    }
+
+    std::string data_name = filename_ + "." + std::to_string( meta.generation );
+    MPI_File fh;
+    slate_mpi_call(
+        MPI_File_open( mpi_comm, data_name.c_str(), MPI_MODE_RDONLY,
+                       MPI_INFO_NULL, &fh ) );
+    auto header = internal::file_header<scalar_t>(
+                      B.m(), B.n(), B.tileMb( 0 ), B.tileNb( 0 ) );
+    internal::FileHeader file_header;
+    if (A.mpiRank() == 0) {
+        slate_mpi_call(
+            MPI_File_read_at( fh, 0, &file_header, sizeof( file_header ),
+                              MPI_BYTE, MPI_STATUS_IGNORE ) );
+    }
+    slate_mpi_call(
+        MPI_Bcast( &file_header, sizeof( file_header ), MPI_BYTE, 0,
+                   mpi_comm ) );
+    if (std::memcmp( &file_header, &header, sizeof( header ) ) != 0) {
+        MPI_File_close( &fh );
+        slate_error( "Checkpoint: " + data_name + " does not match the matrix" );
+    }
+    internal::file_tiles( fh, header, B, false, A.uplo() );
+    slate_mpi_call(
+        MPI_File_close( &fh ) );
+
+    for (int64_t j = 0; j < A.nt(); ++j) {
+        for (int64_t i = 0; i < A.mt(); ++i) {
+            if (A.tileIsLocal( i, j ) && impl::checkpoint_tile( A, i, j )) {
+                A.tileGetForWriting( i, j, HostNum, LayoutConvert::ColMajor );
+                auto T = A( i, j );
+                tile::gecopy( B( i, j ), T );
+                A.tileUpdateOrigin( i, j );
+                A.tileRelease( i, j, HostNum );
+            }
+        }
+    }
+
+    // Don't overwrite the restored checkpoint until the next one is written.
+    generation_ = 1 - meta.generation;
+    return meta.k;
+}
+
+//------------------------------------------------------------------------------
+/// Checkpoints op(A), the pivots, and info before block step k. Copies the
+/// local tiles to host memory, then writes them, the pivots, and k in a
+/// separate thread. Waits for the previous checkpoint first, and throws
+/// its error, if any. Unless MPI provides MPI_THREAD_MULTIPLE, writes
+/// before returning.
+/// Collective over A's MPI communicator. No tasks may be updating A.
+///
+/// @param[in] A
+///     The matrix being factored. Hermitian and triangular matrices
+///     save only the tiles of their stored triangle.
+///
+/// @param[in] pivots
+///     If not null, the pivots of steps 0, ..., k-1 are saved.
+///
+/// @param[in] k
+///     The block step to continue from.
+///
+/// @param[in] info
+///     The info of steps 0, ..., k-1 on this rank.
+///
+template <typename scalar_t>
+void Checkpoint::save(
+    BaseMatrix<scalar_t>& A, Pivots const* pivots, int64_t k, int64_t info )
+{
+    trace::Block trace_block( "Checkpoint::save" );
+
+    wait();
+
+    auto B = impl::checkpoint_tiles_like( A, writerComm( A.mpiComm() ) );
+    for (int64_t j = 0; j < A.nt(); ++j) {
+        for (int64_t i = 0; i < A.mt(); ++i) {
+            if (A.tileIsLocal( i, j ) && impl::checkpoint_tile( A, i, j )) {
+                A.tileGetForReading( i, j, HostNum, LayoutConvert::ColMajor );
+                B.tileInsert( i, j );
+                auto T = B( i, j );
+                tile::gecopy( A( i, j ), T );
+                A.tileRelease( i, j, HostNum );
+            }
+        }
+    }
+
+    std::vector<int64_t> sizes;
+    std::vector<Pivot> pivot_list;
+    if (pivots != nullptr) {
+        for (int64_t s = 0; s < k; ++s) {
+            sizes.push_back( pivots->at( s ).size() );
+            pivot_list.insert( pivot_list.end(),
+                               pivots->at( s ).begin(), pivots->at( s ).end() );
+        }
+    }
+
+    int64_t generation = generation_;
+    generation_ = 1 - generation_;
+    Uplo uplo = A.uplo();
+    auto write = [this, B, uplo, generation, k, info, sizes, pivot_list]()
+        mutable {
+            impl::checkpoint_write( B, uplo, filename_, generation, k, info,
+                                    sizes, pivot_list );
+        };
+
+    if (internal::mpiSerialized()) {
+        // The writer's collectives would hold the MPI lock while waiting
+        // for ranks blocked on it.
+        write();
+    }
+    else {
+        writer_ = std::thread( [this, write]() mutable {
+            try {
+                write();
+            }
+            catch (...) {
+                error_ = std::current_exception();
+            }
+        } );
+    }
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+int64_t Checkpoint::restore<float>(
+    BaseMatrix<float>& A, Pivots* pivots, int64_t* info );
+
+template
+int64_t Checkpoint::restore<double>(
+    BaseMatrix<double>& A, Pivots* pivots, int64_t* info );
+
+template
+int64_t Checkpoint::restore< std::complex<float> >(
+    BaseMatrix< std::complex<float> >& A, Pivots* pivots, int64_t* info );
+
+template
+int64_t Checkpoint::restore< std::complex<double> >(
+    BaseMatrix< std::complex<double> >& A, Pivots* pivots, int64_t* info );
+
+template
+void Checkpoint::save<float>(
+    BaseMatrix<float>& A, Pivots const* pivots, int64_t k, int64_t info );
+
+template
+void Checkpoint::save<double>(
+    BaseMatrix<double>& A, Pivots const* pivots, int64_t k, int64_t info );
+
+template
+void Checkpoint::save< std::complex<float> >(
+    BaseMatrix< std::complex<float> >& A, Pivots const* pivots,
+    int64_t k, int64_t info );
+
+template
+void Checkpoint::save< std::complex<double> >(
+    BaseMatrix< std::complex<double> >& A, Pivots const* pivots,
+    int64_t k, int64_t info );
+
+} // namespace slate
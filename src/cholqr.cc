@@ -5,21 +5,82 @@
 
 #include "slate/slate.hh"
 #include "internal/internal.hh"
+#include "internal/internal_cost.hh"
 
 #include <list>
 #include <tuple>
+#include <type_traits>
 
 namespace slate {
 
 //------------------------------------------------------------------------------
+/// Selects how to compute R = A^H A, for m-by-n A, by a communication and
+/// computation cost model.
+/// GemmC and HerkC keep R in place and receive block cols of A for its
+///     block rows and cols, m (n/p + n/q) words per rank;
+///     HerkC has half the flops, but also half the tiles to spread.
+/// GemmA keeps A in place, receives block cols of A, and reduces
+///     partial R, n (m/p + n/q) words per rank.
+/// HerkA receives A(i, k) only within a process row, none if q = 1,
+///     and reduces half of R, m n / p + n^2 / 2 words per rank.
+/// @see internal::CostModel
+///
 template <typename TA, typename TB>
 inline MethodCholQR select_algo( TA& A, TB& B, Options const& opts )
 {
-    Target target = get_option( opts, Option::Target, Target::HostTask );
-
-    MethodCholQR method = (target == Target::Devices ? MethodCholQR::HerkC
-                                                     : MethodCholQR::GemmA);
+    using scalar_t = typename TA::value_type;
+
+    Target target = get_target( opts, Target::HostTask );
+    int n_devices = A.num_devices();
+
+    internal::CostModel model = internal::cost_model( "cholqr", A, opts );
+    double p = model.p, q = model.q;
+    double m  = A.m(),  n  = A.n();
+    double mt = A.mt(), nt = A.nt();
+    double ws = sizeof( scalar_t );
+    double gemm_flops = 2 * m * n * n;
+
+    double time_GemmC = model.time(
+        mt*(std::ceil( nt/p ) + std::ceil( nt/q )),
+        ws * m * (n/p + n/q), gemm_flops, nt*nt );
+    double time_HerkC = model.time(
+        mt*(std::ceil( nt/p ) + std::ceil( nt/q )),
+        ws * m * (n/p + n/q), gemm_flops/2, nt*(nt + 1)/2 );
+    double time_GemmA = model.time(
+        std::ceil( mt/p )*nt + nt*std::ceil( nt/q ),
+        ws * n * (m/p + n/q), gemm_flops, mt*nt );
+    double time_HerkA = model.time(
+        (q > 1 ? std::ceil( mt/p )*nt : 0) + nt*(nt + 1)/2,
+        ws * ((q > 1 ? m*n/p : 0) + n*n/2), gemm_flops/2, mt*nt );
+
+    // The A methods support only one device per rank.
+    bool a_ok = (target != Target::Devices || n_devices <= 1);
+
+    MethodCholQR method = MethodCholQR::HerkC;
+    double time = time_HerkC;
+    if (time_GemmC < time) {
+        method = MethodCholQR::GemmC;
+        time = time_GemmC;
+    }
+    if (a_ok && time_GemmA < time) {
+        method = MethodCholQR::GemmA;
+        time = time_GemmA;
+    }
+    if (a_ok && time_HerkA < time) {
+        method = MethodCholQR::HerkA;
+        time = time_HerkA;
+    }
 
+    if (get_option<int>( opts, Option::PrintVerbose, 0 ) >= 1) {
+        char reason[ 160 ];
+        std::snprintf( reason, sizeof( reason ),
+                       "est. GemmA %.2e s, GemmC %.2e s, "
+                       "HerkA %.2e s, HerkC %.2e s%s",
+                       time_GemmA, time_GemmC, time_HerkA, time_HerkC,
+                       (a_ok ? "" : "; A methods need one device per rank") );
+        internal::log_method( "cholqr", A, opts, to_c_string( method ),
+                              reason );
+    }
     return method;
 }
 
@@ -27,7 +88,86 @@ namespace impl {
 
 //------------------------------------------------------------------------------
 /// @internal
-/// Generic implementation for any target that uses either gemmA or gemmC
+/// Computes the upper triangle of R = A^H A, with the products local to A,
+/// for the HerkA method. For each block column k, tile A(i, k) is sent
+/// only to the ranks owning A(i, 0:k), which for a p-by-1 grid is the rank
+/// that already has it. Each rank multiplies its local tiles, and the
+/// partial R(j, k), j <= k, are reduced to their owners, so only the
+/// small n-by-n result is communicated, and half of it, compared to gemmA.
+///
+/// @ingroup geqrf_specialization
+///
+template <Target target, typename scalar_t>
+void cholqr_herkA(
+    Matrix<scalar_t>& A,
+    Matrix<scalar_t>& R,
+    Options const& opts )
+{
+    using BcastList  = typename Matrix<scalar_t>::BcastList;
+    using ReduceList = typename Matrix<scalar_t>::ReduceList;
+
+    // Constants
+    const scalar_t one  = 1.0;
+    const scalar_t zero = 0.0;
+    // Assumes column major
+    const Layout layout = Layout::ColMajor;
+
+    auto AH = conj_transpose( A );
+    int64_t A_mt = A.mt();
+    int64_t A_nt = A.nt();
+
+    if (target == Target::Devices) {
+        if (A.num_devices() > 1)
+            slate_not_implemented( "HerkA doesn't support multiple GPUs" );
+        A.allocateBatchArrays();
+        A.reserveDeviceWorkspace();
+    }
+
+    // set min number for omp nested active parallel regions
+    slate::OmpSetMaxActiveLevels set_active_levels( MinOmpActiveLevels );
+
+    #pragma omp parallel
+    #pragma omp master
+    {
+        for (int64_t k = 0; k < A_nt; ++k) {
+            // Send A(i, k) to ranks owning A(i, 0:k).
+            BcastList bcast_list_A;
+            for (int64_t i = 0; i < A_mt; ++i)
+                bcast_list_A.push_back( {i, k, {A.sub( i, i, 0, k )}} );
+            A.template listBcast<target>( bcast_list_A, layout, k );
+
+            // R(0:k, k) = A(:, 0:k)^H A(:, k), local to A,
+            // leaving partial tiles of R to reduce.
+            internal::gemmA<target>(
+                one,  AH.sub( 0, k, 0, A_mt-1 ),
+                      A.sub( 0, A_mt-1, k, k ),
+                zero, R.sub( 0, k, k, k ),
+                layout );
+
+            // Reduce R(j, k) across the ranks owning A(:, j).
+            ReduceList reduce_list_R;
+            for (int64_t j = 0; j <= k; ++j)
+                reduce_list_R.push_back( {j, k,
+                                          R.sub( j, j, k, k ),
+                                          {AH.sub( j, j, 0, A_mt-1 )}
+                                        } );
+            R.template listReduce( reduce_list_R, layout, k );
+
+            auto R_col_k = R.sub( 0, k, k, k );
+            R_col_k.releaseRemoteWorkspace();
+            R_col_k.tileUpdateAllOrigin();
+            R_col_k.releaseLocalWorkspace();
+        }
+        #pragma omp taskwait
+
+        A.releaseRemoteWorkspace();
+        A.releaseLocalWorkspace();
+    }
+}
+
+//------------------------------------------------------------------------------
+/// @internal
+/// Generic implementation for any target that uses gemmA, gemmC, or herkA
 /// to compute the product A^H * A.
 ///
 /// @ingroup geqrf_specialization
@@ -62,6 +202,9 @@ void cholqr(
         case MethodCholQR::GemmC:
             gemmC( one,  AH, A, zero, R, opts );
             break;
+        case MethodCholQR::HerkA:
+            cholqr_herkA<target>( A, R, opts );
+            break;
         default:
             slate_error( "CholQR unknown method" );
     }
@@ -106,6 +249,64 @@ void cholqr(
     trsm( Side::Right, one, U, A, opts );
 }
 
+//------------------------------------------------------------------------------
+/// @internal
+/// Mixed-precision CholQR2, for GramPrecision::Single.
+/// The Gram matrix G = A^H A, the dominant cost, is computed in
+/// low precision scalar_lo, then converted to scalar_t for the Cholesky
+/// factorization G = R_1^H R_1 and A = A R_1^{-1}. The rounding errors of
+/// G leave Q = A with an orthogonality error of about cond( A )^2 u_lo,
+/// so one more CholQR pass in scalar_t, A = Q R_2, restores it to u,
+/// and R = R_2 R_1. The first Cholesky factorization requires
+/// cond( A ) below about u_lo^{-1/2}.
+///
+/// @ingroup geqrf_specialization
+///
+template <typename scalar_t, typename scalar_lo>
+void cholqr_mixed(
+    Matrix<scalar_t>& A,
+    Matrix<scalar_t>& R,
+    Options const& opts )
+{
+    using real_lo = blas::real_type<scalar_lo>;
+
+    // Constants
+    const scalar_t one = 1.0;
+    const real_lo r_one_lo  = 1.0;
+    const real_lo r_zero_lo = 0.0;
+
+    Target target = get_target( opts, Target::HostTask );
+
+    // G_lo = A_lo^H A_lo, in the upper triangle. The lower triangle stays
+    // zero, so R_1 is upper triangular for the accumulation below.
+    auto A_lo = A.template emptyLike<scalar_lo>();
+    A_lo.insertLocalTiles( target );
+    copy( A, A_lo, opts );
+    auto G_lo = R.template emptyLike<scalar_lo>();
+    G_lo.insertLocalTilesZero( target );
+    HermitianMatrix<scalar_lo> G_lo_H( Uplo::Upper, G_lo );
+    auto A_lo_H = conj_transpose( A_lo );
+    herk( r_one_lo, A_lo_H, r_zero_lo, G_lo_H, opts );
+    A_lo.clear();
+
+    // R_1^H R_1 = chol( G ), A = A R_1^{-1}, in the matrix precision.
+    copy( G_lo, R, opts );
+    G_lo.clear();
+    HermitianMatrix<scalar_t> R_H( Uplo::Upper, R );
+    potrf( R_H, opts );
+    auto U = TriangularMatrix<scalar_t>( Diag::NonUnit, R_H );
+    trsm( Side::Right, one, U, A, opts );
+
+    // Second pass, A = Q R_2, all in the matrix precision; R = R_2 R_1.
+    Options opts_hi( opts );
+    opts_hi[ Option::GramPrecision ] = GramPrecision::Native;
+    auto R_pass = R.emptyLike();
+    R_pass.insertLocalTiles( target );
+    slate::cholqr( A, R_pass, opts_hi );
+    auto Rp_U = TriangularMatrix<scalar_t>( Uplo::Upper, Diag::NonUnit, R_pass );
+    trmm( Side::Left, one, Rp_U, R, opts );
+}
+
 } // namespace impl
 
 //------------------------------------------------------------------------------
@@ -133,7 +334,9 @@ void cholqr(
         }
         case MethodCholQR::GemmA:
             /* Fallthrough */
-        case MethodCholQR::GemmC:{
+        case MethodCholQR::GemmC:
+            /* Fallthrough */
+        case MethodCholQR::HerkA: {
             Options opts2 = opts;
             opts2[ Option::MethodCholQR ] = method;
             impl::cholqr<target>( A, R, opts2 );
@@ -179,10 +382,24 @@ void cholqr(
 ///       Number of threads to use for panel. Default omp_get_max_threads()/2.
 ///     - Option::MethodCholQR:
 ///       Select the algorithm used to computed A^H * A:
-///       - Auto:
-///       - GemmA:
-///       - GemmC:
-///       - HerkC:
+///       - Auto:  let the routine decide, by a cost model of
+///         communication and computation. If Option::PrintVerbose >= 1,
+///         rank 0 prints the method chosen and the estimated times.
+///       - GemmA: gemm local to A, broadcasting tiles of A along
+///                process rows and reducing R.
+///       - GemmC: gemm local to R, broadcasting tiles of A.
+///       - HerkA: like GemmA, but only the upper triangle of R, so half
+///                the flops and reductions. Best for a tall, skinny A
+///                on a p-by-1 grid, where no tiles of A move.
+///       - HerkC: herk local to R.
+///     - Option::GramPrecision:
+///       Precision of A^H * A. Possible values:
+///       - Native: the precision of A [default].
+///       - Single: for double precision A, A^H * A in single precision,
+///                 then a second Cholesky QR pass in double precision for
+///                 the orthogonality of Q (mixed-precision CholQR2).
+///                 Requires cond( A ) below about 1e3. With Target::Devices,
+///                 can be combined with ComputePrecision::TF32.
 ///     - Option::Target:
 ///       Implementation to target. Possible values:
 ///       - HostTask:  OpenMP tasks on CPU host [default].
@@ -204,7 +421,20 @@ void cholqr(
         slate_error( "Cholesky QR requires m >= n" );
     }
 
-    Target target = get_option( opts, Option::Target, Target::HostTask );
+    // Only double precision has a lower precision for the Gram matrix.
+    using real_t = blas::real_type<scalar_t>;
+    GramPrecision gram_precision = get_option(
+        opts, Option::GramPrecision, GramPrecision::Native );
+    if constexpr (std::is_same<real_t, double>::value) {
+        if (gram_precision == GramPrecision::Single) {
+            using scalar_lo = std::conditional_t< is_complex<scalar_t>::value,
+                                                  std::complex<float>, float >;
+            impl::cholqr_mixed<scalar_t, scalar_lo>( A, R, opts );
+            return;
+        }
+    }
+
+    Target target = get_target( opts, Target::HostTask );
 
     // Test whether to call hemmA instead of hemm
     switch (target) {
@@ -220,6 +450,7 @@ void cholqr(
             cholqr<Target::HostBatch>(A, R, opts);
             break;
         case Target::Devices:
+        case Target::Hybrid:
             cholqr<Target::Devices>(A, R, opts);
             break;
     }
@@ -52,8 +52,12 @@ void colNorms(
 
         std::vector<real_t> local_maxes(A.n());
 
-        if (target == Target::Devices)
+        if (target == Target::Devices) {
+            const int64_t batch_size_default = 0;
+            const int64_t num_queues = 1;
+            A.allocateBatchArrays( batch_size_default, num_queues );
             A.reserveDeviceWorkspace();
+        }
 
         #pragma omp parallel
         #pragma omp master
@@ -62,14 +66,14 @@ void colNorms(
         }
 
         MPI_Op op_max_nan;
-        #pragma omp critical(slate_mpi)
         {
+            internal::MpiGuard mpi_guard;
             slate_mpi_call(
                 MPI_Op_create(mpi_max_nan, true, &op_max_nan));
         }
 
-        #pragma omp critical(slate_mpi)
         {
+            internal::MpiGuard mpi_guard;
             trace::Block trace_block("MPI_Allreduce");
             slate_mpi_call(
                 MPI_Allreduce(local_maxes.data(), values,
@@ -77,8 +81,8 @@ void colNorms(
                               op_max_nan, A.mpiComm()));
         }
 
-        #pragma omp critical(slate_mpi)
         {
+            internal::MpiGuard mpi_guard;
             slate_mpi_call(
                 MPI_Op_free(&op_max_nan));
         }
@@ -150,7 +154,7 @@ void colNorms(
     blas::real_type<typename matrix_type::value_type>* values,
     Options const& opts )
 {
-    Target target = get_option( opts, Option::Target, Target::HostTask );
+    Target target = get_target( opts, Target::HostTask );
 
     switch (target) {
         case Target::Host:
@@ -164,6 +168,7 @@ void colNorms(
             break;
 
         case Target::Devices:
+        case Target::Hybrid:
             impl::colNorms<Target::Devices>( in_norm, A, values, opts );
             break;
     }
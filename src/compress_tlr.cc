@@ -0,0 +1,120 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/slate.hh"
+#include "internal/internal.hh"
+
+#include <vector>
+
+namespace slate {
+
+//------------------------------------------------------------------------------
+/// Compresses a Hermitian matrix into a tile low-rank (TLR) matrix.
+/// Diagonal tiles are copied as dense tiles; each off-diagonal tile
+/// $A_{ij}$, i > j, is replaced by $U_{ij} V_{ij}^H$, truncating its SVD
+/// at singular values below T.tolerance(), so
+/// $\| A_{ij} - U_{ij} V_{ij}^H \|_2 \le$ T.tolerance().
+/// Each rank compresses its local tiles, without communication.
+/// A is not modified, and can be freed afterwards.
+///
+//------------------------------------------------------------------------------
+/// @tparam scalar_t
+///         One of float, double, std::complex<float>, std::complex<double>.
+//------------------------------------------------------------------------------
+/// @param[in] A
+///         The n-by-n Hermitian matrix A, stored lower.
+///
+/// @param[out] T
+///         The n-by-n TLR matrix, created from A as TLRMatrix( A, tol ).
+///         On exit, the compression of A.
+///
+/// @param[in] opts
+///         Additional options, as map of name = value pairs.
+///         Currently unused; compression is done on the host.
+///
+/// @ingroup posv_computational
+///
+template <typename scalar_t>
+void compress(
+    HermitianMatrix<scalar_t>& A,
+    TLRMatrix<scalar_t>& T,
+    Options const& opts )
+{
+    trace::Block trace_block( "slate::compress" );
+
+    using ij_tuple = typename BaseMatrix<scalar_t>::ij_tuple;
+
+    slate_assert( A.uplo() == Uplo::Lower );
+    slate_assert( A.nt() == T.nt() );
+
+    auto& D = T.diag();
+    int64_t nt = A.nt();
+
+    // Insert the local tiles, then fill them in parallel.
+    std::vector<ij_tuple> diag_tiles, offdiag_tiles;
+    for (int64_t j = 0; j < nt; ++j) {
+        for (int64_t i = j; i < nt; ++i) {
+            if (A.tileIsLocal( i, j )) {
+                if (i == j) {
+                    D.tileInsert( i, i );
+                    diag_tiles.push_back( { i, i } );
+                }
+                else {
+                    T.tileInsert( i, j, LowRankTile<scalar_t>() );
+                    offdiag_tiles.push_back( { i, j } );
+                }
+            }
+        }
+    }
+
+    for (auto ij : diag_tiles) {
+        int64_t i = std::get<0>( ij );
+        A.tileGetForReading( i, i, LayoutConvert::ColMajor );
+        auto Aii = A( i, i );
+        auto Dii = D( i, i );
+        lapack::lacpy( lapack::MatrixType::Lower, Aii.mb(), Aii.nb(),
+                       Aii.data(), Aii.stride(),
+                       Dii.data(), Dii.stride() );
+    }
+
+    blas::real_type<scalar_t> tol = T.tolerance();
+    #pragma omp parallel for schedule( dynamic, 1 )
+    for (size_t t = 0; t < offdiag_tiles.size(); ++t) {
+        int64_t i = std::get<0>( offdiag_tiles[ t ] );
+        int64_t j = std::get<1>( offdiag_tiles[ t ] );
+        A.tileGetForReading( i, j, LayoutConvert::ColMajor );
+        auto Aij = A( i, j );
+        T.tile( i, j ).compress( Aij.mb(), Aij.nb(),
+                                 Aij.data(), Aij.stride(), tol );
+    }
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void compress<float>(
+    HermitianMatrix<float>& A,
+    TLRMatrix<float>& T,
+    Options const& opts);
+
+template
+void compress<double>(
+    HermitianMatrix<double>& A,
+    TLRMatrix<double>& T,
+    Options const& opts);
+
+template
+void compress< std::complex<float> >(
+    HermitianMatrix< std::complex<float> >& A,
+    TLRMatrix< std::complex<float> >& T,
+    Options const& opts);
+
+template
+void compress< std::complex<double> >(
+    HermitianMatrix< std::complex<double> >& A,
+    TLRMatrix< std::complex<double> >& T,
+    Options const& opts);
+
+} // namespace slate
@@ -5,6 +5,7 @@
 
 #include "slate/slate.hh"
 #include "internal/internal.hh"
+#include "internal/internal_util.hh"
 
 #include <list>
 #include <tuple>
@@ -41,6 +42,9 @@ void copy(
         B.tileUpdateAllOrigin();
     }
 
+    if (A.zeroTilesTracked() || B.zeroTilesTracked())
+        internal::zero_tiles_copy( A, B );
+
     B.releaseWorkspace();
 }
 
@@ -49,6 +53,8 @@ void copy(
 //------------------------------------------------------------------------------
 /// Copy and precision conversion.
 /// Assuming the same distribution of source and destination.
+/// The structurally zero tiles of A are copied to B;
+/// @see BaseMatrix::trackZeroTiles.
 /// Transposition is currently ignored.
 /// TODO: Inspect transposition?
 //------------------------------------------------------------------------------
@@ -80,7 +86,7 @@ template <typename src_matrix_type, typename dst_matrix_type>
 void copy(src_matrix_type& A, dst_matrix_type& B,
           Options const& opts)
 {
-    Target target = get_option( opts, Option::Target, Target::HostTask );
+    Target target = get_target( opts, Target::HostTask );
 
     switch (target) {
         case Target::Host:
@@ -0,0 +1,381 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/Counters.hh"
+#include "slate/Exception.hh"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <set>
+#include <vector>
+
+namespace slate {
+
+namespace internal {
+
+std::atomic<int> counts_active( 0 );
+
+std::atomic<int64_t> counts[ num_counts ];
+
+std::atomic<Counters*> message_log( nullptr );
+
+namespace {
+
+//------------------------------------------------------------------------------
+/// @return wall time in seconds; not MPI_Wtime, which the MPI stubs lack.
+double wall_time()
+{
+    return std::chrono::duration<double>(
+        std::chrono::steady_clock::now().time_since_epoch() ).count();
+}
+
+} // anonymous namespace
+
+//------------------------------------------------------------------------------
+/// Starts counting phase: records the time and process-wide counts.
+///
+CounterPhase::CounterPhase( Counters* counters, char const* phase,
+                            double flops )
+    : counters_( counters ),
+      phase_( phase ),
+      flops_( flops ),
+      logs_messages_( false )
+{
+    if (counters_ != nullptr) {
+        if (counters_->logMessages()) {
+            Counters* expected = nullptr;
+            logs_messages_ = message_log.compare_exchange_strong(
+                                 expected, counters_ );
+        }
+        counts_active.fetch_add( 1 );
+        for (int k = 0; k < num_counts; ++k)
+            start_counts_[ k ] = counts[ k ].load( std::memory_order_relaxed );
+        start_ = wall_time();
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Stops counting phase: adds the elapsed time, flops, and change in
+/// process-wide counts to the phase's counters. Thread safe, so phases
+/// can be counted in concurrent tasks.
+///
+CounterPhase::~CounterPhase()
+{
+    if (counters_ == nullptr)
+        return;
+
+    double time = wall_time() - start_;
+    int64_t delta[ num_counts ];
+    for (int k = 0; k < num_counts; ++k)
+        delta[ k ] = counts[ k ].load( std::memory_order_relaxed )
+                   - start_counts_[ k ];
+    counts_active.fetch_sub( 1 );
+    if (logs_messages_)
+        message_log.store( nullptr );
+
+    PhaseCounters phase;
+    phase.calls               = 1;
+    phase.time                = time;
+    phase.flops               = flops_;
+    phase.bytes_sent          = delta[ int( Count::BytesSent         ) ];
+    phase.bytes_recv          = delta[ int( Count::BytesRecv         ) ];
+    phase.messages_sent       = delta[ int( Count::MessagesSent      ) ];
+    phase.tiles_to_device     = delta[ int( Count::TilesToDevice     ) ];
+    phase.tiles_to_host       = delta[ int( Count::TilesToHost       ) ];
+    phase.bytes_to_device     = delta[ int( Count::BytesToDevice     ) ];
+    phase.bytes_to_host       = delta[ int( Count::BytesToHost       ) ];
+    phase.layout_conversions  = delta[ int( Count::LayoutConversions ) ];
+    phase.layout_avoided      = delta[ int( Count::LayoutConversionsAvoided ) ];
+    phase.batch_launches      = delta[ int( Count::BatchLaunches     ) ];
+    phase.batch_tiles         = delta[ int( Count::BatchTiles        ) ];
+    phase.tile_hits           = delta[ int( Count::TileHits          ) ];
+    phase.tile_invalidations  = delta[ int( Count::TileInvalidations ) ];
+    phase.compress_raw_bytes  = delta[ int( Count::CompressRawBytes  ) ];
+    phase.compress_wire_bytes = delta[ int( Count::CompressWireBytes ) ];
+    phase.compress_time       = delta[ int( Count::CompressNanoseconds ) ] * 1e-9;
+    phase.decompress_bytes    = delta[ int( Count::DecompressBytes   ) ];
+    phase.decompress_time     = delta[ int( Count::DecompressNanoseconds ) ] * 1e-9;
+    counters_->add( phase_, phase );
+}
+
+} // namespace internal
+
+//------------------------------------------------------------------------------
+/// Merges counters across all ranks in comm, leaving the result on all
+/// ranks. Phases missing on some ranks are taken as zero.
+/// Calls, time, and flops take the max over ranks, as every rank runs the
+/// same distributed operation, and time is that of the slowest rank.
+/// Bytes, tiles, conversions, launches, and compression times are summed
+/// over ranks.
+/// If messages are logged, also sums the message size histogram and
+/// gathers the communication matrix.
+/// Collective on comm.
+///
+void Counters::merge( MPI_Comm comm )
+{
+    int mpi_size;
+    slate_mpi_call( MPI_Comm_size( comm, &mpi_size ) );
+
+    if (log_messages_) {
+        // Each rank contributes its row, the bytes it sent to each rank.
+        std::vector<int64_t> row( mpi_size, 0 );
+        for (auto& iter : bytes_to_) {
+            if (0 <= iter.first && iter.first < mpi_size)
+                row[ iter.first ] += iter.second;
+        }
+        comm_matrix_.resize( int64_t( mpi_size ) * mpi_size );
+        slate_mpi_call(
+            MPI_Allgather( row.data(), mpi_size, MPI_INT64_T,
+                           comm_matrix_.data(), mpi_size, MPI_INT64_T,
+                           comm ) );
+        if (mpi_size > 1) {
+            std::vector<int64_t> hist_local( size_histogram_ );
+            slate_mpi_call(
+                MPI_Allreduce( hist_local.data(), size_histogram_.data(),
+                               num_size_bins, MPI_INT64_T, MPI_SUM, comm ) );
+        }
+    }
+
+    if (mpi_size == 1)
+        return;
+
+    // Get the union of phase names as fixed-length, '\0' separated lists.
+    std::string names;
+    for (auto& iter : phases_) {
+        names += iter.first;
+        names += '\0';
+    }
+    int len = names.size() + 1;
+    int max_len;
+    slate_mpi_call(
+        MPI_Allreduce( &len, &max_len, 1, MPI_INT, MPI_MAX, comm ) );
+    names.resize( max_len, '\0' );
+
+    std::vector<char> all_names( int64_t( max_len ) * mpi_size );
+    slate_mpi_call(
+        MPI_Allgather( names.data(), max_len, MPI_CHAR,
+                       all_names.data(), max_len, MPI_CHAR, comm ) );
+
+    std::set<std::string> union_names;
+    for (int rank = 0; rank < mpi_size; ++rank) {
+        char const* p   = &all_names[ int64_t( rank ) * max_len ];
+        char const* end = p + max_len;
+        while (p < end && *p != '\0') {
+            union_names.insert( p );
+            p += strlen( p ) + 1;
+        }
+    }
+
+    // Reduce counters of each phase, in the same order on all ranks.
+    const int num_max = 3, num_sum = 16, num_dsum = 2;
+    int64_t num_phases = union_names.size();
+    std::vector<double>  max_vals( num_max * num_phases );
+    std::vector<int64_t> sum_vals( num_sum * num_phases );
+    std::vector<double>  dsum_vals( num_dsum * num_phases );
+    int64_t i = 0;
+    for (auto& name : union_names) {
+        PhaseCounters& phase = phases_[ name ];
+        max_vals[ num_max*i + 0 ] = phase.calls;
+        max_vals[ num_max*i + 1 ] = phase.time;
+        max_vals[ num_max*i + 2 ] = phase.flops;
+        sum_vals[ num_sum*i + 0 ] = phase.bytes_sent;
+        sum_vals[ num_sum*i + 1 ] = phase.bytes_recv;
+        sum_vals[ num_sum*i + 2 ] = phase.tiles_to_device;
+        sum_vals[ num_sum*i + 3 ] = phase.tiles_to_host;
+        sum_vals[ num_sum*i + 4 ] = phase.bytes_to_device;
+        sum_vals[ num_sum*i + 5 ] = phase.bytes_to_host;
+        sum_vals[ num_sum*i + 6 ] = phase.layout_conversions;
+        sum_vals[ num_sum*i + 7 ] = phase.batch_launches;
+        sum_vals[ num_sum*i + 8 ] = phase.batch_tiles;
+        sum_vals[ num_sum*i + 9 ] = phase.tile_hits;
+        sum_vals[ num_sum*i + 10 ] = phase.tile_invalidations;
+        sum_vals[ num_sum*i + 11 ] = phase.layout_avoided;
+        sum_vals[ num_sum*i + 12 ] = phase.messages_sent;
+        sum_vals[ num_sum*i + 13 ] = phase.compress_raw_bytes;
+        sum_vals[ num_sum*i + 14 ] = phase.compress_wire_bytes;
+        sum_vals[ num_sum*i + 15 ] = phase.decompress_bytes;
+        dsum_vals[ num_dsum*i + 0 ] = phase.compress_time;
+        dsum_vals[ num_dsum*i + 1 ] = phase.decompress_time;
+        ++i;
+    }
+    // Not MPI_IN_PLACE, which the MPI stubs lack.
+    std::vector<double>  max_local( max_vals );
+    std::vector<int64_t> sum_local( sum_vals );
+    std::vector<double>  dsum_local( dsum_vals );
+    slate_mpi_call(
+        MPI_Allreduce( max_local.data(), max_vals.data(), max_vals.size(),
+                       MPI_DOUBLE, MPI_MAX, comm ) );
+    slate_mpi_call(
+        MPI_Allreduce( sum_local.data(), sum_vals.data(), sum_vals.size(),
+                       MPI_INT64_T, MPI_SUM, comm ) );
+    slate_mpi_call(
+        MPI_Allreduce( dsum_local.data(), dsum_vals.data(), dsum_vals.size(),
+                       MPI_DOUBLE, MPI_SUM, comm ) );
+
+    i = 0;
+    for (auto& name : union_names) {
+        PhaseCounters& phase = phases_[ name ];
+        phase.calls              = int64_t( max_vals[ num_max*i + 0 ] );
+        phase.time               = max_vals[ num_max*i + 1 ];
+        phase.flops              = max_vals[ num_max*i + 2 ];
+        phase.bytes_sent         = sum_vals[ num_sum*i + 0 ];
+        phase.bytes_recv         = sum_vals[ num_sum*i + 1 ];
+        phase.tiles_to_device    = sum_vals[ num_sum*i + 2 ];
+        phase.tiles_to_host      = sum_vals[ num_sum*i + 3 ];
+        phase.bytes_to_device    = sum_vals[ num_sum*i + 4 ];
+        phase.bytes_to_host      = sum_vals[ num_sum*i + 5 ];
+        phase.layout_conversions = sum_vals[ num_sum*i + 6 ];
+        phase.batch_launches     = sum_vals[ num_sum*i + 7 ];
+        phase.batch_tiles        = sum_vals[ num_sum*i + 8 ];
+        phase.tile_hits          = sum_vals[ num_sum*i + 9 ];
+        phase.tile_invalidations = sum_vals[ num_sum*i + 10 ];
+        phase.layout_avoided     = sum_vals[ num_sum*i + 11 ];
+        phase.messages_sent      = sum_vals[ num_sum*i + 12 ];
+        phase.compress_raw_bytes  = sum_vals[ num_sum*i + 13 ];
+        phase.compress_wire_bytes = sum_vals[ num_sum*i + 14 ];
+        phase.decompress_bytes    = sum_vals[ num_sum*i + 15 ];
+        phase.compress_time       = dsum_vals[ num_dsum*i + 0 ];
+        phase.decompress_time     = dsum_vals[ num_dsum*i + 1 ];
+        ++i;
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Prints a table of counters, one phase per line, with the bytes moved
+/// between host and devices, and the arithmetic intensity in flops per
+/// byte moved (@see PhaseCounters::intensity). If any phase counted
+/// tile hits or invalidations (SLATE_COHERENCE_COUNTERS), prints those too,
+/// and likewise layout conversions avoided on row-major matrices, and the
+/// compression ratio and Gbyte/s of compressing and decompressing tiles
+/// (@see BaseMatrix::compressTransfers).
+///
+/// @param[in] file
+///     File to print to. Default stdout.
+///
+/// @param[in] peak_gflops
+///     Peak Gflop/s of all ranks the counters were merged over, e.g., the
+///     peak per node times the number of nodes. If > 0, prints each
+///     phase's percent of it. Default 0.
+///
+/// @param[in] peak_gbytes
+///     Peak Gbyte/s of the network and host-device links of all ranks. If
+///     > 0, prints each phase's percent of it, for the bytes moved.
+///     Default 0.
+///
+void Counters::print( FILE* file, double peak_gflops, double peak_gbytes ) const
+{
+    using llong = long long;
+
+    bool coherence = false;
+    bool avoided = false;
+    bool compressed = false;
+    for (auto& iter : phases_) {
+        coherence = coherence || iter.second.tile_hits > 0
+                              || iter.second.tile_invalidations > 0;
+        avoided = avoided || iter.second.layout_avoided > 0;
+        compressed = compressed || iter.second.compress_raw_bytes > 0
+                                || iter.second.decompress_bytes > 0;
+    }
+
+    fprintf( file, "%-24s %6s %10s %10s %10s %10s %10s"
+                   " %8s %8s %8s %8s %7s %8s",
+             "phase", "calls", "time (s)", "Gflop/s", "sent (MB)", "recv (MB)",
+             "h<>d (MB)", "to dev", "to host", "layout", "batches", "avg bat",
+             "flop/B" );
+    if (coherence)
+        fprintf( file, " %8s %8s", "hits", "invalid" );
+    if (avoided)
+        fprintf( file, " %8s", "avoided" );
+    if (compressed)
+        fprintf( file, " %7s %9s %9s", "ratio", "cmp GB/s", "dcmp GB/s" );
+    if (peak_gflops > 0)
+        fprintf( file, " %7s", "%flop" );
+    if (peak_gbytes > 0)
+        fprintf( file, " %7s", "%bw" );
+    fprintf( file, "\n" );
+
+    for (auto& iter : phases_) {
+        PhaseCounters const& phase = iter.second;
+        fprintf( file,
+                 "%-24s %6lld %10.4f %10.2f %10.2f %10.2f %10.2f"
+                 " %8lld %8lld %8lld %8lld %7.1f %8.1f",
+                 iter.first.c_str(), llong( phase.calls ),
+                 phase.time, phase.gflops(),
+                 phase.bytes_sent * 1e-6, phase.bytes_recv * 1e-6,
+                 (phase.bytes_to_device + phase.bytes_to_host) * 1e-6,
+                 llong( phase.tiles_to_device ), llong( phase.tiles_to_host ),
+                 llong( phase.layout_conversions ),
+                 llong( phase.batch_launches ), phase.batchSizeAvg(),
+                 phase.intensity() );
+        if (coherence) {
+            fprintf( file, " %8lld %8lld", llong( phase.tile_hits ),
+                     llong( phase.tile_invalidations ) );
+        }
+        if (avoided)
+            fprintf( file, " %8lld", llong( phase.layout_avoided ) );
+        if (compressed) {
+            fprintf( file, " %7.2f %9.2f %9.2f", phase.compressionRatio(),
+                     phase.compressGbytes(), phase.decompressGbytes() );
+        }
+        if (peak_gflops > 0)
+            fprintf( file, " %6.1f%%", 100 * phase.gflops() / peak_gflops );
+        if (peak_gbytes > 0)
+            fprintf( file, " %6.1f%%", 100 * phase.gbytes() / peak_gbytes );
+        fprintf( file, "\n" );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Prints, for each phase, the messages sent and their average size; the
+/// message size histogram; and, after merge, the communication matrix in
+/// Mbytes, one row per source rank, if it has at most 64 ranks.
+/// Prints nothing if messages are not logged.
+///
+/// @param[in] file
+///     File to print to. Default stdout.
+///
+void Counters::printMessages( FILE* file ) const
+{
+    using llong = long long;
+
+    if (! log_messages_)
+        return;
+
+    fprintf( file, "%-24s %10s %12s %12s\n",
+             "phase", "messages", "sent (MB)", "avg (KB)" );
+    for (auto& iter : phases_) {
+        PhaseCounters const& phase = iter.second;
+        fprintf( file, "%-24s %10lld %12.2f %12.2f\n",
+                 iter.first.c_str(), llong( phase.messages_sent ),
+                 phase.bytes_sent * 1e-6, phase.messageSizeAvg() * 1e-3 );
+    }
+
+    fprintf( file, "\n%-24s %10s\n", "message size (bytes)", "messages" );
+    for (int bin = 0; bin < num_size_bins; ++bin) {
+        if (size_histogram_[ bin ] > 0) {
+            fprintf( file, "[ 2^%-2d, 2^%-2d ) %11s %10lld\n",
+                     bin, bin + 1, "", llong( size_histogram_[ bin ] ) );
+        }
+    }
+
+    int64_t p = int64_t( std::sqrt( double( comm_matrix_.size() ) ) );
+    if (p > 0 && p <= 64) {
+        fprintf( file, "\ncommunication matrix (MB), row: source, "
+                       "column: destination\n%6s", "" );
+        for (int64_t dst = 0; dst < p; ++dst)
+            fprintf( file, " %9lld", llong( dst ) );
+        fprintf( file, "\n" );
+        for (int64_t src = 0; src < p; ++src) {
+            fprintf( file, "%6lld", llong( src ) );
+            for (int64_t dst = 0; dst < p; ++dst)
+                fprintf( file, " %9.2f", comm_matrix_[ src*p + dst ] * 1e-6 );
+            fprintf( file, "\n" );
+        }
+    }
+}
+
+} // namespace slate
@@ -0,0 +1,268 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/DeviceGraph.hh"
+#include "slate/Exception.hh"
+
+#if defined( BLAS_HAVE_CUBLAS )
+    #include <cuda_runtime.h>
+#elif defined( BLAS_HAVE_ROCBLAS )
+    #include <hip/hip_runtime.h>
+#endif
+
+#include <string>
+
+namespace slate {
+
+namespace {
+
+//------------------------------------------------------------------------------
+// Graphs, wrapping CUDA or HIP.
+#if defined( BLAS_HAVE_CUBLAS )
+    #define SLATE_DEVICE_GRAPH
+
+    using device_error_t = cudaError_t;
+    using graph_t        = cudaGraph_t;
+    using graph_exec_t   = cudaGraphExec_t;
+
+    const device_error_t device_success = cudaSuccess;
+
+    char const* device_error_string( device_error_t err )
+    {
+        return cudaGetErrorString( err );
+    }
+
+    device_error_t device_begin_capture( blas::Queue& queue )
+    {
+        // Relaxed mode lets other threads keep using the runtime,
+        // e.g., to allocate, while this thread captures.
+        return cudaStreamBeginCapture( queue.stream(),
+                                       cudaStreamCaptureModeRelaxed );
+    }
+
+    device_error_t device_end_capture( blas::Queue& queue, graph_t* graph )
+    {
+        return cudaStreamEndCapture( queue.stream(), graph );
+    }
+
+    device_error_t device_instantiate( graph_exec_t* exec, graph_t graph )
+    {
+        return cudaGraphInstantiateWithFlags( exec, graph, 0 );
+    }
+
+    bool device_update( graph_exec_t exec, graph_t graph )
+    {
+        #if CUDART_VERSION >= 12000
+            cudaGraphExecUpdateResultInfo info;
+            return cudaGraphExecUpdate( exec, graph, &info ) == cudaSuccess;
+        #else
+            cudaGraphNode_t node;
+            cudaGraphExecUpdateResult result;
+            return cudaGraphExecUpdate( exec, graph, &node, &result )
+                   == cudaSuccess;
+        #endif
+    }
+
+    device_error_t device_launch( graph_exec_t exec, blas::Queue& queue )
+    {
+        return cudaGraphLaunch( exec, queue.stream() );
+    }
+
+    void device_graph_destroy( graph_t graph ) { cudaGraphDestroy( graph ); }
+
+    void device_exec_destroy( graph_exec_t exec )
+    {
+        cudaGraphExecDestroy( exec );
+    }
+
+    /// Clears the error a failed update leaves, so it isn't reported later.
+    void device_clear_error() { cudaGetLastError(); }
+
+#elif defined( BLAS_HAVE_ROCBLAS )
+    #define SLATE_DEVICE_GRAPH
+
+    using device_error_t = hipError_t;
+    using graph_t        = hipGraph_t;
+    using graph_exec_t   = hipGraphExec_t;
+
+    const device_error_t device_success = hipSuccess;
+
+    char const* device_error_string( device_error_t err )
+    {
+        return hipGetErrorString( err );
+    }
+
+    device_error_t device_begin_capture( blas::Queue& queue )
+    {
+        // Relaxed mode lets other threads keep using the runtime,
+        // e.g., to allocate, while this thread captures.
+        return hipStreamBeginCapture( queue.stream(),
+                                      hipStreamCaptureModeRelaxed );
+    }
+
+    device_error_t device_end_capture( blas::Queue& queue, graph_t* graph )
+    {
+        return hipStreamEndCapture( queue.stream(), graph );
+    }
+
+    device_error_t device_instantiate( graph_exec_t* exec, graph_t graph )
+    {
+        return hipGraphInstantiate( exec, graph, nullptr, nullptr, 0 );
+    }
+
+    bool device_update( graph_exec_t exec, graph_t graph )
+    {
+        hipGraphNode_t node;
+        hipGraphExecUpdateResult result;
+        return hipGraphExecUpdate( exec, graph, &node, &result ) == hipSuccess;
+    }
+
+    device_error_t device_launch( graph_exec_t exec, blas::Queue& queue )
+    {
+        return hipGraphLaunch( exec, queue.stream() );
+    }
+
+    void device_graph_destroy( graph_t graph ) { hipGraphDestroy( graph ); }
+
+    void device_exec_destroy( graph_exec_t exec )
+    {
+        hipGraphExecDestroy( exec );
+    }
+
+    /// Clears the error a failed update leaves, so it isn't reported later.
+    void device_clear_error() { hipGetLastError(); }
+#endif
+
+#if defined( SLATE_DEVICE_GRAPH )
+
+//------------------------------------------------------------------------------
+/// Throws an Exception if the CUDA or HIP call fails.
+#define slate_graph_call( call ) \
+    do { \
+        device_error_t slate_graph_call_ = call; \
+        if (slate_graph_call_ != device_success) \
+            throw slate::Exception( \
+                std::string( "SLATE device graph ERROR: " ) + #call \
+                + " failed: " + device_error_string( slate_graph_call_ ), \
+                __func__, __FILE__, __LINE__ ); \
+    } while (0)
+
+#endif
+
+} // anonymous namespace
+
+//------------------------------------------------------------------------------
+DeviceGraph::DeviceGraph()
+    : exec_( nullptr ),
+      num_updates_( 0 )
+{}
+
+//------------------------------------------------------------------------------
+DeviceGraph::~DeviceGraph()
+{
+    clear();
+}
+
+//------------------------------------------------------------------------------
+/// @return true if SLATE was built with CUDA or HIP, which support graphs.
+///
+bool DeviceGraph::supported()
+{
+    #if defined( SLATE_DEVICE_GRAPH )
+        return true;
+    #else
+        return false;
+    #endif
+}
+
+//------------------------------------------------------------------------------
+/// Starts capturing work enqueued on queue by the calling thread, instead
+/// of running it. Must be followed by endCapture on the same queue.
+///
+void DeviceGraph::beginCapture( blas::Queue& queue )
+{
+    #if defined( SLATE_DEVICE_GRAPH )
+        slate_graph_call( device_begin_capture( queue ) );
+    #else
+        slate_not_implemented( "SLATE was not built with CUDA or HIP" );
+    #endif
+}
+
+//------------------------------------------------------------------------------
+/// Ends capturing on queue. Updates the launchable graph in place if the
+/// new capture has the same topology, otherwise instantiates it.
+///
+void DeviceGraph::endCapture( blas::Queue& queue )
+{
+    #if defined( SLATE_DEVICE_GRAPH )
+        graph_t graph = nullptr;
+        slate_graph_call( device_end_capture( queue, &graph ) );
+
+        graph_exec_t exec = static_cast<graph_exec_t>( exec_ );
+        if (exec != nullptr && device_update( exec, graph )) {
+            ++num_updates_;
+        }
+        else {
+            device_clear_error();
+            if (exec != nullptr) {
+                device_exec_destroy( exec );
+                exec_ = nullptr;
+            }
+            device_error_t err = device_instantiate( &exec, graph );
+            if (err != device_success) {
+                device_graph_destroy( graph );
+                slate_graph_call( err );
+            }
+            exec_ = exec;
+        }
+        // The launchable graph doesn't need the captured one.
+        device_graph_destroy( graph );
+    #else
+        slate_not_implemented( "SLATE was not built with CUDA or HIP" );
+    #endif
+}
+
+//------------------------------------------------------------------------------
+/// Ends a capture that failed, discarding it and keeping the previous
+/// graph, if any.
+///
+void DeviceGraph::abortCapture( blas::Queue& queue )
+{
+    #if defined( SLATE_DEVICE_GRAPH )
+        graph_t graph = nullptr;
+        if (device_end_capture( queue, &graph ) == device_success
+            && graph != nullptr)
+            device_graph_destroy( graph );
+        device_clear_error();
+    #endif
+}
+
+//------------------------------------------------------------------------------
+/// Enqueues the captured work on queue, which may differ from the queue
+/// captured, but must be on the same device.
+///
+void DeviceGraph::launch( blas::Queue& queue )
+{
+    slate_assert( ! empty() );
+    #if defined( SLATE_DEVICE_GRAPH )
+        slate_graph_call(
+            device_launch( static_cast<graph_exec_t>( exec_ ), queue ) );
+    #endif
+}
+
+//------------------------------------------------------------------------------
+/// Frees the captured graph.
+///
+void DeviceGraph::clear()
+{
+    #if defined( SLATE_DEVICE_GRAPH )
+        if (exec_ != nullptr)
+            device_exec_destroy( static_cast<graph_exec_t>( exec_ ) );
+    #endif
+    exec_ = nullptr;
+    num_updates_ = 0;
+}
+
+} // namespace slate
@@ -0,0 +1,133 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/InfoRequest.hh"
+#include "slate/GrowthStats.hh"
+#include "slate/Exception.hh"
+#include "slate/types.hh"
+
+#include <limits>
+
+namespace slate {
+
+//------------------------------------------------------------------------------
+/// Creates a request with no reduction pending; wait() returns 0.
+///
+InfoRequest::InfoRequest()
+    : request_( MPI_REQUEST_NULL ),
+      send_info_( 0 ),
+      recv_info_( 0 ),
+      info_( 0 ),
+      send_growth_{ 0, 0, 0 },
+      recv_growth_{ 0, 0, 0 },
+      growth_( nullptr ),
+      pending_( false )
+{}
+
+//------------------------------------------------------------------------------
+/// Waits for a pending reduction, since MPI still owns its buffers.
+///
+InfoRequest::~InfoRequest()
+{
+    if (pending_) {
+        try {
+            wait();
+        }
+        catch (...) {
+            // Don't throw from a destructor.
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Starts the reduction of info over the ranks of mpi_comm, as in
+/// internal::reduce_info. Collective, nonblocking.
+///
+/// @param[in] info
+///     Status on this rank; 0 means no error.
+///
+/// @param[in] mpi_comm
+///     MPI communicator.
+///
+/// @param[in] growth
+///     Optional growth statistics of this rank, reduced with info, as in
+///     internal::reduce_info( info, mpi_comm, growth ). wait() stores the
+///     reduced statistics in it, so it must live until then.
+///
+void InfoRequest::start( int64_t info, MPI_Comm mpi_comm, GrowthStats* growth )
+{
+    slate_error_if( pending_ );
+
+    growth_ = growth;
+    if (growth == nullptr) {
+        // Use int64_max as a sentinel to indicate no error.
+        send_info_ = info == 0 ? std::numeric_limits<int64_t>::max() : info;
+        slate_mpi_call(
+            MPI_Iallreduce( &send_info_, &recv_info_, 1,
+                            mpi_type<int64_t>::value,
+                            MPI_MIN, mpi_comm, &request_ ) );
+    }
+    else {
+        // One MIN reduction: info, -max |a_ij|, -max |u_ij|.
+        send_growth_[ 0 ] = info == 0 ? std::numeric_limits<double>::max()
+                                      : double( info );
+        send_growth_[ 1 ] = -growth->maxA();
+        send_growth_[ 2 ] = -growth->maxU();
+        slate_mpi_call(
+            MPI_Iallreduce( send_growth_, recv_growth_, 3, MPI_DOUBLE,
+                            MPI_MIN, mpi_comm, &request_ ) );
+    }
+    pending_ = true;
+}
+
+//------------------------------------------------------------------------------
+/// Tests for completion of the reduction, without blocking.
+///
+/// @return whether the info is available, i.e., wait() won't block.
+///
+bool InfoRequest::test()
+{
+    if (pending_) {
+        int flag = 0;
+        slate_mpi_call( MPI_Test( &request_, &flag, MPI_STATUS_IGNORE ) );
+        if (! flag)
+            return false;
+        finish();
+    }
+    return true;
+}
+
+//------------------------------------------------------------------------------
+/// Waits for the reduction to complete.
+///
+/// @return smallest non-zero info among all MPI ranks,
+///     or zero if info is zero on all MPI ranks.
+///
+int64_t InfoRequest::wait()
+{
+    if (pending_) {
+        slate_mpi_call( MPI_Wait( &request_, MPI_STATUS_IGNORE ) );
+        finish();
+    }
+    return info_;
+}
+
+//------------------------------------------------------------------------------
+void InfoRequest::finish()
+{
+    pending_ = false;
+    if (growth_ == nullptr) {
+        info_ = recv_info_ == std::numeric_limits<int64_t>::max()
+              ? 0 : recv_info_;
+    }
+    else {
+        info_ = recv_growth_[ 0 ] == std::numeric_limits<double>::max()
+              ? 0 : int64_t( recv_growth_[ 0 ] );
+        growth_->set( -recv_growth_[ 1 ], -recv_growth_[ 2 ] );
+        growth_ = nullptr;
+    }
+}
+
+} // namespace slate
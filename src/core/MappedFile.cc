@@ -0,0 +1,116 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/internal/MappedFile.hh"
+#include "slate/Exception.hh"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace slate {
+
+//------------------------------------------------------------------------------
+/// Opens or creates the file, extends it to size bytes if shorter,
+/// and maps it into memory, shared so modifications go to the file.
+/// Existing contents are kept; new space reads as zeros.
+///
+/// @param[in] filename
+///     Name of file to map.
+///
+/// @param[in] size
+///     Number of bytes to map. size > 0.
+///
+MappedFile::MappedFile(std::string const& filename, size_t size):
+    filename_( filename ),
+    size_( size ),
+    fd_( -1 ),
+    data_( nullptr )
+{
+    slate_assert( size > 0 );
+
+    fd_ = open( filename.c_str(), O_RDWR | O_CREAT, 0600 );
+    if (fd_ < 0) {
+        slate_error( "can't open " + filename + ": " + strerror( errno ) );
+    }
+
+    struct stat st;
+    if (fstat( fd_, &st ) != 0 || (size_t( st.st_size ) < size
+                                   && ftruncate( fd_, off_t( size ) ) != 0)) {
+        std::string msg = "can't resize " + filename + ": " + strerror( errno );
+        close( fd_ );
+        slate_error( msg );
+    }
+
+    data_ = mmap( nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0 );
+    if (data_ == MAP_FAILED) {
+        std::string msg = "can't map " + filename + ": " + strerror( errno );
+        close( fd_ );
+        slate_error( msg );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Writes modified pages back to the file and unmaps it.
+/// As this is called in a destructor, it should NOT throw exceptions.
+MappedFile::~MappedFile()
+{
+    msync( data_, size_, MS_SYNC );
+    munmap( data_, size_ );
+    close( fd_ );
+}
+
+//------------------------------------------------------------------------------
+/// Rounds [ptr, ptr + bytes) out to whole pages, as madvise requires.
+void MappedFile::page_range(
+    void const* ptr, size_t bytes, char** begin, size_t* length) const
+{
+    static const size_t page = size_t( sysconf( _SC_PAGESIZE ) );
+    size_t offset = (char const*) ptr - (char const*) data_;
+    size_t first = offset / page * page;
+    size_t last  = std::min( offset + bytes, size_ );
+    *begin  = (char*) data_ + first;
+    *length = last - first;
+}
+
+//------------------------------------------------------------------------------
+/// Hints that bytes starting at ptr will be accessed soon, so the OS
+/// starts reading them from the file asynchronously.
+void MappedFile::prefetch(void const* ptr, size_t bytes)
+{
+    char* begin;
+    size_t length;
+    page_range( ptr, bytes, &begin, &length );
+    posix_madvise( begin, length, POSIX_MADV_WILLNEED );
+}
+
+//------------------------------------------------------------------------------
+/// Hints that bytes starting at ptr won't be accessed for a while.
+/// Starts writing modified pages back to the file, so the OS can
+/// drop them from memory. The data remain valid.
+void MappedFile::release(void const* ptr, size_t bytes)
+{
+    char* begin;
+    size_t length;
+    page_range( ptr, bytes, &begin, &length );
+    msync( begin, length, MS_ASYNC );
+    posix_madvise( begin, length, POSIX_MADV_DONTNEED );
+}
+
+//------------------------------------------------------------------------------
+/// Writes all modified pages back to the file, waiting for completion.
+void MappedFile::sync()
+{
+    if (msync( data_, size_, MS_SYNC ) != 0) {
+        slate_error( "can't sync " + filename_ + ": " + strerror( errno ) );
+    }
+}
+
+} // namespace slate
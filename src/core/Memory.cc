@@ -6,20 +6,38 @@
 #include "auxiliary/Debug.hh"
 #include "slate/internal/Memory.hh"
 #include "slate/Exception.hh"
+#include <algorithm>
 
 namespace slate {
 
 int Memory::num_devices_;
+// defined before static_constructor_, which sizes it
+std::vector< MemoryStats > Memory::totals_;
 Memory::StaticConstructor Memory::static_constructor_;
 
 //------------------------------------------------------------------------------
-/// Construct saves block size, but does not allocate any memory.
+/// Construct saves block size and sets up the size classes,
+/// but does not allocate any memory.
+/// Smaller classes are halves of the next larger one, rounded down to a
+/// multiple of 256 bytes to keep blocks aligned.
 Memory::Memory(size_t block_size):
     block_size_(block_size),
-    free_blocks_( num_devices_ ),
-    allocated_mem_( num_devices_ ),
-    capacity_( num_devices_ )
+    allocated_mem_( num_devices_ + 1 ),
+    block_info_( num_devices_ + 1 ),
+    capacity_( num_devices_ + 1 ),
+    stats_( num_devices_ + 1 ),
+    host_pinned_( false )
 {
+    const size_t align = 256;
+    class_size_.push_back( block_size_ );
+    for (int k = 1; k < max_size_classes; ++k) {
+        size_t size = (block_size_ >> k) / align * align;
+        if (size < align)
+            break;
+        class_size_.push_back( size );
+    }
+    free_blocks_.resize( num_devices_ + 1,
+                         std::vector< std::stack<void*> >( class_size_.size() ) );
 }
 
 //------------------------------------------------------------------------------
@@ -31,30 +49,41 @@ Memory::~Memory()
     // needed to release memory (and can't be passed in here).  So to
     // release the memory, an explicit clear must called using the
     // queue parameter ( Memory::clearDeviceBlocks(device, *queue) ).
-    //assert(capacity_[ HostNum ] == 0);
+    assert( capacity_[ HostNum+1 ] == 0 );
     for (int device = 0; device < num_devices_; ++device) {
-        assert(capacity_[ device ] == 0);
+        assert(capacity_[ device+1 ] == 0);
     }
     // Debug::printNumFreeMemBlocks(*this);
 }
 
-/*
 //------------------------------------------------------------------------------
 /// Allocates num_blocks in host memory
 /// and adds them to the pool of free blocks.
+/// If queue is given, the blocks are in pinned memory, so copies between
+/// them and device memory can be asynchronous.
+/// All host pool blocks must be either pinned or not.
 ///
 // todo: merge with addDeviceBlocks by recognizing HostNum?
-void Memory::addHostBlocks(int64_t num_blocks)
+void Memory::addHostBlocks(int64_t num_blocks, blas::Queue *queue)
 {
+    if (num_blocks <= 0)
+        return;
+
     // or std::byte* (C++17)
     uint8_t* host_mem;
-    host_mem = (uint8_t*) allocHostMemory(block_size_*num_blocks);
-    capacity_[ HostNum ] += num_blocks;
+    #pragma omp critical(slate_memory)
+    {
+        slate_assert( capacity_[ HostNum+1 ] == 0
+                      || host_pinned_ == (queue != nullptr) );
+        host_pinned_ = (queue != nullptr);
 
-    for (int64_t i = 0; i < num_blocks; ++i)
-        free_blocks_[ HostNum ].push(host_mem + i*block_size_);
+        host_mem = (uint8_t*) allocHostMemory(block_size_*num_blocks, queue);
+        capacity_[ HostNum+1 ] += num_blocks;
+
+        for (int64_t i = 0; i < num_blocks; ++i)
+            free_blocks_[ HostNum+1 ][ 0 ].push(host_mem + i*block_size_);
+    }
 }
-*/
 
 //------------------------------------------------------------------------------
 /// Allocates num_blocks in given device's memory
@@ -64,33 +93,78 @@ void Memory::addDeviceBlocks(int device, int64_t num_blocks, blas::Queue *queue)
 {
     // or std::byte* (C++17)
     uint8_t* dev_mem;
-    dev_mem = (uint8_t*) allocDeviceMemory(device, block_size_*num_blocks, queue);
-    capacity_[device] += num_blocks;
+    #pragma omp critical(slate_memory)
+    {
+        dev_mem = (uint8_t*) allocDeviceMemory(device, block_size_*num_blocks, queue);
+        capacity_[ device+1 ] += num_blocks;
+
+        for (int64_t i = 0; i < num_blocks; ++i)
+            free_blocks_[ device+1 ][ 0 ].push(dev_mem + i*block_size_);
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Allocates one slab of block_size bytes in given device's memory,
+/// splits it into blocks of the given size class,
+/// and adds them to the pool of free blocks.
+/// Called within critical(slate_memory).
+///
+void Memory::addSlab(int device, int size_class, blas::Queue *queue)
+{
+    assert( size_class > 0 );
+    size_t size = class_size_[ size_class ];
+    int64_t num_blocks = block_size_ / size;
+
+    uint8_t* dev_mem;
+    dev_mem = (uint8_t*) allocDeviceMemory(device, block_size_, queue);
 
     for (int64_t i = 0; i < num_blocks; ++i)
-        free_blocks_[device].push(dev_mem + i*block_size_);
+        free_blocks_[ device+1 ][ size_class ].push(dev_mem + i*size);
+}
+
+//------------------------------------------------------------------------------
+/// @return smallest size class with blocks of at least size bytes.
+///
+int Memory::size_class(size_t size) const
+{
+    slate_assert( size <= block_size_ );
+    int k = num_size_classes() - 1;
+    while (k > 0 && size > class_size_[ k ])
+        --k;
+    return k;
 }
 
-/*
 //------------------------------------------------------------------------------
 /// Empties the pool of free blocks of host memory and frees the allocations.
+/// If the pool is pinned, queue must be given to free it.
 ///
 // todo: merge with clearDeviceBlocks by recognizing HostNum?
-void Memory::clearHostBlocks()
+void Memory::clearHostBlocks(blas::Queue *queue)
 {
     Debug::checkHostMemoryLeaks(*this);
 
-    while (! free_blocks_[ HostNum ].empty())
-        free_blocks_[ HostNum ].pop();
+    slate_assert( ! host_pinned_ || queue != nullptr
+                  || allocated_mem_[ HostNum+1 ].empty() );
+
+    while (! free_blocks_[ HostNum+1 ][ 0 ].empty())
+        free_blocks_[ HostNum+1 ][ 0 ].pop();
 
-    while (! allocated_mem_[ HostNum ].empty()) {
-        void* host_mem = allocated_mem_[ HostNum ].top();
-        freeHostMemory( host_mem );
-        allocated_mem_[ HostNum ].pop();
+    while (! allocated_mem_[ HostNum+1 ].empty()) {
+        void* host_mem = allocated_mem_[ HostNum+1 ].top();
+        freeHostMemory( host_mem, queue );
+        allocated_mem_[ HostNum+1 ].pop();
+    }
+    capacity_[ HostNum+1 ] = 0;
+    block_info_[ HostNum+1 ].clear();
+    host_pinned_ = false;
+
+    #pragma omp critical(slate_memory)
+    {
+        auto& stats = stats_[ HostNum+1 ];
+        updateStats( HostNum, -int64_t( stats.reserved ), -int64_t( stats.in_use ),
+                     -int64_t( stats.requested ), 0 );
     }
-    capacity_[ HostNum ] = 0;
 }
-*/
 
 //------------------------------------------------------------------------------
 /// Empties the pool of free blocks of given device's memory and frees the
@@ -98,43 +172,87 @@ void Memory::clearHostBlocks()
 ///
 void Memory::clearDeviceBlocks(int device, blas::Queue *queue)
 {
-    while (! free_blocks_[device].empty())
-        free_blocks_[device].pop();
+    Debug::checkDeviceMemoryLeaks(*this, device);
 
-    while (! allocated_mem_[device].empty()) {
-        void* dev_mem = allocated_mem_[device].top();
+    for (auto& free_blocks : free_blocks_[ device+1 ]) {
+        while (! free_blocks.empty())
+            free_blocks.pop();
+    }
+
+    while (! allocated_mem_[ device+1 ].empty()) {
+        void* dev_mem = allocated_mem_[ device+1 ].top();
         freeDeviceMemory(device, dev_mem, queue);
-        allocated_mem_[device].pop();
+        allocated_mem_[ device+1 ].pop();
     }
-    capacity_[device] = 0;
+    capacity_[ device+1 ] = 0;
+    block_info_[ device+1 ].clear();
 
-    Debug::checkDeviceMemoryLeaks(*this, device);
+    #pragma omp critical(slate_memory)
+    {
+        auto& stats = stats_[ device+1 ];
+        updateStats( device, -int64_t( stats.reserved ), -int64_t( stats.in_use ),
+                     -int64_t( stats.requested ), 0 );
+    }
 }
 
 //------------------------------------------------------------------------------
 /// @return single block of memory on the given device, which can be host,
-/// either from free blocks or by allocating a new block.
+/// either from free blocks of the smallest size class that fits,
+/// or by allocating a new block or slab.
+/// On host, blocks come from the host pool while it has free blocks,
+/// then are allocated on-the-fly, with size class -1.
 ///
 void* Memory::alloc(int device, size_t size, blas::Queue* queue)
 {
-    void* block;
+    void* block = nullptr;
 
     if (device == HostNum) {
-        //block = malloc(size);
-        block = new char[size];
+        if (size <= block_size_) {
+            #pragma omp critical(slate_memory)
+            {
+                auto& free_blocks = free_blocks_[ HostNum+1 ][ 0 ];
+                if (free_blocks.size() > 0) {
+                    block = free_blocks.top();
+                    free_blocks.pop();
+                    block_info_[ HostNum+1 ][ block ] = { 0, size };
+                    updateStats( HostNum, 0, block_size_, size, 0 );
+                    stats_[ HostNum+1 ].num_allocs += 1;
+                }
+            }
+        }
+        if (block == nullptr) {
+            //block = malloc(size);
+            block = new char[size];
+            #pragma omp critical(slate_memory)
+            {
+                block_info_[ HostNum+1 ][ block ] = { -1, size };
+                updateStats( HostNum, size, size, size, 0 );
+                stats_[ HostNum+1 ].num_allocs  += 1;
+                stats_[ HostNum+1 ].num_mallocs += 1;
+            }
+        }
     }
     else {
-        slate_assert( size <= block_size_ );
+        int k = size_class( size );
         // this block for device only
         #pragma omp critical(slate_memory)
         {
-            if (free_blocks_[device].size() > 0) {
-                block = free_blocks_[device].top();
-                free_blocks_[device].pop();
+            auto& free_blocks = free_blocks_[ device+1 ][ k ];
+            if (free_blocks.size() > 0) {
+                block = free_blocks.top();
+                free_blocks.pop();
             }
-            else {
+            else if (k == 0) {
                 block = allocBlock(device, queue);
             }
+            else {
+                addSlab(device, k, queue);
+                block = free_blocks.top();
+                free_blocks.pop();
+            }
+            block_info_[ device+1 ][ block ] = { k, size };
+            updateStats( device, 0, class_size_[k], size, 0 );
+            stats_[ device+1 ].num_allocs += 1;
         }
     }
     return block;
@@ -143,51 +261,74 @@ void* Memory::alloc(int device, size_t size, blas::Queue* queue)
 //------------------------------------------------------------------------------
 /// Puts a single block of memory back into the pool of free blocks
 /// for the given device, which can be host.
+/// Host blocks not from the host pool are deleted.
 ///
 void Memory::free(void* block, int device)
 {
+    bool found = false;
+    bool pooled = false;
+    #pragma omp critical(slate_memory)
+    {
+        auto& block_info = block_info_[ device+1 ];
+        auto iter = block_info.find(block);
+        if (iter != block_info.end()) {
+            int k = iter->second.size_class;
+            int64_t size = iter->second.size;
+            if (k < 0) {
+                // host block allocated on-the-fly
+                updateStats( device, -size, -size, -size, 0 );
+            }
+            else {
+                updateStats( device, 0, -int64_t( class_size_[k] ), -size, 0 );
+                free_blocks_[ device+1 ][k].push(block);
+                pooled = true;
+            }
+            block_info.erase(iter);
+            found = true;
+        }
+    }
+
     if (device == HostNum) {
-        //std::free(block);
-        delete[] (char*)block;
+        if (! pooled) {
+            //std::free(block);
+            delete[] (char*)block;
+        }
     }
     else {
-        #pragma omp critical(slate_memory)
-        {
-            free_blocks_[device].push(block);
-        }
+        // block must have been allocated from this pool, and not freed twice
+        slate_assert( found );
     }
 }
 
 //------------------------------------------------------------------------------
-/// Allocates a single block of memory on the given device, which can be host.
+/// Allocates a single block of memory on the given device.
+/// Called within critical(slate_memory).
 ///
 void* Memory::allocBlock(int device, blas::Queue *queue)
 {
-    void* block;
-    if (device == HostNum)
-        block = allocHostMemory(block_size_);
-    else
-        block = allocDeviceMemory(device, block_size_, queue);
+    assert( device != HostNum );
+    void* block = allocDeviceMemory(device, block_size_, queue);
 
-    capacity_[device] += 1;
+    capacity_[ device+1 ] += 1;
     return block;
 }
 
 //------------------------------------------------------------------------------
-/// Allocates host memory of given size.
+/// Allocates host memory of given size, pinned if queue is given.
 ///
-void* Memory::allocHostMemory(size_t size)
+void* Memory::allocHostMemory(size_t size, blas::Queue *queue)
 {
-    slate_not_implemented( "Memory pool currently doesn't handle host memory" );
-    return nullptr;
-    /*
     void* host_mem;
-    host_mem = malloc(size);
-    assert(host_mem != nullptr);
-    allocated_mem_[ HostNum ].push( host_mem );
+    if (queue != nullptr)
+        host_mem = blas::host_malloc_pinned<char>(size, *queue);
+    else
+        host_mem = malloc(size);
+    slate_assert(host_mem != nullptr);
+    allocated_mem_[ HostNum+1 ].push( host_mem );
+    updateStats( HostNum, size, 0, 0, 0 );
+    stats_[ HostNum+1 ].num_mallocs += 1;
 
     return host_mem;
-    */
 }
 
 //------------------------------------------------------------------------------
@@ -196,17 +337,22 @@ void* Memory::allocHostMemory(size_t size)
 void* Memory::allocDeviceMemory(int device, size_t size, blas::Queue *queue)
 {
     void* dev_mem = blas::device_malloc<char>(size, *queue);
-    allocated_mem_[device].push(dev_mem);
+    allocated_mem_[ device+1 ].push(dev_mem);
+    updateStats( device, size, 0, 0, 0 );
+    stats_[ device+1 ].num_mallocs += 1;
 
     return dev_mem;
 }
 
 //------------------------------------------------------------------------------
-/// Frees host memory.
+/// Frees host memory, pinned if the host pool is pinned.
 ///
-void Memory::freeHostMemory(void* host_mem)
+void Memory::freeHostMemory(void* host_mem, blas::Queue *queue)
 {
-    std::free(host_mem);
+    if (host_pinned_)
+        blas::host_free_pinned(host_mem, *queue);
+    else
+        std::free(host_mem);
 }
 
 //------------------------------------------------------------------------------
@@ -217,4 +363,89 @@ void Memory::freeDeviceMemory(int device, void* dev_mem, blas::Queue *queue)
     blas::device_free(dev_mem, *queue);
 }
 
+//------------------------------------------------------------------------------
+/// Adds the given changes in bytes to device's statistics, both for this
+/// Memory object and in total, and updates the high-water marks.
+/// Called within critical(slate_memory).
+///
+void Memory::updateStats(
+    int device, int64_t reserved, int64_t in_use,
+    int64_t requested, int64_t external)
+{
+    for (MemoryStats* stats : { &stats_[ device+1 ], &totals_[ device+1 ] }) {
+        stats->reserved  += reserved;
+        stats->in_use    += in_use;
+        stats->requested += requested;
+        stats->external  += external;
+        stats->peak        = std::max( stats->peak, stats->current() );
+        stats->peak_in_use = std::max( stats->peak_in_use,
+                                       stats->in_use + stats->external );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Accounts for size bytes allocated on device outside the pool,
+/// e.g., batch arrays, so they are included in current and peak use.
+///
+void Memory::addExternal(int device, size_t size)
+{
+    #pragma omp critical(slate_memory)
+    {
+        updateStats( device, 0, 0, 0, size );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Accounts for size bytes freed on device that were added by addExternal.
+///
+void Memory::removeExternal(int device, size_t size)
+{
+    #pragma omp critical(slate_memory)
+    {
+        updateStats( device, 0, 0, 0, -int64_t( size ) );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Resets device's high-water marks to the current use.
+///
+void Memory::resetPeak(int device)
+{
+    #pragma omp critical(slate_memory)
+    {
+        auto& stats = stats_.at( device+1 );
+        stats.peak        = stats.current();
+        stats.peak_in_use = stats.in_use + stats.external;
+    }
+}
+
+//------------------------------------------------------------------------------
+/// @return statistics of device, which can be host,
+/// summed over all Memory objects, i.e., over all matrices.
+///
+MemoryStats Memory::totalStats(int device)
+{
+    MemoryStats stats;
+    #pragma omp critical(slate_memory)
+    {
+        stats = totals_.at( device+1 );
+    }
+    return stats;
+}
+
+//------------------------------------------------------------------------------
+/// Resets device's high-water marks summed over all Memory objects to the
+/// current use. Calling this before a routine and totalStats after it gives
+/// the routine's peak memory use.
+///
+void Memory::resetTotalPeak(int device)
+{
+    #pragma omp critical(slate_memory)
+    {
+        auto& stats = totals_.at( device+1 );
+        stats.peak        = stats.current();
+        stats.peak_in_use = stats.in_use + stats.external;
+    }
+}
+
 } // namespace slate
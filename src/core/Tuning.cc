@@ -0,0 +1,182 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/Tuning.hh"
+#include "slate/Exception.hh"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <tuple>
+
+namespace slate {
+
+//------------------------------------------------------------------------------
+bool TuningKey::operator < ( TuningKey const& other ) const
+{
+    return std::tie( routine, precision, target, size_class, p, q )
+         < std::tie( other.routine, other.precision, other.target,
+                     other.size_class, other.p, other.q );
+}
+
+//------------------------------------------------------------------------------
+/// @return process-wide database, loaded from SLATE_TUNING_DB on first use.
+/// A missing file is taken as empty, so --tune can create it.
+///
+TuningDB& TuningDB::instance()
+{
+    static TuningDB* db = [] {
+        TuningDB* db_ = new TuningDB;
+        char const* path = std::getenv( "SLATE_TUNING_DB" );
+        if (path != nullptr && path[ 0 ] != '\0') {
+            db_->path_ = path;
+            db_->load( path );
+        }
+        return db_;
+    }();
+    return *db;
+}
+
+//------------------------------------------------------------------------------
+/// Adds entries from file path, keeping the faster entry of each key.
+/// Skips a missing file, comments, and malformed lines, so a stale or
+/// partly written database doesn't stop routines from running.
+///
+void TuningDB::load( std::string const& path )
+{
+    std::ifstream file( path );
+    std::string line;
+    while (std::getline( file, line )) {
+        if (line.empty() || line[ 0 ] == '#')
+            continue;
+
+        std::istringstream fields( line );
+        TuningKey key;
+        TuningEntry entry;
+        char target;
+        if (fields >> key.routine >> key.precision >> target
+                   >> key.size_class >> key.p >> key.q
+                   >> entry.nb >> entry.ib >> entry.lookahead
+                   >> entry.panel_threads >> entry.gflops) {
+            key.target = Target( target );
+            record( key, entry );
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Writes all entries to file path, replacing it. Writes a temporary file,
+/// then renames it, so readers never see a partial file.
+///
+void TuningDB::save( std::string const& path ) const
+{
+    std::string tmp = path + ".tmp";
+    FILE* file = fopen( tmp.c_str(), "w" );
+    if (file == nullptr)
+        slate_error( "cannot write tuning database " + tmp );
+
+    fprintf( file, "# routine precision target size_class p q"
+                   " nb ib lookahead panel_threads gflops\n" );
+    {
+        std::lock_guard<std::mutex> guard( mutex_ );
+        for (auto& iter : entries_) {
+            TuningKey const& key = iter.first;
+            TuningEntry const& entry = iter.second;
+            fprintf( file, "%s %c %c %lld %d %d %lld %lld %lld %lld %.6g\n",
+                     key.routine.c_str(), key.precision, char( key.target ),
+                     llong( key.size_class ), key.p, key.q,
+                     llong( entry.nb ), llong( entry.ib ),
+                     llong( entry.lookahead ), llong( entry.panel_threads ),
+                     entry.gflops );
+        }
+    }
+    fclose( file );
+
+    if (std::rename( tmp.c_str(), path.c_str() ) != 0)
+        slate_error( "cannot rename " + tmp + " to " + path );
+}
+
+//------------------------------------------------------------------------------
+/// Finds tuned parameters of key.
+///
+/// @param[out] entry
+///     On exit, if found, the tuned parameters.
+///
+/// @return true if found.
+///
+bool TuningDB::lookup( TuningKey const& key, TuningEntry* entry ) const
+{
+    std::lock_guard<std::mutex> guard( mutex_ );
+    auto iter = entries_.find( key );
+    if (iter == entries_.end())
+        return false;
+    *entry = iter->second;
+    return true;
+}
+
+//------------------------------------------------------------------------------
+/// Records parameters measured for key, if they are faster than the
+/// current entry, or there is none.
+///
+/// @return true if recorded.
+///
+bool TuningDB::record( TuningKey const& key, TuningEntry const& entry )
+{
+    std::lock_guard<std::mutex> guard( mutex_ );
+    auto iter = entries_.find( key );
+    if (iter != entries_.end() && iter->second.gflops >= entry.gflops)
+        return false;
+    entries_[ key ] = entry;
+    return true;
+}
+
+//------------------------------------------------------------------------------
+/// Removes all entries.
+///
+void TuningDB::clear()
+{
+    std::lock_guard<std::mutex> guard( mutex_ );
+    entries_.clear();
+}
+
+//------------------------------------------------------------------------------
+/// @return size class of dimension n: floor( log2( n ) ), so sizes within a
+/// factor of 2 share tuned parameters; 0 for n <= 1.
+///
+int64_t TuningDB::sizeClass( int64_t n )
+{
+    int64_t size_class = 0;
+    while (n > 1) {
+        n /= 2;
+        ++size_class;
+    }
+    return size_class;
+}
+
+//------------------------------------------------------------------------------
+/// @return opts, with tuned InnerBlocking, Lookahead, MaxPanelThreads, and
+/// BlockSize of key added where opts doesn't set them.
+///
+Options TuningDB::tunedOptions( TuningKey const& key, Options const& opts ) const
+{
+    TuningEntry entry;
+    if (! lookup( key, &entry ))
+        return opts;
+
+    Options tuned = opts;
+    // insert doesn't replace options the caller set.
+    if (entry.nb > 0)
+        tuned.insert( { Option::BlockSize, entry.nb } );
+    if (entry.ib > 0)
+        tuned.insert( { Option::InnerBlocking, entry.ib } );
+    if (entry.lookahead >= LookaheadAuto)
+        tuned.insert( { Option::Lookahead, entry.lookahead } );
+    if (entry.panel_threads > 0)
+        tuned.insert( { Option::MaxPanelThreads, entry.panel_threads } );
+    return tuned;
+}
+
+} // namespace slate
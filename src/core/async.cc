@@ -0,0 +1,65 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/internal/mpi.hh"
+#include "slate/internal/openmp.hh"
+#include "slate/Exception.hh"
+
+#include <algorithm>
+#include <mutex>
+#include <set>
+
+namespace slate {
+namespace async {
+namespace internal {
+
+namespace {
+
+std::mutex mutex_;
+
+/// Communicators of the calls in flight.
+std::set<MPI_Comm> comms_;
+
+/// OpenMP threads of the process, shared by the calls in flight;
+/// taken from the first caller.
+int max_threads_ = 0;
+
+} // anonymous namespace
+
+//------------------------------------------------------------------------------
+/// [internal]
+/// Registers a call on mpi_comm.
+///
+/// @return number of OpenMP threads for the call: the threads of the
+/// process divided by the number of calls in flight, at least 1.
+///
+/// @throws Exception if a call on mpi_comm is already in flight.
+///
+int start( MPI_Comm mpi_comm )
+{
+    std::lock_guard<std::mutex> guard( mutex_ );
+    if (comms_.count( mpi_comm ) > 0) {
+        slate_error( "slate::async: a call on this communicator is in flight;"
+                     " concurrent calls need separate communicators" );
+    }
+    if (comms_.empty())
+        max_threads_ = omp_get_max_threads();
+    comms_.insert( mpi_comm );
+    return std::max( 1, max_threads_ / int( comms_.size() ) );
+}
+
+//------------------------------------------------------------------------------
+/// [internal]
+/// Unregisters the call on mpi_comm.
+///
+void finish( MPI_Comm mpi_comm )
+{
+    std::lock_guard<std::mutex> guard( mutex_ );
+    comms_.erase( mpi_comm );
+}
+
+} // namespace internal
+} // namespace async
+} // namespace slate
@@ -0,0 +1,364 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/internal/compress.hh"
+#include "slate/Counters.hh"
+#include "slate/Exception.hh"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace slate {
+namespace internal {
+
+namespace {
+
+//------------------------------------------------------------------------------
+/// Unsigned integer with the bits of real_t.
+template <typename real_t> struct uint_of;
+template <> struct uint_of<float>  { using type = uint32_t; };
+template <> struct uint_of<double> { using type = uint64_t; };
+
+//------------------------------------------------------------------------------
+/// @return nanoseconds since an arbitrary start, for the codec counters.
+int64_t nanoseconds()
+{
+    return std::chrono::duration_cast< std::chrono::nanoseconds >(
+        std::chrono::steady_clock::now().time_since_epoch() ).count();
+}
+
+//------------------------------------------------------------------------------
+/// Rounds the mantissa of the entry with bits u to nearest, dropping its
+/// low drop bits, 0 < drop <= mantissa bits. Inf and NaN are unchanged;
+/// entries that would round to Inf are truncated instead.
+template <typename real_t>
+typename uint_of<real_t>::type round_mantissa(
+    typename uint_of<real_t>::type u, int drop)
+{
+    using uint_t = typename uint_of<real_t>::type;
+    const int mantissa_bits = std::numeric_limits<real_t>::digits - 1;
+    const int exponent_bits = 8*sizeof(real_t) - 1 - mantissa_bits;
+    const uint_t exponent_mask
+        = ((uint_t( 1 ) << exponent_bits) - 1) << mantissa_bits;
+
+    if ((u & exponent_mask) == exponent_mask)
+        return u;
+    uint_t low = (uint_t( 1 ) << drop) - 1;
+    // A carry out of the mantissa correctly increments the exponent.
+    uint_t r = (u + (uint_t( 1 ) << (drop - 1))) & ~low;
+    if ((r & exponent_mask) == exponent_mask)
+        r = u & ~low;
+    return r;
+}
+
+//------------------------------------------------------------------------------
+/// Byte-shuffles the entries into planes: byte b of entry e goes to
+/// planes[ b*n + e ], where n = vector_len * num_vectors, after dropping
+/// the low drop bits of each mantissa, if drop > 0.
+template <typename real_t>
+void shuffle(
+    real_t const* data, int64_t vector_len, int64_t num_vectors,
+    int64_t stride, int drop, uint8_t* planes)
+{
+    using uint_t = typename uint_of<real_t>::type;
+    const int64_t n = vector_len * num_vectors;
+    const int bytes = sizeof(real_t);
+
+    int64_t e = 0;
+    for (int64_t v = 0; v < num_vectors; ++v) {
+        real_t const* x = data + v*stride;
+        for (int64_t k = 0; k < vector_len; ++k, ++e) {
+            uint_t u;
+            std::memcpy( &u, &x[ k ], bytes );
+            if (drop > 0)
+                u = round_mantissa<real_t>( u, drop );
+            for (int b = 0; b < bytes; ++b)
+                planes[ b*n + e ] = uint8_t( u >> (8*b) );
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Inverse of shuffle, without the rounding.
+template <typename real_t>
+void unshuffle(
+    uint8_t const* planes,
+    real_t* data, int64_t vector_len, int64_t num_vectors, int64_t stride)
+{
+    using uint_t = typename uint_of<real_t>::type;
+    const int64_t n = vector_len * num_vectors;
+    const int bytes = sizeof(real_t);
+
+    int64_t e = 0;
+    for (int64_t v = 0; v < num_vectors; ++v) {
+        real_t* x = data + v*stride;
+        for (int64_t k = 0; k < vector_len; ++k, ++e) {
+            uint_t u = 0;
+            for (int b = 0; b < bytes; ++b)
+                u |= uint_t( planes[ b*n + e ] ) << (8*b);
+            std::memcpy( &x[ k ], &u, bytes );
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Appends n as a variable-length integer, 7 bits per byte.
+/// @return false if it doesn't fit before end.
+bool put_varint(uint8_t*& out, uint8_t const* end, uint64_t n)
+{
+    do {
+        if (out == end)
+            return false;
+        uint8_t byte = n & 0x7f;
+        n >>= 7;
+        *out++ = byte | (n > 0 ? 0x80 : 0);
+    } while (n > 0);
+    return true;
+}
+
+//------------------------------------------------------------------------------
+/// @return variable-length integer read from in, before end.
+uint64_t get_varint(uint8_t const*& in, uint8_t const* end)
+{
+    uint64_t n = 0;
+    for (int shift = 0; ; shift += 7) {
+        slate_error_if( in == end || shift > 63 );
+        uint8_t byte = *in++;
+        n |= uint64_t( byte & 0x7f ) << shift;
+        if ((byte & 0x80) == 0)
+            return n;
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Appends a token: literal bytes lit[ 0 : lit_len ], then a run of
+/// run_len bytes equal to value.
+/// @return false if it doesn't fit before end.
+bool put_token(
+    uint8_t*& out, uint8_t const* end,
+    uint8_t const* lit, int64_t lit_len, int64_t run_len, uint8_t value)
+{
+    if (! put_varint( out, end, lit_len ) || end - out < lit_len)
+        return false;
+    std::memcpy( out, lit, lit_len );
+    out += lit_len;
+    if (! put_varint( out, end, run_len ))
+        return false;
+    if (run_len > 0) {
+        if (out == end)
+            return false;
+        *out++ = value;
+    }
+    return true;
+}
+
+//------------------------------------------------------------------------------
+/// Run-length encodes in[ 0 : n ] into out, as tokens of literal bytes
+/// followed by a run of at least min_run equal bytes.
+/// @return encoded length, or -1 if it is more than capacity.
+int64_t rle_encode(uint8_t const* in, int64_t n, uint8_t* out, int64_t capacity)
+{
+    // A run of 4 costs at most 3 bytes in a token with short literals.
+    const int64_t min_run = 4;
+
+    uint8_t* p = out;
+    uint8_t const* end = out + capacity;
+    int64_t lit = 0;
+    int64_t i = 0;
+    while (i < n) {
+        int64_t j = i + 1;
+        while (j < n && in[ j ] == in[ i ])
+            ++j;
+        if (j - i >= min_run) {
+            if (! put_token( p, end, in + lit, i - lit, j - i, in[ i ] ))
+                return -1;
+            lit = j;
+        }
+        i = j;
+    }
+    if (lit < n && ! put_token( p, end, in + lit, n - lit, 0, 0 ))
+        return -1;
+    return p - out;
+}
+
+//------------------------------------------------------------------------------
+/// Decodes in[ 0 : in_len ], encoded by rle_encode, into out[ 0 : n ].
+void rle_decode(uint8_t const* in, int64_t in_len, uint8_t* out, int64_t n)
+{
+    uint8_t const* end = in + in_len;
+    int64_t k = 0;
+    while (in < end) {
+        uint64_t lit_len = get_varint( in, end );
+        slate_error_if( lit_len > uint64_t( end - in )
+                        || lit_len > uint64_t( n - k ) );
+        std::memcpy( out + k, in, lit_len );
+        in += lit_len;
+        k += lit_len;
+
+        uint64_t run_len = get_varint( in, end );
+        if (run_len > 0) {
+            slate_error_if( in == end || run_len > uint64_t( n - k ) );
+            std::memset( out + k, *in++, run_len );
+            k += run_len;
+        }
+    }
+    slate_error_if( k != n );
+}
+
+} // anonymous namespace
+
+//------------------------------------------------------------------------------
+/// [internal]
+/// @return number of mantissa bits to keep so rounding to nearest has
+/// relative error at most tol, for normal numbers: half an ulp with b bits
+/// is 2^{-(b+1)}. Between 0 and mantissa_bits; mantissa_bits if tol <= 0.
+///
+int mantissa_bits_kept(double tol, int mantissa_bits)
+{
+    if (! (tol > 0))
+        return mantissa_bits;
+    int bits = int( std::ceil( -std::log2( tol ) ) ) - 1;
+    return std::max( 0, std::min( bits, mantissa_bits ) );
+}
+
+//------------------------------------------------------------------------------
+/// [internal]
+/// Compresses the entries into message. @see compress.hh for the format.
+/// Counts the bytes in and out and the time taken.
+///
+/// @param[in] compression
+///     Lossless or ErrorBounded. With None, the message is the raw entries.
+///
+/// @param[in] tol
+///     With ErrorBounded, relative error tolerance of each entry.
+///
+/// @param[in] data
+///     The entries, as real numbers.
+///
+/// @param[in] vector_len, num_vectors, stride
+///     Number of entries of each vector, number of vectors, and distance
+///     between vectors, in real entries.
+///
+/// @param[out] message
+///     The message, resized to its length.
+///
+/// @return length of the message, in bytes.
+///
+template <typename real_t>
+int64_t compress(
+    Compression compression, double tol,
+    real_t const* data, int64_t vector_len, int64_t num_vectors,
+    int64_t stride, std::vector<char>& message)
+{
+    const int mantissa_bits = std::numeric_limits<real_t>::digits - 1;
+    const int64_t raw_len = vector_len * num_vectors * sizeof(real_t);
+    int64_t start = nanoseconds();
+
+    // The message is never longer than the raw entries.
+    message.resize( raw_len );
+    int64_t len = -1;
+    if (compression != Compression::None && raw_len > 1) {
+        int kept = mantissa_bits;
+        if (compression == Compression::ErrorBounded)
+            kept = mantissa_bits_kept( tol, mantissa_bits );
+
+        thread_local std::vector<uint8_t> planes;
+        planes.resize( raw_len );
+        shuffle( data, vector_len, num_vectors, stride,
+                 mantissa_bits - kept, planes.data() );
+        len = rle_encode( planes.data(), raw_len,
+                          (uint8_t*) message.data(), raw_len - 1 );
+    }
+    if (len < 0) {
+        // Incompressible: send the raw entries, unrounded.
+        int64_t vector_bytes = vector_len * sizeof(real_t);
+        for (int64_t v = 0; v < num_vectors; ++v) {
+            std::memcpy( &message[ v*vector_bytes ], data + v*stride,
+                         vector_bytes );
+        }
+        len = raw_len;
+    }
+    message.resize( len );
+
+    count( Count::CompressRawBytes, raw_len );
+    count( Count::CompressWireBytes, len );
+    count( Count::CompressNanoseconds, nanoseconds() - start );
+    return len;
+}
+
+//------------------------------------------------------------------------------
+/// [internal]
+/// Decompresses message, made by compress, into the entries.
+/// Counts the bytes out and the time taken.
+///
+/// @param[in] message
+///     The message.
+///
+/// @param[in] message_len
+///     Length of the message, in bytes.
+///
+/// @param[out] data
+///     The entries, as real numbers.
+///
+/// @param[in] vector_len, num_vectors, stride
+///     As in compress.
+///
+template <typename real_t>
+void decompress(
+    char const* message, int64_t message_len,
+    real_t* data, int64_t vector_len, int64_t num_vectors, int64_t stride)
+{
+    const int64_t raw_len = vector_len * num_vectors * sizeof(real_t);
+    slate_error_if( message_len > raw_len );
+    int64_t start = nanoseconds();
+
+    if (message_len == raw_len) {
+        int64_t vector_bytes = vector_len * sizeof(real_t);
+        for (int64_t v = 0; v < num_vectors; ++v) {
+            std::memcpy( data + v*stride, &message[ v*vector_bytes ],
+                         vector_bytes );
+        }
+    }
+    else {
+        thread_local std::vector<uint8_t> planes;
+        planes.resize( raw_len );
+        rle_decode( (uint8_t const*) message, message_len,
+                    planes.data(), raw_len );
+        unshuffle( planes.data(), data, vector_len, num_vectors, stride );
+    }
+
+    count( Count::DecompressBytes, raw_len );
+    count( Count::DecompressNanoseconds, nanoseconds() - start );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+int64_t compress<float>(
+    Compression compression, double tol,
+    float const* data, int64_t vector_len, int64_t num_vectors,
+    int64_t stride, std::vector<char>& message);
+
+template
+int64_t compress<double>(
+    Compression compression, double tol,
+    double const* data, int64_t vector_len, int64_t num_vectors,
+    int64_t stride, std::vector<char>& message);
+
+template
+void decompress<float>(
+    char const* message, int64_t message_len,
+    float* data, int64_t vector_len, int64_t num_vectors, int64_t stride);
+
+template
+void decompress<double>(
+    char const* message, int64_t message_len,
+    double* data, int64_t vector_len, int64_t num_vectors, int64_t stride);
+
+} // namespace internal
+} // namespace slate
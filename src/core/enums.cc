@@ -16,21 +16,33 @@ const char* GridOrder_help    = "c or col; r or row";
 
 const char* MethodCholQR_help = "auto; gemmA; gemmC; herkA; herkC";
 
-const char* MethodGels_help   = "auto; QR; CholQR";
+const char* MethodGels_help   = "auto; QR; CholQR; CholQR2; CholQR3 or sCholQR3; Sketch";
 
-const char* MethodGemm_help   = "auto; A or gemmA; C or gemmC";
+const char* MethodGemm_help   = "auto; A or gemmA; C or gemmC; L, layered, or 2.5D";
 
 const char* MethodHemm_help   = "auto; A or hemmA; C or hemmC";
 
-const char* MethodTrsm_help   = "auto; A or trsmA; B or trsmB";
+const char* MethodTrsm_help   = "auto; A or trsmA; B or trsmB; Inv or trsmInv";
 
 const char* MethodLU_help     = "auto; PPLU or PartialPiv; CALU; NoPiv; RBT; BEAM";
 
 const char* MethodEig_help    = "auto; QR (QR iteration); DC (divide & conquer); "
-                                "bisection; MRRR";
+                                "bisection; MRRR; QDWH (spectral divide & conquer)";
 
 const char* MethodSVD_help    = "auto; QR (QR iteration); DC (divide & conquer); "
-                                "bisection";
+                                "bisection; QDWH (polar decomposition)";
+
+const char* BcastPrecision_help = "native; single or fp32; bf16 or bfloat16; half or fp16";
+
+const char* TaskRuntime_help  = "openmp or omp; ws or workstealing";
+
+const char* QueuePriority_help = "uniform; lookahead";
+
+const char* ComputePrecision_help = "native; tf32 or xf32; 3m";
+
+const char* GramPrecision_help = "native; single or fp32";
+
+const char* Compression_help  = "none; lossless; error-bounded or lossy";
 
 const char* NormScope_help    = "m or matrix; c, cols, or columns; r or rows";
 
@@ -38,6 +50,6 @@ const char* Origin_help       = "d, dev, or devices; h or host; "
                                 "s, scalpk, or scalapack";
 
 const char* Target_help       = "d, dev, or devices; h or host; t or task; "
-                                "n or nest; b or batch";
+                                "n or nest; b or batch; y or hybrid";
 
 } // namespace slate
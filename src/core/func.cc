@@ -0,0 +1,207 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/func.hh"
+#include "slate/Exception.hh"
+#include "internal/internal_cost.hh"
+
+#include <blas.hh>
+
+#include <omp.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <numeric>
+
+namespace slate {
+namespace func {
+
+//------------------------------------------------------------------------------
+/// @see device_gemm_rates in func.hh.
+///
+std::vector<double> device_gemm_rates(int64_t nb, int repeat)
+{
+    slate_assert( nb >= 1 );
+    slate_assert( repeat >= 1 );
+
+    int num_devices = blas::get_device_count();
+    std::vector<double> rates( num_devices, 0.0 );
+    for (int device = 0; device < num_devices; ++device) {
+        blas::Queue queue( device );
+        int64_t size = nb*nb;
+        double* A = blas::device_malloc<double>( 3*size, queue );
+        double* B = A + size;
+        double* C = B + size;
+        blas::device_memset( A, 0, 3*size, queue );
+
+        // Warm up, then time repeat gemms.
+        blas::gemm( blas::Layout::ColMajor, blas::Op::NoTrans, blas::Op::NoTrans,
+                    nb, nb, nb, 1.0, A, nb, B, nb, 0.0, C, nb, queue );
+        queue.sync();
+        double time = omp_get_wtime();
+        for (int r = 0; r < repeat; ++r) {
+            blas::gemm( blas::Layout::ColMajor, blas::Op::NoTrans, blas::Op::NoTrans,
+                        nb, nb, nb, 1.0, A, nb, B, nb, 1.0, C, nb, queue );
+        }
+        queue.sync();
+        time = omp_get_wtime() - time;
+
+        blas::device_free( A, queue );
+        double gflop = 2e-9 * nb * nb * nb * repeat;
+        rates[ device ] = gflop / std::max( time, 1e-9 );
+    }
+    return rates;
+}
+
+namespace {
+
+//------------------------------------------------------------------------------
+/// Cost of one word and one message received in a broadcast.
+struct LinkCost {
+    double word;
+    double message;
+};
+
+} // anonymous namespace
+
+//------------------------------------------------------------------------------
+/// @see topology_grid in func.hh.
+///
+std::function<int(ij_tuple)> topology_grid(
+    std::string const& routine, int64_t m, int64_t n, int64_t nb,
+    std::vector<int> const& nodes,
+    GridOrder* order, int* p, int* q)
+{
+    slate_assert( ! nodes.empty() );
+    slate_assert( nb >= 1 );
+
+    static const LinkCost network = {
+        8 / (internal::env_rate( "SLATE_NETWORK_GBPS", 10 ) * 1e9),
+        internal::env_rate( "SLATE_NETWORK_LATENCY_US", 2 ) * 1e-6 };
+    static const LinkCost node = {
+        8 / (internal::env_rate( "SLATE_NODE_GBPS", 40 ) * 1e9),
+        internal::env_rate( "SLATE_NODE_LATENCY_US", 0.5 ) * 1e-6 };
+
+    int nranks = nodes.size();
+    int64_t mt = std::max( (m + nb - 1) / nb, int64_t( 1 ) );
+    int64_t nt = std::max( (n + nb - 1) / nb, int64_t( 1 ) );
+    bool panel_reduce = routine == "getrf" || routine == "gesv"
+                        || routine == "geqrf" || routine == "gels";
+
+    // Grid position k is rank perm[ k ], filling nodes in order of their
+    // first rank.
+    std::map<int, int> first;
+    for (int r = 0; r < nranks; ++r)
+        first.emplace( nodes[ r ], r );
+    std::vector<int> perm( nranks );
+    std::iota( perm.begin(), perm.end(), 0 );
+    std::stable_sort( perm.begin(), perm.end(), [&]( int a, int b ) {
+        return first[ nodes[ a ] ] < first[ nodes[ b ] ];
+    });
+
+    // Prefer grids without idle process rows or columns, then the cheapest;
+    // ties go to Col and the squarest grid found first.
+    bool best_fits = false;
+    double best_cost = std::numeric_limits<double>::infinity();
+    *order = GridOrder::Col;
+    *p = nranks;
+    *q = 1;
+    for (int pp = int( std::sqrt( nranks ) ); pp >= 1; --pp) {
+        if (nranks % pp != 0)
+            continue;
+        int qq = nranks / pp;
+        for (auto shape : { std::make_pair( pp, qq ), std::make_pair( qq, pp ) }) {
+            int gp = shape.first;
+            int gq = shape.second;
+            for (GridOrder go : { GridOrder::Col, GridOrder::Row }) {
+                auto position = [&]( int prow, int pcol ) {
+                    return go == GridOrder::Col ? prow + pcol*gp
+                                                : prow*gq + pcol;
+                };
+                // Whether each process row, resp. column, is within a node.
+                bool rows_in_node = true, cols_in_node = true;
+                for (int prow = 0; prow < gp; ++prow) {
+                    for (int pcol = 0; pcol < gq; ++pcol) {
+                        int node_ij = nodes[ perm[ position( prow, pcol ) ] ];
+                        if (node_ij != nodes[ perm[ position( prow, 0 ) ] ])
+                            rows_in_node = false;
+                        if (node_ij != nodes[ perm[ position( 0, pcol ) ] ])
+                            cols_in_node = false;
+                    }
+                }
+                LinkCost const& row = rows_in_node ? node : network;
+                LinkCost const& col = cols_in_node ? node : network;
+
+                // Per step: the panel along process rows, the top row
+                // along process columns, and the panel's reductions.
+                double tiles_row = double( mt ) / gp;
+                double tiles_col = double( nt ) / gq;
+                double cost = tiles_row * (row.message + row.word * nb*nb)
+                            + tiles_col * (col.message + col.word * nb*nb);
+                if (panel_reduce && gp > 1)
+                    cost += nb * std::ceil( std::log2( gp ) ) * col.message;
+
+                bool fits = gp <= mt && gq <= nt;
+                if ((fits && ! best_fits)
+                    || (fits == best_fits && cost < best_cost)) {
+                    best_fits = fits;
+                    best_cost = cost;
+                    *order = go;
+                    *p = gp;
+                    *q = gq;
+                }
+            }
+        }
+    }
+
+    auto grid = process_2d_grid( *order, *p, *q );
+    bool identity = true;
+    for (int k = 0; k < nranks; ++k) {
+        if (perm[ k ] != k)
+            identity = false;
+    }
+    if (identity)
+        return grid;
+    return [grid, perm]( ij_tuple ij ) {
+        return perm[ grid( ij ) ];
+    };
+}
+
+//------------------------------------------------------------------------------
+/// @see topology_grid in func.hh.
+///
+std::function<int(ij_tuple)> topology_grid(
+    std::string const& routine, int64_t m, int64_t n, int64_t nb,
+    MPI_Comm mpi_comm,
+    GridOrder* order, int* p, int* q)
+{
+    int mpi_size, mpi_rank;
+    slate_mpi_call(
+        MPI_Comm_size( mpi_comm, &mpi_size ));
+    slate_mpi_call(
+        MPI_Comm_rank( mpi_comm, &mpi_rank ));
+
+    // Identify each node by its lowest rank.
+    MPI_Comm node_comm;
+    int node;
+    std::vector<int> nodes( mpi_size );
+    slate_mpi_call(
+        MPI_Comm_split_type( mpi_comm, MPI_COMM_TYPE_SHARED, mpi_rank,
+                             MPI_INFO_NULL, &node_comm ));
+    slate_mpi_call(
+        MPI_Allreduce( &mpi_rank, &node, 1, MPI_INT, MPI_MIN, node_comm ));
+    slate_mpi_call(
+        MPI_Comm_free( &node_comm ));
+    slate_mpi_call(
+        MPI_Allgather( &node, 1, MPI_INT, nodes.data(), 1, MPI_INT,
+                       mpi_comm ));
+
+    return topology_grid( routine, m, n, nb, nodes, order, p, q );
+}
+
+} // namespace func
+} // namespace slate
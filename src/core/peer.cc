@@ -0,0 +1,279 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/internal/peer.hh"
+#include "slate/enums.hh"
+#include "slate/Exception.hh"
+
+#if defined( BLAS_HAVE_CUBLAS )
+    #include <cuda_runtime.h>
+#elif defined( BLAS_HAVE_ROCBLAS )
+    #include <hip/hip_runtime.h>
+#endif
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <string>
+
+namespace slate {
+namespace internal {
+
+namespace {
+
+//------------------------------------------------------------------------------
+// Peer access, wrapping CUDA or HIP.
+#if defined( BLAS_HAVE_CUBLAS )
+    #define SLATE_PEER_ACCESS
+
+    using device_error_t = cudaError_t;
+
+    const device_error_t device_success = cudaSuccess;
+
+    device_error_t device_get( int* device ) { return cudaGetDevice( device ); }
+
+    device_error_t device_set( int device ) { return cudaSetDevice( device ); }
+
+    bool device_can_access_peer( int device, int peer )
+    {
+        int can = 0;
+        return cudaDeviceCanAccessPeer( &can, device, peer ) == cudaSuccess
+               && can;
+    }
+
+    /// Enables device to access peer's memory; true if access is enabled.
+    bool device_enable_peer( int device, int peer )
+    {
+        if (cudaSetDevice( device ) != cudaSuccess)
+            return false;
+        cudaError_t err = cudaDeviceEnablePeerAccess( peer, 0 );
+        if (err == cudaErrorPeerAccessAlreadyEnabled) {
+            cudaGetLastError();  // clear the error
+            return true;
+        }
+        return err == cudaSuccess;
+    }
+
+    int device_peer_rank( int src_device, int dst_device )
+    {
+        int rank = 0;
+        cudaDeviceGetP2PAttribute( &rank, cudaDevP2PAttrPerformanceRank,
+                                   src_device, dst_device );
+        return rank;
+    }
+
+    device_error_t device_memcpy_peer(
+        void* dst, int dst_device, void const* src, int src_device,
+        size_t bytes, blas::Queue& queue )
+    {
+        return cudaMemcpyPeerAsync( dst, dst_device, src, src_device,
+                                    bytes, queue.stream() );
+    }
+
+    char const* device_error_string( device_error_t err )
+    {
+        return cudaGetErrorString( err );
+    }
+
+#elif defined( BLAS_HAVE_ROCBLAS )
+    #define SLATE_PEER_ACCESS
+
+    using device_error_t = hipError_t;
+
+    const device_error_t device_success = hipSuccess;
+
+    device_error_t device_get( int* device ) { return hipGetDevice( device ); }
+
+    device_error_t device_set( int device ) { return hipSetDevice( device ); }
+
+    bool device_can_access_peer( int device, int peer )
+    {
+        int can = 0;
+        return hipDeviceCanAccessPeer( &can, device, peer ) == hipSuccess
+               && can;
+    }
+
+    /// Enables device to access peer's memory; true if access is enabled.
+    bool device_enable_peer( int device, int peer )
+    {
+        if (hipSetDevice( device ) != hipSuccess)
+            return false;
+        hipError_t err = hipDeviceEnablePeerAccess( peer, 0 );
+        if (err == hipErrorPeerAccessAlreadyEnabled) {
+            hipGetLastError();  // clear the error
+            return true;
+        }
+        return err == hipSuccess;
+    }
+
+    int device_peer_rank( int src_device, int dst_device )
+    {
+        int rank = 0;
+        hipDeviceGetP2PAttribute( &rank, hipDevP2PAttrPerformanceRank,
+                                  src_device, dst_device );
+        return rank;
+    }
+
+    device_error_t device_memcpy_peer(
+        void* dst, int dst_device, void const* src, int src_device,
+        size_t bytes, blas::Queue& queue )
+    {
+        return hipMemcpyPeerAsync( dst, dst_device, src, src_device,
+                                   bytes, queue.stream() );
+    }
+
+    char const* device_error_string( device_error_t err )
+    {
+        return hipGetErrorString( err );
+    }
+#endif
+
+std::once_flag once_;
+
+int num_devices_ = 0;
+
+/// peer_[ src + dst*num_devices_ ]: whether dst can access src's memory.
+std::vector<char> peer_;
+
+/// sources_[ dst + 1 ]: devices to copy a tile from, nearest first.
+std::vector< std::vector<int> > sources_;
+
+//------------------------------------------------------------------------------
+/// Enables peer access and builds the topology table. Called once.
+///
+void peer_init_once()
+{
+    num_devices_ = blas::get_device_count();
+    peer_.assign( num_devices_ * num_devices_, false );
+
+    // $SLATE_PEER_ACCESS=0 disables peer access, e.g., to debug, or on
+    // systems where it is slower than going through the host.
+    const char* env = std::getenv( "SLATE_PEER_ACCESS" );
+    bool enable = env == nullptr || std::strcmp( env, "0" ) != 0;
+
+    // Performance rank of each peer link; lower is faster.
+    std::vector<int> rank( num_devices_ * num_devices_, 0 );
+
+    #if defined( SLATE_PEER_ACCESS )
+        if (enable && num_devices_ > 1) {
+            int orig_device;
+            if (device_get( &orig_device ) != device_success)
+                orig_device = 0;
+            for (int dst = 0; dst < num_devices_; ++dst) {
+                for (int src = 0; src < num_devices_; ++src) {
+                    if (src != dst && device_can_access_peer( dst, src )) {
+                        peer_[ src + dst*num_devices_ ]
+                            = device_enable_peer( dst, src );
+                        rank[ src + dst*num_devices_ ]
+                            = device_peer_rank( src, dst );
+                    }
+                }
+            }
+            device_set( orig_device );
+        }
+    #else
+        (void) enable;
+    #endif
+
+    // Sources for the host: any device, highest first, as before.
+    // Sources for a device: its peers, fastest link first, then the host,
+    // then devices without peer access, whose copies go through the host.
+    sources_.resize( num_devices_ + 1 );
+    for (int d = num_devices_-1; d >= 0; --d)
+        sources_[ 0 ].push_back( d );
+
+    for (int dst = 0; dst < num_devices_; ++dst) {
+        std::vector<int>& order = sources_[ dst + 1 ];
+        std::vector<int> peers, others;
+        for (int src = num_devices_-1; src >= 0; --src) {
+            if (src == dst)
+                continue;
+            if (peer_[ src + dst*num_devices_ ])
+                peers.push_back( src );
+            else
+                others.push_back( src );
+        }
+        std::stable_sort( peers.begin(), peers.end(),
+            [&]( int a, int b ) {
+                return rank[ a + dst*num_devices_ ]
+                       < rank[ b + dst*num_devices_ ];
+            } );
+        order = peers;
+        order.push_back( HostNum );
+        order.insert( order.end(), others.begin(), others.end() );
+    }
+}
+
+} // anonymous namespace
+
+//------------------------------------------------------------------------------
+/// [internal]
+/// Enables peer access between every pair of devices that supports it,
+/// and records which source is nearest to each device.
+/// Called by MatrixStorage; does the work only on the first call.
+/// Setting $SLATE_PEER_ACCESS=0 leaves peer access disabled.
+///
+void peer_init()
+{
+    std::call_once( once_, peer_init_once );
+}
+
+//------------------------------------------------------------------------------
+/// [internal]
+/// @return true if dst_device can access src_device's memory directly.
+///
+bool peer_access( int src_device, int dst_device )
+{
+    peer_init();
+    if (src_device < 0 || src_device >= num_devices_
+        || dst_device < 0 || dst_device >= num_devices_)
+        return false;
+    return peer_[ src_device + dst_device*num_devices_ ];
+}
+
+//------------------------------------------------------------------------------
+/// [internal]
+/// @return devices to copy a tile from to dst_device, nearest first,
+/// including HostNum and excluding dst_device.
+/// For the host, this is every device; for a device, it is its peers
+/// ordered by link performance rank, then the host, then the other devices.
+///
+std::vector<int> const& peer_source_order( int dst_device )
+{
+    peer_init();
+    return sources_.at( dst_device + 1 );
+}
+
+//------------------------------------------------------------------------------
+/// [internal]
+/// Copies bytes from src on src_device to dst on dst_device,
+/// asynchronously on queue. With peer access, the copy goes directly
+/// between the devices; otherwise the runtime stages it through the host.
+///
+void peer_memcpy( void* dst, int dst_device,
+                  void const* src, int src_device,
+                  size_t bytes, blas::Queue& queue )
+{
+    #if defined( SLATE_PEER_ACCESS )
+        if (bytes == 0)
+            return;
+        device_error_t err = device_memcpy_peer(
+            dst, dst_device, src, src_device, bytes, queue );
+        if (err != device_success)
+            throw slate::Exception(
+                std::string( "SLATE peer copy ERROR: " )
+                + device_error_string( err ),
+                __func__, __FILE__, __LINE__ );
+    #else
+        (void) dst_device;
+        (void) src_device;
+        blas::device_memcpy<char>( (char*) dst, (char const*) src,
+                                   bytes, queue );
+    #endif
+}
+
+} // namespace internal
+} // namespace slate
@@ -0,0 +1,299 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/internal/queue.hh"
+#include "slate/Exception.hh"
+
+#if defined( BLAS_HAVE_CUBLAS )
+    #include <cuda_runtime.h>
+#elif defined( BLAS_HAVE_ROCBLAS )
+    #include <hip/hip_runtime.h>
+#endif
+
+#include <complex>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+
+namespace slate {
+namespace internal {
+
+namespace {
+
+//------------------------------------------------------------------------------
+// Streams, wrapping CUDA or HIP.
+#if defined( BLAS_HAVE_CUBLAS )
+    #define SLATE_STREAM_PRIORITY
+
+    using device_error_t = cudaError_t;
+    using stream_t       = cudaStream_t;
+
+    const device_error_t device_success = cudaSuccess;
+
+    char const* device_error_string( device_error_t err )
+    {
+        return cudaGetErrorString( err );
+    }
+
+    device_error_t device_set( int device ) { return cudaSetDevice( device ); }
+
+    device_error_t device_priority_range( int* least, int* greatest )
+    {
+        return cudaDeviceGetStreamPriorityRange( least, greatest );
+    }
+
+    device_error_t device_stream_create( stream_t* stream, int priority )
+    {
+        return cudaStreamCreateWithPriority( stream, cudaStreamDefault,
+                                             priority );
+    }
+
+    void device_stream_destroy( stream_t stream ) { cudaStreamDestroy( stream ); }
+
+#elif defined( BLAS_HAVE_ROCBLAS )
+    #define SLATE_STREAM_PRIORITY
+
+    using device_error_t = hipError_t;
+    using stream_t       = hipStream_t;
+
+    const device_error_t device_success = hipSuccess;
+
+    char const* device_error_string( device_error_t err )
+    {
+        return hipGetErrorString( err );
+    }
+
+    device_error_t device_set( int device ) { return hipSetDevice( device ); }
+
+    device_error_t device_priority_range( int* least, int* greatest )
+    {
+        return hipDeviceGetStreamPriorityRange( least, greatest );
+    }
+
+    device_error_t device_stream_create( stream_t* stream, int priority )
+    {
+        return hipStreamCreateWithPriority( stream, hipStreamDefault,
+                                            priority );
+    }
+
+    void device_stream_destroy( stream_t stream ) { hipStreamDestroy( stream ); }
+#endif
+
+#if defined( SLATE_STREAM_PRIORITY )
+
+#define slate_stream_call( call ) \
+    do { \
+        device_error_t slate_stream_call_ = call; \
+        if (slate_stream_call_ != device_success) \
+            throw slate::Exception( \
+                std::string( "SLATE device stream ERROR: " ) + #call \
+                + " failed: " + device_error_string( slate_stream_call_ ), \
+                __func__, __FILE__, __LINE__ ); \
+    } while (0)
+
+std::mutex mutex_;
+
+/// Streams created for high priority queues, which the queues don't own.
+std::map< lapack::Queue*, stream_t > streams_;
+
+#endif
+
+} // anonymous namespace
+
+//------------------------------------------------------------------------------
+/// [internal]
+/// Creates a queue on device. If high_priority and the device supports
+/// stream priorities, the queue's stream has the device's greatest
+/// priority; otherwise it is a default queue.
+///
+lapack::Queue* new_queue( int device, bool high_priority )
+{
+    #if defined( SLATE_STREAM_PRIORITY )
+        if (high_priority) {
+            int least, greatest;
+            slate_stream_call( device_set( device ) );
+            slate_stream_call( device_priority_range( &least, &greatest ) );
+            if (greatest != least) {
+                stream_t stream;
+                slate_stream_call( device_stream_create( &stream, greatest ) );
+                lapack::Queue* queue = new lapack::Queue( device, stream );
+                std::lock_guard<std::mutex> guard( mutex_ );
+                streams_[ queue ] = stream;
+                return queue;
+            }
+        }
+    #endif
+    return new lapack::Queue( device );
+}
+
+//------------------------------------------------------------------------------
+/// [internal]
+/// Destroys a queue from new_queue, and its high priority stream, if any.
+/// Doesn't throw, as it is called from destructors.
+///
+void delete_queue( lapack::Queue* queue )
+{
+    if (queue == nullptr)
+        return;
+
+    #if defined( SLATE_STREAM_PRIORITY )
+        bool found = false;
+        stream_t stream{};
+        {
+            std::lock_guard<std::mutex> guard( mutex_ );
+            auto iter = streams_.find( queue );
+            if (iter != streams_.end()) {
+                found = true;
+                stream = iter->second;
+                streams_.erase( iter );
+            }
+        }
+        delete queue;
+        // The queue doesn't own the stream, so destroy it after the queue.
+        if (found)
+            device_stream_destroy( stream );
+    #else
+        delete queue;
+    #endif
+}
+
+//------------------------------------------------------------------------------
+/// [internal]
+/// Sets the math mode of the queue's BLAS handle. With TF32, cuBLAS
+/// single precision routines may use TF32 tensor cores
+/// (CUBLAS_TF32_TENSOR_OP_MATH), and rocBLAS uses xf32 on devices that
+/// have it (rocblas_xf32_xdl_math_op). Native restores the default mode,
+/// as does Complex3M, which gemm selects per call with device_gemm3m.
+/// A no-op without devices, or with a rocBLAS too old to have math modes.
+/// Call only when no work is pending on the queue.
+///
+void set_compute_precision( lapack::Queue* queue, ComputePrecision precision )
+{
+    if (queue == nullptr)
+        return;
+
+    #if defined( BLAS_HAVE_CUBLAS )
+        cublasMath_t mode = precision == ComputePrecision::TF32
+                          ? CUBLAS_TF32_TENSOR_OP_MATH
+                          : CUBLAS_DEFAULT_MATH;
+        cublasStatus_t status = cublasSetMathMode( queue->handle(), mode );
+        if (status != CUBLAS_STATUS_SUCCESS)
+            throw slate::Exception( "cublasSetMathMode failed",
+                                    __func__, __FILE__, __LINE__ );
+    #elif defined( BLAS_HAVE_ROCBLAS ) && defined( ROCBLAS_VERSION_MAJOR ) \
+          && ROCBLAS_VERSION_MAJOR >= 3
+        rocblas_math_mode mode = precision == ComputePrecision::TF32
+                               ? rocblas_xf32_xdl_math_op
+                               : rocblas_default_math;
+        rocblas_status status = rocblas_set_math_mode( queue->handle(), mode );
+        if (status != rocblas_status_success)
+            throw slate::Exception( "rocblas_set_math_mode failed",
+                                    __func__, __FILE__, __LINE__ );
+    #else
+        (void) precision;
+    #endif
+}
+
+#if defined( BLAS_HAVE_CUBLAS )
+//------------------------------------------------------------------------------
+/// @return cuBLAS operation for op.
+inline cublasOperation_t cublas_op( Op op )
+{
+    switch (op) {
+        case Op::NoTrans:   return CUBLAS_OP_N;
+        case Op::Trans:     return CUBLAS_OP_T;
+        case Op::ConjTrans: return CUBLAS_OP_C;
+    }
+    return CUBLAS_OP_N;
+}
+#endif
+
+//------------------------------------------------------------------------------
+/// [internal]
+/// @return true if device_gemm3m is available, i.e., with cuBLAS.
+/// rocBLAS has no 3M gemm.
+///
+bool device_gemm3m_available()
+{
+    #if defined( BLAS_HAVE_CUBLAS )
+        return true;
+    #else
+        return false;
+    #endif
+}
+
+//------------------------------------------------------------------------------
+/// [internal]
+/// Complex gemm, $C = \alpha op(A) op(B) + \beta C$, with the 3M
+/// algorithm of cuBLAS (cublasCgemm3m), on the queue.
+/// Throws if not device_gemm3m_available().
+///
+void device_gemm3m(
+    Layout layout, Op opA, Op opB,
+    int64_t m, int64_t n, int64_t k,
+    std::complex<float> alpha, std::complex<float> const* A, int64_t lda,
+                               std::complex<float> const* B, int64_t ldb,
+    std::complex<float> beta,  std::complex<float>* C, int64_t ldc,
+    lapack::Queue& queue )
+{
+    #if defined( BLAS_HAVE_CUBLAS )
+        // cuBLAS is column-major: row-major C^T = op(B)^T op(A)^T.
+        if (layout == Layout::RowMajor) {
+            std::swap( opA, opB );
+            std::swap( m, n );
+            std::swap( A, B );
+            std::swap( lda, ldb );
+        }
+        cublasStatus_t status = cublasCgemm3m(
+            queue.handle(), cublas_op( opA ), cublas_op( opB ),
+            int( m ), int( n ), int( k ),
+            (cuComplex*) &alpha, (cuComplex const*) A, int( lda ),
+                                 (cuComplex const*) B, int( ldb ),
+            (cuComplex*) &beta,  (cuComplex*) C, int( ldc ) );
+        if (status != CUBLAS_STATUS_SUCCESS)
+            throw slate::Exception( "cublasCgemm3m failed",
+                                    __func__, __FILE__, __LINE__ );
+    #else
+        slate_not_implemented( "device_gemm3m requires cuBLAS" );
+    #endif
+}
+
+//------------------------------------------------------------------------------
+/// [internal]
+/// Complex gemm with the 3M algorithm of cuBLAS (cublasZgemm3m).
+/// @see device_gemm3m
+///
+void device_gemm3m(
+    Layout layout, Op opA, Op opB,
+    int64_t m, int64_t n, int64_t k,
+    std::complex<double> alpha, std::complex<double> const* A, int64_t lda,
+                                std::complex<double> const* B, int64_t ldb,
+    std::complex<double> beta,  std::complex<double>* C, int64_t ldc,
+    lapack::Queue& queue )
+{
+    #if defined( BLAS_HAVE_CUBLAS )
+        if (layout == Layout::RowMajor) {
+            std::swap( opA, opB );
+            std::swap( m, n );
+            std::swap( A, B );
+            std::swap( lda, ldb );
+        }
+        cublasStatus_t status = cublasZgemm3m(
+            queue.handle(), cublas_op( opA ), cublas_op( opB ),
+            int( m ), int( n ), int( k ),
+            (cuDoubleComplex*) &alpha, (cuDoubleComplex const*) A, int( lda ),
+                                       (cuDoubleComplex const*) B, int( ldb ),
+            (cuDoubleComplex*) &beta,  (cuDoubleComplex*) C, int( ldc ) );
+        if (status != CUBLAS_STATUS_SUCCESS)
+            throw slate::Exception( "cublasZgemm3m failed",
+                                    __func__, __FILE__, __LINE__ );
+    #else
+        slate_not_implemented( "device_gemm3m requires cuBLAS" );
+    #endif
+}
+
+} // namespace internal
+} // namespace slate
@@ -105,7 +105,7 @@
 *     ..
 *     .. External Subroutines ..
       EXTERNAL           CLASR, CSWAP, SLAEV2, SLARTG, SLASCL, SSTERF,
-     $                   XERBLA
+     $                   SLATE_CLASR, XERBLA
 *     ..
 *     .. Intrinsic Functions ..
       INTRINSIC          ABS, MAX, SIGN, SQRT
@@ -399,7 +399,7 @@
 *        If eigenvectors are desired, then apply saved rotations.
 *
          MM = M - L + 1
-         CALL CLASR( 'R', 'V', 'B', NR, MM, WORK( L ), WORK( N-1+L ),
+         CALL SLATE_CLASR( 'B', NR, MM, WORK( L ), WORK( N-1+L ),
      $               Z( 1, L ), LDZ )
 *
          D( L ) = D( L ) - P
@@ -584,7 +584,7 @@
 *        If eigenvectors are desired, then apply saved rotations.
 *
          MM = L - M + 1
-         CALL CLASR( 'R', 'V', 'F', NR, MM, WORK( M ), WORK( N-1+M ),
+         CALL SLATE_CLASR( 'F', NR, MM, WORK( M ), WORK( N-1+M ),
      $               Z( 1, M ), LDZ )
 *
          D( L ) = D( L ) - P
@@ -84,6 +84,33 @@ __global__ void geadd_batch_kernel(
         beta,  Barray[ blockIdx.x ], ldb );
 }
 
+//------------------------------------------------------------------------------
+/// Kernel implementing element-wise tile addition with precision conversion
+/// of A, reading A once in its own precision.
+/// Each thread deals with one row.
+/// @copydoc geadd_batch
+template <typename src_scalar_t, typename dst_scalar_t>
+__global__ void geadd_mixed_batch_kernel(
+    int64_t m, int64_t n,
+    dst_scalar_t alpha, src_scalar_t const* const* Aarray, int64_t lda,
+    dst_scalar_t beta,  dst_scalar_t** Barray, int64_t ldb)
+{
+    src_scalar_t const* tileA = Aarray[ blockIdx.x ];
+    dst_scalar_t*       tileB = Barray[ blockIdx.x ];
+
+    // thread per row, if more rows than threads, loop by blockDim.x
+    for (int64_t i = threadIdx.x; i < m; i += blockDim.x) {
+        src_scalar_t const* rowA = &tileA[ i ];
+        dst_scalar_t*       rowB = &tileB[ i ];
+
+        for (int64_t j = 0; j < n; ++j) {
+            dst_scalar_t a;
+            copy( rowA[ j*lda ], a );
+            rowB[ j*ldb ] = alpha * a + beta * rowB[ j*ldb ];
+        }
+    }
+}
+
 //------------------------------------------------------------------------------
 /// Routine for element-wise tile addition.
 /// Sets
@@ -307,6 +334,103 @@ void geadd(
            batch_count, queue );
 }
 
+//------------------------------------------------------------------------------
+/// Batched routine for element-wise tile addition with precision conversion
+/// of A. Sets
+/// \[
+///     Barray[k] = \alpha Aarray[k] + \beta Barray[k],
+/// \]
+/// where Aarray[k] is in a lower precision than Barray[k]. This fuses the
+/// copy to high precision with the add, e.g., for the update
+/// X = X + X_lo of mixed-precision iterative refinement.
+///
+/// @param[in] m
+///     Number of rows of each tile. m >= 0.
+///
+/// @param[in] n
+///     Number of columns of each tile. n >= 0.
+///
+/// @param[in] alpha
+///     The scalar alpha.
+///
+/// @param[in] Aarray
+///     Array in GPU memory of dimension batch_count, containing pointers to tiles,
+///     where each Aarray[k] is an m-by-n matrix stored in an lda-by-n array in GPU memory.
+///
+/// @param[in] lda
+///     Leading dimension of each tile in A. lda >= m.
+///
+/// @param[in] beta
+///     The scalar beta.
+///
+/// @param[in,out] Barray
+///     Array in GPU memory of dimension batch_count, containing pointers to tiles,
+///     where each Barray[k] is an m-by-n matrix stored in an ldb-by-n array in GPU memory.
+///
+/// @param[in] ldb
+///     Leading dimension of each tile in B. ldb >= m.
+///
+/// @param[in] batch_count
+///     Size of Aarray and Barray. batch_count >= 0.
+///
+/// @param[in] queue
+///     BLAS++ queue to execute in.
+///
+template <typename src_scalar_t, typename dst_scalar_t>
+void geadd(
+    int64_t m, int64_t n,
+    dst_scalar_t const& alpha, src_scalar_t const* const* Aarray, int64_t lda,
+    dst_scalar_t const& beta, dst_scalar_t** Barray, int64_t ldb,
+    int64_t batch_count, blas::Queue &queue)
+{
+    // quick return
+    if (m == 0 || n == 0 || batch_count == 0)
+        return;
+
+    cudaSetDevice( queue.device() );
+
+    // Max threads/block=1024 for current CUDA compute capability (<= 7.5)
+    int64_t nthreads = std::min( int64_t( 1024 ), m );
+
+    geadd_mixed_batch_kernel<<<batch_count, nthreads, 0, queue.stream()>>>(
+        m, n,
+        alpha, Aarray, lda,
+        beta, Barray, ldb);
+
+    cudaError_t error = cudaGetLastError();
+    slate_assert(error == cudaSuccess);
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+// float => double
+template
+void geadd(
+    int64_t m, int64_t n,
+    double const& alpha, float const* const* Aarray, int64_t lda,
+    double const& beta, double** Barray, int64_t ldb,
+    int64_t batch_count, blas::Queue &queue);
+
+//------------------------------------------------------------------------------
+// Specialization to cast std::complex => cuComplex.
+// complex-float => complex-double
+template <>
+void geadd(
+    int64_t m, int64_t n,
+    std::complex<double> const& alpha,
+    std::complex<float> const* const* Aarray, int64_t lda,
+    std::complex<double> const& beta,
+    std::complex<double>** Barray, int64_t ldb,
+    int64_t batch_count, blas::Queue &queue)
+{
+    geadd( m, n,
+           make_cuDoubleComplex( real( alpha ), imag( alpha ) ),
+           (cuFloatComplex const* const*) Aarray, lda,
+           make_cuDoubleComplex( real( beta ), imag( beta ) ),
+           (cuDoubleComplex**) Barray, ldb,
+           batch_count, queue );
+}
+
 } // namespace batch
 } // namespace device
 } // namespace slate
@@ -0,0 +1,221 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/Exception.hh"
+#include "slate/internal/device.hh"
+
+#include "device_util.cuh"
+
+#include <algorithm>
+
+namespace slate {
+namespace device {
+
+// Threads per block of the rows kernel, one thread per row.
+const int geequ_vbatch_threads = 256;
+
+// Thread block of the columns kernel: geequ_vbatch_nx threads per column,
+// geequ_vbatch_ny columns at a time.
+const int geequ_vbatch_nx = 32;
+const int geequ_vbatch_ny = 8;
+
+//------------------------------------------------------------------------------
+/// Kernel for geequ_vbatch with RowCol::Row. Each thread block does tiles
+/// blockIdx.x, blockIdx.x + gridDim.x, ..., one thread per row, then
+/// updates the row maxima with atomics, as several tiles may share rows.
+/// @see geequ_vbatch
+///
+template <typename scalar_t>
+__global__ void geequ_vbatch_rows_kernel(
+    int64_t const* dims, scalar_t const* const* Aarray,
+    blas::real_type<scalar_t>* values, int64_t batch_count )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    for (int64_t b = blockIdx.x; b < batch_count; b += gridDim.x) {
+        int64_t m    = dims[ b ];
+        int64_t n    = dims[ b +   batch_count ];
+        int64_t lda  = dims[ b + 2*batch_count ];
+        int64_t ioff = dims[ b + 3*batch_count ];
+        scalar_t const* tile = Aarray[ b ];
+
+        for (int64_t i = threadIdx.x; i < m; i += blockDim.x) {
+            real_t max = 0;
+            for (int64_t j = 0; j < n; ++j)
+                max = max_nan( abs( tile[ i + j*lda ] ), max );
+            atomic_max_abs( &values[ ioff + i ], max );
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Kernel for geequ_vbatch with RowCol::Col. Each thread block does tiles
+/// blockIdx.x, blockIdx.x + gridDim.x, ..., geequ_vbatch_ny columns at a
+/// time, geequ_vbatch_nx threads per column, weighting row i by R[ i ],
+/// then updates the column maxima with atomics.
+/// @see geequ_vbatch
+///
+template <typename scalar_t>
+__global__ void geequ_vbatch_cols_kernel(
+    int64_t const* dims, scalar_t const* const* Aarray,
+    blas::real_type<scalar_t> const* R,
+    blas::real_type<scalar_t>* values, int64_t batch_count )
+{
+    using real_t = blas::real_type<scalar_t>;
+    const int nx = geequ_vbatch_nx;
+    const int ny = geequ_vbatch_ny;
+    __shared__ real_t s_max[ ny ][ nx+1 ];
+
+    int tx = threadIdx.x;
+    int ty = threadIdx.y;
+
+    for (int64_t b = blockIdx.x; b < batch_count; b += gridDim.x) {
+        int64_t m    = dims[ b ];
+        int64_t n    = dims[ b +   batch_count ];
+        int64_t lda  = dims[ b + 2*batch_count ];
+        int64_t ioff = dims[ b + 3*batch_count ];
+        int64_t joff = dims[ b + 4*batch_count ];
+        scalar_t const* tile = Aarray[ b ];
+        real_t const* Rb = &R[ ioff ];
+
+        // Uniform across the thread block, so __syncthreads is safe.
+        for (int64_t j0 = 0; j0 < n; j0 += ny) {
+            int64_t j = j0 + ty;
+            real_t max = 0;
+            if (j < n) {
+                for (int64_t i = tx; i < m; i += nx)
+                    max = max_nan( abs( tile[ i + j*lda ] ) * Rb[ i ], max );
+            }
+            s_max[ ty ][ tx ] = max;
+            __syncthreads();
+
+            if (tx == 0 && j < n) {
+                for (int k = 1; k < nx; ++k)
+                    max = max_nan( s_max[ ty ][ k ], max );
+                atomic_max_abs( &values[ joff + j ], max );
+            }
+            __syncthreads();
+        }
+    }
+}
+
+namespace batch {
+
+//------------------------------------------------------------------------------
+/// Variable-size batched row or column maxima for equilibration, reduced
+/// over all tiles on the device in one launch.
+///
+/// @param[in] rowcol
+///     - RowCol::Row: computes the max abs value of each row,
+///           values[ r_b + i ] = max( values[ r_b + i ],
+///                                    max_j abs( A_b(i, j) ) ).
+///     - RowCol::Col: computes the max abs value of each column of
+///       diag( R ) A,
+///           values[ c_b + j ] = max( values[ c_b + j ],
+///                                    max_i R[ r_b + i ] abs( A_b(i, j) ) ).
+///
+/// @param[in] dims
+///     Array in GPU memory of 5*batch_count int64_t: m_b, n_b, lda_b,
+///     row offset r_b, and column offset c_b, each batch_count entries
+///     long, so dims[ b + d*batch_count ] is dimension d of tile b.
+///
+/// @param[in] Aarray
+///     Array in GPU memory of batch_count pointers to the tiles A_b,
+///     where A_b is an m_b-by-n_b matrix stored in an lda_b-by-n_b array.
+///
+/// @param[in] R
+///     Array in GPU memory of the row scale factors, of dimension
+///     max_b( r_b + m_b ). Used by RowCol::Col only; may be null otherwise.
+///
+/// @param[in,out] values
+///     Array in GPU memory of the maxima, zero or previous maxima on entry.
+///
+/// @param[in] batch_count
+///     Number of tiles. batch_count >= 0.
+///
+/// @param[in] queue
+///     BLAS++ queue to execute in.
+///
+template <typename scalar_t>
+void geequ_vbatch(
+    RowCol rowcol, int64_t const* dims,
+    scalar_t const* const* Aarray,
+    blas::real_type<scalar_t> const* R,
+    blas::real_type<scalar_t>* values,
+    int64_t batch_count, blas::Queue& queue )
+{
+    // quick return
+    if (batch_count == 0)
+        return;
+
+    cudaSetDevice( queue.device() );
+
+    // Max grid dimension is large; the kernels loop over the rest.
+    int64_t blocks = std::min( batch_count, int64_t( 65535 ) );
+    if (rowcol == RowCol::Row) {
+        geequ_vbatch_rows_kernel
+            <<<blocks, geequ_vbatch_threads, 0, queue.stream()>>>
+            (dims, Aarray, values, batch_count);
+    }
+    else {
+        dim3 threads( geequ_vbatch_nx, geequ_vbatch_ny );
+        geequ_vbatch_cols_kernel
+            <<<blocks, threads, 0, queue.stream()>>>
+            (dims, Aarray, R, values, batch_count);
+    }
+
+    cudaError_t error = cudaGetLastError();
+    slate_assert( error == cudaSuccess );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void geequ_vbatch(
+    RowCol rowcol, int64_t const* dims,
+    float const* const* Aarray,
+    float const* R,
+    float* values,
+    int64_t batch_count, blas::Queue& queue );
+
+template
+void geequ_vbatch(
+    RowCol rowcol, int64_t const* dims,
+    double const* const* Aarray,
+    double const* R,
+    double* values,
+    int64_t batch_count, blas::Queue& queue );
+
+//------------------------------------------------------------------------------
+// Specializations to cast std::complex => cuComplex.
+template <>
+void geequ_vbatch(
+    RowCol rowcol, int64_t const* dims,
+    std::complex<float> const* const* Aarray,
+    float const* R,
+    float* values,
+    int64_t batch_count, blas::Queue& queue )
+{
+    geequ_vbatch( rowcol, dims,
+                  (cuFloatComplex const* const*) Aarray,
+                  R, values, batch_count, queue );
+}
+
+template <>
+void geequ_vbatch(
+    RowCol rowcol, int64_t const* dims,
+    std::complex<double> const* const* Aarray,
+    double const* R,
+    double* values,
+    int64_t batch_count, blas::Queue& queue )
+{
+    geequ_vbatch( rowcol, dims,
+                  (cuDoubleComplex const* const*) Aarray,
+                  R, values, batch_count, queue );
+}
+
+} // namespace batch
+} // namespace device
+} // namespace slate
@@ -0,0 +1,287 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/Exception.hh"
+#include "slate/internal/device.hh"
+
+#include "device_util.cuh"
+
+#include <cstdio>
+
+namespace slate {
+namespace device {
+
+//------------------------------------------------------------------------------
+/// Generates 128 pseudorandom bits using the Philox-2x64 generator,
+/// the same as slate::random::philox_2x64 on the host.
+/// Based on Salmon et al. "Parallel Random Numbers: As Easy as 1, 2, 3", 2011
+///
+__device__ inline void philox_2x64(
+    uint64_t& state0, uint64_t& state1, uint64_t seed )
+{
+    const uint64_t seed_inc = 0xD2B74407B1CE6E93ull;
+    const uint64_t multiplier = 0x9E3779B97F4A7C15ull;
+    const int rounds = 10;
+
+    for (int i = 0; i < rounds; ++i) {
+        if (i != 0) {
+            // bump seed
+            seed += seed_inc;
+        }
+
+        // Philox S-Box
+        uint64_t L = state0;
+        uint64_t R = state1;
+        state0 = R * multiplier;
+        state1 = __umul64hi( R, multiplier ) ^ seed ^ L;
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Makes a real number in [0, 1) from pseudorandom bits,
+/// the same as slate::random::rand_to_real on the host.
+template <typename real_t>
+__device__ inline real_t rand_to_real( uint64_t bits )
+{
+    const int digits = sizeof(real_t) == 4 ? 24 : 53;
+    return real_t( bits >> (64 - digits) ) / real_t( 1ull << digits );
+}
+
+//------------------------------------------------------------------------------
+/// Kernel generating random tile entries, as slate::random::generate.
+/// Each thread generates one entry of op(A); the grid is over rows in x
+/// and columns in y.
+/// A is stored as real_t, with 2 real_t per entry if is_complex.
+///
+/// @copydoc generate_random
+///
+template <typename real_t, bool is_complex, int dist>
+__global__ void generate_random_kernel(
+    int64_t seed,
+    int64_t m, int64_t n, int64_t ioffset, int64_t joffset,
+    real_t diag_value, real_t scale,
+    real_t* A, int64_t lda )
+{
+    // C++20 has std::numbers::pi_v<real_t>
+    const real_t pi = 3.1415926535897932385;
+    const int incr = is_complex ? 2 : 1;
+
+    int64_t i = blockIdx.x * int64_t( blockDim.x ) + threadIdx.x;
+    if (i >= m)
+        return;
+
+    for (int64_t j = blockIdx.y; j < n; j += gridDim.y) {
+        uint64_t state0 = i + ioffset;
+        uint64_t state1 = j + joffset;
+        philox_2x64( state0, state1, seed );
+        real_t raw_float1 = rand_to_real<real_t>( state0 );
+        real_t raw_float2 = rand_to_real<real_t>( state1 );
+
+        // See slate::random::generate_float for the distributions,
+        // in the same order.
+        real_t re = 0, im = 0;
+        if (dist == 1) {
+            // Uniform
+            re = raw_float1;
+            im = raw_float2;
+        }
+        else if (dist == 2) {
+            // UniformSigned
+            re = 2*raw_float1-1;
+            im = 2*raw_float2-1;
+        }
+        else if (dist == 3) {
+            // Normal, Box-Muller
+            real_t mag = sqrt( -2*log( 1-raw_float1 ) );
+            real_t arg = 2 * pi * raw_float2;
+            re = mag * cos( arg );
+            im = mag * sin( arg );
+        }
+        else if (dist == 4) {
+            // UnitDisk
+            real_t mag = sqrt( raw_float1 );
+            real_t arg = 2 * pi * raw_float2;
+            re = mag * cos( arg );
+            im = mag * sin( arg );
+        }
+        else if (dist == 5) {
+            // UnitCircle
+            real_t arg = 2 * pi * raw_float2;
+            re = cos( arg );
+            im = sin( arg );
+        }
+        else if (dist == 6) {
+            // Binary
+            re = raw_float1 >= 0.5 ? 1.0 : 0.0;
+            im = raw_float2 >= 0.5 ? 1.0 : 0.0;
+        }
+        else if (dist == 7) {
+            // BinarySigned
+            re = raw_float1 >= 0.5 ? 1.0 : -1.0;
+            im = raw_float2 >= 0.5 ? 1.0 : -1.0;
+        }
+
+        if (i == j && diag_value != 0)
+            re += diag_value;
+        if (scale != 1) {
+            re *= scale;
+            im *= scale;
+        }
+
+        real_t* Aij = &A[ (i + j*lda)*incr ];
+        Aij[ 0 ] = re;
+        if (is_complex)
+            Aij[ 1 ] = im;
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Launches generate_random_kernel for the distribution, given as a
+/// template parameter to avoid a switch in the kernel.
+template <typename real_t, bool is_complex>
+void generate_random_launch(
+    int64_t dist, int64_t seed,
+    int64_t m, int64_t n, int64_t ioffset, int64_t joffset,
+    real_t diag_value, real_t scale,
+    real_t* A, int64_t lda,
+    blas::Queue& queue )
+{
+    // quick return
+    if (m == 0 || n == 0)
+        return;
+
+    cudaSetDevice( queue.device() );
+
+    int64_t nthreads = std::min( int64_t( 256 ), m );
+    dim3 threads( nthreads );
+    dim3 blocks( (m + nthreads - 1) / nthreads,
+                 std::min( n, int64_t( 65535 ) ) );
+
+    #define SLATE_GENERATE_RANDOM_CASE( dist_ ) \
+        case dist_: \
+            generate_random_kernel<real_t, is_complex, dist_> \
+                <<<blocks, threads, 0, queue.stream()>>>( \
+                    seed, m, n, ioffset, joffset, \
+                    diag_value, scale, A, lda ); \
+            break;
+
+    switch (dist) {
+        SLATE_GENERATE_RANDOM_CASE( 1 )
+        SLATE_GENERATE_RANDOM_CASE( 2 )
+        SLATE_GENERATE_RANDOM_CASE( 3 )
+        SLATE_GENERATE_RANDOM_CASE( 4 )
+        SLATE_GENERATE_RANDOM_CASE( 5 )
+        SLATE_GENERATE_RANDOM_CASE( 6 )
+        SLATE_GENERATE_RANDOM_CASE( 7 )
+        default:
+            throw slate::Exception( "unknown distribution" );
+    }
+
+    #undef SLATE_GENERATE_RANDOM_CASE
+
+    cudaError_t error = cudaGetLastError();
+    slate_assert(error == cudaSuccess);
+}
+
+//------------------------------------------------------------------------------
+/// Generates an m-by-n tile with random entries on the device, the same,
+/// entry by entry, as slate::random::generate on the host: entry (i, j)
+/// is made from Philox-2x64 of the global index
+/// (i + ioffset, j + joffset) and the seed. Then diag_value is added to
+/// the diagonal entries of the tile, i == j, and the tile is scaled by
+/// scale.
+///
+/// The Uniform, UniformSigned, Binary, and BinarySigned distributions
+/// are bitwise identical to the host. Normal, UnitDisk, and UnitCircle use
+/// the device log, sqrt, sin, and cos, so they may differ from the host
+/// in the last bits.
+///
+/// @param[in] dist
+///     The distribution, as the value of slate::random::Dist:
+///     1: Uniform, 2: UniformSigned, 3: Normal, 4: UnitDisk,
+///     5: UnitCircle, 6: Binary, 7: BinarySigned.
+///
+/// @param[in] seed
+///     The value to seed the random number generator.
+///
+/// @param[in] m
+///     Number of rows of A. m >= 0.
+///
+/// @param[in] n
+///     Number of columns of A. n >= 0.
+///
+/// @param[in] ioffset
+///     The first row of A in the global matrix.
+///
+/// @param[in] joffset
+///     The first column of A in the global matrix.
+///
+/// @param[in] diag_value
+///     The value to add to the diagonal of A.
+///
+/// @param[in] scale
+///     The value to scale A by.
+///
+/// @param[out] A
+///     An m-by-n matrix stored in an lda-by-n array in GPU memory.
+///
+/// @param[in] lda
+///     Leading dimension of A. lda >= m.
+///
+/// @param[in] queue
+///     BLAS++ queue to execute in.
+///
+template <typename scalar_t>
+void generate_random(
+    int64_t dist, int64_t seed,
+    int64_t m, int64_t n, int64_t ioffset, int64_t joffset,
+    blas::real_type<scalar_t> diag_value, blas::real_type<scalar_t> scale,
+    scalar_t* A, int64_t lda,
+    blas::Queue& queue )
+{
+    using real_t = blas::real_type<scalar_t>;
+    const bool is_complex = blas::is_complex<scalar_t>::value;
+
+    generate_random_launch<real_t, is_complex>(
+        dist, seed, m, n, ioffset, joffset, diag_value, scale,
+        (real_t*) A, lda, queue );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void generate_random(
+    int64_t dist, int64_t seed,
+    int64_t m, int64_t n, int64_t ioffset, int64_t joffset,
+    float diag_value, float scale,
+    float* A, int64_t lda,
+    blas::Queue& queue );
+
+template
+void generate_random(
+    int64_t dist, int64_t seed,
+    int64_t m, int64_t n, int64_t ioffset, int64_t joffset,
+    double diag_value, double scale,
+    double* A, int64_t lda,
+    blas::Queue& queue );
+
+template
+void generate_random(
+    int64_t dist, int64_t seed,
+    int64_t m, int64_t n, int64_t ioffset, int64_t joffset,
+    float diag_value, float scale,
+    std::complex<float>* A, int64_t lda,
+    blas::Queue& queue );
+
+template
+void generate_random(
+    int64_t dist, int64_t seed,
+    int64_t m, int64_t n, int64_t ioffset, int64_t joffset,
+    double diag_value, double scale,
+    std::complex<double>* A, int64_t lda,
+    blas::Queue& queue );
+
+} // namespace device
+} // namespace slate
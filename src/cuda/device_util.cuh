@@ -55,6 +55,23 @@ void max_nan_reduce(int n, int tid, real_t* x)
     if (n >    1) { if (tid <    1 && tid +    1 < n) { x[tid] = max_nan(x[tid], x[tid+   1]); }  __syncthreads(); }
 }
 
+//------------------------------------------------------------------------------
+/// Sets *address = max( *address, value ) atomically, for value >= 0 or NaN.
+/// Non-negative floating point values order the same as their bits as
+/// integers, and a NaN with the sign bit cleared is above infinity, so
+/// NaN propagates as in max_nan.
+///
+__device__ inline void atomic_max_abs( float* address, float value )
+{
+    atomicMax( (int*) address, __float_as_int( fabsf( value ) ) );
+}
+
+__device__ inline void atomic_max_abs( double* address, double value )
+{
+    atomicMax( (unsigned long long*) address,
+               (unsigned long long) __double_as_longlong( fabs( value ) ) );
+}
+
 //------------------------------------------------------------------------------
 /// Sum reduction of n-element array x, leaving total in x[0].
 /// With k threads, can reduce array up to 2*k in size. Assumes number of
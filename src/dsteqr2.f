@@ -100,7 +100,7 @@
 *     ..
 *     .. External Subroutines ..
       EXTERNAL           DLAE2, DLAEV2, DLARTG, DLASCL, DLASR,
-     $                   DLASRT, DSWAP, XERBLA
+     $                   DLASRT, DSWAP, SLATE_DLASR, XERBLA
 *     ..
 *     .. Intrinsic Functions ..
       INTRINSIC          ABS, MAX, SIGN, SQRT
@@ -307,7 +307,7 @@
 *
          IF( ICOMPZ.GT.0 ) THEN
             MM = M - L + 1
-            CALL DLASR( 'R', 'V', 'B', NR, MM, WORK( L ), WORK( N-1+L ),
+            CALL SLATE_DLASR( 'B', NR, MM, WORK( L ), WORK( N-1+L ),
      $                  Z( 1, L ), LDZ )
          END IF
 *
@@ -414,7 +414,7 @@
 *
          IF( ICOMPZ.GT.0 ) THEN
             MM = L - M + 1
-            CALL DLASR( 'R', 'V', 'F', NR, MM, WORK( M ), WORK( N-1+M ),
+            CALL SLATE_DLASR( 'F', NR, MM, WORK( M ), WORK( N-1+M ),
      $                  Z( 1, M ), LDZ )
          END IF
 *
@@ -0,0 +1,142 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/slate.hh"
+#include "internal/internal.hh"
+
+namespace slate {
+
+namespace impl {
+
+//------------------------------------------------------------------------------
+/// @internal
+/// Distributed parallel fused element-wise operations.
+/// Generic implementation for any target.
+/// @ingroup add_impl
+///
+template <Target target, typename scalar_t>
+void elementwise(
+    std::vector< ElementwiseOp<scalar_t> >& ops,
+    Options const& opts )
+{
+    auto& B0 = ops[ 0 ].B;
+
+    if (target == Target::Devices) {
+        // Batch arrays o for operation o, of twice the local tiles.
+        B0.allocateBatchArrays( 0, ops.size() );
+        for (auto& op : ops)
+            op.B.reserveDeviceWorkspace();
+    }
+
+    bool hold_local_workspace = get_option<bool>(
+            opts, Option::HoldLocalWorkspace, 0 );
+
+    #pragma omp parallel
+    #pragma omp master
+    {
+        internal::elementwise<target>( ops );
+        #pragma omp taskwait
+        for (auto& op : ops)
+            op.B.tileUpdateAllOrigin();
+    }
+
+    if (hold_local_workspace == false) {
+        for (auto& op : ops) {
+            op.B.releaseWorkspace();
+            if (op.has_A)
+                op.A.releaseWorkspace();
+        }
+    }
+}
+
+} // namespace impl
+
+//------------------------------------------------------------------------------
+/// Distributed parallel fused element-wise operations.
+/// Performs, in order, for each operation op in ops,
+/// \[
+///     B = \alpha A + \beta B,
+/// \]
+/// or $B = \alpha A$ if $\beta = 0$, or $B = \beta B$ if op has no $A$,
+/// in one pass over the tiles: each rank fetches each local tile once,
+/// and applies all the operations to it. Used by Expression.
+///
+//------------------------------------------------------------------------------
+/// @tparam scalar_t
+///         One of float, double, std::complex<float>, std::complex<double>.
+//------------------------------------------------------------------------------
+/// @param[in,out] ops
+///         The operations. All matrices must have the same tiles, on the
+///         same ranks and devices. Transposition is not supported.
+///
+/// @param[in] opts
+///         Additional options, as map of name = value pairs. Possible options:
+///         - Option::Target:
+///           Implementation to target. Possible values:
+///           - HostTask:  OpenMP tasks on CPU host [default].
+///           - HostNest:  as HostTask.
+///           - HostBatch: as HostTask.
+///           - Devices:   batched kernels on GPU devices, queued in order,
+///             with one synchronization per device.
+///
+/// @ingroup add
+///
+template <typename scalar_t>
+void elementwise(
+    std::vector< ElementwiseOp<scalar_t> >& ops,
+    Options const& opts )
+{
+    if (ops.empty())
+        return;
+
+    for (auto& op : ops) {
+        slate_error_if( op.B.op() != Op::NoTrans );
+        slate_error_if( ! impl::elementwise_conforming( ops[ 0 ].B, op.B ) );
+        if (op.has_A) {
+            slate_error_if( op.A.op() != Op::NoTrans );
+            slate_error_if( ! impl::elementwise_conforming( ops[ 0 ].B, op.A ) );
+        }
+    }
+
+    Target target = get_target( opts, Target::HostTask );
+
+    switch (target) {
+        case Target::Host:
+        case Target::HostTask:
+        case Target::HostNest:
+        case Target::HostBatch:
+            impl::elementwise<Target::HostTask>( ops, opts );
+            break;
+
+        case Target::Devices:
+        case Target::Hybrid:
+            impl::elementwise<Target::Devices>( ops, opts );
+            break;
+    }
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void elementwise<float>(
+    std::vector< ElementwiseOp<float> >& ops,
+    Options const& opts);
+
+template
+void elementwise<double>(
+    std::vector< ElementwiseOp<double> >& ops,
+    Options const& opts);
+
+template
+void elementwise< std::complex<float> >(
+    std::vector< ElementwiseOp< std::complex<float> > >& ops,
+    Options const& opts);
+
+template
+void elementwise< std::complex<double> >(
+    std::vector< ElementwiseOp< std::complex<double> > >& ops,
+    Options const& opts);
+
+} // namespace slate
@@ -40,11 +40,14 @@ void gbmm(
     // todo: relax this assumption, by ?
     //       or pass as parameter
     const Layout layout = Layout::ColMajor;
+    // Block rows of C below the band are scaled on devices or on the host.
+    const Target target_scale = (target == Target::Devices ? Target::Devices
+                                                            : Target::HostTask);
 
     const scalar_t one = 1.0;
 
     // Options
-    int64_t lookahead = get_option<int64_t>( opts, Option::Lookahead, 1 );
+    int64_t lookahead = get_lookahead( opts );
 
     // OpenMP needs pointer types, but vectors are exception safe
     std::vector<uint8_t> bcast_vector(A.nt());
@@ -126,24 +129,11 @@ void gbmm(
                     beta,  C.sub(i_begin, i_end-1, 0, C.nt()-1),
                     layout );
 
-            if (beta != one) {
+            if (beta != one && i_end < C.mt()) {
                 // Scale block rows of C below the bandwidth of A:
                 // C(i_end : mt-1, :) = beta * C(i_end : mt-1, :)
-                // todo: make internal::scale routine. This is HostTask.
-                for (int64_t i = i_end; i < C.mt(); ++i) {
-                    for (int64_t j = 0; j < C.nt(); ++j) {
-                        if (C.tileIsLocal(i, j)) {
-                            #pragma omp task slate_omp_default_none \
-                                shared( C ) \
-                                firstprivate(i, j, layout, beta)
-                            {
-                                C.tileGetForWriting(i, j, LayoutConvert(layout));
-                                tile::scale( beta, C(i, j) );
-                            }
-                        }
-                    }
-                }
-                #pragma omp taskwait
+                internal::scale<target_scale>(
+                    beta, C.sub( i_end, C.mt()-1, 0, C.nt()-1 ) );
             }
         }
 
@@ -271,7 +261,7 @@ void gbmm(
     scalar_t beta,  Matrix<scalar_t>& C,
     Options const& opts )
 {
-    Target target = get_option( opts, Option::Target, Target::HostTask );
+    Target target = get_target( opts, Target::HostTask );
 
     switch (target) {
         case Target::Host:
@@ -288,6 +278,7 @@ void gbmm(
             break;
 
         case Target::Devices:
+        case Target::Hybrid:
             impl::gbmm<Target::Devices>( alpha, A, B, beta, C, opts );
             break;
     }
@@ -83,6 +83,10 @@ int64_t gbsv(
     slate_assert( A.mt() == A.nt() );  // square
     slate_assert( B.mt() == A.mt() );
 
+    // With Option::InfoRequest, info is only this rank's, so all ranks
+    // solve, without waiting for its reduction.
+    bool deferred = get_option<Option::InfoRequest>( opts, nullptr ) != nullptr;
+
     // factorization
     Timer t_gbtrf;
     int64_t info = gbtrf( A, pivots, opts );
@@ -90,7 +94,7 @@ int64_t gbsv(
 
     // solve
     Timer t_gbtrs;
-    if (info == 0) {
+    if (info == 0 || deferred) {
         gbtrs( A, pivots, B, opts );
     }
     timers[ "gbsv::gbtrs" ] = t_gbtrs.stop();
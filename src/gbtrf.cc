@@ -16,9 +16,12 @@ namespace impl {
 //------------------------------------------------------------------------------
 /// Distributed parallel band LU factorization.
 /// Generic implementation for any target.
-/// Panel and lookahead computed on host using Host OpenMP task.
+/// Panel computed on host using Host OpenMP task.
+/// For Target::Devices, the row swaps, trsm, and gemm updates inside the
+/// band run on the devices, which hold the band tiles in RowMajor layout
+/// (for efficient row swapping) until the end of the factorization.
 ///
-/// Warning: ColMajor layout is assumed
+/// Warning: ColMajor layout is assumed on entry
 ///
 template <Target target, typename scalar_t>
 int64_t gbtrf(
@@ -34,13 +37,17 @@ int64_t gbtrf(
     const int priority_0 = 0;
     const int priority_1 = 1;
     const int tag_0 = 0;
+    const int queue_1 = 1;
     // Assumes column major
     const Layout layout = Layout::ColMajor;
+    // GPU Devices use RowMajor for efficient row swapping.
+    const Layout target_layout = target == Target::Devices
+                               ? Layout::RowMajor : Layout::ColMajor;
 
     // Options
     real_t pivot_threshold
         = get_option<double>( opts, Option::PivotThreshold, 1.0 );
-    int64_t lookahead = get_option<int64_t>( opts, Option::Lookahead, 1 );
+    int64_t lookahead = get_lookahead( opts );
     int64_t ib = get_option<int64_t>( opts, Option::InnerBlocking, 16 );
     int64_t max_panel_threads  = std::max(omp_get_max_threads()/2, 1);
     max_panel_threads = get_option<int64_t>( opts, Option::MaxPanelThreads,
@@ -82,6 +89,16 @@ int64_t gbtrf(
         }
     }
 
+    if (target == Target::Devices) {
+        // Batch arrays and workspace are sized by the tiles inside the
+        // band, including the fill above. Lookahead columns use queues
+        // 2, ..., 1 + lookahead; the trailing update uses queue 1.
+        const int64_t batch_size_default = 0;
+        int num_queues = 2 + lookahead;
+        A.allocateBatchArrays( batch_size_default, num_queues );
+        A.reserveDeviceWorkspace();
+    }
+
     // set min number for omp nested active parallel regions
     slate::OmpSetMaxActiveLevels set_active_levels( MinOmpActiveLevels );
 
@@ -115,7 +132,7 @@ int64_t gbtrf(
                     // send A(i, k) across row A(i, k+1:nt-1)
                     bcast_list_A.push_back({i, k, {A.sub(i, i, k+1, j_end-1)}});
                 }
-                A.template listBcast(bcast_list_A, layout, tag_k);
+                A.template listBcast<target>(bcast_list_A, target_layout, tag_k);
 
                 // Root broadcasts the pivot to all ranks.
                 // todo: Panel ranks send the pivots to the right.
@@ -134,29 +151,31 @@ int64_t gbtrf(
                 {
                     // swap rows in A(k:mt-1, j)
                     int tag_j = j;
-                    internal::permuteRows<Target::HostTask>(
+                    int queue_jk1 = j-k+1;
+                    internal::permuteRows<target>(
                         Direction::Forward, A.sub(k, i_end-1, j, j), pivots.at(k),
-                        layout, priority_1, tag_j );
+                        target_layout, priority_1, tag_j, queue_jk1 );
 
                     auto Akk = A.sub(k, k, k, k);
                     auto Tkk =
                         TriangularMatrix<scalar_t>(Uplo::Lower, Diag::Unit, Akk);
 
                     // solve A(k, k) A(k, j) = A(k, j)
-                    internal::trsm<Target::HostTask>(
+                    internal::trsm<target>(
                         Side::Left,
                         one, std::move( Tkk ), A.sub(k, k, j, j),
-                        priority_1, layout );
+                        priority_1, target_layout, queue_jk1 );
 
                     // send A(k, j) across column A(k+1:mt-1, j)
+                    // todo: trsm still operates in ColMajor
                     A.tileBcast(k, j, A.sub(k+1, i_end-1, j, j), layout, tag_j);
 
                     // A(k+1:mt-1, j) -= A(k+1:mt-1, k) * A(k, j)
-                    internal::gemm<Target::HostTask>(
+                    internal::gemm<target>(
                         -one, A.sub(k+1, i_end-1, k, k),
                               A.sub(k, k, j, j),
                         one,  A.sub(k+1, i_end-1, j, j),
-                        layout, priority_1 );
+                        target_layout, priority_1, queue_jk1 );
                 }
             }
             // Update trailing submatrix, normal priority.
@@ -169,20 +188,20 @@ int64_t gbtrf(
                 {
                     // swap rows in A(k:mt-1, kl+1:nt-1)
                     int tag_kl1 = k+1+lookahead;
-                    internal::permuteRows<Target::HostTask>(
+                    internal::permuteRows<target>(
                         Direction::Forward, A.sub(k, i_end-1, k+1+lookahead, j_end-1),
-                        pivots.at(k), layout, priority_0, tag_kl1 );
+                        pivots.at(k), target_layout, priority_0, tag_kl1, queue_1 );
 
                     auto Akk = A.sub(k, k, k, k);
                     auto Tkk =
                         TriangularMatrix<scalar_t>(Uplo::Lower, Diag::Unit, Akk);
 
                     // solve A(k, k) A(k, kl+1:nt-1) = A(k, kl+1:nt-1)
-                    internal::trsm<Target::HostTask>(
+                    internal::trsm<target>(
                         Side::Left,
                         one, std::move( Tkk ),
                              A.sub(k, k, k+1+lookahead, j_end-1),
-                        priority_0, layout );
+                        priority_0, target_layout, queue_1 );
 
                     // send A(k, kl+1:j_end-1) across A(k+1:mt-1, kl+1:nt-1)
                     BcastList bcast_list_A;
@@ -190,14 +209,14 @@ int64_t gbtrf(
                         // send A(k, j) across column A(k+1:mt-1, j)
                         bcast_list_A.push_back({k, j, {A.sub(k+1, i_end-1, j, j)}});
                     }
-                    A.template listBcast(bcast_list_A, layout, tag_kl1);
+                    A.template listBcast<target>(bcast_list_A, target_layout, tag_kl1);
 
                     // A(k+1:mt-1, kl+1:nt-1) -= A(k+1:mt-1, k) * A(k, kl+1:nt-1)
-                    internal::gemm<Target::HostTask>(
+                    internal::gemm<target>(
                         -one, A.sub(k+1, i_end-1, k, k),
                               A.sub(k, k, k+1+lookahead, j_end-1),
                         one,  A.sub(k+1, i_end-1, k+1+lookahead, j_end-1),
-                        layout, priority_0 );
+                        target_layout, priority_0, queue_1 );
                 }
             }
 
@@ -222,7 +241,13 @@ int64_t gbtrf(
         }
 
         #pragma omp taskwait
-        A.tileUpdateAllOrigin();
+        if (target == Target::Devices) {
+            // Moves tiles back to their origin and converts them to ColMajor.
+            A.tileLayoutReset();
+        }
+        else {
+            A.tileUpdateAllOrigin();
+        }
     }
     // Band LU does NOT pivot to the left of the panel, since it would
     // introduce fill in the lower triangle. Instead, pivoting is done
@@ -230,7 +255,7 @@ int64_t gbtrf(
 
     A.releaseWorkspace();
 
-    internal::reduce_info( &info, A.mpiComm() );
+    internal::reduce_info( &info, A.mpiComm(), opts );
     return info;
 }
 
@@ -304,7 +329,7 @@ int64_t gbtrf(
     BandMatrix<scalar_t>& A, Pivots& pivots,
     Options const& opts )
 {
-    Target target = get_option( opts, Option::Target, Target::HostTask );
+    Target target = get_target( opts, Target::HostTask );
 
     switch (target) {
         case Target::Host:
@@ -318,6 +343,7 @@ int64_t gbtrf(
             return impl::gbtrf<Target::HostBatch>( A, pivots, opts );
 
         case Target::Devices:
+        case Target::Hybrid:
             return impl::gbtrf<Target::Devices>( A, pivots, opts );
     }
     return -3;  // shouldn't happen
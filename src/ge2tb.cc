@@ -36,6 +36,10 @@ void ge2tb(
     // Assumes column major
     const Layout layout = Layout::ColMajor;
     const int queue_0 = 0;
+    // Triangle-triangle QR reductions and updates run on devices or on
+    // the host.
+    const Target target_tt = (target == Target::Devices ? Target::Devices
+                                                         : Target::HostTask);
 
     // Options
     int64_t ib = get_option<int64_t>( opts, Option::InnerBlocking, 16 );
@@ -205,7 +209,7 @@ void ge2tb(
 
             // triangle-triangle reductions
             // ttqrt handles tile transfers internally
-            internal::ttqrt<Target::HostTask>(
+            internal::ttqrt<target_tt>(
                             std::move(U_panel),
                             std::move(TUr_panel) );
 
@@ -261,7 +265,7 @@ void ge2tb(
 
                 // Apply triangle-triangle reduction reflectors
                 // ttmqr handles the tile broadcasting internally
-                internal::ttmqr<Target::HostTask>(
+                internal::ttmqr<target_tt>(
                                 Side::Left, Op::ConjTrans,
                                 std::move(U_panel),
                                 std::move(TUr_panel),
@@ -314,12 +318,42 @@ void ge2tb(
                 // Instead of doing LQ of panel, we do QR of the transposed
                 // panel, so that the panel is computed in column-major for
                 // much better cache efficiency.
-                for (int64_t j = 0; j < V_panel.nt(); ++j) {
-                    if (V_panel.tileIsLocal(0, j)) {
-                        V_panel.tileGetForReading( 0, j, HostNum, LayoutConvert(layout) );
-                        VT_panel.tileInsert( j, 0 );
-                        VT_panel.tileModified( j, 0, HostNum );
-                        tile::deepConjTranspose( V_panel(0, j), VT_panel(j, 0) );
+                // With Devices, the trailing matrix stays on the devices:
+                // conj-transpose there, on the device that factors the
+                // panel, the device of its first local tile.
+                int VT_device = HostNum;
+                if (target == Target::Devices) {
+                    for (int64_t j = 0; j < V_panel.nt(); ++j) {
+                        if (V_panel.tileIsLocal(0, j)) {
+                            VT_device = VT_panel.tileDevice( j, 0 );
+                            break;
+                        }
+                    }
+                }
+                if (VT_device != HostNum) {
+                    blas::Queue* queue = A.compute_queue( VT_device, queue_0 );
+                    for (int64_t j = 0; j < V_panel.nt(); ++j) {
+                        if (V_panel.tileIsLocal(0, j)) {
+                            V_panel.tileGetForReading( 0, j, VT_device, LayoutConvert(layout) );
+                            VT_panel.tileInsert( j, 0, VT_device );
+                            VT_panel.tileModified( j, 0, VT_device );
+                            auto Vj  = V_panel( 0, j, VT_device );
+                            auto VTj = VT_panel( j, 0, VT_device );
+                            device::transpose( true, Vj.mb(), Vj.nb(),
+                                               Vj.data(), Vj.stride(),
+                                               VTj.data(), VTj.stride(), *queue );
+                        }
+                    }
+                    queue->sync();
+                }
+                else {
+                    for (int64_t j = 0; j < V_panel.nt(); ++j) {
+                        if (V_panel.tileIsLocal(0, j)) {
+                            V_panel.tileGetForReading( 0, j, HostNum, LayoutConvert(layout) );
+                            VT_panel.tileInsert( j, 0 );
+                            VT_panel.tileModified( j, 0, HostNum );
+                            tile::deepConjTranspose( V_panel(0, j), VT_panel(j, 0) );
+                        }
                     }
                 }
 
@@ -343,12 +377,33 @@ void ge2tb(
                 }
 
                 // Copy result back.
-                for (int64_t j = 0; j < V_panel.nt(); ++j) {
-                    if (V_panel.tileIsLocal(0, j)) {
-                        VT_panel.tileGetForReading( j, 0, HostNum, LayoutConvert(layout) );
-                        V_panel.tileGetForWriting( 0, j, HostNum, LayoutConvert(layout) );
-                        tile::deepConjTranspose( VT_panel(j, 0), V_panel(0, j) );
-                        VT_panel.tileErase(j, 0, AllDevices);
+                if (VT_device != HostNum) {
+                    blas::Queue* queue = A.compute_queue( VT_device, queue_0 );
+                    for (int64_t j = 0; j < V_panel.nt(); ++j) {
+                        if (V_panel.tileIsLocal(0, j)) {
+                            VT_panel.tileGetForReading( j, 0, VT_device, LayoutConvert(layout) );
+                            V_panel.tileGetForWriting( 0, j, VT_device, LayoutConvert(layout) );
+                            auto VTj = VT_panel( j, 0, VT_device );
+                            auto Vj  = V_panel( 0, j, VT_device );
+                            device::transpose( true, VTj.mb(), VTj.nb(),
+                                               VTj.data(), VTj.stride(),
+                                               Vj.data(), Vj.stride(), *queue );
+                        }
+                    }
+                    queue->sync();
+                    for (int64_t j = 0; j < V_panel.nt(); ++j) {
+                        if (V_panel.tileIsLocal(0, j))
+                            VT_panel.tileErase(j, 0, AllDevices);
+                    }
+                }
+                else {
+                    for (int64_t j = 0; j < V_panel.nt(); ++j) {
+                        if (V_panel.tileIsLocal(0, j)) {
+                            VT_panel.tileGetForReading( j, 0, HostNum, LayoutConvert(layout) );
+                            V_panel.tileGetForWriting( 0, j, HostNum, LayoutConvert(layout) );
+                            tile::deepConjTranspose( VT_panel(j, 0), V_panel(0, j) );
+                            VT_panel.tileErase(j, 0, AllDevices);
+                        }
                     }
                 }
                 //----------
@@ -530,7 +585,7 @@ void ge2tb(
     TriangularFactors<scalar_t>& TV,
     Options const& opts )
 {
-    Target target = get_option( opts, Option::Target, Target::HostTask );
+    Target target = get_target( opts, Target::HostTask );
 
     switch (target) {
         case Target::Host:
@@ -547,6 +602,7 @@ void ge2tb(
             break;
 
         case Target::Devices:
+        case Target::Hybrid:
             impl::ge2tb<Target::Devices>( A, TU, TV, opts );
             break;
     }
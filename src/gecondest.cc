@@ -40,6 +40,12 @@ namespace slate {
 ///
 /// @param[in] opts
 ///     Additional options, as map of name = value pairs. Possible options:
+///     - Option::EstimateColumns:
+///       Number of columns t of the block estimate of $\|A^{-1}\|$ of
+///       Higham and Tisseur, t >= 1. Each iteration solves with t columns,
+///       with the factors broadcast once for all iterations.
+///       t = 1 uses the estimate of LAPACK lacn2. Default 2.
+///
 ///     - Option::Target:
 ///       Implementation to target. Possible values:
 ///       - HostTask:  OpenMP tasks on CPU host [default].
@@ -93,54 +99,114 @@ blas::real_type<scalar_t> gecondest(
 
     std::vector<int64_t> isave = {0, 0, 0, 0};
 
+    int64_t t = get_option<int64_t>( opts, Option::EstimateColumns, 2 );
+    slate_assert( t >= 1 );
+    t = std::min( t, m );
+
     auto tileMb = A.tileMbFunc();
-    auto tileNb = func::uniform_blocksize(1, 1);
     auto tileRank = A.tileRankFunc();
     auto tileDevice = A.tileDeviceFunc();
-    slate::Matrix<scalar_t> X (m, 1, tileMb, tileNb,
-                               tileRank, tileDevice, A.mpiComm());
-    X.insertLocalTiles(Target::Host);
-    slate::Matrix<scalar_t> V (m, 1, tileMb, tileNb,
-                               tileRank, tileDevice, A.mpiComm());
-    V.insertLocalTiles(Target::Host);
-    slate::Matrix<int64_t> isgn (m, 1, tileMb, tileNb,
-                                 tileRank, tileDevice, A.mpiComm());
-    isgn.insertLocalTiles(Target::Host);
+
+    // Keep the estimator's vectors where the solves run.
+    Target target = get_target( opts, Target::HostTask );
 
     auto L  = TriangularMatrix<scalar_t>(
         Uplo::Lower, slate::Diag::Unit, A );
     auto U  = TriangularMatrix<scalar_t>(
         Uplo::Upper, slate::Diag::NonUnit, A );
-
-    // initial and final value of kase is 0
-    kase = 0;
-    internal::norm1est( X, V, isgn, &Ainvnorm, &kase, isave );
-
-    MPI_Bcast( &isave[0], 4, MPI_INT64_T, X.tileRank(0, 0), A.mpiComm() );
-    MPI_Bcast( &kase, 1, MPI_INT, X.tileRank(0, 0), A.mpiComm() );
-
-    while (kase != 0) {
-        if (kase == kase1) {
-            // Multiply by inv(L).
-            slate::trsm( Side::Left, alpha, L, X, opts );
-
-            // Multiply by inv(U).
-            slate::trsm( Side::Left, alpha, U, X, opts );
+    auto UH = conj_transpose( U );
+    auto LH = conj_transpose( L );
+
+    if (t > 1) {
+        // Block estimate, with t columns in each solve.
+        auto tileNb = func::uniform_blocksize( t, t );
+        auto tileNb1 = func::uniform_blocksize( 1, 1 );
+        slate::Matrix<scalar_t> X( m, t, tileMb, tileNb,
+                                   tileRank, tileDevice, A.mpiComm() );
+        X.insertLocalTiles( target );
+        slate::Matrix<scalar_t> S( m, t, tileMb, tileNb,
+                                   tileRank, tileDevice, A.mpiComm() );
+        S.insertLocalTiles( Target::Host );
+        slate::Matrix<scalar_t> V( m, 1, tileMb, tileNb1,
+                                   tileRank, tileDevice, A.mpiComm() );
+        V.insertLocalTiles( Target::Host );
+
+        // Broadcast the factors once for all solves, unless they are
+        // already on the ranks of X, e.g., from LUFactorization::rcond.
+        Options opts_est = opts;
+        bool resident = get_option<Option::FactorsResident>( opts, false );
+        if (! resident) {
+            impl::trsm_resident_bcast( L,  X, target );
+            impl::trsm_resident_bcast( U,  X, target );
+            impl::trsm_resident_bcast( UH, X, target );
+            impl::trsm_resident_bcast( LH, X, target );
+            opts_est[ Option::MethodTrsm ] = MethodTrsm::B;
+            opts_est[ Option::FactorsResident ] = true;
         }
-        else {
-            // Multiply by inv(U^H).
-            auto UH = conj_transpose( U );
-            slate::trsm( Side::Left, alpha, UH, X, opts );
-
-            // Multiply by inv(L^H).
-            auto LH = conj_transpose( L );
-            slate::trsm( Side::Left, alpha, LH, X, opts );
+
+        // initial and final value of kase is 0
+        kase = 0;
+        internal::norm1est_block( X, V, S, &Ainvnorm, &kase, isave );
+
+        while (kase != 0) {
+            if (kase == kase1) {
+                // Multiply by inv(L), then inv(U).
+                slate::trsm( Side::Left, alpha, L, X, opts_est );
+                slate::trsm( Side::Left, alpha, U, X, opts_est );
+            }
+            else {
+                // Multiply by inv(U^H), then inv(L^H).
+                slate::trsm( Side::Left, alpha, UH, X, opts_est );
+                slate::trsm( Side::Left, alpha, LH, X, opts_est );
+            }
+            internal::norm1est_block( X, V, S, &Ainvnorm, &kase, isave );
+        } // while (kase != 0)
+
+        if (! resident) {
+            A.releaseRemoteWorkspace();
+            A.releaseLocalWorkspace();
         }
+    }
+    else {
+        auto tileNb = func::uniform_blocksize(1, 1);
+        slate::Matrix<scalar_t> X (m, 1, tileMb, tileNb,
+                                   tileRank, tileDevice, A.mpiComm());
+        X.insertLocalTiles(target);
+        slate::Matrix<scalar_t> V (m, 1, tileMb, tileNb,
+                                   tileRank, tileDevice, A.mpiComm());
+        V.insertLocalTiles(target);
+        slate::Matrix<scalar_t> S (m, 1, tileMb, tileNb,
+                                   tileRank, tileDevice, A.mpiComm());
+        S.insertLocalTiles(target);
+
+        // initial and final value of kase is 0
+        kase = 0;
+        internal::norm1est( X, V, S, &Ainvnorm, &kase, isave );
 
-        internal::norm1est( X, V, isgn, &Ainvnorm, &kase, isave );
         MPI_Bcast( &isave[0], 4, MPI_INT64_T, X.tileRank(0, 0), A.mpiComm() );
         MPI_Bcast( &kase, 1, MPI_INT, X.tileRank(0, 0), A.mpiComm() );
-    } // while (kase != 0)
+
+        while (kase != 0) {
+            if (kase == kase1) {
+                // Multiply by inv(L).
+                slate::trsm( Side::Left, alpha, L, X, opts );
+
+                // Multiply by inv(U).
+                slate::trsm( Side::Left, alpha, U, X, opts );
+            }
+            else {
+                // Multiply by inv(U^H).
+                slate::trsm( Side::Left, alpha, UH, X, opts );
+
+                // Multiply by inv(L^H).
+                slate::trsm( Side::Left, alpha, LH, X, opts );
+            }
+
+            internal::norm1est( X, V, S, &Ainvnorm, &kase, isave );
+            MPI_Bcast( &isave[0], 4, MPI_INT64_T, X.tileRank(0, 0), A.mpiComm() );
+            MPI_Bcast( &kase, 1, MPI_INT, X.tileRank(0, 0), A.mpiComm() );
+        } // while (kase != 0)
+    }
 
     // Compute the estimate of the reciprocal condition number.
     if (Ainvnorm != 0.0) {
@@ -0,0 +1,264 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/slate.hh"
+#include "internal/internal.hh"
+#include "internal/internal_util.hh"
+#include "slate/internal/mpi.hh"
+
+#include <algorithm>
+#include <limits>
+
+namespace slate {
+
+namespace impl {
+
+//------------------------------------------------------------------------------
+/// @internal
+/// Max over all ranks of the local maxima, propagating NaN.
+///
+template <typename real_t>
+void allreduce_max(
+    std::vector<real_t>& local, std::vector<real_t>& values, MPI_Comm comm )
+{
+    using internal::mpi_max_nan;
+
+    MPI_Op op_max_nan;
+    {
+        internal::MpiGuard mpi_guard;
+        slate_mpi_call(
+            MPI_Op_create( mpi_max_nan, true, &op_max_nan ) );
+    }
+    {
+        internal::MpiGuard mpi_guard;
+        trace::Block trace_block("MPI_Allreduce");
+        slate_mpi_call(
+            MPI_Allreduce( local.data(), values.data(), local.size(),
+                           mpi_type<real_t>::value, op_max_nan, comm ) );
+    }
+    {
+        internal::MpiGuard mpi_guard;
+        slate_mpi_call(
+            MPI_Op_free( &op_max_nan ) );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// @internal
+/// Distributed parallel row and column scalings to equilibrate a general
+/// matrix, as LAPACK's geequ.
+/// Generic implementation for any target.
+/// @ingroup norm_impl
+///
+template <Target target, typename scalar_t>
+int64_t geequ(
+    Matrix<scalar_t>& A,
+    std::vector< blas::real_type<scalar_t> >& R,
+    std::vector< blas::real_type<scalar_t> >& C,
+    blas::real_type<scalar_t>& rowcnd,
+    blas::real_type<scalar_t>& colcnd,
+    blas::real_type<scalar_t>& amax,
+    Options const& opts )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // Constants
+    const real_t smlnum = std::numeric_limits<real_t>::min();
+    const real_t bignum = 1 / smlnum;
+
+    int64_t m = A.m();
+    int64_t n = A.n();
+    R.resize( m );
+    C.resize( n );
+    rowcnd = 1;
+    colcnd = 1;
+    amax = 0;
+
+    // Quick return
+    if (m == 0 || n == 0)
+        return 0;
+
+    if (target == Target::Devices) {
+        const int64_t batch_size_default = 0;
+        const int64_t num_queues = 1;
+        A.allocateBatchArrays( batch_size_default, num_queues );
+        A.reserveDeviceWorkspace();
+    }
+
+    int64_t info = 0;
+
+    // Row maxima, R_i = max_j |A_ij|.
+    std::vector<real_t> local( m );
+    #pragma omp parallel
+    #pragma omp master
+    {
+        internal::geequ<target>(
+            RowCol::Row, std::move( A ), nullptr, local.data() );
+    }
+    allreduce_max( local, R, A.mpiComm() );
+
+    auto rc = std::minmax_element( R.begin(), R.end() );
+    real_t rcmin = *rc.first;
+    real_t rcmax = *rc.second;
+    amax = rcmax;
+    if (rcmin == 0) {
+        // Row i is exactly zero, 1-based.
+        info = std::find( R.begin(), R.end(), real_t( 0 ) ) - R.begin() + 1;
+    }
+    else {
+        for (int64_t i = 0; i < m; ++i)
+            R[ i ] = 1 / std::min( std::max( R[ i ], smlnum ), bignum );
+        rowcnd = std::max( rcmin, smlnum ) / std::min( rcmax, bignum );
+
+        // Column maxima of the row-scaled matrix,
+        // C_j = max_i R_i |A_ij|, in one more pass over A.
+        local.resize( n );
+        #pragma omp parallel
+        #pragma omp master
+        {
+            internal::geequ<target>(
+                RowCol::Col, std::move( A ), R.data(), local.data() );
+        }
+        allreduce_max( local, C, A.mpiComm() );
+
+        rc = std::minmax_element( C.begin(), C.end() );
+        rcmin = *rc.first;
+        rcmax = *rc.second;
+        if (rcmin == 0) {
+            // Column j is exactly zero, 1-based after the m rows.
+            info = m + (std::find( C.begin(), C.end(), real_t( 0 ) )
+                        - C.begin()) + 1;
+        }
+        else {
+            for (int64_t j = 0; j < n; ++j)
+                C[ j ] = 1 / std::min( std::max( C[ j ], smlnum ), bignum );
+            colcnd = std::max( rcmin, smlnum ) / std::min( rcmax, bignum );
+        }
+    }
+
+    A.releaseWorkspace();
+
+    return info;
+}
+
+} // namespace impl
+
+//------------------------------------------------------------------------------
+/// Distributed parallel row and column scalings to equilibrate a general
+/// matrix, as LAPACK's geequ. Computes R and C such that
+/// $B = diag(R) A diag(C)$ has its largest element in each row and column
+/// of magnitude 1 (to within the safe range).
+///
+/// Each pass reads the local tiles once, on devices in one kernel launch
+/// per device, followed by one MPI_Allreduce of the rows or columns:
+/// the row maxima, then the column maxima of diag(R) A.
+/// A is not modified; apply the scaling with scale_row_col.
+///
+//------------------------------------------------------------------------------
+/// @tparam scalar_t
+///     One of float, double, std::complex<float>, std::complex<double>.
+//------------------------------------------------------------------------------
+/// @param[in] A
+///     The m-by-n matrix A. Transposition is not supported.
+///
+/// @param[out] R
+///     Vector of length m. If return value is 0 or > m, the row scale
+///     factors.
+///
+/// @param[out] C
+///     Vector of length n. If return value is 0, the column scale factors.
+///
+/// @param[out] rowcnd
+///     If return value is 0 or > m, the ratio of the smallest R_i to the
+///     largest R_i. If rowcnd >= 0.1 and amax is neither too large nor too
+///     small, it is not worth scaling by R.
+///
+/// @param[out] colcnd
+///     If return value is 0, the ratio of the smallest C_j to the largest
+///     C_j. If colcnd >= 0.1, it is not worth scaling by C.
+///
+/// @param[out] amax
+///     Absolute value of the largest matrix element.
+///
+/// @param[in] opts
+///     Additional options, as map of name = value pairs. Possible options:
+///     - Option::Target:
+///       Implementation to target. Possible values:
+///       - HostTask:  OpenMP tasks on CPU host [default].
+///       - HostNest:  [uses HostTask]
+///       - HostBatch: [uses HostTask]
+///       - Devices:   batched kernels on GPU device.
+///
+/// @return 0: successful exit
+/// @return i > 0, i <= m: row i of A is exactly zero.
+/// @return i > m: column i - m of A is exactly zero.
+///
+/// @ingroup norm
+///
+template <typename scalar_t>
+int64_t geequ(
+    Matrix<scalar_t>& A,
+    std::vector< blas::real_type<scalar_t> >& R,
+    std::vector< blas::real_type<scalar_t> >& C,
+    blas::real_type<scalar_t>& rowcnd,
+    blas::real_type<scalar_t>& colcnd,
+    blas::real_type<scalar_t>& amax,
+    Options const& opts )
+{
+    slate_assert( A.op() == Op::NoTrans );
+
+    Target target = get_target( opts, Target::HostTask );
+
+    switch (target) {
+        case Target::Host:
+        case Target::HostTask:
+        case Target::HostNest:
+        case Target::HostBatch:
+            return impl::geequ<Target::HostTask>(
+                A, R, C, rowcnd, colcnd, amax, opts );
+
+        case Target::Devices:
+        case Target::Hybrid:
+            return impl::geequ<Target::Devices>(
+                A, R, C, rowcnd, colcnd, amax, opts );
+    }
+    return -3;  // shouldn't happen
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+int64_t geequ<float>(
+    Matrix<float>& A,
+    std::vector<float>& R,
+    std::vector<float>& C,
+    float& rowcnd, float& colcnd, float& amax,
+    Options const& opts);
+
+template
+int64_t geequ<double>(
+    Matrix<double>& A,
+    std::vector<double>& R,
+    std::vector<double>& C,
+    double& rowcnd, double& colcnd, double& amax,
+    Options const& opts);
+
+template
+int64_t geequ< std::complex<float> >(
+    Matrix< std::complex<float> >& A,
+    std::vector<float>& R,
+    std::vector<float>& C,
+    float& rowcnd, float& colcnd, float& amax,
+    Options const& opts);
+
+template
+int64_t geequ< std::complex<double> >(
+    Matrix< std::complex<double> >& A,
+    std::vector<double>& R,
+    std::vector<double>& C,
+    double& rowcnd, double& colcnd, double& amax,
+    Options const& opts);
+
+} // namespace slate
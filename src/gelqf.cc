@@ -39,7 +39,7 @@ void gelqf(
     const Layout layout = Layout::ColMajor;
 
     // Options
-    int64_t lookahead = get_option<int64_t>( opts, Option::Lookahead, 1 );
+    int64_t lookahead = get_lookahead( opts );
     int64_t ib = get_option<int64_t>( opts, Option::InnerBlocking, 16 );
     int64_t max_panel_threads  = std::max(omp_get_max_threads()/2, 1);
     max_panel_threads = get_option<int64_t>( opts, Option::MaxPanelThreads,
@@ -403,7 +403,7 @@ void gelqf(
     TriangularFactors<scalar_t>& T,
     Options const& opts )
 {
-    Target target = get_option( opts, Option::Target, Target::HostTask );
+    Target target = get_target( opts, Target::HostTask );
 
     switch (target) {
         case Target::Host:
@@ -420,6 +420,7 @@ void gelqf(
             break;
 
         case Target::Devices:
+        case Target::Hybrid:
             impl::gelqf<Target::Devices>( A, T, opts );
             break;
     }
@@ -8,13 +8,22 @@
 #include "slate/Matrix.hh"
 #include "slate/TriangularMatrix.hh"
 #include "internal/internal.hh"
+#include "internal/internal_cost.hh"
 
 namespace slate {
 
 //------------------------------------------------------------------------------
+/// Selects the gels method. Householder QR is always chosen: Cholesky QR
+/// communicates less, but is accurate only if A is well-conditioned,
+/// which isn't known here, so it must be requested with
+/// Option::MethodGels.
+///
 template <typename TA, typename TB>
 inline MethodGels select_algo( TA& A, TB& B, Options const& opts )
 {
+    internal::log_method( "gels", A, opts, to_c_string( MethodGels::QR ),
+                          "CholQR needs Option::MethodGels, as its accuracy "
+                          "depends on cond( A )" );
     return MethodGels::QR;
 }
 
@@ -78,6 +87,13 @@ inline MethodGels select_algo( TA& A, TB& B, Options const& opts )
 ///     - Option::Lookahead:
 ///       Number of panels to overlap with matrix updates.
 ///       lookahead >= 0. Default 1.
+///     - Option::MethodGels:
+///       Algorithm to solve the least squares problem. Possible values:
+///       - Auto:    same as QR [default].
+///       - QR:      Householder QR (see gels_qr).
+///       - CholQR, CholQR2, CholQR3: Cholesky QR (see gels_cholqr).
+///       - Sketch:  CGLS preconditioned by the QR of a sparse sketch of A,
+///                  for m >> n and A not transposed (see gels_sketch).
 ///     - Option::Target:
 ///       Implementation to target. Possible values:
 ///       - HostTask:  OpenMP tasks on CPU host [default].
@@ -111,11 +127,17 @@ void gels(
             gels_qr( A, T, BX, opts );
             break;
         }
-        case MethodGels::CholQR: {
+        case MethodGels::CholQR:
+        case MethodGels::CholQR2:
+        case MethodGels::CholQR3: {
             Matrix<scalar_t> R;
             gels_cholqr( A, R, BX, opts );
             break;
         }
+        case MethodGels::Sketch: {
+            gels_sketch( A, BX, opts );
+            break;
+        }
     }
 }
 
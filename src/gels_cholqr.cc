@@ -9,8 +9,97 @@
 #include "slate/TriangularMatrix.hh"
 #include "internal/internal.hh"
 
+#include <limits>
+
 namespace slate {
 
+namespace impl {
+
+//------------------------------------------------------------------------------
+/// @internal
+/// Shifted Cholesky QR, the first pass of shifted CholQR3
+/// (Fukaya, Kannan, Nakatsukasa, Yamamoto, and Yanagisawa, 2020).
+/// Factors chol( A^H A + s I ) = R^H R and sets A = A R^{-1}, with
+/// s = 11 (m n + n (n + 1)) u ||A||_2^2, which keeps the Cholesky
+/// factorization from breaking down for cond( A ) up to about u^{-1}.
+/// The resulting A has cond( A ) of about u^{-1/2}, so CholQR2 on it
+/// is accurate. ||A||_F bounds ||A||_2.
+///
+/// @ingroup geqrf_computational
+///
+template <typename scalar_t>
+void cholqr_shifted(
+    Matrix<scalar_t>& A,
+    Matrix<scalar_t>& R,
+    Options const& opts )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // Constants
+    const scalar_t one = 1.0;
+    const real_t r_one  = 1.0;
+    const real_t r_zero = 0.0;
+    const real_t u = std::numeric_limits<real_t>::epsilon() / 2;
+
+    int64_t m = A.m();
+    int64_t n = A.n();
+
+    real_t Anorm = norm( Norm::Fro, A, opts );
+    real_t shift = 11 * real_t( m*n + n*(n + 1) ) * u * Anorm * Anorm;
+
+    HermitianMatrix<scalar_t> G( Uplo::Upper, R );
+    auto AH = conj_transpose( A );
+    auto U = TriangularMatrix<scalar_t>( Diag::NonUnit, G );
+
+    // G = A^H A + shift I.
+    herk( r_one, AH, r_zero, G, opts );
+    for (int64_t j = 0; j < G.nt(); ++j) {
+        if (G.tileIsLocal( j, j )) {
+            G.tileGetForWriting( j, j, LayoutConvert::ColMajor );
+            auto T = G( j, j );
+            for (int64_t jj = 0; jj < T.nb(); ++jj)
+                T.at( jj, jj ) += shift;
+        }
+    }
+
+    // todo: return value for errors?
+    potrf( G, opts );
+
+    // A = A U^{-1}.
+    trsm( Side::Right, one, U, A, opts );
+}
+
+//------------------------------------------------------------------------------
+/// @internal
+/// Accumulates the triangular factor of a repeated Cholesky QR pass,
+/// R = R_pass R. Only the upper triangles of R_pass and R are referenced;
+/// on exit, the strictly lower triangle of R is zero.
+///
+/// @ingroup geqrf_computational
+///
+template <typename scalar_t>
+void cholqr_accumulate(
+    Matrix<scalar_t>& R_pass,
+    Matrix<scalar_t>& R,
+    Options const& opts )
+{
+    const scalar_t one  = 1.0;
+
+    // cholqr leaves A^H A in the strictly lower triangle, so copy only
+    // the upper triangle of R into a zeroed workspace.
+    auto W = R.emptyLike();
+    W.insertLocalTilesZero();
+    auto R_U = TriangularMatrix<scalar_t>( Uplo::Upper, Diag::NonUnit, R );
+    auto W_U = TriangularMatrix<scalar_t>( Uplo::Upper, Diag::NonUnit, W );
+    slate::copy( R_U, W_U, opts );
+
+    auto Rp_U = TriangularMatrix<scalar_t>( Uplo::Upper, Diag::NonUnit, R_pass );
+    trmm( Side::Left, one, Rp_U, W, opts );
+    slate::copy( W, R, opts );
+}
+
+} // namespace impl
+
 //------------------------------------------------------------------------------
 /// Distributed parallel least squares solve via CholeskyQR factorization.
 ///
@@ -75,6 +164,19 @@ namespace slate {
 ///     - Option::Lookahead:
 ///       Number of panels to overlap with matrix updates.
 ///       lookahead >= 0. Default 1.
+///     - Option::MethodGels:
+///       Number of Cholesky QR passes. Possible values:
+///       - CholQR:  one pass, for well-conditioned A [default].
+///       - CholQR2: two passes, for cond( A ) up to about u^{-1/2}.
+///       - CholQR3: a shifted pass, then two passes, for cond( A ) up to
+///                  about u^{-1}.
+///     - Option::MethodCholQR:
+///       Algorithm to compute A^H A in each pass (see cholqr).
+///     - Option::GramPrecision:
+///       Precision of A^H A in the first Cholesky QR pass (see cholqr).
+///       With Single, the first pass is mixed-precision CholQR2, so
+///       method CholQR already gives Q orthogonal to working precision.
+///       Not used by the shifted pass of CholQR3.
 ///     - Option::Target:
 ///       Implementation to target. Possible values:
 ///       - HostTask:  OpenMP tasks on CPU host [default].
@@ -107,6 +209,8 @@ void gels_cholqr(
     const scalar_t one  = 1.0;
     const scalar_t zero = 0.0;
 
+    MethodGels method = get_option( opts, Option::MethodGels, MethodGels::CholQR );
+
     // Get original, un-transposed matrix A0.
     slate::Matrix<scalar_t> A0;
     if (A.op() == Op::NoTrans)
@@ -128,8 +232,29 @@ void gels_cholqr(
         R = R.slice( 0, A0_N-1, 0, A0_N-1 );
         R.insertLocalTiles();
 
+        // CholQR2 repeats cholqr once on Q; shifted CholQR3 first does a
+        // shifted pass, then CholQR2. Each repeat improves the
+        // orthogonality of Q from about cond( A )^2 u to u.
         Timer t_cholqr;
-        cholqr( A0, R, opts );
+        if (method == MethodGels::CholQR3)
+            impl::cholqr_shifted( A0, R, opts );
+        else
+            cholqr( A0, R, opts );
+
+        // GramPrecision applies only to the first pass, which then
+        // includes its own correction pass in the matrix precision.
+        int passes = (method == MethodGels::CholQR2 ? 1
+                      : method == MethodGels::CholQR3 ? 2 : 0);
+        if (passes > 0) {
+            Options opts_hi( opts );
+            opts_hi[ Option::GramPrecision ] = GramPrecision::Native;
+            auto R_pass = R.emptyLike();
+            R_pass.insertLocalTiles();
+            for (int pass = 0; pass < passes; ++pass) {
+                cholqr( A0, R_pass, opts_hi );
+                impl::cholqr_accumulate( R_pass, R, opts );
+            }
+        }
         timers[ "gels_cholqr::cholqr" ] = t_cholqr.stop();
 
         auto R_U = TriangularMatrix( Uplo::Upper, Diag::NonUnit, R );
@@ -0,0 +1,263 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/slate.hh"
+#include "auxiliary/Debug.hh"
+#include "slate/Matrix.hh"
+#include "slate/TriangularMatrix.hh"
+#include "internal/internal.hh"
+#include "internal/internal_util.hh"
+
+namespace slate {
+
+//------------------------------------------------------------------------------
+/// Distributed parallel iterative-refinement least squares solve.
+///
+/// Solves the over-determined system $A X = B$ for the least squares
+/// solution $X$ that minimizes $\norm{ A X - B }_2$, where $A$ is an
+/// m-by-n matrix of full rank, m >= n, $B$ is m-by-nrhs, and $X$ is
+/// n-by-nrhs.
+///
+/// gels_mixed factors $A = Q R$ in low precision (single), using geqrf or,
+/// with Option::MethodGels = CholQR, cholqr, then refines the solution
+/// with the corrected semi-normal equations (Björck, 1987), which use
+/// only $R$, in high precision (double):
+/// \[
+///     R = B - A X, \quad
+///     R_{lo}^H R_{lo} D = A^H R, \quad
+///     X = X + D,
+/// \]
+/// starting from $X = 0$, with the residuals and $A^H R$ computed by gemm
+/// in high precision and the two triangular solves in low precision.
+/// Each iteration reduces the error by about u_lo cond( $A$ )^2, so it
+/// converges for cond( $A$ ) up to about u_lo^{-1/2}. If the approach
+/// fails, the method falls back to a high precision (double) gels.
+///
+/// The iterative refinement process is stopped if iter > itermax or
+/// for all the RHS, $1 \le j \le nrhs$, we have:
+///     $\norm{d_j}_{inf} < tol \norm{x_j}_{inf}$,
+/// where:
+/// - iter is the number of the current iteration in the iterative refinement
+///    process
+/// - $\norm{d_j}_{inf}$ is the infinity-norm of the correction $d_j$
+/// - $\norm{x_j}_{inf}$ is the infinity-norm of the solution $x_j$
+/// - tol is the tolerance, default eps*sqrt(m), where
+///    eps is the high precision (double) machine epsilon.
+///
+//------------------------------------------------------------------------------
+/// @tparam scalar_hi
+///     One of double, std::complex<double>.
+///
+/// @tparam scalar_lo
+///     One of float, std::complex<float>.
+//------------------------------------------------------------------------------
+/// @param[in,out] A
+///     The m-by-n matrix $A$, m >= n. Currently $A$ must be not transposed.
+///     Not modified, unless the iterations fall back to gels.
+///
+/// @param[in,out] BX
+///     Matrix of size m-by-nrhs.
+///     On entry, the m-by-nrhs right hand side matrix $B$.
+///     On exit, the first n rows are the n-by-nrhs solution matrix $X$.
+///
+/// @param[out] iter
+///     The number of the iterations in the iterative refinement
+///     process, needed for the convergence.
+///     - iter >= 0: converged after iter refinement steps following
+///       the first semi-normal equations solve
+///     - iter < 0: iterative refinement has failed, and the solution
+///       comes from the fallback solver, if enabled.
+///
+/// @param[in] opts
+///     Additional options, as map of name = value pairs. Possible options:
+///     - Option::Lookahead:
+///       Number of panels to overlap with matrix updates.
+///       lookahead >= 0. Default 1.
+///     - Option::Target:
+///       Implementation to target. Possible values:
+///       - HostTask:  OpenMP tasks on CPU host [default].
+///       - HostNest:  nested OpenMP parallel for loop on CPU host.
+///       - HostBatch: batched BLAS on CPU host.
+///       - Devices:   batched BLAS on GPU device.
+///     - Option::MethodGels:
+///       Low precision factorization. Possible values:
+///       - QR:  Householder QR, geqrf [default].
+///       - CholQR, CholQR2, CholQR3: Cholesky QR, cholqr; faster, but
+///         breaks down in low precision for cond( A ) above about
+///         u_lo^{-1/2}, which is then handled by the fallback solver.
+///     - Option::ComputePrecision:
+///       Compute mode of the device gemm updates in the low precision
+///       factorization, e.g., TF32 (see gemm); the refinement always
+///       uses full precision.
+///     - Option::Tolerance:
+///       Iterative refinement tolerance. Default epsilon * sqrt(m)
+///     - Option::MaxIterations:
+///       Maximum number of refinement iterations. Default 30
+///     - Option::UseFallbackSolver:
+///       If true and iterative refinement fails to converge, the problem is
+///       resolved with gels in high precision. Default true
+///
+/// @ingroup gels
+///
+template <typename scalar_hi, typename scalar_lo>
+void gels_mixed(
+    Matrix<scalar_hi>& A,
+    Matrix<scalar_hi>& BX,
+    int& iter,
+    Options const& opts)
+{
+    using real_hi = blas::real_type<scalar_hi>;
+    using real_lo = blas::real_type<scalar_lo>;
+
+    Timer t_gels_mixed;
+
+    // Constants
+    const real_hi eps = std::numeric_limits<real_hi>::epsilon();
+    const scalar_hi one_hi  = 1.0;
+    const scalar_hi zero_hi = 0.0;
+    const scalar_lo one_lo  = 1.0;
+
+    // m, n of op(A) as in docs above.
+    int64_t m = A.m();
+    int64_t n = A.n();
+    int64_t nrhs = BX.n();
+
+    if (A.op() != Op::NoTrans || m < n)
+        slate_not_implemented( "gels_mixed: only A not transposed, m >= n" );
+
+    // Options
+    Target target = get_target( opts, Target::HostTask );
+    int64_t itermax = get_option<int64_t>( opts, Option::MaxIterations, 30 );
+    double tol = get_option<double>( opts, Option::Tolerance, eps*std::sqrt(m) );
+    bool use_fallback = get_option<int64_t>( opts, Option::UseFallbackSolver, true );
+    MethodGels method = get_option( opts, Option::MethodGels, MethodGels::QR );
+    bool use_cholqr = method == MethodGels::CholQR
+                      || method == MethodGels::CholQR2
+                      || method == MethodGels::CholQR3;
+    bool converged = false;
+    iter = 0;
+
+    // X is first n rows of BX.
+    auto X = BX.slice( 0, n-1, 0, nrhs-1 );
+
+    // workspace
+    auto B    = BX.emptyLike();
+    auto R    = BX.emptyLike();
+    auto G    = X.emptyLike();
+    auto A_lo = A.template emptyLike<scalar_lo>();
+    auto D_lo = X.template emptyLike<scalar_lo>();
+
+    std::vector<real_hi> colnorms_X( nrhs );
+    std::vector<real_lo> colnorms_D_lo( nrhs );
+    std::vector<real_hi> colnorms_D( nrhs );
+
+    // insert local tiles
+    B.   insertLocalTiles( target );
+    R.   insertLocalTiles( target );
+    G.   insertLocalTiles( target );
+    A_lo.insertLocalTiles( target );
+    D_lo.insertLocalTiles( target );
+
+    slate::copy( BX, B, opts );
+
+    // Convert A from high to low precision, store result in A_lo.
+    copy( A, A_lo, opts );
+
+    // Factor A_lo = Q_lo R_lo; only R_lo is used.
+    Timer t_geqrf_lo;
+    Matrix<scalar_lo> R_lo;
+    if (use_cholqr) {
+        R_lo = A_lo.emptyLike();
+        R_lo = R_lo.slice( 0, n-1, 0, n-1 );
+        R_lo.insertLocalTiles( target );
+        cholqr( A_lo, R_lo, opts );
+    }
+    else {
+        TriangularFactors<scalar_lo> T_lo;
+        geqrf( A_lo, T_lo, opts );
+        R_lo = A_lo.slice( 0, n-1, 0, n-1 );
+    }
+    timers[ "gels_mixed::geqrf_lo" ] = t_geqrf_lo.stop();
+
+    auto R_lo_U = TriangularMatrix<scalar_lo>( Uplo::Upper, Diag::NonUnit, R_lo );
+    auto R_lo_H = conj_transpose( R_lo_U );
+    auto AH = conj_transpose( A );
+
+    // Starting from X = 0, the first pass solves the semi-normal equations
+    // R_lo^H R_lo X = A^H B; later passes refine X.
+    set( zero_hi, X, opts );
+    timers[ "gels_mixed::gemm_hi" ] = 0;
+    timers[ "gels_mixed::trsm_lo" ] = 0;
+    for (int iiter = 0; iiter <= itermax && ! converged; ++iiter) {
+        // Compute R = B - A X, G = A^H R.
+        Timer t_gemm_hi;
+        slate::copy( B, R, opts );
+        gemm( -one_hi, A, X, one_hi, R, opts );
+        gemm( one_hi, AH, R, zero_hi, G, opts );
+        timers[ "gels_mixed::gemm_hi" ] += t_gemm_hi.stop();
+
+        // Solve R_lo^H R_lo D_lo = G_lo.
+        copy( G, D_lo, opts );
+        Timer t_trsm_lo;
+        trsm( Side::Left, one_lo, R_lo_H, D_lo, opts );
+        trsm( Side::Left, one_lo, R_lo_U, D_lo, opts );
+        timers[ "gels_mixed::trsm_lo" ] += t_trsm_lo.stop();
+
+        // Update the current iterate, X = X + D_lo.
+        add( one_hi, D_lo, one_hi, X, opts );
+
+        // Check whether the correction is small relative to X in each
+        // column. If yes, set iter = iiter and return.
+        colNorms( Norm::Max, X, colnorms_X.data(), opts );
+        colNorms( Norm::Max, D_lo, colnorms_D_lo.data(), opts );
+        std::copy( colnorms_D_lo.begin(), colnorms_D_lo.end(),
+                   colnorms_D.begin() );
+
+        if (internal::iterRefConverged<real_hi>( colnorms_D, colnorms_X, tol )) {
+            iter = iiter;
+            converged = true;
+        }
+    }
+
+    if (! converged) {
+        // If we performed iter = itermax iterations and never satisfied
+        // the stopping criterion, set up the iter flag accordingly.
+        iter = -itermax - 1;
+
+        if (use_fallback) {
+            // Fall back to double precision gels.
+            Timer t_gels_hi;
+            slate::copy( B, BX, opts );
+            gels( A, BX, opts );
+            timers[ "gels_mixed::gels_hi" ] = t_gels_hi.stop();
+        }
+    }
+    timers[ "gels_mixed" ] = t_gels_mixed.stop();
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template <>
+void gels_mixed<double>(
+    Matrix<double>& A,
+    Matrix<double>& BX,
+    int& iter,
+    Options const& opts)
+{
+    gels_mixed<double, float>( A, BX, iter, opts );
+}
+
+template <>
+void gels_mixed< std::complex<double> >(
+    Matrix< std::complex<double> >& A,
+    Matrix< std::complex<double> >& BX,
+    int& iter,
+    Options const& opts)
+{
+    gels_mixed< std::complex<double>, std::complex<float> >(
+        A, BX, iter, opts );
+}
+
+} // namespace slate
@@ -0,0 +1,404 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/slate.hh"
+#include "auxiliary/Debug.hh"
+#include "slate/Matrix.hh"
+#include "slate/TriangularMatrix.hh"
+#include "internal/internal.hh"
+
+#include <climits>
+#include <cmath>
+#include <limits>
+
+namespace slate {
+
+namespace impl {
+
+//------------------------------------------------------------------------------
+/// @internal
+/// splitmix64 hash (Steele, Lea, and Flood, 2014), to draw the sketch
+/// entries of each row from its global index alone, so the sketch does not
+/// depend on the number of ranks or threads.
+///
+inline uint64_t sketch_hash( uint64_t x )
+{
+    x += 0x9e3779b97f4a7c15ull;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+    return x ^ (x >> 31);
+}
+
+//------------------------------------------------------------------------------
+/// @internal
+/// Computes the sketch SA = S A of the m-by-n matrix A, where S is an
+/// s-by-m sparse sign embedding with zeta nonzeros, +-1/sqrt( zeta ), in
+/// each column (Clarkson and Woodruff, 2013; Nelson and Nguyen, 2013).
+/// Each rank adds its local tiles into SA, then an allreduce sums SA,
+/// so on exit SA, s-by-n column-major with leading dimension s, is the
+/// same on all ranks. Costs O( zeta m n ) flops.
+///
+template <typename scalar_t>
+void gels_sketch_apply(
+    Matrix<scalar_t>& A, int64_t s, int64_t zeta, uint64_t seed,
+    std::vector<scalar_t>& SA )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    const real_t scale = 1 / std::sqrt( real_t( zeta ) );
+    int64_t n = A.n();
+
+    std::vector<int64_t> row0( A.mt() + 1, 0 ), col0( A.nt() + 1, 0 );
+    for (int64_t i = 0; i < A.mt(); ++i)
+        row0[ i+1 ] = row0[ i ] + A.tileMb( i );
+    for (int64_t j = 0; j < A.nt(); ++j)
+        col0[ j+1 ] = col0[ j ] + A.tileNb( j );
+
+    SA.assign( s*n, scalar_t( 0 ) );
+    scalar_t* SA_data = SA.data();
+
+    // Each task sums the tiles of one block column, into its own columns
+    // of SA.
+    #pragma omp parallel
+    #pragma omp master
+    {
+        for (int64_t j = 0; j < A.nt(); ++j) {
+            #pragma omp task slate_omp_default_none \
+                shared( A, row0, col0 ) \
+                firstprivate( j, s, zeta, seed, scale, SA_data )
+            {
+                std::vector<int64_t> target;
+                std::vector<real_t> sign;
+                for (int64_t i = 0; i < A.mt(); ++i) {
+                    if (! A.tileIsLocal( i, j ))
+                        continue;
+                    A.tileGetForReading( i, j, LayoutConvert::ColMajor );
+                    auto T = A( i, j );
+                    int64_t mb = T.mb();
+                    target.resize( mb*zeta );
+                    sign.resize( mb*zeta );
+                    for (int64_t ii = 0; ii < mb; ++ii) {
+                        uint64_t row = row0[ i ] + ii;
+                        for (int64_t h = 0; h < zeta; ++h) {
+                            uint64_t key = sketch_hash( seed ^ (row*zeta + h) );
+                            target[ ii*zeta + h ] = (key >> 1) % s;
+                            sign  [ ii*zeta + h ] = (key & 1) ? -scale : scale;
+                        }
+                    }
+                    for (int64_t jj = 0; jj < T.nb(); ++jj) {
+                        scalar_t* SA_j = &SA_data[ (col0[ j ] + jj)*s ];
+                        for (int64_t ii = 0; ii < mb; ++ii) {
+                            scalar_t a = T( ii, jj );
+                            for (int64_t h = 0; h < zeta; ++h)
+                                SA_j[ target[ ii*zeta + h ] ] += sign[ ii*zeta + h ] * a;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    // MPI counts are int, so reduce in chunks.
+    const int64_t chunk = INT_MAX / 2;
+    for (int64_t k = 0; k < s*n; k += chunk) {
+        int count = int( std::min( chunk, s*n - k ) );
+        slate_mpi_call(
+            MPI_Allreduce( MPI_IN_PLACE, &SA_data[ k ], count,
+                           mpi_type<scalar_t>::value, MPI_SUM, A.mpiComm() ) );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// @internal
+/// Returns the squared 2-norm of each column of X, on all ranks.
+///
+template <typename scalar_t>
+std::vector< blas::real_type<scalar_t> > gels_sketch_norms2(
+    Matrix<scalar_t>& X )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    std::vector<real_t> norms( X.n(), 0 );
+    int64_t col0 = 0;
+    for (int64_t j = 0; j < X.nt(); ++j) {
+        for (int64_t i = 0; i < X.mt(); ++i) {
+            if (X.tileIsLocal( i, j )) {
+                X.tileGetForReading( i, j, LayoutConvert::ColMajor );
+                auto T = X( i, j );
+                for (int64_t jj = 0; jj < T.nb(); ++jj)
+                    for (int64_t ii = 0; ii < T.mb(); ++ii)
+                        norms[ col0 + jj ] += std::norm( T( ii, jj ) );
+            }
+        }
+        col0 += X.tileNb( j );
+    }
+    slate_mpi_call(
+        MPI_Allreduce( MPI_IN_PLACE, norms.data(), norms.size(),
+                       mpi_type<real_t>::value, MPI_SUM, X.mpiComm() ) );
+    return norms;
+}
+
+//------------------------------------------------------------------------------
+/// @internal
+/// Updates each column of Y, Y( :, j ) = alpha[ j ] X( :, j ) + beta[ j ]
+/// Y( :, j ). X and Y have the same distribution.
+///
+template <typename scalar_t>
+void gels_sketch_axpby(
+    std::vector< blas::real_type<scalar_t> > const& alpha, Matrix<scalar_t>& X,
+    std::vector< blas::real_type<scalar_t> > const& beta,  Matrix<scalar_t>& Y )
+{
+    int64_t col0 = 0;
+    for (int64_t j = 0; j < Y.nt(); ++j) {
+        for (int64_t i = 0; i < Y.mt(); ++i) {
+            if (Y.tileIsLocal( i, j )) {
+                X.tileGetForReading( i, j, LayoutConvert::ColMajor );
+                Y.tileGetForWriting( i, j, LayoutConvert::ColMajor );
+                auto TX = X( i, j );
+                auto TY = Y( i, j );
+                for (int64_t jj = 0; jj < TY.nb(); ++jj) {
+                    scalar_t a = alpha[ col0 + jj ];
+                    scalar_t b = beta[ col0 + jj ];
+                    for (int64_t ii = 0; ii < TY.mb(); ++ii)
+                        TY.at( ii, jj ) = a*TX( ii, jj ) + b*TY( ii, jj );
+                }
+            }
+        }
+        col0 += Y.tileNb( j );
+    }
+}
+
+} // namespace impl
+
+//------------------------------------------------------------------------------
+/// Distributed parallel least squares solve via sketch-preconditioned CGLS.
+///
+/// Solves the over-determined system $A X = B$ for the least squares
+/// solution $X$ that minimizes $\norm{ A X - B }_2$, for an m-by-n matrix
+/// $A$ of full rank with m >> n, without factoring $A$
+/// (Rokhlin and Tygert, 2008; Avron, Maymounkov, and Toledo, 2010).
+/// It computes a sketch $S A$, with $S$ an s-by-m sparse sign embedding,
+/// s = min( n + oversampling, m ), and the QR factorization $S A = Q R$,
+/// replicated on all ranks; then solves with CGLS preconditioned by $R$,
+/// i.e., on $\min \norm{ A R^{-1} Y - B }_2$ with $X = R^{-1} Y$.
+/// $A R^{-1}$ is well-conditioned, independent of cond( $A$ ), so CGLS
+/// converges in a few tens of iterations, each of two gemm and two trsm
+/// with $R$. For m >> n, this costs less and communicates less than
+/// Householder QR of $A$, which is what gels_qr does.
+///
+/// Several right hand side vectors $b$ and solution vectors $x$ can be
+/// handled in a single call; they are stored as the columns of the
+/// m-by-nrhs right hand side matrix $B$ and the n-by-nrhs solution
+/// matrix $X$.
+///
+//------------------------------------------------------------------------------
+/// @tparam scalar_t
+///     One of float, double, std::complex<float>, std::complex<double>.
+//------------------------------------------------------------------------------
+/// @param[in] A
+///     The m-by-n matrix $A$, m >= n. Currently $A$ must be not transposed.
+///     Not modified, unless the iterations fall back to gels_qr.
+///
+/// @param[in,out] BX
+///     Matrix of size m-by-nrhs.
+///     On entry, the m-by-nrhs right hand side matrix $B$.
+///     On exit, the first n rows are the n-by-nrhs solution matrix $X$.
+///
+/// @param[in] opts
+///     Additional options, as map of name = value pairs. Possible options:
+///     - Option::Oversampling:
+///       Number of sketch rows beyond n. Default 3 n.
+///     - Option::Tolerance:
+///       CGLS stops when, for each column, the 2-norm of the preconditioned
+///       normal equations residual, $R^{-H} A^H (B - A X)$, is
+///       <= tolerance * $\norm{ B }_2$. Default epsilon * sqrt(m).
+///     - Option::MaxIterations:
+///       Maximum number of CGLS iterations. Default 100.
+///     - Option::UseFallbackSolver:
+///       If true and CGLS fails to converge, the problem is solved with
+///       gels_qr, which overwrites $A$; if false, $X$ is the last iterate.
+///       Default true. If $S A$ is rank deficient, gels_qr is always used.
+///     - Option::Lookahead:
+///       Number of panels to overlap with matrix updates.
+///       lookahead >= 0. Default 1.
+///     - Option::Target:
+///       Implementation to target. Possible values:
+///       - HostTask:  OpenMP tasks on CPU host [default].
+///       - HostNest:  nested OpenMP parallel for loop on CPU host.
+///       - HostBatch: batched BLAS on CPU host.
+///       - Devices:   batched BLAS on GPU device.
+///
+/// @ingroup gels
+///
+template <typename scalar_t>
+void gels_sketch(
+    Matrix<scalar_t>& A,
+    Matrix<scalar_t>& BX,
+    Options const& opts)
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    Timer t_gels_sketch;
+
+    const scalar_t one  = 1.0;
+    const scalar_t zero = 0.0;
+    const real_t eps = std::numeric_limits<real_t>::epsilon();
+    const uint64_t seed = 42;
+
+    // m, n of op(A) as in docs above.
+    int64_t m = A.m();
+    int64_t n = A.n();
+    int64_t nrhs = BX.n();
+
+    if (A.op() != Op::NoTrans || m < n)
+        slate_not_implemented( "gels_sketch: only A not transposed, m >= n" );
+
+    int64_t oversampling = get_option<int64_t>( opts, Option::Oversampling, 3*n );
+    int64_t itermax = get_option<int64_t>( opts, Option::MaxIterations, 100 );
+    real_t tol = get_option<double>( opts, Option::Tolerance, eps*std::sqrt( m ) );
+    bool use_fallback = get_option<int64_t>( opts, Option::UseFallbackSolver, true );
+
+    if (oversampling < 0)
+        slate_error( "gels_sketch: Oversampling must be >= 0" );
+    int64_t s = std::min( n + oversampling, m );
+    int64_t zeta = std::min( int64_t( 8 ), s );
+
+    // Sketch and replicated QR, S A = Q R.
+    Timer t_sketch;
+    std::vector<scalar_t> SA;
+    impl::gels_sketch_apply( A, s, zeta, seed, SA );
+    std::vector<scalar_t> tau( n );
+    lapack::geqrf( s, n, SA.data(), s, tau.data() );
+    bool singular = false;
+    for (int64_t k = 0; k < n; ++k)
+        singular = singular || SA[ k + k*s ] == zero;
+    timers[ "gels_sketch::sketch" ] = t_sketch.stop();
+
+    bool converged = false;
+    if (! singular) {
+        // R is n-by-n, distributed like the first n rows of A.
+        auto R = A.emptyLike();
+        R = R.slice( 0, n-1, 0, n-1 );
+        R.insertLocalTiles();
+        int64_t col0 = 0;
+        for (int64_t j = 0; j < R.nt(); ++j) {
+            int64_t row0 = 0;
+            for (int64_t i = 0; i <= j && i < R.mt(); ++i) {
+                if (R.tileIsLocal( i, j )) {
+                    R.tileGetForWriting( i, j, LayoutConvert::ColMajor );
+                    auto T = R( i, j );
+                    for (int64_t jj = 0; jj < T.nb(); ++jj)
+                        for (int64_t ii = 0; ii < T.mb(); ++ii)
+                            T.at( ii, jj ) = SA[ (row0 + ii) + (col0 + jj)*s ];
+                }
+                row0 += R.tileMb( i );
+            }
+            col0 += R.tileNb( j );
+        }
+        auto R_U = TriangularMatrix<scalar_t>( Uplo::Upper, Diag::NonUnit, R );
+        auto RH = conj_transpose( R_U );
+        auto AH = conj_transpose( A );
+
+        // X is first n rows of BX; r and q are m-by-nrhs, like B;
+        // x, d, p, t are n-by-nrhs, like X.
+        auto X = BX.slice( 0, n-1, 0, nrhs-1 );
+        auto r = BX.emptyLike();
+        r.insertLocalTiles();
+        auto q = BX.emptyLike();
+        q.insertLocalTiles();
+        auto x = X.emptyLike();
+        x.insertLocalTiles();
+        auto d = X.emptyLike();
+        d.insertLocalTiles();
+        auto p = X.emptyLike();
+        p.insertLocalTiles();
+        auto t = X.emptyLike();
+        t.insertLocalTiles();
+
+        std::vector<real_t> ones( nrhs, 1 ), zeros( nrhs, 0 ), minus( nrhs );
+        std::vector<real_t> alpha( nrhs ), beta( nrhs );
+
+        // x = 0, r = b, t = R^{-H} A^H r, d = t.
+        Timer t_cgls;
+        set( zero, x, opts );
+        slate::copy( BX, r, opts );
+        auto b_norms2 = impl::gels_sketch_norms2( r );
+        gemm( one, AH, r, zero, t, opts );
+        trsm( Side::Left, one, RH, t, opts );
+        slate::copy( t, d, opts );
+        auto gamma = impl::gels_sketch_norms2( t );
+
+        int64_t iter = 0;
+        for (; iter < itermax; ++iter) {
+            converged = true;
+            for (int64_t j = 0; j < nrhs; ++j)
+                converged = converged && gamma[ j ] <= tol*tol*b_norms2[ j ];
+            if (converged)
+                break;
+
+            // p = R^{-1} d, q = A p.
+            slate::copy( d, p, opts );
+            trsm( Side::Left, one, R_U, p, opts );
+            gemm( one, A, p, zero, q, opts );
+
+            // alpha = gamma / ||q||^2; x += alpha p; r -= alpha q.
+            auto q_norms2 = impl::gels_sketch_norms2( q );
+            for (int64_t j = 0; j < nrhs; ++j) {
+                alpha[ j ] = q_norms2[ j ] == 0 ? 0 : gamma[ j ] / q_norms2[ j ];
+                minus[ j ] = -alpha[ j ];
+            }
+            impl::gels_sketch_axpby( alpha, p, ones, x );
+            impl::gels_sketch_axpby( minus, q, ones, r );
+
+            // t = R^{-H} A^H r; beta = ||t||^2 / gamma; d = t + beta d.
+            gemm( one, AH, r, zero, t, opts );
+            trsm( Side::Left, one, RH, t, opts );
+            auto gamma_new = impl::gels_sketch_norms2( t );
+            for (int64_t j = 0; j < nrhs; ++j) {
+                beta[ j ] = gamma[ j ] == 0 ? 0 : gamma_new[ j ] / gamma[ j ];
+                gamma[ j ] = gamma_new[ j ];
+            }
+            impl::gels_sketch_axpby( ones, t, beta, d );
+        }
+        timers[ "gels_sketch::cgls" ] = t_cgls.stop();
+
+        if (converged || ! use_fallback)
+            slate::copy( x, X, opts );
+    }
+
+    if (singular || (! converged && use_fallback)) {
+        TriangularFactors<scalar_t> T;
+        gels_qr( A, T, BX, opts );
+    }
+    timers[ "gels_sketch" ] = t_gels_sketch.stop();
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void gels_sketch<float>(
+    Matrix<float>& A,
+    Matrix<float>& B,
+    Options const& opts);
+
+template
+void gels_sketch<double>(
+    Matrix<double>& A,
+    Matrix<double>& B,
+    Options const& opts);
+
+template
+void gels_sketch< std::complex<float> >(
+    Matrix< std::complex<float> >& A,
+    Matrix< std::complex<float> >& B,
+    Options const& opts);
+
+template
+void gels_sketch< std::complex<double> >(
+    Matrix< std::complex<double> >& A,
+    Matrix< std::complex<double> >& B,
+    Options const& opts);
+
+} // namespace slate
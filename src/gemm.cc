@@ -5,24 +5,92 @@
 
 #include "slate/slate.hh"
 
+#include "blas/flops.hh"
+#include "internal/internal_cost.hh"
+#include "internal/internal_small.hh"
+
 namespace slate {
 
 //------------------------------------------------------------------------------
+/// Selects gemmA or gemmC by a communication and computation cost model.
+/// gemmC keeps C in place and receives block rows of A and block cols of B,
+///     k (m/p + n/q) words per rank;
+/// gemmA keeps A in place, receives block rows of B, and reduces partial C,
+///     n (k/q + m/p) words per rank.
+/// Each also has work only for as many ranks as it has tiles to update:
+/// mt nt for gemmC, mt kt for gemmA.
+/// @see internal::CostModel
+///
 template <typename TA, typename TB>
 MethodGemm select_algo( TA& A, TB& B, Options& opts )
 {
+    using scalar_t = typename TA::value_type;
+
     // TODO replace the default value by a unique value located elsewhere
-    Target target = get_option( opts, Option::Target, Target::HostTask );
+    Target target = get_target( opts, Target::HostTask );
     int n_devices = A.num_devices();
 
-    MethodGemm method = (B.nt() < 2 ? MethodGemm::A : MethodGemm::C);
+    // gemmA on devices supports only one device per rank.
+    if (target == Target::Devices && n_devices > 1) {
+        internal::log_method( "gemm", A, opts, "C",
+                              "gemmA supports only one device per rank" );
+        return MethodGemm::C;
+    }
+
+    internal::CostModel model = internal::cost_model( "gemm", A, opts );
+    double p = model.p, q = model.q;
+    double m  = A.m(),  n  = B.n(),  k  = A.n();
+    double mt = A.mt(), nt = B.nt(), kt = A.nt();
+    double ws = sizeof( scalar_t );
+    double flops = 2 * m * n * k;
 
-    if (method == MethodGemm::A && target == Target::Devices && n_devices > 1)
-        method = MethodGemm::C;
+    double time_C = model.time(
+        std::ceil( mt/p )*kt + kt*std::ceil( nt/q ),
+        ws * k * (m/p + n/q), flops, mt*nt );
+    double time_A = model.time(
+        std::ceil( kt/q )*nt + std::ceil( mt/p )*nt,
+        ws * n * (k/q + m/p), flops, mt*kt );
 
+    MethodGemm method = (time_A < time_C ? MethodGemm::A : MethodGemm::C);
+
+    internal::log_method( "gemm", A, opts, to_c_string( method ),
+                          internal::cost_reason( "A", time_A, "C", time_C ) );
     return method;
 }
 
+//------------------------------------------------------------------------------
+/// Small-problem fast path of gemm: the rank owning all tiles of A, B, and C
+/// gathers them and calls BLAS gemm, without tasks.
+/// @see internal::small_path
+///
+template <typename scalar_t>
+void gemm_small(
+    scalar_t alpha, Matrix<scalar_t>& A,
+                    Matrix<scalar_t>& B,
+    scalar_t beta,  Matrix<scalar_t>& C,
+    int owner )
+{
+    if (C.mpiRank() != owner)
+        return;
+
+    int64_t m = C.m();
+    int64_t n = C.n();
+    int64_t k = A.n();
+    int64_t lda = std::max( m, int64_t( 1 ) );
+    int64_t ldb = std::max( k, int64_t( 1 ) );
+    std::vector<scalar_t> Adata( lda*k ), Bdata( ldb*n ), Cdata( lda*n );
+    internal::small_gather( A, Adata.data(), lda );
+    internal::small_gather( B, Bdata.data(), ldb );
+    internal::small_gather( C, Cdata.data(), lda );
+
+    blas::gemm( Layout::ColMajor, Op::NoTrans, Op::NoTrans, m, n, k,
+                alpha, Adata.data(), lda,
+                       Bdata.data(), ldb,
+                beta,  Cdata.data(), lda );
+
+    internal::small_scatter( C, Cdata.data(), lda );
+}
+
 //------------------------------------------------------------------------------
 /// Distributed parallel general matrix-matrix multiplication.
 /// Performs the matrix-matrix operation
@@ -66,9 +134,29 @@ MethodGemm select_algo( TA& A, TB& B, Options& opts )
 ///           lookahead >= 0. Default 1.
 ///         - Option::MethodGemm:
 ///           Select the right routine to call. Possible values:
-///           - Auto: let the routine decides [default]
+///           - Auto: let the routine decide, by a cost model of
+///             communication and computation [default]. If
+///             Option::PrintVerbose >= 1, rank 0 prints the method
+///             chosen and the estimated times.
 ///           - gemmA: select gemmA routine
 ///           - gemmC: select gemmC routine
+///           - Layered: select the 2.5D gemmLayered routine, which
+///             cuts broadcast volume at large rank counts for extra memory
+///         - Option::Layers:
+///           Number of layers for Layered; @see gemmLayered. Default 0: auto.
+///         - Option::Counters:
+///           Pointer to Counters to collect performance counters in,
+///           for phase "gemm". Default null: off.
+///         - Option::ComputePrecision:
+///           Compute mode of the gemm, e.g., TF32 to let single
+///           precision use tensor cores on devices, or Complex3M for the
+///           3M algorithm in complex precisions (@see gemmC).
+///           Default Native.
+///         - Option::SmallTiles:
+///           With MethodGemm::Auto and a host target, if A, B, and C each
+///           have at most this many tiles, all on one rank, that rank
+///           calls BLAS gemm on them directly, without tasks. 0: off.
+///           Default 4.
 ///         - Option::Target:
 ///           Implementation to target. Possible values:
 ///           - HostTask:  OpenMP tasks on CPU host [default].
@@ -87,6 +175,17 @@ void gemm(scalar_t alpha, Matrix<scalar_t>& A,
     MethodGemm method = get_option(
         opts, Option::MethodGemm, MethodGemm::Auto );
 
+    internal::CounterPhase c_gemm(
+        get_option<Option::Counters>( opts, nullptr ), "gemm",
+        blas::Gflop<scalar_t>::gemm( C.m(), C.n(), A.n() ) * 1e9 );
+
+    int owner;
+    if (method == MethodGemm::Auto
+        && internal::small_path<scalar_t>( { &A, &B, &C }, opts, &owner )) {
+        gemm_small( alpha, A, B, beta, C, owner );
+        return;
+    }
+
     // Select_algo can also change target.
     Options tuned_opts = opts;
 
@@ -101,6 +200,9 @@ void gemm(scalar_t alpha, Matrix<scalar_t>& A,
         case MethodGemm::C:
             gemmC( alpha, A, B, beta, C, tuned_opts );
             break;
+        case MethodGemm::Layered:
+            gemmLayered( alpha, A, B, beta, C, tuned_opts );
+            break;
     }
 }
 
@@ -43,7 +43,11 @@ void gemmA(
     const Layout layout = Layout::ColMajor;
 
     // Options
-    int64_t lookahead = get_option<int64_t>( opts, Option::Lookahead, 1 );
+    int64_t lookahead = get_lookahead( opts );
+    int64_t host_ws = get_option<int64_t>( opts, Option::HostWorkspaceTiles, 0 );
+    int64_t cache_tiles = get_option<int64_t>( opts, Option::DeviceCacheTiles, 0 );
+    ComputePrecision compute_precision = get_option<Option::ComputePrecision>(
+                                             opts, ComputePrecision::Native );
 
     // OpenMP needs pointer types, but vectors are exception safe
     std::vector<uint8_t> bcast_vector( A.nt() );
@@ -58,8 +62,21 @@ void gemmA(
             slate_not_implemented( "gemmA doesn't support multiple GPUs" );
 
         A.allocateBatchArrays();
-        A.reserveDeviceWorkspace();
+        if (cache_tiles > 0) {
+            A.enableTileCache( cache_tiles );
+            B.enableTileCache( cache_tiles );
+            C.enableTileCache( cache_tiles );
+        }
+        else {
+            A.reserveDeviceWorkspace();
+        }
+        if (host_ws > 0) {
+            B.reserveHostWorkspace( host_ws );
+            C.reserveHostWorkspace( host_ws );
+        }
     }
+    // Also selects the host 3M gemm.
+    A.setComputePrecisions( compute_precision, 0, 1 );
 
     // set min number for omp nested active parallel regions
     slate::OmpSetMaxActiveLevels set_active_levels( MinOmpActiveLevels );
@@ -205,6 +222,13 @@ void gemmA(
         C.tileUpdateAllOrigin();
         A.releaseLocalWorkspace();
     }
+    A.setComputePrecisions( ComputePrecision::Native, 0, 1 );
+
+    if (cache_tiles > 0) {
+        A.disableTileCache();
+        B.disableTileCache();
+        C.disableTileCache();
+    }
 }
 
 } // namespace impl
@@ -258,6 +282,22 @@ void gemmA(
 ///           - HostNest:  nested OpenMP parallel for loop on CPU host.
 ///           - HostBatch: batched BLAS on CPU host.
 ///           - Devices:   batched BLAS on GPU device.
+///         - Option::HostWorkspaceTiles:
+///           Number of host workspace tiles to reserve, in pinned memory,
+///           for staging transfers to and from GPU devices. Default 0.
+///         - Option::DeviceCacheTiles:
+///           If > 0, max number of tiles per device for each matrix, using
+///           device memory as a least-recently-used tile cache, to handle
+///           matrices larger than device memory. Default 0.
+///         - Option::ComputePrecision:
+///           Compute mode of the gemm. Possible values:
+///           - Native: full precision [default].
+///           - TF32: single precision may use TF32 tensor cores on
+///             devices, rounding A and B to 11-bit significands.
+///           - Complex3M: complex precisions use the 3M algorithm, 3 real
+///             gemms per tile instead of 4 (25% fewer flops), on the host
+///             and, with cuBLAS, on devices. The error is bounded normwise,
+///             but small imaginary parts can lose relative accuracy.
 ///
 /// @ingroup gemm
 ///
@@ -268,7 +308,7 @@ void gemmA(
     scalar_t beta,  Matrix<scalar_t>& C,
     Options const& opts )
 {
-    Target target = get_option( opts, Option::Target, Target::HostTask );
+    Target target = get_target( opts, Target::HostTask );
 
     switch (target) {
         case Target::Host:
@@ -279,6 +319,7 @@ void gemmA(
             break;
 
         case Target::Devices:
+        case Target::Hybrid:
             impl::gemmA<Target::Devices>( alpha, A, B, beta, C, opts );
             break;
 
@@ -5,6 +5,7 @@
 
 #include "slate/slate.hh"
 #include "internal/internal.hh"
+#include "internal/internal_util.hh"
 
 #include <list>
 #include <tuple>
@@ -32,7 +33,8 @@ namespace impl {
 /// - bcast communications are serialized,
 /// - gemm operations are serialized,
 /// - bcasts can get ahead of gemms by the value of lookahead.
-/// ColMajor layout is assumed
+/// Computes in RowMajor if A, B, and C are all row-major,
+/// @see native_layout; otherwise in ColMajor.
 ///
 /// @ingroup gemm_impl
 ///
@@ -49,10 +51,15 @@ void gemmC(
 
     // Constants
     const scalar_t one = 1.0;
-    const Layout layout = Layout::ColMajor;
+    const Layout layout = internal::native_layout( target, A, B, C );
 
     // Options
-    int64_t lookahead = get_option<int64_t>( opts, Option::Lookahead, 1 );
+    int64_t lookahead = get_lookahead( opts );
+    int64_t host_ws = get_option<int64_t>( opts, Option::HostWorkspaceTiles, 0 );
+    int64_t cache_tiles = get_option<int64_t>( opts, Option::DeviceCacheTiles, 0 );
+    ComputePrecision compute_precision = get_option<Option::ComputePrecision>(
+                                             opts, ComputePrecision::Native );
+    bool bcast_packed = get_option<bool>( opts, Option::BcastPacked, false );
 
     // OpenMP needs pointer types, but vectors are exception safe
     std::vector<uint8_t> bcast_vector(A.nt());
@@ -67,8 +74,21 @@ void gemmC(
 
     if (target == Target::Devices) {
         C.allocateBatchArrays();
-        C.reserveDeviceWorkspace();
+        if (cache_tiles > 0) {
+            A.enableTileCache( cache_tiles );
+            B.enableTileCache( cache_tiles );
+            C.enableTileCache( cache_tiles );
+        }
+        else {
+            C.reserveDeviceWorkspace();
+        }
+        if (host_ws > 0) {
+            A.reserveHostWorkspace( host_ws );
+            B.reserveHostWorkspace( host_ws );
+        }
     }
+    // Also selects the host 3M gemm.
+    C.setComputePrecisions( compute_precision, 0, 1 );
 
     // set min number for omp nested active parallel regions
     slate::OmpSetMaxActiveLevels set_active_levels( MinOmpActiveLevels );
@@ -92,13 +112,19 @@ void gemmC(
             BcastListTag bcast_list_A;
             for (int64_t i = 0; i < A.mt(); ++i)
                 bcast_list_A.push_back({i, 0, {C.sub(i, i, 0, C.nt()-1)}, i});
-            A.template listBcastMT<target>(bcast_list_A, layout);
+            if (bcast_packed)
+                A.template listBcastPacked<target>( bcast_list_A, layout );
+            else
+                A.template listBcastMT<target>( bcast_list_A, layout );
 
             // broadcast B(0, j) to ranks owning block col C(:, j)
             BcastListTag bcast_list_B;
             for (int64_t j = 0; j < B.nt(); ++j)
                 bcast_list_B.push_back({0, j, {C.sub(0, C.mt()-1, j, j)}, j});
-            B.template listBcastMT<target>(bcast_list_B, layout);
+            if (bcast_packed)
+                B.template listBcastPacked<target>( bcast_list_B, layout );
+            else
+                B.template listBcastMT<target>( bcast_list_B, layout );
         }
 
         // send next lookahead block cols of A and block rows of B
@@ -110,13 +136,19 @@ void gemmC(
                 BcastListTag bcast_list_A;
                 for (int64_t i = 0; i < A.mt(); ++i)
                     bcast_list_A.push_back({i, k, {C.sub(i, i, 0, C.nt()-1)}, i});
-                A.template listBcastMT<target>(bcast_list_A, layout);
+                if (bcast_packed)
+                    A.template listBcastPacked<target>( bcast_list_A, layout );
+                else
+                    A.template listBcastMT<target>( bcast_list_A, layout );
 
                 // broadcast B(k, j) to ranks owning block col C(:, j)
                 BcastListTag bcast_list_B;
                 for (int64_t j = 0; j < B.nt(); ++j)
                     bcast_list_B.push_back({k, j, {C.sub(0, C.mt()-1, j, j)}, j});
-                B.template listBcastMT<target>(bcast_list_B, layout);
+                if (bcast_packed)
+                    B.template listBcastPacked<target>( bcast_list_B, layout );
+                else
+                    B.template listBcastMT<target>( bcast_list_B, layout );
             }
         }
 
@@ -157,7 +189,10 @@ void gemmC(
                         bcast_list_A.push_back(
                             {i, k+lookahead, {C.sub(i, i, 0, C.nt()-1)}, i});
                     }
-                    A.template listBcastMT<target>(bcast_list_A, layout);
+                    if (bcast_packed)
+                        A.template listBcastPacked<target>( bcast_list_A, layout );
+                    else
+                        A.template listBcastMT<target>( bcast_list_A, layout );
 
                     // broadcast B(k+la, j) to ranks owning block col C(:, j)
                     BcastListTag bcast_list_B;
@@ -165,7 +200,10 @@ void gemmC(
                         bcast_list_B.push_back(
                             {k+lookahead, j, {C.sub(0, C.mt()-1, j, j)}, j});
                     }
-                    B.template listBcastMT<target>(bcast_list_B, layout);
+                    if (bcast_packed)
+                        B.template listBcastPacked<target>( bcast_list_B, layout );
+                    else
+                        B.template listBcastMT<target>( bcast_list_B, layout );
                 }
             }
 
@@ -199,6 +237,13 @@ void gemmC(
         C.tileUpdateAllOrigin();
     }
     C.releaseWorkspace();
+    C.setComputePrecisions( ComputePrecision::Native, 0, 1 );
+
+    if (cache_tiles > 0) {
+        A.disableTileCache();
+        B.disableTileCache();
+        C.disableTileCache();
+    }
 }
 
 } // namespace impl
@@ -248,6 +293,22 @@ void gemmC(
 ///           - HostNest:  nested OpenMP parallel for loop on CPU host.
 ///           - HostBatch: batched BLAS on CPU host.
 ///           - Devices:   batched BLAS on GPU device.
+///         - Option::HostWorkspaceTiles:
+///           Number of host workspace tiles to reserve, in pinned memory,
+///           for staging transfers to and from GPU devices. Default 0.
+///         - Option::DeviceCacheTiles:
+///           If > 0, max number of tiles per device for each matrix, using
+///           device memory as a least-recently-used tile cache, to handle
+///           matrices larger than device memory. Default 0.
+///         - Option::ComputePrecision:
+///           Compute mode of the gemm. Possible values:
+///           - Native: full precision [default].
+///           - TF32: single precision may use TF32 tensor cores on
+///             devices, rounding A and B to 11-bit significands.
+///           - Complex3M: complex precisions use the 3M algorithm, 3 real
+///             gemms per tile instead of 4 (25% fewer flops), on the host
+///             and, with cuBLAS, on devices. The error is bounded normwise,
+///             but small imaginary parts can lose relative accuracy.
 ///
 /// @ingroup gemm
 ///
@@ -258,7 +319,7 @@ void gemmC(
     scalar_t beta,  Matrix<scalar_t>& C,
     Options const& opts)
 {
-    Target target = get_option( opts, Option::Target, Target::HostTask );
+    Target target = get_target( opts, Target::HostTask );
 
     switch (target) {
         case Target::Host:
@@ -275,6 +336,7 @@ void gemmC(
             break;
 
         case Target::Devices:
+        case Target::Hybrid:
             impl::gemmC<Target::Devices>( alpha, A, B, beta, C, opts );
             break;
     }
@@ -0,0 +1,371 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/slate.hh"
+#include "internal/internal.hh"
+
+#include <algorithm>
+#include <vector>
+
+namespace slate {
+
+namespace impl {
+
+//------------------------------------------------------------------------------
+/// @internal
+/// Broadcasts block column k of A[ g ] and block row k of B[ g ] of every
+/// problem g with more than k block columns of A, one problem after
+/// another, so the MPI tags of different problems never overlap.
+///
+/// @ingroup gemm_impl
+///
+template <Target target, typename scalar_t>
+void grouped_bcast(
+    int64_t k,
+    std::vector< Matrix<scalar_t> >& A,
+    std::vector< Matrix<scalar_t> >& B,
+    std::vector< Matrix<scalar_t> >& C,
+    bool bcast_packed, Layout layout )
+{
+    using BcastListTag = typename Matrix<scalar_t>::BcastListTag;
+
+    for (size_t g = 0; g < C.size(); ++g) {
+        if (k >= A[ g ].nt())
+            continue;
+
+        // broadcast A(i, k) to ranks owning block row C(i, :)
+        BcastListTag bcast_list_A;
+        for (int64_t i = 0; i < A[ g ].mt(); ++i) {
+            bcast_list_A.push_back(
+                {i, k, {C[ g ].sub( i, i, 0, C[ g ].nt()-1 )}, i});
+        }
+        if (bcast_packed)
+            A[ g ].template listBcastPacked<target>( bcast_list_A, layout );
+        else
+            A[ g ].template listBcastMT<target>( bcast_list_A, layout );
+
+        // broadcast B(k, j) to ranks owning block col C(:, j)
+        BcastListTag bcast_list_B;
+        for (int64_t j = 0; j < B[ g ].nt(); ++j) {
+            bcast_list_B.push_back(
+                {k, j, {C[ g ].sub( 0, C[ g ].mt()-1, j, j )}, j});
+        }
+        if (bcast_packed)
+            B[ g ].template listBcastPacked<target>( bcast_list_B, layout );
+        else
+            B[ g ].template listBcastMT<target>( bcast_list_B, layout );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// @internal
+/// Distributed parallel grouped general matrix-matrix multiplication.
+/// Generic implementation for any target.
+/// Runs the SUMMA steps of all problems jointly: step k broadcasts block
+/// column k of every A and block row k of every B, then multiplies them
+/// into every C, with the problems of a step as concurrent tasks.
+/// Dependencies enforce the following behavior:
+/// - bcast communications are serialized,
+/// - steps of gemm operations are serialized,
+/// - bcasts can get ahead of gemms by the value of lookahead.
+/// ColMajor layout is assumed
+///
+/// @ingroup gemm_impl
+///
+template <Target target, typename scalar_t>
+void gemmGrouped(
+    std::vector<scalar_t> const& alpha, std::vector< Matrix<scalar_t> >& A,
+                                        std::vector< Matrix<scalar_t> >& B,
+    std::vector<scalar_t> const& beta,  std::vector< Matrix<scalar_t> >& C,
+    Options const& opts )
+{
+    trace::Block gemm_block( "gemmGrouped" );
+
+    // Constants
+    const scalar_t one = 1.0;
+    const Layout layout = Layout::ColMajor;
+
+    // Options
+    int64_t lookahead = get_lookahead( opts );
+    int64_t host_ws = get_option<int64_t>( opts, Option::HostWorkspaceTiles, 0 );
+    ComputePrecision compute_precision = get_option<Option::ComputePrecision>(
+                                             opts, ComputePrecision::Native );
+    bool bcast_packed = get_option<bool>( opts, Option::BcastPacked, true );
+
+    int64_t group = C.size();
+
+    // Steps of the longest problem.
+    int64_t nt_max = 0;
+    for (int64_t g = 0; g < group; ++g)
+        nt_max = std::max( nt_max, A[ g ].nt() );
+
+    // OpenMP needs pointer types, but vectors are exception safe
+    std::vector<uint8_t> bcast_vector( nt_max );
+    std::vector<uint8_t> gemm_vector( nt_max );
+    std::vector<uint8_t> c_vector( 1 );
+    uint8_t* bcast = bcast_vector.data();
+    uint8_t* gemm  =  gemm_vector.data();
+    uint8_t* c     =     c_vector.data();
+    SLATE_UNUSED( bcast ); // Used only by OpenMP
+    SLATE_UNUSED( gemm  ); // Used only by OpenMP
+    SLATE_UNUSED( c     ); // Used only by OpenMP
+
+    if (target == Target::Devices) {
+        // Each C has its own batch arrays and queues, so the device
+        // batches of different problems run concurrently.
+        for (int64_t g = 0; g < group; ++g) {
+            C[ g ].allocateBatchArrays();
+            C[ g ].reserveDeviceWorkspace();
+            if (host_ws > 0) {
+                A[ g ].reserveHostWorkspace( host_ws );
+                B[ g ].reserveHostWorkspace( host_ws );
+            }
+        }
+    }
+    // Also selects the host 3M gemm.
+    for (int64_t g = 0; g < group; ++g)
+        C[ g ].setComputePrecisions( compute_precision, 0, 1 );
+
+    // set min number for omp nested active parallel regions
+    slate::OmpSetMaxActiveLevels set_active_levels( MinOmpActiveLevels );
+
+    #pragma omp parallel
+    #pragma omp master
+    {
+        if (target == Target::Devices) {
+            // fetch C matrix tiles into devices in parallel with first MPI broadcast
+            #pragma omp task depend(out:c[0])
+            {
+                trace::Block trace_block("fetch_C");
+                for (int64_t g = 0; g < group; ++g) {
+                    #pragma omp task
+                    {
+                        C[ g ].tileGetAllForWritingOnDevices(
+                            LayoutConvert( layout ) );
+                    }
+                }
+                #pragma omp taskwait
+            }
+        }
+
+        // send first lookahead+1 block cols of A and block rows of B
+        for (int64_t k = 0; k < lookahead+1 && k < nt_max; ++k) {
+            #pragma omp task depend(in:bcast[std::max(k-1, int64_t(0))]) \
+                             depend(out:bcast[k])
+            {
+                grouped_bcast<target>( k, A, B, C, bcast_packed, layout );
+            }
+        }
+
+        for (int64_t k = 0; k < nt_max; ++k) {
+
+            // send next block col of A and block row of B
+            if (k > 0 && k+lookahead < nt_max) {
+                #pragma omp task depend(in:gemm[k-1]) \
+                                 depend(in:bcast[k+lookahead-1]) \
+                                 depend(out:bcast[k+lookahead])
+                {
+                    grouped_bcast<target>(
+                        k+lookahead, A, B, C, bcast_packed, layout );
+                }
+            }
+
+            // multiply alpha A(:, k) B(k, :) + beta C, beta only at k = 0,
+            // for all problems concurrently
+            #pragma omp task depend(in:bcast[k]) \
+                             depend(in:c[0]) \
+                             depend(in:gemm[std::max(k-1, int64_t(0))]) \
+                             depend(out:gemm[k])
+            {
+                for (int64_t g = 0; g < group; ++g) {
+                    if (k >= A[ g ].nt())
+                        continue;
+
+                    #pragma omp task
+                    {
+                        internal::gemm<target>(
+                            alpha[ g ], A[ g ].sub( 0, A[ g ].mt()-1, k, k ),
+                                        B[ g ].sub( k, k, 0, B[ g ].nt()-1 ),
+                            (k == 0 ? beta[ g ] : one), std::move( C[ g ] ),
+                            layout );
+
+                        auto A_colblock = A[ g ].sub( 0, A[ g ].mt()-1, k, k );
+                        auto B_rowblock = B[ g ].sub( k, k, 0, B[ g ].nt()-1 );
+
+                        // Erase remote tiles on all devices including host
+                        A_colblock.releaseRemoteWorkspace();
+                        B_rowblock.releaseRemoteWorkspace();
+
+                        // Erase local workspace on devices.
+                        A_colblock.releaseLocalWorkspace();
+                        B_rowblock.releaseLocalWorkspace();
+                    }
+                }
+                #pragma omp taskwait
+            }
+        }
+        #pragma omp taskwait
+        for (int64_t g = 0; g < group; ++g)
+            C[ g ].tileUpdateAllOrigin();
+    }
+    for (int64_t g = 0; g < group; ++g) {
+        C[ g ].releaseWorkspace();
+        C[ g ].setComputePrecisions( ComputePrecision::Native, 0, 1 );
+    }
+}
+
+} // namespace impl
+
+//------------------------------------------------------------------------------
+/// Distributed parallel grouped general matrix-matrix multiplication.
+/// Performs the matrix-matrix operations
+/// \[
+///     C_g = \alpha_g A_g B_g + \beta_g C_g,
+/// \]
+/// for g = 0, ..., group-1, where $A_g$ is an $m_g$-by-$k_g$ matrix,
+/// $B_g$ a $k_g$-by-$n_g$ matrix, and $C_g$ an $m_g$-by-$n_g$ matrix.
+/// The problems are independent and may differ in size, but all matrices
+/// must be on the same MPI communicator, and the inner dimension $k_g$
+/// must be positive.
+///
+/// Unlike a loop over gemm, the SUMMA steps of all problems run in one
+/// OpenMP parallel region: step k broadcasts block column k of every
+/// $A_g$ and block row k of every $B_g$, then updates every $C_g$
+/// concurrently, so many medium problems fill the machine as one large
+/// gemm would.
+///
+//------------------------------------------------------------------------------
+/// @tparam scalar_t
+///         One of float, double, std::complex<float>, std::complex<double>.
+//------------------------------------------------------------------------------
+/// @param[in] alpha
+///         Vector of group scalars alpha.
+///
+/// @param[in] A
+///         Vector of group matrices; A[ g ] is $m_g$-by-$k_g$.
+///
+/// @param[in] B
+///         Vector of group matrices; B[ g ] is $k_g$-by-$n_g$.
+///
+/// @param[in] beta
+///         Vector of group scalars beta.
+///
+/// @param[in,out] C
+///         Vector of group matrices; on entry, C[ g ] is $m_g$-by-$n_g$.
+///         On exit, overwritten by $\alpha_g A_g B_g + \beta_g C_g$.
+///
+/// @param[in] opts
+///         Additional options, as map of name = value pairs. Possible options:
+///         - Option::Lookahead:
+///           Number of steps to overlap communication and computation.
+///           lookahead >= 0. Default 1.
+///         - Option::Target:
+///           Implementation to target. Possible values:
+///           - HostTask:  OpenMP tasks on CPU host [default].
+///           - HostNest:  nested OpenMP parallel for loop on CPU host.
+///           - HostBatch: batched BLAS on CPU host.
+///           - Devices:   batched BLAS on GPU device.
+///         - Option::BcastPacked:
+///           Whether each step sends the tiles of each matrix to the same
+///           rank in one message. Default true.
+///         - Option::HostWorkspaceTiles:
+///           Number of host workspace tiles to reserve, in pinned memory,
+///           for staging transfers to and from GPU devices. Default 0.
+///         - Option::ComputePrecision:
+///           Compute mode of the gemm. Possible values:
+///           - Native: full precision [default].
+///           - TF32: single precision may use TF32 tensor cores on
+///             devices, rounding A and B to 11-bit significands.
+///           - Complex3M: complex precisions use the 3M algorithm, 3 real
+///             gemms per tile instead of 4 (25% fewer flops), on the host
+///             and, with cuBLAS, on devices. The error is bounded normwise,
+///             but small imaginary parts can lose relative accuracy.
+///
+/// @ingroup gemm
+///
+template <typename scalar_t>
+void gemmGrouped(
+    std::vector<scalar_t> const& alpha, std::vector< Matrix<scalar_t> >& A,
+                                        std::vector< Matrix<scalar_t> >& B,
+    std::vector<scalar_t> const& beta,  std::vector< Matrix<scalar_t> >& C,
+    Options const& opts)
+{
+    size_t group = C.size();
+    slate_error_if( A.size() != group );
+    slate_error_if( B.size() != group );
+    slate_error_if( alpha.size() != group );
+    slate_error_if( beta.size() != group );
+    if (group == 0)
+        return;
+
+    MPI_Comm mpi_comm = C[ 0 ].mpiComm();
+    for (size_t g = 0; g < group; ++g) {
+        slate_error_if( A[ g ].mt() != C[ g ].mt() );
+        slate_error_if( B[ g ].nt() != C[ g ].nt() );
+        slate_error_if( A[ g ].nt() != B[ g ].mt() );
+        slate_error_if( A[ g ].mpiComm() != mpi_comm );
+        slate_error_if( B[ g ].mpiComm() != mpi_comm );
+        slate_error_if( C[ g ].mpiComm() != mpi_comm );
+        slate_error_if( A[ g ].nt() == 0 );
+    }
+
+    Target target = get_target( opts, Target::HostTask );
+
+    switch (target) {
+        case Target::Host:
+        case Target::HostTask:
+            impl::gemmGrouped<Target::HostTask>( alpha, A, B, beta, C, opts );
+            break;
+
+        case Target::HostNest:
+            impl::gemmGrouped<Target::HostNest>( alpha, A, B, beta, C, opts );
+            break;
+
+        case Target::HostBatch:
+            impl::gemmGrouped<Target::HostBatch>( alpha, A, B, beta, C, opts );
+            break;
+
+        case Target::Devices:
+        case Target::Hybrid:
+            impl::gemmGrouped<Target::Devices>( alpha, A, B, beta, C, opts );
+            break;
+    }
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void gemmGrouped<float>(
+    std::vector<float> const& alpha, std::vector< Matrix<float> >& A,
+                                     std::vector< Matrix<float> >& B,
+    std::vector<float> const& beta,  std::vector< Matrix<float> >& C,
+    Options const& opts);
+
+template
+void gemmGrouped<double>(
+    std::vector<double> const& alpha, std::vector< Matrix<double> >& A,
+                                      std::vector< Matrix<double> >& B,
+    std::vector<double> const& beta,  std::vector< Matrix<double> >& C,
+    Options const& opts);
+
+template
+void gemmGrouped< std::complex<float> >(
+    std::vector< std::complex<float> > const& alpha,
+    std::vector< Matrix< std::complex<float> > >& A,
+    std::vector< Matrix< std::complex<float> > >& B,
+    std::vector< std::complex<float> > const& beta,
+    std::vector< Matrix< std::complex<float> > >& C,
+    Options const& opts);
+
+template
+void gemmGrouped< std::complex<double> >(
+    std::vector< std::complex<double> > const& alpha,
+    std::vector< Matrix< std::complex<double> > >& A,
+    std::vector< Matrix< std::complex<double> > >& B,
+    std::vector< std::complex<double> > const& beta,
+    std::vector< Matrix< std::complex<double> > >& C,
+    Options const& opts);
+
+} // namespace slate
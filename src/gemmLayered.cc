@@ -0,0 +1,275 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/slate.hh"
+#include "internal/internal.hh"
+
+#include <cmath>
+#include <vector>
+
+namespace slate {
+
+namespace impl {
+
+//------------------------------------------------------------------------------
+/// @internal
+/// @return an empty matrix with block sizes mb and nb, distributed
+/// 2D cyclic on the p-by-q grid of ranks [ rank0, rank0 + p*q ) of mpi_comm.
+/// Local tiles are distributed over devices as in the default distribution.
+///
+/// @ingroup gemm_impl
+///
+template <typename scalar_t>
+Matrix<scalar_t> layer_matrix(
+    std::vector<int64_t> const& mb, std::vector<int64_t> const& nb,
+    int rank0, int p, int q, int num_devices, MPI_Comm mpi_comm )
+{
+    using ij_tuple = typename BaseMatrix<scalar_t>::ij_tuple;
+
+    int64_t m = 0, n = 0;
+    for (int64_t mb_i : mb)
+        m += mb_i;
+    for (int64_t nb_j : nb)
+        n += nb_j;
+
+    std::function<int64_t (int64_t)> tileMb = [mb]( int64_t i ) {
+        return mb[ i ];
+    };
+    std::function<int64_t (int64_t)> tileNb = [nb]( int64_t j ) {
+        return nb[ j ];
+    };
+    std::function<int (ij_tuple)> tileRank = [rank0, p, q]( ij_tuple ij ) {
+        int64_t i = std::get<0>( ij );
+        int64_t j = std::get<1>( ij );
+        return int( rank0 + i%p + (j%q)*p );
+    };
+    std::function<int (ij_tuple)> tileDevice;
+    if (num_devices > 0) {
+        tileDevice = func::device_1d_grid( GridOrder::Row, q, num_devices );
+    }
+    else {
+        tileDevice = []( ij_tuple ij ) {
+            return HostNum;
+        };
+    }
+    return Matrix<scalar_t>( m, n, tileMb, tileNb, tileRank, tileDevice,
+                             mpi_comm );
+}
+
+//------------------------------------------------------------------------------
+/// @internal
+/// @return the number of layers for nranks ranks: the largest c dividing
+/// nranks with c^3 <= nranks, so each layer is a grid of at least c^2 ranks.
+///
+/// @ingroup gemm_impl
+///
+inline int default_layers( int nranks )
+{
+    int c = 1;
+    for (int d = 2; int64_t( d )*d*d <= nranks; ++d) {
+        if (nranks % d == 0)
+            c = d;
+    }
+    return c;
+}
+
+} // namespace impl
+
+//------------------------------------------------------------------------------
+/// Distributed parallel general matrix-matrix multiplication,
+/// 2.5D (communication-avoiding) variant.
+/// Performs the matrix-matrix operation
+/// \[
+///     C = \alpha A B + \beta C,
+/// \]
+/// where alpha and beta are scalars, and $A$, $B$, and $C$ are matrices, with
+/// $A$ an m-by-k matrix, $B$ a k-by-n matrix, and $C$ an m-by-n matrix.
+///
+/// The P ranks of C's communicator are split into c layers of
+/// P/c consecutive ranks, each a 2D grid. Layer l gets the l-th of c block
+/// column slices of A and block row slices of B, computes
+/// $C_l = \alpha A_l B_l$ with the SUMMA gemmC on its own grid, and the
+/// $C_l$ are then summed into $\beta C$. Each layer does 1/c of the k steps
+/// on a grid with $\sqrt{c}$ times fewer ranks per row and column, so the
+/// panel broadcasts move $\sqrt{c}$ times less data per rank than gemmC on
+/// all P ranks, at the cost of redistributing the inputs and reducing C.
+/// The extra memory per rank is about $(c + 1) m n / P$ for the $C_l$ and
+/// the reduction buffer, plus $(m k + k n) / P$ for the slices of A and B.
+/// This pays off at large P, when gemmC is bound by the broadcasts.
+///
+/// All ranks in C's MPI communicator must call it,
+/// and A, B, and C must use that same communicator.
+///
+/// Complexity (in real): $2 m n k$ flops.
+///
+//------------------------------------------------------------------------------
+/// @tparam scalar_t
+///         One of float, double, std::complex<float>, std::complex<double>.
+//------------------------------------------------------------------------------
+/// @param[in] alpha
+///         The scalar alpha.
+///
+/// @param[in] A
+///         The m-by-k matrix A.
+///
+/// @param[in] B
+///         The k-by-n matrix B.
+///
+/// @param[in] beta
+///         The scalar beta.
+///
+/// @param[in,out] C
+///         On entry, the m-by-n matrix C.
+///         On exit, overwritten by the result $\alpha A B + \beta C$.
+///
+/// @param[in] opts
+///         Additional options, as map of name = value pairs. Possible options:
+///         - Option::Layers:
+///           Number of layers c, dividing the number of ranks P.
+///           Default 0: the largest such c with c^3 <= P.
+///           If larger than the number of block columns of A, it is reduced
+///           to the largest divisor of P that is not.
+///           If c = 1, this is gemmC.
+///         - Options of gemmC, used by each layer.
+///
+/// @ingroup gemm
+///
+template <typename scalar_t>
+void gemmLayered(
+    scalar_t alpha, Matrix<scalar_t>& A,
+                    Matrix<scalar_t>& B,
+    scalar_t beta,  Matrix<scalar_t>& C,
+    Options const& opts )
+{
+    trace::Block trace_block( "slate::gemmLayered" );
+
+    const scalar_t zero = 0.0, one = 1.0;
+
+    slate_assert( A.mt() == C.mt() );
+    slate_assert( B.nt() == C.nt() );
+    slate_assert( A.nt() == B.mt() );
+
+    MPI_Comm mpi_comm = C.mpiComm();
+    int mpi_rank = C.mpiRank();
+    int nranks;
+    slate_mpi_call(
+        MPI_Comm_size( mpi_comm, &nranks ) );
+
+    int64_t layers = get_option<int64_t>( opts, Option::Layers, 0 );
+    if (layers == 0)
+        layers = impl::default_layers( nranks );
+    if (layers < 1 || nranks % layers != 0)
+        slate_error( "gemmLayered: layers must divide the number of ranks" );
+    // At most one layer per block column of A, still dividing nranks.
+    while (layers > A.nt() || nranks % layers != 0)
+        --layers;
+
+    if (layers <= 1) {
+        gemmC( alpha, A, B, beta, C, opts );
+        return;
+    }
+
+    // Grid of each layer, p_l <= q_l, as square as possible.
+    int layer_size = nranks / layers;
+    int p_l = int( std::sqrt( double( layer_size ) ) );
+    while (layer_size % p_l != 0)
+        --p_l;
+    int q_l = layer_size / p_l;
+    int my_layer = mpi_rank / layer_size;
+
+    std::vector<int64_t> mb( C.mt() ), nb( C.nt() );
+    for (int64_t i = 0; i < C.mt(); ++i)
+        mb[ i ] = C.tileMb( i );
+    for (int64_t j = 0; j < C.nt(); ++j)
+        nb[ j ] = C.tileNb( j );
+
+    // Slice l of k has block columns [ k_begin[ l ], k_begin[ l+1 ] ) of A.
+    int64_t kt = A.nt();
+    std::vector<int64_t> k_begin( layers + 1 );
+    for (int64_t l = 0; l <= layers; ++l)
+        k_begin[ l ] = l * kt / layers;
+
+    // Redistribute the slices of A and B onto their layers. All ranks take
+    // part in each redistribute, sending the tiles they own.
+    std::vector< Matrix<scalar_t> > A_layers, B_layers, C_layers;
+    for (int64_t l = 0; l < layers; ++l) {
+        int64_t k1 = k_begin[ l ];
+        int64_t k2 = k_begin[ l+1 ] - 1;
+        std::vector<int64_t> kb( k2 - k1 + 1 );
+        for (int64_t k = k1; k <= k2; ++k)
+            kb[ k - k1 ] = A.tileNb( k );
+
+        int rank0 = l * layer_size;
+        A_layers.push_back( impl::layer_matrix<scalar_t>(
+            mb, kb, rank0, p_l, q_l, C.num_devices(), mpi_comm ) );
+        B_layers.push_back( impl::layer_matrix<scalar_t>(
+            kb, nb, rank0, p_l, q_l, C.num_devices(), mpi_comm ) );
+        C_layers.push_back( impl::layer_matrix<scalar_t>(
+            mb, nb, rank0, p_l, q_l, C.num_devices(), mpi_comm ) );
+        A_layers[ l ].insertLocalTiles();
+        B_layers[ l ].insertLocalTiles();
+        C_layers[ l ].insertLocalTiles();
+
+        auto A_slice = A.sub( 0, A.mt()-1, k1, k2 );
+        auto B_slice = B.sub( k1, k2, 0, B.nt()-1 );
+        redistribute( A_slice, A_layers[ l ], opts );
+        redistribute( B_slice, B_layers[ l ], opts );
+    }
+
+    // Each layer multiplies its slices, concurrently with the other layers.
+    // Its ranks are disjoint from the other layers', so gemmC on one layer
+    // does not communicate with ranks outside it.
+    gemmC( alpha, A_layers[ my_layer ], B_layers[ my_layer ],
+           zero,  C_layers[ my_layer ], opts );
+
+    // Free the slices before the reduction.
+    A_layers.clear();
+    B_layers.clear();
+
+    // Sum the layers' contributions into C, one layer at a time
+    // through a buffer W distributed like C.
+    auto W = C.emptyLike();
+    W.insertLocalTiles();
+    for (int64_t l = 0; l < layers; ++l) {
+        redistribute( C_layers[ l ], W, opts );
+        C_layers[ l ] = Matrix<scalar_t>();
+        if (l == 0 && beta == zero)
+            slate::copy( W, C, opts );
+        else
+            add( one, W, (l == 0 ? beta : one), C, opts );
+    }
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void gemmLayered<float>(
+    float alpha, Matrix<float>& A,
+                 Matrix<float>& B,
+    float beta,  Matrix<float>& C,
+    Options const& opts);
+
+template
+void gemmLayered<double>(
+    double alpha, Matrix<double>& A,
+                  Matrix<double>& B,
+    double beta,  Matrix<double>& C,
+    Options const& opts);
+
+template
+void gemmLayered< std::complex<float> >(
+    std::complex<float> alpha, Matrix< std::complex<float> >& A,
+                               Matrix< std::complex<float> >& B,
+    std::complex<float> beta,  Matrix< std::complex<float> >& C,
+    Options const& opts);
+
+template
+void gemmLayered< std::complex<double> >(
+    std::complex<double> alpha, Matrix< std::complex<double> >& A,
+                                Matrix< std::complex<double> >& B,
+    std::complex<double> beta,  Matrix< std::complex<double> >& C,
+    Options const& opts);
+
+} // namespace slate
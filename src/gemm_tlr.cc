@@ -0,0 +1,202 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/slate.hh"
+#include "internal/internal.hh"
+
+#include <algorithm>
+#include <set>
+#include <vector>
+
+namespace slate {
+
+//------------------------------------------------------------------------------
+/// Distributed parallel matrix-matrix multiplication with a tile low-rank
+/// (TLR) matrix. Performs the matrix-matrix operation
+/// \[
+///     C = \alpha A B + \beta C,
+/// \]
+/// where alpha and beta are scalars, A is an n-by-n Hermitian TLR matrix,
+/// and B and C are n-by-nrhs matrices.
+///
+/// As in gemmC, step k broadcasts block column k of A along the block rows
+/// of C and block row k of B along the block columns of C, then updates C.
+/// Off-diagonal tiles of A are broadcast and applied in low-rank form,
+/// e.g., $C_{il} = C_{il} + \alpha U_{ik} (V_{ik}^H B_{kl})$, for
+/// $O( (mb + nb) r\, nrhs )$ instead of $O( mb\, nb\, nrhs )$ flops
+/// per tile of rank r. Tiles $A_{ik}$, i < k, are applied as
+/// $A_{ki}^H = V_{ki} U_{ki}^H$.
+///
+//------------------------------------------------------------------------------
+/// @tparam scalar_t
+///         One of float, double, std::complex<float>, std::complex<double>.
+//------------------------------------------------------------------------------
+/// @param[in] alpha
+///         The scalar alpha.
+///
+/// @param[in] A
+///         The n-by-n Hermitian TLR matrix A, e.g., from compress().
+///
+/// @param[in] B
+///         The n-by-nrhs matrix B, with the same block rows as A.
+///
+/// @param[in] beta
+///         The scalar beta.
+///
+/// @param[in,out] C
+///         On entry, the n-by-nrhs matrix C, with the same tiles as B.
+///         On exit, overwritten by the result $\alpha A B + \beta C$.
+///
+/// @param[in] opts
+///         Additional options, as map of name = value pairs.
+///         Currently unused; the multiplication is done on the host.
+///
+/// @ingroup gemm
+///
+template <typename scalar_t>
+void gemm(
+    scalar_t alpha, TLRMatrix<scalar_t>& A,
+                       Matrix<scalar_t>& B,
+    scalar_t beta,     Matrix<scalar_t>& C,
+    Options const& opts )
+{
+    trace::Block trace_block( "slate::gemm" );
+
+    using ij_tuple = typename BaseMatrix<scalar_t>::ij_tuple;
+    using BcastListA = typename TLRMatrix<scalar_t>::BcastList;
+    using BcastListB = typename Matrix<scalar_t>::BcastList;
+
+    const scalar_t zero = 0.0, one = 1.0;
+
+    slate_assert( A.nt() == B.mt() );
+    slate_assert( A.nt() == C.mt() );
+    slate_assert( B.nt() == C.nt() );
+    slate_assert( B.op() == Op::NoTrans );
+    slate_assert( C.op() == Op::NoTrans );
+
+    auto& D = A.diag();
+    int64_t nt = A.nt();
+    int64_t C_mt = C.mt();
+    int64_t C_nt = C.nt();
+
+    std::vector<ij_tuple> local;
+    for (int64_t i = 0; i < C_mt; ++i) {
+        for (int64_t l = 0; l < C_nt; ++l) {
+            if (C.tileIsLocal( i, l ))
+                local.push_back( { i, l } );
+        }
+    }
+
+    for (int64_t k = 0; k < nt; ++k) {
+        scalar_t beta_k = k == 0 ? beta : one;
+
+        // Send block column k of A to the ranks of the block rows of C,
+        // with A_ik stored as tile (k, i) for i < k, and
+        // block row k of B to the ranks of the block columns of C.
+        D.tileBcast( k, k, C.sub( k, k, 0, C_nt-1 ), Layout::ColMajor );
+
+        BcastListA bcast_list_A;
+        for (int64_t i = 0; i < nt; ++i) {
+            if (i == k)
+                continue;
+            std::set<int> ranks;
+            for (int64_t l = 0; l < C_nt; ++l)
+                ranks.insert( C.tileRank( i, l ) );
+            bcast_list_A.push_back( { std::max( i, k ), std::min( i, k ),
+                                      ranks } );
+        }
+        A.listBcast( bcast_list_A );
+
+        BcastListB bcast_list_B;
+        for (int64_t l = 0; l < C_nt; ++l)
+            bcast_list_B.push_back( { k, l, { C.sub( 0, C_mt-1, l, l ) } } );
+        B.listBcast( bcast_list_B, Layout::ColMajor );
+
+        if (D.tileExists( k, k ))
+            D.tileGetForReading( k, k, LayoutConvert::ColMajor );
+
+        #pragma omp parallel for schedule( dynamic, 1 )
+        for (size_t t = 0; t < local.size(); ++t) {
+            int64_t i = std::get<0>( local[ t ] );
+            int64_t l = std::get<1>( local[ t ] );
+
+            B.tileGetForReading( k, l, LayoutConvert::ColMajor );
+            C.tileGetForWriting( i, l, LayoutConvert::ColMajor );
+            auto Bkl = B( k, l );
+            auto Cil = C( i, l );
+
+            if (i == k) {
+                // Dense diagonal tile.
+                auto Akk = D( k, k );
+                blas::hemm( blas::Layout::ColMajor, Side::Left, Uplo::Lower,
+                            Cil.mb(), Cil.nb(),
+                            alpha,  Akk.data(), Akk.stride(),
+                                    Bkl.data(), Bkl.stride(),
+                            beta_k, Cil.data(), Cil.stride() );
+                continue;
+            }
+
+            // A_ik = Y Z^H, with Y = U_ik, Z = V_ik for i > k,
+            // or Y = V_ki, Z = U_ki for i < k.
+            bool lower = i > k;
+            auto& At = lower ? A.tile( i, k ) : A.tile( k, i );
+            scalar_t const* Y = lower ? At.U() : At.V();
+            scalar_t const* Z = lower ? At.V() : At.U();
+            int64_t ldy = lower ? At.ldu() : At.ldv();
+            int64_t ldz = lower ? At.ldv() : At.ldu();
+            int64_t r = At.rank();
+
+            // W = Z^H B_kl, then C_il = alpha Y W + beta_k C_il.
+            // With r = 0, this only scales C_il.
+            int64_t ldw = std::max( r, int64_t( 1 ) );
+            std::vector<scalar_t> W( ldw * Cil.nb() );
+            blas::gemm( blas::Layout::ColMajor, Op::ConjTrans, Op::NoTrans,
+                        r, Cil.nb(), Bkl.mb(),
+                        one,  Z, ldz,
+                              Bkl.data(), Bkl.stride(),
+                        zero, W.data(), ldw );
+            blas::gemm( blas::Layout::ColMajor, Op::NoTrans, Op::NoTrans,
+                        Cil.mb(), Cil.nb(), r,
+                        alpha,  Y, ldy,
+                                W.data(), ldw,
+                        beta_k, Cil.data(), Cil.stride() );
+        }
+
+        B.sub( k, k, 0, C_nt-1 ).releaseRemoteWorkspace();
+        A.releaseRemoteTiles();
+    }
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void gemm<float>(
+    float alpha, TLRMatrix<float>& A,
+                    Matrix<float>& B,
+    float beta,     Matrix<float>& C,
+    Options const& opts);
+
+template
+void gemm<double>(
+    double alpha, TLRMatrix<double>& A,
+                     Matrix<double>& B,
+    double beta,     Matrix<double>& C,
+    Options const& opts);
+
+template
+void gemm< std::complex<float> >(
+    std::complex<float> alpha, TLRMatrix< std::complex<float> >& A,
+                                  Matrix< std::complex<float> >& B,
+    std::complex<float> beta,     Matrix< std::complex<float> >& C,
+    Options const& opts);
+
+template
+void gemm< std::complex<double> >(
+    std::complex<double> alpha, TLRMatrix< std::complex<double> >& A,
+                                   Matrix< std::complex<double> >& B,
+    std::complex<double> beta,     Matrix< std::complex<double> >& C,
+    Options const& opts);
+
+} // namespace slate
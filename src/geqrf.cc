@@ -8,11 +8,91 @@
 #include "slate/Matrix.hh"
 #include "internal/internal.hh"
 #include "internal/internal_util.hh"
+#include "slate/internal/Hybrid.hh"
+#include "slate/internal/TaskGraph.hh"
+#include "slate/Tuning.hh"
+
+#include "lapack/flops.hh"
 
 namespace slate {
 
 namespace impl {
 
+//------------------------------------------------------------------------------
+/// Applies the local reflectors of panel k of geqrf with Target::Hybrid
+/// to the trailing submatrix A(k:mt-1, j0:nt-1), with block-columns
+/// j0, ..., s-1 updated on the devices, and s, ..., nt-1 on the host,
+/// while the devices run. The split s balances the local flops by the
+/// rates measured by hybrid. The triangle-triangle reductions after it
+/// stay on the devices, since they communicate.
+/// @ingroup geqrf_impl
+///
+template <typename scalar_t>
+void geqrf_trailing_hybrid(
+    Matrix<scalar_t>& A, Matrix<scalar_t>& Tlocal, Matrix<scalar_t>& W,
+    int64_t k, int64_t j0,
+    internal::HybridSplit& hybrid, int priority, int64_t queue_index )
+{
+    int64_t A_mt = A.mt();
+    int64_t A_nt = A.nt();
+
+    // Local flops of each block-column.
+    std::vector<double> flops( A_nt - j0, 0.0 );
+    int64_t nbk = A.tileNb( k );
+    for (int64_t j = j0; j < A_nt; ++j) {
+        for (int64_t i = k; i < A_mt; ++i) {
+            if (A.tileIsLocal( i, j )) {
+                flops[ j - j0 ] += lapack::Gflop<scalar_t>::unmqr(
+                    Side::Left, A.tileMb( i ), A.tileNb( j ), nbk ) * 1e9;
+            }
+        }
+    }
+    int64_t s = j0 + hybrid.split( flops );
+    double host_flops = 0;
+    for (int64_t j = s; j < A_nt; ++j)
+        host_flops += flops[ j - j0 ];
+    double device_flops = 0;
+    for (int64_t j = j0; j < s; ++j)
+        device_flops += flops[ j - j0 ];
+
+    double device_time = 0;
+    if (s > j0) {
+        #pragma omp task shared( A, Tlocal, W, device_time ) \
+            firstprivate( k, j0, s, A_mt, priority, queue_index )
+        {
+            double time = omp_get_wtime();
+
+            internal::unmqr<Target::Devices>(
+                Side::Left, Op::ConjTrans,
+                A.sub( k, A_mt-1, k, k ),
+                Tlocal.sub( k, A_mt-1, k, k ),
+                A.sub( k, A_mt-1, j0, s-1 ),
+                W.sub( k, A_mt-1, j0, s-1 ),
+                priority, queue_index );
+
+            device_time = omp_get_wtime() - time;
+        }
+    }
+
+    double host_time = 0;
+    if (s < A_nt) {
+        double time = omp_get_wtime();
+
+        internal::unmqr<Target::HostTask>(
+            Side::Left, Op::ConjTrans,
+            A.sub( k, A_mt-1, k, k ),
+            Tlocal.sub( k, A_mt-1, k, k ),
+            A.sub( k, A_mt-1, s, A_nt-1 ),
+            W.sub( k, A_mt-1, s, A_nt-1 ),
+            priority, queue_index );
+
+        host_time = omp_get_wtime() - time;
+    }
+    #pragma omp taskwait
+
+    hybrid.done( host_flops, host_time, device_flops, device_time );
+}
+
 //------------------------------------------------------------------------------
 /// Distributed parallel QR factorization.
 /// Generic implementation for any target.
@@ -37,13 +117,27 @@ void geqrf(
     const int priority_1 = 1;
     // Assumes column major
     const Layout layout = Layout::ColMajor;
+    // Triangle-triangle reductions run on devices or on the host.
+    const Target target_tt = (target == Target::Devices ? Target::Devices
+                                                         : Target::HostTask);
 
     // Options
-    int64_t lookahead = get_option<int64_t>( opts, Option::Lookahead, 1 );
-    int64_t ib = get_option<int64_t>( opts, Option::InnerBlocking, 16 );
+    ResolvedOptions const ropts( opts );
+    int64_t lookahead = get_lookahead( opts );
+    int64_t ib = ropts.get<Option::InnerBlocking>( 16 );
+    QueuePriority queue_priority = ropts.get<Option::QueuePriority>(
+                                       QueuePriority::Lookahead );
+    Counters* counters = ropts.get<Option::Counters>( nullptr );
+    PanelCallback* panel_callback = ropts.get<Option::PanelCallback>( nullptr );
     int64_t max_panel_threads  = std::max(omp_get_max_threads()/2, 1);
-    max_panel_threads = get_option<int64_t>( opts, Option::MaxPanelThreads,
-                                             max_panel_threads );
+    max_panel_threads = ropts.get<Option::MaxPanelThreads>( max_panel_threads );
+    int64_t arity = ropts.get<Option::TreeArity>( 2 );
+    if (arity < 2)
+        slate_error( "geqrf: TreeArity must be >= 2" );
+    // With Hybrid, the host updates part of each trailing submatrix.
+    internal::HybridSplit hybrid(
+        target == Target::Devices
+        && ropts.get<Option::Target>( target ) == Target::Hybrid );
 
     int64_t A_mt = A.mt();
     int64_t A_nt = A.nt();
@@ -69,8 +163,16 @@ void geqrf(
         const int64_t batch_size_default = 0; // use default batch size
         int num_queues = 3 + lookahead;
         A.allocateBatchArrays( batch_size_default, num_queues );
-        A.reserveDeviceWorkspace();
+        // Reserve the planned workspace once, up front.
+        plan::Workspace workspace = plan::geqrf( A, opts, target );
+        A.reserveDeviceWorkspace( workspace.device_tiles );
+        if (workspace.host_tiles > 0)
+            A.reserveHostWorkspace( workspace.host_tiles );
         W.allocateBatchArrays( batch_size_default, num_queues );
+        // Lookahead columns use queues 2, ..., 1 + lookahead;
+        // the trailing update queue 2 + lookahead.
+        A.setComputeQueuePriorities( queue_priority, 2, 2 + lookahead );
+        W.setComputeQueuePriorities( queue_priority, 2, 2 + lookahead );
         // todo: this is demanding too much device workspace memory
         // only one tile-row of matrix W per MPI process is going to be used,
         // but W with size of whole A is being allocated
@@ -130,6 +232,15 @@ void geqrf(
     std::vector< uint8_t > block_vector(A_nt);
     uint8_t* block = block_vector.data();
     SLATE_UNUSED( block ); // Used only by OpenMP
+    uint8_t callback_dep;
+    SLATE_UNUSED( callback_dep ); // Used only by OpenMP
+
+    // Blocks of block columns of the trailing update, one task each.
+    // Devices update it in one task, batched on one queue.
+    int64_t trailing_block = ropts.get<Option::TrailingBlock>( 1 );
+    if (target == Target::Devices)
+        trailing_block = A_nt;
+    internal::ColumnBlocks blocks( A_nt, trailing_block );
 
     // set min number for omp nested active parallel regions
     slate::OmpSetMaxActiveLevels set_active_levels( MinOmpActiveLevels );
@@ -149,21 +260,31 @@ void geqrf(
             // panel, high priority
             #pragma omp task depend(inout:block[k]) priority(1)
             {
-                // local panel factorization
-                internal::geqrf<target>(
-                                std::move(A_panel),
-                                std::move(Tl_panel),
-                                dwork_array, work_size,
-                                ib, max_panel_threads, priority_1 );
+                trace::Block trace_block( "geqrf::panel", k );
+                {
+                    internal::CounterPhase c_panel(
+                        counters, "geqrf::panel",
+                        lapack::Gflop<scalar_t>::geqrf(
+                            A_panel.m(), A_panel.n() ) * 1e9 );
 
-                // triangle-triangle reductions
-                // ttqrt handles tile transfers internally
-                internal::ttqrt<Target::HostTask>(
-                                std::move(A_panel),
-                                std::move(Tr_panel) );
+                    // local panel factorization
+                    internal::geqrf<target>(
+                                    std::move(A_panel),
+                                    std::move(Tl_panel),
+                                    dwork_array, work_size,
+                                    ib, max_panel_threads, priority_1 );
+
+                    // triangle-triangle reductions
+                    // ttqrt handles tile transfers internally
+                    internal::ttqrt<target_tt>(
+                                    A.sub(k, A_mt-1, k, k),
+                                    Treduce.sub(k, A_mt-1, k, k), arity );
+                }
 
                 // if a trailing matrix exists
                 if (k < A_nt-1) {
+                    trace::Block trace_block_bcast( "geqrf::bcast", k );
+                    internal::CounterPhase c_bcast( counters, "geqrf::bcast" );
 
                     // bcast V across row for trailing matrix update
                     if (k < A_mt) {
@@ -204,6 +325,13 @@ void geqrf(
                                  depend(inout:block[j]) \
                                  priority(1)
                 {
+                    trace::Block trace_block( "geqrf::lookahead", k );
+                    internal::CounterPhase c_update(
+                        counters, "geqrf::update",
+                        lapack::Gflop<scalar_t>::unmqr(
+                            Side::Left, A_trail_j.m(), A_trail_j.n(),
+                            A_panel.n() ) * 1e9 );
+
                     // Apply local reflectors
                     int queue_jk1 = j-k+1;
                     internal::unmqr<target>(
@@ -217,43 +345,62 @@ void geqrf(
                     // Apply triangle-triangle reduction reflectors
                     // ttmqr handles the tile broadcasting internally
                     int tag_j = j;
-                    internal::ttmqr<Target::HostTask>(
+                    internal::ttmqr<target_tt>(
                                     Side::Left, Op::ConjTrans,
                                     std::move(A_panel),
                                     std::move(Tr_panel),
                                     std::move(A_trail_j),
-                                    tag_j );
+                                    tag_j, queue_jk1, arity );
                 }
             }
 
-            // update trailing submatrix, normal priority
-            if (k+1+lookahead < A_nt) {
-                int64_t j = k+1+lookahead;
-                auto A_trail_j = A.sub(k, A_mt-1, j, A_nt-1);
+            // update trailing submatrix, normal priority,
+            // one task per block of block columns
+            for (int64_t c = blocks.block( k+1+lookahead );
+                 k+1+lookahead < A_nt && c < blocks.count(); ++c) {
+                int64_t j1 = blocks.first( c, k+1+lookahead );
+                int64_t j2 = blocks.last( c );
+                auto A_trail_j = A.sub(k, A_mt-1, j1, j2);
 
                 #pragma omp task depend(in:block[k]) \
-                                 depend(inout:block[k+1+lookahead]) \
-                                 depend(inout:block[A_nt-1])
+                                 depend(inout:block[j1]) \
+                                 depend(inout:block[j2])
                 {
+                    trace::Block trace_block( "geqrf::trailing", k );
+                    internal::CounterPhase c_update(
+                        counters, "geqrf::update",
+                        lapack::Gflop<scalar_t>::unmqr(
+                            Side::Left, A_trail_j.m(), A_trail_j.n(),
+                            A_panel.n() ) * 1e9 );
+
                     // Apply local reflectors.
-                    int queue_jk1 = j-k+1;
-                    internal::unmqr<target>(
-                                    Side::Left, Op::ConjTrans,
-                                    std::move(A_panel),
-                                    std::move(Tl_panel),
-                                    std::move(A_trail_j),
-                                    W.sub(k, A_mt-1, j, A_nt-1),
-                                    priority_0, queue_jk1 );
+                    int queue_jk1 = j1-k+1;
+                    if (hybrid.enabled()) {
+                        // One block: j1 = k+1+lookahead, j2 = nt-1.
+                        geqrf_trailing_hybrid(
+                            A, Tlocal, W, k, j1, hybrid,
+                            priority_0, queue_jk1 );
+                    }
+                    else {
+                        internal::unmqr<target>(
+                                        Side::Left, Op::ConjTrans,
+                                        std::move(A_panel),
+                                        std::move(Tl_panel),
+                                        std::move(A_trail_j),
+                                        W.sub(k, A_mt-1, j1, j2),
+                                        priority_0, queue_jk1 );
+                    }
 
                     // Apply triangle-triangle reduction reflectors.
-                    // ttmqr handles the tile broadcasting internally.
-                    int tag_j = j;
-                    internal::ttmqr<Target::HostTask>(
+                    // ttmqr handles the tile broadcasting internally,
+                    // with tags j1, ..., j2.
+                    int tag_j1 = j1;
+                    internal::ttmqr<target_tt>(
                                     Side::Left, Op::ConjTrans,
                                     std::move(A_panel),
                                     std::move(Tr_panel),
                                     std::move(A_trail_j),
-                                    tag_j );
+                                    tag_j1, queue_jk1, arity );
                 }
             }
 
@@ -288,10 +435,25 @@ void geqrf(
                     }
                 }
             }
+
+            // Column k is final, on the host; report it, in order.
+            if (panel_callback != nullptr) {
+                #pragma omp task depend(in:block[k]) \
+                                 depend(inout:callback_dep) priority(0)
+                {
+                    (*panel_callback)( k );
+                }
+            }
         }
 
         #pragma omp taskwait
         A.tileUpdateAllOrigin();
+
+        // Columns right of the last panel are final at the end.
+        if (panel_callback != nullptr) {
+            for (int64_t k = A_min_mtnt; k < A_nt; ++k)
+                (*panel_callback)( k );
+        }
     }
 
     A.releaseWorkspace();
@@ -305,6 +467,210 @@ void geqrf(
     }
 }
 
+//------------------------------------------------------------------------------
+/// Distributed parallel QR factorization, scheduled by the work-stealing
+/// runtime (TaskRuntime::WorkStealing). Host only.
+/// Reflectors of panel k are applied to whole block-columns, so
+/// dependencies are by block-column, as in the OpenMP version, but each
+/// trailing column is its own task, so column j can be updated by step k+1
+/// while other columns are still updated by step k.
+/// The update of column j uses MPI tag j, protected by the column's
+/// dependencies on all ranks.
+///
+/// @ingroup geqrf_impl
+///
+template <typename scalar_t>
+void geqrf_graph(
+    Matrix<scalar_t>& A,
+    TriangularFactors<scalar_t>& T,
+    Options const& opts )
+{
+    using BcastList = typename Matrix<scalar_t>::BcastList;
+    using Key = internal::TaskGraph::Key;
+
+    // Constants
+    const int priority_0 = 0;
+    const int priority_1 = 1;
+    const int priority_2 = 2;
+    const Layout layout = Layout::ColMajor;
+    const Target target = Target::HostTask;
+
+    // Options
+    int64_t lookahead = get_lookahead( opts );
+    int64_t ib = get_option<int64_t>( opts, Option::InnerBlocking, 16 );
+    int64_t max_panel_threads  = std::max(omp_get_max_threads()/2, 1);
+    max_panel_threads = get_option<int64_t>( opts, Option::MaxPanelThreads,
+                                             max_panel_threads );
+    int64_t arity = get_option<int64_t>( opts, Option::TreeArity, 2 );
+    if (arity < 2)
+        slate_error( "geqrf: TreeArity must be >= 2" );
+    PanelCallback* panel_callback = get_option<Option::PanelCallback>(
+                                        opts, nullptr );
+
+    int64_t A_mt = A.mt();
+    int64_t A_nt = A.nt();
+    int64_t A_min_mtnt = std::min(A_mt, A_nt);
+
+    T.clear();
+    T.push_back(A.emptyLike());
+    T.push_back(A.emptyLike(ib, 0));
+    auto Tlocal  = T[0];
+    auto Treduce = T[1];
+
+    // workspace
+    auto W = A.emptyLike();
+
+    // no device workspace on host
+    std::vector< scalar_t* > dwork_array( A.num_devices(), nullptr );
+    size_t work_size = 0;
+
+    auto column = []( int64_t j ) { return Key{ 'A', 0, j }; };
+    // Chains the callbacks, in order of k.
+    const Key callback_key{ 'C', 0, 0 };
+
+    // set min number for omp nested active parallel regions
+    slate::OmpSetMaxActiveLevels set_active_levels( MinOmpActiveLevels );
+
+    internal::TaskGraph graph;
+    graph.run( [&]( internal::TaskGraph& g ) {
+        for (int64_t k = 0; k < A_min_mtnt; ++k) {
+            auto A_panel = A.sub(k, A_mt-1, k, k);
+            std::vector< int64_t > first_indices
+                            = internal::geqrf_compute_first_indices(A_panel, k);
+
+            // panel, high priority
+            g.add( priority_2, {}, { column( k ) },
+                   [&, k, first_indices] {
+                trace::Block trace_block( "geqrf::panel", k );
+
+                // local panel factorization
+                internal::geqrf<target>(
+                                A.sub(k, A_mt-1, k, k),
+                                Tlocal.sub(k, A_mt-1, k, k),
+                                dwork_array, work_size,
+                                ib, max_panel_threads, priority_1 );
+
+                // triangle-triangle reductions
+                // ttqrt handles tile transfers internally
+                internal::ttqrt<Target::HostTask>(
+                                A.sub(k, A_mt-1, k, k),
+                                Treduce.sub(k, A_mt-1, k, k), arity );
+
+                // if a trailing matrix exists
+                if (k < A_nt-1) {
+                    trace::Block trace_block_bcast( "geqrf::bcast", k );
+
+                    // bcast V across row for trailing matrix update
+                    BcastList bcast_list_V;
+                    for (int64_t i = k; i < A_mt; ++i) {
+                        // send A(i, k) across row A(i, k+1:nt-1)
+                        bcast_list_V.push_back({i, k, {A.sub(i, i, k+1, A_nt-1)}});
+                    }
+                    A.template listBcast<target>( bcast_list_V, layout );
+
+                    // bcast Tlocal across row for trailing matrix update
+                    if (first_indices.size() > 0) {
+                        BcastList bcast_list_T;
+                        for (int64_t row : first_indices) {
+                            bcast_list_T.push_back({row, k, {Tlocal.sub(row, row, k+1, A_nt-1)}});
+                        }
+                        Tlocal.template listBcast<target>( bcast_list_T, layout );
+                    }
+
+                    // bcast Treduce across row for trailing matrix update
+                    if (first_indices.size() > 1) {
+                        BcastList bcast_list_T;
+                        for (int64_t row : first_indices) {
+                            if (row > k) // exclude the first row of this panel that has no Treduce tile
+                                bcast_list_T.push_back({row, k, {Treduce.sub(row, row, k+1, A_nt-1)}});
+                        }
+                        Treduce.template listBcast(bcast_list_T, layout);
+                    }
+                }
+            });
+
+            // update each trailing column; lookahead columns first
+            for (int64_t j = k+1; j < A_nt; ++j) {
+                int priority = j < k+1+lookahead ? priority_1 : priority_0;
+                g.add( priority, { column( k ) }, { column( j ) },
+                       [&, j, k, priority] {
+                    trace::Block trace_block(
+                        j < k+1+lookahead ? "geqrf::lookahead"
+                                          : "geqrf::trailing", k );
+
+                    // Apply local reflectors
+                    int queue_jk1 = j-k+1;
+                    internal::unmqr<target>(
+                                    Side::Left, Op::ConjTrans,
+                                    A.sub(k, A_mt-1, k, k),
+                                    Tlocal.sub(k, A_mt-1, k, k),
+                                    A.sub(k, A_mt-1, j, j),
+                                    W.sub(k, A_mt-1, j, j),
+                                    priority, queue_jk1 );
+
+                    // Apply triangle-triangle reduction reflectors
+                    // ttmqr handles the tile broadcasting internally
+                    int tag_j = j;
+                    internal::ttmqr<Target::HostTask>(
+                                    Side::Left, Op::ConjTrans,
+                                    A.sub(k, A_mt-1, k, k),
+                                    Treduce.sub(k, A_mt-1, k, k),
+                                    A.sub(k, A_mt-1, j, j),
+                                    tag_j, 0, arity );
+                });
+            }
+
+            g.add( priority_0, {}, { column( k ) }, [&, k, first_indices] {
+                // Release the whole column, not just the panel
+                for (int64_t i = 0; i < A_mt; ++i) {
+                    if (A.tileIsLocal(i, k)) {
+                        A.tileUpdateOrigin(i, k);
+                        A.releaseLocalWorkspaceTile(i, k);
+                    }
+                    else {
+                        A.releaseRemoteWorkspaceTile(i, k);
+                    }
+                }
+
+                for (int64_t i : first_indices) {
+                    if (Tlocal.tileIsLocal( i, k )) {
+                        // Tlocal and Treduce have the same process distribution
+                        Tlocal.tileUpdateOrigin( i, k );
+                        Tlocal.releaseLocalWorkspaceTile( i, k );
+                        if (i != k) {
+                            // i == k is the root of the reduction tree
+                            // Treduce( k, k ) isn't allocated
+                            Treduce.tileUpdateOrigin( i, k );
+                            Treduce.releaseLocalWorkspaceTile( i, k );
+                        }
+                    }
+                    else {
+                        Tlocal.releaseRemoteWorkspaceTile( i, k );
+                        Treduce.releaseRemoteWorkspaceTile( i, k );
+                    }
+                }
+            });
+
+            // Column k is final, on the host; report it, in order.
+            if (panel_callback != nullptr) {
+                g.add( priority_0, { column( k ) }, { callback_key },
+                       [panel_callback, k] {
+                    (*panel_callback)( k );
+                });
+            }
+        }
+    });
+
+    A.tileUpdateAllOrigin();
+
+    // Columns right of the last panel are final at the end.
+    if (panel_callback != nullptr) {
+        for (int64_t k = A_min_mtnt; k < A_nt; ++k)
+            (*panel_callback)( k );
+    }
+    A.releaseWorkspace();
+}
+
 } // namespace impl
 
 //------------------------------------------------------------------------------
@@ -338,7 +704,10 @@ void geqrf(
 ///     On exit, triangular matrices of the block reflectors.
 ///
 /// @param[in] opts
-///     Additional options, as map of name = value pairs. Possible options:
+///     Additional options, as map of name = value pairs.
+///     InnerBlocking, Lookahead, and MaxPanelThreads not set are taken
+///     from the tuning database, if it has an entry (@see TuningDB).
+///     Possible options:
 ///     - Option::Lookahead:
 ///       Number of panels to overlap with matrix updates.
 ///       lookahead >= 0. Default 1.
@@ -346,12 +715,53 @@ void geqrf(
 ///       Inner blocking to use for panel. Default 16.
 ///     - Option::MaxPanelThreads:
 ///       Number of threads to use for panel. Default omp_get_max_threads()/2.
+///     - Option::TreeArity:
+///       Arity of the tree reducing the panel's triangles across ranks.
+///       A higher arity has fewer levels, so fewer messages on the critical
+///       path, but more sequential tpqrt per level. arity >= 2. Default 2.
+///       unmqr must be called with the same arity.
 ///     - Option::Target:
 ///       Implementation to target. Possible values:
 ///       - HostTask:  OpenMP tasks on CPU host [default].
 ///       - HostNest:  nested OpenMP parallel for loop on CPU host.
 ///       - HostBatch: batched BLAS on CPU host.
 ///       - Devices:   batched BLAS on GPU device.
+///       - Hybrid:    as Devices, but the host applies the local
+///         reflectors to the last block-columns of each trailing
+///         submatrix while the devices update the rest, with the split
+///         balanced at each step by the measured host and device rates.
+///     - Option::HostWorkspaceTiles:
+///       Number of host workspace tiles to reserve, in pinned memory,
+///       for staging transfers to and from GPU devices. Default 0.
+///     - Option::QueuePriority:
+///       Stream priorities of the device compute queues.
+///       - Lookahead: panel and lookahead kernels on high priority
+///         streams, preempting the trailing update [default].
+///       - Uniform: all queues at the default priority.
+///     - Option::TaskRuntime:
+///       Task runtime for host targets. Possible values:
+///       - OpenMP: OpenMP tasks with block-column dependencies [default].
+///       - WorkStealing: work-stealing scheduler with a task per trailing
+///         block-column, so columns can run ahead to later steps.
+///       Devices always use OpenMP.
+///     - Option::TrailingBlock:
+///       Number of block columns per task of the trailing update, with
+///       host targets and TaskRuntime::OpenMP. Each block waits only for
+///       its own updates of previous steps, so the trailing update of
+///       step k overlaps with the panel of step k+1. Default 1; >= nt
+///       gives one task, as with Target::Devices.
+///     - Option::Counters:
+///       Pointer to Counters to collect performance counters in, for
+///       phases "geqrf", and, with TaskRuntime::OpenMP, "geqrf::panel"
+///       (local panel and triangle-triangle reductions), "geqrf::bcast",
+///       and "geqrf::update" (lookahead and trailing updates).
+///       Default null: off.
+///     - Option::PanelCallback:
+///       Pointer to PanelCallback to call on each rank as each block
+///       column of R and V, with its T, is final, from a low-priority
+///       task, so the application can use it while the factorization
+///       continues (@see PanelCallback). Columns right of the last panel
+///       are final at the end. Default null: off.
 ///
 /// @ingroup geqrf_computational
 ///
@@ -361,24 +771,46 @@ void geqrf(
     TriangularFactors<scalar_t>& T,
     Options const& opts )
 {
-    Target target = get_option( opts, Option::Target, Target::HostTask );
+    // Options the caller didn't set come from the tuning database, if any.
+    Options tuned;
+    Options const& opts_tuned = internal::tuned_options( "geqrf", A, opts, tuned );
+
+    Target target = get_option( opts_tuned, Option::Target, Target::HostTask );
+    TaskRuntime runtime = get_option( opts_tuned, Option::TaskRuntime,
+                                      TaskRuntime::OpenMP );
+
+    internal::CounterPhase c_geqrf(
+        get_option<Option::Counters>( opts_tuned, nullptr ), "geqrf",
+        lapack::Gflop<scalar_t>::geqrf( A.m(), A.n() ) * 1e9 );
+
+    if (runtime == TaskRuntime::WorkStealing && target != Target::Devices
+        && target != Target::Hybrid) {
+        impl::geqrf_graph( A, T, opts_tuned );
+        return;
+    }
+
+    // Sub-matrices of a non-owning view of A don't update the reference
+    // count of its storage, which the tasks of each step would contend on.
+    auto A_view = internal::nonowning_view( A );
 
     switch (target) {
         case Target::Host:
         case Target::HostTask:
-            impl::geqrf<Target::HostTask>( A, T, opts );
+            impl::geqrf<Target::HostTask>( A_view, T, opts_tuned );
             break;
 
         case Target::HostNest:
-            impl::geqrf<Target::HostNest>( A, T, opts );
+            impl::geqrf<Target::HostNest>( A_view, T, opts_tuned );
             break;
 
         case Target::HostBatch:
-            impl::geqrf<Target::HostBatch>( A, T, opts );
+            impl::geqrf<Target::HostBatch>( A_view, T, opts_tuned );
             break;
 
         case Target::Devices:
-            impl::geqrf<Target::Devices>( A, T, opts );
+        case Target::Hybrid:
+            // Hybrid runs as Devices, splitting the trailing updates.
+            impl::geqrf<Target::Devices>( A_view, T, opts_tuned );
             break;
     }
     // todo: return value for errors?
@@ -0,0 +1,580 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/slate.hh"
+#include "auxiliary/Debug.hh"
+#include "slate/Matrix.hh"
+#include "internal/internal.hh"
+#include "internal/internal_util.hh"
+
+namespace slate {
+
+namespace impl {
+
+//------------------------------------------------------------------------------
+/// Checks that A, from geqrf, is tall, with square tiles on its first
+/// nt block rows, so that R is stored in its top nt block rows, with
+/// R(k, k) in A(k, k).
+/// @ingroup geqrf_impl
+///
+template <typename scalar_t>
+void geqrf_update_check( Matrix<scalar_t>& A )
+{
+    slate_error_if( A.op() != Op::NoTrans );
+    slate_error_if( A.mt() < A.nt() );
+    for (int64_t k = 0; k < A.nt(); ++k)
+        slate_error_if( A.tileMb( k ) != A.tileNb( k ) );
+}
+
+//------------------------------------------------------------------------------
+/// Zeros the strictly lower triangle of tile A(i, j), if it is local,
+/// on the host.
+/// @ingroup geqrf_impl
+///
+template <typename scalar_t>
+void geqrf_update_zero_lower( Matrix<scalar_t>& A, int64_t i, int64_t j )
+{
+    const scalar_t zero = 0.0;
+
+    if (A.tileIsLocal( i, j )) {
+        A.tileGetForWriting( i, j, LayoutConvert::ColMajor );
+        auto Aij = A( i, j );
+        Aij.uplo( Uplo::Lower );
+        tile::tzset( zero, Aij );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Distributed parallel QR update for rows appended to A.
+/// Host OpenMP task implementation.
+///
+/// Step k stacks block row k of R, from A(k, k:nt-1), on top of what is
+/// left of C(:, k:nt-1) in the workspace W, factors that panel by a local
+/// geqrf on each rank and the tile::tpqrt reduction tree of ttqrt, as
+/// geqrf does, applies it to the trailing columns, and stores the new
+/// block row k of R back in A. The reflectors in A are kept.
+/// @ingroup geqrf_impl
+///
+template <typename scalar_t>
+void geqrf_add_rows(
+    Matrix<scalar_t>& A,
+    Matrix<scalar_t>& C,
+    Options const& opts )
+{
+    using BcastList = typename Matrix<scalar_t>::BcastList;
+    using ij_tuple = typename BaseMatrix<scalar_t>::ij_tuple;
+
+    // Constants
+    const scalar_t zero = 0.0;
+    const int priority_0 = 0;
+    const int priority_1 = 1;
+    const Layout layout = Layout::ColMajor;
+    const Target target = Target::HostTask;
+
+    // Options
+    int64_t ib = get_option<int64_t>( opts, Option::InnerBlocking, 16 );
+    int64_t max_panel_threads  = std::max(omp_get_max_threads()/2, 1);
+    max_panel_threads = get_option<int64_t>( opts, Option::MaxPanelThreads,
+                                             max_panel_threads );
+    int64_t arity = get_option<int64_t>( opts, Option::TreeArity, 2 );
+    if (arity < 2)
+        slate_error( "geqrf_add_rows: TreeArity must be >= 2" );
+
+    int64_t A_nt = A.nt();
+    int mpi_rank = A.mpiRank();
+
+    // W = [ block row k of R; C ], with block row 0 on the ranks of
+    // C's block row 0, so it joins their local panels.
+    int64_t nb0 = A.tileNb( 0 );
+    for (int64_t k = 1; k < A_nt; ++k)
+        slate_error_if( A.tileNb( k ) > nb0 );
+
+    std::function<int64_t (int64_t)> tileMb = [&C, nb0]( int64_t i ) {
+        return i == 0 ? nb0 : C.tileMb( i-1 );
+    };
+    std::function<int64_t (int64_t)> tileNb = [&A]( int64_t j ) {
+        return A.tileNb( j );
+    };
+    std::function<int (ij_tuple)> tileRank = [&C]( ij_tuple ij ) {
+        int64_t i = std::get<0>( ij );
+        int64_t j = std::get<1>( ij );
+        return C.tileRank( std::max( i-1, int64_t( 0 ) ), j );
+    };
+    std::function<int (ij_tuple)> tileDevice = [&C]( ij_tuple ij ) {
+        int64_t i = std::get<0>( ij );
+        int64_t j = std::get<1>( ij );
+        return C.tileDevice( std::max( i-1, int64_t( 0 ) ), j );
+    };
+    Matrix<scalar_t> W( nb0 + C.m(), A.n(), tileMb, tileNb,
+                        tileRank, tileDevice, A.mpiComm() );
+    W.insertLocalTiles();
+    int64_t W_mt = W.mt();
+
+    auto WC = W.sub( 1, W_mt-1, 0, A_nt-1 );
+    slate::copy( C, WC, opts );
+
+    auto Tlocal  = W.emptyLike();
+    auto Treduce = W.emptyLike( ib, 0 );
+    auto Wwork   = W.emptyLike();
+
+    // no device workspace on host
+    std::vector< scalar_t* > dwork_array( W.num_devices(), nullptr );
+    size_t work_size = 0;
+
+    // set min number for omp nested active parallel regions
+    slate::OmpSetMaxActiveLevels set_active_levels( MinOmpActiveLevels );
+
+    #pragma omp parallel
+    #pragma omp master
+    {
+        int64_t col_k = 0;  // column index (not block-column)
+        for (int64_t k = 0; k < A_nt; ++k) {
+            int64_t nbk = A.tileNb( k );
+
+            // Load block row k of R into W's block row 0.
+            {
+                auto W0 = W.sub( 0, 0, k, A_nt-1 );
+                set( zero, W0, opts );
+                auto Rk = A.sub( k, k, k, A_nt-1 );
+                auto Wk = W.slice( 0, nbk-1, col_k, A.n()-1 );
+                redistribute( Rk, Wk, opts );
+                geqrf_update_zero_lower( W, 0, k );
+            }
+
+            auto W_panel = W.sub( 0, W_mt-1, k, k );
+            std::vector< int64_t > first_indices
+                            = internal::geqrf_compute_first_indices( W_panel, 0 );
+
+            // local panel factorization
+            internal::geqrf<target>(
+                            W.sub( 0, W_mt-1, k, k ),
+                            Tlocal.sub( 0, W_mt-1, k, k ),
+                            dwork_array, work_size,
+                            ib, max_panel_threads, priority_1 );
+
+            // triangle-triangle reductions, by tile::tpqrt
+            internal::ttqrt<Target::HostTask>(
+                            W.sub( 0, W_mt-1, k, k ),
+                            Treduce.sub( 0, W_mt-1, k, k ), arity );
+
+            if (k < A_nt-1) {
+                // bcast V across row for trailing matrix update
+                BcastList bcast_list_V;
+                for (int64_t i = 0; i < W_mt; ++i) {
+                    bcast_list_V.push_back(
+                        {i, k, {W.sub( i, i, k+1, A_nt-1 )}} );
+                }
+                W.template listBcast<target>( bcast_list_V, layout );
+
+                // bcast Tlocal across row for trailing matrix update
+                if (first_indices.size() > 0) {
+                    BcastList bcast_list_T;
+                    for (int64_t row : first_indices) {
+                        bcast_list_T.push_back(
+                            {row, k, {Tlocal.sub( row, row, k+1, A_nt-1 )}} );
+                    }
+                    Tlocal.template listBcast<target>( bcast_list_T, layout );
+                }
+
+                // bcast Treduce across row for trailing matrix update
+                if (first_indices.size() > 1) {
+                    BcastList bcast_list_T;
+                    for (int64_t row : first_indices) {
+                        // the first row of the panel has no Treduce tile
+                        if (row > 0) {
+                            bcast_list_T.push_back(
+                                {row, k, {Treduce.sub( row, row, k+1, A_nt-1 )}} );
+                        }
+                    }
+                    Treduce.template listBcast( bcast_list_T, layout );
+                }
+
+                // update each trailing column
+                for (int64_t j = k+1; j < A_nt; ++j) {
+                    #pragma omp task shared( W, Tlocal, Treduce, Wwork ) \
+                        firstprivate( j, k, W_mt, arity ) \
+                        priority( priority_0 )
+                    {
+                        internal::unmqr<target>(
+                                        Side::Left, Op::ConjTrans,
+                                        W.sub( 0, W_mt-1, k, k ),
+                                        Tlocal.sub( 0, W_mt-1, k, k ),
+                                        W.sub( 0, W_mt-1, j, j ),
+                                        Wwork.sub( 0, W_mt-1, j, j ),
+                                        priority_0, j-k+1 );
+
+                        // ttmqr handles the tile broadcasting internally
+                        int tag_j = j;
+                        internal::ttmqr<Target::HostTask>(
+                                        Side::Left, Op::ConjTrans,
+                                        W.sub( 0, W_mt-1, k, k ),
+                                        Treduce.sub( 0, W_mt-1, k, k ),
+                                        W.sub( 0, W_mt-1, j, j ),
+                                        tag_j, 0, arity );
+                    }
+                }
+                #pragma omp taskwait
+
+                // Store the new R(k, k+1:nt-1) back in A.
+                auto Wk = W.slice( 0, nbk-1, col_k + nbk, A.n()-1 );
+                auto Rk = A.sub( k, k, k+1, A_nt-1 );
+                redistribute( Wk, Rk, opts );
+            }
+
+            // Store the upper triangle of the new R(k, k) back in A,
+            // keeping the reflectors below its diagonal.
+            {
+                int src = W.tileRank( 0, k );
+                int dst = A.tileRank( k, k );
+                if (src != dst) {
+                    if (mpi_rank == src)
+                        W.tileSend( 0, k, dst );
+                    else if (mpi_rank == dst)
+                        W.tileRecv( 0, k, src, layout );
+                }
+                if (A.tileIsLocal( k, k )) {
+                    A.tileGetForWriting( k, k, LayoutConvert::ColMajor );
+                    W.tileGetForReading( 0, k, LayoutConvert::ColMajor );
+                    auto Rkk = W( 0, k ).slice( Op::NoTrans, 0, 0, nbk, nbk,
+                                                Uplo::Upper );
+                    auto Akk = A( k, k );
+                    Akk.uplo( Uplo::Upper );
+                    tile::tzcopy( Rkk, Akk );
+                    A.tileUpdateOrigin( k, k );
+                }
+            }
+
+            // Release the workspace of the panel.
+            for (int64_t i = 0; i < W_mt; ++i) {
+                if (! W.tileIsLocal( i, k ))
+                    W.releaseRemoteWorkspaceTile( i, k );
+            }
+            for (int64_t i : first_indices) {
+                if (! Tlocal.tileIsLocal( i, k )) {
+                    Tlocal.releaseRemoteWorkspaceTile( i, k );
+                    Treduce.releaseRemoteWorkspaceTile( i, k );
+                }
+            }
+            col_k += nbk;
+        }
+    }
+
+    slate::copy( WC, C, opts );
+
+    A.tileUpdateAllOrigin();
+    A.releaseWorkspace();
+}
+
+} // namespace impl
+
+//------------------------------------------------------------------------------
+/// Distributed parallel QR update for appended columns.
+///
+/// Given the QR factorization $A = QR$ of an m-by-n matrix $A$, from geqrf,
+/// computes the factorization of $[ A, B ]$, for an m-by-k matrix $B$,
+/// without refactoring $A$:
+/// \[
+///     Q^H [ A, B ] = \begin{bmatrix} R & B_1 \\ 0 & B_2 \end{bmatrix},
+///     \qquad
+///     B_2 = Q_B R_B,
+/// \]
+/// so that
+/// \[
+///     [ A, B ] = Q \begin{bmatrix} I & 0 \\ 0 & Q_B \end{bmatrix}
+///                  \begin{bmatrix} R & B_1 \\ 0 & R_B \end{bmatrix}.
+/// \]
+/// $Q^H$ is applied by unmqr with the stored T factors, and only the
+/// (m-n)-by-k panel $B_2$ is factored, by geqrf.
+///
+/// Complexity (in real): $\approx 4 m n k + 2 (m-n) k^2$ flops,
+/// instead of $2 m (n+k)^2$ to refactor.
+///
+//------------------------------------------------------------------------------
+/// @tparam scalar_t
+///     One of float, double, std::complex<float>, std::complex<double>.
+//------------------------------------------------------------------------------
+/// @param[in] A
+///     The m-by-n matrix $A$, m >= n, factored by geqrf, with square
+///     tiles on its first nt block rows.
+///
+/// @param[in] T
+///     The triangular factors of $Q$, from geqrf.
+///
+/// @param[in,out] B
+///     On entry, the m-by-k matrix $B$, with the block rows of $A$.
+///     On exit, its first n rows hold $B_1$; the rows below hold $R_B$
+///     and the Householder vectors of $Q_B$, as geqrf would store them.
+///
+/// @param[out] TB
+///     On exit, the triangular factors of $Q_B$, as from geqrf on
+///     B(nt:mt-1, 0:B.nt()-1).
+///
+/// @param[in] opts
+///     Additional options, as map of name = value pairs, as for geqrf
+///     and unmqr.
+///
+/// @ingroup geqrf_computational
+///
+template <typename scalar_t>
+void geqrf_add_cols(
+    Matrix<scalar_t>& A,
+    TriangularFactors<scalar_t>& T,
+    Matrix<scalar_t>& B,
+    TriangularFactors<scalar_t>& TB,
+    Options const& opts )
+{
+    impl::geqrf_update_check( A );
+    slate_error_if( B.mt() != A.mt() );
+
+    unmqr( Side::Left, Op::ConjTrans, A, T, B, opts );
+
+    TB.clear();
+    if (A.mt() > A.nt()) {
+        auto B2 = B.sub( A.nt(), B.mt()-1, 0, B.nt()-1 );
+        geqrf( B2, TB, opts );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Distributed parallel QR update for deleted columns.
+///
+/// Given the QR factorization $A = QR$ of an m-by-n matrix $A$, from geqrf,
+/// computes the factorization of $\tilde{A}$, the matrix $A$ without its
+/// block columns j1, ..., j2. Deleting those columns of $R$ leaves
+/// $\tilde{R} = Q^H \tilde{A}$ upper triangular but for a band below
+/// its diagonal in block columns j1, ..., that is refactored,
+/// $\tilde{R}( j1:, j1: ) = Q_R R_{new}$, by geqrf, so that
+/// \[
+///     \tilde{A} = Q \begin{bmatrix} I & 0 \\ 0 & Q_R \end{bmatrix} R,
+/// \]
+/// with $R$ in the output R. Only the $\approx n$-by-($n - j_1$) trailing
+/// part of $R$ is factored; $A$, $Q$, and $T$ are unchanged.
+///
+//------------------------------------------------------------------------------
+/// @tparam scalar_t
+///     One of float, double, std::complex<float>, std::complex<double>.
+//------------------------------------------------------------------------------
+/// @param[in] A
+///     The m-by-n matrix $A$, m >= n, factored by geqrf, with square
+///     tiles on its first nt block rows.
+///
+/// @param[in] j1
+///     First block column to delete. 0 <= j1 <= j2.
+///
+/// @param[in] j2
+///     Last block column to delete. j2 < A.nt().
+///
+/// @param[out] R
+///     The matrix with the nt block rows of $R$ and the block columns
+///     of $A$ that are kept, allocated by the caller.
+///     On exit, its upper triangle holds the updated factor $R$; the
+///     part below, in block columns j1, ..., the Householder vectors
+///     of $Q_R$.
+///
+/// @param[out] TR
+///     On exit, the triangular factors of $Q_R$, as from geqrf on
+///     R(j1:mt-1, j1:nt-1). Empty if j2 = A.nt()-1.
+///
+/// @param[in] opts
+///     Additional options, as map of name = value pairs, as for geqrf.
+///
+/// @ingroup geqrf_computational
+///
+template <typename scalar_t>
+void geqrf_delete_cols(
+    Matrix<scalar_t>& A,
+    int64_t j1, int64_t j2,
+    Matrix<scalar_t>& R,
+    TriangularFactors<scalar_t>& TR,
+    Options const& opts )
+{
+    const scalar_t zero = 0.0;
+
+    impl::geqrf_update_check( A );
+    slate_error_if( j1 < 0 || j2 < j1 || j2 >= A.nt() );
+
+    int64_t d = j2 - j1 + 1;
+    int64_t R_mt = R.mt();
+    int64_t R_nt = R.nt();
+    slate_error_if( R_mt != A.nt() );
+    slate_error_if( R_nt != A.nt() - d );
+
+    // Gather the kept columns of R, above the reflectors in A.
+    set( zero, R, opts );
+    for (int64_t kR = 0; kR < R_nt; ++kR) {
+        int64_t k = kR < j1 ? kR : kR + d;
+        auto Ak = A.sub( 0, k, k, k );
+        auto Rk = R.sub( 0, k, kR, kR );
+        redistribute( Ak, Rk, opts );
+        impl::geqrf_update_zero_lower( R, k, kR );
+    }
+    R.tileUpdateAllOrigin();
+
+    // Refactor the columns that moved left of the diagonal.
+    TR.clear();
+    if (j1 < R_nt) {
+        auto R2 = R.sub( j1, R_mt-1, j1, R_nt-1 );
+        geqrf( R2, TR, opts );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Distributed parallel QR update for appended rows.
+///
+/// Given the QR factorization $A = QR$ of an m-by-n matrix $A$, from geqrf,
+/// computes the factor $R$ of
+/// \[
+///     \begin{bmatrix} A \\ C \end{bmatrix}
+///         = \begin{bmatrix} Q & 0 \\ 0 & I \end{bmatrix}
+///           \begin{bmatrix} R \\ C \end{bmatrix}
+/// \]
+/// for a k-by-n matrix $C$, from the (n+k)-by-n matrix $[ R; C ]$,
+/// without refactoring $A$. Block row j of $R$ is stacked on top of
+/// what is left of $C$ for each block column j in turn, and
+/// the triangle on top is reduced with the rows of $C$ by the
+/// tile::tpqrt tree of geqrf, with $[ R; C ]$ in a workspace.
+///
+/// Complexity (in real): $\approx 2 k n^2$ flops,
+/// instead of $2 (m+k) n^2$ to refactor.
+///
+/// Only the factor $R$ is updated. The Householder vectors below it
+/// in $A$ are kept, but they, and T, no longer describe the updated $Q$:
+/// the reflectors reducing $C$ are not returned.
+///
+//------------------------------------------------------------------------------
+/// @tparam scalar_t
+///     One of float, double, std::complex<float>, std::complex<double>.
+//------------------------------------------------------------------------------
+/// @param[in,out] A
+///     On entry, the m-by-n matrix $A$, m >= n, factored by geqrf, with
+///     square tiles on its first nt block rows.
+///     On exit, the upper triangle of its first nt block rows holds
+///     the updated factor $R$; the rest is unchanged.
+///
+/// @param[in,out] C
+///     On entry, the k-by-n matrix $C$, with the block columns of $A$.
+///     On exit, destroyed.
+///
+/// @param[in] opts
+///     Additional options, as map of name = value pairs. Possible options:
+///     - Option::InnerBlocking:
+///       Inner blocking to use for panel. Default 16.
+///     - Option::MaxPanelThreads:
+///       Number of threads to use for panel. Default omp_get_max_threads()/2.
+///     - Option::TreeArity:
+///       Arity of the triangle-triangle reduction tree. Default 2.
+///
+///     The update runs on the host.
+///
+/// @ingroup geqrf_computational
+///
+template <typename scalar_t>
+void geqrf_add_rows(
+    Matrix<scalar_t>& A,
+    Matrix<scalar_t>& C,
+    Options const& opts )
+{
+    impl::geqrf_update_check( A );
+    slate_error_if( C.nt() != A.nt() || C.n() != A.n() );
+
+    if (C.m() == 0)
+        return;
+
+    impl::geqrf_add_rows( A, C, opts );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void geqrf_add_cols<float>(
+    Matrix<float>& A,
+    TriangularFactors<float>& T,
+    Matrix<float>& B,
+    TriangularFactors<float>& TB,
+    Options const& opts);
+
+template
+void geqrf_add_cols<double>(
+    Matrix<double>& A,
+    TriangularFactors<double>& T,
+    Matrix<double>& B,
+    TriangularFactors<double>& TB,
+    Options const& opts);
+
+template
+void geqrf_add_cols< std::complex<float> >(
+    Matrix< std::complex<float> >& A,
+    TriangularFactors< std::complex<float> >& T,
+    Matrix< std::complex<float> >& B,
+    TriangularFactors< std::complex<float> >& TB,
+    Options const& opts);
+
+template
+void geqrf_add_cols< std::complex<double> >(
+    Matrix< std::complex<double> >& A,
+    TriangularFactors< std::complex<double> >& T,
+    Matrix< std::complex<double> >& B,
+    TriangularFactors< std::complex<double> >& TB,
+    Options const& opts);
+
+//------------------------------------------------------------------------------
+template
+void geqrf_delete_cols<float>(
+    Matrix<float>& A,
+    int64_t j1, int64_t j2,
+    Matrix<float>& R,
+    TriangularFactors<float>& TR,
+    Options const& opts);
+
+template
+void geqrf_delete_cols<double>(
+    Matrix<double>& A,
+    int64_t j1, int64_t j2,
+    Matrix<double>& R,
+    TriangularFactors<double>& TR,
+    Options const& opts);
+
+template
+void geqrf_delete_cols< std::complex<float> >(
+    Matrix< std::complex<float> >& A,
+    int64_t j1, int64_t j2,
+    Matrix< std::complex<float> >& R,
+    TriangularFactors< std::complex<float> >& TR,
+    Options const& opts);
+
+template
+void geqrf_delete_cols< std::complex<double> >(
+    Matrix< std::complex<double> >& A,
+    int64_t j1, int64_t j2,
+    Matrix< std::complex<double> >& R,
+    TriangularFactors< std::complex<double> >& TR,
+    Options const& opts);
+
+//------------------------------------------------------------------------------
+template
+void geqrf_add_rows<float>(
+    Matrix<float>& A,
+    Matrix<float>& C,
+    Options const& opts);
+
+template
+void geqrf_add_rows<double>(
+    Matrix<double>& A,
+    Matrix<double>& C,
+    Options const& opts);
+
+template
+void geqrf_add_rows< std::complex<float> >(
+    Matrix< std::complex<float> >& A,
+    Matrix< std::complex<float> >& C,
+    Options const& opts);
+
+template
+void geqrf_add_rows< std::complex<double> >(
+    Matrix< std::complex<double> >& A,
+    Matrix< std::complex<double> >& C,
+    Options const& opts);
+
+} // namespace slate
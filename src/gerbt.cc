@@ -5,8 +5,10 @@
 
 #include "slate/slate.hh"
 #include "slate/types.hh"
+#include "slate/internal/device.hh"
 #include "internal/internal.hh"
 
+#include <algorithm>
 #include <vector>
 
 namespace slate {
@@ -105,6 +107,45 @@ void gerbt_iterate_1d(Op trans, int64_t d, int64_t inner_len, int64_t mt,
     }
 }
 
+// Helper function to split the d butterfly levels into chunks of at most
+// max_depth levels, applied by internal::gerbt_fused in one pass each.
+// Returns the (lo, depth) of each chunk, lowest levels first.
+std::vector< std::pair<int64_t, int64_t> > gerbt_chunks(
+    int64_t d, int64_t max_depth)
+{
+    std::vector< std::pair<int64_t, int64_t> > chunks;
+    for (int64_t lo = 0; lo < d; lo += max_depth) {
+        chunks.push_back( { lo, std::min( max_depth, d - lo ) } );
+    }
+    return chunks;
+}
+
+// Helper function to build a bcast list sending the random factors of each
+// butterfly group to the block row (Side::Left) or block column
+// (Side::Right) of A owning the group's first tile.
+template<typename scalar_t>
+void gerbt_setup_bcast_fused(
+    Side side, Matrix<scalar_t> A,
+    std::vector< std::vector<int64_t> > const& groups,
+    typename Matrix<scalar_t>::BcastListTag& bcast_list)
+{
+    for (auto const& group : groups) {
+        const int64_t root = group[ 0 ];
+        for (int64_t t : group) {
+            if (t < 0)
+                continue;
+            if (side == Side::Left) {
+                bcast_list.push_back(
+                    {t, 0, {A.sub(root, root, 0, A.nt()-1)}, t} );
+            }
+            else {
+                bcast_list.push_back(
+                    {t, 0, {A.sub(0, A.mt()-1, root, root)}, t} );
+            }
+        }
+    }
+}
+
 } // namespace internal
 
 //------------------------------------------------------------------------------
@@ -119,12 +160,23 @@ void gerbt_iterate_1d(Op trans, int64_t d, int64_t inner_len, int64_t mt,
 /// @param[in] V
 ///     The right transform in packed storage. Should not be transposed.
 ///
+/// @param[in] opts
+///     Additional options, as map of name = value pairs. Possible options:
+///     - Option::Target:
+///       Implementation to target. Possible values:
+///       - HostTask:  OpenMP tasks on CPU host [default].
+///       - HostNest:  nested OpenMP parallel for loop on CPU host.
+///       - HostBatch: batched BLAS on CPU host.
+///       - Devices:   GPU kernels, applying up to
+///                    device::gerbt_max_depth levels in one pass.
+///
 /// @ingroup gesv_computational
 ///
 template<typename scalar_t>
 void gerbt(Matrix<scalar_t>& U_in,
            Matrix<scalar_t>& A,
-           Matrix<scalar_t>& V)
+           Matrix<scalar_t>& V,
+           Options const& opts)
 {
     using BcastListTag = typename Matrix<scalar_t>::BcastListTag;
 
@@ -149,11 +201,60 @@ void gerbt(Matrix<scalar_t>& U_in,
         return;
     }
 
+    Target target = get_target( opts, Target::HostTask );
+    const bool on_devices = target == Target::Devices && A.num_devices() > 0;
+
     int64_t inner_len = int64_t(std::ceil(nt / double(1 << d)));
 
     // set min number for omp nested active parallel regions
     slate::OmpSetMaxActiveLevels set_active_levels( MinOmpActiveLevels );
 
+    if (on_devices) {
+        // Two-sided butterflies are applied smallest to largest,
+        // in chunks of levels applied in one pass over the tiles.
+        auto chunks = internal::gerbt_chunks( d, device::gerbt_max_depth );
+
+        #pragma omp parallel
+        #pragma omp master
+        {
+            // Plan which random factors are needed where
+            BcastListTag bcast_list_U, bcast_list_V;
+            for (auto const& chunk : chunks) {
+                auto row_groups = internal::gerbt_groups(
+                    mt, d, inner_len, chunk.first, chunk.second );
+                auto col_groups = internal::gerbt_groups(
+                    nt, d, inner_len, chunk.first, chunk.second );
+                internal::gerbt_setup_bcast_fused(
+                    Side::Left, A, row_groups, bcast_list_U );
+                internal::gerbt_setup_bcast_fused(
+                    Side::Right, A, col_groups, bcast_list_V );
+            }
+
+            // Bcast random factors
+            internal::gerbt_bcast_filter_duplicates<scalar_t>(bcast_list_U);
+            internal::gerbt_bcast_filter_duplicates<scalar_t>(bcast_list_V);
+
+            U.template listBcastMT(bcast_list_U, Layout::ColMajor);
+            V.template listBcastMT(bcast_list_V, Layout::ColMajor);
+
+            for (auto const& chunk : chunks) {
+                internal::gerbt_fused( A, U, V, d, inner_len,
+                                       chunk.first, chunk.second );
+            }
+
+            #pragma omp taskwait
+            U.releaseRemoteWorkspace();
+            U.releaseLocalWorkspace();
+            V.releaseRemoteWorkspace();
+            V.releaseLocalWorkspace();
+
+            A.tileUpdateAllOrigin();
+        }
+        // Keep tiles held on the devices, e.g., by gesv_rbt.
+        A.releaseWorkspace();
+        return;
+    }
+
     #pragma omp parallel
     #pragma omp master
     {
@@ -219,22 +320,26 @@ void gerbt(Matrix<scalar_t>& U_in,
 template
 void gerbt(Matrix<float>&,
            Matrix<float>&,
-           Matrix<float>&);
+           Matrix<float>&,
+           Options const&);
 
 template
 void gerbt(Matrix<double>&,
            Matrix<double>&,
-           Matrix<double>&);
+           Matrix<double>&,
+           Options const&);
 
 template
 void gerbt(Matrix<std::complex<float>>&,
            Matrix<std::complex<float>>&,
-           Matrix<std::complex<float>>&);
+           Matrix<std::complex<float>>&,
+           Options const&);
 
 template
 void gerbt(Matrix<std::complex<double>>&,
            Matrix<std::complex<double>>&,
-           Matrix<std::complex<double>>&);
+           Matrix<std::complex<double>>&,
+           Options const&);
 
 
 //------------------------------------------------------------------------------
@@ -246,11 +351,22 @@ void gerbt(Matrix<std::complex<double>>&,
 /// @param[in, out] A
 ///     The matrix to transform
 ///
+/// @param[in] opts
+///     Additional options, as map of name = value pairs. Possible options:
+///     - Option::Target:
+///       Implementation to target. Possible values:
+///       - HostTask:  OpenMP tasks on CPU host [default].
+///       - HostNest:  nested OpenMP parallel for loop on CPU host.
+///       - HostBatch: batched BLAS on CPU host.
+///       - Devices:   GPU kernels, applying up to
+///                    device::gerbt_left_max_depth levels in one pass.
+///
 /// @ingroup gesv_computational
 ///
 template<typename scalar_t>
 void gerbt(Matrix<scalar_t>& Uin,
-           Matrix<scalar_t>& B)
+           Matrix<scalar_t>& B,
+           Options const& opts)
 {
     using BcastListTag = typename Matrix<scalar_t>::BcastListTag;
 
@@ -272,11 +388,55 @@ void gerbt(Matrix<scalar_t>& Uin,
         return;
     }
 
+    Target target = get_target( opts, Target::HostTask );
+    const bool on_devices = target == Target::Devices && B.num_devices() > 0;
+
     int64_t inner_len = int64_t(std::ceil(mt / double(1 << d)));
 
     // set min number for omp nested active parallel regions
     slate::OmpSetMaxActiveLevels set_active_levels( MinOmpActiveLevels );
 
+    if (on_devices) {
+        // Regular butterflies are applied largest to smallest,
+        // transposed butterflies smallest to largest,
+        // in chunks of levels applied in one pass over the tiles.
+        auto chunks = internal::gerbt_chunks( d, device::gerbt_left_max_depth );
+        if (trans == Op::NoTrans) {
+            std::reverse( chunks.begin(), chunks.end() );
+        }
+
+        #pragma omp parallel
+        #pragma omp master
+        {
+            // Plan which random factors are needed where
+            BcastListTag bcast_list;
+            for (auto const& chunk : chunks) {
+                auto groups = internal::gerbt_groups(
+                    mt, d, inner_len, chunk.first, chunk.second );
+                internal::gerbt_setup_bcast_fused(
+                    Side::Left, B, groups, bcast_list );
+            }
+
+            // Bcast random factors
+            internal::gerbt_bcast_filter_duplicates<scalar_t>(bcast_list);
+            U.template listBcastMT(bcast_list, Layout::ColMajor);
+
+            for (auto const& chunk : chunks) {
+                internal::gerbt_fused( trans, B, U, d, inner_len,
+                                       chunk.first, chunk.second );
+            }
+
+            #pragma omp taskwait
+            U.releaseRemoteWorkspace();
+            U.releaseLocalWorkspace();
+
+            B.tileUpdateAllOrigin();
+        }
+        // Keep tiles held on the devices, e.g., by gesv_rbt.
+        B.releaseWorkspace();
+        return;
+    }
+
     #pragma omp parallel
     #pragma omp master
     {
@@ -324,19 +484,23 @@ void gerbt(Matrix<scalar_t>& Uin,
 
 template
 void gerbt(Matrix<float>&,
-           Matrix<float>&);
+           Matrix<float>&,
+           Options const&);
 
 template
 void gerbt(Matrix<double>&,
-           Matrix<double>&);
+           Matrix<double>&,
+           Options const&);
 
 template
 void gerbt(Matrix<std::complex<float>>&,
-           Matrix<std::complex<float>>&);
+           Matrix<std::complex<float>>&,
+           Options const&);
 
 template
 void gerbt(Matrix<std::complex<double>>&,
-           Matrix<std::complex<double>>&);
+           Matrix<std::complex<double>>&,
+           Options const&);
 
 
 
@@ -9,6 +9,10 @@
 #include "slate/TriangularMatrix.hh"
 #include "internal/internal.hh"
 
+#include "lapack/flops.hh"
+
+#include <limits>
+
 namespace slate {
 
 //------------------------------------------------------------------------------
@@ -60,6 +64,10 @@ namespace slate {
 ///     - Option::MaxPanelThreads:
 ///       Number of threads to use for panel. Default omp_get_max_threads()/2.
 ///
+///     - Option::Counters:
+///       Pointer to Counters to collect performance counters in, for
+///       phases "gesv", "gesv::getrf", "gesv::getrs". Default null: off.
+///
 ///     - Option::Target:
 ///       Implementation to target. Possible values:
 ///       - HostTask:  OpenMP tasks on CPU host [default].
@@ -74,6 +82,30 @@ namespace slate {
 ///       - NoPiv: no pivoting.
 ///         Note pivots vector is currently ignored for NoPiv.
 ///
+///    - Option::Equilibrate:
+///      Whether to equilibrate A first, as LAPACK's gesvx with fact = 'E'.
+///      Default false. If true, computes scalings R and C with geequ,
+///      and if A is badly scaled, solves
+///      $(diag(R) A diag(C)) (diag(C)^{-1} X) = diag(R) B$ instead;
+///      A is then overwritten by the factors of the scaled matrix,
+///      and B by the unscaled solution X.
+///
+///    - Option::InfoRequest:
+///      Pointer to InfoRequest in which the factorization reduces info
+///      over the ranks without blocking (@see InfoRequest). The solve
+///      then starts at once, on all ranks, even if the factor is singular,
+///      in which case B is overwritten with Inf or NaN. The routine
+///      returns this rank's info, and InfoRequest::wait() the reduced
+///      info. Default null: blocking reduction, and no solve if info > 0.
+///
+///    - Option::FusedSolve:
+///      Whether getrf applies the forward substitution $L^{-1} P B$ as it
+///      factors, treating B as extra columns of the trailing update, so B
+///      reuses the panel broadcasts of L, saving a pass over L and its
+///      broadcasts; only the solve with U follows. B then must have the
+///      MPI communicator of A. If info > 0, B is overwritten with
+///      $L^{-1} P B$. Default false. @see getrf( A, pivots, B, opts ).
+///
 /// @return 0: successful exit
 /// @return i > 0: $U(i,i)$ is exactly zero, where $i$ is a 1-based index.
 ///         The factorization has been completed, but the factor $U$ is exactly
@@ -92,15 +124,79 @@ int64_t gesv(
     slate_assert(A.mt() == A.nt());  // square
     slate_assert(B.mt() == A.mt());
 
+    using lapack::Gflop;
+    Counters* counters = get_option<Option::Counters>( opts, nullptr );
+    internal::CounterPhase c_gesv(
+        counters, "gesv", Gflop<scalar_t>::gesv( A.n(), B.n() ) * 1e9 );
+
+    // Equilibrate, with the thresholds of LAPACK's laqge.
+    using real_t = blas::real_type<scalar_t>;
+    bool equilibrate = get_option<bool>( opts, Option::Equilibrate, false );
+    Equed equed = Equed::None;
+    std::vector<real_t> R, C;
+    if (equilibrate) {
+        Timer t_equilibrate;
+        const real_t thresh = 0.1;
+        const real_t small = std::numeric_limits<real_t>::min()
+                           / std::numeric_limits<real_t>::epsilon();
+        const real_t large = 1 / small;
+        real_t rowcnd, colcnd, amax;
+        if (geequ( A, R, C, rowcnd, colcnd, amax, opts ) == 0) {
+            bool scale_rows = rowcnd < thresh || amax < small || amax > large;
+            bool scale_cols = colcnd < thresh;
+            if (scale_rows && scale_cols)
+                equed = Equed::Both;
+            else if (scale_rows)
+                equed = Equed::Row;
+            else if (scale_cols)
+                equed = Equed::Col;
+        }
+        if (equed != Equed::None) {
+            // A = diag(R) A diag(C), and B = diag(R) B.
+            scale_row_col( equed, R, C, A, opts );
+            if (equed == Equed::Row || equed == Equed::Both)
+                scale_row_col( Equed::Row, R, R, B, opts );
+        }
+        timers[ "gesv::equilibrate" ] = t_equilibrate.stop();
+    }
+
+    // With Option::InfoRequest, info is only this rank's, so all ranks
+    // solve, without waiting for its reduction.
+    bool deferred = get_option<Option::InfoRequest>( opts, nullptr ) != nullptr;
+    bool fused = get_option<Option::FusedSolve>( opts, false );
+
     // factorization
     Timer t_getrf;
-    int64_t info = getrf(A, pivots, opts);
+    int64_t info;
+    {
+        internal::CounterPhase c_getrf(
+            counters, "gesv::getrf", Gflop<scalar_t>::getrf( A.m(), A.n() ) * 1e9 );
+        if (fused)
+            info = getrf( A, pivots, B, opts );
+        else
+            info = getrf(A, pivots, opts);
+    }
     timers[ "gesv::getrf" ] = t_getrf.stop();
 
     // solve
     Timer t_getrs;
-    if (info == 0) {
-        getrs( A, pivots, B, opts );
+    if (info == 0 || deferred) {
+        internal::CounterPhase c_getrs(
+            counters, "gesv::getrs", Gflop<scalar_t>::getrs( A.n(), B.n() ) * 1e9 );
+        if (fused) {
+            // Backward substitution, X = U^{-1} Y, with Y = L^{-1} P B
+            // from getrf.
+            const scalar_t one = 1.0;
+            auto U = TriangularMatrix<scalar_t>( Uplo::Upper, Diag::NonUnit, A );
+            trsm( Side::Left, one, U, B, opts );
+        }
+        else {
+            getrs( A, pivots, B, opts );
+        }
+
+        // X = diag(C) X undoes the column scaling.
+        if (equed == Equed::Col || equed == Equed::Both)
+            scale_row_col( Equed::Row, C, C, B, opts );
     }
     timers[ "gesv::getrs" ] = t_getrs.stop();
 
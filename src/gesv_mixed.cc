@@ -94,6 +94,17 @@ namespace slate {
 ///     - Option::UseFallbackSolver:
 ///       If true and iterative refinement fails to converge, the problem is
 ///       resolved with partial-pivoted LU. Default true
+///     - Option::BcastPrecision:
+///       Precision of panel broadcasts in the low precision LU
+///       factorization, e.g., BFloat16; receivers get rounded copies of
+///       the panels, so the factors are less accurate but iterations
+///       correct the solution. With BFloat16 or Half, the trailing
+///       updates multiply 16-bit panels, accumulating in the low
+///       precision, while the panels are factored in the low precision.
+///       Half overflows for entries above 65504; the iterations then
+///       fail to converge and the fallback solver applies.
+///       The fallback solver and the residual
+///       computations always use full precision. Default Native.
 ///
 /// @return 0: successful exit
 /// @return i > 0: $U(i,i)$ is exactly zero, where $i$ is a 1-based index.
@@ -121,7 +132,7 @@ int64_t gesv_mixed(
     const scalar_hi one_hi = 1.0;
 
     // Options
-    Target target = get_option( opts, Option::Target, Target::HostTask );
+    Target target = get_target( opts, Target::HostTask );
     int64_t itermax = get_option<int64_t>( opts, Option::MaxIterations, 30 );
     double tol = get_option<double>( opts, Option::Tolerance, eps*std::sqrt(A.m()) );
     bool use_fallback = get_option<int64_t>( opts, Option::UseFallbackSolver, true );
@@ -180,7 +191,7 @@ int64_t gesv_mixed(
 
     // Compute the LU factorization of A_lo.
     Timer t_getrf_lo;
-    int64_t info = getrf( A_lo, pivots, opts );
+    int64_t info = internal::wait_info( getrf( A_lo, pivots, opts ), opts );
     timers[ "gesv_mixed::getrf_lo" ] = t_getrf_lo.stop();
     if (info != 0) {
         iter = -3;
@@ -224,12 +235,11 @@ int64_t gesv_mixed(
             getrs( A_lo, pivots, X_lo, opts );
             timers[ "gesv_mixed::getrs_lo" ] += t_getrs_lo.stop();
 
-            // Convert X_lo back to double precision and update the current iterate.
-            copy( X_lo, R, opts );
+            // Update the current iterate, X = X + X_lo, converting X_lo
+            // to high precision on the fly instead of through R.
             Timer t_add_hi;
-            add<scalar_hi>(
-                  one_hi, R,
-                  one_hi, X, opts );
+            add( one_hi, X_lo,
+                 one_hi, X, opts );
             timers[ "gesv_mixed::add_hi" ] += t_add_hi.stop();
 
             // Compute R = B - A * X.
@@ -264,7 +274,10 @@ int64_t gesv_mixed(
             // Fall back to double precision factor and solve.
             // Compute the LU factorization of A.
             Timer t_getrf_hi;
-            info = getrf( A, pivots, opts );
+            // Broadcast in full precision for an accurate factorization.
+            Options opts_hi = opts;
+            opts_hi.erase( Option::BcastPrecision );
+            info = internal::wait_info( getrf( A, pivots, opts_hi ), opts_hi );
             timers[ "gesv_mixed::getrf_hi" ] = t_getrf_hi.stop();
 
             // Solve the system A * X = B.
@@ -32,6 +32,20 @@ namespace slate {
 /// the size of the matrix into account. This might be automated in the future.
 /// Up to now, we always try iterative refinement.
 ///
+/// With several right-hand sides, each column has its own Krylov space,
+/// but the GMRES iterations of all unconverged columns proceed together,
+/// so each iteration applies the low precision getrs and the high
+/// precision gemm to a block of columns, as level-3 operations.
+/// Each column needs its own bases, of 2 (restart+1) vectors.
+///
+/// With Option::GMRESSteps s > 1, the iterations use s-step GMRES: each
+/// block of up to s steps builds a Newton basis with s matrix-vector
+/// products, then orthogonalizes it against the previous basis, with one
+/// reduction for the Gram matrix and one broadcast for the Hessenberg
+/// columns, instead of two reductions and a norm per step in classical
+/// Gram-Schmidt (CGS2). A block stops early if its new basis vectors
+/// become numerically dependent.
+///
 /// GMRES-IR process is stopped if iter > itermax or for all the RHS,
 /// $1 \le j \le nrhs$, we have:
 ///     $\norm{r_j}_{inf} < tol \norm{x_j}_{inf} \norm{A}_{inf},$
@@ -99,6 +113,20 @@ namespace slate {
 ///     - Option::UseFallbackSolver:
 ///       If true and iterative refinement fails to converge, the problem is
 ///       resolved with partial-pivoted LU. Default true
+///     - Option::GMRESSteps:
+///       Number of s-step GMRES steps between reductions, s >= 1.
+///       1: classical GMRES with CGS2. Default 1
+///     - Option::BcastPrecision:
+///       Precision of panel broadcasts in the low precision LU
+///       factorization, e.g., BFloat16; receivers get rounded copies of
+///       the panels, so the factors are less accurate but iterations
+///       correct the solution. With BFloat16 or Half, the trailing
+///       updates multiply 16-bit panels, accumulating in the low
+///       precision, while the panels are factored in the low precision.
+///       Half overflows for entries above 65504; the iterations then
+///       fail to converge and the fallback solver applies.
+///       The fallback solver and the residual
+///       computations always use full precision. Default Native.
 ///
 /// @return 0: successful exit
 /// @return i > 0: $U(i,i)$ is exactly zero, where $i$ is a 1-based index.
@@ -128,22 +156,22 @@ int64_t gesv_mixed_gmres(
     const Layout layout = Layout::ColMajor;
 
     // Options
-    Target target = get_option( opts, Option::Target, Target::HostTask );
+    Target target = get_target( opts, Target::HostTask );
     int64_t itermax = get_option<int64_t>( opts, Option::MaxIterations, 30 );
     double tol = get_option<double>( opts, Option::Tolerance, eps*std::sqrt(A.m()) );
     bool use_fallback = get_option<int64_t>( opts, Option::UseFallbackSolver, true );
     int64_t restart = blas::min( 30, itermax, A.tileMb( 0 )-1 );
+    int64_t s = std::max( int64_t( 1 ), std::min(
+        get_option<int64_t>( opts, Option::GMRESSteps, 1 ), restart ) );
 
     bool converged = false;
+    bool breakdown = false;
     iter = 0;
 
     assert( B.mt() == A.mt() );
     assert( A.tileMb( 0 ) >= restart );
 
-    // TODO: implement block gmres
-    if (B.n() != 1) {
-        slate_not_implemented( "block-GMRES for multiple RHS is not yet supported" );
-    }
+    int64_t nrhs = B.n();
 
     // workspace
     auto R    = B.emptyLike();
@@ -152,30 +180,69 @@ int64_t gesv_mixed_gmres(
     A_lo.insertLocalTiles( target );
     auto X_lo = X.template emptyLike<scalar_lo>();
     X_lo.insertLocalTiles( target );
+    // block of the active columns' new solution basis vectors
+    auto Y    = X.emptyLike();
+    Y.insertLocalTiles( target );
 
     std::vector<real_hi> colnorms_X( X.n() );
     std::vector<real_hi> colnorms_R( R.n() );
 
-    // test basis.  First column corresponds to the residual
-    auto V = internal::alloc_basis( A, restart+1, target );
-    // solution basis.  Columns correspond to those in V. First column is unused
-    auto W = internal::alloc_basis( A, restart+1, target );
+    // Each right-hand side c has its own Krylov space, but the GMRES
+    // iterations of all active columns run in lockstep, so the
+    // preconditioner getrs and the matrix-vector product gemm are applied
+    // to a block of columns at once.
+    std::vector< Matrix<scalar_hi> > V, W, H, S;
+    V.reserve( nrhs );
+    W.reserve( nrhs );
+    H.reserve( nrhs );
+    S.reserve( nrhs );
+    for (int64_t c = 0; c < nrhs; ++c) {
+        // test basis.  First column corresponds to the residual
+        V.push_back( internal::alloc_basis( A, restart+1, target ) );
+        // solution basis.  Columns correspond to those in V. First column is unused
+        W.push_back( internal::alloc_basis( A, restart+1, target ) );
+
+        // Hessenberg Matrix. Allocate as a single tile
+        H.push_back( Matrix<scalar_hi>(
+            restart+1, restart+1, restart+1, 1, 1, A.mpiComm() ) );
+        H[ c ].insertLocalTiles( Target::Host );
+        // least squares RHS. Allocate as a single tile
+        S.push_back( Matrix<scalar_hi>(
+            restart+1, 1, restart+1, 1, 1, A.mpiComm() ) );
+        S[ c ].insertLocalTiles( Target::Host );
+    }
+    // Rotations
+    std::vector< std::vector<real_hi> > givens_alpha(
+        nrhs, std::vector<real_hi>( restart ) );
+    std::vector< std::vector<scalar_hi> > givens_beta(
+        nrhs, std::vector<scalar_hi>( restart ) );
+
+    // s-step GMRES workspace: Gram matrix G = [ Q K ]^H K, the change of
+    // basis PT, and the unrotated Hessenberg matrix H_raw on the owner of H.
+    std::vector< Matrix<scalar_hi> > G, PT;
+    std::vector< std::vector<scalar_hi> > H_raw;
+    if (s > 1) {
+        G.reserve( nrhs );
+        PT.reserve( nrhs );
+        for (int64_t c = 0; c < nrhs; ++c) {
+            G.push_back( Matrix<scalar_hi>(
+                restart+1, s, restart+1, 1, 1, A.mpiComm() ) );
+            G[ c ].insertLocalTiles( Target::Host );
+            PT.push_back( Matrix<scalar_hi>(
+                restart+1, s, restart+1, 1, 1, A.mpiComm() ) );
+            PT[ c ].insertLocalTiles( Target::Host );
+        }
+        H_raw.assign( nrhs, std::vector<scalar_hi>() );
+        if (H[ 0 ].tileRank( 0, 0 ) == mpi_rank) {
+            for (int64_t c = 0; c < nrhs; ++c)
+                H_raw[ c ].assign( (restart+1)*(restart+1), zero );
+        }
+    }
 
     // workspace vector for the orthogonalization process
     auto z = X.template emptyLike<scalar_hi>();
     z.insertLocalTiles( target );
 
-    // Hessenberg Matrix. Allocate as a single tile
-    slate::Matrix<scalar_hi> H(
-            restart+1, restart+1, restart+1, 1, 1, A.mpiComm() );
-    H.insertLocalTiles( Target::Host );
-    // least squares RHS. Allocate as a single tile
-    slate::Matrix<scalar_hi> S( restart+1, 1, restart+1, 1, 1, A.mpiComm() );
-    S.insertLocalTiles( Target::Host );
-    // Rotations
-    std::vector<real_hi>   givens_alpha( restart );
-    std::vector<scalar_hi> givens_beta ( restart );
-
 
     if (target == Target::Devices) {
         #pragma omp parallel
@@ -205,7 +272,7 @@ int64_t gesv_mixed_gmres(
     // Compute the LU factorization of A in single-precision.
     slate::copy( A, A_lo, opts );
     Timer t_getrf_lo;
-    int64_t info = getrf( A_lo, pivots, opts );
+    int64_t info = internal::wait_info( getrf( A_lo, pivots, opts ), opts );
     timers[ "gesv_mixed_gmres::getrf_lo" ] = t_getrf_lo.stop();
     if (info != 0) {
         iter = -3;
@@ -243,135 +310,342 @@ int64_t gesv_mixed_gmres(
 
             // GMRES
 
-            // Compute initial vector
-            auto v0 = V.slice( 0, V.m()-1, 0, 0 );
-            slate::copy( R, v0, opts );
-
-            std::vector<real_hi> arnoldi_residual = { norm( Norm::Fro, v0, opts ) };
-            if (arnoldi_residual[0] == 0) {
-                // Solver broke down, but residual is not small enough yet.
-                iter = iiter;
-                converged = false;
+            // Compute initial vectors of the columns not yet converged.
+            std::vector<real_hi> arnoldi_residual( nrhs, 0 );
+            std::vector<int64_t> active;
+            for (int64_t c = 0; c < nrhs; ++c) {
+                if (colnorms_R[ c ] <= colnorms_X[ c ] * cte)
+                    continue;
+
+                auto v0 = V[ c ].slice( 0, A.m()-1, 0, 0 );
+                auto Rc = R.slice( 0, R.m()-1, c, c );
+                slate::copy( Rc, v0, opts );
+
+                arnoldi_residual[ c ] = norm( Norm::Fro, v0, opts );
+                if (arnoldi_residual[ c ] == 0) {
+                    // Solver broke down, but residual is not small enough yet.
+                    iter = iiter;
+                    breakdown = true;
+                    break;
+                }
+                scale( 1.0, arnoldi_residual[ c ], v0, opts );
+                if (S[ c ].tileRank( 0, 0 ) == mpi_rank) {
+                    S[ c ].tileGetForWriting( 0, 0, LayoutConvert::ColMajor );
+                    auto S_00 = S[ c ]( 0, 0 );
+                    S_00.at( 0, 0 ) = arnoldi_residual[ c ];
+                    for (int i = 1; i < S_00.mb(); ++i) {
+                        S_00.at( i, 0 ) = 0.0;
+                    }
+                }
+                active.push_back( c );
+            }
+            if (breakdown)
                 break;
+
+            // Number of Arnoldi steps taken by each column.
+            std::vector<int64_t> steps( nrhs, 0 );
+
+            if (s > 1) {
+                // s-step GMRES: each block takes up to s steps, with one
+                // reduction to orthogonalize the block by block CGS and
+                // CholQR, instead of several reductions per step.
+                // The Newton basis shifts by 1, as M^-1 A is close to I.
+                while (iiter < itermax && ! active.empty()) {
+                    int64_t nact = active.size();
+                    auto X_lo_act = X_lo.slice( 0, X_lo.m()-1, 0, nact-1 );
+                    auto Y_act    = Y.slice( 0, Y.m()-1, 0, nact-1 );
+                    auto R_act    = R.slice( 0, R.m()-1, 0, nact-1 );
+                    int64_t sb = std::min( s, itermax - iiter );
+                    for (int64_t c : active)
+                        sb = std::min( sb, restart - steps[ c ] );
+
+                    // K(:, i) = (A M^-1 - I) K(:, i-1), with W = M^-1 K,
+                    // for all active columns with one getrs and one gemm.
+                    for (int64_t i = 0; i < sb; ++i) {
+                        for (int64_t p = 0; p < nact; ++p) {
+                            int64_t c = active[ p ];
+                            auto Vi = V[ c ].slice( 0, A.m()-1, steps[ c ]+i, steps[ c ]+i );
+                            auto X_lo_p = X_lo.slice( 0, X_lo.m()-1, p, p );
+                            slate::copy( Vi, X_lo_p, opts );
+                        }
+                        t_getrs_lo.start();
+                        getrs( A_lo, pivots, X_lo_act, opts );
+                        timers[ "gesv_mixed_gmres::getrs_lo" ] += t_getrs_lo.stop();
+                        slate::copy( X_lo_act, Y_act, opts );
+
+                        t_gemm_hi.start();
+                        gemm<scalar_hi>(
+                            one,  A,
+                                  Y_act,
+                            zero, R_act,
+                            opts );
+                        timers[ "gesv_mixed_gmres::gemm_hi" ] += t_gemm_hi.stop();
+
+                        for (int64_t p = 0; p < nact; ++p) {
+                            int64_t c = active[ p ];
+                            int64_t ji = steps[ c ] + i;
+                            auto Vi  = V[ c ].slice( 0, A.m()-1, ji, ji );
+                            auto Vi1 = V[ c ].slice( 0, A.m()-1, ji+1, ji+1 );
+                            auto Wi1 = W[ c ].slice( 0, A.m()-1, ji+1, ji+1 );
+                            auto Y_p = Y.slice( 0, Y.m()-1, p, p );
+                            auto R_p = R.slice( 0, R.m()-1, p, p );
+                            slate::copy( Y_p, Wi1, opts );
+                            slate::copy( R_p, Vi1, opts );
+                            Timer t_add_hi;
+                            add( -one, Vi, one, Vi1, opts );
+                            timers[ "gesv_mixed_gmres::add_hi" ] += t_add_hi.stop();
+                        }
+                    }
+                    iiter += sb;
+
+                    // G = [ Q K ]^H K, one reduction per column, then
+                    // orthogonalize and extend H on the root.
+                    // block_info holds the Arnoldi residuals, then the steps taken.
+                    std::vector<real_hi> block_info( 2*nrhs, 0 );
+                    for (int64_t c : active) {
+                        int64_t jc = steps[ c ];
+                        auto QK  = V[ c ].slice( 0, A.m()-1, 0, jc+sb );
+                        auto QKT = conj_transpose( QK );
+                        auto K   = V[ c ].slice( 0, A.m()-1, jc+1, jc+sb );
+                        auto Gc  = G[ c ].slice( 0, jc+sb, 0, sb-1 );
+                        t_gemm_hi.start();
+                        gemm<scalar_hi>(
+                            one,  QKT,
+                                  K,
+                            zero, Gc,
+                            opts );
+                        timers[ "gesv_mixed_gmres::gemm_hi" ] += t_gemm_hi.stop();
+
+                        Timer t_gesv_mixed_gmres_rotations;
+                        if (H[ c ].tileRank( 0, 0 ) == mpi_rank) {
+                            G[ c ].tileGetForWriting( 0, 0, LayoutConvert::ColMajor );
+                            PT[ c ].tileGetForWriting( 0, 0, LayoutConvert::ColMajor );
+                            H[ c ].tileGetForWriting( 0, 0, LayoutConvert::ColMajor );
+                            auto G_00  = G[ c ]( 0, 0 );
+                            auto PT_00 = PT[ c ]( 0, 0 );
+                            auto H_00  = H[ c ]( 0, 0 );
+                            auto S_00  = S[ c ]( 0, 0 );
+                            int64_t sp = internal::sstep_arnoldi(
+                                jc, sb, one,
+                                G_00.data(), G_00.stride(),
+                                PT_00.data(), PT_00.stride(),
+                                H_raw[ c ].data(), restart+1 );
+
+                            // Copy new Hessenberg columns, and apply givens rotations.
+                            auto& alpha = givens_alpha[ c ];
+                            auto& beta  = givens_beta[ c ];
+                            for (int64_t jj = jc; jj < jc + sp; ++jj) {
+                                for (int64_t i = 0; i <= jj+1; ++i)
+                                    H_00.at( i, jj ) = H_raw[ c ][ i + jj*(restart+1) ];
+                                for (int64_t i = 0; i < jj; ++i) {
+                                    blas::rot( 1, &H_00.at( i, jj ), 1, &H_00.at( i+1, jj ), 1,
+                                               alpha[i], beta[i] );
+                                }
+                                scalar_hi H_jj = H_00.at( jj, jj ), H_j1j = H_00.at( jj+1, jj );
+                                blas::rotg( &H_jj, & H_j1j, &alpha[jj], &beta[jj] );
+                                blas::rot( 1, &H_00.at( jj, jj ), 1, &H_00.at( jj+1, jj ), 1,
+                                           alpha[jj], beta[jj] );
+                                blas::rot( 1, &S_00.at( jj, 0 ), 1, &S_00.at( jj+1, 0 ), 1,
+                                           alpha[jj], beta[jj] );
+                            }
+                            block_info[ c ] = cabs1( S_00.at( jc+sp, 0 ) );
+                            block_info[ nrhs + c ] = sp;
+                        }
+                        timers[ "gesv_mixed_gmres::rotations" ] += t_gesv_mixed_gmres_rotations.stop();
+                    }
+                    MPI_Bcast(
+                            block_info.data(), block_info.size(),
+                            mpi_type<real_hi>::value, S[ active[ 0 ] ].tileRank( 0, 0 ),
+                            A.mpiComm() );
+
+                    // Q(:, jc+1 : jc+sp) = (K - Q R) Rn^-1, and
+                    // W(:, jc+1 : jc+sp) = (W(:, jc+1 : jc+sp) - W(:, 1:jc) P) T^-1.
+                    std::vector<int64_t> still_active;
+                    for (int64_t c : active) {
+                        int64_t jc = steps[ c ];
+                        int64_t sp = int64_t( block_info[ nrhs + c ] );
+                        if (sp > 0) {
+                            auto Q   = V[ c ].slice( 0, A.m()-1, 0, jc );
+                            auto Qn  = V[ c ].slice( 0, A.m()-1, jc+1, jc+sp );
+                            auto Rq  = G[ c ].slice( 0, jc, 0, sp-1 );
+                            auto Gn  = G[ c ].slice( jc+1, jc+sp, 0, sp-1 );
+                            auto Rn  = TriangularMatrix<scalar_hi>(
+                                Uplo::Upper, Diag::NonUnit, Gn );
+                            auto Wn  = W[ c ].slice( 0, A.m()-1, jc+1, jc+sp );
+                            auto PTn = PT[ c ].slice( jc, jc+sp-1, 0, sp-1 );
+                            auto T   = TriangularMatrix<scalar_hi>(
+                                Uplo::Upper, Diag::NonUnit, PTn );
+                            t_gemm_hi.start();
+                            gemm<scalar_hi>(
+                                -one, Q,
+                                      Rq,
+                                one,  Qn,
+                                opts );
+                            if (jc > 0) {
+                                auto W_1j = W[ c ].slice( 0, A.m()-1, 1, jc );
+                                auto P    = PT[ c ].slice( 0, jc-1, 0, sp-1 );
+                                gemm<scalar_hi>(
+                                    -one, W_1j,
+                                          P,
+                                    one,  Wn,
+                                    opts );
+                            }
+                            timers[ "gesv_mixed_gmres::gemm_hi" ] += t_gemm_hi.stop();
+                            Timer t_trsm_hi;
+                            trsm( Side::Right, one, Rn, Qn, opts );
+                            trsm( Side::Right, one, T,  Wn, opts );
+                            timers[ "gesv_mixed_gmres::trsm_hi" ] += t_trsm_hi.stop();
+                        }
+                        steps[ c ] = jc + sp;
+                        arnoldi_residual[ c ] = block_info[ c ];
+                        // Drop the columns that converged, broke down, or are full.
+                        if (sp > 0 && steps[ c ] < restart
+                            && arnoldi_residual[ c ] > colnorms_X[ c ] * cte)
+                            still_active.push_back( c );
+                    }
+                    active.swap( still_active );
+                }
             }
-            scale( 1.0, arnoldi_residual[0], v0, opts );
-            if (S.tileRank( 0, 0 ) == mpi_rank) {
-                S.tileGetForWriting( 0, 0, LayoutConvert::ColMajor );
-                auto S_00 = S( 0, 0 );
-                S_00.at( 0, 0 ) = arnoldi_residual[0];
-                for (int i = 1; i < S_00.mb(); ++i) {
-                    S_00.at( i, 0 ) = 0.0;
+            else {
+                // N.B. convergence is detected using norm(X) at the beginning of the
+                // outer iteration. Thus, changes in the magnitude of X may lead to
+                // excessive restarting or delayed completion.
+                for (int64_t j = 0; j < restart && iiter < itermax && ! active.empty();
+                     ++j, ++iiter) {
+                    int64_t nact = active.size();
+                    auto X_lo_act = X_lo.slice( 0, X_lo.m()-1, 0, nact-1 );
+                    auto Y_act    = Y.slice( 0, Y.m()-1, 0, nact-1 );
+                    auto R_act    = R.slice( 0, R.m()-1, 0, nact-1 );
+
+                    // Wj1 = M^-1 A Vj, for all active columns with one getrs
+                    // and one gemm.
+                    for (int64_t p = 0; p < nact; ++p) {
+                        int64_t c = active[ p ];
+                        auto Vj = V[ c ].slice( 0, A.m()-1, j, j );
+                        auto X_lo_p = X_lo.slice( 0, X_lo.m()-1, p, p );
+                        slate::copy( Vj, X_lo_p, opts );
+                    }
+                    t_getrs_lo.start();
+                    getrs( A_lo, pivots, X_lo_act, opts );
+                    timers[ "gesv_mixed_gmres::getrs_lo" ] += t_getrs_lo.stop();
+                    slate::copy( X_lo_act, Y_act, opts );
+
+                    t_gemm_hi.start();
+                    gemm<scalar_hi>(
+                        one,  A,
+                              Y_act,
+                        zero, R_act,
+                        opts );
+                    timers[ "gesv_mixed_gmres::gemm_hi" ] += t_gemm_hi.stop();
+
+                    for (int64_t p = 0; p < nact; ++p) {
+                        int64_t c = active[ p ];
+                        auto Vj1 = V[ c ].slice( 0, A.m()-1, j+1, j+1 );
+                        auto Wj1 = W[ c ].slice( 0, A.m()-1, j+1, j+1 );
+                        auto Y_p = Y.slice( 0, Y.m()-1, p, p );
+                        auto R_p = R.slice( 0, R.m()-1, p, p );
+                        slate::copy( Y_p, Wj1, opts );
+                        slate::copy( R_p, Vj1, opts );
+
+                        // orthogonalize w/ CGS2
+                        auto V0j = V[ c ].slice( 0, A.m()-1, 0, j );
+                        auto V0jT = conj_transpose( V0j );
+                        auto Hj = H[ c ].slice( 0, j, j, j );
+                        t_gemm_hi.start();
+                        gemm<scalar_hi>(
+                            one,  V0jT,
+                                  Vj1,
+                            zero, Hj,
+                            opts );
+                        gemm<scalar_hi>(
+                            -one, V0j,
+                                  Hj,
+                            one,  Vj1,
+                            opts );
+                        timers[ "gesv_mixed_gmres::gemm_hi" ] += t_gemm_hi.stop();
+                        auto zj = z.slice( 0, j, 0, 0 );
+                        t_gemm_hi.start();
+                        gemm<scalar_hi>(
+                            one,  V0jT,
+                                  Vj1,
+                            zero, zj,
+                            opts );
+                        gemm<scalar_hi>(
+                            -one, V0j,
+                                  zj,
+                            one,  Vj1,
+                            opts );
+                        timers[ "gesv_mixed_gmres::gemm_hi" ] += t_gemm_hi.stop();
+                        Timer t_add_hi;
+                        add( one, zj, one, Hj, opts );
+                        timers[ "gesv_mixed_gmres::add_hi" ] += t_add_hi.stop();
+                        auto Vj1_norm = norm( Norm::Fro, Vj1, opts );
+                        scale( 1.0, Vj1_norm, Vj1, opts );
+                        if (H[ c ].tileRank( 0, 0 ) == mpi_rank) {
+                            H[ c ].tileGetForWriting( 0, 0, LayoutConvert::ColMajor );
+                            auto H_00 = H[ c ]( 0, 0 );
+                            H_00.at( j+1, j ) = Vj1_norm;
+                        }
+
+                        // apply givens rotations
+                        Timer t_gesv_mixed_gmres_rotations;
+                        if (H[ c ].tileRank( 0, 0 ) == mpi_rank) {
+                            auto H_00 = H[ c ]( 0, 0 );
+                            auto& alpha = givens_alpha[ c ];
+                            auto& beta  = givens_beta[ c ];
+                            for (int64_t i = 0; i < j; ++i) {
+                                blas::rot( 1, &H_00.at( i, j ), 1, &H_00.at( i+1, j ), 1,
+                                           alpha[i], beta[i] );
+                            }
+                            scalar_hi H_jj = H_00.at( j, j ), H_j1j = H_00.at( j+1, j );
+                            blas::rotg( &H_jj, & H_j1j, &alpha[j], &beta[j] );
+                            blas::rot( 1, &H_00.at( j, j ), 1, &H_00.at( j+1, j ), 1,
+                                       alpha[j], beta[j] );
+                            auto S_00 = S[ c ]( 0, 0 );
+                            blas::rot( 1, &S_00.at( j, 0 ), 1, &S_00.at( j+1, 0 ), 1,
+                                       alpha[j], beta[j] );
+                            arnoldi_residual[ c ] = cabs1( S_00.at( j+1, 0 ) );
+                        }
+                        timers[ "gesv_mixed_gmres::rotations" ] += t_gesv_mixed_gmres_rotations.stop();
+                        steps[ c ] = j+1;
+                    }
+                    MPI_Bcast(
+                            arnoldi_residual.data(), arnoldi_residual.size(),
+                            mpi_type<real_hi>::value, S[ active[ 0 ] ].tileRank( 0, 0 ),
+                            A.mpiComm() );
+
+                    // Drop the columns whose Arnoldi residual has converged.
+                    std::vector<int64_t> still_active;
+                    for (int64_t c : active) {
+                        if (arnoldi_residual[ c ] > colnorms_X[ c ] * cte)
+                            still_active.push_back( c );
+                    }
+                    active.swap( still_active );
                 }
             }
 
-
-            // N.B. convergence is detected using norm(X) at the beginning of the
-            // outer iteration. Thus, changes in the magnitude of X may lead to
-            // excessive restarting or delayed completion.
-            int j = 0;
-            for (; j < restart && iiter < itermax
-                       && ! internal::iterRefConverged(
-                                arnoldi_residual, colnorms_X, cte );
-                 ++j, ++iiter) {
-                auto Vj1 = V.slice( 0, V.m()-1, j+1, j+1 );
-                auto Wj1 = W.slice( 0, W.m()-1, j+1, j+1 );
-
-                auto Vj = V.slice( 0, V.m()-1, j, j );
-
-                // Wj1 = M^-1 A Vj
-                slate::copy( Vj, X_lo, opts );
-                t_getrs_lo.start();
-                getrs( A_lo, pivots, X_lo, opts );
-                timers[ "gesv_mixed_gmres::getrs_lo" ] += t_getrs_lo.stop();
-                slate::copy( X_lo, Wj1, opts );
-
-                t_gemm_hi.start();
-                gemm<scalar_hi>(
-                    one,  A,
-                          Wj1,
-                    zero, Vj1,
-                    opts );
-                timers[ "gesv_mixed_gmres::gemm_hi" ] += t_gemm_hi.stop();
-
-                // orthogonalize w/ CGS2
-                auto V0j = V.slice( 0, V.m()-1, 0, j );
-                auto V0jT = conj_transpose( V0j );
-                auto Hj = H.slice( 0, j, j, j );
-                t_gemm_hi.start();
-                gemm<scalar_hi>(
-                    one,  V0jT,
-                          Vj1,
-                    zero, Hj,
-                    opts );
-                gemm<scalar_hi>(
-                    -one, V0j,
-                          Hj,
-                    one,  Vj1,
-                    opts );
-                timers[ "gesv_mixed_gmres::gemm_hi" ] += t_gemm_hi.stop();
-                auto zj = z.slice( 0, j, 0, 0 );
+            // update X
+            for (int64_t c = 0; c < nrhs; ++c) {
+                int64_t jc = steps[ c ];
+                if (jc == 0)
+                    continue;
+                auto H_j = H[ c ].slice( 0, jc-1, 0, jc-1 );
+                auto S_j = S[ c ].slice( 0, jc-1, 0, 0 );
+                auto H_tri = TriangularMatrix<scalar_hi>(
+                        Uplo::Upper, Diag::NonUnit, H_j );
+                Timer t_trsm_hi;
+                trsm( Side::Left, one, H_tri, S_j, opts );
+                timers[ "gesv_mixed_gmres::trsm_hi" ] += t_trsm_hi.stop();
+                auto W_0j = W[ c ].slice( 0, A.m()-1, 1, jc ); // first column of W is unused
+                auto X_c = X.slice( 0, X.m()-1, c, c );
                 t_gemm_hi.start();
                 gemm<scalar_hi>(
-                    one,  V0jT,
-                          Vj1,
-                    zero, zj,
-                    opts );
-                gemm<scalar_hi>(
-                    -one, V0j,
-                          zj,
-                    one,  Vj1,
+                    one, W_0j,
+                         S_j,
+                    one, X_c,
                     opts );
                 timers[ "gesv_mixed_gmres::gemm_hi" ] += t_gemm_hi.stop();
-                Timer t_add_hi;
-                add( one, zj, one, Hj, opts );
-                timers[ "gesv_mixed_gmres::add_hi" ] += t_add_hi.stop();
-                auto Vj1_norm = norm( Norm::Fro, Vj1, opts );
-                scale( 1.0, Vj1_norm, Vj1, opts );
-                if (H.tileRank( 0, 0 ) == mpi_rank) {
-                    H.tileGetForWriting( 0, 0, LayoutConvert::ColMajor );
-                    auto H_00 = H( 0, 0 );
-                    H_00.at( j+1, j ) = Vj1_norm;
-                }
-
-                // apply givens rotations
-                Timer t_gesv_mixed_gmres_rotations;
-                if (H.tileRank( 0, 0 ) == mpi_rank) {
-                    auto H_00 = H( 0, 0 );
-                    for (int64_t i = 0; i < j; ++i) {
-                        blas::rot( 1, &H_00.at( i, j ), 1, &H_00.at( i+1, j ), 1,
-                                   givens_alpha[i], givens_beta[i] );
-                    }
-                    scalar_hi H_jj = H_00.at( j, j ), H_j1j = H_00.at( j+1, j );
-                    blas::rotg( &H_jj, & H_j1j, &givens_alpha[j], &givens_beta[j] );
-                    blas::rot( 1, &H_00.at( j, j ), 1, &H_00.at( j+1, j ), 1,
-                               givens_alpha[j], givens_beta[j] );
-                    auto S_00 = S( 0, 0 );
-                    blas::rot( 1, &S_00.at( j, 0 ), 1, &S_00.at( j+1, 0 ), 1,
-                               givens_alpha[j], givens_beta[j] );
-                    arnoldi_residual[0] = cabs1( S_00.at( j+1, 0 ) );
-                }
-                timers[ "gesv_mixed_gmres::rotations" ] += t_gesv_mixed_gmres_rotations.stop();
-                MPI_Bcast(
-                        arnoldi_residual.data(), arnoldi_residual.size(),
-                        mpi_type<scalar_hi>::value, S.tileRank( 0, 0 ),
-                        A.mpiComm() );
             }
-            // update X
-            auto H_j = H.slice( 0, j-1, 0, j-1 );
-            auto S_j = S.slice( 0, j-1, 0, 0 );
-            auto H_tri = TriangularMatrix<scalar_hi>(
-                    Uplo::Upper, Diag::NonUnit, H_j );
-            Timer t_trsm_hi;
-            trsm( Side::Left, one, H_tri, S_j, opts );
-            timers[ "gesv_mixed_gmres::trsm_hi" ] += t_trsm_hi.stop();
-            auto W_0j = W.slice( 0, W.m()-1, 1, j ); // first column of W is unused
-            t_gemm_hi.start();
-            gemm<scalar_hi>(
-                one, W_0j,
-                     S_j,
-                one, X,
-                opts );
-            timers[ "gesv_mixed_gmres::gemm_hi" ] += t_gemm_hi.stop();
         }
     }
 
@@ -386,7 +660,10 @@ int64_t gesv_mixed_gmres(
             // Fall back to double precision factor and solve.
             // Compute the LU factorization of A.
             Timer t_getrf_hi;
-            info = getrf( A, pivots, opts );
+            // Broadcast in full precision for an accurate factorization.
+            Options opts_hi = opts;
+            opts_hi.erase( Option::BcastPrecision );
+            info = internal::wait_info( getrf( A, pivots, opts_hi ), opts_hi );
             timers[ "gesv_mixed_gmres::getrf_hi" ] = t_getrf_hi.stop();
 
             // Solve the system A * X = B.
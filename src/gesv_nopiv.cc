@@ -72,11 +72,15 @@ int64_t gesv_nopiv(
     slate_assert(A.mt() == A.nt());  // square
     slate_assert(B.mt() == A.mt());
 
+    // With Option::InfoRequest, info is only this rank's, so all ranks
+    // solve, without waiting for its reduction.
+    bool deferred = get_option<Option::InfoRequest>( opts, nullptr ) != nullptr;
+
     // factorization
     int64_t info = getrf_nopiv( A, opts );
 
     // solve
-    if (info == 0) {
+    if (info == 0 || deferred) {
         getrs_nopiv( A, B, opts );
     }
     return info;
@@ -81,6 +81,11 @@ namespace slate {
 ///     - Option::UseFallbackSolver:
 ///       If true and iterative refinement fails to converge, the problem is
 ///       resolved with partial-pivoted LU. Default true
+///     - Option::GrowthStats:
+///       Pointer to GrowthStats in which getrf_nopiv accumulates the
+///       growth statistics of the transformed matrix (@see GrowthStats),
+///       to check whether the factorization without pivoting was stable.
+///       If the fallback solver runs, they are those of its getrf.
 ///
 /// TODO: return value
 /// @retval 0 successful exit
@@ -99,7 +104,7 @@ void gesv_rbt(Matrix<scalar_t>& A,
 {
     using real_t = blas::real_type<scalar_t>;
 
-    Target target = get_option( opts, Option::Target, Target::HostTask );
+    Target target = get_target( opts, Target::HostTask );
 
     // Most routines prefer column major
     const Layout layout = Layout::ColMajor;
@@ -163,13 +168,13 @@ void gesv_rbt(Matrix<scalar_t>& A,
     bool converged = false;
 
     // Factor
-    gerbt( U, A, V );
+    gerbt( U, A, V, opts );
     getrf_nopiv( A, opts );
 
     // Solve
-    gerbt( U, X );
+    gerbt( U, X, opts );
     getrs_nopiv( A, X, opts );
-    gerbt( V, X );
+    gerbt( V, X, opts );
 
     if (itermax == 0) {
         return;
@@ -191,9 +196,9 @@ void gesv_rbt(Matrix<scalar_t>& A,
     }
 
     for (int64_t iiter = 0; iiter < itermax && ! converged; ++iiter) {
-        gerbt( U, R );
+        gerbt( U, R, opts );
         getrs_nopiv( A, R, opts );
-        gerbt( V, R );
+        gerbt( V, R, opts );
         add( one, R, one, X, opts );
         slate::copy( B, R, opts );
         gemm( -one, A_copy, X,
@@ -8,21 +8,213 @@
 #include "slate/Matrix.hh"
 #include "slate/TriangularMatrix.hh"
 #include "internal/internal.hh"
+#include "internal/internal_small.hh"
+#include "internal/internal_util.hh"
+#include "slate/internal/TaskGraph.hh"
+#include "slate/Tuning.hh"
+#include "slate/internal/Hybrid.hh"
+#include "slate/internal/Affinity.hh"
+#include "slate/internal/Lookahead.hh"
+
+#include "lapack/flops.hh"
 
 namespace slate {
 
 namespace impl {
 
+//------------------------------------------------------------------------------
+/// Trailing gemm of step k of getrf with Target::Hybrid:
+/// A(k+1:mt-1, j0:nt-1) -= A(k+1:mt-1, k) A(k, j0:nt-1),
+/// with block-columns j0, ..., s-1 updated on the devices, and
+/// s, ..., nt-1 on the host, while the devices run. The split s balances
+/// the local flops by the rates measured by hybrid. The row swaps, trsm,
+/// and broadcast before it stay on the devices, since they communicate.
+/// @ingroup gesv_impl
+///
+template <typename scalar_t>
+void getrf_trailing_hybrid(
+    Matrix<scalar_t>& A, int64_t k, int64_t j0,
+    internal::HybridSplit& hybrid, Layout layout,
+    int priority, int64_t queue_index )
+{
+    const scalar_t one = 1.0;
+    int64_t A_mt = A.mt();
+    int64_t A_nt = A.nt();
+
+    // Local flops of each block-column.
+    std::vector<double> flops( A_nt - j0, 0.0 );
+    int64_t nbk = A.tileNb( k );
+    for (int64_t j = j0; j < A_nt; ++j) {
+        for (int64_t i = k+1; i < A_mt; ++i) {
+            if (A.tileIsLocal( i, j )) {
+                flops[ j - j0 ] += blas::Gflop<scalar_t>::gemm(
+                    A.tileMb( i ), A.tileNb( j ), nbk ) * 1e9;
+            }
+        }
+    }
+    int64_t s = j0 + hybrid.split( flops );
+    double host_flops = 0;
+    for (int64_t j = s; j < A_nt; ++j)
+        host_flops += flops[ j - j0 ];
+    double device_flops = 0;
+    for (int64_t j = j0; j < s; ++j)
+        device_flops += flops[ j - j0 ];
+
+    double device_time = 0;
+    if (s > j0) {
+        #pragma omp task shared( A, device_time ) \
+            firstprivate( k, j0, s, A_mt, layout, priority, queue_index )
+        {
+            double time = omp_get_wtime();
+
+            // A(k+1:mt-1, j0:s-1) -= A(k+1:mt-1, k) * A(k, j0:s-1)
+            internal::gemm<Target::Devices>(
+                -one, A.sub( k+1, A_mt-1, k, k ),
+                      A.sub( k, k, j0, s-1 ),
+                one,  A.sub( k+1, A_mt-1, j0, s-1 ),
+                layout, priority, queue_index );
+
+            device_time = omp_get_wtime() - time;
+        }
+    }
+
+    double host_time = 0;
+    if (s < A_nt) {
+        double time = omp_get_wtime();
+
+        // A(k+1:mt-1, s:nt-1) -= A(k+1:mt-1, k) * A(k, s:nt-1)
+        internal::gemm<Target::HostTask>(
+            -one, A.sub( k+1, A_mt-1, k, k ),
+                  A.sub( k, k, s, A_nt-1 ),
+            one,  A.sub( k+1, A_mt-1, s, A_nt-1 ),
+            layout, priority, queue_index );
+
+        host_time = omp_get_wtime() - time;
+    }
+    #pragma omp taskwait
+
+    hybrid.done( host_flops, host_time, device_flops, device_time );
+}
+
+template <Target target, typename scalar_t>
+int64_t getrf(
+    Matrix<scalar_t>& A, Pivots& pivots,
+    Options const& opts, Matrix<scalar_t>* rhs = nullptr );
+
+//------------------------------------------------------------------------------
+/// Tail of getrf on a smaller process grid: gathers the trailing submatrix
+/// A(k:mt-1, k:nt-1) onto a p_tail-by-q_tail grid of the first ranks of A's
+/// communicator with redistribute, factors it there, and scatters it back.
+/// Steps k, ..., min(mt, nt)-1 then swap the rows of A(k:mt-1, 0:k-1), as
+/// the pivot to the left of the main loop does. Pivots are relative to each
+/// panel, so the pivots of the tail are those of A, unchanged.
+/// The tiles of A(k:mt-1, 0:k-1) must be on the host.
+///
+/// @return info of the tail, relative to A(k:mt-1, k:nt-1).
+///
+/// @ingroup gesv_impl
+///
+template <Target target, typename scalar_t>
+int64_t getrf_tail(
+    Matrix<scalar_t>& A, Pivots& pivots, int64_t k,
+    int p_tail, int q_tail, Options const& opts )
+{
+    using ij_tuple = typename BaseMatrix<scalar_t>::ij_tuple;
+
+    const int priority_0 = 0;
+    const int queue_0 = 0;
+    const int tag_0 = 0;
+
+    int64_t A_mt = A.mt();
+    int64_t A_nt = A.nt();
+    int64_t min_mt_nt = std::min( A_mt, A_nt );
+    auto A22 = A.sub( k, A_mt-1, k, A_nt-1 );
+
+    // B has the tiles of A22, 2D block cyclic on the tail grid.
+    std::vector<int64_t> mb( A22.mt() ), nb( A22.nt() );
+    for (int64_t i = 0; i < A22.mt(); ++i)
+        mb[ i ] = A22.tileMb( i );
+    for (int64_t j = 0; j < A22.nt(); ++j)
+        nb[ j ] = A22.tileNb( j );
+    std::function<int64_t (int64_t)> tileMb = [mb]( int64_t i ) {
+        return mb[ i ];
+    };
+    std::function<int64_t (int64_t)> tileNb = [nb]( int64_t j ) {
+        return nb[ j ];
+    };
+    std::function<int (ij_tuple)> tileRank
+        = func::process_2d_grid( GridOrder::Col, p_tail, q_tail );
+    std::function<int (ij_tuple)> tileDevice;
+    if (A.num_devices() > 0) {
+        tileDevice = func::device_1d_grid( GridOrder::Row, q_tail,
+                                           A.num_devices() );
+    }
+    else {
+        tileDevice = []( ij_tuple ij ) {
+            return HostNum;
+        };
+    }
+    Matrix<scalar_t> B( A22.m(), A22.n(), tileMb, tileNb, tileRank,
+                        tileDevice, A.mpiComm() );
+    B.insertLocalTiles();
+
+    // The tail reduces its own info, blocking, since the caller combines
+    // it with the info of the steps before it. Likewise its max |u_ij|;
+    // max |a_ij| is the caller's, taken at step 0.
+    Options opts_tail = opts;
+    opts_tail[ Option::TailShrink ] = int64_t( 0 );
+    opts_tail.erase( Option::InfoRequest );
+    GrowthStats* growth = get_option<Option::GrowthStats>( opts, nullptr );
+    GrowthStats growth_tail;
+    if (growth != nullptr)
+        opts_tail[ Option::GrowthStats ] = &growth_tail;
+
+    redistribute( A22, B, opts );
+
+    Pivots pivots_tail;
+    int64_t info = impl::getrf<target>( B, pivots_tail, opts_tail );
+    if (growth != nullptr)
+        growth->updateU( growth_tail.maxU() );
+
+    redistribute( B, A22, opts );
+
+    for (int64_t t = 0; t < int64_t( pivots_tail.size() ); ++t)
+        pivots.at( k + t ) = pivots_tail[ t ];
+
+    #pragma omp parallel
+    #pragma omp master
+    {
+        for (int64_t kt = k; kt < min_mt_nt; ++kt) {
+            // swap rows in A(kt:mt-1, 0:k-1)
+            internal::permuteRows<Target::HostTask>(
+                Direction::Forward, A.sub( kt, A_mt-1, 0, k-1 ), pivots.at( kt ),
+                Layout::ColMajor, priority_0, tag_0, queue_0 );
+        }
+        #pragma omp taskwait
+    }
+    A.tileUpdateAllOrigin();
+    A.tileLayoutReset();
+
+    return info;
+}
+
 //------------------------------------------------------------------------------
 /// Distributed parallel LU factorization.
 /// Generic implementation for any target.
 /// Panel and lookahead computed on host using Host OpenMP task.
+///
+/// If rhs is not null, A must be square, and step k also applies the
+/// pivots of panel k and the forward substitution with L(k:mt-1, k) to
+/// the block rows k:mt-1 of rhs, as extra columns of the trailing update,
+/// so on exit rhs = L^{-1} P rhs. The panel broadcast also sends
+/// A(i, k) to the ranks of rhs(i, :), so the solve needs no broadcasts
+/// of L of its own. Not with Checkpoint or TailShrink, which are ignored.
 /// @ingroup gesv_impl
 ///
 template <Target target, typename scalar_t>
 int64_t getrf(
     Matrix<scalar_t>& A, Pivots& pivots,
-    Options const& opts )
+    Options const& opts, Matrix<scalar_t>* rhs )
 {
     using real_t = blas::real_type<scalar_t>;
     using BcastList = typename Matrix<scalar_t>::BcastList;
@@ -35,12 +227,34 @@ int64_t getrf(
     const int queue_1 = 1;
 
     // Options
-    real_t pivot_threshold = get_option<Option::PivotThreshold>( opts, 1.0 );
-    int64_t lookahead = get_option<Option::Lookahead>( opts, 1 );
-    int64_t ib = get_option<Option::InnerBlocking>( opts, 16 );
+    ResolvedOptions const ropts( opts );
+    real_t pivot_threshold = ropts.get<Option::PivotThreshold>( 1.0 );
+    int64_t lookahead = ropts.get<Option::Lookahead>( 1 );
+    int64_t max_lookahead = ropts.get<Option::MaxLookahead>( 4 );
+    int64_t ib = ropts.get<Option::InnerBlocking>( 16 );
+    int64_t cache_tiles = ropts.get<Option::DeviceCacheTiles>( 0 );
+    bool progress_thread = ropts.get<Option::ProgressThread>( false );
+    Checkpoint* checkpoint = ropts.get<Option::Checkpoint>( nullptr );
+    BcastPrecision bcast_precision = ropts.get<Option::BcastPrecision>(
+                                         BcastPrecision::Native );
+    bool bcast_partitioned = ropts.get<Option::BcastPartitioned>( false );
+    int64_t tail_shrink = ropts.get<Option::TailShrink>( 0 );
+    QueuePriority queue_priority = ropts.get<Option::QueuePriority>(
+                                       QueuePriority::Lookahead );
+    ComputePrecision compute_precision = ropts.get<Option::ComputePrecision>(
+                                             ComputePrecision::Native );
+    Target panel_target = ropts.get<Option::PanelTarget>( Target::HostTask );
+    Counters* counters = ropts.get<Option::Counters>( nullptr );
+    GrowthStats* growth = ropts.get<Option::GrowthStats>( nullptr );
+    int64_t panel_cores = ropts.get<Option::PanelCores>( 0 );
+    if (target != Target::Devices)
+        panel_target = Target::HostTask;
+    // With Hybrid, the host updates part of each trailing submatrix.
+    internal::HybridSplit hybrid(
+        target == Target::Devices
+        && ropts.get<Option::Target>( target ) == Target::Hybrid );
     int64_t max_panel_threads  = std::max( omp_get_max_threads()/2, 1 );
-    max_panel_threads = get_option<Option::MaxPanelThreads>(
-                                                      opts, max_panel_threads );
+    max_panel_threads = ropts.get<Option::MaxPanelThreads>( max_panel_threads );
 
     // Host can use Col/RowMajor for row swapping,
     // RowMajor is slightly more efficient.
@@ -60,71 +274,268 @@ int64_t getrf(
     int64_t min_mt_nt = std::min(A.mt(), A.nt());
     pivots.resize(min_mt_nt);
 
+    int64_t rhs_nt = 0;
+    if (rhs != nullptr) {
+        slate_assert( A_mt == A_nt );
+        slate_assert( rhs->mt() == A_mt );
+        rhs_nt = rhs->nt();
+        checkpoint = nullptr;
+    }
+
+    // Growth statistics: max |a_ij| in the tasks of step 0, before their
+    // row swaps, and max |u_ij| of each block row of U once it is solved,
+    // where the tiles are; reduced with info.
+    if (growth != nullptr)
+        growth->reset();
+
+    // With TailShrink, steps k_end, ..., min_mt_nt-1 run in getrf_tail on
+    // a grid of half the rows and columns of ranks, which gives each rank
+    // four times the trailing tiles, once the trailing submatrix is too
+    // small to hide the broadcasts across all ranks.
+    int64_t k_end = min_mt_nt;
+    int p_tail = 1, q_tail = 1;
+    if (tail_shrink > 0 && checkpoint == nullptr && rhs == nullptr) {
+        GridOrder grid_order;
+        int p, q, myrow, mycol;
+        A.gridinfo( &grid_order, &p, &q, &myrow, &mycol );
+        p_tail = std::max( p/2, 1 );
+        q_tail = std::max( q/2, 1 );
+        int64_t k_tail = A_nt - tail_shrink;
+        if (grid_order != GridOrder::Unknown && p_tail*q_tail < p*q
+            && k_tail > 0 && k_tail < min_mt_nt) {
+            k_end = k_tail;
+        }
+    }
+
     // OpenMP needs pointer types, but vectors are exception safe
     std::vector< uint8_t > column_vector(A_nt);
     uint8_t* column = column_vector.data();
     SLATE_UNUSED( column ); // Used only by OpenMP
+    uint8_t rhs_dep;
+    SLATE_UNUSED( rhs_dep ); // Used only by OpenMP
 
     // Communication of the jth tile column uses the MPI tag j
-    // So, the data dependencies protect the corresponding MPI tags
+    // So, the data dependencies protect the corresponding MPI tags;
+    // rhs uses tag nt, protected by rhs_dep.
+    const int tag_rhs = A_nt;
+
+    // Blocks of block columns of the trailing update, one task each.
+    // Devices update it in one task, batched on one queue.
+    int64_t trailing_block = ropts.get<Option::TrailingBlock>( 1 );
+    if (target == Target::Devices)
+        trailing_block = A_nt;
+    internal::ColumnBlocks blocks( A_nt, trailing_block );
+
+    // Lookahead depth of each step, fixed or adapted at runtime.
+    internal::AdaptiveLookahead adaptive( lookahead, max_lookahead );
+
+    // Device panel workspace and queue, after the lookahead queues.
+    std::vector< char* > dwork_array( A.num_devices(), nullptr );
+    size_t dwork_bytes = 0;
+    const int queue_panel = 2 + adaptive.max();
 
     if (target == Target::Devices) {
         const int64_t batch_size_default = 0;
-        int num_queues = 2 + lookahead;
+        int num_queues = 2 + adaptive.max();
+        if (panel_target == Target::Devices)
+            num_queues += 1;
         A.allocateBatchArrays( batch_size_default, num_queues );
-        A.reserveDeviceWorkspace();
+        // Lookahead columns use queues 2, ..., 1 + lookahead;
+        // the device panel the last queue.
+        A.setComputeQueuePriorities( queue_priority, 2, num_queues );
+        // Reserve the planned workspace once, up front.
+        plan::Workspace workspace = plan::getrf( A, opts, target );
+        if (cache_tiles > 0)
+            A.enableTileCache( cache_tiles );
+        else
+            A.reserveDeviceWorkspace( workspace.device_tiles );
+        if (workspace.host_tiles > 0)
+            A.reserveHostWorkspace( workspace.host_tiles );
+        if (rhs != nullptr) {
+            rhs->allocateBatchArrays( batch_size_default, 1 );
+            rhs->reserveDeviceWorkspace();
+        }
+
+        if (panel_target == Target::Devices && A.num_devices() > 0) {
+            // Size for the most local rows of any panel.
+            int64_t mlocal_max = 0;
+            for (int64_t j = 0; j < min_mt_nt; ++j) {
+                int64_t mlocal = 0;
+                for (int64_t i = j; i < A_mt; ++i) {
+                    if (A.tileIsLocal( i, j ))
+                        mlocal += A.tileMb( i );
+                }
+                mlocal_max = std::max( mlocal_max, mlocal );
+            }
+            int64_t nb_max = 0;
+            for (int64_t j = 0; j < min_mt_nt; ++j)
+                nb_max = std::max( nb_max, A.tileNb( j ) );
+
+            lapack::Queue* queue = A.comm_queue( 0 );
+            dwork_bytes = internal::getrf_panel_work_bytes<scalar_t>(
+                              mlocal_max, nb_max, nullptr, *queue );
+            for (int dev = 0; dev < A.num_devices(); ++dev) {
+                queue = A.comm_queue( dev );
+                dwork_array[ dev ]
+                    = blas::device_malloc<char>( dwork_bytes, *queue );
+            }
+        }
     }
+    // The trailing and lookahead updates may use a lower compute
+    // precision; the pivoting and device panel queues stay native.
+    A.setComputePrecisions( compute_precision, queue_1, queue_panel );
 
     // set min number for omp nested active parallel regions
     slate::OmpSetMaxActiveLevels set_active_levels( MinOmpActiveLevels );
 
+    // Continue from the last checkpoint, if any.
+    int64_t k_start = 0;
+    if (checkpoint != nullptr) {
+        k_start = checkpoint->restore( A, &pivots, &info );
+        adaptive.resume( k_start );
+    }
+
+    // Panel and communication threads on their own cores, if reserved,
+    // so they don't share cores or caches with the trailing update.
+    internal::CoreAffinity affinity( panel_cores );
+
+    // Drive panel broadcasts while the trailing update runs.
+    internal::ProgressThread progress( progress_thread );
+
     #pragma omp parallel
     #pragma omp master
     {
         int64_t kk = 0;  // column index (not block-column)
-        for (int64_t k = 0; k < min_mt_nt; ++k) {
+        for (int64_t k = 0; k < k_start; ++k)
+            kk += A.tileNb( k );
+        int64_t la_prev = 0;  // lookahead of step k-1
+        for (int64_t k = k_start; k < k_end; ++k) {
+
+            // Checkpoint steps 0, ..., k-1, written while steps k, ...
+            // compute.
+            if (checkpoint != nullptr && k > k_start
+                && checkpoint->due( k )) {
+                #pragma omp taskwait
+                checkpoint->save( A, &pivots, k, info );
+            }
 
             int64_t diag_len = std::min(A.tileMb(k), A.tileNb(k));
             pivots.at(k).resize(diag_len);
 
+            // Flops of the panel and of a trailing column, to predict times.
+            int64_t mk = A.m() - kk;
+            int64_t nbk = A.tileNb(k);
+            double panel_flops = lapack::Gflop<scalar_t>::getrf( mk, nbk ) * 1e9;
+            double col_flops = blas::Gflop<scalar_t>::gemm( mk, nbk, nbk ) * 1e9;
+            adaptive.wait( k );
+            int64_t la = adaptive.step( k, panel_flops,
+                                        col_flops * (A_nt - k - 1) );
+
             // panel, high priority
             #pragma omp task depend(inout:column[k]) priority(1)
             {
+                trace::Block trace_block( "getrf::panel", k );
+                internal::PanelBinding panel_binding;
+                double panel_time = omp_get_wtime();
+
                 // factor A(k:mt-1, k)
                 int64_t iinfo;
-                internal::getrf_panel<Target::HostTask>(
-                    A.sub(k, A_mt-1, k, k), diag_len, ib, pivots.at(k),
-                    pivot_threshold, max_panel_threads, priority_1, k, &iinfo );
+                if (k == 0) {
+                    internal::growth_update_A(
+                        growth, A.sub(0, A_mt-1, 0, 0), priority_1, queue_0 );
+                }
+                {
+                    internal::CounterPhase c_panel(
+                        counters, "getrf::panel", panel_flops );
+                    if (panel_target == Target::Devices) {
+                        internal::getrf_panel<Target::Devices>(
+                            A.sub(k, A_mt-1, k, k), diag_len, ib, pivots.at(k),
+                            pivot_threshold, max_panel_threads, priority_1, k,
+                            dwork_array, dwork_bytes, queue_panel, &iinfo );
+                    }
+                    else {
+                        internal::getrf_panel<Target::HostTask>(
+                            A.sub(k, A_mt-1, k, k), diag_len, ib, pivots.at(k),
+                            pivot_threshold, max_panel_threads, priority_1, k, &iinfo );
+                    }
+                }
                 if (info == 0 && iinfo > 0)
                     info = kk + iinfo;
+                internal::growth_update_U(
+                    growth, Uplo::Upper, A.sub(k, k, k, k), priority_1, queue_0 );
+
+                trace::Block trace_block_bcast( "getrf::bcast", k );
+                internal::CounterPhase c_bcast( counters, "getrf::bcast" );
+
+                // Root broadcasts the pivots to all ranks, packed, while
+                // the panel tiles are sent.
+                std::vector<int64_t> pivots_packed;
+                internal::pack_pivots( pivots.at(k), pivots_packed );
+                MPI_Request pivots_request;
+                MPI_Ibcast(pivots_packed.data(), pivots_packed.size(),
+                           MPI_INT64_T, A.tileRank(k, k), A.mpiComm(),
+                           &pivots_request);
 
                 BcastList bcast_list_A;
                 int tag_k = k;
                 for (int64_t i = k; i < A_mt; ++i) {
-                    // send A(i, k) across row A(i, k+1:nt-1)
-                    bcast_list_A.push_back({i, k, {A.sub(i, i, k+1, A_nt-1)}});
+                    // send A(i, k) across row A(i, k+1:nt-1),
+                    // and row rhs(i, 0:nrhs-1)
+                    if (rhs != nullptr) {
+                        bcast_list_A.push_back(
+                            {i, k, {A.sub(i, i, k+1, A_nt-1),
+                                    rhs->sub(i, i, 0, rhs_nt-1)}});
+                    }
+                    else {
+                        bcast_list_A.push_back({i, k, {A.sub(i, i, k+1, A_nt-1)}});
+                    }
+                }
+                // Packed broadcasts are only to tiles of A.
+                if (rhs == nullptr
+                    && (bcast_partitioned
+                        || bcast_precision != BcastPrecision::Native)) {
+                    A.template listBcastPacked<target>(
+                        bcast_list_A, target_layout, tag_k, false,
+                        bcast_precision, bcast_partitioned );
+                }
+                else {
+                    A.template listBcast<target>(
+                        bcast_list_A, target_layout, tag_k );
                 }
-                A.template listBcast<target>(
-                    bcast_list_A, target_layout, tag_k );
 
-                // Root broadcasts the pivot to all ranks.
-                // todo: Panel ranks send the pivots to the right.
                 {
-                    trace::Block trace_block("MPI_Bcast");
+                    trace::Block trace_block("MPI_Wait");
 
-                    MPI_Bcast(pivots.at(k).data(),
-                              sizeof(Pivot)*pivots.at(k).size(),
-                              MPI_BYTE, A.tileRank(k, k), A.mpiComm());
+                    MPI_Wait(&pivots_request, MPI_STATUS_IGNORE);
                 }
+                internal::unpack_pivots( pivots_packed, pivots.at(k) );
+                adaptive.panelDone( k, panel_flops,
+                                    omp_get_wtime() - panel_time );
             }
             // update lookahead column(s), high priority
-            for (int64_t j = k+1; j < k+1+lookahead && j < A_nt; ++j) {
+            for (int64_t j = k+1; j < k+1+la && j < A_nt; ++j) {
+                // If the lookahead grew, column j was in the trailing
+                // submatrix of step k-1, whose task on the block of j
+                // depends on its first column.
+                int64_t j_trail = (k > 0 && j > k + la_prev)
+                                ? blocks.sentinel( j, k + la_prev ) : k;
                 #pragma omp task depend(in:column[k]) \
+                                 depend(in:column[j_trail]) \
                                  depend(inout:column[j]) priority(1)
                 {
+                    trace::Block trace_block( "getrf::lookahead", k );
+                    internal::CounterPhase c_update(
+                        counters, "getrf::update", col_flops );
+                    double update_time = omp_get_wtime();
+
                     // swap rows in A(k:mt-1, j)
                     int tag_j = j;
                     int queue_jk1 = j-k+1;
+                    if (k == 0) {
+                        internal::growth_update_A(
+                            growth, A.sub(0, A_mt-1, j, j),
+                            priority_1, queue_jk1 );
+                    }
                     internal::permuteRows<target>(
                         Direction::Forward, A.sub(k, A_mt-1, j, j), pivots.at(k),
                         target_layout, priority_1, tag_j, queue_jk1 );
@@ -138,6 +549,9 @@ int64_t getrf(
                         Side::Left,
                         one, std::move( Tkk ), A.sub(k, k, j, j),
                         priority_1, target_layout, queue_jk1 );
+                    internal::growth_update_U(
+                        growth, Uplo::General, A.sub(k, k, j, j),
+                        priority_1, queue_jk1 );
 
                     // send A(k, j) across column A(k+1:mt-1, j)
                     // todo: trsm still operates in ColMajor
@@ -149,6 +563,9 @@ int64_t getrf(
                               A.sub(k, k, j, j),
                         one,  A.sub(k+1, A_mt-1, j, j),
                         target_layout, priority_1, queue_jk1 );
+
+                    adaptive.updateDone( col_flops,
+                                         omp_get_wtime() - update_time );
                 }
             }
             // pivot to the left
@@ -171,46 +588,128 @@ int64_t getrf(
                     }
                 }
             }
-            // update trailing submatrix, normal priority
-            if (k+1+lookahead < A_nt) {
+            // update trailing submatrix, normal priority,
+            // one task per block of block columns
+            for (int64_t c = blocks.block( k+1+la );
+                 k+1+la < A_nt && c < blocks.count(); ++c) {
+                int64_t j1 = blocks.first( c, k+1+la );
+                int64_t j2 = blocks.last( c );
                 #pragma omp task depend(in:column[k]) \
-                                 depend(inout:column[k+1+lookahead]) \
-                                 depend(inout:column[A_nt-1])
+                                 depend(inout:column[j1]) \
+                                 depend(inout:column[j2])
                 {
-                    // swap rows in A(k:mt-1, kl+1:nt-1)
-                    int tag_kl1 = k+1+lookahead;
+                    trace::Block trace_block( "getrf::trailing", k );
+                    internal::CounterPhase c_update(
+                        counters, "getrf::update", col_flops * (j2 - j1 + 1) );
+                    double update_time = omp_get_wtime();
+
+                    // swap rows in A(k:mt-1, j1:j2)
+                    int tag_j1 = j1;
+                    if (k == 0) {
+                        internal::growth_update_A(
+                            growth, A.sub(0, A_mt-1, j1, j2),
+                            priority_0, queue_1 );
+                    }
                     // todo: target
                     internal::permuteRows<target>(
-                        Direction::Forward, A.sub(k, A_mt-1, k+1+lookahead, A_nt-1),
-                        pivots.at(k), target_layout, priority_0, tag_kl1, queue_1 );
+                        Direction::Forward, A.sub(k, A_mt-1, j1, j2),
+                        pivots.at(k), target_layout, priority_0, tag_j1, queue_1 );
 
                     auto Akk = A.sub(k, k, k, k);
                     auto Tkk =
                         TriangularMatrix<scalar_t>(Uplo::Lower, Diag::Unit, Akk);
 
-                    // solve A(k, k) A(k, kl+1:nt-1) = A(k, kl+1:nt-1)
+                    // solve A(k, k) A(k, j1:j2) = A(k, j1:j2)
                     // todo: target
                     internal::trsm<target>(
                         Side::Left,
                         one, std::move( Tkk ),
-                             A.sub(k, k, k+1+lookahead, A_nt-1),
+                             A.sub(k, k, j1, j2),
                         priority_0, target_layout, queue_1 );
+                    internal::growth_update_U(
+                        growth, Uplo::General, A.sub(k, k, j1, j2),
+                        priority_0, queue_1 );
 
-                    // send A(k, kl+1:A_nt-1) across A(k+1:mt-1, kl+1:nt-1)
+                    // send A(k, j1:j2) across A(k+1:mt-1, j1:j2)
                     BcastList bcast_list_A;
-                    for (int64_t j = k+1+lookahead; j < A_nt; ++j) {
+                    for (int64_t j = j1; j <= j2; ++j) {
                         // send A(k, j) across column A(k+1:mt-1, j)
                         bcast_list_A.push_back({k, j, {A.sub(k+1, A_mt-1, j, j)}});
                     }
-                    A.template listBcast<target>(
-                        bcast_list_A, target_layout, tag_kl1);
+                    if (bcast_partitioned
+                        || bcast_precision != BcastPrecision::Native) {
+                        A.template listBcastPacked<target>(
+                            bcast_list_A, target_layout, tag_j1, false,
+                            bcast_precision, bcast_partitioned );
+                    }
+                    else {
+                        A.template listBcast<target>(
+                            bcast_list_A, target_layout, tag_j1);
+                    }
 
-                    // A(k+1:mt-1, kl+1:nt-1) -= A(k+1:mt-1, k) * A(k, kl+1:nt-1)
-                    internal::gemm<target>(
-                        -one, A.sub(k+1, A_mt-1, k, k),
-                              A.sub(k, k, k+1+lookahead, A_nt-1),
-                        one,  A.sub(k+1, A_mt-1, k+1+lookahead, A_nt-1),
-                        target_layout, priority_0, queue_1 );
+                    // A(k+1:mt-1, j1:j2) -= A(k+1:mt-1, k) * A(k, j1:j2)
+                    if (hybrid.enabled()) {
+                        // One block: j1 = k+1+la, j2 = nt-1.
+                        getrf_trailing_hybrid(
+                            A, k, j1, hybrid, target_layout,
+                            priority_0, queue_1 );
+                    }
+                    else {
+                        internal::gemm<target>(
+                            -one, A.sub(k+1, A_mt-1, k, k),
+                                  A.sub(k, k, j1, j2),
+                            one,  A.sub(k+1, A_mt-1, j1, j2),
+                            target_layout, priority_0, queue_1 );
+                    }
+
+                    adaptive.updateDone( col_flops * (j2 - j1 + 1),
+                                         omp_get_wtime() - update_time );
+                }
+            }
+            // update rhs, as the trailing columns, normal priority
+            if (rhs != nullptr) {
+                #pragma omp task depend(in:column[k]) depend(inout:rhs_dep)
+                {
+                    trace::Block trace_block( "getrf::rhs", k );
+
+                    // swap rows in rhs(k:mt-1, :)
+                    internal::permuteRows<target>(
+                        Direction::Forward, rhs->sub(k, A_mt-1, 0, rhs_nt-1),
+                        pivots.at(k), target_layout, priority_0, tag_rhs,
+                        queue_0 );
+
+                    auto Akk = A.sub(k, k, k, k);
+                    auto Tkk =
+                        TriangularMatrix<scalar_t>(Uplo::Lower, Diag::Unit, Akk);
+
+                    // solve A(k, k) rhs(k, :) = rhs(k, :)
+                    internal::trsm<target>(
+                        Side::Left,
+                        one, std::move( Tkk ), rhs->sub(k, k, 0, rhs_nt-1),
+                        priority_0, target_layout, queue_0 );
+
+                    if (k+1 < A_mt) {
+                        // send rhs(k, j) across column rhs(k+1:mt-1, j)
+                        BcastList bcast_list_B;
+                        for (int64_t j = 0; j < rhs_nt; ++j) {
+                            bcast_list_B.push_back(
+                                {k, j, {rhs->sub(k+1, A_mt-1, j, j)}});
+                        }
+                        rhs->template listBcast<target>(
+                            bcast_list_B, target_layout, tag_rhs );
+
+                        // rhs(k+1:mt-1, :) -= A(k+1:mt-1, k) * rhs(k, :)
+                        internal::gemm<target>(
+                            -one, A.sub(k+1, A_mt-1, k, k),
+                                  rhs->sub(k, k, 0, rhs_nt-1),
+                            one,  rhs->sub(k+1, A_mt-1, 0, rhs_nt-1),
+                            target_layout, priority_0, queue_0 );
+                    }
+
+                    auto rhs_row = rhs->sub( k, k, 0, rhs_nt-1 );
+                    rhs_row.releaseRemoteWorkspace();
+                    rhs_row.tileUpdateAllOrigin();
+                    rhs_row.releaseLocalWorkspace();
                 }
             }
             #pragma omp task depend(inout:column[k])
@@ -232,17 +731,440 @@ int64_t getrf(
                 top_panel.releaseLocalWorkspace();
             }
             kk += A.tileNb( k );
+            la_prev = la;
         }
         #pragma omp taskwait
 
         A.tileLayoutReset();
+        if (rhs != nullptr) {
+            rhs->tileLayoutReset();
+            rhs->tileUpdateAllOrigin();
+        }
     }
     A.clearWorkspace();
+    if (rhs != nullptr)
+        rhs->releaseWorkspace();
+    if (cache_tiles > 0)
+        A.disableTileCache();
+    A.setComputePrecisions( ComputePrecision::Native, queue_1, queue_panel );
+
+    if (checkpoint != nullptr)
+        checkpoint->remove( A.mpiComm() );
+
+    for (int dev = 0; dev < A.num_devices(); ++dev) {
+        if (dwork_array[ dev ] != nullptr) {
+            blas::Queue* queue = A.comm_queue( dev );
+            blas::device_free( dwork_array[ dev ], *queue );
+            dwork_array[ dev ] = nullptr;
+        }
+    }
+
+    if (k_end < min_mt_nt) {
+        int64_t jj = 0;  // column index of block-column k_end
+        for (int64_t k = 0; k < k_end; ++k)
+            jj += A.tileNb( k );
+        int64_t info_tail = getrf_tail<target>(
+                                A, pivots, k_end, p_tail, q_tail, opts );
+        if (info == 0 && info_tail > 0)
+            info = jj + info_tail;
+    }
 
-    internal::reduce_info( &info, A.mpiComm() );
+    internal::reduce_info( &info, A.mpiComm(), opts );
     return info;
 }
 
+//------------------------------------------------------------------------------
+/// Distributed parallel LU factorization, scheduled by the work-stealing
+/// runtime (TaskRuntime::WorkStealing). Host only.
+/// Row swaps cover whole block-columns, so dependencies are by
+/// block-column, as in the OpenMP version, but each trailing column is its
+/// own task, so column j can be updated by step k+1 while other columns
+/// are still updated by step k.
+/// Communication of the jth tile column uses the MPI tag j, protected by
+/// the column's dependencies on all ranks.
+/// @ingroup gesv_impl
+///
+template <typename scalar_t>
+int64_t getrf_graph(
+    Matrix<scalar_t>& A, Pivots& pivots,
+    Options const& opts )
+{
+    using real_t = blas::real_type<scalar_t>;
+    using BcastList = typename Matrix<scalar_t>::BcastList;
+    using Key = internal::TaskGraph::Key;
+
+    // Constants
+    const scalar_t one = 1.0;
+    const int priority_0 = 0;
+    const int priority_1 = 1;
+    const int priority_2 = 2;
+    const int queue_0 = 0;
+    const Layout layout = Layout::ColMajor;
+
+    // Options
+    real_t pivot_threshold = get_option<Option::PivotThreshold>( opts, 1.0 );
+    int64_t lookahead = get_lookahead( opts );
+    int64_t ib = get_option<Option::InnerBlocking>( opts, 16 );
+    bool progress_thread = get_option<Option::ProgressThread>( opts, false );
+    BcastPrecision bcast_precision = get_option<Option::BcastPrecision>(
+                                         opts, BcastPrecision::Native );
+    bool bcast_partitioned = get_option<Option::BcastPartitioned>( opts, false );
+    int64_t max_panel_threads  = std::max( omp_get_max_threads()/2, 1 );
+    max_panel_threads = get_option<Option::MaxPanelThreads>(
+                                                      opts, max_panel_threads );
+    GrowthStats* growth = get_option<Option::GrowthStats>( opts, nullptr );
+
+    int64_t info = 0;
+    int64_t A_nt = A.nt();
+    int64_t A_mt = A.mt();
+    int64_t min_mt_nt = std::min(A.mt(), A.nt());
+    pivots.resize(min_mt_nt);
+
+    // Growth statistics as in the OpenMP version.
+    if (growth != nullptr)
+        growth->reset();
+
+    auto column = []( int64_t j ) { return Key{ 'A', 0, j }; };
+
+    // set min number for omp nested active parallel regions
+    slate::OmpSetMaxActiveLevels set_active_levels( MinOmpActiveLevels );
+
+    // Drive panel broadcasts while the trailing update runs.
+    internal::ProgressThread progress( progress_thread );
+
+    internal::TaskGraph graph;
+    graph.run( [&]( internal::TaskGraph& g ) {
+        int64_t kk = 0;  // column index (not block-column)
+        for (int64_t k = 0; k < min_mt_nt; ++k) {
+
+            int64_t diag_len = std::min(A.tileMb(k), A.tileNb(k));
+            pivots.at(k).resize(diag_len);
+
+            // panel, high priority
+            g.add( priority_2, {}, { column( k ) }, [&, k, kk, diag_len] {
+                trace::Block trace_block( "getrf::panel", k );
+
+                // factor A(k:mt-1, k)
+                int64_t iinfo;
+                if (k == 0) {
+                    internal::growth_update_A(
+                        growth, A.sub(0, A_mt-1, 0, 0), priority_1 );
+                }
+                internal::getrf_panel<Target::HostTask>(
+                    A.sub(k, A_mt-1, k, k), diag_len, ib, pivots.at(k),
+                    pivot_threshold, max_panel_threads, priority_1, k, &iinfo );
+                if (info == 0 && iinfo > 0)
+                    info = kk + iinfo;
+                internal::growth_update_U(
+                    growth, Uplo::Upper, A.sub(k, k, k, k), priority_1 );
+
+                trace::Block trace_block_bcast( "getrf::bcast", k );
+
+                // Root broadcasts the pivots to all ranks, packed, while
+                // the panel tiles are sent.
+                std::vector<int64_t> pivots_packed;
+                internal::pack_pivots( pivots.at(k), pivots_packed );
+                MPI_Request pivots_request;
+                MPI_Ibcast(pivots_packed.data(), pivots_packed.size(),
+                           MPI_INT64_T, A.tileRank(k, k), A.mpiComm(),
+                           &pivots_request);
+
+                BcastList bcast_list_A;
+                int tag_k = k;
+                for (int64_t i = k; i < A_mt; ++i) {
+                    // send A(i, k) across row A(i, k+1:nt-1)
+                    bcast_list_A.push_back({i, k, {A.sub(i, i, k+1, A_nt-1)}});
+                }
+                if (bcast_partitioned
+                    || bcast_precision != BcastPrecision::Native) {
+                    A.template listBcastPacked<Target::HostTask>(
+                        bcast_list_A, layout, tag_k, false, bcast_precision,
+                        bcast_partitioned );
+                }
+                else {
+                    A.template listBcast<Target::HostTask>(
+                        bcast_list_A, layout, tag_k );
+                }
+
+                {
+                    trace::Block trace_block("MPI_Wait");
+
+                    MPI_Wait(&pivots_request, MPI_STATUS_IGNORE);
+                }
+                internal::unpack_pivots( pivots_packed, pivots.at(k) );
+            });
+
+            // update each trailing column; lookahead columns first
+            for (int64_t j = k+1; j < A_nt; ++j) {
+                int priority = j < k+1+lookahead ? priority_1 : priority_0;
+                g.add( priority, { column( k ) }, { column( j ) },
+                       [&, j, k, priority] {
+                    trace::Block trace_block(
+                        j < k+1+lookahead ? "getrf::lookahead"
+                                          : "getrf::trailing", k );
+
+                    // swap rows in A(k:mt-1, j)
+                    int tag_j = j;
+                    if (k == 0) {
+                        internal::growth_update_A(
+                            growth, A.sub(0, A_mt-1, j, j), priority );
+                    }
+                    internal::permuteRows<Target::HostTask>(
+                        Direction::Forward, A.sub(k, A_mt-1, j, j), pivots.at(k),
+                        layout, priority, tag_j, queue_0 );
+
+                    auto Akk = A.sub(k, k, k, k);
+                    auto Tkk =
+                        TriangularMatrix<scalar_t>(Uplo::Lower, Diag::Unit, Akk);
+
+                    // solve A(k, k) A(k, j) = A(k, j)
+                    internal::trsm<Target::HostTask>(
+                        Side::Left,
+                        one, std::move( Tkk ), A.sub(k, k, j, j),
+                        priority, layout, queue_0 );
+                    internal::growth_update_U(
+                        growth, Uplo::General, A.sub(k, k, j, j), priority );
+
+                    // send A(k, j) across column A(k+1:mt-1, j)
+                    A.tileBcast(k, j, A.sub(k+1, A_mt-1, j, j), layout, tag_j);
+
+                    // A(k+1:mt-1, j) -= A(k+1:mt-1, k) * A(k, j)
+                    internal::gemm<Target::HostTask>(
+                        -one, A.sub(k+1, A_mt-1, k, k),
+                              A.sub(k, k, j, j),
+                        one,  A.sub(k+1, A_mt-1, j, j),
+                        layout, priority, queue_0 );
+                });
+            }
+
+            // pivot to the left
+            if (k > 0) {
+                g.add( priority_0, { column( k ) },
+                       { column( 0 ), column( k-1 ) }, [&, k] {
+                    // swap rows in A(k:mt-1, 0:k-1)
+                    const int tag_0 = 0;
+                    internal::permuteRows<Target::HostTask>(
+                        Direction::Forward, A.sub(k, A_mt-1, 0, k-1), pivots.at(k),
+                        layout, priority_0, tag_0, queue_0 );
+                });
+            }
+
+            g.add( priority_0, {}, { column( k ) }, [&, k] {
+                auto left_panel = A.sub( k, A_mt-1, k, k );
+                auto top_panel = A.sub( k, k, k+1, A_nt-1 );
+
+                // Erase remote tiles
+                left_panel.releaseRemoteWorkspace();
+                top_panel.releaseRemoteWorkspace();
+            });
+            kk += A.tileNb( k );
+        }
+    });
+
+    A.tileLayoutReset();
+    A.clearWorkspace();
+
+    internal::reduce_info( &info, A.mpiComm(), opts );
+    return info;
+}
+
+//------------------------------------------------------------------------------
+/// Small-problem fast path of getrf: the rank owning all tiles of A gathers
+/// them and calls LAPACK getrf, without tasks. The LAPACK pivots are
+/// broadcast and converted to SLATE pivots, relative to each panel.
+/// Requires square diagonal tiles, except the last.
+/// @see internal::small_path
+///
+template <typename scalar_t>
+int64_t getrf_small(
+    Matrix<scalar_t>& A, Pivots& pivots, int owner, Options const& opts )
+{
+    int64_t m = A.m();
+    int64_t n = A.n();
+    int64_t min_mn = std::min( m, n );
+    int64_t min_mt_nt = std::min( A.mt(), A.nt() );
+
+    GrowthStats* growth = get_option<Option::GrowthStats>( opts, nullptr );
+    if (growth != nullptr)
+        growth->reset();
+
+    int64_t info = 0;
+    std::vector<int64_t> ipiv( std::max( min_mn, int64_t( 1 ) ) );
+    if (A.mpiRank() == owner) {
+        int64_t lda = std::max( m, int64_t( 1 ) );
+        std::vector<scalar_t> Adata( lda*n );
+        internal::small_gather( A, Adata.data(), lda );
+        if (growth != nullptr) {
+            growth->updateA( lapack::lange(
+                Norm::Max, m, n, Adata.data(), lda ) );
+        }
+        info = lapack::getrf( m, n, Adata.data(), lda, ipiv.data() );
+        if (growth != nullptr) {
+            growth->updateU( lapack::lantr(
+                Norm::Max, Uplo::Upper, Diag::NonUnit, min_mn, n,
+                Adata.data(), lda ) );
+        }
+        internal::small_scatter( A, Adata.data(), lda );
+    }
+    slate_mpi_call(
+        MPI_Bcast( ipiv.data(), min_mn, mpi_type<int64_t>::value,
+                   owner, A.mpiComm() ) );
+
+    // Pivot kk + i of LAPACK is the 1-based row swapped with row kk + i,
+    // i.e., the pivot in tile t >= k of panel k.
+    pivots.resize( min_mt_nt );
+    int64_t kk = 0;
+    for (int64_t k = 0; k < min_mt_nt; ++k) {
+        int64_t diag_len = std::min( A.tileMb( k ), A.tileNb( k ) );
+        pivots.at( k ).resize( diag_len );
+        for (int64_t i = 0; i < diag_len; ++i) {
+            int64_t row = ipiv[ kk + i ] - 1;
+            int64_t t = k;
+            int64_t row0 = kk;
+            while (row >= row0 + A.tileMb( t )) {
+                row0 += A.tileMb( t );
+                ++t;
+            }
+            pivots[ k ][ i ] = Pivot( t - k, row - row0 );
+        }
+        kk += diag_len;
+    }
+
+    internal::reduce_info( &info, A.mpiComm(), opts );
+    return info;
+}
+
+//------------------------------------------------------------------------------
+/// Forward substitution B = L^{-1} P B with the factors of getrf, for the
+/// methods that don't apply it during the factorization.
+/// @ingroup gesv_impl
+///
+template <typename scalar_t>
+void getrf_forward(
+    Matrix<scalar_t>& A, Pivots& pivots, Matrix<scalar_t>& B,
+    Options const& opts )
+{
+    const scalar_t one = 1.0;
+    const int priority_0 = 0;
+    const int queue_0 = 0;
+    const int tag_0 = 0;
+
+    MethodLU method = get_option<Option::MethodLU>( opts, MethodLU::PartialPiv );
+    if (method != MethodLU::NoPiv) {
+        #pragma omp parallel
+        #pragma omp master
+        {
+            for (int64_t k = 0; k < B.mt(); ++k) {
+                // swap rows in B(k:mt-1, :)
+                internal::permuteRows<Target::HostTask>(
+                    Direction::Forward, B.sub( k, B.mt()-1, 0, B.nt()-1 ),
+                    pivots.at( k ), Layout::ColMajor,
+                    priority_0, tag_0, queue_0 );
+            }
+            #pragma omp taskwait
+        }
+        B.tileUpdateAllOrigin();
+        B.tileLayoutReset();
+    }
+
+    auto L = TriangularMatrix<scalar_t>( Uplo::Lower, Diag::Unit, A );
+    trsm( Side::Left, one, L, B, opts );
+}
+
+//------------------------------------------------------------------------------
+/// Runs the getrf method selected by opts.
+/// If rhs is not null, also applies the forward substitution
+/// rhs = L^{-1} P rhs, during the factorization where the method allows.
+/// @see slate::getrf
+///
+template <typename scalar_t>
+int64_t getrf_method(
+    Matrix<scalar_t>& A, Pivots& pivots,
+    Options const& opts_tuned, Matrix<scalar_t>* rhs = nullptr )
+{
+    // Methods without a fused path factor, then solve.
+    auto factor_forward = [&]( int64_t info ) {
+        if (rhs != nullptr)
+            getrf_forward( A, pivots, *rhs, opts_tuned );
+        return info;
+    };
+
+    MethodLU method = get_option<Option::MethodLU>( opts_tuned, MethodLU::PartialPiv );
+
+    // todo: info for tntpiv, nopiv
+    if (method == MethodLU::CALU) {
+        // No growth statistics; leave them zero.
+        GrowthStats* growth = get_option<Option::GrowthStats>(
+                                  opts_tuned, nullptr );
+        if (growth != nullptr)
+            growth->reset();
+        return factor_forward( getrf_tntpiv( A, pivots, opts_tuned ) );
+    }
+    else if (method == MethodLU::NoPiv) {
+        // todo: fill in pivots vector?
+        return factor_forward( getrf_nopiv( A, opts_tuned ) );
+    }
+    else if (method == MethodLU::PartialPiv) {
+        Target target = get_option<Option::Target>( opts_tuned, Target::HostTask );
+        TaskRuntime runtime = get_option<Option::TaskRuntime>(
+                                  opts_tuned, TaskRuntime::OpenMP );
+
+        // The small path needs square diagonal tiles, except the last,
+        // for LAPACK's pivots to map to SLATE's panels.
+        int owner;
+        bool square = true;
+        for (int64_t k = 0; k < std::min( A.mt(), A.nt() ) - 1; ++k)
+            square = square && A.tileMb( k ) == A.tileNb( k );
+        if (square
+            && get_option<Option::Checkpoint>( opts_tuned, nullptr ) == nullptr
+            && internal::small_path<scalar_t>( { &A }, opts_tuned, &owner ))
+            return factor_forward(
+                impl::getrf_small( A, pivots, owner, opts_tuned ) );
+
+        if (runtime == TaskRuntime::WorkStealing && target != Target::Devices
+            && target != Target::Hybrid
+            && get_option<Option::Checkpoint>( opts_tuned, nullptr ) == nullptr)
+            return factor_forward( impl::getrf_graph( A, pivots, opts_tuned ) );
+
+        if (rhs != nullptr
+            && (A.mt() != A.nt()
+                || get_option<Option::Checkpoint>( opts_tuned, nullptr )
+                   != nullptr)) {
+            return factor_forward(
+                getrf_method( A, pivots, opts_tuned ) );
+        }
+
+        // Sub-matrices of a non-owning view of A don't update the reference
+        // count of its storage, which the tasks of each step would contend on.
+        auto A_view = internal::nonowning_view( A );
+
+        switch (target) {
+            case Target::Host:
+            case Target::HostTask:
+                return impl::getrf<Target::HostTask>(
+                           A_view, pivots, opts_tuned, rhs );
+
+            case Target::HostNest:
+                return impl::getrf<Target::HostNest>(
+                           A_view, pivots, opts_tuned, rhs );
+
+            case Target::HostBatch:
+                return impl::getrf<Target::HostBatch>(
+                           A_view, pivots, opts_tuned, rhs );
+
+            case Target::Devices:
+            case Target::Hybrid:
+                // Hybrid runs as Devices, splitting the trailing updates.
+                return impl::getrf<Target::Devices>(
+                           A_view, pivots, opts_tuned, rhs );
+        }
+    }
+    else {
+        throw Exception( "unknown value for MethodLU" );
+    }
+    return -3;  // shouldn't happen
+}
+
 } // namespace impl
 
 //------------------------------------------------------------------------------
@@ -278,11 +1200,21 @@ int64_t getrf(
 ///     The pivot indices that define the permutation matrix $P$.
 ///
 /// @param[in] opts
-///     Additional options, as map of name = value pairs. Possible options:
+///     Additional options, as map of name = value pairs.
+///     InnerBlocking, Lookahead, and MaxPanelThreads not set are taken
+///     from the tuning database, if it has an entry (@see TuningDB).
+///     Possible options:
 ///
 ///     - Option::Lookahead:
 ///       Number of panels to overlap with matrix updates.
 ///       lookahead >= 0. Default 1.
+///       LookaheadAuto adapts it at each step from measured panel and
+///       update times, growing as the trailing matrix shrinks.
+///       Only for MethodLU::PartialPiv; otherwise, Auto uses 1.
+///
+///     - Option::MaxLookahead:
+///       Max lookahead for LookaheadAuto. Each panel in flight holds
+///       workspace for a block-column of remote tiles. Default 4.
 ///
 ///     - Option::InnerBlocking:
 ///       Inner blocking to use for panel. Default 16.
@@ -290,12 +1222,72 @@ int64_t getrf(
 ///     - Option::MaxPanelThreads:
 ///       Number of threads to use for panel. Default omp_get_max_threads()/2.
 ///
+///     - Option::Counters:
+///       Pointer to Counters to collect performance counters in, for
+///       phases "getrf", and, with TaskRuntime::OpenMP, "getrf::panel",
+///       "getrf::bcast", and "getrf::update" (lookahead and trailing
+///       updates, including their row broadcasts). Default null: off.
+///
+///     - Option::Checkpoint:
+///       Pointer to Checkpoint to checkpoint the factorization in, and
+///       restart it from, every interval block steps (@see Checkpoint).
+///       Only for MethodLU::PartialPiv, with TaskRuntime::OpenMP.
+///       Default null: off.
+///
 ///     - Option::Target:
 ///       Implementation to target. Possible values:
 ///       - HostTask:  OpenMP tasks on CPU host [default].
 ///       - HostNest:  nested OpenMP parallel for loop on CPU host.
 ///       - HostBatch: batched BLAS on CPU host.
 ///       - Devices:   batched BLAS on GPU device.
+///       - Hybrid:    as Devices, but the host does the trailing gemm of
+///         the last block-columns while the devices update the rest,
+///         with the split balanced at each step by the measured host and
+///         device rates. Only for MethodLU::PartialPiv; others use
+///         Devices.
+///
+///     - Option::HostWorkspaceTiles:
+///       Number of host workspace tiles to reserve, in pinned memory,
+///       for staging transfers to and from GPU devices. Default 0.
+///
+///     - Option::DeviceCacheTiles:
+///       If > 0, max number of tiles per device for each matrix, using
+///       device memory as a least-recently-used tile cache, to handle
+///       matrices larger than device memory. Default 0.
+///
+///     - Option::BcastPrecision:
+///       Precision in which panels are broadcast, e.g., BFloat16.
+///       Receivers update with rounded copies of the panels, so use a
+///       lower precision only where an approximate factorization suffices,
+///       e.g., as a preconditioner. Default Native.
+///       Only for MethodLU::PartialPiv.
+///
+///     - Option::QueuePriority:
+///       Stream priorities of the device compute queues.
+///       - Lookahead: panel and lookahead kernels on high priority
+///         streams, preempting the trailing update [default].
+///       - Uniform: all queues at the default priority.
+///
+///     - Option::ComputePrecision:
+///       Compute mode of the trailing and lookahead updates.
+///       - Native: full precision [default].
+///       - TF32: single precision trsm and gemm may use TF32 tensor
+///         cores on devices, rounding their inputs to 11-bit
+///         significands. Panels stay in full precision.
+///       - Complex3M: complex gemm updates use the 3M algorithm, 25% fewer
+///         flops, on the host and, with cuBLAS, on devices. Its error is
+///         bounded normwise, so the backward error of the factorization
+///         keeps its order, but small imaginary parts of the updates lose
+///         relative accuracy.
+///       Only for MethodLU::PartialPiv.
+///
+///     - Option::PanelTarget:
+///       Where to factor panels with Target::Devices.
+///       - HostTask: on the host with MaxPanelThreads threads [default].
+///       - Devices: on the panel's device with LAPACK's device getrf, so
+///         the LU stays on the device. Applies to panels on one rank and
+///         one device, with PivotThreshold 1; other panels use the host.
+///       Only for MethodLU::PartialPiv.
 ///
 ///     - Option::PivotThreshold:
 ///       Strictness of the pivot selection.  Between 0 and 1 with 1 giving
@@ -308,6 +1300,57 @@ int64_t getrf(
 ///       - MethodLU::NoPiv: no pivoting.
 ///         Note pivots vector is currently ignored for NoPiv.
 ///
+///     - Option::TaskRuntime:
+///       Task runtime for host targets. Possible values:
+///       - OpenMP: OpenMP tasks with block-column dependencies [default].
+///       - WorkStealing: work-stealing scheduler with a task per trailing
+///         block-column, so columns can run ahead to later steps.
+///       Devices always use OpenMP. Only for MethodLU::PartialPiv.
+///     - Option::SmallTiles:
+///       With MethodLU::PartialPiv and a host target, if A has at most this
+///       many tiles, all on one rank, and square diagonal tiles, that rank
+///       calls LAPACK getrf on A directly, without tasks. 0: off.
+///       Default 4.
+///
+///     - Option::TrailingBlock:
+///       Number of block columns per task of the trailing update, with
+///       host targets. Each block waits only for its own updates of
+///       previous steps, so the trailing update of step k overlaps with
+///       the panel of step k+1. Default 1; >= nt gives one task, as with
+///       Target::Devices. Only for MethodLU::PartialPiv.
+///
+///     - Option::TailShrink:
+///       Number of trailing block columns at which the rest of A is
+///       gathered onto a grid of half the process rows and columns, with
+///       redistribute, to finish the factorization there, and scattered
+///       back. This trades two redistributions for fewer, larger
+///       broadcasts when the trailing submatrix is too small to keep all
+///       ranks busy. Requires a 2D block cyclic A. Default 0: off.
+///       Only for MethodLU::PartialPiv with TaskRuntime::OpenMP, and not
+///       with Option::Checkpoint.
+///
+///     - Option::InfoRequest:
+///       Pointer to InfoRequest in which to reduce info over the ranks
+///       without blocking (@see InfoRequest). The routine then returns
+///       this rank's info, and InfoRequest::wait() the reduced info.
+///       Default null: blocking reduction.
+///
+///     - Option::PanelCores:
+///       Number of cores reserved for the panel and communication
+///       threads: the first cores of each rank's affinity mask, which a
+///       launcher binding ranks near their GPU and NIC lists first. The
+///       trailing updates run on the other cores. Set MaxPanelThreads to
+///       at most PanelCores. Linux only. Default 0: off.
+///       Only for MethodLU::PartialPiv with TaskRuntime::OpenMP.
+///
+///     - Option::GrowthStats:
+///       Pointer to GrowthStats in which to accumulate max |a_ij| of A on
+///       entry and max |u_ij| of U, to check the growth factor without
+///       extra passes over A (@see GrowthStats). The tasks of the panels
+///       and updates take them where the tiles are; they are reduced
+///       with info, in the same reduction. Default null: off.
+///       Not for MethodLU::CALU, which leaves them zero.
+///
 /// @return 0: successful exit
 /// @return i > 0: $U(i,i)$ is exactly zero, where $i$ is a 1-based index.
 ///         The factorization has been completed, but the factor $U$ is exactly
@@ -321,38 +1364,81 @@ int64_t getrf(
     Matrix<scalar_t>& A, Pivots& pivots,
     Options const& opts )
 {
-    MethodLU method = get_option<Option::MethodLU>( opts, MethodLU::PartialPiv );
+    // Options the caller didn't set come from the tuning database, if any.
+    Options tuned;
+    Options const& opts_tuned = internal::tuned_options( "getrf", A, opts, tuned );
 
-    // todo: info for tntpiv, nopiv
-    if (method == MethodLU::CALU) {
-        return getrf_tntpiv( A, pivots, opts );
-    }
-    else if (method == MethodLU::NoPiv) {
-        // todo: fill in pivots vector?
-        return getrf_nopiv( A, opts );
-    }
-    else if (method == MethodLU::PartialPiv) {
-        Target target = get_option<Option::Target>( opts, Target::HostTask );
+    internal::CounterPhase c_getrf(
+        get_option<Option::Counters>( opts_tuned, nullptr ), "getrf",
+        lapack::Gflop<scalar_t>::getrf( A.m(), A.n() ) * 1e9 );
 
-        switch (target) {
-            case Target::Host:
-            case Target::HostTask:
-                return impl::getrf<Target::HostTask>( A, pivots, opts );
+    // Row swaps modify panels after they are broadcast, so remote copies
+    // kept by a workspace session are stale, before and after.
+    A.invalidateWorkspaceSession();
+    int64_t info = impl::getrf_method( A, pivots, opts_tuned );
+    A.invalidateWorkspaceSession();
+    return info;
+}
 
-            case Target::HostNest:
-                return impl::getrf<Target::HostNest>( A, pivots, opts );
+//------------------------------------------------------------------------------
+/// Distributed parallel LU factorization, with forward substitution.
+///
+/// Computes the LU factorization $A = P L U$ of a square matrix $A$, as
+/// getrf does, and overwrites B with $L^{-1} P B$, so solving
+/// $A X = B$ only needs the backward substitution $U X = B$ after it.
+///
+/// With MethodLU::PartialPiv, step k of the factorization solves block
+/// row k of B and updates the rows below it, as extra trailing columns:
+/// B reuses the broadcasts of the panels of L, saving a pass over L and
+/// its broadcasts. Otherwise, and with Checkpoint, B is solved after the
+/// factorization; TailShrink and packed broadcasts (BcastPrecision,
+/// BcastPartitioned) are not used.
+///
+//------------------------------------------------------------------------------
+/// @tparam scalar_t
+///     One of float, double, std::complex<float>, std::complex<double>.
+//------------------------------------------------------------------------------
+/// @param[in,out] A
+///     On entry, the n-by-n matrix $A$ to be factored.
+///     On exit, the factors $L$ and $U$ from the factorization $A = P L U$;
+///     the unit diagonal elements of $L$ are not stored.
+///
+/// @param[out] pivots
+///     The pivot indices that define the permutation matrix $P$.
+///
+/// @param[in,out] B
+///     On entry, the n-by-nrhs right hand side matrix $B$, with the block
+///     rows of A and the same MPI communicator.
+///     On exit, $L^{-1} P B$.
+///
+/// @param[in] opts
+///     Additional options, as map of name = value pairs, as for getrf.
+///
+/// @return 0: successful exit
+/// @return i > 0: $U(i,i)$ is exactly zero, where $i$ is a 1-based index.
+///
+/// @ingroup gesv_computational
+///
+template <typename scalar_t>
+int64_t getrf(
+    Matrix<scalar_t>& A, Pivots& pivots,
+    Matrix<scalar_t>& B,
+    Options const& opts )
+{
+    slate_assert( A.mt() == A.nt() );
+    slate_assert( B.mt() == A.mt() );
 
-            case Target::HostBatch:
-                return impl::getrf<Target::HostBatch>( A, pivots, opts );
+    Options tuned;
+    Options const& opts_tuned = internal::tuned_options( "getrf", A, opts, tuned );
 
-            case Target::Devices:
-                return impl::getrf<Target::Devices>( A, pivots, opts );
-        }
-    }
-    else {
-        throw Exception( "unknown value for MethodLU" );
-    }
-    return -3;  // shouldn't happen
+    internal::CounterPhase c_getrf(
+        get_option<Option::Counters>( opts_tuned, nullptr ), "getrf",
+        lapack::Gflop<scalar_t>::getrf( A.m(), A.n() ) * 1e9 );
+
+    A.invalidateWorkspaceSession();
+    int64_t info = impl::getrf_method( A, pivots, opts_tuned, &B );
+    A.invalidateWorkspaceSession();
+    return info;
 }
 
 //------------------------------------------------------------------------------
@@ -377,4 +1463,28 @@ int64_t getrf< std::complex<double> >(
     Matrix< std::complex<double> >& A, Pivots& pivots,
     Options const& opts);
 
+template
+int64_t getrf<float>(
+    Matrix<float>& A, Pivots& pivots,
+    Matrix<float>& B,
+    Options const& opts);
+
+template
+int64_t getrf<double>(
+    Matrix<double>& A, Pivots& pivots,
+    Matrix<double>& B,
+    Options const& opts);
+
+template
+int64_t getrf< std::complex<float> >(
+    Matrix< std::complex<float> >& A, Pivots& pivots,
+    Matrix< std::complex<float> >& B,
+    Options const& opts);
+
+template
+int64_t getrf< std::complex<double> >(
+    Matrix< std::complex<double> >& A, Pivots& pivots,
+    Matrix< std::complex<double> >& B,
+    Options const& opts);
+
 } // namespace slate
@@ -36,8 +36,9 @@ int64_t getrf_nopiv(
     const Layout layout = Layout::ColMajor;
 
     // Options
-    int64_t lookahead = get_option<Option::Lookahead>( opts, 1 );
+    int64_t lookahead = get_lookahead( opts );
     int64_t ib = get_option<Option::InnerBlocking>( opts, 16 );
+    GrowthStats* growth = get_option<Option::GrowthStats>( opts, nullptr );
 
     if (target == Target::Devices) {
         // two batch arrays plus one for each lookahead
@@ -51,6 +52,12 @@ int64_t getrf_nopiv(
     int64_t A_mt = A.mt();
     int64_t min_mt_nt = std::min(A.mt(), A.nt());
 
+    // Growth statistics: max |a_ij| in the tasks of step 0, before they
+    // update the tiles, and max |u_ij| of each block row of U once it is
+    // solved, where the tiles are; reduced with info.
+    if (growth != nullptr)
+        growth->reset();
+
     // OpenMP needs pointer types, but vectors are exception safe
     std::vector< uint8_t > column_vector(A_nt);
     std::vector< uint8_t > diag_vector(A_nt);
@@ -80,11 +87,17 @@ int64_t getrf_nopiv(
             {
                 // factor A(k, k)
                 int64_t iinfo;
+                if (k == 0) {
+                    internal::growth_update_A(
+                        growth, A.sub(0, 0, 0, 0), priority_1 );
+                }
                 internal::getrf_nopiv<Target::HostTask>(
                     A.sub(k, k, k, k), ib, priority_1, &iinfo );
                 if (info == 0 && iinfo > 0) {
                     info = kk + iinfo;
                 }
+                internal::growth_update_U(
+                    growth, Uplo::Upper, A.sub(k, k, k, k), priority_1 );
 
                 // Update panel
                 int tag_k = k;
@@ -103,6 +116,10 @@ int64_t getrf_nopiv(
                 auto Akk = A.sub(k, k, k, k);
                 auto Tkk = TriangularMatrix<scalar_t>(Uplo::Upper, Diag::NonUnit, Akk);
 
+                if (k == 0) {
+                    internal::growth_update_A(
+                        growth, A.sub(1, A_mt-1, 0, 0), priority_1, queue_0 );
+                }
                 internal::trsm<target>(
                     Side::Right,
                     one, std::move( Tkk ), A.sub(k+1, A_mt-1, k, k),
@@ -132,10 +149,17 @@ int64_t getrf_nopiv(
                         TriangularMatrix<scalar_t>(Uplo::Lower, Diag::Unit, Akk);
 
                     // solve A(k, k) A(k, j) = A(k, j)
+                    if (k == 0) {
+                        internal::growth_update_A(
+                            growth, A.sub(0, 0, j, j), priority_1, queue_jk1 );
+                    }
                     internal::trsm<target>(
                         Side::Left,
                         one, std::move( Tkk ), A.sub(k, k, j, j),
                         priority_1, layout, queue_jk1 );
+                    internal::growth_update_U(
+                        growth, Uplo::General, A.sub(k, k, j, j),
+                        priority_1, queue_jk1 );
 
                     // send A(k, j) across column A(k+1:mt-1, j)
                     A.tileBcast(k, j, A.sub(k+1, A_mt-1, j, j), layout, tag_j);
@@ -146,6 +170,11 @@ int64_t getrf_nopiv(
                                  priority(1)
                 {
                     int queue_jk1 = j-k+1;
+                    if (k == 0) {
+                        internal::growth_update_A(
+                            growth, A.sub(1, A_mt-1, j, j),
+                            priority_1, queue_jk1 );
+                    }
                     // A(k+1:mt-1, j) -= A(k+1:mt-1, k) * A(k, j)
                     internal::gemm<target>(
                         -one, A.sub(k+1, A_mt-1, k, k),
@@ -166,11 +195,20 @@ int64_t getrf_nopiv(
                         TriangularMatrix<scalar_t>(Uplo::Lower, Diag::Unit, Akk);
 
                     // solve A(k, k) A(k, kl+1:nt-1) = A(k, kl+1:nt-1)
+                    if (k == 0) {
+                        internal::growth_update_A(
+                            growth, A.sub(0, 0, 1+lookahead, A_nt-1),
+                            priority_0, queue_1 );
+                    }
                     internal::trsm<target>(
                         Side::Left,
                         one, std::move( Tkk ),
                              A.sub(k, k, k+1+lookahead, A_nt-1),
                         priority_0, layout, queue_1 );
+                    internal::growth_update_U(
+                        growth, Uplo::General,
+                        A.sub(k, k, k+1+lookahead, A_nt-1),
+                        priority_0, queue_1 );
 
                     // send A(k, kl+1:A_nt-1) across A(k+1:mt-1, kl+1:nt-1)
                     BcastListTag bcast_list;
@@ -189,6 +227,11 @@ int64_t getrf_nopiv(
                                  depend(inout:column[k+1+lookahead]) \
                                  depend(inout:column[A_nt-1])
                 {
+                    if (k == 0) {
+                        internal::growth_update_A(
+                            growth, A.sub(1, A_mt-1, 1+lookahead, A_nt-1),
+                            priority_0, queue_1 );
+                    }
                     // A(k+1:mt-1, kl+1:nt-1) -= A(k+1:mt-1, k) * A(k, kl+1:nt-1)
                     internal::gemm<target>(
                         -one, A.sub(k+1, A_mt-1, k, k),
@@ -223,7 +266,7 @@ int64_t getrf_nopiv(
     }
     A.clearWorkspace();
 
-    internal::reduce_info( &info, A.mpiComm() );
+    internal::reduce_info( &info, A.mpiComm(), opts );
     return info;
 }
 
@@ -244,6 +287,10 @@ int64_t getrf_nopiv(
 ///
 /// This is the right-looking Level 3 BLAS version of the algorithm.
 ///
+/// If $A$ tracks structurally zero tiles, zero tiles of $L$ and $U$ are
+/// neither broadcast nor used in the trailing updates, and tiles filled in
+/// by the updates are no longer zero; @see BaseMatrix::trackZeroTiles.
+///
 //------------------------------------------------------------------------------
 /// @tparam scalar_t
 ///     One of float, double, std::complex<float>, std::complex<double>.
@@ -266,6 +313,12 @@ int64_t getrf_nopiv(
 ///       - HostNest:  nested OpenMP parallel for loop on CPU host.
 ///       - HostBatch: batched BLAS on CPU host.
 ///       - Devices:   batched BLAS on GPU device.
+///     - Option::GrowthStats:
+///       Pointer to GrowthStats in which to accumulate max |a_ij| of A on
+///       entry and max |u_ij| of U, to check whether the factorization
+///       without pivoting is stable (@see GrowthStats). The tasks of the
+///       panels and updates take them where the tiles are; they are
+///       reduced with info, in the same reduction. Default null: off.
 ///
 /// @return 0: successful exit
 /// @return i > 0: $U(i,i)$ is exactly zero, where $i$ is a 1-based index.
@@ -278,7 +331,7 @@ int64_t getrf_nopiv(
     Matrix<scalar_t>& A,
     Options const& opts )
 {
-    Target target = get_option( opts, Option::Target, Target::HostTask );
+    Target target = get_target( opts, Target::HostTask );
 
     switch (target) {
         case Target::Host:
@@ -292,6 +345,7 @@ int64_t getrf_nopiv(
             return impl::getrf_nopiv<Target::HostBatch>( A, opts );
 
         case Target::Devices:
+        case Target::Hybrid:
             return impl::getrf_nopiv<Target::Devices>( A, opts );
     }
     return -2;  // shouldn't happen
@@ -38,7 +38,7 @@ int64_t getrf_tntpiv(
     const int queue_2 = 2;
 
     // Options
-    int64_t lookahead = get_option<Option::Lookahead>( opts, 1 );
+    int64_t lookahead = get_lookahead( opts );
     int64_t ib = get_option<Option::InnerBlocking>( opts, 16 );
     int64_t max_panel_threads  = std::max( omp_get_max_threads()/2, 1 );
     max_panel_threads = get_option<Option::MaxPanelThreads>(
@@ -117,9 +117,12 @@ int64_t getrf_tntpiv(
             size_A_bytes = roundup( size_A_bytes, size_t( 8 ) );
             ipiv_bytes   = roundup( ipiv_bytes,   size_t( 8 ) );
 
-            // Size of dA, dwork, dipiv, and dinfo in bytes.
+            // Size of dA, dwork, dipiv, and dinfo in bytes,
+            // plus the workspace for the tournament between ranks.
             dwork_bytes = dsize + size_A_bytes + ipiv_bytes
-                        + sizeof( device_info_int );
+                        + sizeof( device_info_int )
+                        + internal::getrf_tntpiv_tournament_work_bytes<scalar_t>(
+                              nb, *comm_queue );
 
             for (int64_t dev = 0; dev < num_devices; ++dev) {
                 lapack::Queue* queue = A.comm_queue( dev );
@@ -391,7 +394,7 @@ int64_t getrf_tntpiv(
         }
     }
 
-    internal::reduce_info( &info, A.mpiComm() );
+    internal::reduce_info( &info, A.mpiComm(), opts );
     return info;
 }
 
@@ -454,7 +457,7 @@ int64_t getrf_tntpiv(
     Matrix<scalar_t>& A, Pivots& pivots,
     Options const& opts)
 {
-    Target target = get_option( opts, Option::Target, Target::HostTask );
+    Target target = get_target( opts, Target::HostTask );
 
     switch (target) {
         case Target::Host:
@@ -468,6 +471,7 @@ int64_t getrf_tntpiv(
             return impl::getrf_tntpiv<Target::HostBatch>( A, pivots, opts );
 
         case Target::Devices:
+        case Target::Hybrid:
             return impl::getrf_tntpiv<Target::Devices>( A, pivots, opts );
     }
     return -2;  // shouldn't happen
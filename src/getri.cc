@@ -14,17 +14,45 @@ namespace slate {
 
 namespace impl {
 
+//------------------------------------------------------------------------------
+/// Sets the strictly lower triangle of the local tile A(k, k) to zero,
+/// keeping its diagonal, on the tile's device for target = Devices,
+/// else on the host.
+///
+template <Target target, typename scalar_t>
+void getri_zero_lower( TriangularMatrix<scalar_t>& L, int64_t k )
+{
+    const scalar_t zero = 0.0;
+
+    if (! L.tileIsLocal( k, k ))
+        return;
+
+    if (target == Target::Devices) {
+        int device = L.tileDevice( k, k );
+        L.tileGetForWriting( k, k, device, LayoutConvert::ColMajor );
+        auto Lkk = L( k, k, device );
+        if (Lkk.mb() > 1) {
+            blas::Queue* queue = L.compute_queue( device, 0 );
+            device::tzset( Uplo::Lower, Lkk.mb()-1, Lkk.nb(), zero, zero,
+                           &Lkk.at( 1, 0 ), Lkk.stride(), *queue );
+            queue->sync();
+        }
+    }
+    else {
+        L.tileGetForWriting( k, k, LayoutConvert::ColMajor );
+        auto Lkk = L( k, k );
+        tile::tzset( zero, Lkk );
+    }
+}
+
 //------------------------------------------------------------------------------
 /// Distributed parallel inverse of a general matrix.
 /// Generic implementation for any target.
+/// For target = Devices, the workspace is on the devices, and the copies,
+/// trsm, gemmA, and the column pivoting are done on the devices.
+/// Other host targets use HostTask throughout.
 /// @ingroup gesv_impl
 ///
-/// todo: This routine is in-place and does not support GPUs.
-///       There is another one (out-of-place) that does.
-///       What if this one is called with Target::Devices?
-///       a) execute on CPUs,
-///       b) error out (not supported)?
-///
 template <Target target, typename scalar_t>
 void getri(
     Matrix<scalar_t>& A, Pivots& pivots,
@@ -38,13 +66,25 @@ void getri(
     const scalar_t zero = 0.0;
     const scalar_t one  = 1.0;
     const int priority_0 = 0;
+    const int tag_0 = 0;
+    const int queue_0 = 0;
 
     // Assumes column major
     const Layout layout = Layout::ColMajor;
+    // Host targets other than HostTask lack copy and column pivoting.
+    const Target target_impl = (target == Target::Devices ? Target::Devices
+                                                           : Target::HostTask);
 
     // auto U = TriangularMatrix<scalar_t>(Uplo::Upper, Diag::NonUnit, A);
     auto L = TriangularMatrix<scalar_t>(Uplo::Lower, Diag::Unit, A);
 
+    if (target == Target::Devices) {
+        if (A.num_devices() > 1)
+            slate_not_implemented( "getri doesn't support multiple GPUs" );
+        A.allocateBatchArrays();
+        A.reserveDeviceWorkspace();
+    }
+
     #pragma omp parallel
     #pragma omp master
     {
@@ -52,24 +92,21 @@ void getri(
         {
             auto Akk = A.sub(k, k, k, k);
             auto W = Akk.template emptyLike<scalar_t>();
-            W.insertLocalTiles(Target::HostTask);
+            W.insertLocalTiles(target_impl);
 
             // Copy A(k, k) to W.
             // todo: Copy L(k, k) to W.
-            internal::copy<Target::HostTask>(std::move(Akk), std::move(W));
+            internal::copy<target_impl>(std::move(Akk), std::move(W));
 
             // Zero L(k, k).
-            if (L.tileIsLocal(k, k)) {
-                auto Lkk = L(k, k);
-                tile::tzset( zero, Lkk );
-            }
+            getri_zero_lower<target_impl>( L, k );
 
             // send W down col A(0:nt-1, k)
-            W.template tileBcast(
+            W.template tileBcast<target_impl>(
                 0, 0, A.sub(0, A.nt()-1, k, k), layout);
 
             auto Wkk = TriangularMatrix<scalar_t>(Uplo::Lower, Diag::Unit, W);
-            internal::trsm<Target::HostTask>(
+            internal::trsm<target_impl>(
                 Side::Right,
                 one, std::move( Wkk ), A.sub(0, A.nt()-1, k, k),
                 priority_0, layout );
@@ -82,23 +119,17 @@ void getri(
 
             auto Lk = A.sub(k, A.nt()-1, k, k);
             auto W = Lk.template emptyLike<scalar_t>();
-            W.insertLocalTiles(Target::HostTask);
+            W.insertLocalTiles(target_impl);
 
             // Copy L(:, k) to W.
-            internal::copy<Target::HostTask>(std::move(Lk), std::move(W));
+            internal::copy<target_impl>(std::move(Lk), std::move(W));
 
             // Zero L(k, k).
-            if (L.tileIsLocal(k, k)) {
-                auto Lkk = L(k, k);
-                tile::tzset( zero, Lkk );
-            }
+            getri_zero_lower<target_impl>( L, k );
 
             // Zero L(k+1:A_nt-1, k).
-            for (int64_t i = k+1; i < A.nt(); ++i) {
-                if (L.tileIsLocal(i, k)) {
-                    L(i, k).set(0.0);
-                }
-            }
+            internal::set<target_impl>(
+                zero, zero, A.sub(k+1, A.nt()-1, k, k) );
 
             // send W across A
             BcastList bcast_list_W;
@@ -106,10 +137,10 @@ void getri(
                 // send W(i) down column A(0:nt-1, k+i)
                 bcast_list_W.push_back({i, 0, {A.sub(0, A.nt()-1, k+i, k+i)}});
             }
-            W.template listBcast(bcast_list_W, layout);
+            W.template listBcast<target_impl>(bcast_list_W, layout);
 
             // A(:, k) -= A(:, k+1:nt-1) * W
-            internal::gemmA<Target::HostTask>(
+            internal::gemmA<target_impl>(
                 -one, A.sub(0, A.nt()-1, k+1, A.nt()-1),
                       W.sub(1, W.mt()-1, 0, 0),
                 one,  A.sub(0, A.nt()-1, k, k),
@@ -124,17 +155,18 @@ void getri(
                                           {A.sub(i, i, k+1, A.nt()-1)}
                                         });
             }
-            A.template listReduce(reduce_list_A, layout);
+            A.template listReduce<target_impl>(reduce_list_A, layout);
 
             // Release workspace tiles from gemmA
             A.sub(0, A.nt()-1, k, k).releaseRemoteWorkspace();
 
             // send W(0, 0) down col A(0:nt-1, k)
-            W.tileBcast(0, 0, A.sub(0, A.nt()-1, k, k), layout);
+            W.template tileBcast<target_impl>(
+                0, 0, A.sub(0, A.nt()-1, k, k), layout);
 
             auto Wkk = W.sub(0, 0, 0, 0);
             auto Tkk = TriangularMatrix<scalar_t>(Uplo::Lower, Diag::Unit, Wkk);
-            internal::trsm<Target::HostTask>(
+            internal::trsm<target_impl>(
                 Side::Right,
                 one, std::move( Tkk ), A.sub(0, A.nt()-1, k, k),
                 priority_0, layout );
@@ -143,12 +175,19 @@ void getri(
         }
 
         // Apply column pivoting.
+        // The rows of transpose(A) are contiguous in its column major
+        // tiles, as the devices need to swap them.
         for (int64_t j = A.nt()-1; j >= 0; --j) {
-            internal::permuteRows<Target::HostTask>(
+            internal::permuteRows<target_impl>(
                 Direction::Backward, transpose(A).sub(j, A.nt()-1, 0, A.nt()-1),
-                pivots.at(j), Layout::ColMajor);
+                pivots.at(j), Layout::ColMajor, priority_0, tag_0, queue_0);
         }
+
+        #pragma omp taskwait
+        A.tileUpdateAllOrigin();
     }
+
+    A.releaseWorkspace();
 }
 
 } // namespace impl
@@ -194,7 +233,7 @@ void getri(
     auto U = TriangularMatrix<scalar_t>(Uplo::Upper, Diag::NonUnit, A);
     trtri(U, opts);
 
-    Target target = get_option( opts, Option::Target, Target::HostTask );
+    Target target = get_target( opts, Target::HostTask );
 
     switch (target) {
         case Target::Host:
@@ -211,6 +250,7 @@ void getri(
             break;
 
         case Target::Devices:
+        case Target::Hybrid:
             impl::getri<Target::Devices>( A, pivots, opts );
             break;
     }
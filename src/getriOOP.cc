@@ -16,6 +16,8 @@ namespace slate {
 ///
 /// Computes the inverse of a matrix $A$ using the LU factorization $A = L*U$
 /// computed by `getrf`. Stores the result in $B$. Does not change $A$.
+/// With Target::Devices, $B$ is set to the identity, pivoted, and solved
+/// on the devices, without moving $B$ to the host.
 ///
 //------------------------------------------------------------------------------
 /// @tparam scalar_t
@@ -9,8 +9,60 @@
 #include "slate/TriangularMatrix.hh"
 #include "internal/internal.hh"
 
+#include "lapack/flops.hh"
+
 namespace slate {
 
+namespace impl {
+
+//------------------------------------------------------------------------------
+/// Applies the row pivots of getrf to B, forward (B = P B) or
+/// backward (B = P^T B).
+/// For target = Devices, rows are swapped on the devices, in row major
+/// tiles, which are then converted back to column major, on the devices,
+/// instead of moving B to the host.
+///
+template <typename scalar_t>
+void permute_rhs(
+    Direction direction, Pivots& pivots, Matrix<scalar_t>& B, Target target )
+{
+    const int priority_0 = 0;
+    const int tag_0 = 0;
+    const int queue_0 = 0;
+
+    bool on_devices = target == Target::Devices && B.num_devices() > 0;
+    Layout layout = on_devices ? Layout::RowMajor : Layout::ColMajor;
+
+    int64_t begin = 0, end = B.mt(), inc = 1;
+    if (direction == Direction::Backward) {
+        begin = B.mt()-1;
+        end   = -1;
+        inc   = -1;
+    }
+    for (int64_t k = begin; k != end; k += inc) {
+        // swap rows in B(k:mt-1, 0:nt-1)
+        auto Bk = B.sub( k, B.mt()-1, 0, B.nt()-1 );
+        if (on_devices) {
+            internal::permuteRows<Target::Devices>(
+                direction, std::move( Bk ), pivots.at( k ),
+                layout, priority_0, tag_0, queue_0 );
+        }
+        else {
+            internal::permuteRows<Target::HostTask>(
+                direction, std::move( Bk ), pivots.at( k ),
+                layout, priority_0, tag_0, queue_0 );
+        }
+    }
+    if (on_devices) {
+        B.tileGetAllForWritingOnDevices( LayoutConvert::ColMajor );
+        // Backward pivoting is the last step of the solve.
+        if (direction == Direction::Backward)
+            B.tileUpdateAllOrigin();
+    }
+}
+
+} // namespace impl
+
 //------------------------------------------------------------------------------
 /// Distributed parallel LU solve.
 ///
@@ -46,6 +98,10 @@ namespace slate {
 ///       Number of panels to overlap with matrix updates.
 ///       lookahead >= 0. Default 1.
 ///
+///     - Option::Counters:
+///       Pointer to Counters to collect performance counters in, for
+///       phases "getrs". Default null: off.
+///
 ///     - Option::Target:
 ///       Implementation to target. Possible values:
 ///       - HostTask:  OpenMP tasks on CPU host [default].
@@ -53,6 +109,14 @@ namespace slate {
 ///       - HostBatch: batched BLAS on CPU host.
 ///       - Devices:   batched BLAS on GPU device.
 ///
+///     - Option::ChunkSize:
+///       Number of columns of B to solve at a time, rounded up to whole
+///       tiles; chunk >= 1. With many right hand sides, B is streamed in
+///       chunks of block columns through the pivoting and both solves,
+///       with the tiles of L and U broadcast once and kept, on the ranks
+///       and devices of B, for all chunks, so the workspace for B is
+///       bounded by the chunk. Default: all of B at once.
+///
 ///    - Option::MethodLU:
 ///      Algorithm for LU factorization.
 ///       - MethodLU::PartialPiv: partial pivoting [default].
@@ -76,42 +140,72 @@ void getrs(Matrix<scalar_t>& A, Pivots& pivots,
     assert(A.mt() == A.nt());
     assert(B.mt() == A.mt());
 
+    internal::CounterPhase c_getrs(
+        get_option<Option::Counters>( opts, nullptr ), "getrs",
+        lapack::Gflop<scalar_t>::getrs( A.n(), B.n() ) * 1e9 );
+
     auto L = TriangularMatrix<scalar_t>(Uplo::Lower, Diag::Unit, A);
     auto U = TriangularMatrix<scalar_t>(Uplo::Upper, Diag::NonUnit, A);
 
-    if (A.op() == Op::NoTrans) {
-        if (method != MethodLU::NoPiv) {
-            // Pivot the right hand side matrix.
-            for (int64_t k = 0; k < B.mt(); ++k) {
-                // swap rows in B(k:mt-1, 0:nt-1)
-                internal::permuteRows<Target::HostTask>(
-                    Direction::Forward, B.sub(k, B.mt()-1, 0, B.nt()-1),
-                    pivots.at(k), Layout::ColMajor);
+    int64_t chunk = get_option<int64_t>( opts, Option::ChunkSize, B.n() );
+    bool resident = get_option<Option::FactorsResident>( opts, false );
+    slate_assert( chunk >= 1 );
+
+    Target target = get_target( opts, Target::HostTask );
+
+    Options opts_chunk = opts;
+    bool release = false;
+    if (chunk < B.n() && ! resident) {
+        // Broadcast L and U once for all chunks of B.
+        impl::trsm_resident_bcast( L, B, target );
+        impl::trsm_resident_bcast( U, B, target );
+        opts_chunk[ Option::MethodTrsm ] = MethodTrsm::B;
+        opts_chunk[ Option::FactorsResident ] = true;
+        release = true;
+    }
+
+    // Solve for block columns j1:j2 of B at a time,
+    // with at least chunk columns each, except the last.
+    int64_t j1 = 0;
+    while (j1 < B.nt()) {
+        int64_t j2 = j1;
+        int64_t ncols = B.tileNb( j1 );
+        while (ncols < chunk && j2 < B.nt()-1) {
+            ++j2;
+            ncols += B.tileNb( j2 );
+        }
+        auto Bc = B.sub( 0, B.mt()-1, j1, j2 );
+
+        if (A.op() == Op::NoTrans) {
+            if (method != MethodLU::NoPiv) {
+                // Pivot the right hand side matrix.
+                impl::permute_rhs( Direction::Forward, pivots, Bc, target );
             }
+
+            // Forward substitution, Y = L^{-1} P B.
+            trsm(Side::Left, one, L, Bc, opts_chunk);
+
+            // Backward substitution, X = U^{-1} Y.
+            trsm(Side::Left, one, U, Bc, opts_chunk);
         }
+        else {
+            // Forward substitution, Y = U^{-T} B.
+            trsm(Side::Left, one, U, Bc, opts_chunk);
 
-        // Forward substitution, Y = L^{-1} P B.
-        trsm(Side::Left, one, L, B, opts);
+            // Backward substitution, Xhat = L^{-T} Y.
+            trsm(Side::Left, one, L, Bc, opts_chunk);
 
-        // Backward substitution, X = U^{-1} Y.
-        trsm(Side::Left, one, U, B, opts);
-    }
-    else {
-        // Forward substitution, Y = U^{-T} B.
-        trsm(Side::Left, one, U, B, opts);
-
-        // Backward substitution, Xhat = L^{-T} Y.
-        trsm(Side::Left, one, L, B, opts);
-
-        if (method != MethodLU::NoPiv) {
-            // Pivot the right hand side matrix, X = P^T Xhat
-            for (int64_t k = B.mt()-1; k >= 0; --k) {
-                // swap rows in B(k:mt-1, 0:nt-1)
-                internal::permuteRows<Target::HostTask>(
-                    Direction::Backward, B.sub(k, B.mt()-1, 0, B.nt()-1),
-                    pivots.at(k), Layout::ColMajor);
+            if (method != MethodLU::NoPiv) {
+                // Pivot the right hand side matrix, X = P^T Xhat
+                impl::permute_rhs( Direction::Backward, pivots, Bc, target );
             }
         }
+        j1 = j2 + 1;
+    }
+
+    if (release) {
+        A.releaseRemoteWorkspace();
+        A.releaseLocalWorkspace();
     }
     // todo: return value for errors?
 }
@@ -10,7 +10,11 @@
 #include "slate/TriangularMatrix.hh"
 #include "internal/internal.hh"
 
+#include <algorithm>
 #include <atomic>
+#include <limits>
+#include <list>
+#include <set>
 
 namespace slate {
 
@@ -188,6 +192,678 @@ void hb2st_run(
     }
 }
 
+//------------------------------------------------------------------------------
+/// @internal
+/// Copies the local tiles of the lower band of A to LAPACK band storage,
+/// with entry (i, j) in AB[ i + j*lda ]. AB has dimension (lda + 1)*n.
+///
+template <typename scalar_t>
+void hb2st_get_band(
+    HermitianBandMatrix<scalar_t>& A,
+    std::vector<scalar_t>& AB, int64_t lda )
+{
+    int64_t n    = A.n();
+    int64_t nt   = A.nt();
+    int64_t band = A.bandwidth();
+
+    AB.assign( (lda + 1)*n, scalar_t( 0 ) );
+    int64_t jj = 0;
+    for (int64_t j = 0; j < nt; ++j) {
+        int64_t ii = jj;
+        int64_t i_end = std::min( j + ceildiv( band, A.tileNb( j ) ) + 1, nt );
+        for (int64_t i = j; i < i_end; ++i) {
+            if (A.tileIsLocal( i, j )) {
+                A.tileGetForReading( i, j, HostNum, LayoutConvert::ColMajor );
+                auto Aij = A( i, j );
+                for (int64_t c = 0; c < Aij.nb(); ++c) {
+                    for (int64_t r = 0; r < Aij.mb(); ++r) {
+                        int64_t d = ii + r - (jj + c);
+                        if (0 <= d && d <= band)
+                            AB[ ii + r + (jj + c)*lda ] = Aij( r, c );
+                    }
+                }
+            }
+            ii += A.tileMb( i );
+        }
+        jj += A.tileNb( j );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// @internal
+/// Copies LAPACK band storage back to the local tiles of the lower band of A.
+/// @see hb2st_get_band
+///
+template <typename scalar_t>
+void hb2st_set_band(
+    HermitianBandMatrix<scalar_t>& A,
+    std::vector<scalar_t> const& AB, int64_t lda )
+{
+    int64_t nt   = A.nt();
+    int64_t band = A.bandwidth();
+
+    int64_t jj = 0;
+    for (int64_t j = 0; j < nt; ++j) {
+        int64_t ii = jj;
+        int64_t i_end = std::min( j + ceildiv( band, A.tileNb( j ) ) + 1, nt );
+        for (int64_t i = j; i < i_end; ++i) {
+            if (A.tileIsLocal( i, j )) {
+                A.tileGetForWriting( i, j, HostNum, LayoutConvert::ColMajor );
+                auto Aij = A( i, j );
+                for (int64_t c = 0; c < Aij.nb(); ++c) {
+                    for (int64_t r = 0; r < Aij.mb(); ++r) {
+                        int64_t d = ii + r - (jj + c);
+                        if (0 <= d && d <= band)
+                            Aij.at( r, c ) = AB[ ii + r + (jj + c)*lda ];
+                    }
+                }
+            }
+            ii += A.tileMb( i );
+        }
+        jj += A.tileNb( j );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// @internal
+/// Implements tridiagonal bulge chasing on one GPU device.
+/// Copies the lower band of A to the device in LAPACK band storage, with
+/// room for the bulge, then runs all steps with the same wavefront
+/// 3*sweep + step in one launch, in the same order of dependencies as
+/// hb2st_run. Reflectors of a group of band sweeps are kept in a ring of
+/// device buffers and copied to their tiles of V once the group finishes.
+///
+/// @return false if the device implementation does not apply, e.g.,
+/// for an upper matrix, in which case A and V are unchanged.
+///
+template <typename scalar_t>
+bool hb2st_device(
+    HermitianBandMatrix<scalar_t>& A,
+    Matrix<scalar_t>& V )
+{
+    int64_t n    = A.n();
+    int64_t nt   = A.nt();
+    int64_t band = A.bandwidth();
+
+    if (A.num_devices() == 0 || A.uplo() != Uplo::Lower || band < 1
+        || V.tileMb( 0 ) != 2*band || V.tileNb( 0 ) != band)
+        return false;
+
+    // No sweeps, nothing to do.
+    if (n < 2)
+        return true;
+
+    const int device = 0;
+    A.allocateBatchArrays();
+    blas::Queue* queue = A.compute_queue( device );
+
+    // Lower band of A, with room for the bulge.
+    int64_t lda  = 2*band;
+    int64_t ldab = lda + 1;
+    std::vector<scalar_t> hAB;
+    hb2st_get_band( A, hAB, lda );
+
+    // Sweeps s in [ g*band, (g+1)*band ) form group g of V, with
+    // nt - g tiles starting at tile vindex( g ), as in hb2st_step.
+    int64_t nsweeps = n - 1;
+    int64_t ngroups = ceildiv( nsweeps, band );
+    auto nsteps = [&]( int64_t sweep ) {
+        return 2*ceildiv( n - 1 - sweep, band ) - 1;
+    };
+    auto vindex = [&]( int64_t g ) {
+        return g*nt - g*(g - 1)/2;
+    };
+    // Last wavefront of group g.
+    auto wave_end = [&]( int64_t g ) {
+        int64_t s = std::min( (g+1)*band, nsweeps ) - 1;
+        return 3*s + nsteps( s ) - 1;
+    };
+
+    // Groups in flight at once: group g is still active when
+    // later groups up to 3*g2*band <= wave_end( g ) start.
+    int64_t vgroups = 1;
+    for (int64_t g = 0; g < ngroups; ++g) {
+        int64_t g2 = std::min( wave_end( g ) / (3*band), ngroups - 1 );
+        vgroups = std::max( vgroups, g2 - g + 1 );
+    }
+    int64_t ldv = 2*band;
+    int64_t vtile = ldv*band;
+    int64_t vgroup_stride = nt*vtile;
+
+    // Sweeps in a wavefront start 3 waves apart.
+    int64_t max_sweeps = std::min( nsweeps, ceildiv( nsteps( 0 ), int64_t( 3 ) ) + 1 );
+
+    scalar_t* dAB   = blas::device_malloc<scalar_t>( ldab*n, *queue );
+    scalar_t* dV    = blas::device_malloc<scalar_t>( vgroups*vgroup_stride, *queue );
+    scalar_t* dwork = blas::device_malloc<scalar_t>( max_sweeps*band, *queue );
+    blas::device_memcpy<scalar_t>( dAB, hAB.data(), ldab*n, *queue );
+    blas::device_memset( dV, 0, vgroups*vgroup_stride, *queue );
+
+    int64_t sweep_begin = 0;
+    int64_t g_done = 0;
+    for (int64_t wave = 0; sweep_begin < nsweeps; ++wave) {
+        // Skip sweeps that are finished by this wavefront.
+        while (sweep_begin < nsweeps
+               && wave - 3*sweep_begin >= nsteps( sweep_begin ))
+            ++sweep_begin;
+        int64_t sweep_end = std::min( wave/3 + 1, nsweeps );
+        int64_t sweep_count = sweep_end - sweep_begin;
+        if (sweep_count > 0) {
+            slate_assert( sweep_count <= max_sweeps );
+            device::hb2st_wave(
+                n, band, wave, sweep_begin, sweep_count,
+                dAB, lda, dV, ldv, vgroup_stride, vgroups, dwork, *queue );
+        }
+
+        // Copy reflectors of finished groups to V and clear their buffers.
+        for (; g_done < ngroups && wave_end( g_done ) <= wave; ++g_done) {
+            scalar_t* dVg = &dV[ (g_done % vgroups)*vgroup_stride ];
+            for (int64_t t = 0; t < nt - g_done; ++t) {
+                auto Vt = V( 0, vindex( g_done ) + t );
+                blas::device_memcpy_2d<scalar_t>(
+                    Vt.data(), Vt.stride(),
+                    &dVg[ t*vtile ], ldv,
+                    Vt.mb(), Vt.nb(), *queue );
+            }
+            blas::device_memset( dVg, 0, vgroup_stride, *queue );
+        }
+    }
+    slate_assert( g_done == ngroups );
+
+    blas::device_memcpy<scalar_t>( hAB.data(), dAB, ldab*n, *queue );
+    queue->sync();
+
+    blas::device_free( dAB, *queue );
+    blas::device_free( dV, *queue );
+    blas::device_free( dwork, *queue );
+
+    // The band is now tridiagonal.
+    hb2st_set_band( A, hAB, lda );
+
+    A.bandwidth( 1 );
+    return true;
+}
+
+//------------------------------------------------------------------------------
+/// @internal
+/// Applies a Householder reflector to the lower triangle of a Hermitian
+/// block from both sides, $A = H^H A H$, with $H = I - \tau v v^H$,
+/// as in LAPACK hetd2. v[0] holds tau; the reflector has v[0] = 1.
+/// Uses 2*m entries of work.
+///
+template <typename scalar_t>
+void hb2st_herf(
+    int64_t m, scalar_t const* v,
+    scalar_t* A, int64_t lda, scalar_t* work )
+{
+    const scalar_t zero = 0.0;
+    const scalar_t one  = 1.0;
+    const scalar_t half = 0.5;
+
+    scalar_t tau = v[ 0 ];
+    scalar_t* u = work;
+    scalar_t* w = &work[ m ];
+    u[ 0 ] = one;
+    std::copy( &v[ 1 ], &v[ m ], &u[ 1 ] );
+
+    // w = tau A u - 1/2 tau^2 (w^H u) u
+    blas::hemv( Layout::ColMajor, Uplo::Lower, m, tau, A, lda, u, 1, zero, w, 1 );
+    scalar_t alpha = -half * tau * blas::dot( m, w, 1, u, 1 );
+    blas::axpy( m, alpha, u, 1, w, 1 );
+
+    // A = A - u w^H - w u^H
+    blas::her2( Layout::ColMajor, Uplo::Lower, m, -one, u, 1, w, 1, A, lda );
+}
+
+//------------------------------------------------------------------------------
+/// @internal
+/// Does step of sweep in tridiagonal bulge chasing, the same task as
+/// hb2st_step, on the lower band in LAPACK band storage,
+/// with entry (i, j) in AB[ i + j*lda ].
+///
+/// @param[in] v_in
+///     Reflector from the previous step; unused for step 0.
+///
+/// @param[out] v_out
+///     Reflector generated by the step; unused for diagonal blocks.
+///
+template <typename scalar_t>
+void hb2st_band_step(
+    int64_t n, int64_t band, int64_t sweep, int64_t step,
+    scalar_t* AB, int64_t lda,
+    scalar_t const* v_in, scalar_t* v_out )
+{
+    const scalar_t zero = 0.0;
+    const scalar_t one  = 1.0;
+    using blas::conj;
+
+    int64_t task  = step == 0 ? 0 : (step + 1) % 2 + 1;
+    int64_t block = step/2;
+    std::vector<scalar_t> work( 2*band );
+
+    if (task == 0) {
+        // Brings col i to tridiagonal and updates the diagonal block.
+        int64_t i  = sweep;
+        int64_t m1 = std::min( i + band, n - 1 ) - i;
+        scalar_t* x = &AB[ (i+1) + i*lda ];
+        scalar_t tau;
+        lapack::larfg( m1, &x[ 0 ], &x[ 1 ], 1, &tau );
+        v_out[ 0 ] = tau;
+        for (int64_t e = 1; e < m1; ++e) {
+            v_out[ e ] = x[ e ];
+            x[ e ] = zero;
+        }
+        hb2st_herf( m1, v_out, &AB[ (i+1) + (i+1)*lda ], lda, work.data() );
+    }
+    else if (task == 1) {
+        // Applies the reflector from the previous step from the right,
+        // creating a bulge, then brings col j back to the band and
+        // applies the new reflector from the left.
+        int64_t i = (block+1)*band + 1 + sweep;
+        int64_t j =  block   *band + 1 + sweep;
+        int64_t m2 = std::min( i + band - 1, n - 1 ) - i + 1;
+        scalar_t* B = &AB[ i + j*lda ];
+        scalar_t* u = work.data();
+        scalar_t* w = &work[ band ];
+
+        // B = B - tau1 (B u) u^H
+        u[ 0 ] = one;
+        std::copy( &v_in[ 1 ], &v_in[ band ], &u[ 1 ] );
+        blas::gemv( Layout::ColMajor, Op::NoTrans, m2, band,
+                    one, B, lda, u, 1, zero, w, 1 );
+        blas::ger( Layout::ColMajor, m2, band, -v_in[ 0 ], w, 1, u, 1, B, lda );
+
+        scalar_t tau;
+        lapack::larfg( m2, &B[ 0 ], &B[ 1 ], 1, &tau );
+        v_out[ 0 ] = tau;
+        u[ 0 ] = one;
+        for (int64_t e = 1; e < m2; ++e) {
+            u[ e ] = v_out[ e ] = B[ e ];
+            B[ e ] = zero;
+        }
+
+        // B = B - conj( tau2 ) u (u^H B), for cols 1 : band-1.
+        if (band > 1) {
+            scalar_t* B1 = &B[ lda ];
+            blas::gemv( Layout::ColMajor, Op::ConjTrans, m2, band-1,
+                        one, B1, lda, u, 1, zero, w, 1 );
+            blas::ger( Layout::ColMajor, m2, band-1, -conj( tau ),
+                       u, 1, w, 1, B1, lda );
+        }
+    }
+    else {
+        // Applies the reflector from the previous step to a diagonal block.
+        int64_t i  = block*band + 1 + sweep;
+        int64_t m1 = std::min( i + band - 1, n - 1 ) - i + 1;
+        hb2st_herf( m1, v_in, &AB[ i + i*lda ], lda, work.data() );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// @internal
+/// Implements tridiagonal bulge chasing pipelined over MPI ranks.
+///
+/// The lower band is in LAPACK band storage, with entry (i, j) in
+/// AB[ i + j*lda ], lda >= 2*band, with room for the bulge. Column j is
+/// owned by rank col_rank( j ); entries of other columns are used only as
+/// workspace. Each step is done by the rank owning the first column that
+/// it updates. Steps with the same wavefront 3*sweep + step are independent
+/// and update disjoint entries, though their columns may overlap. A step
+/// that runs into the next rank's columns borrows those entries for the
+/// wavefront, so ranks advance in step, with each rank doing its part of
+/// every wavefront. Reflectors go from the rank generating them to the
+/// rank applying them next.
+///
+/// At the end, the reflector of (sweep, block) is in vector( sweep, block )
+/// on rank vector_rank( sweep, block ), which is the same for a group of
+/// band sweeps, as with the tiles of V in hb2st_step.
+///
+/// @param[in] vector
+///     vector( sweep, block ) returns a pointer to band entries to store
+///     that reflector on this rank, initially zero.
+///
+template <typename scalar_t, typename ColRank, typename Vector, typename VectorRank>
+void hb2st_pipeline(
+    int64_t n, int64_t band,
+    scalar_t* AB, int64_t lda,
+    ColRank&& col_rank, Vector&& vector, VectorRank&& vector_rank,
+    MPI_Comm mpi_comm )
+{
+    const int tag_borrow = 0;
+    const int tag_return = 1;
+    const int tag_vector = 2;
+    const int tag_merge  = 3;
+    const auto mpi_scalar = mpi_type<scalar_t>::value;
+
+    int mpi_rank;
+    slate_mpi_call(
+        MPI_Comm_rank( mpi_comm, &mpi_rank ) );
+
+    int64_t nsweeps = n - 1;
+    auto nsteps = [&]( int64_t sweep ) {
+        return 2*ceildiv( n - 1 - sweep, band ) - 1;
+    };
+
+    // Entries that step updates: cols [ col_begin, col_end ), and in col j,
+    // rows [ max( j, row_begin ), row_end ). Returns false for no-op steps.
+    struct Step {
+        int64_t sweep, step, col_begin, col_end, row_begin, row_end;
+        int rank, lender;
+    };
+    auto make_step = [&]( int64_t sweep, int64_t step, Step& s ) {
+        int64_t task  = step == 0 ? 0 : (step + 1) % 2 + 1;
+        int64_t block = step/2;
+        int64_t i = (task == 1 ? block+1 : block)*band + 1 + sweep;
+        if (task == 0) {
+            int64_t m1 = std::min( sweep + band, n - 1 ) - sweep;
+            s.col_begin = sweep;
+            s.row_begin = sweep + 1;
+            s.row_end   = sweep + 1 + m1;
+            s.col_end   = s.row_end;
+        }
+        else if (i < n) {
+            int64_t m = std::min( i + band - 1, n - 1 ) - i + 1;
+            s.col_begin = task == 1 ? i - band : i;
+            s.col_end   = task == 1 ? i : i + m;
+            s.row_begin = i;
+            s.row_end   = i + m;
+        }
+        else {
+            return false;
+        }
+        s.sweep = sweep;
+        s.step  = step;
+        s.rank  = col_rank( s.col_begin );
+        s.lender = col_rank( s.col_end - 1 );
+        return true;
+    };
+
+    // Packs or unpacks the borrowed entries of step s:
+    // the columns of the lender, which are at the end of the step.
+    auto borrowed = [&]( Step const& s, std::vector<scalar_t>& buffer,
+                         bool pack ) {
+        int64_t j0 = s.col_end - 1;
+        while (j0 > s.col_begin && col_rank( j0 - 1 ) == s.lender)
+            --j0;
+        if (pack)
+            buffer.clear();
+        int64_t e = 0;
+        for (int64_t j = j0; j < s.col_end; ++j) {
+            for (int64_t i = std::max( j, s.row_begin ); i < s.row_end; ++i) {
+                if (pack)
+                    buffer.push_back( AB[ i + j*lda ] );
+                else
+                    AB[ i + j*lda ] = buffer[ e++ ];
+            }
+        }
+    };
+
+    // Reflector (sweep, block) is generated by step 2*block - 1, or 0,
+    // and applied by steps 2*block and 2*block + 1, of the same rank.
+    auto generator_rank = [&]( int64_t sweep, int64_t block ) {
+        return col_rank( block == 0 ? sweep : (block-1)*band + 1 + sweep );
+    };
+    auto consumer_rank = [&]( int64_t sweep, int64_t block ) {
+        return col_rank( block*band + 1 + sweep );
+    };
+    auto generated = [&]( int64_t sweep, int64_t block ) {
+        return block == 0 || block*band + 1 + sweep < n;
+    };
+
+    // Sends outstanding; each is done by the end of wavefront due.
+    struct Message {
+        MPI_Request request;
+        std::vector<scalar_t> data;
+        int64_t due;
+    };
+    std::list<Message> messages;
+    auto isend = [&]( std::vector<scalar_t>&& data, int dst, int tag,
+                      int64_t due ) {
+        messages.emplace_back();
+        Message& msg = messages.back();
+        msg.data = std::move( data );
+        msg.due  = due;
+        slate_mpi_call(
+            MPI_Isend( msg.data.data(), msg.data.size(), mpi_scalar,
+                       dst, tag, mpi_comm, &msg.request ) );
+    };
+    auto recv = [&]( scalar_t* data, int64_t count, int src, int tag ) {
+        slate_mpi_call(
+            MPI_Recv( data, count, mpi_scalar, src, tag, mpi_comm,
+                      MPI_STATUS_IGNORE ) );
+    };
+    auto wait = [&]( int64_t wave ) {
+        for (auto msg = messages.begin(); msg != messages.end(); ) {
+            if (msg->due <= wave) {
+                slate_mpi_call(
+                    MPI_Wait( &msg->request, MPI_STATUS_IGNORE ) );
+                msg = messages.erase( msg );
+            }
+            else {
+                ++msg;
+            }
+        }
+    };
+
+    std::vector<Step> steps, lent;
+    std::vector< std::vector<scalar_t> > buffers;
+    std::vector<scalar_t*> v_in, v_out;
+    int64_t sweep_begin = 0;
+    for (int64_t wave = 0; sweep_begin < nsweeps; ++wave) {
+        while (sweep_begin < nsweeps
+               && wave - 3*sweep_begin >= nsteps( sweep_begin ))
+            ++sweep_begin;
+        int64_t sweep_end = std::min( wave/3 + 1, nsweeps );
+
+        // Steps of this rank, and steps borrowing from this rank.
+        steps.clear();
+        lent.clear();
+        for (int64_t sweep = sweep_begin; sweep < sweep_end; ++sweep) {
+            Step s;
+            if (make_step( sweep, wave - 3*sweep, s )) {
+                if (s.rank == mpi_rank)
+                    steps.push_back( s );
+                else if (s.lender == mpi_rank)
+                    lent.push_back( s );
+            }
+        }
+
+        // Lend entries, as updated by the previous wavefronts.
+        for (auto const& s : lent) {
+            std::vector<scalar_t> buffer;
+            borrowed( s, buffer, true );
+            isend( std::move( buffer ), s.rank, tag_borrow, wave );
+        }
+
+        // Receive borrowed entries and reflectors.
+        buffers.resize( steps.size() );
+        v_in.assign( steps.size(), nullptr );
+        v_out.assign( steps.size(), nullptr );
+        for (size_t k = 0; k < steps.size(); ++k) {
+            Step const& s = steps[ k ];
+            if (s.step > 0) {
+                // Steps 2*block and 2*block + 1 apply reflector block;
+                // receive it at its first use.
+                int64_t block = s.step % 2 == 0 ? s.step/2 : (s.step - 1)/2;
+                v_in[ k ] = vector( s.sweep, block );
+                int src = generator_rank( s.sweep, block );
+                if (src != mpi_rank && (s.step % 2 == 0 || s.step == 1))
+                    recv( v_in[ k ], band, src, tag_vector );
+            }
+            if (s.step % 2 == 1 || s.step == 0)
+                v_out[ k ] = vector( s.sweep, (s.step + 1)/2 );
+            if (s.lender != mpi_rank) {
+                borrowed( s, buffers[ k ], true );
+                recv( buffers[ k ].data(), buffers[ k ].size(),
+                      s.lender, tag_borrow );
+                borrowed( s, buffers[ k ], false );
+            }
+        }
+
+        #pragma omp parallel for schedule( dynamic, 1 ) if (steps.size() > 1)
+        for (size_t k = 0; k < steps.size(); ++k) {
+            Step const& s = steps[ k ];
+            hb2st_band_step( n, band, s.sweep, s.step, AB, lda,
+                             v_in[ k ], v_out[ k ] );
+        }
+
+        // Return borrowed entries, and send new reflectors to where
+        // they are applied, in the next wavefront.
+        for (size_t k = 0; k < steps.size(); ++k) {
+            Step const& s = steps[ k ];
+            if (s.lender != mpi_rank) {
+                borrowed( s, buffers[ k ], true );
+                isend( std::move( buffers[ k ] ), s.lender, tag_return, wave );
+            }
+            if (s.step % 2 == 1 || s.step == 0) {
+                int64_t block = (s.step + 1)/2;
+                int dst = consumer_rank( s.sweep, block );
+                if (dst != mpi_rank
+                    && (block > 0 || s.sweep + band + 1 < n)) {
+                    scalar_t const* v = v_out[ k ];
+                    isend( std::vector<scalar_t>( v, v + band ),
+                           dst, tag_vector, wave + 1 );
+                }
+            }
+        }
+
+        // Get back lent entries.
+        for (auto const& s : lent) {
+            std::vector<scalar_t> buffer;
+            borrowed( s, buffer, true );
+            recv( buffer.data(), buffer.size(), s.rank, tag_return );
+            borrowed( s, buffer, false );
+        }
+        wait( wave );
+    }
+    wait( std::numeric_limits<int64_t>::max() );
+
+    // Gather reflectors to their owners, one message per group and block
+    // from each other rank that generated some of them.
+    int64_t ngroups = ceildiv( nsweeps, band );
+    for (int64_t group = 0; group < ngroups; ++group) {
+        int64_t s_begin = group*band;
+        int64_t s_end   = std::min( s_begin + band, nsweeps );
+        for (int64_t block = 0; generated( s_begin, block ); ++block) {
+            int dst = vector_rank( s_begin, block );
+            std::vector<int> srcs;
+            std::vector<scalar_t> buffer;
+            for (int64_t sweep = s_begin; sweep < s_end; ++sweep) {
+                if (! generated( sweep, block ))
+                    break;
+                int src = generator_rank( sweep, block );
+                if (src == dst)
+                    continue;
+                if (std::find( srcs.begin(), srcs.end(), src ) == srcs.end())
+                    srcs.push_back( src );
+                if (src == mpi_rank) {
+                    scalar_t const* v = vector( sweep, block );
+                    buffer.insert( buffer.end(), v, v + band );
+                }
+            }
+            if (! buffer.empty())
+                isend( std::move( buffer ), dst, tag_merge, 0 );
+            if (dst == mpi_rank) {
+                for (int src : srcs) {
+                    std::vector<int64_t> sweeps;
+                    for (int64_t sweep = s_begin; sweep < s_end; ++sweep) {
+                        if (generated( sweep, block )
+                            && generator_rank( sweep, block ) == src)
+                            sweeps.push_back( sweep );
+                    }
+                    buffer.resize( sweeps.size()*band );
+                    recv( buffer.data(), buffer.size(), src, tag_merge );
+                    for (size_t e = 0; e < sweeps.size(); ++e) {
+                        std::copy( &buffer[ e*band ], &buffer[ (e+1)*band ],
+                                   vector( sweeps[ e ], block ) );
+                    }
+                }
+            }
+        }
+    }
+    wait( std::numeric_limits<int64_t>::max() );
+}
+
+//------------------------------------------------------------------------------
+/// @internal
+/// Implements tridiagonal bulge chasing of a band matrix distributed over
+/// several MPI ranks, with the tiles of each block column on one rank,
+/// e.g., on a 1-by-q grid. Each rank copies its block columns to LAPACK
+/// band storage, and hb2st_pipeline chases the bulges across the ranks.
+/// The reflectors end up in the tiles of V, distributed as V is.
+///
+/// @return false if A is on one rank, in which case A and V are unchanged.
+///
+template <typename scalar_t>
+bool hb2st_distributed(
+    HermitianBandMatrix<scalar_t>& A,
+    Matrix<scalar_t>& V )
+{
+    const scalar_t zero = 0.0;
+
+    int64_t n    = A.n();
+    int64_t nt   = A.nt();
+    int64_t band = A.bandwidth();
+    int64_t nb   = A.tileNb( 0 );
+
+    bool distributed = false;
+    for (int64_t j = 1; j < nt; ++j)
+        distributed = distributed || A.tileRank( j, j ) != A.tileRank( 0, 0 );
+    if (! distributed)
+        return false;
+
+    if (A.uplo() != Uplo::Lower)
+        slate_not_implemented( "hb2st: distributed upper band matrix" );
+    slate_assert( band == nb );
+    slate_assert( V.tileMb( 0 ) == 2*band && V.tileNb( 0 ) == band );
+    for (int64_t j = 0; j < nt - 1; ++j) {
+        if (A.tileRank( j+1, j ) != A.tileRank( j, j ))
+            slate_error( "hb2st: block columns of A must be on one rank" );
+    }
+
+    // Lower band, with room for the bulge.
+    int64_t lda = 2*band;
+    std::vector<scalar_t> AB;
+    hb2st_get_band( A, AB, lda );
+
+    auto col_rank = [&]( int64_t j ) {
+        return A.tileRank( j / nb, j / nb );
+    };
+
+    // Reflectors are stored in tiles of V as in hb2st_step. Tiles of
+    // other ranks are workspace, until the reflectors go to their owner.
+    std::set<int64_t> workspace;
+    auto vector_tile = [&]( int64_t sweep, int64_t block ) {
+        int64_t k = sweep / band;
+        return k*nt - k*(k - 1)/2 + block;
+    };
+    auto vector = [&]( int64_t sweep, int64_t block ) {
+        int64_t t = vector_tile( sweep, block );
+        if (! V.tileIsLocal( 0, t ) && workspace.insert( t ).second) {
+            auto T = V.tileInsertWorkspace( 0, t );
+            lapack::laset(
+                lapack::MatrixType::General, T.mb(), T.nb(),
+                zero, zero, T.data(), T.stride() );
+        }
+        auto T = V( 0, t );
+        return &T.at( sweep % band + 1, sweep % band );
+    };
+    auto vector_rank = [&]( int64_t sweep, int64_t block ) {
+        return V.tileRank( 0, vector_tile( sweep, block ) );
+    };
+
+    hb2st_pipeline( n, band, AB.data(), lda,
+                    col_rank, vector, vector_rank, A.mpiComm() );
+
+    for (int64_t t : workspace)
+        V.tileErase( 0, t );
+
+    // The band is now tridiagonal.
+    hb2st_set_band( A, AB, lda );
+    A.bandwidth( 1 );
+    return true;
+}
+
 //------------------------------------------------------------------------------
 /// @internal
 /// Reduces a band Hermitian matrix to a tridiagonal matrix using bulge chasing.
@@ -210,6 +886,20 @@ void hb2st(
 
     set(zero, V);
 
+    // Pipeline over the ranks if A is distributed.
+    if (hb2st_distributed( A, V ))
+        return;
+
+    // A is on one rank; other ranks have nothing to do.
+    if (A.nt() == 0 || ! A.tileIsLocal( 0, 0 )) {
+        A.bandwidth( 1 );
+        return;
+    }
+
+    // Chase bulges on one device if possible; else fall back to the host.
+    if (target == Target::Devices && hb2st_device( A, V ))
+        return;
+
     // Insert workspace tiles needed for fill-in in bulge chasing
     // and set tile entries outside the band to 0.
     // todo: should release these tiles when done
@@ -289,6 +979,8 @@ void hb2st(
 
 //------------------------------------------------------------------------------
 /// Reduces a band Hermitian matrix to a bidiagonal matrix using bulge chasing.
+/// If the block columns of A are on several MPI ranks, e.g., on a 1-by-q
+/// grid, all ranks call hb2st and the bulge chasing is pipelined over them.
 ///
 //------------------------------------------------------------------------------
 /// @tparam scalar_t
@@ -308,7 +1000,9 @@ void hb2st(
 ///       - HostTask:  OpenMP tasks on CPU host [default].
 ///       - HostNest:  nested OpenMP parallel for loop on CPU host.
 ///       - HostBatch: batched BLAS on CPU host.
-///       - Devices:   batched BLAS on GPU device.
+///       - Devices:   bulge chasing on one GPU device, one kernel launch
+///         per wavefront of independent steps. Falls back to the host
+///         for an upper matrix.
 ///
 /// @ingroup heev_computational
 ///
@@ -318,7 +1012,7 @@ void hb2st(
     Matrix<scalar_t>& V,
     Options const& opts)
 {
-    Target target = get_option( opts, Option::Target, Target::HostTask );
+    Target target = get_target( opts, Target::HostTask );
 
     switch (target) {
         case Target::Host:
@@ -332,6 +1026,7 @@ void hb2st(
             impl::hb2st<Target::HostBatch>(A, V, opts);
             break;
         case Target::Devices:
+        case Target::Hybrid:
             impl::hb2st<Target::Devices>(A, V, opts);
             break;
     }
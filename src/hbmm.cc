@@ -48,9 +48,13 @@ void hbmm(
 
     // Assumes column major
     const Layout layout = Layout::ColMajor;
+    // Diagonal tiles of A, and block rows of C below the band,
+    // run on devices or on the host.
+    const Target target_diag = (target == Target::Devices ? Target::Devices
+                                                           : Target::HostTask);
 
     // Options
-    int64_t lookahead = get_option<int64_t>( opts, Option::Lookahead, 1 );
+    int64_t lookahead = get_lookahead( opts );
 
     // if on right, change to left by transposing A, B, C to get
     // op(C) = op(A)*op(B)
@@ -149,7 +153,7 @@ void hbmm(
             #pragma omp task depend(in:bcast[0]) \
                              depend(out:gemm[0])
             {
-                internal::hemm<Target::HostTask>(
+                internal::hemm<target_diag>(
                     Side::Left,
                     alpha, A.sub(0, 0),
                            B.sub(0, 0, 0, B.nt()-1),
@@ -165,24 +169,11 @@ void hbmm(
                         layout );
                 }
 
-                if (beta != one) {
+                if (beta != one && i_end < C.mt()) {
                     // Scale block rows of C below the bandwidth of A:
                     // C(i_end : mt-1, :) = beta * C(i_end : mt-1, :)
-                    // todo: make internal::scale routine. This is HostTask.
-                    for (int64_t i = i_end; i < C.mt(); ++i) {
-                        for (int64_t j = 0; j < C.nt(); ++j) {
-                            if (C.tileIsLocal(i, j)) {
-                                #pragma omp task slate_omp_default_none \
-                                    shared( C ) \
-                                    firstprivate(i, j, layout, beta)
-                                {
-                                    C.tileGetForWriting(i, j, LayoutConvert(layout));
-                                    tile::scale( beta, C(i, j) );
-                                }
-                            }
-                        }
-                    }
-                    #pragma omp taskwait
+                    internal::scale<target_diag>(
+                        beta, C.sub( i_end, C.mt()-1, 0, C.nt()-1 ) );
                 }
             }
 
@@ -255,7 +246,7 @@ void hbmm(
                         one,   C.sub(i_begin, k-1, 0, C.nt()-1),
                         layout );
 
-                    internal::hemm<Target::HostTask>(
+                    internal::hemm<target_diag>(
                         Side::Left,
                         alpha, A.sub(k, k),
                                B.sub(k, k, 0, B.nt()-1),
@@ -344,7 +335,7 @@ void hbmm(
             #pragma omp task depend(in:bcast[0]) \
                              depend(out:gemm[0])
             {
-                internal::hemm<Target::HostTask>(
+                internal::hemm<target_diag>(
                     Side::Left,
                     alpha, A.sub(0, 0),
                            B.sub(0, 0, 0, B.nt()-1),
@@ -361,21 +352,11 @@ void hbmm(
                         layout );
                 }
 
-                if (beta != one) {
-                    for (int64_t i = i_end; i < C.mt(); ++i) {
-                        for (int64_t j = 0; j < C.nt(); ++j) {
-                            if (C.tileIsLocal(i, j)) {
-                                #pragma omp task slate_omp_default_none \
-                                    shared( C ) \
-                                    firstprivate(i, j, layout, beta)
-                                {
-                                    C.tileGetForWriting(i, j, LayoutConvert(layout));
-                                    tile::scale( beta, C(i, j) );
-                                }
-                            }
-                        }
-                    }
-                    #pragma omp taskwait
+                if (beta != one && i_end < C.mt()) {
+                    // Scale block rows of C below the bandwidth of A:
+                    // C(i_end : mt-1, :) = beta * C(i_end : mt-1, :)
+                    internal::scale<target_diag>(
+                        beta, C.sub( i_end, C.mt()-1, 0, C.nt()-1 ) );
                 }
             }
 
@@ -447,7 +428,7 @@ void hbmm(
                         one,   C.sub(i_begin, k-1, 0, C.nt()-1),
                         layout );
 
-                    internal::hemm<Target::HostTask>(
+                    internal::hemm<target_diag>(
                         Side::Left,
                         alpha, A.sub(k, k),
                                B.sub(k, k, 0, B.nt()-1),
@@ -550,7 +531,7 @@ void hbmm(Side side,
     scalar_t beta,  Matrix<scalar_t>& C,
     Options const& opts)
 {
-    Target target = get_option( opts, Option::Target, Target::HostTask );
+    Target target = get_target( opts, Target::HostTask );
 
     switch (target) {
         case Target::Host:
@@ -567,6 +548,7 @@ void hbmm(Side side,
             break;
 
         case Target::Devices:
+        case Target::Hybrid:
             impl::hbmm<Target::Devices>( side, alpha, A, B, beta, C, opts );
             break;
     }
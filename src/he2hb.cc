@@ -48,6 +48,9 @@ void he2hb(
     // Assumes column major
     const Layout layout = Layout::ColMajor;
     const LayoutConvert layoutc = LayoutConvert( layout );
+    // Triangle-triangle reductions and updates run on devices or on the host.
+    const Target target_tt = (target == Target::Devices ? Target::Devices
+                                                         : Target::HostTask);
 
     // Options
     int64_t ib = get_option<int64_t>( opts, Option::InnerBlocking, 16 );
@@ -80,7 +83,11 @@ void he2hb(
     // in particular when we call he2hb_hemm,
     // which will improve the performance.
     A.gridinfo( &grid_order, &nprow, &npcol, &myrow, &mycol );
-    assert( grid_order == GridOrder::Col );  // todo: update for Row
+    assert( grid_order != GridOrder::Row );  // todo: update for Row
+    // Other distributions, e.g., func::symmetric_2d_grid,
+    // cycle the GPUs over every block row.
+    if (grid_order == GridOrder::Unknown)
+        nprow = 1;
 
     auto tileNb = A.tileNbFunc();
     auto tileRank = A.tileRankFunc();
@@ -194,8 +201,10 @@ void he2hb(
                 depend( inout:block[ k ] ) \
                 shared( dwork_array ) \
                 firstprivate(  A_panel, Tlocal_panel, Treduce_panel, ib, \
-                               max_panel_threads, work_size, priority_1 )
+                               max_panel_threads, work_size, priority_1, k )
             {
+                trace::Block trace_block( "he2hb::panel", k );
+
                 internal::geqrf<target>(
                     std::move( A_panel ),
                     std::move( Tlocal_panel ),
@@ -204,7 +213,7 @@ void he2hb(
 
                 // triangle-triangle reductions
                 // ttqrt handles tile transfers internally
-                internal::ttqrt<Target::HostTask>(
+                internal::ttqrt<target_tt>(
                     std::move( A_panel ),
                     std::move( Treduce_panel ) );
             }
@@ -219,6 +228,8 @@ void he2hb(
                     firstprivate( A_panel, k, nt, panel_ranks, first_indices, \
                                   layout )
                 {
+                    trace::Block trace_block( "he2hb::bcast", k );
+
                     // Send V across row i & col i for trailing matrix update.
                     BcastListTag bcast_list_V;
                     for (int64_t i = k; i < nt; ++i) {
@@ -278,6 +289,8 @@ void he2hb(
                     shared( A, W ) \
                     firstprivate( zero, A_panel, k, nt, panel_ranks, layoutc )
                 {
+                    trace::Block trace_block( "he2hb::fetch", k );
+
                     // todo: insert and set on device?
                     // todo: do we need entire column, or subset? needs W[ my_rows + my_cols ].
                     // todo: is this getting erased anywhere?
@@ -395,6 +408,8 @@ void he2hb(
                                       panel_rank_rows_sub, mpi_rank, \
                                       layout, layoutc, priority_0, queue_0 )
                     {
+                        trace::Block trace_block( "he2hb::trailing", k );
+
                         // Compute W = A V T.
                         // 1a. Wi_part = sum_j Aij Vj, local partial sum,
                         // for i = k+1, ..., nt-1 and j = panel_rank_rows.
@@ -429,26 +444,51 @@ void he2hb(
                                 else if (rank_upper == mpi_rank)
                                     neighbor = rank_lower;
                                 if (neighbor != -1 && neighbor != mpi_rank) {
-                                    Wtmp.tileInsert( i, k );
+                                    // With GPU-aware MPI, exchange and sum
+                                    // on the device.
+                                    int device = HostNum;
+                                    if (target == Target::Devices) {
+                                        if (gpu_aware_mpi()) {
+                                            device = W.tileDevice( i, k );
+                                        }
+                                        else {
+                                            // Sent and received via host.
+                                            internal::addHostStagedBytes(
+                                                2 * W.tileMb( i ) * W.tileNb( k )
+                                                  * sizeof(scalar_t) );
+                                        }
+                                    }
+                                    Wtmp.tileInsert( i, k, device );
                                     int tag_i = i;
                                     int tag_i1 = i+1;
-                                    W.tileGetForWriting( i, k, HostNum, layoutc );
-                                    MPI_Request req;
-                                    if (neighbor < mpi_rank) {
-                                        W  .tileIsend( i, k, neighbor, tag_i, &req );
-                                        Wtmp.tileRecv( i, k, neighbor, layout, tag_i1 );
+                                    int tag_send = neighbor < mpi_rank ? tag_i  : tag_i1;
+                                    int tag_recv = neighbor < mpi_rank ? tag_i1 : tag_i;
+                                    // Post the receive before the send, and
+                                    // wait for both together.
+                                    MPI_Request reqs[ 2 ];
+                                    Wtmp.tileGetForWriting( i, k, device, layoutc );
+                                    Wtmp( i, k, device ).irecv( neighbor, W.mpiComm(),
+                                                                layout, tag_recv,
+                                                                &reqs[ 0 ] );
+                                    W.tileGetForWriting( i, k, device, layoutc );
+                                    W.tileIsend( i, k, neighbor, tag_send, &reqs[ 1 ] );
+                                    slate_mpi_call(
+                                        MPI_Waitall( 2, reqs, MPI_STATUSES_IGNORE ) );
+                                    auto Wtmp_ik = Wtmp( i, k, device );
+                                    auto W_ik = W( i, k, device );
+                                    if (device == HostNum) {
+                                        blas::axpy( W_ik.nb()*W_ik.nb(),
+                                                    one, Wtmp_ik.data(), 1,
+                                                            W_ik.data(), 1 );
                                     }
                                     else {
-                                        W  .tileIsend( i, k, neighbor, tag_i1, &req );
-                                        Wtmp.tileRecv( i, k, neighbor, layout, tag_i );
+                                        blas::Queue* queue = W.comm_queue( device );
+                                        blas::axpy( W_ik.nb()*W_ik.nb(),
+                                                    one, Wtmp_ik.data(), 1,
+                                                            W_ik.data(), 1, *queue );
+                                        queue->sync();
                                     }
-                                    MPI_Wait( &req, MPI_STATUS_IGNORE );
-                                    auto Wtmp_ik = Wtmp( i, k );
-                                    auto W_ik = W( i, k );
-                                    blas::axpy( W_ik.nb()*W_ik.nb(),
-                                                one, Wtmp_ik.data(), 1,
-                                                        W_ik.data(), 1 );
-                                    Wtmp.tileErase( i, k );
+                                    Wtmp.tileErase( i, k, device );
                                 }
                             }
                         }
@@ -566,10 +606,12 @@ void he2hb(
                     shared( A ) \
                     firstprivate( A_panel, Treduce_panel, k, nt )
                 {
+                    trace::Block trace_block( "he2hb::trailing", k );
+
                     int tag_base = A.mt()*A.mt();
                     // Do 2-sided Hermitian update:
                     // 3. A = Q^H A Q
-                    internal::hettmqr<Target::HostTask>(
+                    internal::hettmqr<target_tt>(
                         Op::ConjTrans,
                         std::move( A_panel ),
                         std::move( Treduce_panel ),
@@ -682,7 +724,7 @@ void he2hb(
     TriangularFactors<scalar_t>& T,
     Options const& opts )
 {
-    Target target = get_option( opts, Option::Target, Target::HostTask );
+    Target target = get_target( opts, Target::HostTask );
 
     // HostNest and HostBatch not implemented; use HostTask.
     switch (target) {
@@ -694,6 +736,7 @@ void he2hb(
             break;
 
         case Target::Devices:
+        case Target::Hybrid:
             impl::he2hb<Target::Devices>( A, T, opts );
             break;
     }
@@ -9,50 +9,264 @@
 #include "slate/HermitianBandMatrix.hh"
 #include "internal/internal.hh"
 
+#include <algorithm>
+#include <cmath>
+
 namespace slate {
 
+namespace impl {
+
 //------------------------------------------------------------------------------
-/// Distributed parallel Hermitian matrix eigen decomposition.
-/// heev Computes all eigenvalues and, optionally, eigenvectors of a
-/// Hermitian matrix A. The matrix A is preliminary reduced to
-/// tridiagonal form using a two-stage approach:
-/// First stage: reduction to band tridiagonal form (see he2hb);
-/// Second stage: reduction from band to tridiagonal form (see hb2st).
+/// @internal
+/// Returns the real parts of the diagonal of the n-by-n matrix A on all ranks.
+/// The diagonal tiles of A are assumed square.
 ///
+template <typename scalar_t>
+std::vector< blas::real_type<scalar_t> > heev_qdwh_diag( Matrix<scalar_t>& A )
+{
+    using real_t = blas::real_type<scalar_t>;
+    using std::real;
+
+    const auto mpi_real_type = mpi_type<real_t>::value;
+
+    std::vector<real_t> D( A.n(), 0 );
+    int64_t ii = 0;
+    for (int64_t i = 0; i < A.nt(); ++i) {
+        if (A.tileIsLocal( i, i )) {
+            A.tileGetForReading( i, i, LayoutConvert::None );
+            auto T = A( i, i );
+            for (int64_t d = 0; d < T.nb(); ++d)
+                D[ ii + d ] = real( T( d, d ) );
+        }
+        ii += A.tileNb( i );
+    }
+    slate_mpi_call(
+        MPI_Allreduce( MPI_IN_PLACE, D.data(), D.size(), mpi_real_type,
+                       MPI_SUM, A.mpiComm() ) );
+    return D;
+}
+
 //------------------------------------------------------------------------------
-/// @tparam scalar_t
-///     One of float, double, std::complex<float>, std::complex<double>.
-//------------------------------------------------------------------------------
-/// @param[in] A
-///     On entry, the n-by-n Hermitian matrix $A$.
-///     On exit, contents are destroyed.
+/// @internal
+/// Shifts the diagonal of the n-by-n matrix A, A = A + shift I.
+/// The diagonal tiles of A are assumed square.
 ///
-/// @param[out] Lambda
-///     The vector Lambda of length n.
-///     If successful, the eigenvalues in ascending order.
+template <typename scalar_t>
+void heev_qdwh_shift( Matrix<scalar_t>& A, blas::real_type<scalar_t> shift )
+{
+    for (int64_t i = 0; i < A.nt(); ++i) {
+        if (A.tileIsLocal( i, i )) {
+            A.tileGetForWriting( i, i, LayoutConvert::None );
+            auto T = A( i, i );
+            for (int64_t d = 0; d < T.nb(); ++d)
+                T.at( d, d ) += shift;
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// @internal
+/// Hermitian eigen decomposition by QDWH-based spectral divide and conquer
+/// (Nakatsukasa and Higham, 2013), made of level 3 BLAS only.
+/// The n-by-n Hermitian matrix A, stored in full, is split at
+/// sigma = median( diag( A ) ):
 ///
-/// @param[out] Z
-///     On entry, if Z is empty, does not compute eigenvectors.
-///     Otherwise, the n-by-n matrix $Z$ to store eigenvectors.
-///     On exit, orthonormal eigenvectors of the matrix A.
+/// 1. The polar factor $U_p$ of $A - \sigma I$ gives the spectral projector
+///    $P = (U_p + I) / 2$ onto the invariant subspace of the k eigenvalues
+///    greater than sigma, with k = trace( P ).
+/// 2. An orthonormal basis $Q = [ Q_1, Q_2 ]$, with $Q_1$ spanning
+///    range( P ), is computed by two steps of subspace iteration from
+///    the k columns of P with the largest diagonal, then geqrf.
+/// 3. The subproblems $A_1 = Q_1^H A Q_1$ and $A_2 = Q_2^H A Q_2$ are
+///    solved recursively, and $Z = [ Q_2 Z_2, Q_1 Z_1 ]$.
 ///
-/// @param[in] opts
-///     Additional options, as map of name = value pairs. Possible options:
-///     - Option::InnerBlocking:
-///       Inner blocking to use for panel. Default 16.
-///     - Option::MaxPanelThreads:
-///       Number of threads to use for panel. Default omp_get_max_threads()/2.
-///     - Option::Target:
-///       Implementation to target. Possible values:
-///       - HostTask:  OpenMP tasks on CPU host [default].
-///       - HostNest:  nested OpenMP parallel for loop on CPU host.
-///       - HostBatch: batched BLAS on CPU host.
-///       - Devices:   batched BLAS on GPU device.
+/// Subproblems of at most 2 nb, or that do not split, are solved by heev
+/// with MethodEig::DC.
+/// On exit, A is destroyed.
 ///
-/// @ingroup heev
+template <typename scalar_t>
+void heev_qdwh(
+    Matrix<scalar_t>& A,
+    std::vector< blas::real_type<scalar_t> >& Lambda,
+    Matrix<scalar_t>& Z,
+    Options const& opts)
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // Constants
+    const scalar_t zero = 0;
+    const scalar_t one  = 1;
+    const real_t r_one  = 1;
+    const real_t r_two  = 2;
+
+    Target target = get_target( opts, Target::HostTask );
+
+    int64_t n = A.n();
+    int64_t nb = A.tileNb( 0 );
+    bool wantz = (Z.mt() > 0);
+    MPI_Comm mpi_comm = A.mpiComm();
+
+    Options opts_base( opts );
+    opts_base[ Option::MethodEig ] = MethodEig::DC;
+    auto base_case = [&]() {
+        HermitianMatrix<scalar_t> AH( Uplo::Lower, A );
+        slate::heev( AH, Lambda, Z, opts_base );
+    };
+
+    if (n <= 2*nb) {
+        base_case();
+        return;
+    }
+
+    GridOrder order;
+    int p, q, myrow, mycol;
+    A.gridinfo( &order, &p, &q, &myrow, &mycol );
+    if (order == GridOrder::Unknown) {
+        order = GridOrder::Col;
+        slate_mpi_call(
+            MPI_Comm_size( mpi_comm, &p ) );
+        q = 1;
+    }
+
+    // Split at the median of the diagonal, which usually divides
+    // the eigenvalues in halves.
+    std::vector<real_t> D = heev_qdwh_diag( A );
+    std::nth_element( D.begin(), D.begin() + n/2, D.end() );
+    real_t sigma = D[ n/2 ];
+
+    // Spectral projector P = (polar( A - sigma I ) + I) / 2.
+    Matrix<scalar_t> P = A.emptyLike();
+    P.insertLocalTiles( target );
+    slate::copy( A, P, opts );
+    heev_qdwh_shift( P, -sigma );
+    Matrix<scalar_t> H_empty;
+    polar( P, H_empty, opts );
+    scale( r_one, r_two, P, opts );
+    heev_qdwh_shift( P, r_one / r_two );
+
+    // The eigenvalues of P are 0 and 1, so k = trace( P ),
+    // and || P e_j ||_2^2 = P_jj.
+    D = heev_qdwh_diag( P );
+    real_t trace_P = 0;
+    for (real_t d : D)
+        trace_P += d;
+    int64_t k = std::llround( trace_P );
+    if (k <= 0 || k >= n) {
+        base_case();
+        return;
+    }
+
+    Matrix<scalar_t> Y( n, k, nb, nb, order, p, q, mpi_comm );
+    Matrix<scalar_t> Q( n, n, nb, nb, order, p, q, mpi_comm );
+    Y.insertLocalTiles( target );
+    Q.insertLocalTiles( target );
+    auto Q1 = Q.slice( 0, n-1, 0, k-1 );
+
+    {
+        // Start from the k columns of P with the largest norms,
+        // Y = P S, with S selecting them.
+        std::vector<int64_t> index( n );
+        for (int64_t j = 0; j < n; ++j)
+            index[ j ] = j;
+        std::stable_sort(
+            index.begin(), index.end(),
+            [&D]( int64_t i1, int64_t i2 ) { return D[ i1 ] > D[ i2 ]; } );
+        std::vector<int64_t> select( n, -1 );
+        for (int64_t l = 0; l < k; ++l)
+            select[ index[ l ] ] = l;
+
+        Matrix<scalar_t> S( n, k, nb, nb, order, p, q, mpi_comm );
+        S.insertLocalTiles( target );
+        std::function< scalar_t (int64_t, int64_t) > select_entry =
+            [&select]( int64_t i, int64_t j ) {
+                return select[ i ] == j ? scalar_t( 1 ) : scalar_t( 0 );
+            };
+        set( select_entry, S, opts );
+        gemm( one, P, S, zero, Y, opts );
+
+        // Two steps of subspace iteration, Q = orth( P orth( Y ) ),
+        // since P is only a projector to the QDWH accuracy.
+        for (int step = 0; step < 2; ++step) {
+            if (step > 0)
+                gemm( one, P, Q1, zero, Y, opts );
+            TriangularFactors<scalar_t> T;
+            geqrf( Y, T, opts );
+            set( zero, one, Q, opts );
+            unmqr( Side::Left, Op::NoTrans, Y, T, Q, opts );
+        }
+    }
+    P.clear();
+    Y.clear();
+
+    // Q2 is copied to a new matrix, since it starts within a tile of Q.
+    Matrix<scalar_t> Q2( n, n-k, nb, nb, order, p, q, mpi_comm );
+    Q2.insertLocalTiles( target );
+    auto Q_k = Q.slice( 0, n-1, k, n-1 );
+    redistribute( Q_k, Q2, opts );
+
+    Matrix<scalar_t> A1( k,   k,   nb, nb, order, p, q, mpi_comm );
+    Matrix<scalar_t> A2( n-k, n-k, nb, nb, order, p, q, mpi_comm );
+    A1.insertLocalTiles( target );
+    A2.insertLocalTiles( target );
+    {
+        // A1 = Q1^H A Q1 and A2 = Q2^H A Q2.
+        Matrix<scalar_t> W1( n, k,   nb, nb, order, p, q, mpi_comm );
+        Matrix<scalar_t> W2( n, n-k, nb, nb, order, p, q, mpi_comm );
+        W1.insertLocalTiles( target );
+        W2.insertLocalTiles( target );
+        auto Q1H = conj_transpose( Q1 );
+        auto Q2H = conj_transpose( Q2 );
+        gemm( one, A,   Q1, zero, W1, opts );
+        gemm( one, Q1H, W1, zero, A1, opts );
+        gemm( one, A,   Q2, zero, W2, opts );
+        gemm( one, Q2H, W2, zero, A2, opts );
+    }
+    A.clear();
+
+    // The eigenvalues of A2 are below sigma, and those of A1 above it,
+    // so Lambda = [ Lambda2, Lambda1 ] is in ascending order.
+    std::vector<real_t> Lambda1, Lambda2;
+    Matrix<scalar_t> Z1, Z2;
+    if (wantz) {
+        Z1 = Matrix<scalar_t>( k,   k,   nb, nb, order, p, q, mpi_comm );
+        Z2 = Matrix<scalar_t>( n-k, n-k, nb, nb, order, p, q, mpi_comm );
+        Z1.insertLocalTiles( target );
+        Z2.insertLocalTiles( target );
+    }
+    heev_qdwh( A1, Lambda1, Z1, opts );
+    heev_qdwh( A2, Lambda2, Z2, opts );
+
+    Lambda.resize( n );
+    std::copy( Lambda2.begin(), Lambda2.end(), Lambda.begin() );
+    std::copy( Lambda1.begin(), Lambda1.end(), Lambda.begin() + (n-k) );
+
+    if (wantz) {
+        // Z = [ Q2 Z2, Q1 Z1 ]. Q1 Z1 is copied into Z, since it starts
+        // within a tile of Z.
+        auto Z_left = Z.slice( 0, n-1, 0, n-k-1 );
+        gemm( one, Q2, Z2, zero, Z_left, opts );
+
+        Matrix<scalar_t> W( n, k, nb, nb, order, p, q, mpi_comm );
+        W.insertLocalTiles( target );
+        gemm( one, Q1, Z1, zero, W, opts );
+        auto Z_right = Z.slice( 0, n-1, n-k, n-1 );
+        redistribute( W, Z_right, opts );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// @internal
+/// Distributed parallel Hermitian matrix eigen decomposition,
+/// for all eigenpairs or a subset selected by range.
+/// Generic implementation for any target.
+/// @see heev, heevx
+/// @ingroup heev_impl
 ///
 template <typename scalar_t>
 void heev(
+    Range range,
+    blas::real_type<scalar_t> vl, blas::real_type<scalar_t> vu,
+    int64_t il, int64_t iu,
     HermitianMatrix<scalar_t>& A,
     std::vector< blas::real_type<scalar_t> >& Lambda,
     Matrix<scalar_t>& Z,
@@ -78,7 +292,39 @@ void heev(
     const real_t sqrt_big = sqrt( big_num );
 
     MethodEig method = get_option( opts, Option::MethodEig, MethodEig::DC );
-    Target target = get_option( opts, Option::Target, Target::HostTask );
+    Target target = get_target( opts, Target::HostTask );
+
+    // Bisection and inverse iteration compute only the selected
+    // eigenpairs; the other methods compute all of them.
+    bool subset = range != Range::All || method == MethodEig::Bisection;
+
+    if (method == MethodEig::QDWH && range == Range::All) {
+        // Spectral divide and conquer on a full copy of A.
+        // It needs no scaling, since polar scales each shifted matrix.
+        Timer t_qdwh;
+        int64_t nb = A.tileNb( 0 );
+        GridOrder order;
+        int p, q, myrow, mycol;
+        A.gridinfo( &order, &p, &q, &myrow, &mycol );
+        if (order == GridOrder::Unknown) {
+            order = GridOrder::Col;
+            slate_mpi_call(
+                MPI_Comm_size( A.mpiComm(), &p ) );
+            q = 1;
+        }
+        Matrix<scalar_t> Afull( n, n, nb, nb, order, p, q, A.mpiComm() );
+        Matrix<scalar_t> Id( n, n, nb, nb, order, p, q, A.mpiComm() );
+        Afull.insertLocalTiles( target );
+        Id.insertLocalTiles( target );
+        set( scalar_t( 0 ), scalar_t( 1 ), Id, opts );
+        hemm( Side::Left, scalar_t( 1 ), A, Id, scalar_t( 0 ), Afull, opts );
+        Id.clear();
+
+        heev_qdwh( Afull, Lambda, Z, opts );
+        timers[ "heev::qdwh" ] = t_qdwh.stop();
+        timers[ "heev" ] = t_heev.stop();
+        return;
+    }
 
     // Scale matrix to allowable range, if necessary.
     real_t Anorm = norm( Norm::Max, A );
@@ -98,6 +344,8 @@ void heev(
     if (alpha != 1.0) {
         // Scale by sqrt_sml/Anorm or sqrt_big/Anorm.
         scale( alpha, Anorm, A, opts );
+        vl *= alpha / Anorm;
+        vu *= alpha / Anorm;
     }
 
     // 1. Reduce to band form.
@@ -106,14 +354,16 @@ void heev(
     he2hb(A, T, opts);
     timers[ "heev::he2hb" ] = t_he2hb.stop();
 
-    // Copy band.
-    // Currently, gathers band matrix to rank 0.
+    // Copy band, distributed by block columns over a 1D grid of all ranks.
+    int mpi_size;
+    slate_mpi_call(
+        MPI_Comm_size(A.mpiComm(), &mpi_size));
     int64_t nb = A.tileNb(0);
-    HermitianBandMatrix<scalar_t> Aband(A.uplo(), n, nb, nb, 1, 1, A.mpiComm());
+    HermitianBandMatrix<scalar_t> Aband(A.uplo(), n, nb, nb, 1, mpi_size,
+                                        A.mpiComm());
     Aband.insertLocalTiles();
     Aband.he2hbGather(A);
 
-    // Currently, hb2st and sterf are run on a single node.
     Lambda.resize(n);
     std::vector<real_t> E(n - 1);
     Matrix<scalar_t> V;
@@ -123,26 +373,56 @@ void heev(
     int64_t vm = 2*nb;
     int64_t nt = A.nt();
     int64_t vn = nt*(nt + 1)/2*nb;
-    V = Matrix<scalar_t>(vm, vn, vm, nb, 1, 1, A.mpiComm());
-    if (A.mpiRank() == 0) {
-        V.insertLocalTiles();
+    V = Matrix<scalar_t>(vm, vn, vm, nb, 1, mpi_size, A.mpiComm());
+    V.insertLocalTiles();
 
-        // 2. Reduce band to real symmetric tri-diagonal.
-        Timer t_hb2st;
-        hb2st(Aband, V, opts);
-        timers[ "heev::hb2st" ] = t_hb2st.stop();
+    // 2. Reduce band to real symmetric tri-diagonal,
+    // with bulge chasing pipelined over all ranks.
+    Timer t_hb2st;
+    hb2st(Aband, V, opts);
+    timers[ "heev::hb2st" ] = t_hb2st.stop();
 
-        // Copy diagonal and super-diagonal to vectors.
-        internal::copyhb2st( Aband, Lambda, E );
+    // Copy diagonal and super-diagonal to vectors on all ranks.
+    internal::copyhb2st( Aband, Lambda, E );
 
-        Aband.releaseRemoteWorkspace();
-    }
+    Aband.releaseRemoteWorkspace();
 
     // 3. Tri-diagonal eigenvalue solver.
-    if (wantz) {
-        // Bcast the Lambda and E vectors (diagonal and sup/super-diagonal).
-        MPI_Bcast( &Lambda[0], n,   mpi_real_type, 0, A.mpiComm() );
-        MPI_Bcast( &E[0],      n-1, mpi_real_type, 0, A.mpiComm() );
+    if (subset) {
+        // Bisection for the selected eigenvalues, then inverse iteration
+        // for only their eigenvectors, by block columns over all ranks.
+        Timer t_stev;
+        std::vector<real_t> D( Lambda );
+        int64_t il_out;
+        stebz( range, vl, vu, il, iu, D, E, Lambda, il_out, opts );
+        int64_t m = Lambda.size();
+
+        if (wantz && m > 0) {
+            if (Z.n() < m)
+                slate_error( "heev: Z needs at least "
+                             + std::to_string( m ) + " columns" );
+
+            Matrix<scalar_t> Z1d( n, m, nb, 1, mpi_size, Z.mpiComm() );
+            Z1d.insertLocalTiles( target );
+            stein( D, E, Lambda, Z1d, opts );
+            timers[ "heev::stev" ] = t_stev.stop();
+
+            // Back-transform only the m columns: Z = Q1 * Q2 * Z.
+            Timer t_unmtr_hb2st;
+            unmtr_hb2st( Side::Left, Op::NoTrans, V, Z1d, opts );
+            timers[ "heev::unmtr_hb2st" ] = t_unmtr_hb2st.stop();
+
+            auto Zm = Z.slice( 0, n-1, 0, m-1 );
+            redistribute( Z1d, Zm, opts );
+            Timer t_unmtr_he2hb;
+            unmtr_he2hb( Side::Left, Op::NoTrans, A, T, Zm, opts );
+            timers[ "heev::unmtr_he2hb" ] = t_unmtr_he2hb.stop();
+        }
+        else {
+            timers[ "heev::stev" ] = t_stev.stop();
+        }
+    }
+    else if (wantz) {
         Timer t_stev;
         if (method == MethodEig::QR) {
             // QR iteration to get eigenvalues and eigenvectors of tridiagonal.
@@ -164,11 +444,6 @@ void heev(
         }
         timers[ "heev::stev" ] = t_stev.stop();
 
-        // Find the total number of processors.
-        int mpi_size;
-        slate_mpi_call(
-            MPI_Comm_size(A.mpiComm(), &mpi_size));
-
         Matrix<scalar_t> Z1d(Z.m(), Z.n(), Z.tileNb(0), 1, mpi_size, Z.mpiComm());
         Z1d.insertLocalTiles(target);
         redistribute(Z, Z1d, opts);
@@ -198,11 +473,131 @@ void heev(
     if (alpha != 1.0) {
         // Scale by Anorm/sqrt_sml or Anorm/sqrt_big.
         // todo: deal with not all eigenvalues converging, cf. LAPACK.
-        blas::scal( n, Anorm/alpha, &Lambda[0], 1 );
+        blas::scal( Lambda.size(), Anorm/alpha, Lambda.data(), 1 );
     }
     timers[ "heev" ] = t_heev.stop();
 }
 
+} // namespace impl
+
+//------------------------------------------------------------------------------
+/// Distributed parallel Hermitian matrix eigen decomposition.
+/// heev Computes all eigenvalues and, optionally, eigenvectors of a
+/// Hermitian matrix A. The matrix A is preliminary reduced to
+/// tridiagonal form using a two-stage approach:
+/// First stage: reduction to band tridiagonal form (see he2hb);
+/// Second stage: reduction from band to tridiagonal form (see hb2st).
+///
+//------------------------------------------------------------------------------
+/// @tparam scalar_t
+///     One of float, double, std::complex<float>, std::complex<double>.
+//------------------------------------------------------------------------------
+/// @param[in] A
+///     On entry, the n-by-n Hermitian matrix $A$.
+///     On exit, contents are destroyed.
+///
+/// @param[out] Lambda
+///     The vector Lambda of length n.
+///     If successful, the eigenvalues in ascending order.
+///
+/// @param[out] Z
+///     On entry, if Z is empty, does not compute eigenvectors.
+///     Otherwise, the n-by-n matrix $Z$ to store eigenvectors.
+///     On exit, orthonormal eigenvectors of the matrix A.
+///
+/// @param[in] opts
+///     Additional options, as map of name = value pairs. Possible options:
+///     - Option::InnerBlocking:
+///       Inner blocking to use for panel. Default 16.
+///     - Option::MaxPanelThreads:
+///       Number of threads to use for panel. Default omp_get_max_threads()/2.
+///     - Option::MethodEig:
+///       Tridiagonal eigensolver. Possible values:
+///       - DC:        divide and conquer [default].
+///       - QR:        QR iteration.
+///       - Bisection: bisection and inverse iteration.
+///       - QDWH:      QDWH-based spectral divide and conquer on the full
+///                    matrix, without the band reduction, in level 3 BLAS
+///                    only (see polar). Requires square tiles, mb = nb.
+///     - Option::Target:
+///       Implementation to target. Possible values:
+///       - HostTask:  OpenMP tasks on CPU host [default].
+///       - HostNest:  nested OpenMP parallel for loop on CPU host.
+///       - HostBatch: batched BLAS on CPU host.
+///       - Devices:   batched BLAS on GPU device.
+///
+/// @ingroup heev
+///
+template <typename scalar_t>
+void heev(
+    HermitianMatrix<scalar_t>& A,
+    std::vector< blas::real_type<scalar_t> >& Lambda,
+    Matrix<scalar_t>& Z,
+    Options const& opts)
+{
+    impl::heev( Range::All, 0, 0, 1, A.n(), A, Lambda, Z, opts );
+}
+
+//------------------------------------------------------------------------------
+/// Distributed parallel Hermitian matrix eigen decomposition,
+/// for selected eigenvalues and, optionally, eigenvectors.
+/// As heev, but the tridiagonal eigenproblem is solved by bisection
+/// for only the selected eigenvalues (see stebz), then by inverse iteration
+/// for only their eigenvectors (see stein), and only those columns are
+/// back-transformed. This saves most of the work of the tridiagonal solve
+/// and back-transformation when only a few eigenpairs are needed.
+///
+//------------------------------------------------------------------------------
+/// @tparam scalar_t
+///     One of float, double, std::complex<float>, std::complex<double>.
+//------------------------------------------------------------------------------
+/// @param[in] range
+///     - Range::All:   find all eigenvalues.
+///     - Range::Value: find eigenvalues in the half-open interval (vl, vu].
+///     - Range::Index: find eigenvalues with 1-based indices il through iu.
+///
+/// @param[in] vl, vu
+///     If range = Value, the lower and upper bounds of the interval;
+///     vl < vu. Otherwise not referenced.
+///
+/// @param[in] il, iu
+///     If range = Index, the 1-based indices of the smallest and largest
+///     eigenvalues to find; 1 <= il <= iu <= n. Otherwise not referenced.
+///
+/// @param[in] A
+///     On entry, the n-by-n Hermitian matrix $A$.
+///     On exit, contents are destroyed.
+///
+/// @param[out] Lambda
+///     On exit, the m selected eigenvalues in ascending order,
+///     resized to m.
+///
+/// @param[out] Z
+///     On entry, if Z is empty, does not compute eigenvectors.
+///     Otherwise, the n-by-k matrix $Z$ to store eigenvectors, k >= m,
+///     e.g., k = iu - il + 1 for range = Index, or k = n.
+///     On exit, the first m columns have the orthonormal eigenvectors.
+///
+/// @param[in] opts
+///     Additional options, as for heev, except Option::MethodEig.
+///
+/// @ingroup heev
+///
+template <typename scalar_t>
+void heevx(
+    Range range,
+    blas::real_type<scalar_t> vl, blas::real_type<scalar_t> vu,
+    int64_t il, int64_t iu,
+    HermitianMatrix<scalar_t>& A,
+    std::vector< blas::real_type<scalar_t> >& Lambda,
+    Matrix<scalar_t>& Z,
+    Options const& opts)
+{
+    Options opts_local( opts );
+    opts_local[ Option::MethodEig ] = MethodEig::Bisection;
+    impl::heev( range, vl, vu, il, iu, A, Lambda, Z, opts_local );
+}
+
 //------------------------------------------------------------------------------
 // Explicit instantiations.
 template
@@ -233,4 +628,36 @@ void heev< std::complex<double> >(
     Matrix< std::complex<double> >& Z,
     Options const& opts);
 
+template
+void heevx<float>(
+    Range range, float vl, float vu, int64_t il, int64_t iu,
+    HermitianMatrix<float>& A,
+    std::vector<float>& Lambda,
+    Matrix<float>& Z,
+    Options const& opts);
+
+template
+void heevx<double>(
+    Range range, double vl, double vu, int64_t il, int64_t iu,
+    HermitianMatrix<double>& A,
+    std::vector<double>& Lambda,
+    Matrix<double>& Z,
+    Options const& opts);
+
+template
+void heevx< std::complex<float> >(
+    Range range, float vl, float vu, int64_t il, int64_t iu,
+    HermitianMatrix< std::complex<float> >& A,
+    std::vector<float>& Lambda,
+    Matrix< std::complex<float> >& Z,
+    Options const& opts);
+
+template
+void heevx< std::complex<double> >(
+    Range range, double vl, double vu, int64_t il, int64_t iu,
+    HermitianMatrix< std::complex<double> >& A,
+    std::vector<double>& Lambda,
+    Matrix< std::complex<double> >& Z,
+    Options const& opts);
+
 } // namespace slate
@@ -0,0 +1,330 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/slate.hh"
+#include "auxiliary/Debug.hh"
+#include "slate/Matrix.hh"
+#include "slate/HermitianMatrix.hh"
+#include "internal/internal.hh"
+
+namespace slate {
+
+namespace impl {
+
+//------------------------------------------------------------------------------
+/// @internal
+/// One step of the Ogita and Aishima (2018) eigenvector refinement.
+/// Given S = Z^H A Z and R = I - Z^H Z for approximate eigenvectors Z,
+/// computes the refined eigenvalues
+///     lambda_i = s_ii / (1 - r_ii),
+/// and overwrites S with the correction E, Z := Z + Z E:
+///     e_ij = (s_ij + lambda_j r_ij) / (lambda_j - lambda_i)
+///         if | lambda_j - lambda_i | > delta, else r_ij / 2,
+/// with delta = 2 (||S - diag( lambda )||_F + ||A||_2 ||R||_F), where
+/// ||A||_2 is taken as max_i | lambda_i |. The Frobenius norms bound the
+/// 2-norms of the paper. S and R have the same distribution.
+///
+/// @return max_ij | e_ij |, on all ranks.
+///
+template <typename scalar_t>
+blas::real_type<scalar_t> heev_mixed_correction(
+    Matrix<scalar_t>& S,
+    Matrix<scalar_t>& R,
+    std::vector< blas::real_type<scalar_t> >& Lambda )
+{
+    using real_t = blas::real_type<scalar_t>;
+    using std::real;
+
+    const auto mpi_real_type = mpi_type<real_t>::value;
+    MPI_Comm mpi_comm = S.mpiComm();
+
+    int64_t n = S.n();
+    std::vector<int64_t> offset( S.nt() + 1, 0 );
+    for (int64_t j = 0; j < S.nt(); ++j)
+        offset[ j+1 ] = offset[ j ] + S.tileNb( j );
+
+    // Gather the diagonals of S and R: diag[ 0:n-1 ] = s_ii,
+    // diag[ n:2n-1 ] = r_ii.
+    std::vector<real_t> diag( 2*n, 0 );
+    for (int64_t j = 0; j < S.nt(); ++j) {
+        if (S.tileIsLocal( j, j )) {
+            S.tileGetForWriting( j, j, LayoutConvert::ColMajor );
+            R.tileGetForWriting( j, j, LayoutConvert::ColMajor );
+            auto Sjj = S( j, j );
+            auto Rjj = R( j, j );
+            for (int64_t jj = 0; jj < Sjj.nb(); ++jj) {
+                diag[     offset[ j ] + jj ] = real( Sjj( jj, jj ) );
+                diag[ n + offset[ j ] + jj ] = real( Rjj( jj, jj ) );
+            }
+        }
+    }
+    slate_mpi_call(
+        MPI_Allreduce( MPI_IN_PLACE, diag.data(), 2*n, mpi_real_type,
+                       MPI_SUM, mpi_comm ) );
+
+    real_t A_norm = 0;
+    for (int64_t i = 0; i < n; ++i) {
+        Lambda[ i ] = diag[ i ] / (1 - diag[ n + i ]);
+        A_norm = std::max( A_norm, std::abs( Lambda[ i ] ) );
+    }
+
+    // sums[ 0 ] = ||S - diag( lambda )||_F^2, sums[ 1 ] = ||R||_F^2.
+    real_t sums[ 2 ] = { 0, 0 };
+    for (int64_t j = 0; j < S.nt(); ++j) {
+        for (int64_t i = 0; i < S.mt(); ++i) {
+            if (S.tileIsLocal( i, j )) {
+                S.tileGetForWriting( i, j, LayoutConvert::ColMajor );
+                R.tileGetForWriting( i, j, LayoutConvert::ColMajor );
+                auto Sij = S( i, j );
+                auto Rij = R( i, j );
+                for (int64_t jj = 0; jj < Sij.nb(); ++jj) {
+                    for (int64_t ii = 0; ii < Sij.mb(); ++ii) {
+                        scalar_t s = Sij( ii, jj );
+                        if (offset[ i ] + ii == offset[ j ] + jj)
+                            s -= Lambda[ offset[ j ] + jj ];
+                        sums[ 0 ] += std::norm( s );
+                        sums[ 1 ] += std::norm( Rij( ii, jj ) );
+                    }
+                }
+            }
+        }
+    }
+    slate_mpi_call(
+        MPI_Allreduce( MPI_IN_PLACE, sums, 2, mpi_real_type,
+                       MPI_SUM, mpi_comm ) );
+    real_t delta = 2 * (std::sqrt( sums[ 0 ] ) + A_norm * std::sqrt( sums[ 1 ] ));
+
+    real_t E_max = 0;
+    for (int64_t j = 0; j < S.nt(); ++j) {
+        for (int64_t i = 0; i < S.mt(); ++i) {
+            if (S.tileIsLocal( i, j )) {
+                auto Sij = S( i, j );
+                auto Rij = R( i, j );
+                for (int64_t jj = 0; jj < Sij.nb(); ++jj) {
+                    real_t lambda_j = Lambda[ offset[ j ] + jj ];
+                    for (int64_t ii = 0; ii < Sij.mb(); ++ii) {
+                        real_t lambda_i = Lambda[ offset[ i ] + ii ];
+                        scalar_t e;
+                        if (std::abs( lambda_j - lambda_i ) > delta) {
+                            e = (Sij( ii, jj ) + lambda_j * Rij( ii, jj ))
+                                / (lambda_j - lambda_i);
+                        }
+                        else {
+                            e = Rij( ii, jj ) / real_t( 2 );
+                        }
+                        Sij.at( ii, jj ) = e;
+                        E_max = std::max( E_max, std::abs( e ) );
+                    }
+                }
+            }
+        }
+    }
+    slate_mpi_call(
+        MPI_Allreduce( MPI_IN_PLACE, &E_max, 1, mpi_real_type,
+                       MPI_MAX, mpi_comm ) );
+    return E_max;
+}
+
+} // namespace impl
+
+//------------------------------------------------------------------------------
+/// Distributed parallel mixed-precision Hermitian eigen decomposition.
+///
+/// Computes all eigenvalues and eigenvectors of the n-by-n Hermitian
+/// matrix $A$, $A = Z \Lambda Z^H$.
+///
+/// heev_mixed first computes the eigen decomposition in low precision
+/// (single) with heev, i.e., he2hb, hb2st, and, by default, stedc, then
+/// refines the eigenvalues and eigenvectors in high precision (double)
+/// with the iterations of Ogita and Aishima (2018),
+/// \[
+///     S = Z^H A Z, \quad
+///     R = I - Z^H Z, \quad
+///     Z = Z + Z E,
+/// \]
+/// where the eigenvalues are $\lambda_i = s_{ii} / (1 - r_{ii})$ and $E$ is
+/// computed entrywise from $S$, $R$, and $\lambda$ (see
+/// heev_mixed_correction). Each iteration is one hemm and three gemm, so
+/// it is made of level 3 BLAS only, and it converges quadratically: each
+/// iteration about doubles the number of correct digits. Eigenvalues
+/// closer than the current error are refined as a cluster: their
+/// eigenvectors converge to an orthonormal basis of the invariant
+/// subspace. If the approach fails, the method falls back to a high
+/// precision (double) heev.
+///
+/// The iterative refinement process is stopped if iter > itermax or
+/// $\norm{E}_{max}^2 \le tol$, i.e., when the next correction, about
+/// $\norm{E}_{max}^2$, is below tol, default eps*sqrt(n), where eps is
+/// the high precision (double) machine epsilon.
+///
+//------------------------------------------------------------------------------
+/// @tparam scalar_hi
+///     One of double, std::complex<double>.
+///
+/// @tparam scalar_lo
+///     One of float, std::complex<float>.
+//------------------------------------------------------------------------------
+/// @param[in,out] A
+///     On entry, the n-by-n Hermitian matrix $A$.
+///     Not modified, unless the iterations fall back to heev, which
+///     destroys $A$.
+///     Currently, only Uplo::Lower is supported.
+///
+/// @param[out] Lambda
+///     The vector Lambda of length n.
+///     The eigenvalues in ascending order, as computed by the low
+///     precision heev; refinement can swap nearly equal eigenvalues.
+///
+/// @param[out] Z
+///     The n-by-n matrix of orthonormal eigenvectors.
+///
+/// @param[out] iter
+///     The number of the iterations in the iterative refinement
+///     process, needed for the convergence.
+///     - iter > 0: converged after iter iterations
+///     - iter < 0: iterative refinement has failed, and the eigen
+///       decomposition comes from the fallback solver, if enabled.
+///
+/// @param[in] opts
+///     Additional options, as map of name = value pairs. Possible options:
+///     - Option::MethodEig:
+///       Method of the low precision heev (see heev). Default DC.
+///     - Option::Tolerance:
+///       Iterative refinement tolerance. Default epsilon * sqrt(n)
+///     - Option::MaxIterations:
+///       Maximum number of refinement iterations. Default 5
+///     - Option::UseFallbackSolver:
+///       If true and iterative refinement fails to converge, the problem is
+///       resolved with heev in high precision. Default true
+///     - Option::Target:
+///       Implementation to target. Possible values:
+///       - HostTask:  OpenMP tasks on CPU host [default].
+///       - HostNest:  nested OpenMP parallel for loop on CPU host.
+///       - HostBatch: batched BLAS on CPU host.
+///       - Devices:   batched BLAS on GPU device.
+///
+/// @ingroup heev
+///
+template <typename scalar_hi, typename scalar_lo>
+void heev_mixed(
+    HermitianMatrix<scalar_hi>& A,
+    std::vector< blas::real_type<scalar_hi> >& Lambda,
+    Matrix<scalar_hi>& Z,
+    int& iter,
+    Options const& opts)
+{
+    using real_hi = blas::real_type<scalar_hi>;
+    using real_lo = blas::real_type<scalar_lo>;
+
+    Timer t_heev_mixed;
+
+    // Constants
+    const real_hi eps = std::numeric_limits<real_hi>::epsilon();
+    const scalar_hi zero = 0.0;
+    const scalar_hi one  = 1.0;
+
+    int64_t n = A.n();
+
+    // Options
+    Target target = get_target( opts, Target::HostTask );
+    int64_t itermax = get_option<int64_t>( opts, Option::MaxIterations, 5 );
+    double tol = get_option<double>( opts, Option::Tolerance, eps*std::sqrt(n) );
+    bool use_fallback = get_option<int64_t>( opts, Option::UseFallbackSolver, true );
+    bool converged = false;
+    iter = 0;
+
+    // workspace
+    auto A_lo = A.template emptyLike<scalar_lo>();
+    auto Z_lo = Z.template emptyLike<scalar_lo>();
+    auto W = Z.emptyLike();
+    auto S = Z.emptyLike();
+    auto R = Z.emptyLike();
+    std::vector<real_lo> Lambda_lo( n );
+    Lambda.resize( n );
+
+    // insert local tiles
+    A_lo.insertLocalTiles( target );
+    Z_lo.insertLocalTiles( target );
+    W.   insertLocalTiles( target );
+    S.   insertLocalTiles( target );
+    R.   insertLocalTiles( target );
+
+    // Convert A from high to low precision, store result in A_lo,
+    // and compute its eigen decomposition.
+    copy( A, A_lo, opts );
+    Timer t_heev_lo;
+    heev( A_lo, Lambda_lo, Z_lo, opts );
+    timers[ "heev_mixed::heev_lo" ] = t_heev_lo.stop();
+
+    // Convert Z_lo to high precision.
+    copy( Z_lo, Z, opts );
+    std::copy( Lambda_lo.begin(), Lambda_lo.end(), Lambda.begin() );
+
+    auto ZH = conj_transpose( Z );
+
+    Timer t_refine;
+    for (int iiter = 0; iiter < itermax && ! converged; ++iiter) {
+        // W = A Z, S = Z^H A Z, R = I - Z^H Z.
+        hemm( Side::Left, one, A, Z, zero, W, opts );
+        gemm( one, ZH, W, zero, S, opts );
+        set( zero, one, R, opts );
+        gemm( -one, ZH, Z, one, R, opts );
+
+        // Lambda and E, in S.
+        real_hi E_max = impl::heev_mixed_correction( S, R, Lambda );
+
+        // Z = Z + Z E, via W.
+        slate::copy( Z, W, opts );
+        gemm( one, Z, S, one, W, opts );
+        slate::copy( W, Z, opts );
+
+        if (E_max * E_max <= tol) {
+            iter = iiter + 1;
+            converged = true;
+        }
+    }
+    timers[ "heev_mixed::refine" ] = t_refine.stop();
+
+    if (! converged) {
+        // If we performed iter = itermax iterations and never satisfied
+        // the stopping criterion, set up the iter flag accordingly.
+        iter = -itermax - 1;
+
+        if (use_fallback) {
+            // Fall back to double precision heev.
+            Timer t_heev_hi;
+            heev( A, Lambda, Z, opts );
+            timers[ "heev_mixed::heev_hi" ] = t_heev_hi.stop();
+        }
+    }
+    timers[ "heev_mixed" ] = t_heev_mixed.stop();
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template <>
+void heev_mixed<double>(
+    HermitianMatrix<double>& A,
+    std::vector<double>& Lambda,
+    Matrix<double>& Z,
+    int& iter,
+    Options const& opts)
+{
+    heev_mixed<double, float>( A, Lambda, Z, iter, opts );
+}
+
+template <>
+void heev_mixed< std::complex<double> >(
+    HermitianMatrix< std::complex<double> >& A,
+    std::vector<double>& Lambda,
+    Matrix< std::complex<double> >& Z,
+    int& iter,
+    Options const& opts)
+{
+    heev_mixed< std::complex<double>, std::complex<float> >(
+        A, Lambda, Z, iter, opts );
+}
+
+} // namespace slate
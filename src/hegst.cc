@@ -33,9 +33,13 @@ void hegst(
     const int priority_0 = 0;
     const int queue_0 = 0;
     const Layout layout = Layout::ColMajor;
+    // The diagonal block and its single-tile updates run on devices or
+    // on the host.
+    const Target target_diag = (target == Target::Devices ? Target::Devices
+                                                           : Target::HostTask);
 
     // Options
-    int64_t lookahead = get_option<int64_t>( opts, Option::Lookahead, 1 );
+    int64_t lookahead = get_lookahead( opts );
 
     if (itype != 1 && itype != 2 && itype != 3) {
         throw Exception("itype must be: 1, 2, or 3");
@@ -77,7 +81,7 @@ void hegst(
             if (itype == 1) {
                 #pragma omp task depend(inout:column[k])
                 {
-                    internal::hegst<Target::HostTask>(
+                    internal::hegst<target_diag>(
                         itype, std::move(Akk),
                                std::move(Bkk));
                 }
@@ -98,7 +102,7 @@ void hegst(
 
                     #pragma omp task depend(inout:column[k])
                     {
-                        A.tileBcast( k, k, Asub, layout );
+                        A.template tileBcast<target>( k, k, Asub, layout );
 
                         BcastList bcast_list;
                         for (int64_t i = k+1; i < nt; ++i) {
@@ -112,7 +116,7 @@ void hegst(
                                      depend(inout:column[k+1]) \
                                      depend(inout:column[nt-1])
                     {
-                        internal::hemm<Target::HostTask>(
+                        internal::hemm<target_diag>(
                             Side::Right, -half, std::move(Akk),
                                                 std::move(Bsub),
                                           one,  std::move(Asub) );
@@ -130,7 +134,7 @@ void hegst(
                             r_one, A.sub(k+1, nt-1),
                             priority_0, queue_0, layout );
 
-                        internal::hemm<Target::HostTask>(
+                        internal::hemm<target_diag>(
                             Side::Right,
                             -half, std::move( Akk  ),
                                    std::move( Bsub ),
@@ -152,7 +156,7 @@ void hegst(
 
                     #pragma omp task depend(inout:column[0])
                     {
-                        A.tileBcast( k, k, Asub, layout );
+                        A.template tileBcast<target>( k, k, Asub, layout );
 
                         BcastList bcast_list;
                         for (int64_t i = 0; i < k; ++i) {
@@ -171,7 +175,7 @@ void hegst(
                             Side::Right, one,  TBk1,
                                                Asub, column, column, lookahead);
 
-                        internal::hemm<Target::HostTask>(
+                        internal::hemm<target_diag>(
                             Side::Left,  half, std::move(Akk),
                                                std::move(Bsub),
                                          one,  std::move(Asub) );
@@ -183,18 +187,18 @@ void hegst(
                         }
                         A.template listBcast<target>(bcast_list, layout);
 
-                        internal::her2k<Target::HostTask>(
+                        internal::her2k<target>(
                             one,   conj_transpose( Asub ),
                                    conj_transpose( Bsub ),
                             r_one, A.sub(0, k-1),
                             priority_0, queue_0, layout );
 
-                        internal::hemm<Target::HostTask>(
+                        internal::hemm<target_diag>(
                             Side::Left, half, std::move(Akk),
                                               std::move(Bsub),
                                         one,  std::move(Asub) );
 
-                        internal::trmm<Target::HostTask>(
+                        internal::trmm<target_diag>(
                             Side::Left, one,  conj_transpose( TBkk ),
                                               std::move(Asub) );
                     }
@@ -202,7 +206,7 @@ void hegst(
 
                 #pragma omp task depend(inout:column[0]) depend(inout:column[k])
                 {
-                    internal::hegst<Target::HostTask>(
+                    internal::hegst<target_diag>(
                       itype,  std::move(Akk),
                               std::move(Bkk));
                 }
@@ -292,7 +296,7 @@ void hegst(
                    HermitianMatrix<scalar_t>& B,
     Options const& opts )
 {
-    Target target = get_option( opts, Option::Target, Target::HostTask );
+    Target target = get_target( opts, Target::HostTask );
 
     switch (target) {
         case Target::Host:
@@ -309,6 +313,7 @@ void hegst(
             break;
 
         case Target::Devices:
+        case Target::Hybrid:
             impl::hegst<Target::Devices>( itype, A, B, opts );
             break;
     }
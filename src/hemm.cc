@@ -4,22 +4,56 @@
 // the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
 
 #include "slate/slate.hh"
+#include "internal/internal_cost.hh"
 
 namespace slate {
 
 //------------------------------------------------------------------------------
+/// Selects hemmA or hemmC by a communication and computation cost model,
+/// as for gemm, with k = m the order of A. For side = right, the model
+/// is of the transposed product, C^H = A B^H.
+/// @see select_algo for gemm, internal::CostModel
+///
 template <typename TA, typename TB>
-inline MethodHemm select_algo( TA& A, TB& B, Options const& opts )
+inline MethodHemm select_algo(
+    Side side, TA& A, TB& B, Options const& opts )
 {
-    // TODO replace the default value by a unique value located elsewhere
-    Target target = get_option( opts, Option::Target, Target::HostTask );
+    using scalar_t = typename TA::value_type;
 
-    MethodHemm method = (B.nt() < 2 ? MethodHemm::A : MethodHemm::C);
+    // TODO replace the default value by a unique value located elsewhere
+    Target target = get_target( opts, Target::HostTask );
 
     // XXX For now, when target == device, we fallback to HemmC on device
-    if (target == Target::Devices && method == MethodHemm::A)
-        method = MethodHemm::C;
+    if (target == Target::Devices) {
+        internal::log_method( "hemm", A, opts, "C",
+                              "hemmA is not implemented on devices" );
+        return MethodHemm::C;
+    }
+
+    internal::CostModel model = internal::cost_model( "hemm", A, opts );
+    double p = model.p, q = model.q;
+    double m  = B.m(),  n  = B.n();
+    double mt = B.mt(), nt = B.nt();
+    if (side == Side::Right) {
+        std::swap( m, n );
+        std::swap( mt, nt );
+        std::swap( p, q );
+    }
+    double k = m, kt = mt;
+    double ws = sizeof( scalar_t );
+    double flops = 2 * m * n * k;
+
+    double time_C = model.time(
+        std::ceil( mt/p )*kt + kt*std::ceil( nt/q ),
+        ws * k * (m/p + n/q), flops, mt*nt );
+    double time_A = model.time(
+        std::ceil( kt/q )*nt + std::ceil( mt/p )*nt,
+        ws * n * (k/q + m/p), flops, mt*kt );
+
+    MethodHemm method = (time_A < time_C ? MethodHemm::A : MethodHemm::C);
 
+    internal::log_method( "hemm", A, opts, to_c_string( method ),
+                          internal::cost_reason( "A", time_A, "C", time_C ) );
     return method;
 }
 
@@ -72,7 +106,10 @@ inline MethodHemm select_algo( TA& A, TB& B, Options const& opts )
 ///           lookahead >= 0. Default 1.
 ///         - Option::MethodHemm:
 ///           Select the right routine to call. Possible values:
-///           - Auto: let the routine decides [default]
+///           - Auto: let the routine decide, by a cost model of
+///             communication and computation [default]. If
+///             Option::PrintVerbose >= 1, rank 0 prints the method
+///             chosen and the estimated times.
 ///           - hemmA: select hemmA routine
 ///           - hemmC: select hemmC routine
 ///         - Option::Target:
@@ -95,7 +132,7 @@ void hemm(Side side,
         opts, Option::MethodHemm, MethodHemm::Auto );
 
     if (method == MethodHemm::Auto)
-        method = select_algo( A, B, opts );
+        method = select_algo( side, A, B, opts );
 
     switch (method) {
         case MethodHemm::A:
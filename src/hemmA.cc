@@ -42,7 +42,7 @@ void hemmA(
     const Layout layout = Layout::ColMajor;
 
     // Options
-    int64_t lookahead = get_option<int64_t>( opts, Option::Lookahead, 1 );
+    int64_t lookahead = get_lookahead( opts );
 
     // if on right, change to left by transposing A, B, C to get
     // op(C) = op(A)*op(B)
@@ -651,7 +651,7 @@ void hemmA(
     scalar_t beta,  Matrix<scalar_t>& C,
     Options const& opts )
 {
-    Target target = get_option<Target>( opts, Option::Target, Target::HostTask );
+    Target target = get_target( opts, Target::HostTask );
 
     switch (target) {
         case Target::Host:
@@ -662,6 +662,7 @@ void hemmA(
         case Target::HostNest:
         case Target::HostBatch:
         case Target::Devices:
+        case Target::Hybrid:
             slate_not_implemented("target not yet supported");
             break;
     }
@@ -36,7 +36,7 @@ void her2k(
     const Layout layout = Layout::ColMajor;
 
     // Options
-    int64_t lookahead = get_option<int64_t>( opts, Option::Lookahead, 1 );
+    int64_t lookahead = get_lookahead( opts );
 
     // if upper, change to lower
     if (C.uplo() == Uplo::Upper)
@@ -245,7 +245,7 @@ void her2k(
     blas::real_type<scalar_t> beta, HermitianMatrix<scalar_t>& C,
     Options const& opts )
 {
-    Target target = get_option( opts, Option::Target, Target::HostTask );
+    Target target = get_target( opts, Target::HostTask );
 
     switch (target) {
         case Target::Host:
@@ -262,6 +262,7 @@ void her2k(
             break;
 
         case Target::Devices:
+        case Target::Hybrid:
             impl::her2k<Target::Devices>( alpha, A, B, beta, C, opts );
             break;
     }
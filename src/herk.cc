@@ -5,6 +5,7 @@
 
 #include "slate/slate.hh"
 #include "internal/internal.hh"
+#include "internal/internal_util.hh"
 
 namespace slate {
 
@@ -31,16 +32,16 @@ void herk(
     using real_t = blas::real_type<scalar_t>;
     using BcastList = typename Matrix<scalar_t>::BcastList;
 
-    // Assumes column major
-    const Layout layout = Layout::ColMajor;
-
     // Options
-    int64_t lookahead = get_option<int64_t>( opts, Option::Lookahead, 1 );
+    int64_t lookahead = get_lookahead( opts );
 
     // if upper, change to lower
     if (C.uplo() == Uplo::Upper)
         C = conj_transpose( C );
 
+    // Computes on row-major A and C in place, @see native_layout.
+    const Layout layout = internal::native_layout( target, A, C );
+
     // A is mt-by-nt, C is mt-by-mt
     assert(A.mt() == C.mt());
 
@@ -216,7 +217,7 @@ void herk(
     blas::real_type<scalar_t> beta,  HermitianMatrix<scalar_t>& C,
     Options const& opts )
 {
-    Target target = get_option( opts, Option::Target, Target::HostTask );
+    Target target = get_target( opts, Target::HostTask );
 
     switch (target) {
         case Target::Host:
@@ -230,6 +231,7 @@ void herk(
             impl::herk<Target::HostBatch>( alpha, A, beta, C, opts );
             break;
         case Target::Devices:
+        case Target::Hybrid:
             impl::herk<Target::Devices>( alpha, A, beta, C, opts );
             break;
     }
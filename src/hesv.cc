@@ -108,6 +108,10 @@ int64_t hesv(
     if (A_.uplo() == Uplo::Upper)
         A_ = conj_transpose( A_ );
 
+    // With Option::InfoRequest, info is only this rank's, so all ranks
+    // solve, without waiting for its reduction.
+    bool deferred = get_option<Option::InfoRequest>( opts, nullptr ) != nullptr;
+
     // factorization
     Timer t_hetrf;
     int64_t info = hetrf( A_, pivots, T, pivots2, H, opts );
@@ -115,7 +119,7 @@ int64_t hesv(
 
     // solve
     Timer t_hetrs;
-    if (info == 0) {
+    if (info == 0 || deferred) {
         hetrs( A_, pivots, T, pivots2, B, opts );
     }
     timers[ "hesv::hetrs" ] = t_hetrs.stop();
@@ -20,7 +20,10 @@ namespace impl {
 //------------------------------------------------------------------------------
 /// Distributed parallel Hermitian indefinite $LTL^T$ factorization.
 /// Generic implementation for any target.
-/// <b>GPU version not yet implemented.</b>
+/// For Devices, the left-looking updates of the panel column,
+/// A(k+1:mt, k) -= L(k+1:mt, 0:k-1) H(k, 0:k-1)^H, run on the GPUs;
+/// the panel factorization, the row swaps, and the updates of T and H
+/// remain on the host.
 /// @ingroup hesv_impl
 ///
 template <Target target, typename scalar_t>
@@ -49,7 +52,7 @@ int64_t hetrf(
     // Options
     real_t pivot_threshold
         = get_option<double>( opts, Option::PivotThreshold, 1.0 );
-    int64_t lookahead = get_option<int64_t>( opts, Option::Lookahead, 1 );
+    int64_t lookahead = get_lookahead( opts );
     int64_t ib = get_option<int64_t>( opts, Option::InnerBlocking, 16 );
 
     // Using > 1 thread leads to hang, reason unclear.
@@ -76,6 +79,11 @@ int64_t hetrf(
 
     assert(A.uplo() == Uplo::Lower); // upper not implemented, yet
 
+    if (target == Target::Devices) {
+        A.allocateBatchArrays();
+        A.reserveDeviceWorkspace();
+    }
+
     pivots.resize(A_mt);
 
     int rank;
@@ -296,7 +304,7 @@ int64_t hetrf(
                             Hj = conj_transpose( Hj );
 
                             #if 1
-                                slate::internal::gemmA<Target::HostTask>(
+                                slate::internal::gemmA<target>(
                                     -one, A.sub(k+1, A_mt-1, 0, k-2),
                                           Hj.sub(0, k-2, 0, 0),
                                     one,  A.sub(k+1, A_mt-1, k, k),
@@ -509,13 +517,14 @@ int64_t hetrf(
 
     // second-stage (factorization of band matrix)
     gbtrf(T, pivots2, {
+        {Option::Target, target},
         {Option::InnerBlocking, ib},
         {slate::Option::Lookahead, lookahead},
         {slate::Option::MaxPanelThreads, max_panel_threads}});
 
     A.clearWorkspace();
 
-    internal::reduce_info( &info, A.mpiComm() );
+    internal::reduce_info( &info, A.mpiComm(), opts );
     return info;
 }
 
@@ -589,7 +598,7 @@ int64_t hetrf(
              Matrix<scalar_t>& H,
     Options const& opts)
 {
-    Target target = get_option( opts, Option::Target, Target::HostTask );
+    Target target = get_target( opts, Target::HostTask );
 
     switch (target) {
         case Target::Host:
@@ -603,8 +612,8 @@ int64_t hetrf(
             return impl::hetrf<Target::HostBatch>( A, pivots, T, pivots2, H, opts );
 
         case Target::Devices:
-            slate_not_implemented( "hetrf not yet implemented for GPU devices" );
-            break;
+        case Target::Hybrid:
+            return impl::hetrf<Target::Devices>( A, pivots, T, pivots2, H, opts );
     }
     return -6;  // shouldn't happen
 }
@@ -0,0 +1,238 @@
+#include "hip/hip_runtime.h"
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/Exception.hh"
+#include "slate/internal/device.hh"
+
+#include "device_util.hip.hh"
+
+#include <algorithm>
+
+namespace slate {
+namespace device {
+
+// Each thread block computes a gemm_vbatch_nb-by-gemm_vbatch_nb block of C,
+// one entry per thread.
+const int gemm_vbatch_nb = 16;
+
+//------------------------------------------------------------------------------
+/// @return entry (i, j) of op( A ), where A is stored column-major in an
+/// lda-by-* array.
+///
+template <typename scalar_t>
+__device__ inline scalar_t gemm_vbatch_entry(
+    blas::Op op, scalar_t const* A, int64_t lda, int64_t i, int64_t j )
+{
+    if (op == blas::Op::NoTrans)
+        return A[ i + j*lda ];
+    else if (op == blas::Op::Trans)
+        return A[ j + i*lda ];
+    else
+        return conj( A[ j + i*lda ] );
+}
+
+//------------------------------------------------------------------------------
+/// Kernel for gemm_vbatch. Block (blockIdx.x, blockIdx.y) of problem
+/// blockIdx.z, looping over the batch when it exceeds the grid. Blocks
+/// outside a smaller problem skip it, so the grid is sized for the
+/// largest problem.
+/// @see gemm_vbatch
+///
+template <typename scalar_t>
+__global__ void gemm_vbatch_kernel(
+    blas::Op opA, blas::Op opB, int64_t const* dims,
+    scalar_t alpha, scalar_t const* const* Aarray,
+                    scalar_t const* const* Barray,
+    scalar_t beta,  scalar_t** Carray, bool beta_zero,
+    int64_t batch_count )
+{
+    using real_t = blas::real_type<scalar_t>;
+    const int nb = gemm_vbatch_nb;
+    __shared__ scalar_t sA[ nb ][ nb+1 ];
+    __shared__ scalar_t sB[ nb ][ nb+1 ];
+
+    scalar_t zero;
+    copy( real_t( 0 ), zero );
+
+    int tx = threadIdx.x;
+    int ty = threadIdx.y;
+
+    for (int64_t b = blockIdx.z; b < batch_count; b += gridDim.z) {
+        int64_t m   = dims[ b ];
+        int64_t n   = dims[ b +   batch_count ];
+        int64_t k   = dims[ b + 2*batch_count ];
+        int64_t lda = dims[ b + 3*batch_count ];
+        int64_t ldb = dims[ b + 4*batch_count ];
+        int64_t ldc = dims[ b + 5*batch_count ];
+
+        // Uniform across the thread block, so __syncthreads is safe.
+        int64_t i0 = blockIdx.x * int64_t( nb );
+        int64_t j0 = blockIdx.y * int64_t( nb );
+        if (i0 >= m || j0 >= n)
+            continue;
+
+        scalar_t const* A = Aarray[ b ];
+        scalar_t const* B = Barray[ b ];
+        scalar_t*       C = Carray[ b ];
+
+        int64_t i = i0 + tx;
+        int64_t j = j0 + ty;
+        scalar_t sum = zero;
+        for (int64_t l0 = 0; l0 < k; l0 += nb) {
+            sA[ ty ][ tx ] = (i < m && l0 + ty < k)
+                           ? gemm_vbatch_entry( opA, A, lda, i, l0 + ty )
+                           : zero;
+            sB[ ty ][ tx ] = (l0 + tx < k && j < n)
+                           ? gemm_vbatch_entry( opB, B, ldb, l0 + tx, j )
+                           : zero;
+            __syncthreads();
+            for (int l = 0; l < nb; ++l)
+                sum += sA[ l ][ tx ] * sB[ ty ][ l ];
+            __syncthreads();
+        }
+
+        if (i < m && j < n) {
+            if (beta_zero)
+                C[ i + j*ldc ] = alpha * sum;
+            else
+                C[ i + j*ldc ] = alpha * sum + beta * C[ i + j*ldc ];
+        }
+    }
+}
+
+namespace batch {
+
+//------------------------------------------------------------------------------
+/// Variable-size batched general matrix multiply,
+/// \[
+///     C_b = \alpha op( A_b ) op( B_b ) + \beta C_b,
+/// \]
+/// where C_b is m_b-by-n_b, and the sum is over k_b, for column-major tiles
+/// of any sizes, in one launch. Used for the remainder tiles of a batch
+/// whose sizes differ, e.g., the last block row and column, instead of one
+/// vendor batched gemm per size. Not tuned for large uniform batches,
+/// which should still use the vendor batched gemm.
+///
+/// @param[in] opA, opB
+///     Operations on A and B: NoTrans, Trans, or ConjTrans.
+///
+/// @param[in] max_m, max_n
+///     Maximum of m_b and n_b over the batch, to size the grid.
+///
+/// @param[in] dims
+///     Array of 6*batch_count int64_t in GPU memory: m_b, n_b, k_b,
+///     lda_b, ldb_b, ldc_b, each batch_count entries long, so
+///     dims[ b + d*batch_count ] is dimension d of problem b.
+///
+/// @param[in] alpha, beta
+///     The scalars alpha and beta. If beta = 0, C_b is not read.
+///
+/// @param[in] Aarray, Barray
+///     Arrays in GPU memory of batch_count pointers to the tiles A_b
+///     and B_b, where op( A_b ) is m_b-by-k_b and op( B_b ) is k_b-by-n_b.
+///
+/// @param[in,out] Carray
+///     Array in GPU memory of batch_count pointers to the tiles C_b.
+///
+/// @param[in] batch_count
+///     Number of problems. batch_count >= 0.
+///
+/// @param[in] queue
+///     BLAS++ queue to execute in.
+///
+template <typename scalar_t>
+void gemm_vbatch(
+    blas::Op opA, blas::Op opB,
+    int64_t max_m, int64_t max_n, int64_t const* dims,
+    scalar_t const& alpha, scalar_t** Aarray,
+                           scalar_t** Barray,
+    scalar_t const& beta,  scalar_t** Carray,
+    int64_t batch_count, blas::Queue& queue )
+{
+    // quick return
+    if (batch_count == 0 || max_m == 0 || max_n == 0)
+        return;
+
+    hipSetDevice( queue.device() );
+
+    const int nb = gemm_vbatch_nb;
+    // Max grid z dimension is 65535; the kernel loops over the rest.
+    dim3 threads( nb, nb );
+    dim3 blocks( ceildiv( max_m, int64_t( nb ) ),
+                 ceildiv( max_n, int64_t( nb ) ),
+                 std::min( batch_count, int64_t( 65535 ) ) );
+    bool beta_zero = real( beta ) == 0 && imag( beta ) == 0;
+
+    gemm_vbatch_kernel<<<blocks, threads, 0, queue.stream()>>>(
+        opA, opB, dims,
+        alpha, Aarray, Barray,
+        beta,  Carray, beta_zero, batch_count );
+
+    hipError_t error = hipGetLastError();
+    slate_assert( error == hipSuccess );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void gemm_vbatch(
+    blas::Op opA, blas::Op opB,
+    int64_t max_m, int64_t max_n, int64_t const* dims,
+    float const& alpha, float** Aarray,
+                        float** Barray,
+    float const& beta,  float** Carray,
+    int64_t batch_count, blas::Queue& queue );
+
+template
+void gemm_vbatch(
+    blas::Op opA, blas::Op opB,
+    int64_t max_m, int64_t max_n, int64_t const* dims,
+    double const& alpha, double** Aarray,
+                         double** Barray,
+    double const& beta,  double** Carray,
+    int64_t batch_count, blas::Queue& queue );
+
+//------------------------------------------------------------------------------
+// Specializations to cast std::complex => hipComplex.
+template <>
+void gemm_vbatch(
+    blas::Op opA, blas::Op opB,
+    int64_t max_m, int64_t max_n, int64_t const* dims,
+    std::complex<float> const& alpha, std::complex<float>** Aarray,
+                                      std::complex<float>** Barray,
+    std::complex<float> const& beta,  std::complex<float>** Carray,
+    int64_t batch_count, blas::Queue& queue )
+{
+    gemm_vbatch( opA, opB, max_m, max_n, dims,
+                 rocblas_float_complex( real( alpha ), imag( alpha ) ),
+                 (rocblas_float_complex**) Aarray,
+                 (rocblas_float_complex**) Barray,
+                 rocblas_float_complex( real( beta ), imag( beta ) ),
+                 (rocblas_float_complex**) Carray,
+                 batch_count, queue );
+}
+
+template <>
+void gemm_vbatch(
+    blas::Op opA, blas::Op opB,
+    int64_t max_m, int64_t max_n, int64_t const* dims,
+    std::complex<double> const& alpha, std::complex<double>** Aarray,
+                                       std::complex<double>** Barray,
+    std::complex<double> const& beta,  std::complex<double>** Carray,
+    int64_t batch_count, blas::Queue& queue )
+{
+    gemm_vbatch( opA, opB, max_m, max_n, dims,
+                 rocblas_double_complex( real( alpha ), imag( alpha ) ),
+                 (rocblas_double_complex**) Aarray,
+                 (rocblas_double_complex**) Barray,
+                 rocblas_double_complex( real( beta ), imag( beta ) ),
+                 (rocblas_double_complex**) Carray,
+                 batch_count, queue );
+}
+
+} // namespace batch
+} // namespace device
+} // namespace slate
@@ -0,0 +1,257 @@
+#include "hip/hip_runtime.h"
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/Exception.hh"
+#include "slate/internal/device.hh"
+
+#include "device_util.hip.hh"
+
+#include <algorithm>
+
+namespace slate {
+namespace device {
+
+// Each thread block computes a gemmt_diag_threads-by-gemmt_diag_threads
+// block of C, one entry per thread.
+const int gemmt_diag_threads = 16;
+
+//------------------------------------------------------------------------------
+/// @return entry (i, j) of op( A ), where A is stored column-major in an
+/// lda-by-* array.
+///
+template <typename scalar_t>
+__device__ inline scalar_t gemmt_diag_entry(
+    blas::Op op, scalar_t const* A, int64_t lda, int64_t i, int64_t j )
+{
+    if (op == blas::Op::NoTrans)
+        return A[ i + j*lda ];
+    else if (op == blas::Op::Trans)
+        return A[ j + i*lda ];
+    else
+        return conj( A[ j + i*lda ] );
+}
+
+//------------------------------------------------------------------------------
+/// Kernel for gemmt_diag. Block (blockIdx.x, blockIdx.y) of problem
+/// blockIdx.z, looping over the batch when it exceeds the grid. Blocks
+/// outside the uplo triangle of the diagonal blocks return at once.
+/// @see gemmt_diag
+///
+template <typename scalar_t>
+__global__ void gemmt_diag_kernel(
+    bool lower, blas::Op opA, blas::Op opB,
+    int64_t n, int64_t k, int64_t nb_diag,
+    scalar_t alpha, scalar_t const* const* Aarray, int64_t lda,
+                    scalar_t const* const* Barray, int64_t ldb,
+    scalar_t beta,  scalar_t** Carray, int64_t ldc,
+    bool beta_zero, bool hermitian,
+    int64_t batch_count )
+{
+    using real_t = blas::real_type<scalar_t>;
+    const int nb = gemmt_diag_threads;
+    __shared__ scalar_t sA[ nb ][ nb+1 ];
+    __shared__ scalar_t sB[ nb ][ nb+1 ];
+
+    // Uniform across the thread block, so __syncthreads is safe.
+    int64_t i0 = blockIdx.x * int64_t( nb );
+    int64_t j0 = blockIdx.y * int64_t( nb );
+    if (i0 / nb_diag != j0 / nb_diag)
+        return;
+    if (lower ? i0 + nb <= j0 : j0 + nb <= i0)
+        return;
+
+    scalar_t zero;
+    copy( real_t( 0 ), zero );
+
+    int tx = threadIdx.x;
+    int ty = threadIdx.y;
+    int64_t i = i0 + tx;
+    int64_t j = j0 + ty;
+    bool in_triangle = i < n && j < n && (lower ? i >= j : i <= j);
+
+    for (int64_t b = blockIdx.z; b < batch_count; b += gridDim.z) {
+        scalar_t const* A = Aarray[ b ];
+        scalar_t const* B = Barray[ b ];
+        scalar_t*       C = Carray[ b ];
+
+        scalar_t sum = zero;
+        for (int64_t l0 = 0; l0 < k; l0 += nb) {
+            sA[ ty ][ tx ] = (i < n && l0 + ty < k)
+                           ? gemmt_diag_entry( opA, A, lda, i, l0 + ty )
+                           : zero;
+            sB[ ty ][ tx ] = (l0 + tx < k && j < n)
+                           ? gemmt_diag_entry( opB, B, ldb, l0 + tx, j )
+                           : zero;
+            __syncthreads();
+            for (int l = 0; l < nb; ++l)
+                sum += sA[ l ][ tx ] * sB[ ty ][ l ];
+            __syncthreads();
+        }
+
+        if (in_triangle) {
+            scalar_t value = alpha * sum;
+            if (! beta_zero)
+                value = value + beta * C[ i + j*ldc ];
+            // The diagonal of a Hermitian result is real, as in herk.
+            if (hermitian && i == j)
+                copy( real( value ), value );
+            C[ i + j*ldc ] = value;
+        }
+    }
+}
+
+namespace batch {
+
+//------------------------------------------------------------------------------
+/// Batched matrix multiply of the diagonal blocks of triangular results,
+/// \[
+///     C_b = \alpha op( A_b ) op( B_b ) + \beta C_b,
+/// \]
+/// computing only the uplo triangle of each nb_diag-by-nb_diag diagonal
+/// block of the n-by-n tiles C_b; the rest of C_b is not referenced.
+/// With nb_diag = n, this is a batched gemmt, e.g., batched herk with
+/// B_b = A_b and opB = ConjTrans. With a smaller nb_diag, it finishes
+/// diagonal tiles whose off-diagonal blocks were updated by a vendor
+/// batched gemm, so one launch covers all diagonal tiles, instead of one
+/// vendor herk or syrk per tile.
+///
+/// @param[in] uplo
+///     Triangle of the diagonal blocks to compute: Lower or Upper.
+///
+/// @param[in] opA, opB
+///     Operations on A and B: NoTrans, Trans, or ConjTrans. If either is
+///     ConjTrans, the result is taken as Hermitian, so its diagonal is
+///     set real.
+///
+/// @param[in] n
+///     Number of rows and columns of each C_b. n >= 0.
+///
+/// @param[in] k
+///     Number of columns of op( A_b ) and rows of op( B_b ). k >= 0.
+///
+/// @param[in] nb_diag
+///     Size of the diagonal blocks, a multiple of 16.
+///
+/// @param[in] alpha, beta
+///     The scalars alpha and beta. If beta = 0, C_b is not read.
+///
+/// @param[in] Aarray, Barray
+///     Arrays in GPU memory of batch_count pointers to the tiles A_b
+///     and B_b, where op( A_b ) is n-by-k and op( B_b ) is k-by-n.
+///
+/// @param[in] lda, ldb
+///     Leading dimensions of A_b and B_b.
+///
+/// @param[in,out] Carray
+///     Array in GPU memory of batch_count pointers to the tiles C_b.
+///
+/// @param[in] ldc
+///     Leading dimension of C_b. ldc >= n.
+///
+/// @param[in] batch_count
+///     Number of problems. batch_count >= 0.
+///
+/// @param[in] queue
+///     BLAS++ queue to execute in.
+///
+template <typename scalar_t>
+void gemmt_diag(
+    blas::Uplo uplo, blas::Op opA, blas::Op opB,
+    int64_t n, int64_t k, int64_t nb_diag,
+    scalar_t const& alpha, scalar_t** Aarray, int64_t lda,
+                           scalar_t** Barray, int64_t ldb,
+    scalar_t const& beta,  scalar_t** Carray, int64_t ldc,
+    int64_t batch_count, blas::Queue& queue )
+{
+    // quick return
+    if (batch_count == 0 || n == 0)
+        return;
+
+    assert( nb_diag % gemmt_diag_threads == 0 );
+
+    hipSetDevice( queue.device() );
+
+    const int nb = gemmt_diag_threads;
+    // Max grid z dimension is 65535; the kernel loops over the rest.
+    dim3 threads( nb, nb );
+    dim3 blocks( ceildiv( n, int64_t( nb ) ),
+                 ceildiv( n, int64_t( nb ) ),
+                 std::min( batch_count, int64_t( 65535 ) ) );
+    bool beta_zero = real( beta ) == 0 && imag( beta ) == 0;
+    bool hermitian = opA == blas::Op::ConjTrans || opB == blas::Op::ConjTrans;
+
+    gemmt_diag_kernel<<<blocks, threads, 0, queue.stream()>>>(
+        uplo == blas::Uplo::Lower, opA, opB, n, k, nb_diag,
+        alpha, Aarray, lda,
+               Barray, ldb,
+        beta,  Carray, ldc,
+        beta_zero, hermitian, batch_count );
+
+    hipError_t error = hipGetLastError();
+    slate_assert( error == hipSuccess );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void gemmt_diag(
+    blas::Uplo uplo, blas::Op opA, blas::Op opB,
+    int64_t n, int64_t k, int64_t nb_diag,
+    float const& alpha, float** Aarray, int64_t lda,
+                        float** Barray, int64_t ldb,
+    float const& beta,  float** Carray, int64_t ldc,
+    int64_t batch_count, blas::Queue& queue );
+
+template
+void gemmt_diag(
+    blas::Uplo uplo, blas::Op opA, blas::Op opB,
+    int64_t n, int64_t k, int64_t nb_diag,
+    double const& alpha, double** Aarray, int64_t lda,
+                         double** Barray, int64_t ldb,
+    double const& beta,  double** Carray, int64_t ldc,
+    int64_t batch_count, blas::Queue& queue );
+
+//------------------------------------------------------------------------------
+// Specializations to cast std::complex => hipComplex.
+template <>
+void gemmt_diag(
+    blas::Uplo uplo, blas::Op opA, blas::Op opB,
+    int64_t n, int64_t k, int64_t nb_diag,
+    std::complex<float> const& alpha, std::complex<float>** Aarray, int64_t lda,
+                                      std::complex<float>** Barray, int64_t ldb,
+    std::complex<float> const& beta,  std::complex<float>** Carray, int64_t ldc,
+    int64_t batch_count, blas::Queue& queue )
+{
+    gemmt_diag( uplo, opA, opB, n, k, nb_diag,
+                rocblas_float_complex( real( alpha ), imag( alpha ) ),
+                (rocblas_float_complex**) Aarray, lda,
+                (rocblas_float_complex**) Barray, ldb,
+                rocblas_float_complex( real( beta ), imag( beta ) ),
+                (rocblas_float_complex**) Carray, ldc,
+                batch_count, queue );
+}
+
+template <>
+void gemmt_diag(
+    blas::Uplo uplo, blas::Op opA, blas::Op opB,
+    int64_t n, int64_t k, int64_t nb_diag,
+    std::complex<double> const& alpha, std::complex<double>** Aarray, int64_t lda,
+                                       std::complex<double>** Barray, int64_t ldb,
+    std::complex<double> const& beta,  std::complex<double>** Carray, int64_t ldc,
+    int64_t batch_count, blas::Queue& queue )
+{
+    gemmt_diag( uplo, opA, opB, n, k, nb_diag,
+                rocblas_double_complex( real( alpha ), imag( alpha ) ),
+                (rocblas_double_complex**) Aarray, lda,
+                (rocblas_double_complex**) Barray, ldb,
+                rocblas_double_complex( real( beta ), imag( beta ) ),
+                (rocblas_double_complex**) Carray, ldc,
+                batch_count, queue );
+}
+
+} // namespace batch
+} // namespace device
+} // namespace slate
@@ -0,0 +1,300 @@
+#include "hip/hip_runtime.h"
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/Exception.hh"
+#include "slate/internal/device.hh"
+
+#include "device_util.hip.hh"
+
+#include <algorithm>
+
+namespace slate {
+namespace device {
+
+// Threads per block for the matrix scope; a power of 2 for the reduction.
+const int genorm_vbatch_threads = 256;
+
+// Thread block of the columns scope: genorm_vbatch_nx threads per column,
+// genorm_vbatch_ny columns at a time.
+const int genorm_vbatch_nx = 32;
+const int genorm_vbatch_ny = 8;
+
+//------------------------------------------------------------------------------
+/// Reduces max in s_max and scaled sum-of-squares in s_scale, s_sumsq
+/// over the thread block, into entry 0. blockDim.x is a power of 2.
+///
+template <typename real_t>
+__device__ void genorm_vbatch_reduce(
+    real_t* s_max, real_t* s_scale, real_t* s_sumsq )
+{
+    int tid = threadIdx.x;
+    __syncthreads();
+    for (int s = blockDim.x / 2; s > 0; s /= 2) {
+        if (tid < s) {
+            s_max[ tid ] = max_nan( s_max[ tid + s ], s_max[ tid ] );
+            combine_sumsq( s_scale[ tid ], s_sumsq[ tid ],
+                           s_scale[ tid + s ], s_sumsq[ tid + s ] );
+        }
+        __syncthreads();
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Kernel for genorm_vbatch with NormScope::Matrix. Each thread block
+/// reduces tiles blockIdx.x, blockIdx.x + gridDim.x, ..., to a partial
+/// max and scaled sum-of-squares in values[ 3 + 3*blockIdx.x ]; the last
+/// block to finish, found with a counter in dims, reduces the partial
+/// results to values[ 0 : 2 ] and resets the counter.
+/// @see genorm_vbatch
+///
+template <typename scalar_t>
+__global__ void genorm_vbatch_matrix_kernel(
+    int64_t* dims, scalar_t const* const* Aarray,
+    blas::real_type<scalar_t>* values, int64_t batch_count )
+{
+    using real_t = blas::real_type<scalar_t>;
+    const int nt = genorm_vbatch_threads;
+    __shared__ real_t s_max[ nt ];
+    __shared__ real_t s_scale[ nt ];
+    __shared__ real_t s_sumsq[ nt ];
+    __shared__ bool is_last;
+
+    int tid = threadIdx.x;
+    real_t max = 0, scale = 0, sumsq = 1;
+
+    // Each thread accumulates rows tid, tid + nt, ... of its block's tiles.
+    // This does coalesced reads of one column at a time in parallel.
+    for (int64_t b = blockIdx.x; b < batch_count; b += gridDim.x) {
+        int64_t m   = dims[ b ];
+        int64_t n   = dims[ b +   batch_count ];
+        int64_t lda = dims[ b + 2*batch_count ];
+        scalar_t const* tile = Aarray[ b ];
+        for (int64_t i = tid; i < m; i += nt) {
+            for (int64_t j = 0; j < n; ++j) {
+                real_t a = abs( tile[ i + j*lda ] );
+                max = max_nan( a, max );
+                add_sumsq( scale, sumsq, a );
+            }
+        }
+    }
+    s_max  [ tid ] = max;
+    s_scale[ tid ] = scale;
+    s_sumsq[ tid ] = sumsq;
+    genorm_vbatch_reduce( s_max, s_scale, s_sumsq );
+
+    real_t* partial = &values[ 3 ];
+    unsigned long long* counter = (unsigned long long*) &dims[ 4*batch_count ];
+    if (tid == 0) {
+        partial[ 3*blockIdx.x + 0 ] = s_max[ 0 ];
+        partial[ 3*blockIdx.x + 1 ] = s_scale[ 0 ];
+        partial[ 3*blockIdx.x + 2 ] = s_sumsq[ 0 ];
+        // Make the partial result visible before counting this block.
+        __threadfence();
+        unsigned long long done = atomicAdd( counter, 1ull );
+        is_last = (done == gridDim.x - 1);
+    }
+    __syncthreads();
+
+    if (is_last) {
+        // Read past the cache, as other blocks wrote the partial results.
+        volatile real_t* vpartial = partial;
+        max = 0;
+        scale = 0;
+        sumsq = 1;
+        for (int k = tid; k < gridDim.x; k += nt) {
+            max = max_nan( real_t( vpartial[ 3*k + 0 ] ), max );
+            combine_sumsq( scale, sumsq,
+                           real_t( vpartial[ 3*k + 1 ] ),
+                           real_t( vpartial[ 3*k + 2 ] ) );
+        }
+        s_max  [ tid ] = max;
+        s_scale[ tid ] = scale;
+        s_sumsq[ tid ] = sumsq;
+        genorm_vbatch_reduce( s_max, s_scale, s_sumsq );
+
+        if (tid == 0) {
+            values[ 0 ] = s_max[ 0 ];
+            values[ 1 ] = s_scale[ 0 ];
+            values[ 2 ] = s_sumsq[ 0 ];
+            *counter = 0;
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Kernel for genorm_vbatch with NormScope::Columns. Each thread block
+/// does tiles blockIdx.x, blockIdx.x + gridDim.x, ..., genorm_vbatch_ny
+/// columns at a time, genorm_vbatch_nx threads per column, then updates
+/// the column maxima with atomics, as several tiles may share columns.
+/// @see genorm_vbatch
+///
+template <typename scalar_t>
+__global__ void genorm_vbatch_columns_kernel(
+    int64_t const* dims, scalar_t const* const* Aarray,
+    blas::real_type<scalar_t>* values, int64_t batch_count )
+{
+    using real_t = blas::real_type<scalar_t>;
+    const int nx = genorm_vbatch_nx;
+    const int ny = genorm_vbatch_ny;
+    __shared__ real_t s_max[ ny ][ nx+1 ];
+
+    int tx = threadIdx.x;
+    int ty = threadIdx.y;
+
+    for (int64_t b = blockIdx.x; b < batch_count; b += gridDim.x) {
+        int64_t m      = dims[ b ];
+        int64_t n      = dims[ b +   batch_count ];
+        int64_t lda    = dims[ b + 2*batch_count ];
+        int64_t offset = dims[ b + 3*batch_count ];
+        scalar_t const* tile = Aarray[ b ];
+
+        // Uniform across the thread block, so __syncthreads is safe.
+        for (int64_t j0 = 0; j0 < n; j0 += ny) {
+            int64_t j = j0 + ty;
+            real_t max = 0;
+            if (j < n) {
+                for (int64_t i = tx; i < m; i += nx)
+                    max = max_nan( abs( tile[ i + j*lda ] ), max );
+            }
+            s_max[ ty ][ tx ] = max;
+            __syncthreads();
+
+            if (tx == 0 && j < n) {
+                for (int k = 1; k < nx; ++k)
+                    max = max_nan( s_max[ ty ][ k ], max );
+                atomic_max_abs( &values[ offset + j ], max );
+            }
+            __syncthreads();
+        }
+    }
+}
+
+namespace batch {
+
+//------------------------------------------------------------------------------
+/// Variable-size batched general matrix norm, reduced over all tiles on
+/// the device in one launch, for tiles of any sizes. Unlike genorm, which
+/// returns a result per tile for the host to reduce, only the final
+/// values are left in GPU memory.
+///
+/// @param[in] scope
+///     - NormScope::Matrix: computes the max norm and the scaled
+///       sum-of-squares for the Frobenius norm together over all tiles.
+///     - NormScope::Columns: computes the max norm of each column.
+///
+/// @param[in,out] dims
+///     Array in GPU memory of 4*batch_count + 1 int64_t: m_b, n_b, lda_b,
+///     and column offset c_b, each batch_count entries long, so
+///     dims[ b + d*batch_count ] is dimension d of tile b; then a
+///     counter used by NormScope::Matrix, which must be 0 on entry, and
+///     is 0 on exit. c_b is used by NormScope::Columns only.
+///
+/// @param[in] Aarray
+///     Array in GPU memory of batch_count pointers to the tiles A_b,
+///     where A_b is an m_b-by-n_b matrix stored in an lda_b-by-n_b array.
+///
+/// @param[in,out] values
+///     Array in GPU memory.
+///     - NormScope::Matrix: dimension 3*(genorm_vbatch_blocks + 1).
+///       On exit,
+///           values[ 0 ] = max_{b, i, j} abs( A_b(i, j) ),
+///           values[ 1 ] = scale,
+///           values[ 2 ] = sumsq,
+///       where scale^2 sumsq = sum_{b, i, j} abs( A_b(i, j) )^2.
+///       The rest is workspace.
+///
+///     - NormScope::Columns: dimension max_b( c_b + n_b ). On entry,
+///       zero or previous maxima. On exit,
+///           values[ c_b + j ] = max( values[ c_b + j ],
+///                                    max_i abs( A_b(i, j) ) ),
+///       over all tiles b sharing the column.
+///
+/// @param[in] batch_count
+///     Number of tiles. batch_count >= 0.
+///
+/// @param[in] queue
+///     BLAS++ queue to execute in.
+///
+template <typename scalar_t>
+void genorm_vbatch(
+    NormScope scope, int64_t* dims,
+    scalar_t const* const* Aarray,
+    blas::real_type<scalar_t>* values,
+    int64_t batch_count, blas::Queue& queue )
+{
+    // quick return
+    if (batch_count == 0)
+        return;
+
+    hipSetDevice( queue.device() );
+
+    if (scope == NormScope::Matrix) {
+        int64_t blocks = std::min( batch_count, genorm_vbatch_blocks );
+        genorm_vbatch_matrix_kernel
+            <<<blocks, genorm_vbatch_threads, 0, queue.stream()>>>
+            (dims, Aarray, values, batch_count);
+    }
+    else if (scope == NormScope::Columns) {
+        // Max grid dimension is large; the kernel loops over the rest.
+        dim3 threads( genorm_vbatch_nx, genorm_vbatch_ny );
+        int64_t blocks = std::min( batch_count, int64_t( 65535 ) );
+        genorm_vbatch_columns_kernel
+            <<<blocks, threads, 0, queue.stream()>>>
+            (dims, Aarray, values, batch_count);
+    }
+    else {
+        slate_not_implemented("The norm scope isn't yet supported.");
+    }
+
+    hipError_t error = hipGetLastError();
+    slate_assert( error == hipSuccess );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void genorm_vbatch(
+    NormScope scope, int64_t* dims,
+    float const* const* Aarray,
+    float* values,
+    int64_t batch_count, blas::Queue& queue );
+
+template
+void genorm_vbatch(
+    NormScope scope, int64_t* dims,
+    double const* const* Aarray,
+    double* values,
+    int64_t batch_count, blas::Queue& queue );
+
+//------------------------------------------------------------------------------
+// Specializations to cast std::complex => hipComplex.
+template <>
+void genorm_vbatch(
+    NormScope scope, int64_t* dims,
+    std::complex<float> const* const* Aarray,
+    float* values,
+    int64_t batch_count, blas::Queue& queue )
+{
+    genorm_vbatch( scope, dims,
+                   (rocblas_float_complex**) Aarray,
+                   values, batch_count, queue );
+}
+
+template <>
+void genorm_vbatch(
+    NormScope scope, int64_t* dims,
+    std::complex<double> const* const* Aarray,
+    double* values,
+    int64_t batch_count, blas::Queue& queue )
+{
+    genorm_vbatch( scope, dims,
+                   (rocblas_double_complex**) Aarray,
+                   values, batch_count, queue );
+}
+
+} // namespace batch
+} // namespace device
+} // namespace slate
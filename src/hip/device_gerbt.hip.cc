@@ -0,0 +1,527 @@
+#include "hip/hip_runtime.h"
+// Copyright (c) 2020-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/Exception.hh"
+#include "slate/internal/device.hh"
+
+#include "device_util.hip.hh"
+
+#include <cstdio>
+
+namespace slate {
+namespace device {
+
+//------------------------------------------------------------------------------
+/// The tiles of a one-sided butterfly group, passed to the kernel by value.
+/// Tile c is B[ c ], an mb[ c ]-by-n tile stored in an ldb[ c ]-by-n
+/// array, with transform entries U[ c ]. Absent tiles have mb[ c ] = 0.
+///
+template <typename scalar_t>
+struct gerbt_left_group
+{
+    scalar_t* B[ 1 << gerbt_left_max_depth ];
+    int64_t mb[ 1 << gerbt_left_max_depth ];
+    int64_t ldb[ 1 << gerbt_left_max_depth ];
+    scalar_t const* U[ 1 << gerbt_left_max_depth ];
+};
+
+//------------------------------------------------------------------------------
+/// The tiles of a two-sided butterfly group, passed to the kernel by value.
+/// Tile (ci, cj) is A[ ci*2^depth + cj ], an mb[ ci ]-by-nb[ cj ] tile
+/// stored in an lda[ ci*2^depth + cj ]-by-nb[ cj ] array, with transform
+/// entries U[ ci ] and V[ cj ].
+///
+template <typename scalar_t>
+struct gerbt_group
+{
+    scalar_t* A[ 1 << (2*gerbt_max_depth) ];
+    int64_t lda[ 1 << (2*gerbt_max_depth) ];
+    int64_t mb[ 1 << gerbt_max_depth ];
+    int64_t nb[ 1 << gerbt_max_depth ];
+    scalar_t const* U[ 1 << gerbt_max_depth ];
+    scalar_t const* V[ 1 << gerbt_max_depth ];
+};
+
+//------------------------------------------------------------------------------
+/// Kernel applying depth levels of a butterfly to the left of a group of
+/// tiles, as tile::gerbt_left_notrans or tile::gerbt_left_trans applied
+/// level by level. Each thread holds the 2^depth entries of one
+/// (row, column) position of the group in registers.
+/// The grid is over rows in x and columns in y.
+///
+/// @copydoc gerbt_left
+///
+template <typename scalar_t, typename real_t, int depth, bool trans>
+__global__ void gerbt_left_kernel(
+    int64_t mb_max, int64_t n,
+    gerbt_left_group<scalar_t> group )
+{
+    const int group_size = 1 << depth;
+    const real_t inv_sqrt_2 = 1.0 / sqrt( 2.0 );
+
+    int64_t i = blockIdx.x * int64_t( blockDim.x ) + threadIdx.x;
+    if (i >= mb_max)
+        return;
+
+    for (int64_t j = blockIdx.y; j < n; j += gridDim.y) {
+        scalar_t b[ group_size ];
+        #pragma unroll
+        for (int c = 0; c < group_size; ++c) {
+            if (i < group.mb[ c ])
+                b[ c ] = group.B[ c ][ i + j*group.ldb[ c ] ];
+        }
+
+        // Regular butterflies are applied largest to smallest,
+        // transposed butterflies smallest to largest.
+        #pragma unroll
+        for (int level = 0; level < depth; ++level) {
+            const int h = 1 << (trans ? level : depth-1 - level);
+
+            #pragma unroll
+            for (int c = 0; c < group_size; ++c) {
+                if ((c & h) != 0 || i >= group.mb[ c ])
+                    continue;
+
+                const int c2 = c | h;
+                const scalar_t u1 = group.U[ c ][ i ];
+                if (i < group.mb[ c2 ]) {
+                    const scalar_t u2 = group.U[ c2 ][ i ];
+                    const scalar_t b1 = b[ c  ];
+                    const scalar_t b2 = b[ c2 ];
+                    if (trans) {
+                        b[ c  ] = inv_sqrt_2*u1*(b1 + b2);
+                        b[ c2 ] = inv_sqrt_2*u2*(b1 - b2);
+                    }
+                    else {
+                        b[ c  ] = inv_sqrt_2*(u1*b1 + u2*b2);
+                        b[ c2 ] = inv_sqrt_2*(u1*b1 - u2*b2);
+                    }
+                }
+                else {
+                    b[ c ] = u1*b[ c ];
+                }
+            }
+        }
+
+        #pragma unroll
+        for (int c = 0; c < group_size; ++c) {
+            if (i < group.mb[ c ])
+                group.B[ c ][ i + j*group.ldb[ c ] ] = b[ c ];
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Kernel applying depth levels of a butterfly to both sides of a group of
+/// tiles, as tile::gerbt applied level by level. Each thread holds the
+/// 4^depth entries of one (row, column) position of the group in registers.
+/// The grid is over rows in x and columns in y.
+///
+/// @copydoc gerbt
+///
+template <typename scalar_t, typename real_t, int depth>
+__global__ void gerbt_kernel(
+    int64_t mb_max, int64_t nb_max,
+    gerbt_group<scalar_t> group )
+{
+    const int group_size = 1 << depth;
+    const real_t inv_sqrt_2 = 1.0 / sqrt( 2.0 );
+    const real_t inv_2 = 0.5;
+
+    int64_t i = blockIdx.x * int64_t( blockDim.x ) + threadIdx.x;
+    if (i >= mb_max)
+        return;
+
+    for (int64_t j = blockIdx.y; j < nb_max; j += gridDim.y) {
+        scalar_t a[ group_size*group_size ];
+        #pragma unroll
+        for (int ci = 0; ci < group_size; ++ci) {
+            #pragma unroll
+            for (int cj = 0; cj < group_size; ++cj) {
+                const int c = ci*group_size + cj;
+                if (i < group.mb[ ci ] && j < group.nb[ cj ])
+                    a[ c ] = group.A[ c ][ i + j*group.lda[ c ] ];
+            }
+        }
+
+        // Two-sided butterflies are applied smallest to largest.
+        #pragma unroll
+        for (int level = 0; level < depth; ++level) {
+            const int h = 1 << level;
+
+            #pragma unroll
+            for (int ci = 0; ci < group_size; ++ci) {
+                if ((ci & h) != 0 || i >= group.mb[ ci ])
+                    continue;
+
+                const int ci2 = ci | h;
+                const bool row2 = i < group.mb[ ci2 ];
+                const scalar_t u1 = group.U[ ci ][ i ];
+                const scalar_t u2 = row2 ? group.U[ ci2 ][ i ] : u1;
+
+                #pragma unroll
+                for (int cj = 0; cj < group_size; ++cj) {
+                    if ((cj & h) != 0 || j >= group.nb[ cj ])
+                        continue;
+
+                    const int cj2 = cj | h;
+                    const bool col2 = j < group.nb[ cj2 ];
+                    const scalar_t v1 = group.V[ cj ][ j ];
+                    const scalar_t v2 = col2 ? group.V[ cj2 ][ j ] : v1;
+
+                    scalar_t& a11 = a[ ci *group_size + cj  ];
+                    scalar_t& a12 = a[ ci *group_size + cj2 ];
+                    scalar_t& a21 = a[ ci2*group_size + cj  ];
+                    scalar_t& a22 = a[ ci2*group_size + cj2 ];
+
+                    if (row2 && col2) {
+                        const scalar_t sum1 = a11 + a12;
+                        const scalar_t sum2 = a21 + a22;
+                        const scalar_t dif1 = a11 - a12;
+                        const scalar_t dif2 = a21 - a22;
+
+                        a11 = inv_2*u1*(sum1 + sum2)*v1;
+                        a12 = inv_2*u1*(dif1 + dif2)*v2;
+                        a21 = inv_2*u2*(sum1 - sum2)*v1;
+                        a22 = inv_2*u2*(dif1 - dif2)*v2;
+                    }
+                    else if (col2) {
+                        const scalar_t b11 = a11;
+                        const scalar_t b12 = a12;
+
+                        a11 = inv_sqrt_2*u1*(b11 + b12)*v1;
+                        a12 = inv_sqrt_2*u1*(b11 - b12)*v2;
+                    }
+                    else if (row2) {
+                        const scalar_t b11 = a11;
+                        const scalar_t b21 = a21;
+
+                        a11 = inv_sqrt_2*u1*(b11 + b21)*v1;
+                        a21 = inv_sqrt_2*u2*(b11 - b21)*v1;
+                    }
+                    else {
+                        a11 = u1*a11*v1;
+                    }
+                }
+            }
+        }
+
+        #pragma unroll
+        for (int ci = 0; ci < group_size; ++ci) {
+            #pragma unroll
+            for (int cj = 0; cj < group_size; ++cj) {
+                const int c = ci*group_size + cj;
+                if (i < group.mb[ ci ] && j < group.nb[ cj ])
+                    group.A[ c ][ i + j*group.lda[ c ] ] = a[ c ];
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Launches gerbt_left_kernel with the depth and trans as template
+/// parameters, so the kernel's loops unroll.
+template <typename scalar_t, typename real_t>
+void gerbt_left_launch(
+    blas::Op trans, int64_t depth, int64_t n,
+    int64_t const* mb, scalar_t* const* Barray, int64_t const* ldb,
+    scalar_t const* const* Uarray,
+    blas::Queue& queue )
+{
+    slate_assert( 1 <= depth && depth <= gerbt_left_max_depth );
+
+    gerbt_left_group<scalar_t> group;
+    int64_t mb_max = 0;
+    for (int64_t c = 0; c < (1 << depth); ++c) {
+        group.B[ c ] = Barray[ c ];
+        group.mb[ c ] = mb[ c ];
+        group.ldb[ c ] = ldb[ c ];
+        group.U[ c ] = Uarray[ c ];
+        mb_max = std::max( mb_max, mb[ c ] );
+    }
+
+    // quick return
+    if (mb_max == 0 || n == 0)
+        return;
+
+    hipSetDevice( queue.device() );
+
+    int64_t nthreads = std::min( int64_t( 256 ), mb_max );
+    dim3 threads( nthreads );
+    dim3 blocks( (mb_max + nthreads - 1) / nthreads,
+                 std::min( n, int64_t( 65535 ) ) );
+
+    #define SLATE_GERBT_LEFT_CASE( depth_ ) \
+        case depth_: \
+            if (trans == blas::Op::NoTrans) \
+                gerbt_left_kernel<scalar_t, real_t, depth_, false> \
+                    <<<blocks, threads, 0, queue.stream()>>>( \
+                        mb_max, n, group ); \
+            else \
+                gerbt_left_kernel<scalar_t, real_t, depth_, true> \
+                    <<<blocks, threads, 0, queue.stream()>>>( \
+                        mb_max, n, group ); \
+            break;
+
+    switch (depth) {
+        SLATE_GERBT_LEFT_CASE( 1 )
+        SLATE_GERBT_LEFT_CASE( 2 )
+        SLATE_GERBT_LEFT_CASE( 3 )
+        SLATE_GERBT_LEFT_CASE( 4 )
+    }
+
+    #undef SLATE_GERBT_LEFT_CASE
+
+    hipError_t error = hipGetLastError();
+    slate_assert(error == hipSuccess);
+}
+
+//------------------------------------------------------------------------------
+/// Launches gerbt_kernel with the depth as a template parameter,
+/// so the kernel's loops unroll.
+template <typename scalar_t, typename real_t>
+void gerbt_launch(
+    int64_t depth,
+    int64_t const* mb, int64_t const* nb,
+    scalar_t* const* Aarray, int64_t const* lda,
+    scalar_t const* const* Uarray, scalar_t const* const* Varray,
+    blas::Queue& queue )
+{
+    slate_assert( 1 <= depth && depth <= gerbt_max_depth );
+
+    const int64_t group_size = 1 << depth;
+    gerbt_group<scalar_t> group;
+    int64_t mb_max = 0, nb_max = 0;
+    for (int64_t c = 0; c < group_size; ++c) {
+        group.mb[ c ] = mb[ c ];
+        group.nb[ c ] = nb[ c ];
+        group.U[ c ] = Uarray[ c ];
+        group.V[ c ] = Varray[ c ];
+        mb_max = std::max( mb_max, mb[ c ] );
+        nb_max = std::max( nb_max, nb[ c ] );
+    }
+    for (int64_t c = 0; c < group_size*group_size; ++c) {
+        group.A[ c ] = Aarray[ c ];
+        group.lda[ c ] = lda[ c ];
+    }
+
+    // quick return
+    if (mb_max == 0 || nb_max == 0)
+        return;
+
+    hipSetDevice( queue.device() );
+
+    int64_t nthreads = std::min( int64_t( 256 ), mb_max );
+    dim3 threads( nthreads );
+    dim3 blocks( (mb_max + nthreads - 1) / nthreads,
+                 std::min( nb_max, int64_t( 65535 ) ) );
+
+    switch (depth) {
+        case 1:
+            gerbt_kernel<scalar_t, real_t, 1>
+                <<<blocks, threads, 0, queue.stream()>>>(
+                    mb_max, nb_max, group );
+            break;
+        case 2:
+            gerbt_kernel<scalar_t, real_t, 2>
+                <<<blocks, threads, 0, queue.stream()>>>(
+                    mb_max, nb_max, group );
+            break;
+    }
+
+    hipError_t error = hipGetLastError();
+    slate_assert(error == hipSuccess);
+}
+
+//------------------------------------------------------------------------------
+/// Applies depth levels of a random butterfly transform to the left of a
+/// group of 2^depth tiles in one pass, as tile::gerbt_left_notrans or
+/// tile::gerbt_left_trans applied level by level. Level l pairs tile c
+/// with tile c + 2^b, for c without bit b, where b = depth-1-l if trans
+/// is NoTrans, and b = l if trans is Trans.
+///
+/// @param[in] trans
+///     Whether to apply the butterfly (NoTrans) or its transpose (Trans).
+///
+/// @param[in] depth
+///     Number of butterfly levels. 1 <= depth <= gerbt_left_max_depth.
+///
+/// @param[in] n
+///     Number of columns of the tiles. n >= 0.
+///
+/// @param[in] mb
+///     Array of dimension 2^depth of the number of rows of each tile;
+///     0 for tiles beyond the end of the matrix.
+///     mb[ c ] >= mb[ c + 2^b ] for each pair.
+///
+/// @param[in,out] Barray
+///     Array of dimension 2^depth, where Barray[ c ] is an
+///     mb[ c ]-by-n tile stored in an ldb[ c ]-by-n array in GPU memory.
+///
+/// @param[in] ldb
+///     Array of dimension 2^depth of the leading dimensions of the tiles.
+///
+/// @param[in] Uarray
+///     Array of dimension 2^depth, where Uarray[ c ] holds the mb[ c ]
+///     random entries of the butterfly for tile c in GPU memory.
+///
+/// @param[in] queue
+///     BLAS++ queue to execute in.
+///
+template <typename scalar_t>
+void gerbt_left(
+    blas::Op trans, int64_t depth, int64_t n,
+    int64_t const* mb, scalar_t* const* Barray, int64_t const* ldb,
+    scalar_t const* const* Uarray,
+    blas::Queue& queue )
+{
+    gerbt_left_launch<scalar_t, scalar_t>(
+        trans, depth, n, mb, Barray, ldb, Uarray, queue );
+}
+
+//------------------------------------------------------------------------------
+/// Applies depth levels of a random butterfly transform to both sides of
+/// a group of 2^depth-by-2^depth tiles in one pass, as tile::gerbt applied
+/// level by level, smallest butterfly first. Level l pairs tile rows ci
+/// and ci + 2^l, and tile columns cj and cj + 2^l.
+///
+/// @param[in] depth
+///     Number of butterfly levels. 1 <= depth <= gerbt_max_depth.
+///
+/// @param[in] mb
+///     Array of dimension 2^depth of the number of rows of each tile row;
+///     0 for tile rows beyond the end of the matrix.
+///
+/// @param[in] nb
+///     Array of dimension 2^depth of the number of columns of each tile
+///     column; 0 for tile columns beyond the end of the matrix.
+///
+/// @param[in,out] Aarray
+///     Array of dimension 4^depth, where Aarray[ ci*2^depth + cj ] is an
+///     mb[ ci ]-by-nb[ cj ] tile stored in an
+///     lda[ ci*2^depth + cj ]-by-nb[ cj ] array in GPU memory.
+///
+/// @param[in] lda
+///     Array of dimension 4^depth of the leading dimensions of the tiles.
+///
+/// @param[in] Uarray
+///     Array of dimension 2^depth, where Uarray[ ci ] holds the mb[ ci ]
+///     random entries of the left butterfly for tile row ci in GPU memory.
+///
+/// @param[in] Varray
+///     Array of dimension 2^depth, where Varray[ cj ] holds the nb[ cj ]
+///     random entries of the right butterfly for tile column cj in GPU
+///     memory.
+///
+/// @param[in] queue
+///     BLAS++ queue to execute in.
+///
+template <typename scalar_t>
+void gerbt(
+    int64_t depth,
+    int64_t const* mb, int64_t const* nb,
+    scalar_t* const* Aarray, int64_t const* lda,
+    scalar_t const* const* Uarray, scalar_t const* const* Varray,
+    blas::Queue& queue )
+{
+    gerbt_launch<scalar_t, scalar_t>(
+        depth, mb, nb, Aarray, lda, Uarray, Varray, queue );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void gerbt_left(
+    blas::Op trans, int64_t depth, int64_t n,
+    int64_t const* mb, float* const* Barray, int64_t const* ldb,
+    float const* const* Uarray,
+    blas::Queue& queue );
+
+template
+void gerbt_left(
+    blas::Op trans, int64_t depth, int64_t n,
+    int64_t const* mb, double* const* Barray, int64_t const* ldb,
+    double const* const* Uarray,
+    blas::Queue& queue );
+
+template
+void gerbt(
+    int64_t depth,
+    int64_t const* mb, int64_t const* nb,
+    float* const* Aarray, int64_t const* lda,
+    float const* const* Uarray, float const* const* Varray,
+    blas::Queue& queue );
+
+template
+void gerbt(
+    int64_t depth,
+    int64_t const* mb, int64_t const* nb,
+    double* const* Aarray, int64_t const* lda,
+    double const* const* Uarray, double const* const* Varray,
+    blas::Queue& queue );
+
+//------------------------------------------------------------------------------
+// Specializations to cast std::complex => hipComplex.
+template <>
+void gerbt_left(
+    blas::Op trans, int64_t depth, int64_t n,
+    int64_t const* mb, std::complex<float>* const* Barray, int64_t const* ldb,
+    std::complex<float> const* const* Uarray,
+    blas::Queue& queue )
+{
+    gerbt_left_launch<rocblas_float_complex, float>(
+        trans, depth, n, mb,
+        (rocblas_float_complex* const*) Barray, ldb,
+        (rocblas_float_complex const* const*) Uarray, queue );
+}
+
+template <>
+void gerbt_left(
+    blas::Op trans, int64_t depth, int64_t n,
+    int64_t const* mb, std::complex<double>* const* Barray, int64_t const* ldb,
+    std::complex<double> const* const* Uarray,
+    blas::Queue& queue )
+{
+    gerbt_left_launch<rocblas_double_complex, double>(
+        trans, depth, n, mb,
+        (rocblas_double_complex* const*) Barray, ldb,
+        (rocblas_double_complex const* const*) Uarray, queue );
+}
+
+template <>
+void gerbt(
+    int64_t depth,
+    int64_t const* mb, int64_t const* nb,
+    std::complex<float>* const* Aarray, int64_t const* lda,
+    std::complex<float> const* const* Uarray,
+    std::complex<float> const* const* Varray,
+    blas::Queue& queue )
+{
+    gerbt_launch<rocblas_float_complex, float>(
+        depth, mb, nb,
+        (rocblas_float_complex* const*) Aarray, lda,
+        (rocblas_float_complex const* const*) Uarray,
+        (rocblas_float_complex const* const*) Varray, queue );
+}
+
+template <>
+void gerbt(
+    int64_t depth,
+    int64_t const* mb, int64_t const* nb,
+    std::complex<double>* const* Aarray, int64_t const* lda,
+    std::complex<double> const* const* Uarray,
+    std::complex<double> const* const* Varray,
+    blas::Queue& queue )
+{
+    gerbt_launch<rocblas_double_complex, double>(
+        depth, mb, nb,
+        (rocblas_double_complex* const*) Aarray, lda,
+        (rocblas_double_complex const* const*) Uarray,
+        (rocblas_double_complex const* const*) Varray, queue );
+}
+
+} // namespace device
+} // namespace slate
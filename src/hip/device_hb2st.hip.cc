@@ -0,0 +1,365 @@
+#include "hip/hip_runtime.h"
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/Exception.hh"
+#include "slate/internal/device.hh"
+
+#include "device_util.hip.hh"
+
+namespace slate {
+namespace device {
+
+//------------------------------------------------------------------------------
+/// Device function generating a Householder reflector
+/// $H = I - \tau v v^H$ such that $H^H x = \beta e_1$, as in LAPACK larfg,
+/// but without rescaling tiny beta. Stores tau in v[0] and the rest of the
+/// reflector in v[1:m-1], and overwrites x with beta e_1.
+/// Called by the whole thread block; uses blockDim.x + 1 entries of shmem.
+///
+template <typename scalar_t>
+__device__ void hb2st_larfg(
+    int64_t m, scalar_t* x, scalar_t* v, scalar_t* shmem )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    int tid = threadIdx.x;
+    scalar_t* partial = shmem;
+    scalar_t* scale   = &shmem[ blockDim.x ];
+
+    // partial[ 0 ] = || x[1:m-1] ||^2
+    real_t sum = 0;
+    for (int64_t e = 1 + tid; e < m; e += blockDim.x) {
+        real_t a = abs( x[ e ] );
+        sum += a*a;
+    }
+    copy( sum, partial[ tid ] );
+    __syncthreads();
+    sum_reduce( blockDim.x, tid, partial );
+
+    if (tid == 0) {
+        scalar_t alpha = x[ 0 ];
+        real_t xnorm = sqrt( real( partial[ 0 ] ) );
+        scalar_t tau, beta;
+        if (xnorm == 0 && imag( alpha ) == 0) {
+            // H = I.
+            copy( real_t( 0 ), tau );
+            copy( real_t( 0 ), *scale );
+            beta = alpha;
+        }
+        else {
+            real_t a = abs( alpha );
+            real_t norm = sqrt( a*a + xnorm*xnorm );
+            copy( real( alpha ) >= 0 ? -norm : norm, beta );
+            tau = (beta - alpha) / real( beta );
+            *scale = real_t( 1 ) / (alpha - beta);
+        }
+        v[ 0 ] = tau;
+        x[ 0 ] = beta;
+    }
+    __syncthreads();
+
+    for (int64_t e = 1 + tid; e < m; e += blockDim.x) {
+        v[ e ] = x[ e ] * (*scale);
+        copy( real_t( 0 ), x[ e ] );
+    }
+    __syncthreads();
+}
+
+//------------------------------------------------------------------------------
+/// Device function applying a Householder reflector to the lower triangle
+/// of a Hermitian matrix from both sides, as in internal::herf:
+/// $A = H A H^H$ with $H = I - \tau v v^H$, where tau = conj( v[0] ).
+/// Uses m entries of work and blockDim.x + 1 entries of shmem.
+///
+template <typename scalar_t>
+__device__ void hb2st_herf(
+    int64_t m, scalar_t const* v,
+    scalar_t* A, int64_t lda,
+    scalar_t* work, scalar_t* shmem )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    int tid = threadIdx.x;
+    scalar_t* w = work;
+    scalar_t* partial = shmem;
+    scalar_t* alpha   = &shmem[ blockDim.x ];
+    scalar_t one;
+    copy( real_t( 1 ), one );
+    scalar_t tau = conj( v[ 0 ] );
+
+    // w = A v, using only the lower triangle of A; v[0] is 1.
+    // partial = w^H v
+    scalar_t dot;
+    copy( real_t( 0 ), dot );
+    for (int64_t i = tid; i < m; i += blockDim.x) {
+        scalar_t wi;
+        copy( real( A[ i + i*lda ] ), wi );
+        wi = wi * (i == 0 ? one : v[ i ]);
+        for (int64_t j = 0; j < i; ++j)
+            wi += A[ i + j*lda ] * (j == 0 ? one : v[ j ]);
+        for (int64_t j = i+1; j < m; ++j)
+            wi += conj( A[ j + i*lda ] ) * v[ j ];
+        w[ i ] = wi;
+        dot += conj( wi ) * (i == 0 ? one : v[ i ]);
+    }
+    partial[ tid ] = dot;
+    __syncthreads();
+    sum_reduce( blockDim.x, tid, partial );
+
+    // w = A v - 0.5 tau (w^H v) v
+    if (tid == 0)
+        *alpha = real_t( -0.5 ) * tau * partial[ 0 ];
+    __syncthreads();
+    for (int64_t i = tid; i < m; i += blockDim.x)
+        w[ i ] += (*alpha) * (i == 0 ? one : v[ i ]);
+    __syncthreads();
+
+    // A = A - tau v w^H - conj(tau) w v^H, lower triangle, real diagonal.
+    for (int64_t i = tid; i < m; i += blockDim.x) {
+        scalar_t vi = i == 0 ? one : v[ i ];
+        scalar_t wi = w[ i ];
+        for (int64_t j = 0; j <= i; ++j) {
+            scalar_t vj = j == 0 ? one : v[ j ];
+            scalar_t aij = A[ i + j*lda ]
+                         - tau * vi * conj( w[ j ] )
+                         - conj( tau ) * wi * conj( vj );
+            if (i == j)
+                copy( real( aij ), aij );
+            A[ i + j*lda ] = aij;
+        }
+    }
+    __syncthreads();
+}
+
+//------------------------------------------------------------------------------
+/// Kernel implementing one wavefront of tridiagonal bulge chasing.
+/// Thread block k does step (wave - 3*sweep) of sweep = sweep_begin + k,
+/// the same task as impl::hb2st_step on the host.
+/// @copydoc hb2st_wave
+///
+template <typename scalar_t>
+__global__ void hb2st_wave_kernel(
+    int64_t n, int64_t band,
+    int64_t wave, int64_t sweep_begin,
+    scalar_t* A, int64_t lda,
+    scalar_t* V, int64_t ldv, int64_t vgroup_stride, int64_t vgroups,
+    scalar_t* work )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    extern __shared__ char dynamic_data[];
+    scalar_t* shmem = (scalar_t*) dynamic_data;
+
+    int tid = threadIdx.x;
+    int64_t sweep = sweep_begin + blockIdx.x;
+    int64_t step  = wave - 3*sweep;
+    work = &work[ blockIdx.x * band ];
+
+    // Steps 0, 1, ... map to task types 0, 1, 2, 1, 2, ...
+    int64_t task  = step == 0 ? 0 : (step + 1) % 2 + 1;
+    int64_t block = step/2;
+
+    // Vectors of this sweep: column sweep % band of consecutive
+    // 2*band-by-band tiles of the group of sweeps.
+    int64_t vj = sweep % band;
+    int64_t vi = vj + 1;
+    scalar_t* Vs = &V[ ((sweep / band) % vgroups) * vgroup_stride
+                       + vi + vj*ldv ];
+    int64_t vtile = band*ldv;
+
+    if (task == 0) {
+        int64_t i  = sweep;
+        int64_t m1 = min( i + band, n - 1 ) - i;
+        scalar_t* v = Vs;
+        hb2st_larfg( m1, &A[ (i+1) + i*lda ], v, shmem );
+        hb2st_herf( m1, v, &A[ (i+1) + (i+1)*lda ], lda, work, shmem );
+    }
+    else if (task == 1) {
+        int64_t i = (block+1)*band + 1 + sweep;
+        int64_t j =  block   *band + 1 + sweep;
+        if (i < n) {
+            int64_t m2 = min( i + band - 1, n - 1 ) - i + 1;
+            scalar_t const* v1 = &Vs[ ((step-1)/2) * vtile ];
+            scalar_t*       v2 = &Vs[ ((step+1)/2) * vtile ];
+            scalar_t* B = &A[ i + j*lda ];
+            scalar_t one;
+            copy( real_t( 1 ), one );
+
+            // Apply reflector from the previous task from the right,
+            // B = B - conj( tau1 ) (B v1) v1^H, one row per thread.
+            scalar_t tau1 = conj( v1[ 0 ] );
+            for (int64_t r = tid; r < m2; r += blockDim.x) {
+                scalar_t wr = B[ r ];
+                for (int64_t c = 1; c < band; ++c)
+                    wr += B[ r + c*lda ] * v1[ c ];
+                wr = conj( tau1 ) * wr;
+                B[ r ] -= wr;
+                for (int64_t c = 1; c < band; ++c)
+                    B[ r + c*lda ] -= wr * conj( v1[ c ] );
+            }
+            __syncthreads();
+
+            // Bring column 0 back to the band, then apply the reflector
+            // from the left to the other columns, one column per thread,
+            // B = B - tau2 v2 (v2^H B).
+            hb2st_larfg( m2, B, v2, shmem );
+            scalar_t tau2 = conj( v2[ 0 ] );
+            for (int64_t c = 1 + tid; c < band; c += blockDim.x) {
+                scalar_t* Bc = &B[ c*lda ];
+                scalar_t yc = Bc[ 0 ];
+                for (int64_t r = 1; r < m2; ++r)
+                    yc += conj( v2[ r ] ) * Bc[ r ];
+                yc = tau2 * yc;
+                Bc[ 0 ] -= yc;
+                for (int64_t r = 1; r < m2; ++r)
+                    Bc[ r ] -= v2[ r ] * yc;
+            }
+            __syncthreads();
+        }
+    }
+    else {
+        int64_t i = block*band + 1 + sweep;
+        if (i < n) {
+            int64_t m1 = min( i + band - 1, n - 1 ) - i + 1;
+            scalar_t const* v = &Vs[ (step/2) * vtile ];
+            hb2st_herf( m1, v, &A[ i + i*lda ], lda, work, shmem );
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// One wavefront of tridiagonal bulge chasing of a Hermitian band matrix.
+/// Step t of sweep s depends on step t-1 of sweep s and step t+2 of
+/// sweep s-1, so all steps with 3*s + t = wave are independent and run
+/// concurrently, one sweep per thread block. Wavefronts 0, 1, ... done in
+/// order are the same sweeps, steps, and reflectors as impl::hb2st_run.
+///
+/// @param[in] n
+///     Order of the matrix A. n >= 0.
+///
+/// @param[in] band
+///     Bandwidth of A. band >= 1.
+///
+/// @param[in] wave
+///     The wavefront, 3*sweep + step.
+///
+/// @param[in] sweep_begin
+///     First sweep in the wavefront.
+///
+/// @param[in] sweep_count
+///     Number of sweeps in the wavefront.
+///
+/// @param[in,out] A
+///     The lower triangle of the n-by-n Hermitian band matrix, in GPU memory,
+///     with entry (i, j) stored in A[ i + j*lda ] for 0 <= i - j <= 2*band,
+///     i.e., LAPACK band storage with ldab = lda + 1, with room for the bulge.
+///
+/// @param[in] lda
+///     Leading dimension of A. lda >= 2*band.
+///
+/// @param[in,out] V
+///     Householder reflectors, in GPU memory, in vgroups groups of
+///     vgroup_stride entries, with sweep s in group (s / band) % vgroups.
+///     Each group is consecutive ldv-by-band tiles, in the same layout as
+///     the tiles of V in hb2st.
+///
+/// @param[in] ldv
+///     Leading dimension of V tiles. ldv >= 2*band.
+///
+/// @param[in] vgroup_stride
+///     Entries between groups of V.
+///
+/// @param[in] vgroups
+///     Number of groups of V.
+///
+/// @param[out] work
+///     Workspace of dimension sweep_count*band, in GPU memory.
+///
+/// @param[in] queue
+///     BLAS++ queue to execute in.
+///
+template <typename scalar_t>
+void hb2st_wave(
+    int64_t n, int64_t band,
+    int64_t wave, int64_t sweep_begin, int64_t sweep_count,
+    scalar_t* A, int64_t lda,
+    scalar_t* V, int64_t ldv, int64_t vgroup_stride, int64_t vgroups,
+    scalar_t* work,
+    blas::Queue& queue )
+{
+    // quick return
+    if (sweep_count == 0)
+        return;
+
+    hipSetDevice( queue.device() );
+
+    int nthreads = std::min( int64_t( 256 ), roundup( band + 1, int64_t( 32 ) ) );
+    size_t shared_mem = sizeof(scalar_t) * (nthreads + 1);
+
+    hb2st_wave_kernel<<<sweep_count, nthreads, shared_mem, queue.stream()>>>(
+        n, band, wave, sweep_begin, A, lda,
+        V, ldv, vgroup_stride, vgroups, work );
+
+    hipError_t error = hipGetLastError();
+    slate_assert( error == hipSuccess );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void hb2st_wave(
+    int64_t n, int64_t band,
+    int64_t wave, int64_t sweep_begin, int64_t sweep_count,
+    float* A, int64_t lda,
+    float* V, int64_t ldv, int64_t vgroup_stride, int64_t vgroups,
+    float* work,
+    blas::Queue& queue );
+
+template
+void hb2st_wave(
+    int64_t n, int64_t band,
+    int64_t wave, int64_t sweep_begin, int64_t sweep_count,
+    double* A, int64_t lda,
+    double* V, int64_t ldv, int64_t vgroup_stride, int64_t vgroups,
+    double* work,
+    blas::Queue& queue );
+
+//------------------------------------------------------------------------------
+// Specializations to cast std::complex => hipComplex.
+template <>
+void hb2st_wave(
+    int64_t n, int64_t band,
+    int64_t wave, int64_t sweep_begin, int64_t sweep_count,
+    std::complex<float>* A, int64_t lda,
+    std::complex<float>* V, int64_t ldv, int64_t vgroup_stride, int64_t vgroups,
+    std::complex<float>* work,
+    blas::Queue& queue )
+{
+    hb2st_wave( n, band, wave, sweep_begin, sweep_count,
+                (rocblas_float_complex*) A, lda,
+                (rocblas_float_complex*) V, ldv, vgroup_stride, vgroups,
+                (rocblas_float_complex*) work,
+                queue );
+}
+
+template <>
+void hb2st_wave(
+    int64_t n, int64_t band,
+    int64_t wave, int64_t sweep_begin, int64_t sweep_count,
+    std::complex<double>* A, int64_t lda,
+    std::complex<double>* V, int64_t ldv, int64_t vgroup_stride, int64_t vgroups,
+    std::complex<double>* work,
+    blas::Queue& queue )
+{
+    hb2st_wave( n, band, wave, sweep_begin, sweep_count,
+                (rocblas_double_complex*) A, lda,
+                (rocblas_double_complex*) V, ldv, vgroup_stride, vgroups,
+                (rocblas_double_complex*) work,
+                queue );
+}
+
+} // namespace device
+} // namespace slate
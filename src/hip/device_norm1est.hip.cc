@@ -0,0 +1,369 @@
+#include "hip/hip_runtime.h"
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/Exception.hh"
+#include "slate/internal/device.hh"
+
+#include "device_util.hip.hh"
+
+#include <cstdio>
+
+namespace slate {
+namespace device {
+
+//------------------------------------------------------------------------------
+/// Sets real x to its sign, 1 if x >= 0, otherwise -1.
+/// @return 1 if the sign differs from the previous sign s, else 0.
+/// Sets s to the new sign.
+template <typename real_t>
+__device__ int norm1est_sign_entry(real_t& x, real_t& s, real_t safmin)
+{
+    real_t sign = x >= 0 ? 1 : -1;
+    int changed = (sign != s);
+    x = sign;
+    s = sign;
+    return changed;
+}
+
+//------------------------------------------------------------------------------
+/// Sets complex x to x / |x|, or 1 if |x| <= safmin. s is not used.
+/// @return 0.
+template <typename scalar_t, typename real_t>
+__device__ int norm1est_sign_entry(scalar_t& x, scalar_t& s, real_t safmin)
+{
+    real_t absx = abs( x );
+    if (absx > safmin)
+        x = x / absx;
+    else
+        copy( real_t( 1 ), x );
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+/// Kernel implementing the sign step of norm1est.
+/// One thread block deals with the vector.
+/// Each thread deals with one entry, looping by blockDim.x.
+/// Launched by norm1est_sign().
+///
+/// @copydoc norm1est_sign
+///
+template <typename scalar_t>
+__global__ void norm1est_sign_kernel(
+    int64_t m, scalar_t* x, scalar_t* s, int64_t* nchanged,
+    blas::real_type<scalar_t> safmin)
+{
+    // Save partial counts in shared memory.
+    extern __shared__ char dynamic_data[];
+    int64_t* count = (int64_t*) dynamic_data;
+    count[ threadIdx.x ] = 0;
+
+    for (int64_t i = threadIdx.x; i < m; i += blockDim.x)
+        count[ threadIdx.x ] += norm1est_sign_entry( x[ i ], s[ i ], safmin );
+
+    // Sum reduction of the counts.
+    __syncthreads();
+    for (int k = blockDim.x / 2; k > 0; k /= 2) {
+        if (threadIdx.x < k)
+            count[ threadIdx.x ] += count[ threadIdx.x + k ];
+        __syncthreads();
+    }
+    if (threadIdx.x == 0)
+        *nchanged = count[ 0 ];
+}
+
+//------------------------------------------------------------------------------
+/// Kernel implementing the argmax step of norm1est.
+/// One thread block deals with the vector.
+/// Each thread deals with one entry, looping by blockDim.x.
+/// Launched by norm1est_amax().
+///
+/// @copydoc norm1est_amax
+///
+template <typename scalar_t>
+__global__ void norm1est_amax_kernel(
+    int64_t m, scalar_t const* x,
+    blas::real_type<scalar_t>* amax, int64_t* index)
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // Save partial results in shared memory: maxima, then their indices.
+    extern __shared__ char dynamic_data[];
+    int64_t* thread_index = (int64_t*) dynamic_data;
+    real_t* thread_max = (real_t*) &thread_index[ blockDim.x ];
+    thread_max[ threadIdx.x ] = 0;
+    thread_index[ threadIdx.x ] = 0;
+
+    // Each thread keeps its first maximum.
+    for (int64_t i = threadIdx.x; i < m; i += blockDim.x) {
+        real_t absx = abs( x[ i ] );
+        if (absx > thread_max[ threadIdx.x ]) {
+            thread_max[ threadIdx.x ] = absx;
+            thread_index[ threadIdx.x ] = i;
+        }
+    }
+
+    // Max reduction, keeping the smallest index among equal maxima.
+    __syncthreads();
+    for (int k = blockDim.x / 2; k > 0; k /= 2) {
+        if (threadIdx.x < k) {
+            real_t max2 = thread_max[ threadIdx.x + k ];
+            int64_t index2 = thread_index[ threadIdx.x + k ];
+            if (max2 > thread_max[ threadIdx.x ]
+                || (max2 == thread_max[ threadIdx.x ] && max2 > 0
+                    && index2 < thread_index[ threadIdx.x ])) {
+                thread_max[ threadIdx.x ] = max2;
+                thread_index[ threadIdx.x ] = index2;
+            }
+        }
+        __syncthreads();
+    }
+    if (threadIdx.x == 0) {
+        *amax  = thread_max[ 0 ];
+        *index = thread_index[ 0 ];
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Kernel implementing the alternating sign vector of norm1est.
+/// Each thread deals with one entry.
+/// Launched by norm1est_altsgn().
+///
+/// @copydoc norm1est_altsgn
+///
+template <typename scalar_t>
+__global__ void norm1est_altsgn_kernel(
+    int64_t m, int64_t ioffset, int64_t n, scalar_t* x)
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    int64_t i = blockIdx.x * int64_t( blockDim.x ) + threadIdx.x;
+    if (i < m) {
+        int64_t k = ioffset + i;
+        // Sign is (-1)^(k (k+1) / 2), which is + for k mod 4 = 0 or 3.
+        real_t sign = (k % 4 == 0 || k % 4 == 3) ? 1 : -1;
+        copy( sign * (1 + real_t( k - 1 ) / real_t( n - 1 )), x[ i ] );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Replaces each entry of the vector x by its sign, for norm1est.
+/// For real x, x_i = 1 if x_i >= 0, otherwise -1, and counts the entries
+/// whose sign differs from the previous signs s, then sets s = x.
+/// For complex x, x_i = x_i / |x_i|, or 1 if x_i is zero, and s is not
+/// used.
+///
+/// @param[in] m
+///     Number of entries of x. m >= 0.
+///
+/// @param[in,out] x
+///     Vector of dimension m in GPU memory.
+///
+/// @param[in,out] s
+///     Vector of dimension m in GPU memory.
+///     On entry, the previous signs; on exit, the signs of x.
+///
+/// @param[out] nchanged
+///     In GPU memory. On exit, the number of signs that changed.
+///     0 for complex x.
+///
+/// @param[in] queue
+///     BLAS++ queue to execute in.
+///
+template <typename scalar_t>
+void norm1est_sign(
+    int64_t m, scalar_t* x, scalar_t* s, int64_t* nchanged,
+    blas::Queue& queue)
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    hipSetDevice( queue.device() );
+
+    // Power of 2 for the reduction.
+    int nthreads = 512;
+    size_t shared_mem = sizeof(int64_t) * nthreads;
+    real_t safmin = std::numeric_limits<real_t>::min();
+
+    norm1est_sign_kernel<<<1, nthreads, shared_mem, queue.stream()>>>(
+        m, x, s, nchanged, safmin );
+
+    hipError_t error = hipGetLastError();
+    slate_assert(error == hipSuccess);
+}
+
+//------------------------------------------------------------------------------
+/// Finds the entry of the vector x of largest absolute value, for
+/// norm1est. Entries that are NaN are ignored.
+///
+/// @param[in] m
+///     Number of entries of x. m >= 0.
+///
+/// @param[in] x
+///     Vector of dimension m in GPU memory.
+///
+/// @param[out] amax
+///     In GPU memory. On exit, max_i |x_i|, or 0 if m = 0.
+///
+/// @param[out] index
+///     In GPU memory. On exit, the first index i with |x_i| = amax,
+///     or 0 if x is zero.
+///
+/// @param[in] queue
+///     BLAS++ queue to execute in.
+///
+template <typename scalar_t>
+void norm1est_amax(
+    int64_t m, scalar_t const* x,
+    blas::real_type<scalar_t>* amax, int64_t* index,
+    blas::Queue& queue)
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    hipSetDevice( queue.device() );
+
+    // Power of 2 for the reduction.
+    int nthreads = 512;
+    size_t shared_mem = (sizeof(int64_t) + sizeof(real_t)) * nthreads;
+
+    norm1est_amax_kernel<<<1, nthreads, shared_mem, queue.stream()>>>(
+        m, x, amax, index );
+
+    hipError_t error = hipGetLastError();
+    slate_assert(error == hipSuccess);
+}
+
+//------------------------------------------------------------------------------
+/// Sets the vector x to the alternating sign vector of norm1est,
+///     x_i = (-1)^(k (k+1) / 2) (1 + (k - 1) / (n - 1)),
+/// where k = ioffset + i is the global index of entry i.
+///
+/// @param[in] m
+///     Number of entries of x. m >= 0.
+///
+/// @param[in] ioffset
+///     Global index of x_0.
+///
+/// @param[in] n
+///     Global length of the vector. n >= 2.
+///
+/// @param[out] x
+///     Vector of dimension m in GPU memory.
+///
+/// @param[in] queue
+///     BLAS++ queue to execute in.
+///
+template <typename scalar_t>
+void norm1est_altsgn(
+    int64_t m, int64_t ioffset, int64_t n, scalar_t* x,
+    blas::Queue& queue)
+{
+    // quick return
+    if (m == 0)
+        return;
+
+    hipSetDevice( queue.device() );
+
+    int64_t nthreads = std::min( int64_t( 1024 ), m );
+    int64_t nblocks = ceildiv( m, nthreads );
+
+    norm1est_altsgn_kernel<<<nblocks, nthreads, 0, queue.stream()>>>(
+        m, ioffset, n, x );
+
+    hipError_t error = hipGetLastError();
+    slate_assert(error == hipSuccess);
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void norm1est_sign(
+    int64_t m, float* x, float* s, int64_t* nchanged,
+    blas::Queue& queue);
+
+template
+void norm1est_sign(
+    int64_t m, double* x, double* s, int64_t* nchanged,
+    blas::Queue& queue);
+
+template
+void norm1est_amax(
+    int64_t m, float const* x,
+    float* amax, int64_t* index,
+    blas::Queue& queue);
+
+template
+void norm1est_amax(
+    int64_t m, double const* x,
+    double* amax, int64_t* index,
+    blas::Queue& queue);
+
+template
+void norm1est_altsgn(
+    int64_t m, int64_t ioffset, int64_t n, float* x,
+    blas::Queue& queue);
+
+template
+void norm1est_altsgn(
+    int64_t m, int64_t ioffset, int64_t n, double* x,
+    blas::Queue& queue);
+
+//------------------------------------------------------------------------------
+// Specializations to cast std::complex => hipComplex.
+template <>
+void norm1est_sign(
+    int64_t m, std::complex<float>* x, std::complex<float>* s,
+    int64_t* nchanged,
+    blas::Queue& queue)
+{
+    norm1est_sign( m, (rocblas_float_complex*) x, (rocblas_float_complex*) s,
+                   nchanged, queue );
+}
+
+template <>
+void norm1est_sign(
+    int64_t m, std::complex<double>* x, std::complex<double>* s,
+    int64_t* nchanged,
+    blas::Queue& queue)
+{
+    norm1est_sign( m, (rocblas_double_complex*) x, (rocblas_double_complex*) s,
+                   nchanged, queue );
+}
+
+template <>
+void norm1est_amax(
+    int64_t m, std::complex<float> const* x,
+    float* amax, int64_t* index,
+    blas::Queue& queue)
+{
+    norm1est_amax( m, (rocblas_float_complex const*) x, amax, index, queue );
+}
+
+template <>
+void norm1est_amax(
+    int64_t m, std::complex<double> const* x,
+    double* amax, int64_t* index,
+    blas::Queue& queue)
+{
+    norm1est_amax( m, (rocblas_double_complex const*) x, amax, index, queue );
+}
+
+template <>
+void norm1est_altsgn(
+    int64_t m, int64_t ioffset, int64_t n, std::complex<float>* x,
+    blas::Queue& queue)
+{
+    norm1est_altsgn( m, ioffset, n, (rocblas_float_complex*) x, queue );
+}
+
+template <>
+void norm1est_altsgn(
+    int64_t m, int64_t ioffset, int64_t n, std::complex<double>* x,
+    blas::Queue& queue)
+{
+    norm1est_altsgn( m, ioffset, n, (rocblas_double_complex*) x, queue );
+}
+
+} // namespace device
+} // namespace slate
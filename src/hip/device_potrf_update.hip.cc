@@ -0,0 +1,193 @@
+#include "hip/hip_runtime.h"
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/Exception.hh"
+#include "slate/internal/device.hh"
+
+#include "device_util.hip.hh"
+
+#include <cstdio>
+
+namespace slate {
+namespace device {
+
+namespace batch {
+
+//------------------------------------------------------------------------------
+/// Kernel applying the rotations of a Cholesky update or downdate to a
+/// batch of tiles of L and V, as tile::potrf_update_apply.
+/// Rows are independent, so each thread deals with one row of a tile,
+/// applying all the rotations in order.
+/// The grid is over rows in x and the batch in y.
+/// Launched by potrf_update_apply().
+///
+/// @copydoc potrf_update_apply
+///
+template <typename scalar_t>
+__global__ void potrf_update_apply_kernel(
+    bool conj_trans, int sign, int64_t m, int64_t n, int64_t k,
+    scalar_t const* R, int64_t ldr,
+    scalar_t** Aarray, int64_t lda,
+    scalar_t** Varray, int64_t ldv)
+{
+    int64_t i = blockIdx.x * int64_t( blockDim.x ) + threadIdx.x;
+    if (i >= m)
+        return;
+
+    scalar_t* A = Aarray[ blockIdx.y ];
+    scalar_t* V = Varray[ blockIdx.y ];
+
+    for (int64_t j = 0; j < n; ++j) {
+        scalar_t* aij = conj_trans ? &A[ j + i*lda ] : &A[ i + j*lda ];
+        scalar_t a = conj_trans ? conj( *aij ) : *aij;
+        for (int64_t l = 0; l < k; ++l) {
+            auto c = real( R[ j + l*ldr ] );
+            scalar_t s = R[ j + (k + l)*ldr ];
+            scalar_t& v = V[ i + l*ldv ];
+            if (sign > 0) {
+                scalar_t a_new = a*c + conj( s )*v;
+                v = v*c - s*a;
+                a = a_new;
+            }
+            else {
+                // Mixed form of the hyperbolic rotation.
+                a = a*c - conj( s )*v;
+                v = (v - s*a) / c;
+            }
+        }
+        *aij = conj_trans ? conj( a ) : a;
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Batched application of the rotations of a Cholesky rank-k update
+/// (sign = 1) or downdate (sign = -1) of a diagonal tile to tiles below it,
+///     [ L_b, V_b ] = [ L_b, V_b ] Q,
+/// as tile::potrf_update_apply for each b = 0, ..., batch_count-1.
+///
+/// @param[in] op
+///     NoTrans if Aarray holds the tiles L_b,
+///     ConjTrans if it holds L_b^H, e.g., for upper A.
+///
+/// @param[in] sign
+///     1 for an update, -1 for a downdate.
+///
+/// @param[in] m
+///     Number of rows of each L_b and V_b. m >= 0.
+///
+/// @param[in] n
+///     Number of columns of each L_b. n >= 0.
+///
+/// @param[in] k
+///     Number of columns of each V_b. k >= 0.
+///
+/// @param[in] R
+///     The n-by-2k rotations from tile::potrf_update, stored in an
+///     ldr-by-2k array in GPU memory.
+///
+/// @param[in] ldr
+///     Leading dimension of R. ldr >= n.
+///
+/// @param[in,out] Aarray
+///     Array in GPU memory of dimension batch_count, containing pointers
+///     to the column-major tiles L_b, or L_b^H, in GPU memory.
+///
+/// @param[in] lda
+///     Leading dimension of each tile in Aarray.
+///
+/// @param[in,out] Varray
+///     Array in GPU memory of dimension batch_count, containing pointers
+///     to the m-by-k column-major tiles V_b in GPU memory.
+///
+/// @param[in] ldv
+///     Leading dimension of each tile in Varray. ldv >= m.
+///
+/// @param[in] batch_count
+///     Size of Aarray and Varray. batch_count <= 65535.
+///
+/// @param[in] queue
+///     BLAS++ queue to execute in.
+///
+template <typename scalar_t>
+void potrf_update_apply(
+    blas::Op op, int sign, int64_t m, int64_t n, int64_t k,
+    scalar_t const* R, int64_t ldr,
+    scalar_t** Aarray, int64_t lda,
+    scalar_t** Varray, int64_t ldv,
+    int64_t batch_count, blas::Queue& queue )
+{
+    // quick return
+    if (m == 0 || n == 0 || k == 0 || batch_count == 0)
+        return;
+
+    hipSetDevice( queue.device() );
+
+    int64_t nthreads = std::min( int64_t( 256 ), m );
+    dim3 threads( nthreads );
+    dim3 blocks( (m + nthreads - 1) / nthreads, batch_count );
+
+    potrf_update_apply_kernel<<<blocks, threads, 0, queue.stream()>>>(
+        op != blas::Op::NoTrans, sign, m, n, k,
+        R, ldr, Aarray, lda, Varray, ldv );
+
+    hipError_t error = hipGetLastError();
+    slate_assert(error == hipSuccess);
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void potrf_update_apply(
+    blas::Op op, int sign, int64_t m, int64_t n, int64_t k,
+    float const* R, int64_t ldr,
+    float** Aarray, int64_t lda,
+    float** Varray, int64_t ldv,
+    int64_t batch_count, blas::Queue& queue );
+
+template
+void potrf_update_apply(
+    blas::Op op, int sign, int64_t m, int64_t n, int64_t k,
+    double const* R, int64_t ldr,
+    double** Aarray, int64_t lda,
+    double** Varray, int64_t ldv,
+    int64_t batch_count, blas::Queue& queue );
+
+//------------------------------------------------------------------------------
+// Specializations to cast std::complex => hipComplex.
+template <>
+void potrf_update_apply(
+    blas::Op op, int sign, int64_t m, int64_t n, int64_t k,
+    std::complex<float> const* R, int64_t ldr,
+    std::complex<float>** Aarray, int64_t lda,
+    std::complex<float>** Varray, int64_t ldv,
+    int64_t batch_count, blas::Queue& queue )
+{
+    potrf_update_apply( op, sign, m, n, k,
+                        (rocblas_float_complex const*) R, ldr,
+                        (rocblas_float_complex**) Aarray, lda,
+                        (rocblas_float_complex**) Varray, ldv,
+                        batch_count, queue );
+}
+
+template <>
+void potrf_update_apply(
+    blas::Op op, int sign, int64_t m, int64_t n, int64_t k,
+    std::complex<double> const* R, int64_t ldr,
+    std::complex<double>** Aarray, int64_t lda,
+    std::complex<double>** Varray, int64_t ldv,
+    int64_t batch_count, blas::Queue& queue )
+{
+    potrf_update_apply( op, sign, m, n, k,
+                        (rocblas_double_complex const*) R, ldr,
+                        (rocblas_double_complex**) Aarray, lda,
+                        (rocblas_double_complex**) Varray, ldv,
+                        batch_count, queue );
+}
+
+} // namespace batch
+
+} // namespace device
+} // namespace slate
@@ -0,0 +1,362 @@
+#include "hip/hip_runtime.h"
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/Exception.hh"
+#include "slate/internal/device.hh"
+
+#include "device_util.hip.hh"
+
+#include <limits>
+
+namespace slate {
+namespace device {
+
+//------------------------------------------------------------------------------
+/// Device function finding root j of the secular equation
+/// \[
+///     f(\lambda) = 1/\rho + \sum_i z_i^2 / (d_i - \lambda) = 0,
+/// \]
+/// for d sorted increasing, rho > 0, and z of unit norm, so the root is in
+/// $(d_j, d_{j+1})$, or in $(d_{n-1}, d_{n-1} + \rho]$ for j = n-1.
+///
+/// As in LAPACK laed4, the root is found as an offset tau from the nearer
+/// pole $d_o$, and delta is computed as $(d_i - d_o) - \tau$, which keeps
+/// the relative accuracy of the small denominators needed by the
+/// Löwner formula. Uses safeguarded Newton iteration on tau,
+/// falling back to bisection of the bracket.
+/// Called by one thread per root.
+///
+template <typename real_t>
+__device__ void stedc_secular_root(
+    int64_t n, int64_t j,
+    real_t const* D, real_t const* z, real_t rho, real_t eps,
+    real_t* lambda, real_t* delta )
+{
+    const int max_iters = 200;
+    real_t rho_inv = 1 / rho;
+
+    // Choose the pole nearer the root, bracketing tau in [lo, hi].
+    int64_t origin = j;
+    real_t lo = 0, hi = rho;
+    if (j < n-1) {
+        real_t half = (D[ j+1 ] - D[ j ]) / 2;
+        real_t f = rho_inv;
+        for (int64_t i = 0; i < n; ++i)
+            f += z[ i ] * z[ i ] / ((D[ i ] - D[ j ]) - half);
+        if (f >= 0) {
+            hi = half;
+        }
+        else {
+            origin = j+1;
+            lo = -half;
+            hi = 0;
+        }
+    }
+    real_t d0 = D[ origin ];
+
+    real_t tau = (lo + hi) / 2;
+    for (int iter = 0; iter < max_iters; ++iter) {
+        // f and f' at tau; f is increasing on the bracket.
+        real_t f = rho_inv, df = 0;
+        for (int64_t i = 0; i < n; ++i) {
+            real_t t = z[ i ] / ((D[ i ] - d0) - tau);
+            f  += z[ i ] * t;
+            df += t * t;
+        }
+        if (f == 0)
+            break;
+        if (f > 0)
+            hi = tau;
+        else
+            lo = tau;
+
+        real_t next = tau - f / df;
+        if (! (lo < next && next < hi))
+            next = (lo + hi) / 2;
+        bool done = abs( next - tau ) <= eps * abs( next );
+        tau = next;
+        if (done)
+            break;
+    }
+
+    *lambda = d0 + tau;
+    for (int64_t i = 0; i < n; ++i)
+        delta[ i ] = (D[ i ] - d0) - tau;
+}
+
+//------------------------------------------------------------------------------
+/// Kernel for stedc_secular_roots: each thread block solves blockDim.x
+/// roots, one per thread.
+/// @see stedc_secular_roots
+///
+template <typename real_t>
+__global__ void stedc_secular_roots_kernel(
+    int64_t n, int64_t nroots, int64_t const* roots,
+    real_t const* D, real_t const* z, real_t rho, real_t eps,
+    real_t* Lambda, real_t* Delta, int64_t ldd )
+{
+    int64_t k = blockIdx.x * int64_t( blockDim.x ) + threadIdx.x;
+    if (k < nroots) {
+        stedc_secular_root( n, roots[ k ], D, z, rho, eps,
+                            &Lambda[ k ], &Delta[ k*ldd ] );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Kernel for stedc_secular_ztilde: each thread computes one entry of the
+/// partial product.
+/// @see stedc_secular_ztilde
+///
+template <typename real_t>
+__global__ void stedc_secular_ztilde_kernel(
+    int64_t n, int64_t nroots, int64_t const* roots,
+    real_t const* D, real_t const* Delta, int64_t ldd,
+    real_t* ztilde )
+{
+    int64_t i = blockIdx.x * int64_t( blockDim.x ) + threadIdx.x;
+    if (i < n) {
+        real_t zi = 1;
+        for (int64_t k = 0; k < nroots; ++k) {
+            int64_t j = roots[ k ];
+            if (i == j)
+                zi *= Delta[ i + k*ldd ];
+            else
+                zi *= Delta[ i + k*ldd ] / (D[ i ] - D[ j ]);
+        }
+        ztilde[ i ] = zi;
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Kernel for stedc_secular_vectors: each thread block computes one
+/// eigenvector, using blockDim.x entries of shmem.
+/// @see stedc_secular_vectors
+///
+template <typename real_t>
+__global__ void stedc_secular_vectors_kernel(
+    int64_t n, real_t const* ztilde, real_t* Delta, int64_t ldd )
+{
+    extern __shared__ char dynamic_data[];
+    real_t* partial = (real_t*) dynamic_data;
+
+    int tid = threadIdx.x;
+    real_t* u = &Delta[ blockIdx.x * ldd ];
+
+    // u = ztilde ./ delta, and its max norm.
+    real_t amax = 0;
+    for (int64_t i = tid; i < n; i += blockDim.x) {
+        u[ i ] = ztilde[ i ] / u[ i ];
+        amax = max( amax, abs( u[ i ] ) );
+    }
+    partial[ tid ] = amax;
+    __syncthreads();
+    for (int s = blockDim.x / 2; s > 0; s /= 2) {
+        if (tid < s)
+            partial[ tid ] = max( partial[ tid ], partial[ tid + s ] );
+        __syncthreads();
+    }
+    amax = partial[ 0 ];
+    __syncthreads();
+    if (amax == 0)
+        return;
+
+    // Scaled 2-norm, to avoid overflow.
+    real_t sum = 0;
+    for (int64_t i = tid; i < n; i += blockDim.x) {
+        real_t t = u[ i ] / amax;
+        sum += t * t;
+    }
+    partial[ tid ] = sum;
+    __syncthreads();
+    for (int s = blockDim.x / 2; s > 0; s /= 2) {
+        if (tid < s)
+            partial[ tid ] += partial[ tid + s ];
+        __syncthreads();
+    }
+    real_t nrm = amax * sqrt( partial[ 0 ] );
+
+    for (int64_t i = tid; i < n; i += blockDim.x)
+        u[ i ] /= nrm;
+}
+
+//------------------------------------------------------------------------------
+/// Solves a batch of roots of the secular equation, as laed4 does one at a
+/// time on the host.
+///
+/// @param[in] n
+///     Order of the secular equation. n > 2.
+///
+/// @param[in] nroots
+///     Number of roots to solve.
+///
+/// @param[in] roots
+///     Array of length nroots in GPU memory. Indices j of the roots to solve,
+///     0 <= j < n.
+///
+/// @param[in] D
+///     Array of length n in GPU memory. The poles, sorted increasing.
+///
+/// @param[in] z
+///     Array of length n in GPU memory. The updating vector, of unit norm.
+///
+/// @param[in] rho
+///     The scalar in the secular equation. rho > 0.
+///
+/// @param[out] Lambda
+///     Array of length nroots in GPU memory. Lambda[ k ] is root roots[ k ].
+///
+/// @param[out] Delta
+///     n-by-nroots matrix in GPU memory. Column k has
+///     $d_i - \lambda_k$, computed accurately from the nearer pole.
+///
+/// @param[in] ldd
+///     Leading dimension of Delta. ldd >= n.
+///
+/// @param[in] queue
+///     BLAS++ queue to execute in.
+///
+template <typename real_t>
+void stedc_secular_roots(
+    int64_t n, int64_t nroots, int64_t const* roots,
+    real_t const* D, real_t const* z, real_t rho,
+    real_t* Lambda, real_t* Delta, int64_t ldd,
+    blas::Queue& queue )
+{
+    // quick return
+    if (nroots == 0)
+        return;
+
+    hipSetDevice( queue.device() );
+
+    // Several roots per thread block, one per thread; all threads read the
+    // same D[ i ], z[ i ] at the same time.
+    int nthreads = 64;
+    int64_t nblocks = ceildiv( nroots, int64_t( nthreads ) );
+    real_t eps = std::numeric_limits<real_t>::epsilon();
+
+    stedc_secular_roots_kernel<<<nblocks, nthreads, 0, queue.stream()>>>(
+        n, nroots, roots, D, z, rho, eps, Lambda, Delta, ldd );
+
+    hipError_t error = hipGetLastError();
+    slate_assert( error == hipSuccess );
+}
+
+//------------------------------------------------------------------------------
+/// Computes this rank's partial product for the Löwner formula,
+/// \[
+///     \tilde{z}_i = \prod_k \delta_{i,k} / (d_i - d_{j_k}),
+/// \]
+/// over roots $j_k$ = roots[ k ], excluding the $d_i - d_{j_k}$ factor
+/// for $j_k = i$. The product over all roots is $-\tilde{z}_i^2$.
+///
+/// @param[in] roots, D, Delta, ldd
+///     As output by stedc_secular_roots.
+///
+/// @param[out] ztilde
+///     Array of length n in GPU memory. The partial product.
+///
+template <typename real_t>
+void stedc_secular_ztilde(
+    int64_t n, int64_t nroots, int64_t const* roots,
+    real_t const* D, real_t const* Delta, int64_t ldd,
+    real_t* ztilde,
+    blas::Queue& queue )
+{
+    // quick return
+    if (n == 0)
+        return;
+
+    hipSetDevice( queue.device() );
+
+    int nthreads = 256;
+    int64_t nblocks = ceildiv( n, int64_t( nthreads ) );
+
+    stedc_secular_ztilde_kernel<<<nblocks, nthreads, 0, queue.stream()>>>(
+        n, nroots, roots, D, Delta, ldd, ztilde );
+
+    hipError_t error = hipGetLastError();
+    slate_assert( error == hipSuccess );
+}
+
+//------------------------------------------------------------------------------
+/// Computes eigenvectors of the secular equation from the Löwner formula,
+/// $u_k = \tilde{z} ./ \delta_k / \| \tilde{z} ./ \delta_k \|$,
+/// overwriting each column $\delta_k$ of Delta.
+///
+/// @param[in] ztilde
+///     Array of length n in GPU memory. The final ztilde, with sign from z.
+///
+/// @param[in,out] Delta
+///     n-by-ncols matrix in GPU memory. On entry, as output by
+///     stedc_secular_roots. On exit, the eigenvectors.
+///
+template <typename real_t>
+void stedc_secular_vectors(
+    int64_t n, int64_t ncols,
+    real_t const* ztilde, real_t* Delta, int64_t ldd,
+    blas::Queue& queue )
+{
+    // quick return
+    if (ncols == 0)
+        return;
+
+    hipSetDevice( queue.device() );
+
+    int nthreads = 256;
+    size_t shared_mem = sizeof(real_t) * nthreads;
+
+    stedc_secular_vectors_kernel<<<ncols, nthreads, shared_mem, queue.stream()>>>(
+        n, ztilde, Delta, ldd );
+
+    hipError_t error = hipGetLastError();
+    slate_assert( error == hipSuccess );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+// Only real, not complex.
+template
+void stedc_secular_roots(
+    int64_t n, int64_t nroots, int64_t const* roots,
+    float const* D, float const* z, float rho,
+    float* Lambda, float* Delta, int64_t ldd,
+    blas::Queue& queue );
+
+template
+void stedc_secular_roots(
+    int64_t n, int64_t nroots, int64_t const* roots,
+    double const* D, double const* z, double rho,
+    double* Lambda, double* Delta, int64_t ldd,
+    blas::Queue& queue );
+
+template
+void stedc_secular_ztilde(
+    int64_t n, int64_t nroots, int64_t const* roots,
+    float const* D, float const* Delta, int64_t ldd,
+    float* ztilde,
+    blas::Queue& queue );
+
+template
+void stedc_secular_ztilde(
+    int64_t n, int64_t nroots, int64_t const* roots,
+    double const* D, double const* Delta, int64_t ldd,
+    double* ztilde,
+    blas::Queue& queue );
+
+template
+void stedc_secular_vectors(
+    int64_t n, int64_t ncols,
+    float const* ztilde, float* Delta, int64_t ldd,
+    blas::Queue& queue );
+
+template
+void stedc_secular_vectors(
+    int64_t n, int64_t ncols,
+    double const* ztilde, double* Delta, int64_t ldd,
+    blas::Queue& queue );
+
+} // namespace device
+} // namespace slate
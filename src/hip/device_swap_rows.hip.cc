@@ -0,0 +1,143 @@
+#include "hip/hip_runtime.h"
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/Exception.hh"
+#include "slate/internal/device.hh"
+
+#include "device_util.hip.hh"
+
+#include <cstdio>
+
+namespace slate {
+namespace device {
+
+namespace batch {
+
+//------------------------------------------------------------------------------
+/// Kernel applying a sequence of row swaps to each set of rows in a batch.
+/// Each thread swaps one column of every pair of rows, in order, so the
+/// swaps within a set are applied sequentially.
+/// The grid is over columns in x and the batch in y.
+///
+/// @copydoc swap_rows
+///
+template <typename scalar_t>
+__global__ void swap_rows_kernel(
+    int64_t n, int64_t nswaps,
+    scalar_t** rows1, scalar_t** rows2 )
+{
+    int64_t j = blockIdx.x * int64_t( blockDim.x ) + threadIdx.x;
+    if (j >= n)
+        return;
+
+    scalar_t** rows1_k = &rows1[ blockIdx.y * nswaps ];
+    scalar_t** rows2_k = &rows2[ blockIdx.y * nswaps ];
+
+    for (int64_t s = 0; s < nswaps; ++s) {
+        scalar_t* row1 = rows1_k[ s ];
+        scalar_t* row2 = rows2_k[ s ];
+        if (row1 != nullptr && row1 != row2) {
+            scalar_t tmp = row1[ j ];
+            row1[ j ] = row2[ j ];
+            row2[ j ] = tmp;
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Batched sequence of row swaps, as blas::swap applied to each pair of
+/// rows in turn, but with one launch for the whole batch.
+/// For each k = 0, ..., batch_count-1 and s = 0, ..., nswaps-1 in order,
+/// swaps the n contiguous entries of
+///     rows1[ k*nswaps + s ] and rows2[ k*nswaps + s ].
+/// A null rows1 entry skips that swap, so sets with fewer swaps can be
+/// padded. Rows are contiguous, as in RowMajor tiles.
+///
+/// @param[in] n
+///     Number of entries in each row. n >= 0.
+///
+/// @param[in] nswaps
+///     Number of swaps in each set of the batch. nswaps >= 0.
+///
+/// @param[in,out] rows1
+///     Array in GPU memory of dimension nswaps*batch_count,
+///     with pointers to the first rows of the swaps.
+///
+/// @param[in,out] rows2
+///     Array in GPU memory of dimension nswaps*batch_count,
+///     with pointers to the second rows of the swaps.
+///
+/// @param[in] batch_count
+///     Size of the batch. batch_count <= 65535.
+///
+/// @param[in] queue
+///     BLAS++ queue to execute in.
+///
+template <typename scalar_t>
+void swap_rows(
+    int64_t n, int64_t nswaps,
+    scalar_t** rows1, scalar_t** rows2,
+    int64_t batch_count, blas::Queue& queue )
+{
+    // quick return
+    if (n == 0 || nswaps == 0 || batch_count == 0)
+        return;
+
+    hipSetDevice( queue.device() );
+
+    int64_t nthreads = std::min( int64_t( 256 ), n );
+    dim3 threads( nthreads );
+    dim3 blocks( (n + nthreads - 1) / nthreads, batch_count );
+
+    swap_rows_kernel<<<blocks, threads, 0, queue.stream()>>>(
+        n, nswaps, rows1, rows2 );
+
+    hipError_t error = hipGetLastError();
+    slate_assert(error == hipSuccess);
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void swap_rows(
+    int64_t n, int64_t nswaps,
+    float** rows1, float** rows2,
+    int64_t batch_count, blas::Queue& queue );
+
+template
+void swap_rows(
+    int64_t n, int64_t nswaps,
+    double** rows1, double** rows2,
+    int64_t batch_count, blas::Queue& queue );
+
+//------------------------------------------------------------------------------
+// Specializations to cast std::complex => hipComplex.
+template <>
+void swap_rows(
+    int64_t n, int64_t nswaps,
+    std::complex<float>** rows1, std::complex<float>** rows2,
+    int64_t batch_count, blas::Queue& queue )
+{
+    swap_rows( n, nswaps,
+               (rocblas_float_complex**) rows1, (rocblas_float_complex**) rows2,
+               batch_count, queue );
+}
+
+template <>
+void swap_rows(
+    int64_t n, int64_t nswaps,
+    std::complex<double>** rows1, std::complex<double>** rows2,
+    int64_t batch_count, blas::Queue& queue )
+{
+    swap_rows( n, nswaps,
+               (rocblas_double_complex**) rows1, (rocblas_double_complex**) rows2,
+               batch_count, queue );
+}
+
+} // namespace batch
+
+} // namespace device
+} // namespace slate
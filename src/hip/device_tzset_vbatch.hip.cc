@@ -0,0 +1,159 @@
+#include "hip/hip_runtime.h"
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/Exception.hh"
+#include "slate/internal/device.hh"
+
+#include "device_util.hip.hh"
+
+#include <algorithm>
+
+namespace slate {
+namespace device {
+
+// Threads per block; each thread sets one row at a time.
+const int tzset_vbatch_threads = 256;
+
+//------------------------------------------------------------------------------
+/// Kernel implementing variable-size batched tile set.
+/// Each thread block sets tiles blockIdx.x, blockIdx.x + gridDim.x, ...
+/// Each thread deals with one row.
+/// @see tzset_vbatch
+///
+template <typename scalar_t>
+__global__ void tzset_vbatch_kernel(
+    int64_t const* dims,
+    scalar_t offdiag_value,
+    scalar_t diag_value,
+    scalar_t** Aarray, int64_t batch_count )
+{
+    for (int64_t b = blockIdx.x; b < batch_count; b += gridDim.x) {
+        int64_t m    = dims[ b ];
+        int64_t n    = dims[ b +   batch_count ];
+        int64_t lda  = dims[ b + 2*batch_count ];
+        auto    uplo = lapack::Uplo( dims[ b + 3*batch_count ] );
+        scalar_t diag = dims[ b + 4*batch_count ] ? diag_value : offdiag_value;
+        scalar_t* A = Aarray[ b ];
+
+        // thread per row, if more rows than threads, loop by blockDim.x
+        for (int64_t i = threadIdx.x; i < m; i += blockDim.x) {
+            scalar_t* rowA = &A[ i ];
+            int64_t jbegin = uplo == lapack::Uplo::Upper ? i : 0;
+            int64_t jend   = uplo == lapack::Uplo::Lower && i < n ? i+1 : n;
+            for (int64_t j = jbegin; j < jend; ++j)
+                rowA[ j*lda ] = i == j ? diag : offdiag_value;
+        }
+    }
+}
+
+namespace batch {
+
+//------------------------------------------------------------------------------
+/// Variable-size batched tile set, for tiles of any sizes in one launch.
+/// Sets the general, lower, or upper trapezoid part of each tile A_b to
+/// offdiag_value, and its diagonal to diag_value or offdiag_value.
+///
+/// @param[in] dims
+///     Array in GPU memory of 5*batch_count int64_t: m_b, n_b, lda_b,
+///     uplo_b, and diag_b, each batch_count entries long, so
+///     dims[ b + d*batch_count ] is dimension d of tile b.
+///     - uplo_b: the part of A_b to set, as int64_t( Uplo::General ),
+///       int64_t( Uplo::Lower ), or int64_t( Uplo::Upper ).
+///     - diag_b: if nonzero, the diagonal of A_b is set to diag_value,
+///       otherwise to offdiag_value.
+///
+/// @param[in] offdiag_value
+///     The value to set outside of the diagonal.
+///
+/// @param[in] diag_value
+///     The value to set on the diagonal of tiles with nonzero diag_b.
+///
+/// @param[out] Aarray
+///     Array in GPU memory of batch_count pointers to the tiles A_b,
+///     where A_b is an m_b-by-n_b matrix stored in an lda_b-by-n_b array.
+///
+/// @param[in] batch_count
+///     Number of tiles. batch_count >= 0.
+///
+/// @param[in] queue
+///     BLAS++ queue to execute in.
+///
+template <typename scalar_t>
+void tzset_vbatch(
+    int64_t const* dims,
+    scalar_t const& offdiag_value, scalar_t const& diag_value,
+    scalar_t** Aarray,
+    int64_t batch_count, blas::Queue& queue )
+{
+    // quick return
+    if (batch_count == 0)
+        return;
+
+    hipSetDevice( queue.device() );
+
+    // Max grid dimension is large; the kernel loops over the rest.
+    int64_t blocks = std::min( batch_count, int64_t( 65535 ) );
+
+    tzset_vbatch_kernel<<<blocks, tzset_vbatch_threads, 0, queue.stream()>>>(
+        dims, offdiag_value, diag_value, Aarray, batch_count );
+
+    hipError_t error = hipGetLastError();
+    slate_assert( error == hipSuccess );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void tzset_vbatch(
+    int64_t const* dims,
+    float const& offdiag_value, float const& diag_value,
+    float** Aarray,
+    int64_t batch_count, blas::Queue& queue );
+
+template
+void tzset_vbatch(
+    int64_t const* dims,
+    double const& offdiag_value, double const& diag_value,
+    double** Aarray,
+    int64_t batch_count, blas::Queue& queue );
+
+//------------------------------------------------------------------------------
+// Specializations to cast std::complex => hipComplex.
+template <>
+void tzset_vbatch(
+    int64_t const* dims,
+    std::complex<float> const& offdiag_value,
+    std::complex<float> const& diag_value,
+    std::complex<float>** Aarray,
+    int64_t batch_count, blas::Queue& queue )
+{
+    tzset_vbatch(
+        dims,
+        rocblas_float_complex( real( offdiag_value ), imag( offdiag_value ) ),
+        rocblas_float_complex( real( diag_value    ), imag( diag_value    ) ),
+        (rocblas_float_complex**) Aarray,
+        batch_count, queue );
+}
+
+template <>
+void tzset_vbatch(
+    int64_t const* dims,
+    std::complex<double> const& offdiag_value,
+    std::complex<double> const& diag_value,
+    std::complex<double>** Aarray,
+    int64_t batch_count, blas::Queue& queue )
+{
+    tzset_vbatch(
+        dims,
+        rocblas_double_complex( real( offdiag_value ), imag( offdiag_value ) ),
+        rocblas_double_complex( real( diag_value    ), imag( diag_value    ) ),
+        (rocblas_double_complex**) Aarray,
+        batch_count, queue );
+}
+
+} // namespace batch
+} // namespace device
+} // namespace slate
@@ -12,6 +12,7 @@
 #include "slate/internal/util.hh"
 
 #include <cmath>
+#include <functional>
 #include <list>
 #include <vector>
 
@@ -23,6 +24,9 @@ namespace tile {
 
 //------------------------------------------------------------------------------
 /// Compute the QR factorization of a panel.
+/// The panel is factored recursively, in halves split on ib-wide stripes,
+/// with level 3 updates between halves; each stripe is factored a column
+/// at a time. The threads split the tiles of the panel in all steps.
 ///
 /// @param[in] ib
 ///     internal blocking in the panel
@@ -57,7 +61,8 @@ namespace tile {
 ///     Householder norm
 ///
 /// @param[out] W
-//      Workspace for the algorithm
+///     Workspace for the algorithm, one vector per thread,
+///     each of size max( ib, diag_len ) * nb.
 ///
 /// @ingroup geqrf_tile
 ///
@@ -93,11 +98,9 @@ void geqrf(
     std::vector<scalar_t> betas(diag_len);
     int64_t nb = diag_tile.nb();
 
-    // Loop over ib-wide stripes within panel
-    for (int64_t k = 0; k < diag_len; k += ib) {
-
-        int64_t kb = std::min(diag_len-k, ib);
-
+    // Factors the stripe k : k+kb-1, kb <= ib, a column at a time,
+    // with level 2 updates within the stripe.
+    auto factor_stripe = [&]( int64_t k, int64_t kb ) {
         //=======================
         //
         // ib-stripe factorization:
@@ -316,8 +319,12 @@ void geqrf(
                 diag_tile.at(j,j) = betas.at(j);
             }
         } // end of ib-factorization of Householder reflectors
+    };
 
-        // Compute V(k:m,k:k+kb)^H * [V(k:m,1:k+kb), A(k:m,k+kb+1:nb)]
+    // Computes W = V(k:m,k:k+kb)^H * A(k:m,j1:j2) and reduces it into W[0],
+    // on thread 0, after the thread barrier.
+    auto project = [&]( int64_t k, int64_t kb, int64_t j1, int64_t j2 ) {
+        int64_t n2 = j2 - j1;
         for (int64_t idx = thread_rank;
              idx < int64_t(tiles.size());
              idx += thread_size)
@@ -334,34 +341,34 @@ void geqrf(
             // be more advantageous computing extra
             // flops at once
             if (i_index == tile_indices.at(0)) {
-                for (int64_t j = 0; j < nb; ++j) {
+                for (int64_t j = 0; j < n2; ++j) {
                     for (int64_t i = 0; i < kb; ++i) {
-                        W.at(thread_rank).data()[i+j*kb] = tile.at(k+i,j);
+                        W.at(thread_rank).data()[i+j*kb] = tile.at(k+i, j1+j);
                     }
                 }
 
                 blas::trmm(Layout::ColMajor,
                            Side::Left, Uplo::Lower,
                            Op::ConjTrans, Diag::Unit,
-                           kb, nb,
+                           kb, n2,
                            one, &tile.at(k, k), tile.stride(),
                                 W.at(thread_rank).data(), kb);
 
                 if (k+kb < tile.mb()) {
                     blas::gemm(Layout::ColMajor,
                                Op::ConjTrans, Op::NoTrans,
-                               kb, nb, tile.mb()-k-kb,
+                               kb, n2, tile.mb()-k-kb,
                                one, &tile.at(k+kb, k), tile.stride(),
-                                    &tile.at(k+kb, 0), tile.stride(),
+                                    &tile.at(k+kb, j1), tile.stride(),
                                one, gemm_c, c_stride);
                 }
             }
             else {
                 blas::gemm(Layout::ColMajor,
                            Op::ConjTrans, Op::NoTrans,
-                           kb, nb, tile.mb(),
+                           kb, n2, tile.mb(),
                            one,       &tile.at(0, k), tile.stride(),
-                                      &tile.at(0, 0), tile.stride(),
+                                      &tile.at(0, j1), tile.stride(),
                            gemm_beta, gemm_c, c_stride);
             }
         }
@@ -372,10 +379,19 @@ void geqrf(
         // change inner-loop to axpy?
         if (thread_rank == 0) {
             for (int rank = 1; rank < thread_size; ++rank)
-                for (int64_t j = 0; j < nb; ++j)
+                for (int64_t j = 0; j < n2; ++j)
                     for (int64_t i = 0; i < kb; ++i)
                         W.at(0).data()[i+j*(kb)] += W.at(rank).data()[i+j*(kb)];
+        }
+    };
+
+    // Builds the columns k : k+kb-1 of T, from the inner products
+    // of the stripe's reflectors with all the previous ones.
+    auto build_T = [&]( int64_t k, int64_t kb ) {
+        // Compute V(k:m,k:k+kb)^H * V(k:m,1:k+kb)
+        project( k, kb, 0, k+kb );
 
+        if (thread_rank == 0) {
             // copy needed data for constructing rectangular block of T
             for (int64_t j = k; j < k+kb; ++j)
                 for (int64_t i = 0; i < j; ++i)
@@ -415,74 +431,101 @@ void geqrf(
             }
         }
         thread_barrier.wait(thread_size);
+    };
 
-        // Update trailing sub-matrix using
-        //       the GEMM performed earlier
-        if (k+kb < nb) {
+    // Applies the block reflector of columns k : k+kb-1,
+    // (I - V T V^H)^H, to columns j1 : j2-1.
+    auto update = [&]( int64_t k, int64_t kb, int64_t j1, int64_t j2 ) {
+        int64_t n2 = j2 - j1;
 
-            // Apply blocking factor T
-            if (thread_rank == 0) {
-                // W(1:kb,1:nb-k-kb) = T(k:k+kb,k:k+kb)^H * W(1:kb,1:nb-k-kb)
-                // where originally W(1:kb,1:nb-k-kb) = V(k:m,k:k+kb)^H A(k:m,k+kb+1:nb)
-                blas::trmm(Layout::ColMajor,
-                           Side::Left, Uplo::Upper,
-                           Op::ConjTrans, Diag::NonUnit,
-                           kb, nb-k-kb,
-                           one, &T.at(k, k), T.stride(),
-                                &W.at(0).data()[(k+kb)*(kb)], kb);
-            }
-            thread_barrier.wait(thread_size);
+        // W(1:kb,1:n2) = V(k:m,k:k+kb)^H A(k:m,j1:j2)
+        project( k, kb, j1, j2 );
 
-            // Finish projection:
-            for (int64_t idx = thread_rank;
-                 idx < int64_t(tiles.size());
-                 idx += thread_size)
-            {
-                auto tile = tiles.at(idx);
-                auto i_index = tile_indices.at(idx);
+        // Apply blocking factor T
+        if (thread_rank == 0) {
+            // W(1:kb,1:n2) = T(k:k+kb,k:k+kb)^H * W(1:kb,1:n2)
+            blas::trmm(Layout::ColMajor,
+                       Side::Left, Uplo::Upper,
+                       Op::ConjTrans, Diag::NonUnit,
+                       kb, n2,
+                       one, &T.at(k, k), T.stride(),
+                            W.at(0).data(), kb);
+        }
+        thread_barrier.wait(thread_size);
 
-                // A(k:m,k+kb:nb) = A(k:m,k+kb:nb) - V(k:m,k:k+kb) * W(1:kb,1:nb-k+kb)
-                // where W(1:kb,1:nb-k-kb) = (T(k:k+kb,k:k+kb)^H * V(k:m,k:k+kb)^H * A(k:m,k+kb+1:nb))
-                if (i_index == tile_indices.at(0)) {
-                    if (k+kb < tile.mb()) {
-                        blas::gemm(Layout::ColMajor,
-                                   Op::NoTrans, Op::NoTrans,
-                                   tile.mb()-k-kb, nb-k-kb, kb,
-                                   -one, &tile.at(k+kb, k), tile.stride(),
-                                         &W.at(0).data()[(k+kb)*(kb)], kb,
-                                    one, &tile.at(k+kb, k+kb), tile.stride());
-                    }
-                }
-                else {
+        // Finish projection:
+        for (int64_t idx = thread_rank;
+             idx < int64_t(tiles.size());
+             idx += thread_size)
+        {
+            auto tile = tiles.at(idx);
+            auto i_index = tile_indices.at(idx);
+
+            // A(k:m,j1:j2) = A(k:m,j1:j2) - V(k:m,k:k+kb) * W(1:kb,1:n2)
+            if (i_index == tile_indices.at(0)) {
+                if (k+kb < tile.mb()) {
                     blas::gemm(Layout::ColMajor,
                                Op::NoTrans, Op::NoTrans,
-                               tile.mb(), nb-k-kb, kb,
-                               -one, &tile.at(0, k), tile.stride(),
-                                     &W.at(0).data()[(k+kb)*(kb)], kb,
-                                one, &tile.at(0, k+kb), tile.stride());
+                               tile.mb()-k-kb, n2, kb,
+                               -one, &tile.at(k+kb, k), tile.stride(),
+                                     W.at(0).data(), kb,
+                                one, &tile.at(k+kb, j1), tile.stride());
                 }
             }
-            thread_barrier.wait(thread_size);
-
-            if (thread_rank == 0) {
-                // Needed due to breaking up the projection
-                // by triangular block and lower-rectangular
-                // block. This finishes the projection.
-                auto& tile = diag_tile;
-                blas::trmm(Layout::ColMajor,
-                           Side::Left, Uplo::Lower,
-                           Op::NoTrans, Diag::Unit,
-                           kb, nb-k-kb,
-                           one, &tile.at(k, k), tile.stride(),
-                                &W.at(thread_rank).data()[(k+kb)*kb], kb);
-
-                for (int64_t j = 0; j < nb-k-kb; ++j)
-                    for (int64_t i = 0; i < kb; ++i)
-                        tile.at(k+i, k+kb+j) -=
-                            W.at(thread_rank).data()[i+(j+k+kb)*(kb)];
+            else {
+                blas::gemm(Layout::ColMajor,
+                           Op::NoTrans, Op::NoTrans,
+                           tile.mb(), n2, kb,
+                           -one, &tile.at(0, k), tile.stride(),
+                                 W.at(0).data(), kb,
+                            one, &tile.at(0, j1), tile.stride());
             }
         }
-    }
+        thread_barrier.wait(thread_size);
+
+        if (thread_rank == 0) {
+            // Needed due to breaking up the projection
+            // by triangular block and lower-rectangular
+            // block. This finishes the projection.
+            auto& tile = diag_tile;
+            blas::trmm(Layout::ColMajor,
+                       Side::Left, Uplo::Lower,
+                       Op::NoTrans, Diag::Unit,
+                       kb, n2,
+                       one, &tile.at(k, k), tile.stride(),
+                            W.at(0).data(), kb);
+
+            for (int64_t j = 0; j < n2; ++j)
+                for (int64_t i = 0; i < kb; ++i)
+                    tile.at(k+i, j1+j) -= W.at(0).data()[i+j*(kb)];
+        }
+        thread_barrier.wait(thread_size);
+    };
+
+    // Factors columns j1 : j2-1 recursively, as in LAPACK geqrt3:
+    // splits them in halves, on stripe boundaries, and applies the left
+    // half's block reflector to the right half in between. Most of the
+    // work is then in level 3 updates, even if nb >> ib.
+    std::function<void (int64_t, int64_t)> factor_recursive;
+    factor_recursive = [&]( int64_t j1, int64_t j2 ) {
+        int64_t n = j2 - j1;
+        if (n <= ib) {
+            factor_stripe( j1, n );
+            build_T( j1, n );
+        }
+        else {
+            int64_t n1 = ((n/ib + 1) / 2) * ib;
+            factor_recursive( j1, j1+n1 );
+            update( j1, n1, j1+n1, j2 );
+            factor_recursive( j1+n1, j2 );
+        }
+    };
+
+    factor_recursive( 0, diag_len );
+
+    // If the panel is wider than its diagonal, update the rest of it.
+    if (diag_len < nb)
+        update( 0, diag_len, diag_len, nb );
 }
 
 } // namespace tile
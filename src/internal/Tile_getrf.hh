@@ -12,6 +12,7 @@
 #include "slate/types.hh"
 #include "slate/internal/util.hh"
 
+#include <functional>
 #include <list>
 
 #include <blas.hh>
@@ -94,8 +95,77 @@ void getrf_swap(
     }
 }
 
+//------------------------------------------------------------------------------
+/// Finds the first entry of largest cabs1 in x( 0 : n-1 ), in two passes:
+/// a max reduction, then a search for the max. Unlike a single argmax
+/// loop, each pass has no loop-carried index, so with a compile-time n
+/// both passes unroll and vectorize fully. NaN entries are skipped,
+/// as in the pivot search.
+///
+/// @tparam fixed_n
+///     If > 0, the compile-time length of x; otherwise use n.
+///
+/// @param[in] n
+///     Length of x, used if fixed_n <= 0.
+///
+/// @param[in] x
+///     Vector of length n, with stride 1.
+///
+/// @param[out] max_value
+///     cabs1 of the largest entry, or 0 if n == 0.
+///
+/// @return Index of the largest entry, or 0 if max_value is 0.
+///
+template <int64_t fixed_n, typename scalar_t>
+inline int64_t iamax_cabs1(
+    int64_t n, scalar_t const* x, blas::real_type<scalar_t>& max_value )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    if (fixed_n > 0)
+        n = fixed_n;
+
+    real_t max = 0;
+    for (int64_t i = 0; i < n; ++i) {
+        real_t v = cabs1( x[ i ] );
+        max = v > max ? v : max;
+    }
+    max_value = max;
+
+    if (max == 0)
+        return 0;
+    for (int64_t i = 0; i < n; ++i) {
+        if (cabs1( x[ i ] ) == max)
+            return i;
+    }
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+/// Dispatches iamax_cabs1 to a version specialized on the length of x,
+/// for the common tile sizes, or to the generic version otherwise.
+/// @see iamax_cabs1
+///
+template <typename scalar_t>
+inline int64_t iamax_cabs1(
+    int64_t n, scalar_t const* x, blas::real_type<scalar_t>& max_value )
+{
+    switch (n) {
+        case  64: return iamax_cabs1< 64>( n, x, max_value );
+        case 128: return iamax_cabs1<128>( n, x, max_value );
+        case 192: return iamax_cabs1<192>( n, x, max_value );
+        case 256: return iamax_cabs1<256>( n, x, max_value );
+        case 384: return iamax_cabs1<384>( n, x, max_value );
+        case 512: return iamax_cabs1<512>( n, x, max_value );
+        default:  return iamax_cabs1<  0>( n, x, max_value );
+    }
+}
+
 //------------------------------------------------------------------------------
 /// Compute the LU factorization of a panel.
+/// The panel is factored recursively, in halves split on ib-wide stripes,
+/// with level 3 updates between halves; each stripe is factored a column
+/// at a time. The threads split the tiles of the panel in all steps.
 ///
 /// @param[in] diag_len
 ///     length of the panel diagonal
@@ -143,7 +213,8 @@ void getrf_swap(
 ///
 /// @param[in] tob_block
 ///     workspace for broadcasting the top row for the geru operation
-///     and the top block for the gemm operation.
+///     and the top block for the gemm operation,
+///     of size max( ib, diag_len ) * nb.
 ///
 /// @param[in] pivot_threshold
 ///     threshold for pivoting.  1 is partial pivoting, 0 is no pivoting
@@ -184,13 +255,9 @@ void getrf(
 
     *info = 0;
 
-    // Loop over ib-wide stripes.
-    for (int64_t k = 0; k < diag_len; k += ib) {
-
-        //=======================
-        // ib panel factorization
-        int64_t kb = std::min(diag_len-k, ib);
-
+    // Factors the stripe k : k+kb-1, kb <= ib, a column at a time,
+    // with level 2 updates within the stripe.
+    auto factor_stripe = [&]( int64_t k, int64_t kb ) {
         // Loop over ib columns of a stripe.
         for (int64_t j = k; j < k+kb; ++j) {
 
@@ -224,14 +291,15 @@ void getrf(
                         }
                     }
                 }
-                // off diagonal tiles
+                // off diagonal tiles, specialized on common tile sizes
                 else {
-                    for (int64_t i = 0; i < tile.mb(); ++i) {
-                        if (cabs1(tile(i, j)) > cabs1(max_value[thread_rank])) {
-                            max_value[thread_rank] = tile(i, j);
-                            max_index[thread_rank] = idx;
-                            max_offset[thread_rank] = i;
-                        }
+                    real_t tile_max;
+                    int64_t i = iamax_cabs1( tile.mb(), &tile.at(0, j),
+                                             tile_max );
+                    if (tile_max > cabs1(max_value[thread_rank])) {
+                        max_value[thread_rank] = tile(i, j);
+                        max_index[thread_rank] = idx;
+                        max_offset[thread_rank] = i;
                     }
                 }
             }
@@ -387,63 +455,94 @@ void getrf(
             // Next instructions only use thread's assigned tiles
             // So no thread barrier is needed here
         }
-
-        // If there is a trailing submatrix.
-        if (k+kb < nb) {
-            if (thread_rank == 0) {
-                if (root) {
-                    // triangular solve
-                    auto top_tile = tiles[0];
-                    blas::trsm(Layout::ColMajor,
-                               Side::Left, Uplo::Lower,
-                               Op::NoTrans, Diag::Unit,
-                               kb, nb-k-kb,
-                               one, &top_tile.at(k, k), top_tile.stride(),
-                                    &top_tile.at(k, k+kb), top_tile.stride());
-
-                    // Broadcast the top block for gemm.
-                    lapack::lacpy(lapack::MatrixType::General,
-                                  kb, nb-k-kb,
-                                  &top_tile.at(k, k+kb), top_tile.stride(),
-                                  top_block.data(), kb);
-                }
-                slate_mpi_call(
-                    MPI_Bcast(top_block.data(),
-                              kb*(nb-k-kb), mpi_type<scalar_t>::value,
-                              mpi_root, mpi_comm));
+    };
+
+    // Updates columns j1 : j2-1 with the factored columns k : k+kb-1,
+    // by a triangular solve for the block row of U, then a gemm on the
+    // tiles of all threads.
+    auto update = [&]( int64_t k, int64_t kb, int64_t j1, int64_t j2 ) {
+        int64_t n2 = j2 - j1;
+
+        // Wait for all threads to finish with top_block.
+        thread_barrier.wait(thread_size);
+        if (thread_rank == 0) {
+            if (root) {
+                // triangular solve
+                auto top_tile = tiles[0];
+                blas::trsm(Layout::ColMajor,
+                           Side::Left, Uplo::Lower,
+                           Op::NoTrans, Diag::Unit,
+                           kb, n2,
+                           one, &top_tile.at(k, k), top_tile.stride(),
+                                &top_tile.at(k, j1), top_tile.stride());
+
+                // Broadcast the top block for gemm.
+                lapack::lacpy(lapack::MatrixType::General,
+                              kb, n2,
+                              &top_tile.at(k, j1), top_tile.stride(),
+                              top_block.data(), kb);
             }
-            thread_barrier.wait(thread_size);
-
-            //============================
-            // rank-ib update to the right
-            for (int64_t idx = thread_rank;
-                 idx < int64_t(tiles.size());
-                 idx += thread_size)
-            {
-                auto tile = tiles[idx];
-                auto i_index = tile_indices[idx];
-
-                if (i_index == 0) {
-                    if (k+kb < tile.mb()) {
-                        blas::gemm(blas::Layout::ColMajor,
-                                   Op::NoTrans, Op::NoTrans,
-                                   tile.mb()-k-kb, nb-k-kb, kb,
-                                   -one, &tile.at( k+kb, k    ), tile.stride(),
-                                         &tile.at( k,    k+kb ), tile.stride(),
-                                   one,  &tile.at( k+kb, k+kb ), tile.stride());
-                    }
-                }
-                else {
+            slate_mpi_call(
+                MPI_Bcast(top_block.data(),
+                          kb*n2, mpi_type<scalar_t>::value,
+                          mpi_root, mpi_comm));
+        }
+        thread_barrier.wait(thread_size);
+
+        //============================
+        // rank-kb update to the right
+        for (int64_t idx = thread_rank;
+             idx < int64_t(tiles.size());
+             idx += thread_size)
+        {
+            auto tile = tiles[idx];
+            auto i_index = tile_indices[idx];
+
+            if (i_index == 0) {
+                if (k+kb < tile.mb()) {
                     blas::gemm(blas::Layout::ColMajor,
                                Op::NoTrans, Op::NoTrans,
-                               tile.mb(), nb-k-kb, kb,
-                               -one, &tile.at(0, k), tile.stride(),
-                                     top_block.data(), kb,
-                               one,  &tile.at(0, k+kb), tile.stride());
+                               tile.mb()-k-kb, n2, kb,
+                               -one, &tile.at( k+kb, k  ), tile.stride(),
+                                     &tile.at( k,    j1 ), tile.stride(),
+                               one,  &tile.at( k+kb, j1 ), tile.stride());
                 }
             }
+            else {
+                blas::gemm(blas::Layout::ColMajor,
+                           Op::NoTrans, Op::NoTrans,
+                           tile.mb(), n2, kb,
+                           -one, &tile.at(0, k), tile.stride(),
+                                 top_block.data(), kb,
+                           one,  &tile.at(0, j1), tile.stride());
+            }
         }
-    }
+    };
+
+    // Factors columns j1 : j2-1 recursively, as in LAPACK getrf2:
+    // splits them in halves, on stripe boundaries, and updates the right
+    // half with the factored left half in between. Most of the work is
+    // then in level 3 updates, even if nb >> ib, while the swaps apply
+    // to whole rows of the panel.
+    std::function<void (int64_t, int64_t)> factor_recursive;
+    factor_recursive = [&]( int64_t j1, int64_t j2 ) {
+        int64_t n = j2 - j1;
+        if (n <= ib) {
+            factor_stripe( j1, n );
+        }
+        else {
+            int64_t n1 = ((n/ib + 1) / 2) * ib;
+            factor_recursive( j1, j1+n1 );
+            update( j1, n1, j1+n1, j2 );
+            factor_recursive( j1+n1, j2 );
+        }
+    };
+
+    factor_recursive( 0, diag_len );
+
+    // If the panel is wider than its diagonal, update the rest of it.
+    if (diag_len < nb)
+        update( 0, diag_len, diag_len, nb );
 }
 
 } // namespace tile
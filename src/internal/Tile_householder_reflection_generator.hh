@@ -69,8 +69,13 @@ void householder_reflection_generator(
     trace::Block trace_block("householder_reflection_generator");
 
     using blas::conj;
+    using blas::real;
+    using blas::imag;
     using real_t = blas::real_type<scalar_t>;
 
+    const scalar_t zero = 0.0;
+    const scalar_t one  = 1.0;
+
     Tile<scalar_t>& diag_tile = tiles.at(0);
     int64_t diag_len = std::min( diag_tile.mb(), diag_tile.nb() );
 
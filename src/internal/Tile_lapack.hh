@@ -262,6 +262,8 @@ void trnorm(Norm norm, Tile<scalar_t> const&& A,
 //------------------------------------------------------------------------------
 /// Cholesky factorization of tile: $L L^H = A$ or $U^H U = A$.
 /// uplo is set in the tile.
+/// A row-major tile is factored in place as the column-major conj(A),
+/// with uplo flipped, whose factor is the row-major factor of A.
 /// @ingroup posv_tile
 ///
 template <typename scalar_t>
@@ -269,7 +271,11 @@ int64_t potrf(Tile<scalar_t>& A)
 {
     trace::Block trace_block("lapack::potrf");
 
-    return lapack::potrf(A.uploPhysical(),
+    Uplo uplo = A.uploPhysical();
+    if (A.layout() == Layout::RowMajor)
+        uplo = (uplo == Uplo::Lower ? Uplo::Upper : Uplo::Lower);
+
+    return lapack::potrf(uplo,
                          A.nb(),
                          A.data(), A.stride());
 }
@@ -0,0 +1,214 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef SLATE_TILE_POTRF_UPDATE_HH
+#define SLATE_TILE_POTRF_UPDATE_HH
+
+#include <blas.hh>
+
+#include "slate/Tile.hh"
+
+#include <cmath>
+
+namespace slate {
+
+namespace tile {
+
+//------------------------------------------------------------------------------
+/// Applies one rotation of a Cholesky update (sign = 1) or downdate
+/// (sign = -1) to an entry a of a column of L and an entry v of a column
+/// of V, so that
+///     a a^H + sign v v^H
+/// is unchanged over the rows. The update uses a Givens rotation
+/// [ c, -s; conj(s), c ]; the downdate the hyperbolic rotation with
+/// c^2 - |s|^2 = 1, in its mixed form, computing v from the new a, which
+/// is stable where the plain hyperbolic rotation is not.
+/// @ingroup posv_tile
+///
+template <typename scalar_t>
+inline void potrf_update_rotate(
+    int sign, blas::real_type<scalar_t> c, scalar_t s,
+    scalar_t& a, scalar_t& v)
+{
+    using blas::conj;
+
+    if (sign > 0) {
+        scalar_t a_new = c*a + conj( s )*v;
+        v = c*v - s*a;
+        a = a_new;
+    }
+    else {
+        a = c*a - conj( s )*v;
+        v = (v - s*a) / c;
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Rank-k update or downdate of a diagonal tile of a Cholesky factor,
+/// \[
+///     \tilde{L} \tilde{L}^H = L L^H + sign V V^H,
+/// \]
+/// by a rotation of each column of L with each column of V, zeroing V.
+/// Saves the rotations in R for potrf_update_apply to apply to the tiles
+/// below.
+/// @ingroup posv_tile
+///
+/// @param[in] sign
+///     1 for an update, -1 for a downdate.
+///
+/// @param[in,out] A
+///     The n-by-n lower triangular tile L, stored as L (op NoTrans) or as
+///     L^H (op ConjTrans), column major.
+///     On exit, overwritten by $\tilde{L}$.
+///
+/// @param[in,out] V
+///     The n-by-k tile V, column major. On exit, zero.
+///
+/// @param[out] R
+///     The n-by-2k tile of rotations, column major: R(j, l) is the cosine
+///     and R(j, k + l) the sine of the rotation of column j of L with
+///     column l of V.
+///
+/// @return info: 0 on success, or j > 0 if the downdated matrix is not
+///     positive definite in column j; the rotations from column j on are
+///     then the identity.
+///
+template <typename scalar_t>
+int64_t potrf_update(
+    int sign, Tile<scalar_t>& A, Tile<scalar_t>& V, Tile<scalar_t>& R)
+{
+    using real_t = blas::real_type<scalar_t>;
+    using blas::conj;
+    using blas::real;
+
+    trace::Block trace_block( "slate::potrf_update" );
+
+    assert( A.layout() == Layout::ColMajor );
+    assert( V.layout() == Layout::ColMajor );
+    assert( A.mb() == A.nb() );
+    assert( V.mb() == A.mb() );
+    assert( R.mb() == A.mb() && R.nb() == 2*V.nb() );
+
+    int64_t n = A.mb();
+    int64_t k = V.nb();
+    bool ct = A.op() != Op::NoTrans;
+    scalar_t* a = A.data();
+    scalar_t* v = V.data();
+    scalar_t* r = R.data();
+    int64_t lda = A.stride();
+    int64_t ldv = V.stride();
+    int64_t ldr = R.stride();
+    auto L = [a, lda, ct]( int64_t i, int64_t j ) -> scalar_t& {
+        return ct ? a[ j + i*lda ] : a[ i + j*lda ];
+    };
+
+    int64_t info = 0;
+    for (int64_t j = 0; j < n; ++j) {
+        for (int64_t l = 0; l < k; ++l) {
+            real_t c = 1;
+            scalar_t s = 0;
+            if (info == 0) {
+                real_t x = real( L( j, j ) );
+                real_t y = std::abs( v[ j + l*ldv ] );
+                real_t rr;
+                if (sign > 0) {
+                    rr = std::hypot( x, y );
+                }
+                else {
+                    real_t rr2 = (x - y) * (x + y);
+                    rr = rr2 > 0 ? std::sqrt( rr2 ) : 0;
+                }
+                if (rr > 0) {
+                    c = x / rr;
+                    s = v[ j + l*ldv ] / rr;
+                    L( j, j ) = rr;
+                    v[ j + l*ldv ] = 0;
+                    for (int64_t i = j+1; i < n; ++i) {
+                        scalar_t aij = ct ? conj( L( i, j ) ) : L( i, j );
+                        potrf_update_rotate( sign, c, s, aij, v[ i + l*ldv ] );
+                        L( i, j ) = ct ? conj( aij ) : aij;
+                    }
+                }
+                else {
+                    info = j + 1;
+                }
+            }
+            r[ j + l*ldr ]       = c;
+            r[ j + (k + l)*ldr ] = s;
+        }
+    }
+    return info;
+}
+
+//------------------------------------------------------------------------------
+/// Applies the rotations of a Cholesky update or downdate of a diagonal
+/// tile, from potrf_update, to a tile of L below it and the same rows
+/// of V,
+/// \[
+///     [ L_i, V_i ] = [ L_i, V_i ] Q,
+/// \]
+/// with one pass over the rows per rotation; $O( m n k )$ flops.
+/// @ingroup posv_tile
+///
+/// @param[in] sign
+///     1 for an update, -1 for a downdate.
+///
+/// @param[in] R
+///     The n-by-2k tile of rotations from potrf_update.
+///
+/// @param[in,out] A
+///     The m-by-n tile L_i, stored as L_i (op NoTrans) or as L_i^H
+///     (op ConjTrans), column major.
+///
+/// @param[in,out] V
+///     The m-by-k tile V_i, column major.
+///
+template <typename scalar_t>
+void potrf_update_apply(
+    int sign, Tile<scalar_t> const& R, Tile<scalar_t>& A, Tile<scalar_t>& V)
+{
+    using real_t = blas::real_type<scalar_t>;
+    using blas::conj;
+    using blas::real;
+
+    trace::Block trace_block( "slate::potrf_update_apply" );
+
+    assert( A.layout() == Layout::ColMajor );
+    assert( V.layout() == Layout::ColMajor );
+    assert( V.mb() == A.mb() );
+    assert( R.mb() == A.nb() && R.nb() == 2*V.nb() );
+
+    int64_t m = A.mb();
+    int64_t n = A.nb();
+    int64_t k = V.nb();
+    bool ct = A.op() != Op::NoTrans;
+    scalar_t* a = A.data();
+    scalar_t* v = V.data();
+    scalar_t const* r = R.data();
+    int64_t lda = A.stride();
+    int64_t ldv = V.stride();
+    int64_t ldr = R.stride();
+
+    for (int64_t j = 0; j < n; ++j) {
+        for (int64_t l = 0; l < k; ++l) {
+            real_t c = real( r[ j + l*ldr ] );
+            scalar_t s = r[ j + (k + l)*ldr ];
+            if (s == scalar_t( 0 ))
+                continue;
+            for (int64_t i = 0; i < m; ++i) {
+                scalar_t& aij = ct ? a[ j + i*lda ] : a[ i + j*lda ];
+                scalar_t lij = ct ? conj( aij ) : aij;
+                potrf_update_rotate( sign, c, s, lij, v[ i + l*ldv ] );
+                aij = ct ? conj( lij ) : lij;
+            }
+        }
+    }
+}
+
+} // namespace tile
+
+} // namespace slate
+
+#endif // SLATE_TILE_POTRF_UPDATE_HH
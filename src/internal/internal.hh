@@ -17,10 +17,14 @@
 #include "slate/TriangularMatrix.hh"
 #include "slate/TriangularBandMatrix.hh"
 #include "slate/BandMatrix.hh"
+#include "slate/GrowthStats.hh"
 #include "lapack.hh"
 
 namespace slate {
 
+template <typename scalar_t>
+struct ElementwiseOp;
+
 //------------------------------------------------------------------------------
 /// @namespace slate::internal
 /// Namespace used for SLATE internal implementation.
@@ -121,6 +125,11 @@ void scale(blas::real_type<scalar_t> numer, blas::real_type<scalar_t> denom,
            BaseTrapezoidMatrix<scalar_t>&& A,
            int priority=0, int queue_index=0);
 
+// Scale by a scalar of A's type; only HostTask and Devices.
+template <Target target=Target::HostTask, typename scalar_t>
+void scale(scalar_t alpha, Matrix<scalar_t>&& A,
+           int priority=0, int queue_index=0);
+
 //-----------------------------------------
 // scale_row_col
 template <Target target=Target::HostTask, typename scalar_t, typename scalar_t2>
@@ -130,6 +139,15 @@ void scale_row_col(
     std::vector< scalar_t2 > const& C,
     Matrix<scalar_t>&& A );
 
+//-----------------------------------------
+// geequ
+template <Target target=Target::HostTask, typename scalar_t>
+void geequ(
+    RowCol rowcol, Matrix<scalar_t>&& A,
+    blas::real_type<scalar_t> const* R,
+    blas::real_type<scalar_t>* values,
+    int priority=0, int queue_index=0 );
+
 //-----------------------------------------
 // set()
 template <Target target=Target::HostTask, typename scalar_t>
@@ -180,7 +198,7 @@ void hemm(Side side,
           scalar_t alpha, HermitianMatrix<scalar_t>&& A,
                           Matrix<scalar_t>&& B,
           scalar_t beta,  Matrix<scalar_t>&& C,
-          int priority=0 );
+          int priority=0, int64_t queue_index=0 );
 
 // forward real-symmetric matrices to hemm;
 // disabled for complex
@@ -254,7 +272,7 @@ void symm(Side side,
           scalar_t alpha, SymmetricMatrix<scalar_t>&& A,
                           Matrix<scalar_t>&& B,
           scalar_t beta,  Matrix<scalar_t>&& C,
-          int priority=0 );
+          int priority=0, int64_t queue_index=0 );
 
 // forward real-Hermitian matrices to symm;
 // disabled for complex
@@ -342,13 +360,13 @@ void trsmA(Side side,
 // trtri()
 template <Target target=Target::HostTask, typename scalar_t>
 void trtri(TriangularMatrix<scalar_t>&& A,
-           int priority=0);
+           int priority=0, int64_t queue_index=0);
 
 //-----------------------------------------
 // trtrm()
 template <Target target=Target::HostTask, typename scalar_t>
 void trtrm(TriangularMatrix<scalar_t>&& A,
-           int priority=0);
+           int priority=0, int64_t queue_index=0);
 
 //------------------------------------------------------------------------------
 // LAPACK auxiliary
@@ -371,11 +389,22 @@ void add(scalar_t alpha, Matrix<scalar_t>&& A,
          scalar_t beta,  Matrix<scalar_t>&& B,
          int priority=0, int queue_index=0 );
 
+template <Target target=Target::HostTask, typename src_scalar_t,
+          typename scalar_t>
+void add(scalar_t alpha, Matrix<src_scalar_t>&& A,
+         scalar_t beta,  Matrix<scalar_t>&& B,
+         int priority=0, int queue_index=0 );
+
 template <Target target=Target::HostTask, typename scalar_t>
 void add(scalar_t alpha, BaseTrapezoidMatrix<scalar_t>&& A,
          scalar_t beta,  BaseTrapezoidMatrix<scalar_t>&& B,
          int priority=0, int queue_index=0 );
 
+// Fused element-wise operations, for Expression.
+template <Target target=Target::HostTask, typename scalar_t>
+void elementwise(std::vector< ElementwiseOp<scalar_t> >& ops,
+                 int priority=0, int queue_index=0 );
+
 template<typename scalar_t>
 void gerbt(Matrix<scalar_t> A11,
            Matrix<scalar_t> A12,
@@ -394,6 +423,21 @@ void gerbt(Side side,
            Matrix<scalar_t> U1,
            Matrix<scalar_t> U2);
 
+std::vector< std::vector<int64_t> > gerbt_groups(
+    int64_t nt, int64_t d, int64_t inner_len, int64_t lo, int64_t depth);
+
+template<typename scalar_t>
+void gerbt_fused(Matrix<scalar_t> A,
+                 Matrix<scalar_t> U,
+                 Matrix<scalar_t> V,
+                 int64_t d, int64_t inner_len, int64_t lo, int64_t depth);
+
+template<typename scalar_t>
+void gerbt_fused(Op trans,
+                 Matrix<scalar_t> B,
+                 Matrix<scalar_t> U,
+                 int64_t d, int64_t inner_len, int64_t lo, int64_t depth);
+
 template<typename scalar_t>
 std::pair<Matrix<scalar_t>, Matrix<scalar_t>> rbt_generate(
         const Matrix<scalar_t>& A,
@@ -445,6 +489,51 @@ void norm(Norm in_norm, NormScope scope, Matrix<scalar_t>&& A,
           blas::real_type<scalar_t>* values,
           int priority=0, int queue_index=0);
 
+template <Target target=Target::HostTask, typename scalar_t>
+void norm_max_fro(Matrix<scalar_t>&& A,
+                  blas::real_type<scalar_t>* values,
+                  int priority=0, int queue_index=0);
+
+// Device max and Frobenius, or column max, norms of the local tiles of A
+// for which in_tiles( i, j ) is true, or all if in_tiles is empty.
+template <typename scalar_t>
+void norm_vbatch(NormScope scope, BaseMatrix<scalar_t>& A,
+                 blas::real_type<scalar_t>* values,
+                 int priority, int queue_index,
+                 std::function<bool (int64_t, int64_t)> const& in_tiles = {});
+
+// Local max abs of all tiles, or of the upper part, of A, where each tile
+// is valid, in its layout; for growth statistics.
+template <typename scalar_t>
+void max_abs(Uplo uplo, Matrix<scalar_t>&& A,
+             blas::real_type<scalar_t>* value,
+             int priority=0, int queue_index=0);
+
+// If growth is set, updates its max |a_ij| with the local tiles of A.
+template <typename scalar_t>
+void growth_update_A(GrowthStats* growth, Matrix<scalar_t>&& A,
+                     int priority=0, int queue_index=0)
+{
+    if (growth != nullptr) {
+        blas::real_type<scalar_t> value;
+        max_abs( Uplo::General, std::move( A ), &value, priority, queue_index );
+        growth->updateA( value );
+    }
+}
+
+// If growth is set, updates its max |u_ij| with the local tiles of A,
+// of which diagonal tiles are upper triangular with Uplo::Upper.
+template <typename scalar_t>
+void growth_update_U(GrowthStats* growth, Uplo uplo, Matrix<scalar_t>&& A,
+                     int priority=0, int queue_index=0)
+{
+    if (growth != nullptr) {
+        blas::real_type<scalar_t> value;
+        max_abs( uplo, std::move( A ), &value, priority, queue_index );
+        growth->updateU( value );
+    }
+}
+
 template <Target target=Target::HostTask, typename scalar_t>
 void norm(Norm in_norm, NormScope scope, HermitianMatrix<scalar_t>&& A,
           blas::real_type<scalar_t>* values,
@@ -485,6 +574,19 @@ void getrf_panel(
     blas::real_type<scalar_t> remote_pivot_threshold,
     int max_panel_threads, int priority, int tag, int64_t* info );
 
+template <Target target=Target::HostTask, typename scalar_t>
+void getrf_panel(
+    Matrix<scalar_t>&& A, int64_t diag_len, int64_t ib,
+    std::vector<Pivot>& pivot,
+    blas::real_type<scalar_t> remote_pivot_threshold,
+    int max_panel_threads, int priority, int tag,
+    std::vector< char* >& dwork_array, size_t dwork_bytes,
+    int queue_index, int64_t* info );
+
+template <typename scalar_t>
+size_t getrf_panel_work_bytes(
+    int64_t mlocal, int64_t nb, scalar_t* dA, lapack::Queue& queue );
+
 //-----------------------------------------
 // getrf_nopiv()
 template <Target target=Target::HostTask, typename scalar_t>
@@ -502,6 +604,9 @@ void getrf_tntpiv_panel(
     std::vector<Pivot>& pivot,
     int max_panel_threads, int priority, int64_t* info );
 
+template <typename scalar_t>
+size_t getrf_tntpiv_tournament_work_bytes( int64_t nb, lapack::Queue& queue );
+
 //-----------------------------------------
 // geqrf()
 template <Target target=Target::HostTask, typename scalar_t>
@@ -565,7 +670,8 @@ void he2hb_her2k_offdiag_ranks(
 // ttqrt()
 template <Target target=Target::HostTask, typename scalar_t>
 void ttqrt(Matrix<scalar_t>&& A,
-           Matrix<scalar_t>&& T );
+           Matrix<scalar_t>&& T,
+           int arity=2 );
 
 // ttlqt()
 template <Target target=Target::HostTask, typename scalar_t>
@@ -579,7 +685,15 @@ void ttmqr(Side side, Op op,
            Matrix<scalar_t>&& A,
            Matrix<scalar_t>&& T,
            Matrix<scalar_t>&& C,
-           int tag=0 );
+           int tag=0, int queue_index=0, int arity=2 );
+
+// Device equivalent of tile::tpmqrt, used by ttmqr and hettmqr.
+template <typename scalar_t>
+void tpmqrt_device(
+    Side side, Op op,
+    Matrix<scalar_t>& A, Matrix<scalar_t>& T, int64_t i,
+    BaseMatrix<scalar_t>& C, int64_t i1, int64_t j1, int64_t i2, int64_t j2,
+    int device, int queue_index );
 
 // ttmlq()
 template <Target target=Target::HostTask, typename scalar_t>
@@ -636,13 +750,32 @@ template <Target target=Target::HostTask, typename scalar_t>
 int64_t potrf(
     HermitianMatrix<scalar_t>&& A,
     int priority=0, int64_t queue_index=0,
-    lapack::device_info_int* device_info=nullptr );
+    lapack::device_info_int* device_info=nullptr,
+    int64_t sub_tile=0 );
+
+//-----------------------------------------
+// potrf_update()
+template <typename scalar_t>
+int64_t potrf_update(
+    int sign,
+    HermitianMatrix<scalar_t>&& A,
+    Matrix<scalar_t>&& V,
+    Matrix<scalar_t>&& R );
+
+template <Target target=Target::HostTask, typename scalar_t>
+void potrf_update_apply(
+    int sign,
+    Matrix<scalar_t>&& R,
+    Matrix<scalar_t>&& A,
+    Matrix<scalar_t>&& V,
+    int priority=0, int64_t queue_index=0 );
 
 //-----------------------------------------
 // hegst()
 template <Target target=Target::HostTask, typename scalar_t>
 void hegst(int64_t itype, HermitianMatrix<scalar_t>&& A,
-                          HermitianMatrix<scalar_t>&& B);
+                          HermitianMatrix<scalar_t>&& B,
+           int64_t queue_index=0);
 
 //------------------------------------------------------------------------------
 // Norm 1 estimate
@@ -650,7 +783,16 @@ template <typename scalar_t>
 void norm1est(
     Matrix<scalar_t>& A,
     Matrix<scalar_t>& V,
-    Matrix<int64_t>& S,
+    Matrix<scalar_t>& S,
+    blas::real_type<scalar_t>* one_normest,
+    int* kase,
+    std::vector<int64_t>& isave );
+
+template <typename scalar_t>
+void norm1est_block(
+    Matrix<scalar_t>& X,
+    Matrix<scalar_t>& V,
+    Matrix<scalar_t>& S,
     blas::real_type<scalar_t>* one_normest,
     int* kase,
     std::vector<int64_t>& isave );
@@ -659,6 +801,12 @@ void norm1est(
 // MPI reduce info, used in getrf, hetrf, etc.
 void reduce_info( int64_t* info, MPI_Comm mpi_comm );
 
+void reduce_info( int64_t* info, MPI_Comm mpi_comm, GrowthStats* growth );
+
+void reduce_info( int64_t* info, MPI_Comm mpi_comm, Options const& opts );
+
+int64_t wait_info( int64_t info, Options const& opts );
+
 } // namespace internal
 } // namespace slate
 
@@ -0,0 +1,144 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/internal/Affinity.hh"
+#include "slate/internal/openmp.hh"
+
+#include <mutex>
+
+#ifdef __linux__
+    #include <pthread.h>
+    #include <sched.h>
+#endif
+
+namespace slate {
+namespace internal {
+
+namespace {
+
+//------------------------------------------------------------------------------
+/// Panel cores of the active CoreAffinity, empty if none is active.
+std::mutex affinity_mutex;
+std::vector<int> panel_cores_active;
+
+//------------------------------------------------------------------------------
+/// @return the cores in the calling thread's affinity mask, in order;
+/// empty if unsupported.
+std::vector<int> get_thread_cores()
+{
+    std::vector<int> cores;
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO( &set );
+    if (pthread_getaffinity_np( pthread_self(), sizeof( set ), &set ) == 0) {
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET( cpu, &set ))
+                cores.push_back( cpu );
+        }
+    }
+#endif
+    return cores;
+}
+
+//------------------------------------------------------------------------------
+/// Sets the calling thread's affinity mask to cores, if not empty.
+void set_thread_cores( std::vector<int> const& cores )
+{
+#ifdef __linux__
+    if (cores.empty())
+        return;
+    cpu_set_t set;
+    CPU_ZERO( &set );
+    for (int cpu : cores)
+        CPU_SET( cpu, &set );
+    // A failure leaves the mask as is, which only costs performance.
+    pthread_setaffinity_np( pthread_self(), sizeof( set ), &set );
+#endif
+}
+
+//------------------------------------------------------------------------------
+/// Sets the affinity mask of each thread of an OpenMP team to cores.
+/// OpenMP reuses the team's threads in the next parallel regions.
+void set_team_cores( std::vector<int> const& cores )
+{
+    #pragma omp parallel
+    set_thread_cores( cores );
+}
+
+} // anonymous namespace
+
+//------------------------------------------------------------------------------
+/// Reserves the first panel_cores cores of the process's mask for panels;
+/// binds the OpenMP team to the others.
+///
+/// @param[in] panel_cores
+///     Number of cores for panel and communication threads; 0: off.
+///
+CoreAffinity::CoreAffinity( int64_t panel_cores )
+    : enabled_( false )
+{
+    if (panel_cores <= 0)
+        return;
+
+    process_cores_ = get_thread_cores();
+    if (int64_t( process_cores_.size() ) <= panel_cores)
+        return;
+
+    {
+        std::lock_guard<std::mutex> guard( affinity_mutex );
+        if (! panel_cores_active.empty())
+            return;
+        panel_cores_active.assign( process_cores_.begin(),
+                                   process_cores_.begin() + panel_cores );
+    }
+    enabled_ = true;
+
+    std::vector<int> update_cores( process_cores_.begin() + panel_cores,
+                                   process_cores_.end() );
+    set_team_cores( update_cores );
+}
+
+//------------------------------------------------------------------------------
+/// Restores the process's mask on the OpenMP team.
+///
+CoreAffinity::~CoreAffinity()
+{
+    if (enabled_) {
+        set_team_cores( process_cores_ );
+        std::lock_guard<std::mutex> guard( affinity_mutex );
+        panel_cores_active.clear();
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Binds the calling thread to the panel cores, if a CoreAffinity is
+/// active.
+///
+PanelBinding::PanelBinding()
+    : bound_( false )
+{
+    std::vector<int> panel_cores;
+    {
+        std::lock_guard<std::mutex> guard( affinity_mutex );
+        panel_cores = panel_cores_active;
+    }
+    if (! panel_cores.empty()) {
+        thread_cores_ = get_thread_cores();
+        set_thread_cores( panel_cores );
+        bound_ = true;
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Restores the calling thread's mask.
+///
+PanelBinding::~PanelBinding()
+{
+    if (bound_)
+        set_thread_cores( thread_cores_ );
+}
+
+} // namespace internal
+} // namespace slate
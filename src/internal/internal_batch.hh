@@ -8,7 +8,9 @@
 /// Provides various helper functions for batched routines.
 ///
 /// Provides simple precision-independent wrappers around MKL batch
-/// routines. Eventually to be replaced by BLAS++ batch routines.
+/// routines, and host_gemm_batch, a grouped batch gemm on the host that
+/// uses them with MKL and OpenMP tasks otherwise.
+/// Eventually to be replaced by BLAS++ batch routines.
 ///
 /// Provides routines to build the batch regions for device batched kernels.
 #ifndef SLATE_INTERNAL_BATCH_HH
@@ -16,6 +18,10 @@
 
 #include "slate/Exception.hh"
 #include "slate/BaseMatrix.hh"
+#include "slate/Tile_blas.hh"
+#include "slate/internal/device.hh"
+#include "slate/Counters.hh"
+#include "slate/internal/openmp.hh"
 
 #include <blas.hh>
 
@@ -23,8 +29,11 @@
     #include <mkl_cblas.h>
 #endif
 
+#include <algorithm>
 #include <complex>
+#include <map>
 #include <set>
+#include <vector>
 
 namespace slate {
 namespace internal {
@@ -151,6 +160,108 @@ inline void cblas_gemm_batch(
 }
 #endif // BLAS_HAVE_MKL
 
+//------------------------------------------------------------------------------
+/// Grouped batch gemm on the host, with the interface of MKL's
+/// cblas_?gemm_batch: group g has group_size[ g ] multiplies
+///     C_b = alpha[ g ] op( A_b ) op( B_b ) + beta[ g ] C_b,
+/// which share the op, m, n, k, alpha, beta, and leading dimensions of
+/// index g; the pointer arrays list groups consecutively.
+///
+/// With Intel MKL, calls cblas_?gemm_batch. Otherwise runs the multiplies
+/// with BLAS++ gemm, which any BLAS provides (BLIS, OpenBLAS, ArmPL, ...),
+/// in one OpenMP task per thread, each doing a contiguous chunk of
+/// multiplies, so a batch of small tiles doesn't pay for a task per tile.
+/// With ComputePrecision::Complex3M, complex multiplies use tile::gemm3m
+/// in the same tasks, also with MKL.
+/// Call from inside a parallel region.
+///
+template <typename scalar_t>
+void host_gemm_batch(
+    Layout layout,
+    Op const* opA_array,
+    Op const* opB_array,
+    int const* m_array,
+    int const* n_array,
+    int const* k_array,
+    scalar_t const* alpha_array,
+    scalar_t const** A_array,
+    int const* lda_array,
+    scalar_t const** B_array,
+    int const* ldb_array,
+    scalar_t const* beta_array,
+    scalar_t** C_array,
+    int const* ldc_array,
+    int group_count,
+    int const* group_size,
+    ComputePrecision precision = ComputePrecision::Native)
+{
+#ifdef BLAS_HAVE_MKL
+    if (precision != ComputePrecision::Complex3M) {
+        std::vector<CBLAS_TRANSPOSE> transA( group_count ), transB( group_count );
+        for (int g = 0; g < group_count; ++g) {
+            transA[ g ] = cblas_trans_const( opA_array[ g ] );
+            transB[ g ] = cblas_trans_const( opB_array[ g ] );
+        }
+        cblas_gemm_batch(
+            layout == Layout::ColMajor ? CblasColMajor : CblasRowMajor,
+            transA.data(), transB.data(),
+            m_array, n_array, k_array,
+            alpha_array, A_array, lda_array,
+                         B_array, ldb_array,
+            beta_array,  C_array, ldc_array,
+            group_count, group_size );
+        return;
+    }
+#endif
+    // offsets[ g ] is the index of the first multiply of group g.
+    std::vector<int64_t> offsets( group_count + 1, 0 );
+    for (int g = 0; g < group_count; ++g)
+        offsets[ g+1 ] = offsets[ g ] + group_size[ g ];
+    int64_t batch_count = offsets[ group_count ];
+    if (batch_count == 0)
+        return;
+
+    int64_t num_chunks = std::min( batch_count,
+                                   int64_t( omp_get_max_threads() ) );
+
+    #pragma omp taskgroup
+    for (int64_t chunk = 0; chunk < num_chunks; ++chunk) {
+        #pragma omp task slate_omp_default_none \
+            shared( offsets ) \
+            firstprivate( chunk, num_chunks, batch_count, layout, precision, \
+                          opA_array, opB_array, m_array, n_array, k_array, \
+                          alpha_array, A_array, lda_array, B_array, \
+                          ldb_array, beta_array, C_array, ldc_array )
+        {
+            int64_t begin = chunk * batch_count / num_chunks;
+            int64_t end = (chunk + 1) * batch_count / num_chunks;
+            // Group of the first multiply of the chunk.
+            int64_t g = std::upper_bound( offsets.begin(), offsets.end(),
+                                          begin ) - offsets.begin() - 1;
+            for (int64_t b = begin; b < end; ++b) {
+                while (b >= offsets[ g+1 ])
+                    ++g;
+                if (precision == ComputePrecision::Complex3M) {
+                    tile::gemm3m(
+                        layout, opA_array[ g ], opB_array[ g ],
+                        m_array[ g ], n_array[ g ], k_array[ g ],
+                        alpha_array[ g ], A_array[ b ], lda_array[ g ],
+                                          B_array[ b ], ldb_array[ g ],
+                        beta_array[ g ],  C_array[ b ], ldc_array[ g ] );
+                }
+                else {
+                    blas::gemm(
+                        layout, opA_array[ g ], opB_array[ g ],
+                        m_array[ g ], n_array[ g ], k_array[ g ],
+                        alpha_array[ g ], A_array[ b ], lda_array[ g ],
+                                          B_array[ b ], ldb_array[ g ],
+                        beta_array[ g ],  C_array[ b ], ldc_array[ g ] );
+                }
+            }
+        }
+    }
+}
+
 
 // Utilities for computing device batch regions
 
@@ -214,6 +325,76 @@ public:
     }
 };
 
+//------------------------------------------------------------------------------
+/// Assigns the local tiles of a batched update to devices, when
+/// C.deviceStealing() is set. Each device gets at most
+/// ceil( tiles.size() / num_devices ) tiles: the last tiles of a device
+/// with more stay in the given order but move, one by one, to the device
+/// with the fewest. As the trailing matrix of a factorization shrinks
+/// from its first tiles, taking the last tiles moves mostly the same
+/// tiles from one step to the next, instead of copying them back.
+///
+/// @param[in] C
+///     The matrix updated by the batch, for the tileDevice of each tile.
+///
+/// @param[in] tiles
+///     The local tiles of C in the batch.
+///
+/// @return the device to update each tile on.
+///
+template <typename scalar_t>
+std::map< std::tuple< int64_t, int64_t >, int > device_steal_assign(
+        BaseMatrix<scalar_t>& C,
+        std::vector< std::tuple< int64_t, int64_t > > const& tiles)
+{
+    using ij_tuple = std::tuple< int64_t, int64_t >;
+
+    int num_devices = C.num_devices();
+    std::vector< std::vector< ij_tuple > > home( num_devices );
+    for (auto ij : tiles)
+        home[ C.tileDevice( std::get<0>( ij ), std::get<1>( ij ) ) ].push_back( ij );
+
+    int64_t quota = ceildiv( int64_t( tiles.size() ), int64_t( num_devices ) );
+    std::vector< int64_t > load( num_devices );
+    for (int device = 0; device < num_devices; ++device)
+        load[ device ] = home[ device ].size();
+
+    std::map< ij_tuple, int > assigned;
+    for (int device = 0; device < num_devices; ++device) {
+        for (int64_t t = 0; t < int64_t( home[ device ].size() ); ++t) {
+            int dest = device;
+            if (t >= quota) {
+                // The total is at most quota * num_devices, so while this
+                // device is over its quota, another is under.
+                dest = std::min_element( load.begin(), load.end() )
+                       - load.begin();
+                ++load[ dest ];
+                --load[ device ];
+            }
+            assigned[ home[ device ][ t ] ] = dest;
+        }
+    }
+    return assigned;
+}
+
+//------------------------------------------------------------------------------
+/// @return whether any input matrix, mats[1:], has a structurally zero tile
+/// for tile (i, j) of mats[0], with size 1 dimensions broadcast.
+/// @see device_regions_build
+///
+template< int mat_count, typename scalar_t >
+bool device_regions_zero(
+        std::array< std::reference_wrapper<BaseMatrix<scalar_t>>, mat_count >& mats,
+        int64_t const* i_step, int64_t const* j_step,
+        int64_t i, int64_t j)
+{
+    for (int m = 1; m < mat_count; ++m) {
+        if (mats[ m ].get().tileIsZero( i*i_step[m], j*j_step[m] ))
+            return true;
+    }
+    return false;
+}
+
 //------------------------------------------------------------------------------
 /// @copydoc device_regions_build(std::array< std::reference_wrapper<BaseMatrix<scalar_t>>, mat_count >, std::array< scalar_t**, mat_count >, int64_t, std::function<void(int64_t, int64_t, int64_t)>)
 ///
@@ -223,14 +404,20 @@ public:
 /// @param[in] jrange
 ///     The ranges of tiles with a uniform number of columns
 ///
-template< bool store_diag, int mat_count, typename scalar_t, bool diag_same=!store_diag >
+/// @param[in] tile_device
+///     If set, the device to compute each tile of mats[0] on,
+///     instead of its tileDevice, e.g., from device_steal_assign.
+///
+template< bool store_diag, int mat_count, typename scalar_t, bool diag_same=!store_diag,
+          bool skip_zero=false >
 std::vector< device_regions_params<store_diag, mat_count> > device_regions_build(
         std::array< std::reference_wrapper<BaseMatrix<scalar_t>>, mat_count > mats,
         std::array< scalar_t**, mat_count > mats_array_host,
         int64_t device,
         std::function<void(int64_t, int64_t, int64_t)> extra_setup,
         std::vector<int64_t>& irange,
-        std::vector<int64_t>& jrange)
+        std::vector<int64_t>& jrange,
+        std::function<int (int64_t, int64_t)> tile_device = {})
 {
     // The first two arguments should be valid targets for brace-initialization
     // reference_wrapper works around fact that C++ doesn't allow array of references
@@ -260,6 +447,7 @@ std::vector< device_regions_params<store_diag, mat_count> > device_regions_build
     int64_t batch_count = 0;
     int64_t mt = A.mt();
     std::vector<Params> group_params;
+    std::vector<int64_t> local_rows;
     // loop over regions
     for (size_t jj = 0; jj < jrange.size() - 1; ++jj) {
     for (size_t ii = 0; ii < irange.size() - 1; ++ii) {
@@ -275,9 +463,21 @@ std::vector< device_regions_params<store_diag, mat_count> > device_regions_build
             // * General matrices run the whole range
             int64_t istart = std::max(irange[ ii ], (A.uplo() == Uplo::Lower ? j+1 : 0));
             int64_t iend   = std::min(irange[ ii+1 ], (A.uplo() == Uplo::Upper ? j : mt));
-            for (int64_t i = istart; i < iend; ++i) {
+            // Only local tiles on this device, from the storage's cache,
+            // instead of checking every tile of the region.
+            local_rows.clear();
+            if (istart < iend && tile_device) {
+                for (int64_t i = istart; i < iend; ++i) {
+                    if (A.tileIsLocal( i, j ) && tile_device( i, j ) == device)
+                        local_rows.push_back( i );
+                }
+            }
+            else if (istart < iend)
+                A.tileLocalRows( j, istart, iend, device, local_rows );
+            for (int64_t i : local_rows) {
                 if ((diag_same || i != j)
-                    && A.tileIsLocal( i, j ) && device == A.tileDevice( i, j )) {
+                    && ! (skip_zero && device_regions_zero<mat_count, scalar_t>(
+                                           mats, i_step, j_step, i, j ))) {
 
                     // Add tiles to current group
                     for (int m = 0; m < mat_count; ++m) {
@@ -316,7 +516,10 @@ std::vector< device_regions_params<store_diag, mat_count> > device_regions_build
             int64_t ijend   = std::min(irange[ ii+1 ], jrange[ jj+1 ]);
             for (int64_t ij = ijstart; ij < ijend; ++ij) {
                 if (A.tileIsLocal( ij, ij )
-                    && device == A.tileDevice( ij, ij )) {
+                    && device == (tile_device ? tile_device( ij, ij )
+                                              : A.tileDevice( ij, ij ))
+                    && ! (skip_zero && device_regions_zero<mat_count, scalar_t>(
+                                           mats, i_step, j_step, ij, ij ))) {
 
                     // Add tiles to current group
                     // This logic matches that of above
@@ -361,6 +564,10 @@ std::vector< device_regions_params<store_diag, mat_count> > device_regions_build
 /// @tparam[in] diag_same
 ///     Whether to include the diagonal tiles in the off-diagonal groups
 ///     If false, store_diag must be true
+///
+/// @tparam[in] skip_zero
+///     Whether to skip tiles where an input matrix, mats[1:], has a
+///     structurally zero tile, e.g., for gemm updates.
 //------------------------------------------------------------------------------
 /// @param[in] mats
 ///     An array of the matrices to build regions for
@@ -375,24 +582,143 @@ std::vector< device_regions_params<store_diag, mat_count> > device_regions_build
 ///     Callback that is called whenever a tile is added to a group.
 ///     The group index and the tile indices are passed as arguments
 ///
+/// @param[in] tile_device
+///     If set, the device to compute each tile of mats[0] on,
+///     instead of its tileDevice, e.g., from device_steal_assign.
+///
 /// @return A list of batches with identical size.
 ///
-template< bool store_diag, int mat_count, typename scalar_t, bool diag_same=!store_diag >
+template< bool store_diag, int mat_count, typename scalar_t, bool diag_same=!store_diag,
+          bool skip_zero=false >
 std::vector< device_regions_params<store_diag, mat_count> > device_regions_build(
         std::array< std::reference_wrapper<BaseMatrix<scalar_t>>, mat_count > mats,
         std::array< scalar_t**, mat_count > mats_array_host,
         int64_t device,
-        std::function<void(int64_t, int64_t, int64_t)> extra_setup = {})
+        std::function<void(int64_t, int64_t, int64_t)> extra_setup = {},
+        std::function<int (int64_t, int64_t)> tile_device = {})
 {
     // Find ranges of matching mb's and ranges of matching nb's.
     auto irange = device_regions_range( RowCol::Row, mats[0].get() );
     auto jrange = device_regions_range( RowCol::Col, mats[0].get() );
 
-    return device_regions_build< store_diag, mat_count, scalar_t, diag_same >(
+    return device_regions_build< store_diag, mat_count, scalar_t, diag_same, skip_zero >(
                                  mats, mats_array_host, device, extra_setup,
-                                 irange, jrange );
+                                 irange, jrange, tile_device );
 }
 
+//------------------------------------------------------------------------------
+/// Width of the column panels that device_herk_diag splits diagonal tiles
+/// into; a multiple of 16, as device::batch::gemmt_diag requires.
+const int64_t herk_diag_nb = 64;
+
+//------------------------------------------------------------------------------
+/// Rank-k update of the uplo triangle of a batch of n-by-n diagonal tiles,
+/// \[
+///     C_b = \alpha op( A_b ) op( A_b )^{H or T} + \beta C_b,
+/// \]
+/// in a number of launches that doesn't depend on the batch size, where
+/// vendor batched herk and syrk on devices are one call per tile.
+/// Each tile is split into herk_diag_nb wide column panels. The part of
+/// each panel outside its diagonal block is updated by one vendor batched
+/// gemm over all tiles; the diagonal blocks of all panels and all tiles
+/// are then finished by one launch of device::batch::gemmt_diag.
+/// The other triangle of C_b is not referenced.
+/// Requires column-major tiles.
+///
+/// @param[in] uplo
+///     Physical triangle of C_b to update.
+///
+/// @param[in] opA
+///     op( A_b ): NoTrans, Trans, or ConjTrans.
+///
+/// @param[in] opB
+///     ConjTrans for herk, Trans for syrk, if opA = NoTrans;
+///     else NoTrans. B_b = A_b.
+///
+/// @param[in] a_array, c_array
+///     Host arrays of the group_count pointers to A_b and C_b on device.
+///
+/// @param[in] C
+///     Matrix whose batch arrays on device, at batch_arrays_index, hold
+///     at least batch_size >= group_count pointers in each of their
+///     A and C slots.
+///
+template <typename scalar_t>
+void device_herk_diag(
+    Uplo uplo, Op opA, Op opB, int64_t n, int64_t k,
+    scalar_t alpha, std::vector<scalar_t*> const& a_array, int64_t lda,
+    scalar_t beta,  std::vector<scalar_t*> const& c_array, int64_t ldc,
+    BaseMatrix<scalar_t>& C, int device, int64_t batch_arrays_index,
+    int64_t batch_size, blas::Queue& queue )
+{
+    int64_t group_count = a_array.size();
+    bool lower = uplo == Uplo::Lower;
+    const int64_t nb_panel = herk_diag_nb;
+
+    // Row r of op( X ), and column c of op( X ), stored with leading dim ld.
+    auto row = [](Op op, scalar_t* X, int64_t ld, int64_t r) {
+        return op == Op::NoTrans ? X + r : X + r*ld;
+    };
+    auto col = [](Op op, scalar_t* X, int64_t ld, int64_t c) {
+        return op == Op::NoTrans ? X + c*ld : X + c;
+    };
+
+    // Off-diagonal part of each panel, one batched gemm per panel.
+    int64_t nb_diag = roundup( n, int64_t( 16 ) );
+    if (n > nb_panel) {
+        nb_diag = nb_panel;
+
+        std::vector<Op> opA_( 1, opA ), opB_( 1, opB );
+        std::vector<int64_t> k_( 1, k ), ldda( 1, lda ), lddc( 1, ldc );
+        std::vector<scalar_t> alpha_( 1, alpha ), beta_( 1, beta );
+        std::vector<int64_t> info;
+        std::vector<scalar_t*> ap( group_count ), bp( group_count ),
+                               cp( group_count );
+
+        for (int64_t j0 = 0; j0 < n; j0 += nb_panel) {
+            int64_t jb = std::min( nb_panel, n - j0 );
+            // Lower: rows below the diagonal block; upper: rows above.
+            int64_t i0 = lower ? j0 + jb : 0;
+            int64_t ib = lower ? n - i0  : j0;
+            if (ib == 0)
+                continue;
+
+            for (int64_t t = 0; t < group_count; ++t) {
+                ap[ t ] = row( opA, a_array[ t ], lda, i0 );
+                bp[ t ] = col( opB, a_array[ t ], lda, j0 );
+                cp[ t ] = c_array[ t ] + i0 + j0*ldc;
+            }
+            std::vector<int64_t> m_( 1, ib ), n_( 1, jb );
+
+            internal::count( internal::Count::BatchLaunches );
+            internal::count( internal::Count::BatchTiles, group_count );
+            blas::batch::gemm(
+                Layout::ColMajor, opA_, opB_,
+                m_, n_, k_,
+                alpha_, ap, ldda,
+                        bp, ldda,
+                beta_,  cp, lddc,
+                group_count, info, queue );
+        }
+    }
+
+    // Triangles of all diagonal blocks, in one launch.
+    // Pointers go in the A and C slots of the batch arrays.
+    scalar_t** array_dev = C.array_device( device, batch_arrays_index );
+    C.batchArrayUpload( device, batch_arrays_index, a_array.data(),
+                        group_count, queue, 0 );
+    C.batchArrayUpload( device, batch_arrays_index, c_array.data(),
+                        group_count, queue, 2*batch_size );
+
+    internal::count( internal::Count::BatchLaunches );
+    internal::count( internal::Count::BatchTiles, group_count );
+    device::batch::gemmt_diag(
+        uplo, opA, opB, n, k, nb_diag,
+        alpha, array_dev, lda,
+               array_dev, lda,
+        beta,  array_dev + 2*batch_size, ldc,
+        group_count, queue );
+}
 
 } // namespace internal
 } // namespace slate
@@ -3,17 +3,409 @@
 // This program is free software: you can redistribute it and/or modify it under
 // the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
 
+#include "slate/Counters.hh"
 #include "slate/Exception.hh"
 #include "slate/internal/comm.hh"
 #include "internal/internal_util.hh"
 #include "slate/internal/Trace.hh"
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
 #include <cassert>
+#include <cstring>
+#include <list>
+#include <map>
+#include <mutex>
+#include <tuple>
+#include <unordered_map>
 #include <vector>
 
+#if defined( SLATE_HAVE_NCCL )
+    #include "blas.hh"
+    #if defined( BLAS_HAVE_CUBLAS )
+        #include <cuda_runtime.h>
+        #include <nccl.h>
+    #elif defined( BLAS_HAVE_ROCBLAS )
+        #include <hip/hip_runtime.h>
+        #include <rccl/rccl.h>
+    #endif
+#endif
+
 namespace slate {
 namespace internal {
 
+namespace {
+
+//------------------------------------------------------------------------------
+/// Hash of a sorted list of ranks.
+struct RanksHash {
+    size_t operator()(std::vector<int> const& ranks) const
+    {
+        size_t hash = ranks.size();
+        for (int rank : ranks)
+            hash ^= std::hash<int>()( rank ) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+        return hash;
+    }
+};
+
+//------------------------------------------------------------------------------
+/// [internal]
+/// LRU cache of communicators created by commFromSet, keyed by the set of
+/// ranks. One cache is attached, as an MPI attribute, to each parent
+/// communicator, so the cached communicators are freed when the parent
+/// communicator is freed.
+/// Also holds the node of each rank, for topology-aware patterns,
+/// and the NCCL/RCCL communicators, if enabled.
+/// All methods must be called inside critical(slate_comm_cache).
+///
+class CommCache {
+public:
+    struct Entry {
+        MPI_Comm comm;
+        MPI_Group group;
+        std::list< std::vector<int> >::iterator lru;
+    };
+
+    ~CommCache()
+    {
+        for (auto& iter : entries_) {
+            MPI_Comm_free( &iter.second.comm );
+            MPI_Group_free( &iter.second.group );
+        }
+        #if defined( SLATE_HAVE_NCCL )
+            for (auto& nccl_comm : nccl_comms)
+                ncclCommDestroy( nccl_comm );
+        #endif
+    }
+
+    /// @return cache entry for ranks, or nullptr if not cached.
+    /// Marks the entry as most recently used.
+    Entry* find(std::vector<int> const& ranks)
+    {
+        auto iter = entries_.find( ranks );
+        if (iter == entries_.end())
+            return nullptr;
+
+        lru_.splice( lru_.begin(), lru_, iter->second.lru );
+        return &iter->second;
+    }
+
+    /// Inserts the communicator and group for ranks as most recently used,
+    /// evicting the least recently used entry if over capacity.
+    void insert(std::vector<int> const& ranks, MPI_Comm comm, MPI_Group group)
+    {
+        lru_.push_front( ranks );
+        Entry& entry = entries_[ ranks ];
+        entry = { comm, group, lru_.begin() };
+
+        int64_t capacity = commCacheCapacity();
+        if (capacity > 0 && int64_t( entries_.size() ) > capacity) {
+            auto victim = entries_.find( lru_.back() );
+            MPI_Comm_free( &victim->second.comm );
+            MPI_Group_free( &victim->second.group );
+            entries_.erase( victim );
+            lru_.pop_back();
+        }
+    }
+
+    /// Node of each rank in the parent communicator, identified by
+    /// the lowest rank on the node; empty if not known.
+    std::vector<int> nodes;
+
+    #if defined( SLATE_HAVE_NCCL )
+        /// NCCL/RCCL communicator for each device, spanning all ranks.
+        std::vector<ncclComm_t> nccl_comms;
+    #endif
+
+private:
+    std::unordered_map< std::vector<int>, Entry, RanksHash > entries_;
+    std::list< std::vector<int> > lru_;
+};
+
+/// Attribute key of the CommCache on parent communicators.
+int comm_cache_keyval = MPI_KEYVAL_INVALID;
+
+//------------------------------------------------------------------------------
+/// Frees the CommCache attached to a communicator being freed.
+int commCacheDelete(MPI_Comm comm, int keyval, void* attr, void* extra)
+{
+    delete static_cast< CommCache* >( attr );
+    return MPI_SUCCESS;
+}
+
+//------------------------------------------------------------------------------
+/// Called when MPI_COMM_SELF is freed in MPI_Finalize. Frees the cache on
+/// MPI_COMM_WORLD, whose attributes MPI does not delete, and the key.
+int commCacheFinalize(MPI_Comm comm, int keyval, void* attr, void* extra)
+{
+    void* cache;
+    int flag;
+    MPI_Comm_get_attr( MPI_COMM_WORLD, comm_cache_keyval, &cache, &flag );
+    if (flag)
+        MPI_Comm_delete_attr( MPI_COMM_WORLD, comm_cache_keyval );
+    MPI_Comm_free_keyval( &comm_cache_keyval );
+    MPI_Comm_free_keyval( &keyval );
+    return MPI_SUCCESS;
+}
+
+//------------------------------------------------------------------------------
+/// @return the CommCache attached to mpi_comm, creating it if needed.
+/// Must be called inside critical(slate_comm_cache).
+///
+CommCache* getCommCache(MPI_Comm mpi_comm)
+{
+    MpiGuard mpi_guard;
+    if (comm_cache_keyval == MPI_KEYVAL_INVALID) {
+        slate_mpi_call(
+            MPI_Comm_create_keyval( MPI_COMM_NULL_COPY_FN, commCacheDelete,
+                                    &comm_cache_keyval, nullptr ));
+
+        int finalize_keyval;
+        slate_mpi_call(
+            MPI_Comm_create_keyval( MPI_COMM_NULL_COPY_FN, commCacheFinalize,
+                                    &finalize_keyval, nullptr ));
+        slate_mpi_call(
+            MPI_Comm_set_attr( MPI_COMM_SELF, finalize_keyval, nullptr ));
+    }
+
+    void* attr;
+    int flag;
+    slate_mpi_call(
+        MPI_Comm_get_attr( mpi_comm, comm_cache_keyval, &attr, &flag ));
+    if (! flag) {
+        attr = new CommCache;
+        slate_mpi_call(
+            MPI_Comm_set_attr( mpi_comm, comm_cache_keyval, attr ));
+    }
+    return static_cast< CommCache* >( attr );
+}
+
+} // anonymous namespace
+
+//------------------------------------------------------------------------------
+/// @return maximum number of communicators cached per parent communicator,
+/// or 0 for no limit. Initially $SLATE_COMM_CACHE_SIZE, if set, else 0.
+///
+/// Because MPI_Comm_create_group is collective over the ranks in the set,
+/// all of those ranks must agree whether the set is cached. Evicting entries
+/// is safe only if every rank sees the same sequence of sets, e.g., when
+/// each set spans the whole parent communicator's process column; hence by
+/// default nothing is evicted until the parent communicator is freed.
+///
+int64_t commCacheCapacity()
+{
+    return commCacheCapacity( -1 );
+}
+
+//------------------------------------------------------------------------------
+/// Sets the maximum number of communicators cached per parent communicator,
+/// or 0 for no limit. Overrides $SLATE_COMM_CACHE_SIZE.
+/// Negative values leave the current capacity unchanged.
+/// @return the (new) capacity.
+///
+int64_t commCacheCapacity(int64_t capacity)
+{
+    static std::atomic<int64_t> capacity_( [] {
+        const char* env = getenv( "SLATE_COMM_CACHE_SIZE" );
+        return env != nullptr ? std::max( int64_t( atol( env ) ), int64_t( 0 ) )
+                              : int64_t( 0 );
+    }() );
+    if (capacity >= 0)
+        capacity_ = capacity;
+    return capacity_;
+}
+
+namespace {
+
+/// 1 if MPI calls are serialized, 0 if not, -1 if not yet determined.
+std::atomic<int> mpi_serialized_( -1 );
+
+/// @return true if MPI provides MPI_THREAD_MULTIPLE.
+/// Assumes single threaded support before MPI is initialized.
+bool mpiThreadMultiple()
+{
+    int initialized = 0, provided = 0;
+    MPI_Initialized( &initialized );
+    if (initialized)
+        MPI_Query_thread( &provided );
+    return initialized && provided >= MPI_THREAD_MULTIPLE;
+}
+
+} // anonymous namespace
+
+//------------------------------------------------------------------------------
+/// @return true if MpiGuard serializes MPI calls, as the critical section
+/// around each MPI call used to. Initially true unless MPI provides
+/// MPI_THREAD_MULTIPLE, or if $SLATE_MPI_SERIALIZE is 1.
+///
+bool mpiSerialized()
+{
+    return mpiSerialized( -1 );
+}
+
+//------------------------------------------------------------------------------
+/// Sets whether MpiGuard serializes MPI calls. Calls can't be made
+/// concurrent unless MPI provides MPI_THREAD_MULTIPLE.
+/// Negative values leave the current setting unchanged.
+/// Change it only while no MPI calls are in flight.
+/// @return the (new) setting.
+///
+bool mpiSerialized(int serialize)
+{
+    int state = mpi_serialized_.load();
+    if (state < 0) {
+        const char* env = getenv( "SLATE_MPI_SERIALIZE" );
+        bool forced = env != nullptr && strcmp( env, "1" ) == 0;
+        state = forced || ! mpiThreadMultiple();
+        // Before MPI is initialized, don't cache the answer.
+        int initialized = 0;
+        MPI_Initialized( &initialized );
+        if (initialized)
+            mpi_serialized_.store( state );
+    }
+    if (serialize >= 0) {
+        state = serialize > 0 || ! mpiThreadMultiple();
+        mpi_serialized_.store( state );
+    }
+    return state;
+}
+
+//------------------------------------------------------------------------------
+/// @return mutex that MpiGuard locks when MPI calls are serialized.
+///
+std::mutex& mpiMutex()
+{
+    static std::mutex mutex;
+    return mutex;
+}
+
+namespace {
+
+/// Key of a cached vector type: count, blocklength, stride, base type.
+using VectorTypeKey = std::tuple< int, int, int, MPI_Datatype >;
+
+/// Maximum number of vector types kept in the cache.
+const size_t max_vector_types = 1024;
+
+/// Committed vector types, freed only when MPI is finalized.
+std::map< VectorTypeKey, MPI_Datatype > vector_types_;
+std::mutex vector_types_mutex_;
+
+} // anonymous namespace
+
+//------------------------------------------------------------------------------
+/// [internal]
+/// Returns a committed MPI vector type of count blocks of blocklength
+/// elements of base_type, stride elements apart, as used to send a strided
+/// tile. Tiles of an algorithm mostly share a few shapes, so the types are
+/// cached, sparing each message an MPI_Type_vector and MPI_Type_commit.
+///
+/// @param[out] cached
+///     On output, true if the type is owned by the cache; false if the cache
+///     is full and the caller must free the type with MPI_Type_free.
+///
+MPI_Datatype vectorType(
+    int count, int blocklength, int stride, MPI_Datatype base_type,
+    bool* cached)
+{
+    VectorTypeKey key( count, blocklength, stride, base_type );
+    std::lock_guard< std::mutex > guard( vector_types_mutex_ );
+
+    auto iter = vector_types_.find( key );
+    if (iter != vector_types_.end()) {
+        *cached = true;
+        return iter->second;
+    }
+
+    MPI_Datatype type;
+    slate_mpi_call(
+        MPI_Type_vector( count, blocklength, stride, base_type, &type ) );
+    slate_mpi_call(
+        MPI_Type_commit( &type ) );
+
+    *cached = vector_types_.size() < max_vector_types;
+    if (*cached)
+        vector_types_.emplace( key, type );
+    return type;
+}
+
+//------------------------------------------------------------------------------
+/// @return number of vector types currently cached by vectorType().
+///
+int64_t vectorTypeCacheSize()
+{
+    std::lock_guard< std::mutex > guard( vector_types_mutex_ );
+    return vector_types_.size();
+}
+
+namespace {
+
+/// 1 if strided tiles are packed for broadcasts, 0 if not,
+/// -1 if not yet determined.
+std::atomic<int> mpi_pack_tiles_( -1 );
+
+} // anonymous namespace
+
+//------------------------------------------------------------------------------
+/// @return true if Tile::bcast packs strided tiles into a contiguous buffer
+/// instead of sending them with an MPI vector type.
+/// Initially true if $SLATE_MPI_PACK is 1.
+///
+/// Some MPI implementations handle non-contiguous types in collectives
+/// much slower than an explicit copy. All ranks must use the same setting.
+///
+bool mpiPackTiles()
+{
+    return mpiPackTiles( -1 );
+}
+
+//------------------------------------------------------------------------------
+/// Sets whether Tile::bcast packs strided tiles. Overrides $SLATE_MPI_PACK.
+/// Negative values leave the current setting unchanged.
+/// @return the (new) setting.
+///
+bool mpiPackTiles(int pack)
+{
+    int state = mpi_pack_tiles_.load();
+    if (state < 0) {
+        const char* env = getenv( "SLATE_MPI_PACK" );
+        state = env != nullptr && strcmp( env, "1" ) == 0;
+        mpi_pack_tiles_.store( state );
+    }
+    if (pack >= 0) {
+        state = pack > 0;
+        mpi_pack_tiles_.store( state );
+    }
+    return state;
+}
+
+//------------------------------------------------------------------------------
+/// [internal]
+/// Returns a communicator over the ranks in bcast_set, taken from a cache
+/// attached to mpi_comm. On the first use of a set, the communicator is
+/// created collectively by all ranks in the set; afterwards only a hash
+/// lookup is needed. The returned communicator is owned by the cache and
+/// must not be freed by the caller; it is freed with mpi_comm.
+///
+/// @param[in] bcast_set
+///     Set of ranks, in mpi_comm, of the new communicator.
+///
+/// @param[in] mpi_comm
+///     Parent communicator.
+///
+/// @param[in] mpi_group
+///     Group of mpi_comm.
+///
+/// @param[in] in_rank
+///     Rank in mpi_comm to translate.
+///
+/// @param[out] out_rank
+///     in_rank translated to the returned communicator.
+///
+/// @param[in] tag
+///     Tag for MPI_Comm_create_group, used when the set is not cached.
+///
 MPI_Comm commFromSet(const std::set<int>& bcast_set,
                      MPI_Comm mpi_comm, MPI_Group mpi_group,
                      const int in_rank, int& out_rank, int tag)
@@ -21,32 +413,746 @@ MPI_Comm commFromSet(const std::set<int>& bcast_set,
     // Convert the set of ranks to a vector.
     std::vector<int> bcast_vec(bcast_set.begin(), bcast_set.end());
 
-    // Create the broadcast group.
+    // Look up the set in the cache.
+    MPI_Comm bcast_comm = MPI_COMM_NULL;
     MPI_Group bcast_group;
-    #pragma omp critical(slate_mpi)
-    slate_mpi_call(
-        MPI_Group_incl(mpi_group, bcast_vec.size(), bcast_vec.data(),
-                       &bcast_group));
+    CommCache* cache;
+    #pragma omp critical(slate_comm_cache)
+    {
+        cache = getCommCache( mpi_comm );
+        CommCache::Entry* entry = cache->find( bcast_vec );
+        if (entry != nullptr) {
+            bcast_comm  = entry->comm;
+            bcast_group = entry->group;
+            MpiGuard mpi_guard;
+            slate_mpi_call(
+                MPI_Group_translate_ranks(mpi_group, 1, &in_rank,
+                                          bcast_group, &out_rank));
+        }
+    }
+    if (bcast_comm != MPI_COMM_NULL)
+        return bcast_comm;
 
-    // Create a broadcast communicator.
-    MPI_Comm bcast_comm;
-    #pragma omp critical(slate_mpi)
+    // Create the broadcast group and communicator, and translate the
+    // input rank. Different tags let threads create communicators
+    // concurrently with MPI_THREAD_MULTIPLE.
     {
-        trace::Block trace_block("MPI_Comm_create_group");
+        MpiGuard mpi_guard;
         slate_mpi_call(
-            MPI_Comm_create_group(mpi_comm, bcast_group, tag, &bcast_comm));
+            MPI_Group_incl(mpi_group, bcast_vec.size(), bcast_vec.data(),
+                           &bcast_group));
+        {
+            trace::Block trace_block("MPI_Comm_create_group");
+            slate_mpi_call(
+                MPI_Comm_create_group(mpi_comm, bcast_group, tag, &bcast_comm));
+        }
+        assert(bcast_comm != MPI_COMM_NULL);
+
+        slate_mpi_call(
+            MPI_Group_translate_ranks(mpi_group, 1, &in_rank,
+                                      bcast_group, &out_rank));
     }
-    assert(bcast_comm != MPI_COMM_NULL);
 
-    // Translate the input rank.
-    #pragma omp critical(slate_mpi)
-    slate_mpi_call(
-        MPI_Group_translate_ranks(mpi_group, 1, &in_rank,
-                                  bcast_group, &out_rank));
+    // Add the communicator to the cache.
+    #pragma omp critical(slate_comm_cache)
+    cache->insert( bcast_vec, bcast_comm, bcast_group );
 
     return bcast_comm;
 }
 
+//------------------------------------------------------------------------------
+/// @return true if broadcast and reduce patterns use the node topology.
+/// Initially true unless $SLATE_TOPO_BCAST is 0. The value must be the same
+/// on all ranks.
+///
+bool topoBcastEnabled()
+{
+    static bool enabled = [] {
+        const char* env = getenv( "SLATE_TOPO_BCAST" );
+        return env == nullptr || strcmp( env, "0" ) != 0;
+    }();
+    return enabled;
+}
+
+//------------------------------------------------------------------------------
+/// [internal]
+/// Discovers which ranks of mpi_comm share a node, using
+/// MPI_Comm_split_type, and caches it with mpi_comm for bcastPattern.
+/// Collective over mpi_comm the first time it is called for mpi_comm,
+/// hence called by the matrix constructors; afterwards it is a lookup.
+///
+/// @param[in] mpi_comm
+///     Communicator.
+///
+void commInitNodes(MPI_Comm mpi_comm)
+{
+    if (! topoBcastEnabled())
+        return;
+
+    int mpi_size, mpi_rank;
+    slate_mpi_call(
+        MPI_Comm_size( mpi_comm, &mpi_size ));
+    if (mpi_size == 1)
+        return;
+
+    CommCache* cache;
+    bool known;
+    #pragma omp critical(slate_comm_cache)
+    {
+        cache = getCommCache( mpi_comm );
+        known = ! cache->nodes.empty();
+    }
+    if (known)
+        return;
+
+    trace::Block trace_block( "commInitNodes" );
+
+    slate_mpi_call(
+        MPI_Comm_rank( mpi_comm, &mpi_rank ));
+
+    // Identify each node by its lowest rank.
+    MPI_Comm node_comm;
+    int node;
+    std::vector<int> nodes( mpi_size );
+    {
+        MpiGuard mpi_guard;
+        slate_mpi_call(
+            MPI_Comm_split_type( mpi_comm, MPI_COMM_TYPE_SHARED, mpi_rank,
+                                 MPI_INFO_NULL, &node_comm ));
+        slate_mpi_call(
+            MPI_Allreduce( &mpi_rank, &node, 1, MPI_INT, MPI_MIN, node_comm ));
+        slate_mpi_call(
+            MPI_Comm_free( &node_comm ));
+        slate_mpi_call(
+            MPI_Allgather( &node, 1, MPI_INT, nodes.data(), 1, MPI_INT,
+                           mpi_comm ));
+    }
+
+    #pragma omp critical(slate_comm_cache)
+    cache->nodes = std::move( nodes );
+}
+
+//------------------------------------------------------------------------------
+/// [internal]
+/// Implements a two-level broadcast pattern: a hypercube among one leader
+/// rank per node, then a hypercube within each node. For a given rank, finds
+/// the rank to receive from and the list of ranks to forward to. Assumes
+/// rank 0 as the root of the broadcast, which leads its node. On other
+/// nodes, the leader is the node's first rank. Ranks forward to other
+/// nodes before forwarding within their node, so the slower inter-node
+/// hops start first.
+///
+/// @param[in] nodes
+///     Node of each rank participating in the broadcast.
+///
+/// @param[in] rank
+///     Rank of the local process.
+///
+/// @param[in] radix
+///     Dimension of the cube among nodes. Within nodes, where messages
+///     are cheaper, the dimension is at least 8.
+///
+/// @param[out] recv_from
+///     List containing the rank to receive from.
+///     Empty list for rank 0.
+///
+/// @param[out] send_to
+///     List of ranks to forward to.
+///
+void topoBcastPattern(std::vector<int> const& nodes, int rank, int radix,
+                      std::list<int>& recv_from, std::list<int>& send_to)
+{
+    // Group ranks by node, in order of first appearance, so each node's
+    // first rank is its leader and the root's node comes first.
+    std::vector<int> leaders;
+    std::map< int, std::vector<int> > members;
+    for (int r = 0; r < int( nodes.size() ); ++r) {
+        auto& node_members = members[ nodes[ r ] ];
+        if (node_members.empty())
+            leaders.push_back( r );
+        node_members.push_back( r );
+    }
+    auto& node_members = members[ nodes[ rank ] ];
+    int local_rank = std::distance(
+        node_members.begin(),
+        std::find( node_members.begin(), node_members.end(), rank ) );
+
+    // Among nodes.
+    if (local_rank == 0) {
+        int leader_rank = std::distance(
+            leaders.begin(), std::find( leaders.begin(), leaders.end(), rank ) );
+        std::list<int> inter_recv, inter_send;
+        cubeBcastPattern( leaders.size(), leader_rank, radix,
+                          inter_recv, inter_send );
+        for (int r : inter_recv)
+            recv_from.push_back( leaders[ r ] );
+        for (int r : inter_send)
+            send_to.push_back( leaders[ r ] );
+    }
+
+    // Within the node.
+    std::list<int> intra_recv, intra_send;
+    cubeBcastPattern( node_members.size(), local_rank, std::max( radix, 8 ),
+                      intra_recv, intra_send );
+    for (int r : intra_recv)
+        recv_from.push_back( node_members[ r ] );
+    for (int r : intra_send)
+        send_to.push_back( node_members[ r ] );
+}
+
+//------------------------------------------------------------------------------
+/// [internal]
+/// Finds the broadcast pattern for ranks in mpi_comm, using topoBcastPattern
+/// if the ranks span several nodes and some node has several ranks,
+/// otherwise cubeBcastPattern.
+///
+/// @param[in] mpi_comm
+///     Communicator; commInitNodes must have been called for it.
+///
+/// @param[in] ranks
+///     Ranks in mpi_comm participating in the broadcast, with the root first.
+///
+/// @param[in] rank
+///     Index of the local process in ranks.
+///
+/// @param[in] radix
+///     Dimension of the cube.
+///
+/// @param[out] recv_from
+///     List containing the index in ranks to receive from.
+///
+/// @param[out] send_to
+///     List of indices in ranks to forward to.
+///
+/// @return true if the two-level pattern was chosen.
+///
+bool bcastPattern(MPI_Comm mpi_comm, std::vector<int> const& ranks,
+                  int rank, int radix,
+                  std::list<int>& recv_from, std::list<int>& send_to)
+{
+    std::vector<int> const* comm_nodes = nullptr;
+    if (topoBcastEnabled() && ranks.size() > 2) {
+        #pragma omp critical(slate_comm_cache)
+        {
+            CommCache* cache = getCommCache( mpi_comm );
+            if (! cache->nodes.empty())
+                comm_nodes = &cache->nodes;
+        }
+    }
+
+    if (comm_nodes != nullptr) {
+        std::vector<int> nodes( ranks.size() );
+        for (size_t r = 0; r < ranks.size(); ++r)
+            nodes[ r ] = (*comm_nodes)[ ranks[ r ] ];
+
+        std::set<int> node_set( nodes.begin(), nodes.end() );
+        if (node_set.size() > 1 && node_set.size() < ranks.size()) {
+            topoBcastPattern( nodes, rank, radix, recv_from, send_to );
+            return true;
+        }
+    }
+
+    cubeBcastPattern( ranks.size(), rank, radix, recv_from, send_to );
+    return false;
+}
+
+//------------------------------------------------------------------------------
+/// [internal]
+/// Finds the reduce pattern for ranks in mpi_comm; the reverse of
+/// bcastPattern.
+/// @see bcastPattern
+///
+bool reducePattern(MPI_Comm mpi_comm, std::vector<int> const& ranks,
+                   int rank, int radix,
+                   std::list<int>& recv_from, std::list<int>& send_to)
+{
+    return bcastPattern( mpi_comm, ranks, rank, radix, send_to, recv_from );
+}
+
+//------------------------------------------------------------------------------
+/// @return true if broadcasts of device tiles use NCCL (CUDA) or RCCL (ROCm).
+/// Requires building with NCCL/RCCL (SLATE_HAVE_NCCL), and
+/// $SLATE_NCCL set to 1. The value must be the same on all ranks.
+///
+/// NCCL matches point-to-point messages by order, not by tag, so it is
+/// enabled only on request: all ranks must issue broadcasts of device
+/// tiles in the same order, as the drivers using listBcast do.
+///
+bool ncclEnabled()
+{
+    #if defined( SLATE_HAVE_NCCL )
+        static bool enabled = [] {
+            const char* env = getenv( "SLATE_NCCL" );
+            return env != nullptr && strcmp( env, "1" ) == 0;
+        }();
+        return enabled;
+    #else
+        return false;
+    #endif
+}
+
+#if defined( SLATE_HAVE_NCCL )
+
+namespace {
+
+//------------------------------------------------------------------------------
+/// Throws an Exception if the NCCL call fails.
+#define slate_nccl_call( call ) \
+    do { \
+        ncclResult_t slate_nccl_call_ = call; \
+        if (slate_nccl_call_ != ncclSuccess) \
+            throw slate::Exception( \
+                std::string( "SLATE NCCL ERROR: " ) + #call + " failed: " \
+                + ncclGetErrorString( slate_nccl_call_ ), \
+                __func__, __FILE__, __LINE__ ); \
+    } while (0)
+
+//------------------------------------------------------------------------------
+/// Sets the current device, for NCCL calls.
+void setDevice(int device)
+{
+    #if defined( BLAS_HAVE_CUBLAS )
+        cudaSetDevice( device );
+    #elif defined( BLAS_HAVE_ROCBLAS )
+        hipSetDevice( device );
+    #endif
+}
+
+//------------------------------------------------------------------------------
+/// @return NCCL communicator of mpi_comm for device.
+ncclComm_t getNcclComm(MPI_Comm mpi_comm, int device)
+{
+    ncclComm_t nccl_comm = nullptr;
+    #pragma omp critical(slate_comm_cache)
+    {
+        CommCache* cache = getCommCache( mpi_comm );
+        if (device < int( cache->nccl_comms.size() ))
+            nccl_comm = cache->nccl_comms[ device ];
+    }
+    slate_assert( nccl_comm != nullptr );
+    return nccl_comm;
+}
+
+} // anonymous namespace
+
+#endif // SLATE_HAVE_NCCL
+
+//------------------------------------------------------------------------------
+/// [internal]
+/// Creates an NCCL/RCCL communicator for each device, spanning the ranks of
+/// mpi_comm, and caches them with mpi_comm for ncclSend and ncclRecv.
+/// Collective over mpi_comm the first time it is called for mpi_comm,
+/// hence called by the matrix constructors; afterwards it is a lookup.
+/// Does nothing unless ncclEnabled().
+/// All ranks must have the same number of devices.
+///
+/// @param[in] mpi_comm
+///     Communicator.
+///
+/// @param[in] num_devices
+///     Number of devices per rank.
+///
+void commInitNccl(MPI_Comm mpi_comm, int num_devices)
+{
+    #if defined( SLATE_HAVE_NCCL )
+        if (! ncclEnabled() || num_devices == 0)
+            return;
+
+        int mpi_size, mpi_rank;
+        slate_mpi_call(
+            MPI_Comm_size( mpi_comm, &mpi_size ));
+        if (mpi_size == 1)
+            return;
+
+        CommCache* cache;
+        bool known;
+        #pragma omp critical(slate_comm_cache)
+        {
+            cache = getCommCache( mpi_comm );
+            known = ! cache->nccl_comms.empty();
+        }
+        if (known)
+            return;
+
+        trace::Block trace_block( "commInitNccl" );
+
+        slate_mpi_call(
+            MPI_Comm_rank( mpi_comm, &mpi_rank ));
+
+        std::vector<ncclComm_t> nccl_comms( num_devices );
+        for (int device = 0; device < num_devices; ++device) {
+            ncclUniqueId id;
+            if (mpi_rank == 0)
+                slate_nccl_call( ncclGetUniqueId( &id ) );
+            {
+                MpiGuard mpi_guard;
+                slate_mpi_call(
+                    MPI_Bcast( &id, sizeof( id ), MPI_BYTE, 0, mpi_comm ));
+            }
+
+            setDevice( device );
+            slate_nccl_call(
+                ncclCommInitRank( &nccl_comms[ device ], mpi_size, id,
+                                  mpi_rank ));
+        }
+
+        #pragma omp critical(slate_comm_cache)
+        cache->nccl_comms = std::move( nccl_comms );
+    #endif
+}
+
+//------------------------------------------------------------------------------
+/// [internal]
+/// Queues sending bytes of device memory to rank dst of mpi_comm on queue,
+/// using NCCL/RCCL, so the transfer is ordered with other work on queue,
+/// without synchronizing with the host.
+/// commInitNccl must have been called for mpi_comm.
+///
+/// @param[in] data
+///     Device memory to send, on queue's device.
+///
+/// @param[in] bytes
+///     Number of bytes to send.
+///
+/// @param[in] dst
+///     Destination rank in mpi_comm.
+///
+/// @param[in] mpi_comm
+///     Communicator.
+///
+/// @param[in] queue
+///     Queue on which to order the transfer.
+///
+void ncclSend(void const* data, size_t bytes, int dst, MPI_Comm mpi_comm,
+              blas::Queue& queue)
+{
+    #if defined( SLATE_HAVE_NCCL )
+        trace::Block trace_block( "ncclSend" );
+        internal::count_message( dst, bytes );
+
+        ncclComm_t nccl_comm = getNcclComm( mpi_comm, queue.device() );
+        #pragma omp critical(slate_nccl)
+        {
+            setDevice( queue.device() );
+            slate_nccl_call(
+                ::ncclSend( data, bytes, ncclChar, dst, nccl_comm,
+                            queue.stream() ));
+        }
+    #else
+        slate_not_implemented( "SLATE was not built with NCCL/RCCL" );
+    #endif
+}
+
+//------------------------------------------------------------------------------
+/// [internal]
+/// Queues receiving bytes of device memory from rank src of mpi_comm on
+/// queue, using NCCL/RCCL.
+/// @see ncclSend
+///
+/// @param[out] data
+///     Device memory to receive into, on queue's device.
+///
+/// @param[in] bytes
+///     Number of bytes to receive.
+///
+/// @param[in] src
+///     Source rank in mpi_comm.
+///
+/// @param[in] mpi_comm
+///     Communicator.
+///
+/// @param[in] queue
+///     Queue on which to order the transfer.
+///
+void ncclRecv(void* data, size_t bytes, int src, MPI_Comm mpi_comm,
+              blas::Queue& queue)
+{
+    #if defined( SLATE_HAVE_NCCL )
+        trace::Block trace_block( "ncclRecv" );
+        internal::count( internal::Count::BytesRecv, bytes );
+
+        ncclComm_t nccl_comm = getNcclComm( mpi_comm, queue.device() );
+        #pragma omp critical(slate_nccl)
+        {
+            setDevice( queue.device() );
+            slate_nccl_call(
+                ::ncclRecv( data, bytes, ncclChar, src, nccl_comm,
+                            queue.stream() ));
+        }
+    #else
+        slate_not_implemented( "SLATE was not built with NCCL/RCCL" );
+    #endif
+}
+
+namespace {
+
+/// Bytes of tile data staged through host memory; see hostStagedBytes.
+std::atomic<int64_t> host_staged_bytes_( 0 );
+
+} // anonymous namespace
+
+//------------------------------------------------------------------------------
+/// [internal]
+/// Statistic of tile communication that went through host memory although
+/// the tile's data was on, or was needed on, a device: a device tile copied
+/// to host to be sent, or a tile received on host for a Devices target.
+/// With GPU-aware MPI this should stay 0 for Devices targets.
+/// Counts all threads on this MPI rank; reset it before a call to get that
+/// call's count.
+///
+/// @return bytes staged through host memory since the last reset.
+///
+int64_t hostStagedBytes()
+{
+    return host_staged_bytes_;
+}
+
+//------------------------------------------------------------------------------
+/// [internal]
+/// Resets the hostStagedBytes statistic to 0.
+///
+void resetHostStagedBytes()
+{
+    host_staged_bytes_ = 0;
+}
+
+//------------------------------------------------------------------------------
+/// [internal]
+/// Adds bytes to the hostStagedBytes statistic.
+///
+/// @param[in] bytes
+///     Bytes of tile data staged through host memory.
+///
+void addHostStagedBytes(int64_t bytes)
+{
+    host_staged_bytes_ += bytes;
+}
+
+//------------------------------------------------------------------------------
+/// [internal]
+/// Chooses the segment size for pipelining the broadcast of a tile.
+/// Small tiles are sent whole, since each segment adds a message latency.
+/// Tiles of at least 4 MiB (e.g., nb >= 1024 in single precision) are split
+/// into 1 MiB segments, so intermediate ranks forward one segment while
+/// receiving the next one.
+///
+/// @param[in] tile_bytes
+///     Size of the tile in bytes.
+///
+/// @return segment size in bytes, or 0 to send the whole tile.
+///
+int64_t bcastSegmentBytes(int64_t tile_bytes)
+{
+    const int64_t min_tile_bytes = 4*1024*1024;
+    const int64_t segment_bytes  = 1024*1024;
+
+    return tile_bytes >= min_tile_bytes ? segment_bytes : 0;
+}
+
+namespace {
+
+//------------------------------------------------------------------------------
+/// Rounds float to bfloat16, to nearest even; NaN stays NaN.
+inline uint16_t float_to_bf16( float x )
+{
+    uint32_t u;
+    std::memcpy( &u, &x, sizeof(u) );
+    if ((u & 0x7fffffff) > 0x7f800000)
+        return uint16_t( (u >> 16) | 0x0040 );  // quiet NaN
+    u += 0x7fff + ((u >> 16) & 1);
+    return uint16_t( u >> 16 );
+}
+
+//------------------------------------------------------------------------------
+inline float bf16_to_float( uint16_t h )
+{
+    uint32_t u = uint32_t( h ) << 16;
+    float x;
+    std::memcpy( &x, &u, sizeof(x) );
+    return x;
+}
+
+//------------------------------------------------------------------------------
+/// Rounds float to IEEE half (FP16), to nearest even; NaN stays NaN.
+/// Values of magnitude >= 65520 overflow to Inf; small values round to
+/// half subnormals or zero.
+inline uint16_t float_to_half( float x )
+{
+    uint32_t u;
+    std::memcpy( &u, &x, sizeof(u) );
+    uint16_t sign = uint16_t( (u >> 16) & 0x8000 );
+    uint32_t a = u & 0x7fffffff;
+    if (a > 0x7f800000)
+        return sign | 0x7e00;  // quiet NaN
+    if (a >= 0x477ff000)
+        return sign | 0x7c00;  // Inf
+    if (a < 0x38800000) {
+        // Subnormal half, |x| < 2^-14: round |x| 2^24 to an integer.
+        if (a < 0x33000000)
+            return sign;
+        uint32_t mant  = (a & 0x007fffff) | 0x00800000;
+        int      shift = 126 - int( a >> 23 );
+        uint32_t h     = mant >> shift;
+        uint32_t rem   = mant & ((uint32_t( 1 ) << shift) - 1);
+        uint32_t tie   = uint32_t( 1 ) << (shift - 1);
+        if (rem > tie || (rem == tie && (h & 1)))
+            ++h;
+        return sign | uint16_t( h );
+    }
+    // Normal: rebias exponent from 127 to 15, round 23 to 10 fraction bits.
+    a -= uint32_t( 112 ) << 23;
+    a += 0x0fff + ((a >> 13) & 1);
+    return sign | uint16_t( a >> 13 );
+}
+
+//------------------------------------------------------------------------------
+inline float half_to_float( uint16_t h )
+{
+    uint32_t sign = uint32_t( h & 0x8000 ) << 16;
+    uint32_t expo = (h >> 10) & 0x1f;
+    uint32_t mant = h & 0x03ff;
+    if (expo == 0) {
+        float x = std::ldexp( float( mant ), -24 );
+        return sign ? -x : x;
+    }
+    uint32_t u = sign | (mant << 13)
+               | (expo == 31 ? 0x7f800000 : (expo + 112) << 23);
+    float x;
+    std::memcpy( &x, &u, sizeof(x) );
+    return x;
+}
+
+//------------------------------------------------------------------------------
+template <typename real_t>
+void wirePack_(
+    BcastPrecision precision, int64_t m, int64_t n,
+    real_t const* A, int64_t lda, void* buffer )
+{
+    if (wireBytes( precision, sizeof(real_t) ) == sizeof(real_t)) {
+        real_t* B = static_cast<real_t*>( buffer );
+        for (int64_t j = 0; j < n; ++j)
+            std::copy( &A[ j*lda ], &A[ j*lda + m ], &B[ j*m ] );
+    }
+    else if (precision == BcastPrecision::Single) {
+        float* B = static_cast<float*>( buffer );
+        for (int64_t j = 0; j < n; ++j)
+            for (int64_t i = 0; i < m; ++i)
+                B[ i + j*m ] = float( A[ i + j*lda ] );
+    }
+    else if (precision == BcastPrecision::Half) {
+        uint16_t* B = static_cast<uint16_t*>( buffer );
+        for (int64_t j = 0; j < n; ++j)
+            for (int64_t i = 0; i < m; ++i)
+                B[ i + j*m ] = float_to_half( float( A[ i + j*lda ] ) );
+    }
+    else {
+        uint16_t* B = static_cast<uint16_t*>( buffer );
+        for (int64_t j = 0; j < n; ++j)
+            for (int64_t i = 0; i < m; ++i)
+                B[ i + j*m ] = float_to_bf16( float( A[ i + j*lda ] ) );
+    }
+}
+
+//------------------------------------------------------------------------------
+template <typename real_t>
+void wireUnpack_(
+    BcastPrecision precision, int64_t m, int64_t n,
+    void const* buffer, real_t* A, int64_t lda )
+{
+    if (wireBytes( precision, sizeof(real_t) ) == sizeof(real_t)) {
+        real_t const* B = static_cast<real_t const*>( buffer );
+        for (int64_t j = 0; j < n; ++j)
+            std::copy( &B[ j*m ], &B[ j*m + m ], &A[ j*lda ] );
+    }
+    else if (precision == BcastPrecision::Single) {
+        float const* B = static_cast<float const*>( buffer );
+        for (int64_t j = 0; j < n; ++j)
+            for (int64_t i = 0; i < m; ++i)
+                A[ i + j*lda ] = real_t( B[ i + j*m ] );
+    }
+    else if (precision == BcastPrecision::Half) {
+        uint16_t const* B = static_cast<uint16_t const*>( buffer );
+        for (int64_t j = 0; j < n; ++j)
+            for (int64_t i = 0; i < m; ++i)
+                A[ i + j*lda ] = real_t( half_to_float( B[ i + j*m ] ) );
+    }
+    else {
+        uint16_t const* B = static_cast<uint16_t const*>( buffer );
+        for (int64_t j = 0; j < n; ++j)
+            for (int64_t i = 0; i < m; ++i)
+                A[ i + j*lda ] = real_t( bf16_to_float( B[ i + j*m ] ) );
+    }
+}
+
+} // anonymous namespace
+
+//------------------------------------------------------------------------------
+/// [internal]
+/// Size on the wire of one real number in a broadcast.
+///
+/// @param[in] precision
+///     Wire precision.
+///
+/// @param[in] real_bytes
+///     Size of the real type of the matrix, sizeof( real_type<scalar_t> ).
+///
+/// @return bytes per real: real_bytes for Native, or when the wire
+///     precision is not lower than the matrix precision.
+///
+size_t wireBytes(BcastPrecision precision, size_t real_bytes)
+{
+    switch (precision) {
+        case BcastPrecision::Single:   return std::min( real_bytes, size_t( 4 ) );
+        case BcastPrecision::BFloat16: return std::min( real_bytes, size_t( 2 ) );
+        case BcastPrecision::Half:     return std::min( real_bytes, size_t( 2 ) );
+        default:                       return real_bytes;
+    }
+}
+
+//------------------------------------------------------------------------------
+/// [internal]
+/// Converts the m-by-n real matrix A to the wire precision, packed
+/// in buffer with leading dimension m. Complex matrices are passed as real
+/// matrices with twice as many rows.
+///
+/// @param[in] precision
+///     Wire precision.
+///
+/// @param[in] A
+///     m-by-n matrix, with leading dimension lda.
+///
+/// @param[out] buffer
+///     Buffer of m*n*wireBytes( precision, sizeof(*A) ) bytes.
+///
+void wirePack(BcastPrecision precision, int64_t m, int64_t n,
+              float const* A, int64_t lda, void* buffer)
+{
+    wirePack_( precision, m, n, A, lda, buffer );
+}
+
+void wirePack(BcastPrecision precision, int64_t m, int64_t n,
+              double const* A, int64_t lda, void* buffer)
+{
+    wirePack_( precision, m, n, A, lda, buffer );
+}
+
+//------------------------------------------------------------------------------
+/// [internal]
+/// Converts the packed buffer from the wire precision into the m-by-n
+/// real matrix A; inverse of wirePack.
+///
+void wireUnpack(BcastPrecision precision, int64_t m, int64_t n,
+                void const* buffer, float* A, int64_t lda)
+{
+    wireUnpack_( precision, m, n, buffer, A, lda );
+}
+
+void wireUnpack(BcastPrecision precision, int64_t m, int64_t n,
+                void const* buffer, double* A, int64_t lda)
+{
+    wireUnpack_( precision, m, n, buffer, A, lda );
+}
+
 //------------------------------------------------------------------------------
 /// [internal]
 /// Implements a hypercube broadcast pattern. For a given rank, finds the rank
@@ -8,8 +8,13 @@
 #define SLATE_COPY_COL_HH
 
 #include "slate/Matrix.hh"
+#include "slate/internal/device.hh"
 
+#include <map>
 #include <numeric>
+#include <set>
+#include <utility>
+#include <vector>
 
 namespace slate {
 namespace internal {
@@ -134,6 +139,316 @@ void copy_col(
     }
 }
 
+//------------------------------------------------------------------------------
+/// Segment of a column, the local rows of one tile, for copy_segments.
+template <typename real_t>
+struct ColSegment {
+    real_t const* x;  ///< source, in device memory
+    real_t* y;        ///< destination, in device memory
+    int64_t m;        ///< length
+    int device;       ///< device of x and y
+};
+
+//------------------------------------------------------------------------------
+/// Batched device copy of column segments, y_k = x_k, with one batched
+/// device::gecopy per device and segment length, n = 1, as a gather or
+/// scatter of columns. Waits for the copies to finish.
+///
+/// @param[in] A
+///     Matrix whose compute queues to use.
+///
+/// @param[in] segs
+///     The segments to copy.
+///
+template <typename real_t>
+void copy_segments(
+    Matrix<real_t>& A, std::vector< ColSegment<real_t> > const& segs )
+{
+    for (int device = 0; device < A.num_devices(); ++device) {
+        // Group by length, as device::gecopy takes one m.
+        std::map< int64_t, std::vector< ColSegment<real_t> > > groups;
+        for (auto const& seg : segs) {
+            if (seg.device == device)
+                groups[ seg.m ].push_back( seg );
+        }
+        if (groups.empty())
+            continue;
+
+        int64_t batch_count = 0;
+        for (auto const& group : groups)
+            batch_count += group.second.size();
+
+        // x and y pointer arrays, for all groups.
+        std::vector<real_t*> array( 2*batch_count );
+        int64_t k = 0;
+        for (auto const& group : groups) {
+            for (auto const& seg : group.second) {
+                array[ k ] = const_cast<real_t*>( seg.x );
+                array[ batch_count + k ] = seg.y;
+                ++k;
+            }
+        }
+
+        blas::Queue* queue = A.compute_queue( device );
+        real_t** darray = blas::device_malloc<real_t*>( 2*batch_count, *queue );
+        blas::device_memcpy<real_t*>( darray, array.data(), 2*batch_count,
+                                      *queue );
+        k = 0;
+        for (auto const& group : groups) {
+            int64_t m = group.first;
+            int64_t cnt = group.second.size();
+            device::gecopy( m, 1,
+                            (real_t const* const*) &darray[ k ], m,
+                            &darray[ batch_count + k ], m,
+                            cnt, *queue );
+            k += cnt;
+        }
+        queue->sync();
+        blas::device_free( darray, *queue );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Copy local rows of columns of A to columns of B, for each pair
+/// ( jg, kg ) in cols, B.at( :, kg ) = A.at( :, jg ), where jg and kg are
+/// global column indices. A and B must have the same distribution, number
+/// of rows, and tile mb, and a fixed tile nb.
+///
+/// If on_devices, the tiles are copied on the device of B's tile,
+/// with batched gathers, leaving A and B there;
+/// otherwise, on the host, as copy_col.
+///
+template <typename real_t>
+void copy_cols(
+    Matrix<real_t>& A, Matrix<real_t>& B,
+    std::vector< std::pair<int64_t, int64_t> > const& cols,
+    bool on_devices )
+{
+    int64_t nb = A.tileNb( 0 );
+
+    if (! on_devices) {
+        for (auto const& col : cols) {
+            copy_col( A, col.first / nb, col.first % nb,
+                      B, col.second / nb, col.second % nb );
+        }
+        return;
+    }
+
+    int64_t mt = A.mt();
+    int num_devices = A.num_devices();
+    using ij_tuple = typename Matrix<real_t>::ij_tuple;
+
+    // Get the tiles once per device, then gather.
+    std::vector< std::set<ij_tuple> > A_tiles( num_devices ),
+                                      B_tiles( num_devices );
+    for (auto const& col : cols) {
+        int64_t j = col.first / nb;
+        int64_t k = col.second / nb;
+        for (int64_t i = 0; i < mt; ++i) {
+            if (A.tileIsLocal( i, j )) {
+                int device = B.tileDevice( i, k );
+                A_tiles[ device ].insert( { i, j } );
+                B_tiles[ device ].insert( { i, k } );
+            }
+        }
+    }
+    for (int device = 0; device < num_devices; ++device) {
+        A.tileGetForReading( A_tiles[ device ], device, LayoutConvert::ColMajor );
+        B.tileGetForWriting( B_tiles[ device ], device, LayoutConvert::ColMajor );
+    }
+
+    std::vector< ColSegment<real_t> > segs;
+    for (auto const& col : cols) {
+        int64_t j  = col.first  / nb;
+        int64_t jj = col.first  % nb;
+        int64_t k  = col.second / nb;
+        int64_t kk = col.second % nb;
+        for (int64_t i = 0; i < mt; ++i) {
+            if (A.tileIsLocal( i, j )) {
+                int device = B.tileDevice( i, k );
+                auto Aij = A( i, j, device );
+                auto Bik = B( i, k, device );
+                assert( Aij.mb() == Bik.mb() );
+                segs.push_back( { Aij.data() + jj*Aij.stride(),
+                                  Bik.data() + kk*Bik.stride(),
+                                  Aij.mb(), device } );
+            }
+        }
+    }
+    copy_segments( A, segs );
+}
+
+//------------------------------------------------------------------------------
+/// Copy local rows of columns of A to the host vector x, packed one after
+/// another: the local rows of A.at( :, cols[ c ] ) go to
+/// x[ c*mlocal : (c+1)*mlocal - 1 ], where mlocal is the local number of
+/// rows of A, and cols[ c ] are global column indices. A must have a
+/// fixed tile nb.
+///
+/// If on_devices, the columns are gathered on the devices of A's tiles,
+/// then copied to the host in runs of consecutive entries on the same
+/// device, e.g., one copy with one device per rank;
+/// otherwise, on the host, as copy_col.
+///
+template <typename real_t>
+void copy_cols(
+    Matrix<real_t>& A, std::vector<int64_t> const& cols, int64_t mlocal,
+    real_t* x, bool on_devices )
+{
+    int64_t nb = A.tileNb( 0 );
+    int64_t ncols = cols.size();
+
+    if (! on_devices) {
+        for (int64_t c = 0; c < ncols; ++c)
+            copy_col( A, cols[ c ] / nb, cols[ c ] % nb, &x[ c*mlocal ] );
+        return;
+    }
+
+    int64_t mt = A.mt();
+    int num_devices = A.num_devices();
+    using ij_tuple = typename Matrix<real_t>::ij_tuple;
+    std::vector< std::set<ij_tuple> > A_tiles( num_devices );
+    for (int64_t c = 0; c < ncols; ++c) {
+        int64_t j = cols[ c ] / nb;
+        for (int64_t i = 0; i < mt; ++i) {
+            if (A.tileIsLocal( i, j ))
+                A_tiles[ A.tileDevice( i, j ) ].insert( { i, j } );
+        }
+    }
+
+    // Device buffers, each the size of x, at the same offsets.
+    std::vector<real_t*> dx( num_devices, nullptr );
+    for (int device = 0; device < num_devices; ++device) {
+        if (A_tiles[ device ].empty())
+            continue;
+        A.tileGetForReading( A_tiles[ device ], device, LayoutConvert::ColMajor );
+        dx[ device ] = blas::device_malloc<real_t>(
+            ncols*mlocal, *A.compute_queue( device ) );
+    }
+
+    // Segments in the order of x, and their runs by device.
+    std::vector< ColSegment<real_t> > segs;
+    std::vector< std::pair<int64_t, int> > runs;  // ( end offset, device )
+    int64_t offset = 0;
+    for (int64_t c = 0; c < ncols; ++c) {
+        int64_t j  = cols[ c ] / nb;
+        int64_t jj = cols[ c ] % nb;
+        for (int64_t i = 0; i < mt; ++i) {
+            if (A.tileIsLocal( i, j )) {
+                int device = A.tileDevice( i, j );
+                auto Aij = A( i, j, device );
+                segs.push_back( { Aij.data() + jj*Aij.stride(),
+                                  &dx[ device ][ offset ],
+                                  Aij.mb(), device } );
+                offset += Aij.mb();
+                if (! runs.empty() && runs.back().second == device)
+                    runs.back().first = offset;
+                else
+                    runs.push_back( { offset, device } );
+            }
+        }
+    }
+    copy_segments( A, segs );
+
+    int64_t begin = 0;
+    for (auto const& run : runs) {
+        blas::Queue* queue = A.compute_queue( run.second );
+        blas::device_memcpy<real_t>( &x[ begin ], &dx[ run.second ][ begin ],
+                                     run.first - begin, *queue );
+        begin = run.first;
+    }
+    for (int device = 0; device < num_devices; ++device) {
+        if (dx[ device ] != nullptr) {
+            blas::Queue* queue = A.compute_queue( device );
+            queue->sync();
+            blas::device_free( dx[ device ], *queue );
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Copy the host vector x, packed as in copy_cols( A, cols, mlocal, x ),
+/// to local rows of columns of B: the local rows of B.at( :, cols[ c ] )
+/// are x[ c*mlocal : (c+1)*mlocal - 1 ]. B must have a fixed tile nb.
+///
+/// If on_devices, runs of x for the same device are copied to the device,
+/// then scattered to the devices of B's tiles;
+/// otherwise, on the host, as copy_col.
+///
+template <typename real_t>
+void copy_cols(
+    real_t* x, int64_t mlocal,
+    Matrix<real_t>& B, std::vector<int64_t> const& cols, bool on_devices )
+{
+    int64_t nb = B.tileNb( 0 );
+    int64_t ncols = cols.size();
+
+    if (! on_devices) {
+        for (int64_t c = 0; c < ncols; ++c)
+            copy_col( &x[ c*mlocal ], B, cols[ c ] / nb, cols[ c ] % nb );
+        return;
+    }
+
+    int64_t mt = B.mt();
+    int num_devices = B.num_devices();
+    using ij_tuple = typename Matrix<real_t>::ij_tuple;
+    std::vector< std::set<ij_tuple> > B_tiles( num_devices );
+    for (int64_t c = 0; c < ncols; ++c) {
+        int64_t k = cols[ c ] / nb;
+        for (int64_t i = 0; i < mt; ++i) {
+            if (B.tileIsLocal( i, k ))
+                B_tiles[ B.tileDevice( i, k ) ].insert( { i, k } );
+        }
+    }
+
+    std::vector<real_t*> dx( num_devices, nullptr );
+    for (int device = 0; device < num_devices; ++device) {
+        if (B_tiles[ device ].empty())
+            continue;
+        B.tileGetForWriting( B_tiles[ device ], device, LayoutConvert::ColMajor );
+        dx[ device ] = blas::device_malloc<real_t>(
+            ncols*mlocal, *B.compute_queue( device ) );
+    }
+
+    std::vector< ColSegment<real_t> > segs;
+    std::vector< std::pair<int64_t, int> > runs;  // ( end offset, device )
+    int64_t offset = 0;
+    for (int64_t c = 0; c < ncols; ++c) {
+        int64_t k  = cols[ c ] / nb;
+        int64_t kk = cols[ c ] % nb;
+        for (int64_t i = 0; i < mt; ++i) {
+            if (B.tileIsLocal( i, k )) {
+                int device = B.tileDevice( i, k );
+                auto Bik = B( i, k, device );
+                segs.push_back( { &dx[ device ][ offset ],
+                                  Bik.data() + kk*Bik.stride(),
+                                  Bik.mb(), device } );
+                offset += Bik.mb();
+                if (! runs.empty() && runs.back().second == device)
+                    runs.back().first = offset;
+                else
+                    runs.push_back( { offset, device } );
+            }
+        }
+    }
+
+    // The copies to the devices are on the queues of the scatters,
+    // so they are ordered before them.
+    int64_t begin = 0;
+    for (auto const& run : runs) {
+        blas::Queue* queue = B.compute_queue( run.second );
+        blas::device_memcpy<real_t>( &dx[ run.second ][ begin ], &x[ begin ],
+                                     run.first - begin, *queue );
+        begin = run.first;
+    }
+    copy_segments( B, segs );
+
+    for (int device = 0; device < num_devices; ++device) {
+        if (dx[ device ] != nullptr)
+            blas::device_free( dx[ device ], *B.compute_queue( device ) );
+    }
+}
+
 } // namespace internal
 } // namespace slate
 
@@ -14,6 +14,7 @@ namespace internal {
 //------------------------------------------------------------------------------
 /// Copy bi-diagonal TriangularBand matrix to two vectors.
 /// Dispatches to target implementations.
+/// All ranks of A must call it; all of them get D and E.
 /// @ingroup copy_internal
 ///
 template <Target target, typename scalar_t>
@@ -50,8 +51,8 @@ void copytb2bd(internal::TargetType<Target::HostTask>,
 
     int64_t nt = A.nt();
     int64_t n = A.n();
-    D.resize(n);
-    E.resize(n - 1);
+    D.assign(n, 0);
+    E.assign(n - 1, 0);
 
     // Copy diagonal & super-diagonal.
     int64_t D_index = 0;
@@ -59,26 +60,46 @@ void copytb2bd(internal::TargetType<Target::HostTask>,
     for (int64_t i = 0; i < nt; ++i) {
         // Copy 1 element from super-diagonal tile to E.
         if (i > 0) {
-            auto T = A(i-1, i);
-            E[E_index] = real( T(T.mb()-1, 0) );
+            if (A.tileIsLocal(i-1, i)) {
+                auto T = A(i-1, i);
+                E[E_index] = real( T(T.mb()-1, 0) );
+            }
             E_index += 1;
         }
 
-        // Copy main diagonal to D.
-        auto T = A(i, i);
-        slate_assert(T.mb() == T.nb()); // square diagonal tile
-        auto len = T.nb();
-        for (int j = 0; j < len; ++j) {
-            D[D_index + j] = real( T(j, j) );
-        }
-        D_index += len;
+        auto len = A.tileNb(i);
+        if (A.tileIsLocal(i, i)) {
+            // Copy main diagonal to D.
+            auto T = A(i, i);
+            slate_assert(T.mb() == T.nb()); // square diagonal tile
+            for (int j = 0; j < len; ++j) {
+                D[D_index + j] = real( T(j, j) );
+            }
 
-        // Copy super-diagonal to E.
-        for (int j = 0; j < len-1; ++j) {
-            E[E_index + j] = real( T(j, j+1) );
+            // Copy super-diagonal to E.
+            for (int j = 0; j < len-1; ++j) {
+                E[E_index + j] = real( T(j, j+1) );
+            }
         }
+        D_index += len;
         E_index += len-1;
     }
+
+    // The band may be distributed, e.g., after a distributed tb2bd, or be
+    // on one of several ranks. Each rank copies its local tiles, then the
+    // vectors are summed over the ranks.
+    int mpi_size;
+    slate_mpi_call(
+        MPI_Comm_size(A.mpiComm(), &mpi_size));
+    if (mpi_size > 1) {
+        using real_t = blas::real_type<scalar_t>;
+        slate_mpi_call(
+            MPI_Allreduce(MPI_IN_PLACE, D.data(), n,
+                          mpi_type<real_t>::value, MPI_SUM, A.mpiComm()));
+        slate_mpi_call(
+            MPI_Allreduce(MPI_IN_PLACE, E.data(), n - 1,
+                          mpi_type<real_t>::value, MPI_SUM, A.mpiComm()));
+    }
 }
 
 //------------------------------------------------------------------------------
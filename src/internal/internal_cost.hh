@@ -0,0 +1,164 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+//------------------------------------------------------------------------------
+/// @file
+///
+#ifndef SLATE_INTERNAL_COST_HH
+#define SLATE_INTERNAL_COST_HH
+
+#include "slate/Matrix.hh"
+#include "slate/Tuning.hh"
+#include "slate/types.hh"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+namespace slate {
+namespace internal {
+
+//------------------------------------------------------------------------------
+/// Machine model used to choose between the methods of a routine, e.g.,
+/// which matrix of gemm stays in place. The time of a method is
+///
+///     latency * messages + words * word_size / bandwidth
+///         + flops / (flop_rate * parallel units busy),
+///
+/// with messages and words counted as received by one rank.
+/// @see cost_model
+///
+struct CostModel {
+    double flop_rate;   ///< flop/s of one rank, including its devices
+    double bandwidth;   ///< network bytes/s into one rank
+    double latency;     ///< seconds per message
+    int p, q;           ///< MPI grid, or p = nranks, q = 1 if not 2D
+    int num_devices;    ///< devices per rank used, or 0 on the host
+
+    //----------------------------------------
+    /// @return estimated seconds of a method on this machine.
+    ///
+    /// @param[in] messages
+    ///     Number of messages received by one rank.
+    ///
+    /// @param[in] bytes
+    ///     Number of bytes received by one rank.
+    ///
+    /// @param[in] flops
+    ///     Total flops of the method, over all ranks.
+    ///
+    /// @param[in] units
+    ///     Number of ranks with work, <= p*q; fewer if there are
+    ///     fewer tiles to update than ranks.
+    ///
+    double time( double messages, double bytes, double flops,
+                 double units ) const
+    {
+        units = std::max( 1.0, std::min( units, double( p ) * q ) );
+        return latency * messages + bytes / bandwidth
+               + flops / (flop_rate * units);
+    }
+};
+
+//------------------------------------------------------------------------------
+/// [internal]
+/// @return value of the environment variable name, if set and positive,
+/// else default_value.
+///
+inline double env_rate( char const* name, double default_value )
+{
+    const char* env = std::getenv( name );
+    double value = (env != nullptr ? std::atof( env ) : 0);
+    return (value > 0 ? value : default_value);
+}
+
+//------------------------------------------------------------------------------
+/// [internal]
+/// @return the machine model for routine on matrix A, with options opts.
+///
+/// The network defaults to 10 GB/s and 2 us per message, overridden by
+/// $SLATE_NETWORK_GBPS and $SLATE_NETWORK_LATENCY_US, e.g., from a
+/// ping-pong benchmark. The flop rate defaults to 50 Gflop/s per rank on
+/// the host and 5 Tflop/s per device; if the tuning database has a rate
+/// measured for routine (@see TuningDB), that is used instead.
+///
+template <typename matrix_type>
+CostModel cost_model(
+    char const* routine, matrix_type& A, Options const& opts )
+{
+    using scalar_t = typename matrix_type::value_type;
+
+    static const double bandwidth
+        = env_rate( "SLATE_NETWORK_GBPS", 10 ) * 1e9;
+    static const double latency
+        = env_rate( "SLATE_NETWORK_LATENCY_US", 2 ) * 1e-6;
+
+    Target target = get_target( opts, Target::HostTask );
+
+    GridOrder order;
+    int p, q, myrow, mycol;
+    A.gridinfo( &order, &p, &q, &myrow, &mycol );
+    if (order == GridOrder::Unknown) {
+        // Not 2D block cyclic: treat the ranks as one column.
+        int nranks;
+        MPI_Comm_size( A.mpiComm(), &nranks );
+        p = nranks;
+        q = 1;
+    }
+
+    int num_devices = (target == Target::Devices ? A.num_devices() : 0);
+    double flop_rate = (num_devices > 0 ? 5e12 * num_devices : 50e9);
+
+    TuningDB& db = TuningDB::instance();
+    TuningEntry entry;
+    if (! db.empty()
+        && db.lookup( { routine, precision_char<scalar_t>(), target,
+                        TuningDB::sizeClass( std::max( A.m(), A.n() ) ),
+                        p, q },
+                      &entry )
+        && entry.gflops > 0) {
+        // The database has the rate of all p*q ranks together.
+        flop_rate = entry.gflops * 1e9 / (double( p ) * q);
+    }
+
+    return { flop_rate, bandwidth, latency, p, q, num_devices };
+}
+
+//------------------------------------------------------------------------------
+/// [internal]
+/// If Option::PrintVerbose >= 1, prints on rank 0 the method routine chose
+/// and why, e.g., the estimated time of each method.
+///
+template <typename matrix_type>
+void log_method(
+    char const* routine, matrix_type& A, Options const& opts,
+    char const* method, std::string const& reason )
+{
+    int verbose = get_option<int>( opts, Option::PrintVerbose, 0 );
+    if (verbose >= 1 && A.mpiRank() == 0) {
+        std::printf( "slate::%s: method %s: %s\n",
+                     routine, method, reason.c_str() );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// [internal]
+/// @return reason string listing estimated times, e.g.,
+/// "est. A 1.2e-03 s, C 4.5e-04 s".
+///
+inline std::string cost_reason(
+    char const* name1, double time1, char const* name2, double time2 )
+{
+    char buf[ 128 ];
+    std::snprintf( buf, sizeof( buf ), "est. %s %.2e s, %s %.2e s",
+                   name1, time1, name2, time2 );
+    return buf;
+}
+
+} // namespace internal
+} // namespace slate
+
+#endif // SLATE_INTERNAL_COST_HH
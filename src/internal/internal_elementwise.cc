@@ -0,0 +1,236 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/slate.hh"
+#include "slate/internal/device.hh"
+#include "internal/internal_batch.hh"
+#include "internal/internal.hh"
+#include "slate/internal/util.hh"
+#include "slate/Tile_aux.hh"
+#include "slate/Tile_blas.hh"
+#include "slate/types.hh"
+
+namespace slate {
+namespace internal {
+
+//------------------------------------------------------------------------------
+/// Fused element-wise operations.
+/// Dispatches to target implementations.
+/// @ingroup add_internal
+///
+template <Target target, typename scalar_t>
+void elementwise(std::vector< ElementwiseOp<scalar_t> >& ops,
+                 int priority, int queue_index )
+{
+    elementwise( internal::TargetType<target>(),
+                 ops, priority, queue_index );
+}
+
+//------------------------------------------------------------------------------
+/// Fused element-wise operations.
+/// Assumes all the matrices have the same tiles and distribution.
+/// Host OpenMP task implementation: one task per local tile position,
+/// applying the operations in order.
+/// @ingroup add_internal
+///
+template <typename scalar_t>
+void elementwise(internal::TargetType<Target::HostTask>,
+                 std::vector< ElementwiseOp<scalar_t> >& ops,
+                 int priority, int queue_index )
+{
+    const scalar_t zero = 0.0;
+    const scalar_t one  = 1.0;
+
+    auto& B0 = ops[ 0 ].B;
+
+    #pragma omp taskgroup
+    for (int64_t i = 0; i < B0.mt(); ++i) {
+        for (int64_t j = 0; j < B0.nt(); ++j) {
+            if (B0.tileIsLocal( i, j )) {
+                #pragma omp task slate_omp_default_none \
+                    shared( ops ) firstprivate( i, j, zero, one ) \
+                    priority( priority )
+                {
+                    for (auto& op : ops) {
+                        op.B.tileGetForWriting( i, j, LayoutConvert::None );
+                        if (! op.has_A) {
+                            tile::scale( op.beta, op.B( i, j ) );
+                        }
+                        else {
+                            op.A.tileGetForReading( i, j, LayoutConvert::None );
+                            if (op.beta == zero) {
+                                tile::gecopy( op.A( i, j ), op.B( i, j ) );
+                                if (op.alpha != one)
+                                    tile::scale( op.alpha, op.B( i, j ) );
+                            }
+                            else {
+                                tile::add( op.alpha, op.A( i, j ),
+                                           op.beta,  op.B( i, j ) );
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Fused element-wise operations.
+/// Assumes all the matrices have the same tiles and distribution.
+/// GPU device implementation: on each device, the tiles of all the
+/// operations are fetched, then the batched kernels of the operations
+/// are queued in order on one queue, with one synchronization.
+/// Operation o uses batch arrays o of ops[ 0 ].B.
+/// @ingroup add_internal
+///
+template <typename scalar_t>
+void elementwise(internal::TargetType<Target::Devices>,
+                 std::vector< ElementwiseOp<scalar_t> >& ops,
+                 int priority, int queue_index )
+{
+    using ij_tuple = typename BaseMatrix<scalar_t>::ij_tuple;
+
+    const scalar_t zero = 0.0;
+    const scalar_t one  = 1.0;
+    const Layout layout = Layout::ColMajor;
+
+    auto& B0 = ops[ 0 ].B;
+
+    #pragma omp taskgroup
+    for (int device = 0; device < B0.num_devices(); ++device) {
+        #pragma omp task slate_omp_default_none priority( priority ) \
+            shared( ops, B0 ) firstprivate( device, queue_index, zero, one, layout )
+        {
+            std::set<ij_tuple> tiles_set;
+            for (int64_t i = 0; i < B0.mt(); ++i) {
+                for (int64_t j = 0; j < B0.nt(); ++j) {
+                    if (B0.tileIsLocal( i, j ) && device == B0.tileDevice( i, j ))
+                        tiles_set.insert( { i, j } );
+                }
+            }
+
+            int64_t batch_size = tiles_set.size();
+            if (batch_size > 0) {
+                // One queue for all, to keep the operations in order.
+                blas::Queue* queue = B0.compute_queue( device, queue_index );
+
+                for (size_t o = 0; o < ops.size(); ++o) {
+                    auto& op = ops[ o ];
+                    if (op.has_A)
+                        op.A.tileGetForReading( tiles_set, device, LayoutConvert( layout ) );
+                    op.B.tileGetForWriting( tiles_set, device, LayoutConvert( layout ) );
+
+                    scalar_t** a_array_host = B0.array_host( device, o );
+                    scalar_t** b_array_host = a_array_host + batch_size;
+                    scalar_t** a_array_dev  = B0.array_device( device, o );
+                    scalar_t** b_array_dev  = a_array_dev + batch_size;
+
+                    if (! op.has_A) {
+                        auto group_params = device_regions_build<false, 1, scalar_t>(
+                                {op.B}, {a_array_host}, device );
+                        B0.batchArrayUpload( device, o, a_array_host,
+                                             batch_size, *queue );
+
+                        for (size_t g = 0; g < group_params.size(); ++g) {
+                            int64_t group_count = group_params[ g ].count;
+                            device::batch::gescale(
+                                    group_params[ g ].mb, group_params[ g ].nb,
+                                    op.beta, one,
+                                    a_array_dev, group_params[ g ].ld[0],
+                                    group_count, *queue );
+                            a_array_dev += group_count;
+                        }
+                        continue;
+                    }
+
+                    auto group_params = device_regions_build<false, 2, scalar_t>(
+                            {op.A, op.B}, {a_array_host, b_array_host}, device );
+                    B0.batchArrayUpload( device, o, a_array_host,
+                                         2*batch_size, *queue );
+
+                    for (size_t g = 0; g < group_params.size(); ++g) {
+                        int64_t group_count = group_params[ g ].count;
+                        int64_t mb = group_params[ g ].mb;
+                        int64_t nb = group_params[ g ].nb;
+                        int64_t lda = group_params[ g ].ld[0];
+                        int64_t ldb = group_params[ g ].ld[1];
+                        if (op.beta == zero) {
+                            device::gecopy(
+                                    mb, nb, a_array_dev, lda,
+                                    b_array_dev, ldb, group_count, *queue );
+                            if (op.alpha != one) {
+                                device::batch::gescale(
+                                        mb, nb, op.alpha, one,
+                                        b_array_dev, ldb,
+                                        group_count, *queue );
+                            }
+                        }
+                        else {
+                            device::batch::geadd(
+                                    mb, nb,
+                                    op.alpha, a_array_dev, lda,
+                                    op.beta,  b_array_dev, ldb,
+                                    group_count, *queue );
+                        }
+                        a_array_dev += group_count;
+                        b_array_dev += group_count;
+                    }
+                }
+
+                queue->sync();
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+// ----------------------------------------
+template
+void elementwise<Target::HostTask, float>(
+    std::vector< ElementwiseOp<float> >& ops,
+    int priority, int queue_index);
+
+template
+void elementwise<Target::Devices, float>(
+    std::vector< ElementwiseOp<float> >& ops,
+    int priority, int queue_index);
+
+// ----------------------------------------
+template
+void elementwise<Target::HostTask, double>(
+    std::vector< ElementwiseOp<double> >& ops,
+    int priority, int queue_index);
+
+template
+void elementwise<Target::Devices, double>(
+    std::vector< ElementwiseOp<double> >& ops,
+    int priority, int queue_index);
+
+// ----------------------------------------
+template
+void elementwise< Target::HostTask, std::complex<float> >(
+    std::vector< ElementwiseOp< std::complex<float> > >& ops,
+    int priority, int queue_index);
+
+template
+void elementwise< Target::Devices, std::complex<float> >(
+    std::vector< ElementwiseOp< std::complex<float> > >& ops,
+    int priority, int queue_index);
+
+// ----------------------------------------
+template
+void elementwise< Target::HostTask, std::complex<double> >(
+    std::vector< ElementwiseOp< std::complex<double> > >& ops,
+    int priority, int queue_index);
+
+template
+void elementwise< Target::Devices, std::complex<double> >(
+    std::vector< ElementwiseOp< std::complex<double> > >& ops,
+    int priority, int queue_index);
+
+} // namespace internal
+} // namespace slate
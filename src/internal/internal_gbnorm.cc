@@ -286,7 +286,10 @@ void norm(
 //------------------------------------------------------------------------------
 /// General banded matrix norm.
 /// GPU device implementation.
-/// TODO
+/// The max and Frobenius norms reduce on the devices over the tiles in the
+/// band, of any sizes, in one launch per device, @see norm_vbatch;
+/// the one and inf norms return values for each tile in the band,
+/// reduced on the host.
 /// @ingroup norm_internal
 ///
 template <typename scalar_t>
@@ -310,8 +313,6 @@ void norm(
 
     assert(A.num_devices() > 0);
 
-    std::vector<std::vector<real_t> > vals_host_arrays(A.num_devices());
-
     int64_t kl = A.lowerBandwidth();
     int64_t ku = A.upperBandwidth();
 
@@ -319,15 +320,26 @@ void norm(
     int64_t klt = ceildiv( kl, A.tileNb(0) );
     int64_t kut = ceildiv( ku, A.tileNb(0) );
 
-    // devices_values used for max and Frobenius norms.
-    std::vector<real_t> devices_values;
+    if (in_norm == Norm::Max || in_norm == Norm::Fro) {
+        real_t max_fro[ 3 ];
+        norm_vbatch( scope, A, max_fro, priority, queue_index,
+                     [klt, kut]( int64_t i, int64_t j ) {
+                         return j - kut <= i && i <= j + klt;
+                     } );
+        if (in_norm == Norm::Max) {
+            values[ 0 ] = max_fro[ 0 ];
+        }
+        else {
+            values[ 0 ] = max_fro[ 1 ];
+            values[ 1 ] = max_fro[ 2 ];
+        }
+        return;
+    }
+
+    std::vector<std::vector<real_t> > vals_host_arrays(A.num_devices());
 
     int64_t ldv = 0;
-    if (in_norm == Norm::Max) {
-        ldv = 1;
-        devices_values.resize(A.num_devices());
-    }
-    else if (in_norm == Norm::One) {
+    if (in_norm == Norm::One) {
         for (int64_t j = 0; j < A.nt(); ++j) {
             ldv = std::max( ldv, A.tileNb(j) );
         }
@@ -337,10 +349,6 @@ void norm(
             ldv = std::max( ldv, A.tileMb(i) );
         }
     }
-    else if (in_norm == Norm::Fro) {
-        ldv = 2;
-        devices_values.resize(A.num_devices() * 2);
-    }
 
     // Define index ranges for regions of matrix.
     // Tiles in each region are all the same size.
@@ -362,7 +370,7 @@ void norm(
     #pragma omp taskgroup
     for (int device = 0; device < A.num_devices(); ++device) {
         #pragma omp task slate_omp_default_none priority( priority ) \
-            shared( A, devices_values, vals_host_arrays, jrange, irange ) \
+            shared( A, vals_host_arrays, jrange, irange ) \
             firstprivate(layout, in_norm, ldv, queue_index, device, i_end, i_begin, kut, klt)
         {
             std::set<ij_tuple> A_tiles_set;
@@ -375,103 +383,82 @@ void norm(
                         A_tiles_set.insert({i, j});
                 }
             }
-            A.tileGetForReading(A_tiles_set, device, LayoutConvert(layout));
-
             int64_t num_tiles = A_tiles_set.size();
+            if (num_tiles > 0) {
+                A.tileGetForReading(A_tiles_set, device, LayoutConvert(layout));
 
-            // Setup batched arguments.
-            std::vector<scalar_t*> a_host_array_vect(num_tiles);
-            vals_host_arrays[device].resize(num_tiles*ldv);
+                // Setup batched arguments, in the batch arrays of A.
+                vals_host_arrays[device].resize(num_tiles*ldv);
 
-            blas::Queue* queue = A.compute_queue(device, queue_index);
-            scalar_t** a_dev_array = blas::device_malloc<scalar_t*>(num_tiles, *queue);
-            real_t* vals_dev_array = blas::device_malloc<real_t>(num_tiles*ldv, *queue);
+                blas::Queue* queue = A.compute_queue(device, queue_index);
+                scalar_t** a_host_array = A.array_host(device, queue_index);
+                scalar_t** a_dev_array = A.array_device(device, queue_index);
+                real_t* vals_dev_array = blas::device_malloc<real_t>(num_tiles*ldv, *queue);
 
-            scalar_t** a_host_array = a_host_array_vect.data();
-
-            int64_t batch_count = 0;
-            int64_t mb[4], nb[4], lda[4], group_count[4];
-            for (int q = 0; q < 4; ++q) {
-                group_count[q] = 0;
-                lda[q] = 0;
-                mb[q] = A.tileMb(irange[q][0]);
-                nb[q] = A.tileNb(jrange[q][0]);
-                for (int64_t j = jrange[q][0]; j < jrange[q][1]; ++j) {
-                    i_begin = max(j - kut, 0);
-                    i_end   = min(j + klt + 1, A.mt());
-
-                    i_begin = std::max( irange[q][0], i_begin );
-                    i_end   = std::min( irange[q][1], i_end );
-
-                    for (int64_t i = i_begin; i < i_end; ++i) {
-                        if (A.tileIsLocal(i, j) &&
-                            device == A.tileDevice(i, j))
-                        {
-                            a_host_array[batch_count] = A(i, j, device).data();
-                            lda[q] = A(i, j, device).stride();
-                            ++group_count[q];
-                            ++batch_count;
+                int64_t batch_count = 0;
+                int64_t mb[4], nb[4], lda[4], group_count[4];
+                for (int q = 0; q < 4; ++q) {
+                    group_count[q] = 0;
+                    lda[q] = 0;
+                    mb[q] = A.tileMb(irange[q][0]);
+                    nb[q] = A.tileNb(jrange[q][0]);
+                    for (int64_t j = jrange[q][0]; j < jrange[q][1]; ++j) {
+                        i_begin = max(j - kut, 0);
+                        i_end   = min(j + klt + 1, A.mt());
+
+                        i_begin = std::max( irange[q][0], i_begin );
+                        i_end   = std::min( irange[q][1], i_end );
+
+                        for (int64_t i = i_begin; i < i_end; ++i) {
+                            if (A.tileIsLocal(i, j) &&
+                                device == A.tileDevice(i, j))
+                            {
+                                a_host_array[batch_count] = A(i, j, device).data();
+                                lda[q] = A(i, j, device).stride();
+                                ++group_count[q];
+                                ++batch_count;
+                            }
                         }
                     }
                 }
-            }
-
-            real_t* vals_host_array = vals_host_arrays[device].data();
 
-            // Batched call to compute partial results for each tile.
-            {
-                trace::Block trace_block("slate::device::genorm");
+                real_t* vals_host_array = vals_host_arrays[device].data();
 
-                blas::device_memcpy<scalar_t*>(
-                    a_dev_array, a_host_array, batch_count, *queue );
-
-                scalar_t** a_dev_array_g = a_dev_array;
-                real_t* vals_dev_array_g = vals_dev_array;
-                for (int q = 0; q < 4; ++q) {
-                    if (group_count[q] > 0) {
-                        device::genorm(in_norm, NormScope::Matrix,
-                                       mb[q], nb[q],
-                                       a_dev_array_g, lda[q],
-                                       vals_dev_array_g, ldv,
-                                       group_count[q], *queue);
-                        a_dev_array_g += group_count[q];
-                        vals_dev_array_g += group_count[q] * ldv;
+                // Batched call to compute partial results for each tile.
+                {
+                    trace::Block trace_block("slate::device::genorm");
+
+                    A.batchArrayUpload( device, queue_index, a_host_array,
+                                        batch_count, *queue );
+
+                    scalar_t** a_dev_array_g = a_dev_array;
+                    real_t* vals_dev_array_g = vals_dev_array;
+                    for (int q = 0; q < 4; ++q) {
+                        if (group_count[q] > 0) {
+                            device::genorm(in_norm, NormScope::Matrix,
+                                           mb[q], nb[q],
+                                           a_dev_array_g, lda[q],
+                                           vals_dev_array_g, ldv,
+                                           group_count[q], *queue);
+                            a_dev_array_g += group_count[q];
+                            vals_dev_array_g += group_count[q] * ldv;
+                        }
                     }
-                }
 
-                blas::device_memcpy<real_t>(
-                    vals_host_array, vals_dev_array, batch_count*ldv, *queue );
+                    blas::device_memcpy<real_t>(
+                        vals_host_array, vals_dev_array, batch_count*ldv, *queue );
 
-                queue->sync();
-            }
-
-            // Reduction over tiles to device result.
-            if (in_norm == Norm::Max) {
-                devices_values[device] =
-                    lapack::lange(in_norm, 1, batch_count, vals_host_array, 1);
-            }
-            else if (in_norm == Norm::Fro) {
-                for (int64_t k = 0; k < batch_count; ++k) {
-                    combine_sumsq(devices_values[2*device + 0],
-                              devices_values[2*device + 1],
-                              vals_host_array[2*k + 0],
-                              vals_host_array[2*k + 1]);
+                    queue->sync();
                 }
-            }
 
-            // Release temporary device workspace
-            blas::device_free(a_dev_array, *queue);
-            blas::device_free(vals_dev_array, *queue);
+                // Release temporary device workspace
+                blas::device_free(vals_dev_array, *queue);
+            }
         }
     }
 
     // Reduction over devices to local result.
-    if (in_norm == Norm::Max) {
-        *values = lapack::lange(in_norm,
-                                1, devices_values.size(),
-                                devices_values.data(), 1);
-    }
-    else if (in_norm == Norm::One) {
+    if (in_norm == Norm::One) {
         for (int device = 0; device < A.num_devices(); ++device) {
             real_t* vals_host_array = vals_host_arrays[device].data();
             int64_t batch_count = 0;
@@ -528,15 +515,6 @@ void norm(
             }
         }
     }
-    else if (in_norm == Norm::Fro) {
-        values[0] = 0;
-        values[1] = 1;
-        for (int device = 0; device < A.num_devices(); ++device) {
-            combine_sumsq(values[0], values[1],
-                      devices_values[2*device + 0],
-                      devices_values[2*device + 1]);
-        }
-    }
 }
 
 //------------------------------------------------------------------------------
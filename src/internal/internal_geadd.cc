@@ -9,6 +9,7 @@
 #include "slate/internal/util.hh"
 #include "slate/Matrix.hh"
 #include "internal/Tile_lapack.hh"
+#include "slate/Tile_aux.hh"
 #include "slate/types.hh"
 
 namespace slate {
@@ -160,8 +161,7 @@ void add(internal::TargetType<Target::Devices>,
 
             blas::Queue* queue = B.compute_queue(device, queue_index);
 
-            blas::device_memcpy<scalar_t*>(
-                a_array_dev, a_array_host, batch_size*2, *queue );
+            B.batchArrayUpload( device, queue_index, a_array_host, batch_size*2, *queue );
 
             for (size_t g = 0; g < group_params.size(); ++g) {
                 int64_t group_count = group_params[ g ].count;
@@ -179,6 +179,152 @@ void add(internal::TargetType<Target::Devices>,
     }
 }
 
+//------------------------------------------------------------------------------
+/// General matrix add with precision conversion of A, B = alpha A + beta B,
+/// where A may be in a lower precision than B.
+/// Dispatches to target implementations.
+/// @ingroup add_internal
+///
+template <Target target, typename src_scalar_t, typename scalar_t>
+void add(scalar_t alpha, Matrix<src_scalar_t>&& A,
+         scalar_t beta,  Matrix<scalar_t>&& B,
+         int priority, int queue_index )
+{
+    add(internal::TargetType<target>(),
+        alpha, A,
+        beta,  B,
+        priority, queue_index );
+}
+
+//------------------------------------------------------------------------------
+/// General matrix add with precision conversion of A.
+/// Assumes A & B have same tile layout, dimensions, and distribution.
+/// Host OpenMP task implementation.
+/// @ingroup add_internal
+///
+template <typename src_scalar_t, typename scalar_t>
+void add(internal::TargetType<Target::HostTask>,
+         scalar_t alpha, Matrix<src_scalar_t>& A,
+         scalar_t beta,  Matrix<scalar_t>& B,
+         int priority, int queue_index )
+{
+    assert(A.mt() == B.mt());
+    assert(A.nt() == B.nt());
+
+    #pragma omp taskgroup
+    for (int64_t i = 0; i < B.mt(); ++i) {
+        for (int64_t j = 0; j < B.nt(); ++j) {
+            if (B.tileIsLocal(i, j)) {
+                #pragma omp task slate_omp_default_none \
+                    shared( A, B ) \
+                    firstprivate( i, j, alpha, beta )  priority(priority)
+                {
+                    A.tileGetForReading(i, j, LayoutConvert::None);
+                    B.tileGetForWriting(i, j, LayoutConvert::None);
+                    tile::geadd(
+                        alpha, A(i, j),
+                        beta,  B(i, j) );
+                }
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// General matrix add with precision conversion of A.
+/// Assumes A & B have same tile layout, dimensions, and distribution.
+/// GPU device implementation.
+/// @ingroup add_internal
+///
+template <typename src_scalar_t, typename scalar_t>
+void add(internal::TargetType<Target::Devices>,
+         scalar_t alpha, Matrix<src_scalar_t>& A,
+         scalar_t beta,  Matrix<scalar_t>& B,
+         int priority, int queue_index )
+{
+    using ij_tuple = typename BaseMatrix<scalar_t>::ij_tuple;
+
+    #pragma omp taskgroup
+    for (int device = 0; device < B.num_devices(); ++device) {
+        #pragma omp task slate_omp_default_none priority( priority ) \
+            shared( A, B ) \
+            firstprivate( device, queue_index, beta, alpha )
+        {
+            auto layout = Layout::ColMajor;
+            std::set<ij_tuple> tiles_set;
+            for (int64_t i = 0; i < B.mt(); ++i) {
+                for (int64_t j = 0; j < B.nt(); ++j) {
+                    if (B.tileIsLocal(i, j) && device == B.tileDevice(i, j)) {
+                        tiles_set.insert({i, j});
+                    }
+                }
+            }
+            #pragma omp taskgroup
+            {
+                #pragma omp task slate_omp_default_none \
+                    shared( A, tiles_set ) \
+                    firstprivate(device, layout)
+                {
+                    A.tileGetForReading(tiles_set, device, LayoutConvert(layout));
+                }
+                #pragma omp task slate_omp_default_none \
+                    shared( B, tiles_set ) \
+                    firstprivate(device, layout)
+                {
+                    B.tileGetForWriting(tiles_set, device, LayoutConvert(layout));
+                }
+            }
+
+            // As in copy, A provides its own batch arrays because of the
+            // different types.
+            src_scalar_t** a_array_host = A.array_host(device, queue_index);
+            scalar_t** b_array_host = B.array_host(device, queue_index);
+
+            std::vector<int64_t> lda;
+            int64_t batch_count = 0;
+            std::function<void(int64_t, int64_t, int64_t)>
+            setup_A = [&] (int64_t group, int64_t i, int64_t j) {
+                auto Aij = A( i, j, device );
+                a_array_host[ batch_count ] = Aij.data();
+                if (lda.size() == size_t(group)) {
+                    lda.push_back( Aij.stride() );
+                }
+                else {
+                    assert(lda.size() > size_t(group));
+                    assert(lda[group] == Aij.stride());
+                }
+                ++batch_count;
+            };
+            auto group_params = device_regions_build<false, 1, scalar_t>(
+                    {B},
+                    {b_array_host},
+                    device,
+                    setup_A );
+
+            src_scalar_t** a_array_dev = A.array_device(device, queue_index);
+            scalar_t** b_array_dev = B.array_device(device, queue_index);
+
+            blas::Queue* queue = B.compute_queue(device, queue_index);
+
+            A.batchArrayUpload( device, queue_index, a_array_host, batch_count, *queue );
+            B.batchArrayUpload( device, queue_index, b_array_host, batch_count, *queue );
+
+            for (size_t g = 0; g < group_params.size(); ++g) {
+                int64_t group_count = group_params[ g ].count;
+                device::batch::geadd(
+                        group_params[ g ].mb, group_params[ g ].nb,
+                        alpha, (src_scalar_t const* const*) a_array_dev, lda[ g ],
+                        beta, b_array_dev, group_params[ g ].ld[0],
+                        group_count, *queue);
+                a_array_dev += group_count;
+                b_array_dev += group_count;
+            }
+
+            queue->sync();
+        }
+    }
+}
+
 //------------------------------------------------------------------------------
 // Explicit instantiations.
 /// todo: these functions should just be named "add".
@@ -282,5 +428,33 @@ void add< Target::Devices, std::complex<double> >(
      std::complex<double> beta, Matrix< std::complex<double> >&& B,
      int priority, int queue_index );
 
+// ----------------------------------------
+// Mixed precision: float => double
+template
+void add<Target::HostTask, float, double>(
+     double alpha, Matrix<float>&& A,
+     double beta,  Matrix<double>&& B,
+     int priority, int queue_index );
+
+template
+void add<Target::Devices, float, double>(
+     double alpha, Matrix<float>&& A,
+     double beta,  Matrix<double>&& B,
+     int priority, int queue_index );
+
+// ----------------------------------------
+// Mixed precision: complex-float => complex-double
+template
+void add< Target::HostTask, std::complex<float>, std::complex<double> >(
+     std::complex<double> alpha, Matrix< std::complex<float> >&& A,
+     std::complex<double> beta,  Matrix< std::complex<double> >&& B,
+     int priority, int queue_index );
+
+template
+void add< Target::Devices, std::complex<float>, std::complex<double> >(
+     std::complex<double> alpha, Matrix< std::complex<float> >&& A,
+     std::complex<double> beta,  Matrix< std::complex<double> >&& B,
+     int priority, int queue_index );
+
 } // namespace internal
 } // namespace slate
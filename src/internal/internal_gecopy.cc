@@ -187,11 +187,9 @@ void copy(internal::TargetType<Target::Devices>,
 
             blas::Queue* queue = B.compute_queue(device, queue_index);
 
-            blas::device_memcpy<src_scalar_t*>(
-                a_array_dev, a_array_host, batch_count, *queue );
+            A.batchArrayUpload( device, queue_index, a_array_host, batch_count, *queue );
 
-            blas::device_memcpy<dst_scalar_t*>(
-                b_array_dev, b_array_host, batch_count, *queue );
+            B.batchArrayUpload( device, queue_index, b_array_host, batch_count, *queue );
 
             bool is_trans = (A.op() != B.op());
             bool is_conj = false;
@@ -202,9 +200,10 @@ void copy(internal::TargetType<Target::Devices>,
             for (size_t g = 0; g < group_params.size(); ++g) {
                 int64_t group_count = group_params[ g ].count;
                 if (is_trans) {
+                    // op(A) is mb-by-nb, so its tiles are nb-by-mb.
                     device::transpose_batch(
                             is_conj,
-                            group_params[ g ].mb, group_params[ g ].nb,
+                            group_params[ g ].nb, group_params[ g ].mb,
                             a_array_dev, lda[ g ],
                             b_array_dev, group_params[ g ].ld[0],
                             group_count, *queue);
@@ -0,0 +1,274 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/internal/device.hh"
+#include "internal/internal_batch.hh"
+#include "internal/internal_util.hh"
+#include "internal/internal.hh"
+#include "slate/internal/util.hh"
+#include "slate/Matrix.hh"
+#include "slate/types.hh"
+
+#include <vector>
+
+namespace slate {
+namespace internal {
+
+//------------------------------------------------------------------------------
+/// Local row or column maxima for equilibration.
+/// Dispatches to target implementations.
+/// @ingroup norm_internal
+///
+/// @param[in] rowcol
+/// - RowCol::Row: values is dimension m and contains the local
+///   max_j abs( A(i, j) ) of each row i.
+/// - RowCol::Col: values is dimension n and contains the local
+///   max_i R[ i ] abs( A(i, j) ) of each column j.
+///
+/// @param[in] R
+///     Row scale factors, dimension m. Used by RowCol::Col only.
+///
+template <Target target, typename scalar_t>
+void geequ(
+    RowCol rowcol, Matrix<scalar_t>&& A,
+    blas::real_type<scalar_t> const* R,
+    blas::real_type<scalar_t>* values,
+    int priority, int queue_index )
+{
+    geequ( internal::TargetType<target>(),
+           rowcol, A, R, values, priority, queue_index );
+}
+
+//------------------------------------------------------------------------------
+/// Local row or column maxima for equilibration.
+/// Host OpenMP task implementation: a task per block row for RowCol::Row,
+/// or per block column for RowCol::Col, so tasks don't share entries of
+/// values.
+/// @ingroup norm_internal
+///
+template <typename scalar_t>
+void geequ(
+    internal::TargetType<Target::HostTask>,
+    RowCol rowcol, Matrix<scalar_t>& A,
+    blas::real_type<scalar_t> const* R,
+    blas::real_type<scalar_t>* values,
+    int priority, int queue_index )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    auto ioffsets = tile_offsets( RowCol::Row, A );
+    auto joffsets = tile_offsets( RowCol::Col, A );
+    bool want_row = rowcol == RowCol::Row;
+    std::fill( values, values + (want_row ? A.m() : A.n()), real_t( 0 ) );
+
+    int64_t outer = want_row ? A.mt() : A.nt();
+    int64_t inner = want_row ? A.nt() : A.mt();
+
+    #pragma omp taskgroup
+    for (int64_t k = 0; k < outer; ++k) {
+        #pragma omp task slate_omp_default_none priority( priority ) \
+            shared( A, ioffsets, joffsets ) \
+            firstprivate( k, inner, want_row, R, values )
+        {
+            for (int64_t l = 0; l < inner; ++l) {
+                int64_t i = want_row ? k : l;
+                int64_t j = want_row ? l : k;
+                if (! A.tileIsLocal( i, j ))
+                    continue;
+
+                A.tileGetForReading( i, j, LayoutConvert::None );
+                auto T = A( i, j );
+                if (want_row) {
+                    real_t* Vi = &values[ ioffsets[ i ] ];
+                    for (int64_t jj = 0; jj < T.nb(); ++jj)
+                        for (int64_t ii = 0; ii < T.mb(); ++ii)
+                            Vi[ ii ] = max_nan( std::abs( T( ii, jj ) ), Vi[ ii ] );
+                }
+                else {
+                    real_t const* Ri = &R[ ioffsets[ i ] ];
+                    real_t* Vj = &values[ joffsets[ j ] ];
+                    for (int64_t jj = 0; jj < T.nb(); ++jj)
+                        for (int64_t ii = 0; ii < T.mb(); ++ii)
+                            Vj[ jj ] = max_nan( std::abs( T( ii, jj ) ) * Ri[ ii ],
+                                                Vj[ jj ] );
+                }
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Local row or column maxima for equilibration.
+/// GPU device implementation: each device reduces over all its local
+/// tiles in one launch, @see device::batch::geequ_vbatch, so only its
+/// maxima are copied to the host.
+/// @ingroup norm_internal
+///
+template <typename scalar_t>
+void geequ(
+    internal::TargetType<Target::Devices>,
+    RowCol rowcol, Matrix<scalar_t>& A,
+    blas::real_type<scalar_t> const* R,
+    blas::real_type<scalar_t>* values,
+    int priority, int queue_index )
+{
+    using real_t = blas::real_type<scalar_t>;
+    using ij_tuple = typename BaseMatrix<scalar_t>::ij_tuple;
+
+    // kernels assume column major
+    const Layout layout = Layout::ColMajor;
+
+    bool want_row = rowcol == RowCol::Row;
+    int64_t nvalues = want_row ? A.m() : A.n();
+    auto ioffsets = tile_offsets( RowCol::Row, A );
+    auto joffsets = tile_offsets( RowCol::Col, A );
+
+    // Local results of each device; empty if it has no tiles.
+    std::vector< std::vector<real_t> > devices_values( A.num_devices() );
+
+    #pragma omp taskgroup
+    for (int device = 0; device < A.num_devices(); ++device) {
+        #pragma omp task slate_omp_default_none priority( priority ) \
+            shared( A, devices_values, ioffsets, joffsets ) \
+            firstprivate( device, queue_index, rowcol, want_row, nvalues, \
+                          R, layout )
+        {
+            std::set<ij_tuple> A_tiles_set;
+            for (int64_t i = 0; i < A.mt(); ++i) {
+                for (int64_t j = 0; j < A.nt(); ++j) {
+                    if (A.tileIsLocal( i, j ) && device == A.tileDevice( i, j )) {
+                        A_tiles_set.insert( { i, j } );
+                    }
+                }
+            }
+            int64_t batch_count = A_tiles_set.size();
+            if (batch_count > 0) {
+                A.tileGetForReading( A_tiles_set, device, LayoutConvert( layout ) );
+
+                // Setup batched arguments: m, n, lda, row and column
+                // offsets of each tile.
+                scalar_t** a_array_host = A.array_host( device, queue_index );
+                int64_t* dims_host = A.dims_host( device, queue_index );
+                int64_t b = 0;
+                for (auto ij : A_tiles_set) {
+                    int64_t i = std::get<0>( ij );
+                    int64_t j = std::get<1>( ij );
+                    auto T = A( i, j, device );
+                    a_array_host[ b ] = T.data();
+                    dims_host[ b                 ] = T.mb();
+                    dims_host[ b +   batch_count ] = T.nb();
+                    dims_host[ b + 2*batch_count ] = T.stride();
+                    dims_host[ b + 3*batch_count ] = ioffsets[ i ];
+                    dims_host[ b + 4*batch_count ] = joffsets[ j ];
+                    ++b;
+                }
+
+                blas::Queue* queue = A.compute_queue( device, queue_index );
+                scalar_t** a_array_dev = A.array_device( device, queue_index );
+                int64_t* dims_dev = A.dims_device( device, queue_index );
+
+                real_t* values_dev = blas::device_malloc<real_t>( nvalues, *queue );
+                real_t* R_dev = nullptr;
+                devices_values[ device ].resize( nvalues );
+
+                {
+                    trace::Block trace_block("slate::device::geequ_vbatch");
+
+                    blas::device_memcpy<int64_t>(
+                        dims_dev, dims_host, 5*batch_count, *queue );
+                    A.batchArrayUpload( device, queue_index, a_array_host,
+                                        batch_count, *queue );
+                    blas::device_memset( values_dev, 0, nvalues, *queue );
+                    if (! want_row) {
+                        R_dev = blas::device_malloc<real_t>( A.m(), *queue );
+                        blas::device_memcpy<real_t>( R_dev, R, A.m(), *queue );
+                    }
+
+                    device::batch::geequ_vbatch(
+                        rowcol, dims_dev,
+                        (scalar_t const* const*) a_array_dev,
+                        R_dev, values_dev, batch_count, *queue );
+
+                    blas::device_memcpy<real_t>(
+                        devices_values[ device ].data(), values_dev, nvalues,
+                        *queue );
+
+                    queue->sync();
+                }
+                // Free device workspace
+                blas::device_free( values_dev, *queue );
+                if (R_dev != nullptr)
+                    blas::device_free( R_dev, *queue );
+            }
+        }
+    }
+
+    // Reduction over devices to local result.
+    std::fill( values, values + nvalues, real_t( 0 ) );
+    for (int device = 0; device < A.num_devices(); ++device) {
+        auto& dev_values = devices_values[ device ];
+        if (! dev_values.empty()) {
+            for (int64_t k = 0; k < nvalues; ++k)
+                values[ k ] = max_nan( dev_values[ k ], values[ k ] );
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+// ----------------------------------------
+template
+void geequ<Target::HostTask, float>(
+    RowCol rowcol, Matrix<float>&& A,
+    float const* R, float* values,
+    int priority, int queue_index );
+
+template
+void geequ<Target::Devices, float>(
+    RowCol rowcol, Matrix<float>&& A,
+    float const* R, float* values,
+    int priority, int queue_index );
+
+// ----------------------------------------
+template
+void geequ<Target::HostTask, double>(
+    RowCol rowcol, Matrix<double>&& A,
+    double const* R, double* values,
+    int priority, int queue_index );
+
+template
+void geequ<Target::Devices, double>(
+    RowCol rowcol, Matrix<double>&& A,
+    double const* R, double* values,
+    int priority, int queue_index );
+
+// ----------------------------------------
+template
+void geequ< Target::HostTask, std::complex<float> >(
+    RowCol rowcol, Matrix< std::complex<float> >&& A,
+    float const* R, float* values,
+    int priority, int queue_index );
+
+template
+void geequ< Target::Devices, std::complex<float> >(
+    RowCol rowcol, Matrix< std::complex<float> >&& A,
+    float const* R, float* values,
+    int priority, int queue_index );
+
+// ----------------------------------------
+template
+void geequ< Target::HostTask, std::complex<double> >(
+    RowCol rowcol, Matrix< std::complex<double> >&& A,
+    double const* R, double* values,
+    int priority, int queue_index );
+
+template
+void geequ< Target::Devices, std::complex<double> >(
+    RowCol rowcol, Matrix< std::complex<double> >&& A,
+    double const* R, double* values,
+    int priority, int queue_index );
+
+} // namespace internal
+} // namespace slate
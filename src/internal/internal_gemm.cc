@@ -8,6 +8,7 @@
 #include "slate/Tile_blas.hh"
 #include "internal/internal.hh"
 #include "internal/internal_batch.hh"
+#include "internal/internal_util.hh"
 
 namespace slate {
 namespace internal {
@@ -20,6 +21,10 @@ namespace internal {
 /// if $op(C)$ is transpose, then $op(A)$ and $op(B)$ cannot be conj_transpose;
 /// if $op(C)$ is conj_transpose, then $op(A)$ and $op(B)$ cannot be transpose.
 ///
+/// Tiles C(i, j) where A(i, 0) or B(0, j) is structurally zero are skipped,
+/// apart from scaling by beta, and fill-in of zero tiles of C is recorded;
+/// @see BaseMatrix::trackZeroTiles.
+///
 /// @param[in] layout
 ///     Indicates the Layout (ColMajor/RowMajor) to operate with.
 ///     Local tiles of matrix C and corresponding tiles of A & B
@@ -66,18 +71,26 @@ void gemm(internal::TargetType<Target::HostTask>,
     //       by watching 'layout' and 'C(i, j).layout()'
 
     using ij_tuple = typename BaseMatrix<scalar_t>::ij_tuple;
+    const scalar_t zero = 0.0;
+
     // check dimensions
     assert(A.nt() == 1);
     assert(B.mt() == 1);
     assert(A.mt() == C.mt());
     assert(B.nt() == C.nt());
 
+    // Skip C(i, j) if A(i, 0) or B(0, j) is structurally zero.
+    bool skip_zero = A.zeroTilesTracked() || B.zeroTilesTracked();
+    auto skipped = [&]( int64_t i, int64_t j ) {
+        return skip_zero && (A.tileIsZero( i, 0 ) || B.tileIsZero( 0, j ));
+    };
+
     int err = 0;
     std::string err_msg;
     std::set<ij_tuple> A_tiles_set, B_tiles_set;
     for (int64_t i = 0; i < C.mt(); ++i) {
         for (int64_t j = 0; j < C.nt(); ++j) {
-            if (C.tileIsLocal(i, j)) {
+            if (C.tileIsLocal(i, j) && ! skipped( i, j )) {
                 A_tiles_set.insert({i, 0});
                 B_tiles_set.insert({0, j});
             }
@@ -86,20 +99,33 @@ void gemm(internal::TargetType<Target::HostTask>,
     A.tileGetForReading(A_tiles_set, LayoutConvert(layout));
     B.tileGetForReading(B_tiles_set, LayoutConvert(layout));
 
+    ComputePrecision precision = C.computePrecision( queue_index );
+
     #pragma omp taskgroup
     for (int64_t i = 0; i < C.mt(); ++i) {
         for (int64_t j = 0; j < C.nt(); ++j) {
-            if (C.tileIsLocal(i, j)) {
+            if (C.tileIsLocal(i, j) && ! skipped( i, j )) {
+                // With beta = 0, gemm overwrites a lazy zero tile of C,
+                // so allocate it without zeroing.
+                if (beta == zero)
+                    C.tileMaterialize( i, j, false );
+
+                // Hint to run near C(i, j), e.g., in its NUMA domain.
+                scalar_t* Cij = nullptr;
+                if (C.tileExists( i, j ))
+                    Cij = C( i, j ).data();
+                SLATE_UNUSED( Cij ); // Used only by OpenMP 5.0 affinity
+
                 #pragma omp task slate_omp_default_none \
                     shared( A, B, C, err, err_msg ) \
-                    firstprivate(i, j, layout, alpha, beta ) \
-                    priority(priority)
+                    firstprivate(i, j, layout, alpha, beta, Cij, precision ) \
+                    priority(priority) slate_omp_affinity( Cij[ 0:1 ] )
                 {
                     try {
                         C.tileGetForWriting(i, j, LayoutConvert(layout));
                         tile::gemm(
                             alpha, A(i, 0), B(0, j),
-                            beta,  C(i, j) );
+                            beta,  C(i, j), precision );
                     }
                     catch (std::exception& e) {
                         err = __LINE__;
@@ -112,6 +138,9 @@ void gemm(internal::TargetType<Target::HostTask>,
 
     if (err)
         slate_error(err_msg+", line "+std::to_string(err));
+
+    if (skip_zero || C.zeroTilesTracked())
+        zero_tiles_update( beta, C, false, skipped );
 }
 
 //------------------------------------------------------------------------------
@@ -137,23 +166,43 @@ void gemm(internal::TargetType<Target::HostNest>,
     assert(A.mt() == C.mt());
     assert(B.nt() == C.nt());
 
+    // Skip C(i, j) if A(i, 0) or B(0, j) is structurally zero.
+    bool skip_zero = A.zeroTilesTracked() || B.zeroTilesTracked();
+    auto skipped = [&]( int64_t i, int64_t j ) {
+        return skip_zero && (A.tileIsZero( i, 0 ) || B.tileIsZero( 0, j ));
+    };
+
     int err = 0;
     std::string err_msg;
     int64_t C_mt = C.mt();
     int64_t C_nt = C.nt();
+    ComputePrecision precision = C.computePrecision( queue_index );
+
+    // With beta = 0, gemm overwrites lazy zero tiles of C,
+    // so allocate them without zeroing.
+    const scalar_t zero = 0.0;
+    if (beta == zero) {
+        for (int64_t i = 0; i < C_mt; ++i) {
+            for (int64_t j = 0; j < C_nt; ++j) {
+                if (C.tileIsLocal( i, j ) && ! skipped( i, j ))
+                    C.tileMaterialize( i, j, false );
+            }
+        }
+    }
 
     #pragma omp parallel for collapse(2) schedule(dynamic, 1) slate_omp_default_none \
-        shared(A, B, C, err, err_msg) firstprivate(C_nt, C_mt, layout, alpha, beta)
+        shared(A, B, C, err, err_msg, skipped) \
+        firstprivate(C_nt, C_mt, layout, alpha, beta, precision)
     for (int64_t i = 0; i < C_mt; ++i) {
         for (int64_t j = 0; j < C_nt; ++j) {
-            if (C.tileIsLocal(i, j)) {
+            if (C.tileIsLocal(i, j) && ! skipped( i, j )) {
                 try {
                     A.tileGetForReading(i, 0, LayoutConvert(layout));
                     B.tileGetForReading(0, j, LayoutConvert(layout));
                     C.tileGetForWriting(i, j, LayoutConvert(layout));
                     tile::gemm(
                         alpha, A(i, 0), B(0, j),
-                        beta,  C(i, j) );
+                        beta,  C(i, j), precision );
                 }
                 catch (std::exception& e) {
                     err = __LINE__;
@@ -165,6 +214,9 @@ void gemm(internal::TargetType<Target::HostNest>,
 
     if (err)
         slate_error(err_msg+", line "+std::to_string(err));
+
+    if (skip_zero || C.zeroTilesTracked())
+        zero_tiles_update( beta, C, false, skipped );
 #endif // omit if SLATE_HAVE_OMPTARGET
 }
 
@@ -183,7 +235,6 @@ void gemm(internal::TargetType<Target::HostBatch>,
           scalar_t beta,  Matrix<scalar_t>& C,
           Layout layout, int priority, int64_t queue_index )
 {
-#ifdef BLAS_HAVE_MKL
     using blas::conj;
     using std::swap;
     using ij_tuple = typename BaseMatrix<scalar_t>::ij_tuple;
@@ -194,13 +245,19 @@ void gemm(internal::TargetType<Target::HostBatch>,
     assert(A.mt() == C.mt());
     assert(B.nt() == C.nt());
 
+    // Skip C(i, j) if A(i, 0) or B(0, j) is structurally zero.
+    bool skip_zero = A.zeroTilesTracked() || B.zeroTilesTracked();
+    auto skipped = [&]( int64_t i, int64_t j ) {
+        return skip_zero && (A.tileIsZero( i, 0 ) || B.tileIsZero( 0, j ));
+    };
+
     // load off-diagonal tiles to host, if not there
     // also count tiles
     int batch_count = 0;
     std::set<ij_tuple> A_tiles_set, B_tiles_set, C_tiles_set;
     for (int64_t i = 0; i < C.mt(); ++i) {
         for (int64_t j = 0; j < C.nt(); ++j) {
-            if (C.tileIsLocal(i, j)) {
+            if (C.tileIsLocal(i, j) && ! skipped( i, j )) {
                 A_tiles_set.insert({i, 0});
                 B_tiles_set.insert({0, j});
                 C_tiles_set.insert({i, j});
@@ -262,11 +319,9 @@ void gemm(internal::TargetType<Target::HostBatch>,
         }
 
         // all same
-        std::vector<CBLAS_TRANSPOSE> opA_array(batch_count,
-                                               cblas_trans_const(opA));
+        std::vector<Op> opA_array(batch_count, opA);
         // all same
-        std::vector<CBLAS_TRANSPOSE> opB_array(batch_count,
-                                               cblas_trans_const(opB));
+        std::vector<Op> opB_array(batch_count, opB);
         std::vector<int> m_array(batch_count);
         std::vector<int> n_array(batch_count);
         std::vector<int> k_array(batch_count);
@@ -283,7 +338,7 @@ void gemm(internal::TargetType<Target::HostBatch>,
         int index = 0;
         for (int64_t i = 0; i < C.mt(); ++i) {
             for (int64_t j = 0; j < C.nt(); ++j) {
-                if (C.tileIsLocal(i, j)) {
+                if (C.tileIsLocal(i, j) && ! skipped( i, j )) {
                     m_array[ index ] = C(i, j).mb();
                     n_array[ index ] = C(i, j).nb();
                     k_array[ index ] = A(i, 0).nb();  // should be all same
@@ -313,35 +368,34 @@ void gemm(internal::TargetType<Target::HostBatch>,
             swap(m_array,   n_array);
         }
 
+        ComputePrecision precision = C.computePrecision( queue_index );
         {
-            trace::Block trace_block("cblas_gemm_batch");
-            // mkl_set_num_threads_local(...);
+            trace::Block trace_block("host_gemm_batch");
             if (layout == Layout::ColMajor) {
-                cblas_gemm_batch(
-                    CblasColMajor,
+                host_gemm_batch(
+                    Layout::ColMajor,
                     opA_array.data(), opB_array.data(),
                     m_array.data(), n_array.data(), k_array.data(),
                     alpha_array.data(), a_array.data(), lda_array.data(),
                                         b_array.data(), ldb_array.data(),
                     beta_array.data(),  c_array.data(), ldc_array.data(),
-                    batch_count, group_size.data());
+                    batch_count, group_size.data(), precision);
             }
             else {
-                cblas_gemm_batch(
-                    CblasColMajor,
+                host_gemm_batch(
+                    Layout::ColMajor,
                     opB_array.data(), opA_array.data(),
                     n_array.data(), m_array.data(), k_array.data(),
                     alpha_array.data(), b_array.data(), ldb_array.data(),
                                         a_array.data(), lda_array.data(),
                     beta_array.data(),  c_array.data(), ldc_array.data(),
-                    batch_count, group_size.data());
+                    batch_count, group_size.data(), precision);
             }
-            // mkl_set_num_threads_local(1);
         }
     }
-#else
-    slate_not_implemented( "HostBatch requires Intel MKL" );
-#endif
+
+    if (skip_zero || C.zeroTilesTracked())
+        zero_tiles_update( beta, C, false, skipped );
 }
 
 //------------------------------------------------------------------------------
@@ -361,6 +415,7 @@ void gemm(internal::TargetType<Target::Devices>,
     using blas::conj;
     using std::swap;
     using ij_tuple = typename BaseMatrix<scalar_t>::ij_tuple;
+    const scalar_t zero = 0.0;
 
     // check dimensions
     assert(C.mt() > 0);
@@ -372,11 +427,35 @@ void gemm(internal::TargetType<Target::Devices>,
 
     assert(C.num_devices() > 0);
 
+    // Skip C(i, j) if A(i, 0) or B(0, j) is structurally zero.
+    bool skip_zero = A.zeroTilesTracked() || B.zeroTilesTracked();
+    auto skipped = [&]( int64_t i, int64_t j ) {
+        return skip_zero && (A.tileIsZero( i, 0 ) || B.tileIsZero( 0, j ));
+    };
+
     int err = 0;
 
+    // With device stealing, balance the tiles across devices.
+    std::map< ij_tuple, int > assigned;
+    std::function<int (int64_t, int64_t)> tile_device;
+    if (C.deviceStealing() && C.num_devices() > 1) {
+        std::vector< ij_tuple > tiles;
+        for (int64_t i = 0; i < C.mt(); ++i) {
+            for (int64_t j = 0; j < C.nt(); ++j) {
+                if (C.tileIsLocal( i, j ) && ! skipped( i, j ))
+                    tiles.push_back( { i, j } );
+            }
+        }
+        assigned = device_steal_assign( C, tiles );
+        tile_device = [&assigned]( int64_t i, int64_t j ) {
+            return assigned.at( { i, j } );
+        };
+    }
+
     #pragma omp taskgroup
     for (int device = 0; device < C.num_devices(); ++device) {
-        #pragma omp task shared(A, B, C, err) priority(priority) \
+        #pragma omp task shared(A, B, C, err, skipped, tile_device) \
+            priority(priority) \
             firstprivate( alpha, beta, layout, queue_index, device )
         {
             // if op(C) is NoTrans, invert opA, opB if possible
@@ -416,8 +495,9 @@ void gemm(internal::TargetType<Target::Devices>,
             std::set<ij_tuple> A_tiles_set, B_tiles_set, C_tiles_set;
             for (int64_t i = 0; i < C.mt(); ++i) {
                 for (int64_t j = 0; j < C.nt(); ++j) {
-                    if (C.tileIsLocal(i, j)) {
-                        if (device == C.tileDevice(i, j)) {
+                    if (C.tileIsLocal(i, j) && ! skipped( i, j )) {
+                        if (device == (tile_device ? tile_device( i, j )
+                                                   : C.tileDevice( i, j ))) {
                             A_tiles_set.insert({i, 0});
                             B_tiles_set.insert({0, j});
                             C_tiles_set.insert({i, j});
@@ -426,6 +506,18 @@ void gemm(internal::TargetType<Target::Devices>,
                 }
             }
 
+            // With beta = 0, gemm overwrites lazy zero tiles of C,
+            // so allocate them without zeroing.
+            if (beta == zero) {
+                for (auto ij : C_tiles_set)
+                    C.tileMaterialize( std::get<0>( ij ), std::get<1>( ij ), false );
+            }
+
+            // Keep the tile cache from evicting tiles until kernels finish.
+            A.tileCachePin( A_tiles_set, device );
+            B.tileCachePin( B_tiles_set, device );
+            C.tileCachePin( C_tiles_set, device );
+
             #pragma omp taskgroup
             {
                 #pragma omp task slate_omp_default_none \
@@ -452,10 +544,10 @@ void gemm(internal::TargetType<Target::Devices>,
             scalar_t** c_array_host = b_array_host + batch_size;
 
             // C comes first since we do computation for a local C
-            auto group_params = device_regions_build<false, 3, scalar_t>(
+            auto group_params = device_regions_build<false, 3, scalar_t, true, true>(
                     {C, A, B},
                     {c_array_host, a_array_host, b_array_host},
-                    device );
+                    device, {}, tile_device );
 
             if (C.op() != Op::NoTrans) {
                 swap(opA, opB);
@@ -474,11 +566,54 @@ void gemm(internal::TargetType<Target::Devices>,
 
                 blas::Queue* queue = C.compute_queue(device, queue_index);
                 assert(queue != nullptr);
+                trace::DeviceBlock trace_device("blas::batch::gemm", *queue);
+
+                // With ComputePrecision::Complex3M, complex tiles go one by
+                // one to the vendor 3M gemm, which has no batched form for
+                // both precisions; else, or without it, to batched gemm.
+                bool use_3m = is_complex<scalar_t>::value
+                              && C.computePrecision( queue_index )
+                                 == ComputePrecision::Complex3M
+                              && device_gemm3m_available();
+
+                // With several groups, e.g., from the last block row and
+                // column when mb or nb does not divide m or n, the largest
+                // group goes to the vendor batched gemm and the rest are
+                // done together in one variable-size batch launch,
+                // instead of one launch per group.
+                size_t g_max = 0;
+                for (size_t g = 1; g < group_params.size(); ++g) {
+                    if (group_params[ g ].count > group_params[ g_max ].count)
+                        g_max = g;
+                }
+                bool use_vbatch = group_params.size() > 1 && ! use_3m;
+                std::vector<scalar_t*> va_array, vb_array, vc_array;
+                std::vector<int64_t> vm, vn, vldda, vlddb, vlddc;
 
                 for (size_t g = 0; g < group_params.size(); ++g) {
 
                     int64_t group_count = group_params[ g ].count;
 
+                    if (use_vbatch && g != g_max) {
+                        for (int64_t t = 0; t < group_count; ++t) {
+                            va_array.push_back( a_array_host[ t ] );
+                            vb_array.push_back( b_array_host[ t ] );
+                            vc_array.push_back( c_array_host[ t ] );
+                            vm   .push_back( group_params[ g ].mb );
+                            vn   .push_back( group_params[ g ].nb );
+                            vldda.push_back( group_params[ g ].ld[1] );
+                            vlddb.push_back( group_params[ g ].ld[2] );
+                            vlddc.push_back( group_params[ g ].ld[0] );
+                        }
+                        a_array_host += group_count;
+                        b_array_host += group_count;
+                        c_array_host += group_count;
+                        continue;
+                    }
+
+                    internal::count( internal::Count::BatchLaunches );
+                    internal::count( internal::Count::BatchTiles, group_count );
+
                     std::vector<int64_t>    m(1, group_params[ g ].mb);
                     std::vector<int64_t>    n(1, group_params[ g ].nb);
                     std::vector<int64_t> ldda(1, group_params[ g ].ld[1]);
@@ -495,6 +630,23 @@ void gemm(internal::TargetType<Target::Devices>,
                         swap(ldda, lddb);
                     }
 
+                    if constexpr (is_complex<scalar_t>::value) {
+                        if (use_3m) {
+                            for (int64_t t = 0; t < group_count; ++t) {
+                                device_gemm3m(
+                                    layout, opA, opB,
+                                    m[ 0 ], n[ 0 ], k[ 0 ],
+                                    alpha, a_array[ t ], ldda[ 0 ],
+                                           b_array[ t ], lddb[ 0 ],
+                                    beta,  c_array[ t ], lddc[ 0 ], *queue );
+                            }
+                            a_array_host += group_count;
+                            b_array_host += group_count;
+                            c_array_host += group_count;
+                            continue;
+                        }
+                    }
+
                     blas::batch::gemm(
                         layout, opA_, opB_,
                         m, n, k,
@@ -508,13 +660,70 @@ void gemm(internal::TargetType<Target::Devices>,
                     c_array_host += group_count;
                 }
 
+                int64_t vcount = va_array.size();
+                if (vcount > 0) {
+                    internal::count( internal::Count::BatchLaunches );
+                    internal::count( internal::Count::BatchTiles, vcount );
+
+                    // gemm_vbatch is column-major: as above, swap A and B
+                    // if op(C) is not NoTrans, and again for RowMajor,
+                    // where C^T = op(B)^T op(A)^T.
+                    Op vopA = opA, vopB = opB;
+                    if (layout == Layout::RowMajor)
+                        swap( vopA, vopB );
+                    if ((C.op() != Op::NoTrans) != (layout == Layout::RowMajor)) {
+                        swap( vm, vn );
+                        swap( va_array, vb_array );
+                        swap( vldda, vlddb );
+                    }
+
+                    int64_t max_m = 0, max_n = 0;
+                    int64_t* dims_host = C.dims_host( device, queue_index );
+                    for (int64_t t = 0; t < vcount; ++t) {
+                        dims_host[ t            ] = vm[ t ];
+                        dims_host[ t +   vcount ] = vn[ t ];
+                        dims_host[ t + 2*vcount ] = k[ 0 ];
+                        dims_host[ t + 3*vcount ] = vldda[ t ];
+                        dims_host[ t + 4*vcount ] = vlddb[ t ];
+                        dims_host[ t + 5*vcount ] = vlddc[ t ];
+                        max_m = std::max( max_m, vm[ t ] );
+                        max_n = std::max( max_n, vn[ t ] );
+                    }
+                    int64_t* dims_dev = C.dims_device( device, queue_index );
+                    blas::device_memcpy<int64_t>(
+                        dims_dev, dims_host, 6*vcount, *queue );
+
+                    // Pointers go in the same slots as on the host,
+                    // A at 0, B at batch_size, C at 2*batch_size.
+                    scalar_t** array_dev = C.array_device( device, queue_index );
+                    C.batchArrayUpload( device, queue_index, va_array.data(),
+                                        vcount, *queue, 0 );
+                    C.batchArrayUpload( device, queue_index, vb_array.data(),
+                                        vcount, *queue, batch_size );
+                    C.batchArrayUpload( device, queue_index, vc_array.data(),
+                                        vcount, *queue, 2*batch_size );
+
+                    device::batch::gemm_vbatch(
+                        vopA, vopB, max_m, max_n, dims_dev,
+                        alpha, array_dev,
+                               array_dev + batch_size,
+                        beta,  array_dev + 2*batch_size,
+                        vcount, *queue );
+                }
+
                 queue->sync();
             }
+            A.tileCacheUnpin( A_tiles_set, device );
+            B.tileCacheUnpin( B_tiles_set, device );
+            C.tileCacheUnpin( C_tiles_set, device );
         }
     }
 
     if (err)
         slate_error(std::to_string(err));
+
+    if (skip_zero || C.zeroTilesTracked())
+        zero_tiles_update( beta, C, false, skipped );
 }
 
 //------------------------------------------------------------------------------
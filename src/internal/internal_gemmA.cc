@@ -149,11 +149,14 @@ void gemmA(internal::TargetType<Target::HostTask>,
         slate_error(
             std::string( "Error in omp-task line: " ) + std::to_string( err ) );
 
+    ComputePrecision precision = A.computePrecision( queue_index );
+
     #pragma omp taskgroup
     for (int64_t i = 0; i < A.mt(); ++i) {
         #pragma omp task slate_omp_default_none \
             shared( A, B, C, err ) \
-            firstprivate( i, alpha, beta, zero, one, c_tile_acquired ) \
+            firstprivate( i, alpha, beta, zero, one, c_tile_acquired, \
+                          precision ) \
             priority(priority)
         {
             try {
@@ -170,7 +173,7 @@ void gemmA(internal::TargetType<Target::HostTask>,
                         if (A.tileIsLocal( i, j )) {
                             tile::gemm(
                                 alpha,  A( i, j ), B( j, k ),
-                                beta_j, C( i, k ) );
+                                beta_j, C( i, k ), precision );
 
                             beta_j = one;
                             Cik_modified = true;
@@ -286,6 +289,7 @@ void gemmA(internal::TargetType<Target::Devices>,
     // in the reduce process, we scale it here first.
     if (beta != one) {
         std::set<int> queues_to_sync;
+        std::vector< std::pair<int64_t, int> > scaled;  // (i, device)
         #pragma omp taskgroup
         for (int64_t i = 0; i < A.mt(); ++i) {
             int nlocal_A_row_i_tiles_touched = 0;
@@ -301,6 +305,8 @@ void gemmA(internal::TargetType<Target::Devices>,
                 blas::Queue* queue = A.compute_queue( device, queue_index );
                 assert( queue != nullptr );
                 queues_to_sync.insert( device );
+                C.tileCachePin( { { i, 0 } }, device );
+                scaled.push_back( { i, device } );
 
                 #pragma omp task slate_omp_default_none \
                     shared( C ) \
@@ -337,6 +343,8 @@ void gemmA(internal::TargetType<Target::Devices>,
             assert( queue != nullptr );
             queue->sync();
         }
+        for (auto& i_device : scaled)
+            C.tileCacheUnpin( { { i_device.first, 0 } }, i_device.second );
     }
 
     #pragma omp taskgroup
@@ -381,6 +389,10 @@ void gemmA(internal::TargetType<Target::Devices>,
 
             int64_t batch_size = A_tiles_set.size();
             if (batch_size > 0) {
+                // Keep the tile cache from evicting tiles until kernels finish.
+                A.tileCachePin( A_tiles_set, device );
+                B.tileCachePin( B_tiles_set, device );
+                C.tileCachePin( C_tiles_set, device );
 
                 #pragma omp taskgroup
                 {
@@ -421,6 +433,13 @@ void gemmA(internal::TargetType<Target::Devices>,
                 // info size 0 disables slow checks in batched BLAS++.
                 std::vector<int64_t> info;
 
+                // Complex tiles go one by one to the vendor 3M gemm,
+                // as in internal::gemm.
+                bool use_3m = is_complex<scalar_t>::value
+                              && A.computePrecision( queue_index )
+                                 == ComputePrecision::Complex3M
+                              && device_gemm3m_available();
+
                 for (int64_t j = 0; j < A.nt(); ++j) {
                     auto A_j = A.sub( 0, A.mt()-1, j, j );
                     auto B_j = B.sub( j, j, 0, 0 );
@@ -454,13 +473,28 @@ void gemmA(internal::TargetType<Target::Devices>,
                             swap(ldda, lddb);
                         }
 
-                        blas::batch::gemm(
-                            layout, opA_, opB_,
-                            m, n, k,
-                            alpha_, a_array, ldda,
-                                    b_array, lddb,
-                            beta_,  c_array, lddc,
-                            group_count, info, *queue);
+                        if constexpr (is_complex<scalar_t>::value) {
+                            if (use_3m) {
+                                for (int64_t t = 0; t < group_count; ++t) {
+                                    device_gemm3m(
+                                        layout, opA, opB,
+                                        m[ 0 ], n[ 0 ], k[ 0 ],
+                                        alpha,     a_array[ t ], ldda[ 0 ],
+                                                   b_array[ t ], lddb[ 0 ],
+                                        beta_[ 0 ], c_array[ t ], lddc[ 0 ],
+                                        *queue );
+                                }
+                            }
+                        }
+                        if (! use_3m) {
+                            blas::batch::gemm(
+                                layout, opA_, opB_,
+                                m, n, k,
+                                alpha_, a_array, ldda,
+                                        b_array, lddb,
+                                beta_,  c_array, lddc,
+                                group_count, info, *queue);
+                        }
 
                         a_array_host += group_count;
                         b_array_host += group_count;
@@ -478,6 +512,9 @@ void gemmA(internal::TargetType<Target::Devices>,
                     trace::Block trace_block("blas::batch::gemm");
                     queue->sync();
                 }
+                A.tileCacheUnpin( A_tiles_set, device );
+                B.tileCacheUnpin( B_tiles_set, device );
+                C.tileCacheUnpin( C_tiles_set, device );
             }
         }
     }
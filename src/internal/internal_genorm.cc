@@ -359,75 +359,215 @@ void norm(
 }
 
 //------------------------------------------------------------------------------
-/// General matrix norm.
+/// General matrix max norm together with the Frobenius norm, or max norm of
+/// each column, reduced on each device over all its local tiles, of any
+/// sizes, in one launch, so only the device's result is copied to the host.
 /// GPU device implementation.
 /// @ingroup norm_internal
 ///
+/// @param[in] scope
+/// - NormScope::Matrix: values is dimension 3 and contains the local max,
+///                      and the local scale and sum-of-squares.
+/// - NormScope::Columns: values is dimension n and contains the local
+///                       column maxima.
+///
+/// @param[in] in_tiles
+///     If set, only local tiles (i, j) with in_tiles( i, j ) are included,
+///     e.g., the tiles in the band of a band matrix. Default all.
+///
 template <typename scalar_t>
-void norm(
-    internal::TargetType<Target::Devices>,
-    Norm in_norm, NormScope scope, Matrix<scalar_t>& A,
+void norm_vbatch(
+    NormScope scope, BaseMatrix<scalar_t>& A,
     blas::real_type<scalar_t>* values,
-    int priority, int queue_index)
+    int priority, int queue_index,
+    std::function<bool (int64_t, int64_t)> const& in_tiles)
 {
     using real_t = blas::real_type<scalar_t>;
 
     // norms assume column major
-    // todo: relax this assumption, a few cases need to be adjusted only
     const Layout layout = Layout::ColMajor;
     using ij_tuple = typename BaseMatrix<scalar_t>::ij_tuple;
 
     assert(A.num_devices() > 0);
 
-    std::vector<std::vector<real_t>> vals_host_arrays( A.num_devices() );
+    // Local results of each device; empty if it has no tiles.
+    std::vector<std::vector<real_t>> devices_values( A.num_devices() );
+    int64_t ldv = (scope == NormScope::Matrix ? 3 : A.n());
+    auto joffsets = tile_offsets( RowCol::Col, A );
 
-    // devices_values used for max and Frobenius norms.
-    std::vector<real_t> devices_values;
+    #pragma omp taskgroup
+    for (int device = 0; device < A.num_devices(); ++device) {
+        #pragma omp task slate_omp_default_none priority( priority ) \
+            shared( A, devices_values, joffsets, in_tiles ) \
+            firstprivate( device, queue_index, ldv, scope, layout )
+        {
+            std::set<ij_tuple> A_tiles_set;
 
-    // Find ranges of matching mb's and ranges of matching nb's to avoid
-    // repeatedly recomputing them
-    auto irange = device_regions_range( RowCol::Row, A );
-    auto jrange = device_regions_range( RowCol::Col, A );
+            for (int64_t i = 0; i < A.mt(); ++i) {
+                for (int64_t j = 0; j < A.nt(); ++j) {
+                    if (A.tileIsLocal(i, j) && device == A.tileDevice(i, j)
+                        && (! in_tiles || in_tiles( i, j ))) {
+                        A_tiles_set.insert({i, j});
+                    }
+                }
+            }
+            int64_t batch_count = A_tiles_set.size();
+            if (batch_count > 0) {
+                A.tileGetForReading(A_tiles_set, device, LayoutConvert(layout));
+
+                // Setup batched arguments: m, n, lda, column offset of each
+                // tile, then the kernel's counter.
+                scalar_t** a_array_host = A.array_host( device, queue_index );
+                int64_t* dims_host = A.dims_host( device, queue_index );
+                int64_t b = 0;
+                for (auto ij : A_tiles_set) {
+                    int64_t i = std::get<0>( ij );
+                    int64_t j = std::get<1>( ij );
+                    auto T = A( i, j, device );
+                    a_array_host[ b ] = T.data();
+                    dims_host[ b                 ] = T.mb();
+                    dims_host[ b +   batch_count ] = T.nb();
+                    dims_host[ b + 2*batch_count ] = T.stride();
+                    dims_host[ b + 3*batch_count ] = joffsets[ j ];
+                    ++b;
+                }
+                dims_host[ 4*batch_count ] = 0;
 
-    int64_t ldv = 0;
-    if (scope == NormScope::Matrix) {
-        if (in_norm == Norm::Max) {
-            ldv = 1;
-            devices_values.resize(A.num_devices());
+                blas::Queue* queue = A.compute_queue( device, queue_index );
+                scalar_t** a_array_dev = A.array_device( device, queue_index );
+                int64_t* dims_dev = A.dims_device( device, queue_index );
+
+                int64_t values_size = (scope == NormScope::Matrix
+                                       ? 3*(device::batch::genorm_vbatch_blocks + 1)
+                                       : A.n());
+                real_t* values_dev = blas::device_malloc<real_t>( values_size, *queue );
+                devices_values[ device ].resize( ldv );
+
+                {
+                    trace::Block trace_block("slate::device::genorm_vbatch");
+
+                    blas::device_memcpy<int64_t>(
+                        dims_dev, dims_host, 4*batch_count + 1, *queue );
+                    A.batchArrayUpload( device, queue_index, a_array_host,
+                                        batch_count, *queue );
+                    if (scope == NormScope::Columns)
+                        blas::device_memset( values_dev, 0, A.n(), *queue );
+
+                    device::batch::genorm_vbatch(
+                        scope, dims_dev, a_array_dev, values_dev,
+                        batch_count, *queue );
+
+                    blas::device_memcpy<real_t>(
+                        devices_values[ device ].data(), values_dev, ldv, *queue );
+
+                    queue->sync();
+                }
+                // Free device workspace
+                blas::device_free( values_dev, *queue );
+            }
         }
-        else if (in_norm == Norm::One) {
-            for (size_t j = 0; j < jrange.size()-1; ++j) {
-                ldv = std::max( ldv, A.tileNb( jrange[j] ) );
+    }
+
+    // Reduction over devices to local result.
+    if (scope == NormScope::Matrix) {
+        values[ 0 ] = 0;
+        values[ 1 ] = 0;
+        values[ 2 ] = 1;
+        for (int device = 0; device < A.num_devices(); ++device) {
+            auto& dev_values = devices_values[ device ];
+            if (! dev_values.empty()) {
+                values[ 0 ] = max_nan( dev_values[ 0 ], values[ 0 ] );
+                combine_sumsq( values[ 1 ], values[ 2 ],
+                               dev_values[ 1 ], dev_values[ 2 ] );
             }
         }
-        else if (in_norm == Norm::Inf) {
-            for (size_t i = 0; i < irange.size()-1; ++i) {
-                ldv = std::max( ldv, A.tileMb( irange[i] ) );
+    }
+    else {
+        std::fill( values, values + A.n(), real_t( 0 ) );
+        for (int device = 0; device < A.num_devices(); ++device) {
+            auto& dev_values = devices_values[ device ];
+            if (! dev_values.empty()) {
+                for (int64_t k = 0; k < A.n(); ++k)
+                    values[ k ] = max_nan( dev_values[ k ], values[ k ] );
             }
         }
-        else if (in_norm == Norm::Fro) {
-            ldv = 2;
-            devices_values.resize(A.num_devices() * 2);
+    }
+}
+
+//------------------------------------------------------------------------------
+/// General matrix norm.
+/// GPU device implementation.
+/// The max and Frobenius norms of the matrix and the max norm of columns
+/// reduce on the devices, @see norm_vbatch; the one and inf norms return
+/// values for each tile, reduced on the host.
+/// @ingroup norm_internal
+///
+template <typename scalar_t>
+void norm(
+    internal::TargetType<Target::Devices>,
+    Norm in_norm, NormScope scope, Matrix<scalar_t>& A,
+    blas::real_type<scalar_t>* values,
+    int priority, int queue_index)
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    if (scope == NormScope::Matrix
+        && (in_norm == Norm::Max || in_norm == Norm::Fro)) {
+        real_t max_fro[ 3 ];
+        norm_vbatch( scope, A, max_fro, priority, queue_index );
+        if (in_norm == Norm::Max) {
+            values[ 0 ] = max_fro[ 0 ];
+        }
+        else {
+            values[ 0 ] = max_fro[ 1 ];
+            values[ 1 ] = max_fro[ 2 ];
         }
+        return;
     }
     else if (scope == NormScope::Columns) {
         if (in_norm == Norm::Max) {
-            for (size_t j = 0; j < jrange.size()-1; ++j) {
-                ldv = std::max( ldv, A.tileNb( jrange[j] ) );
-            }
+            norm_vbatch( scope, A, values, priority, queue_index );
+            return;
         }
         else {
-            slate_not_implemented("The NormScope isn't yet supported.");
+            slate_not_implemented("The Norm isn't yet supported.");
         }
     }
-    else {
+    else if (scope != NormScope::Matrix) {
         slate_not_implemented("The NormScope isn't yet supported.");
     }
 
+    // norms assume column major
+    // todo: relax this assumption, a few cases need to be adjusted only
+    const Layout layout = Layout::ColMajor;
+    using ij_tuple = typename BaseMatrix<scalar_t>::ij_tuple;
+
+    assert(A.num_devices() > 0);
+
+    std::vector<std::vector<real_t>> vals_host_arrays( A.num_devices() );
+
+    // Find ranges of matching mb's and ranges of matching nb's to avoid
+    // repeatedly recomputing them
+    auto irange = device_regions_range( RowCol::Row, A );
+    auto jrange = device_regions_range( RowCol::Col, A );
+
+    // One norm: column sums; inf norm: row sums.
+    int64_t ldv = 0;
+    if (in_norm == Norm::One) {
+        for (size_t j = 0; j < jrange.size()-1; ++j) {
+            ldv = std::max( ldv, A.tileNb( jrange[j] ) );
+        }
+    }
+    else if (in_norm == Norm::Inf) {
+        for (size_t i = 0; i < irange.size()-1; ++i) {
+            ldv = std::max( ldv, A.tileMb( irange[i] ) );
+        }
+    }
+
     #pragma omp taskgroup
     for (int device = 0; device < A.num_devices(); ++device) {
         #pragma omp task slate_omp_default_none priority( priority ) \
-            shared( A, devices_values, vals_host_arrays, irange, jrange ) \
+            shared( A, vals_host_arrays, irange, jrange ) \
             firstprivate(device, queue_index, ldv, scope, in_norm, layout)
         {
             std::set<ij_tuple> A_tiles_set;
@@ -464,8 +604,7 @@ void norm(
                 trace::Block trace_block("slate::device::genorm");
 
 
-                blas::device_memcpy<scalar_t*>(
-                    a_array_dev, a_array_host, batch_size, *queue );
+                A.batchArrayUpload( device, queue_index, a_array_host, batch_size, *queue );
 
                 real_t* vals_dev_array_group = vals_dev_array;
                 for (size_t g = 0; g < group_params.size(); ++g) {
@@ -487,127 +626,85 @@ void norm(
                 queue->sync();
             }
 
-            if (scope == NormScope::Matrix) {
-                // Reduction over tiles to device result.
-                if (in_norm == Norm::Max) {
-                    devices_values[device] =
-                        lapack::lange(in_norm, 1, batch_size, vals_host_array, 1);
-                }
-                else if (in_norm == Norm::Fro) {
-                    for (int64_t k = 0; k < batch_size; ++k) {
-                        combine_sumsq(devices_values[2*device + 0],
-                                  devices_values[2*device + 1],
-                                  vals_host_array[2*k + 0],
-                                  vals_host_array[2*k + 1]);
-                    }
-                }
-            }
             // Free device workspace
             blas::device_free(vals_dev_array, *queue);
         }
     }
 
-    if (scope == NormScope::Matrix) {
-
-        // Reduction over devices to local result.
-        if (in_norm == Norm::Max) {
-            *values = lapack::lange(in_norm,
-                                    1, devices_values.size(),
-                                    devices_values.data(), 1);
-        }
-        else if (in_norm == Norm::One) {
-            auto joffsets = tile_offsets( RowCol::Col, A );
-
-            for (int device = 0; device < A.num_devices(); ++device) {
-
-                real_t* vals_host_array = vals_host_arrays[device].data();
-
-                int64_t batch_count = 0;
-                for (size_t jj = 0; jj < jrange.size() - 1; ++jj) {
-                for (size_t ii = 0; ii < irange.size() - 1; ++ii) {
-                    int64_t nb = A.tileNb( jrange[jj] );
-                    for (int64_t j = jrange[ jj ]; j < jrange[ jj+1 ]; ++j) {
-                    for (int64_t i = irange[ ii ]; i < irange[ ii+1 ]; ++i) {
-                        if (A.tileIsLocal( i, j ) && device == A.tileDevice( i, j )) {
-                            blas::axpy(
-                                nb, 1.0,
-                                &vals_host_array[batch_count*ldv], 1,
-                                &values[ joffsets[j] ], 1);
-                            ++batch_count;
-                        }
-                    }} // for j,i
-                }} // for jj,ii
-            }
-        }
-        else if (in_norm == Norm::Inf) {
-            auto ioffsets = tile_offsets( RowCol::Row, A );
-
-            for (int device = 0; device < A.num_devices(); ++device) {
-
-                real_t* vals_host_array = vals_host_arrays[device].data();
-
-                int64_t batch_count = 0;
-                for (size_t jj = 0; jj < jrange.size() - 1; ++jj) {
-                for (size_t ii = 0; ii < irange.size() - 1; ++ii) {
-                    int64_t mb = A.tileMb( irange[ii] );
-                    for (int64_t j = jrange[ jj ]; j < jrange[ jj+1 ]; ++j) {
-                    for (int64_t i = irange[ ii ]; i < irange[ ii+1 ]; ++i) {
-                        if (A.tileIsLocal( i, j ) && device == A.tileDevice( i, j )) {
-                            blas::axpy(
-                                mb, 1.0,
-                                &vals_host_array[batch_count*ldv], 1,
-                                &values[ ioffsets[i] ], 1);
-                            ++batch_count;
-                        }
-                    }} // for j,i
-                }} // for jj,ii
-            }
+    // Reduction over devices to local result.
+    if (in_norm == Norm::One) {
+        auto joffsets = tile_offsets( RowCol::Col, A );
+
+        for (int device = 0; device < A.num_devices(); ++device) {
+
+            real_t* vals_host_array = vals_host_arrays[device].data();
+
+            int64_t batch_count = 0;
+            for (size_t jj = 0; jj < jrange.size() - 1; ++jj) {
+            for (size_t ii = 0; ii < irange.size() - 1; ++ii) {
+                int64_t nb = A.tileNb( jrange[jj] );
+                for (int64_t j = jrange[ jj ]; j < jrange[ jj+1 ]; ++j) {
+                for (int64_t i = irange[ ii ]; i < irange[ ii+1 ]; ++i) {
+                    if (A.tileIsLocal( i, j ) && device == A.tileDevice( i, j )) {
+                        blas::axpy(
+                            nb, 1.0,
+                            &vals_host_array[batch_count*ldv], 1,
+                            &values[ joffsets[j] ], 1);
+                        ++batch_count;
+                    }
+                }} // for j,i
+            }} // for jj,ii
         }
-        else if (in_norm == Norm::Fro) {
-            values[0] = 0;
-            values[1] = 1;
-            for (int device = 0; device < A.num_devices(); ++device) {
-                combine_sumsq(values[0], values[1],
-                          devices_values[2*device + 0],
-                          devices_values[2*device + 1]);
-            }
+    }
+    else if (in_norm == Norm::Inf) {
+        auto ioffsets = tile_offsets( RowCol::Row, A );
+
+        for (int device = 0; device < A.num_devices(); ++device) {
+
+            real_t* vals_host_array = vals_host_arrays[device].data();
+
+            int64_t batch_count = 0;
+            for (size_t jj = 0; jj < jrange.size() - 1; ++jj) {
+            for (size_t ii = 0; ii < irange.size() - 1; ++ii) {
+                int64_t mb = A.tileMb( irange[ii] );
+                for (int64_t j = jrange[ jj ]; j < jrange[ jj+1 ]; ++j) {
+                for (int64_t i = irange[ ii ]; i < irange[ ii+1 ]; ++i) {
+                    if (A.tileIsLocal( i, j ) && device == A.tileDevice( i, j )) {
+                        blas::axpy(
+                            mb, 1.0,
+                            &vals_host_array[batch_count*ldv], 1,
+                            &values[ ioffsets[i] ], 1);
+                        ++batch_count;
+                    }
+                }} // for j,i
+            }} // for jj,ii
         }
     }
-    else if (scope == NormScope::Columns) {
+}
 
-        if (in_norm == Norm::Max) {
-            auto joffsets = tile_offsets( RowCol::Col, A );
-
-            // Reduction over devices to local result.
-            // todo: re-arrange loops to be able to issue omp tasks
-            for (int device = 0; device < A.num_devices(); ++device) {
-
-                real_t* vals_host_array = vals_host_arrays[device].data();
-
-                int64_t batch_count = 0;
-                for (size_t jj = 0; jj < jrange.size() - 1; ++jj) {
-                for (size_t ii = 0; ii < irange.size() - 1; ++ii) {
-                    int64_t nb = A.tileNb( jrange[jj] );
-                    for (int64_t j = jrange[ jj ]; j < jrange[ jj+1 ]; ++j) {
-                    for (int64_t i = irange[ ii ]; i < irange[ ii+1 ]; ++i) {
-                        if (A.tileIsLocal( i, j ) && device == A.tileDevice( i, j )) {
-                            for (int k = 0; k < nb; ++k) {
-                                values[j*ldv + k] =
-                                    max_nan(vals_host_array[batch_count*ldv + k],
-                                            values[ joffsets[j] + k]);
-                            }
-                            ++batch_count;
-                        }
-                    }} // for j,i
-                }} // for jj,ii
-            }
-        }
-        else {
-            slate_not_implemented("The Norm isn't yet supported.");
-        }
+//------------------------------------------------------------------------------
+/// General matrix max and Frobenius norms together.
+/// On devices, both come from one pass over the tiles, @see norm_vbatch;
+/// on the host, from two.
+///
+/// @param[out] values
+///     Dimension 3. Contains the local max, and the local scale and
+///     sum-of-squares.
+///
+template <Target target, typename scalar_t>
+void norm_max_fro(
+    Matrix<scalar_t>&& A,
+    blas::real_type<scalar_t>* values,
+    int priority, int queue_index)
+{
+    if (target == Target::Devices) {
+        norm_vbatch( NormScope::Matrix, A, values, priority, queue_index );
     }
     else {
-        slate_not_implemented("The NormScope isn't yet supported.");
+        norm<target>( Norm::Max, NormScope::Matrix, std::move( A ),
+                      &values[ 0 ], priority, queue_index );
+        norm<target>( Norm::Fro, NormScope::Matrix, std::move( A ),
+                      &values[ 1 ], priority, queue_index );
     }
 }
 
@@ -689,5 +786,113 @@ void norm< Target::Devices, std::complex<double> >(
     double* values,
     int priority, int queue_index);
 
+// ----------------------------------------
+template
+void norm_max_fro<Target::HostTask, float>(
+    Matrix<float>&& A,
+    float* values,
+    int priority, int queue_index);
+
+template
+void norm_max_fro<Target::HostNest, float>(
+    Matrix<float>&& A,
+    float* values,
+    int priority, int queue_index);
+
+template
+void norm_max_fro<Target::Devices, float>(
+    Matrix<float>&& A,
+    float* values,
+    int priority, int queue_index);
+
+// ----------------------------------------
+template
+void norm_max_fro<Target::HostTask, double>(
+    Matrix<double>&& A,
+    double* values,
+    int priority, int queue_index);
+
+template
+void norm_max_fro<Target::HostNest, double>(
+    Matrix<double>&& A,
+    double* values,
+    int priority, int queue_index);
+
+template
+void norm_max_fro<Target::Devices, double>(
+    Matrix<double>&& A,
+    double* values,
+    int priority, int queue_index);
+
+// ----------------------------------------
+template
+void norm_max_fro< Target::HostTask, std::complex<float> >(
+    Matrix< std::complex<float> >&& A,
+    float* values,
+    int priority, int queue_index);
+
+template
+void norm_max_fro< Target::HostNest, std::complex<float> >(
+    Matrix< std::complex<float> >&& A,
+    float* values,
+    int priority, int queue_index);
+
+template
+void norm_max_fro< Target::Devices, std::complex<float> >(
+    Matrix< std::complex<float> >&& A,
+    float* values,
+    int priority, int queue_index);
+
+// ----------------------------------------
+template
+void norm_max_fro< Target::HostTask, std::complex<double> >(
+    Matrix< std::complex<double> >&& A,
+    double* values,
+    int priority, int queue_index);
+
+template
+void norm_max_fro< Target::HostNest, std::complex<double> >(
+    Matrix< std::complex<double> >&& A,
+    double* values,
+    int priority, int queue_index);
+
+template
+void norm_max_fro< Target::Devices, std::complex<double> >(
+    Matrix< std::complex<double> >&& A,
+    double* values,
+    int priority, int queue_index);
+
+// ----------------------------------------
+template
+void norm_vbatch(
+    NormScope scope, BaseMatrix<float>& A,
+    float* values,
+    int priority, int queue_index,
+    std::function<bool (int64_t, int64_t)> const& in_tiles);
+
+// ----------------------------------------
+template
+void norm_vbatch(
+    NormScope scope, BaseMatrix<double>& A,
+    double* values,
+    int priority, int queue_index,
+    std::function<bool (int64_t, int64_t)> const& in_tiles);
+
+// ----------------------------------------
+template
+void norm_vbatch(
+    NormScope scope, BaseMatrix< std::complex<float> >& A,
+    float* values,
+    int priority, int queue_index,
+    std::function<bool (int64_t, int64_t)> const& in_tiles);
+
+// ----------------------------------------
+template
+void norm_vbatch(
+    NormScope scope, BaseMatrix< std::complex<double> >& A,
+    double* values,
+    int priority, int queue_index,
+    std::function<bool (int64_t, int64_t)> const& in_tiles);
+
 } // namespace internal
 } // namespace slate
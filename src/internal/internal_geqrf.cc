@@ -106,9 +106,10 @@ void geqrf(
         #endif
         {
             // Factor the panel in parallel.
-            // todo: double check the size of W.
+            // The recursive panel projects up to diag_len columns at a time.
             int thread_rank = omp_get_thread_num();
-            W.at(thread_rank).resize(ib*A.tileNb(0));
+            int64_t diag_len = std::min( tiles[0].mb(), tiles[0].nb() );
+            W.at(thread_rank).resize( std::max( ib, diag_len ) * A.tileNb(0) );
             tile::geqrf( ib,
                          tiles, tile_indices, T00,
                          thread_rank, thread_size,
@@ -4,6 +4,7 @@
 // the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
 
 #include "slate/types.hh"
+#include "slate/internal/device.hh"
 #include "internal/internal.hh"
 #include "internal/Tile_gerbt.hh"
 
@@ -475,6 +476,378 @@ void gerbt(Side,
            Matrix<std::complex<double>>);
 
 
+//------------------------------------------------------------------------------
+/// Lists the butterfly groups of tiles 0, ..., nt-1 for levels
+/// lo, ..., lo+depth-1 of a depth d transform with inner_len tiles per
+/// smallest butterfly half. Tile t = r + inner_len*c is member
+/// (c >> lo) mod 2^depth of the group whose first tile has bits
+/// lo, ..., lo+depth-1 of c cleared. Members beyond the end are -1.
+///
+/// @ingroup gesv_internal
+///
+std::vector< std::vector<int64_t> > gerbt_groups(
+    int64_t nt, int64_t d, int64_t inner_len, int64_t lo, int64_t depth)
+{
+    const int64_t group_size = int64_t( 1 ) << depth;
+    const int64_t mask = (group_size - 1) << lo;
+    const int64_t nt_bt = std::min( nt, (int64_t( 1 ) << d)*inner_len );
+
+    std::vector< std::vector<int64_t> > groups;
+    for (int64_t t = 0; t < nt_bt; ++t) {
+        if (((t / inner_len) & mask) == 0) {
+            std::vector<int64_t> group( group_size );
+            for (int64_t c = 0; c < group_size; ++c) {
+                const int64_t tc = t + inner_len*(c << lo);
+                group[ c ] = tc < nt ? tc : -1;
+            }
+            groups.push_back( group );
+        }
+    }
+    return groups;
+}
+
+//------------------------------------------------------------------------------
+/// Applies levels lo, ..., lo+depth-1 of a two-sided butterfly transform to
+/// A on the devices, in one pass over the tiles. The tiles of each group
+/// (see gerbt_groups) are gathered on the rank and device of its first
+/// tile, transformed by device::gerbt, and sent back.
+/// U and V are in packed storage, not transposed, and the tiles needed by
+/// the first tile of each group must already be on its rank.
+///
+/// @ingroup gesv_internal
+///
+template<typename scalar_t>
+void gerbt_fused(Matrix<scalar_t> A,
+                 Matrix<scalar_t> U,
+                 Matrix<scalar_t> V,
+                 int64_t d, int64_t inner_len, int64_t lo, int64_t depth)
+{
+    slate_assert(depth <= device::gerbt_max_depth);
+
+    const int64_t mt = A.mt();
+    const int64_t nt = A.nt();
+    const int64_t group_size = int64_t( 1 ) << depth;
+
+    auto row_groups = gerbt_groups( mt, d, inner_len, lo, depth );
+    auto col_groups = gerbt_groups( nt, d, inner_len, lo, depth );
+
+    // Gather the tiles of each group on the rank of its first tile.
+    std::vector<MPI_Request> requests;
+    for (auto const& gi : row_groups) {
+        for (auto const& gj : col_groups) {
+            const int root_rank = A.tileRank( gi[ 0 ], gj[ 0 ] );
+            const bool root_local = A.tileIsLocal( gi[ 0 ], gj[ 0 ] );
+            for (int64_t ci = 0; ci < group_size; ++ci) {
+                for (int64_t cj = 0; cj < group_size; ++cj) {
+                    const int64_t ti = gi[ ci ];
+                    const int64_t tj = gj[ cj ];
+                    if (ti < 0 || tj < 0 || (ci == 0 && cj == 0))
+                        continue;
+
+                    const int tag = ti*nt + tj;
+                    MPI_Request r;
+                    if (root_local && ! A.tileIsLocal( ti, tj )) {
+                        A.tileIrecv( ti, tj, A.tileRank( ti, tj ),
+                                     Layout::ColMajor, tag, &r );
+                        if (r != MPI_REQUEST_NULL) {
+                            requests.push_back( r );
+                        }
+                    }
+                    else if (! root_local && A.tileIsLocal( ti, tj )) {
+                        // Don't need to keep the request since we don't
+                        // touch the tile until receiving the finished data
+                        A.tileIsend( ti, tj, root_rank, tag, &r );
+                        MPI_Request_free( &r );
+                    }
+                }
+            }
+        }
+    }
+    slate_mpi_call(MPI_Waitall(requests.size(), requests.data(),
+                               MPI_STATUSES_IGNORE));
+    requests.clear();
+
+    #pragma omp taskgroup
+    for (int device = 0; device < A.num_devices(); ++device) {
+        #pragma omp task slate_omp_default_none priority( 1 ) \
+            shared( A, U, V, row_groups, col_groups ) \
+            firstprivate( device, depth, group_size )
+        {
+            blas::Queue* queue = A.compute_queue( device, 0 );
+
+            std::vector<int64_t> mb( group_size ), nb( group_size );
+            std::vector<int64_t> lda( group_size*group_size );
+            std::vector<scalar_t*> Aarray( group_size*group_size );
+            std::vector<scalar_t const*> Uarray( group_size );
+            std::vector<scalar_t const*> Varray( group_size );
+
+            for (auto const& gi : row_groups) {
+                for (auto const& gj : col_groups) {
+                    if (! A.tileIsLocal( gi[ 0 ], gj[ 0 ] )
+                        || A.tileDevice( gi[ 0 ], gj[ 0 ] ) != device) {
+                        continue;
+                    }
+
+                    for (int64_t c = 0; c < group_size; ++c) {
+                        mb[ c ] = 0;
+                        nb[ c ] = 0;
+                        Uarray[ c ] = nullptr;
+                        Varray[ c ] = nullptr;
+                        if (gi[ c ] >= 0) {
+                            U.tileGetForReading( gi[ c ], 0, device,
+                                                 LayoutConvert::None );
+                            mb[ c ] = A.tileMb( gi[ c ] );
+                            Uarray[ c ] = U( gi[ c ], 0, device ).data();
+                        }
+                        if (gj[ c ] >= 0) {
+                            V.tileGetForReading( gj[ c ], 0, device,
+                                                 LayoutConvert::None );
+                            nb[ c ] = A.tileNb( gj[ c ] );
+                            Varray[ c ] = V( gj[ c ], 0, device ).data();
+                        }
+                    }
+                    for (int64_t ci = 0; ci < group_size; ++ci) {
+                        for (int64_t cj = 0; cj < group_size; ++cj) {
+                            const int64_t c = ci*group_size + cj;
+                            Aarray[ c ] = nullptr;
+                            lda[ c ] = 1;
+                            if (gi[ ci ] >= 0 && gj[ cj ] >= 0) {
+                                A.tileGetForWriting( gi[ ci ], gj[ cj ], device,
+                                                     LayoutConvert::None );
+                                auto Aij = A( gi[ ci ], gj[ cj ], device );
+                                Aarray[ c ] = Aij.data();
+                                lda[ c ] = Aij.stride();
+                            }
+                        }
+                    }
+
+                    device::gerbt( depth, mb.data(), nb.data(),
+                                   Aarray.data(), lda.data(),
+                                   Uarray.data(), Varray.data(), *queue );
+                }
+            }
+            queue->sync();
+        }
+    }
+
+    // Send the transformed tiles back.
+    for (auto const& gi : row_groups) {
+        for (auto const& gj : col_groups) {
+            const int root_rank = A.tileRank( gi[ 0 ], gj[ 0 ] );
+            const bool root_local = A.tileIsLocal( gi[ 0 ], gj[ 0 ] );
+            for (int64_t ci = 0; ci < group_size; ++ci) {
+                for (int64_t cj = 0; cj < group_size; ++cj) {
+                    const int64_t ti = gi[ ci ];
+                    const int64_t tj = gj[ cj ];
+                    if (ti < 0 || tj < 0 || (ci == 0 && cj == 0))
+                        continue;
+
+                    const int tag = ti*nt + tj;
+                    MPI_Request r;
+                    if (root_local && ! A.tileIsLocal( ti, tj )) {
+                        A.tileIsend( ti, tj, A.tileRank( ti, tj ), tag, &r );
+                        if (r != MPI_REQUEST_NULL) {
+                            requests.push_back( r );
+                        }
+                    }
+                    else if (! root_local && A.tileIsLocal( ti, tj )) {
+                        A.tileIrecv( ti, tj, root_rank, Layout::ColMajor,
+                                     tag, &r );
+                        requests.push_back( r );
+                    }
+                }
+            }
+        }
+    }
+    slate_mpi_call(MPI_Waitall(requests.size(), requests.data(),
+                               MPI_STATUSES_IGNORE));
+
+    A.releaseRemoteWorkspace();
+}
+
+template
+void gerbt_fused(Matrix<float>,
+                 Matrix<float>,
+                 Matrix<float>,
+                 int64_t, int64_t, int64_t, int64_t);
+
+template
+void gerbt_fused(Matrix<double>,
+                 Matrix<double>,
+                 Matrix<double>,
+                 int64_t, int64_t, int64_t, int64_t);
+
+template
+void gerbt_fused(Matrix<std::complex<float>>,
+                 Matrix<std::complex<float>>,
+                 Matrix<std::complex<float>>,
+                 int64_t, int64_t, int64_t, int64_t);
+
+template
+void gerbt_fused(Matrix<std::complex<double>>,
+                 Matrix<std::complex<double>>,
+                 Matrix<std::complex<double>>,
+                 int64_t, int64_t, int64_t, int64_t);
+
+//------------------------------------------------------------------------------
+/// Applies levels lo, ..., lo+depth-1 of a one-sided butterfly transform to
+/// B on the left on the devices, in one pass over the tiles. The tiles of
+/// each group (see gerbt_groups) in each block column are gathered on the
+/// rank and device of its first tile, transformed by device::gerbt_left,
+/// and sent back.
+/// U is in packed storage, not transposed, and the tiles needed by the
+/// first tile of each group must already be on its rank.
+///
+/// @ingroup gesv_internal
+///
+template<typename scalar_t>
+void gerbt_fused(Op trans,
+                 Matrix<scalar_t> B,
+                 Matrix<scalar_t> U,
+                 int64_t d, int64_t inner_len, int64_t lo, int64_t depth)
+{
+    slate_assert(depth <= device::gerbt_left_max_depth);
+
+    const int64_t mt = B.mt();
+    const int64_t nt = B.nt();
+    const int64_t group_size = int64_t( 1 ) << depth;
+
+    auto groups = gerbt_groups( mt, d, inner_len, lo, depth );
+
+    // Gather the tiles of each group on the rank of its first tile.
+    std::vector<MPI_Request> requests;
+    for (auto const& group : groups) {
+        for (int64_t j = 0; j < nt; ++j) {
+            const int root_rank = B.tileRank( group[ 0 ], j );
+            const bool root_local = B.tileIsLocal( group[ 0 ], j );
+            for (int64_t c = 1; c < group_size; ++c) {
+                const int64_t t = group[ c ];
+                if (t < 0)
+                    continue;
+
+                const int tag = t*nt + j;
+                MPI_Request r;
+                if (root_local && ! B.tileIsLocal( t, j )) {
+                    B.tileIrecv( t, j, B.tileRank( t, j ),
+                                 Layout::ColMajor, tag, &r );
+                    if (r != MPI_REQUEST_NULL) {
+                        requests.push_back( r );
+                    }
+                }
+                else if (! root_local && B.tileIsLocal( t, j )) {
+                    B.tileIsend( t, j, root_rank, tag, &r );
+                    MPI_Request_free( &r );
+                }
+            }
+        }
+    }
+    slate_mpi_call(MPI_Waitall(requests.size(), requests.data(),
+                               MPI_STATUSES_IGNORE));
+    requests.clear();
+
+    #pragma omp taskgroup
+    for (int device = 0; device < B.num_devices(); ++device) {
+        #pragma omp task slate_omp_default_none priority( 1 ) \
+            shared( B, U, groups ) \
+            firstprivate( device, trans, depth, group_size, nt )
+        {
+            blas::Queue* queue = B.compute_queue( device, 0 );
+
+            std::vector<int64_t> mb( group_size ), ldb( group_size );
+            std::vector<scalar_t*> Barray( group_size );
+            std::vector<scalar_t const*> Uarray( group_size );
+
+            for (auto const& group : groups) {
+                for (int64_t j = 0; j < nt; ++j) {
+                    if (! B.tileIsLocal( group[ 0 ], j )
+                        || B.tileDevice( group[ 0 ], j ) != device) {
+                        continue;
+                    }
+
+                    for (int64_t c = 0; c < group_size; ++c) {
+                        const int64_t t = group[ c ];
+                        mb[ c ] = 0;
+                        ldb[ c ] = 1;
+                        Barray[ c ] = nullptr;
+                        Uarray[ c ] = nullptr;
+                        if (t >= 0) {
+                            B.tileGetForWriting( t, j, device,
+                                                 LayoutConvert::None );
+                            U.tileGetForReading( t, 0, device,
+                                                 LayoutConvert::None );
+                            auto Btj = B( t, j, device );
+                            mb[ c ] = Btj.mb();
+                            ldb[ c ] = Btj.stride();
+                            Barray[ c ] = Btj.data();
+                            Uarray[ c ] = U( t, 0, device ).data();
+                        }
+                    }
+
+                    device::gerbt_left( trans, depth, B.tileNb( j ),
+                                        mb.data(), Barray.data(), ldb.data(),
+                                        Uarray.data(), *queue );
+                }
+            }
+            queue->sync();
+        }
+    }
+
+    // Send the transformed tiles back.
+    for (auto const& group : groups) {
+        for (int64_t j = 0; j < nt; ++j) {
+            const int root_rank = B.tileRank( group[ 0 ], j );
+            const bool root_local = B.tileIsLocal( group[ 0 ], j );
+            for (int64_t c = 1; c < group_size; ++c) {
+                const int64_t t = group[ c ];
+                if (t < 0)
+                    continue;
+
+                const int tag = t*nt + j;
+                MPI_Request r;
+                if (root_local && ! B.tileIsLocal( t, j )) {
+                    B.tileIsend( t, j, B.tileRank( t, j ), tag, &r );
+                    if (r != MPI_REQUEST_NULL) {
+                        requests.push_back( r );
+                    }
+                }
+                else if (! root_local && B.tileIsLocal( t, j )) {
+                    B.tileIrecv( t, j, root_rank, Layout::ColMajor, tag, &r );
+                    requests.push_back( r );
+                }
+            }
+        }
+    }
+    slate_mpi_call(MPI_Waitall(requests.size(), requests.data(),
+                               MPI_STATUSES_IGNORE));
+
+    B.releaseRemoteWorkspace();
+}
+
+template
+void gerbt_fused(Op,
+                 Matrix<float>,
+                 Matrix<float>,
+                 int64_t, int64_t, int64_t, int64_t);
+
+template
+void gerbt_fused(Op,
+                 Matrix<double>,
+                 Matrix<double>,
+                 int64_t, int64_t, int64_t, int64_t);
+
+template
+void gerbt_fused(Op,
+                 Matrix<std::complex<float>>,
+                 Matrix<std::complex<float>>,
+                 int64_t, int64_t, int64_t, int64_t);
+
+template
+void gerbt_fused(Op,
+                 Matrix<std::complex<double>>,
+                 Matrix<std::complex<double>>,
+                 int64_t, int64_t, int64_t, int64_t);
+
+
 } // namespace internal
 
 } // namespace slate
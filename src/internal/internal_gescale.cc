@@ -118,8 +118,7 @@ void scale(internal::TargetType<Target::Devices>,
             blas::Queue* queue = A.compute_queue( device, queue_index );
 
             scalar_t** a_array_dev = A.array_device( device, queue_index );
-            blas::device_memcpy<scalar_t*>(
-                a_array_dev, a_array_host, batch_size, *queue );
+            A.batchArrayUpload( device, queue_index, a_array_host, batch_size, *queue );
 
             for (size_t g = 0; g < group_params.size(); ++g) {
                 int64_t group_count = group_params[ g ].count;
@@ -136,8 +136,7 @@ void scale_row_col(
 
             scalar_t** a_array_dev = A.array_device( device, queue_index );
 
-            blas::device_memcpy< scalar_t* >(
-                &a_array_dev[ 0 ], &a_array_host[ 0 ], batch_count, *queue);
+            A.batchArrayUpload( device, queue_index, a_array_host, batch_count, *queue );
 
             if (want_row) {
                 blas::device_memcpy< scalar_t2* >(
@@ -0,0 +1,159 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/internal/device.hh"
+#include "internal/internal_batch.hh"
+#include "internal/internal.hh"
+#include "slate/internal/util.hh"
+#include "slate/Matrix.hh"
+#include "slate/Tile_blas.hh"
+#include "slate/types.hh"
+
+namespace slate {
+namespace internal {
+
+//------------------------------------------------------------------------------
+/// Scale matrix entries by the scalar alpha, which may be complex.
+/// Dispatches to target implementations.
+/// @ingroup scale_internal
+///
+template <Target target, typename scalar_t>
+void scale(
+    scalar_t alpha, Matrix<scalar_t>&& A, int priority, int queue_index)
+{
+    scale(internal::TargetType<target>(),
+          alpha, A, priority, queue_index);
+}
+
+//------------------------------------------------------------------------------
+/// Scale matrix entries by the scalar alpha.
+/// Host OpenMP task implementation.
+/// @ingroup scale_internal
+///
+template <typename scalar_t>
+void scale(
+    internal::TargetType<Target::HostTask>,
+    scalar_t alpha, Matrix<scalar_t>& A, int priority, int queue_index)
+{
+    #pragma omp taskgroup
+    for (int64_t i = 0; i < A.mt(); ++i) {
+        for (int64_t j = 0; j < A.nt(); ++j) {
+            if (A.tileIsLocal(i, j)) {
+                #pragma omp task slate_omp_default_none \
+                    shared( A ) \
+                    firstprivate(i, j, alpha) priority(priority)
+                {
+                    A.tileGetForWriting(i, j, LayoutConvert::None);
+                    tile::scale( alpha, A( i, j ) );
+                }
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Scale matrix entries by the scalar alpha.
+/// GPU device implementation: device::batch::gescale with
+/// numer = alpha, denom = 1, in the scalar type of A.
+/// @ingroup scale_internal
+///
+template <typename scalar_t>
+void scale(internal::TargetType<Target::Devices>,
+           scalar_t alpha, Matrix<scalar_t>& A, int priority, int queue_index)
+{
+    using ij_tuple = typename BaseMatrix<scalar_t>::ij_tuple;
+
+    const scalar_t one = 1.0;
+
+    #pragma omp taskgroup
+    for (int device = 0; device < A.num_devices(); ++device) {
+        #pragma omp task slate_omp_default_none priority( priority ) \
+            shared( A ) firstprivate( device, queue_index, alpha, one )
+        {
+            std::set<ij_tuple> A_tiles_set;
+            for (int64_t i = 0; i < A.mt(); ++i) {
+                for (int64_t j = 0; j < A.nt(); ++j) {
+                    if (A.tileIsLocal(i, j) && device == A.tileDevice(i, j)) {
+                        A_tiles_set.insert({i, j});
+                    }
+                }
+            }
+            if (A_tiles_set.size() > 0) {
+                A.tileGetForWriting( A_tiles_set, device, LayoutConvert::ColMajor );
+
+                int64_t batch_size = A_tiles_set.size();
+                scalar_t** a_array_host = A.array_host( device, queue_index );
+
+                auto group_params = device_regions_build<false, 1, scalar_t>(
+                        {A}, {a_array_host}, device );
+
+                blas::Queue* queue = A.compute_queue( device, queue_index );
+
+                scalar_t** a_array_dev = A.array_device( device, queue_index );
+                A.batchArrayUpload( device, queue_index, a_array_host, batch_size, *queue );
+
+                for (size_t g = 0; g < group_params.size(); ++g) {
+                    int64_t group_count = group_params[ g ].count;
+                    device::batch::gescale(
+                            group_params[ g ].mb, group_params[ g ].nb,
+                            alpha, one, a_array_dev, group_params[ g ].ld[0],
+                            group_count, *queue);
+                    a_array_dev += group_count;
+                }
+
+                queue->sync();
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+// ----------------------------------------
+template
+void scale<Target::HostTask, float>(
+    float alpha, Matrix<float>&& A,
+    int priority, int queue_index);
+
+template
+void scale<Target::Devices, float>(
+    float alpha, Matrix<float>&& A,
+    int priority, int queue_index);
+
+// ----------------------------------------
+template
+void scale<Target::HostTask, double>(
+    double alpha, Matrix<double>&& A,
+    int priority, int queue_index);
+
+template
+void scale<Target::Devices, double>(
+    double alpha, Matrix<double>&& A,
+    int priority, int queue_index);
+
+// ----------------------------------------
+template
+void scale< Target::HostTask, std::complex<float> >(
+    std::complex<float> alpha, Matrix< std::complex<float> >&& A,
+    int priority, int queue_index);
+
+template
+void scale< Target::Devices, std::complex<float> >(
+    std::complex<float> alpha, Matrix< std::complex<float> >&& A,
+    int priority, int queue_index);
+
+// ----------------------------------------
+template
+void scale< Target::HostTask, std::complex<double> >(
+    std::complex<double> alpha, Matrix< std::complex<double> >&& A,
+    int priority, int queue_index);
+
+template
+void scale< Target::Devices, std::complex<double> >(
+    std::complex<double> alpha, Matrix< std::complex<double> >&& A,
+    int priority, int queue_index);
+
+} // namespace internal
+} // namespace slate
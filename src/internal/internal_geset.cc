@@ -99,7 +99,6 @@ void set(internal::TargetType<Target::Devices>,
             // Get local tiles for writing.
             // convert to column major layout to simplify lda's
             // todo: this is in-efficient because the diagonal is independant of layout
-            // todo: best, handle directly through the CUDA kernels
             auto layout = LayoutConvert::ColMajor;
             std::set<ij_tuple> A_tiles_set;
 
@@ -112,41 +111,39 @@ void set(internal::TargetType<Target::Devices>,
             }
             A.tileGetForWriting( A_tiles_set, device, layout );
 
-            int64_t batch_size = A_tiles_set.size();
+            // Set up a variable-size batch of m, n, lda, uplo, and whether
+            // each tile has the diagonal, so one launch sets all tiles,
+            // whatever their sizes.
+            int64_t batch_count = A_tiles_set.size();
             scalar_t** a_array_host = A.array_host( device, queue_index );
+            int64_t* dims_host = A.dims_host( device, queue_index );
+            int64_t b = 0;
+            for (auto ij : A_tiles_set) {
+                int64_t i = std::get<0>( ij );
+                int64_t j = std::get<1>( ij );
+                auto T = A( i, j, device );
+                a_array_host[ b ] = T.data();
+                dims_host[ b                 ] = T.mb();
+                dims_host[ b +   batch_count ] = T.nb();
+                dims_host[ b + 2*batch_count ] = T.stride();
+                dims_host[ b + 3*batch_count ] = int64_t( Uplo::General );
+                dims_host[ b + 4*batch_count ] = (i == j);
+                ++b;
+            }
 
-            // If offdiag == diag value, lump diag tiles with offdiag tiles
-            // in one batch.
-            bool diag_same = offdiag_value == diag_value;
-
-            auto group_params = diag_same
-                                   ? device_regions_build<true, 1, scalar_t, true>(
-                                                {A}, {a_array_host}, device )
-                                   : device_regions_build<true, 1, scalar_t, false>(
-                                                {A}, {a_array_host}, device );
             blas::Queue* queue = A.compute_queue( device, queue_index );
-
             scalar_t** a_array_dev = A.array_device( device, queue_index );
-            blas::device_memcpy<scalar_t*>(
-                a_array_dev, a_array_host, batch_size, *queue );
+            int64_t* dims_dev = A.dims_device( device, queue_index );
 
-            for (size_t g = 0; g < group_params.size(); ++g) {
-                int64_t group_count = group_params[ g ].count;
-                if (group_params[ g ].is_diagonal) {
-                    device::batch::geset(
-                        group_params[ g ].mb, group_params[ g ].nb,
-                        offdiag_value, diag_value,
-                        a_array_dev, group_params[ g ].ld[0],
-                        group_count, *queue );
-                }
-                else {
-                    device::batch::geset(
-                        group_params[ g ].mb, group_params[ g ].nb,
-                        offdiag_value, offdiag_value,
-                        a_array_dev, group_params[ g ].ld[0],
-                        group_count, *queue );
-                }
-                a_array_dev += group_count;
+            if (batch_count > 0) {
+                blas::device_memcpy<int64_t>(
+                    dims_dev, dims_host, 5*batch_count, *queue );
+                A.batchArrayUpload( device, queue_index, a_array_host,
+                                    batch_count, *queue );
+
+                device::batch::tzset_vbatch(
+                    dims_dev, offdiag_value, diag_value,
+                    a_array_dev, batch_count, *queue );
             }
             queue->sync();
         } // end task
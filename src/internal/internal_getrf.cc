@@ -8,6 +8,12 @@
 #include "slate/types.hh"
 #include "internal/Tile_getrf.hh"
 #include "internal/internal.hh"
+#include "slate/internal/Affinity.hh"
+#include "lapack.hh"
+#include "lapack/device.hh"
+#include "blas/device.hh"
+
+#include <algorithm>
 
 namespace slate {
 
@@ -57,7 +63,7 @@ void getrf_panel(
     // If participating in the panel factorization.
     if (ranks_set.find( A.mpiRank() ) != ranks_set.end()) {
 
-        // Create the broadcast communicator.
+        // Get the broadcast communicator, cached with A's communicator.
         // Translate the root rank.
         int bcast_rank;
         int bcast_root;
@@ -78,7 +84,9 @@ void getrf_panel(
         std::vector<scalar_t> max_value(thread_size);
         std::vector<int64_t> max_index(thread_size);
         std::vector<int64_t> max_offset(thread_size);
-        std::vector<scalar_t> top_block(ib*A.tileNb(0));
+        // The recursive panel updates up to diag_len columns at a time.
+        std::vector<scalar_t> top_block(
+            std::max( ib, diag_len ) * A.tileNb(0) );
         std::vector< AuxPivot<scalar_t> > aux_pivot(diag_len);
 
         #if 1
@@ -98,6 +106,9 @@ void getrf_panel(
                               diag_len, thread_size, pivot_threshold )
         #endif
         for (int thread_rank = 0; thread_rank < thread_size; ++thread_rank) {
+            // On the panel cores, if reserved; @see Option::PanelCores.
+            PanelBinding panel_binding;
+
             // Factor the panel in parallel.
             tile::getrf( diag_len, ib,
                          tiles, tile_indices,
@@ -114,9 +125,176 @@ void getrf_panel(
             pivot[i] = Pivot(aux_pivot[i].tileIndex(),
                              aux_pivot[i].elementOffset());
         }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Returns the device workspace size in bytes for getrf_panel on device for
+/// panels of up to mlocal local rows and nb columns: the panel gathered in
+/// one column-major array, LAPACK's device workspace, pivots, and info.
+/// @ingroup gesv_internal
+///
+template <typename scalar_t>
+size_t getrf_panel_work_bytes(
+    int64_t mlocal, int64_t nb, scalar_t* dA, lapack::Queue& queue )
+{
+    using lapack::device_info_int;
+    using lapack::device_pivot_int;
+
+    size_t dsize, hsize;
+    lapack::getrf_work_size_bytes( mlocal, nb, dA, std::max( mlocal, int64_t( 1 ) ),
+                                   &dsize, &hsize, queue );
+    assert( hsize == 0 );
+
+    // Pad arrays to 8-byte boundaries.
+    size_t size_A_bytes = roundup( size_t( std::max( mlocal, int64_t( 1 ) ) * nb )
+                                   * sizeof( scalar_t ), size_t( 8 ) );
+    size_t ipiv_bytes = roundup( std::min( mlocal, nb ) * sizeof( device_pivot_int ),
+                                 size_t( 8 ) );
+    dsize = roundup( dsize, size_t( 8 ) );
+    return size_A_bytes + dsize + ipiv_bytes + sizeof( device_info_int );
+}
+
+//------------------------------------------------------------------------------
+/// LU factorization of a column of tiles, device implementation.
+/// The local tiles are gathered into one column-major array on their device
+/// and factored there with LAPACK's device getrf, with the pivot search and
+/// row swaps on the device, then scattered back, so the panel doesn't
+/// round trip to the host.
+///
+/// This needs the whole panel on one rank and one device, and standard
+/// partial pivoting (pivot_threshold = 1); otherwise, the panel is factored
+/// by the host implementation. The decision is local to the panel's rank,
+/// so all ranks agree.
+///
+/// @param[in,out] dwork_array
+///     Device workspace of dwork_bytes per device,
+///     at least getrf_panel_work_bytes for the largest panel.
+///
+/// @param[in] queue_index
+///     Index of the compute queue to use.
+///
+/// @ingroup gesv_internal
+///
+template <typename scalar_t>
+void getrf_panel(
+    internal::TargetType<Target::Devices>,
+    Matrix<scalar_t>& A, int64_t diag_len, int64_t ib,
+    std::vector<Pivot>& pivot,
+    blas::real_type<scalar_t> pivot_threshold,
+    int max_panel_threads, int priority, int tag,
+    std::vector< char* >& dwork_array, size_t dwork_bytes,
+    int queue_index, int64_t* info )
+{
+    using ij_tuple = typename BaseMatrix<scalar_t>::ij_tuple;
+    using lapack::device_info_int;
+    using lapack::device_pivot_int;
+    assert(A.nt() == 1);
+
+    *info = 0;
+
+    // Find the panel's ranks and device, and the local rows.
+    std::set<int> ranks_set;
+    int device = HostNum;
+    bool one_device = true;
+    int64_t mlocal = 0;
+    for (int64_t i = 0; i < A.mt(); ++i) {
+        ranks_set.insert( A.tileRank( i, 0 ) );
+        if (A.tileIsLocal( i, 0 )) {
+            if (device == HostNum)
+                device = A.tileDevice( i, 0 );
+            else if (device != A.tileDevice( i, 0 ))
+                one_device = false;
+            mlocal += A.tileMb( i );
+        }
+    }
+
+    if (ranks_set.size() != 1 || ! one_device || device == HostNum
+        || pivot_threshold != 1
+        || dwork_array[ device ] == nullptr) {
+        getrf_panel(
+            internal::TargetType<Target::HostTask>(),
+            A, diag_len, ib, pivot,
+            pivot_threshold, max_panel_threads, priority, tag, info );
+        return;
+    }
+
+    // Move the panel to the device. All its tiles are local.
+    std::set<ij_tuple> A_tiles_set;
+    std::vector<int64_t> tile_indices;
+    std::vector<int64_t> tile_offsets;
+    int64_t row = 0;
+    for (int64_t i = 0; i < A.mt(); ++i) {
+        A_tiles_set.insert( { i, 0 } );
+        tile_indices.push_back( i );
+        tile_offsets.push_back( row );
+        row += A.tileMb( i );
+    }
+    // Keep the tile cache from evicting tiles until the scatter finishes.
+    A.tileCachePin( A_tiles_set, device );
+    A.tileGetForWriting( A_tiles_set, device, LayoutConvert::ColMajor );
+
+    lapack::Queue* queue = A.compute_queue( device, queue_index );
+    int64_t nb = A.tileNb( 0 );
+
+    // Split workspace into dA, dwork, dipiv, dinfo.
+    char* dworkspace = dwork_array[ device ];
+    scalar_t* dA = (scalar_t*) dworkspace;
+    size_t dsize, hsize;
+    lapack::getrf_work_size_bytes( mlocal, nb, dA, mlocal,
+                                   &dsize, &hsize, *queue );
+    size_t size_A_bytes = roundup( size_t( mlocal * nb ) * sizeof( scalar_t ),
+                                   size_t( 8 ) );
+    size_t ipiv_bytes = roundup( std::min( mlocal, nb )
+                                 * sizeof( device_pivot_int ), size_t( 8 ) );
+    dsize = roundup( dsize, size_t( 8 ) );
+    assert( size_A_bytes + dsize + ipiv_bytes + sizeof( device_info_int )
+            <= dwork_bytes );
+    assert( hsize == 0 );
+    SLATE_UNUSED( dwork_bytes );
+
+    char* dwork = &dworkspace[ size_A_bytes ];
+    device_pivot_int* dipiv
+        = (device_pivot_int*) &dworkspace[ size_A_bytes + dsize ];
+    device_info_int* dinfo
+        = (device_info_int*) &dworkspace[ size_A_bytes + dsize + ipiv_bytes ];
+    std::vector<char> hwork( hsize );
+
+    // Gather, factor, and scatter the panel, all on queue.
+    for (size_t t = 0; t < tile_indices.size(); ++t) {
+        auto Ai0 = A( tile_indices[ t ], 0, device );
+        blas::device_memcpy_2d<scalar_t>(
+            &dA[ tile_offsets[ t ] ], mlocal,
+            Ai0.data(), Ai0.stride(),
+            Ai0.mb(), nb, *queue );
+    }
+
+    lapack::getrf( mlocal, nb, dA, mlocal, dipiv,
+                   dwork, dsize, hwork.data(), hsize, dinfo, *queue );
 
-        // Free the broadcast communicator.
-        slate_mpi_call(MPI_Comm_free(&bcast_comm));
+    for (size_t t = 0; t < tile_indices.size(); ++t) {
+        auto Ai0 = A( tile_indices[ t ], 0, device );
+        blas::device_memcpy_2d<scalar_t>(
+            Ai0.data(), Ai0.stride(),
+            &dA[ tile_offsets[ t ] ], mlocal,
+            Ai0.mb(), nb, *queue );
+    }
+
+    std::vector<device_pivot_int> hipiv( diag_len );
+    device_info_int host_info;
+    blas::device_memcpy<device_pivot_int>( hipiv.data(), dipiv, diag_len,
+                                           *queue );
+    blas::device_memcpy<device_info_int>( &host_info, dinfo, 1, *queue );
+    queue->sync();
+    A.tileCacheUnpin( A_tiles_set, device );
+    *info = host_info;
+
+    // Convert rows of dA (1-based) to tile indices and offsets.
+    for (int64_t i = 0; i < diag_len; ++i) {
+        int64_t r = hipiv[ i ] - 1;
+        int64_t t = std::upper_bound( tile_offsets.begin(), tile_offsets.end(), r )
+                  - tile_offsets.begin() - 1;
+        pivot[ i ] = Pivot( tile_indices[ t ], r - tile_offsets[ t ] );
     }
 }
 
@@ -138,6 +316,27 @@ void getrf_panel(
         pivot_threshold, max_panel_threads, priority, tag, info );
 }
 
+//------------------------------------------------------------------------------
+/// LU factorization of a column of tiles, with device workspace.
+/// Dispatches to target implementations.
+/// @ingroup gesv_internal
+///
+template <Target target, typename scalar_t>
+void getrf_panel(
+    Matrix<scalar_t>&& A, int64_t diag_len, int64_t ib,
+    std::vector<Pivot>& pivot,
+    blas::real_type<scalar_t> pivot_threshold,
+    int max_panel_threads, int priority, int tag,
+    std::vector< char* >& dwork_array, size_t dwork_bytes,
+    int queue_index, int64_t* info )
+{
+    getrf_panel(
+        internal::TargetType<target>(),
+        A, diag_len, ib, pivot,
+        pivot_threshold, max_panel_threads, priority, tag,
+        dwork_array, dwork_bytes, queue_index, info );
+}
+
 //------------------------------------------------------------------------------
 // Explicit instantiations.
 // ----------------------------------------
@@ -172,5 +371,61 @@ void getrf_panel< Target::HostTask, std::complex<double> >(
     double pivot_threshold,
     int max_panel_threads, int priority, int tag, int64_t* info );
 
+// ----------------------------------------
+template
+void getrf_panel<Target::Devices, float>(
+    Matrix<float>&& A, int64_t diag_len, int64_t ib,
+    std::vector<Pivot>& pivot,
+    float pivot_threshold,
+    int max_panel_threads, int priority, int tag,
+    std::vector< char* >& dwork_array, size_t dwork_bytes,
+    int queue_index, int64_t* info );
+
+template
+size_t getrf_panel_work_bytes<float>(
+    int64_t mlocal, int64_t nb, float* dA, lapack::Queue& queue );
+
+// ----------------------------------------
+template
+void getrf_panel<Target::Devices, double>(
+    Matrix<double>&& A, int64_t diag_len, int64_t ib,
+    std::vector<Pivot>& pivot,
+    double pivot_threshold,
+    int max_panel_threads, int priority, int tag,
+    std::vector< char* >& dwork_array, size_t dwork_bytes,
+    int queue_index, int64_t* info );
+
+template
+size_t getrf_panel_work_bytes<double>(
+    int64_t mlocal, int64_t nb, double* dA, lapack::Queue& queue );
+
+// ----------------------------------------
+template
+void getrf_panel< Target::Devices, std::complex<float> >(
+    Matrix< std::complex<float> >&& A, int64_t diag_len, int64_t ib,
+    std::vector<Pivot>& pivot,
+    float pivot_threshold,
+    int max_panel_threads, int priority, int tag,
+    std::vector< char* >& dwork_array, size_t dwork_bytes,
+    int queue_index, int64_t* info );
+
+template
+size_t getrf_panel_work_bytes< std::complex<float> >(
+    int64_t mlocal, int64_t nb, std::complex<float>* dA, lapack::Queue& queue );
+
+// ----------------------------------------
+template
+void getrf_panel< Target::Devices, std::complex<double> >(
+    Matrix< std::complex<double> >&& A, int64_t diag_len, int64_t ib,
+    std::vector<Pivot>& pivot,
+    double pivot_threshold,
+    int max_panel_threads, int priority, int tag,
+    std::vector< char* >& dwork_array, size_t dwork_bytes,
+    int queue_index, int64_t* info );
+
+template
+size_t getrf_panel_work_bytes< std::complex<double> >(
+    int64_t mlocal, int64_t nb, std::complex<double>* dA, lapack::Queue& queue );
+
 } // namespace internal
 } // namespace slate
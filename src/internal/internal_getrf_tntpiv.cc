@@ -347,8 +347,99 @@ void getrf_tntpiv_local(
     }
 }
 
+//------------------------------------------------------------------------------
+/// Splits the tournament part of the GPU workspace, which is the last
+/// getrf_tntpiv_tournament_work_bytes() bytes of dwork_array[ dev ],
+/// into dC, dW0, dW, dwork, dipiv, and dinfo;
+/// dC    is this rank's nb-by-nb block of candidate rows, ld nb,
+/// dW0   is the (2 nb)-by-nb stack of two candidate blocks,
+/// dW    is its LU factorization,
+/// dwork is getrf workspace,
+/// dipiv is pivot vector,
+/// dinfo is getrf return value.
+///
+/// @return the size of the tournament workspace in bytes.
+///
+template <typename scalar_t>
+size_t getrf_tntpiv_tournament_split(
+    int64_t nb, char* dworkspace, lapack::Queue& queue,
+    scalar_t** dC, scalar_t** dW0, scalar_t** dW,
+    char** dwork, size_t* dsize,
+    lapack::device_pivot_int** dipiv, lapack::device_info_int** dinfo )
+{
+    using lapack::device_info_int;
+    using lapack::device_pivot_int;
+
+    size_t size_C_bytes = (nb * nb) * sizeof( scalar_t );
+    size_t size_W_bytes = (2 * nb * nb) * sizeof( scalar_t );
+    size_t ipiv_bytes   = nb * sizeof( device_pivot_int );
+
+    size_t hsize;
+    lapack::getrf_work_size_bytes( 2*nb, nb, (scalar_t*) nullptr, 2*nb,
+                                   dsize, &hsize, queue );
+    assert( hsize == 0 );
+
+    // Pad arrays to 8-byte boundaries.
+    *dsize       = roundup( *dsize,       size_t( 8 ) );
+    size_C_bytes = roundup( size_C_bytes, size_t( 8 ) );
+    size_W_bytes = roundup( size_W_bytes, size_t( 8 ) );
+    ipiv_bytes   = roundup( ipiv_bytes,   size_t( 8 ) );
+
+    if (dworkspace != nullptr) {
+        size_t offset = 0;
+        *dC    = (scalar_t*)         &dworkspace[ offset ];
+        offset += size_C_bytes;
+        *dW0   = (scalar_t*)         &dworkspace[ offset ];
+        offset += size_W_bytes;
+        *dW    = (scalar_t*)         &dworkspace[ offset ];
+        offset += size_W_bytes;
+        *dwork = (char*)             &dworkspace[ offset ];
+        offset += *dsize;
+        *dipiv = (device_pivot_int*) &dworkspace[ offset ];
+        offset += ipiv_bytes;
+        *dinfo = (device_info_int*)  &dworkspace[ offset ];
+    }
+
+    return size_C_bytes + 2*size_W_bytes + *dsize + ipiv_bytes
+           + sizeof( device_info_int );
+}
+
+//------------------------------------------------------------------------------
+/// Size in bytes of the GPU workspace used by the tournament of
+/// getrf_tntpiv_panel on devices, in addition to the workspace of the
+/// local panel factorization.
+///
+/// @param[in] nb
+///     Tile column block size.
+///
+/// @param[in] queue
+///     Queue used to query the getrf workspace size.
+///
+/// @ingroup gesv_internal
+///
+template <typename scalar_t>
+size_t getrf_tntpiv_tournament_work_bytes( int64_t nb, lapack::Queue& queue )
+{
+    scalar_t* dC;
+    scalar_t* dW0;
+    scalar_t* dW;
+    char* dwork;
+    size_t dsize;
+    lapack::device_pivot_int* dipiv;
+    lapack::device_info_int*  dinfo;
+    return getrf_tntpiv_tournament_split(
+        nb, nullptr, queue, &dC, &dW0, &dW, &dwork, &dsize, &dipiv, &dinfo );
+}
+
 //------------------------------------------------------------------------------
 /// LU factorization of a column of tiles.
+///
+/// On devices, when tiles are no taller than nb, the tournament runs on
+/// the GPU: each rank factors its local tiles, gathers its candidate
+/// rows into an nb-by-nb block on the device, and pairs of ranks
+/// exchange only those blocks, factoring two stacked blocks per level.
+/// Only the factored diagonal tile is copied back to Awork.
+///
 /// @ingroup gesv_internal
 ///
 template <Target target, typename scalar_t>
@@ -378,6 +469,10 @@ void getrf_tntpiv_panel(
     std::vector<int64_t> tile_indices;
     std::set<int> ranks_set;
 
+    // The device tournament keeps only the candidate rows, so the
+    // diagonal tile must not have rows below its nb candidates.
+    bool device_tournament = target == Target::Devices && mb <= nb;
+
     int64_t tile_index_zero = -1;
     int64_t mlocal = 0;
     if (target == Target::Devices) {
@@ -404,7 +499,9 @@ void getrf_tntpiv_panel(
             A_tiles_set.insert( { i, 0 } );
         }
     }
-    internal::copy<Target::HostTask>( std::move( A ), std::move( Awork ) );
+    if (! device_tournament) {
+        internal::copy<Target::HostTask>( std::move( A ), std::move( Awork ) );
+    }
     A.tileGetForReading( A_tiles_set, device, LayoutConvert::ColMajor );
 
     // Device contiguous memory for lapack::getrf call
@@ -508,7 +605,25 @@ void getrf_tntpiv_panel(
                 }
             }
 
-            // Apply swaps to tiles in Awork, and to permute.
+            // Split the tournament workspace, at the end of dwork_array.
+            scalar_t* dC  = nullptr;
+            scalar_t* dW0 = nullptr;
+            scalar_t* dW  = nullptr;
+            char* dwork = nullptr;
+            size_t dsize = 0;
+            lapack::device_pivot_int* dipiv = nullptr;
+            lapack::device_info_int*  dinfo = nullptr;
+            if (device_tournament) {
+                size_t tnt_bytes
+                    = getrf_tntpiv_tournament_work_bytes<scalar_t>( nb, *queue );
+                assert( tnt_bytes <= work_bytes );
+                getrf_tntpiv_tournament_split(
+                    nb, &dwork_array[ device ][ work_bytes - tnt_bytes ],
+                    *queue, &dC, &dW0, &dW, &dwork, &dsize, &dipiv, &dinfo );
+            }
+
+            // Apply swaps to tiles in Awork (or to the candidate block dC
+            // on the device), and to permute.
             // Swap (tile, row) (i=0, ii) with (ip, iip).
             auto Awork00 = Awork( tile_indices[0], 0 );
             scalar_t* Awork00_data = Awork00.data();
@@ -523,11 +638,20 @@ void getrf_tntpiv_panel(
                 int64_t isp  =  permute[ 0 ][ ii ].first;
                 int64_t iisp =  permute[ 0 ][ ii ].second;
 
-                auto Aisp = A( isp, 0 );
-                scalar_t* Aisp_data = Aisp.data();
+                if (device_tournament) {
+                    auto Aisp = A( isp, 0, device );
+                    scalar_t* Aisp_data = Aisp.data();
 
-                blas::copy( nb, &Aisp_data[ iisp ], Aisp.stride(),
-                             &Awork00_data[ ii ], Awork00.stride() );
+                    blas::copy( nb, &Aisp_data[ iisp ], Aisp.stride(),
+                                &dC[ ii ], nb, *queue );
+                }
+                else {
+                    auto Aisp = A( isp, 0 );
+                    scalar_t* Aisp_data = Aisp.data();
+
+                    blas::copy( nb, &Aisp_data[ iisp ], Aisp.stride(),
+                                 &Awork00_data[ ii ], Awork00.stride() );
+                }
             }
 
             // Copy nb elements of permute to aux_pivot for first block.
@@ -536,115 +660,244 @@ void getrf_tntpiv_panel(
                 aux_pivot[ 0 ][ ii ].set_elementOffset( permute[ 0 ][ ii ].second );
             }
 
-            int64_t step = 1;
-            for (int level = 0; level < nlevels; ++level) {
-                if (index % (2*step) == 0) {
-                    if (index + step < nranks) {
-                        // This is the top, rank1, of the pair;
-                        // recv tile from bottom, rank2, and do LU factorization.
-                        int rank2  = rank_rows[ index+step ].first;
-                        int64_t i2 = rank_rows[ index+step ].second;
-                        int64_t i1 = rank_rows[ index ].second;
-
-                        Awork.tileRecv( i2, 0, rank2, layout );
-                        Awork.tileGetForWriting( i1, 0, LayoutConvert( layout ));
-
-                        MPI_Status status;
-                        MPI_Recv( aux_pivot[ 1 ].data(),
-                                  sizeof(AuxPivot<scalar_t>) * aux_pivot[ 1 ].size(),
-                                  MPI_BYTE, rank2, 0, A.mpiComm(),  &status );
-
-                        // Alocate workspace to copy tiles in the tree reduction.
-                        std::vector<scalar_t> data1( Awork.tileMb( i1 ) * nb );
-                        std::vector<scalar_t> data2( Awork.tileMb( i2 ) * nb );
-
-                        Tile<scalar_t> tile1( Awork.tileMb( i1 ), nb,
-                                              &data1[ 0 ], Awork.tileMb( i1 ),
-                                              slate::HostNum, TileKind::Workspace );
-                        Tile<scalar_t> tile2( Awork.tileMb( i2 ), nb,
-                                              &data2[ 0 ], Awork.tileMb( i2 ),
-                                              slate::HostNum, TileKind::Workspace );
-
-                        Awork( i1, 0 ).copyData( &tile1 );
-                        Awork( i2, 0 ).copyData( &tile2 );
-
-                        piv_len = std::min( tile1.mb(), nb );
-
-                        std::vector< Tile< scalar_t > > tmp_tiles;
-                        tmp_tiles.push_back( tile1 );
-                        tmp_tiles.push_back( tile2 );
-
-                        // Factor the panel locally in parallel.
-                        getrf_tntpiv_local(
-                            internal::TargetType<Target::HostTask>(),
-                            tmp_tiles, dwork_array, work_bytes, mlocal, device,
-                            queue, piv_len, ib, 1, mb, nb, tile_indices,
-                            aux_pivot, A.mpiRank(), max_panel_threads, priority,
-                            info );
-
-                        std::vector< Tile< scalar_t > > work_tiles;
-                        work_tiles.push_back( Awork( i1, 0 ) );
-                        work_tiles.push_back( Awork( i2, 0 ) );
-
-                        // Swap rows in tiles in Awork.
-                        // Swap (tile, row) (0, ii) and (ip, iip).
-
-                        for (int64_t ii = 0; ii < piv_len; ++ii) {
-                            int64_t ip  = aux_pivot[ 0 ][ ii ].localTileIndex();
-                            int64_t iip = aux_pivot[ 0 ][ ii ].localOffset();
-                            if (ip > 0 || iip > ii) {
-                                swapLocalRow(
-                                    0, nb,
-                                    work_tiles[ 0  ], ii,
-                                    work_tiles[ ip ], iip );
+            if (device_tournament) {
+                using lapack::device_info_int;
+                using lapack::device_pivot_int;
+
+                const auto mpi_scalar = mpi_type<scalar_t>::value;
+                std::vector< device_pivot_int > hipiv( nb );
+                std::vector< scalar_t > hdiagu( nb );
+                std::vector< int64_t > perm( 2*nb );
+
+                int64_t step = 1;
+                for (int level = 0; level < nlevels; ++level) {
+                    if (index % (2*step) == 0) {
+                        if (index + step < nranks) {
+                            // This is the top, rank1, of the pair;
+                            // recv candidate rows from bottom, rank2,
+                            // and do LU factorization of both blocks.
+                            int rank2  = rank_rows[ index+step ].first;
+                            int64_t i2 = rank_rows[ index+step ].second;
+                            int64_t i1 = rank_rows[ index ].second;
+
+                            int64_t piv_len2 = std::min( A.tileMb( i2 ), nb );
+                            int64_t m2 = piv_len + piv_len2;
+
+                            std::vector<scalar_t> hC2( piv_len2 * nb );
+                            MPI_Status status;
+                            MPI_Recv( hC2.data(), piv_len2 * nb, mpi_scalar,
+                                      rank2, 0, A.mpiComm(), &status );
+                            MPI_Recv( aux_pivot[ 1 ].data(),
+                                      sizeof(AuxPivot<scalar_t>) * aux_pivot[ 1 ].size(),
+                                      MPI_BYTE, rank2, 0, A.mpiComm(), &status );
+
+                            // Stack the blocks, dW0 = [ dC; C2 ],
+                            // and factor a copy, dW.
+                            blas::device_memcpy_2d<scalar_t>(
+                                    dW0, m2, dC, nb,
+                                    piv_len, nb, *queue );
+                            blas::device_memcpy_2d<scalar_t>(
+                                    &dW0[ piv_len ], m2, hC2.data(), piv_len2,
+                                    piv_len2, nb, *queue );
+                            blas::device_memcpy_2d<scalar_t>(
+                                    dW, m2, dW0, m2,
+                                    m2, nb, *queue );
+
+                            lapack::getrf( m2, nb, dW, m2, dipiv,
+                                           dwork, dsize, nullptr, 0, dinfo,
+                                           *queue );
+
+                            blas::device_memcpy<device_pivot_int>(
+                                &hipiv[ 0 ], dipiv, piv_len, *queue );
+                            device_info_int host_info;
+                            blas::device_memcpy<device_info_int>(
+                                &host_info, dinfo, 1, *queue );
+                            blas::device_copy_vector( piv_len, dW, m2 + 1,
+                                                      &hdiagu[ 0 ], 1, *queue );
+                            queue->sync();
+                            *info = host_info;
+
+                            // Convert device sequential pivots to aux pivots
+                            // for stage 1, as tile::getrf_tntpiv_local does,
+                            // and track where the rows of dW0 move.
+                            for (int64_t i = 0; i < m2; ++i) {
+                                perm[ i ] = i;
+                            }
+                            for (int64_t j = 0; j < piv_len; ++j) {
+                                int64_t p   = hipiv[ j ] - 1;
+                                int64_t ip  = p < piv_len ? 0 : 1;
+                                int64_t iip = p < piv_len ? p : p - piv_len;
+
+                                int64_t global_tile_index
+                                    = aux_pivot[ ip ][ iip ].tileIndex();
+                                int64_t global_offset
+                                    = aux_pivot[ ip ][ iip ].elementOffset();
+
+                                aux_pivot[ ip ][ iip ] = aux_pivot[ 0 ][ j ];
+
+                                aux_pivot[ 0 ][ j ] = AuxPivot<scalar_t>(
+                                    global_tile_index, global_offset,
+                                    ip, iip, hdiagu[ j ], A.mpiRank() );
+
+                                std::swap( perm[ j ], perm[ p ] );
+                            }
+
+                            // The original rows that won are the new
+                            // candidate block.
+                            for (int64_t j = 0; j < piv_len; ++j) {
+                                blas::copy( nb, &dW0[ perm[ j ] ], m2,
+                                            &dC[ j ], nb, *queue );
+                            }
+
+                            if (level == nlevels-1) {
+                                // Copy the last factorization back to panel tile
+                                Awork.tileGetForWriting( i1, 0, LayoutConvert( layout ));
+                                auto Awork_i1 = Awork( i1, 0 );
+                                blas::device_memcpy_2d<scalar_t>(
+                                        Awork_i1.data(), Awork_i1.stride(),
+                                        dW, m2,
+                                        piv_len, nb, *queue );
+                                queue->sync();
+                                permutation_to_sequential_pivot(
+                                    aux_pivot[ 0 ], diag_len, A.mt(), mb );
                             }
                         }
-                        if (level == nlevels-1) {
-                            // Copy the last factorization back to panel tile
-                            tile1.copyData( &work_tiles[ 0 ] );
-                            permutation_to_sequential_pivot(
-                                aux_pivot[ 0 ], diag_len, A.mt(), mb );
-                        }
+                    }
+                    else {
+                        // This is bottom, rank2, of the pair;
+                        // send candidate rows and pivot data to top, rank1.
+                        int rank1 = rank_rows[ index - step ].first;
+
+                        std::vector<scalar_t> hC( piv_len * nb );
+                        blas::device_memcpy_2d<scalar_t>(
+                                hC.data(), piv_len, dC, nb,
+                                piv_len, nb, *queue );
+                        queue->sync();
+
+                        MPI_Send( hC.data(), piv_len * nb, mpi_scalar,
+                                  rank1, 0, A.mpiComm() );
+                        MPI_Send( aux_pivot[ 0 ].data(),
+                                  sizeof(AuxPivot<scalar_t>) * aux_pivot[ 0 ].size(),
+                                  MPI_BYTE, rank1, 0, A.mpiComm() );
+
+                        // This rank's info is irrelevant;
+                        // the top rank will detect singularity.
+                        *info = 0;
+
+                        // This rank is done!
+                        break;
+                    }
+                    step *= 2;
+                } // for loop over levels
+            }
+            else {
+                int64_t step = 1;
+                for (int level = 0; level < nlevels; ++level) {
+                    if (index % (2*step) == 0) {
+                        if (index + step < nranks) {
+                            // This is the top, rank1, of the pair;
+                            // recv tile from bottom, rank2, and do LU factorization.
+                            int rank2  = rank_rows[ index+step ].first;
+                            int64_t i2 = rank_rows[ index+step ].second;
+                            int64_t i1 = rank_rows[ index ].second;
+
+                            Awork.tileRecv( i2, 0, rank2, layout );
+                            Awork.tileGetForWriting( i1, 0, LayoutConvert( layout ));
+
+                            MPI_Status status;
+                            MPI_Recv( aux_pivot[ 1 ].data(),
+                                      sizeof(AuxPivot<scalar_t>) * aux_pivot[ 1 ].size(),
+                                      MPI_BYTE, rank2, 0, A.mpiComm(),  &status );
+
+                            // Alocate workspace to copy tiles in the tree reduction.
+                            std::vector<scalar_t> data1( Awork.tileMb( i1 ) * nb );
+                            std::vector<scalar_t> data2( Awork.tileMb( i2 ) * nb );
+
+                            Tile<scalar_t> tile1( Awork.tileMb( i1 ), nb,
+                                                  &data1[ 0 ], Awork.tileMb( i1 ),
+                                                  slate::HostNum, TileKind::Workspace );
+                            Tile<scalar_t> tile2( Awork.tileMb( i2 ), nb,
+                                                  &data2[ 0 ], Awork.tileMb( i2 ),
+                                                  slate::HostNum, TileKind::Workspace );
+
+                            Awork( i1, 0 ).copyData( &tile1 );
+                            Awork( i2, 0 ).copyData( &tile2 );
+
+                            piv_len = std::min( tile1.mb(), nb );
+
+                            std::vector< Tile< scalar_t > > tmp_tiles;
+                            tmp_tiles.push_back( tile1 );
+                            tmp_tiles.push_back( tile2 );
+
+                            // Factor the panel locally in parallel.
+                            getrf_tntpiv_local(
+                                internal::TargetType<Target::HostTask>(),
+                                tmp_tiles, dwork_array, work_bytes, mlocal, device,
+                                queue, piv_len, ib, 1, mb, nb, tile_indices,
+                                aux_pivot, A.mpiRank(), max_panel_threads, priority,
+                                info );
+
+                            std::vector< Tile< scalar_t > > work_tiles;
+                            work_tiles.push_back( Awork( i1, 0 ) );
+                            work_tiles.push_back( Awork( i2, 0 ) );
+
+                            // Swap rows in tiles in Awork.
+                            // Swap (tile, row) (0, ii) and (ip, iip).
+
+                            for (int64_t ii = 0; ii < piv_len; ++ii) {
+                                int64_t ip  = aux_pivot[ 0 ][ ii ].localTileIndex();
+                                int64_t iip = aux_pivot[ 0 ][ ii ].localOffset();
+                                if (ip > 0 || iip > ii) {
+                                    swapLocalRow(
+                                        0, nb,
+                                        work_tiles[ 0  ], ii,
+                                        work_tiles[ ip ], iip );
+                                }
+                            }
+                            if (level == nlevels-1) {
+                                // Copy the last factorization back to panel tile
+                                tile1.copyData( &work_tiles[ 0 ] );
+                                permutation_to_sequential_pivot(
+                                    aux_pivot[ 0 ], diag_len, A.mt(), mb );
+                            }
 
-                        Awork.tileRelease( i2, 0 );
+                            Awork.tileRelease( i2, 0 );
+                        }
                     }
-                }
-                else {
-                    // This is bottom, rank2, of the pair;
-                    // send tile i2 and pivot data to top, rank1.
-                    int rank1  = rank_rows[ index - step ].first;
-                    int64_t i2 = rank_rows[ index ].second;
-                    Awork.tileSend( i2, 0, rank1 );
-
-                    MPI_Send( aux_pivot[ 0 ].data(),
-                              sizeof(AuxPivot<scalar_t>) * aux_pivot[ 0 ].size(),
-                              MPI_BYTE, rank1, 0, A.mpiComm() );
-
-                    // This rank's info is irrelevant;
-                    // the top rank will detect singularity.
-                    *info = 0;
-
-                    // This rank is done!
-                    break;
-                }
-                step *= 2;
-            } // for loop over levels
+                    else {
+                        // This is bottom, rank2, of the pair;
+                        // send tile i2 and pivot data to top, rank1.
+                        int rank1  = rank_rows[ index - step ].first;
+                        int64_t i2 = rank_rows[ index ].second;
+                        Awork.tileSend( i2, 0, rank1 );
+
+                        MPI_Send( aux_pivot[ 0 ].data(),
+                                  sizeof(AuxPivot<scalar_t>) * aux_pivot[ 0 ].size(),
+                                  MPI_BYTE, rank1, 0, A.mpiComm() );
+
+                        // This rank's info is irrelevant;
+                        // the top rank will detect singularity.
+                        *info = 0;
+
+                        // This rank is done!
+                        break;
+                    }
+                    step *= 2;
+                } // for loop over levels
+            }
         }
         else if (target == Target::Devices) {
             // Copy from contiguous memory back into workspace.
             // If no reduction is needed do not redo factorization.
-            Awork.tileGetForWriting( A_tiles_set, slate::HostNum, LayoutConvert::ColMajor );
-            temp_loc = 0;
-            for (int64_t i = 0; i < Awork.mt(); ++i) {
-                if (Awork.tileIsLocal( i, 0 )) {
-                    Tile Ai0 = Awork( i, 0 );
-                    blas::device_memcpy_2d<scalar_t>(
-                            Ai0.data(), Ai0.stride(),
-                            &dA[ temp_loc ], mlocal,
-                            Ai0.mb(), nb, *queue );
-                    temp_loc += Ai0.mb();
-                }
-            }
+            // Only the diagonal tile, at the top of dA, is used afterwards.
+            int64_t i0 = tile_indices[ 0 ];
+            Awork.tileGetForWriting( i0, 0, slate::HostNum, LayoutConvert::ColMajor );
+            Tile Ai0 = Awork( i0, 0 );
+            blas::device_memcpy_2d<scalar_t>(
+                    Ai0.data(), Ai0.stride(),
+                    dA, mlocal,
+                    Ai0.mb(), nb, *queue );
+            queue->sync();
         }
 
         // Copy pivot information from aux_pivot to pivot.
@@ -837,6 +1090,23 @@ void getrf_tntpiv_panel<Target::Devices, std::complex<double> >(
     std::vector<Pivot>& pivot,
     int max_panel_threads, int priority, int64_t* info );
 
+// ----------------------------------------
+template
+size_t getrf_tntpiv_tournament_work_bytes<float>(
+    int64_t nb, lapack::Queue& queue );
+
+template
+size_t getrf_tntpiv_tournament_work_bytes<double>(
+    int64_t nb, lapack::Queue& queue );
+
+template
+size_t getrf_tntpiv_tournament_work_bytes< std::complex<float> >(
+    int64_t nb, lapack::Queue& queue );
+
+template
+size_t getrf_tntpiv_tournament_work_bytes< std::complex<double> >(
+    int64_t nb, lapack::Queue& queue );
+
 } // namespace internal
 
 } // namespace slate
@@ -20,9 +20,10 @@ namespace internal {
 ///
 template <Target target, typename scalar_t>
 void hegst(int64_t itype, HermitianMatrix< scalar_t >&& A,
-                          HermitianMatrix< scalar_t >&& B)
+                          HermitianMatrix< scalar_t >&& B,
+           int64_t queue_index)
 {
-    hegst(internal::TargetType<target>(), itype, A, B);
+    hegst(internal::TargetType<target>(), itype, A, B, queue_index);
 }
 
 //------------------------------------------------------------------------------
@@ -33,7 +34,8 @@ void hegst(int64_t itype, HermitianMatrix< scalar_t >&& A,
 template <typename scalar_t>
 void hegst(internal::TargetType<Target::HostTask>,
            int64_t itype, HermitianMatrix<scalar_t>& A,
-                          HermitianMatrix<scalar_t>& B)
+                          HermitianMatrix<scalar_t>& B,
+           int64_t queue_index)
 {
     assert(A.mt() == 1);
     assert(A.nt() == 1);
@@ -47,31 +49,135 @@ void hegst(internal::TargetType<Target::HostTask>,
     }
 }
 
+//------------------------------------------------------------------------------
+/// Reduces a complex Hermitian positive-definite generalized eigenvalue problem
+/// to the standard form of single tile, GPU device implementation.
+/// There is no device hegst, so this expands A to a full Hermitian
+/// workspace W with hemm, applies the triangular factor B from both sides
+/// with trsm (itype = 1) or trmm (itype = 2, 3), then copies the
+/// lower or upper triangle of W back to A, all on the device of A.
+/// @ingroup hegv_internal
+///
+template <typename scalar_t>
+void hegst(internal::TargetType<Target::Devices>,
+           int64_t itype, HermitianMatrix<scalar_t>& A,
+                          HermitianMatrix<scalar_t>& B,
+           int64_t queue_index)
+{
+    const scalar_t zero = 0.0;
+    const scalar_t one  = 1.0;
+    const Layout layout = Layout::ColMajor;
+
+    assert(A.mt() == 1);
+    assert(A.nt() == 1);
+    assert(B.mt() == 1);
+    assert(B.nt() == 1);
+
+    if (A.tileIsLocal(0, 0)) {
+        int device = A.tileDevice( 0, 0 );
+        A.tileGetForWriting( 0, 0, device, LayoutConvert( layout ) );
+        B.tileGetForReading( 0, 0, device, LayoutConvert( layout ) );
+        blas::Queue* queue = A.compute_queue( device, queue_index );
+
+        auto A00 = A( 0, 0, device );
+        auto B00 = B( 0, 0, device );
+        int64_t n = A00.mb();
+        Uplo uplo = A00.uploPhysical();
+
+        // W = A, full Hermitian, from hemm with the identity I.
+        scalar_t* W = blas::device_malloc<scalar_t>( 2*n*n, *queue );
+        scalar_t* I = W + n*n;
+        device::geset( n, n, zero, one, I, n, *queue );
+        blas::hemm( layout, Side::Left, uplo, n, n,
+                    one,  A00.data(), A00.stride(),
+                          I, n,
+                    zero, W, n, *queue );
+
+        // itype = 1: W = L^{-1} W L^{-H}, or W = U^{-H} W U^{-1};
+        // itype = 2, 3: W = L^H W L, or W = U W U^H.
+        Op op_left = ((uplo == Uplo::Lower) == (itype == 1)
+                      ? Op::NoTrans : Op::ConjTrans);
+        Op op_right = (op_left == Op::NoTrans ? Op::ConjTrans : Op::NoTrans);
+        if (itype == 1) {
+            blas::trsm( layout, Side::Left, uplo, op_left, Diag::NonUnit,
+                        n, n, one, B00.data(), B00.stride(), W, n, *queue );
+            blas::trsm( layout, Side::Right, uplo, op_right, Diag::NonUnit,
+                        n, n, one, B00.data(), B00.stride(), W, n, *queue );
+        }
+        else {
+            blas::trmm( layout, Side::Left, uplo, op_left, Diag::NonUnit,
+                        n, n, one, B00.data(), B00.stride(), W, n, *queue );
+            blas::trmm( layout, Side::Right, uplo, op_right, Diag::NonUnit,
+                        n, n, one, B00.data(), B00.stride(), W, n, *queue );
+        }
+
+        // Copy back only the triangle of A, leaving the other untouched.
+        scalar_t** a_array_host = A.array_host( device, queue_index );
+        scalar_t** a_array_dev  = A.array_device( device, queue_index );
+        a_array_host[ 0 ] = W;
+        a_array_host[ 1 ] = A00.data();
+        A.batchArrayUpload( device, queue_index, a_array_host, 2, *queue );
+        device::tzcopy( uplo, n, n, a_array_dev, n,
+                        a_array_dev + 1, A00.stride(), 1, *queue );
+
+        queue->sync();
+        blas::device_free( W, *queue );
+    }
+}
+
 //------------------------------------------------------------------------------
 // Explicit instantiations.
 // ----------------------------------------
 template
 void hegst<Target::HostTask, float>(
     int64_t itype, HermitianMatrix<float>&& A,
-                   HermitianMatrix<float>&& B);
+                   HermitianMatrix<float>&& B,
+    int64_t queue_index);
+
+template
+void hegst<Target::Devices, float>(
+    int64_t itype, HermitianMatrix<float>&& A,
+                   HermitianMatrix<float>&& B,
+    int64_t queue_index);
 
 // ----------------------------------------
 template
 void hegst<Target::HostTask, double>(
     int64_t itype, HermitianMatrix<double>&& A,
-                   HermitianMatrix<double>&& B);
+                   HermitianMatrix<double>&& B,
+    int64_t queue_index);
+
+template
+void hegst<Target::Devices, double>(
+    int64_t itype, HermitianMatrix<double>&& A,
+                   HermitianMatrix<double>&& B,
+    int64_t queue_index);
 
 // ----------------------------------------
 template
 void hegst<Target::HostTask, std::complex<float>>(
     int64_t itype, HermitianMatrix<std::complex<float>>&& A,
-                   HermitianMatrix<std::complex<float>>&& B);
+                   HermitianMatrix<std::complex<float>>&& B,
+    int64_t queue_index);
+
+template
+void hegst<Target::Devices, std::complex<float>>(
+    int64_t itype, HermitianMatrix<std::complex<float>>&& A,
+                   HermitianMatrix<std::complex<float>>&& B,
+    int64_t queue_index);
 
 // ----------------------------------------
 template
 void hegst<Target::HostTask, std::complex<double>>(
     int64_t itype, HermitianMatrix<std::complex<double>>&& A,
-                   HermitianMatrix<std::complex<double>>&& B);
+                   HermitianMatrix<std::complex<double>>&& B,
+    int64_t queue_index);
+
+template
+void hegst<Target::Devices, std::complex<double>>(
+    int64_t itype, HermitianMatrix<std::complex<double>>&& A,
+                   HermitianMatrix<std::complex<double>>&& B,
+    int64_t queue_index);
 
 } // namespace internal
 } // namespace slate
@@ -27,7 +27,7 @@ void hemm(Side side,
           scalar_t alpha, HermitianMatrix<scalar_t>&& A,
                           Matrix<scalar_t>&& B,
           scalar_t beta,  Matrix<scalar_t>&& C,
-          int priority )
+          int priority, int64_t queue_index )
 {
     // check dimensions
     assert(A.mt() == 1);
@@ -48,7 +48,7 @@ void hemm(Side side,
          side,
          alpha, A, B,
          beta,  C,
-         priority );
+         priority, queue_index );
 }
 
 //------------------------------------------------------------------------------
@@ -62,7 +62,7 @@ void hemm(internal::TargetType<Target::HostTask>,
           scalar_t alpha, HermitianMatrix<scalar_t>& A,
                           Matrix<scalar_t>& B,
           scalar_t beta,  Matrix<scalar_t>& C,
-          int priority )
+          int priority, int64_t queue_index )
 {
     // CPU uses ColMajor
     // todo: relax this assumption, by allowing Tile_blas.hh::hemm() to take layout param
@@ -137,7 +137,7 @@ void hemm(internal::TargetType<Target::HostNest>,
           scalar_t alpha, HermitianMatrix<scalar_t>& A,
                           Matrix<scalar_t>& B,
           scalar_t beta,  Matrix<scalar_t>& C,
-          int priority )
+          int priority, int64_t queue_index )
 {
     // CPU uses ColMajor
     // todo: relax this assumption, by allowing Tile_blas.hh::hemm() to take layout param
@@ -192,6 +192,93 @@ void hemm(internal::TargetType<Target::HostNest>,
         throw std::exception();
 }
 
+//------------------------------------------------------------------------------
+/// Hermitian matrix multiply to update trailing matrix.
+/// GPU device implementation: one task per device updates its tiles of C on
+/// one queue, then syncs once.
+/// @ingroup hemm_internal
+///
+template <typename scalar_t>
+void hemm(internal::TargetType<Target::Devices>,
+          Side side,
+          scalar_t alpha, HermitianMatrix<scalar_t>& A,
+                          Matrix<scalar_t>& B,
+          scalar_t beta,  Matrix<scalar_t>& C,
+          int priority, int64_t queue_index )
+{
+    using blas::conj;
+    using ij_tuple = typename BaseMatrix<scalar_t>::ij_tuple;
+
+    // GPU assumes column major
+    const Layout layout = Layout::ColMajor;
+
+    assert(C.num_devices() > 0);
+    assert(A.op() != Op::Trans);
+    assert(B.op() != Op::Trans);
+
+    // A.op can be ignored, since A == A^H.
+    // If op(B) = op(C) = ConjTrans, undo the transpose by swapping
+    // left <=> right, m <=> n, and conjugating alpha and beta.
+    Side sideA = side;
+    if (C.op() != Op::NoTrans) {
+        sideA = (side == Side::Left ? Side::Right : Side::Left);
+        alpha = conj( alpha );
+        beta  = conj( beta );
+    }
+
+    int err = 0;
+    #pragma omp taskgroup
+    for (int device = 0; device < C.num_devices(); ++device) {
+        #pragma omp task slate_omp_default_none \
+            shared( A, B, C, err ) priority( priority ) \
+            firstprivate( device, sideA, alpha, beta ) \
+            firstprivate( queue_index, layout )
+        {
+            try {
+                std::set<ij_tuple> C_tiles_set;
+                for (int64_t i = 0; i < C.mt(); ++i) {
+                    for (int64_t j = 0; j < C.nt(); ++j) {
+                        if (C.tileIsLocal( i, j )
+                            && device == C.tileDevice( i, j )) {
+                            C_tiles_set.insert( { i, j } );
+                        }
+                    }
+                }
+
+                if (C_tiles_set.size() > 0) {
+                    A.tileGetForReading( 0, 0, device, LayoutConvert( layout ) );
+                    B.tileGetForReading( C_tiles_set, device, LayoutConvert( layout ) );
+                    C.tileGetForWriting( C_tiles_set, device, LayoutConvert( layout ) );
+
+                    blas::Queue* queue = C.compute_queue( device, queue_index );
+                    auto A00 = A( 0, 0, device );
+                    for (auto ij : C_tiles_set) {
+                        int64_t i = std::get<0>( ij );
+                        int64_t j = std::get<1>( ij );
+                        auto Bij = B( i, j, device );
+                        auto Cij = C( i, j, device );
+                        // Physical dimensions of C(i, j).
+                        int64_t m = (C.op() == Op::NoTrans ? Cij.mb() : Cij.nb());
+                        int64_t n = (C.op() == Op::NoTrans ? Cij.nb() : Cij.mb());
+                        blas::hemm(
+                            layout, sideA, A00.uploPhysical(), m, n,
+                            alpha, A00.data(), A00.stride(),
+                                   Bij.data(), Bij.stride(),
+                            beta,  Cij.data(), Cij.stride(), *queue );
+                    }
+                    queue->sync();
+                }
+            }
+            catch (std::exception& e) {
+                err = __LINE__;
+            }
+        }
+    }
+
+    if (err)
+        throw std::exception();
+}
+
 //------------------------------------------------------------------------------
 // Explicit instantiations.
 // ----------------------------------------
@@ -201,7 +288,7 @@ void hemm< Target::HostTask, float >(
     float alpha, HermitianMatrix<float>&& A,
                  Matrix<float>&& B,
     float beta,  Matrix<float>&& C,
-    int priority );
+    int priority, int64_t queue_index );
 
 template
 void hemm<Target::HostNest, float>(
@@ -209,7 +296,15 @@ void hemm<Target::HostNest, float>(
     float alpha, HermitianMatrix<float>&& A,
                  Matrix<float>&& B,
     float beta,  Matrix<float>&& C,
-    int priority );
+    int priority, int64_t queue_index );
+
+template
+void hemm<Target::Devices, float>(
+    Side side,
+    float alpha, HermitianMatrix<float>&& A,
+                 Matrix<float>&& B,
+    float beta,  Matrix<float>&& C,
+    int priority, int64_t queue_index );
 
 // ----------------------------------------
 template
@@ -218,7 +313,7 @@ void hemm<Target::HostTask, double>(
     double alpha, HermitianMatrix<double>&& A,
                   Matrix<double>&& B,
     double beta,  Matrix<double>&& C,
-    int priority );
+    int priority, int64_t queue_index );
 
 template
 void hemm<Target::HostNest, double>(
@@ -226,7 +321,15 @@ void hemm<Target::HostNest, double>(
     double alpha, HermitianMatrix<double>&& A,
                   Matrix<double>&& B,
     double beta,  Matrix<double>&& C,
-    int priority );
+    int priority, int64_t queue_index );
+
+template
+void hemm<Target::Devices, double>(
+    Side side,
+    double alpha, HermitianMatrix<double>&& A,
+                  Matrix<double>&& B,
+    double beta,  Matrix<double>&& C,
+    int priority, int64_t queue_index );
 
 // ----------------------------------------
 template
@@ -235,7 +338,7 @@ void hemm< Target::HostTask, std::complex<float> >(
     std::complex<float> alpha, HermitianMatrix< std::complex<float> >&& A,
                                Matrix< std::complex<float> >&& B,
     std::complex<float> beta,  Matrix< std::complex<float> >&& C,
-    int priority );
+    int priority, int64_t queue_index );
 
 template
 void hemm< Target::HostNest, std::complex<float> >(
@@ -243,7 +346,15 @@ void hemm< Target::HostNest, std::complex<float> >(
     std::complex<float> alpha, HermitianMatrix< std::complex<float> >&& A,
                                Matrix< std::complex<float> >&& B,
     std::complex<float> beta,  Matrix< std::complex<float> >&& C,
-    int priority );
+    int priority, int64_t queue_index );
+
+template
+void hemm< Target::Devices, std::complex<float> >(
+    Side side,
+    std::complex<float> alpha, HermitianMatrix< std::complex<float> >&& A,
+                               Matrix< std::complex<float> >&& B,
+    std::complex<float> beta,  Matrix< std::complex<float> >&& C,
+    int priority, int64_t queue_index );
 
 // ----------------------------------------
 template
@@ -252,7 +363,7 @@ void hemm< Target::HostTask, std::complex<double> >(
     std::complex<double> alpha, HermitianMatrix< std::complex<double> >&& A,
                                 Matrix< std::complex<double> >&& B,
     std::complex<double> beta,  Matrix< std::complex<double> >&& C,
-    int priority );
+    int priority, int64_t queue_index );
 
 template
 void hemm< Target::HostNest, std::complex<double> >(
@@ -260,7 +371,15 @@ void hemm< Target::HostNest, std::complex<double> >(
     std::complex<double> alpha, HermitianMatrix< std::complex<double> >&& A,
                                 Matrix< std::complex<double> >&& B,
     std::complex<double> beta,  Matrix< std::complex<double> >&& C,
-    int priority );
+    int priority, int64_t queue_index );
+
+template
+void hemm< Target::Devices, std::complex<double> >(
+    Side side,
+    std::complex<double> alpha, HermitianMatrix< std::complex<double> >&& A,
+                                Matrix< std::complex<double> >&& B,
+    std::complex<double> beta,  Matrix< std::complex<double> >&& C,
+    int priority, int64_t queue_index );
 
 } // namespace internal
 } // namespace slate
@@ -227,7 +227,6 @@ void her2k(internal::TargetType<Target::HostBatch>,
            blas::real_type<scalar_t> beta, HermitianMatrix<scalar_t>& C,
            int priority, int queue_index, Layout layout )
 {
-#ifdef BLAS_HAVE_MKL
     using blas::conj;
 
     // CPU assumes column major
@@ -293,11 +292,9 @@ void her2k(internal::TargetType<Target::HostBatch>,
         Op opB = (opA == Op::NoTrans ? Op::ConjTrans : Op::NoTrans);
 
         // all same
-        std::vector<CBLAS_TRANSPOSE> opA_array(batch_count,
-                                               cblas_trans_const(opA));
+        std::vector<Op> opA_array(batch_count, opA);
         // all same
-        std::vector<CBLAS_TRANSPOSE> opB_array(batch_count,
-                                               cblas_trans_const(opB));
+        std::vector<Op> opB_array(batch_count, opB);
         std::vector<int> m_array(batch_count);
         std::vector<int> n_array(batch_count);
         std::vector<int> k_array(batch_count);
@@ -356,19 +353,18 @@ void her2k(internal::TargetType<Target::HostBatch>,
         }
 
         {
-            trace::Block trace_block("cblas_gemm_batch");
+            trace::Block trace_block("host_gemm_batch");
             const scalar_t one = 1.0;
 
-            // mkl_set_num_threads_local(...);
-            cblas_gemm_batch(CblasColMajor,
-                             opA_array.data(), opB_array.data(),
-                             m_array.data(), n_array.data(), k_array.data(),
-                             alpha_array.data(),
-                             ai_array.data(), ldai_array.data(),
-                             bj_array.data(), ldbj_array.data(),
-                             beta_array.data(),
-                             c_array.data(), ldc_array.data(),
-                             batch_count, group_size.data());
+            host_gemm_batch(Layout::ColMajor,
+                            opA_array.data(), opB_array.data(),
+                            m_array.data(), n_array.data(), k_array.data(),
+                            alpha_array.data(),
+                            ai_array.data(), ldai_array.data(),
+                            bj_array.data(), ldbj_array.data(),
+                            beta_array.data(),
+                            c_array.data(), ldc_array.data(),
+                            batch_count, group_size.data());
 
             // ai => bi, bj => aj, conjugate alpha, set beta = 1
             if (is_complex<scalar_t>::value) {
@@ -376,16 +372,15 @@ void her2k(internal::TargetType<Target::HostBatch>,
                           alpha_array.end(), conj(alpha));
             }
             std::fill( beta_array.begin(), beta_array.end(), one );
-            cblas_gemm_batch(CblasColMajor,
-                             opA_array.data(), opB_array.data(),
-                             m_array.data(), n_array.data(), k_array.data(),
-                             alpha_array.data(),
-                             bi_array.data(), ldbi_array.data(),
-                             aj_array.data(), ldaj_array.data(),
-                             beta_array.data(),
-                             c_array.data(), ldc_array.data(),
-                             batch_count, group_size.data());
-            // mkl_set_num_threads_local(1);
+            host_gemm_batch(Layout::ColMajor,
+                            opA_array.data(), opB_array.data(),
+                            m_array.data(), n_array.data(), k_array.data(),
+                            alpha_array.data(),
+                            bi_array.data(), ldbi_array.data(),
+                            aj_array.data(), ldaj_array.data(),
+                            beta_array.data(),
+                            c_array.data(), ldc_array.data(),
+                            batch_count, group_size.data());
         }
     }
 
@@ -393,10 +388,6 @@ void her2k(internal::TargetType<Target::HostBatch>,
 
     if (err)
         throw std::exception();
-#else
-    slate_not_implemented(
-        "slate::Target::HostBatch needs Intel MKL.");
-#endif
 }
 
 //------------------------------------------------------------------------------
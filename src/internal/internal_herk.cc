@@ -9,6 +9,7 @@
 #include "slate/Tile_blas.hh"
 #include "internal/internal.hh"
 #include "internal/internal_batch.hh"
+#include "internal/internal_util.hh"
 
 namespace slate {
 namespace internal {
@@ -18,6 +19,9 @@ namespace internal {
 /// Dispatches to target implementations.
 /// C is Lower, NoTrans or Upper, Trans/ConjTrans.
 /// In complex case, A and C cannot be Trans.
+/// Tiles C(i, j) where A(i, 0) or A(j, 0) is structurally zero are skipped,
+/// apart from scaling by beta, and fill-in of zero tiles of C is recorded;
+/// @see BaseMatrix::trackZeroTiles.
 /// @ingroup herk_internal
 ///
 template <Target target, typename scalar_t>
@@ -52,23 +56,31 @@ void herk(internal::TargetType<Target::HostTask>,
     scalar_t alpha_ = scalar_t(alpha);
     scalar_t beta_  = scalar_t(beta);
 
-    // CPU assumes column major
-    // todo: relax this assumption, by updating Tile_blas.hh::herk()
-    //       to operate in row major
-    // todo: optimize for the number of layout conversions,
-    //       by watching 'layout' and 'C(i, j).layout()'
-    assert(layout == Layout::ColMajor);
+    // Tiles are computed on in layout, ColMajor or RowMajor.
+
+    // Skip C(i, j) if A(i, 0) or A(j, 0) is structurally zero.
+    bool skip_zero = A.zeroTilesTracked();
+    auto skipped = [&]( int64_t i, int64_t j ) {
+        return skip_zero && (A.tileIsZero( i, 0 ) || A.tileIsZero( j, 0 ));
+    };
 
     // Lower, NoTrans
     int err = 0;
     #pragma omp taskgroup
     for (int64_t j = 0; j < C.nt(); ++j) {
         for (int64_t i = j; i < C.mt(); ++i) {  // lower
-            if (C.tileIsLocal(i, j)) {
+            if (C.tileIsLocal(i, j) && ! skipped( i, j )) {
+                // Hint to run near C(i, j), e.g., in its NUMA domain.
+                scalar_t* Cij = nullptr;
+                if (C.tileExists( i, j ))
+                    Cij = C( i, j ).data();
+                SLATE_UNUSED( Cij ); // Used only by OpenMP 5.0 affinity
+
                 if (i == j) {
                     #pragma omp task slate_omp_default_none \
                         shared( A, C, err ) priority( priority ) \
-                        firstprivate( j, layout, alpha, beta )
+                        firstprivate( j, layout, alpha, beta, Cij ) \
+                        slate_omp_affinity( Cij[ 0:1 ] )
                     {
                         try {
                             A.tileGetForReading(j, 0, LayoutConvert(layout));
@@ -85,7 +97,8 @@ void herk(internal::TargetType<Target::HostTask>,
                 else {
                     #pragma omp task slate_omp_default_none \
                         shared( A, C, err ) priority( priority ) \
-                        firstprivate( i, j, layout, alpha_, beta_ )
+                        firstprivate( i, j, layout, alpha_, beta_, Cij ) \
+                        slate_omp_affinity( Cij[ 0:1 ] )
                     {
                         try {
                             A.tileGetForReading(i, 0, LayoutConvert(layout));
@@ -107,6 +120,9 @@ void herk(internal::TargetType<Target::HostTask>,
 
     if (err)
         throw std::exception();
+
+    if (skip_zero || C.zeroTilesTracked())
+        zero_tiles_update( scalar_t( beta ), C, true, skipped );
 }
 
 //------------------------------------------------------------------------------
@@ -128,18 +144,19 @@ void herk(internal::TargetType<Target::HostNest>,
     scalar_t alpha_ = scalar_t(alpha);
     scalar_t beta_  = scalar_t(beta);
 
-    // CPU assumes column major
-    // todo: relax this assumption, by allowing Tile_blas.hh::herk()
-    //       to take layout param
-    // todo: optimize for the number of layout conversions,
-    //       by watching 'layout' and 'C(i, j).layout()'
-    assert(layout == Layout::ColMajor);
+    // Tiles are computed on in layout, ColMajor or RowMajor.
+
+    // Skip C(i, j) if A(i, 0) or A(j, 0) is structurally zero.
+    bool skip_zero = A.zeroTilesTracked();
+    auto skipped = [&]( int64_t i, int64_t j ) {
+        return skip_zero && (A.tileIsZero( i, 0 ) || A.tileIsZero( j, 0 ));
+    };
 
     // Lower, NoTrans
     int err = 0;
     #pragma omp taskgroup
     for (int64_t j = 0; j < C.nt(); ++j) {
-        if (C.tileIsLocal(j, j)) {
+        if (C.tileIsLocal(j, j) && ! skipped( j, j )) {
             #pragma omp task slate_omp_default_none \
                 shared( A, C, err ) \
                 firstprivate( j, layout, alpha, beta )
@@ -163,11 +180,12 @@ void herk(internal::TargetType<Target::HostNest>,
 
     // #pragma omp parallel for collapse(2) schedule(dynamic, 1) num_threads(...) default(none)
     #pragma omp parallel for collapse(2) schedule(dynamic, 1) slate_omp_default_none \
-        shared( A, C, err ) firstprivate( C_nt, C_mt, layout, beta_, alpha_ )
+        shared( A, C, err, skipped ) \
+        firstprivate( C_nt, C_mt, layout, beta_, alpha_ )
     for (int64_t j = 0; j < C_nt; ++j) {
         for (int64_t i = 0; i < C_mt; ++i) {  // full
             if (i >= j+1) {                    // strictly lower
-                if (C.tileIsLocal(i, j)) {
+                if (C.tileIsLocal(i, j) && ! skipped( i, j )) {
                     try {
                         A.tileGetForReading(i, 0, LayoutConvert(layout));
                         A.tileGetForReading(j, 0, LayoutConvert(layout));
@@ -187,6 +205,9 @@ void herk(internal::TargetType<Target::HostNest>,
 
     if (err)
         throw std::exception();
+
+    if (skip_zero || C.zeroTilesTracked())
+        zero_tiles_update( scalar_t( beta ), C, true, skipped );
 #endif // omit if SLATE_HAVE_OMPTARGET
 }
 
@@ -202,7 +223,6 @@ void herk(internal::TargetType<Target::HostBatch>,
           blas::real_type<scalar_t> beta,  HermitianMatrix<scalar_t>& C,
           int priority, int queue_index, Layout layout )
 {
-#ifdef BLAS_HAVE_MKL
     // CPU assumes column major
     // todo: relax this assumption, by allowing Tile_blas.hh::herk()
     //       to take layout param
@@ -210,11 +230,17 @@ void herk(internal::TargetType<Target::HostBatch>,
     //       by watching 'layout' and 'C(i, j).layout()'
     assert(layout == Layout::ColMajor);
 
+    // Skip C(i, j) if A(i, 0) or A(j, 0) is structurally zero.
+    bool skip_zero = A.zeroTilesTracked();
+    auto skipped = [&]( int64_t i, int64_t j ) {
+        return skip_zero && (A.tileIsZero( i, 0 ) || A.tileIsZero( j, 0 ));
+    };
+
     // diagonal tiles by herk on host
     int err = 0;
     #pragma omp taskgroup
     for (int64_t j = 0; j < C.nt(); ++j) {
-        if (C.tileIsLocal(j, j)) {
+        if (C.tileIsLocal(j, j) && ! skipped( j, j )) {
             #pragma omp task slate_omp_default_none \
                 shared( A, C, err ) firstprivate( j, layout, alpha, beta )
             {
@@ -238,7 +264,7 @@ void herk(internal::TargetType<Target::HostBatch>,
     int batch_count = 0;
     for (int64_t j = 0; j < C.nt(); ++j) {
         for (int64_t i = j+1; i < C.mt(); ++i) {  // strictly lower
-            if (C.tileIsLocal(i, j)) {
+            if (C.tileIsLocal(i, j) && ! skipped( i, j )) {
                 // todo: omp task?
                 A.tileGetForReading(i, 0, LayoutConvert(layout));
                 A.tileGetForReading(j, 0, LayoutConvert(layout));
@@ -266,11 +292,9 @@ void herk(internal::TargetType<Target::HostBatch>,
         Op opB = (opA == Op::NoTrans ? Op::ConjTrans : Op::NoTrans);
 
         // all same
-        std::vector<CBLAS_TRANSPOSE> opA_array(batch_count,
-                                               cblas_trans_const(opA));
+        std::vector<Op> opA_array(batch_count, opA);
         // all same
-        std::vector<CBLAS_TRANSPOSE> opB_array(batch_count,
-                                               cblas_trans_const(opB));
+        std::vector<Op> opB_array(batch_count, opB);
         std::vector<int> m_array(batch_count);
         std::vector<int> n_array(batch_count);
         std::vector<int> k_array(batch_count);
@@ -287,7 +311,7 @@ void herk(internal::TargetType<Target::HostBatch>,
         int index = 0;
         for (int64_t j = 0; j < C.nt(); ++j) {
             for (int64_t i = j+1; i < C.mt(); ++i) {  // strictly lower
-                if (C.tileIsLocal(i, j)) {
+                if (C.tileIsLocal(i, j) && ! skipped( i, j )) {
                     m_array[index] = C(i, j).mb();
                     n_array[index] = C(i, j).nb();
                     k_array[index] = A(i, 0).nb();  // should be all same
@@ -318,27 +342,24 @@ void herk(internal::TargetType<Target::HostBatch>,
         }
 
         {
-            trace::Block trace_block("cblas_gemm_batch");
-            // mkl_set_num_threads_local(...);
-            cblas_gemm_batch(CblasColMajor,
-                             opA_array.data(), opB_array.data(),
-                             m_array.data(), n_array.data(), k_array.data(),
-                             alpha_array.data(),
-                             a_array.data(), lda_array.data(),
-                             b_array.data(), ldb_array.data(),
-                             beta_array.data(),
-                             c_array.data(), ldc_array.data(),
-                             batch_count, group_size.data());
-            // mkl_set_num_threads_local(1);
+            trace::Block trace_block("host_gemm_batch");
+            host_gemm_batch(Layout::ColMajor,
+                            opA_array.data(), opB_array.data(),
+                            m_array.data(), n_array.data(), k_array.data(),
+                            alpha_array.data(),
+                            a_array.data(), lda_array.data(),
+                            b_array.data(), ldb_array.data(),
+                            beta_array.data(),
+                            c_array.data(), ldc_array.data(),
+                            batch_count, group_size.data());
         }
     }
 
     if (err)
         throw std::exception();
-#else
-    slate_not_implemented(
-        "slate::Target::HostBatch needs Intel MKL.");
-#endif
+
+    if (skip_zero || C.zeroTilesTracked())
+        zero_tiles_update( scalar_t( beta ), C, true, skipped );
 }
 
 //------------------------------------------------------------------------------
@@ -360,15 +381,23 @@ void herk(internal::TargetType<Target::Devices>,
 
     assert(C.num_devices() > 0);
 
+    // Skip C(i, j) if A(i, 0) or A(j, 0) is structurally zero.
+    bool skip_zero = A.zeroTilesTracked();
+    auto skipped = [&]( int64_t i, int64_t j ) {
+        return skip_zero && (A.tileIsZero( i, 0 ) || A.tileIsZero( j, 0 ));
+    };
+
     // if single tile, avoid creating tasks for all devices
     #pragma omp taskgroup
     if (C.nt() == 1) {
-        if (C.tileIsLocal(0, 0)) {
+        if (C.tileIsLocal(0, 0) && ! skipped( 0, 0 )) {
             #pragma omp task slate_omp_default_none \
                 shared( A, C, err ) priority( priority ) \
                 firstprivate( layout, queue_index, alpha, beta )
             {
                 int device = C.tileDevice(0, 0);
+                A.tileCachePin( { { 0, 0 } }, device );
+                C.tileCachePin( { { 0, 0 } }, device );
                 A.tileGetForReading(0, 0, device, LayoutConvert(layout));
                 C.tileGetForWriting(0, 0, device, LayoutConvert(layout));
 
@@ -384,15 +413,34 @@ void herk(internal::TargetType<Target::Devices>,
                     beta,  C00.data(), C00.stride(), *queue);
 
                 queue->sync();
+                A.tileCacheUnpin( { { 0, 0 } }, device );
+                C.tileCacheUnpin( { { 0, 0 } }, device );
             }
         }
     }
     else {
+        // With device stealing, balance the tiles across devices.
+        std::map< ij_tuple, int > assigned;
+        std::function<int (int64_t, int64_t)> tile_device;
+        if (C.deviceStealing() && C.num_devices() > 1) {
+            std::vector< ij_tuple > tiles;
+            for (int64_t j = 0; j < C.nt(); ++j) {
+                for (int64_t i = j; i < C.mt(); ++i) {  // lower
+                    if (C.tileIsLocal( i, j ) && ! skipped( i, j ))
+                        tiles.push_back( { i, j } );
+                }
+            }
+            assigned = device_steal_assign( C, tiles );
+            tile_device = [&assigned]( int64_t i, int64_t j ) {
+                return assigned.at( { i, j } );
+            };
+        }
+
         // off-diagonal tiles by batch gemm on device
         // diagonal tiles by herk on device
         for (int device = 0; device < C.num_devices(); ++device) {
             #pragma omp task slate_omp_default_none \
-                shared( A, C, err ) priority( priority ) \
+                shared( A, C, err, skipped, tile_device ) priority( priority ) \
                 firstprivate( layout, queue_index, device, alpha, beta )
             {
                 try {
@@ -416,7 +464,9 @@ void herk(internal::TargetType<Target::Devices>,
                     for (int64_t j = 0; j < C.nt(); ++j) {
                         for (int64_t i = j; i < C.mt(); ++i) {  // lower
                             if (C.tileIsLocal(i, j)
-                                && device == C.tileDevice(i, j)) {
+                                && device == (tile_device ? tile_device( i, j )
+                                                          : C.tileDevice( i, j ))
+                                && ! skipped( i, j )) {
                                 A_tiles_set.insert({j, 0});
                                 C_tiles_set.insert({i, j});
                                 if (i != j) {
@@ -426,6 +476,10 @@ void herk(internal::TargetType<Target::Devices>,
                         }
                     }
 
+                    // Keep the tile cache from evicting tiles until kernels finish.
+                    A.tileCachePin( A_tiles_set, device );
+                    C.tileCachePin( C_tiles_set, device );
+
                     #pragma omp taskgroup
                     {
                         #pragma omp task slate_omp_default_none \
@@ -452,10 +506,10 @@ void herk(internal::TargetType<Target::Devices>,
                     auto AT = conj_transpose(A);
 
                     // C comes first since we do computation for a local C
-                    auto group_params = device_regions_build<true, 3, scalar_t>(
+                    auto group_params = device_regions_build<true, 3, scalar_t, false, true>(
                             {C, A, AT},
                             {c_array_host, a_array_host, b_array_host},
-                            device );
+                            device, {}, tile_device );
 
                     if (C.op() != Op::NoTrans) {
                         swap(opA, opB);
@@ -476,10 +530,14 @@ void herk(internal::TargetType<Target::Devices>,
                         std::vector<Uplo> uplo(1, C.uploPhysical());
 
                         blas::Queue* queue = C.compute_queue(device, queue_index);
+                        trace::DeviceBlock trace_device(
+                            "blas::batch::herk", *queue);
 
                         for (size_t g = 0; g < group_params.size(); ++g) {
 
                             int64_t group_count = group_params[ g ].count;
+                            internal::count( internal::Count::BatchLaunches );
+                            internal::count( internal::Count::BatchTiles, group_count );
 
                             std::vector<int64_t>    n(1, group_params[ g ].nb);
                             std::vector<int64_t> ldda(1, group_params[ g ].ld[1]);
@@ -487,7 +545,19 @@ void herk(internal::TargetType<Target::Devices>,
                             std::vector<scalar_t*> a_array(a_array_host, a_array_host+group_count);
                             std::vector<scalar_t*> c_array(c_array_host, c_array_host+group_count);
 
-                            if (group_params[ g ].is_diagonal) {
+                            if (group_params[ g ].is_diagonal
+                                && group_count > 1
+                                && layout == Layout::ColMajor) {
+                                // One vendor herk per tile would
+                                // serialize the diagonal tiles.
+                                device_herk_diag(
+                                    uplo[ 0 ], opA, opB, n[ 0 ], k[ 0 ],
+                                    alpha_s[ 0 ], a_array, ldda[ 0 ],
+                                    beta_s[ 0 ],  c_array, lddc[ 0 ],
+                                    C, device, queue_index, batch_size,
+                                    *queue );
+                            }
+                            else if (group_params[ g ].is_diagonal) {
                                 blas::batch::herk(
                                     layout, uplo, opA_,
                                     n, k,
@@ -522,6 +592,8 @@ void herk(internal::TargetType<Target::Devices>,
 
                         queue->sync();
                     }
+                    A.tileCacheUnpin( A_tiles_set, device );
+                    C.tileCacheUnpin( C_tiles_set, device );
                 }
                 catch (std::exception& e) {
                     err = __LINE__;
@@ -532,6 +604,9 @@ void herk(internal::TargetType<Target::Devices>,
 
     if (err)
         slate_error(std::to_string(err));
+
+    if (skip_zero || C.zeroTilesTracked())
+        zero_tiles_update( scalar_t( beta ), C, true, skipped );
 }
 
 //------------------------------------------------------------------------------
@@ -61,7 +61,10 @@ void hettmqr(
 //------------------------------------------------------------------------------
 /// Distributed multiply Hermitian matrix on left and right by Q from
 /// QR triangle-triangle factorization of column of tiles.
-/// Host implementation.
+/// The Hermitian 2-by-2 diagonal block updates are done on the host.
+/// The off-diagonal tile-pair updates are done on the host or, for
+/// target = Devices, on the device of the local tile of C, so those tiles
+/// move to the host only to be sent to other ranks.
 /// @ingroup heev_internal
 ///
 /// @param[in] tag_base
@@ -69,7 +72,7 @@ void hettmqr(
 ///
 template <typename scalar_t>
 void hettmqr(
-    internal::TargetType<Target::HostTask>,
+    Target target,
     Op op,
     Matrix<scalar_t>& V,
     Matrix<scalar_t>& T,
@@ -241,6 +244,7 @@ void hettmqr(
                     }
                     else {
                         // Send transposed tile.
+                        C.tileGetForWriting(j, i1, HostNum, LayoutConvert(layout));
                         tile::deepConjTranspose( C(j, i1) );
                         C.tileSend(j, i1, dst, tag);
                     }
@@ -262,16 +266,27 @@ void hettmqr(
                     // Applies Q, then sends updated tile back.
                     #pragma omp task shared(V, T, C)
                     {
-                        V.tileGetForReading(i2, 0, LayoutConvert(layout));
-                        T.tileGetForReading(i2, 0, LayoutConvert(layout));
-                        C.tileGetForWriting(i2, j, LayoutConvert(layout));
-
                         // Multiply op(Q) * [ C(i1, j) ].
                         //                  [ C(i2, j) ]
-                        tile::tpmqrt( Side::Left, op,
-                                      std::min( V.tileMb( i2 ), V.tileNb( 0 ) ),
-                                      V( i2, 0 ), T( i2, 0 ),
-                                      C( i1, j ), C( i2, j ) );
+                        if (target == Target::Devices) {
+                            int device = C.tileDevice(i2, j);
+                            V.tileGetForReading(i2, 0, device, LayoutConvert(layout));
+                            T.tileGetForReading(i2, 0, device, LayoutConvert(layout));
+                            C.tileGetForWriting(i2, j, device, LayoutConvert(layout));
+                            C.tileGetForWriting(i1, j, device, LayoutConvert(layout));
+                            tpmqrt_device( Side::Left, op, V, T, i2,
+                                           C, i1, j, i2, j, device, 0 );
+                        }
+                        else {
+                            V.tileGetForReading(i2, 0, LayoutConvert(layout));
+                            T.tileGetForReading(i2, 0, LayoutConvert(layout));
+                            C.tileGetForWriting(i2, j, LayoutConvert(layout));
+
+                            tile::tpmqrt( Side::Left, op,
+                                          std::min( V.tileMb( i2 ), V.tileNb( 0 ) ),
+                                          V( i2, 0 ), T( i2, 0 ),
+                                          C( i1, j ), C( i2, j ) );
+                        }
 
                         // Sends updated tile back.
                         int src = (i1 >= j
@@ -328,15 +343,26 @@ void hettmqr(
                     // Applies Q, then sends updated tile back.
                     #pragma omp task shared( V, T, C ) firstprivate( src, tag )
                     {
-                        V.tileGetForReading(j2, 0, LayoutConvert(layout));
-                        T.tileGetForReading(j2, 0, LayoutConvert(layout));
-                        C.tileGetForWriting(i, j2, LayoutConvert(layout));
-
                         // Multiply [ C(i, j1) C(i, j2) ] * opR(Q).
-                        tile::tpmqrt( Side::Right, opR,
-                                      std::min( V.tileMb( j2 ), V.tileNb( 0 ) ),
-                                      V( j2, 0 ), T( j2, 0 ),
-                                      C( i, j1 ), C( i, j2 ) );
+                        if (target == Target::Devices) {
+                            int device = C.tileDevice(i, j2);
+                            V.tileGetForReading(j2, 0, device, LayoutConvert(layout));
+                            T.tileGetForReading(j2, 0, device, LayoutConvert(layout));
+                            C.tileGetForWriting(i, j2, device, LayoutConvert(layout));
+                            C.tileGetForWriting(i, j1, device, LayoutConvert(layout));
+                            tpmqrt_device( Side::Right, opR, V, T, j2,
+                                           C, i, j1, i, j2, device, 0 );
+                        }
+                        else {
+                            V.tileGetForReading(j2, 0, LayoutConvert(layout));
+                            T.tileGetForReading(j2, 0, LayoutConvert(layout));
+                            C.tileGetForWriting(i, j2, LayoutConvert(layout));
+
+                            tile::tpmqrt( Side::Right, opR,
+                                          std::min( V.tileMb( j2 ), V.tileNb( 0 ) ),
+                                          V( j2, 0 ), T( j2, 0 ),
+                                          C( i, j1 ), C( i, j2 ) );
+                        }
 
                         C.tileSend(i, j1, src, tag);
                     }
@@ -367,6 +393,44 @@ void hettmqr(
     } // for level
 }
 
+//------------------------------------------------------------------------------
+/// Distributed multiply Hermitian matrix on left and right by Q from
+/// QR triangle-triangle factorization of column of tiles.
+/// Host implementation.
+/// @ingroup heev_internal
+///
+template <typename scalar_t>
+void hettmqr(
+    internal::TargetType<Target::HostTask>,
+    Op op,
+    Matrix<scalar_t>& V,
+    Matrix<scalar_t>& T,
+    HermitianMatrix<scalar_t>& C,
+    int tag_base )
+{
+    hettmqr( Target::HostTask, op, V, T, C, tag_base );
+}
+
+//------------------------------------------------------------------------------
+/// Distributed multiply Hermitian matrix on left and right by Q from
+/// QR triangle-triangle factorization of column of tiles.
+/// Device implementation.
+/// Assumes local tiles of C reside on devices, e.g., after the device
+/// he2hb trailing update.
+/// @ingroup heev_internal
+///
+template <typename scalar_t>
+void hettmqr(
+    internal::TargetType<Target::Devices>,
+    Op op,
+    Matrix<scalar_t>& V,
+    Matrix<scalar_t>& T,
+    HermitianMatrix<scalar_t>& C,
+    int tag_base )
+{
+    hettmqr( Target::Devices, op, V, T, C, tag_base );
+}
+
 //------------------------------------------------------------------------------
 // Explicit instantiations.
 // ----------------------------------------
@@ -405,5 +469,41 @@ void hettmqr< Target::HostTask, std::complex<double> >(
     HermitianMatrix< std::complex<double> >&& C,
     int tag );
 
+// ----------------------------------------
+template
+void hettmqr<Target::Devices, float>(
+    Op op,
+    Matrix<float>&& V,
+    Matrix<float>&& T,
+    HermitianMatrix<float>&& C,
+    int tag );
+
+// ----------------------------------------
+template
+void hettmqr<Target::Devices, double>(
+    Op op,
+    Matrix<double>&& V,
+    Matrix<double>&& T,
+    HermitianMatrix<double>&& C,
+    int tag );
+
+// ----------------------------------------
+template
+void hettmqr< Target::Devices, std::complex<float> >(
+    Op op,
+    Matrix< std::complex<float> >&& V,
+    Matrix< std::complex<float> >&& T,
+    HermitianMatrix< std::complex<float> >&& C,
+    int tag );
+
+// ----------------------------------------
+template
+void hettmqr< Target::Devices, std::complex<double> >(
+    Op op,
+    Matrix< std::complex<double> >&& V,
+    Matrix< std::complex<double> >&& T,
+    HermitianMatrix< std::complex<double> >&& C,
+    int tag );
+
 } // namespace internal
 } // namespace slate
@@ -0,0 +1,104 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/internal/Hybrid.hh"
+
+#include <algorithm>
+
+namespace slate {
+namespace internal {
+
+//------------------------------------------------------------------------------
+/// @param[in] enabled
+///     Whether to split; true for Target::Hybrid.
+///
+HybridSplit::HybridSplit( bool enabled )
+    : enabled_( enabled ),
+      host_rate_( 0 ),
+      device_rate_( 0 )
+{}
+
+//------------------------------------------------------------------------------
+/// Chooses the first block-column updated on the host.
+///
+/// @param[in] flops
+///     Flops of the local update of each trailing block-column, in order.
+///
+/// @return s, 0 <= s <= flops.size(): columns 0, ..., s-1 are updated on
+/// the devices, and s, ..., flops.size()-1 on the host.
+///
+int64_t HybridSplit::split( std::vector<double> const& flops ) const
+{
+    int64_t n = flops.size();
+    if (! enabled_ || n < 2)
+        return n;
+
+    double host_rate, device_rate;
+    {
+        std::lock_guard<std::mutex> guard( mutex_ );
+        host_rate   = host_rate_;
+        device_rate = device_rate_;
+    }
+    // Until both are measured, give the host the last column.
+    if (host_rate <= 0 || device_rate <= 0)
+        return n - 1;
+
+    double total = 0;
+    for (double f : flops)
+        total += f;
+
+    // Minimize the slower part's time over all splits.
+    int64_t best = n;
+    double best_time = total / device_rate;
+    double host_flops = 0;
+    for (int64_t s = n-1; s >= 0; --s) {
+        host_flops += flops[ s ];
+        double time = std::max( host_flops / host_rate,
+                                (total - host_flops) / device_rate );
+        if (time < best_time) {
+            best = s;
+            best_time = time;
+        }
+    }
+    return best;
+}
+
+//------------------------------------------------------------------------------
+/// Records the flops and times of the host and device parts of a
+/// trailing update. Parts without flops or time are ignored. Rates are
+/// averaged with the previous step's, to smooth out noise.
+///
+void HybridSplit::done( double host_flops, double host_time,
+                        double device_flops, double device_time )
+{
+    if (! enabled_)
+        return;
+
+    auto average = []( double rate, double flops, double time ) {
+        double new_rate = flops / time;
+        return rate > 0 ? (rate + new_rate) / 2 : new_rate;
+    };
+
+    std::lock_guard<std::mutex> guard( mutex_ );
+    if (host_flops > 0 && host_time > 0)
+        host_rate_ = average( host_rate_, host_flops, host_time );
+    if (device_flops > 0 && device_time > 0)
+        device_rate_ = average( device_rate_, device_flops, device_time );
+}
+
+//------------------------------------------------------------------------------
+/// @return fraction of the update flops the host can do in the time the
+/// devices do the rest, from the measured rates; 0 until both are measured.
+///
+double HybridSplit::hostFraction() const
+{
+    std::lock_guard<std::mutex> guard( mutex_ );
+    if (host_rate_ <= 0 || device_rate_ <= 0)
+        return 0;
+    return host_rate_ / (host_rate_ + device_rate_);
+}
+
+} // namespace internal
+} // namespace slate
@@ -0,0 +1,226 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+//------------------------------------------------------------------------------
+/// @file
+/// SLATE matrix file format, shared by slate::write, slate::read, and
+/// Checkpoint.
+///
+#ifndef SLATE_INTERNAL_IO_HH
+#define SLATE_INTERNAL_IO_HH
+
+#include "slate/internal/mpi.hh"
+#include "slate/Matrix.hh"
+
+#include <cstring>
+#include <vector>
+
+#include <lapack.hh>
+
+namespace slate {
+namespace internal {
+
+//------------------------------------------------------------------------------
+/// Header of the SLATE matrix file format.
+/// The header is followed by the m-by-n matrix in mb-by-nb tiles, the last
+/// block row and column possibly smaller. Block columns are stored in
+/// order, each as its tiles in order, each tile column-major, so tile
+/// (i, j) starts at element ( j nb ) m + ( i mb ) nb_j, where nb_j is the
+/// width of block column j. Data is in the native representation.
+///
+struct FileHeader {
+    char    magic[ 8 ];     ///< "SLATEMAT"
+    int64_t version;        ///< format version, 1
+    int64_t type;           ///< 1: float, 2: double,
+                            ///< 3: complex<float>, 4: complex<double>
+    int64_t m, n;           ///< matrix dimensions
+    int64_t mb, nb;         ///< tile dimensions
+    int64_t reserved;
+};
+
+static_assert( sizeof( FileHeader ) == 64, "FileHeader must be 64 bytes" );
+
+const char file_magic[ 8 ] = { 'S', 'L', 'A', 'T', 'E', 'M', 'A', 'T' };
+const int64_t file_version = 1;
+
+//------------------------------------------------------------------------------
+/// @return the type code of scalar_t in the file header.
+template <typename scalar_t>
+int64_t file_type()
+{
+    using real_t = blas::real_type<scalar_t>;
+    return (sizeof( real_t ) == sizeof( float ) ? 1 : 2)
+           + (is_complex<scalar_t>::value ? 2 : 0);
+}
+
+//------------------------------------------------------------------------------
+/// @return the offset, in elements after the header, of tile (i, j)
+/// in the file.
+inline int64_t file_tile_offset( FileHeader const& header, int64_t i, int64_t j )
+{
+    int64_t nb_j = std::min( header.nb, header.n - j*header.nb );
+    return (j*header.nb)*header.m + (i*header.mb)*nb_j;
+}
+
+//------------------------------------------------------------------------------
+/// @return the file header of an m-by-n matrix of scalar_t in mb-by-nb tiles.
+template <typename scalar_t>
+FileHeader file_header( int64_t m, int64_t n, int64_t mb, int64_t nb )
+{
+    FileHeader header;
+    std::memcpy( header.magic, file_magic, sizeof( header.magic ) );
+    header.version  = file_version;
+    header.type     = file_type<scalar_t>();
+    header.m        = m;
+    header.n        = n;
+    header.mb       = mb;
+    header.nb       = nb;
+    header.reserved = 0;
+    return header;
+}
+
+//------------------------------------------------------------------------------
+/// @return whether op(A) is not transposed and has the mb-by-nb tiles of
+/// the file, so its local tiles can be read or written in place.
+template <typename scalar_t>
+bool file_tiles_match( Matrix<scalar_t>& A, int64_t mb, int64_t nb )
+{
+    if (A.op() != Op::NoTrans
+        || A.mt() != ceildiv( A.m(), mb )
+        || A.nt() != ceildiv( A.n(), nb ))
+        return false;
+    for (int64_t i = 0; i < A.mt(); ++i) {
+        if (A.tileMb( i ) != std::min( mb, A.m() - i*mb ))
+            return false;
+    }
+    for (int64_t j = 0; j < A.nt(); ++j) {
+        if (A.tileNb( j ) != std::min( nb, A.n() - j*nb ))
+            return false;
+    }
+    return true;
+}
+
+//------------------------------------------------------------------------------
+/// Reads or writes the local tiles of A, which has the file's tiles,
+/// with collective MPI-IO. Each rank accesses its local tiles at their
+/// offsets in the file, one local block column per collective call, so
+/// only one block column of tiles is staged in host memory at a time.
+/// Tiles valid only on devices are copied to the host for writing, and
+/// read tiles are copied back to their origin, then host copies that are
+/// workspace are released.
+/// With uplo Lower or Upper, only tiles in that triangle are accessed,
+/// as for the stored tiles of Hermitian matrices; the other tiles are
+/// holes in the file.
+///
+template <typename scalar_t>
+void file_tiles(
+    MPI_File fh, FileHeader const& header, Matrix<scalar_t>& A,
+    bool is_write, Uplo uplo = Uplo::General )
+{
+    auto tile_accessed = [&]( int64_t i, int64_t j ) {
+        return A.tileIsLocal( i, j )
+               && (uplo == Uplo::General
+                   || (uplo == Uplo::Lower && i >= j)
+                   || (uplo == Uplo::Upper && i <= j));
+    };
+
+    MPI_Comm mpi_comm = A.mpiComm();
+    MPI_Datatype mpi_scalar = mpi_type<scalar_t>::value;
+
+    std::vector<int64_t> local_cols;
+    for (int64_t j = 0; j < A.nt(); ++j) {
+        for (int64_t i = 0; i < A.mt(); ++i) {
+            if (tile_accessed( i, j )) {
+                local_cols.push_back( j );
+                break;
+            }
+        }
+    }
+
+    // Every rank must make the same number of collective calls.
+    int64_t nrounds = local_cols.size();
+    slate_mpi_call(
+        MPI_Allreduce( MPI_IN_PLACE, &nrounds, 1, MPI_INT64_T, MPI_MAX,
+                       mpi_comm ) );
+
+    std::vector<scalar_t> buffer;
+    for (int64_t r = 0; r < nrounds; ++r) {
+        std::vector<int64_t> rows;
+        std::vector<int> lengths;
+        std::vector<MPI_Aint> displacements;
+        int64_t j = -1;
+        int64_t count = 0;
+        if (r < int64_t( local_cols.size() )) {
+            j = local_cols[ r ];
+            for (int64_t i = 0; i < A.mt(); ++i) {
+                if (tile_accessed( i, j )) {
+                    int64_t size = A.tileMb( i ) * A.tileNb( j );
+                    rows.push_back( i );
+                    lengths.push_back( size );
+                    displacements.push_back(
+                        file_tile_offset( header, i, j ) * sizeof( scalar_t ) );
+                    count += size;
+                }
+            }
+        }
+        buffer.resize( count );
+
+        if (is_write) {
+            int64_t offset = 0;
+            for (int64_t i : rows) {
+                A.tileGetForReading( i, j, HostNum, LayoutConvert::ColMajor );
+                auto T = A( i, j );
+                lapack::lacpy( lapack::MatrixType::General, T.mb(), T.nb(),
+                               T.data(), T.stride(),
+                               &buffer[ offset ], T.mb() );
+                offset += T.mb() * T.nb();
+                A.tileRelease( i, j, HostNum );
+            }
+        }
+
+        MPI_Datatype filetype;
+        slate_mpi_call(
+            MPI_Type_create_hindexed(
+                lengths.size(), lengths.data(), displacements.data(),
+                mpi_scalar, &filetype ) );
+        slate_mpi_call(
+            MPI_Type_commit( &filetype ) );
+        slate_mpi_call(
+            MPI_File_set_view( fh, sizeof( FileHeader ), mpi_scalar, filetype,
+                               "native", MPI_INFO_NULL ) );
+        if (is_write) {
+            slate_mpi_call(
+                MPI_File_write_all( fh, buffer.data(), count, mpi_scalar,
+                                    MPI_STATUS_IGNORE ) );
+        }
+        else {
+            slate_mpi_call(
+                MPI_File_read_all( fh, buffer.data(), count, mpi_scalar,
+                                   MPI_STATUS_IGNORE ) );
+        }
+        slate_mpi_call(
+            MPI_Type_free( &filetype ) );
+
+        if (! is_write) {
+            int64_t offset = 0;
+            for (int64_t i : rows) {
+                A.tileGetForWriting( i, j, HostNum, LayoutConvert::ColMajor );
+                auto T = A( i, j );
+                lapack::lacpy( lapack::MatrixType::General, T.mb(), T.nb(),
+                               &buffer[ offset ], T.mb(),
+                               T.data(), T.stride() );
+                offset += T.mb() * T.nb();
+                A.tileUpdateOrigin( i, j );
+                A.tileRelease( i, j, HostNum );
+            }
+        }
+    }
+}
+
+
+} // namespace internal
+} // namespace slate
+
+#endif // SLATE_INTERNAL_IO_HH
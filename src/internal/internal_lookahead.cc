@@ -0,0 +1,119 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/internal/Lookahead.hh"
+#include "slate/internal/openmp.hh"
+#include "slate/enums.hh"
+#include "slate/Exception.hh"
+
+#include <algorithm>
+#include <thread>
+
+namespace slate {
+namespace internal {
+
+//------------------------------------------------------------------------------
+/// @param[in] lookahead
+///     Option::Lookahead: fixed depth >= 0, or LookaheadAuto.
+///
+/// @param[in] max_lookahead
+///     Option::MaxLookahead: max depth for LookaheadAuto, >= 1.
+///
+AdaptiveLookahead::AdaptiveLookahead( int64_t lookahead, int64_t max_lookahead )
+    : auto_( lookahead == LookaheadAuto ),
+      max_( auto_ ? max_lookahead : lookahead ),
+      depth_( std::min( int64_t( 1 ), max_ ) ),
+      panel_rate_( 0 ),
+      update_rate_( 0 ),
+      last_panel_( -1 )
+{
+    slate_assert( lookahead >= 0 || lookahead == LookaheadAuto );
+    slate_assert( max_ >= 0 );
+    slate_assert( ! auto_ || max_lookahead >= 1 );
+}
+
+//------------------------------------------------------------------------------
+/// Called by the thread submitting tasks, for steps k = 0, 1, ..., in order.
+///
+/// @param[in] k
+///     Step.
+///
+/// @param[in] panel_flops
+///     Flops of panel k.
+///
+/// @param[in] update_flops
+///     Flops of the trailing update of step k, including lookahead columns.
+///
+/// @return depth of step k: number of columns after k updated by
+/// separate, high priority tasks.
+///
+int64_t AdaptiveLookahead::step(
+    int64_t k, double panel_flops, double update_flops )
+{
+    if (! auto_)
+        return max_;
+
+    double panel_time, update_time;
+    {
+        std::lock_guard<std::mutex> guard( mutex_ );
+        panel_time  = panel_rate_  * panel_flops;
+        update_time = update_rate_ * update_flops;
+    }
+    // Until both are measured, keep the default depth.
+    if (panel_time > 0 && update_time > 0) {
+        int64_t target = 1 + int64_t( panel_time / update_time );
+        target = std::min( target, max_ );
+        depth_ = std::max( depth_ - 1, std::min( depth_ + 1, target ) );
+    }
+    return depth_;
+}
+
+//------------------------------------------------------------------------------
+/// For LookaheadAuto, waits until panel k - max() - 1 is done, so the
+/// submitting thread, and the depths step() chooses from measured times,
+/// stay within a few steps of the tasks that run.
+/// Waits only with more than one thread, since otherwise no other thread
+/// would run the panel.
+///
+void AdaptiveLookahead::wait( int64_t k )
+{
+    if (! auto_ || omp_get_num_threads() == 1)
+        return;
+
+    while (last_panel_.load() < k - max_ - 1) {
+        #pragma omp taskyield
+        std::this_thread::yield();
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Records the time of panel k. Panels finish in order.
+///
+void AdaptiveLookahead::panelDone( int64_t k, double flops, double time )
+{
+    if (! auto_)
+        return;
+
+    if (flops > 0) {
+        std::lock_guard<std::mutex> guard( mutex_ );
+        panel_rate_ = time / flops;
+    }
+    last_panel_.store( k );
+}
+
+//------------------------------------------------------------------------------
+/// Records the time of an update task of the trailing submatrix.
+///
+void AdaptiveLookahead::updateDone( double flops, double time )
+{
+    if (! auto_ || flops <= 0)
+        return;
+
+    std::lock_guard<std::mutex> guard( mutex_ );
+    update_rate_ = time / flops;
+}
+
+} // namespace internal
+} // namespace slate
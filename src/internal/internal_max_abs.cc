@@ -0,0 +1,228 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/internal/device.hh"
+#include "internal/internal_batch.hh"
+#include "internal/internal.hh"
+#include "slate/internal/util.hh"
+#include "slate/Matrix.hh"
+#include "slate/types.hh"
+
+#include <vector>
+
+namespace slate {
+namespace internal {
+
+//------------------------------------------------------------------------------
+/// Max abs of a tile, or of its upper triangle, in the tile's layout.
+/// A row-major tile is the column-major transpose, with uplo flipped.
+///
+template <typename scalar_t>
+blas::real_type<scalar_t> tile_max_abs(
+    bool upper, Tile<scalar_t> const& T )
+{
+    assert( T.op() == Op::NoTrans );
+    int64_t m = T.mb();
+    int64_t n = T.nb();
+    Uplo uplo = Uplo::Upper;
+    if (T.layout() == Layout::RowMajor) {
+        std::swap( m, n );
+        uplo = Uplo::Lower;
+    }
+    if (upper) {
+        return lapack::lantr( Norm::Max, uplo, Diag::NonUnit,
+                              m, n, T.data(), T.stride() );
+    }
+    else {
+        return lapack::lange( Norm::Max, m, n, T.data(), T.stride() );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// @return the device with a valid copy of tile (i, j), preferring the
+/// tile's compute device, then the host; HostNum if none is valid.
+///
+template <typename scalar_t>
+int valid_device( Matrix<scalar_t>& A, int64_t i, int64_t j )
+{
+    int tile_device = A.num_devices() > 0 ? A.tileDevice( i, j ) : HostNum;
+    if (tile_device != HostNum && A.tileExists( i, j, tile_device )
+        && A.tileState( i, j, tile_device ) != MOSI::Invalid)
+        return tile_device;
+    if (A.tileExists( i, j, HostNum )
+        && A.tileState( i, j, HostNum ) != MOSI::Invalid)
+        return HostNum;
+    for (int device = 0; device < A.num_devices(); ++device) {
+        if (A.tileExists( i, j, device )
+            && A.tileState( i, j, device ) != MOSI::Invalid)
+            return device;
+    }
+    return HostNum;
+}
+
+//------------------------------------------------------------------------------
+/// Local max abs of the elements of A, used to accumulate growth
+/// statistics (@see GrowthStats) in the tasks of getrf.
+/// Each tile is read where it is already valid, in its current layout,
+/// without conversions: on the host with lange, or on its device with one
+/// genorm_vbatch per device, so statistics of device-resident panels and
+/// trailing matrices cost no copies to the host.
+/// The upper triangles of diagonal tiles are read on the host.
+/// @ingroup norm_internal
+///
+/// @param[in] uplo
+///     - Uplo::General: all local tiles of A.
+///     - Uplo::Upper: the local tiles A(i, j) with i <= j, and only the
+///       upper triangle of diagonal tiles, e.g., the U of a factored panel.
+///
+/// @param[in] A
+///     Matrix, not transposed.
+///
+/// @param[out] value
+///     Max abs over the local tiles; 0 if there are none; NaN if any is.
+///
+/// @param[in] queue_index
+///     Batch arrays and queue to use on devices. The caller's task has to
+///     own them, e.g., by calling this before or after its own kernels.
+///
+template <typename scalar_t>
+void max_abs(
+    Uplo uplo, Matrix<scalar_t>&& A,
+    blas::real_type<scalar_t>* value,
+    int priority, int queue_index)
+{
+    using real_t = blas::real_type<scalar_t>;
+    using ij_tuple = typename BaseMatrix<scalar_t>::ij_tuple;
+
+    // Split local tiles between the host and the devices holding them.
+    std::vector<ij_tuple> host_tiles;
+    std::vector< std::set<ij_tuple> > device_tiles( A.num_devices() );
+    for (int64_t i = 0; i < A.mt(); ++i) {
+        for (int64_t j = 0; j < A.nt(); ++j) {
+            if (! A.tileIsLocal( i, j ) || (uplo == Uplo::Upper && i > j))
+                continue;
+            int device = valid_device( A, i, j );
+            if (device == HostNum || (uplo == Uplo::Upper && i == j))
+                host_tiles.push_back( { i, j } );
+            else
+                device_tiles[ device ].insert( { i, j } );
+        }
+    }
+
+    real_t local = 0;
+
+    #pragma omp taskgroup
+    {
+        for (auto ij : host_tiles) {
+            int64_t i = std::get<0>( ij );
+            int64_t j = std::get<1>( ij );
+            #pragma omp task slate_omp_default_none priority( priority ) \
+                shared( A, local ) firstprivate( i, j, uplo )
+            {
+                A.tileGetForReading( i, j, HostNum, LayoutConvert::None );
+                real_t tile_value = tile_max_abs(
+                    uplo == Uplo::Upper && i == j, A( i, j ) );
+                #pragma omp critical(slate_max_abs)
+                local = max_nan( local, tile_value );
+            }
+        }
+
+        for (int device = 0; device < A.num_devices(); ++device) {
+            if (device_tiles[ device ].empty())
+                continue;
+            #pragma omp task slate_omp_default_none priority( priority ) \
+                shared( A, local, device_tiles ) \
+                firstprivate( device, queue_index )
+            {
+                std::set<ij_tuple>& tiles = device_tiles[ device ];
+                int64_t batch_count = tiles.size();
+                // Keep the tile cache from evicting tiles until the kernel finishes.
+                A.tileCachePin( tiles, device );
+                A.tileGetForReading( tiles, device, LayoutConvert::None );
+
+                // Setup batched arguments: storage m, n, lda of each tile,
+                // no column offsets, then the kernel's counter.
+                scalar_t** a_array_host = A.array_host( device, queue_index );
+                int64_t* dims_host = A.dims_host( device, queue_index );
+                int64_t b = 0;
+                for (auto ij : tiles) {
+                    auto T = A( std::get<0>( ij ), std::get<1>( ij ), device );
+                    bool row_major = T.layout() == Layout::RowMajor;
+                    a_array_host[ b ] = T.data();
+                    dims_host[ b                 ] = row_major ? T.nb() : T.mb();
+                    dims_host[ b +   batch_count ] = row_major ? T.mb() : T.nb();
+                    dims_host[ b + 2*batch_count ] = T.stride();
+                    dims_host[ b + 3*batch_count ] = 0;
+                    ++b;
+                }
+                dims_host[ 4*batch_count ] = 0;
+
+                blas::Queue* queue = A.compute_queue( device, queue_index );
+                scalar_t** a_array_dev = A.array_device( device, queue_index );
+                int64_t* dims_dev = A.dims_device( device, queue_index );
+
+                int64_t values_size = 3*(device::batch::genorm_vbatch_blocks + 1);
+                real_t* values_dev
+                    = blas::device_malloc<real_t>( values_size, *queue );
+                real_t values[ 3 ];
+                {
+                    trace::Block trace_block("slate::device::genorm_vbatch");
+
+                    blas::device_memcpy<int64_t>(
+                        dims_dev, dims_host, 4*batch_count + 1, *queue );
+                    A.batchArrayUpload( device, queue_index, a_array_host,
+                                        batch_count, *queue );
+
+                    device::batch::genorm_vbatch(
+                        NormScope::Matrix, dims_dev, a_array_dev, values_dev,
+                        batch_count, *queue );
+
+                    blas::device_memcpy<real_t>( values, values_dev, 3, *queue );
+                    queue->sync();
+                }
+                A.tileCacheUnpin( tiles, device );
+                blas::device_free( values_dev, *queue );
+
+                #pragma omp critical(slate_max_abs)
+                local = max_nan( local, values[ 0 ] );
+            }
+        }
+    }
+
+    *value = local;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+// ----------------------------------------
+template
+void max_abs<float>(
+    Uplo uplo, Matrix<float>&& A,
+    float* value,
+    int priority, int queue_index);
+
+// ----------------------------------------
+template
+void max_abs<double>(
+    Uplo uplo, Matrix<double>&& A,
+    double* value,
+    int priority, int queue_index);
+
+// ----------------------------------------
+template
+void max_abs< std::complex<float> >(
+    Uplo uplo, Matrix< std::complex<float> >&& A,
+    float* value,
+    int priority, int queue_index);
+
+// ----------------------------------------
+template
+void max_abs< std::complex<double> >(
+    Uplo uplo, Matrix< std::complex<double> >&& A,
+    double* value,
+    int priority, int queue_index);
+
+} // namespace internal
+} // namespace slate
@@ -8,36 +8,72 @@
 #include "slate/HermitianBandMatrix.hh"
 #include "internal/internal.hh"
 #include "internal/internal_util.hh"
+#include "slate/internal/device.hh"
 
 namespace slate {
 namespace internal {
 
+//------------------------------------------------------------------------------
+/// An auxiliary routine to group the local tiles of the vector X by device,
+/// for the norm1est kernels when X's origin is on devices.
+template <typename scalar_t>
+std::vector< std::vector<int64_t> > norm1est_device_tiles(Matrix<scalar_t>& X)
+{
+    std::vector< std::vector<int64_t> > tiles( X.num_devices() );
+    for (int64_t i = 0; i < X.mt(); ++i) {
+        if (X.tileIsLocal( i, 0 ))
+            tiles[ X.tileDevice( i, 0 ) ].push_back( i );
+    }
+    return tiles;
+}
+
 //------------------------------------------------------------------------------
 /// An auxiliary routine to set the entries of a vector and alternating the
 /// vector entries signs.
 /// Vector is stored as a matrix
 /// For each iteration in norm1est, if the new estimation is smaller than the
 /// current one, then call this routine to set a new search direction.
+/// Entry k of the vector, in global numbering, is
+///     (-1)^(k (k+1) / 2) (1 + (k - 1) / (n - 1)).
 template <typename scalar_t>
 void norm1est_altsgn(Matrix<scalar_t>& A)
 {
     using real_t = blas::real_type<scalar_t>;
 
     int64_t mt = A.mt();
-    int64_t n  = A.n();
-
-    const scalar_t one  = 1.0;
-    real_t altsgn = 1.;
+    int64_t n  = A.m();
+
+    // Global index of the first row of each block row.
+    std::vector<int64_t> row0( mt+1, 0 );
+    for (int64_t i = 0; i < mt; ++i)
+        row0[ i+1 ] = row0[ i ] + A.tileMb( i );
+
+    if (A.origin() == Target::Devices) {
+        auto tiles = norm1est_device_tiles( A );
+        for (int device = 0; device < A.num_devices(); ++device) {
+            if (tiles[ device ].empty())
+                continue;
+            blas::Queue* queue = A.compute_queue( device );
+            for (int64_t i : tiles[ device ]) {
+                A.tileGetForWriting( i, 0, device, LayoutConvert::ColMajor );
+                auto Ai = A( i, 0, device );
+                device::norm1est_altsgn( Ai.mb(), row0[ i ], n, Ai.data(),
+                                         *queue );
+            }
+            queue->sync();
+        }
+        return;
+    }
 
     for (int64_t i = 0; i < mt; ++i) {
         if (A.tileIsLocal(i, 0)) {
             A.tileGetForWriting( i, 0, LayoutConvert::ColMajor );
             auto Aij = A(i, 0);
             auto Aij_data = Aij.data();
-            int64_t nb = A.tileMb(i);
-            for (int64_t ii = 0; ii < nb; ++ii) {
-                altsgn = pow(-1, int(i*nb+ii)) * altsgn;
-                Aij_data[ii] = altsgn * ( one + scalar_t( (i*nb+ii)-1 ) / scalar_t( n-1 ) );
+            for (int64_t ii = 0; ii < Aij.mb(); ++ii) {
+                int64_t k = row0[ i ] + ii;
+                real_t altsgn = (k % 4 == 0 || k % 4 == 3) ? 1 : -1;
+                Aij_data[ii] = altsgn * ( 1 + real_t( k - 1 ) / real_t( n - 1 ) );
             }
         }
     }
@@ -47,33 +83,193 @@ void norm1est_altsgn(Matrix<scalar_t>& A)
 /// An auxiliary routine to replace each entry of a vector by its sign (+1 or -1),
 /// for each entry a_i = {1.0,  if a_i >=0
 ///                      {-1.0, if a_i < 0
-/// Store the sign of each entry in isgn vector as well.
+/// or, for complex, by a_i / abs( a_i ), or 1.0 if a_i = 0.
+/// For real, stores the signs in S as well, and returns the number of local
+/// entries whose sign differs from the previous sign in S.
 template <typename scalar_t>
-void norm1est_set(Matrix<int64_t>& isgn, Matrix<scalar_t>& A)
+int64_t norm1est_set(Matrix<scalar_t>& S, Matrix<scalar_t>& A)
 {
     using blas::real;
+    using real_t = blas::real_type<scalar_t>;
+    real_t safmin = std::numeric_limits< real_t >::min();
+    const scalar_t one = 1.0;
 
     int64_t mt = A.mt();
+    int64_t nchanged = 0;
+
+    if (A.origin() == Target::Devices) {
+        // One counter per tile, copied back once per device.
+        auto tiles = norm1est_device_tiles( A );
+        for (int device = 0; device < A.num_devices(); ++device) {
+            int64_t ntiles = tiles[ device ].size();
+            if (ntiles == 0)
+                continue;
+            blas::Queue* queue = A.compute_queue( device );
+            int64_t* dcount = blas::device_malloc<int64_t>( ntiles, *queue );
+            for (int64_t k = 0; k < ntiles; ++k) {
+                int64_t i = tiles[ device ][ k ];
+                A.tileGetForWriting( i, 0, device, LayoutConvert::ColMajor );
+                S.tileGetForWriting( i, 0, device, LayoutConvert::ColMajor );
+                auto Ai = A( i, 0, device );
+                auto Si = S( i, 0, device );
+                device::norm1est_sign( Ai.mb(), Ai.data(), Si.data(),
+                                       &dcount[ k ], *queue );
+            }
+            std::vector<int64_t> count( ntiles );
+            blas::device_memcpy( count.data(), dcount, ntiles, *queue );
+            queue->sync();
+            blas::device_free( dcount, *queue );
+            for (int64_t c : count)
+                nchanged += c;
+        }
+        return nchanged;
+    }
 
     for (int64_t i = 0; i < mt; ++i) {
         if (A.tileIsLocal(i, 0)) {
             A.tileGetForWriting( i, 0, LayoutConvert::ColMajor );
+            S.tileGetForWriting( i, 0, LayoutConvert::ColMajor );
             auto Ai = A(i, 0);
             auto Ai_data = Ai.data();
-            auto isgn0 = isgn(i, 0);
-            auto isgn0_data = isgn0.data();
-            for (int64_t ii = 0; ii < A.tileMb(i); ++ii) {
-                if (real( Ai_data[ii] ) >= 0) {
-                    Ai_data[ii] = 1.0;
-                    isgn0_data[ii] = 1;
+            auto Si = S(i, 0);
+            auto Si_data = Si.data();
+            for (int64_t ii = 0; ii < Ai.mb(); ++ii) {
+                if constexpr (blas::is_complex<scalar_t>::value) {
+                    real_t absx1 = std::abs( Ai_data[ii] );
+                    Ai_data[ii] = absx1 > safmin ? Ai_data[ii] / absx1 : one;
                 }
                 else {
-                    Ai_data[ii] = -1.0;
-                    isgn0_data[ii] = -1;
+                    scalar_t sign = real( Ai_data[ii] ) >= 0 ? one : -one;
+                    if (sign != Si_data[ii])
+                        ++nchanged;
+                    Ai_data[ii] = sign;
+                    Si_data[ii] = sign;
                 }
             }
         }
     }
+    return nchanged;
+}
+
+//------------------------------------------------------------------------------
+/// An auxiliary routine to find the local entry of largest absolute value
+/// of a vector. Returns the value, or 0 if no local entry is nonzero, and
+/// its tile i_max and index ii_max in the tile, which are unchanged if
+/// the value is 0. Ties go to the first entry.
+template <typename scalar_t>
+blas::real_type<scalar_t> norm1est_amax(
+    Matrix<scalar_t>& A, int64_t* i_max, int64_t* ii_max)
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    int64_t mt = A.mt();
+    real_t A_max = 0.;
+
+    if (A.origin() == Target::Devices) {
+        // Maximum of each tile, copied back once per device; the first
+        // maximum over the tiles is then found in tile order.
+        auto tiles = norm1est_device_tiles( A );
+        std::vector<real_t> tile_max( mt, 0. );
+        std::vector<int64_t> tile_index( mt, 0 );
+        for (int device = 0; device < A.num_devices(); ++device) {
+            int64_t ntiles = tiles[ device ].size();
+            if (ntiles == 0)
+                continue;
+            blas::Queue* queue = A.compute_queue( device );
+            real_t* dmax = blas::device_malloc<real_t>( ntiles, *queue );
+            int64_t* dindex = blas::device_malloc<int64_t>( ntiles, *queue );
+            for (int64_t k = 0; k < ntiles; ++k) {
+                int64_t i = tiles[ device ][ k ];
+                A.tileGetForReading( i, 0, device, LayoutConvert::ColMajor );
+                auto Ai = A( i, 0, device );
+                device::norm1est_amax( Ai.mb(), Ai.data(), &dmax[ k ],
+                                       &dindex[ k ], *queue );
+            }
+            std::vector<real_t> max( ntiles );
+            std::vector<int64_t> index( ntiles );
+            blas::device_memcpy( max.data(), dmax, ntiles, *queue );
+            blas::device_memcpy( index.data(), dindex, ntiles, *queue );
+            queue->sync();
+            blas::device_free( dmax, *queue );
+            blas::device_free( dindex, *queue );
+            for (int64_t k = 0; k < ntiles; ++k) {
+                tile_max  [ tiles[ device ][ k ] ] = max[ k ];
+                tile_index[ tiles[ device ][ k ] ] = index[ k ];
+            }
+        }
+        for (int64_t i = 0; i < mt; ++i) {
+            if (tile_max[ i ] > A_max) {
+                A_max = tile_max[ i ];
+                *i_max  = i;
+                *ii_max = tile_index[ i ];
+            }
+        }
+        return A_max;
+    }
+
+    for (int64_t i = 0; i < mt; ++i) {
+        if (A.tileIsLocal(i, 0)) {
+            A.tileGetForReading( i, 0, LayoutConvert::ColMajor );
+            auto Ai = A(i, 0);
+            auto Ai_data = Ai.data();
+            for (int64_t ii = 0; ii < Ai.mb(); ++ii) {
+                if (std::abs( Ai_data[ii] ) > A_max) {
+                    A_max = std::abs( Ai_data[ii] );
+                    *i_max  = i;
+                    *ii_max = ii;
+                }
+            }
+        }
+    }
+    return A_max;
+}
+
+//------------------------------------------------------------------------------
+/// An auxiliary routine to get entry ii of local tile i of a vector.
+template <typename scalar_t>
+scalar_t norm1est_get(Matrix<scalar_t>& A, int64_t i, int64_t ii)
+{
+    scalar_t value;
+    if (A.origin() == Target::Devices) {
+        int device = A.tileDevice( i, 0 );
+        blas::Queue* queue = A.compute_queue( device );
+        A.tileGetForReading( i, 0, device, LayoutConvert::ColMajor );
+        blas::device_memcpy( &value, &A( i, 0, device ).data()[ ii ], 1,
+                             *queue );
+        queue->sync();
+    }
+    else {
+        A.tileGetForReading( i, 0, LayoutConvert::ColMajor );
+        value = A( i, 0 ).data()[ ii ];
+    }
+    return value;
+}
+
+//------------------------------------------------------------------------------
+/// An auxiliary routine to set a vector to the unit vector with 1 in entry
+/// ii of tile i, on all ranks.
+template <typename scalar_t>
+void norm1est_unit(
+    Matrix<scalar_t>& A, int64_t i, int64_t ii, Options const& opts)
+{
+    const scalar_t zero = 0.0;
+    const scalar_t one  = 1.0;
+
+    slate::set( zero, zero, A, opts );
+    if (A.tileIsLocal( i, 0 )) {
+        if (A.origin() == Target::Devices) {
+            int device = A.tileDevice( i, 0 );
+            blas::Queue* queue = A.compute_queue( device );
+            A.tileGetForWriting( i, 0, device, LayoutConvert::ColMajor );
+            blas::device_memcpy( &A( i, 0, device ).data()[ ii ], &one, 1,
+                                 *queue );
+            queue->sync();
+        }
+        else {
+            A.tileGetForWriting( i, 0, LayoutConvert::ColMajor );
+            A( i, 0 ).data()[ ii ] = one;
+        }
+    }
 }
 
 //------------------------------------------------------------------------------
@@ -98,8 +294,9 @@ void norm1est_set(Matrix<int64_t>& isgn, Matrix<scalar_t>& A)
 ///     On exit, V = A*W, where est = norm(A) / norm(W)
 ///     (W is not returned).
 ///
-/// @param[out] isgn
-///     isgn is integer matrix with size n-by-1.
+/// @param[in,out] S
+///     The n-by-1 matrix $S$, distributed as X, as workspace for the
+///     signs of the previous A * X.
 ///
 /// @param[in,out] est
 ///     On entry, with kase = 1 or 2 and isave[0] = 3, est should be unchanged
@@ -120,6 +317,11 @@ void norm1est_set(Matrix<int64_t>& isgn, Matrix<scalar_t>& A)
 ///     isave[2]: index of maximum element in X
 ///     isave[3]: number of iterations
 ///
+/// If the origin of X, V, and S is on devices, i.e., they were created with
+/// insertLocalTiles( Target::Devices ), norm1est keeps them there: the sign,
+/// argmax, and alternating sign steps run as device kernels, and only
+/// scalars move to the host.
+///
 /// Note in LAPACK, norm1est is lacn2
 ///
 /// @ingroup cond_internal
@@ -128,37 +330,55 @@ template <typename scalar_t>
 void norm1est(
            Matrix<scalar_t>& X,
            Matrix<scalar_t>& V,
-           Matrix<int64_t>& isgn,
+           Matrix<scalar_t>& S,
            blas::real_type<scalar_t>* est,
            int* kase,
            std::vector<int64_t>& isave )
 {
     using real_t = blas::real_type<scalar_t>;
-    using blas::real;
-    using blas::imag;
     const auto mpi_real_type = mpi_type< blas::real_type<scalar_t> >::value;
-    real_t safmin = std::numeric_limits< real_t >::min();
-    SLATE_UNUSED(safmin);
 
     const scalar_t one  = 1.0;
-    const scalar_t zero = 0.0;
 
     int64_t n = X.m();
     scalar_t alpha = one /scalar_t( n );
 
     int itmax = 5;
 
+    // Vector operations where X lives.
+    Options const opts = {
+        { Option::Target, X.origin() == Target::Devices ? Target::Devices
+                                                        : Target::HostTask }
+    };
+
     // isave[0] = jump
     // isave[1] = j which is the tile of the max element in X
     // isave[2] = jj which is the index of the max element in X
     // isave[3] = iter
 
-    int64_t mt = X.mt();
+    // Finds the tile and index of the largest entry of X among all ranks,
+    // and saves them in isave[1] and isave[2].
+    auto find_max = [&]() {
+        isave[1] = 0;
+        isave[2] = 0;
+
+        struct { real_t max; int loc; } max_loc_in[1], max_loc[1];
+        max_loc_in[0].max = norm1est_amax( X, &isave[1], &isave[2] );
+        max_loc_in[0].loc = X.mpiRank();
+
+        slate_mpi_call(
+                MPI_Allreduce(max_loc_in, max_loc, 1,
+                    mpi_type< max_loc_type<real_t> >::value,
+                    MPI_MAXLOC, X.mpiComm()) );
+
+        int root_rank = max_loc[0].loc;
+        MPI_Bcast( &isave[1], 2, MPI_INT64_T, root_rank, X.mpiComm() );
+    };
 
     // First iteration, kase = 0
     // Initialize X = 1./n
     if (*kase == 0) {
-        slate::set(alpha, alpha, X);
+        slate::set(alpha, alpha, X, opts);
         // X to be overwritten by A*X, so kase = 1.
         *kase = 1;
         isave[0] = 1;
@@ -171,13 +391,9 @@ void norm1est(
         if (isave[0] == 1) {
             // quick return
             if (n == 1) {
+                slate::copy( X, V, opts );
                 if (X.tileIsLocal(0, 0)) {
-                    auto Xi = X(0, 0);
-                    auto Vi = V(0, 0);
-                    auto Xi_data = Xi.data();
-                    auto Vi_data = Vi.data();
-                    Vi_data[0] = Xi_data[0];
-                    *est = std::abs( Vi_data[0] );
+                    *est = std::abs( norm1est_get( X, 0, 0 ) );
                 }
                 MPI_Bcast( est, 1, mpi_real_type, X.tileRank(0, 0), X.mpiComm() );
                 // Converged, set kase back to zero
@@ -186,45 +402,13 @@ void norm1est(
             }
 
             // Initial value of est
-            *est = slate::norm(slate::Norm::One, X);
+            *est = slate::norm(slate::Norm::One, X, opts);
 
             // Update the vector X
             // For real case, the vector X will be 1 or -1
             // For complex case, vector X will be X/abs(X) or 1
-            // Loop over the tiles and over the elements of each tile
-            for (int64_t i = 0; i < mt; ++i) {
-                if (X.tileIsLocal(i, 0)) {
-                    auto Xi = X(i, 0);
-                    auto Xi_data = Xi.data();
-                    auto isgn0 = isgn(i, 0);
-                    auto isgn0_data = isgn0.data();
-                    for (int64_t ii = 0; ii < X.tileMb(i); ++ii) {
-                        // for complex number
-                        if constexpr (blas::is_complex<scalar_t>::value) {
-                            real_t absx1 = std::abs( Xi_data[ii] );
-                            if (absx1 > safmin) {
-                                scalar_t Xi_ii = blas::MakeScalarTraits<scalar_t>::make(
-                                        real( Xi_data[ii] ) / absx1,
-                                        imag( Xi_data[ii] ) / absx1 );
-                                Xi_data[ii] = Xi_ii;
-                            }
-                            else {
-                                Xi_data[ii] = one;
-                            }
-                        }
-                        else {
-                            if (Xi_data[ii] >= zero) {
-                                Xi_data[ii] = one;
-                                isgn0_data[ii] = 1;
-                            }
-                            else {
-                                Xi_data[ii] = -one;
-                                isgn0_data[ii] = -1;
-                            }
-                        }
-                    }
-                }
-            }
+            norm1est_set( S, X );
+
             // Update kase and isave
             // X be overwritten by A^*X, so kase = 2
             *kase = 2;
@@ -235,176 +419,56 @@ void norm1est(
             // X has been overwritten by A^T*X
             // Find the index of the largest entry of X,
             // The location of the largest element will be saved in isave[1] and isave[2]
-            isave[1] = 0;
-            isave[2] = 0;
-            real_t X_max = 0.;
-
-            struct { real_t max; int loc; } max_loc_in[1], max_loc[1];
-            max_loc_in[0].max = 0.;
-            max_loc_in[0].loc = 0;
-
-            for (int64_t i = 0; i < mt; ++i) {
-                if (X.tileIsLocal(i, 0)) {
-                    auto Xi = X(i, 0);
-                    auto Xi_data = Xi.data();
-                    int64_t nb = X.tileMb(i);
-                    for (int64_t ii = 0; ii < nb; ++ii) {
-                        if (std::abs( Xi_data[ii] ) > X_max) {
-                            isave[1] = i;
-                            isave[2] = ii;
-                            X_max = std::abs( Xi_data[ ii ] );
-                            max_loc_in[0].max = X_max;
-                            max_loc_in[0].loc = X.tileRank(i, 0);
-                        }
-                    }
-                }
-            }
-            slate_mpi_call(
-                    MPI_Allreduce(max_loc_in, max_loc, 1,
-                        mpi_type< max_loc_type<real_t> >::value,
-                        MPI_MAXLOC, X.mpiComm()) );
-
-            int root_rank = max_loc[0].loc;
-            MPI_Bcast( &isave[1], 2, MPI_INT64_T, root_rank, X.mpiComm() );
+            find_max();
 
             isave[3] = 2;
 
             // main loop - iterations 2,3,..., itmax
-            slate::set(zero, zero, X);
-            int64_t i_isave = isave[1];
-
-            if (X.tileIsLocal(i_isave, 0)) {
-                auto Xi = X(i_isave, 0);
-                auto Xi_data = Xi.data();
-                Xi_data[ isave[2] ] = one;
-            }
+            // X_i = 0, all i, except X_i_max = 1
+            norm1est_unit( X, isave[1], isave[2], opts );
             *kase = 1;
             isave[0] = 3;
             return;
         }
         else if (isave[0] == 3) {
             // X has been overwritten by A*X
-            copy(X, V);
+            slate::copy( X, V, opts );
             real_t estold = *est;
-            *est = slate::norm(slate::Norm::One, V);
+            *est = slate::norm(slate::Norm::One, V, opts);
 
-            if constexpr (blas::is_complex<scalar_t>::value) {
-                if (*est <= estold) {
-                    norm1est_altsgn( X );
-                    *kase = 1;
-                    isave[0] = 5;
-                    return;
-                }
-                for (int64_t i = 0; i < mt; ++i) {
-                    if (X.tileIsLocal(i, 0)) {
-                        auto Xi = X(i, 0);
-                        auto Xi_data = Xi.data();
-                        for (int64_t ii = 0; ii < X.tileMb(i); ++ii) {
-                            real_t absx1 = std::abs( Xi_data[ii] );
-                            if (absx1 > safmin) {
-                                scalar_t Xi_ii = blas::MakeScalarTraits<scalar_t>::make( real( Xi_data[ii] ) / absx1,
-                                        imag( Xi_data[ii] ) / absx1);
-                                Xi_data[ii] = Xi_ii;
-                            }
-                            else {
-                                Xi_data[ii] = one;
-                            }
-                        }
-                    }
-                }
-                *kase = 2;
-                isave[0] = 4;
+            if (*est <= estold) {
+                norm1est_altsgn( X );
+                *kase = 1;
+                isave[0] = 5;
                 return;
             }
-            else {
-                int break_outer = -1;
-                int glo_break_outer = -1;
-                for (int64_t i = 0; i < mt; ++i) {
-                    if (X.tileIsLocal(i, 0)) {
-                        auto Xi = X(i, 0);
-                        auto Xi_data = Xi.data();
-                        auto isgn0 = isgn(i, 0);
-                        auto isgn0_data = isgn0.data();
-                        for (int64_t ii = 0; ii < X.tileMb(i); ++ii) {
-                            int64_t sign_x;
-                            if (real( Xi_data[ii] ) >= 0.) {
-                                sign_x = 1;
-                            }
-                            else {
-                                sign_x = -1;
-                            }
-                            if (sign_x != isgn0_data[ii]) {
-                                if (*est <= estold) {
-                                    break_outer = 1;
-                                    break;
-                                }
-                                break_outer = 2;
-                                break;
-                            } // if (sign_x != isgn[i])
-                        } // for ii = 0:nb
-                        if (break_outer == 1 || break_outer == 2) break;
-                    } // if (X.tileIsLocal(i, j))
-                } // for i = 0:mt
-
-                slate_mpi_call(MPI_Allreduce(&break_outer, &glo_break_outer, 1, MPI_INT, MPI_MAX, X.mpiComm()));
-                if (glo_break_outer == 1) {
+
+            // X = sign( X ). For real, if no sign changed, the iteration
+            // repeats, so stop with the alternating sign vector.
+            int64_t nchanged = norm1est_set( S, X );
+            if constexpr (! blas::is_complex<scalar_t>::value) {
+                int64_t glo_nchanged = 0;
+                slate_mpi_call(
+                    MPI_Allreduce( &nchanged, &glo_nchanged, 1, MPI_INT64_T,
+                                   MPI_SUM, X.mpiComm() ) );
+                if (glo_nchanged == 0) {
+                    norm1est_altsgn( X );
                     *kase = 1;
                     isave[0] = 5;
-                    norm1est_altsgn( X );
-                    return;
-                }
-                else if (glo_break_outer == 2) {
-                    *kase = 2;
-                    isave[0] = 4;
-                    norm1est_set( isgn, X );
                     return;
                 }
-
-                norm1est_altsgn( X );
-                *kase = 1;
-                isave[0] = 5;
-                return;
-            } // if constexpr
+            }
+            *kase = 2;
+            isave[0] = 4;
+            return;
         }
         else if (isave[0] == 4) {
             // X has been overwritten by A^T*X
             int64_t jlast  = isave[1];
             int64_t jjlast = isave[2];
-            isave[1] = 0;
-            isave[2] = 0;
-            real_t X_max = 0.;
-
-            struct { real_t max; int loc; } max_loc_in[1], max_loc[1];
-            max_loc_in[0].max = 0.;
-            max_loc_in[0].loc = 0;
-
-            // Find the max value/index on each rank
-            for (int64_t i = 0; i < mt; ++i) {
-                if (X.tileIsLocal(i, 0)) {
-                    auto Xi = X(i, 0);
-                    auto Xi_data = Xi.data();
-                    int64_t nb = X.tileMb(i);
-                    for (int64_t ii = 0; ii < nb; ++ii) {
-                        if (std::abs( Xi_data[ii] ) > X_max) {
-                            isave[1] = i;
-                            isave[2] = ii;
-                            X_max = std::abs( Xi_data[ ii ] );
-                            max_loc_in[0].max = X_max;
-                            max_loc_in[0].loc = X.tileRank(i, 0);
-                        }
-                    }
-                }
-            }
 
             // Find the max value/index among all mpi ranks
-            slate_mpi_call(
-                    MPI_Allreduce(max_loc_in, max_loc, 1,
-                        mpi_type< max_loc_type<real_t> >::value,
-                        MPI_MAXLOC, X.mpiComm()) );
-
-            // Bcast the index of the max value to all mpi ranks
-            int root_rank = max_loc[0].loc;
-            MPI_Bcast( &isave[1], 2, MPI_INT64_T, root_rank, X.mpiComm() );
+            find_max();
 
             // Find the tile which has the isave[1] entry (max value)
             int64_t i_max = isave[1];
@@ -412,15 +476,11 @@ void norm1est(
             // Find the value at jlast
             real_t X_jlast = 0., X_i_max = 0.;
             if (X.tileIsLocal(jlast, 0)) {
-                auto Xi = X(jlast, 0);
-                auto Xi_data = Xi.data();
-                X_jlast = std::abs( Xi_data[ jjlast ] );
+                X_jlast = std::abs( norm1est_get( X, jlast, jjlast ) );
             }
             // Find the value at i_max
             if (X.tileIsLocal(i_max, 0)) {
-                auto Xi = X(i_max, 0);
-                auto Xi_data = Xi.data();
-                X_i_max = std::abs( Xi_data[isave[2] ] );
+                X_i_max = std::abs( norm1est_get( X, i_max, isave[2] ) );
             }
 
             // Bcast previous max value (X_jlast) and the current max
@@ -433,17 +493,10 @@ void norm1est(
             // then do one more iteration
             if (X_jlast != X_i_max && isave[3] < itmax) {
                 isave[3] = isave[3] + 1;
-                slate::set(zero, zero, X);
 
-                // Find the tile index which has the max entry,
-                // then set X to a canonical form:
+                // Set X to a canonical form:
                 // X_i = 0, all i, except X_i_max = 1
-                int64_t i_isave = isave[1];
-                if (X.tileIsLocal(i_isave, 0)) {
-                    auto Xi = X(i_isave, 0);
-                    auto Xi_data = Xi.data();
-                    Xi_data[ isave[2] ] = one;
-                }
+                norm1est_unit( X, isave[1], isave[2], opts );
                 *kase = 1;
                 isave[0] = 3;
                 return;
@@ -455,10 +508,10 @@ void norm1est(
         }
         else if (isave[0] == 5) {
             // X has been overwritten by A*X.
-            real_t temp = slate::norm(slate::Norm::One, V);
+            real_t temp = slate::norm(slate::Norm::One, X, opts);
             temp = real_t(2.0) * temp / ( real_t(3.0) * real_t(n) );
             if (temp > *est) {
-                copy( X, V );
+                slate::copy( X, V, opts );
                 *est = temp;
             }
             // Set kase to zero, norm1est converged
@@ -475,7 +528,7 @@ template
 void norm1est<float>(
     Matrix<float>& X,
     Matrix<float>& V,
-    Matrix<int64_t>& isgn,
+    Matrix<float>& S,
     float* est,
     int* kase,
     std::vector<int64_t>& isave );
@@ -484,7 +537,7 @@ template
 void norm1est<double>(
     Matrix<double>& X,
     Matrix<double>& V,
-    Matrix<int64_t>& isgn,
+    Matrix<double>& S,
     double* est,
     int* kase,
     std::vector<int64_t>& isave );
@@ -493,7 +546,7 @@ template
 void norm1est< std::complex<float> >(
     Matrix< std::complex<float> >& X,
     Matrix< std::complex<float> >& V,
-    Matrix<int64_t>& isgn,
+    Matrix< std::complex<float> >& S,
     float* est,
     int* kase,
     std::vector<int64_t>& isave );
@@ -502,7 +555,7 @@ template
 void norm1est< std::complex<double> >(
     Matrix< std::complex<double> >& X,
     Matrix< std::complex<double> >& V,
-    Matrix<int64_t>& isgn,
+    Matrix< std::complex<double> >& S,
     double* est,
     int* kase,
     std::vector<int64_t>& isave );
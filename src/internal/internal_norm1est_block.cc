@@ -0,0 +1,378 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/slate.hh"
+#include "slate/Matrix.hh"
+#include "internal/internal.hh"
+#include "internal/internal_util.hh"
+
+#include <algorithm>
+#include <numeric>
+
+namespace slate {
+namespace internal {
+
+//------------------------------------------------------------------------------
+/// An auxiliary routine to compute the 1-norms of the columns of the
+/// n-by-t matrix X, which has one block column, on all ranks.
+template <typename scalar_t>
+void norm1est_block_colnorms(
+    Matrix<scalar_t>& X, std::vector< blas::real_type<scalar_t> >& norms )
+{
+    using real_t = blas::real_type<scalar_t>;
+    const auto mpi_real_type = mpi_type<real_t>::value;
+
+    int64_t t = X.n();
+    std::vector<real_t> local( t, 0. );
+    for (int64_t i = 0; i < X.mt(); ++i) {
+        if (X.tileIsLocal( i, 0 )) {
+            X.tileGetForReading( i, 0, LayoutConvert::ColMajor );
+            auto Xi = X( i, 0 );
+            for (int64_t j = 0; j < t; ++j) {
+                for (int64_t ii = 0; ii < Xi.mb(); ++ii)
+                    local[ j ] += std::abs( Xi( ii, j ) );
+            }
+        }
+    }
+    norms.resize( t );
+    slate_mpi_call(
+        MPI_Allreduce( local.data(), norms.data(), t, mpi_real_type,
+                       MPI_SUM, X.mpiComm() ) );
+}
+
+//------------------------------------------------------------------------------
+/// Distributed parallel block estimate of the 1-norm of a square matrix A,
+/// using t columns at a time.
+/// Generic implementation for any target.
+///
+/// This is the block algorithm of Higham and Tisseur (Algorithm 2.4 in
+/// SIAM J. Matrix Anal. Appl. 21(4), 2000), used by MATLAB normest1,
+/// with the same reverse communication as norm1est. Each product A X or
+/// A^H X is on t columns, so it does fewer, larger solves than norm1est,
+/// which uses t = 1; usually the estimate takes 2 to 4 products of each
+/// kind. Unlike normest1, it does not resample columns of the sign matrix
+/// that are parallel to other columns.
+///
+/// All ranks compute the same kase and est, so no broadcast is needed
+/// between calls.
+///
+//------------------------------------------------------------------------------
+/// @tparam scalar_t
+///     One of float, double, std::complex<float>, std::complex<double>.
+//------------------------------------------------------------------------------
+/// @param[in,out] X
+///     The n-by-t matrix $X$, with one block column, 1 <= t <= n.
+///     On an intermediate return, X should be overwritten by
+///       A * X,   if kase=1
+///       A^H * X,   if kase=2
+///
+/// @param[in,out] V
+///     The n-by-1 matrix $V$, distributed as X.
+///     On exit, V = A*W, where est = norm(V) and norm(W) = 1
+///     (W is not returned).
+///
+/// @param[in,out] S
+///     The n-by-t matrix $S$, distributed as X, as workspace for the
+///     signs of the previous A * X.
+///
+/// @param[in,out] est
+///     On entry, with kase = 1 or 2, est should be unchanged from the
+///     previous call to norm1est_block.
+///     On exit, est is an estimate for norm(A).
+///
+/// @param[in,out] kase
+///     On the initial call to norm1est_block, kase should be 0.
+///     On an intermediate return, kase will be 1 or 2, indicating whether
+///     X should be overwritten by A * X or A^H * X.
+///     On exit, kase will again be 0.
+///
+/// @param[in,out] isave
+///     isave is used to save variables between calls to norm1est_block.
+///     isave[0]: the step to do in the next iteration
+///     isave[1]: number of iterations
+///     isave[2]: index of the best unit vector so far
+///     isave[3:]: indices of the unit vectors used so far,
+///                the last t for the current X.
+///
+/// @ingroup cond_internal
+///
+template <typename scalar_t>
+void norm1est_block(
+           Matrix<scalar_t>& X,
+           Matrix<scalar_t>& V,
+           Matrix<scalar_t>& S,
+           blas::real_type<scalar_t>* est,
+           int* kase,
+           std::vector<int64_t>& isave )
+{
+    using real_t = blas::real_type<scalar_t>;
+    const auto mpi_real_type = mpi_type<real_t>::value;
+    real_t safmin = std::numeric_limits< real_t >::min();
+
+    const scalar_t one  = 1.0;
+    const scalar_t zero = 0.0;
+    const int itmax = 5;
+
+    int64_t n  = X.m();
+    int64_t t  = X.n();
+    int64_t mt = X.mt();
+    slate_assert( t >= 1 && t <= n );
+    slate_assert( X.nt() == 1 );
+
+    // Global index of the first row of each block row.
+    std::vector<int64_t> row0( mt+1, 0 );
+    for (int64_t i = 0; i < mt; ++i)
+        row0[ i+1 ] = row0[ i ] + X.tileMb( i );
+
+    // First iteration, kase = 0
+    // Initialize X: first column 1/n, others +-1/n with pseudo-random
+    // signs, the same on every rank.
+    if (*kase == 0) {
+        real_t rn = real_t( 1 ) / n;
+        for (int64_t i = 0; i < mt; ++i) {
+            if (X.tileIsLocal( i, 0 )) {
+                X.tileGetForWriting( i, 0, LayoutConvert::ColMajor );
+                auto Xi = X( i, 0 );
+                for (int64_t ii = 0; ii < Xi.mb(); ++ii) {
+                    uint64_t ig = row0[ i ] + ii;
+                    Xi.at( ii, 0 ) = rn;
+                    for (int64_t j = 1; j < t; ++j) {
+                        uint64_t h = (ig + 1) * 0x9E3779B97F4A7C15ull
+                                   ^ (j * 0xBF58476D1CE4E5B9ull);
+                        h ^= h >> 31;
+                        Xi.at( ii, j ) = (h & 1) ? -rn : rn;
+                    }
+                }
+            }
+        }
+        *est = 0.;
+        isave.assign( { 1, 1, -1 } );
+        // X to be overwritten by A*X, so kase = 1.
+        *kase = 1;
+        return;
+    }
+
+    int64_t iter = isave[ 1 ];
+    int64_t nhist = isave.size() - 3;
+
+    if (isave[ 0 ] == 1) {
+        // X has been overwritten by Y = A*X.
+        std::vector<real_t> norms;
+        norm1est_block_colnorms( X, norms );
+        int64_t jbest = std::max_element( norms.begin(), norms.end() )
+                      - norms.begin();
+        real_t estold = *est;
+
+        if (norms[ jbest ] > estold || iter == 2) {
+            if (iter >= 2)
+                isave[ 2 ] = isave[ 3 + nhist - t + jbest ];
+            // V = Y(:, jbest)
+            for (int64_t i = 0; i < mt; ++i) {
+                if (X.tileIsLocal( i, 0 )) {
+                    X.tileGetForReading( i, 0, LayoutConvert::ColMajor );
+                    V.tileGetForWriting( i, 0, LayoutConvert::ColMajor );
+                    auto Xi = X( i, 0 );
+                    auto Vi = V( i, 0 );
+                    for (int64_t ii = 0; ii < Xi.mb(); ++ii)
+                        Vi.at( ii, 0 ) = Xi( ii, jbest );
+                }
+            }
+        }
+        if (iter >= 2 && norms[ jbest ] <= estold) {
+            // No increase, converged; est stays estold.
+            *kase = 0;
+            return;
+        }
+        *est = norms[ jbest ];
+        if (iter > itmax) {
+            *kase = 0;
+            return;
+        }
+
+        // X = sign( Y ); for complex, Y / |Y|.
+        // For real, count the columns parallel to a column of the
+        // previous signs S, i.e., with S(:, i)^T X(:, j) = +-n.
+        std::vector<real_t> dots( t*t, 0. );
+        for (int64_t i = 0; i < mt; ++i) {
+            if (X.tileIsLocal( i, 0 )) {
+                X.tileGetForWriting( i, 0, LayoutConvert::ColMajor );
+                auto Xi = X( i, 0 );
+                for (int64_t j = 0; j < t; ++j) {
+                    for (int64_t ii = 0; ii < Xi.mb(); ++ii) {
+                        if constexpr (blas::is_complex<scalar_t>::value) {
+                            real_t absx = std::abs( Xi( ii, j ) );
+                            Xi.at( ii, j ) = absx > safmin
+                                        ? Xi( ii, j ) / absx : one;
+                        }
+                        else {
+                            Xi.at( ii, j ) = Xi( ii, j ) >= zero ? one : -one;
+                        }
+                    }
+                }
+                if (iter >= 2 && ! blas::is_complex<scalar_t>::value) {
+                    S.tileGetForReading( i, 0, LayoutConvert::ColMajor );
+                    auto Si = S( i, 0 );
+                    for (int64_t j = 0; j < t; ++j) {
+                        for (int64_t k = 0; k < t; ++k) {
+                            for (int64_t ii = 0; ii < Xi.mb(); ++ii) {
+                                dots[ k + j*t ] += blas::real(
+                                    Si( ii, k ) * Xi( ii, j ) );
+                            }
+                        }
+                    }
+                }
+            }
+        }
+        if (iter >= 2 && ! blas::is_complex<scalar_t>::value) {
+            std::vector<real_t> dots_sum( t*t );
+            slate_mpi_call(
+                MPI_Allreduce( dots.data(), dots_sum.data(), t*t,
+                               mpi_real_type, MPI_SUM, X.mpiComm() ) );
+            int64_t nparallel = 0;
+            for (int64_t j = 0; j < t; ++j) {
+                for (int64_t k = 0; k < t; ++k) {
+                    if (std::abs( dots_sum[ k + j*t ] ) == real_t( n )) {
+                        ++nparallel;
+                        break;
+                    }
+                }
+            }
+            if (nparallel == t) {
+                // All the signs repeat, converged.
+                *kase = 0;
+                return;
+            }
+        }
+        slate::copy( X, S );
+
+        // X to be overwritten by A^H*X, so kase = 2.
+        *kase = 2;
+        isave[ 0 ] = 2;
+        return;
+    }
+    else if (isave[ 0 ] == 2) {
+        // X has been overwritten by Z = A^H*S.
+        // h(i) = max_j |Z(i, j)|, on all ranks.
+        std::vector<real_t> h_local( n, 0. ), h( n );
+        for (int64_t i = 0; i < mt; ++i) {
+            if (X.tileIsLocal( i, 0 )) {
+                X.tileGetForReading( i, 0, LayoutConvert::ColMajor );
+                auto Xi = X( i, 0 );
+                for (int64_t j = 0; j < t; ++j) {
+                    for (int64_t ii = 0; ii < Xi.mb(); ++ii) {
+                        real_t& hi = h_local[ row0[ i ] + ii ];
+                        hi = std::max( hi, real_t( std::abs( Xi( ii, j ) ) ) );
+                    }
+                }
+            }
+        }
+        slate_mpi_call(
+            MPI_Allreduce( h_local.data(), h.data(), n, mpi_real_type,
+                           MPI_MAX, X.mpiComm() ) );
+
+        real_t h_max = *std::max_element( h.begin(), h.end() );
+        if (iter >= 2 && h_max == h[ isave[ 2 ] ]) {
+            // The best unit vector is still the best, converged.
+            *kase = 0;
+            return;
+        }
+
+        // Indices sorted by decreasing h.
+        std::vector<int64_t> order( n );
+        std::iota( order.begin(), order.end(), 0 );
+        std::stable_sort( order.begin(), order.end(),
+                          [&h]( int64_t a, int64_t b ) {
+                              return h[ a ] > h[ b ];
+                          } );
+
+        auto used = [&isave]( int64_t index ) {
+            return std::find( isave.begin() + 3, isave.end(), index )
+                   != isave.end();
+        };
+        if (t > 1) {
+            bool all_used = true;
+            for (int64_t j = 0; j < t; ++j)
+                all_used = all_used && used( order[ j ] );
+            if (all_used) {
+                *kase = 0;
+                return;
+            }
+        }
+
+        // Take the t largest indices not used before; if fewer are left,
+        // fill in with the largest used ones.
+        std::vector<int64_t> ind;
+        for (int64_t k = 0; k < n && int64_t( ind.size() ) < t; ++k) {
+            if (! used( order[ k ] ))
+                ind.push_back( order[ k ] );
+        }
+        for (int64_t k = 0; k < n && int64_t( ind.size() ) < t; ++k) {
+            if (std::find( ind.begin(), ind.end(), order[ k ] ) == ind.end())
+                ind.push_back( order[ k ] );
+        }
+
+        // X(:, j) = e_{ind(j)}
+        slate::set( zero, zero, X );
+        for (int64_t i = 0; i < mt; ++i) {
+            if (X.tileIsLocal( i, 0 )) {
+                X.tileGetForWriting( i, 0, LayoutConvert::ColMajor );
+                auto Xi = X( i, 0 );
+                for (int64_t j = 0; j < t; ++j) {
+                    if (ind[ j ] >= row0[ i ] && ind[ j ] < row0[ i+1 ])
+                        Xi.at( ind[ j ] - row0[ i ], j ) = one;
+                }
+            }
+        }
+        isave.insert( isave.end(), ind.begin(), ind.end() );
+        isave[ 1 ] = iter + 1;
+
+        // X to be overwritten by A*X, so kase = 1.
+        *kase = 1;
+        isave[ 0 ] = 1;
+        return;
+    }
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+// ----------------------------------------
+template
+void norm1est_block<float>(
+    Matrix<float>& X,
+    Matrix<float>& V,
+    Matrix<float>& S,
+    float* est,
+    int* kase,
+    std::vector<int64_t>& isave );
+
+template
+void norm1est_block<double>(
+    Matrix<double>& X,
+    Matrix<double>& V,
+    Matrix<double>& S,
+    double* est,
+    int* kase,
+    std::vector<int64_t>& isave );
+
+template
+void norm1est_block< std::complex<float> >(
+    Matrix< std::complex<float> >& X,
+    Matrix< std::complex<float> >& V,
+    Matrix< std::complex<float> >& S,
+    float* est,
+    int* kase,
+    std::vector<int64_t>& isave );
+
+template
+void norm1est_block< std::complex<double> >(
+    Matrix< std::complex<double> >& X,
+    Matrix< std::complex<double> >& V,
+    Matrix< std::complex<double> >& S,
+    double* est,
+    int* kase,
+    std::vector<int64_t>& isave );
+
+} // namespace internal
+} // namespace slate
@@ -21,14 +21,106 @@ template <Target target, typename scalar_t>
 int64_t potrf(
     HermitianMatrix< scalar_t >&& A,
     int priority, int64_t queue_index,
-    lapack::device_info_int* device_info)
+    lapack::device_info_int* device_info,
+    int64_t sub_tile)
 {
     return potrf( internal::TargetType<target>(), A, priority,
-                  queue_index, device_info );
+                  queue_index, device_info, sub_tile );
+}
+
+//------------------------------------------------------------------------------
+/// Cholesky factorization of a tile on the sub-tiles of size sub_tile it
+/// is cut into, as a tiled Cholesky whose trsm and update of each step run
+/// as tasks. The sub-tiles are slices of the data of A, not tiles in the
+/// matrix storage. A row-major tile is factored as in tile::potrf.
+/// @ingroup posv_internal
+///
+/// @return info: 0 on success, or i > 0 if the leading minor of order i
+///     is not positive definite.
+///
+template <typename scalar_t>
+int64_t potrf_sub_tiles(Tile<scalar_t>& A, int64_t sub_tile, int priority)
+{
+    using real_t = blas::real_type<scalar_t>;
+    const scalar_t one = 1.0;
+    const real_t r_one = 1.0;
+
+    Uplo uplo = A.uploPhysical();
+    if (A.layout() == Layout::RowMajor)
+        uplo = (uplo == Uplo::Lower ? Uplo::Upper : Uplo::Lower);
+    int64_t n = A.mb();
+    int64_t lda = A.stride();
+    scalar_t* a = A.data();
+    auto at = [a, lda]( int64_t i, int64_t j ) { return &a[ i + j*lda ]; };
+
+    for (int64_t k0 = 0; k0 < n; k0 += sub_tile) {
+        int64_t kb = std::min( sub_tile, n - k0 );
+        int64_t info = lapack::potrf( uplo, kb, at( k0, k0 ), lda );
+        if (info != 0)
+            return k0 + info;
+
+        // Sub-tiles below (or right of) the diagonal one.
+        #pragma omp taskgroup
+        for (int64_t i0 = k0 + kb; i0 < n; i0 += sub_tile) {
+            #pragma omp task slate_omp_default_none priority( priority ) \
+                firstprivate( uplo, i0, k0, kb, n, sub_tile, lda, at, one )
+            {
+                int64_t ib = std::min( sub_tile, n - i0 );
+                if (uplo == Uplo::Lower) {
+                    blas::trsm( Layout::ColMajor, Side::Right, Uplo::Lower,
+                                Op::ConjTrans, Diag::NonUnit, ib, kb,
+                                one, at( k0, k0 ), lda, at( i0, k0 ), lda );
+                }
+                else {
+                    blas::trsm( Layout::ColMajor, Side::Left, Uplo::Upper,
+                                Op::ConjTrans, Diag::NonUnit, kb, ib,
+                                one, at( k0, k0 ), lda, at( k0, i0 ), lda );
+                }
+            }
+        }
+
+        // Trailing sub-tiles, one block column (or row) per task.
+        #pragma omp taskgroup
+        for (int64_t j0 = k0 + kb; j0 < n; j0 += sub_tile) {
+            #pragma omp task slate_omp_default_none priority( priority ) \
+                firstprivate( uplo, j0, k0, kb, n, sub_tile, lda, at, one, r_one )
+            {
+                int64_t jb = std::min( sub_tile, n - j0 );
+                int64_t rest = n - j0 - jb;
+                if (uplo == Uplo::Lower) {
+                    blas::herk( Layout::ColMajor, Uplo::Lower, Op::NoTrans,
+                                jb, kb, -r_one, at( j0, k0 ), lda,
+                                r_one, at( j0, j0 ), lda );
+                    if (rest > 0) {
+                        blas::gemm( Layout::ColMajor, Op::NoTrans, Op::ConjTrans,
+                                    rest, jb, kb,
+                                    -one, at( j0 + jb, k0 ), lda,
+                                          at( j0, k0 ), lda,
+                                    one,  at( j0 + jb, j0 ), lda );
+                    }
+                }
+                else {
+                    blas::herk( Layout::ColMajor, Uplo::Upper, Op::ConjTrans,
+                                jb, kb, -r_one, at( k0, j0 ), lda,
+                                r_one, at( j0, j0 ), lda );
+                    if (rest > 0) {
+                        blas::gemm( Layout::ColMajor, Op::ConjTrans, Op::NoTrans,
+                                    jb, rest, kb,
+                                    -one, at( k0, j0 ), lda,
+                                          at( k0, j0 + jb ), lda,
+                                    one,  at( j0, j0 + jb ), lda );
+                    }
+                }
+            }
+        }
+    }
+    return 0;
 }
 
 //------------------------------------------------------------------------------
 /// Cholesky factorization of single tile, host implementation.
+/// If 0 < sub_tile < the tile size, factors the tile on its sub-tiles,
+/// @see potrf_sub_tiles.
 /// @ingroup posv_internal
 ///
 template <typename scalar_t>
@@ -36,21 +128,28 @@ int64_t potrf(
     internal::TargetType<Target::HostTask>,
     HermitianMatrix<scalar_t>& A,
     int priority, int64_t queue_index,
-    lapack::device_info_int* device_info)
+    lapack::device_info_int* device_info,
+    int64_t sub_tile)
 {
     assert(A.mt() == 1);
     assert(A.nt() == 1);
 
     int64_t info = 0;
     if (A.tileIsLocal( 0, 0 )) {
-        A.tileGetForWriting( 0, 0, LayoutConvert::ColMajor );
-        info = tile::potrf( A( 0, 0 ) );
+        // Factors tiles in A's layout, without conversion.
+        A.tileGetForWriting( 0, 0, LayoutConvert( A.layout() ) );
+        auto A00 = A( 0, 0 );
+        if (sub_tile > 0 && sub_tile < A00.mb())
+            info = potrf_sub_tiles( A00, sub_tile, priority );
+        else
+            info = tile::potrf( A00 );
     }
     return info;
 }
 
 //------------------------------------------------------------------------------
 /// Cholesky factorization of single tile, device implementation.
+/// Ignores sub_tile.
 /// @ingroup posv_internal
 ///
 template <typename scalar_t>
@@ -58,7 +157,8 @@ int64_t potrf(
     internal::TargetType<Target::Devices>,
     HermitianMatrix<scalar_t>& A,
     int priority, int64_t queue_index,
-    lapack::device_info_int* device_info)
+    lapack::device_info_int* device_info,
+    int64_t sub_tile)
 {
     assert(A.mt() == 1);
     assert(A.nt() == 1);
@@ -66,15 +166,22 @@ int64_t potrf(
     int64_t info = 0;
     if (A.tileIsLocal(0, 0)) {
         int device = A.tileDevice( 0, 0 );
-        A.tileGetForWriting(0, 0, device, LayoutConvert::ColMajor);
+        // Keep the tile cache from evicting the tile until potrf finishes.
+        A.tileCachePin( { { 0, 0 } }, device );
+        A.tileGetForWriting(0, 0, device, LayoutConvert( A.layout() ));
         lapack::Queue* queue = A.compute_queue( device, queue_index );
         auto A00 = A( 0, 0, device );
+        // Row-major as in tile::potrf.
+        Uplo uplo = A00.uploPhysical();
+        if (A00.layout() == Layout::RowMajor)
+            uplo = (uplo == Uplo::Lower ? Uplo::Upper : Uplo::Lower);
         lapack::potrf(
-            A00.uploPhysical(), A00.mb(), A00.data(),
+            uplo, A00.mb(), A00.data(),
             A00.stride(), device_info, *queue );
         lapack::device_info_int host_info;
         blas::device_memcpy( &host_info, device_info, 1, *queue );
         queue->sync();
+        A.tileCacheUnpin( { { 0, 0 } }, device );
         info = int64_t( host_info );
     }
     return info;
@@ -87,55 +194,63 @@ template
 int64_t potrf<Target::HostTask, float>(
     HermitianMatrix<float>&& A,
     int priority, int64_t queue_index,
-    lapack::device_info_int* device_info);
+    lapack::device_info_int* device_info,
+    int64_t sub_tile);
 
 // ----------------------------------------
 template
 int64_t potrf<Target::HostTask, double>(
     HermitianMatrix<double>&& A,
     int priority, int64_t queue_index,
-    lapack::device_info_int* device_info);
+    lapack::device_info_int* device_info,
+    int64_t sub_tile);
 
 // ----------------------------------------
 template
 int64_t potrf< Target::HostTask, std::complex<float> >(
     HermitianMatrix< std::complex<float> >&& A,
     int priority, int64_t queue_index,
-    lapack::device_info_int* device_info);
+    lapack::device_info_int* device_info,
+    int64_t sub_tile);
 
 // ----------------------------------------
 template
 int64_t potrf< Target::HostTask, std::complex<double> >(
     HermitianMatrix< std::complex<double> >&& A,
     int priority, int64_t queue_index,
-    lapack::device_info_int* device_info);
+    lapack::device_info_int* device_info,
+    int64_t sub_tile);
 
 template
 int64_t potrf<Target::Devices, float>(
     HermitianMatrix<float>&& A,
     int priority, int64_t queue_index,
-    lapack::device_info_int* device_info);
+    lapack::device_info_int* device_info,
+    int64_t sub_tile);
 
 // ----------------------------------------
 template
 int64_t potrf<Target::Devices, double>(
     HermitianMatrix<double>&& A,
     int priority, int64_t queue_index,
-    lapack::device_info_int* device_info);
+    lapack::device_info_int* device_info,
+    int64_t sub_tile);
 
 // ----------------------------------------
 template
 int64_t potrf< Target::Devices, std::complex<float> >(
     HermitianMatrix< std::complex<float> >&& A,
     int priority, int64_t queue_index,
-    lapack::device_info_int* device_info);
+    lapack::device_info_int* device_info,
+    int64_t sub_tile);
 
 // ----------------------------------------
 template
 int64_t potrf< Target::Devices, std::complex<double> >(
     HermitianMatrix< std::complex<double> >&& A,
     int priority, int64_t queue_index,
-    lapack::device_info_int* device_info);
+    lapack::device_info_int* device_info,
+    int64_t sub_tile);
 
 } // namespace internal
 } // namespace slate
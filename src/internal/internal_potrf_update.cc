@@ -0,0 +1,289 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/Matrix.hh"
+#include "slate/HermitianMatrix.hh"
+#include "slate/types.hh"
+#include "slate/internal/device.hh"
+#include "internal/internal_batch.hh"
+#include "internal/internal.hh"
+#include "internal/Tile_potrf_update.hh"
+
+namespace slate {
+namespace internal {
+
+//------------------------------------------------------------------------------
+/// Rank-k update (sign = 1) or downdate (sign = -1) of a single diagonal
+/// tile of a lower Cholesky factor,
+///     L00 L00^H + sign V0 V0^H,
+/// on the host of the rank owning A(0, 0), which must also hold V(0, 0)
+/// and R(0, 0). Saves the rotations in R for potrf_update_apply.
+/// @see tile::potrf_update
+/// @ingroup posv_internal
+///
+/// @return info: 0 on success, or j > 0 if the downdated matrix is not
+///     positive definite in column j of the tile.
+///
+template <typename scalar_t>
+int64_t potrf_update(
+    int sign,
+    HermitianMatrix<scalar_t>&& A,
+    Matrix<scalar_t>&& V,
+    Matrix<scalar_t>&& R)
+{
+    assert( A.mt() == 1 );
+    assert( V.mt() == 1 && V.nt() == 1 );
+    assert( R.mt() == 1 && R.nt() == 1 );
+
+    int64_t info = 0;
+    if (A.tileIsLocal( 0, 0 )) {
+        A.tileGetForWriting( 0, 0, LayoutConvert::ColMajor );
+        V.tileGetForWriting( 0, 0, LayoutConvert::ColMajor );
+        R.tileGetForWriting( 0, 0, LayoutConvert::ColMajor );
+        auto A00 = A( 0, 0 );
+        auto V00 = V( 0, 0 );
+        auto R00 = R( 0, 0 );
+        info = tile::potrf_update( sign, A00, V00, R00 );
+    }
+    return info;
+}
+
+//------------------------------------------------------------------------------
+/// Applies the rotations of a Cholesky update or downdate of a diagonal
+/// tile, from potrf_update, to the tiles of a block column below it and
+/// the same block rows of V,
+///     [ A(i, 0), V(i, 0) ] = [ A(i, 0), V(i, 0) ] Q.
+/// Each rank applies them to its local tiles of A, and must hold V(i, 0)
+/// for them, and R(0, 0).
+/// Dispatches to target implementations.
+/// @ingroup posv_internal
+///
+template <Target target, typename scalar_t>
+void potrf_update_apply(
+    int sign,
+    Matrix<scalar_t>&& R,
+    Matrix<scalar_t>&& A,
+    Matrix<scalar_t>&& V,
+    int priority, int64_t queue_index)
+{
+    potrf_update_apply( internal::TargetType<target>(),
+                        sign, R, A, V, priority, queue_index );
+}
+
+//------------------------------------------------------------------------------
+/// Applies the rotations of a Cholesky update or downdate.
+/// Host OpenMP task implementation.
+/// @ingroup posv_internal
+///
+template <typename scalar_t>
+void potrf_update_apply(
+    internal::TargetType<Target::HostTask>,
+    int sign,
+    Matrix<scalar_t>& R,
+    Matrix<scalar_t>& A,
+    Matrix<scalar_t>& V,
+    int priority, int64_t queue_index)
+{
+    assert( A.nt() == 1 );
+    assert( V.mt() == A.mt() && V.nt() == 1 );
+
+    bool any_local = false;
+    for (int64_t i = 0; i < A.mt(); ++i)
+        any_local = any_local || A.tileIsLocal( i, 0 );
+    if (! any_local)
+        return;
+
+    R.tileGetForReading( 0, 0, LayoutConvert::ColMajor );
+
+    #pragma omp taskgroup
+    for (int64_t i = 0; i < A.mt(); ++i) {
+        if (A.tileIsLocal( i, 0 )) {
+            #pragma omp task slate_omp_default_none \
+                shared( A, V, R ) firstprivate( i, sign ) priority( priority )
+            {
+                A.tileGetForWriting( i, 0, LayoutConvert::ColMajor );
+                V.tileGetForWriting( i, 0, LayoutConvert::ColMajor );
+                auto Ai0 = A( i, 0 );
+                auto Vi0 = V( i, 0 );
+                tile::potrf_update_apply( sign, R( 0, 0 ), Ai0, Vi0 );
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Applies the rotations of a Cholesky update or downdate.
+/// GPU device implementation, batched over the tiles on each device.
+/// V(i, 0) is moved to the device of A(i, 0).
+/// @ingroup posv_internal
+///
+template <typename scalar_t>
+void potrf_update_apply(
+    internal::TargetType<Target::Devices>,
+    int sign,
+    Matrix<scalar_t>& R,
+    Matrix<scalar_t>& A,
+    Matrix<scalar_t>& V,
+    int priority, int64_t queue_index)
+{
+    using ij_tuple = typename BaseMatrix<scalar_t>::ij_tuple;
+
+    assert( A.nt() == 1 );
+    assert( V.mt() == A.mt() && V.nt() == 1 );
+
+    #pragma omp taskgroup
+    for (int device = 0; device < A.num_devices(); ++device) {
+        #pragma omp task slate_omp_default_none priority( priority ) \
+            shared( A, V, R ) firstprivate( device, queue_index, sign )
+        {
+            std::set<ij_tuple> A_tiles_set, V_tiles_set;
+            for (int64_t i = 0; i < A.mt(); ++i) {
+                if (A.tileIsLocal( i, 0 ) && device == A.tileDevice( i, 0 )) {
+                    A_tiles_set.insert( { i, 0 } );
+                    V_tiles_set.insert( { i, 0 } );
+                }
+            }
+
+            int64_t batch_size = A_tiles_set.size();
+            if (batch_size > 0) {
+                A.tileGetForWriting( A_tiles_set, device, LayoutConvert::ColMajor );
+                V.tileGetForWriting( V_tiles_set, device, LayoutConvert::ColMajor );
+                R.tileGetForReading( 0, 0, device, LayoutConvert::ColMajor );
+
+                scalar_t** a_array_host = A.array_host( device, queue_index );
+                scalar_t** v_array_host = a_array_host + batch_size;
+
+                auto group_params = device_regions_build<false, 2, scalar_t>(
+                        {A, V}, {a_array_host, v_array_host}, device );
+
+                blas::Queue* queue = A.compute_queue( device, queue_index );
+
+                scalar_t** a_array_dev = A.array_device( device, queue_index );
+                scalar_t** v_array_dev = a_array_dev + batch_size;
+                A.batchArrayUpload( device, queue_index, a_array_host,
+                                    2*batch_size, *queue );
+
+                auto R00 = R( 0, 0, device );
+                for (size_t g = 0; g < group_params.size(); ++g) {
+                    int64_t group_count = group_params[ g ].count;
+                    device::batch::potrf_update_apply(
+                            A.op(), sign,
+                            group_params[ g ].mb, group_params[ g ].nb,
+                            V.tileNb( 0 ),
+                            R00.data(), R00.stride(),
+                            a_array_dev, group_params[ g ].ld[0],
+                            v_array_dev, group_params[ g ].ld[1],
+                            group_count, *queue );
+                    a_array_dev += group_count;
+                    v_array_dev += group_count;
+                }
+
+                queue->sync();
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+// ----------------------------------------
+template
+int64_t potrf_update<float>(
+    int sign,
+    HermitianMatrix<float>&& A,
+    Matrix<float>&& V,
+    Matrix<float>&& R);
+
+template
+int64_t potrf_update<double>(
+    int sign,
+    HermitianMatrix<double>&& A,
+    Matrix<double>&& V,
+    Matrix<double>&& R);
+
+template
+int64_t potrf_update< std::complex<float> >(
+    int sign,
+    HermitianMatrix< std::complex<float> >&& A,
+    Matrix< std::complex<float> >&& V,
+    Matrix< std::complex<float> >&& R);
+
+template
+int64_t potrf_update< std::complex<double> >(
+    int sign,
+    HermitianMatrix< std::complex<double> >&& A,
+    Matrix< std::complex<double> >&& V,
+    Matrix< std::complex<double> >&& R);
+
+// ----------------------------------------
+template
+void potrf_update_apply<Target::HostTask, float>(
+    int sign,
+    Matrix<float>&& R,
+    Matrix<float>&& A,
+    Matrix<float>&& V,
+    int priority, int64_t queue_index);
+
+template
+void potrf_update_apply<Target::Devices, float>(
+    int sign,
+    Matrix<float>&& R,
+    Matrix<float>&& A,
+    Matrix<float>&& V,
+    int priority, int64_t queue_index);
+
+// ----------------------------------------
+template
+void potrf_update_apply<Target::HostTask, double>(
+    int sign,
+    Matrix<double>&& R,
+    Matrix<double>&& A,
+    Matrix<double>&& V,
+    int priority, int64_t queue_index);
+
+template
+void potrf_update_apply<Target::Devices, double>(
+    int sign,
+    Matrix<double>&& R,
+    Matrix<double>&& A,
+    Matrix<double>&& V,
+    int priority, int64_t queue_index);
+
+// ----------------------------------------
+template
+void potrf_update_apply< Target::HostTask, std::complex<float> >(
+    int sign,
+    Matrix< std::complex<float> >&& R,
+    Matrix< std::complex<float> >&& A,
+    Matrix< std::complex<float> >&& V,
+    int priority, int64_t queue_index);
+
+template
+void potrf_update_apply< Target::Devices, std::complex<float> >(
+    int sign,
+    Matrix< std::complex<float> >&& R,
+    Matrix< std::complex<float> >&& A,
+    Matrix< std::complex<float> >&& V,
+    int priority, int64_t queue_index);
+
+// ----------------------------------------
+template
+void potrf_update_apply< Target::HostTask, std::complex<double> >(
+    int sign,
+    Matrix< std::complex<double> >&& R,
+    Matrix< std::complex<double> >&& A,
+    Matrix< std::complex<double> >&& V,
+    int priority, int64_t queue_index);
+
+template
+void potrf_update_apply< Target::Devices, std::complex<double> >(
+    int sign,
+    Matrix< std::complex<double> >&& R,
+    Matrix< std::complex<double> >&& A,
+    Matrix< std::complex<double> >&& V,
+    int priority, int64_t queue_index);
+
+} // namespace internal
+} // namespace slate
@@ -0,0 +1,297 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/Exception.hh"
+#include "slate/internal/comm.hh"
+#include "slate/internal/Affinity.hh"
+#include "slate/internal/openmp.hh"
+
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace slate {
+namespace internal {
+
+namespace {
+
+//------------------------------------------------------------------------------
+/// [internal]
+/// MPI request handed to the progress engine.
+/// The engine decrements *pending when the request completes.
+///
+struct ProgressItem {
+    MPI_Request request;
+    std::atomic<int>* pending;
+    ProgressItem* next;
+};
+
+//------------------------------------------------------------------------------
+/// [internal]
+/// Progress engine: a thread that drives outstanding MPI requests with
+/// MPI_Testsome, so messages, notably large rendezvous messages, progress
+/// while all OpenMP threads are computing.
+/// Requests are posted through a lock-free, multiple-producer,
+/// single-consumer stack; the engine takes all posted requests at once.
+///
+class ProgressEngine {
+public:
+    ~ProgressEngine()
+    {
+        if (thread_.joinable()) {
+            stopping_ = true;
+            thread_.join();
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    /// Starts the engine thread, if not yet running.
+    void start()
+    {
+        std::lock_guard<std::mutex> guard( mutex_ );
+        if (users_++ == 0) {
+            error_ = nullptr;
+            stopping_ = false;
+            thread_ = std::thread( &ProgressEngine::run, this );
+            active_ = true;
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    /// Stops the engine thread when the last user stops it.
+    /// Outstanding requests are completed first.
+    void stop()
+    {
+        std::lock_guard<std::mutex> guard( mutex_ );
+        if (users_ > 0 && --users_ == 0) {
+            active_ = false;
+            stopping_ = true;
+            thread_.join();
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    bool active() const
+    {
+        return active_.load( std::memory_order_acquire );
+    }
+
+    //--------------------------------------------------------------------------
+    /// Posts the chain of items first, ..., last (linked by next).
+    void post( ProgressItem* first, ProgressItem* last )
+    {
+        ProgressItem* head = head_.load( std::memory_order_relaxed );
+        do {
+            last->next = head;
+        } while (! head_.compare_exchange_weak(
+                       head, first,
+                       std::memory_order_release, std::memory_order_relaxed ));
+    }
+
+    //--------------------------------------------------------------------------
+    /// Rethrows an MPI error raised by the engine thread, if any.
+    void check_error()
+    {
+        std::exception_ptr error;
+        {
+            std::lock_guard<std::mutex> guard( error_mutex_ );
+            error = error_;
+        }
+        if (error)
+            std::rethrow_exception( error );
+    }
+
+private:
+    void run();
+
+    std::atomic<ProgressItem*> head_{ nullptr };
+    std::atomic<bool> active_{ false };
+    std::atomic<bool> stopping_{ false };
+    std::thread thread_;
+    std::mutex mutex_;          ///< guards users_ and thread_
+    int users_ = 0;
+    std::mutex error_mutex_;    ///< guards error_
+    std::exception_ptr error_;
+};
+
+//------------------------------------------------------------------------------
+/// Engine thread: takes newly posted requests, then tests all outstanding
+/// requests, until stopped and no requests remain.
+/// Runs on the panel cores, if Option::PanelCores reserved them.
+///
+void ProgressEngine::run()
+{
+    PanelBinding panel_binding;
+
+    std::vector<MPI_Request> requests;
+    std::vector< std::atomic<int>* > pendings;
+    std::vector<int> indices;
+
+    while (true) {
+        // Take all newly posted requests. Items cannot be used after
+        // their pending count is decremented, so copy them now.
+        ProgressItem* item = head_.exchange( nullptr, std::memory_order_acquire );
+        while (item != nullptr) {
+            ProgressItem* next = item->next;
+            requests.push_back( item->request );
+            pendings.push_back( item->pending );
+            item = next;
+        }
+
+        if (requests.empty()) {
+            if (stopping_.load( std::memory_order_acquire )
+                && head_.load( std::memory_order_acquire ) == nullptr)
+                break;
+            std::this_thread::yield();
+            continue;
+        }
+
+        int count = int( requests.size() );
+        int outcount = 0;
+        indices.resize( count );
+        int err = MPI_Testsome( count, requests.data(), &outcount,
+                                indices.data(), MPI_STATUSES_IGNORE );
+        if (err != MPI_SUCCESS) {
+            // Record the error and release all waiters, who rethrow it.
+            {
+                std::lock_guard<std::mutex> guard( error_mutex_ );
+                error_ = std::make_exception_ptr( MpiException(
+                    "MPI_Testsome", err, __func__, __FILE__, __LINE__ ) );
+            }
+            for (auto pending : pendings)
+                pending->fetch_sub( 1, std::memory_order_release );
+            requests.clear();
+            pendings.clear();
+            continue;
+        }
+        if (outcount == MPI_UNDEFINED || outcount == 0) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        for (int k = 0; k < outcount; ++k)
+            pendings[ indices[ k ] ]->fetch_sub( 1, std::memory_order_release );
+
+        // Remove completed requests, which are now MPI_REQUEST_NULL.
+        size_t n = 0;
+        for (size_t k = 0; k < requests.size(); ++k) {
+            if (requests[ k ] != MPI_REQUEST_NULL) {
+                requests[ n ] = requests[ k ];
+                pendings[ n ] = pendings[ k ];
+                ++n;
+            }
+        }
+        requests.resize( n );
+        pendings.resize( n );
+    }
+}
+
+//------------------------------------------------------------------------------
+ProgressEngine& progressEngine()
+{
+    static ProgressEngine engine;
+    return engine;
+}
+
+} // anonymous namespace
+
+//------------------------------------------------------------------------------
+/// [internal]
+/// Starts the MPI progress thread, which drives requests passed to
+/// internal::wait and internal::waitall. Calls are reference counted:
+/// the thread runs until progressStop is called as many times.
+/// Requires MPI_THREAD_MULTIPLE, as SLATE does anyway.
+/// @see ProgressThread
+///
+void progressStart()
+{
+    progressEngine().start();
+}
+
+//------------------------------------------------------------------------------
+/// [internal]
+/// Stops the MPI progress thread, after the last matching progressStart.
+/// Waits must not be in flight.
+///
+void progressStop()
+{
+    progressEngine().stop();
+}
+
+//------------------------------------------------------------------------------
+/// [internal]
+/// @return true if the MPI progress thread is running.
+///
+bool progressActive()
+{
+    return progressEngine().active();
+}
+
+//------------------------------------------------------------------------------
+/// [internal]
+/// Waits for all requests to complete, then sets them to MPI_REQUEST_NULL.
+///
+/// Without the progress thread, this is MPI_Waitall.
+/// With it, the requests are handed to the progress thread, and the caller
+/// yields to other OpenMP tasks (e.g., trailing updates) until they
+/// complete. Since the caller may run other tasks meanwhile, use this for
+/// sends, not for receives whose data the caller must forward, which
+/// could otherwise deadlock if a yielded-to task waits on the forwarded
+/// data.
+///
+/// @param[in,out] requests
+///     MPI requests to wait for; MPI_REQUEST_NULL entries are ignored.
+///
+void waitall(std::vector<MPI_Request>& requests)
+{
+    ProgressEngine& engine = progressEngine();
+    if (! engine.active()) {
+        slate_mpi_call(
+            MPI_Waitall( requests.size(), requests.data(), MPI_STATUSES_IGNORE ) );
+        return;
+    }
+
+    std::atomic<int> pending( 0 );
+    std::vector<ProgressItem> items;
+    items.reserve( requests.size() );
+    for (auto& request : requests) {
+        if (request != MPI_REQUEST_NULL) {
+            items.push_back( { request, &pending, nullptr } );
+            request = MPI_REQUEST_NULL;
+        }
+    }
+    if (items.empty())
+        return;
+
+    pending = int( items.size() );
+    for (size_t k = 0; k + 1 < items.size(); ++k)
+        items[ k ].next = &items[ k+1 ];
+    engine.post( &items.front(), &items.back() );
+
+    while (pending.load( std::memory_order_acquire ) > 0) {
+        #pragma omp taskyield
+        std::this_thread::yield();
+    }
+    engine.check_error();
+}
+
+//------------------------------------------------------------------------------
+/// [internal]
+/// Waits for one request; @see waitall.
+///
+/// @param[in,out] request
+///     MPI request to wait for.
+///
+void wait(MPI_Request* request)
+{
+    std::vector<MPI_Request> requests( 1, *request );
+    waitall( requests );
+    *request = MPI_REQUEST_NULL;
+}
+
+} // namespace internal
+} // namespace slate
@@ -4,6 +4,8 @@
 // the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
 
 #include "slate/types.hh"
+#include "slate/InfoRequest.hh"
+#include "slate/GrowthStats.hh"
 #include "internal/internal.hh"
 
 namespace slate {
@@ -35,5 +37,92 @@ void reduce_info( int64_t* info, MPI_Comm mpi_comm )
         *info = 0;
 }
 
+//------------------------------------------------------------------------------
+/// MPI reduce info together with growth statistics, in one reduction,
+/// used in getrf and getrf_nopiv with Option::GrowthStats.
+///
+/// @param[in,out] info
+///     As in reduce_info( info, mpi_comm ).
+///
+/// @param[in] mpi_comm
+///     MPI communicator.
+///
+/// @param[in,out] growth
+///     On input, the maxima on each rank; on output, the maxima over all
+///     MPI ranks. If null, same as reduce_info( info, mpi_comm ).
+///
+void reduce_info( int64_t* info, MPI_Comm mpi_comm, GrowthStats* growth )
+{
+    if (growth == nullptr) {
+        reduce_info( info, mpi_comm );
+        return;
+    }
+
+    // MIN of info, with double_max as the sentinel, and of the negated
+    // maxima. Info is exact in a double up to 2^53.
+    double send[ 3 ] = {
+        *info == 0 ? std::numeric_limits<double>::max() : double( *info ),
+        -growth->maxA(),
+        -growth->maxU()
+    };
+    double recv[ 3 ];
+    slate_mpi_call(
+        MPI_Allreduce( send, recv, 3, MPI_DOUBLE, MPI_MIN, mpi_comm ) );
+
+    *info = recv[ 0 ] == std::numeric_limits<double>::max()
+          ? 0 : int64_t( recv[ 0 ] );
+    growth->set( -recv[ 1 ], -recv[ 2 ] );
+}
+
+//------------------------------------------------------------------------------
+/// MPI reduce info at the end of a factorization. With Option::InfoRequest,
+/// starts a nonblocking reduction in the request instead, leaving info
+/// as this rank's status, so the next routine isn't synchronized with
+/// all ranks.
+///
+/// @param[in,out] info
+///     On input, status on each rank; 0 means no error.
+///     On output, as in reduce_info( info, mpi_comm ), or unchanged with
+///     Option::InfoRequest.
+///
+/// @param[in] mpi_comm
+///     MPI communicator.
+///
+/// @param[in] opts
+///     Options of the factorization; uses Option::InfoRequest and
+///     Option::GrowthStats, whose statistics are reduced with info.
+///
+void reduce_info( int64_t* info, MPI_Comm mpi_comm, Options const& opts )
+{
+    InfoRequest* request = get_option<Option::InfoRequest>( opts, nullptr );
+    GrowthStats* growth = get_option<Option::GrowthStats>( opts, nullptr );
+    if (request != nullptr)
+        request->start( *info, mpi_comm, growth );
+    else
+        reduce_info( info, mpi_comm, growth );
+}
+
+//------------------------------------------------------------------------------
+/// Completes the reduction of info started by a factorization with
+/// Option::InfoRequest, for routines that branch on the info of a
+/// factorization they call, so all ranks take the same branch.
+///
+/// @param[in] info
+///     Info returned by the factorization.
+///
+/// @param[in] opts
+///     Options passed to the factorization; uses Option::InfoRequest.
+///
+/// @return the reduced info of the request, if it has one pending;
+///     otherwise info, already reduced by the factorization.
+///
+int64_t wait_info( int64_t info, Options const& opts )
+{
+    InfoRequest* request = get_option<Option::InfoRequest>( opts, nullptr );
+    if (request != nullptr && request->pending())
+        return request->wait();
+    return info;
+}
+
 } // namespace internal
 } // namespace slate
@@ -0,0 +1,163 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+//------------------------------------------------------------------------------
+/// @file
+///
+#ifndef SLATE_INTERNAL_SMALL_HH
+#define SLATE_INTERNAL_SMALL_HH
+
+#include "slate/BaseMatrix.hh"
+#include "slate/types.hh"
+
+#include <vector>
+
+namespace slate {
+namespace internal {
+
+//------------------------------------------------------------------------------
+/// Default of Option::SmallTiles: matrices with at most this many tiles
+/// take the small-problem fast path.
+const int64_t small_tiles_default = 4;
+
+//------------------------------------------------------------------------------
+/// [internal]
+/// @return the MPI rank owning all tiles of A, or -1 if the tiles are on
+/// several ranks. Only the uplo triangle of triangular, trapezoid,
+/// symmetric, and Hermitian matrices is considered.
+///
+template <typename scalar_t>
+int small_owner( BaseMatrix<scalar_t>& A )
+{
+    int owner = -1;
+    for (int64_t j = 0; j < A.nt(); ++j) {
+        for (int64_t i = 0; i < A.mt(); ++i) {
+            if ((A.uplo() == Uplo::Lower && i < j)
+                || (A.uplo() == Uplo::Upper && i > j))
+                continue;
+            int rank = A.tileRank( i, j );
+            if (owner == -1)
+                owner = rank;
+            else if (rank != owner)
+                return -1;
+        }
+    }
+    return owner;
+}
+
+//------------------------------------------------------------------------------
+/// [internal]
+/// Decides whether a driver takes the small-problem fast path, which
+/// calls LAPACK or BLAS on the host on the whole matrix, gathered on the
+/// one rank that owns it, instead of building the task DAG. For a matrix
+/// of a few tiles, starting the OpenMP team, creating tasks, and changing
+/// the nested levels cost more than the computation.
+///
+/// The path is taken if:
+/// - the target is on the host (Host, HostTask, HostNest, HostBatch);
+/// - each matrix has at most Option::SmallTiles tiles (default
+///   small_tiles_default; 0 disables the fast path);
+/// - all tiles of all matrices are on the same MPI rank.
+///
+/// @param[in] matrices
+///     Matrices of the driver, in the same MPI communicator.
+///
+/// @param[in] opts
+///     Options of the driver.
+///
+/// @param[out] owner
+///     MPI rank owning all tiles, if the path is taken.
+///
+/// @return whether to take the small-problem fast path.
+///
+template <typename scalar_t>
+bool small_path(
+    std::vector< BaseMatrix<scalar_t>* > const& matrices,
+    Options const& opts, int* owner )
+{
+    int64_t small_tiles = get_option<Option::SmallTiles>(
+        opts, small_tiles_default );
+    Target target = get_option<Option::Target>( opts, Target::HostTask );
+    if (small_tiles <= 0
+        || target == Target::Devices || target == Target::Hybrid)
+        return false;
+
+    *owner = -1;
+    for (auto* A : matrices) {
+        if (A->mt() * A->nt() > small_tiles)
+            return false;
+        int rank = small_owner( *A );
+        if (rank == -1 || (*owner != -1 && rank != *owner))
+            return false;
+        *owner = rank;
+    }
+    return *owner != -1;
+}
+
+//------------------------------------------------------------------------------
+/// [internal]
+/// Copies op(A) into the column-major m-by-n array data, on the rank
+/// owning all tiles of A. Tiles are taken on the host.
+/// Only the uplo triangle of the tiles is copied, for triangular, trapezoid,
+/// symmetric, and Hermitian matrices; diagonal tiles are copied whole.
+///
+template <typename scalar_t>
+void small_gather( BaseMatrix<scalar_t>& A, scalar_t* data, int64_t ld )
+{
+    int64_t jj = 0;
+    for (int64_t j = 0; j < A.nt(); ++j) {
+        int64_t ii = 0;
+        for (int64_t i = 0; i < A.mt(); ++i) {
+            if (! ((A.uplo() == Uplo::Lower && i < j)
+                   || (A.uplo() == Uplo::Upper && i > j))) {
+                A.tileGetForReading( i, j, LayoutConvert::ColMajor );
+                auto T = A( i, j );
+                for (int64_t c = 0; c < T.nb(); ++c)
+                    for (int64_t r = 0; r < T.mb(); ++r)
+                        data[ (ii + r) + (jj + c)*ld ] = T( r, c );
+            }
+            ii += A.tileMb( i );
+        }
+        jj += A.tileNb( j );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// [internal]
+/// Copies the column-major array data back into op(A), on the rank owning
+/// all tiles of A, marking the host tiles modified. The inverse of
+/// small_gather.
+///
+template <typename scalar_t>
+void small_scatter( BaseMatrix<scalar_t>& A, scalar_t const* data, int64_t ld )
+{
+    using blas::conj;
+
+    int64_t jj = 0;
+    for (int64_t j = 0; j < A.nt(); ++j) {
+        int64_t ii = 0;
+        for (int64_t i = 0; i < A.mt(); ++i) {
+            if (! ((A.uplo() == Uplo::Lower && i < j)
+                   || (A.uplo() == Uplo::Upper && i > j))) {
+                A.tileGetForWriting( i, j, LayoutConvert::ColMajor );
+                auto T = A( i, j );
+                bool conj_tile = T.op() == Op::ConjTrans;
+                for (int64_t c = 0; c < T.nb(); ++c) {
+                    for (int64_t r = 0; r < T.mb(); ++r) {
+                        scalar_t value = data[ (ii + r) + (jj + c)*ld ];
+                        T.at( r, c ) = conj_tile ? conj( value ) : value;
+                    }
+                }
+            }
+            ii += A.tileMb( i );
+        }
+        jj += A.tileNb( j );
+    }
+}
+
+} // namespace internal
+} // namespace slate
+
+#endif // SLATE_INTERNAL_SMALL_HH
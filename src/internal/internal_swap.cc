@@ -190,6 +190,8 @@ void permuteRows(
 //------------------------------------------------------------------------------
 /// Permutes rows of a general matrix according to the pivot vector.
 /// Host implementation.
+/// Block columns with their pivoted tiles on the same ranks exchange rows
+/// in one message per pair of ranks.
 /// todo: Restructure similarly to Hermitian permuteRowsCols
 ///       (use the auxiliary swap functions).
 ///
@@ -220,37 +222,59 @@ void permuteRows(
 
         MPI_Datatype mpi_scalar = mpi_type<scalar_t>::value;
 
-        // todo: what about parallelizing this? MPI blocking?
+        // Apply pivots forward (0, ..., k-1) or reverse (k-1, ..., 0)
+        int64_t begin, end, inc;
+        if (direction == Direction::Forward) {
+            begin = 0;
+            end   = pivot.size();
+            inc   = 1;
+        }
+        else {
+            begin = pivot.size() - 1;
+            end   = -1;
+            inc   = -1;
+        }
+
+        // Block columns whose pivoted tiles are on the same ranks swap rows
+        // between the same pairs of ranks, so they are grouped, and each
+        // pair of ranks exchanges one message per group, holding the rows
+        // of all its block columns, rather than one per block column.
+        // All ranks iterate the groups in the same order.
+        std::map< std::vector<int>, std::vector<int64_t> > groups;
         for (int64_t j = 0; j < A.nt(); ++j) {
-            int root_rank = A.tileRank(0, j);
-            bool root = A.mpiRank() == A.tileRank(0, j);
+            std::vector<int> ranks;
+            for (int64_t i : pivoted_tile_rows)
+                ranks.push_back( A.tileRank( i, j ) );
+            groups[ ranks ].push_back( j );
+        }
 
-            int tag = tag_base + j;
+        for (auto const& group : groups) {
+            std::vector<int64_t> const& cols = group.second;
+            int64_t ncols = cols.size();
+            int64_t j0 = cols[ 0 ];
+            int root_rank = A.tileRank(0, j0);
+            bool root = A.mpiRank() == root_rank;
 
-            // Apply pivots forward (0, ..., k-1) or reverse (k-1, ..., 0)
-            int64_t begin, end, inc;
-            if (direction == Direction::Forward) {
-                begin = 0;
-                end   = pivot.size();
-                inc   = 1;
-            }
-            else {
-                begin = pivot.size() - 1;
-                end   = -1;
-                inc   = -1;
-            }
+            int tag = tag_base + j0;
 
-            // Get tiles needed locally for this block column
+            // Offset of each block column in the rows of the group.
+            std::vector<int64_t> col_offsets( ncols + 1, 0 );
+            for (int64_t c = 0; c < ncols; ++c)
+                col_offsets[ c+1 ] = col_offsets[ c ] + A.tileNb( cols[ c ] );
+
+            // Get tiles needed locally for these block columns
             std::set< ij_tuple > local_tiles;
-            for (int64_t i : pivoted_tile_rows) {
-                if (A.tileIsLocal(i, j)) {
-                    local_tiles.insert({i, j});
+            for (int64_t j : cols) {
+                for (int64_t i : pivoted_tile_rows) {
+                    if (A.tileIsLocal(i, j)) {
+                        local_tiles.insert({i, j});
+                    }
                 }
             }
             A.tileGetForWriting( local_tiles, LayoutConvert(layout) );
 
-            // process pivots
-            int64_t nb = A.tileNb(j);
+            // process pivots; nb is the length of the group's rows
+            int64_t nb = col_offsets[ ncols ];
 
             MPI_Datatype row_type;
             MPI_Type_contiguous(nb, mpi_scalar, &row_type);
@@ -270,7 +294,7 @@ void permuteRows(
                 std::vector<int> remote_count(comm_size + 1);
                 for (int64_t i = begin; i != end; i += inc) {
                     auto piv = pivot[i];
-                    auto swap_rank = A.tileRank(piv.tileIndex(), j);
+                    auto swap_rank = A.tileRank(piv.tileIndex(), j0);
                     if (root_rank != swap_rank) {
                         ++remote_count[swap_rank];
                     }
@@ -284,7 +308,7 @@ void permuteRows(
                 std::map<Pivot, int> remote_pivot_table;
                 for (int64_t i = begin; i != end; i += inc) {
                     auto piv = pivot[i];
-                    auto swap_rank = A.tileRank(piv.tileIndex(), j);
+                    auto swap_rank = A.tileRank(piv.tileIndex(), j0);
                     if (root_rank != swap_rank
                         && remote_pivot_table.find(piv) == remote_pivot_table.end()) {
                         int index = remote_index[swap_rank];
@@ -315,37 +339,40 @@ void permuteRows(
                 }
                 MPI_Waitall(request_count, requests.data(), MPI_STATUSES_IGNORE);
 
-                int64_t stride_0j = A(0, j).rowIncrement();
+                // Swap rows locally, in pivot order within each block column.
+                for (int64_t i = begin; i != end; i += inc) {
+                    int pivot_rank = A.tileRank(pivot[i].tileIndex(), j0);
 
-                // Swap rows locally.
-            for (int64_t i = begin; i != end; i += inc) {
-                int pivot_rank = A.tileRank(pivot[i].tileIndex(), j);
+                    for (int64_t c = 0; c < ncols; ++c) {
+                        int64_t j = cols[ c ];
+                        int64_t stride_0j = A(0, j).rowIncrement();
 
-                    if (pivot_rank == root_rank) {
-                        // If pivot not on the diagonal.
-                        if (pivot[i].tileIndex() > 0 ||
-                            pivot[i].elementOffset() > i)
-                        {
-                            // todo: assumes 1-D block cyclic distribution on devices
-                            int64_t i1 = i;
-                            int64_t i2 = pivot[i].elementOffset();
-                            int64_t idx2 = pivot[i].tileIndex();
+                        if (pivot_rank == root_rank) {
+                            // If pivot not on the diagonal.
+                            if (pivot[i].tileIndex() > 0 ||
+                                pivot[i].elementOffset() > i)
+                            {
+                                // todo: assumes 1-D block cyclic distribution on devices
+                                int64_t i1 = i;
+                                int64_t i2 = pivot[i].elementOffset();
+                                int64_t idx2 = pivot[i].tileIndex();
 
-                            int64_t stride_idx2j = A(idx2, j).rowIncrement();
+                                int64_t stride_idx2j = A(idx2, j).rowIncrement();
 
+                                blas::swap(
+                                    A.tileNb(j),
+                                    &A(0,    j).at(i1, 0), stride_0j,
+                                    &A(idx2, j).at(i2, 0), stride_idx2j);
+                            }
+                        }
+                        else {
+                            auto remote_idx = remote_pivot_table[pivot[i]];
                             blas::swap(
                                 A.tileNb(j),
-                                &A(0,    j).at(i1, 0), stride_0j,
-                                &A(idx2, j).at(i2, 0), stride_idx2j);
+                                &A(0, j).at(i, 0), stride_0j,
+                                remote_rows + nb*remote_idx + col_offsets[ c ], 1);
                         }
                     }
-                    else {
-                        auto remote_idx = remote_pivot_table[pivot[i]];
-                        blas::swap(
-                            A.tileNb(j),
-                            &A(0, j).at(i, 0), stride_0j,
-                            remote_rows + nb*remote_idx, 1);
-                    }
                 }
 
                 // Scatter remote rows.
@@ -368,7 +395,7 @@ void permuteRows(
                 int remote_length = 0;
                 for (int64_t i = begin; i != end; i += inc) {
                     auto piv = pivot[i];
-                    auto swap_rank = A.tileRank(piv.tileIndex(), j);
+                    auto swap_rank = A.tileRank(piv.tileIndex(), j0);
                     if (swap_rank == A.mpiRank()
                         && remote_pivot_table.find(piv) == remote_pivot_table.end()) {
 
@@ -381,22 +408,25 @@ void permuteRows(
                     std::vector<scalar_t> remote_rows_vect (nb*remote_length);
                     scalar_t* remote_rows = remote_rows_vect.data();
 
-                    // Pack pivot rows into workspace.
-                    int64_t count = 0;
-                    for (int64_t i = begin; i != end; i += inc) {
-                        int pivot_rank = A.tileRank(pivot[i].tileIndex(), j);
-                        if (pivot_rank == A.mpiRank()) {
-                            auto remote_idx = remote_pivot_table[pivot[i]];
-                            auto tile_index = pivot[i].tileIndex();
-                            auto tile_offset = pivot[i].elementOffset();
-
-                            if (remote_idx >= count) {
-                                int64_t stride_idxj = A(tile_index, j).rowIncrement();
-                                blas::copy(
-                                    A.tileNb(j),
-                                    &A(tile_index, j).at(tile_offset, 0), stride_idxj,
-                                    remote_rows + nb*remote_idx, 1);
-                                ++count;
+                    // Pack pivot rows of all block columns into workspace.
+                    for (int64_t c = 0; c < ncols; ++c) {
+                        int64_t j = cols[ c ];
+                        int64_t count = 0;
+                        for (int64_t i = begin; i != end; i += inc) {
+                            int pivot_rank = A.tileRank(pivot[i].tileIndex(), j);
+                            if (pivot_rank == A.mpiRank()) {
+                                auto remote_idx = remote_pivot_table[pivot[i]];
+                                auto tile_index = pivot[i].tileIndex();
+                                auto tile_offset = pivot[i].elementOffset();
+
+                                if (remote_idx >= count) {
+                                    int64_t stride_idxj = A(tile_index, j).rowIncrement();
+                                    blas::copy(
+                                        A.tileNb(j),
+                                        &A(tile_index, j).at(tile_offset, 0), stride_idxj,
+                                        remote_rows + nb*remote_idx + col_offsets[ c ], 1);
+                                    ++count;
+                                }
                             }
                         }
                     }
@@ -407,22 +437,25 @@ void permuteRows(
                     MPI_Recv(remote_rows, remote_length, row_type,
                              root_rank, tag, comm, MPI_STATUS_IGNORE);
 
-                    // Unpack pivot rows from workspace.
-                    count = 0;
-                    for (int64_t i = begin; i != end; i += inc) {
-                        int pivot_rank = A.tileRank(pivot[i].tileIndex(), j);
-                        if (pivot_rank == A.mpiRank()) {
-                            auto remote_idx = remote_pivot_table[pivot[i]];
-                            auto tile_index = pivot[i].tileIndex();
-                            auto tile_offset = pivot[i].elementOffset();
-
-                            if (remote_idx >= count) {
-                                int64_t stride_idxj = A(tile_index, j).rowIncrement();
-                                blas::copy(
-                                    A.tileNb(j),
-                                    remote_rows + nb*remote_idx, 1,
-                                    &A(tile_index, j).at(tile_offset, 0), stride_idxj);
-                                ++count;
+                    // Unpack pivot rows of all block columns from workspace.
+                    for (int64_t c = 0; c < ncols; ++c) {
+                        int64_t j = cols[ c ];
+                        int64_t count = 0;
+                        for (int64_t i = begin; i != end; i += inc) {
+                            int pivot_rank = A.tileRank(pivot[i].tileIndex(), j);
+                            if (pivot_rank == A.mpiRank()) {
+                                auto remote_idx = remote_pivot_table[pivot[i]];
+                                auto tile_index = pivot[i].tileIndex();
+                                auto tile_offset = pivot[i].elementOffset();
+
+                                if (remote_idx >= count) {
+                                    int64_t stride_idxj = A(tile_index, j).rowIncrement();
+                                    blas::copy(
+                                        A.tileNb(j),
+                                        remote_rows + nb*remote_idx + col_offsets[ c ], 1,
+                                        &A(tile_index, j).at(tile_offset, 0), stride_idxj);
+                                    ++count;
+                                }
                             }
                         }
                     }
@@ -516,8 +549,10 @@ void permuteRows(
 {
     using ij_tuple = typename Matrix<scalar_t>::ij_tuple;
 
-    // GPU uses RowMajor
-    assert(layout == Layout::RowMajor);
+    // GPU swaps contiguous rows: RowMajor tiles, or ColMajor tiles of a
+    // transposed matrix, e.g., to swap columns of A as rows of A^T.
+    assert(layout == (A.op() == Op::NoTrans ? Layout::RowMajor
+                                            : Layout::ColMajor));
 
     {
         trace::Block trace_block("internal::permuteRows");
@@ -553,6 +588,40 @@ void permuteRows(
                 scalar_t* remote_rows_dev
                     = A.allocWorkspaceBuffer(device, A.tileMb(0)*max_nb);
 
+                // The root's row swaps of several block columns are applied
+                // in one device::batch::swap_rows launch. rows1 and rows2
+                // hold the pairs of rows to swap, nswaps per block column,
+                // and are copied to the workspace rows_dev to launch.
+                int64_t nswaps = pivot.size();
+                int64_t rows_dev_size = A.tileMb(0)*max_nb;
+                scalar_t* rows_dev
+                    = A.allocWorkspaceBuffer(device, rows_dev_size);
+                int64_t max_rows = rows_dev_size * sizeof(scalar_t)
+                                 / (2 * sizeof(scalar_t*));
+                int64_t max_batch = std::min( max_rows / std::max( nswaps, int64_t( 1 ) ),
+                                              int64_t( 65535 ) );
+                slate_assert( max_batch >= 1 );
+                scalar_t** rows1_dev = (scalar_t**) rows_dev;
+                scalar_t** rows2_dev = rows1_dev + max_rows;
+                std::vector<scalar_t*> rows1, rows2;
+                int64_t batch_nb = 0;
+                int64_t batch_count = 0;
+                std::set< ij_tuple > pinned_tiles;
+                auto flush_swaps = [&]() {
+                    if (batch_count > 0) {
+                        blas::device_memcpy<scalar_t*>(
+                            rows1_dev, rows1.data(), rows1.size(), *compute_queue );
+                        blas::device_memcpy<scalar_t*>(
+                            rows2_dev, rows2.data(), rows2.size(), *compute_queue );
+                        device::batch::swap_rows(
+                            batch_nb, nswaps, rows1_dev, rows2_dev,
+                            batch_count, *compute_queue );
+                        rows1.clear();
+                        rows2.clear();
+                        batch_count = 0;
+                    }
+                };
+
                 // Apply pivots forward (0, ..., k-1) or reverse (k-1, ..., 0)
                 int64_t begin, end, inc;
                 if (direction == Direction::Forward) {
@@ -583,6 +652,9 @@ void permuteRows(
                             local_tiles.insert({i, j});
                         }
                     }
+                    // Pinned until the queue syncs at the end.
+                    A.tileCachePin( local_tiles, device );
+                    pinned_tiles.insert( local_tiles.begin(), local_tiles.end() );
                     A.tileGetForWriting( local_tiles, device,
                                          LayoutConvert(layout) );
 
@@ -658,7 +730,12 @@ void permuteRows(
                                 remote_rows_size, *compute_queue );
                         }
 
-                        // Swap rows locally.
+                        // Swap rows locally, as one set of the batch.
+                        if (nb != batch_nb || batch_count == max_batch)
+                            flush_swaps();
+                        batch_nb = nb;
+
+                        assert(A(0, j, device).layout() == layout);
                         for (int64_t i = begin; i != end; i += inc) {
                             int pivot_rank = A.tileRank(pivot[i].tileIndex(), j);
 
@@ -667,27 +744,32 @@ void permuteRows(
                                 if (pivot[i].tileIndex() > 0 ||
                                     pivot[i].elementOffset() > i)
                                     {
-                                        assert(A(0, j, device).layout() == Layout::RowMajor);
                                         int64_t i1 = i;
                                         int64_t i2 = pivot[i].elementOffset();
                                         int64_t idx2 = pivot[i].tileIndex();
-                                        blas::swap(
-                                                   A.tileNb(j),
-                                                   &A(0,    j, device).at(i1, 0), 1,
-                                                   &A(idx2, j, device).at(i2, 0), 1,
-                                                   *compute_queue);
+                                        rows1.push_back( &A(0,    j, device).at(i1, 0) );
+                                        rows2.push_back( &A(idx2, j, device).at(i2, 0) );
                                     }
+                                else {
+                                    rows1.push_back( nullptr );
+                                    rows2.push_back( nullptr );
+                                }
                             }
                             else {
                                 auto remote_idx = remote_pivot_table[pivot[i]];
-                                blas::swap(
-                                           A.tileNb(j),
-                                           &A(0, j, device).at(i, 0), 1,
-                                           remote_rows_dev + nb*remote_idx, 1,
-                                           *compute_queue);
+                                rows1.push_back( &A(0, j, device).at(i, 0) );
+                                rows2.push_back( remote_rows_dev + nb*remote_idx );
                             }
                         }
-                        compute_queue->sync();
+                        ++batch_count;
+
+                        // Columns without remote rows wait to be swapped
+                        // together; remote rows must be swapped before
+                        // they are scattered back.
+                        if (remote_rows_size > 0) {
+                            flush_swaps();
+                            compute_queue->sync();
+                        }
 
                         if (!using_gpu_aware_mpi) {
                             blas::device_memcpy<scalar_t>(
@@ -798,7 +880,10 @@ void permuteRows(
 
                     MPI_Type_free(&row_type);
                 }
+                flush_swaps();
                 compute_queue->sync();
+                A.tileCacheUnpin( pinned_tiles, device );
+                A.freeWorkspaceBuffer(device, rows_dev);
                 A.freeWorkspaceBuffer(device, remote_rows_dev);
             }
         }
@@ -198,7 +198,6 @@ void syrk(internal::TargetType<Target::HostBatch>,
           scalar_t beta,  SymmetricMatrix<scalar_t>& C,
           int priority, int queue_index, Layout layout )
 {
-#ifdef BLAS_HAVE_MKL
     // CPU assumes column major
     // todo: relax this assumption, by allowing Tile_blas.hh::syrk()
     //       to take layout param
@@ -261,11 +260,9 @@ void syrk(internal::TargetType<Target::HostBatch>,
         Op opB = (opA == Op::NoTrans ? Op::Trans : Op::NoTrans);
 
         // all same
-        std::vector<CBLAS_TRANSPOSE> opA_array(batch_count,
-                                               cblas_trans_const(opA));
+        std::vector<Op> opA_array(batch_count, opA);
         // all same
-        std::vector<CBLAS_TRANSPOSE> opB_array(batch_count,
-                                               cblas_trans_const(opB));
+        std::vector<Op> opB_array(batch_count, opB);
         std::vector<int> m_array(batch_count);
         std::vector<int> n_array(batch_count);
         std::vector<int> k_array(batch_count);
@@ -313,27 +310,21 @@ void syrk(internal::TargetType<Target::HostBatch>,
         }
 
         {
-            trace::Block trace_block("cblas_gemm_batch");
-            // mkl_set_num_threads_local(...);
-            cblas_gemm_batch(CblasColMajor,
-                             opA_array.data(), opB_array.data(),
-                             m_array.data(), n_array.data(), k_array.data(),
-                             alpha_array.data(),
-                             a_array.data(), lda_array.data(),
-                             b_array.data(), ldb_array.data(),
-                             beta_array.data(),
-                             c_array.data(), ldc_array.data(),
-                             batch_count, group_size.data());
-            // mkl_set_num_threads_local(1);
+            trace::Block trace_block("host_gemm_batch");
+            host_gemm_batch(Layout::ColMajor,
+                            opA_array.data(), opB_array.data(),
+                            m_array.data(), n_array.data(), k_array.data(),
+                            alpha_array.data(),
+                            a_array.data(), lda_array.data(),
+                            b_array.data(), ldb_array.data(),
+                            beta_array.data(),
+                            c_array.data(), ldc_array.data(),
+                            batch_count, group_size.data());
         }
     }
 
     if (err)
         throw std::exception();
-#else
-    slate_not_implemented(
-        "slate::Target::HostBatch needs Intel MKL.");
-#endif
 }
 
 //------------------------------------------------------------------------------
@@ -479,7 +470,19 @@ void syrk(internal::TargetType<Target::Devices>,
                             std::vector<scalar_t*> a_array(a_array_host, a_array_host+group_count);
                             std::vector<scalar_t*> c_array(c_array_host, c_array_host+group_count);
 
-                            if (group_params[ g ].is_diagonal) {
+                            if (group_params[ g ].is_diagonal
+                                && group_count > 1
+                                && layout == Layout::ColMajor) {
+                                // One vendor syrk per tile would
+                                // serialize the diagonal tiles.
+                                device_herk_diag(
+                                    uplo[ 0 ], opA, opB, n[ 0 ], k[ 0 ],
+                                    alpha_[ 0 ], a_array, ldda[ 0 ],
+                                    beta_[ 0 ],  c_array, lddc[ 0 ],
+                                    C, device, queue_index, batch_size,
+                                    *queue );
+                            }
+                            else if (group_params[ g ].is_diagonal) {
                                 blas::batch::syrk(
                                     layout, uplo, opA_,
                                     n, k,
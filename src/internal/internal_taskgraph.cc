@@ -0,0 +1,272 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/internal/TaskGraph.hh"
+#include "slate/internal/openmp.hh"
+
+#include <algorithm>
+#include <thread>
+
+namespace slate {
+namespace internal {
+
+//------------------------------------------------------------------------------
+/// [internal]
+/// Task in the graph. It is ready when deps reaches 0; deps starts at 1,
+/// which add() releases after adding all edges.
+///
+struct TaskGraph::Task {
+    std::function< void () > body;
+    int priority;
+    int64_t seq;
+    std::atomic<int> deps{ 1 };
+    std::mutex mutex;           ///< guards done and successors
+    bool done = false;
+    std::vector< Task* > successors;
+};
+
+//------------------------------------------------------------------------------
+/// [internal]
+/// Ready tasks of one thread, as a heap with the highest priority,
+/// then earliest submitted, task on top.
+/// Padded to a cache line, as each thread mostly uses its own queue.
+///
+struct alignas(64) TaskGraph::ReadyQueue {
+    /// Heap order: true if task a runs after task b.
+    static bool runsAfter( Task const* a, Task const* b )
+    {
+        return a->priority != b->priority ? a->priority < b->priority
+                                          : a->seq > b->seq;
+    }
+
+    std::mutex mutex;           ///< guards heap
+    std::vector< Task* > heap;
+};
+
+//------------------------------------------------------------------------------
+/// Creates an empty task graph.
+///
+TaskGraph::TaskGraph()
+    : pending_( 0 ),
+      closed_( false ),
+      num_steals_( 0 ),
+      num_tasks_( 0 )
+{}
+
+//------------------------------------------------------------------------------
+TaskGraph::~TaskGraph()
+{}
+
+//------------------------------------------------------------------------------
+/// Runs the graph: in an OpenMP parallel region, the master thread calls
+/// submit( *this ) to add tasks, while all threads, including the master
+/// after submit returns, execute tasks until all are finished.
+///
+/// If a task or submit throws, later task bodies are skipped and the
+/// first exception is rethrown here, after all threads are done.
+///
+void TaskGraph::run( std::function< void (TaskGraph&) > submit )
+{
+    closed_ = false;
+    error_ = nullptr;
+    queues_.clear();
+    int max_threads = omp_get_max_threads();
+    for (int thread = 0; thread < max_threads; ++thread)
+        queues_.emplace_back( new ReadyQueue );
+
+    #pragma omp parallel
+    {
+        #pragma omp master
+        {
+            try {
+                submit( *this );
+            }
+            catch (...) {
+                std::lock_guard<std::mutex> guard( error_mutex_ );
+                if (! error_)
+                    error_ = std::current_exception();
+            }
+            closed_ = true;
+        }
+        work();
+    }
+
+    num_tasks_ = tasks_.size();
+    tasks_.clear();
+    keys_.clear();
+    queues_.clear();
+
+    if (error_)
+        std::rethrow_exception( error_ );
+}
+
+//------------------------------------------------------------------------------
+/// Adds a task; called only by the thread running submit.
+/// Like depend(in:) and depend(inout:), the task runs after the last task
+/// that wrote any of its in or inout keys; tasks writing an inout key also
+/// run after all tasks that read it since its last write.
+///
+/// @param[in] priority
+///     Larger runs first among ready tasks; equal priorities run in
+///     submission order.
+///
+/// @param[in] in
+///     Keys the task reads.
+///
+/// @param[in] inout
+///     Keys the task writes.
+///
+/// @param[in] body
+///     Work of the task.
+///
+void TaskGraph::add(
+    int priority,
+    std::vector<Key> const& in,
+    std::vector<Key> const& inout,
+    std::function< void () > body )
+{
+    tasks_.emplace_back( new Task );
+    Task* task = tasks_.back().get();
+    task->body     = std::move( body );
+    task->priority = priority;
+    task->seq      = tasks_.size();
+    pending_.fetch_add( 1 );
+
+    for (auto& key : in) {
+        KeyState& state = keys_[ key ];
+        if (state.writer != nullptr)
+            addEdge( state.writer, task );
+        state.readers.push_back( task );
+    }
+    for (auto& key : inout) {
+        KeyState& state = keys_[ key ];
+        if (state.readers.empty()) {
+            if (state.writer != nullptr)
+                addEdge( state.writer, task );
+        }
+        else {
+            for (Task* reader : state.readers) {
+                if (reader != task)
+                    addEdge( reader, task );
+            }
+            state.readers.clear();
+        }
+        state.writer = task;
+    }
+
+    if (task->deps.fetch_sub( 1 ) == 1)
+        push( task, omp_get_thread_num() );
+}
+
+//------------------------------------------------------------------------------
+/// Makes task depend on pred, unless pred is already done.
+///
+void TaskGraph::addEdge( Task* pred, Task* task )
+{
+    std::lock_guard<std::mutex> guard( pred->mutex );
+    if (! pred->done) {
+        task->deps.fetch_add( 1 );
+        pred->successors.push_back( task );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Puts a ready task in the thread's queue.
+///
+void TaskGraph::push( Task* task, int thread )
+{
+    ReadyQueue& queue = *queues_[ thread ];
+    std::lock_guard<std::mutex> guard( queue.mutex );
+    queue.heap.push_back( task );
+    std::push_heap( queue.heap.begin(), queue.heap.end(),
+                    ReadyQueue::runsAfter );
+}
+
+//------------------------------------------------------------------------------
+/// @return the top task of the thread's own queue, or else a task stolen
+/// from the top of another thread's queue; or null if none is ready.
+///
+TaskGraph::Task* TaskGraph::pop( int thread )
+{
+    int num_queues = queues_.size();
+    for (int k = 0; k < num_queues; ++k) {
+        ReadyQueue& queue = *queues_[ (thread + k) % num_queues ];
+        std::unique_lock<std::mutex> lock( queue.mutex, std::defer_lock );
+        // Don't wait on a victim's queue that is busy.
+        if (k == 0)
+            lock.lock();
+        else if (! lock.try_lock())
+            continue;
+        if (! queue.heap.empty()) {
+            std::pop_heap( queue.heap.begin(), queue.heap.end(),
+                           ReadyQueue::runsAfter );
+            Task* task = queue.heap.back();
+            queue.heap.pop_back();
+            if (k > 0)
+                num_steals_.fetch_add( 1, std::memory_order_relaxed );
+            return task;
+        }
+    }
+    return nullptr;
+}
+
+//------------------------------------------------------------------------------
+/// Executes a task, then releases its successors into the thread's queue.
+///
+void TaskGraph::execute( Task* task, int thread )
+{
+    bool failed;
+    {
+        std::lock_guard<std::mutex> guard( error_mutex_ );
+        failed = bool( error_ );
+    }
+    if (! failed) {
+        try {
+            task->body();
+        }
+        catch (...) {
+            std::lock_guard<std::mutex> guard( error_mutex_ );
+            if (! error_)
+                error_ = std::current_exception();
+        }
+    }
+    // Release captured objects now, not when the graph is destroyed.
+    task->body = nullptr;
+
+    std::vector< Task* > successors;
+    {
+        std::lock_guard<std::mutex> guard( task->mutex );
+        task->done = true;
+        successors.swap( task->successors );
+    }
+    for (Task* successor : successors) {
+        if (successor->deps.fetch_sub( 1 ) == 1)
+            push( successor, thread );
+    }
+    pending_.fetch_sub( 1 );
+}
+
+//------------------------------------------------------------------------------
+/// Executes tasks until submission is closed and all tasks are finished.
+/// While idle, yields to OpenMP tasks created inside task bodies.
+///
+void TaskGraph::work()
+{
+    int thread = omp_get_thread_num();
+    while (true) {
+        Task* task = pop( thread );
+        if (task != nullptr) {
+            execute( task, thread );
+            continue;
+        }
+        if (closed_.load() && pending_.load() == 0)
+            break;
+        #pragma omp taskyield
+        std::this_thread::yield();
+    }
+}
+
+} // namespace internal
+} // namespace slate
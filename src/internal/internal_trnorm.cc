@@ -448,8 +448,7 @@ void norm(
             {
                 trace::Block trace_block("slate::device::trnorm");
 
-                blas::device_memcpy<scalar_t*>(
-                    a_array_dev, a_array_host, batch_size, *queue );
+                A.batchArrayUpload( device, queue_index, a_array_host, batch_size, *queue );
 
                 real_t* vals_dev_array_group = vals_dev_array;
                 for (size_t g = 0; g < group_params.size(); ++g) {
@@ -43,12 +43,7 @@ void trsm(internal::TargetType<Target::HostTask>,
                                     Matrix<scalar_t>& B,
           int priority, Layout layout, int64_t queue_index )
 {
-    // CPU assumes column major
-    // todo: relax this assumption, by allowing Tile_blas.hh::trsm()
-    //       to take layout param
-    // todo: optimize for the number of layout conversions,
-    //       by watching 'layout' and 'B(i, j).layout()'
-    assert(layout == Layout::ColMajor);
+    // Tiles are computed on in layout, ColMajor or RowMajor.
     assert(A.mt() == 1);
 
     if (B.numLocalTiles() > 0) {
@@ -198,6 +193,9 @@ void trsm(internal::TargetType<Target::Devices>,
 
             int64_t batch_size = B_tiles_set.size();
             if (batch_size > 0) {
+                // Keep the tile cache from evicting tiles until kernels finish.
+                A.tileCachePin( { { 0, 0 } }, device );
+                B.tileCachePin( B_tiles_set, device );
 
                 A.tileGetForReading(0, 0, device, LayoutConvert(layout));
                 B.tileGetForWriting(B_tiles_set, device, LayoutConvert(layout));
@@ -224,10 +222,13 @@ void trsm(internal::TargetType<Target::Devices>,
 
                     blas::Queue* queue = B.compute_queue(device, queue_index);
                     assert(queue != nullptr);
+                    trace::DeviceBlock trace_device("blas::batch::trsm", *queue);
 
                     for (size_t g = 0; g < group_params.size(); ++g) {
 
                         int64_t group_count = group_params[ g ].count;
+                        internal::count( internal::Count::BatchLaunches );
+                        internal::count( internal::Count::BatchTiles, group_count );
 
                         std::vector<int64_t>    m(1, group_params[ g ].mb);
                         std::vector<int64_t>    n(1, group_params[ g ].nb);
@@ -254,6 +255,8 @@ void trsm(internal::TargetType<Target::Devices>,
 
                     queue->sync();
                 }
+                A.tileCacheUnpin( { { 0, 0 } }, device );
+                B.tileCacheUnpin( B_tiles_set, device );
             }
         }
     }
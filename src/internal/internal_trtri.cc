@@ -8,6 +8,8 @@
 #include "slate/types.hh"
 #include "internal/Tile_lapack.hh"
 #include "internal/internal.hh"
+#include "slate/internal/device.hh"
+#include "blas/device.hh"
 
 namespace slate {
 namespace internal {
@@ -18,9 +20,9 @@ namespace internal {
 /// @ingroup tr_internal
 ///
 template <Target target, typename scalar_t>
-void trtri(TriangularMatrix< scalar_t >&& A, int priority)
+void trtri(TriangularMatrix< scalar_t >&& A, int priority, int64_t queue_index)
 {
-    trtri(internal::TargetType<target>(), A, priority);
+    trtri(internal::TargetType<target>(), A, priority, queue_index);
 }
 
 //------------------------------------------------------------------------------
@@ -29,7 +31,7 @@ void trtri(TriangularMatrix< scalar_t >&& A, int priority)
 ///
 template <typename scalar_t>
 void trtri(internal::TargetType<Target::HostTask>,
-           TriangularMatrix<scalar_t>& A, int priority)
+           TriangularMatrix<scalar_t>& A, int priority, int64_t queue_index)
 {
     assert(A.mt() == 1);
     assert(A.nt() == 1);
@@ -40,31 +42,113 @@ void trtri(internal::TargetType<Target::HostTask>,
     }
 }
 
+//------------------------------------------------------------------------------
+/// Triangular inversion of single tile, GPU device implementation.
+/// Solves $A X = I$ with a device trsm into a workspace, then copies
+/// X back to the triangle of A, leaving the other triangle untouched.
+/// For a unit diagonal, the diagonal is not referenced.
+/// Unlike the host version, does not check for a singular tile.
+/// @ingroup tr_internal
+///
+template <typename scalar_t>
+void trtri(internal::TargetType<Target::Devices>,
+           TriangularMatrix<scalar_t>& A, int priority, int64_t queue_index)
+{
+    const scalar_t zero = 0.0;
+    const scalar_t one  = 1.0;
+
+    assert(A.mt() == 1);
+    assert(A.nt() == 1);
+
+    if (A.tileIsLocal(0, 0)) {
+        int device = A.tileDevice(0, 0);
+        A.tileGetForWriting(0, 0, device, LayoutConvert::ColMajor);
+
+        lapack::Queue* queue = A.compute_queue( device, queue_index );
+
+        auto T = A( 0, 0, device );
+        Uplo uplo = T.uploPhysical();
+        int64_t nb = T.nb();
+
+        // X, then pointer arrays for tzcopy.
+        int64_t ptrs_size = ceildiv( 2*sizeof(scalar_t*), sizeof(scalar_t) );
+        scalar_t* W = A.allocWorkspaceBuffer( device, nb*nb + ptrs_size );
+        scalar_t** dptrs = (scalar_t**) &W[ nb*nb ];
+
+        // X = A^{-1}, from A X = I.
+        device::geset( nb, nb, zero, one, W, nb, *queue );
+        blas::trsm( Layout::ColMajor, Side::Left, uplo,
+                    Op::NoTrans, A.diag(),
+                    nb, nb,
+                    one, T.data(), T.stride(),
+                         W, nb, *queue );
+
+        // Copy the triangle of X back to A,
+        // excluding the diagonal for a unit diagonal.
+        int64_t offset_W = 0, offset_T = 0, n = nb;
+        if (A.diag() == Diag::Unit) {
+            n = nb - 1;
+            offset_W = (uplo == Uplo::Lower ? 1 : nb);
+            offset_T = (uplo == Uplo::Lower ? 1 : T.stride());
+        }
+        if (n > 0) {
+            scalar_t* hptrs[ 2 ] = { &W[ offset_W ], &T.data()[ offset_T ] };
+            blas::device_memcpy<scalar_t*>( dptrs, hptrs, 2, *queue );
+            device::tzcopy( uplo, n, n, &dptrs[ 0 ], nb,
+                            &dptrs[ 1 ], T.stride(), 1, *queue );
+        }
+
+        queue->sync();
+
+        A.freeWorkspaceBuffer( device, W );
+    }
+}
+
 //------------------------------------------------------------------------------
 // Explicit instantiations.
 // ----------------------------------------
 template
 void trtri<Target::HostTask, float>(
     TriangularMatrix<float>&& A,
-    int priority);
+    int priority, int64_t queue_index);
+
+template
+void trtri<Target::Devices, float>(
+    TriangularMatrix<float>&& A,
+    int priority, int64_t queue_index);
 
 // ----------------------------------------
 template
 void trtri<Target::HostTask, double>(
     TriangularMatrix<double>&& A,
-    int priority);
+    int priority, int64_t queue_index);
+
+template
+void trtri<Target::Devices, double>(
+    TriangularMatrix<double>&& A,
+    int priority, int64_t queue_index);
 
 // ----------------------------------------
 template
 void trtri< Target::HostTask, std::complex<float> >(
     TriangularMatrix< std::complex<float> >&& A,
-    int priority);
+    int priority, int64_t queue_index);
+
+template
+void trtri< Target::Devices, std::complex<float> >(
+    TriangularMatrix< std::complex<float> >&& A,
+    int priority, int64_t queue_index);
 
 // ----------------------------------------
 template
 void trtri< Target::HostTask, std::complex<double> >(
     TriangularMatrix< std::complex<double> >&& A,
-    int priority);
+    int priority, int64_t queue_index);
+
+template
+void trtri< Target::Devices, std::complex<double> >(
+    TriangularMatrix< std::complex<double> >&& A,
+    int priority, int64_t queue_index);
 
 } // namespace internal
 } // namespace slate
@@ -8,31 +8,30 @@
 #include "slate/types.hh"
 #include "internal/Tile_lapack.hh"
 #include "internal/internal.hh"
+#include "slate/internal/device.hh"
+#include "blas/device.hh"
 
 namespace slate {
 namespace internal {
 
 //------------------------------------------------------------------------------
-///
-/// todo: update docs: multiply not inverse
-///
-/// Triangular inversion of single tile.
+/// Triangular multiplication $L = L^H L$ or $U = U U^H$ of single tile.
 /// Dispatches to target implementations.
 /// @ingroup tr_internal
 ///
 template <Target target, typename scalar_t>
-void trtrm(TriangularMatrix< scalar_t >&& A, int priority)
+void trtrm(TriangularMatrix< scalar_t >&& A, int priority, int64_t queue_index)
 {
-    trtrm(internal::TargetType<target>(), A, priority);
+    trtrm(internal::TargetType<target>(), A, priority, queue_index);
 }
 
 //------------------------------------------------------------------------------
-/// Triangular inversion of single tile, host implementation.
+/// Triangular multiplication of single tile, host implementation.
 /// @ingroup tr_internal
 ///
 template <typename scalar_t>
 void trtrm(internal::TargetType<Target::HostTask>,
-           TriangularMatrix<scalar_t>& A, int priority)
+           TriangularMatrix<scalar_t>& A, int priority, int64_t queue_index)
 {
     assert(A.mt() == 1);
     assert(A.nt() == 1);
@@ -43,31 +42,118 @@ void trtrm(internal::TargetType<Target::HostTask>,
     }
 }
 
+//------------------------------------------------------------------------------
+/// Triangular multiplication $L = L^H L$ or $U = U U^H$ of single tile,
+/// GPU device implementation, as in lauum.
+/// Copies the triangle of A into a zeroed workspace W, computes
+/// W = L^H W or W = W U^H with a device trmm, then copies the triangle of W
+/// back to A, leaving the other triangle untouched.
+/// @ingroup tr_internal
+///
+template <typename scalar_t>
+void trtrm(internal::TargetType<Target::Devices>,
+           TriangularMatrix<scalar_t>& A, int priority, int64_t queue_index)
+{
+    const scalar_t zero = 0.0;
+    const scalar_t one  = 1.0;
+
+    assert(A.mt() == 1);
+    assert(A.nt() == 1);
+
+    if (A.tileIsLocal(0, 0)) {
+        int device = A.tileDevice(0, 0);
+        A.tileGetForWriting(0, 0, device, LayoutConvert::ColMajor);
+
+        lapack::Queue* queue = A.compute_queue( device, queue_index );
+
+        auto T = A( 0, 0, device );
+        Uplo uplo = T.uploPhysical();
+        int64_t nb = T.nb();
+
+        // W, then pointer arrays for tzcopy.
+        int64_t ptrs_size = ceildiv( 2*sizeof(scalar_t*), sizeof(scalar_t) );
+        scalar_t* W = A.allocWorkspaceBuffer( device, nb*nb + ptrs_size );
+        scalar_t** dptrs = (scalar_t**) &W[ nb*nb ];
+        scalar_t* hptrs[ 2 ] = { T.data(), W };
+        blas::device_memcpy<scalar_t*>( dptrs, hptrs, 2, *queue );
+
+        // W = triangle of A, zero elsewhere.
+        device::geset( nb, nb, zero, zero, W, nb, *queue );
+        device::tzcopy( uplo, nb, nb, &dptrs[ 0 ], T.stride(),
+                        &dptrs[ 1 ], nb, 1, *queue );
+
+        if (uplo == Uplo::Lower) {
+            // W = L^H L
+            blas::trmm( Layout::ColMajor, Side::Left, uplo,
+                        Op::ConjTrans, Diag::NonUnit,
+                        nb, nb,
+                        one, T.data(), T.stride(),
+                             W, nb, *queue );
+        }
+        else {
+            // W = U U^H
+            blas::trmm( Layout::ColMajor, Side::Right, uplo,
+                        Op::ConjTrans, Diag::NonUnit,
+                        nb, nb,
+                        one, T.data(), T.stride(),
+                             W, nb, *queue );
+        }
+
+        // Copy the triangle of W back to A.
+        device::tzcopy( uplo, nb, nb, &dptrs[ 1 ], nb,
+                        &dptrs[ 0 ], T.stride(), 1, *queue );
+
+        queue->sync();
+
+        A.freeWorkspaceBuffer( device, W );
+    }
+}
+
 //------------------------------------------------------------------------------
 // Explicit instantiations.
 // ----------------------------------------
 template
 void trtrm<Target::HostTask, float>(
     TriangularMatrix<float>&& A,
-    int priority);
+    int priority, int64_t queue_index);
+
+template
+void trtrm<Target::Devices, float>(
+    TriangularMatrix<float>&& A,
+    int priority, int64_t queue_index);
 
 // ----------------------------------------
 template
 void trtrm<Target::HostTask, double>(
     TriangularMatrix<double>&& A,
-    int priority);
+    int priority, int64_t queue_index);
+
+template
+void trtrm<Target::Devices, double>(
+    TriangularMatrix<double>&& A,
+    int priority, int64_t queue_index);
 
 // ----------------------------------------
 template
 void trtrm< Target::HostTask, std::complex<float> >(
     TriangularMatrix< std::complex<float> >&& A,
-    int priority);
+    int priority, int64_t queue_index);
+
+template
+void trtrm< Target::Devices, std::complex<float> >(
+    TriangularMatrix< std::complex<float> >&& A,
+    int priority, int64_t queue_index);
 
 // ----------------------------------------
 template
 void trtrm< Target::HostTask, std::complex<double> >(
     TriangularMatrix< std::complex<double> >&& A,
-    int priority);
+    int priority, int64_t queue_index);
+
+template
+void trtrm< Target::Devices, std::complex<double> >(
+    TriangularMatrix< std::complex<double> >&& A,
+    int priority, int64_t queue_index);
 
 } // namespace internal
 } // namespace slate
@@ -8,6 +8,8 @@
 #include "internal/Tile_tpmqrt.hh"
 #include "internal/internal.hh"
 #include "internal/internal_util.hh"
+#include "slate/internal/device.hh"
+#include "blas/device.hh"
 
 namespace slate {
 namespace internal {
@@ -20,6 +22,7 @@ namespace internal {
 /// However, it necessarily handles communication for C.
 /// Tag is used in geqrf to differentiate communication for look-ahead panel
 /// from rest of trailing matrix.
+/// Arity is that of the reduction tree, which must match the one in ttqrt.
 /// @ingroup geqrf_internal
 ///
 template <Target target, typename scalar_t>
@@ -27,25 +30,149 @@ void ttmqr(Side side, Op op,
            Matrix<scalar_t>&& A,
            Matrix<scalar_t>&& T,
            Matrix<scalar_t>&& C,
-           int tag )
+           int tag, int queue_index, int arity )
 {
     ttmqr(internal::TargetType<target>(),
-          side, op, A, T, C, tag );
+          side, op, A, T, C, tag, queue_index, arity );
+}
+
+//------------------------------------------------------------------------------
+/// Multiply [ C(i1, j1); C(i2, j2) ] from the left, or [ C(i1, j1) C(i2, j2) ]
+/// from the right, by op(Q) from the triangle-triangle QR factorization in
+/// A(i, 0) and T(i, 0), on a device; the device equivalent of tile::tpmqrt
+/// with l = m. V2 is copied with zeros below its upper trapezoid, then each
+/// block of ib reflectors is applied with gemm and trmm, in the same order
+/// as tpmqrt.
+/// C may be any matrix type, e.g., Hermitian in hettmqr.
+/// @ingroup geqrf_internal
+///
+template <typename scalar_t>
+void tpmqrt_device(
+    Side side, Op op,
+    Matrix<scalar_t>& A, Matrix<scalar_t>& T, int64_t i,
+    BaseMatrix<scalar_t>& C, int64_t i1, int64_t j1, int64_t i2, int64_t j2,
+    int device, int queue_index )
+{
+    using blas::device_memcpy_2d;
+
+    const scalar_t zero = 0.0;
+    const scalar_t one  = 1.0;
+
+    blas::Queue* queue = C.compute_queue( device, queue_index );
+
+    auto V2 = A( i, 0, device );
+    auto Ti = T( i, 0, device );
+    auto C1 = C( i1, j1, device );
+    auto C2 = C( i2, j2, device );
+
+    // Upper trapezoid of V2 is m-by-k.
+    // Left:  C1 is k-by-n, C2 is m-by-n.
+    // Right: C1 is n-by-k, C2 is n-by-m.
+    bool left   = side == Side::Left;
+    int64_t k   = V2.nb();
+    int64_t m   = std::min( V2.mb(), k );
+    int64_t n   = left ? C2.nb() : C2.mb();
+    int64_t ib  = std::min( Ti.mb(), k );
+    int64_t ldt = Ti.stride();
+    int64_t ld1 = C1.stride();
+    int64_t ld2 = C2.stride();
+
+    // V2 with zeros below its upper trapezoid, and W, ib-by-n or n-by-ib.
+    scalar_t* V = C.allocWorkspaceBuffer( device, m*k + ib*n );
+    scalar_t* W = &V[ m*k ];
+
+    device_memcpy_2d<scalar_t>( V, m, V2.data(), V2.stride(), m, k, *queue );
+    if (m > 1) {
+        device::tzset( Uplo::Lower, m-1, k, zero, zero, &V[ 1 ], m, *queue );
+    }
+
+    // Reverse order for Q C and C Q^H.
+    bool reverse = (left == (op == Op::NoTrans));
+    int64_t nblocks = ceildiv( k, ib );
+    for (int64_t b = 0; b < nblocks; ++b) {
+        int64_t j0 = (reverse ? nblocks-1 - b : b) * ib;
+        int64_t jb = std::min( k-j0, ib );
+
+        if (left) {
+            scalar_t* C1_j0 = &C1.data()[ j0 ];
+
+            // W = C1( j0 : j0+jb, : ) + V( :, j0 : j0+jb )^H C2
+            device_memcpy_2d<scalar_t>( W, ib, C1_j0, ld1, jb, n, *queue );
+            blas::gemm( Layout::ColMajor,
+                        Op::ConjTrans, Op::NoTrans,
+                        jb, n, m,
+                        one, &V[ j0*m ], m,
+                             C2.data(), ld2,
+                        one, W, ib, *queue );
+
+            // W = op( T_j0 ) W
+            blas::trmm( Layout::ColMajor,
+                        Side::Left, Uplo::Upper, op, Diag::NonUnit,
+                        jb, n,
+                        one, &Ti.data()[ j0*ldt ], ldt,
+                             W, ib, *queue );
+
+            // C1( j0 : j0+jb, : ) -= W,  C2 -= V( :, j0 : j0+jb ) W
+            device::geadd( jb, n, -one, W, ib, one, C1_j0, ld1, *queue );
+            blas::gemm( Layout::ColMajor,
+                        Op::NoTrans, Op::NoTrans,
+                        m, n, jb,
+                        -one, &V[ j0*m ], m,
+                              W, ib,
+                        one,  C2.data(), ld2, *queue );
+        }
+        else {
+            scalar_t* C1_j0 = &C1.data()[ j0*ld1 ];
+
+            // W = C1( :, j0 : j0+jb ) + C2 V( :, j0 : j0+jb )
+            device_memcpy_2d<scalar_t>( W, n, C1_j0, ld1, n, jb, *queue );
+            blas::gemm( Layout::ColMajor,
+                        Op::NoTrans, Op::NoTrans,
+                        n, jb, m,
+                        one, C2.data(), ld2,
+                             &V[ j0*m ], m,
+                        one, W, n, *queue );
+
+            // W = W op( T_j0 )
+            blas::trmm( Layout::ColMajor,
+                        Side::Right, Uplo::Upper, op, Diag::NonUnit,
+                        n, jb,
+                        one, &Ti.data()[ j0*ldt ], ldt,
+                             W, n, *queue );
+
+            // C1( :, j0 : j0+jb ) -= W,  C2 -= W V( :, j0 : j0+jb )^H
+            device::geadd( n, jb, -one, W, n, one, C1_j0, ld1, *queue );
+            blas::gemm( Layout::ColMajor,
+                        Op::NoTrans, Op::ConjTrans,
+                        n, m, jb,
+                        -one, W, n,
+                              &V[ j0*m ], m,
+                        one,  C2.data(), ld2, *queue );
+        }
+    }
+
+    queue->sync();
+
+    C.freeWorkspaceBuffer( device, V );
 }
 
 //------------------------------------------------------------------------------
 /// Distributed multiply matrix by Q from QR triangle-triangle factorization of
-/// column of tiles, host implementation.
+/// column of tiles, with tile pairs updated on the host or, for
+/// target = Devices, on the device of the local tile of C, using
+/// queue_index.
 /// @ingroup geqrf_internal
 ///
 template <typename scalar_t>
-void ttmqr(internal::TargetType<Target::HostTask>,
+void ttmqr(Target target,
            Side side, Op op,
            Matrix<scalar_t>& A,
            Matrix<scalar_t>& T,
            Matrix<scalar_t>& C,
-           int tag )
+           int tag, int queue_index, int arity )
 {
+    assert( target == Target::HostTask || side == Side::Left );
+
     // Assumes column major
     const Layout layout = Layout::ColMajor;
 
@@ -77,14 +204,13 @@ void ttmqr(internal::TargetType<Target::HostTask>,
               compareSecond<int, int64_t>);
 
     int nranks = rank_indices.size();
-    int nlevels = int( ceil( log2( nranks ) ) );
 
     // Apply reduction tree.
     // If Left, NoTrans or Right, Trans, apply descending from root to leaves,
     // i.e., in reverse order of how they were created.
     // If Left, Trans or Right, NoTrans, apply ascending from leaves to root,
     // i.e., in same order as they were created.
-    // Example for A.mt == 8.
+    // Example for A.mt == 8, arity 2.
     // Leaves:
     //     ttqrt( a0, a1 )
     //     ttqrt( a2, a3 )
@@ -95,12 +221,11 @@ void ttmqr(internal::TargetType<Target::HostTask>,
     //     ttqrt( a4, a6 )
     // Root:
     //     ttqrt( a0, a4 )
+    // The arity must match the one used in ttqrt; @see tt_tree_pairs.
     bool descend = (side == Side::Left) == (op == Op::NoTrans);
-    int step;
+    std::vector< std::pair<int, int> > pairs = tt_tree_pairs( nranks, arity );
     if (descend)
-        step = pow(2, nlevels - 1);
-    else
-        step = 1;
+        std::reverse( pairs.begin(), pairs.end() );
 
     int64_t k_end;
     int64_t i, j, i1, j1, i_dst, j_dst;
@@ -112,18 +237,18 @@ void ttmqr(internal::TargetType<Target::HostTask>,
         k_end = C.mt();
     }
 
+    // For each pair, this rank's tiles of C in the src row, then in the
+    // dst row; a rank has tiles in at most one of them.
     std::vector<MPI_Request> requests;
-    for (int level = 0; level < nlevels; ++level) {
-        for (int index = 0; index < nranks; index += step) {
+    for (auto const& pair : pairs) {
+        for (int role = 0; role < 2; ++role) {
+            int index = (role == 0 ? pair.first : pair.second);
             int64_t rank_ind = rank_indices[ index ].second;
 
             requests.clear();
 
-            if (index % (2*step) == 0) {
-                if (index + step >= nranks) {
-                    break;
-                }
-                int64_t k_dst = rank_indices[ index + step ].second;
+            if (role == 0) {
+                int64_t k_dst = rank_indices[ pair.second ].second;
 
                 size_t message_count = 0;
                 // if (side == left), scan rows of C for local tiles;
@@ -195,7 +320,7 @@ void ttmqr(internal::TargetType<Target::HostTask>,
 
             }
             else {
-                int64_t k_src = rank_indices[ index - step ].second;
+                int64_t k_src = rank_indices[ pair.first ].second;
                 size_t message_count = 0;
                 // if (side == left), scan rows of C for local tiles;
                 // if (side == right), scan cols of C for local tiles
@@ -254,6 +379,32 @@ void ttmqr(internal::TargetType<Target::HostTask>,
                             j1 = k_src;
                         }
 
+                        if (target == Target::Devices) {
+                            // Update on one queue, in order.
+                            MPI_Wait( &requests[ recv_index ], MPI_STATUS_IGNORE );
+
+                            int device = C.tileDevice( i, j );
+                            A.tileGetForReading( rank_ind, 0, device,
+                                                 LayoutConvert( layout ) );
+                            T.tileGetForReading( rank_ind, 0, device,
+                                                 LayoutConvert( layout ) );
+                            C.tileGetForWriting( i, j, device,
+                                                 LayoutConvert( layout ) );
+                            C.tileGetForWriting( i1, j1, device,
+                                                 LayoutConvert( layout ) );
+
+                            // Apply Q.
+                            tpmqrt_device( side, op, A, T, rank_ind,
+                                           C, i1, j1, i, j,
+                                           device, queue_index );
+
+                            int src = C.tileRank( i1, j1 );
+                            // Send updated tile back.
+                            C.tileIsend( i1, j1, src, tag+k, &requests[ recv_index ] );
+                            recv_index++;
+                            continue;
+                        }
+
                         #pragma omp task slate_omp_default_none \
                             shared( A, T, C, requests ) \
                             firstprivate( i, j, k, rank_ind, layout, i1, j1 ) \
@@ -283,15 +434,44 @@ void ttmqr(internal::TargetType<Target::HostTask>,
                 slate_mpi_call(
                     MPI_Waitall( requests.size(), requests.data(), MPI_STATUSES_IGNORE ) );
             }
-            break;
         }
-        if (descend)
-            step /= 2;
-        else
-            step *= 2;
     }
 }
 
+//------------------------------------------------------------------------------
+/// Distributed multiply matrix by Q from QR triangle-triangle factorization of
+/// column of tiles, host implementation.
+/// @ingroup geqrf_internal
+///
+template <typename scalar_t>
+void ttmqr(internal::TargetType<Target::HostTask>,
+           Side side, Op op,
+           Matrix<scalar_t>& A,
+           Matrix<scalar_t>& T,
+           Matrix<scalar_t>& C,
+           int tag, int queue_index, int arity )
+{
+    ttmqr( Target::HostTask, side, op, A, T, C, tag, queue_index, arity );
+}
+
+//------------------------------------------------------------------------------
+/// Distributed multiply matrix by Q from QR triangle-triangle factorization of
+/// column of tiles, device implementation.
+/// Assumes local tiles of C reside on devices, e.g., after the device unmqr,
+/// so they move to the host only to be sent to other ranks.
+/// @ingroup geqrf_internal
+///
+template <typename scalar_t>
+void ttmqr(internal::TargetType<Target::Devices>,
+           Side side, Op op,
+           Matrix<scalar_t>& A,
+           Matrix<scalar_t>& T,
+           Matrix<scalar_t>& C,
+           int tag, int queue_index, int arity )
+{
+    ttmqr( Target::Devices, side, op, A, T, C, tag, queue_index, arity );
+}
+
 //------------------------------------------------------------------------------
 // Explicit instantiations.
 // ----------------------------------------
@@ -301,7 +481,7 @@ void ttmqr<Target::HostTask, float>(
     Matrix<float>&& A,
     Matrix<float>&& T,
     Matrix<float>&& C,
-    int tag );
+    int tag, int queue_index, int arity );
 
 // ----------------------------------------
 template
@@ -310,7 +490,7 @@ void ttmqr<Target::HostTask, double>(
     Matrix<double>&& A,
     Matrix<double>&& T,
     Matrix<double>&& C,
-    int tag );
+    int tag, int queue_index, int arity );
 
 // ----------------------------------------
 template
@@ -319,7 +499,7 @@ void ttmqr< Target::HostTask, std::complex<float> >(
     Matrix< std::complex<float> >&& A,
     Matrix< std::complex<float> >&& T,
     Matrix< std::complex<float> >&& C,
-    int tag );
+    int tag, int queue_index, int arity );
 
 // ----------------------------------------
 template
@@ -328,7 +508,76 @@ void ttmqr< Target::HostTask, std::complex<double> >(
     Matrix< std::complex<double> >&& A,
     Matrix< std::complex<double> >&& T,
     Matrix< std::complex<double> >&& C,
-    int tag );
+    int tag, int queue_index, int arity );
+
+// ----------------------------------------
+template
+void ttmqr<Target::Devices, float>(
+    Side side, Op op,
+    Matrix<float>&& A,
+    Matrix<float>&& T,
+    Matrix<float>&& C,
+    int tag, int queue_index, int arity );
+
+// ----------------------------------------
+template
+void ttmqr<Target::Devices, double>(
+    Side side, Op op,
+    Matrix<double>&& A,
+    Matrix<double>&& T,
+    Matrix<double>&& C,
+    int tag, int queue_index, int arity );
+
+// ----------------------------------------
+template
+void ttmqr< Target::Devices, std::complex<float> >(
+    Side side, Op op,
+    Matrix< std::complex<float> >&& A,
+    Matrix< std::complex<float> >&& T,
+    Matrix< std::complex<float> >&& C,
+    int tag, int queue_index, int arity );
+
+// ----------------------------------------
+template
+void ttmqr< Target::Devices, std::complex<double> >(
+    Side side, Op op,
+    Matrix< std::complex<double> >&& A,
+    Matrix< std::complex<double> >&& T,
+    Matrix< std::complex<double> >&& C,
+    int tag, int queue_index, int arity );
+
+//------------------------------------------------------------------------------
+template
+void tpmqrt_device(
+    Side side, Op op,
+    Matrix<float>& A, Matrix<float>& T, int64_t i,
+    BaseMatrix<float>& C, int64_t i1, int64_t j1, int64_t i2, int64_t j2,
+    int device, int queue_index );
+
+template
+void tpmqrt_device(
+    Side side, Op op,
+    Matrix<double>& A, Matrix<double>& T, int64_t i,
+    BaseMatrix<double>& C, int64_t i1, int64_t j1, int64_t i2, int64_t j2,
+    int device, int queue_index );
+
+template
+void tpmqrt_device(
+    Side side, Op op,
+    Matrix< std::complex<float> >& A, Matrix< std::complex<float> >& T,
+    int64_t i,
+    BaseMatrix< std::complex<float> >& C,
+    int64_t i1, int64_t j1, int64_t i2, int64_t j2,
+    int device, int queue_index );
+
+template
+void tpmqrt_device(
+    Side side, Op op,
+    Matrix< std::complex<double> >& A, Matrix< std::complex<double> >& T,
+    int64_t i,
+    BaseMatrix< std::complex<double> >& C,
+    int64_t i1, int64_t j1, int64_t i2, int64_t j2,
+    int device, int queue_index );
 
 } // namespace internal
 } // namespace slate
@@ -8,6 +8,10 @@
 #include "internal/Tile_tpqrt.hh"
 #include "internal/internal.hh"
 #include "internal/internal_util.hh"
+#include "slate/internal/device.hh"
+#include "lapack.hh"
+#include "lapack/device.hh"
+#include "blas/device.hh"
 
 namespace slate {
 namespace internal {
@@ -15,26 +19,158 @@ namespace internal {
 //------------------------------------------------------------------------------
 /// Distributed QR triangle-triangle factorization of column of tiles.
 /// Each rank has one triangular tile, the result of local geqrf panel.
+/// The triangles are reduced by a tree of the given arity, >= 2;
+/// @see tt_tree_pairs.
 /// Dispatches to target implementations.
 /// @ingroup geqrf_internal
 ///
 template <Target target, typename scalar_t>
 void ttqrt(Matrix<scalar_t>&& A,
-           Matrix<scalar_t>&& T )
+           Matrix<scalar_t>&& T,
+           int arity )
 {
     ttqrt(internal::TargetType<target>(),
-          A, T );
+          A, T, arity );
 }
 
 //------------------------------------------------------------------------------
-/// Distributed QR triangle-triangle factorization, host implementation.
-/// Assumes panel tiles reside on host.
+/// Triangle-triangle QR factorization of tiles A(i1, 0) and A(i2, 0) on a
+/// device; the device equivalent of tile::tpqrt with l = m.
+/// The upper triangles R1 and R2 are stacked, with zeros below, into a
+/// workspace factored by geqrf. The zeros stay exactly zero, so the
+/// Householder vectors below R1 are the upper trapezoid V2 that tpqrt
+/// stores in A(i2, 0). Only the upper triangles are copied back, preserving
+/// the local panel's vectors below them. As in tpqrt, T(i2, 0) holds
+/// the ib-by-ib triangular factors of each block of ib columns.
+/// Uses compute queue 0, the panel queue.
 /// @ingroup geqrf_internal
 ///
 template <typename scalar_t>
-void ttqrt(internal::TargetType<Target::HostTask>,
+void tpqrt_device(
+    Matrix<scalar_t>& A, int64_t i1, int64_t i2,
+    Matrix<scalar_t>& T, int device )
+{
+    using blas::device_memcpy_2d;
+    using lapack::device_info_int;
+
+    const scalar_t zero = 0.0;
+    const scalar_t one  = 1.0;
+
+    lapack::Queue* queue = A.compute_queue( device, 0 );
+
+    auto A1 = A( i1, 0, device );
+    auto A2 = A( i2, 0, device );
+    auto T2 = T( i2, 0, device );
+
+    // Upper triangle of A1 is k-by-k, upper trapezoid of A2 is m-by-k.
+    int64_t k   = A2.nb();
+    int64_t m   = std::min( A2.mb(), k );
+    int64_t ib  = std::min( T2.mb(), k );
+    int64_t lds = k + m;
+
+    // Stacked [ R1; R2 ], the T factor, and tau.
+    scalar_t* S    = A.allocWorkspaceBuffer( device, lds*k + k*k + k );
+    scalar_t* dT   = &S[ lds*k ];
+    scalar_t* dtau = &dT[ k*k ];
+
+    size_t dsize, hsize;
+    lapack::geqrf_work_size_bytes( lds, k, S, lds, &dsize, &hsize, *queue );
+
+    // geqrf workspace, then pointer arrays for tzcopy, then info.
+    size_t dwork_bytes = roundup( dsize, sizeof(scalar_t*) );
+    size_t work_bytes  = dwork_bytes + 4*sizeof(scalar_t*)
+                       + sizeof(device_info_int);
+    scalar_t* work = A.allocWorkspaceBuffer(
+                         device, ceildiv( work_bytes, sizeof(scalar_t) ) );
+    char* dwork = (char*) work;
+    scalar_t** dptrs = (scalar_t**) &dwork[ dwork_bytes ];
+    device_info_int* dinfo
+        = (device_info_int*) &dwork[ dwork_bytes + 4*sizeof(scalar_t*) ];
+    std::vector<char> hwork( hsize );
+
+    // S = [ upper( R1 ); upper( R2 ) ].
+    device_memcpy_2d<scalar_t>( &S[ 0 ], lds, A1.data(), A1.stride(),
+                                k, k, *queue );
+    device_memcpy_2d<scalar_t>( &S[ k ], lds, A2.data(), A2.stride(),
+                                m, k, *queue );
+    if (k > 1) {
+        device::tzset( Uplo::Lower, k-1, k, zero, zero,
+                       &S[ 1 ], lds, *queue );
+    }
+    if (m > 1) {
+        device::tzset( Uplo::Lower, m-1, k, zero, zero,
+                       &S[ k+1 ], lds, *queue );
+    }
+
+    lapack::geqrf( lds, k, S, lds, dtau,
+                   dwork, dsize, hwork.data(), hsize, dinfo, *queue );
+
+    // Copy R back to A1 and V2 back to A2, upper triangles only.
+    scalar_t* hptrs[ 4 ] = { &S[ 0 ], A1.data(), &S[ k ], A2.data() };
+    blas::device_memcpy<scalar_t*>( dptrs, hptrs, 4, *queue );
+    device::tzcopy( Uplo::Upper, k, k, &dptrs[ 0 ], lds,
+                    &dptrs[ 1 ], A1.stride(), 1, *queue );
+    device::tzcopy( Uplo::Upper, m, k, &dptrs[ 2 ], lds,
+                    &dptrs[ 3 ], A2.stride(), 1, *queue );
+
+    // Copy tau to host for trmm, as in the device geqrf panel.
+    std::vector<scalar_t> htau( k );
+    blas::device_memcpy<scalar_t>( htau.data(), dtau, k, *queue );
+
+    // The identity part of V is orthogonal to itself,
+    // so V^H V = I + V2^H V2; the trmm below uses only its strictly upper
+    // part, where the identity is zero.
+    blas::gemm( Layout::ColMajor,
+                Op::ConjTrans, Op::NoTrans,
+                k, k, m,
+                one,  &S[ k ], lds,
+                      &S[ k ], lds,
+                zero, dT, k, *queue );
+    blas::copy( k, dtau, 1, dT, k+1, *queue );
+    if (k > 1) {
+        device::tzset( Uplo::Lower, k-1, k, zero, zero,
+                       &dT[ 1 ], k, *queue );
+    }
+
+    // Triangular factor of each block of ib columns.
+    for (int64_t j0 = 0; j0 < k; j0 += ib) {
+        int64_t jb = std::min( k-j0, ib );
+        for (int64_t j = j0+1; j < j0+jb; ++j) {
+            blas::trmm( Layout::ColMajor,
+                        Side::Left, Uplo::Upper,
+                        Op::NoTrans, Diag::NonUnit,
+                        j-j0, 1,
+                        -htau[ j ], &dT[ j0 + j0*k ], k,
+                                    &dT[ j0 + j*k  ], k, *queue );
+        }
+    }
+
+    // T2 = [ T_0, T_1, ... ], each ib-by-ib upper triangular.
+    device::geset( T2.mb(), T2.nb(), zero, zero,
+                   T2.data(), T2.stride(), *queue );
+    for (int64_t j0 = 0; j0 < k; j0 += ib) {
+        int64_t jb = std::min( k-j0, ib );
+        device_memcpy_2d<scalar_t>( &T2.data()[ j0*T2.stride() ], T2.stride(),
+                                    &dT[ j0 + j0*k ], k,
+                                    jb, jb, *queue );
+    }
+
+    queue->sync();
+
+    A.freeWorkspaceBuffer( device, work );
+    A.freeWorkspaceBuffer( device, S );
+}
+
+//------------------------------------------------------------------------------
+/// Distributed QR triangle-triangle factorization, with tile pairs factored
+/// on the host or, for target = Devices, on the device of the local tile.
+/// @ingroup geqrf_internal
+///
+template <typename scalar_t>
+void ttqrt(Target target,
            Matrix<scalar_t>& A,
-           Matrix<scalar_t>& T )
+           Matrix<scalar_t>& T,
+           int arity )
 {
     // Assumes column major
     const Layout layout = Layout::ColMajor;
@@ -71,9 +207,8 @@ void ttqrt(internal::TargetType<Target::HostTask>,
         // This rank has a tile in this column, at row i.
         int64_t i = rank_rows[index].second;
         int nranks = rank_rows.size();
-        int nlevels = int( ceil( log2( nranks ) ) );
 
-        // Example: 2D cyclic, p = 7, q = 1, column k = 9
+        // Example: 2D cyclic, p = 7, q = 1, column k = 9, arity 2
         //                                           Levels
         //               { rank, row }        index  L=0  L=1  L=2
         // rank_rows = [ {    2,   9 },    // 0      src  src  src
@@ -87,6 +222,8 @@ void ttqrt(internal::TargetType<Target::HostTask>,
         //                                 //              |
         //               {    1,  15 } ];  // 6       x   dst
         // src-dst pairs indicate tiles that are factored together.
+        // With a larger arity, each src is paired in turn with up to
+        // arity-1 dst per level, so there are fewer levels.
         //
         // Two triangular tiles are factored with tpqrt on dst rank,
         // with the resulting triangular tile sent back to src rank.
@@ -94,66 +231,137 @@ void ttqrt(internal::TargetType<Target::HostTask>,
         // (here, rank_row {2, 9}), which is always src, never dst.
         // For each pair, the Householder vectors V overwrite the bottom tile,
         // A(i, 0) on dst. The T matrix is also stored on dst.
-        int step = 1;
-        for (int level = 0; level < nlevels; ++level) {
-            if (index % (2*step) == 0) {
-                if (index + step < nranks) {
-                    // Send tile to dst, then receive updated tile back.
-                    int dst = rank_rows[ index + step ].first;
-                    A.tileSend(i, 0, dst);
-                    A.tileRecv(i, 0, dst, layout);
-                }
+        for (auto const& pair : tt_tree_pairs( nranks, arity )) {
+            if (pair.first == index) {
+                // Send tile to dst, then receive updated tile back.
+                int dst = rank_rows[ pair.second ].first;
+                A.tileSend(i, 0, dst);
+                A.tileRecv(i, 0, dst, layout);
             }
-            else {
+            else if (pair.second == index) {
                 // Receive tile from src.
-                int     src   = rank_rows[ index - step ].first;
-                int64_t i_src = rank_rows[ index - step ].second;
+                int     src   = rank_rows[ pair.first ].first;
+                int64_t i_src = rank_rows[ pair.first ].second;
                 A.tileRecv(i_src, 0, src, layout);
 
-                A.tileGetForWriting(i, 0, LayoutConvert(layout));
+                if (target == Target::Devices) {
+                    int device = A.tileDevice(i, 0);
+                    A.tileGetForWriting(i, 0, device, LayoutConvert(layout));
+                    A.tileGetForWriting(i_src, 0, device,
+                                        LayoutConvert(layout));
+
+                    // Factor tiles, which eliminates local tile A(i, 0).
+                    T.tileInsert(i, 0, device);
+                    tpqrt_device( A, i_src, i, T, device );
+                    T.tileModified(i, 0, device);
+                }
+                else {
+                    A.tileGetForWriting(i, 0, LayoutConvert(layout));
 
-                // Factor tiles, which eliminates local tile A(i, 0).
-                T.tileInsert(i, 0);
-                T(i, 0).set(0);
-                int64_t l = std::min(A.tileMb(i), A.tileNb(0));
-                tile::tpqrt( l, A( i_src, 0 ), A( i, 0 ), T( i, 0 ) );
+                    // Factor tiles, which eliminates local tile A(i, 0).
+                    T.tileInsert(i, 0);
+                    T(i, 0).set(0);
+                    int64_t l = std::min(A.tileMb(i), A.tileNb(0));
+                    tile::tpqrt( l, A( i_src, 0 ), A( i, 0 ), T( i, 0 ) );
 
-                T.tileModified(i, 0);
+                    T.tileModified(i, 0);
+                }
 
                 // Send updated tile back. This rank is done!
                 A.tileSend(i_src, 0, src);
                 break;
             }
-            step *= 2;
         }
     }
 }
 
+//------------------------------------------------------------------------------
+/// Distributed QR triangle-triangle factorization, host implementation.
+/// Assumes panel tiles reside on host.
+/// @ingroup geqrf_internal
+///
+template <typename scalar_t>
+void ttqrt(internal::TargetType<Target::HostTask>,
+           Matrix<scalar_t>& A,
+           Matrix<scalar_t>& T,
+           int arity )
+{
+    ttqrt( Target::HostTask, A, T, arity );
+}
+
+//------------------------------------------------------------------------------
+/// Distributed QR triangle-triangle factorization, device implementation.
+/// Assumes local panel tiles reside on one device per rank, as left by the
+/// device geqrf panel; each pair is factored on that device, so tiles
+/// move to the host only to be sent to other ranks.
+/// @ingroup geqrf_internal
+///
+template <typename scalar_t>
+void ttqrt(internal::TargetType<Target::Devices>,
+           Matrix<scalar_t>& A,
+           Matrix<scalar_t>& T,
+           int arity )
+{
+    ttqrt( Target::Devices, A, T, arity );
+}
+
 //------------------------------------------------------------------------------
 // Explicit instantiations.
 // ----------------------------------------
 template
 void ttqrt<Target::HostTask, float>(
     Matrix<float>&& A,
-    Matrix<float>&& T );
+    Matrix<float>&& T,
+    int arity );
 
 // ----------------------------------------
 template
 void ttqrt<Target::HostTask, double>(
     Matrix<double>&& A,
-    Matrix<double>&& T );
+    Matrix<double>&& T,
+    int arity );
 
 // ----------------------------------------
 template
 void ttqrt< Target::HostTask, std::complex<float> >(
     Matrix< std::complex<float> >&& A,
-    Matrix< std::complex<float> >&& T );
+    Matrix< std::complex<float> >&& T,
+    int arity );
 
 // ----------------------------------------
 template
 void ttqrt< Target::HostTask, std::complex<double> >(
     Matrix< std::complex<double> >&& A,
-    Matrix< std::complex<double> >&& T );
+    Matrix< std::complex<double> >&& T,
+    int arity );
+
+// ----------------------------------------
+template
+void ttqrt<Target::Devices, float>(
+    Matrix<float>&& A,
+    Matrix<float>&& T,
+    int arity );
+
+// ----------------------------------------
+template
+void ttqrt<Target::Devices, double>(
+    Matrix<double>&& A,
+    Matrix<double>&& T,
+    int arity );
+
+// ----------------------------------------
+template
+void ttqrt< Target::Devices, std::complex<float> >(
+    Matrix< std::complex<float> >&& A,
+    Matrix< std::complex<float> >&& T,
+    int arity );
+
+// ----------------------------------------
+template
+void ttqrt< Target::Devices, std::complex<double> >(
+    Matrix< std::complex<double> >&& A,
+    Matrix< std::complex<double> >&& T,
+    int arity );
 
 } // namespace internal
 } // namespace slate
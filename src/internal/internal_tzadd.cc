@@ -185,8 +185,7 @@ void add(internal::TargetType<Target::Devices>,
 
             blas::Queue* queue = A.compute_queue(device, queue_index);
 
-            blas::device_memcpy<scalar_t*>(
-                a_array_dev, a_array_host, batch_size*2, *queue );
+            B.batchArrayUpload( device, queue_index, a_array_host, batch_size*2, *queue );
 
             for (size_t g = 0; g < group_params.size(); ++g) {
                 int64_t group_count = group_params[ g ].count;
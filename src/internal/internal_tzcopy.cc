@@ -174,11 +174,9 @@ void copy(internal::TargetType<Target::Devices>,
 
             blas::Queue* queue = A.compute_queue(device, queue_index);
 
-            blas::device_memcpy<src_scalar_t*>(
-                a_array_dev, a_array_host, batch_count, *queue );
+            A.batchArrayUpload( device, queue_index, a_array_host, batch_count, *queue );
 
-            blas::device_memcpy<dst_scalar_t*>(
-                b_array_dev, b_array_host, batch_count, *queue );
+            B.batchArrayUpload( device, queue_index, b_array_host, batch_count, *queue );
 
             for (size_t g = 0; g < group_params.size(); ++g) {
                 int64_t group_count = group_params[ g ].count;
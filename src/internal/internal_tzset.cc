@@ -151,37 +151,40 @@ void set(
             }
             A.tileGetForWriting( A_tiles_set, device, layout );
 
-            int64_t batch_size = A_tiles_set.size();
-            scalar_t** a_array_host = A.array_host( device );
-            scalar_t** a_array_dev  = A.array_device( device );
-
-            auto group_params = device_regions_build<true, 1, scalar_t>(
-                    {A}, {a_array_host}, device );
-
-            blas::Queue* queue = A.compute_queue(device, queue_index);
+            // Set up a variable-size batch of m, n, lda, uplo, and whether
+            // each tile has the diagonal, so one launch sets all tiles,
+            // whatever their sizes. Off-diagonal tiles are set in full.
+            int64_t batch_count = A_tiles_set.size();
+            scalar_t** a_array_host = A.array_host( device, queue_index );
+            int64_t* dims_host = A.dims_host( device, queue_index );
+            int64_t b = 0;
+            for (auto ij : A_tiles_set) {
+                int64_t i = std::get<0>( ij );
+                int64_t j = std::get<1>( ij );
+                auto T = A( i, j, device );
+                a_array_host[ b ] = T.data();
+                dims_host[ b                 ] = T.mb();
+                dims_host[ b +   batch_count ] = T.nb();
+                dims_host[ b + 2*batch_count ] = T.stride();
+                dims_host[ b + 3*batch_count ]
+                    = int64_t( i == j ? A.uplo() : Uplo::General );
+                dims_host[ b + 4*batch_count ] = (i == j);
+                ++b;
+            }
 
-            blas::device_memcpy<scalar_t*>(
-                a_array_dev, a_array_host, batch_size, *queue );
+            blas::Queue* queue = A.compute_queue( device, queue_index );
+            scalar_t** a_array_dev = A.array_device( device, queue_index );
+            int64_t* dims_dev = A.dims_device( device, queue_index );
 
-            for (size_t g = 0; g < group_params.size(); ++g) {
-                int64_t group_count = group_params[ g ].count;
+            if (batch_count > 0) {
+                blas::device_memcpy<int64_t>(
+                    dims_dev, dims_host, 5*batch_count, *queue );
+                A.batchArrayUpload( device, queue_index, a_array_host,
+                                    batch_count, *queue );
 
-                if (group_params[ g ].is_diagonal) {
-                    device::batch::tzset(
-                        A.uplo(),
-                        group_params[ g ].mb, group_params[ g ].nb,
-                        offdiag_value, diag_value,
-                        a_array_dev, group_params[ g ].ld[0],
-                        group_count, *queue);
-                }
-                else {
-                    device::batch::geset(
-                        group_params[ g ].mb, group_params[ g ].nb,
-                        offdiag_value, offdiag_value,
-                        a_array_dev, group_params[ g ].ld[0],
-                        group_count, *queue );
-                }
-                a_array_dev += group_count;
+                device::batch::tzset_vbatch(
+                    dims_dev, offdiag_value, diag_value,
+                    a_array_dev, batch_count, *queue );
             }
             queue->sync();
         }
@@ -154,6 +154,21 @@ void unmtr_hb2st( internal::TargetType<target>,
                         Vr_data[ii + ii*ldv] = 1;
                     }
 
+                    // Devices with local tiles in row i of C, the only
+                    // ones that need V and VT.
+                    std::vector<int> row_devices;
+                    if (target == Target::Devices) {
+                        std::vector<bool> has_tiles( C.num_devices(), false );
+                        for (int64_t k = 0; k < nt; ++k) {
+                            if (C.tileIsLocal(i, k))
+                                has_tiles[ C.tileDevice(i, k) ] = true;
+                        }
+                        for (int d = 0; d < C.num_devices(); ++d) {
+                            if (has_tiles[ d ])
+                                row_devices.push_back( d );
+                        }
+                    }
+
                     // larft and prefetch of V and C in parallel
                     #pragma omp taskgroup
                     {
@@ -230,9 +245,8 @@ void unmtr_hb2st( internal::TargetType<target>,
                             if (target == Target::Devices) {
                                 #pragma omp taskgroup
                                 {
-                                    for (int d = 0; d < C.num_devices(); ++d)
-                                    {
-                                        // prefetch VT on all devices for C -= VT VC operation
+                                    for (int d : row_devices) {
+                                        // prefetch VT on devices for C -= VT VC operation
                                         #pragma omp task slate_omp_default_none \
                                             firstprivate( d, i ) shared( VT )
                                         {
@@ -243,8 +257,8 @@ void unmtr_hb2st( internal::TargetType<target>,
                             }
                         }
                         if (target == Target::Devices) {
-                            // prefetch V on all devices for VC += V^H C
-                            for (int d = 0; d < C.num_devices(); ++d) {
+                            // prefetch V on devices for VC += V^H C
+                            for (int d : row_devices) {
                                 #pragma omp task slate_omp_default_none \
                                     firstprivate( d, r ) shared( V_ )
                                 {
@@ -279,37 +293,88 @@ void unmtr_hb2st( internal::TargetType<target>,
                     // Vr and VT are (mb0 + mb1)-by-vnb = vm_-by-vnb,
                     // C0 is mb0-by-cnb,
                     // C1 is mb1-by-cnb.
-                    for (int64_t k = 0; k < nt; ++k) { // todo This for-loop must be parallelized.
-                        if (C.tileIsLocal(i, k)) {
-                            auto C0 = C(i, k);
+                    if (target == Target::Devices) {
+                        // All updates of this task go in order on one queue
+                        // per device, so VC(i/2, device) is reused for each
+                        // k without syncing; sync once after all tiles.
+                        int thread = omp_get_thread_num();
+                        for (int64_t k = 0; k < nt; ++k) {
+                            if (! C.tileIsLocal(i, k))
+                                continue;
+
+                            int device = C.tileDevice(i, k);
+                            blas::Queue* queue = C.compute_queue(device, thread);
+                            auto Vd  = V_(0, r, device);
+                            auto VTd = VT(i/2, 0, device);
+                            auto VCd = VC(i/2, device, device);
+                            auto C0  = C(i, k, device);
                             int64_t cnb = C0.nb();
-                            if (target != Target::Devices) {
-                                assert( cnb <= VC(i/2, 0).nb() );
-                            }
                             assert( C0.mb()-1 == mb0 );  // After 1st row sliced off.
-                            int device = C.tileDevice(i, k);
 
                             // VC = Vr0^H C0
                             // vnb-by-cnb = (mb0-by-vnb)^H (mb0-by-cnb)
                             // Slice off 1st row of C0.
-                            // C0
-                            if (target == Target::Devices) {
-                                blas::Queue* queue = C.compute_queue(device, omp_get_thread_num());
+                            blas::gemm(Layout::ColMajor,
+                                       Op::ConjTrans, Op::NoTrans,
+                                       vnb, cnb, mb0,
+                                       one,  Vd.data(), Vd.stride(),
+                                             &C0.data()[ 1 ], C0.stride(),
+                                       zero, VCd.data(), VCd.stride(),
+                                       *queue);
+
+                            // VC += Vr1^H C1
+                            // vnb-by-cnb += (mb1-by-vnb)^H (mb1-by-cnb)
+                            if (i+1 < mt) {
+                                // ensures 1D column block distribution for C
+                                assert(C.tileIsLocal(i+1, k));
+                                auto C1 = C(i+1, k, device);
                                 blas::gemm(Layout::ColMajor,
                                            Op::ConjTrans, Op::NoTrans,
-                                           vnb, cnb, mb0,
-                                           one,
-                                           V_(0, r, device).data(),
-                                           V_(0, r, device).stride(),
-                                           &C(i, k, device).data()[ 1 ],
-                                           C(i, k, device).stride(),
-                                           zero,
-                                           VC(i/2, device, device).data(),
-                                           VC(i/2, device, device).stride(),
+                                           vnb, cnb, mb1,
+                                           one, &Vd.data()[ mb0 ], Vd.stride(),
+                                                C1.data(), C1.stride(),
+                                           one, VCd.data(), VCd.stride(),
                                            *queue);
-                                queue->sync();
                             }
-                            else {
+
+                            // C0 -= (V0 T) VC
+                            // mb0-by-cnb -= (mb0-by-vnb) (vnb-by-cnb)
+                            // Slice off 1st row of C0.
+                            blas::gemm(Layout::ColMajor,
+                                       Op::NoTrans, Op::NoTrans,
+                                       mb0, cnb, vnb,
+                                       -one, VTd.data(), VTd.stride(),
+                                             VCd.data(), VCd.stride(),
+                                       one,  &C0.data()[ 1 ], C0.stride(),
+                                       *queue);
+
+                            // C1 -= (V1 T) VC
+                            // mb1-by-cnb -= (mb1-by-vnb) (vnb-by-cnb)
+                            if (i+1 < mt) {
+                                auto C1 = C(i+1, k, device);
+                                blas::gemm(Layout::ColMajor,
+                                           Op::NoTrans, Op::NoTrans,
+                                           mb1, cnb, vnb,
+                                           -one, &VTd.data()[ mb0 ], VTd.stride(),
+                                                 VCd.data(), VCd.stride(),
+                                           one,  C1.data(), C1.stride(),
+                                           *queue);
+                            }
+                        }
+                        for (int device : row_devices)
+                            C.compute_queue(device, thread)->sync();
+                    }
+                    else {
+                        for (int64_t k = 0; k < nt; ++k) { // todo This for-loop must be parallelized.
+                            if (C.tileIsLocal(i, k)) {
+                                auto C0 = C(i, k);
+                                int64_t cnb = C0.nb();
+                                assert( cnb <= VC(i/2, 0).nb() );
+                                assert( C0.mb()-1 == mb0 );  // After 1st row sliced off.
+
+                                // VC = Vr0^H C0
+                                // vnb-by-cnb = (mb0-by-vnb)^H (mb0-by-cnb)
+                                // Slice off 1st row of C0.
                                 blas::gemm(Layout::ColMajor,
                                            Op::ConjTrans, Op::NoTrans,
                                            vnb, cnb, mb0,
@@ -321,32 +386,12 @@ void unmtr_hb2st( internal::TargetType<target>,
                                            zero,
                                            VC(i/2, 0).data(),
                                            VC(i/2, 0).stride());
-                            }
 
-                            // VC += Vr1^H C1
-                            // vnb-by-cnb += (mb1-by-vnb)^H (mb1-by-cnb)
-                            Tile<scalar_t> C1;
-                            if (i+1 < mt) {
-                                // ensures 1D column block distribution for C
-                                assert(C.tileIsLocal(i+1, k));
-                                C1 = C(i+1, k);
-                                if (target == Target::Devices) {
-                                    blas::Queue* queue = C.compute_queue(device, omp_get_thread_num());
-                                    blas::gemm(Layout::ColMajor,
-                                               Op::ConjTrans, Op::NoTrans,
-                                               vnb, cnb, mb1,
-                                               one,
-                                               &(V_(0, r, device).data()[ mb0 ]),
-                                               V_(0, r, device).stride(),
-                                               C(i+1, k, device).data(),
-                                               C(i+1, k, device).stride(),
-                                               one,
-                                               VC(i/2, device, device).data(),
-                                               VC(i/2, device, device).stride(),
-                                               *queue);
-                                    queue->sync();
-                                }
-                                else {
+                                // VC += Vr1^H C1
+                                // vnb-by-cnb += (mb1-by-vnb)^H (mb1-by-cnb)
+                                if (i+1 < mt) {
+                                    // ensures 1D column block distribution for C
+                                    assert(C.tileIsLocal(i+1, k));
                                     blas::gemm(Layout::ColMajor,
                                                Op::ConjTrans, Op::NoTrans,
                                                vnb, cnb, mb1,
@@ -359,31 +404,13 @@ void unmtr_hb2st( internal::TargetType<target>,
                                                VC(i/2, 0).data(),
                                                VC(i/2, 0).stride());
                                 }
-                            }
-                            #pragma omp taskgroup
-                            {
-                                // C0 -= (V0 T) VC
-                                // mb0-by-cnb -= (mb0-by-vnb) (vnb-by-cnb)
-                                // Slice off 1st row of C0.
-                                #pragma omp task
+                                #pragma omp taskgroup
                                 {
-                                    if (target == Target::Devices) {
-                                        blas::Queue* queue = C.compute_queue(device, omp_get_thread_num());
-                                        blas::gemm(Layout::ColMajor,
-                                                   Op::NoTrans, Op::NoTrans,
-                                                   mb0, cnb, vnb,
-                                                   -one,
-                                                   VT(i/2, 0, device).data(),
-                                                   VT(i/2, 0, device).stride(),
-                                                   VC(i/2, device, device).data(),
-                                                   VC(i/2, device, device).stride(),
-                                                   one,
-                                                   &C(i, k, device).data()[ 1 ],
-                                                   C(i, k, device).stride(),
-                                                   *queue);
-                                        queue->sync();
-                                    }
-                                    else {
+                                    // C0 -= (V0 T) VC
+                                    // mb0-by-cnb -= (mb0-by-vnb) (vnb-by-cnb)
+                                    // Slice off 1st row of C0.
+                                    #pragma omp task
+                                    {
                                         blas::gemm(Layout::ColMajor,
                                                    Op::NoTrans, Op::NoTrans,
                                                    mb0, cnb, vnb,
@@ -396,31 +423,11 @@ void unmtr_hb2st( internal::TargetType<target>,
                                                    &C(i, k).data()[ 1 ],
                                                    C(i, k).stride());
                                     }
-                                }
 
-                                // C1 -= (V1 T) VC
-                                // mb1-by-cnb -= (mb1-by-vnb) (vnb-by-cnb)
-                                if (i+1 < mt) {
-                                    #pragma omp task
-                                    {
-                                        if (target == Target::Devices)
-                                        {
-                                            blas::Queue* queue = C.compute_queue(device, omp_get_thread_num());
-                                            blas::gemm(Layout::ColMajor,
-                                                       Op::NoTrans, Op::NoTrans,
-                                                       mb1, cnb, vnb,
-                                                       -one,
-                                                       &VT(i/2, 0, device).data()[ mb0 ],
-                                                       VT(i/2, 0, device).stride(),
-                                                       VC(i/2, device, device).data(),
-                                                       VC(i/2, device, device).stride(),
-                                                       one,
-                                                       C(i+1, k, device).data(),
-                                                       C(i+1, k, device).stride(),
-                                                       *queue);
-                                            queue->sync();
-                                        }
-                                        else
+                                    // C1 -= (V1 T) VC
+                                    // mb1-by-cnb -= (mb1-by-vnb) (vnb-by-cnb)
+                                    if (i+1 < mt) {
+                                        #pragma omp task
                                         {
                                             blas::gemm(Layout::ColMajor,
                                                        Op::NoTrans, Op::NoTrans,
@@ -436,9 +443,9 @@ void unmtr_hb2st( internal::TargetType<target>,
                                         }
                                     }
                                 }
-                            }
-                        } // if C(i, k) is local
-                    } // inner for loop
+                            } // if C(i, k) is local
+                        } // inner for loop
+                    }
 
                     // Restore diag(Vr) = tau.
                     if (V_.tileIsLocal(0, r)) {
@@ -6,6 +6,15 @@
 #include "slate/internal/util.hh"
 #include "internal/internal_util.hh"
 
+#include <climits>
+#include <thread>
+
+#if defined( __linux__ )
+    #include <linux/futex.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+#endif
+
 namespace slate {
 namespace internal {
 
@@ -49,4 +58,47 @@ void mpi_max_nan(void* invec, void* inoutvec, int* len, MPI_Datatype* datatype)
 }
 
 } // namespace internal
+
+//------------------------------------------------------------------------------
+/// Slow path of ThreadBarrier::wait, after spinning: yields, then sleeps
+/// until the barrier passes generation passed_old.
+///
+void ThreadBarrier::block( int passed_old )
+{
+    for (int i = 0; i < yield_count; ++i) {
+        if (passed_.load( std::memory_order_acquire ) != passed_old)
+            return;
+        std::this_thread::yield();
+    }
+
+    #if defined( __linux__ )
+        static_assert( sizeof( std::atomic<int> ) == sizeof( int ),
+                       "futex requires std::atomic<int> to be an int" );
+        // Registering as a sleeper before re-checking passed_ (both
+        // sequentially consistent) pairs with wait(), which increments
+        // passed_ before checking sleepers_, so a wake isn't lost.
+        // FUTEX_WAIT returns at once if passed_ has already changed.
+        sleepers_.fetch_add( 1 );
+        while (passed_.load() == passed_old) {
+            syscall( SYS_futex, reinterpret_cast<int*>( &passed_ ),
+                     FUTEX_WAIT_PRIVATE, passed_old, nullptr, nullptr, 0 );
+        }
+        sleepers_.fetch_sub( 1 );
+    #else
+        while (passed_.load( std::memory_order_acquire ) == passed_old)
+            std::this_thread::yield();
+    #endif
+}
+
+//------------------------------------------------------------------------------
+/// Wakes threads sleeping in ThreadBarrier::block.
+///
+void ThreadBarrier::wake()
+{
+    #if defined( __linux__ )
+        syscall( SYS_futex, reinterpret_cast<int*>( &passed_ ),
+                 FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0 );
+    #endif
+}
+
 } // namespace slate
@@ -10,10 +10,15 @@
 #define SLATE_INTERNAL_UTIL_HH
 
 #include "slate/internal/mpi.hh"
+#include "slate/Counters.hh"
 #include "slate/Matrix.hh"
+#include "slate/Tile_blas.hh"
 
 #include <cmath>
 #include <complex>
+#include <functional>
+#include <limits>
+#include <vector>
 
 #include <blas.hh>
 
@@ -37,6 +42,96 @@ inline bool compareSecond(
     return a.second < b.second;
 }
 
+//------------------------------------------------------------------------------
+/// Pairs { src, dst } of indices into the nranks ranks of a column, sorted
+/// by row, in the order that the triangle-triangle reduction tree of the
+/// given arity factors them (see ttqrt, ttmqr).
+/// At level L, with step = arity^L, each src that is a multiple of
+/// arity*step is paired in turn with src + step, ..., src + (arity-1)*step.
+/// src keeps the triangle; dst keeps the Householder vectors and T.
+/// Arity 2 is a binary tree; arity >= nranks is a flat tree.
+///
+inline std::vector< std::pair<int, int> > tt_tree_pairs(
+    int nranks, int arity )
+{
+    assert( arity >= 2 );
+    std::vector< std::pair<int, int> > pairs;
+    for (int64_t step = 1; step < nranks; step *= arity) {
+        for (int64_t src = 0; src < nranks; src += arity*step) {
+            for (int64_t a = 1; a < arity && src + a*step < nranks; ++a)
+                pairs.push_back( { int( src ), int( src + a*step ) } );
+        }
+    }
+    return pairs;
+}
+
+//------------------------------------------------------------------------------
+/// Packs each pivot into one int64_t, with the tile index in the high
+/// 32 bits and the element offset in the low 32 bits, halving the bytes
+/// of a pivot broadcast. Requires tile indices < 2^31 and offsets < 2^32.
+/// @see unpack_pivots
+inline void pack_pivots(
+    std::vector<Pivot> const& pivots, std::vector<int64_t>& packed )
+{
+    packed.resize( pivots.size() );
+    for (size_t i = 0; i < pivots.size(); ++i) {
+        assert( pivots[ i ].elementOffset() < (int64_t( 1 ) << 32) );
+        packed[ i ] = (pivots[ i ].tileIndex() << 32)
+                    | pivots[ i ].elementOffset();
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Unpacks pivots packed by pack_pivots.
+inline void unpack_pivots(
+    std::vector<int64_t> const& packed, std::vector<Pivot>& pivots )
+{
+    const int64_t mask = (int64_t( 1 ) << 32) - 1;
+    pivots.resize( packed.size() );
+    for (size_t i = 0; i < packed.size(); ++i)
+        pivots[ i ] = Pivot( packed[ i ] >> 32, packed[ i ] & mask );
+}
+
+//------------------------------------------------------------------------------
+/// Returns a non-owning view of A, of the same type, for drivers that
+/// create many sub-matrices per step. The view and all sub-matrices of it
+/// are copied without atomic updates of the storage's reference count.
+/// A must outlive the view and every matrix derived from it, which holds
+/// within a driver, as its tasks complete before it returns.
+/// @see BaseMatrix::dropStorageOwnership
+///
+template <typename matrix_type>
+matrix_type nonowning_view( matrix_type& A )
+{
+    matrix_type view = A;
+    view.dropStorageOwnership();
+    return view;
+}
+
+//------------------------------------------------------------------------------
+/// Returns the layout for a driver to compute in: Layout::RowMajor if all
+/// the matrices are row-major, e.g., from fromScaLAPACKDevice with
+/// Layout::RowMajor, and target computes in either layout; otherwise
+/// Layout::ColMajor. In RowMajor, the tile BLAS and potrf work on row-major
+/// tiles directly, flipping op and uplo, so the tiles are not transposed
+/// by layoutConvert on first use and back at the end. These avoided
+/// conversions, one per local tile, are counted in
+/// Count::LayoutConversionsAvoided.
+///
+template <typename... matrix_types>
+Layout native_layout( Target target, matrix_types&... A )
+{
+    bool row_major = (target == Target::HostTask || target == Target::HostNest
+                      || target == Target::Devices)
+                     && ((A.layout() == Layout::RowMajor) && ...);
+    if (! row_major)
+        return Layout::ColMajor;
+
+    int64_t avoided = (A.numLocalTiles() + ...);
+    count( Count::LayoutConversionsAvoided, avoided );
+    return Layout::RowMajor;
+}
+
 //------------------------------------------------------------------------------
 /// A helper function to find each rank's first (top-most) row in panel k for
 /// the QR-family of routines.
@@ -154,6 +249,126 @@ slate::Matrix<scalar_t> alloc_basis(slate::BaseMatrix<scalar_t>& A, int64_t n,
     return V;
 }
 
+//------------------------------------------------------------------------------
+/// Host part of one block of s-step GMRES, on the rank owning the small
+/// matrices. On entry, G = [ Q K ]^H K, computed with one reduction, where
+/// Q are the j+1 orthonormal basis vectors and K are the s new vectors of
+/// the Newton basis, K(:, i) = (A M^{-1} - theta I) K(:, i-1), with
+/// K(:, -1) = Q(:, j).
+///
+/// Orthogonalizes K by block classical Gram-Schmidt and CholQR,
+/// (I - Q Q^H) K = Qn Rn, with the Cholesky factor of K^H K - R^H R,
+/// R = Q^H K, equilibrated by the norms of K. The block stops before the
+/// first vector with less than eps^{1/4} of its norm outside the span of
+/// the previous ones, taking s' <= s steps.
+///
+/// On exit, for the first s' columns:
+/// - G(0:j, :) = R and G(j+1:j+s', :) = Rn, so Qn = (K - Q R) Rn^{-1}.
+/// - PT(0:j-1, :) = P and PT(j:j+s'-1, :) = T, upper triangular, with
+///   [ Q(:, j), K(:, 0:s'-2) ] = Q(:, 0:j-1) P + Q(:, j:j+s'-1) T, so the
+///   solution basis is M^{-1} Q(:, j:j+s'-1)
+///   = (M^{-1} [ Q(:, j), K(:, 0:s'-2) ] - M^{-1} Q(:, 0:j-1) P) T^{-1}.
+/// - H(0:j+s', j:j+s'-1) are the new columns of the Hessenberg matrix,
+///   A M^{-1} Q(:, 0:j+s'-1) = Q(:, 0:j+s') H, given its previous columns
+///   H(0:j, 0:j-1), before any Givens rotations.
+///
+/// @return s', the number of steps taken, 0 <= s' <= s.
+///
+template <typename scalar_t>
+int64_t sstep_arnoldi(
+    int64_t j, int64_t s, scalar_t theta,
+    scalar_t* G,  int64_t ldg,
+    scalar_t* PT, int64_t ldpt,
+    scalar_t* H,  int64_t ldh )
+{
+    using real_t = blas::real_type<scalar_t>;
+    using blas::conj;
+    const scalar_t zero = 0.0;
+    const scalar_t one  = 1.0;
+    const real_t tol = std::pow( std::numeric_limits<real_t>::epsilon(),
+                                 real_t( 0.25 ) );
+
+    auto g  = [&]( int64_t i, int64_t k ) -> scalar_t& { return G[ i + k*ldg ]; };
+    auto pt = [&]( int64_t i, int64_t k ) -> scalar_t& { return PT[ i + k*ldpt ]; };
+    auto h  = [&]( int64_t i, int64_t k ) -> scalar_t& { return H[ i + k*ldh ]; };
+
+    // Gk = K^H K - R^H R, upper triangle; d = norms of K.
+    std::vector<scalar_t> Gk( s*s ), U( s*s, zero );
+    std::vector<real_t> d( s );
+    for (int64_t k = 0; k < s; ++k) {
+        d[ k ] = std::sqrt( std::real( g( j+1+k, k ) ) );
+        for (int64_t r = 0; r <= k; ++r) {
+            scalar_t sum = g( j+1+r, k );
+            for (int64_t i = 0; i <= j; ++i)
+                sum -= conj( g( i, r ) ) * g( i, k );
+            Gk[ r + k*s ] = sum;
+        }
+    }
+
+    // Cholesky of D^{-1} Gk D^{-1} = U^H U, stopping at a small pivot.
+    int64_t sp = 0;
+    for (int64_t k = 0; k < s; ++k) {
+        if (! (d[ k ] > 0))
+            break;
+        real_t diag = std::real( Gk[ k + k*s ] ) / (d[ k ]*d[ k ]);
+        for (int64_t r = 0; r < k; ++r) {
+            scalar_t sum = Gk[ r + k*s ] / (d[ r ]*d[ k ]);
+            for (int64_t i = 0; i < r; ++i)
+                sum -= conj( U[ i + r*s ] ) * U[ i + k*s ];
+            U[ r + k*s ] = sum / U[ r + r*s ];
+            diag -= std::norm( U[ r + k*s ] );
+        }
+        if (! (diag > tol*tol))
+            break;
+        U[ k + k*s ] = std::sqrt( diag );
+        sp = k+1;
+    }
+    if (sp == 0)
+        return 0;
+
+    // Rn = U D.
+    for (int64_t k = 0; k < sp; ++k) {
+        for (int64_t r = 0; r < sp; ++r)
+            g( j+1+r, k ) = r <= k ? U[ r + k*s ] * d[ k ] : zero;
+    }
+
+    // P and T.
+    for (int64_t k = 0; k < sp; ++k) {
+        for (int64_t r = 0; r < j; ++r)
+            pt( r, k ) = k == 0 ? zero : g( r, k-1 );
+        pt( j, k ) = k == 0 ? one : g( j, k-1 );
+        for (int64_t r = 1; r < sp; ++r)
+            pt( j+r, k ) = k == 0 || r > k ? zero : g( j+r, k-1 );
+    }
+
+    // With C(:, 0) = e_j and C(:, i) = [ R(:, i-1); Rn(:, i-1) ], i >= 1,
+    // A M^{-1} K(:, i-1) = Q (C(:, i+1) + theta C(:, i)), where K(:, -1)
+    // = q_j, so H(:, j:j+s'-1) T = C(:, 1:s') + theta C(:, 0:s'-1)
+    // - [ H(0:j, 0:j-1) P; 0 ].
+    int64_t rows = j + sp + 1;
+    auto c_col = [&]( int64_t r, int64_t i ) -> scalar_t {
+        if (i == 0)
+            return r == j ? one : zero;
+        return r <= j + i ? g( r, i-1 ) : zero;
+    };
+    for (int64_t i = 0; i < sp; ++i) {
+        for (int64_t r = 0; r < rows; ++r) {
+            scalar_t sum = c_col( r, i+1 ) + theta * c_col( r, i );
+            if (r <= j) {
+                for (int64_t k = 0; k < j; ++k)
+                    sum -= h( r, k ) * pt( k, i );
+            }
+            // Solve with T, forward over columns.
+            for (int64_t k = 0; k < i; ++k)
+                sum -= h( r, j+k ) * pt( j+k, i );
+            h( r, j+i ) = sum / pt( j+i, i );
+        }
+        for (int64_t r = rows; r < ldh; ++r)
+            h( r, j+i ) = zero;
+    }
+    return sp;
+}
+
 //------------------------------------------------------------------------------
 /// Computes the global index for each tile
 ///
@@ -182,6 +397,110 @@ std::vector<int64_t> tile_offsets( RowCol dim, slate::BaseMatrix<scalar_t>& A )
     return offset_list;
 }
 
+//------------------------------------------------------------------------------
+/// Finishes an update $C = \alpha A B + \beta C$ that skipped the tiles
+/// C(i, j) whose inputs are structurally zero. Scales those local tiles
+/// by beta, on the host, then records the fill-in: C(i, j) stays zero only
+/// if it was skipped and either it was zero or beta = 0.
+/// Must be called on all ranks, so they agree on the zero tiles of C.
+///
+/// @param[in] beta
+///     The scalar beta of the update.
+///
+/// @param[in,out] C
+///     The updated matrix.
+///
+/// @param[in] lower
+///     Whether only tiles in the lower triangle, i >= j, were updated.
+///
+/// @param[in] skipped
+///     Whether the update of C(i, j) was skipped.
+///
+template <typename scalar_t>
+void zero_tiles_update(
+    scalar_t beta, slate::BaseMatrix<scalar_t>& C, bool lower,
+    std::function<bool (int64_t i, int64_t j)> const& skipped )
+{
+    const scalar_t zero = 0.0;
+    const scalar_t one  = 1.0;
+
+    bool track = C.zeroTilesTracked();
+    for (int64_t j = 0; j < C.nt(); ++j) {
+        for (int64_t i = (lower ? j : 0); i < C.mt(); ++i) {
+            if (skipped( i, j )) {
+                // A lazy zero tile stays unallocated when beta = 0.
+                if (beta != one && C.tileIsLocal( i, j )
+                    && ! (beta == zero && C.tileIsLazyZero( i, j ))) {
+                    C.tileGetForWriting( i, j, LayoutConvert::None );
+                    if (beta == zero)
+                        C( i, j ).set( zero );
+                    else
+                        tile::scale( beta, C( i, j ) );
+                }
+                if (track && beta == zero)
+                    C.tileSetZero( i, j );
+            }
+            else if (track) {
+                C.tileSetZero( i, j, false );
+            }
+        }
+    }
+}
+
+
+//------------------------------------------------------------------------------
+/// Records the zero tiles of A after setting its off-diagonal entries to
+/// offdiag_value and its diagonal entries to diag_value: a tile is zero if
+/// offdiag_value = 0 and either diag_value = 0 or it has no diagonal entries.
+/// Must be called on all ranks; does nothing if A does not track zero tiles.
+///
+template <typename scalar_t>
+void zero_tiles_set(
+    scalar_t offdiag_value, scalar_t diag_value,
+    slate::BaseMatrix<scalar_t>& A )
+{
+    const scalar_t zero = 0.0;
+
+    if (! A.zeroTilesTracked())
+        return;
+
+    std::vector<int64_t> row_offsets = tile_offsets( RowCol::Row, A );
+    std::vector<int64_t> col_offsets = tile_offsets( RowCol::Col, A );
+    for (int64_t j = 0; j < A.nt(); ++j) {
+        int64_t j1 = col_offsets[ j ];
+        int64_t j2 = j1 + A.tileNb( j );
+        for (int64_t i = 0; i < A.mt(); ++i) {
+            int64_t i1 = row_offsets[ i ];
+            int64_t i2 = i1 + A.tileMb( i );
+            bool has_diag = i1 < j2 && j1 < i2;
+            bool is_zero = offdiag_value == zero
+                           && (diag_value == zero || ! has_diag);
+            A.tileSetZero( i, j, is_zero );
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Copies the zero tiles of A to B after copying A to B.
+/// If A tracks zero tiles, B then tracks them too.
+/// Must be called on all ranks.
+///
+template <typename src_scalar_t, typename dst_scalar_t>
+void zero_tiles_copy(
+    slate::BaseMatrix<src_scalar_t>& A,
+    slate::BaseMatrix<dst_scalar_t>& B )
+{
+    if (A.zeroTilesTracked())
+        B.trackZeroTiles();
+    else if (! B.zeroTilesTracked())
+        return;
+
+    for (int64_t j = 0; j < B.nt(); ++j) {
+        for (int64_t i = 0; i < B.mt(); ++i) {
+            B.tileSetZero( i, j, A.tileIsZero( i, j ) );
+        }
+    }
+}
 
 } // namespace internal
 } // namespace slate
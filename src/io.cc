@@ -0,0 +1,205 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/slate.hh"
+#include "internal/internal.hh"
+#include "internal/internal_io.hh"
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace slate {
+
+namespace impl {
+
+//------------------------------------------------------------------------------
+/// @return a matrix of the same size as op(A) with the file's mb-by-nb
+/// tiles, on A's process grid if it is 2D block cyclic, otherwise on a
+/// 1-by-mpi_size grid.
+template <typename scalar_t>
+Matrix<scalar_t> file_tiles_like(
+    Matrix<scalar_t>& A, int64_t mb, int64_t nb )
+{
+    GridOrder order;
+    int p, q, myp, myq;
+    A.gridinfo( &order, &p, &q, &myp, &myq );
+    if (order == GridOrder::Unknown) {
+        int mpi_size;
+        slate_mpi_call(
+            MPI_Comm_size( A.mpiComm(), &mpi_size ) );
+        order = GridOrder::Col;
+        p = 1;
+        q = mpi_size;
+    }
+    Matrix<scalar_t> B( A.m(), A.n(), mb, nb, order, p, q, A.mpiComm() );
+    B.insertLocalTiles();
+    return B;
+}
+
+} // namespace impl
+
+//------------------------------------------------------------------------------
+/// Writes op(A) to a file in the SLATE matrix format, with collective
+/// MPI-IO: each rank writes its local tiles at their offsets in the file.
+/// The file has A's tile size, A.tileMb( 0 )-by-A.tileNb( 0 ). If op(A) is
+/// transposed or has irregular tiles, it is first redistributed to regular
+/// tiles.
+/// Collective over A's MPI communicator.
+///
+/// @param[in] filename
+///     Name of the file, which is created or overwritten.
+///
+/// @param[in] A
+///     The m-by-n matrix A to write. Tiles valid only on devices are
+///     streamed through the host one block column at a time.
+///
+/// @param[in] opts
+///     Additional options, currently unused.
+///
+/// @ingroup util
+///
+template <typename scalar_t>
+void write(
+    std::string const& filename, Matrix<scalar_t>& A, Options const& opts )
+{
+    trace::Block trace_block( "slate::write" );
+
+    auto header = internal::file_header<scalar_t>(
+                      A.m(), A.n(), A.tileMb( 0 ), A.tileNb( 0 ) );
+
+    if (! internal::file_tiles_match( A, header.mb, header.nb )) {
+        auto B = impl::file_tiles_like( A, header.mb, header.nb );
+        redistribute( A, B, opts );
+        write( filename, B, opts );
+        return;
+    }
+
+    MPI_File fh;
+    slate_mpi_call(
+        MPI_File_open( A.mpiComm(), filename.c_str(),
+                       MPI_MODE_CREATE | MPI_MODE_WRONLY,
+                       MPI_INFO_NULL, &fh ) );
+    slate_mpi_call(
+        MPI_File_set_size( fh, 0 ) );
+    if (A.mpiRank() == 0) {
+        slate_mpi_call(
+            MPI_File_write_at( fh, 0, &header, sizeof( header ), MPI_BYTE,
+                               MPI_STATUS_IGNORE ) );
+    }
+    internal::file_tiles( fh, header, A, true );
+    slate_mpi_call(
+        MPI_File_close( &fh ) );
+}
+
+//------------------------------------------------------------------------------
+/// Reads op(A) from a file in the SLATE matrix format, with collective
+/// MPI-IO: each rank reads its local tiles from their offsets in the file.
+/// A can have a different process grid or tile size than the matrix that
+/// was written; then the file is read into the file's tiles and
+/// redistributed to A.
+/// Collective over A's MPI communicator.
+///
+/// @param[in] filename
+///     Name of the file.
+///
+/// @param[in,out] A
+///     On entry, the m-by-n matrix A with its local tiles inserted,
+///     of the same size and precision as the matrix in the file.
+///     On exit, the matrix from the file. Tiles with origin on devices
+///     are updated on devices.
+///
+/// @param[in] opts
+///     Additional options, currently unused.
+///
+/// @ingroup util
+///
+template <typename scalar_t>
+void read(
+    std::string const& filename, Matrix<scalar_t>& A, Options const& opts )
+{
+    trace::Block trace_block( "slate::read" );
+
+    MPI_File fh;
+    slate_mpi_call(
+        MPI_File_open( A.mpiComm(), filename.c_str(), MPI_MODE_RDONLY,
+                       MPI_INFO_NULL, &fh ) );
+
+    internal::FileHeader header;
+    if (A.mpiRank() == 0) {
+        slate_mpi_call(
+            MPI_File_read_at( fh, 0, &header, sizeof( header ), MPI_BYTE,
+                              MPI_STATUS_IGNORE ) );
+    }
+    slate_mpi_call(
+        MPI_Bcast( &header, sizeof( header ), MPI_BYTE, 0, A.mpiComm() ) );
+
+    if (std::memcmp( header.magic, internal::file_magic, sizeof( header.magic ) ) != 0
+        || header.version != internal::file_version) {
+        MPI_File_close( &fh );
+        slate_error( "read: " + filename + " is not a SLATE matrix file" );
+    }
+    if (header.type != internal::file_type<scalar_t>()) {
+        MPI_File_close( &fh );
+        slate_error( "read: precision of " + filename + " does not match" );
+    }
+    if (header.m != A.m() || header.n != A.n()) {
+        MPI_File_close( &fh );
+        slate_error( "read: dimensions of " + filename + " do not match" );
+    }
+
+    if (internal::file_tiles_match( A, header.mb, header.nb )) {
+        internal::file_tiles( fh, header, A, false );
+        slate_mpi_call(
+            MPI_File_close( &fh ) );
+    }
+    else {
+        auto B = impl::file_tiles_like( A, header.mb, header.nb );
+        internal::file_tiles( fh, header, B, false );
+        slate_mpi_call(
+            MPI_File_close( &fh ) );
+        redistribute( B, A, opts );
+    }
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void write<float>(
+    std::string const& filename, Matrix<float>& A, Options const& opts );
+
+template
+void write<double>(
+    std::string const& filename, Matrix<double>& A, Options const& opts );
+
+template
+void write< std::complex<float> >(
+    std::string const& filename, Matrix< std::complex<float> >& A,
+    Options const& opts );
+
+template
+void write< std::complex<double> >(
+    std::string const& filename, Matrix< std::complex<double> >& A,
+    Options const& opts );
+
+template
+void read<float>(
+    std::string const& filename, Matrix<float>& A, Options const& opts );
+
+template
+void read<double>(
+    std::string const& filename, Matrix<double>& A, Options const& opts );
+
+template
+void read< std::complex<float> >(
+    std::string const& filename, Matrix< std::complex<float> >& A,
+    Options const& opts );
+
+template
+void read< std::complex<double> >(
+    std::string const& filename, Matrix< std::complex<double> >& A,
+    Options const& opts );
+
+} // namespace slate
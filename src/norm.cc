@@ -65,14 +65,14 @@ norm(
         }
 
         MPI_Op op_max_nan;
-        #pragma omp critical(slate_mpi)
         {
+            internal::MpiGuard mpi_guard;
             slate_mpi_call(
                 MPI_Op_create(mpi_max_nan, true, &op_max_nan));
         }
 
-        #pragma omp critical(slate_mpi)
         {
+            internal::MpiGuard mpi_guard;
             trace::Block trace_block("MPI_Allreduce");
             slate_mpi_call(
                 MPI_Allreduce(&local_max, &global_max,
@@ -80,8 +80,8 @@ norm(
                               op_max_nan, A.mpiComm()));
         }
 
-        #pragma omp critical(slate_mpi)
         {
+            internal::MpiGuard mpi_guard;
             slate_mpi_call(
                 MPI_Op_free(&op_max_nan));
         }
@@ -105,8 +105,8 @@ norm(
 
         std::vector<real_t> global_sums(A.n());
 
-        #pragma omp critical(slate_mpi)
         {
+            internal::MpiGuard mpi_guard;
             trace::Block trace_block("MPI_Allreduce");
             slate_mpi_call(
                 MPI_Allreduce(local_sums.data(), global_sums.data(),
@@ -133,8 +133,8 @@ norm(
 
         std::vector<real_t> global_sums(A.m());
 
-        #pragma omp critical(slate_mpi)
         {
+            internal::MpiGuard mpi_guard;
             trace::Block trace_block("MPI_Allreduce");
             slate_mpi_call(
                 MPI_Allreduce(local_sums.data(), global_sums.data(),
@@ -161,8 +161,8 @@ norm(
             internal::norm<target>(in_norm, NormScope::Matrix, std::move(A), local_values);
         }
 
-        #pragma omp critical(slate_mpi)
         {
+            internal::MpiGuard mpi_guard;
             trace::Block trace_block("MPI_Allreduce");
             // todo: propogate scale
             local_sumsq = local_values[0] * local_values[0] * local_values[1];
@@ -181,6 +181,95 @@ norm(
     }
 }
 
+//------------------------------------------------------------------------------
+/// @internal
+/// Distributed parallel general matrix norms.
+/// Generic implementation for any target.
+/// @ingroup norm_impl
+///
+template <Target target, typename scalar_t>
+void norms(
+    std::vector<Norm> const& in_norms, Matrix<scalar_t> A,
+    blas::real_type<scalar_t>* values,
+    Options const& opts )
+{
+    using real_t = blas::real_type<scalar_t>;
+    using internal::mpi_max_nan;
+
+    bool want_max = false, want_fro = false;
+    for (auto in_norm : in_norms) {
+        want_max = want_max || in_norm == Norm::Max;
+        want_fro = want_fro || in_norm == Norm::Fro;
+    }
+
+    real_t global_max = 0, global_fro = 0;
+    bool max_fro = want_max && want_fro;
+    if (max_fro) {
+        // Max and Frobenius norms are the same for any transpose.
+        if (A.op() == Op::ConjTrans)
+            A = conj_transpose( A );
+        else if (A.op() == Op::Trans)
+            A = transpose( A );
+
+        if (target == Target::Devices) {
+            const int64_t batch_size_default = 0;
+            const int64_t num_queues = 1;
+            A.allocateBatchArrays( batch_size_default, num_queues );
+            A.reserveDeviceWorkspace();
+        }
+
+        // local max, scale, and sum-of-squares
+        real_t local_values[ 3 ];
+
+        #pragma omp parallel
+        #pragma omp master
+        {
+            internal::norm_max_fro<target>( std::move( A ), local_values );
+        }
+
+        MPI_Op op_max_nan;
+        {
+            internal::MpiGuard mpi_guard;
+            slate_mpi_call(
+                MPI_Op_create(mpi_max_nan, true, &op_max_nan));
+        }
+
+        real_t local_sumsq = local_values[ 1 ] * local_values[ 1 ] * local_values[ 2 ];
+        real_t global_sumsq;
+        {
+            internal::MpiGuard mpi_guard;
+            trace::Block trace_block("MPI_Allreduce");
+            slate_mpi_call(
+                MPI_Allreduce(&local_values[ 0 ], &global_max,
+                              1, mpi_type<real_t>::value,
+                              op_max_nan, A.mpiComm()));
+            slate_mpi_call(
+                MPI_Allreduce(&local_sumsq, &global_sumsq,
+                              1, mpi_type<real_t>::value,
+                              MPI_SUM, A.mpiComm()));
+        }
+
+        {
+            internal::MpiGuard mpi_guard;
+            slate_mpi_call(
+                MPI_Op_free(&op_max_nan));
+        }
+
+        A.releaseWorkspace();
+
+        global_fro = sqrt( global_sumsq );
+    }
+
+    for (size_t k = 0; k < in_norms.size(); ++k) {
+        if (max_fro && in_norms[ k ] == Norm::Max)
+            values[ k ] = global_max;
+        else if (max_fro && in_norms[ k ] == Norm::Fro)
+            values[ k ] = global_fro;
+        else
+            values[ k ] = impl::norm<target>( in_norms[ k ], A, opts );
+    }
+}
+
 } // namespace impl
 
 //------------------------------------------------------------------------------
@@ -218,7 +307,7 @@ norm(
     Norm in_norm, matrix_type& A,
     Options const& opts )
 {
-    Target target = get_option( opts, Option::Target, Target::HostTask );
+    Target target = get_target( opts, Target::HostTask );
 
     switch (target) {
         case Target::Host:
@@ -232,15 +321,94 @@ norm(
             break;
 
         case Target::Devices:
+        case Target::Hybrid:
             return impl::norm<Target::Devices>( in_norm, A, opts );
             break;
     }
     return -1.0;  // unreachable; silence error
 }
 
+//------------------------------------------------------------------------------
+/// Distributed parallel general matrix norms: computes several norms of A
+/// in one call. The max and Frobenius norms together take a single pass
+/// over A, which on devices is one launch per device that reduces all
+/// local tiles, and a single Allreduce each. Other norms are computed as
+/// in norm().
+///
+/// @param[in] in_norms
+///     Norms to compute: Norm::Max, One, Inf, or Fro, @see norm.
+///
+/// @param[in] A
+///     The m-by-n matrix A.
+///
+/// @param[out] values
+///     Array of dimension in_norms.size().
+///     On exit, values[ k ] is the norm in_norms[ k ] of A.
+///
+/// @param[in] opts
+///     Additional options, as map of name = value pairs. Possible options:
+///     - Option::Target:
+///       Implementation to target. Possible values:
+///       - HostTask:  OpenMP tasks on CPU host [default].
+///       - HostNest:  nested OpenMP parallel for loop on CPU host.
+///       - Devices:   batched BLAS on GPU device.
+///
+/// @ingroup norm
+///
+template <typename scalar_t>
+void norms(
+    std::vector<Norm> const& in_norms, Matrix<scalar_t>& A,
+    blas::real_type<scalar_t>* values,
+    Options const& opts )
+{
+    Target target = get_target( opts, Target::HostTask );
+
+    switch (target) {
+        case Target::Host:
+        case Target::HostTask:
+            impl::norms<Target::HostTask>( in_norms, A, values, opts );
+            break;
+
+        case Target::HostBatch:
+        case Target::HostNest:
+            impl::norms<Target::HostNest>( in_norms, A, values, opts );
+            break;
+
+        case Target::Devices:
+        case Target::Hybrid:
+            impl::norms<Target::Devices>( in_norms, A, values, opts );
+            break;
+    }
+}
+
 //------------------------------------------------------------------------------
 // Explicit instantiations.
 template
+void norms(
+    std::vector<Norm> const& in_norms, Matrix<float>& A,
+    float* values,
+    Options const& opts);
+
+template
+void norms(
+    std::vector<Norm> const& in_norms, Matrix<double>& A,
+    double* values,
+    Options const& opts);
+
+template
+void norms(
+    std::vector<Norm> const& in_norms, Matrix< std::complex<float> >& A,
+    float* values,
+    Options const& opts);
+
+template
+void norms(
+    std::vector<Norm> const& in_norms, Matrix< std::complex<double> >& A,
+    double* values,
+    Options const& opts);
+
+//--------------------
+template
 float norm(
     Norm in_norm, Matrix<float>& A,
     Options const& opts);
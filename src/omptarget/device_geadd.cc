@@ -6,6 +6,8 @@
 #include "slate/Exception.hh"
 #include "slate/internal/device.hh"
 
+#include "device_util.hh"
+
 #include <cstdio>
 
 namespace slate {
@@ -57,17 +59,11 @@ void geadd(
     if (m == 0 || n == 0)
         return;
 
-    queue.sync(); // sync queue before switching to openmp device execution
-    // Use omp target offload
-    #pragma omp target is_device_ptr(A, B) device(queue.device())
-    #pragma omp teams distribute parallel for schedule(static, 1)
-    for (int64_t i = 0; i < m; ++i) {
-        scalar_t* rowA = &A[i];
-        scalar_t* rowB = &B[i];
-        for (int64_t j = 0; j < n; ++j) {
-            rowB[j*ldb] = alpha * rowA[j*lda] + beta * rowB[j*ldb];
-        }
-    }
+    for_each_element(
+        m, n, 1, queue,
+        [=]( int64_t, int64_t i, int64_t j ) {
+            B[ i + j*ldb ] = alpha * A[ i + j*lda ] + beta * B[ i + j*ldb ];
+        } );
 #else
     throw slate::Exception( "device routines not available" );
 #endif
@@ -160,23 +156,13 @@ void geadd(
     if (batch_count == 0)
         return;
 
-    queue.sync(); // sync queue before switching to openmp device execution
-    // Use omp target offload
-    #pragma omp target is_device_ptr(Aarray, Barray) device(queue.device())
-    #pragma omp teams distribute
-    for (int64_t k = 0; k < batch_count; ++k) {
-        scalar_t* tileA = Aarray[k];
-        scalar_t* tileB = Barray[k];
-        // distribute rows (i) to threads
-        #pragma omp parallel for schedule(static, 1)
-        for (int64_t i = 0; i < m; ++i) {
-            scalar_t* rowA = &tileA[i];
-            scalar_t* rowB = &tileB[i];
-            for (int64_t j = 0; j < n; ++j) {
-                rowB[j*ldb] = alpha * rowA[j*lda] + beta * rowB[j*ldb];
-            }
-        }
-    }
+    for_each_element(
+        m, n, batch_count, queue,
+        [=]( int64_t k, int64_t i, int64_t j ) {
+            scalar_t* B = Barray[ k ];
+            B[ i + j*ldb ] = alpha * Aarray[ k ][ i + j*lda ]
+                           + beta * B[ i + j*ldb ];
+        } );
 #else
     throw slate::Exception( "device routines not available" );
 #endif
@@ -212,6 +198,55 @@ void geadd(
     std::complex<double> const& beta, std::complex<double>** Barray, int64_t ldb,
     int64_t batch_count, blas::Queue &queue);
 
+//------------------------------------------------------------------------------
+/// Batched routine for element-wise tile addition with precision conversion
+/// of A, as the CUDA implementation.
+/// @see geadd
+///
+template <typename src_scalar_t, typename dst_scalar_t>
+void geadd(
+    int64_t m, int64_t n,
+    dst_scalar_t const& alpha, src_scalar_t const* const* Aarray, int64_t lda,
+    dst_scalar_t const& beta, dst_scalar_t** Barray, int64_t ldb,
+    int64_t batch_count, blas::Queue &queue)
+{
+#ifdef SLATE_HAVE_OMPTARGET
+    // quick return
+    if (m == 0 || n == 0 || batch_count == 0)
+        return;
+
+    for_each_element(
+        m, n, batch_count, queue,
+        [=]( int64_t k, int64_t i, int64_t j ) {
+            dst_scalar_t* B = Barray[ k ];
+            dst_scalar_t a = dst_scalar_t( Aarray[ k ][ i + j*lda ] );
+            B[ i + j*ldb ] = alpha * a + beta * B[ i + j*ldb ];
+        } );
+#else
+    throw slate::Exception( "device routines not available" );
+#endif
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+// float => double
+template
+void geadd(
+    int64_t m, int64_t n,
+    double const& alpha, float const* const* Aarray, int64_t lda,
+    double const& beta, double** Barray, int64_t ldb,
+    int64_t batch_count, blas::Queue &queue);
+
+// complex-float => complex-double
+template
+void geadd(
+    int64_t m, int64_t n,
+    std::complex<double> const& alpha,
+    std::complex<float> const* const* Aarray, int64_t lda,
+    std::complex<double> const& beta,
+    std::complex<double>** Barray, int64_t ldb,
+    int64_t batch_count, blas::Queue &queue);
+
 } // namespace batch
 } // namespace device
 } // namespace slate
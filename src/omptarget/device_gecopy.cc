@@ -59,24 +59,13 @@ void gecopy(
     if (batch_count == 0)
         return;
 
-    queue.sync(); // sync queue before switching to openmp device execution
-    #pragma omp target is_device_ptr(Aarray, Barray) device(queue.device())
-    #pragma omp teams distribute
-    for (int64_t k = 0; k < batch_count; ++k) {
-        src_scalar_t const* tileA = Aarray[k];
-        dst_scalar_t* tileB = Barray[k];
-        // distribute rows (i) to threads
-        #pragma omp parallel for schedule(static, 1)
-        for (int64_t i = 0; i < m; ++i) {
-            src_scalar_t const* rowA = &tileA[i];
-            dst_scalar_t* rowB = &tileB[i];
-            for (int64_t j = 0; j < n; ++j) {
-                // todo: confirm type conversion float-complex -> double-complex
-                // todo: confirm type conversion double-complex -> float-complex
-                rowB[j*ldb] = rowA[j*lda];
-            }
-        }
-    }
+    for_each_element(
+        m, n, batch_count, queue,
+        [=]( int64_t k, int64_t i, int64_t j ) {
+            // todo: confirm type conversion float-complex -> double-complex
+            // todo: confirm type conversion double-complex -> float-complex
+            Barray[ k ][ i + j*ldb ] = Aarray[ k ][ i + j*lda ];
+        } );
 #else
     throw slate::Exception( "device routines not available" );
 #endif
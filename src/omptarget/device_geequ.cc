@@ -0,0 +1,119 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/Exception.hh"
+#include "slate/internal/device.hh"
+
+#include "device_util.hh"
+
+#include <complex>
+
+namespace slate {
+namespace device {
+namespace batch {
+
+//------------------------------------------------------------------------------
+/// Variable-size batched row or column maxima for equilibration,
+/// as the CUDA implementation.
+/// @see geequ_vbatch
+///
+template <typename scalar_t>
+void geequ_vbatch(
+    RowCol rowcol, int64_t const* dims,
+    scalar_t const* const* Aarray,
+    blas::real_type<scalar_t> const* R,
+    blas::real_type<scalar_t>* values,
+    int64_t batch_count, blas::Queue& queue )
+{
+#ifdef SLATE_HAVE_OMPTARGET
+    using real_t = blas::real_type<scalar_t>;
+
+    // quick return
+    if (batch_count == 0)
+        return;
+
+    queue.sync(); // sync queue before switching to openmp device execution
+
+    // Tiles may share rows or columns, so tiles go in order,
+    // rows or columns in parallel.
+    if (rowcol == RowCol::Row) {
+        #pragma omp target is_device_ptr(dims, Aarray, values) \
+                    device(queue.device())
+        for (int64_t b = 0; b < batch_count; ++b) {
+            int64_t m    = dims[ b ];
+            int64_t n    = dims[ b +   batch_count ];
+            int64_t lda  = dims[ b + 2*batch_count ];
+            int64_t ioff = dims[ b + 3*batch_count ];
+            scalar_t const* tile = Aarray[ b ];
+            #pragma omp parallel for schedule(static, 1)
+            for (int64_t i = 0; i < m; ++i) {
+                real_t max = values[ ioff + i ];
+                for (int64_t j = 0; j < n; ++j)
+                    max = max_nan( max, abs_val( tile[ i + j*lda ] ) );
+                values[ ioff + i ] = max;
+            }
+        }
+    }
+    else {
+        #pragma omp target is_device_ptr(dims, Aarray, R, values) \
+                    device(queue.device())
+        for (int64_t b = 0; b < batch_count; ++b) {
+            int64_t m    = dims[ b ];
+            int64_t n    = dims[ b +   batch_count ];
+            int64_t lda  = dims[ b + 2*batch_count ];
+            int64_t ioff = dims[ b + 3*batch_count ];
+            int64_t joff = dims[ b + 4*batch_count ];
+            scalar_t const* tile = Aarray[ b ];
+            #pragma omp parallel for schedule(static, 1)
+            for (int64_t j = 0; j < n; ++j) {
+                real_t max = values[ joff + j ];
+                for (int64_t i = 0; i < m; ++i)
+                    max = max_nan( max, abs_val( tile[ i + j*lda ] ) * R[ ioff + i ] );
+                values[ joff + j ] = max;
+            }
+        }
+    }
+#else
+    throw slate::Exception( "device routines not available" );
+#endif
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void geequ_vbatch(
+    RowCol rowcol, int64_t const* dims,
+    float const* const* Aarray,
+    float const* R,
+    float* values,
+    int64_t batch_count, blas::Queue& queue );
+
+template
+void geequ_vbatch(
+    RowCol rowcol, int64_t const* dims,
+    double const* const* Aarray,
+    double const* R,
+    double* values,
+    int64_t batch_count, blas::Queue& queue );
+
+template
+void geequ_vbatch(
+    RowCol rowcol, int64_t const* dims,
+    std::complex<float> const* const* Aarray,
+    float const* R,
+    float* values,
+    int64_t batch_count, blas::Queue& queue );
+
+template
+void geequ_vbatch(
+    RowCol rowcol, int64_t const* dims,
+    std::complex<double> const* const* Aarray,
+    double const* R,
+    double* values,
+    int64_t batch_count, blas::Queue& queue );
+
+} // namespace batch
+} // namespace device
+} // namespace slate
@@ -0,0 +1,119 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/Exception.hh"
+#include "slate/internal/device.hh"
+
+namespace slate {
+namespace device {
+namespace batch {
+
+//------------------------------------------------------------------------------
+/// Variable-size batched general matrix multiply.
+/// @see the CUDA implementation for details of the arguments.
+///
+template <typename scalar_t>
+void gemm_vbatch(
+    blas::Op opA, blas::Op opB,
+    int64_t max_m, int64_t max_n, int64_t const* dims,
+    scalar_t const& alpha, scalar_t** Aarray,
+                           scalar_t** Barray,
+    scalar_t const& beta,  scalar_t** Carray,
+    int64_t batch_count, blas::Queue& queue )
+{
+#ifdef SLATE_HAVE_OMPTARGET
+    using blas::conj;
+
+    // quick return
+    if (batch_count == 0 || max_m == 0 || max_n == 0)
+        return;
+
+    bool beta_zero = beta == scalar_t( 0 );
+    // Pass scalars by value to the device.
+    scalar_t alpha_ = alpha;
+    scalar_t beta_  = beta;
+
+    queue.sync(); // sync queue before switching to openmp device execution
+    // Use omp target offload
+    #pragma omp target is_device_ptr(dims, Aarray, Barray, Carray) \
+                device(queue.device())
+    #pragma omp teams distribute
+    for (int64_t b = 0; b < batch_count; ++b) {
+        int64_t m   = dims[ b ];
+        int64_t n   = dims[ b +   batch_count ];
+        int64_t k   = dims[ b + 2*batch_count ];
+        int64_t lda = dims[ b + 3*batch_count ];
+        int64_t ldb = dims[ b + 4*batch_count ];
+        int64_t ldc = dims[ b + 5*batch_count ];
+        scalar_t const* A = Aarray[ b ];
+        scalar_t const* B = Barray[ b ];
+        scalar_t*       C = Carray[ b ];
+
+        #pragma omp parallel for collapse(2) schedule(static, 1)
+        for (int64_t j = 0; j < n; ++j) {
+            for (int64_t i = 0; i < m; ++i) {
+                scalar_t sum = 0;
+                for (int64_t l = 0; l < k; ++l) {
+                    scalar_t a = opA == blas::Op::NoTrans ? A[ i + l*lda ]
+                               : opA == blas::Op::Trans   ? A[ l + i*lda ]
+                               : conj( A[ l + i*lda ] );
+                    scalar_t bb = opB == blas::Op::NoTrans ? B[ l + j*ldb ]
+                                : opB == blas::Op::Trans   ? B[ j + l*ldb ]
+                                : conj( B[ j + l*ldb ] );
+                    sum += a * bb;
+                }
+                if (beta_zero)
+                    C[ i + j*ldc ] = alpha_ * sum;
+                else
+                    C[ i + j*ldc ] = alpha_ * sum + beta_ * C[ i + j*ldc ];
+            }
+        }
+    }
+#else
+    throw slate::Exception( "device routines not available" );
+#endif
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void gemm_vbatch(
+    blas::Op opA, blas::Op opB,
+    int64_t max_m, int64_t max_n, int64_t const* dims,
+    float const& alpha, float** Aarray,
+                        float** Barray,
+    float const& beta,  float** Carray,
+    int64_t batch_count, blas::Queue& queue );
+
+template
+void gemm_vbatch(
+    blas::Op opA, blas::Op opB,
+    int64_t max_m, int64_t max_n, int64_t const* dims,
+    double const& alpha, double** Aarray,
+                         double** Barray,
+    double const& beta,  double** Carray,
+    int64_t batch_count, blas::Queue& queue );
+
+template
+void gemm_vbatch(
+    blas::Op opA, blas::Op opB,
+    int64_t max_m, int64_t max_n, int64_t const* dims,
+    std::complex<float> const& alpha, std::complex<float>** Aarray,
+                                      std::complex<float>** Barray,
+    std::complex<float> const& beta,  std::complex<float>** Carray,
+    int64_t batch_count, blas::Queue& queue );
+
+template
+void gemm_vbatch(
+    blas::Op opA, blas::Op opB,
+    int64_t max_m, int64_t max_n, int64_t const* dims,
+    std::complex<double> const& alpha, std::complex<double>** Aarray,
+                                       std::complex<double>** Barray,
+    std::complex<double> const& beta,  std::complex<double>** Carray,
+    int64_t batch_count, blas::Queue& queue );
+
+} // namespace batch
+} // namespace device
+} // namespace slate
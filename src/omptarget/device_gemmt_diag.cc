@@ -0,0 +1,122 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/Exception.hh"
+#include "slate/internal/device.hh"
+
+#include <complex>
+
+namespace slate {
+namespace device {
+namespace batch {
+
+//------------------------------------------------------------------------------
+/// Batched matrix multiply of the diagonal blocks of triangular results.
+/// @see the CUDA implementation for details of the arguments.
+///
+template <typename scalar_t>
+void gemmt_diag(
+    blas::Uplo uplo, blas::Op opA, blas::Op opB,
+    int64_t n, int64_t k, int64_t nb_diag,
+    scalar_t const& alpha, scalar_t** Aarray, int64_t lda,
+                           scalar_t** Barray, int64_t ldb,
+    scalar_t const& beta,  scalar_t** Carray, int64_t ldc,
+    int64_t batch_count, blas::Queue& queue )
+{
+#ifdef SLATE_HAVE_OMPTARGET
+    using blas::conj;
+    using blas::real;
+
+    // quick return
+    if (batch_count == 0 || n == 0)
+        return;
+
+    bool lower = uplo == blas::Uplo::Lower;
+    bool beta_zero = beta == scalar_t( 0 );
+    bool hermitian = opA == blas::Op::ConjTrans || opB == blas::Op::ConjTrans;
+    // Pass scalars by value to the device.
+    scalar_t alpha_ = alpha;
+    scalar_t beta_  = beta;
+
+    queue.sync(); // sync queue before switching to openmp device execution
+    // Use omp target offload
+    #pragma omp target is_device_ptr(Aarray, Barray, Carray) \
+                device(queue.device())
+    #pragma omp teams distribute
+    for (int64_t b = 0; b < batch_count; ++b) {
+        scalar_t const* A = Aarray[ b ];
+        scalar_t const* B = Barray[ b ];
+        scalar_t*       C = Carray[ b ];
+
+        #pragma omp parallel for collapse(2) schedule(static, 1)
+        for (int64_t j = 0; j < n; ++j) {
+            for (int64_t i = 0; i < n; ++i) {
+                if (i / nb_diag != j / nb_diag || (lower ? i < j : i > j))
+                    continue;
+                scalar_t sum = 0;
+                for (int64_t l = 0; l < k; ++l) {
+                    scalar_t a = opA == blas::Op::NoTrans ? A[ i + l*lda ]
+                               : opA == blas::Op::Trans   ? A[ l + i*lda ]
+                               : conj( A[ l + i*lda ] );
+                    scalar_t bb = opB == blas::Op::NoTrans ? B[ l + j*ldb ]
+                                : opB == blas::Op::Trans   ? B[ j + l*ldb ]
+                                : conj( B[ j + l*ldb ] );
+                    sum += a * bb;
+                }
+                scalar_t value = alpha_ * sum;
+                if (! beta_zero)
+                    value += beta_ * C[ i + j*ldc ];
+                if (hermitian && i == j)
+                    value = real( value );
+                C[ i + j*ldc ] = value;
+            }
+        }
+    }
+#else
+    throw slate::Exception( "device routines not available" );
+#endif
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void gemmt_diag(
+    blas::Uplo uplo, blas::Op opA, blas::Op opB,
+    int64_t n, int64_t k, int64_t nb_diag,
+    float const& alpha, float** Aarray, int64_t lda,
+                        float** Barray, int64_t ldb,
+    float const& beta,  float** Carray, int64_t ldc,
+    int64_t batch_count, blas::Queue& queue );
+
+template
+void gemmt_diag(
+    blas::Uplo uplo, blas::Op opA, blas::Op opB,
+    int64_t n, int64_t k, int64_t nb_diag,
+    double const& alpha, double** Aarray, int64_t lda,
+                         double** Barray, int64_t ldb,
+    double const& beta,  double** Carray, int64_t ldc,
+    int64_t batch_count, blas::Queue& queue );
+
+template
+void gemmt_diag(
+    blas::Uplo uplo, blas::Op opA, blas::Op opB,
+    int64_t n, int64_t k, int64_t nb_diag,
+    std::complex<float> const& alpha, std::complex<float>** Aarray, int64_t lda,
+                                      std::complex<float>** Barray, int64_t ldb,
+    std::complex<float> const& beta,  std::complex<float>** Carray, int64_t ldc,
+    int64_t batch_count, blas::Queue& queue );
+
+template
+void gemmt_diag(
+    blas::Uplo uplo, blas::Op opA, blas::Op opB,
+    int64_t n, int64_t k, int64_t nb_diag,
+    std::complex<double> const& alpha, std::complex<double>** Aarray, int64_t lda,
+                                       std::complex<double>** Barray, int64_t ldb,
+    std::complex<double> const& beta,  std::complex<double>** Carray, int64_t ldc,
+    int64_t batch_count, blas::Queue& queue );
+
+} // namespace batch
+} // namespace device
+} // namespace slate
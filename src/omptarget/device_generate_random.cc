@@ -0,0 +1,188 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/Exception.hh"
+#include "slate/internal/device.hh"
+
+#include <cmath>
+
+#include "device_util.hh"
+
+namespace slate {
+namespace device {
+
+#ifdef SLATE_HAVE_OMPTARGET
+
+//------------------------------------------------------------------------------
+/// Generates 128 pseudorandom bits using the Philox-2x64 generator,
+/// the same as slate::random::philox_2x64 on the host, with the portable
+/// 64 x 64 => 128-bit product.
+///
+#pragma omp declare target
+inline void philox_2x64(
+    uint64_t& state0, uint64_t& state1, uint64_t seed )
+{
+    const uint64_t seed_inc = 0xD2B74407B1CE6E93ull;
+    const uint64_t multiplier = 0x9E3779B97F4A7C15ull;
+    const uint64_t mask_32 = (uint64_t(1) << 32) - 1;
+    const int rounds = 10;
+
+    for (int i = 0; i < rounds; ++i) {
+        if (i != 0) {
+            // bump seed
+            seed += seed_inc;
+        }
+
+        // Philox S-Box
+        uint64_t L = state0;
+        uint64_t R = state1;
+
+        uint64_t hi1 = (R >> 32) & mask_32;
+        uint64_t lo1 = R & mask_32;
+        uint64_t hi2 = (multiplier >> 32) & mask_32;
+        uint64_t lo2 = multiplier & mask_32;
+        uint64_t lo_lo = lo1*lo2;
+        uint64_t mid = (lo_lo >> 32) + (hi1*lo2 & mask_32) + lo1*hi2;
+        uint64_t product_hi = hi1*hi2 + (hi1*lo2 >> 32) + (mid >> 32);
+
+        state0 = R * multiplier;
+        state1 = product_hi ^ seed ^ L;
+    }
+}
+#pragma omp end declare target
+
+#endif // SLATE_HAVE_OMPTARGET
+
+//------------------------------------------------------------------------------
+/// Generates an m-by-n tile with random entries on the device,
+/// as the CUDA implementation.
+/// @see generate_random
+///
+template <typename scalar_t>
+void generate_random(
+    int64_t dist, int64_t seed,
+    int64_t m, int64_t n, int64_t ioffset, int64_t joffset,
+    blas::real_type<scalar_t> diag_value, blas::real_type<scalar_t> scale,
+    scalar_t* A, int64_t lda,
+    blas::Queue& queue )
+{
+#ifdef SLATE_HAVE_OMPTARGET
+    using real_t = blas::real_type<scalar_t>;
+    const bool is_complex = blas::is_complex<scalar_t>::value;
+    const int incr = is_complex ? 2 : 1;
+    const int digits = std::numeric_limits<real_t>::digits;
+    const real_t pi = 3.1415926535897932385;
+
+    // quick return
+    if (m == 0 || n == 0)
+        return;
+    if (dist < 1 || dist > 7)
+        throw slate::Exception( "unknown distribution" );
+
+    real_t* A_ = (real_t*) A;
+
+    queue.sync(); // sync queue before switching to openmp device execution
+    // Use omp target offload
+    #pragma omp target is_device_ptr(A_) device(queue.device())
+    #pragma omp teams distribute parallel for collapse(2) schedule(static, 1)
+    for (int64_t j = 0; j < n; ++j) {
+        for (int64_t i = 0; i < m; ++i) {
+            uint64_t state0 = i + ioffset;
+            uint64_t state1 = j + joffset;
+            philox_2x64( state0, state1, seed );
+            real_t raw_float1 = real_t( state0 >> (64 - digits) )
+                              / real_t( uint64_t(1) << digits );
+            real_t raw_float2 = real_t( state1 >> (64 - digits) )
+                              / real_t( uint64_t(1) << digits );
+
+            real_t re = 0, im = 0;
+            if (dist == 1) {
+                re = raw_float1;
+                im = raw_float2;
+            }
+            else if (dist == 2) {
+                re = 2*raw_float1-1;
+                im = 2*raw_float2-1;
+            }
+            else if (dist == 3) {
+                real_t mag = std::sqrt( -2*std::log( 1-raw_float1 ) );
+                real_t arg = 2 * pi * raw_float2;
+                re = mag * std::cos( arg );
+                im = mag * std::sin( arg );
+            }
+            else if (dist == 4) {
+                real_t mag = std::sqrt( raw_float1 );
+                real_t arg = 2 * pi * raw_float2;
+                re = mag * std::cos( arg );
+                im = mag * std::sin( arg );
+            }
+            else if (dist == 5) {
+                real_t arg = 2 * pi * raw_float2;
+                re = std::cos( arg );
+                im = std::sin( arg );
+            }
+            else if (dist == 6) {
+                re = raw_float1 >= 0.5 ? 1.0 : 0.0;
+                im = raw_float2 >= 0.5 ? 1.0 : 0.0;
+            }
+            else {
+                re = raw_float1 >= 0.5 ? 1.0 : -1.0;
+                im = raw_float2 >= 0.5 ? 1.0 : -1.0;
+            }
+
+            if (i == j && diag_value != 0)
+                re += diag_value;
+            if (scale != 1) {
+                re *= scale;
+                im *= scale;
+            }
+
+            real_t* Aij = &A_[ (i + j*lda)*incr ];
+            Aij[ 0 ] = re;
+            if (is_complex)
+                Aij[ 1 ] = im;
+        }
+    }
+#else
+    throw slate::Exception( "device routines not available" );
+#endif
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void generate_random(
+    int64_t dist, int64_t seed,
+    int64_t m, int64_t n, int64_t ioffset, int64_t joffset,
+    float diag_value, float scale,
+    float* A, int64_t lda,
+    blas::Queue& queue );
+
+template
+void generate_random(
+    int64_t dist, int64_t seed,
+    int64_t m, int64_t n, int64_t ioffset, int64_t joffset,
+    double diag_value, double scale,
+    double* A, int64_t lda,
+    blas::Queue& queue );
+
+template
+void generate_random(
+    int64_t dist, int64_t seed,
+    int64_t m, int64_t n, int64_t ioffset, int64_t joffset,
+    float diag_value, float scale,
+    std::complex<float>* A, int64_t lda,
+    blas::Queue& queue );
+
+template
+void generate_random(
+    int64_t dist, int64_t seed,
+    int64_t m, int64_t n, int64_t ioffset, int64_t joffset,
+    double diag_value, double scale,
+    std::complex<double>* A, int64_t lda,
+    blas::Queue& queue );
+
+} // namespace device
+} // namespace slate
@@ -0,0 +1,138 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/Exception.hh"
+#include "slate/internal/device.hh"
+
+#include "device_util.hh"
+
+#include <algorithm>
+#include <complex>
+
+namespace slate {
+namespace device {
+namespace batch {
+
+//------------------------------------------------------------------------------
+/// Variable-size batched general matrix norm, reduced over all tiles.
+/// @see the CUDA implementation for details of the arguments.
+///
+template <typename scalar_t>
+void genorm_vbatch(
+    NormScope scope, int64_t* dims,
+    scalar_t const* const* Aarray,
+    blas::real_type<scalar_t>* values,
+    int64_t batch_count, blas::Queue& queue )
+{
+#ifdef SLATE_HAVE_OMPTARGET
+    using real_t = blas::real_type<scalar_t>;
+
+    // quick return
+    if (batch_count == 0)
+        return;
+
+    queue.sync(); // sync queue before switching to openmp device execution
+
+    if (scope == NormScope::Matrix) {
+        int64_t blocks = std::min( batch_count, genorm_vbatch_blocks );
+        real_t* partial = &values[ 3 ];
+
+        // Each team reduces tiles k, k + blocks, ..., to partial[ 3*k ].
+        #pragma omp target is_device_ptr(dims, Aarray, partial) \
+                    device(queue.device())
+        #pragma omp teams distribute
+        for (int64_t k = 0; k < blocks; ++k) {
+            real_t max = 0, scale = 0, sumsq = 1;
+            for (int64_t b = k; b < batch_count; b += blocks) {
+                int64_t m   = dims[ b ];
+                int64_t n   = dims[ b +   batch_count ];
+                int64_t lda = dims[ b + 2*batch_count ];
+                scalar_t const* tile = Aarray[ b ];
+                for (int64_t j = 0; j < n; ++j) {
+                    for (int64_t i = 0; i < m; ++i) {
+                        real_t a = abs_val( tile[ i + j*lda ] );
+                        max = max_nan( max, a );
+                        add_sumsq( scale, sumsq, a );
+                    }
+                }
+            }
+            partial[ 3*k + 0 ] = max;
+            partial[ 3*k + 1 ] = scale;
+            partial[ 3*k + 2 ] = sumsq;
+        }
+
+        #pragma omp target is_device_ptr(values, partial) device(queue.device())
+        {
+            real_t max = 0, scale = 0, sumsq = 1;
+            for (int64_t k = 0; k < blocks; ++k) {
+                max = max_nan( max, partial[ 3*k + 0 ] );
+                combine_sumsq( scale, sumsq,
+                               partial[ 3*k + 1 ], partial[ 3*k + 2 ] );
+            }
+            values[ 0 ] = max;
+            values[ 1 ] = scale;
+            values[ 2 ] = sumsq;
+        }
+    }
+    else if (scope == NormScope::Columns) {
+        // Tiles may share columns, so tiles go in order, columns in parallel.
+        #pragma omp target is_device_ptr(dims, Aarray, values) \
+                    device(queue.device())
+        for (int64_t b = 0; b < batch_count; ++b) {
+            int64_t m      = dims[ b ];
+            int64_t n      = dims[ b +   batch_count ];
+            int64_t lda    = dims[ b + 2*batch_count ];
+            int64_t offset = dims[ b + 3*batch_count ];
+            scalar_t const* tile = Aarray[ b ];
+            #pragma omp parallel for schedule(static, 1)
+            for (int64_t j = 0; j < n; ++j) {
+                real_t max = values[ offset + j ];
+                for (int64_t i = 0; i < m; ++i)
+                    max = max_nan( max, abs_val( tile[ i + j*lda ] ) );
+                values[ offset + j ] = max;
+            }
+        }
+    }
+    else {
+        slate_not_implemented("The norm scope isn't yet supported.");
+    }
+#else
+    throw slate::Exception( "device routines not available" );
+#endif
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void genorm_vbatch(
+    NormScope scope, int64_t* dims,
+    float const* const* Aarray,
+    float* values,
+    int64_t batch_count, blas::Queue& queue );
+
+template
+void genorm_vbatch(
+    NormScope scope, int64_t* dims,
+    double const* const* Aarray,
+    double* values,
+    int64_t batch_count, blas::Queue& queue );
+
+template
+void genorm_vbatch(
+    NormScope scope, int64_t* dims,
+    std::complex<float> const* const* Aarray,
+    float* values,
+    int64_t batch_count, blas::Queue& queue );
+
+template
+void genorm_vbatch(
+    NormScope scope, int64_t* dims,
+    std::complex<double> const* const* Aarray,
+    double* values,
+    int64_t batch_count, blas::Queue& queue );
+
+} // namespace batch
+} // namespace device
+} // namespace slate
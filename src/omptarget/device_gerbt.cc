@@ -0,0 +1,303 @@
+// Copyright (c) 2020-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/Exception.hh"
+#include "slate/internal/device.hh"
+
+#include <cmath>
+
+namespace slate {
+namespace device {
+
+//------------------------------------------------------------------------------
+/// Applies depth levels of a random butterfly transform to the left of a
+/// group of 2^depth tiles in one pass, as the CUDA implementation.
+/// @see gerbt_left
+///
+template <typename scalar_t>
+void gerbt_left(
+    blas::Op trans, int64_t depth, int64_t n,
+    int64_t const* mb, scalar_t* const* Barray, int64_t const* ldb,
+    scalar_t const* const* Uarray,
+    blas::Queue& queue )
+{
+#ifdef SLATE_HAVE_OMPTARGET
+    using real_t = blas::real_type<scalar_t>;
+    const int max_group = 1 << gerbt_left_max_depth;
+
+    slate_assert( 1 <= depth && depth <= gerbt_left_max_depth );
+
+    const int group_size = 1 << depth;
+    const bool transp = trans != blas::Op::NoTrans;
+    const real_t inv_sqrt_2 = 1.0 / std::sqrt( 2.0 );
+
+    scalar_t* B[ max_group ];
+    scalar_t const* U[ max_group ];
+    int64_t mb_[ max_group ], ldb_[ max_group ];
+    int64_t mb_max = 0;
+    for (int c = 0; c < group_size; ++c) {
+        B[ c ] = Barray[ c ];
+        U[ c ] = Uarray[ c ];
+        mb_[ c ] = mb[ c ];
+        ldb_[ c ] = ldb[ c ];
+        mb_max = std::max( mb_max, mb[ c ] );
+    }
+
+    // quick return
+    if (mb_max == 0 || n == 0)
+        return;
+
+    queue.sync(); // sync queue before switching to openmp device execution
+    // Use omp target offload
+    #pragma omp target map(to: B, U, mb_, ldb_) device(queue.device())
+    #pragma omp teams distribute parallel for collapse(2) schedule(static, 1)
+    for (int64_t j = 0; j < n; ++j) {
+        for (int64_t i = 0; i < mb_max; ++i) {
+            scalar_t b[ max_group ];
+            for (int c = 0; c < group_size; ++c) {
+                if (i < mb_[ c ])
+                    b[ c ] = B[ c ][ i + j*ldb_[ c ] ];
+            }
+
+            // Regular butterflies are applied largest to smallest,
+            // transposed butterflies smallest to largest.
+            for (int level = 0; level < depth; ++level) {
+                const int h = 1 << (transp ? level : depth-1 - level);
+                for (int c = 0; c < group_size; ++c) {
+                    if ((c & h) != 0 || i >= mb_[ c ])
+                        continue;
+
+                    const int c2 = c | h;
+                    const scalar_t u1 = U[ c ][ i ];
+                    if (i < mb_[ c2 ]) {
+                        const scalar_t u2 = U[ c2 ][ i ];
+                        const scalar_t b1 = b[ c  ];
+                        const scalar_t b2 = b[ c2 ];
+                        if (transp) {
+                            b[ c  ] = inv_sqrt_2*u1*(b1 + b2);
+                            b[ c2 ] = inv_sqrt_2*u2*(b1 - b2);
+                        }
+                        else {
+                            b[ c  ] = inv_sqrt_2*(u1*b1 + u2*b2);
+                            b[ c2 ] = inv_sqrt_2*(u1*b1 - u2*b2);
+                        }
+                    }
+                    else {
+                        b[ c ] = u1*b[ c ];
+                    }
+                }
+            }
+
+            for (int c = 0; c < group_size; ++c) {
+                if (i < mb_[ c ])
+                    B[ c ][ i + j*ldb_[ c ] ] = b[ c ];
+            }
+        }
+    }
+#else
+    throw slate::Exception( "device routines not available" );
+#endif
+}
+
+//------------------------------------------------------------------------------
+/// Applies depth levels of a random butterfly transform to both sides of
+/// a group of 2^depth-by-2^depth tiles in one pass, as the CUDA
+/// implementation.
+/// @see gerbt
+///
+template <typename scalar_t>
+void gerbt(
+    int64_t depth,
+    int64_t const* mb, int64_t const* nb,
+    scalar_t* const* Aarray, int64_t const* lda,
+    scalar_t const* const* Uarray, scalar_t const* const* Varray,
+    blas::Queue& queue )
+{
+#ifdef SLATE_HAVE_OMPTARGET
+    using real_t = blas::real_type<scalar_t>;
+    const int max_group = 1 << gerbt_max_depth;
+
+    slate_assert( 1 <= depth && depth <= gerbt_max_depth );
+
+    const int group_size = 1 << depth;
+    const real_t inv_sqrt_2 = 1.0 / std::sqrt( 2.0 );
+    const real_t inv_2 = 0.5;
+
+    scalar_t* A[ max_group*max_group ];
+    int64_t lda_[ max_group*max_group ];
+    scalar_t const* U[ max_group ];
+    scalar_t const* V[ max_group ];
+    int64_t mb_[ max_group ], nb_[ max_group ];
+    int64_t mb_max = 0, nb_max = 0;
+    for (int c = 0; c < group_size; ++c) {
+        U[ c ] = Uarray[ c ];
+        V[ c ] = Varray[ c ];
+        mb_[ c ] = mb[ c ];
+        nb_[ c ] = nb[ c ];
+        mb_max = std::max( mb_max, mb[ c ] );
+        nb_max = std::max( nb_max, nb[ c ] );
+    }
+    for (int c = 0; c < group_size*group_size; ++c) {
+        A[ c ] = Aarray[ c ];
+        lda_[ c ] = lda[ c ];
+    }
+
+    // quick return
+    if (mb_max == 0 || nb_max == 0)
+        return;
+
+    queue.sync(); // sync queue before switching to openmp device execution
+    // Use omp target offload
+    #pragma omp target map(to: A, lda_, U, V, mb_, nb_) device(queue.device())
+    #pragma omp teams distribute parallel for collapse(2) schedule(static, 1)
+    for (int64_t j = 0; j < nb_max; ++j) {
+        for (int64_t i = 0; i < mb_max; ++i) {
+            scalar_t a[ max_group*max_group ];
+            for (int ci = 0; ci < group_size; ++ci) {
+                for (int cj = 0; cj < group_size; ++cj) {
+                    const int c = ci*group_size + cj;
+                    if (i < mb_[ ci ] && j < nb_[ cj ])
+                        a[ c ] = A[ c ][ i + j*lda_[ c ] ];
+                }
+            }
+
+            // Two-sided butterflies are applied smallest to largest.
+            for (int level = 0; level < depth; ++level) {
+                const int h = 1 << level;
+                for (int ci = 0; ci < group_size; ++ci) {
+                    if ((ci & h) != 0 || i >= mb_[ ci ])
+                        continue;
+
+                    const int ci2 = ci | h;
+                    const bool row2 = i < mb_[ ci2 ];
+                    const scalar_t u1 = U[ ci ][ i ];
+                    const scalar_t u2 = row2 ? U[ ci2 ][ i ] : u1;
+
+                    for (int cj = 0; cj < group_size; ++cj) {
+                        if ((cj & h) != 0 || j >= nb_[ cj ])
+                            continue;
+
+                        const int cj2 = cj | h;
+                        const bool col2 = j < nb_[ cj2 ];
+                        const scalar_t v1 = V[ cj ][ j ];
+                        const scalar_t v2 = col2 ? V[ cj2 ][ j ] : v1;
+
+                        scalar_t& a11 = a[ ci *group_size + cj  ];
+                        scalar_t& a12 = a[ ci *group_size + cj2 ];
+                        scalar_t& a21 = a[ ci2*group_size + cj  ];
+                        scalar_t& a22 = a[ ci2*group_size + cj2 ];
+
+                        if (row2 && col2) {
+                            const scalar_t sum1 = a11 + a12;
+                            const scalar_t sum2 = a21 + a22;
+                            const scalar_t dif1 = a11 - a12;
+                            const scalar_t dif2 = a21 - a22;
+
+                            a11 = inv_2*u1*(sum1 + sum2)*v1;
+                            a12 = inv_2*u1*(dif1 + dif2)*v2;
+                            a21 = inv_2*u2*(sum1 - sum2)*v1;
+                            a22 = inv_2*u2*(dif1 - dif2)*v2;
+                        }
+                        else if (col2) {
+                            const scalar_t b11 = a11;
+                            const scalar_t b12 = a12;
+
+                            a11 = inv_sqrt_2*u1*(b11 + b12)*v1;
+                            a12 = inv_sqrt_2*u1*(b11 - b12)*v2;
+                        }
+                        else if (row2) {
+                            const scalar_t b11 = a11;
+                            const scalar_t b21 = a21;
+
+                            a11 = inv_sqrt_2*u1*(b11 + b21)*v1;
+                            a21 = inv_sqrt_2*u2*(b11 - b21)*v1;
+                        }
+                        else {
+                            a11 = u1*a11*v1;
+                        }
+                    }
+                }
+            }
+
+            for (int ci = 0; ci < group_size; ++ci) {
+                for (int cj = 0; cj < group_size; ++cj) {
+                    const int c = ci*group_size + cj;
+                    if (i < mb_[ ci ] && j < nb_[ cj ])
+                        A[ c ][ i + j*lda_[ c ] ] = a[ c ];
+                }
+            }
+        }
+    }
+#else
+    throw slate::Exception( "device routines not available" );
+#endif
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void gerbt_left(
+    blas::Op trans, int64_t depth, int64_t n,
+    int64_t const* mb, float* const* Barray, int64_t const* ldb,
+    float const* const* Uarray,
+    blas::Queue& queue );
+
+template
+void gerbt_left(
+    blas::Op trans, int64_t depth, int64_t n,
+    int64_t const* mb, double* const* Barray, int64_t const* ldb,
+    double const* const* Uarray,
+    blas::Queue& queue );
+
+template
+void gerbt_left(
+    blas::Op trans, int64_t depth, int64_t n,
+    int64_t const* mb, std::complex<float>* const* Barray, int64_t const* ldb,
+    std::complex<float> const* const* Uarray,
+    blas::Queue& queue );
+
+template
+void gerbt_left(
+    blas::Op trans, int64_t depth, int64_t n,
+    int64_t const* mb, std::complex<double>* const* Barray, int64_t const* ldb,
+    std::complex<double> const* const* Uarray,
+    blas::Queue& queue );
+
+template
+void gerbt(
+    int64_t depth,
+    int64_t const* mb, int64_t const* nb,
+    float* const* Aarray, int64_t const* lda,
+    float const* const* Uarray, float const* const* Varray,
+    blas::Queue& queue );
+
+template
+void gerbt(
+    int64_t depth,
+    int64_t const* mb, int64_t const* nb,
+    double* const* Aarray, int64_t const* lda,
+    double const* const* Uarray, double const* const* Varray,
+    blas::Queue& queue );
+
+template
+void gerbt(
+    int64_t depth,
+    int64_t const* mb, int64_t const* nb,
+    std::complex<float>* const* Aarray, int64_t const* lda,
+    std::complex<float> const* const* Uarray,
+    std::complex<float> const* const* Varray,
+    blas::Queue& queue );
+
+template
+void gerbt(
+    int64_t depth,
+    int64_t const* mb, int64_t const* nb,
+    std::complex<double>* const* Aarray, int64_t const* lda,
+    std::complex<double> const* const* Uarray,
+    std::complex<double> const* const* Varray,
+    blas::Queue& queue );
+
+} // namespace device
+} // namespace slate
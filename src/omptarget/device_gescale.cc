@@ -54,15 +54,11 @@ void gescale(
 
     scalar_t2 mul = numer / denom;
 
-    queue.sync(); // sync queue before switching to openmp device execution
-    // Use omp target offload
-    #pragma omp target is_device_ptr(A) device(queue.device())
-    #pragma omp teams distribute parallel for schedule(static, 1)
-    for (int64_t i = 0; i < m; ++i) {
-        scalar_t* rowA = &A[ i ];
-        for (int64_t j = 0; j < n; ++j)
-            rowA[ j*lda ] = rowA[ j*lda ] * mul;
-    }
+    for_each_element(
+        m, n, 1, queue,
+        [=]( int64_t, int64_t i, int64_t j ) {
+            A[ i + j*lda ] = A[ i + j*lda ] * mul;
+        } );
 #else
     throw slate::Exception( "device routines not available" );
 #endif
@@ -165,20 +161,12 @@ void gescale(
 
     scalar_t2 mul = numer / denom;
 
-    queue.sync(); // sync queue before switching to openmp device execution
-    // Use omp target offload
-    #pragma omp target is_device_ptr(Aarray) device(queue.device())
-    #pragma omp teams distribute
-    for (int64_t k = 0; k < batch_count; ++k) {
-        scalar_t* A = Aarray[k];
-        // distribute rows (i) to threads
-        #pragma omp parallel for schedule(static, 1)
-        for (int64_t i = 0; i < m; ++i) {
-            scalar_t* rowA = &A[ i ];
-            for (int64_t j = 0; j < n; ++j)
-                rowA[ j*lda ] = rowA[ j*lda ] * mul;
-        }
-    }
+    for_each_element(
+        m, n, batch_count, queue,
+        [=]( int64_t k, int64_t i, int64_t j ) {
+            scalar_t* A = Aarray[ k ];
+            A[ i + j*lda ] = A[ i + j*lda ] * mul;
+        } );
 #else
     throw slate::Exception( "device routines not available" );
 #endif
@@ -6,6 +6,8 @@
 #include "slate/Exception.hh"
 #include "slate/internal/device.hh"
 
+#include "device_util.hh"
+
 #include <cstdio>
 
 namespace slate {
@@ -48,16 +50,11 @@ void geset(
     if (m == 0 || n == 0)
         return;
 
-    queue.sync(); // sync queue before switching to openmp device execution
-    // Use omp target offload
-    #pragma omp target is_device_ptr(A) device(queue.device())
-    #pragma omp teams distribute parallel for schedule(static, 1)
-    for (int64_t i = 0; i < m; ++i) {
-        scalar_t* rowA = &A[i];
-        for (int64_t j = 0; j < n; ++j) {
-            rowA[j*lda] = (j != i) ? offdiag_value : diag_value;
-        }
-    }
+    for_each_element(
+        m, n, 1, queue,
+        [=]( int64_t, int64_t i, int64_t j ) {
+            A[ i + j*lda ] = (j != i) ? offdiag_value : diag_value;
+        } );
 #else
     throw slate::Exception( "device routines not available" );
 #endif
@@ -140,21 +137,11 @@ void geset(
     if (m == 0 || n == 0)
         return;
 
-    queue.sync(); // sync queue before switching to openmp device execution
-    // Use omp target offload
-    #pragma omp target is_device_ptr(Aarray) device(queue.device())
-    #pragma omp teams distribute
-    for (int64_t k = 0; k < batch_count; ++k) {
-        scalar_t* tileA = Aarray[k];
-        // distribute i to threads
-        #pragma omp parallel for schedule(static, 1)
-        for (int64_t i = 0; i < m; ++i) {
-            scalar_t* rowA = &tileA[i];
-            for (int64_t j = 0; j < n; ++j) {
-                rowA[j*lda] = (j == i ? diag_value : offdiag_value);
-            }
-        }
-    }
+    for_each_element(
+        m, n, batch_count, queue,
+        [=]( int64_t k, int64_t i, int64_t j ) {
+            Aarray[ k ][ i + j*lda ] = (j == i ? diag_value : offdiag_value);
+        } );
 #else
     throw slate::Exception( "device routines not available" );
 #endif
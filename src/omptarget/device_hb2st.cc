@@ -0,0 +1,265 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/Exception.hh"
+#include "slate/internal/device.hh"
+
+#include <cstdio>
+#include <cmath>
+#include <complex>
+
+#include "device_util.hh"
+
+namespace slate {
+namespace device {
+
+#ifdef SLATE_HAVE_OMPTARGET
+
+//------------------------------------------------------------------------------
+/// Generates a Householder reflector $H = I - \tau v v^H$ such that
+/// $H^H x = \beta e_1$, as in LAPACK larfg, but without rescaling tiny beta.
+/// Stores tau in v[0] and the rest of the reflector in v[1:m-1],
+/// and overwrites x with beta e_1.
+///
+#pragma omp declare target
+template <typename scalar_t>
+void hb2st_larfg( int64_t m, scalar_t* x, scalar_t* v )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    real_t xnorm = 0;
+    for (int64_t e = 1; e < m; ++e) {
+        real_t a = abs_val( x[ e ] );
+        xnorm += a*a;
+    }
+    xnorm = sqrt( xnorm );
+
+    scalar_t alpha = x[ 0 ];
+    scalar_t tau = 0, beta = alpha, scale = 0;
+    if (xnorm != 0 || std::imag( alpha ) != 0) {
+        real_t a = abs_val( alpha );
+        real_t norm = sqrt( a*a + xnorm*xnorm );
+        beta  = std::real( alpha ) >= 0 ? -norm : norm;
+        tau   = (beta - alpha) / std::real( beta );
+        scale = real_t( 1 ) / (alpha - beta);
+    }
+    v[ 0 ] = tau;
+    x[ 0 ] = beta;
+    for (int64_t e = 1; e < m; ++e) {
+        v[ e ] = x[ e ] * scale;
+        x[ e ] = 0;
+    }
+}
+#pragma omp end declare target
+
+//------------------------------------------------------------------------------
+/// Applies a Householder reflector to the lower triangle of a Hermitian
+/// matrix from both sides, as in internal::herf:
+/// $A = H A H^H$ with $H = I - \tau v v^H$, where tau = conj( v[0] ).
+/// Uses m entries of work.
+///
+#pragma omp declare target
+template <typename scalar_t>
+void hb2st_herf(
+    int64_t m, scalar_t const* v,
+    scalar_t* A, int64_t lda, scalar_t* w )
+{
+    using blas::conj;
+    using real_t = blas::real_type<scalar_t>;
+
+    const scalar_t one = 1;
+    scalar_t tau = conj( v[ 0 ] );
+
+    // w = A v, using only the lower triangle of A; v[0] is 1.
+    scalar_t dot = 0;
+    for (int64_t i = 0; i < m; ++i) {
+        scalar_t wi = std::real( A[ i + i*lda ] ) * (i == 0 ? one : v[ i ]);
+        for (int64_t j = 0; j < i; ++j)
+            wi += A[ i + j*lda ] * (j == 0 ? one : v[ j ]);
+        for (int64_t j = i+1; j < m; ++j)
+            wi += conj( A[ j + i*lda ] ) * v[ j ];
+        w[ i ] = wi;
+        dot += conj( wi ) * (i == 0 ? one : v[ i ]);
+    }
+
+    // w = A v - 0.5 tau (w^H v) v
+    scalar_t alpha = real_t( -0.5 ) * tau * dot;
+    for (int64_t i = 0; i < m; ++i)
+        w[ i ] += alpha * (i == 0 ? one : v[ i ]);
+
+    // A = A - tau v w^H - conj(tau) w v^H, lower triangle, real diagonal.
+    for (int64_t i = 0; i < m; ++i) {
+        scalar_t vi = i == 0 ? one : v[ i ];
+        for (int64_t j = 0; j <= i; ++j) {
+            scalar_t vj = j == 0 ? one : v[ j ];
+            scalar_t aij = A[ i + j*lda ]
+                         - tau * vi * conj( w[ j ] )
+                         - conj( tau ) * w[ i ] * conj( vj );
+            A[ i + j*lda ] = i == j ? scalar_t( std::real( aij ) ) : aij;
+        }
+    }
+}
+#pragma omp end declare target
+
+//------------------------------------------------------------------------------
+/// Does step of sweep in tridiagonal bulge chasing, the same task as
+/// impl::hb2st_step on the host.
+/// @see hb2st_wave
+///
+#pragma omp declare target
+template <typename scalar_t>
+void hb2st_task(
+    int64_t n, int64_t band, int64_t sweep, int64_t step,
+    scalar_t* A, int64_t lda,
+    scalar_t* V, int64_t ldv, int64_t vgroup_stride, int64_t vgroups,
+    scalar_t* work )
+{
+    using blas::conj;
+
+    // Steps 0, 1, ... map to task types 0, 1, 2, 1, 2, ...
+    int64_t task  = step == 0 ? 0 : (step + 1) % 2 + 1;
+    int64_t block = step/2;
+
+    // Vectors of this sweep: column sweep % band of consecutive
+    // 2*band-by-band tiles of the group of sweeps.
+    int64_t vj = sweep % band;
+    int64_t vi = vj + 1;
+    scalar_t* Vs = &V[ ((sweep / band) % vgroups) * vgroup_stride
+                       + vi + vj*ldv ];
+    int64_t vtile = band*ldv;
+
+    if (task == 0) {
+        int64_t i  = sweep;
+        int64_t m1 = std::min( i + band, n - 1 ) - i;
+        hb2st_larfg( m1, &A[ (i+1) + i*lda ], Vs );
+        hb2st_herf( m1, Vs, &A[ (i+1) + (i+1)*lda ], lda, work );
+    }
+    else if (task == 1) {
+        int64_t i = (block+1)*band + 1 + sweep;
+        int64_t j =  block   *band + 1 + sweep;
+        if (i < n) {
+            int64_t m2 = std::min( i + band - 1, n - 1 ) - i + 1;
+            scalar_t const* v1 = &Vs[ ((step-1)/2) * vtile ];
+            scalar_t*       v2 = &Vs[ ((step+1)/2) * vtile ];
+            scalar_t* B = &A[ i + j*lda ];
+
+            // Apply reflector from the previous task from the right,
+            // B = B - conj( tau1 ) (B v1) v1^H.
+            scalar_t tau1 = conj( v1[ 0 ] );
+            for (int64_t r = 0; r < m2; ++r) {
+                scalar_t wr = B[ r ];
+                for (int64_t c = 1; c < band; ++c)
+                    wr += B[ r + c*lda ] * v1[ c ];
+                wr = conj( tau1 ) * wr;
+                B[ r ] -= wr;
+                for (int64_t c = 1; c < band; ++c)
+                    B[ r + c*lda ] -= wr * conj( v1[ c ] );
+            }
+
+            // Bring column 0 back to the band, then apply the reflector
+            // from the left to the other columns,
+            // B = B - tau2 v2 (v2^H B).
+            hb2st_larfg( m2, B, v2 );
+            scalar_t tau2 = conj( v2[ 0 ] );
+            for (int64_t c = 1; c < band; ++c) {
+                scalar_t* Bc = &B[ c*lda ];
+                scalar_t yc = Bc[ 0 ];
+                for (int64_t r = 1; r < m2; ++r)
+                    yc += conj( v2[ r ] ) * Bc[ r ];
+                yc = tau2 * yc;
+                Bc[ 0 ] -= yc;
+                for (int64_t r = 1; r < m2; ++r)
+                    Bc[ r ] -= v2[ r ] * yc;
+            }
+        }
+    }
+    else {
+        int64_t i = block*band + 1 + sweep;
+        if (i < n) {
+            int64_t m1 = std::min( i + band - 1, n - 1 ) - i + 1;
+            hb2st_herf( m1, &Vs[ (step/2) * vtile ],
+                        &A[ i + i*lda ], lda, work );
+        }
+    }
+}
+#pragma omp end declare target
+
+#endif // SLATE_HAVE_OMPTARGET
+
+//------------------------------------------------------------------------------
+/// One wavefront of tridiagonal bulge chasing of a Hermitian band matrix.
+/// Step t of sweep s depends on step t-1 of sweep s and step t+2 of
+/// sweep s-1, so all steps with 3*s + t = wave are independent and run
+/// concurrently, one sweep per team.
+/// @see the CUDA implementation for details of the arguments.
+///
+template <typename scalar_t>
+void hb2st_wave(
+    int64_t n, int64_t band,
+    int64_t wave, int64_t sweep_begin, int64_t sweep_count,
+    scalar_t* A, int64_t lda,
+    scalar_t* V, int64_t ldv, int64_t vgroup_stride, int64_t vgroups,
+    scalar_t* work,
+    blas::Queue& queue )
+{
+#ifdef SLATE_HAVE_OMPTARGET
+    // quick return
+    if (sweep_count == 0)
+        return;
+
+    queue.sync(); // sync queue before switching to openmp device execution
+    // Use omp target offload
+    #pragma omp target is_device_ptr(A, V, work) device(queue.device())
+    #pragma omp teams distribute
+    for (int64_t k = 0; k < sweep_count; ++k) {
+        int64_t sweep = sweep_begin + k;
+        hb2st_task( n, band, sweep, wave - 3*sweep, A, lda,
+                    V, ldv, vgroup_stride, vgroups, &work[ k*band ] );
+    }
+#else
+    throw slate::Exception( "device routines not available" );
+#endif
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void hb2st_wave(
+    int64_t n, int64_t band,
+    int64_t wave, int64_t sweep_begin, int64_t sweep_count,
+    float* A, int64_t lda,
+    float* V, int64_t ldv, int64_t vgroup_stride, int64_t vgroups,
+    float* work,
+    blas::Queue& queue );
+
+template
+void hb2st_wave(
+    int64_t n, int64_t band,
+    int64_t wave, int64_t sweep_begin, int64_t sweep_count,
+    double* A, int64_t lda,
+    double* V, int64_t ldv, int64_t vgroup_stride, int64_t vgroups,
+    double* work,
+    blas::Queue& queue );
+
+template
+void hb2st_wave(
+    int64_t n, int64_t band,
+    int64_t wave, int64_t sweep_begin, int64_t sweep_count,
+    std::complex<float>* A, int64_t lda,
+    std::complex<float>* V, int64_t ldv, int64_t vgroup_stride, int64_t vgroups,
+    std::complex<float>* work,
+    blas::Queue& queue );
+
+template
+void hb2st_wave(
+    int64_t n, int64_t band,
+    int64_t wave, int64_t sweep_begin, int64_t sweep_count,
+    std::complex<double>* A, int64_t lda,
+    std::complex<double>* V, int64_t ldv, int64_t vgroup_stride, int64_t vgroups,
+    std::complex<double>* work,
+    blas::Queue& queue );
+
+} // namespace device
+} // namespace slate
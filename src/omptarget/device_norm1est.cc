@@ -0,0 +1,238 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/Exception.hh"
+#include "slate/internal/device.hh"
+
+#include "device_util.hh"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <complex>
+
+namespace slate {
+namespace device {
+
+//------------------------------------------------------------------------------
+/// Replaces each entry of the vector x by its sign, for norm1est.
+/// For real x, x_i = 1 if x_i >= 0, otherwise -1, and counts the entries
+/// whose sign differs from the previous signs s, then sets s = x.
+/// For complex x, x_i = x_i / |x_i|, or 1 if x_i is zero, and s is not
+/// used.
+///
+/// @param[in] m
+///     Number of entries of x. m >= 0.
+///
+/// @param[in,out] x
+///     Vector of dimension m in GPU memory.
+///
+/// @param[in,out] s
+///     Vector of dimension m in GPU memory.
+///     On entry, the previous signs; on exit, the signs of x.
+///
+/// @param[out] nchanged
+///     In GPU memory. On exit, the number of signs that changed.
+///     0 for complex x.
+///
+/// @param[in] queue
+///     BLAS++ queue to execute in.
+///
+template <typename scalar_t>
+void norm1est_sign(
+    int64_t m, scalar_t* x, scalar_t* s, int64_t* nchanged,
+    blas::Queue& queue)
+{
+#ifdef SLATE_HAVE_OMPTARGET
+    using real_t = blas::real_type<scalar_t>;
+    real_t safmin = std::numeric_limits<real_t>::min();
+
+    queue.sync(); // sync queue before switching to openmp device execution
+    #pragma omp target is_device_ptr(x, s, nchanged) device(queue.device())
+    {
+        int64_t count = 0;
+        #pragma omp parallel for reduction(+:count)
+        for (int64_t i = 0; i < m; ++i) {
+            if constexpr (blas::is_complex<scalar_t>::value) {
+                real_t absx = abs_val( x[ i ] );
+                x[ i ] = absx > safmin ? x[ i ] / absx : scalar_t( 1 );
+            }
+            else {
+                scalar_t sign = x[ i ] >= 0 ? 1 : -1;
+                if (sign != s[ i ])
+                    ++count;
+                x[ i ] = sign;
+                s[ i ] = sign;
+            }
+        }
+        *nchanged = count;
+    }
+#else
+    throw slate::Exception( "device routines not available" );
+#endif
+}
+
+//------------------------------------------------------------------------------
+/// Finds the entry of the vector x of largest absolute value, for
+/// norm1est. Entries that are NaN are ignored.
+///
+/// @param[in] m
+///     Number of entries of x. m >= 0.
+///
+/// @param[in] x
+///     Vector of dimension m in GPU memory.
+///
+/// @param[out] amax
+///     In GPU memory. On exit, max_i |x_i|, or 0 if m = 0.
+///
+/// @param[out] index
+///     In GPU memory. On exit, the first index i with |x_i| = amax,
+///     or 0 if x is zero.
+///
+/// @param[in] queue
+///     BLAS++ queue to execute in.
+///
+template <typename scalar_t>
+void norm1est_amax(
+    int64_t m, scalar_t const* x,
+    blas::real_type<scalar_t>* amax, int64_t* index,
+    blas::Queue& queue)
+{
+#ifdef SLATE_HAVE_OMPTARGET
+    using real_t = blas::real_type<scalar_t>;
+
+    queue.sync(); // sync queue before switching to openmp device execution
+    // Sequential on the device, as the index of the first maximum does not
+    // map to an OpenMP reduction; the vector is one tile.
+    #pragma omp target is_device_ptr(x, amax, index) device(queue.device())
+    {
+        real_t max = 0;
+        int64_t imax = 0;
+        for (int64_t i = 0; i < m; ++i) {
+            real_t absx = abs_val( x[ i ] );
+            if (absx > max) {
+                max = absx;
+                imax = i;
+            }
+        }
+        *amax  = max;
+        *index = imax;
+    }
+#else
+    throw slate::Exception( "device routines not available" );
+#endif
+}
+
+//------------------------------------------------------------------------------
+/// Sets the vector x to the alternating sign vector of norm1est,
+///     x_i = (-1)^(k (k+1) / 2) (1 + (k - 1) / (n - 1)),
+/// where k = ioffset + i is the global index of entry i.
+///
+/// @param[in] m
+///     Number of entries of x. m >= 0.
+///
+/// @param[in] ioffset
+///     Global index of x_0.
+///
+/// @param[in] n
+///     Global length of the vector. n >= 2.
+///
+/// @param[out] x
+///     Vector of dimension m in GPU memory.
+///
+/// @param[in] queue
+///     BLAS++ queue to execute in.
+///
+template <typename scalar_t>
+void norm1est_altsgn(
+    int64_t m, int64_t ioffset, int64_t n, scalar_t* x,
+    blas::Queue& queue)
+{
+#ifdef SLATE_HAVE_OMPTARGET
+    using real_t = blas::real_type<scalar_t>;
+
+    for_each_element(
+        m, 1, 1, queue,
+        [=]( int64_t, int64_t i, int64_t ) {
+            int64_t k = ioffset + i;
+            // Sign is (-1)^(k (k+1) / 2), which is + for k mod 4 = 0 or 3.
+            real_t sign = (k % 4 == 0 || k % 4 == 3) ? 1 : -1;
+            x[ i ] = sign * (1 + real_t( k - 1 ) / real_t( n - 1 ));
+        } );
+#else
+    throw slate::Exception( "device routines not available" );
+#endif
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void norm1est_sign(
+    int64_t m, float* x, float* s, int64_t* nchanged,
+    blas::Queue& queue);
+
+template
+void norm1est_sign(
+    int64_t m, double* x, double* s, int64_t* nchanged,
+    blas::Queue& queue);
+
+template
+void norm1est_sign(
+    int64_t m, std::complex<float>* x, std::complex<float>* s,
+    int64_t* nchanged,
+    blas::Queue& queue);
+
+template
+void norm1est_sign(
+    int64_t m, std::complex<double>* x, std::complex<double>* s,
+    int64_t* nchanged,
+    blas::Queue& queue);
+
+template
+void norm1est_amax(
+    int64_t m, float const* x,
+    float* amax, int64_t* index,
+    blas::Queue& queue);
+
+template
+void norm1est_amax(
+    int64_t m, double const* x,
+    double* amax, int64_t* index,
+    blas::Queue& queue);
+
+template
+void norm1est_amax(
+    int64_t m, std::complex<float> const* x,
+    float* amax, int64_t* index,
+    blas::Queue& queue);
+
+template
+void norm1est_amax(
+    int64_t m, std::complex<double> const* x,
+    double* amax, int64_t* index,
+    blas::Queue& queue);
+
+template
+void norm1est_altsgn(
+    int64_t m, int64_t ioffset, int64_t n, float* x,
+    blas::Queue& queue);
+
+template
+void norm1est_altsgn(
+    int64_t m, int64_t ioffset, int64_t n, double* x,
+    blas::Queue& queue);
+
+template
+void norm1est_altsgn(
+    int64_t m, int64_t ioffset, int64_t n, std::complex<float>* x,
+    blas::Queue& queue);
+
+template
+void norm1est_altsgn(
+    int64_t m, int64_t ioffset, int64_t n, std::complex<double>* x,
+    blas::Queue& queue);
+
+} // namespace device
+} // namespace slate
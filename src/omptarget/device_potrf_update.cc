@@ -0,0 +1,156 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/Exception.hh"
+#include "slate/internal/device.hh"
+
+#include "device_util.hh"
+
+#include <cstdio>
+#include <complex>
+
+namespace slate {
+namespace device {
+
+namespace batch {
+
+//------------------------------------------------------------------------------
+/// Batched application of the rotations of a Cholesky rank-k update
+/// (sign = 1) or downdate (sign = -1) of a diagonal tile to tiles below it,
+///     [ L_b, V_b ] = [ L_b, V_b ] Q,
+/// as tile::potrf_update_apply for each b = 0, ..., batch_count-1.
+/// Rows are independent, so each row of a tile applies all the rotations
+/// in order.
+///
+/// @param[in] op
+///     NoTrans if Aarray holds the tiles L_b,
+///     ConjTrans if it holds L_b^H, e.g., for upper A.
+///
+/// @param[in] sign
+///     1 for an update, -1 for a downdate.
+///
+/// @param[in] m
+///     Number of rows of each L_b and V_b. m >= 0.
+///
+/// @param[in] n
+///     Number of columns of each L_b. n >= 0.
+///
+/// @param[in] k
+///     Number of columns of each V_b. k >= 0.
+///
+/// @param[in] R
+///     The n-by-2k rotations from tile::potrf_update, stored in an
+///     ldr-by-2k array in GPU memory.
+///
+/// @param[in] ldr
+///     Leading dimension of R. ldr >= n.
+///
+/// @param[in,out] Aarray
+///     Array in GPU memory of dimension batch_count, containing pointers
+///     to the column-major tiles L_b, or L_b^H, in GPU memory.
+///
+/// @param[in] lda
+///     Leading dimension of each tile in Aarray.
+///
+/// @param[in,out] Varray
+///     Array in GPU memory of dimension batch_count, containing pointers
+///     to the m-by-k column-major tiles V_b in GPU memory.
+///
+/// @param[in] ldv
+///     Leading dimension of each tile in Varray. ldv >= m.
+///
+/// @param[in] batch_count
+///     Size of Aarray and Varray. batch_count >= 0.
+///
+/// @param[in] queue
+///     BLAS++ queue to execute in.
+///
+template <typename scalar_t>
+void potrf_update_apply(
+    blas::Op op, int sign, int64_t m, int64_t n, int64_t k,
+    scalar_t const* R, int64_t ldr,
+    scalar_t** Aarray, int64_t lda,
+    scalar_t** Varray, int64_t ldv,
+    int64_t batch_count, blas::Queue& queue )
+{
+#ifdef SLATE_HAVE_OMPTARGET
+    using blas::conj;
+    using real_t = blas::real_type<scalar_t>;
+
+    // quick return
+    if (m == 0 || n == 0 || k == 0 || batch_count == 0)
+        return;
+
+    bool conj_trans = op != blas::Op::NoTrans;
+
+    for_each_element(
+        m, 1, batch_count, queue,
+        [=]( int64_t b, int64_t i, int64_t ) {
+            scalar_t* A = Aarray[ b ];
+            scalar_t* V = Varray[ b ];
+            for (int64_t j = 0; j < n; ++j) {
+                scalar_t* aij = conj_trans ? &A[ j + i*lda ] : &A[ i + j*lda ];
+                scalar_t a = conj_trans ? conj( *aij ) : *aij;
+                for (int64_t l = 0; l < k; ++l) {
+                    real_t c = std::real( R[ j + l*ldr ] );
+                    scalar_t s = R[ j + (k + l)*ldr ];
+                    scalar_t& v = V[ i + l*ldv ];
+                    if (sign > 0) {
+                        scalar_t a_new = a*c + conj( s )*v;
+                        v = v*c - s*a;
+                        a = a_new;
+                    }
+                    else {
+                        // Mixed form of the hyperbolic rotation.
+                        a = a*c - conj( s )*v;
+                        v = (v - s*a) / c;
+                    }
+                }
+                *aij = conj_trans ? conj( a ) : a;
+            }
+        } );
+#else
+    throw slate::Exception( "device routines not available" );
+#endif
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void potrf_update_apply(
+    blas::Op op, int sign, int64_t m, int64_t n, int64_t k,
+    float const* R, int64_t ldr,
+    float** Aarray, int64_t lda,
+    float** Varray, int64_t ldv,
+    int64_t batch_count, blas::Queue& queue );
+
+template
+void potrf_update_apply(
+    blas::Op op, int sign, int64_t m, int64_t n, int64_t k,
+    double const* R, int64_t ldr,
+    double** Aarray, int64_t lda,
+    double** Varray, int64_t ldv,
+    int64_t batch_count, blas::Queue& queue );
+
+template
+void potrf_update_apply(
+    blas::Op op, int sign, int64_t m, int64_t n, int64_t k,
+    std::complex<float> const* R, int64_t ldr,
+    std::complex<float>** Aarray, int64_t lda,
+    std::complex<float>** Varray, int64_t ldv,
+    int64_t batch_count, blas::Queue& queue );
+
+template
+void potrf_update_apply(
+    blas::Op op, int sign, int64_t m, int64_t n, int64_t k,
+    std::complex<double> const* R, int64_t ldr,
+    std::complex<double>** Aarray, int64_t lda,
+    std::complex<double>** Varray, int64_t ldv,
+    int64_t batch_count, blas::Queue& queue );
+
+} // namespace batch
+
+} // namespace device
+} // namespace slate
@@ -0,0 +1,249 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/Exception.hh"
+#include "slate/internal/device.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "device_util.hh"
+
+namespace slate {
+namespace device {
+
+#ifdef SLATE_HAVE_OMPTARGET
+
+//------------------------------------------------------------------------------
+/// Finds root j of the secular equation, as in the CUDA implementation.
+/// @see stedc_secular_roots
+///
+#pragma omp declare target
+template <typename real_t>
+void stedc_secular_root(
+    int64_t n, int64_t j,
+    real_t const* D, real_t const* z, real_t rho, real_t eps,
+    real_t* lambda, real_t* delta )
+{
+    const int max_iters = 200;
+    real_t rho_inv = 1 / rho;
+
+    // Choose the pole nearer the root, bracketing tau in [lo, hi].
+    int64_t origin = j;
+    real_t lo = 0, hi = rho;
+    if (j < n-1) {
+        real_t half = (D[ j+1 ] - D[ j ]) / 2;
+        real_t f = rho_inv;
+        for (int64_t i = 0; i < n; ++i)
+            f += z[ i ] * z[ i ] / ((D[ i ] - D[ j ]) - half);
+        if (f >= 0) {
+            hi = half;
+        }
+        else {
+            origin = j+1;
+            lo = -half;
+            hi = 0;
+        }
+    }
+    real_t d0 = D[ origin ];
+
+    real_t tau = (lo + hi) / 2;
+    for (int iter = 0; iter < max_iters; ++iter) {
+        // f and f' at tau; f is increasing on the bracket.
+        real_t f = rho_inv, df = 0;
+        for (int64_t i = 0; i < n; ++i) {
+            real_t t = z[ i ] / ((D[ i ] - d0) - tau);
+            f  += z[ i ] * t;
+            df += t * t;
+        }
+        if (f == 0)
+            break;
+        if (f > 0)
+            hi = tau;
+        else
+            lo = tau;
+
+        real_t next = tau - f / df;
+        if (! (lo < next && next < hi))
+            next = (lo + hi) / 2;
+        bool done = abs_val( next - tau ) <= eps * abs_val( next );
+        tau = next;
+        if (done)
+            break;
+    }
+
+    *lambda = d0 + tau;
+    for (int64_t i = 0; i < n; ++i)
+        delta[ i ] = (D[ i ] - d0) - tau;
+}
+#pragma omp end declare target
+
+#endif // SLATE_HAVE_OMPTARGET
+
+//------------------------------------------------------------------------------
+/// Solves a batch of roots of the secular equation.
+/// @see the CUDA implementation for details of the arguments.
+///
+template <typename real_t>
+void stedc_secular_roots(
+    int64_t n, int64_t nroots, int64_t const* roots,
+    real_t const* D, real_t const* z, real_t rho,
+    real_t* Lambda, real_t* Delta, int64_t ldd,
+    blas::Queue& queue )
+{
+#ifdef SLATE_HAVE_OMPTARGET
+    // quick return
+    if (nroots == 0)
+        return;
+
+    real_t eps = std::numeric_limits<real_t>::epsilon();
+
+    queue.sync(); // sync queue before switching to openmp device execution
+    // Use omp target offload
+    #pragma omp target is_device_ptr(roots, D, z, Lambda, Delta) \
+                device(queue.device())
+    #pragma omp teams distribute parallel for
+    for (int64_t k = 0; k < nroots; ++k) {
+        stedc_secular_root( n, roots[ k ], D, z, rho, eps,
+                            &Lambda[ k ], &Delta[ k*ldd ] );
+    }
+#else
+    throw slate::Exception( "device routines not available" );
+#endif
+}
+
+//------------------------------------------------------------------------------
+/// Computes this rank's partial product for the Löwner formula.
+/// @see the CUDA implementation for details of the arguments.
+///
+template <typename real_t>
+void stedc_secular_ztilde(
+    int64_t n, int64_t nroots, int64_t const* roots,
+    real_t const* D, real_t const* Delta, int64_t ldd,
+    real_t* ztilde,
+    blas::Queue& queue )
+{
+#ifdef SLATE_HAVE_OMPTARGET
+    // quick return
+    if (n == 0)
+        return;
+
+    queue.sync(); // sync queue before switching to openmp device execution
+    // Use omp target offload
+    #pragma omp target is_device_ptr(roots, D, Delta, ztilde) \
+                device(queue.device())
+    #pragma omp teams distribute parallel for
+    for (int64_t i = 0; i < n; ++i) {
+        real_t zi = 1;
+        for (int64_t k = 0; k < nroots; ++k) {
+            int64_t j = roots[ k ];
+            if (i == j)
+                zi *= Delta[ i + k*ldd ];
+            else
+                zi *= Delta[ i + k*ldd ] / (D[ i ] - D[ j ]);
+        }
+        ztilde[ i ] = zi;
+    }
+#else
+    throw slate::Exception( "device routines not available" );
+#endif
+}
+
+//------------------------------------------------------------------------------
+/// Computes eigenvectors of the secular equation from the Löwner formula.
+/// @see the CUDA implementation for details of the arguments.
+///
+template <typename real_t>
+void stedc_secular_vectors(
+    int64_t n, int64_t ncols,
+    real_t const* ztilde, real_t* Delta, int64_t ldd,
+    blas::Queue& queue )
+{
+#ifdef SLATE_HAVE_OMPTARGET
+    // quick return
+    if (ncols == 0)
+        return;
+
+    queue.sync(); // sync queue before switching to openmp device execution
+    // Use omp target offload
+    #pragma omp target is_device_ptr(ztilde, Delta) device(queue.device())
+    #pragma omp teams distribute
+    for (int64_t k = 0; k < ncols; ++k) {
+        real_t* u = &Delta[ k*ldd ];
+
+        // u = ztilde ./ delta, and its max norm.
+        real_t amax = 0;
+        #pragma omp parallel for reduction(max:amax)
+        for (int64_t i = 0; i < n; ++i) {
+            u[ i ] = ztilde[ i ] / u[ i ];
+            amax = std::max( amax, abs_val( u[ i ] ) );
+        }
+
+        if (amax != 0) {
+            // Scaled 2-norm, to avoid overflow.
+            real_t sum = 0;
+            #pragma omp parallel for reduction(+:sum)
+            for (int64_t i = 0; i < n; ++i) {
+                real_t t = u[ i ] / amax;
+                sum += t * t;
+            }
+            real_t nrm = amax * sqrt( sum );
+
+            #pragma omp parallel for
+            for (int64_t i = 0; i < n; ++i)
+                u[ i ] /= nrm;
+        }
+    }
+#else
+    throw slate::Exception( "device routines not available" );
+#endif
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+// Only real, not complex.
+template
+void stedc_secular_roots(
+    int64_t n, int64_t nroots, int64_t const* roots,
+    float const* D, float const* z, float rho,
+    float* Lambda, float* Delta, int64_t ldd,
+    blas::Queue& queue );
+
+template
+void stedc_secular_roots(
+    int64_t n, int64_t nroots, int64_t const* roots,
+    double const* D, double const* z, double rho,
+    double* Lambda, double* Delta, int64_t ldd,
+    blas::Queue& queue );
+
+template
+void stedc_secular_ztilde(
+    int64_t n, int64_t nroots, int64_t const* roots,
+    float const* D, float const* Delta, int64_t ldd,
+    float* ztilde,
+    blas::Queue& queue );
+
+template
+void stedc_secular_ztilde(
+    int64_t n, int64_t nroots, int64_t const* roots,
+    double const* D, double const* Delta, int64_t ldd,
+    double* ztilde,
+    blas::Queue& queue );
+
+template
+void stedc_secular_vectors(
+    int64_t n, int64_t ncols,
+    float const* ztilde, float* Delta, int64_t ldd,
+    blas::Queue& queue );
+
+template
+void stedc_secular_vectors(
+    int64_t n, int64_t ncols,
+    double const* ztilde, double* Delta, int64_t ldd,
+    blas::Queue& queue );
+
+} // namespace device
+} // namespace slate
@@ -0,0 +1,81 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/Exception.hh"
+#include "slate/internal/device.hh"
+
+namespace slate {
+namespace device {
+
+namespace batch {
+
+//------------------------------------------------------------------------------
+/// Batched sequence of row swaps, as the CUDA implementation.
+/// @see swap_rows
+///
+template <typename scalar_t>
+void swap_rows(
+    int64_t n, int64_t nswaps,
+    scalar_t** rows1, scalar_t** rows2,
+    int64_t batch_count, blas::Queue& queue )
+{
+#ifdef SLATE_HAVE_OMPTARGET
+    // quick return
+    if (n == 0 || nswaps == 0 || batch_count == 0)
+        return;
+
+    queue.sync(); // sync queue before switching to openmp device execution
+    // Use omp target offload
+    #pragma omp target is_device_ptr(rows1, rows2) device(queue.device())
+    #pragma omp teams distribute parallel for collapse(2) schedule(static, 1)
+    for (int64_t k = 0; k < batch_count; ++k) {
+        for (int64_t j = 0; j < n; ++j) {
+            // Each column applies the swaps of its set in order.
+            for (int64_t s = 0; s < nswaps; ++s) {
+                scalar_t* row1 = rows1[ k*nswaps + s ];
+                scalar_t* row2 = rows2[ k*nswaps + s ];
+                if (row1 != nullptr && row1 != row2) {
+                    scalar_t tmp = row1[ j ];
+                    row1[ j ] = row2[ j ];
+                    row2[ j ] = tmp;
+                }
+            }
+        }
+    }
+#else
+    throw slate::Exception( "device routines not available" );
+#endif
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void swap_rows(
+    int64_t n, int64_t nswaps,
+    float** rows1, float** rows2,
+    int64_t batch_count, blas::Queue& queue );
+
+template
+void swap_rows(
+    int64_t n, int64_t nswaps,
+    double** rows1, double** rows2,
+    int64_t batch_count, blas::Queue& queue );
+
+template
+void swap_rows(
+    int64_t n, int64_t nswaps,
+    std::complex<float>** rows1, std::complex<float>** rows2,
+    int64_t batch_count, blas::Queue& queue );
+
+template
+void swap_rows(
+    int64_t n, int64_t nswaps,
+    std::complex<double>** rows1, std::complex<double>** rows2,
+    int64_t batch_count, blas::Queue& queue );
+
+} // namespace batch
+
+} // namespace device
+} // namespace slate
@@ -71,30 +71,15 @@ void tzadd(
     if (batch_count == 0)
         return;
 
-    queue.sync(); // sync queue before switching to openmp device execution
-    #pragma omp target is_device_ptr(Aarray, Barray) device(queue.device())
-    #pragma omp teams distribute
-    for (int64_t k = 0; k < batch_count; ++k) {
-        scalar_t* tileA = Aarray[ k ];
-        scalar_t* tileB = Barray[ k ];
-        // distribute rows (i) to thread
-        #pragma omp parallel for collapse(1) schedule(static, 1)
-        for (int64_t i = 0; i < m; ++i) {
-            scalar_t* rowA = &tileA[ i ];
-            scalar_t* rowB = &tileB[ i ];
-            // add lower/upper
-            if (uplo == lapack::Uplo::Lower) {
-                for (int64_t j = 0; j <= i && j < n; ++j) { // lower
-                    rowB[j*ldb] = alpha * rowA[j*lda] + beta * rowB[j*ldb];
-                }
+    for_each_element(
+        m, n, batch_count, queue,
+        [=]( int64_t k, int64_t i, int64_t j ) {
+            if (uplo == lapack::Uplo::Lower ? j <= i : j >= i) {
+                scalar_t* B = Barray[ k ];
+                B[ i + j*ldb ] = alpha * Aarray[ k ][ i + j*lda ]
+                               + beta * B[ i + j*ldb ];
             }
-            else {
-                for (int64_t j = n-1; j >= i; --j) { // upper
-                    rowB[j*ldb] = alpha * rowA[j*lda] + beta * rowB[j*ldb];
-                }
-            }
-        }
-    }
+        } );
 #else
     throw slate::Exception( "device routines not available" );
 #endif
@@ -6,6 +6,8 @@
 #include "slate/Exception.hh"
 #include "slate/internal/device.hh"
 
+#include "device_util.hh"
+
 #include <cstdio>
 
 namespace slate {
@@ -53,27 +55,12 @@ void tzcopy(
     if (batch_count == 0)
         return;
 
-    queue.sync(); // sync queue before switching to openmp device execution
-    #pragma omp target is_device_ptr(Aarray, Barray) device(queue.device())
-    #pragma omp teams distribute
-    for (int64_t k = 0; k < batch_count; ++k) {
-        src_scalar_t const* tileA = Aarray[k];
-        dst_scalar_t* tileB = Barray[k];
-        // distribute rows (i) to threads
-        #pragma omp parallel for schedule(static, 1)
-        for (int64_t i = 0; i < m; ++i) {
-            src_scalar_t const* rowA = &tileA[i];
-            dst_scalar_t* rowB = &tileB[i];
-            if (uplo == lapack::Uplo::Lower) {
-                for (int64_t j = 0; j <= i && j < n; ++j) // lower
-                    rowB[j*ldb] = rowA[j*lda];
-            }
-            else {
-                for (int64_t j = n-1; j >= i; --j) // upper
-                    rowB[j*ldb] = rowA[j*lda];
-            }
-        }
-    }
+    for_each_element(
+        m, n, batch_count, queue,
+        [=]( int64_t k, int64_t i, int64_t j ) {
+            if (uplo == lapack::Uplo::Lower ? j <= i : j >= i)
+                Barray[ k ][ i + j*ldb ] = Aarray[ k ][ i + j*lda ];
+        } );
 #else
     throw slate::Exception( "device routines not available" );
 #endif
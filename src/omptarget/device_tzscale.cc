@@ -65,28 +65,14 @@ void tzscale(
 
     blas::real_type<scalar_t> mul = numer / denom;
 
-    queue.sync(); // sync queue before switching to openmp device execution
-    // Use omp target offload
-    #pragma omp target is_device_ptr(Aarray) device(queue.device())
-    #pragma omp teams distribute
-    for (int64_t k = 0; k < batch_count; ++k) {
-        scalar_t* tileA = Aarray[ k ];
-        // distribute rows (i) to threads
-        #pragma omp parallel for schedule(static, 1)
-        for (int64_t i = 0; i < m; ++i) {
-            scalar_t* rowA = &tileA[ i ];
-            // lower or upper
-            if (uplo == lapack::Uplo::Lower) {
-                for (int64_t j = 0; j <= i && j < n; ++j) { // lower
-                    rowA[j*lda] = rowA[j*lda] * mul;
-                }
+    for_each_element(
+        m, n, batch_count, queue,
+        [=]( int64_t k, int64_t i, int64_t j ) {
+            if (uplo == lapack::Uplo::Lower ? j <= i : j >= i) {
+                scalar_t* A = Aarray[ k ];
+                A[ i + j*lda ] = A[ i + j*lda ] * mul;
             }
-            else {
-                for (int64_t j = n-1; j >= i; --j) // upper
-                    rowA[j*lda] = rowA[j*lda] * mul;
-            }
-        }
-    }
+        } );
 #else
     throw slate::Exception( "device routines not available" );
 #endif
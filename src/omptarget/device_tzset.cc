@@ -54,25 +54,12 @@ void tzset(
     blas::Queue& queue )
 {
 #ifdef SLATE_HAVE_OMPTARGET
-    queue.sync(); // sync queue before switching to openmp device execution
-    // Use omp target offload
-    #pragma omp target is_device_ptr(A) device(queue.device())
-    // distribute rows (i) to threads
-    #pragma omp teams distribute parallel for schedule(static, 1)
-    for (int64_t i = 0; i < m; ++i) {
-        scalar_t* rowA = &A[ i ];
-        // lower or upper
-        if (uplo == lapack::Uplo::Lower) {
-            for (int64_t j = 0; j <= i && j < n; ++j) { // lower
-                rowA[ j*lda ] = i == j ? diag_value : offdiag_value;
-            }
-        }
-        else {
-            for (int64_t j = n-1; j >= i; --j) { // upper
-                rowA[ j*lda ] = i == j ? diag_value : offdiag_value;
-            }
-        }
-    }
+    for_each_element(
+        m, n, 1, queue,
+        [=]( int64_t, int64_t i, int64_t j ) {
+            if (uplo == lapack::Uplo::Lower ? j <= i : j >= i)
+                A[ i + j*lda ] = i == j ? diag_value : offdiag_value;
+        } );
 #else
     throw slate::Exception( "device routines not available" );
 #endif
@@ -164,29 +151,12 @@ void tzset(
     if (batch_count == 0)
         return;
 
-    queue.sync(); // sync queue before switching to openmp device execution
-    // Use omp target offload
-    #pragma omp target is_device_ptr(Aarray) device(queue.device())
-    #pragma omp teams distribute
-    for (int64_t k = 0; k < batch_count; ++k) {
-        scalar_t* A = Aarray[ k ];
-        // distribute rows (i) to threads
-        #pragma omp parallel for schedule(static, 1)
-        for (int64_t i = 0; i < m; ++i) {
-            scalar_t* rowA = &A[ i ];
-            // lower or upper
-            if (uplo == lapack::Uplo::Lower) {
-                for (int64_t j = 0; j <= i && j < n; ++j) { // lower
-                    rowA[ j*lda ] = i == j ? diag_value : offdiag_value;
-                }
-            }
-            else {
-                for (int64_t j = n-1; j >= i; --j) { // upper
-                    rowA[ j*lda ] = i == j ? diag_value : offdiag_value;
-                }
-            }
-        }
-    }
+    for_each_element(
+        m, n, batch_count, queue,
+        [=]( int64_t k, int64_t i, int64_t j ) {
+            if (uplo == lapack::Uplo::Lower ? j <= i : j >= i)
+                Aarray[ k ][ i + j*lda ] = i == j ? diag_value : offdiag_value;
+        } );
 #else
     throw slate::Exception( "device routines not available" );
 #endif
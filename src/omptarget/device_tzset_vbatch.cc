@@ -0,0 +1,93 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/Exception.hh"
+#include "slate/internal/device.hh"
+
+#include "device_util.hh"
+
+#include <complex>
+
+namespace slate {
+namespace device {
+namespace batch {
+
+//------------------------------------------------------------------------------
+/// Variable-size batched tile set, for tiles of any sizes in one launch.
+/// @see the CUDA implementation for details of the arguments.
+///
+template <typename scalar_t>
+void tzset_vbatch(
+    int64_t const* dims,
+    scalar_t const& offdiag_value, scalar_t const& diag_value,
+    scalar_t** Aarray,
+    int64_t batch_count, blas::Queue& queue )
+{
+#ifdef SLATE_HAVE_OMPTARGET
+    // quick return
+    if (batch_count == 0)
+        return;
+
+    queue.sync(); // sync queue before switching to openmp device execution
+    // Use omp target offload
+    #pragma omp target is_device_ptr(dims, Aarray) device(queue.device())
+    #pragma omp teams distribute
+    for (int64_t b = 0; b < batch_count; ++b) {
+        int64_t m    = dims[ b ];
+        int64_t n    = dims[ b +   batch_count ];
+        int64_t lda  = dims[ b + 2*batch_count ];
+        auto    uplo = lapack::Uplo( dims[ b + 3*batch_count ] );
+        scalar_t diag = dims[ b + 4*batch_count ] ? diag_value : offdiag_value;
+        scalar_t* A = Aarray[ b ];
+        // distribute rows (i) to threads
+        #pragma omp parallel for schedule(static, 1)
+        for (int64_t i = 0; i < m; ++i) {
+            scalar_t* rowA = &A[ i ];
+            int64_t jbegin = uplo == lapack::Uplo::Upper ? i : 0;
+            int64_t jend   = uplo == lapack::Uplo::Lower && i < n ? i+1 : n;
+            for (int64_t j = jbegin; j < jend; ++j)
+                rowA[ j*lda ] = i == j ? diag : offdiag_value;
+        }
+    }
+#else
+    throw slate::Exception( "device routines not available" );
+#endif
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void tzset_vbatch(
+    int64_t const* dims,
+    float const& offdiag_value, float const& diag_value,
+    float** Aarray,
+    int64_t batch_count, blas::Queue& queue );
+
+template
+void tzset_vbatch(
+    int64_t const* dims,
+    double const& offdiag_value, double const& diag_value,
+    double** Aarray,
+    int64_t batch_count, blas::Queue& queue );
+
+template
+void tzset_vbatch(
+    int64_t const* dims,
+    std::complex<float> const& offdiag_value,
+    std::complex<float> const& diag_value,
+    std::complex<float>** Aarray,
+    int64_t batch_count, blas::Queue& queue );
+
+template
+void tzset_vbatch(
+    int64_t const* dims,
+    std::complex<double> const& offdiag_value,
+    std::complex<double> const& diag_value,
+    std::complex<double>** Aarray,
+    int64_t batch_count, blas::Queue& queue );
+
+} // namespace batch
+} // namespace device
+} // namespace slate
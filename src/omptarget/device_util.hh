@@ -10,9 +10,60 @@
 
 #include <math.h>
 
+#include "blas.hh"
+
+#if defined( BLAS_HAVE_SYCL )
+    #if __has_include( <sycl/sycl.hpp> )
+        #include <sycl/sycl.hpp>
+    #else
+        #include <CL/sycl.hpp>
+    #endif
+#endif
+
 namespace slate {
 namespace device {
 
+//------------------------------------------------------------------------------
+/// Applies func( k, i, j ) to each element (i, j) of each m-by-n tile k of
+/// a batch of batch_count tiles, in one kernel over all elements.
+///
+/// With SYCL, which the omptarget kernels are built with, the kernel is
+/// submitted to the queue's in-order SYCL queue and returns without
+/// waiting, so it is ordered with the BLAS calls and copies on the queue,
+/// and the host can queue more work, as with the CUDA and HIP kernels.
+/// Otherwise, it is a blocking OpenMP target region, after syncing the
+/// queue. func must capture by value, and index only device memory.
+///
+template <typename Func>
+void for_each_element(
+    int64_t m, int64_t n, int64_t batch_count, blas::Queue& queue,
+    Func func )
+{
+    if (m == 0 || n == 0 || batch_count == 0)
+        return;
+
+#if defined( BLAS_HAVE_SYCL )
+    // Rows are the fastest index, for coalesced column-major access.
+    queue.stream().parallel_for(
+        sycl::range<3>( batch_count, n, m ),
+        [=]( sycl::item<3> item ) {
+            func( int64_t( item[ 0 ] ), int64_t( item[ 2 ] ),
+                  int64_t( item[ 1 ] ) );
+        } );
+#else
+    queue.sync(); // sync queue before switching to openmp device execution
+    #pragma omp target teams distribute parallel for collapse(3) \
+        device(queue.device())
+    for (int64_t k = 0; k < batch_count; ++k) {
+        for (int64_t j = 0; j < n; ++j) {
+            for (int64_t i = 0; i < m; ++i) {
+                func( k, i, j );
+            }
+        }
+    }
+#endif
+}
+
 //------------------------------------------------------------------------------
 /// max that propagates nan consistently:
 ///     max_nan( 1,   nan ) = nan
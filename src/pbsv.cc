@@ -71,11 +71,15 @@ int64_t pbsv(
     Matrix<scalar_t>& B,
     Options const& opts )
 {
+    // With Option::InfoRequest, info is only this rank's, so all ranks
+    // solve, without waiting for its reduction.
+    bool deferred = get_option<Option::InfoRequest>( opts, nullptr ) != nullptr;
+
     // factorization
     int64_t info = pbtrf(A, opts);
 
     // solve
-    if (info == 0) {
+    if (info == 0 || deferred) {
         pbtrs(A, B, opts);
     }
     return info;
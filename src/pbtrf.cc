@@ -16,7 +16,8 @@ namespace impl {
 //------------------------------------------------------------------------------
 /// Distributed parallel band Cholesky factorization.
 /// Generic implementation for any target.
-/// Panel and lookahead computed on host using Host OpenMP task.
+/// Diagonal tiles factored on host using Host OpenMP task;
+/// the trsm, herk, and gemm updates inside the band use the target.
 ///
 /// Warning: ColMajor layout is assumed
 ///
@@ -33,12 +34,13 @@ int64_t pbtrf(
     const int priority_0 = 0;
     const int priority_1 = 1;
     const int queue_0 = 0;
+    const int queue_1 = 1;
 
     // Assumes column major
     const Layout layout = Layout::ColMajor;
 
     // Options
-    int64_t lookahead = get_option<int64_t>( opts, Option::Lookahead, 1 );
+    int64_t lookahead = get_lookahead( opts );
 
     // if upper, change to lower
     if (A.uplo() == Uplo::Upper)
@@ -57,6 +59,18 @@ int64_t pbtrf(
     // todo: initially, assume fixed size, square tiles for simplicity
     int64_t kdt = ceildiv( kd, A.tileNb(0) );
 
+    if (target == Target::Devices) {
+        // The trailing update uses queue 0, the panel trsm queue 1,
+        // and lookahead columns queues 2, ..., 1 + lookahead.
+        const int64_t batch_size_default = 0;
+        int num_queues = 2 + lookahead;
+        A.allocateBatchArrays( batch_size_default, num_queues );
+        A.reserveDeviceWorkspace();
+    }
+
+    // set min number for omp nested active parallel regions
+    slate::OmpSetMaxActiveLevels set_active_levels( MinOmpActiveLevels );
+
     #pragma omp parallel
     #pragma omp master
     {
@@ -82,11 +96,11 @@ int64_t pbtrf(
                 if (k+1 < ij_end) {
                     auto Akk = A.sub(k, k);
                     auto Tkk = TriangularMatrix< scalar_t >(Diag::NonUnit, Akk);
-                    internal::trsm<Target::HostTask>(
+                    internal::trsm<target>(
                         Side::Right,
                         one, conj_transpose( Tkk ),
                         A.sub(k+1, ij_end-1, k, k),
-                        priority_1, layout );
+                        priority_1, layout, queue_1 );
                 }
 
                 BcastList bcast_list_A;
@@ -96,7 +110,7 @@ int64_t pbtrf(
                     bcast_list_A.push_back({i, k, {A.sub(i, i, k+1, i),
                                                    A.sub(i, ij_end-1, i, i)}});
                 }
-                A.template listBcast(bcast_list_A, layout);
+                A.template listBcast<target>(bcast_list_A, layout);
             }
 
             // update trailing submatrix, normal priority
@@ -105,7 +119,7 @@ int64_t pbtrf(
                                  depend(inout:column[k+1+lookahead]) \
                                  depend(inout:column[A_nt-1])
                 {
-                    internal::herk<Target::HostTask>(
+                    internal::herk<target>(
                         -r_one, A.sub(k+1+lookahead, ij_end-1, k, k),
                         r_one,  A.sub(k+1+lookahead, ij_end-1),
                         priority_0, queue_0, layout );
@@ -117,18 +131,19 @@ int64_t pbtrf(
                 #pragma omp task depend(in:column[k]) \
                                  depend(inout:column[j])
                 {
-                    internal::herk<Target::HostTask>(
+                    int queue_jk1 = j-k+1;
+                    internal::herk<target>(
                         -r_one, A.sub(j, j, k, k),
                         r_one,  A.sub(j, j),
-                        priority_0, queue_0, layout );
+                        priority_0, queue_jk1, layout );
 
                     if (j+1 <= A_nt-1) {
                         auto Ajk = A.sub(j, j, k, k);
-                        internal::gemm<Target::HostTask>(
+                        internal::gemm<target>(
                             -one, A.sub(j+1, ij_end-1, k, k),
                                   conj_transpose( Ajk ),
                             one,  A.sub(j+1, ij_end-1, j, j),
-                            layout, priority_1 );
+                            layout, priority_1, queue_jk1 );
                     }
                 }
             }
@@ -159,7 +174,7 @@ int64_t pbtrf(
 
     // Debug::printTilesMaps(A);
 
-    internal::reduce_info( &info, A.mpiComm() );
+    internal::reduce_info( &info, A.mpiComm(), opts );
     return info;
 }
 
@@ -217,7 +232,7 @@ int64_t pbtrf(
     HermitianBandMatrix<scalar_t>& A,
     Options const& opts )
 {
-    Target target = get_option( opts, Option::Target, Target::HostTask );
+    Target target = get_target( opts, Target::HostTask );
 
     switch (target) {
         case Target::Host:
@@ -231,6 +246,7 @@ int64_t pbtrf(
             return impl::pbtrf<Target::HostBatch>( A, opts );
 
         case Target::Devices:
+        case Target::Hybrid:
             return impl::pbtrf<Target::Devices>( A, opts );
     }
     return -2;  // shouldn't happen
@@ -41,6 +41,12 @@ namespace slate {
 ///
 /// @param[in] opts
 ///     Additional options, as map of name = value pairs. Possible options:
+///     - Option::EstimateColumns:
+///       Number of columns t of the block estimate of $\|A^{-1}\|$ of
+///       Higham and Tisseur, t >= 1. Each iteration solves with t columns,
+///       with the factors broadcast once for all iterations.
+///       t = 1 uses the estimate of LAPACK lacn2. Default 2.
+///
 ///     - Option::Target:
 ///       Implementation to target. Possible values:
 ///       - HostTask:  OpenMP tasks on CPU host [default].
@@ -87,35 +93,93 @@ blas::real_type<scalar_t> pocondest(
 
     std::vector<int64_t> isave = {0, 0, 0, 0};
 
+    int64_t t = get_option<int64_t>( opts, Option::EstimateColumns, 2 );
+    slate_assert( t >= 1 );
+    t = std::min( t, m );
+
     auto tileMb = A.tileMbFunc();
-    auto tileNb = func::uniform_blocksize(1, 1);
     auto tileRank = A.tileRankFunc();
     auto tileDevice = A.tileDeviceFunc();
-    slate::Matrix<scalar_t> X (m, 1, tileMb, tileNb,
-                               tileRank, tileDevice, A.mpiComm());
-    X.insertLocalTiles(Target::Host);
-    slate::Matrix<scalar_t> V (m, 1, tileMb, tileNb,
-                               tileRank, tileDevice, A.mpiComm());
-    V.insertLocalTiles(Target::Host);
-    slate::Matrix<int64_t> isgn (m, 1, tileMb, tileNb,
-                                 tileRank, tileDevice, A.mpiComm());
-    isgn.insertLocalTiles(Target::Host);
-
-    // initial and final value of kase is 0
-    kase = 0;
-    internal::norm1est( X, V, isgn, &Ainvnorm, &kase, isave );
-
-    MPI_Bcast( &isave[0], 4, MPI_INT64_T, X.tileRank(0, 0), A.mpiComm() );
-    MPI_Bcast( &kase, 1, MPI_INT, X.tileRank(0, 0), A.mpiComm() );
-
-    while (kase != 0) {
-        // A is symmetric, so both cases are equivalent
-        potrs( A, X, opts );
-
-        internal::norm1est( X, V, isgn, &Ainvnorm, &kase, isave );
+
+    // Keep the estimator's vectors where the solves run.
+    Target target = get_target( opts, Target::HostTask );
+
+    if (t > 1) {
+        // Block estimate, with t columns in each solve.
+        auto tileNb = func::uniform_blocksize( t, t );
+        auto tileNb1 = func::uniform_blocksize( 1, 1 );
+        slate::Matrix<scalar_t> X( m, t, tileMb, tileNb,
+                                   tileRank, tileDevice, A.mpiComm() );
+        X.insertLocalTiles( target );
+        slate::Matrix<scalar_t> S( m, t, tileMb, tileNb,
+                                   tileRank, tileDevice, A.mpiComm() );
+        S.insertLocalTiles( Target::Host );
+        slate::Matrix<scalar_t> V( m, 1, tileMb, tileNb1,
+                                   tileRank, tileDevice, A.mpiComm() );
+        V.insertLocalTiles( Target::Host );
+
+        // Broadcast the factors once for all solves, unless they are
+        // already on the ranks of X, e.g., from CholeskyFactorization::rcond.
+        // As in potrs, solve with L and L^H.
+        auto A_ = A;
+        if (A_.uplo() == Uplo::Upper)
+            A_ = conj_transpose( A_ );
+        auto L = TriangularMatrix<scalar_t>( Diag::NonUnit, A_ );
+        auto LH = conj_transpose( L );
+
+        Options opts_est = opts;
+        bool resident = get_option<Option::FactorsResident>( opts, false );
+        if (! resident) {
+            impl::trsm_resident_bcast( L,  X, target );
+            impl::trsm_resident_bcast( LH, X, target );
+            opts_est[ Option::MethodTrsm ] = MethodTrsm::B;
+            opts_est[ Option::FactorsResident ] = true;
+        }
+
+        // initial and final value of kase is 0
+        kase = 0;
+        internal::norm1est_block( X, V, S, &Ainvnorm, &kase, isave );
+
+        while (kase != 0) {
+            // A is symmetric, so both cases are equivalent
+            potrs( A, X, opts_est );
+
+            internal::norm1est_block( X, V, S, &Ainvnorm, &kase, isave );
+        } // while (kase != 0)
+
+        if (! resident) {
+            A_.releaseRemoteWorkspace();
+            A_.releaseLocalWorkspace();
+        }
+    }
+    else {
+        auto tileNb = func::uniform_blocksize(1, 1);
+        slate::Matrix<scalar_t> X (m, 1, tileMb, tileNb,
+                                   tileRank, tileDevice, A.mpiComm());
+        X.insertLocalTiles(target);
+        slate::Matrix<scalar_t> V (m, 1, tileMb, tileNb,
+                                   tileRank, tileDevice, A.mpiComm());
+        V.insertLocalTiles(target);
+        slate::Matrix<scalar_t> S (m, 1, tileMb, tileNb,
+                                   tileRank, tileDevice, A.mpiComm());
+        S.insertLocalTiles(target);
+
+        // initial and final value of kase is 0
+        kase = 0;
+        internal::norm1est( X, V, S, &Ainvnorm, &kase, isave );
+
         MPI_Bcast( &isave[0], 4, MPI_INT64_T, X.tileRank(0, 0), A.mpiComm() );
         MPI_Bcast( &kase, 1, MPI_INT, X.tileRank(0, 0), A.mpiComm() );
-    } // while (kase != 0)
+
+        while (kase != 0) {
+            // A is symmetric, so both cases are equivalent
+            potrs( A, X, opts );
+
+            internal::norm1est( X, V, S, &Ainvnorm, &kase, isave );
+            MPI_Bcast( &isave[0], 4, MPI_INT64_T, X.tileRank(0, 0), A.mpiComm() );
+            MPI_Bcast( &kase, 1, MPI_INT, X.tileRank(0, 0), A.mpiComm() );
+        } // while (kase != 0)
+    }
 
     // Compute the estimate of the reciprocal condition number.
     if (Ainvnorm != 0.0) {
@@ -0,0 +1,137 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/slate.hh"
+#include "internal/internal.hh"
+#include "slate/internal/mpi.hh"
+
+#include <algorithm>
+#include <cmath>
+
+namespace slate {
+
+//------------------------------------------------------------------------------
+/// Distributed parallel scaling to equilibrate a Hermitian positive definite
+/// matrix, as LAPACK's poequ. Computes S such that
+/// $B = diag(S) A diag(S)$ has ones on the diagonal, with
+/// $S_i = 1 / \sqrt{ A_{ii} }$.
+///
+/// Only the diagonal tiles are read, on the host, and the diagonal is
+/// combined with one MPI_Allreduce. Apply the scaling with scale_row_col.
+///
+//------------------------------------------------------------------------------
+/// @tparam scalar_t
+///     One of float, double, std::complex<float>, std::complex<double>.
+//------------------------------------------------------------------------------
+/// @param[in] A
+///     The n-by-n Hermitian positive definite matrix A.
+///
+/// @param[out] S
+///     Vector of length n. If return value is 0, the scale factors.
+///
+/// @param[out] scond
+///     If return value is 0, the ratio of the smallest S_i to the largest
+///     S_i. If scond >= 0.1 and amax is neither too large nor too small,
+///     it is not worth scaling by S.
+///
+/// @param[out] amax
+///     Absolute value of the largest diagonal element.
+///
+/// @param[in] opts
+///     Currently unused.
+///
+/// @return 0: successful exit
+/// @return i > 0: the i-th diagonal element is nonpositive.
+///
+/// @ingroup norm
+///
+template <typename scalar_t>
+int64_t poequ(
+    HermitianMatrix<scalar_t>& A,
+    std::vector< blas::real_type<scalar_t> >& S,
+    blas::real_type<scalar_t>& scond,
+    blas::real_type<scalar_t>& amax,
+    Options const& opts )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    int64_t n = A.n();
+    S.resize( n );
+    scond = 1;
+    amax = 0;
+
+    // Quick return
+    if (n == 0)
+        return 0;
+
+    // Each diagonal entry is set by its owner only, so a sum gathers them.
+    std::vector<real_t> local( n, 0 );
+    int64_t jj = 0;
+    for (int64_t j = 0; j < A.nt(); ++j) {
+        if (A.tileIsLocal( j, j )) {
+            A.tileGetForReading( j, j, LayoutConvert::None );
+            auto T = A( j, j );
+            for (int64_t k = 0; k < T.nb(); ++k)
+                local[ jj + k ] = std::real( T( k, k ) );
+        }
+        jj += A.tileNb( j );
+    }
+    {
+        internal::MpiGuard mpi_guard;
+        trace::Block trace_block("MPI_Allreduce");
+        slate_mpi_call(
+            MPI_Allreduce( local.data(), S.data(), n, mpi_type<real_t>::value,
+                           MPI_SUM, A.mpiComm() ) );
+    }
+
+    auto rc = std::minmax_element( S.begin(), S.end() );
+    real_t smin = *rc.first;
+    amax = *rc.second;
+    if (smin <= 0) {
+        // First nonpositive diagonal element, 1-based.
+        for (int64_t i = 0; i < n; ++i) {
+            if (S[ i ] <= 0)
+                return i + 1;
+        }
+    }
+
+    for (int64_t i = 0; i < n; ++i)
+        S[ i ] = 1 / std::sqrt( S[ i ] );
+    scond = std::sqrt( smin ) / std::sqrt( amax );
+
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+int64_t poequ<float>(
+    HermitianMatrix<float>& A,
+    std::vector<float>& S,
+    float& scond, float& amax,
+    Options const& opts);
+
+template
+int64_t poequ<double>(
+    HermitianMatrix<double>& A,
+    std::vector<double>& S,
+    double& scond, double& amax,
+    Options const& opts);
+
+template
+int64_t poequ< std::complex<float> >(
+    HermitianMatrix< std::complex<float> >& A,
+    std::vector<float>& S,
+    float& scond, float& amax,
+    Options const& opts);
+
+template
+int64_t poequ< std::complex<double> >(
+    HermitianMatrix< std::complex<double> >& A,
+    std::vector<double>& S,
+    double& scond, double& amax,
+    Options const& opts);
+
+} // namespace slate
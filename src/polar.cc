@@ -0,0 +1,303 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/slate.hh"
+#include "internal/internal.hh"
+
+#include <cmath>
+
+namespace slate {
+
+namespace impl {
+
+//------------------------------------------------------------------------------
+/// @internal
+/// Creates the (m + n)-by-n matrix $[ X; I ]$ for the QR-based QDWH
+/// iteration, with the m-by-n X = A stacked over the n-by-n identity.
+/// The top block rows have A's tile sizes and distribution, so copying
+/// X into them is local; the bottom block rows have A's column tile sizes,
+/// so both blocks are whole tiles.
+///
+template <typename scalar_t>
+Matrix<scalar_t> polar_stack( Matrix<scalar_t>& A )
+{
+    using ij_tuple = typename BaseMatrix<scalar_t>::ij_tuple;
+
+    int64_t mt = A.mt();
+
+    std::function<int64_t (int64_t)> tileMb = [A, mt]( int64_t i ) {
+        return i < mt ? A.tileMb( i ) : A.tileNb( i - mt );
+    };
+    std::function<int64_t (int64_t)> tileNb = [A]( int64_t j ) {
+        return A.tileNb( j );
+    };
+    std::function<int (ij_tuple)> tileRank = [A, mt]( ij_tuple ij ) {
+        int64_t i = std::get<0>( ij );
+        int64_t j = std::get<1>( ij );
+        return A.tileRank( i % mt, j );
+    };
+    std::function<int (ij_tuple)> tileDevice = [A, mt]( ij_tuple ij ) {
+        int64_t i = std::get<0>( ij );
+        int64_t j = std::get<1>( ij );
+        return A.tileDevice( i % mt, j );
+    };
+    return Matrix<scalar_t>( A.m() + A.n(), A.n(),
+                             tileMb, tileNb, tileRank, tileDevice,
+                             A.mpiComm() );
+}
+
+} // namespace impl
+
+//------------------------------------------------------------------------------
+/// Distributed parallel polar decomposition.
+/// Computes the polar decomposition of an m-by-n matrix A, m >= n,
+/// \[
+///     A = U_p H,
+/// \]
+/// where $U_p$ is m-by-n with orthonormal columns and H is n-by-n
+/// Hermitian positive semi-definite, by the QR-based dynamically weighted
+/// Halley (QDWH) iteration (Nakatsukasa, Bai, and Gygi, 2010):
+/// \[
+///     X_{k+1} = X_k (a_k I + b_k X_k^H X_k) (I + c_k X_k^H X_k)^{-1},
+/// \]
+/// starting from $X_0 = A / \| A \|_F$, with weights $a_k, b_k, c_k$ from a
+/// lower bound $\ell_k$ on the smallest singular value of $X_k$.
+///
+/// While $c_k > 100$, the iteration is done in its inverse-free QR form,
+/// factoring $[ \sqrt{c_k} X_k; I ] = [ Q_1; Q_2 ] R$ by geqrf, then
+/// \[
+///     X_{k+1} = \frac{b_k}{c_k} X_k
+///             + \frac{1}{\sqrt{c_k}} \left( a_k - \frac{b_k}{c_k} \right)
+///               Q_1 Q_2^H.
+/// \]
+/// Once $c_k \le 100$, $I + c_k X_k^H X_k$ is well conditioned, and the
+/// cheaper Cholesky form is used, with herk, potrf, and two trsm.
+/// It converges in at most 6 iterations in double precision, with
+/// usually only the first 1 or 2 in QR form. All steps are level 3 BLAS
+/// (gemm, herk, trsm) or factorizations built on them (geqrf, potrf),
+/// so it runs at their speed on GPUs.
+///
+/// The tiles of A are assumed square, mb = nb.
+///
+//------------------------------------------------------------------------------
+/// @tparam scalar_t
+///     One of float, double, std::complex<float>, std::complex<double>.
+//------------------------------------------------------------------------------
+/// @param[in,out] A
+///     On entry, the m-by-n matrix $A$, m >= n.
+///     On exit, the orthonormal polar factor $U_p$.
+///
+/// @param[out] H
+///     On entry, if H is empty, does not compute the Hermitian factor.
+///     Otherwise, the n-by-n matrix H, with A's column tiles.
+///     On exit, the Hermitian polar factor $H = U_p^H A$, stored in full.
+///
+/// @param[in] opts
+///     Additional options, as map of name = value pairs. Possible options:
+///     - Option::MaxIterations:
+///       Maximum number of QDWH iterations. Default 30.
+///     - Options of geqrf, unmqr, potrf, trsm, and gemm, used by each step.
+///     - Option::Target:
+///       Implementation to target. Possible values:
+///       - HostTask:  OpenMP tasks on CPU host [default].
+///       - HostNest:  nested OpenMP parallel for loop on CPU host.
+///       - HostBatch: batched BLAS on CPU host.
+///       - Devices:   batched BLAS on GPU device.
+///
+/// @ingroup svd
+///
+template <typename scalar_t>
+void polar(
+    Matrix<scalar_t>& A,
+    Matrix<scalar_t>& H,
+    Options const& opts )
+{
+    trace::Block trace_block( "slate::polar" );
+
+    using real_t = blas::real_type<scalar_t>;
+
+    // Constants
+    const scalar_t zero = 0;
+    const scalar_t one  = 1;
+    const real_t r_one  = 1;
+    const real_t eps    = std::numeric_limits<real_t>::epsilon();
+
+    // Options
+    Target target = get_target( opts, Target::HostTask );
+    int64_t itermax = get_option<int64_t>( opts, Option::MaxIterations, 30 );
+
+    int64_t m = A.m();
+    int64_t n = A.n();
+    bool wanth = (H.mt() > 0);
+
+    if (m < n)
+        slate_error( "polar: requires m >= n" );
+    if (wanth)
+        slate_assert( H.m() == n && H.n() == n );
+    if (n == 0)
+        return;
+
+    int64_t nb = A.tileNb( 0 );
+    MPI_Comm mpi_comm = A.mpiComm();
+
+    GridOrder order;
+    int p, q, myrow, mycol;
+    A.gridinfo( &order, &p, &q, &myrow, &mycol );
+    if (order == GridOrder::Unknown) {
+        order = GridOrder::Col;
+        slate_mpi_call(
+            MPI_Comm_size( mpi_comm, &p ) );
+        q = 1;
+    }
+
+    // Keep A for H = U_p^H A.
+    Matrix<scalar_t> A0;
+    if (wanth) {
+        A0 = A.emptyLike();
+        A0.insertLocalTiles( target );
+        slate::copy( A, A0, opts );
+    }
+
+    // X_0 = A / alpha, with alpha = || A ||_F >= || A ||_2,
+    // so all singular values of X_0 are in (0, 1].
+    auto& X = A;
+    real_t alpha = norm( Norm::Fro, X, opts );
+    if (alpha == 0) {
+        // A = 0 has polar factors U_p = [ I; 0 ] and H = 0.
+        set( zero, one, X, opts );
+        if (wanth)
+            set( zero, H, opts );
+        return;
+    }
+    scale( r_one, alpha, X, opts );
+
+    // Lower bound on sigma_min( X_0 ) = sigma_min( R ), with X_0 = Q R:
+    // || R^{-1} ||_2 <= sqrt( n ) || R^{-1} ||_1 = sqrt( n ) / (rcond || R ||_1).
+    real_t ell;
+    {
+        Matrix<scalar_t> Xqr = X.emptyLike();
+        Xqr.insertLocalTiles( target );
+        slate::copy( X, Xqr, opts );
+        TriangularFactors<scalar_t> T;
+        geqrf( Xqr, T, opts );
+        auto R_ = Xqr.slice( 0, n-1, 0, n-1 );
+        TriangularMatrix<scalar_t> R( Uplo::Upper, Diag::NonUnit, R_ );
+        real_t R_norm = norm( Norm::One, R, opts );
+        real_t rcond = trcondest( Norm::One, R, R_norm, opts );
+        ell = rcond * R_norm / std::sqrt( real_t( n ) );
+    }
+    ell = std::max( ell, eps );
+
+    Matrix<scalar_t> Xprev = X.emptyLike();
+    Xprev.insertLocalTiles( target );
+
+    real_t tol_conv = std::cbrt( 5*eps );
+    real_t conv = 1;
+    for (int64_t iter = 0; iter < itermax; ++iter) {
+        if (conv <= tol_conv && std::abs( 1 - ell ) <= 5*eps)
+            break;
+
+        // Dynamically weighted Halley weights, which map [ell, 1]
+        // as close to 1 as possible.
+        real_t ell2 = ell*ell;
+        real_t dd = std::cbrt( 4*(1 - ell2) / (ell2*ell2) );
+        real_t sqd = std::sqrt( 1 + dd );
+        real_t a = sqd + std::sqrt( 8 - 4*dd + 8*(2 - ell2) / (ell2*sqd) ) / 2;
+        real_t b = (a - 1)*(a - 1) / 4;
+        real_t c = a + b - 1;
+        ell = ell*(a + b*ell2) / (1 + c*ell2);
+
+        slate::copy( X, Xprev, opts );
+
+        if (c > 100) {
+            // QR form: [ sqrt( c ) X; I ] = [ Q1; Q2 ] R,
+            // X = (b/c) X + (a - b/c) / sqrt( c ) Q1 Q2^H.
+            Matrix<scalar_t> B = impl::polar_stack( X );
+            B.insertLocalTiles( target );
+            auto B_top = B.sub( 0, X.mt()-1, 0, X.nt()-1 );
+            auto B_bot = B.sub( X.mt(), B.mt()-1, 0, B.nt()-1 );
+            slate::copy( X, B_top, opts );
+            scale( std::sqrt( c ), r_one, B_top, opts );
+            set( zero, one, B_bot, opts );
+
+            TriangularFactors<scalar_t> T;
+            geqrf( B, T, opts );
+
+            Matrix<scalar_t> Q = B.emptyLike();
+            Q.insertLocalTiles( target );
+            set( zero, one, Q, opts );
+            unmqr( Side::Left, Op::NoTrans, B, T, Q, opts );
+
+            auto Q1 = Q.sub( 0, X.mt()-1, 0, X.nt()-1 );
+            auto Q2 = Q.sub( X.mt(), Q.mt()-1, 0, Q.nt()-1 );
+            auto Q2H = conj_transpose( Q2 );
+            gemm( scalar_t( (a - b/c) / std::sqrt( c ) ), Q1, Q2H,
+                  scalar_t( b/c ), X, opts );
+        }
+        else {
+            // Cholesky form: I + c X^H X = L L^H,
+            // X = (b/c) X + (a - b/c) X L^{-H} L^{-1}.
+            HermitianMatrix<scalar_t> Z( Uplo::Lower, n, nb, order, p, q,
+                                         mpi_comm );
+            Z.insertLocalTiles( target );
+            set( zero, one, Z, opts );
+            auto XH = conj_transpose( X );
+            herk( c, XH, r_one, Z, opts );
+            int64_t info = internal::wait_info( potrf( Z, opts ), opts );
+            if (info != 0)
+                slate_error( "polar: potrf failed in the QDWH iteration, info = "
+                             + std::to_string( info ) );
+
+            Matrix<scalar_t> W = X.emptyLike();
+            W.insertLocalTiles( target );
+            slate::copy( X, W, opts );
+            auto L = TriangularMatrix<scalar_t>( Diag::NonUnit, Z );
+            auto LH = conj_transpose( L );
+            trsm( Side::Right, one, LH, W, opts );
+            trsm( Side::Right, one, L,  W, opts );
+            add( scalar_t( a - b/c ), W, scalar_t( b/c ), X, opts );
+        }
+
+        // conv = || X_{k+1} - X_k ||_F.
+        add( one, X, -one, Xprev, opts );
+        conv = norm( Norm::Fro, Xprev, opts );
+    }
+
+    if (wanth) {
+        // H = (U_p^H A + A^H U_p) / 2, which is Hermitian to rounding.
+        auto XH  = conj_transpose( X );
+        auto A0H = conj_transpose( A0 );
+        gemm( scalar_t( 0.5 ), XH,  A0, zero, H, opts );
+        gemm( scalar_t( 0.5 ), A0H, X,  one,  H, opts );
+    }
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void polar<float>(
+    Matrix<float>& A,
+    Matrix<float>& H,
+    Options const& opts);
+
+template
+void polar<double>(
+    Matrix<double>& A,
+    Matrix<double>& H,
+    Options const& opts);
+
+template
+void polar< std::complex<float> >(
+    Matrix< std::complex<float> >& A,
+    Matrix< std::complex<float> >& H,
+    Options const& opts);
+
+template
+void polar< std::complex<double> >(
+    Matrix< std::complex<double> >& A,
+    Matrix< std::complex<double> >& H,
+    Options const& opts);
+
+} // namespace slate
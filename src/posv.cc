@@ -10,6 +10,10 @@
 #include "slate/TriangularMatrix.hh"
 #include "internal/internal.hh"
 
+#include "lapack/flops.hh"
+
+#include <limits>
+
 namespace slate {
 
 //------------------------------------------------------------------------------
@@ -53,6 +57,10 @@ namespace slate {
 ///     - Option::Lookahead:
 ///       Number of panels to overlap with matrix updates.
 ///       lookahead >= 0. Default 1.
+///     - Option::Counters:
+///       Pointer to Counters to collect performance counters in, for
+///       phases "posv", "posv::potrf", "posv::potrs". Default null: off.
+///
 ///     - Option::Target:
 ///       Implementation to target. Possible values:
 ///       - HostTask:  OpenMP tasks on CPU host [default].
@@ -60,6 +68,30 @@ namespace slate {
 ///       - HostBatch: batched BLAS on CPU host.
 ///       - Devices:   batched BLAS on GPU device.
 ///
+///     - Option::Equilibrate:
+///       Whether to equilibrate A first, as LAPACK's posvx with fact = 'E'.
+///       Default false. If true, computes a scaling S with poequ, and if A
+///       is badly scaled, solves
+///       $(diag(S) A diag(S)) (diag(S)^{-1} X) = diag(S) B$ instead;
+///       A is then overwritten by the factor of the scaled matrix,
+///       and B by the unscaled solution X.
+///
+///     - Option::InfoRequest:
+///       Pointer to InfoRequest in which the factorization reduces info
+///       over the ranks without blocking (@see InfoRequest). The solve
+///       then starts at once, on all ranks, even if the factor is singular,
+///       in which case B is overwritten with Inf or NaN. The routine
+///       returns this rank's info, and InfoRequest::wait() the reduced
+///       info. Default null: blocking reduction, and no solve if info > 0.
+///
+///     - Option::FusedSolve:
+///       Whether potrf applies the forward substitution $L^{-1} B$, or
+///       $U^{-H} B$, as it factors, treating B as extra columns of the
+///       trailing update, so B reuses the panel broadcasts of L, saving a
+///       pass over L and its broadcasts; only the backward solve follows.
+///       B then must have the MPI communicator of A. Default false.
+///       @see potrf( A, B, opts ).
+///
 /// @return 0: successful exit
 /// @return i > 0: the leading minor of order $i$ of $A$ is not
 ///         positive definite, so the factorization could not
@@ -77,15 +109,75 @@ int64_t posv(
 
     slate_assert(B.mt() == A.mt());
 
+    using lapack::Gflop;
+    Counters* counters = get_option<Option::Counters>( opts, nullptr );
+    internal::CounterPhase c_posv(
+        counters, "posv", Gflop<scalar_t>::posv( A.n(), B.n() ) * 1e9 );
+
+    // Equilibrate, with the thresholds of LAPACK's laqhe.
+    using real_t = blas::real_type<scalar_t>;
+    bool equilibrate = get_option<bool>( opts, Option::Equilibrate, false );
+    bool equed = false;
+    std::vector<real_t> S;
+    if (equilibrate) {
+        Timer t_equilibrate;
+        const real_t thresh = 0.1;
+        const real_t small = std::numeric_limits<real_t>::min()
+                           / std::numeric_limits<real_t>::epsilon();
+        const real_t large = 1 / small;
+        real_t scond, amax;
+        if (poequ( A, S, scond, amax, opts ) == 0) {
+            equed = scond < thresh || amax < small || amax > large;
+        }
+        if (equed) {
+            // A = diag(S) A diag(S), and B = diag(S) B.
+            scale_row_col( S, A, opts );
+            scale_row_col( Equed::Row, S, S, B, opts );
+        }
+        timers[ "posv::equilibrate" ] = t_equilibrate.stop();
+    }
+
+    // With Option::InfoRequest, info is only this rank's, so all ranks
+    // solve, without waiting for its reduction.
+    bool deferred = get_option<Option::InfoRequest>( opts, nullptr ) != nullptr;
+    bool fused = get_option<Option::FusedSolve>( opts, false );
+
     // factorization
     Timer t_potrf;
-    int64_t info = potrf( A, opts );
+    int64_t info;
+    {
+        internal::CounterPhase c_potrf(
+            counters, "posv::potrf", Gflop<scalar_t>::potrf( A.n() ) * 1e9 );
+        if (fused)
+            info = potrf( A, B, opts );
+        else
+            info = potrf( A, opts );
+    }
     timers[ "posv::potrf" ] = t_potrf.stop();
 
     // solve
     Timer t_potrs;
-    if (info == 0) {
-        potrs( A, B, opts );
+    if (info == 0 || deferred) {
+        internal::CounterPhase c_potrs(
+            counters, "posv::potrs", Gflop<scalar_t>::potrs( A.n(), B.n() ) * 1e9 );
+        if (fused) {
+            // Backward substitution, X = L^{-H} Y, with Y = L^{-1} B
+            // from potrf.
+            const scalar_t one = 1.0;
+            auto A_ = A;  // local shallow copy to transpose
+            if (A_.uplo() == Uplo::Upper)
+                A_ = conj_transpose( A_ );
+            auto L = TriangularMatrix<scalar_t>( Diag::NonUnit, A_ );
+            auto LH = conj_transpose( L );
+            trsm( Side::Left, one, LH, B, opts );
+        }
+        else {
+            potrs( A, B, opts );
+        }
+
+        // X = diag(S) X undoes the scaling.
+        if (equed)
+            scale_row_col( Equed::Row, S, S, B, opts );
     }
     timers[ "posv::potrs" ] = t_potrs.stop();
 
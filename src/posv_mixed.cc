@@ -94,6 +94,17 @@ namespace slate {
 ///     - Option::UseFallbackSolver:
 ///       If true and iterative refinement fails to converge, the problem is
 ///       resolved with partial-pivoted LU. Default true
+///     - Option::BcastPrecision:
+///       Precision of panel broadcasts in the low precision Cholesky
+///       factorization, e.g., BFloat16; receivers get rounded copies of
+///       the panels, so the factors are less accurate but iterations
+///       correct the solution. With BFloat16 or Half, the trailing
+///       updates multiply 16-bit panels, accumulating in the low
+///       precision, while the panels are factored in the low precision.
+///       Half overflows for entries above 65504; the iterations then
+///       fail to converge and the fallback solver applies.
+///       The fallback solver and the residual
+///       computations always use full precision. Default Native.
 ///
 /// @return 0: successful exit
 /// @return i > 0: the leading minor of order $i$ of $A$ is not
@@ -123,7 +134,7 @@ int64_t posv_mixed(
     // Options
     // XXX target is used only for the memory management and may be inconsistent
     // with the routines called in this routine.
-    Target target = get_option( opts, Option::Target, Target::HostTask );
+    Target target = get_target( opts, Target::HostTask );
     int64_t itermax = get_option<int64_t>( opts, Option::MaxIterations, 30 );
     double tol = get_option<double>( opts, Option::Tolerance, eps*std::sqrt(A.m()) );
     bool use_fallback = get_option<int64_t>( opts, Option::UseFallbackSolver, true );
@@ -181,7 +192,7 @@ int64_t posv_mixed(
 
     // Compute the Cholesky factorization of A_lo.
     Timer t_potrf_lo;
-    int64_t info = potrf( A_lo, opts );
+    int64_t info = internal::wait_info( potrf( A_lo, opts ), opts );
     timers[ "posv_mixed::potrf_lo" ] = t_potrf_lo.stop();
     if (info != 0) {
         iter = -3;
@@ -226,12 +237,11 @@ int64_t posv_mixed(
             potrs( A_lo, X_lo, opts );
             timers[ "posv_mixed::potrs_lo" ] += t_potrs_lo.stop();
 
-            // Convert X_lo back to double precision and update the current iterate.
-            copy( X_lo, R, opts );
+            // Update the current iterate, X = X + X_lo, converting X_lo
+            // to high precision on the fly instead of through R.
             Timer t_add_hi;
-            add<scalar_hi>(
-                  one_hi, R,
-                  one_hi, X, opts );
+            add( one_hi, X_lo,
+                 one_hi, X, opts );
             timers[ "posv_mixed::add_hi" ] += t_add_hi.stop();
 
             // Compute R = B - A * X.
@@ -267,7 +277,10 @@ int64_t posv_mixed(
             // Fall back to double precision factor and solve.
             // Compute the Cholesky factorization of A.
             Timer t_potrf_hi;
-            info = potrf( A, opts );
+            // Broadcast in full precision for an accurate factorization.
+            Options opts_hi = opts;
+            opts_hi.erase( Option::BcastPrecision );
+            info = internal::wait_info( potrf( A, opts_hi ), opts_hi );
             timers[ "posv_mixed::potrf_hi" ] = t_potrf_hi.stop();
 
             // Solve the system A * X = B.
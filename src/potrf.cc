@@ -9,23 +9,122 @@
 #include "slate/HermitianMatrix.hh"
 #include "slate/TriangularMatrix.hh"
 #include "internal/internal.hh"
+#include "internal/internal_small.hh"
+#include "internal/internal_util.hh"
+#include "slate/internal/TaskGraph.hh"
+#include "slate/Tuning.hh"
+#include "slate/internal/Hybrid.hh"
+#include "slate/internal/Lookahead.hh"
+
+#include "lapack/flops.hh"
 
 namespace slate {
 
 namespace impl {
 
+//------------------------------------------------------------------------------
+/// Trailing update of step k of potrf with Target::Hybrid:
+/// A(j0:nt-1, j0:nt-1) -= A(j0:nt-1, k) A(j0:nt-1, k)^H,
+/// with block-columns j0, ..., s-1 updated on the devices, and the lower
+/// right corner A(s:nt-1, s:nt-1) on the host, while the devices run.
+/// The split s balances the local flops by the rates measured by hybrid.
+/// @ingroup posv_impl
+///
+template <typename scalar_t>
+void potrf_trailing_hybrid(
+    HermitianMatrix<scalar_t>& A, int64_t k, int64_t j0,
+    internal::HybridSplit& hybrid, int priority, int64_t queue_index )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    const scalar_t one = 1.0;
+    const Layout layout = Layout::ColMajor;
+    int64_t A_nt = A.nt();
+
+    // Local flops of each block-column, on and below the diagonal.
+    std::vector<double> flops( A_nt - j0, 0.0 );
+    int64_t nbk = A.tileNb( k );
+    for (int64_t j = j0; j < A_nt; ++j) {
+        for (int64_t i = j; i < A_nt; ++i) {
+            if (A.tileIsLocal( i, j )) {
+                flops[ j - j0 ] += i == j
+                    ? blas::Gflop<scalar_t>::herk( A.tileNb( j ), nbk ) * 1e9
+                    : blas::Gflop<scalar_t>::gemm(
+                          A.tileMb( i ), A.tileNb( j ), nbk ) * 1e9;
+            }
+        }
+    }
+    int64_t s = j0 + hybrid.split( flops );
+    double host_flops = 0;
+    for (int64_t j = s; j < A_nt; ++j)
+        host_flops += flops[ j - j0 ];
+    double device_flops = 0;
+    for (int64_t j = j0; j < s; ++j)
+        device_flops += flops[ j - j0 ];
+
+    double device_time = 0;
+    if (s > j0) {
+        #pragma omp task shared( A, device_time ) \
+            firstprivate( k, j0, s, A_nt, priority, queue_index )
+        {
+            double time = omp_get_wtime();
+
+            // A(j0:s-1, j0:s-1) -= A(j0:s-1, k) A(j0:s-1, k)^H
+            internal::herk<Target::Devices>(
+                real_t(-1.0), A.sub( j0, s-1, k, k ),
+                real_t( 1.0), A.sub( j0, s-1 ),
+                priority, queue_index, layout );
+
+            // A(s:nt-1, j0:s-1) -= A(s:nt-1, k) A(j0:s-1, k)^H
+            if (s < A_nt) {
+                auto Ak = A.sub( j0, s-1, k, k );
+                internal::gemm<Target::Devices>(
+                    -one, A.sub( s, A_nt-1, k, k ),
+                          conj_transpose( Ak ),
+                    one,  A.sub( s, A_nt-1, j0, s-1 ),
+                    layout, priority, queue_index );
+            }
+            device_time = omp_get_wtime() - time;
+        }
+    }
+
+    double host_time = 0;
+    if (s < A_nt) {
+        double time = omp_get_wtime();
+
+        // A(s:nt-1, s:nt-1) -= A(s:nt-1, k) A(s:nt-1, k)^H
+        internal::herk<Target::HostTask>(
+            real_t(-1.0), A.sub( s, A_nt-1, k, k ),
+            real_t( 1.0), A.sub( s, A_nt-1 ),
+            priority, queue_index, layout );
+
+        host_time = omp_get_wtime() - time;
+    }
+    #pragma omp taskwait
+
+    hybrid.done( host_flops, host_time, device_flops, device_time );
+}
+
 //------------------------------------------------------------------------------
 /// Distributed parallel Cholesky factorization.
 /// Generic implementation for any target.
+///
+/// If rhs is not null, step k also applies the forward substitution with
+/// L(k:nt-1, k) to the block rows k:nt-1 of rhs, as extra columns of the
+/// trailing update, so on exit rhs = L^{-1} rhs, or U^{-H} rhs if A is
+/// upper. The panel broadcasts also send A(i, k) to the ranks of
+/// rhs(i, :), so the solve needs no broadcasts of L of its own.
+/// Not with Checkpoint.
 /// @ingroup posv_impl
 ///
 template <Target target, typename scalar_t>
 int64_t potrf(
     slate::internal::TargetType<target>,
     HermitianMatrix<scalar_t> A,
-    Options const& opts )
+    Options const& opts, Matrix<scalar_t>* rhs = nullptr )
 {
     using real_t = blas::real_type<scalar_t>;
+    using BcastList = typename Matrix<scalar_t>::BcastList;
     using BcastListTag = typename Matrix<scalar_t>::BcastListTag;
 
     // Constants
@@ -34,12 +133,44 @@ int64_t potrf(
     const int queue_0 = 0;
     const int queue_1 = 1;
     const int queue_2 = 2;
-    // Assumes column major
-    const Layout layout = Layout::ColMajor;
 
     // Options
-    int64_t lookahead = get_option<Option::Lookahead>( opts, 1 );
-    bool hold_local_workspace = get_option<Option::HoldLocalWorkspace>( opts, false );
+    ResolvedOptions const ropts( opts );
+    int64_t lookahead = ropts.get<Option::Lookahead>( 1 );
+    int64_t max_lookahead = ropts.get<Option::MaxLookahead>( 4 );
+    bool hold_local_workspace = ropts.get<Option::HoldLocalWorkspace>( false );
+    int64_t cache_tiles = ropts.get<Option::DeviceCacheTiles>( 0 );
+    bool bcast_packed = ropts.get<Option::BcastPacked>( false );
+    bool bcast_partitioned = ropts.get<Option::BcastPartitioned>( false );
+    bool progress_thread = ropts.get<Option::ProgressThread>( false );
+    Checkpoint* checkpoint = ropts.get<Option::Checkpoint>( nullptr );
+    BcastPrecision bcast_precision = ropts.get<Option::BcastPrecision>(
+                                         BcastPrecision::Native );
+    QueuePriority queue_priority = ropts.get<Option::QueuePriority>(
+                                       QueuePriority::Lookahead );
+    ComputePrecision compute_precision = ropts.get<Option::ComputePrecision>(
+                                             ComputePrecision::Native );
+    // With Devices, factor diagonal tiles on the device by default.
+    Target panel_target = ropts.get<Option::PanelTarget>( target );
+    Counters* counters = ropts.get<Option::Counters>( nullptr );
+    PanelCallback* panel_callback = ropts.get<Option::PanelCallback>( nullptr );
+    bool device_stealing = ropts.get<Option::DeviceStealing>( false );
+    if (target != Target::Devices)
+        panel_target = Target::HostTask;
+    int64_t sub_tile = ropts.get<Option::PanelSubTile>( 0 );
+    // With Hybrid, the host updates part of each trailing submatrix.
+    internal::HybridSplit hybrid(
+        target == Target::Devices
+        && ropts.get<Option::Target>( target ) == Target::Hybrid );
+
+    // Computes on a row-major A in place, @see native_layout; reduced
+    // precision broadcasts and the hybrid host update are column-major.
+    // rhs is computed on in the same layout.
+    const Layout layout
+        = bcast_precision == BcastPrecision::Native && ! hybrid.enabled()
+        ? (rhs != nullptr ? internal::native_layout( target, A, *rhs )
+                          : internal::native_layout( target, A ))
+        : Layout::ColMajor;
 
     // if upper, change to lower
     if (A.uplo() == Uplo::Upper) {
@@ -49,10 +180,34 @@ int64_t potrf(
     int64_t info = 0;
     int64_t A_nt = A.nt();
 
+    int64_t rhs_nt = 0;
+    if (rhs != nullptr) {
+        slate_assert( rhs->mt() == A_nt );
+        rhs_nt = rhs->nt();
+        checkpoint = nullptr;
+    }
+
     // OpenMP needs pointer types, but vectors are exception safe
     std::vector< uint8_t > column_vector(A_nt);
     uint8_t* column = column_vector.data();
     SLATE_UNUSED( column ); // Used only by OpenMP
+    uint8_t rhs_dep;
+    SLATE_UNUSED( rhs_dep ); // Used only by OpenMP
+    uint8_t callback_dep;
+    SLATE_UNUSED( callback_dep ); // Used only by OpenMP
+
+    // rhs uses tag nt, unused by A's broadcasts, protected by rhs_dep.
+    const int tag_rhs = A_nt;
+
+    // Blocks of block columns of the trailing update, one task each.
+    // Devices update it in one task, batched on one queue.
+    int64_t trailing_block = ropts.get<Option::TrailingBlock>( 1 );
+    if (target == Target::Devices)
+        trailing_block = A_nt;
+    internal::ColumnBlocks blocks( A_nt, trailing_block );
+
+    // Lookahead depth of each step, fixed or adapted at runtime.
+    internal::AdaptiveLookahead adaptive( lookahead, max_lookahead );
 
     // Allocate batch arrays = number of kernels without lookahead + lookahead
     // number of kernels without lookahead = 3
@@ -63,13 +218,28 @@ int64_t potrf(
     // the number of kernels without lookahead, and then incremented by 1
     // for every execution for the internal::herk
     const int64_t batch_size_default = 0;
-    int num_queues = 3 + lookahead;  // Number of kernels with lookahead
+    int num_queues = 3 + adaptive.max();  // Number of kernels with lookahead
     using lapack::device_info_int;
     std::vector< device_info_int* > device_info_array( A.num_devices(), nullptr );
 
     if (target == Target::Devices) {
         A.allocateBatchArrays( batch_size_default, num_queues );
-        A.reserveDeviceWorkspace();
+        // The panel uses queues 1 and 2; lookahead columns 3, ...;
+        // the trailing update queue 0.
+        A.setComputeQueuePriorities( queue_priority, 1, num_queues );
+        A.setDeviceStealing( device_stealing );
+        // Reserve the planned workspace once, up front.
+        plan::Workspace workspace = plan::potrf( A, opts, target );
+        if (cache_tiles > 0)
+            A.enableTileCache( cache_tiles );
+        else
+            A.reserveDeviceWorkspace( workspace.device_tiles );
+        if (workspace.host_tiles > 0)
+            A.reserveHostWorkspace( workspace.host_tiles );
+        if (rhs != nullptr) {
+            rhs->allocateBatchArrays( batch_size_default, 1 );
+            rhs->reserveDeviceWorkspace();
+        }
 
         // Allocate
         for (int64_t dev = 0; dev < A.num_devices(); ++dev) {
@@ -77,39 +247,127 @@ int64_t potrf(
             device_info_array[dev] = blas::device_malloc<device_info_int>( 1, *queue );
         }
     }
+    // The trailing and lookahead updates may use a lower compute
+    // precision; the panel queues stay native.
+    A.setComputePrecisions( compute_precision, queue_0, queue_0 + 1 );
+    A.setComputePrecisions( compute_precision, 3, num_queues );
 
     // set min number for omp nested active parallel regions
     slate::OmpSetMaxActiveLevels set_active_levels( MinOmpActiveLevels );
 
+    // Continue from the last checkpoint, if any.
+    int64_t k_start = 0;
+    if (checkpoint != nullptr) {
+        k_start = checkpoint->restore( A, nullptr, &info );
+        adaptive.resume( k_start );
+        // The restored columns are final.
+        if (panel_callback != nullptr) {
+            for (int64_t k = 0; k < k_start; ++k)
+                (*panel_callback)( k );
+        }
+    }
+
+    // Drive panel broadcasts while the trailing update runs.
+    internal::ProgressThread progress( progress_thread );
+
     #pragma omp parallel
     #pragma omp master
     {
         int64_t kk = 0;  // column index (not block-column)
-        for (int64_t k = 0; k < A_nt; ++k) {
+        for (int64_t k = 0; k < k_start; ++k)
+            kk += A.tileNb( k );
+        int64_t la_prev = 0;  // lookahead of step k-1
+        int64_t prefetched = k_start;  // panels read ahead
+        for (int64_t k = k_start; k < A_nt; ++k) {
+            // Checkpoint steps 0, ..., k-1, written while steps k, ...
+            // compute.
+            if (checkpoint != nullptr && k > k_start
+                && checkpoint->due( k )) {
+                #pragma omp taskwait
+                checkpoint->save( A, nullptr, k, info );
+            }
+
+            // Flops of the panel and of a trailing column, to predict times.
+            int64_t nk = A.n() - kk;
+            int64_t nbk = A.tileNb( k );
+            double panel_flops = lapack::Gflop<scalar_t>::potrf( nbk ) * 1e9
+                + blas::Gflop<scalar_t>::trsm( Side::Right, nk - nbk, nbk ) * 1e9;
+            double col_flops = blas::Gflop<scalar_t>::gemm( nk - nbk, nbk, nbk ) * 1e9;
+            adaptive.wait( k );
+            int64_t la = adaptive.step( k, panel_flops,
+                                        col_flops * (A_nt - k - 1) / 2 );
+
+            // For out-of-core matrices, read the lookahead panels and the
+            // panel after them while the trailing matrix is updated.
+            for (; prefetched <= k+1+la && prefetched < A_nt; ++prefetched) {
+                A.sub( prefetched, A_nt-1, prefetched, prefetched )
+                    .prefetchMapped();
+            }
+
             // Panel, normal priority
             #pragma omp task depend(inout:column[k]) priority( priority_0 ) \
                 shared( info )
             {
+                trace::Block trace_block( "potrf::panel", k );
+                double panel_time = omp_get_wtime();
+
                 // factor A(k, k)
                 int64_t iinfo;
-                if (target == Target::Devices) {
-                    iinfo = internal::potrf<target>(
-                        A.sub(k, k), priority_0, queue_2,
-                        device_info_array[ A.tileDevice( k, k ) ] );
-                }
-                else {
-                    iinfo = internal::potrf<target>(
-                        A.sub(k, k), priority_0, queue_2 );
+                {
+                    internal::CounterPhase c_panel(
+                        counters, "potrf::panel",
+                        lapack::Gflop<scalar_t>::potrf( nbk ) * 1e9 );
+                    if (panel_target == Target::Devices) {
+                        iinfo = internal::potrf<Target::Devices>(
+                            A.sub(k, k), priority_0, queue_2,
+                            device_info_array[ A.tileDevice( k, k ) ] );
+                    }
+                    else {
+                        iinfo = internal::potrf<Target::HostTask>(
+                            A.sub(k, k), priority_0, queue_2, nullptr,
+                            sub_tile );
+                    }
                 }
                 if (iinfo != 0 && info == 0)
                     info = kk + iinfo;
 
-                // send A(k, k) down col A(k+1:nt-1, k)
-                if (k+1 <= A_nt-1)
-                    A.tileBcast(k, k, A.sub(k+1, A_nt-1, k, k), layout);
+                // send A(k, k) down col A(k+1:nt-1, k),
+                // and across row rhs(k, :)
+                if (rhs != nullptr) {
+                    trace::Block trace_block_bcast( "potrf::bcast", k );
+                    internal::CounterPhase c_bcast( counters, "potrf::bcast" );
+                    BcastList bcast_list_kk;
+                    if (k+1 <= A_nt-1) {
+                        bcast_list_kk.push_back(
+                            {k, k, {A.sub(k+1, A_nt-1, k, k),
+                                    rhs->sub(k, k, 0, rhs_nt-1)}});
+                    }
+                    else {
+                        bcast_list_kk.push_back(
+                            {k, k, {rhs->sub(k, k, 0, rhs_nt-1)}});
+                    }
+                    A.template listBcast<target>( bcast_list_kk, layout );
+                }
+                else if (k+1 <= A_nt-1) {
+                    trace::Block trace_block_bcast( "potrf::bcast", k );
+                    internal::CounterPhase c_bcast( counters, "potrf::bcast" );
+                    if (panel_target == Target::Devices) {
+                        // With GPU-aware MPI or NCCL, A(k, k) goes from
+                        // device to device, skipping the host; the copies
+                        // to local devices are queued asynchronously.
+                        A.template tileBcast<Target::Devices>(
+                            k, k, A.sub(k+1, A_nt-1, k, k), layout );
+                    }
+                    else {
+                        A.tileBcast(k, k, A.sub(k+1, A_nt-1, k, k), layout);
+                    }
+                }
 
                 // A(k+1:nt-1, k) * A(k, k)^{-H}
                 if (k+1 <= A_nt-1) {
+                    internal::CounterPhase c_panel(
+                        counters, "potrf::panel",
+                        panel_flops - lapack::Gflop<scalar_t>::potrf( nbk ) * 1e9 );
                     auto Akk = A.sub(k, k);
                     auto Tkk = TriangularMatrix< scalar_t >(Diag::NonUnit, Akk);
                     internal::trsm<target>(
@@ -123,28 +381,82 @@ int64_t potrf(
                 for (int64_t i = k+1; i < A_nt; ++i) {
                     // send A(i, k) across row A(i, k+1:i) and
                     //                down col A(i:nt-1, i) with msg tag i
-                    bcast_list_A.push_back({i, k, {A.sub(i, i, k+1, i),
-                                                   A.sub(i, A_nt-1, i, i)},
-                                            i});
+                    if (rhs != nullptr) {
+                        // and across row rhs(i, :)
+                        bcast_list_A.push_back({i, k, {A.sub(i, i, k+1, i),
+                                                       A.sub(i, A_nt-1, i, i),
+                                                       rhs->sub(i, i, 0, rhs_nt-1)},
+                                                i});
+                    }
+                    else {
+                        bcast_list_A.push_back({i, k, {A.sub(i, i, k+1, i),
+                                                       A.sub(i, A_nt-1, i, i)},
+                                                i});
+                    }
                 }
 
-                A.template listBcastMT<target>(
-                  bcast_list_A, layout);
+                trace::Block trace_block_bcast( "potrf::bcast", k );
+                internal::CounterPhase c_bcast( counters, "potrf::bcast" );
+                // Packed broadcasts are only to tiles of A.
+                if (rhs == nullptr
+                    && (bcast_packed || bcast_partitioned
+                        || bcast_precision != BcastPrecision::Native))
+                    A.template listBcastPacked<target>(
+                        bcast_list_A, layout, false, bcast_precision,
+                        bcast_partitioned );
+                else
+                    A.template listBcastMT<target>( bcast_list_A, layout );
+
+                adaptive.panelDone( k, panel_flops,
+                                    omp_get_wtime() - panel_time );
             }
 
-            // update trailing submatrix, normal priority
-            if (k+1+lookahead < A_nt) {
+            // update trailing submatrix, normal priority,
+            // one task per block of block columns
+            for (int64_t c = blocks.block( k+1+la );
+                 k+1+la < A_nt && c < blocks.count(); ++c) {
+                int64_t j1 = blocks.first( c, k+1+la );
+                int64_t j2 = blocks.last( c );
                 #pragma omp task depend(in:column[k]) \
-                                 depend(inout:column[k+1+lookahead]) \
-                                 depend(inout:column[A_nt-1])
+                                 depend(inout:column[j1]) \
+                                 depend(inout:column[j2])
                 {
-                    // A(kl+1:nt-1, kl+1:nt-1) -=
-                    //     A(kl+1:nt-1, k) * A(kl+1:nt-1, k)^H
-                    // where kl = k + lookahead
-                    internal::herk<target>(
-                        real_t(-1.0), A.sub(k+1+lookahead, A_nt-1, k, k),
-                        real_t( 1.0), A.sub(k+1+lookahead, A_nt-1),
-                        priority_0, queue_0, layout );
+                    trace::Block trace_block( "potrf::trailing", k );
+                    internal::CounterPhase c_update(
+                        counters, "potrf::update",
+                        col_flops * (j2 - j1 + 1) * (2*A_nt - j1 - j2)
+                            / (2.0 * (A_nt - k)) );
+                    double update_time = omp_get_wtime();
+
+                    if (hybrid.enabled()) {
+                        // One block: j1 = k+1+la, j2 = nt-1.
+                        potrf_trailing_hybrid(
+                            A, k, j1, hybrid, priority_0, queue_0 );
+                    }
+                    else {
+                        // A(j1:j2, j1:j2) -= A(j1:j2, k) * A(j1:j2, k)^H
+                        internal::herk<target>(
+                            real_t(-1.0), A.sub(j1, j2, k, k),
+                            real_t( 1.0), A.sub(j1, j2),
+                            priority_0, queue_0, layout );
+
+                        // A(j2+1:nt-1, j1:j2) -=
+                        //     A(j2+1:nt-1, k) * A(j1:j2, k)^H
+                        if (j2+1 <= A_nt-1) {
+                            auto Ajk = A.sub(j1, j2, k, k);
+                            internal::gemm<target>(
+                                -one, A.sub(j2+1, A_nt-1, k, k),
+                                      conj_transpose( Ajk ),
+                                one,  A.sub(j2+1, A_nt-1, j1, j2),
+                                layout, priority_0, queue_0 );
+                        }
+                    }
+
+                    // Columns j1:j2 of the trailing triangle.
+                    adaptive.updateDone(
+                        col_flops * (j2 - j1 + 1) * (2*A_nt - j1 - j2)
+                            / (2.0 * (A_nt - k)),
+                        omp_get_wtime() - update_time );
                 }
             }
 
@@ -153,10 +465,21 @@ int64_t potrf(
             // lookahead base index (i.e, number of kernels without lookahead),
             // which is equal to "2" for slate::potrf, and then the variable is
             // incremented with every lookahead column "j" ( j-k+1 = 2+j-(k+1) )
-            for (int64_t j = k+1; j < k+1+lookahead && j < A_nt; ++j) {
+            for (int64_t j = k+1; j < k+1+la && j < A_nt; ++j) {
+                // If the lookahead grew, column j was in the trailing
+                // submatrix of step k-1, whose task on the block of j
+                // depends on its first column.
+                int64_t j_trail = (k > 0 && j > k + la_prev)
+                                ? blocks.sentinel( j, k + la_prev ) : k;
                 #pragma omp task depend(in:column[k]) \
+                                 depend(in:column[j_trail]) \
                                  depend(inout:column[j])
                 {
+                    trace::Block trace_block( "potrf::lookahead", k );
+                    internal::CounterPhase c_update(
+                        counters, "potrf::update", col_flops );
+                    double update_time = omp_get_wtime();
+
                     // A(j, j) -= A(j, k) * A(j, k)^H
                     int queue_jk2 = j-k+2;
                     internal::herk<target>(
@@ -173,6 +496,48 @@ int64_t potrf(
                             one,  A.sub(j+1, A_nt-1, j, j),
                             layout, priority_0, queue_jk2 );
                     }
+
+                    adaptive.updateDone( col_flops,
+                                         omp_get_wtime() - update_time );
+                }
+            }
+
+            // update rhs, as the trailing columns, normal priority
+            if (rhs != nullptr) {
+                #pragma omp task depend(in:column[k]) depend(inout:rhs_dep)
+                {
+                    trace::Block trace_block( "potrf::rhs", k );
+
+                    // solve A(k, k) rhs(k, :) = rhs(k, :)
+                    auto Akk = A.sub(k, k);
+                    auto Tkk = TriangularMatrix< scalar_t >(Diag::NonUnit, Akk);
+                    internal::trsm<target>(
+                        Side::Left,
+                        one, std::move( Tkk ), rhs->sub(k, k, 0, rhs_nt-1),
+                        priority_0, layout, queue_0 );
+
+                    if (k+1 <= A_nt-1) {
+                        // send rhs(k, j) down col rhs(k+1:nt-1, j)
+                        BcastList bcast_list_B;
+                        for (int64_t j = 0; j < rhs_nt; ++j) {
+                            bcast_list_B.push_back(
+                                {k, j, {rhs->sub(k+1, A_nt-1, j, j)}});
+                        }
+                        rhs->template listBcast<target>(
+                            bcast_list_B, layout, tag_rhs );
+
+                        // rhs(k+1:nt-1, :) -= A(k+1:nt-1, k) * rhs(k, :)
+                        internal::gemm<target>(
+                            -one, A.sub(k+1, A_nt-1, k, k),
+                                  rhs->sub(k, k, 0, rhs_nt-1),
+                            one,  rhs->sub(k+1, A_nt-1, 0, rhs_nt-1),
+                            layout, priority_0, queue_0 );
+                    }
+
+                    auto rhs_row = rhs->sub( k, k, 0, rhs_nt-1 );
+                    rhs_row.releaseRemoteWorkspace();
+                    rhs_row.tileUpdateAllOrigin();
+                    rhs_row.releaseLocalWorkspace();
                 }
             }
 
@@ -189,15 +554,37 @@ int64_t potrf(
 
                 // Erase local workspace on devices.
                 panel.releaseLocalWorkspace();
+
+                // The panel is done; let the OS write it back to the file.
+                panel.flushMapped();
+            }
+
+            // Column k is final, on the host; report it, in order.
+            if (panel_callback != nullptr) {
+                #pragma omp task depend(in:column[k]) \
+                                 depend(inout:callback_dep) priority( priority_0 )
+                {
+                    (*panel_callback)( k );
+                }
             }
             kk += A.tileNb( k );
+            la_prev = la;
         }
     }
     A.tileUpdateAllOrigin();
+    if (rhs != nullptr) {
+        rhs->tileUpdateAllOrigin();
+        rhs->releaseWorkspace();
+    }
 
     if (hold_local_workspace == false) {
         A.releaseWorkspace();
     }
+    if (cache_tiles > 0) {
+        A.disableTileCache();
+    }
+    A.setComputePrecisions( ComputePrecision::Native, 0, num_queues );
+    A.setDeviceStealing( false );
     if (target == Target::Devices) {
         for (int64_t dev = 0; dev < A.num_devices(); ++dev) {
             blas::Queue* queue = A.comm_queue(dev);
@@ -205,10 +592,300 @@ int64_t potrf(
         }
     }
 
-    internal::reduce_info( &info, A.mpiComm() );
+    if (checkpoint != nullptr)
+        checkpoint->remove( A.mpiComm() );
+
+    internal::reduce_info( &info, A.mpiComm(), opts );
     return info;
 }
 
+//------------------------------------------------------------------------------
+/// Distributed parallel Cholesky factorization, scheduled by the
+/// work-stealing runtime with a tile-level DAG (TaskRuntime::WorkStealing).
+/// Host only. Unlike the OpenMP version, which updates the trailing matrix
+/// of step k in one task, each trailing tile is its own task, so tiles of
+/// step k+1 can start as soon as the panel k+1 is sent, before all of
+/// step k finishes. Broadcasts are chained in order on all ranks, as the
+/// OpenMP version's panels are, so MPI tags are used in the same order.
+/// @ingroup posv_impl
+///
+template <typename scalar_t>
+int64_t potrf_graph(
+    HermitianMatrix<scalar_t> A,
+    Options const& opts )
+{
+    using real_t = blas::real_type<scalar_t>;
+    using BcastListTag = typename Matrix<scalar_t>::BcastListTag;
+    using Key = internal::TaskGraph::Key;
+
+    // Constants
+    const scalar_t one = 1.0;
+    const int priority_0 = 0;
+    const int priority_1 = 1;
+    const int priority_2 = 2;
+    const Layout layout = Layout::ColMajor;
+
+    // Options
+    int64_t lookahead = get_lookahead( opts );
+    bool hold_local_workspace = get_option<Option::HoldLocalWorkspace>( opts, false );
+    bool bcast_packed = get_option<Option::BcastPacked>( opts, false );
+    bool bcast_partitioned = get_option<Option::BcastPartitioned>( opts, false );
+    bool progress_thread = get_option<Option::ProgressThread>( opts, false );
+    BcastPrecision bcast_precision = get_option<Option::BcastPrecision>(
+                                         opts, BcastPrecision::Native );
+    int64_t sub_tile = get_option<Option::PanelSubTile>( opts, 0 );
+
+    // if upper, change to lower
+    if (A.uplo() == Uplo::Upper) {
+        A = conj_transpose( A );
+    }
+
+    int64_t info = 0;
+    int64_t A_nt = A.nt();
+
+    // Dependency keys: tile A(i, j); column k of L broadcast;
+    // and the chain of broadcasts.
+    auto tile  = []( int64_t i, int64_t j ) { return Key{ 'A', i, j }; };
+    auto panel = []( int64_t k ) { return Key{ 'P', k, 0 }; };
+    const Key comm = { 'C', 0, 0 };
+
+    // set min number for omp nested active parallel regions
+    slate::OmpSetMaxActiveLevels set_active_levels( MinOmpActiveLevels );
+
+    // Drive panel broadcasts while the trailing update runs.
+    internal::ProgressThread progress( progress_thread );
+
+    internal::TaskGraph graph;
+    graph.run( [&]( internal::TaskGraph& g ) {
+        int64_t kk = 0;  // column index (not block-column)
+        for (int64_t k = 0; k < A_nt; ++k) {
+            // factor A(k, k), on all ranks so each traces the step
+            g.add( priority_2, {}, { tile( k, k ) }, [&, k, kk] {
+                trace::Block trace_block( "potrf::panel", k );
+                int64_t iinfo = internal::potrf<Target::HostTask>(
+                    A.sub( k, k ), priority_1, 0, nullptr, sub_tile );
+                if (iinfo != 0 && info == 0)
+                    info = kk + iinfo;
+            });
+
+            if (k+1 <= A_nt-1) {
+                // send A(k, k) down col A(k+1:nt-1, k)
+                g.add( priority_2, {}, { tile( k, k ), comm }, [&, k] {
+                    trace::Block trace_block( "potrf::bcast", k );
+                    A.tileBcast( k, k, A.sub( k+1, A_nt-1, k, k ), layout );
+                });
+
+                // A(i, k) * A(k, k)^{-H}, one task per local tile
+                std::vector<Key> col_k;
+                for (int64_t i = k+1; i < A_nt; ++i) {
+                    if (A.tileIsLocal( i, k )) {
+                        col_k.push_back( tile( i, k ) );
+                        g.add( priority_2, { tile( k, k ) }, { tile( i, k ) },
+                               [&, i, k] {
+                            trace::Block trace_block( "potrf::trsm", k );
+                            auto Akk = A.sub( k, k );
+                            auto Tkk = TriangularMatrix< scalar_t >(
+                                           Diag::NonUnit, Akk );
+                            internal::trsm<Target::HostTask>(
+                                Side::Right,
+                                one, conj_transpose( Tkk ),
+                                A.sub( i, i, k, k ),
+                                priority_1, layout );
+                        });
+                    }
+                }
+
+                // send A(i, k) across row A(i, k+1:i) and
+                //                down col A(i:nt-1, i) with msg tag i
+                g.add( priority_2, col_k, { comm, panel( k ) }, [&, k] {
+                    trace::Block trace_block( "potrf::bcast", k );
+                    BcastListTag bcast_list_A;
+                    for (int64_t i = k+1; i < A_nt; ++i) {
+                        bcast_list_A.push_back({i, k, {A.sub(i, i, k+1, i),
+                                                       A.sub(i, A_nt-1, i, i)},
+                                                i});
+                    }
+                    if (bcast_packed || bcast_partitioned
+                        || bcast_precision != BcastPrecision::Native)
+                        A.template listBcastPacked<Target::HostTask>(
+                            bcast_list_A, layout, false, bcast_precision,
+                            bcast_partitioned );
+                    else
+                        A.template listBcastMT<Target::HostTask>(
+                            bcast_list_A, layout );
+                });
+
+                // update local tiles of the trailing matrix, one task per
+                // tile; lookahead columns first
+                for (int64_t j = k+1; j < A_nt; ++j) {
+                    int priority = j < k+1+lookahead ? priority_1 : priority_0;
+                    for (int64_t i = j; i < A_nt; ++i) {
+                        if (! A.tileIsLocal( i, j ))
+                            continue;
+                        g.add( priority, { panel( k ) }, { tile( i, j ) },
+                               [&, i, j, k, priority] {
+                            trace::Block trace_block(
+                                j < k+1+lookahead ? "potrf::lookahead"
+                                                  : "potrf::trailing", k );
+                            if (i == j) {
+                                // A(j, j) -= A(j, k) * A(j, k)^H
+                                internal::herk<Target::HostTask>(
+                                    real_t(-1.0), A.sub( j, j, k, k ),
+                                    real_t( 1.0), A.sub( j, j ),
+                                    priority, 0, layout );
+                            }
+                            else {
+                                // A(i, j) -= A(i, k) * A(j, k)^H
+                                auto Ajk = A.sub( j, j, k, k );
+                                internal::gemm<Target::HostTask>(
+                                    -one, A.sub( i, i, k, k ),
+                                          conj_transpose( Ajk ),
+                                    one,  A.sub( i, i, j, j ),
+                                    layout, priority );
+                            }
+                        });
+                    }
+                }
+            }
+
+            // after all updates by column k, erase its remote tiles
+            g.add( priority_0, {}, { panel( k ) }, [&, k] {
+                auto panel_k = A.sub( k, A_nt-1, k, k );
+                panel_k.releaseRemoteWorkspace();
+                panel_k.tileUpdateAllOrigin();
+                panel_k.releaseLocalWorkspace();
+            });
+            kk += A.tileNb( k );
+        }
+    });
+
+    A.tileUpdateAllOrigin();
+    if (hold_local_workspace == false) {
+        A.releaseWorkspace();
+    }
+
+    internal::reduce_info( &info, A.mpiComm(), opts );
+    return info;
+}
+
+//------------------------------------------------------------------------------
+/// Small-problem fast path of potrf: the rank owning all tiles of A gathers
+/// them and calls LAPACK potrf, without tasks.
+/// @see internal::small_path
+///
+template <typename scalar_t>
+int64_t potrf_small(
+    HermitianMatrix<scalar_t> A, int owner, Options const& opts )
+{
+    // if upper, change to lower
+    if (A.uplo() == Uplo::Upper) {
+        A = conj_transpose( A );
+    }
+
+    int64_t info = 0;
+    if (A.mpiRank() == owner) {
+        int64_t n = A.n();
+        int64_t lda = std::max( n, int64_t( 1 ) );
+        std::vector<scalar_t> Adata( lda*n );
+        internal::small_gather( A, Adata.data(), lda );
+        info = lapack::potrf( Uplo::Lower, n, Adata.data(), lda );
+        internal::small_scatter( A, Adata.data(), lda );
+    }
+
+    internal::reduce_info( &info, A.mpiComm(), opts );
+    return info;
+}
+
+//------------------------------------------------------------------------------
+/// Forward substitution B = L^{-1} B, or U^{-H} B if A is upper, with the
+/// factor of potrf, for the paths that don't apply it during the
+/// factorization.
+/// @ingroup posv_impl
+///
+template <typename scalar_t>
+void potrf_forward(
+    HermitianMatrix<scalar_t>& A, Matrix<scalar_t>& B,
+    Options const& opts )
+{
+    const scalar_t one = 1.0;
+
+    auto A_ = A;  // local shallow copy to transpose
+    if (A_.uplo() == Uplo::Upper)
+        A_ = conj_transpose( A_ );
+
+    auto L = TriangularMatrix<scalar_t>( Diag::NonUnit, A_ );
+    trsm( Side::Left, one, L, B, opts );
+}
+
+//------------------------------------------------------------------------------
+/// Runs the potrf path selected by opts.
+/// If rhs is not null, also applies the forward substitution
+/// rhs = L^{-1} rhs, during the factorization where the path allows.
+/// @see slate::potrf
+///
+template <typename scalar_t>
+int64_t potrf_method(
+    HermitianMatrix<scalar_t>& A,
+    Options const& opts_tuned, Matrix<scalar_t>* rhs = nullptr )
+{
+    using internal::TargetType;
+
+    Target target = get_option<Option::Target>( opts_tuned, Target::HostTask );
+    TaskRuntime runtime = get_option<Option::TaskRuntime>(
+                              opts_tuned, TaskRuntime::OpenMP );
+    bool checkpoint = get_option<Option::Checkpoint>( opts_tuned, nullptr )
+                      != nullptr;
+
+    // Paths without a fused solve factor, then solve; all the columns
+    // are final together.
+    PanelCallback* panel_callback = get_option<Option::PanelCallback>(
+                                        opts_tuned, nullptr );
+    auto factor_forward = [&]( int64_t info ) {
+        if (rhs != nullptr)
+            potrf_forward( A, *rhs, opts_tuned );
+        if (panel_callback != nullptr) {
+            for (int64_t k = 0; k < A.nt(); ++k)
+                (*panel_callback)( k );
+        }
+        return info;
+    };
+
+    int owner;
+    if (! checkpoint
+        && internal::small_path<scalar_t>( { &A }, opts_tuned, &owner ))
+        return factor_forward( impl::potrf_small( A, owner, opts_tuned ) );
+
+    if (runtime == TaskRuntime::WorkStealing && target != Target::Devices
+        && target != Target::Hybrid && ! checkpoint)
+        return factor_forward( impl::potrf_graph( A, opts_tuned ) );
+
+    if (rhs != nullptr && checkpoint) {
+        int64_t info = potrf_method( A, opts_tuned );
+        potrf_forward( A, *rhs, opts_tuned );
+        return info;
+    }
+
+    // Sub-matrices of a non-owning view of A don't update the reference
+    // count of its storage, which the tasks of each step would contend on.
+    auto A_view = internal::nonowning_view( A );
+
+    switch (target) {
+        case Target::Host:
+        case Target::HostNest:
+        case Target::HostBatch:
+        case Target::HostTask:
+            return impl::potrf( TargetType<Target::HostTask>(), A_view,
+                                opts_tuned, rhs );
+
+        case Target::Devices:
+        case Target::Hybrid:
+            // Hybrid runs as Devices, splitting the trailing updates.
+            return impl::potrf( TargetType<Target::Devices>(), A_view,
+                                opts_tuned, rhs );
+    }
+    return -2;  // shouldn't happen
+}
+
 } // namespace impl
 
 //------------------------------------------------------------------------------
@@ -229,6 +906,15 @@ int64_t potrf(
 ///
 /// Complexity (in real): $\approx \frac{1}{3} n^{3}$ flops.
 ///
+/// If $A$ tracks structurally zero tiles, e.g., for block-arrow matrices,
+/// zero tiles of $L$ or $U$ are neither broadcast nor used in the trailing
+/// updates, and tiles filled in by the updates are no longer zero;
+/// @see BaseMatrix::trackZeroTiles.
+///
+/// If $A$ is out-of-core, with tiles inserted by insertLocalTilesMapped,
+/// the panel after the lookahead panels is prefetched from the file while
+/// the trailing matrix is updated, and each finished panel is flushed.
+///
 //------------------------------------------------------------------------------
 /// @tparam scalar_t
 ///     One of float, double, std::complex<float>, std::complex<double>.
@@ -240,16 +926,120 @@ int64_t potrf(
 ///     If scalar_t is real, $A$ can be a SymmetricMatrix object.
 ///
 /// @param[in] opts
-///     Additional options, as map of name = value pairs. Possible options:
+///     Additional options, as map of name = value pairs.
+///     InnerBlocking, Lookahead, and MaxPanelThreads not set are taken
+///     from the tuning database, if it has an entry (@see TuningDB).
+///     Possible options:
 ///     - Option::Lookahead:
 ///       Number of panels to overlap with matrix updates.
 ///       lookahead >= 0. Default 1.
+///       LookaheadAuto adapts it at each step from measured panel and
+///       update times, growing as the trailing matrix shrinks.
+///     - Option::MaxLookahead:
+///       Max lookahead for LookaheadAuto. Each panel in flight holds
+///       workspace for a block-column of remote tiles. Default 4.
+///     - Option::Counters:
+///       Pointer to Counters to collect performance counters in, for
+///       phases "potrf", and, with TaskRuntime::OpenMP, "potrf::panel"
+///       (potrf of the diagonal tile and trsm of the column),
+///       "potrf::bcast", and "potrf::update" (lookahead and trailing
+///       updates). Default null: off.
+///
+///     - Option::Checkpoint:
+///       Pointer to Checkpoint to checkpoint the factorization in, and
+///       restart it from, every interval block steps (@see Checkpoint).
+///       Uses TaskRuntime::OpenMP. Default null: off.
+///
 ///     - Option::Target:
 ///       Implementation to target. Possible values:
 ///       - HostTask:  OpenMP tasks on CPU host [default].
 ///       - HostNest:  nested OpenMP parallel for loop on CPU host.
 ///       - HostBatch: batched BLAS on CPU host.
 ///       - Devices:   batched BLAS on GPU device.
+///       - Hybrid:    as Devices, but the host updates the last
+///         block-columns of each trailing submatrix while the devices
+///         update the rest, with the split balanced at each step by the
+///         measured host and device rates.
+///     - Option::HostWorkspaceTiles:
+///       Number of host workspace tiles to reserve, in pinned memory,
+///       for staging transfers to and from GPU devices. Default 0.
+///     - Option::DeviceCacheTiles:
+///       If > 0, max number of tiles per device for each matrix, using
+///       device memory as a least-recently-used tile cache, to handle
+///       matrices larger than device memory. Default 0.
+///     - Option::BcastPrecision:
+///       Precision in which panels are broadcast, e.g., BFloat16.
+///       Receivers update with rounded copies of the panels, so use a
+///       lower precision only where an approximate factorization suffices,
+///       e.g., as a preconditioner. Default Native.
+///     - Option::QueuePriority:
+///       Stream priorities of the device compute queues.
+///       - Lookahead: panel and lookahead kernels on high priority
+///         streams, preempting the trailing update [default].
+///       - Uniform: all queues at the default priority.
+///     - Option::ComputePrecision:
+///       Compute mode of the trailing and lookahead updates.
+///       - Native: full precision [default].
+///       - TF32: single precision herk and gemm may use TF32 tensor cores
+///         on devices, rounding their inputs to 11-bit significands.
+///         The diagonal potrf and panel trsm stay in full precision.
+///       - Complex3M: the complex gemm updates use the 3M algorithm, 25%
+///         fewer flops, on the host and, with cuBLAS, on devices; herk
+///         stays native. Its error is bounded normwise, but small
+///         imaginary parts of the updates lose relative accuracy.
+///     - Option::PanelTarget:
+///       Where to factor diagonal tiles with Target::Devices.
+///       - Devices: on the tile's device with LAPACK's device potrf,
+///         broadcasting it device to device with GPU-aware MPI or NCCL
+///         [default].
+///       - HostTask: on the host, e.g., if the device potrf is slower
+///         for small tiles.
+///       The panel trsm always runs on the devices.
+///     - Option::DeviceStealing:
+///       With Target::Devices and several devices per rank, whether each
+///       batched trailing and lookahead update balances its local tiles
+///       across the devices, instead of updating each tile on its
+///       tileDevice, so devices whose tiles of the shrinking trailing
+///       matrix are done take tiles from the others. Stolen tiles move by
+///       peer copies where available and stay coherent by the MOSI
+///       protocol. Default false.
+///     - Option::TaskRuntime:
+///       Task runtime for host targets. Possible values:
+///       - OpenMP: OpenMP tasks with block-column dependencies [default].
+///       - WorkStealing: work-stealing scheduler with tile dependencies,
+///         so trailing tiles can run ahead to later steps.
+///       Devices always use OpenMP.
+///     - Option::SmallTiles:
+///       With a host target, if A has at most this many tiles, all on one
+///       rank, that rank calls LAPACK potrf on A directly, without tasks.
+///       0: off. Default 4.
+///     - Option::TrailingBlock:
+///       Number of block columns per task of the trailing update, with
+///       host targets. Each block waits only for its own updates of
+///       previous steps, so the trailing update of step k overlaps with
+///       the panel of step k+1. Default 1; >= nt gives one task, as with
+///       Target::Devices.
+///     - Option::PanelSubTile:
+///       With the diagonal tiles factored on the host, size of the
+///       sub-tiles on which to factor each one, as a tiled Cholesky with
+///       one task per sub-tile trsm and block column of its update. The
+///       sub-tiles are views of the tile data, so large tiles keep the
+///       trailing gemm efficient while the panel, on the critical path,
+///       runs in parallel. 0: off, one LAPACK potrf per tile [default].
+///
+///     - Option::PanelCallback:
+///       Pointer to PanelCallback to call on each rank as each block
+///       column of L, or block row of U, is final, from a low-priority
+///       task, so the application can use it while the factorization
+///       continues (@see PanelCallback). The small path and
+///       TaskRuntime::WorkStealing call it for all columns at the end.
+///       Default null: off.
+///
+///     - Option::InfoRequest:
+///       Pointer to InfoRequest in which to reduce info over the ranks
+///       without blocking (@see InfoRequest). The routine then returns
+///       this rank's info, and InfoRequest::wait() the reduced info.
+///       Default null: blocking reduction.
 ///
 /// @return 0: successful exit
 /// @return i > 0: the leading minor of order $i$ of $A$ is not
@@ -263,21 +1053,78 @@ int64_t potrf(
     HermitianMatrix<scalar_t>& A,
     Options const& opts)
 {
-    using internal::TargetType;
+    // Options the caller didn't set come from the tuning database, if any.
+    Options tuned;
+    Options const& opts_tuned = internal::tuned_options( "potrf", A, opts, tuned );
 
-    Target target = get_option<Option::Target>( opts, Target::HostTask );
+    internal::CounterPhase c_potrf(
+        get_option<Option::Counters>( opts_tuned, nullptr ), "potrf",
+        lapack::Gflop<scalar_t>::potrf( A.n() ) * 1e9 );
 
-    switch (target) {
-        case Target::Host:
-        case Target::HostNest:
-        case Target::HostBatch:
-        case Target::HostTask:
-            return impl::potrf( TargetType<Target::HostTask>(), A, opts );
+    // potrf overwrites A, so remote copies kept by a workspace session are
+    // stale; its own broadcasts are of final tiles, and are kept.
+    A.invalidateWorkspaceSession();
 
-        case Target::Devices:
-            return impl::potrf( TargetType<Target::Devices>(), A, opts );
-    }
-    return -2;  // shouldn't happen
+    return impl::potrf_method( A, opts_tuned );
+}
+
+//------------------------------------------------------------------------------
+/// Distributed parallel Cholesky factorization, with forward substitution.
+///
+/// Computes the Cholesky factorization $A = L L^H$ or $A = U^H U$, as
+/// potrf does, and overwrites B with $L^{-1} B$ or $U^{-H} B$, so solving
+/// $A X = B$ only needs the backward substitution $L^H X = B$ or
+/// $U X = B$ after it.
+///
+/// Step k of the factorization solves block row k of B and updates the
+/// rows below it, as extra trailing columns: B reuses the broadcasts of
+/// the panels of L, saving a pass over L and its broadcasts. With
+/// the small path, TaskRuntime::WorkStealing, or Checkpoint, B is solved
+/// after the factorization; packed broadcasts (BcastPacked,
+/// BcastPartitioned, BcastPrecision) are not used.
+///
+//------------------------------------------------------------------------------
+/// @tparam scalar_t
+///     One of float, double, std::complex<float>, std::complex<double>.
+//------------------------------------------------------------------------------
+/// @param[in,out] A
+///     On entry, the n-by-n Hermitian positive definite matrix $A$.
+///     On exit, if return value = 0, the factor $U$ or $L$ from the Cholesky
+///     factorization $A = U^H U$ or $A = L L^H$.
+///
+/// @param[in,out] B
+///     On entry, the n-by-nrhs right hand side matrix $B$, with the block
+///     rows of A and the same MPI communicator.
+///     On exit, $L^{-1} B$ or $U^{-H} B$; if return value > 0, undefined.
+///
+/// @param[in] opts
+///     Additional options, as map of name = value pairs, as for potrf.
+///
+/// @return 0: successful exit
+/// @return i > 0: the leading minor of order $i$ of $A$ is not
+///         positive definite, so the factorization could not
+///         be completed.
+///
+/// @ingroup posv_computational
+///
+template <typename scalar_t>
+int64_t potrf(
+    HermitianMatrix<scalar_t>& A,
+    Matrix<scalar_t>& B,
+    Options const& opts)
+{
+    slate_assert( B.mt() == A.mt() );
+
+    Options tuned;
+    Options const& opts_tuned = internal::tuned_options( "potrf", A, opts, tuned );
+
+    internal::CounterPhase c_potrf(
+        get_option<Option::Counters>( opts_tuned, nullptr ), "potrf",
+        lapack::Gflop<scalar_t>::potrf( A.n() ) * 1e9 );
+
+    A.invalidateWorkspaceSession();
+
+    return impl::potrf_method( A, opts_tuned, &B );
 }
 
 //------------------------------------------------------------------------------
@@ -302,4 +1149,28 @@ int64_t potrf< std::complex<double> >(
     HermitianMatrix< std::complex<double> >& A,
     Options const& opts);
 
+template
+int64_t potrf<float>(
+    HermitianMatrix<float>& A,
+    Matrix<float>& B,
+    Options const& opts);
+
+template
+int64_t potrf<double>(
+    HermitianMatrix<double>& A,
+    Matrix<double>& B,
+    Options const& opts);
+
+template
+int64_t potrf< std::complex<float> >(
+    HermitianMatrix< std::complex<float> >& A,
+    Matrix< std::complex<float> >& B,
+    Options const& opts);
+
+template
+int64_t potrf< std::complex<double> >(
+    HermitianMatrix< std::complex<double> >& A,
+    Matrix< std::complex<double> >& B,
+    Options const& opts);
+
 } // namespace slate
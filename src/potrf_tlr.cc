@@ -0,0 +1,199 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/slate.hh"
+#include "internal/internal.hh"
+#include "internal/Tile_lapack.hh"
+
+#include <set>
+#include <vector>
+
+namespace slate {
+
+//------------------------------------------------------------------------------
+/// Distributed parallel tile low-rank (TLR) Cholesky factorization.
+///
+/// Performs the Cholesky factorization of a Hermitian positive definite
+/// TLR matrix $A = L L^H$, with L lower triangular, in TLR form.
+/// At step k, the dense diagonal tile is factored, $L_{kk} L_{kk}^H = A_{kk}$,
+/// and each low-rank tile in column k is solved through its V factor only,
+/// $L_{ik} = U_{ik} (L_{kk}^{-1} V_{ik})^H$. The factors $U_{ik}, V_{ik}$,
+/// not dense tiles, are then broadcast to the ranks updating the trailing
+/// matrix. Off-diagonal trailing tiles are updated in low-rank form,
+/// $A_{ij} = A_{ij} - U_{ik} (V_{ik}^H V_{jk}) U_{jk}^H$, and recompressed
+/// to A.tolerance(). For tiles of rank r, this costs $O( n^2 r^2 / nb )$
+/// flops instead of the $n^3 / 3$ of dense potrf.
+///
+/// The factorization is exact for the TLR matrix up to the recompression
+/// error, so $\| A - L L^H \|$ is of the order of the compression tolerance
+/// times the number of block columns.
+///
+//------------------------------------------------------------------------------
+/// @tparam scalar_t
+///         One of float, double, std::complex<float>, std::complex<double>.
+//------------------------------------------------------------------------------
+/// @param[in,out] A
+///         On entry, the n-by-n Hermitian positive definite TLR matrix A,
+///         e.g., from compress().
+///         On exit, if return value = 0, the factor L in TLR form.
+///
+/// @param[in] opts
+///         Additional options, as map of name = value pairs.
+///         Currently unused; the factorization is done on the host.
+///
+/// @return 0: successful exit
+/// @return i > 0: the leading minor of order i of A is not
+///         positive definite, so the factorization could not
+///         be completed.
+///
+/// @ingroup posv_computational
+///
+template <typename scalar_t>
+int64_t potrf(
+    TLRMatrix<scalar_t>& A,
+    Options const& opts )
+{
+    trace::Block trace_block( "slate::potrf" );
+
+    using ij_tuple = typename BaseMatrix<scalar_t>::ij_tuple;
+    using BcastList = typename TLRMatrix<scalar_t>::BcastList;
+
+    const scalar_t zero = 0.0, one = 1.0;
+
+    auto& D = A.diag();
+    int64_t nt = A.nt();
+    blas::real_type<scalar_t> tol = A.tolerance();
+
+    int64_t info = 0;
+    int64_t row = 0;
+    for (int64_t k = 0; k < nt; ++k) {
+        // Factor the diagonal tile and send it down block column k.
+        if (A.tileIsLocal( k, k )) {
+            D.tileGetForWriting( k, k, LayoutConvert::ColMajor );
+            int64_t iinfo = tile::potrf( D( k, k ) );
+            if (iinfo != 0 && info == 0)
+                info = row + iinfo;
+        }
+        if (k < nt-1)
+            D.tileBcast( k, k, D.sub( k+1, nt-1, k, k ), Layout::ColMajor );
+
+        // Solve the local tiles of block column k,
+        // L_ik = U_ik V_ik^H L_kk^{-H} = U_ik (L_kk^{-1} V_ik)^H.
+        std::vector<int64_t> panel;
+        for (int64_t i = k+1; i < nt; ++i) {
+            if (A.tileIsLocal( i, k ))
+                panel.push_back( i );
+        }
+        if (! panel.empty()) {
+            D.tileGetForReading( k, k, LayoutConvert::ColMajor );
+            auto Lkk = D( k, k );
+            #pragma omp parallel for schedule( dynamic, 1 )
+            for (size_t t = 0; t < panel.size(); ++t) {
+                auto& Lik = A.tile( panel[ t ], k );
+                blas::trsm( blas::Layout::ColMajor,
+                            Side::Left, Uplo::Lower, Op::NoTrans, Diag::NonUnit,
+                            Lik.nb(), Lik.rank(),
+                            one, Lkk.data(), Lkk.stride(),
+                                 Lik.V(), Lik.ldv() );
+            }
+        }
+
+        // Send the factors of L_ik to the ranks updating block row i
+        // and block column i of the trailing matrix.
+        BcastList bcast_list;
+        for (int64_t i = k+1; i < nt; ++i) {
+            std::set<int> ranks;
+            for (int64_t j = k+1; j <= i; ++j)
+                ranks.insert( A.tileRank( i, j ) );
+            for (int64_t l = i+1; l < nt; ++l)
+                ranks.insert( A.tileRank( l, i ) );
+            bcast_list.push_back( { i, k, ranks } );
+        }
+        A.listBcast( bcast_list );
+
+        // Update the local tiles of the trailing matrix,
+        // A_ij = A_ij - L_ik L_jk^H = A_ij - U_ik (V_ik^H V_jk) U_jk^H.
+        std::vector<ij_tuple> update;
+        for (int64_t j = k+1; j < nt; ++j) {
+            for (int64_t i = j; i < nt; ++i) {
+                if (A.tileIsLocal( i, j ))
+                    update.push_back( { i, j } );
+            }
+        }
+        #pragma omp parallel for schedule( dynamic, 1 )
+        for (size_t t = 0; t < update.size(); ++t) {
+            int64_t i = std::get<0>( update[ t ] );
+            int64_t j = std::get<1>( update[ t ] );
+            auto& Lik = A.tile( i, k );
+            auto& Ljk = A.tile( j, k );
+            int64_t ri = Lik.rank();
+            int64_t rj = Ljk.rank();
+            if (ri == 0 || rj == 0)
+                continue;
+
+            // G = V_ik^H V_jk and Y = U_ik G.
+            int64_t mb = Lik.mb();
+            std::vector<scalar_t> G( ri*rj ), Y( mb*rj );
+            blas::gemm( blas::Layout::ColMajor, Op::ConjTrans, Op::NoTrans,
+                        ri, rj, Lik.nb(),
+                        one,  Lik.V(), Lik.ldv(),
+                              Ljk.V(), Ljk.ldv(),
+                        zero, G.data(), ri );
+            blas::gemm( blas::Layout::ColMajor, Op::NoTrans, Op::NoTrans,
+                        mb, rj, ri,
+                        one,  Lik.U(), Lik.ldu(),
+                              G.data(), ri,
+                        zero, Y.data(), mb );
+
+            if (i == j) {
+                // Dense diagonal tile, A_jj = A_jj - Y U_jk^H.
+                D.tileGetForWriting( j, j, LayoutConvert::ColMajor );
+                auto Ajj = D( j, j );
+                blas::gemm( blas::Layout::ColMajor, Op::NoTrans, Op::ConjTrans,
+                            mb, mb, rj,
+                            -one, Y.data(), mb,
+                                  Ljk.U(), Ljk.ldu(),
+                            one,  Ajj.data(), Ajj.stride() );
+            }
+            else {
+                // Low-rank tile, A_ij = [ U_ij, -Y ] [ V_ij, U_jk ]^H,
+                // then recompress.
+                auto& Aij = A.tile( i, j );
+                Aij.append( -one, rj, Y.data(), mb, Ljk.U(), Ljk.ldu() );
+                Aij.recompress( tol );
+            }
+        }
+
+        A.releaseRemoteTiles();
+        row += A.tileNb( k );
+    }
+
+    internal::reduce_info( &info, A.mpiComm(), opts );
+    return info;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+int64_t potrf<float>(
+    TLRMatrix<float>& A,
+    Options const& opts);
+
+template
+int64_t potrf<double>(
+    TLRMatrix<double>& A,
+    Options const& opts);
+
+template
+int64_t potrf< std::complex<float> >(
+    TLRMatrix< std::complex<float> >& A,
+    Options const& opts);
+
+template
+int64_t potrf< std::complex<double> >(
+    TLRMatrix< std::complex<double> >& A,
+    Options const& opts);
+
+} // namespace slate
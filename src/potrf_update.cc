@@ -0,0 +1,325 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/slate.hh"
+#include "auxiliary/Debug.hh"
+#include "slate/Matrix.hh"
+#include "slate/HermitianMatrix.hh"
+#include "internal/internal.hh"
+
+namespace slate {
+
+namespace impl {
+
+//------------------------------------------------------------------------------
+/// Moves V(i, 0), for i = i1, ..., i2, to the rank of A(i, k), from the rank
+/// of A(i, k-1) that applied step k-1 to it, or, for k = 0, from its
+/// origin rank. Remote copies left on the senders are released.
+/// @ingroup posv_impl
+///
+template <typename scalar_t>
+void potrf_update_move(
+    HermitianMatrix<scalar_t>& A, Matrix<scalar_t>& V,
+    int64_t k, int64_t i1, int64_t i2, int tag_0 )
+{
+    int mpi_rank = A.mpiRank();
+
+    std::vector<MPI_Request> requests;
+    std::vector<int64_t> sent;
+    for (int64_t i = i1; i <= i2; ++i) {
+        int src = k == 0 ? V.tileRank( i, 0 ) : A.tileRank( i, k-1 );
+        int dst = A.tileRank( i, k );
+        if (src == dst)
+            continue;
+        if (mpi_rank == dst) {
+            requests.push_back( MPI_REQUEST_NULL );
+            V.tileIrecv( i, 0, src, Layout::ColMajor, tag_0 + i,
+                         &requests.back() );
+        }
+        else if (mpi_rank == src) {
+            requests.push_back( MPI_REQUEST_NULL );
+            V.tileIsend( i, 0, dst, tag_0 + i, &requests.back() );
+            sent.push_back( i );
+        }
+    }
+    if (! requests.empty()) {
+        slate_mpi_call(
+            MPI_Waitall( requests.size(), requests.data(),
+                         MPI_STATUSES_IGNORE ) );
+    }
+    for (int64_t i : sent)
+        V.tileRelease( i, 0, AllDevices );
+}
+
+//------------------------------------------------------------------------------
+/// Distributed parallel rank-k update or downdate of a Cholesky factor.
+/// Generic implementation for any target.
+/// Diagonal tiles are done on the host, as their rotations are a
+/// sequential sweep over the columns; the tiles below are updated by
+/// target, with lookahead over block rows.
+/// @ingroup posv_impl
+///
+template <Target target, typename scalar_t>
+int64_t potrf_update(
+    slate::internal::TargetType<target>,
+    HermitianMatrix<scalar_t> A, Matrix<scalar_t>& V, int sign,
+    Options const& opts )
+{
+    using ij_tuple = typename BaseMatrix<scalar_t>::ij_tuple;
+
+    // Constants
+    const int priority_0 = 0;
+    const int queue_0 = 0;
+
+    // Options
+    int64_t lookahead = get_option<Option::Lookahead>( opts, 1 );
+
+    // if upper, change to lower
+    if (A.uplo() == Uplo::Upper) {
+        A = conj_transpose( A );
+    }
+
+    int64_t info = 0;
+    int64_t A_nt = A.nt();
+
+    // OpenMP needs pointer types, but vectors are exception safe
+    std::vector< uint8_t > row_vector( A_nt );
+    uint8_t* row = row_vector.data();
+    SLATE_UNUSED( row ); // Used only by OpenMP
+
+    // R uses tags 0, ..., nt-1; V tags nt, ..., 2 nt - 1.
+    const int tag_V = A_nt;
+
+    if (target == Target::Devices) {
+        // Queue 0 for the trailing rows; 1, ..., lookahead for the others.
+        A.allocateBatchArrays( 0, 1 + lookahead );
+        A.reserveDeviceWorkspace();
+    }
+
+    // set min number for omp nested active parallel regions
+    slate::OmpSetMaxActiveLevels set_active_levels( MinOmpActiveLevels );
+
+    // Block columns of V are applied one after the other.
+    for (int64_t c = 0; c < V.nt() && info == 0; ++c) {
+        auto Vc = V.sub( 0, V.mt()-1, c, c );
+        int64_t kb = Vc.tileNb( 0 );
+
+        // R(k, 0) holds the rotations of step k, on the rank of A(k, k).
+        std::function<int64_t (int64_t)> tileMb = [&A]( int64_t i ) {
+            return A.tileNb( i );
+        };
+        std::function<int64_t (int64_t)> tileNb = [kb]( int64_t ) {
+            return 2*kb;
+        };
+        std::function<int (ij_tuple)> tileRank = [&A]( ij_tuple ij ) {
+            int64_t i = std::get<0>( ij );
+            return A.tileRank( i, i );
+        };
+        std::function<int (ij_tuple)> tileDevice = [&A]( ij_tuple ij ) {
+            int64_t i = std::get<0>( ij );
+            return A.tileDevice( i, i );
+        };
+        Matrix<scalar_t> R( A.n(), 2*kb, tileMb, tileNb, tileRank, tileDevice,
+                            A.mpiComm() );
+        R.insertLocalTiles();
+
+        int64_t iinfo_c = 0;
+
+        #pragma omp parallel
+        #pragma omp master
+        {
+            int64_t kk = 0;  // column index (not block-column)
+            for (int64_t k = 0; k < A_nt; ++k) {
+                // Diagonal tile, on the host, normal priority.
+                #pragma omp task depend(inout:row[k]) priority( priority_0 ) \
+                    shared( A, Vc, R, iinfo_c ) firstprivate( k, kk )
+                {
+                    potrf_update_move( A, Vc, k, k, k, tag_V );
+
+                    int64_t iinfo = internal::potrf_update(
+                        sign, A.sub( k, k ), Vc.sub( k, k, 0, 0 ),
+                        R.sub( k, k, 0, 0 ) );
+                    if (iinfo != 0 && iinfo_c == 0)
+                        iinfo_c = kk + iinfo;
+
+                    // send R(k, 0) down col A(k+1:nt-1, k)
+                    if (k+1 <= A_nt-1) {
+                        R.tileBcast( k, 0, A.sub( k+1, A_nt-1, k, k ),
+                                     Layout::ColMajor, k );
+                    }
+                }
+
+                // Lookahead rows, normal priority.
+                for (int64_t i = k+1; i < k+1+lookahead && i < A_nt; ++i) {
+                    #pragma omp task depend(in:row[k]) depend(inout:row[i]) \
+                        priority( priority_0 ) shared( A, Vc, R ) \
+                        firstprivate( k, i, sign )
+                    {
+                        potrf_update_move( A, Vc, k, i, i, tag_V );
+
+                        internal::potrf_update_apply<target>(
+                            sign, R.sub( k, k, 0, 0 ),
+                            A.sub( i, i, k, k ), Vc.sub( i, i, 0, 0 ),
+                            priority_0, i-k );
+                    }
+                }
+
+                // Trailing rows, in one task.
+                if (k+1+lookahead < A_nt) {
+                    int64_t i1 = k+1+lookahead;
+                    #pragma omp task depend(in:row[k]) \
+                                     depend(inout:row[i1]) \
+                                     depend(inout:row[A_nt-1]) \
+                        priority( priority_0 ) shared( A, Vc, R ) \
+                        firstprivate( k, i1, sign )
+                    {
+                        potrf_update_move( A, Vc, k, i1, A_nt-1, tag_V );
+
+                        internal::potrf_update_apply<target>(
+                            sign, R.sub( k, k, 0, 0 ),
+                            A.sub( i1, A_nt-1, k, k ),
+                            Vc.sub( i1, A_nt-1, 0, 0 ),
+                            priority_0, queue_0 );
+                    }
+                }
+                kk += A.tileNb( k );
+            }
+
+            #pragma omp taskwait
+            A.tileUpdateAllOrigin();
+        }
+
+        internal::reduce_info( &iinfo_c, A.mpiComm() );
+        info = iinfo_c;
+    }
+
+    A.releaseWorkspace();
+    V.releaseWorkspace();
+
+    return info;
+}
+
+} // namespace impl
+
+//------------------------------------------------------------------------------
+/// Distributed parallel rank-k update or downdate of a Cholesky factor.
+///
+/// Given the Cholesky factor $L$ of $A = L L^H$, from potrf, computes the
+/// factor $\tilde{L}$ of
+/// \[
+///     \tilde{L} \tilde{L}^H = L L^H + sign V V^H,
+/// \]
+/// or, if $A$ is stored upper, the factor $\tilde{U}$ of
+/// $\tilde{U}^H \tilde{U} = U^H U + sign V V^H$, without refactoring:
+/// each column $j$ of $L$ is rotated with each column of $V$, zeroing
+/// $V(j, :)$, by Givens rotations for an update, and by hyperbolic
+/// rotations, in their stable mixed form, for a downdate. Step k applies
+/// the rotations of the diagonal tile to the block column of $L$ below it,
+/// broadcasting them down the column, with lookahead over the block rows.
+/// Block row i of $V$ moves along block row i of $L$ as the steps reach it.
+///
+/// Complexity (in real): $\approx 2 k n^2$ flops for an n-by-k $V$,
+/// instead of $\frac{1}{3} n^3$ to refactor.
+///
+//------------------------------------------------------------------------------
+/// @tparam scalar_t
+///     One of float, double, std::complex<float>, std::complex<double>.
+//------------------------------------------------------------------------------
+/// @param[in,out] A
+///     On entry, the Cholesky factor $L$ or $U$ of the n-by-n Hermitian
+///     positive definite matrix $A$, from potrf.
+///     On exit, if return value = 0, the updated factor $\tilde{L}$ or
+///     $\tilde{U}$. If return value > 0 for a downdate, the leading
+///     columns of the factor are updated, and the rest partially.
+///
+/// @param[in,out] V
+///     On entry, the n-by-k matrix $V$, with the block rows of $A$,
+///     column-major tiles, and the same MPI communicator.
+///     On exit, destroyed.
+///
+/// @param[in] sign
+///     1 for an update, $L L^H + V V^H$;
+///     -1 for a downdate, $L L^H - V V^H$.
+///
+/// @param[in] opts
+///     Additional options, as map of name = value pairs. Possible options:
+///     - Option::Lookahead:
+///       Number of block rows of each step to apply ahead of the rest.
+///       lookahead >= 0. Default 1.
+///     - Option::Target:
+///       Implementation to target. Possible values:
+///       - HostTask:  OpenMP tasks on CPU host [default].
+///       - HostNest:  as HostTask.
+///       - HostBatch: as HostTask.
+///       - Devices:   batched kernels on GPU devices for the tiles below
+///         the diagonal; the diagonal tiles are done on the host.
+///
+/// @return 0: successful exit
+/// @return i > 0: for a downdate, $L L^H - V V^H$ is not positive
+///         definite, as found in column $i$ of the factor.
+///
+/// @ingroup posv_computational
+///
+template <typename scalar_t>
+int64_t potrf_update(
+    HermitianMatrix<scalar_t>& A,
+    Matrix<scalar_t>& V,
+    int sign,
+    Options const& opts)
+{
+    using internal::TargetType;
+
+    slate_error_if( sign != 1 && sign != -1 );
+    slate_error_if( V.mt() != A.mt() );
+
+    Target target = get_option<Option::Target>( opts, Target::HostTask );
+
+    switch (target) {
+        case Target::Host:
+        case Target::HostNest:
+        case Target::HostBatch:
+        case Target::HostTask:
+            return impl::potrf_update( TargetType<Target::HostTask>(),
+                                       A, V, sign, opts );
+
+        case Target::Devices:
+        case Target::Hybrid:
+            return impl::potrf_update( TargetType<Target::Devices>(),
+                                       A, V, sign, opts );
+    }
+    return -2;  // shouldn't happen
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+int64_t potrf_update<float>(
+    HermitianMatrix<float>& A,
+    Matrix<float>& V,
+    int sign,
+    Options const& opts);
+
+template
+int64_t potrf_update<double>(
+    HermitianMatrix<double>& A,
+    Matrix<double>& V,
+    int sign,
+    Options const& opts);
+
+template
+int64_t potrf_update< std::complex<float> >(
+    HermitianMatrix< std::complex<float> >& A,
+    Matrix< std::complex<float> >& V,
+    int sign,
+    Options const& opts);
+
+template
+int64_t potrf_update< std::complex<double> >(
+    HermitianMatrix< std::complex<double> >& A,
+    Matrix< std::complex<double> >& V,
+    int sign,
+    Options const& opts);
+
+} // namespace slate
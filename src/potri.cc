@@ -42,7 +42,7 @@ namespace slate {
 ///       - HostTask:  OpenMP tasks on CPU host [default].
 ///       - HostNest:  nested OpenMP parallel for loop on CPU host.
 ///       - HostBatch: batched BLAS on CPU host.
-///       - Devices:   batched BLAS on GPU device.
+///       - Devices:   batched BLAS on GPU device, for both trtri and trtrm.
 ///
 /// TODO: return value
 /// @retval 0 successful exit
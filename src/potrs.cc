@@ -10,6 +10,8 @@
 #include "slate/TriangularMatrix.hh"
 #include "internal/internal.hh"
 
+#include "lapack/flops.hh"
+
 namespace slate {
 
 //------------------------------------------------------------------------------
@@ -42,6 +44,18 @@ namespace slate {
 ///     - Option::Lookahead:
 ///       Number of panels to overlap with matrix updates.
 ///       lookahead >= 0. Default 1.
+///     - Option::Counters:
+///       Pointer to Counters to collect performance counters in, for
+///       phases "potrs". Default null: off.
+///
+///     - Option::ChunkSize:
+///       Number of columns of B to solve at a time, rounded up to whole
+///       tiles; chunk >= 1. With many right hand sides, B is streamed in
+///       chunks of block columns through both solves, with the tiles of
+///       the Cholesky factor broadcast once and kept, on the ranks and
+///       devices of B, for all chunks, so the workspace for B is bounded
+///       by the chunk. Default: all of B at once.
+///
 ///     - Option::Target:
 ///       Implementation to target. Possible values:
 ///       - HostTask:  OpenMP tasks on CPU host [default].
@@ -62,6 +76,10 @@ void potrs(HermitianMatrix<scalar_t>& A,
     // assert(A.mt() == A.nt());
     assert(B.mt() == A.mt());
 
+    internal::CounterPhase c_potrs(
+        get_option<Option::Counters>( opts, nullptr ), "potrs",
+        lapack::Gflop<scalar_t>::potrs( A.n(), B.n() ) * 1e9 );
+
     auto A_ = A;  // local shallow copy to transpose
 
     // if upper, change to lower
@@ -71,9 +89,45 @@ void potrs(HermitianMatrix<scalar_t>& A,
     auto L = TriangularMatrix<scalar_t>(Diag::NonUnit, A_);
     auto LT = conj_transpose( L );
 
-    trsm(Side::Left, one, L, B, opts);
+    int64_t chunk = get_option<int64_t>( opts, Option::ChunkSize, B.n() );
+    bool resident = get_option<Option::FactorsResident>( opts, false );
+    slate_assert( chunk >= 1 );
+
+    Options opts_chunk = opts;
+    bool release = false;
+    if (chunk < B.n() && ! resident) {
+        // Broadcast L and L^H once for all chunks of B.
+        Target target = get_target( opts, Target::HostTask );
+        impl::trsm_resident_bcast( L, B, target );
+        impl::trsm_resident_bcast( LT, B, target );
+        opts_chunk[ Option::MethodTrsm ] = MethodTrsm::B;
+        opts_chunk[ Option::FactorsResident ] = true;
+        release = true;
+    }
+
+    // Solve for block columns j1:j2 of B at a time,
+    // with at least chunk columns each, except the last.
+    int64_t j1 = 0;
+    while (j1 < B.nt()) {
+        int64_t j2 = j1;
+        int64_t ncols = B.tileNb( j1 );
+        while (ncols < chunk && j2 < B.nt()-1) {
+            ++j2;
+            ncols += B.tileNb( j2 );
+        }
+        auto Bc = B.sub( 0, B.mt()-1, j1, j2 );
+
+        trsm(Side::Left, one, L, Bc, opts_chunk);
+
+        trsm(Side::Left, one, LT, Bc, opts_chunk);
+
+        j1 = j2 + 1;
+    }
 
-    trsm(Side::Left, one, LT, B, opts);
+    if (release) {
+        A_.releaseRemoteWorkspace();
+        A_.releaseLocalWorkspace();
+    }
     // todo: return value for errors?
 }
 
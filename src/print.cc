@@ -8,6 +8,7 @@
 
 #include <string>
 #include <cstdio>
+#include <utility>
 
 namespace slate {
 
@@ -1295,4 +1296,282 @@ void print(
     std::vector<std::complex<double>> const& x,
     Options const& opts);
 
+//------------------------------------------------------------------------------
+/// @return device holding a valid copy of tile A(i, j), preferring the
+/// host, or -2 if no copy is valid, e.g., the tile is missing.
+///
+template <typename scalar_t>
+int dump_tile_device( BaseMatrix<scalar_t>& A, int64_t i, int64_t j )
+{
+    if (A.tileExists( i, j, HostNum )
+        && A.tileState( i, j, HostNum ) != MOSI::Invalid)
+        return HostNum;
+    for (int device = 0; device < A.num_devices(); ++device) {
+        if (A.tileExists( i, j, device )
+            && A.tileState( i, j, device ) != MOSI::Invalid)
+            return device;
+    }
+    return -2;
+}
+
+//------------------------------------------------------------------------------
+/// Writes each rank's local tiles of op(A) to its own file, prefix.<rank>,
+/// in parallel, without gathering them on rank 0 as print does, so large
+/// matrices can be dumped quickly with little memory. Rank 0 also writes
+/// prefix.index, describing the matrix, the files, and how to assemble
+/// them. No MPI is involved; does not change MSI status.
+///
+/// Text files have, for each tile, a Matlab statement assigning it,
+///     label( ii+1:ii+mb, jj+1:jj+nb ) = [ ... ];
+/// so after label = nan( m, n ), running all files assembles the matrix.
+/// Binary files have, for each tile, the int64_t record
+///     { i, j, ii, jj, mb, nb }
+/// of its block indices, first row and column (0-based), and size,
+/// followed by the mb-by-nb tile, column-major, in the native format.
+///
+/// Tiles valid only on devices are read into pinned host memory with
+/// asynchronous copies, a block column at a time; copies of the next
+/// block column overlap writing the current one.
+/// Missing tiles are skipped, as are tiles outside the stored triangle
+/// of triangular, symmetric, and Hermitian matrices; diagonal tiles are
+/// written as stored.
+///
+/// @param[in] label
+///     Name of the matrix, in text files.
+///
+/// @param[in] A
+///     The matrix to dump.
+///
+/// @param[in] prefix
+///     Prefix of the file names.
+///
+/// @param[in] opts
+///     Additional options:
+///     - Option::PrintBinary:
+///       Whether to write binary files. Default false: text.
+///     - Option::PrintWidth, Option::PrintPrecision:
+///       Format of text values, as in print.
+///
+/// @ingroup util
+///
+template <typename scalar_t>
+void dump(
+    const char* label,
+    BaseMatrix<scalar_t>& A,
+    std::string const& prefix,
+    Options const& opts)
+{
+    using std::to_string;
+
+    int width     = get_option<int>( opts, Option::PrintWidth,     10 );
+    int precision = get_option<int>( opts, Option::PrintPrecision,  4 );
+    bool binary   = get_option<bool>( opts, Option::PrintBinary, false );
+    width = std::max( width, precision + 6 );
+
+    int mpi_rank = A.mpiRank();
+    int mpi_size;
+    MPI_Comm_size( A.mpiComm(), &mpi_size );
+
+    int64_t mt = A.mt();
+    int64_t nt = A.nt();
+    std::vector<int64_t> row_offsets( mt + 1, 0 );
+    std::vector<int64_t> col_offsets( nt + 1, 0 );
+    for (int64_t i = 0; i < mt; ++i)
+        row_offsets[ i+1 ] = row_offsets[ i ] + A.tileMb( i );
+    for (int64_t j = 0; j < nt; ++j)
+        col_offsets[ j+1 ] = col_offsets[ j ] + A.tileNb( j );
+
+    if (mpi_rank == 0) {
+        std::string index_name = prefix + ".index";
+        FILE* index = std::fopen( index_name.c_str(), "w" );
+        if (index == nullptr)
+            slate_error( "dump: cannot create " + index_name );
+        std::string msg
+            = std::string( "% " ) + label + ": Matrix "
+            + to_string( A.m() ) + "-by-" + to_string( A.n() ) + ", "
+            + to_string( mt ) + "-by-" + to_string( nt )
+            + " tiles, tileSize " + to_string( A.tileMb( 0 ) ) + "-by-"
+            + to_string( A.tileNb( 0 ) ) + ", uplo = " + to_string( A.uplo() )
+            + "\n% Files " + prefix + ".<rank>, rank = 0, ..., "
+            + to_string( mpi_size - 1 ) + ", hold each rank's tiles";
+        if (binary) {
+            msg += ", binary:\n"
+                   "% per tile, int64 { i, j, ii, jj, mb, nb } (0-based),\n"
+                   "% then the mb-by-nb tile, column-major, in native ";
+            msg += (is_complex<scalar_t>::value ? "complex " : "real ");
+            msg += to_string( 8 * sizeof( blas::real_type<scalar_t> ) )
+                   + "-bit.\n";
+        }
+        else {
+            msg += ", as\n% label( ii+1:ii+mb, jj+1:jj+nb ) = [ ... ];"
+                   " run them after\n"
+                   + std::string( label ) + " = nan( " + to_string( A.m() )
+                   + ", " + to_string( A.n() ) + " );\n";
+        }
+        std::fputs( msg.c_str(), index );
+        std::fclose( index );
+    }
+
+    std::string filename = prefix + "." + to_string( mpi_rank );
+    FILE* file = std::fopen( filename.c_str(), binary ? "wb" : "w" );
+    if (file == nullptr)
+        slate_error( "dump: cannot create " + filename );
+
+    // Block columns with local tiles, and the staging size of the
+    // largest one.
+    std::vector<int64_t> local_cols;
+    int64_t stage_size = 0;
+    for (int64_t j = 0; j < nt; ++j) {
+        bool is_local = false;
+        int64_t size = 0;
+        for (int64_t i = 0; i < mt; ++i) {
+            if (A.tileIsLocal( i, j )) {
+                is_local = true;
+                if (dump_tile_device( A, i, j ) >= 0)
+                    size += A.tileMb( i ) * A.tileNb( j );
+            }
+        }
+        if (is_local)
+            local_cols.push_back( j );
+        stage_size = std::max( stage_size, size );
+    }
+
+    // Two pinned buffers, for the block column written and the next one.
+    scalar_t* stage[ 2 ] = { nullptr, nullptr };
+    if (stage_size > 0) {
+        for (int b = 0; b < 2; ++b) {
+            stage[ b ] = blas::host_malloc_pinned<scalar_t>(
+                             stage_size, *A.comm_queue( 0 ) );
+        }
+    }
+
+    // Starts copying the tiles of block column j valid only on devices to
+    // buffer; returns host views of its tiles, and sets the devices used.
+    using TileList = std::vector< std::pair< int64_t, Tile<scalar_t> > >;
+    auto start_column = [&]( int64_t j, scalar_t* buffer,
+                             std::vector<bool>& devices_used ) {
+        TileList tiles;
+        devices_used.assign( A.num_devices(), false );
+        int64_t offset = 0;
+        for (int64_t i = 0; i < mt; ++i) {
+            if (! A.tileIsLocal( i, j ))
+                continue;
+            int device = dump_tile_device( A, i, j );
+            if (device == HostNum) {
+                tiles.push_back( { i, A( i, j ) } );
+            }
+            else if (device >= 0) {
+                auto T = A( i, j, device );
+                // Dimensions of T's data, as a column-major array.
+                int64_t mb0 = T.op() == Op::NoTrans ? T.mb() : T.nb();
+                int64_t nb0 = T.op() == Op::NoTrans ? T.nb() : T.mb();
+                if (T.layout() == Layout::RowMajor)
+                    std::swap( mb0, nb0 );
+                blas::device_copy_matrix(
+                    mb0, nb0, T.data(), T.stride(),
+                    &buffer[ offset ], mb0, *A.comm_queue( device ) );
+                tiles.push_back(
+                    { i, Tile<scalar_t>( T, &buffer[ offset ], mb0,
+                                         TileKind::Workspace ) } );
+                offset += mb0 * nb0;
+                devices_used[ device ] = true;
+            }
+        }
+        return tiles;
+    };
+
+    char buf[ 80 ];
+    std::vector<scalar_t> values;
+    std::vector<bool> devices_used[ 2 ];
+    TileList tiles;
+    if (! local_cols.empty())
+        tiles = start_column( local_cols[ 0 ], stage[ 0 ], devices_used[ 0 ] );
+    for (size_t c = 0; c < local_cols.size(); ++c) {
+        int64_t j = local_cols[ c ];
+        int b = c % 2;
+        for (int device = 0; device < A.num_devices(); ++device) {
+            if (devices_used[ b ][ device ])
+                A.comm_queue( device )->sync();
+        }
+        TileList next;
+        if (c + 1 < local_cols.size()) {
+            next = start_column( local_cols[ c+1 ], stage[ 1 - b ],
+                                 devices_used[ 1 - b ] );
+        }
+
+        for (auto& item : tiles) {
+            int64_t i = item.first;
+            auto& T = item.second;
+            int64_t ii = row_offsets[ i ];
+            int64_t jj = col_offsets[ j ];
+            if (binary) {
+                int64_t record[ 6 ] = { i, j, ii, jj, T.mb(), T.nb() };
+                values.resize( T.mb() * T.nb() );
+                for (int64_t tj = 0; tj < T.nb(); ++tj)
+                    for (int64_t ti = 0; ti < T.mb(); ++ti)
+                        values[ ti + tj*T.mb() ] = T( ti, tj );
+                std::fwrite( record, sizeof( record ), 1, file );
+                std::fwrite( values.data(), sizeof( scalar_t ),
+                             values.size(), file );
+            }
+            else {
+                std::string msg
+                    = std::string( label ) + "( "
+                    + to_string( ii + 1 ) + ":" + to_string( ii + T.mb() )
+                    + ", "
+                    + to_string( jj + 1 ) + ":" + to_string( jj + T.nb() )
+                    + " ) = [\n";
+                for (int64_t ti = 0; ti < T.mb(); ++ti) {
+                    for (int64_t tj = 0; tj < T.nb(); ++tj) {
+                        snprintf_value( buf, sizeof(buf), width, precision,
+                                        T( ti, tj ) );
+                        msg += buf;
+                    }
+                    msg += "\n";
+                }
+                msg += "];\n";
+                std::fputs( msg.c_str(), file );
+            }
+        }
+        tiles = std::move( next );
+    }
+
+    for (int b = 0; b < 2; ++b) {
+        if (stage[ b ] != nullptr)
+            blas::host_free_pinned( stage[ b ], *A.comm_queue( 0 ) );
+    }
+    if (std::fclose( file ) != 0)
+        slate_error( "dump: cannot write " + filename );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void dump(
+    const char* label,
+    BaseMatrix<float>& A,
+    std::string const& prefix,
+    Options const& opts);
+
+template
+void dump(
+    const char* label,
+    BaseMatrix<double>& A,
+    std::string const& prefix,
+    Options const& opts);
+
+template
+void dump(
+    const char* label,
+    BaseMatrix<std::complex<float>>& A,
+    std::string const& prefix,
+    Options const& opts);
+
+template
+void dump(
+    const char* label,
+    BaseMatrix<std::complex<double>>& A,
+    std::string const& prefix,
+    Options const& opts);
+
 } // namespace slate
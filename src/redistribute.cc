@@ -9,119 +9,334 @@
 #include "slate/Matrix.hh"
 #include "internal/internal.hh"
 
+#include <limits>
+#include <map>
+#include <utility>
+#include <vector>
+
 namespace slate {
 
+namespace impl {
+
 //------------------------------------------------------------------------------
-/// Redistribute a matrix A from one distribution into matrix B with another
-/// distribution.
-/// @ingroup copy_internal
+/// Intersection of a block row (or column) of A with one of B.
+struct Segment {
+    int64_t a_tile;     ///< block row (or column) index in A
+    int64_t a_offset;   ///< row (or column) offset within A's tile
+    int64_t b_tile;     ///< block row (or column) index in B
+    int64_t b_offset;   ///< row (or column) offset within B's tile
+    int64_t size;       ///< number of rows (or columns)
+};
+
+//------------------------------------------------------------------------------
+/// Splits rows (or columns) into segments, each within a single tile of A
+/// and a single tile of B, given the tile sizes of A and B.
+///
+std::vector<Segment> intersect_tiles(
+    std::vector<int64_t> const& a_sizes,
+    std::vector<int64_t> const& b_sizes)
+{
+    std::vector<Segment> segments;
+    int64_t a_tile = 0, a_offset = 0;
+    int64_t b_tile = 0, b_offset = 0;
+    while (a_tile < int64_t( a_sizes.size() )
+           && b_tile < int64_t( b_sizes.size() )) {
+        int64_t size = std::min( a_sizes[ a_tile ] - a_offset,
+                                 b_sizes[ b_tile ] - b_offset );
+        segments.push_back( { a_tile, a_offset, b_tile, b_offset, size } );
+        a_offset += size;
+        b_offset += size;
+        if (a_offset == a_sizes[ a_tile ]) {
+            ++a_tile;
+            a_offset = 0;
+        }
+        if (b_offset == b_sizes[ b_tile ]) {
+            ++b_tile;
+            b_offset = 0;
+        }
+    }
+    return segments;
+}
+
+//------------------------------------------------------------------------------
+/// Copies the mb-by-nb block of op(T) starting at (i0, j0) into a
+/// column-major buffer, conjugating if op(T) is ConjTrans.
 ///
 template <typename scalar_t>
-void redistribute(
-    Matrix<scalar_t>& A,
-    Matrix<scalar_t>& B,
-    Options const& opts )
+void pack_block(
+    Tile<scalar_t> const& T, int64_t i0, int64_t j0, int64_t mb, int64_t nb,
+    scalar_t* buffer)
 {
-    trace::Block trace_block("slate::redistribute");
+    if (T.op() == Op::NoTrans && T.layout() == Layout::ColMajor) {
+        lapack::lacpy( lapack::MatrixType::General, mb, nb,
+                       &T.at( i0, j0 ), T.stride(), buffer, mb );
+    }
+    else {
+        for (int64_t j = 0; j < nb; ++j)
+            for (int64_t i = 0; i < mb; ++i)
+                buffer[ i + j*mb ] = T( i0 + i, j0 + j );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Copies a column-major buffer into the mb-by-nb block of op(T) starting
+/// at (i0, j0), conjugating if op(T) is ConjTrans, so op(T) gets the
+/// buffer's values.
+///
+template <typename scalar_t>
+void unpack_block(
+    scalar_t const* buffer, int64_t mb, int64_t nb,
+    Tile<scalar_t>& T, int64_t i0, int64_t j0)
+{
+    using blas::conj;
 
+    if (T.op() == Op::NoTrans && T.layout() == Layout::ColMajor) {
+        lapack::lacpy( lapack::MatrixType::General, mb, nb,
+                       buffer, mb, &T.at( i0, j0 ), T.stride() );
+    }
+    else if (T.op() == Op::ConjTrans) {
+        for (int64_t j = 0; j < nb; ++j)
+            for (int64_t i = 0; i < mb; ++i)
+                T.at( i0 + i, j0 + j ) = conj( buffer[ i + j*mb ] );
+    }
+    else {
+        for (int64_t j = 0; j < nb; ++j)
+            for (int64_t i = 0; i < mb; ++i)
+                T.at( i0 + i, j0 + j ) = buffer[ i + j*mb ];
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Redistribute tile by tile, when A and B have the same tiles and op.
+/// With GPU-aware MPI, tiles go directly between device memories.
+///
+template <typename scalar_t>
+void redistribute_tiles(
+    Matrix<scalar_t>& A,
+    Matrix<scalar_t>& B)
+{
     int64_t mt = B.mt();
     int64_t nt = B.nt();
 
-    bool is_conj = false;
-    if (A.op() != B.op()) {
-        if (A.op() == Op::ConjTrans || B.op() == Op::ConjTrans)
-            is_conj = true;
-
-        auto BT = A.emptyLike();
-        for (int64_t j = 0; j < nt; ++j) {
-            for (int64_t i = 0; i < mt; ++i) {
-                if (B.tileIsLocal(i, j)) {
-                    B.tileGetForWriting( i, j, LayoutConvert::None );
-                    if (! A.tileIsLocal(i, j)) {
-                        auto Bij = B(i, j);
-                        if (Bij.mb() == Bij.nb()) {
-                            Bij.recv(A.tileRank(i, j), A.mpiComm(),  A.layout());
-                            B.tileGetForWriting( i, j, LayoutConvert::None );
-                            if (is_conj)
-                                tile::deepConjTranspose( std::move(Bij) );
-                            else
-                                tile::deepTranspose( std::move(Bij) );
-                        }
-                        else {
-                            BT.tileInsert(i, j);
-                            auto BTij = BT(i, j);
-                            BT.tileGetForWriting( i, j, LayoutConvert::None );
-                            BTij.recv(A.tileRank(i, j), A.mpiComm(),  A.layout());
-                            if (is_conj) {
-                                auto AijT = conj_transpose(BTij);
-                                tile::deepConjTranspose( std::move(AijT), std::move(Bij) );
-                            }
-                            else {
-                                auto AijT = transpose(BTij);
-                                tile::deepTranspose( std::move(AijT), std::move(Bij) );
-                            }
-                        }
-                    }
-                    else {
-                        A.tileGetForReading(i, j, LayoutConvert::None);
-                        // copy local tiles if needed.
-                        auto Aij = A(i, j);
-                        auto Bij = B(i, j);
-                        if (Bij.mb() == Bij.nb()) {
-                            if (is_conj)
-                                tile::deepConjTranspose( std::move(Aij), std::move(Bij) );
-                            else
-                                tile::deepTranspose( std::move(Aij), std::move(Bij) );
-                        }
-                        else {
-                            if (is_conj) {
-                                auto AijT = conj_transpose(Aij);
-                                tile::deepConjTranspose( std::move(AijT), std::move(Bij) );
-                            }
-                            else {
-                                auto AijT = transpose(Aij);
-                                tile::deepTranspose( std::move(AijT), std::move(Bij) );
-                            }
-                        }
-                    }
+    for (int64_t j = 0; j < nt; ++j) {
+        for (int64_t i = 0; i < mt; ++i) {
+            if (B.tileIsLocal(i, j)) {
+                if (! A.tileIsLocal(i, j)) {
+                    // With GPU-aware MPI, receive where B's tile is valid.
+                    int device = B.tileSourceDevice( i, j );
+                    B.tileGetForWriting( i, j, device, LayoutConvert::None );
+                    auto Bij = B(i, j, device);
+                    Bij.recv(A.tileRank(i, j), A.mpiComm(),  A.layout());
                 }
-                else if (A.tileIsLocal(i, j)) {
+                else {
+                    B.tileGetForWriting( i, j, LayoutConvert::None );
                     A.tileGetForReading(i, j, LayoutConvert::None);
+                    // copy local tiles if needed.
                     auto Aij = A(i, j);
-                    Aij.send(B.tileRank(i, j), B.mpiComm());
+                    auto Bij = B(i, j);
+                    if (Aij.data() != Bij.data() ) {
+                        tile::gecopy( Aij, Bij );
+                    }
                 }
             }
+            else if (A.tileIsLocal(i, j)) {
+                A.tileSend( i, j, B.tileRank( i, j ) );
+            }
         }
     }
-    else {
-        for (int64_t j = 0; j < nt; ++j) {
-            for (int64_t i = 0; i < mt; ++i) {
-                if (B.tileIsLocal(i, j)) {
-                    B.tileGetForWriting( i, j, LayoutConvert::None );
-                    if (! A.tileIsLocal(i, j)) {
-                        auto Bij = B(i, j);
-                        Bij.recv(A.tileRank(i, j), A.mpiComm(),  A.layout());
-                    }
-                    else {
-                        A.tileGetForReading(i, j, LayoutConvert::None);
-                        // copy local tiles if needed.
-                        auto Aij = A(i, j);
-                        auto Bij = B(i, j);
-                        if (Aij.data() != Bij.data() ) {
-                            tile::gecopy( Aij, Bij );
-                            // deep conj tile after receive if it is square
-                            // if rectangular, recv in a tmp tile then transpose it
-                        }
-                    }
-                }
-                else if (A.tileIsLocal(i, j)) {
-                    A.tileGetForReading(i, j, LayoutConvert::None);
-                    auto Aij = A(i, j);
-                    Aij.send(B.tileRank(i, j), B.mpiComm());
-                }
+}
+
+//------------------------------------------------------------------------------
+/// Redistribute by exchanging one packed message between each pair of ranks.
+/// The schedule, the list of blocks that each pair of ranks exchanges, is
+/// computed once from the intersections of A's and B's tiles, so A and B
+/// can have different tile sizes. All receives are posted first; each
+/// destination's message is sent as soon as it is packed, and each
+/// received message is unpacked (and transposed) as soon as it arrives,
+/// overlapping packing, transfer, and unpacking.
+///
+template <typename scalar_t>
+void redistribute_packed(
+    Matrix<scalar_t>& A,
+    Matrix<scalar_t>& B)
+{
+    trace::Block trace_block("slate::redistribute_packed");
+
+    MPI_Comm mpi_comm = A.mpiComm();
+    int mpi_rank = A.mpiRank();
+    int tag = 0;
+
+    // Schedule.
+    std::vector<int64_t> A_mb( A.mt() ), A_nb( A.nt() );
+    std::vector<int64_t> B_mb( B.mt() ), B_nb( B.nt() );
+    for (int64_t i = 0; i < A.mt(); ++i)
+        A_mb[ i ] = A.tileMb( i );
+    for (int64_t j = 0; j < A.nt(); ++j)
+        A_nb[ j ] = A.tileNb( j );
+    for (int64_t i = 0; i < B.mt(); ++i)
+        B_mb[ i ] = B.tileMb( i );
+    for (int64_t j = 0; j < B.nt(); ++j)
+        B_nb[ j ] = B.tileNb( j );
+    std::vector<Segment> rows = intersect_tiles( A_mb, B_mb );
+    std::vector<Segment> cols = intersect_tiles( A_nb, B_nb );
+
+    // Blocks, as (row, col) segment indices, in the same order on all ranks.
+    using Block = std::pair<int64_t, int64_t>;
+    std::map< int, std::vector<Block> > send_blocks, recv_blocks;
+    std::vector<Block> local_blocks;
+    for (int64_t c = 0; c < int64_t( cols.size() ); ++c) {
+        for (int64_t r = 0; r < int64_t( rows.size() ); ++r) {
+            int src = A.tileRank( rows[ r ].a_tile, cols[ c ].a_tile );
+            int dst = B.tileRank( rows[ r ].b_tile, cols[ c ].b_tile );
+            if (src == mpi_rank && dst == mpi_rank)
+                local_blocks.push_back( { r, c } );
+            else if (src == mpi_rank)
+                send_blocks[ dst ].push_back( { r, c } );
+            else if (dst == mpi_rank)
+                recv_blocks[ src ].push_back( { r, c } );
+        }
+    }
+    auto count_of = [&rows, &cols]( std::vector<Block> const& blocks ) {
+        int64_t count = 0;
+        for (auto& block : blocks)
+            count += rows[ block.first ].size * cols[ block.second ].size;
+        slate_assert( count <= std::numeric_limits<int>::max() );
+        return count;
+    };
+
+    // Blocks are packed on host. B's tiles are entirely overwritten,
+    // so acquire them without copying their data.
+    for (int64_t j = 0; j < A.nt(); ++j) {
+        for (int64_t i = 0; i < A.mt(); ++i) {
+            if (A.tileIsLocal( i, j )
+                && A.tileSourceDevice( i, j ) != HostNum) {
+                internal::addHostStagedBytes(
+                    A.tileMb( i ) * A.tileNb( j ) * sizeof(scalar_t) );
+            }
+        }
+    }
+    A.tileGetAllForReading( HostNum, LayoutConvert::None );
+    for (int64_t j = 0; j < B.nt(); ++j) {
+        for (int64_t i = 0; i < B.mt(); ++i) {
+            if (B.tileIsLocal( i, j )) {
+                B.tileAcquire( i, j, HostNum, B.layout() );
+                B.tileModified( i, j, HostNum, true );
             }
         }
     }
+
+    // Post all receives.
+    std::vector< std::vector<scalar_t> > recv_buffers;
+    std::vector<int> recv_ranks;
+    std::vector<MPI_Request> recv_requests;
+    recv_buffers.reserve( recv_blocks.size() );
+    for (auto& rank_blocks : recv_blocks) {
+        int64_t count = count_of( rank_blocks.second );
+        recv_buffers.emplace_back( count );
+        recv_ranks.push_back( rank_blocks.first );
+        internal::count( internal::Count::BytesRecv, count * sizeof(scalar_t) );
+        MPI_Request request;
+        slate_mpi_call(
+            MPI_Irecv( recv_buffers.back().data(), count,
+                       mpi_type<scalar_t>::value, rank_blocks.first, tag,
+                       mpi_comm, &request ) );
+        recv_requests.push_back( request );
+    }
+
+    // Pack and send to each destination.
+    std::vector< std::vector<scalar_t> > send_buffers;
+    std::vector<MPI_Request> send_requests;
+    send_buffers.reserve( send_blocks.size() );
+    for (auto& rank_blocks : send_blocks) {
+        send_buffers.emplace_back( count_of( rank_blocks.second ) );
+        scalar_t* buffer = send_buffers.back().data();
+        for (auto& block : rank_blocks.second) {
+            Segment const& row = rows[ block.first  ];
+            Segment const& col = cols[ block.second ];
+            auto Aij = A( row.a_tile, col.a_tile );
+            pack_block( Aij, row.a_offset, col.a_offset, row.size, col.size,
+                        buffer );
+            buffer += row.size * col.size;
+        }
+        internal::count_message( rank_blocks.first,
+                                 send_buffers.back().size() * sizeof(scalar_t) );
+        MPI_Request request;
+        slate_mpi_call(
+            MPI_Isend( send_buffers.back().data(), send_buffers.back().size(),
+                       mpi_type<scalar_t>::value, rank_blocks.first, tag,
+                       mpi_comm, &request ) );
+        send_requests.push_back( request );
+    }
+
+    // Copy local blocks while messages are in flight.
+    std::vector<scalar_t> local_buffer;
+    for (auto& block : local_blocks) {
+        Segment const& row = rows[ block.first  ];
+        Segment const& col = cols[ block.second ];
+        local_buffer.resize( row.size * col.size );
+        auto Aij = A( row.a_tile, col.a_tile );
+        auto Bij = B( row.b_tile, col.b_tile );
+        pack_block( Aij, row.a_offset, col.a_offset, row.size, col.size,
+                    local_buffer.data() );
+        unpack_block( local_buffer.data(), row.size, col.size,
+                      Bij, row.b_offset, col.b_offset );
+    }
+
+    // Unpack messages as they arrive.
+    for (size_t k = 0; k < recv_requests.size(); ++k) {
+        int index;
+        slate_mpi_call(
+            MPI_Waitany( recv_requests.size(), recv_requests.data(),
+                         &index, MPI_STATUS_IGNORE ) );
+        scalar_t const* buffer = recv_buffers[ index ].data();
+        for (auto& block : recv_blocks[ recv_ranks[ index ] ]) {
+            Segment const& row = rows[ block.first  ];
+            Segment const& col = cols[ block.second ];
+            auto Bij = B( row.b_tile, col.b_tile );
+            unpack_block( buffer, row.size, col.size,
+                          Bij, row.b_offset, col.b_offset );
+            buffer += row.size * col.size;
+        }
+    }
+
+    internal::waitall( send_requests );
+}
+
+} // namespace impl
+
+//------------------------------------------------------------------------------
+/// Redistribute a matrix A from one distribution into matrix B with another
+/// distribution, so that op(B) = op(A). A and B can have different tile
+/// sizes and process grids, but must have the same MPI communicator.
+/// All ranks with tiles of A or B must call it.
+///
+/// If A and B have the same tiles and op, and GPU-aware MPI is enabled,
+/// tiles are sent directly between device memories. Otherwise, each pair
+/// of ranks exchanges one packed message; @see impl::redistribute_packed.
+/// @ingroup copy_internal
+///
+template <typename scalar_t>
+void redistribute(
+    Matrix<scalar_t>& A,
+    Matrix<scalar_t>& B,
+    Options const& opts )
+{
+    trace::Block trace_block("slate::redistribute");
+
+    slate_assert( A.m() == B.m() );
+    slate_assert( A.n() == B.n() );
+
+    bool same_tiles = A.op() == B.op()
+                      && A.mt() == B.mt() && A.nt() == B.nt();
+    for (int64_t i = 0; i < A.mt() && same_tiles; ++i)
+        same_tiles = A.tileMb( i ) == B.tileMb( i );
+    for (int64_t j = 0; j < A.nt() && same_tiles; ++j)
+        same_tiles = A.tileNb( j ) == B.tileNb( j );
+
+    if (same_tiles && gpu_aware_mpi())
+        impl::redistribute_tiles( A, B );
+    else
+        impl::redistribute_packed( A, B );
 }
 
 //------------------------------------------------------------------------------
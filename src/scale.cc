@@ -71,13 +71,7 @@ void scale(
     Matrix<scalar_t>& A,
     Options const& opts )
 {
-    Target target;
-    try {
-        target = Target(opts.at(Option::Target).i_);
-    }
-    catch (std::out_of_range&) {
-        target = Target::HostTask;
-    }
+    Target target = get_target( opts, Target::HostTask );
 
     switch (target) {
         case Target::Host:
@@ -188,13 +182,7 @@ void scale(
     BaseTrapezoidMatrix<scalar_t>& A,
     Options const& opts )
 {
-    Target target;
-    try {
-        target = Target(opts.at(Option::Target).i_);
-    }
-    catch (std::out_of_range&) {
-        target = Target::HostTask;
-    }
+    Target target = get_target( opts, Target::HostTask );
 
     switch (target) {
         case Target::Host:
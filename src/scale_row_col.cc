@@ -24,23 +24,9 @@ void scale_row_col(
     Matrix<scalar_t>& A,
     Options const& opts )
 {
-    //scalar_t2* dR = nullptr;
-    //scalar_t2* dC = nullptr;
-    //scalar_t2** dRarray = nullptr;
-    //scalar_t2** dCarray = nullptr;
-
     if (target == Target::Devices) {
         A.allocateBatchArrays();
         A.reserveDeviceWorkspace();
-
-        //if (equed == Equed::Row || equed == Equed::Both) {
-        //    dR      = blas::device_malloc< scalar_t2  >( A.m()  );
-        //    dRarray = blas::device_malloc< scalar_t2* >( A.mt() );
-        //}
-        //if (equed == Equed::Col || equed == Equed::Both) {
-        //    dC      = blas::device_malloc< scalar_t2  >( A.n()  );
-        //    dCarray = blas::device_malloc< scalar_t2* >( A.nt() );
-        //}
     }
 
     #pragma omp parallel
@@ -48,18 +34,60 @@ void scale_row_col(
     {
         internal::scale_row_col<target>(
             equed, R, C, std::move(A) );
-            //dR, dRarray, dC, dCarray );
         A.tileUpdateAllOrigin();
     }
 
     A.releaseWorkspace();
+}
+
+//------------------------------------------------------------------------------
+/// @internal
+/// Apply symmetric scaling, $A = diag(S) A diag(S)$, to a Hermitian matrix.
+/// Each block column (lower) or block row (upper) of the stored triangle is
+/// a general matrix, scaled with the corresponding pieces of S.
+/// Generic implementation for any target.
+/// @ingroup scale_impl
+///
+template <Target target, typename scalar_t, typename scalar_t2>
+void scale_row_col(
+    std::vector<scalar_t2> const& S,
+    HermitianMatrix<scalar_t>& A,
+    Options const& opts )
+{
+    if (target == Target::Devices) {
+        A.allocateBatchArrays();
+        A.reserveDeviceWorkspace();
+    }
+
+    bool lower = A.uplo() == Uplo::Lower;
+    int64_t nt = A.nt();
+    int64_t n  = A.n();
+
+    #pragma omp parallel
+    #pragma omp master
+    {
+        int64_t kk = 0;
+        for (int64_t k = 0; k < nt; ++k) {
+            int64_t kb = A.tileNb( k );
+            auto Sk = std::vector<scalar_t2>( S.begin() + kk,
+                                              S.begin() + kk + kb );
+            auto Sr = std::vector<scalar_t2>( S.begin() + kk, S.begin() + n );
+            if (lower) {
+                auto Ak = Matrix<scalar_t>( A, k, nt-1, k, k );
+                internal::scale_row_col<target>(
+                    Equed::Both, Sr, Sk, std::move( Ak ) );
+            }
+            else {
+                auto Ak = Matrix<scalar_t>( A, k, k, k, nt-1 );
+                internal::scale_row_col<target>(
+                    Equed::Both, Sk, Sr, std::move( Ak ) );
+            }
+            kk += kb;
+        }
+        A.tileUpdateAllOrigin();
+    }
 
-    //if (target == Target::Devices) {
-    //    blas::device_free( dR );
-    //    blas::device_free( dRarray );
-    //    blas::device_free( dC );
-    //    blas::device_free( dCarray );
-    //}
+    A.releaseWorkspace();
 }
 
 } // namespace impl
@@ -105,7 +133,7 @@ void scale_row_col(
     std::vector<scalar_t2> const& C,
     Matrix<scalar_t>& A, Options const& opts )
 {
-    Target target = get_option( opts, Option::Target, Target::HostTask );
+    Target target = get_target( opts, Target::HostTask );
 
     switch (target) {
         case Target::Host:
@@ -116,11 +144,59 @@ void scale_row_col(
             break;
 
         case Target::Devices:
+        case Target::Hybrid:
             impl::scale_row_col<Target::Devices>( equed, R, C, A, opts );
             break;
     }
 }
 
+//------------------------------------------------------------------------------
+/// Apply symmetric scaling to a Hermitian matrix, setting
+/// $A = diag(S) A diag(S)$, e.g., with S from poequ.
+/// Only the stored triangle is referenced and scaled.
+//------------------------------------------------------------------------------
+/// @tparam scalar_t
+///     One of float, double, std::complex<float>, std::complex<double>.
+//------------------------------------------------------------------------------
+/// @param[in] S
+///     Vector of length n containing the real scaling factors.
+///
+/// @param[in,out] A
+///     The n-by-n Hermitian matrix A.
+///
+/// @param[in] opts
+///     Additional options, as map of name = value pairs. Possible options:
+///     - Option::Target:
+///       Implementation to target. Possible values:
+///       - HostTask:  OpenMP tasks on CPU host [default].
+///       - HostNest:  [uses HostTask]
+///       - HostBatch: [uses HostTask]
+///       - Devices:   batched BLAS on GPU device.
+///
+/// @ingroup scale
+///
+template <typename scalar_t, typename scalar_t2>
+void scale_row_col(
+    std::vector<scalar_t2> const& S,
+    HermitianMatrix<scalar_t>& A, Options const& opts )
+{
+    Target target = get_target( opts, Target::HostTask );
+
+    switch (target) {
+        case Target::Host:
+        case Target::HostTask:
+        case Target::HostNest:
+        case Target::HostBatch:
+            impl::scale_row_col<Target::HostTask>( S, A, opts );
+            break;
+
+        case Target::Devices:
+        case Target::Hybrid:
+            impl::scale_row_col<Target::Devices>( S, A, opts );
+            break;
+    }
+}
+
 //------------------------------------------------------------------------------
 // Explicit instantiations.
 template
@@ -173,4 +249,29 @@ void scale_row_col(
     Matrix< std::complex<double> >& A,
     Options const& opts);
 
+// Hermitian, real S
+template
+void scale_row_col(
+    std::vector<float> const& S,
+    HermitianMatrix<float>& A,
+    Options const& opts);
+
+template
+void scale_row_col(
+    std::vector<double> const& S,
+    HermitianMatrix<double>& A,
+    Options const& opts);
+
+template
+void scale_row_col(
+    std::vector<float> const& S,
+    HermitianMatrix< std::complex<float> >& A,
+    Options const& opts);
+
+template
+void scale_row_col(
+    std::vector<double> const& S,
+    HermitianMatrix< std::complex<double> >& A,
+    Options const& opts);
+
 } // namespace slate
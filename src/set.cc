@@ -5,6 +5,7 @@
 
 #include "slate/slate.hh"
 #include "internal/internal.hh"
+#include "internal/internal_util.hh"
 
 namespace slate {
 
@@ -36,6 +37,8 @@ void set(
         A.tileUpdateAllOrigin();
     }
 
+    internal::zero_tiles_set( offdiag_value, diag_value, A );
+
     A.releaseWorkspace();
 }
 
@@ -43,6 +46,8 @@ void set(
 
 //------------------------------------------------------------------------------
 /// Set matrix entries.
+/// If A tracks structurally zero tiles, marks the tiles that are set to
+/// zero, and unmarks the others; @see BaseMatrix::trackZeroTiles.
 /// Transposition is currently ignored.
 /// TODO: Inspect transposition?
 //------------------------------------------------------------------------------
@@ -75,7 +80,7 @@ void set(
     Matrix<scalar_t>& A,
     Options const& opts )
 {
-    Target target = get_option( opts, Option::Target, Target::HostTask );
+    Target target = get_target( opts, Target::HostTask );
 
     switch (target) {
         case Target::Host:
@@ -154,6 +159,8 @@ void set(
         A.tileUpdateAllOrigin();
     }
 
+    internal::zero_tiles_set( offdiag_value, diag_value, A );
+
     A.releaseWorkspace();
 }
 
@@ -161,6 +168,8 @@ void set(
 
 //------------------------------------------------------------------------------
 /// Set matrix entries.
+/// If A tracks structurally zero tiles, marks the tiles that are set to
+/// zero, and unmarks the others; @see BaseMatrix::trackZeroTiles.
 /// Transposition is currently ignored.
 /// TODO: Inspect transposition?
 //------------------------------------------------------------------------------
@@ -193,7 +202,7 @@ void set(
     BaseTrapezoidMatrix<scalar_t>& A,
     Options const& opts )
 {
-    Target target = get_option( opts, Option::Target, Target::HostTask );
+    Target target = get_target( opts, Target::HostTask );
 
     switch (target) {
         case Target::Host:
@@ -7,6 +7,84 @@
 
 namespace slate {
 
+namespace impl {
+
+//------------------------------------------------------------------------------
+/// @internal
+/// Sets the given local tiles of A, which reside on the devices, from the
+/// function value. The host evaluates value into a pinned staging buffer,
+/// one task per tile, and each task copies its tile straight into the
+/// device tile, so the host instance of A is neither allocated nor
+/// read back. Requires A not transposed.
+/// @ingroup set_impl
+///
+template <typename scalar_t>
+void set_device_tiles(
+    std::function< scalar_t (int64_t i, int64_t j) > const& value,
+    BaseMatrix<scalar_t>& A,
+    std::vector< std::pair< int64_t, int64_t > > const& tiles )
+{
+    if (tiles.empty())
+        return;
+
+    // Global offsets of block rows and columns.
+    std::vector<int64_t> row_offsets( A.mt()+1, 0 );
+    std::vector<int64_t> col_offsets( A.nt()+1, 0 );
+    for (int64_t i = 0; i < A.mt(); ++i)
+        row_offsets[ i+1 ] = row_offsets[ i ] + A.tileMb( i );
+    for (int64_t j = 0; j < A.nt(); ++j)
+        col_offsets[ j+1 ] = col_offsets[ j ] + A.tileNb( j );
+
+    // Offset of each tile in the staging buffer.
+    std::vector<int64_t> stage_offsets( tiles.size()+1, 0 );
+    for (size_t t = 0; t < tiles.size(); ++t) {
+        stage_offsets[ t+1 ] = stage_offsets[ t ]
+            + A.tileMb( tiles[ t ].first ) * A.tileNb( tiles[ t ].second );
+    }
+    scalar_t* stage = blas::host_malloc_pinned<scalar_t>(
+                          stage_offsets.back(), *A.comm_queue( 0 ) );
+
+    #pragma omp parallel
+    #pragma omp master
+    {
+        for (size_t t = 0; t < tiles.size(); ++t) {
+            #pragma omp task slate_omp_default_none \
+                shared( A, value, tiles, row_offsets, col_offsets, \
+                        stage_offsets ) \
+                firstprivate( t, stage )
+            {
+                int64_t i = tiles[ t ].first;
+                int64_t j = tiles[ t ].second;
+                int64_t mb = A.tileMb( i );
+                int64_t nb = A.tileNb( j );
+                int64_t i_global = row_offsets[ i ];
+                int64_t j_global = col_offsets[ j ];
+                scalar_t* buffer = &stage[ stage_offsets[ t ] ];
+                for (int64_t jj = 0; jj < nb; ++jj) {
+                    for (int64_t ii = 0; ii < mb; ++ii) {
+                        buffer[ ii + jj*mb ]
+                            = value( i_global + ii, j_global + jj );
+                    }
+                }
+
+                int device = A.tileDevice( i, j );
+                A.tileGetForWriting( i, j, device, LayoutConvert::ColMajor );
+                auto T = A( i, j, device );
+                blas::device_copy_matrix(
+                    mb, nb, buffer, mb, T.data(), T.stride(),
+                    *A.comm_queue( device ) );
+            }
+        }
+    }
+
+    // Wait for the copies before freeing the staging buffer.
+    for (int device = 0; device < A.num_devices(); ++device)
+        A.comm_queue( device )->sync();
+    blas::host_free_pinned( stage, *A.comm_queue( 0 ) );
+}
+
+} // namespace impl
+
 //------------------------------------------------------------------------------
 /// Set matrix entries.
 /// Transposition is automatically handled.
@@ -22,8 +100,14 @@ namespace slate {
 ///     The m-by-n matrix A.
 ///
 /// @param[in] opts
-///     Additional options, as map of name = value pairs. Currently no options.
-///     It always uses Target = HostTask, since lambda is a CPU function.
+///     Additional options, as map of name = value pairs. Possible options:
+///     - Option::Target:
+///       Implementation to target. Possible values:
+///       - HostTask: OpenMP tasks on CPU host [default].
+///       - Devices:  if A's tiles originate on the devices, the host
+///         evaluates value, a CPU function, into a pinned buffer, and
+///         copies each tile straight into its device tile. Otherwise,
+///         same as HostTask.
 ///
 /// @ingroup set
 ///
@@ -36,6 +120,20 @@ void set(
     int64_t mt = A.mt();
     int64_t nt = A.nt();
 
+    Target target = get_target( opts, Target::HostTask );
+    if (target == Target::Devices && A.origin() == Target::Devices
+        && A.op() == Op::NoTrans) {
+        std::vector< std::pair< int64_t, int64_t > > tiles;
+        for (int64_t j = 0; j < nt; ++j) {
+            for (int64_t i = 0; i < mt; ++i) {
+                if (A.tileIsLocal( i, j ))
+                    tiles.push_back( { i, j } );
+            }
+        }
+        impl::set_device_tiles( value, A, tiles );
+        return;
+    }
+
     #pragma omp parallel
     #pragma omp master
     {
@@ -111,8 +209,14 @@ void set(
 ///     The m-by-n matrix A.
 ///
 /// @param[in] opts
-///     Additional options, as map of name = value pairs. Currently no options.
-///     It always uses Target = HostTask, since lambda is a CPU function.
+///     Additional options, as map of name = value pairs. Possible options:
+///     - Option::Target:
+///       Implementation to target. Possible values:
+///       - HostTask: OpenMP tasks on CPU host [default].
+///       - Devices:  if A's tiles originate on the devices, the host
+///         evaluates value, a CPU function, into a pinned buffer, and
+///         copies each tile straight into its device tile. Otherwise,
+///         same as HostTask.
 ///
 /// @ingroup set
 ///
@@ -126,6 +230,22 @@ void set(
     int64_t nt = A.nt();
     bool upper = A.uplo() == Uplo::Upper;
 
+    Target target = get_target( opts, Target::HostTask );
+    if (target == Target::Devices && A.origin() == Target::Devices
+        && A.op() == Op::NoTrans) {
+        std::vector< std::pair< int64_t, int64_t > > tiles;
+        for (int64_t j = 0; j < nt; ++j) {
+            int64_t istart = upper ? 0 : j;
+            int64_t iend   = upper ? std::min( j+1, mt ) : mt;
+            for (int64_t i = istart; i < iend; ++i) {
+                if (A.tileIsLocal( i, j ))
+                    tiles.push_back( { i, j } );
+            }
+        }
+        impl::set_device_tiles( value, A, tiles );
+        return;
+    }
+
     #pragma omp parallel
     #pragma omp master
     {
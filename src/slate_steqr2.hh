@@ -57,6 +57,36 @@ extern "C" void slate_zsteqr2(
     double* work,
     blas_int* info);
 
+// -----------------------------------------------------------------------------
+// Multithreaded replacements for xLASR( 'R', 'V', direct, ... ), called by
+// slate_xsteqr2 to apply each sweep of Givens rotations to Z.
+// Defined in steqr2.cc.
+
+#define slate_slasr BLAS_FORTRAN_NAME( slate_slasr, SLATE_SLASR )
+#define slate_dlasr BLAS_FORTRAN_NAME( slate_dlasr, SLATE_DLASR )
+#define slate_clasr BLAS_FORTRAN_NAME( slate_clasr, SLATE_CLASR )
+#define slate_zlasr BLAS_FORTRAN_NAME( slate_zlasr, SLATE_ZLASR )
+
+extern "C" void slate_slasr(
+    const char* direct, const blas_int* m, const blas_int* n,
+    const float* c, const float* s,
+    float* z, const blas_int* ldz);
+
+extern "C" void slate_dlasr(
+    const char* direct, const blas_int* m, const blas_int* n,
+    const double* c, const double* s,
+    double* z, const blas_int* ldz);
+
+extern "C" void slate_clasr(
+    const char* direct, const blas_int* m, const blas_int* n,
+    const float* c, const float* s,
+    std::complex<float>* z, const blas_int* ldz);
+
+extern "C" void slate_zlasr(
+    const char* direct, const blas_int* m, const blas_int* n,
+    const double* c, const double* s,
+    std::complex<double>* z, const blas_int* ldz);
+
 // -----------------------------------------------------------------------------
 
 inline void slate_steqr2(
@@ -99,7 +99,7 @@
 *     ..
 *     .. External Subroutines ..
       EXTERNAL           SLAE2, SLAEV2, SLARTG, SLASCL, SLASR,
-     $                   SLASRT, SSWAP, XERBLA
+     $                   SLASRT, SSWAP, SLATE_SLASR, XERBLA
 *     ..
 *     .. Intrinsic Functions ..
       INTRINSIC          ABS, MAX, SIGN, SQRT
@@ -306,7 +306,7 @@
 *
          IF( ICOMPZ.GT.0 ) THEN
             MM = M - L + 1
-            CALL SLASR( 'R', 'V', 'B', NR, MM, WORK( L ), WORK( N-1+L ),
+            CALL SLATE_SLASR( 'B', NR, MM, WORK( L ), WORK( N-1+L ),
      $                  Z( 1, L ), LDZ )
          END IF
 *
@@ -413,7 +413,7 @@
 *
          IF( ICOMPZ.GT.0 ) THEN
             MM = L - M + 1
-            CALL SLASR( 'R', 'V', 'F', NR, MM, WORK( M ), WORK( N-1+M ),
+            CALL SLATE_SLASR( 'F', NR, MM, WORK( M ), WORK( N-1+M ),
      $                  Z( 1, M ), LDZ )
          END IF
 *
@@ -0,0 +1,197 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/slate.hh"
+#include "internal/internal.hh"
+
+#include <cmath>
+#include <limits>
+
+namespace slate {
+
+namespace impl {
+
+//------------------------------------------------------------------------------
+/// @internal
+/// Sturm count: returns the number of eigenvalues of the symmetric
+/// tridiagonal matrix T = tridiag( E, D, E ) that are <= x,
+/// as in LAPACK laebz. E2 has the squares of the off-diagonal entries.
+/// Pivots smaller than pivmin are replaced by -pivmin.
+///
+template <typename real_t>
+int64_t stebz_count(
+    int64_t n, real_t const* D, real_t const* E2, real_t pivmin, real_t x )
+{
+    int64_t count = 0;
+    real_t q = D[ 0 ] - x;
+    if (std::abs( q ) < pivmin)
+        q = -pivmin;
+    if (q <= 0)
+        ++count;
+    for (int64_t i = 1; i < n; ++i) {
+        q = D[ i ] - E2[ i-1 ] / q - x;
+        if (std::abs( q ) < pivmin)
+            q = -pivmin;
+        if (q <= 0)
+            ++count;
+    }
+    return count;
+}
+
+} // namespace impl
+
+//------------------------------------------------------------------------------
+/// Computes selected eigenvalues of a symmetric tridiagonal matrix
+/// by bisection, as in LAPACK stebz.
+/// Eigenvalue k is found by bisection of the Sturm count independently
+/// of the others, so the selected eigenvalues are computed in parallel
+/// by the OpenMP threads. Each MPI rank computes them redundantly,
+/// in O( n m log( 1/eps ) ) time for m eigenvalues, which is small
+/// compared to the reduction to tridiagonal form.
+///
+//------------------------------------------------------------------------------
+/// @tparam real_t
+///     One of float, double.
+//------------------------------------------------------------------------------
+/// @param[in] range
+///     - Range::All:   find all eigenvalues.
+///     - Range::Value: find eigenvalues in the half-open interval (vl, vu].
+///     - Range::Index: find eigenvalues with 1-based indices il through iu.
+///
+/// @param[in] vl, vu
+///     If range = Value, the lower and upper bounds of the interval;
+///     vl < vu. Otherwise not referenced.
+///
+/// @param[in] il, iu
+///     If range = Index, the 1-based indices of the smallest and largest
+///     eigenvalues to find; 1 <= il <= iu <= n, or il = 1 and iu = 0
+///     if n = 0. Otherwise not referenced.
+///
+/// @param[in] D
+///     The n diagonal entries of the tridiagonal matrix.
+///
+/// @param[in] E
+///     The n-1 off-diagonal entries of the tridiagonal matrix.
+///
+/// @param[out] Lambda
+///     On exit, the m selected eigenvalues in ascending order,
+///     resized to m.
+///
+/// @param[out] il_out
+///     On exit, the 1-based index of the smallest eigenvalue found,
+///     so Lambda holds eigenvalues il_out, ..., il_out + m - 1.
+///
+/// @param[in] opts
+///     Currently unused.
+///
+/// @ingroup heev_computational
+///
+template <typename real_t>
+void stebz(
+    Range range, real_t vl, real_t vu, int64_t il, int64_t iu,
+    std::vector<real_t> const& D,
+    std::vector<real_t> const& E,
+    std::vector<real_t>& Lambda,
+    int64_t& il_out,
+    Options const& opts )
+{
+    trace::Block trace_block("slate::stebz");
+
+    const real_t safe_min = std::numeric_limits<real_t>::min();
+    const real_t eps      = std::numeric_limits<real_t>::epsilon();
+    const real_t fudge    = 2.1;
+
+    int64_t n = D.size();
+    il_out = 1;
+    if (n == 0) {
+        Lambda.clear();
+        return;
+    }
+
+    if (range == Range::Value && ! (vl < vu))
+        slate_error( "stebz: requires vl < vu" );
+    if (range == Range::Index && (il < 1 || iu < il - 1 || iu > n))
+        slate_error( "stebz: requires 1 <= il <= iu + 1 <= n + 1" );
+
+    // Squared off-diagonal, pivmin, and Gershgorin interval [ gl, gu ].
+    std::vector<real_t> E2( std::max( n - 1, int64_t( 1 ) ) );
+    real_t e2max = 0;
+    for (int64_t i = 0; i < n-1; ++i) {
+        E2[ i ] = E[ i ] * E[ i ];
+        e2max = std::max( e2max, E2[ i ] );
+    }
+    real_t pivmin = safe_min * std::max( real_t( 1 ), e2max );
+
+    real_t gl = D[ 0 ], gu = D[ 0 ];
+    for (int64_t i = 0; i < n; ++i) {
+        real_t radius = (i > 0   ? std::abs( E[ i-1 ] ) : 0)
+                      + (i < n-1 ? std::abs( E[ i   ] ) : 0);
+        gl = std::min( gl, D[ i ] - radius );
+        gu = std::max( gu, D[ i ] + radius );
+    }
+    real_t tnorm = std::max( std::abs( gl ), std::abs( gu ) );
+    gl -= fudge*tnorm*eps*n + fudge*2*pivmin;
+    gu += fudge*tnorm*eps*n + fudge*2*pivmin;
+
+    // Range of 0-based indices [ k_begin, k_end ) to find.
+    int64_t k_begin = 0, k_end = n;
+    if (range == Range::Value) {
+        k_begin = impl::stebz_count( n, &D[ 0 ], &E2[ 0 ], pivmin, vl );
+        k_end   = impl::stebz_count( n, &D[ 0 ], &E2[ 0 ], pivmin, vu );
+    }
+    else if (range == Range::Index) {
+        k_begin = il - 1;
+        k_end   = iu;
+    }
+    int64_t m = k_end - k_begin;
+    il_out = k_begin + 1;
+    Lambda.resize( m );
+
+    // Bisection until the interval is below the absolute tolerance
+    // 2 fudge pivmin or the relative tolerance 2 eps.
+    const real_t atol = fudge*2*pivmin;
+    const real_t rtol = 2*eps;
+    const int max_iters = 4*std::numeric_limits<real_t>::digits;
+
+    #pragma omp parallel for schedule( dynamic, 16 )
+    for (int64_t k = k_begin; k < k_end; ++k) {
+        // Invariant: count( lo ) <= k < count( hi ).
+        real_t lo = gl, hi = gu;
+        for (int iter = 0; iter < max_iters; ++iter) {
+            real_t tol = std::max( atol,
+                                   rtol*std::max( std::abs( lo ), std::abs( hi ) ) );
+            if (hi - lo <= tol)
+                break;
+            real_t mid = (lo + hi) / 2;
+            if (impl::stebz_count( n, &D[ 0 ], &E2[ 0 ], pivmin, mid ) > k)
+                hi = mid;
+            else
+                lo = mid;
+        }
+        Lambda[ k - k_begin ] = (lo + hi) / 2;
+    }
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void stebz<float>(
+    Range range, float vl, float vu, int64_t il, int64_t iu,
+    std::vector<float> const& D,
+    std::vector<float> const& E,
+    std::vector<float>& Lambda,
+    int64_t& il_out,
+    Options const& opts);
+
+template
+void stebz<double>(
+    Range range, double vl, double vu, int64_t il, int64_t iu,
+    std::vector<double> const& D,
+    std::vector<double> const& E,
+    std::vector<double>& Lambda,
+    int64_t& il_out,
+    Options const& opts);
+
+} // namespace slate
@@ -67,17 +67,28 @@ void stedc(
     lapack::lascl( MatrixType::General, 0, 0, Anorm, one, n,   1, &D[0], n   );
     lapack::lascl( MatrixType::General, 0, 0, Anorm, one, n-1, 1, &E[0], n-1 );
 
-    // For now, the algorithm is CPU-only.
-    // Move Q to the CPU and reset target.
+    // The algorithm runs on the CPU, except that with Target::Devices,
+    // stedc_merge solves the secular equation, multiplies the eigenvectors,
+    // and permutes their columns on devices, so the eigenvectors W and
+    // the workspace Q stay on the devices across merge levels.
+    // Otherwise, move Q to the CPU and reset target for the rest.
     // todo: the MOSI API doesn't have a way to do Hold + Modified in one call.
-    Q.tileGetAndHoldAll( HostNum, LayoutConvert::ColMajor ); // get for reading
-    Q.tileGetAllForWriting( HostNum, LayoutConvert::ColMajor );
+    Target target = get_target( opts, Target::HostTask );
+    bool use_device = target == Target::Devices && Q.num_devices() > 0;
     Options opts_local( opts );
-    opts_local[ Option::Target ] = Target::HostTask;
+    if (! use_device) {
+        Q.tileGetAndHoldAll( HostNum, LayoutConvert::ColMajor ); // get for reading
+        Q.tileGetAllForWriting( HostNum, LayoutConvert::ColMajor );
+        opts_local[ Option::Target ] = Target::HostTask;
+    }
 
     // Allocate workspace matrices W and U needed in stedc_merge.
+    // U is updated by the secular solver on the CPU.
     auto W = Q.emptyLike();
-    W.insertLocalTiles();
+    if (use_device)
+        W.insertLocalTiles( Target::Devices );
+    else
+        W.insertLocalTiles();
 
     auto U = Q.emptyLike();
     U.insertLocalTiles();
@@ -87,19 +98,25 @@ void stedc(
     if (sort) {
         // Computing eigenvectors in W and sorting into Q saves a copy.
         set( zero, one, W, opts_local );
-        stedc_solve( D, E, W, Q, U, opts_local );
+        stedc_solve( D, E, W, Q, U, opts );
         stedc_sort( D, W, Q, opts_local );
     }
     else {
         // Compute eigenvectors directly in Q.
         set( zero, one, Q, opts_local );
-        stedc_solve( D, E, Q, W, U, opts_local );
+        stedc_solve( D, E, Q, W, U, opts );
     }
 
     // Scale eigenvalues back.
     lapack::lascl( MatrixType::General, 0, 0, one, Anorm, n, 1, &D[0], n );
 
-    Q.tileUnsetHoldAll( HostNum );
+    if (use_device) {
+        Q.tileUpdateAllOrigin();
+        Q.releaseWorkspace();
+    }
+    else {
+        Q.tileUnsetHoldAll( HostNum );
+    }
 }
 
 //------------------------------------------------------------------------------
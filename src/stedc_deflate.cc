@@ -5,6 +5,7 @@
 
 #include "slate/slate.hh"
 #include "internal/Array2D.hh"
+#include "internal/internal_copy_col.hh"
 
 #include <numeric>
 
@@ -168,6 +169,10 @@ void stedc_deflate(
     int mpi_rank = Q.mpiRank();
     MPI_Comm comm = Q.mpiComm();
 
+    // With Target::Devices, Q and Qtype stay on the devices.
+    Target target = get_target( opts, Target::HostTask );
+    bool use_device = target == Target::Devices && Q.num_devices() > 0;
+
     // Constants.
     const int tag_0 = 0;
     const MPI_Datatype mpi_real_t = mpi_type<real_t>::value;
@@ -245,8 +250,9 @@ void stedc_deflate(
     // After deflation:
     //     D( ideflate( 0 : nsecular-1 ) ) are non-deflated, ascending;
     //     D( ideflate( nsecular : n-1 ) ) are deflated, descending.
-    std::vector<real_t> buf_vector( n );  // todo: only need nb?
+    std::vector<real_t> buf_vector( n );  // one column of Q
     real_t* buf = buf_vector.data();
+    std::vector<MPI_Request> requests;
     std::vector<int64_t> isort( n );        // (Was: indx, as workspace)
     std::vector<int64_t> ideflate( n );     // (Was: indxp)
     std::vector<int64_t> iglobal( n );      // (Was: indxc)
@@ -344,6 +350,63 @@ void stedc_deflate(
 
                 // Apply Givens rotation on right to columns js1, js2 of Q
                 // Q( :, [js1, js2] ) = Q( :, [js1, js2] ) * G';
+                // Where only one column is local, exchange it with the rank
+                // owning the other column. Messages for all block rows are
+                // posted at once, so they overlap, then rot is applied.
+                // rot is applied redundantly on both rank1 and rank2;
+                // buf contents are discarded.
+                // With Q on devices, bring the local tiles of both columns
+                // to the host; copy_cols below gathers them back.
+                if (use_device) {
+                    for (int64_t ii = 0; ii < nt; ++ii) {
+                        if (Q.tileRank( ii, jj1 ) == mpi_rank)
+                            Q.tileGetForWriting( ii, jj1, LayoutConvert::ColMajor );
+                        if (Q.tileRank( ii, jj2 ) == mpi_rank)
+                            Q.tileGetForWriting( ii, jj2, LayoutConvert::ColMajor );
+                    }
+                }
+
+                requests.clear();
+                int64_t ioffset = 0;  // offset of block row ii in buf.
+                for (int64_t ii = 0; ii < nt; ++ii) {
+                    int64_t mb = Q.tileMb( ii );
+                    int rank1 = Q.tileRank( ii, jj1 );
+                    int rank2 = Q.tileRank( ii, jj2 );
+                    if (rank1 == mpi_rank && rank2 != mpi_rank) {
+                        // js1 is local; send js1, recv js2.
+                        auto T1 = Q( ii, jj1 );
+                        real_t* x1 = &T1.at( 0, jj1_offset );
+                        requests.resize( requests.size() + 2 );
+                        slate_mpi_call(
+                            MPI_Irecv( &buf[ ioffset ], mb, mpi_real_t,
+                                       rank2, tag_0, comm,
+                                       &requests.end()[ -2 ] ) );
+                        slate_mpi_call(
+                            MPI_Isend( x1, mb, mpi_real_t,
+                                       rank2, tag_0, comm,
+                                       &requests.end()[ -1 ] ) );
+                    }
+                    else if (rank2 == mpi_rank && rank1 != mpi_rank) {
+                        // js2 is local; recv js1, send js2.
+                        auto T2 = Q( ii, jj2 );
+                        real_t* x2 = &T2.at( 0, jj2_offset );
+                        requests.resize( requests.size() + 2 );
+                        slate_mpi_call(
+                            MPI_Irecv( &buf[ ioffset ], mb, mpi_real_t,
+                                       rank1, tag_0, comm,
+                                       &requests.end()[ -2 ] ) );
+                        slate_mpi_call(
+                            MPI_Isend( x2, mb, mpi_real_t,
+                                       rank1, tag_0, comm,
+                                       &requests.end()[ -1 ] ) );
+                    }
+                    ioffset += mb;
+                }
+                slate_mpi_call(
+                    MPI_Waitall( requests.size(), requests.data(),
+                                 MPI_STATUSES_IGNORE ) );
+
+                ioffset = 0;
                 for (int64_t ii = 0; ii < nt; ++ii) {
                     int64_t mb = Q.tileMb( ii );
                     int rank1 = Q.tileRank( ii, jj1 );
@@ -357,29 +420,16 @@ void stedc_deflate(
                         blas::rot( mb, x1, 1, x2, 1, c, s );
                     }
                     else if (rank1 == mpi_rank) {
-                        // js1 is local; send js1, recv js2, apply rot.
-                        // rot is applied redundantly on both rank1 and rank2;
-                        // buf contents are discarded.
                         auto T1 = Q( ii, jj1 );
                         real_t* x1 = &T1.at( 0, jj1_offset );
-                        slate_mpi_call(
-                            MPI_Sendrecv(
-                                x1,  mb, mpi_real_t, rank2, tag_0,
-                                buf, mb, mpi_real_t, rank2, tag_0,
-                                comm, MPI_STATUS_IGNORE ));
-                        blas::rot( mb, x1, 1, buf, 1, c, s );
+                        blas::rot( mb, x1, 1, &buf[ ioffset ], 1, c, s );
                     }
                     else if (rank2 == mpi_rank) {
-                        // js2 is local; recv js1, send js2, apply rot as above.
                         auto T2 = Q( ii, jj2 );
                         real_t* x2 = &T2.at( 0, jj2_offset );
-                        slate_mpi_call(
-                            MPI_Sendrecv(
-                                x2,  mb, mpi_real_t, rank1, tag_0,
-                                buf, mb, mpi_real_t, rank1, tag_0,
-                                comm, MPI_STATUS_IGNORE ));
-                        blas::rot( mb, buf, 1, x2, 1, c, s );
+                        blas::rot( mb, &buf[ ioffset ], 1, x2, 1, c, s );
                     }
+                    ioffset += mb;
                 }
 
                 // Apply Givens rotation on both sides of D (see offdiag above).
@@ -480,6 +530,7 @@ void stedc_deflate(
     // This merges 3 loops from ScaLAPACK.
     // For permuting D, uses z as workspace, since z was copied to zsecular.
     std::copy( &D[ 0 ], &D[ n ], z );
+    std::vector< std::pair<int64_t, int64_t> > permute_cols;
     for (int64_t j = 0; j < n; ++j) {
         int64_t jd, jt, jt_local, jg;
         int pcol, ctype;
@@ -496,23 +547,9 @@ void stedc_deflate(
         iglobal[ jg ] = jt;
 
         // Copy & permute Q(:, ideflate(j)) => Qtype(:, itype(j)),
-        // if this process owns them.
+        // if this process owns them; copied after the loop.
         if (pcol == mycol) {
-            int64_t jjd        = jd / nb;
-            int64_t jjd_offset = jd % nb;
-            int64_t jjt        = jt / nb;
-            int64_t jjt_offset = jt % nb;
-            for (int64_t ii = 0; ii < nt; ++ii) {
-                int64_t mb = Q.tileMb( ii );
-                if (Q.tileIsLocal( ii, jjd )) {
-                    assert( Qtype.tileIsLocal( ii, jjt ) );
-                    auto T1 =     Q( ii, jjd );
-                    auto T2 = Qtype( ii, jjt );
-                    real_t* x1 = &T1.at( 0, jjd_offset );
-                    real_t* x2 = &T2.at( 0, jjt_offset );
-                    blas::copy( mb, x1, 1, x2, 1 );
-                }
-            }
+            permute_cols.push_back( { jd, jt } );
         }
 
         // The deflated eigenvalues and their corresponding vectors go
@@ -527,6 +564,10 @@ void stedc_deflate(
         //}
     }
 
+    // Gather the columns into Qtype, in one batch per device with
+    // Target::Devices, where Q and Qtype stay.
+    internal::copy_cols( Q, Qtype, permute_cols, use_device );
+
     // Restore ct_idx_global (same code as above).
     ct_idx_global[ 1 ] = 0;
     for (int ctype = 2; ctype <= 4; ++ctype) {
@@ -4,6 +4,7 @@
 // the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
 
 #include "slate/slate.hh"
+#include "slate/internal/comm.hh"
 #include "internal/internal_copy_col.hh"
 
 namespace slate {
@@ -37,6 +38,10 @@ namespace slate {
 /// the current problem are multiplied with the eigenvectors from
 /// the overall problem.
 ///
+/// Only the ranks that own tiles of Q take part; the others return
+/// immediately. So when Q is a diagonal block of a larger matrix, as in
+/// stedc_solve, merges of blocks on disjoint sets of ranks run concurrently.
+///
 /// Corresponds to ScaLAPACK pdlaed1.
 //------------------------------------------------------------------------------
 /// @tparam real_t
@@ -76,7 +81,7 @@ namespace slate {
 ///       - HostTask:  OpenMP tasks on CPU host [default].
 ///       - HostNest:  nested OpenMP parallel for loop on CPU host.
 ///       - HostBatch: batched BLAS on CPU host.
-///       - Devices:   batched BLAS on GPU device.
+///       - Devices:   secular equation and eigenvector gemm on GPU device.
 ///
 /// @ingroup heev_computational
 ///
@@ -106,6 +111,30 @@ void stedc_merge(
     int64_t nt1 = nt / 2;  // smaller half first.
     assert( n1 == nt1 * nb );
 
+    // Collectives use the ranks that own tiles of Q.
+    std::set<int> ranks;
+    Q.getRanks( &ranks );
+    if (ranks.count( Q.mpiRank() ) == 0)
+        return;
+    int q_size;
+    slate_mpi_call(
+        MPI_Comm_size( Q.mpiComm(), &q_size ) );
+    MPI_Comm comm = Q.mpiComm();
+    if (int( ranks.size() ) < q_size) {
+        int comm_rank;
+        comm = internal::commFromSet( ranks, Q.mpiComm(), Q.mpiGroup(),
+                                      Q.mpiRank(), comm_rank );
+    }
+
+    // With Target::Devices, the eigenvector products run as device gemms
+    // and the column permutations as device copies, so Q and Qtype stay
+    // on the devices. The secular solver updates U on the host.
+    Target target = get_target( opts, Target::HostTask );
+    bool use_device = target == Target::Devices && Q.num_devices() > 0;
+    if (use_device) {
+        U.tileGetAllForWriting( HostNum, LayoutConvert::ColMajor );
+    }
+
     std::vector<real_t>  Dsecular( n ), z( n ), zsecular( n );
     std::vector<int64_t> itype( n );
 
@@ -113,7 +142,7 @@ void stedc_merge(
     int64_t Qt12_begin = -1, Qt12_end = -1;
     int64_t Qt23_begin = -1, Qt23_end = -1;
 
-    stedc_z_vector( Q, z );
+    stedc_z_vector( Q, z, comm );
 
     stedc_deflate( n, n1, rho,
                    &D[0], &Dsecular[0],
@@ -130,7 +159,7 @@ void stedc_merge(
 
         stedc_secular( nsecular, n, rho,
                        &Dsecular[0], &zsecular[0], &D[0], U,
-                       &itype[0], opts );
+                       &itype[0], comm, opts );
 
         // Compute the updated eigenvectors.
         // Qt is Qtype, locally permuted into col types 1, 2, 3, and 4:
@@ -194,15 +223,16 @@ void stedc_merge(
         int dcol = r0 / nprow;  // todo: assumes col-major grid
 
         // Copy deflated eigenvectors from Qtype to Q (local operation).
+        std::vector< std::pair<int64_t, int64_t> > deflated_cols;
         for (int64_t j = nsecular; j < n; ++j) {
             int64_t kg = itype[ j ]; // global index
             int64_t k  = kg / nb;   // block index
-            int64_t kk = kg % nb;   // offset within block
             int64_t pk = (k + dcol) % npcol; // process column
             if (pk == mycol) {
-                internal::copy_col( Qtype, k, kk, Q, k, kk );
+                deflated_cols.push_back( { kg, kg } );
             }
         }
+        internal::copy_cols( Qtype, Q, deflated_cols, use_device );
     }
 }
 
@@ -4,6 +4,7 @@
 // the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
 
 #include "slate/slate.hh"
+#include "slate/internal/device.hh"
 
 #include <numeric>
 
@@ -56,6 +57,10 @@ namespace slate {
 ///     as output by stedc_deflate.
 ///     Used to permute Lambda and U to match Qtype.
 ///
+/// @param[in] comm
+///     Communicator of the ranks that solve the roots: U.mpiComm(), or a
+///     subcommunicator of it including all ranks that own tiles of U.
+///
 /// @param[in] opts
 ///     Additional options, as map of name = value pairs. Possible options:
 ///     - Option::Target:
@@ -63,7 +68,9 @@ namespace slate {
 ///       - HostTask:  OpenMP tasks on CPU host [default].
 ///       - HostNest:  nested OpenMP parallel for loop on CPU host.
 ///       - HostBatch: batched BLAS on CPU host.
-///       - Devices:   batched BLAS on GPU device.
+///       - Devices:   roots and eigenvectors of the secular equation
+///         are computed on the first GPU device of each rank,
+///         one root per thread, with ztilde from the Löwner formula.
 ///
 /// @ingroup heev_computational
 ///
@@ -76,14 +83,16 @@ void stedc_secular(
     real_t* Lambda,
     Matrix<real_t>& U,
     int64_t* itype,
+    MPI_Comm comm,
     Options const& opts )
 {
     const MPI_Datatype mpi_real_t = mpi_type<real_t>::value;
 
-    int mpi_rank = U.mpiRank();
-    int mpi_size;
+    int mpi_rank, mpi_size;
+    slate_mpi_call(
+        MPI_Comm_rank( comm, &mpi_rank ) );
     slate_mpi_call(
-        MPI_Comm_size( U.mpiComm(), &mpi_size ) );
+        MPI_Comm_size( comm, &mpi_size ) );
 
     int64_t info = 0, iinfo;
 
@@ -109,28 +118,72 @@ void stedc_secular(
     std::vector<real_t> ztilde( nsecular, 1.0 ),
                         deltaJ( nsecular ),
                         Lambda_local( nsecular );
-    for (int64_t j = begin; j < end; ++j) {
-        iinfo = lapack::laed4( nsecular, j, &D[ 0 ], &z[ 0 ], &deltaJ[ 0 ],
-                               rho, &Lambda_local[ j ] );
-        if (iinfo != 0)
-            info = j;
-
-        // Update local partial product ztilde_partial
-        // ztilde_partial *= deltaJ / (d_i - d_j)
-        for (int64_t i = 0; i < j; ++i) {
-            ztilde[ i ] *= deltaJ[ i ] / (D[ i ] - D[ j ]);
-        }
-        // for i = j, exclude (d_i - d_j) term in denominator.
-        ztilde[ j ] *= deltaJ[ j ];
-        for (int64_t i = j+1; i < nsecular; ++i) {
-            ztilde[ i ] *= deltaJ[ i ] / (D[ i ] - D[ j ]);
+
+    // On devices, each thread solves one root. laed4 returns the
+    // eigenvectors directly for nsecular <= 2, so those stay on the host.
+    Target target = get_target( opts, Target::HostTask );
+    bool use_device = target == Target::Devices && U.num_devices() > 0
+                      && nsecular > 2;
+    const int device = 0;
+    blas::Queue* queue = nullptr;
+    real_t* dD = nullptr;
+    real_t* dz = nullptr;
+    real_t* dztilde = nullptr;
+    if (use_device) {
+        U.allocateBatchArrays();
+        queue = U.compute_queue( device );
+        dD      = blas::device_malloc<real_t>( nsecular, *queue );
+        dz      = blas::device_malloc<real_t>( nsecular, *queue );
+        dztilde = blas::device_malloc<real_t>( nsecular, *queue );
+        blas::device_memcpy<real_t>( dD, D, nsecular, *queue );
+        blas::device_memcpy<real_t>( dz, z, nsecular, *queue );
+
+        // Solve roots [ begin, end ), then their partial products.
+        int64_t ncols = std::max( mycnt, int64_t( 1 ) );
+        std::vector<int64_t> roots( mycnt );
+        std::iota( roots.begin(), roots.end(), begin );
+        int64_t* droots  = blas::device_malloc<int64_t>( ncols, *queue );
+        real_t*  dLambda = blas::device_malloc<real_t>( ncols, *queue );
+        real_t*  dDelta  = blas::device_malloc<real_t>( nsecular*ncols, *queue );
+        blas::device_memcpy<int64_t>( droots, roots.data(), mycnt, *queue );
+
+        device::stedc_secular_roots( nsecular, mycnt, droots, dD, dz, rho,
+                                     dLambda, dDelta, nsecular, *queue );
+        device::stedc_secular_ztilde( nsecular, mycnt, droots, dD,
+                                      dDelta, nsecular, dztilde, *queue );
+        blas::device_memcpy<real_t>( &Lambda_local[ begin ], dLambda, mycnt,
+                                     *queue );
+        blas::device_memcpy<real_t>( &ztilde[ 0 ], dztilde, nsecular, *queue );
+        queue->sync();
+
+        blas::device_free( droots,  *queue );
+        blas::device_free( dLambda, *queue );
+        blas::device_free( dDelta,  *queue );
+    }
+    else {
+        for (int64_t j = begin; j < end; ++j) {
+            iinfo = lapack::laed4( nsecular, j, &D[ 0 ], &z[ 0 ], &deltaJ[ 0 ],
+                                   rho, &Lambda_local[ j ] );
+            if (iinfo != 0)
+                info = j;
+
+            // Update local partial product ztilde_partial
+            // ztilde_partial *= deltaJ / (d_i - d_j)
+            for (int64_t i = 0; i < j; ++i) {
+                ztilde[ i ] *= deltaJ[ i ] / (D[ i ] - D[ j ]);
+            }
+            // for i = j, exclude (d_i - d_j) term in denominator.
+            ztilde[ j ] *= deltaJ[ j ];
+            for (int64_t i = j+1; i < nsecular; ++i) {
+                ztilde[ i ] *= deltaJ[ i ] / (D[ i ] - D[ j ]);
+            }
         }
     }
 
     // ztilde = +- sqrt( prod_{all ranks} ztilde_partial )
     slate_mpi_call(
         MPI_Allreduce( MPI_IN_PLACE, &ztilde[ 0 ], nsecular, mpi_real_t,
-                       MPI_PROD, U.mpiComm() ) );
+                       MPI_PROD, comm ) );
     // Compute final ztilde, with sign from original z (redundantly).
     for (int64_t i = 0; i < nsecular; ++i) {
         ztilde[ i ] = copysign( sqrt( -ztilde[ i ] ), z[ i ] );
@@ -147,7 +200,7 @@ void stedc_secular(
     slate_mpi_call(
         MPI_Allgatherv( MPI_IN_PLACE, mycnt, mpi_real_t,
                         &Lambda_local[ 0 ], &recv_cnts[ 0 ], &recv_offsets[ 0 ],
-                        mpi_real_t, U.mpiComm() ) );
+                        mpi_real_t, comm ) );
 
     if (info != 0)
         slate_error( "info " + std::to_string( info ) );
@@ -197,6 +250,44 @@ void stedc_secular(
     int64_t col_cnt = icol.size();
     int64_t row_cnt = irow.size();
 
+    if (use_device) {
+        // Solve the roots of the local columns again, and compute their
+        // u vectors from the Löwner formula, all on the device.
+        int64_t ncols = std::max( col_cnt, int64_t( 1 ) );
+        std::vector<real_t> Ulocal( nsecular*col_cnt );
+        int64_t* droots  = blas::device_malloc<int64_t>( ncols, *queue );
+        real_t*  dLambda = blas::device_malloc<real_t>( ncols, *queue );
+        real_t*  dDelta  = blas::device_malloc<real_t>( nsecular*ncols, *queue );
+        blas::device_memcpy<int64_t>( droots, icol.data(), col_cnt, *queue );
+        blas::device_memcpy<real_t>( dztilde, &ztilde[ 0 ], nsecular, *queue );
+
+        device::stedc_secular_roots( nsecular, col_cnt, droots, dD, dz, rho,
+                                     dLambda, dDelta, nsecular, *queue );
+        device::stedc_secular_vectors( nsecular, col_cnt, dztilde,
+                                       dDelta, nsecular, *queue );
+        blas::device_memcpy<real_t>( Ulocal.data(), dDelta, nsecular*col_cnt,
+                                     *queue );
+        queue->sync();
+
+        blas::device_free( droots,  *queue );
+        blas::device_free( dLambda, *queue );
+        blas::device_free( dDelta,  *queue );
+        blas::device_free( dD,      *queue );
+        blas::device_free( dz,      *queue );
+        blas::device_free( dztilde, *queue );
+
+        for (int64_t jj = 0; jj < col_cnt; ++jj) {
+            int64_t jq = itype[ icol[ jj ] ];
+            for (int64_t ii = 0; ii < row_cnt; ++ii) {
+                int64_t i  = irow[ ii ];
+                int64_t iq = itype[ i ];
+                auto Uij = U( iq / nb, jq / nb );
+                Uij.at( iq % nb, jq % nb ) = Ulocal[ i + jj*nsecular ];
+            }
+        }
+        return;
+    }
+
     // Compute u vectors.
     // Each rank in processor column computes redundantly in order to get norm.
     // todo: cache delta_jj terms and compute other deltas from D[i] - Lambda[j],
@@ -243,9 +334,52 @@ void stedc_secular(
     }
 }
 
+//------------------------------------------------------------------------------
+/// Finds the roots of the secular equation on all ranks of U.mpiComm().
+/// @ingroup heev_computational
+///
+template <typename real_t>
+void stedc_secular(
+    int64_t nsecular, int64_t n,
+    real_t rho,
+    real_t* D,
+    real_t* z,
+    real_t* Lambda,
+    Matrix<real_t>& U,
+    int64_t* itype,
+    Options const& opts )
+{
+    stedc_secular( nsecular, n, rho, D, z, Lambda, U, itype, U.mpiComm(),
+                   opts );
+}
+
 //------------------------------------------------------------------------------
 // Explicit instantiations.
 // Only real, not complex.
+template
+void stedc_secular<float>(
+    int64_t nsecular, int64_t n,
+    float rho,
+    float* D,
+    float* z,
+    float* Lambda,
+    Matrix<float>& U,
+    int64_t* itype,
+    MPI_Comm comm,
+    Options const& opts );
+
+template
+void stedc_secular<double>(
+    int64_t nsecular, int64_t n,
+    double rho,
+    double* D,
+    double* z,
+    double* Lambda,
+    Matrix<double>& U,
+    int64_t* itype,
+    MPI_Comm comm,
+    Options const& opts );
+
 template
 void stedc_secular<float>(
     int64_t nsecular, int64_t n,
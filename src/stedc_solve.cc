@@ -4,6 +4,10 @@
 // the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
 
 #include "slate/slate.hh"
+#include "slate/internal/comm.hh"
+
+#include <algorithm>
+#include <set>
 
 namespace slate {
 
@@ -114,6 +118,7 @@ void stedc_solve(
             ib = Q.tileNb( i );
             assert( ib == std::min( nb, n - ii ) );
             if (Q.tileIsLocal( i, i )) {
+                Q.tileGetForWriting( i, i, LayoutConvert::ColMajor );
                 #pragma omp task
                 {
                     auto Qii = Q( i, i );
@@ -196,6 +201,19 @@ void stedc_solve(
         subs.at( i ) += subs.at( i-1 );
     }
 
+    // Each merge involves only the ranks that own tiles of its diagonal
+    // block, so merges of blocks on disjoint sets of ranks run
+    // concurrently, without a global sync between levels.
+    // d_ranks[ i ] is the set of ranks where D of subproblem i is current;
+    // after the gather above, all ranks.
+    int mpi_size;
+    slate_mpi_call(
+        MPI_Comm_size( Q.mpiComm(), &mpi_size ) );
+    std::set<int> all_ranks;
+    Q.getRanks( &all_ranks );
+    std::vector< std::set<int> > d_ranks( end, all_ranks );
+    int level = 0;
+
     // Successively merge eigensystems of adjacent submatrices
     // into eigensystem for the corresponding larger matrix.
     // nblock  is # blocks in merged problem
@@ -235,8 +253,56 @@ void stedc_solve(
                 auto Usub = U.sub( j, j2, j, j2 );
                 assert( Qsub.n() == nmerge );
 
-                stedc_merge( nmerge, nmerge1, rho, &D[ jj ], Qsub, Wsub, Usub,
-                             opts );
+                std::set<int> merge_ranks;
+                Qsub.getRanks( &merge_ranks );
+                if (merge_ranks.count( mpi_rank ) > 0) {
+                    MPI_Comm comm = Q.mpiComm();
+                    if (int( merge_ranks.size() ) < mpi_size) {
+                        // Unique tag per merge for MPI_Comm_create_group.
+                        int comm_rank;
+                        int merge_tag = (level*Q.nt() + j) % 32768;
+                        comm = internal::commFromSet(
+                                   merge_ranks, Q.mpiComm(), Q.mpiGroup(),
+                                   mpi_rank, comm_rank, merge_tag );
+                    }
+
+                    // D of each half is current only on the ranks of the
+                    // merge that produced it, a subset of merge_ranks;
+                    // broadcast it from the first of those.
+                    int64_t half_offset[ 2 ] = { 0, nmerge1 };
+                    int64_t half_size[ 2 ]   = { nmerge1, nmerge - nmerge1 };
+                    for (int h = 0; h < 2; ++h) {
+                        auto const& half_ranks = d_ranks.at( i + h );
+                        bool current = std::includes(
+                            half_ranks.begin(), half_ranks.end(),
+                            merge_ranks.begin(), merge_ranks.end() );
+                        if (! current) {
+                            MPI_Group comm_group;
+                            slate_mpi_call(
+                                MPI_Comm_group( comm, &comm_group ) );
+                            int half_root = *half_ranks.begin();
+                            int comm_root;
+                            slate_mpi_call(
+                                MPI_Group_translate_ranks(
+                                    Q.mpiGroup(), 1, &half_root,
+                                    comm_group, &comm_root ) );
+                            slate_mpi_call(
+                                MPI_Group_free( &comm_group ) );
+                            slate_mpi_call(
+                                MPI_Bcast( &D[ jj + half_offset[ h ] ],
+                                           half_size[ h ],
+                                           mpi_type<real_t>::value,
+                                           comm_root, comm ) );
+                        }
+                    }
+
+                    stedc_merge( nmerge, nmerge1, rho, &D[ jj ], Qsub, Wsub,
+                                 Usub, opts );
+                }
+                d_ranks.at( i/2 ) = merge_ranks;
+            }
+            else {
+                d_ranks.at( i/2 ) = d_ranks.at( i + 1 );
             }
 
             // Shift: subs[ 0, 1, 2, .., (end-2)/2 ] = subs[ 1, 3, 5, .., end-1 ]
@@ -244,6 +310,8 @@ void stedc_solve(
         }
         end /= 2;
         subs.resize( end );
+        d_ranks.resize( end );
+        ++level;
     }
 }
 
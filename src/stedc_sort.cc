@@ -7,6 +7,8 @@
 #include "internal/internal_copy_col.hh"
 
 #include <numeric>
+#include <utility>
+#include <vector>
 
 namespace slate {
 
@@ -52,11 +54,16 @@ void stedc_sort(
     slate_assert( grid_order == GridOrder::Col );
     int64_t mlocal = num_local_rows_cols( m, mb, myrow, 0, nprow );
 
+    // With Target::Devices, Q and Qout stay on the devices and columns
+    // are gathered and scattered there; messages go through the host.
+    Target target = get_target( opts, Target::HostTask );
+    bool on_devices = target == Target::Devices && Q.num_devices() > 0;
+
     // Quick return.
     if (mlocal == 0)
         return;
 
-    std::vector<real_t> work( std::max( n, mlocal * nb ) );
+    std::vector<real_t> work( n );
 
     // Determine permutation isort to sort eigenvalues in D.
     std::vector<int64_t> isort( n ), isort_inv( n );
@@ -73,98 +80,92 @@ void stedc_sort(
         isort_inv[ isort[ j ] ] = j;
     }
 
-    std::vector<int>     pcols( nb );
-    std::vector<int64_t> imine( nb ),
-                         pcnt( npcol ),
-                         poffset( npcol );
-
     // Apply permutation Qout = P Q.
-    // j,  k  is tile index in Q, Qout respectively.
-    // jj, kk is offset within tile
-    // jg, kg is global index. jg is index of first column in tile j.
-    // jb     is tile size
-    // pj, pk is process column for j, k resp.
-    int pj, pk;
-    int64_t jb, k, kk, kg, cnt;
-    int64_t jg = 0;
-    int64_t nt = Q.nt();
-    for (int64_t j = 0; j < nt; ++j) {
-        jb = Q.tileNb( j );
-        pj = (jg / nb) % npcol;  // indxg2p
-
-        // Get destination process col for each column, and
-        // count columns in each destination process col.
-        std::fill( &pcnt[ 0 ], &pcnt[ npcol ], 0 );
-        imine.clear();
-        for (int64_t jj = 0; jj < jb; ++jj) {
-            kg = isort_inv[ jg + jj ];
-            pk = (kg / nb) % npcol;  // indxg2p
-            pcols[ jj ] = pk;
-            pcnt[ pk ] += 1;
-            if (pk == mycol) {
-                imine.push_back( kg );
-            }
+    // Column jg of Q, in process col pj, moves to column kg of Qout,
+    // in process col pk. The local rows of all columns that one process
+    // col sends to another are packed into one message, and all messages
+    // are in flight at once, instead of one blocking exchange per tile.
+    // send_cols[ p ] are the jg that I send to process col p;
+    // recv_cols[ p ] are the kg that I receive from process col p;
+    // both in ascending order of jg, which is also the packing order.
+    std::vector< std::vector<int64_t> > send_cols( npcol ), recv_cols( npcol );
+    std::vector< std::pair<int64_t, int64_t> > local_cols;
+    int64_t send_cnt = 0, recv_cnt = 0;
+    for (int64_t jg = 0; jg < n; ++jg) {
+        int64_t kg = isort_inv[ jg ];
+        int pj = (jg / nb) % npcol;  // indxg2p
+        int pk = (kg / nb) % npcol;  // indxg2p
+        if (pj == mycol && pk == mycol) {
+            local_cols.push_back( { jg, kg } );
+        }
+        else if (pj == mycol) {
+            send_cols[ pk ].push_back( jg );
+            ++send_cnt;
         }
+        else if (pk == mycol) {
+            recv_cols[ pj ].push_back( kg );
+            ++recv_cnt;
+        }
+    }
 
-        if (pj == mycol) {
-            // Running sum of column counts.
-            poffset[ 0 ] = 0;
-            std::partial_sum( &pcnt[ 0 ], &pcnt[ npcol-1 ], &poffset[ 1 ] );
-            assert( int64_t( imine.size() ) == pcnt[ mycol ] );
-
-            // Copy columns to workspace, grouped by destination process col (pk).
-            // Copy my columns with permutation directly to destination Qout.
-            for (int64_t jj = 0; jj < jb; ++jj) {
-                pk = pcols[ jj ];
-                if (pk == mycol) {
-                    kg = isort_inv[ jg + jj ];
-                    k  = kg / nb;
-                    kk = kg % nb;
-                    internal::copy_col( Q, j, jj, Qout, k, kk );
-                }
-                else {
-                    kk = poffset[ pk ]++;
-                    internal::copy_col( Q, j, jj, &work[ kk*mlocal ] );
-                }
-            }
-
-            // Reset running sum of column counts (same as above).
-            poffset[ 0 ] = 0;
-            std::partial_sum( &pcnt[ 0 ], &pcnt[ npcol-1 ], &poffset[ 1 ] );
-
-            // Send each process's part of workspace to that process.
-            // todo: MPI_Isend
-            for (int p = 0; p < npcol; ++p) {
-                cnt = pcnt[ p ];
-                if (p != mycol && cnt > 0 && myrow < Q.mt()) {
-                    int dst = Q.tileRank( myrow, p );
-                    kk = poffset[ p ];
-                    slate_mpi_call(
-                        MPI_Send( &work[ kk*mlocal ], mlocal * cnt,
-                                  mpi_type<real_t>::value,
-                                  dst, tag_0, Q.mpiComm() ) );
-                }
-            }
+    std::vector<real_t> send_buf( mlocal * send_cnt ),
+                        recv_buf( mlocal * recv_cnt );
+    std::vector<MPI_Request> recv_requests, send_requests;
+    std::vector<int> recv_from;
+    recv_requests.reserve( npcol );
+    send_requests.reserve( npcol );
+
+    // Post all receives.
+    int64_t offset = 0;
+    std::vector<int64_t> recv_offset( npcol );
+    for (int p = 0; p < npcol; ++p) {
+        int64_t cnt = recv_cols[ p ].size();
+        recv_offset[ p ] = offset;
+        if (cnt > 0) {
+            int src = Q.tileRank( myrow, p );
+            recv_requests.push_back( MPI_REQUEST_NULL );
+            recv_from.push_back( p );
+            slate_mpi_call(
+                MPI_Irecv( &recv_buf[ offset ], mlocal * cnt,
+                           mpi_type<real_t>::value,
+                           src, tag_0, Q.mpiComm(), &recv_requests.back() ) );
+            offset += mlocal * cnt;
         }
-        else if (imine.size() > 0 && myrow < Q.mt()) {
-            // Recv workspace, then copy with permutation to destination Qout.
-            cnt = imine.size();
-            assert( cnt == pcnt[ mycol ] );
-            int src = Q.tileRank( myrow, pj );
+    }
+
+    // Pack and send columns, one message per destination process col.
+    offset = 0;
+    for (int p = 0; p < npcol; ++p) {
+        int64_t cnt = send_cols[ p ].size();
+        if (cnt > 0) {
+            internal::copy_cols( Q, send_cols[ p ], mlocal,
+                                 &send_buf[ offset ], on_devices );
+            int dst = Q.tileRank( myrow, p );
+            send_requests.push_back( MPI_REQUEST_NULL );
             slate_mpi_call(
-                MPI_Recv( &work[ 0 ], mlocal * cnt,
-                          mpi_type<real_t>::value,
-                          src, tag_0, Q.mpiComm(), MPI_STATUS_IGNORE ) );
-            for (int64_t jj = 0; jj < cnt; ++jj) {
-                kg = imine[ jj ];
-                k  = kg / nb;
-                kk = kg % nb;
-                internal::copy_col( &work[ jj*mlocal ], Qout, k, kk );
-            }
+                MPI_Isend( &send_buf[ offset ], mlocal * cnt,
+                           mpi_type<real_t>::value,
+                           dst, tag_0, Q.mpiComm(), &send_requests.back() ) );
+            offset += mlocal * cnt;
         }
+    }
 
-        jg += jb;
+    // Copy my columns with permutation directly to destination Qout,
+    // while messages are in flight.
+    internal::copy_cols( Q, Qout, local_cols, on_devices );
+
+    // Copy received columns with permutation to Qout, as they arrive.
+    for (size_t r = 0; r < recv_requests.size(); ++r) {
+        int index;
+        slate_mpi_call(
+            MPI_Waitany( recv_requests.size(), recv_requests.data(),
+                         &index, MPI_STATUS_IGNORE ) );
+        int p = recv_from[ index ];
+        internal::copy_cols( &recv_buf[ recv_offset[ p ] ], mlocal,
+                             Qout, recv_cols[ p ], on_devices );
     }
+
+    internal::waitall( send_requests );
 }
 
 //------------------------------------------------------------------------------
@@ -5,6 +5,8 @@
 
 #include "slate/slate.hh"
 
+#include <numeric>
+
 namespace slate {
 
 //------------------------------------------------------------------------------
@@ -29,7 +31,11 @@ namespace slate {
 ///     the last row of Q1 and the first row of Q2:
 ///         z = Q^T [ e_{n_1} ] = [ Q1^T e_{n_1} ].
 ///                 [ e_1     ]   [ Q2^T e_1     ]
-///     z is duplicated on all MPI ranks.
+///     z is duplicated on all MPI ranks of comm.
+///
+/// @param[in] comm
+///     Communicator of the ranks taking part: Q.mpiComm(), or a
+///     subcommunicator of it including all ranks that own tiles of Q.
 ///
 /// @param[in] opts
 ///     Additional options, as map of name = value pairs. Possible options:
@@ -41,62 +47,123 @@ template <typename real_t>
 void stedc_z_vector(
     Matrix<real_t>& Q,
     std::vector<real_t>& z,
+    MPI_Comm comm,
     Options const& opts )
 {
-    int mpi_rank = Q.mpiRank();
+    const MPI_Datatype mpi_real_t = mpi_type<real_t>::value;
+
+    int mpi_rank, mpi_size, q_size;
+    slate_mpi_call(
+        MPI_Comm_rank( comm, &mpi_rank ) );
+    slate_mpi_call(
+        MPI_Comm_size( comm, &mpi_size ) );
+    slate_mpi_call(
+        MPI_Comm_size( Q.mpiComm(), &q_size ) );
 
-    const int tag = 0;
-    const int root = 0;
+    // Translate the tile ranks in Q's communicator to ranks in comm.
+    std::vector<int> q_ranks( q_size ), comm_ranks( q_size );
+    std::iota( q_ranks.begin(), q_ranks.end(), 0 );
+    if (comm == Q.mpiComm()) {
+        comm_ranks = q_ranks;
+    }
+    else {
+        MPI_Group comm_group;
+        slate_mpi_call(
+            MPI_Comm_group( comm, &comm_group ) );
+        slate_mpi_call(
+            MPI_Group_translate_ranks( Q.mpiGroup(), q_size, q_ranks.data(),
+                                       comm_group, comm_ranks.data() ) );
+        slate_mpi_call(
+            MPI_Group_free( &comm_group ) );
+    }
+    auto tile_rank = [&]( int64_t i, int64_t j ) {
+        return comm_ranks[ Q.tileRank( i, j ) ];
+    };
 
     assert( Q.mt() == Q.nt() );
     int64_t nt = Q.nt();
     int64_t nt1 = nt/2;
     //int64_t nt2 = ceildiv( nt, 2 );
 
-    // Gather z1 = last row of Q1.
-    // todo: We could pack all the data on each rank into one workspace to
-    // have only one send, followed by unpack, as in ScaLAPACK.
-    int64_t jj = 0;  // position in z vector == # elements received so far.
+    // z1 = last row of Q1 is in block row nt1-1;
+    // z2 = first row of Q2 is in block row nt1.
+    auto z_row = [nt1]( int64_t j ) {
+        return j < nt1 ? nt1 - 1 : nt1;
+    };
 
-    // Start gathering z1 = last row of Q1, from block row nt1-1.
-    int64_t i  = nt1 - 1;
-    int64_t ii = Q.tileMb( i ) - 1;  // Last row of block.
+    // Count z entries on each rank.
+    // Like ScaLAPACK, each rank packs all its entries into one contiguous
+    // piece, then one allgatherv replaces per-tile messages to a root
+    // followed by a broadcast.
+    std::vector<int> counts( mpi_size, 0 ), displs( mpi_size, 0 );
+    int64_t n = 0;
     for (int64_t j = 0; j < nt; ++j) {
-        if (j == nt1) {
-            // Switch to gathering z2 = 1st row of Q2, from block row nt1.
-            i  = nt1;
-            ii = 0;  // First row.
-        }
-        int64_t nb = Q.tileNb( j );
+        counts[ tile_rank( z_row( j ), j ) ] += Q.tileNb( j );
+        n += Q.tileNb( j );
+    }
+    std::partial_sum( counts.begin(), counts.end() - 1, displs.begin() + 1 );
+
+    // Pack my entries into my piece of the workspace.
+    std::vector<real_t> work( n );
+    int64_t kk = displs[ mpi_rank ];
+    for (int64_t j = 0; j < nt; ++j) {
+        int64_t i = z_row( j );
         if (Q.tileIsLocal( i, j )) {
+            int64_t ii = (j < nt1 ? Q.tileMb( i ) - 1 : 0);
+            int64_t nb = Q.tileNb( j );
             Q.tileGetForReading( i, j, LayoutConvert::None );
             auto Qij = Q( i, j );
-            // Pack it into contiguous space. On root, this is its final place.
-            blas::copy( nb, &Qij.at( ii, 0 ), Qij.stride(), &z[ jj ], 1 );
-            if (mpi_rank != root) {
-                // todo: isend?
-                slate_mpi_call(
-                    MPI_Send( &z[ jj ], nb, mpi_type<real_t>::value,
-                              root, tag, Q.mpiComm() ) );
-            }
-        }
-        else if (mpi_rank == root) {
-            // todo: irecv?
-            slate_mpi_call(
-                MPI_Recv( &z[ jj ], nb, mpi_type<real_t>::value,
-                          Q.tileRank( i, j ), tag, Q.mpiComm(),
-                          MPI_STATUS_IGNORE ) );
+            blas::copy( nb, &Qij.at( ii, 0 ), Qij.stride(), &work[ kk ], 1 );
+            kk += nb;
         }
+    }
+
+    slate_mpi_call(
+        MPI_Allgatherv( MPI_IN_PLACE, 0, mpi_real_t,
+                        &work[ 0 ], &counts[ 0 ], &displs[ 0 ], mpi_real_t,
+                        comm ) );
+
+    // Unpack into z, in order of block columns.
+    int64_t jj = 0;  // position in z vector.
+    for (int64_t j = 0; j < nt; ++j) {
+        int rank = tile_rank( z_row( j ), j );
+        int64_t nb = Q.tileNb( j );
+        blas::copy( nb, &work[ displs[ rank ] ], 1, &z[ jj ], 1 );
+        displs[ rank ] += nb;
         jj += nb;
     }
+}
 
-    // Broadcast complete z to all ranks.
-    MPI_Bcast( &z[ 0 ], jj, mpi_type<real_t>::value, root, Q.mpiComm() );
+//------------------------------------------------------------------------------
+/// Communicates the z vector to all ranks of Q.mpiComm().
+/// @ingroup heev_computational
+///
+template <typename real_t>
+void stedc_z_vector(
+    Matrix<real_t>& Q,
+    std::vector<real_t>& z,
+    Options const& opts )
+{
+    stedc_z_vector( Q, z, Q.mpiComm(), opts );
 }
 
 //------------------------------------------------------------------------------
 // Explicit instantiations.
 // Only real, not complex.
+template
+void stedc_z_vector<float>(
+    Matrix<float>& Q,
+    std::vector<float>& z,
+    MPI_Comm comm,
+    Options const& opts );
+
+template
+void stedc_z_vector<double>(
+    Matrix<double>& Q,
+    std::vector<double>& z,
+    MPI_Comm comm,
+    Options const& opts );
+
 template
 void stedc_z_vector<float>(
     Matrix<float>& Q,
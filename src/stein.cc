@@ -0,0 +1,338 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/slate.hh"
+#include "internal/internal.hh"
+
+#include <cmath>
+#include <limits>
+
+namespace slate {
+
+namespace impl {
+
+//------------------------------------------------------------------------------
+/// @internal
+/// Computes eigenvectors begin, ..., end-1 of the symmetric tridiagonal
+/// matrix T = tridiag( E, D, E ) by inverse iteration, as in LAPACK stein,
+/// for the sorted eigenvalues Lambda[ begin : end-1 ], which must all be in
+/// one cluster, so each vector is orthogonalized against the previous ones.
+/// The vectors are stored in the columns of X, which is n-by-(end - begin).
+///
+/// The start vector for eigenvalue j is seeded by j, so any rank computing
+/// vector j gets bitwise the same result.
+///
+template <typename real_t>
+void stein_cluster(
+    int64_t n, real_t const* D, real_t const* E,
+    real_t const* Lambda, int64_t begin, int64_t end,
+    real_t onenrm, real_t* X, int64_t ldx )
+{
+    const real_t eps = std::numeric_limits<real_t>::epsilon();
+    const int max_iters = 5;
+    const int extra = 2;
+
+    if (n == 1) {
+        for (int64_t j = 0; j < end - begin; ++j)
+            X[ j*ldx ] = 1;
+        return;
+    }
+
+    // Criterion for sufficient growth, as in stein.
+    const real_t dtpcrt = std::sqrt( real_t( 0.1 ) / n );
+    // Tiny pivots of U are replaced by +-tol.
+    const real_t tol = eps * onenrm;
+
+    // LU factors of T - x I with partial pivoting, as in gttrf.
+    std::vector<real_t> dl( n-1 ), d( n ), du( n-1 ), du2( n );
+    std::vector<char> swap( n );
+
+    real_t xjm = 0;
+    for (int64_t j = begin; j < end; ++j) {
+        real_t* x = &X[ (j - begin)*ldx ];
+
+        // Separate close eigenvalues slightly, as in stein.
+        real_t xj = Lambda[ j ];
+        if (j > begin) {
+            real_t pertol = 10 * std::abs( eps * xj );
+            if (xj - xjm < pertol)
+                xj = xjm + pertol;
+        }
+        xjm = xj;
+
+        // Start vector, uniform in (-1, 1), from a 64-bit LCG seeded by j.
+        uint64_t seed = 0x9E3779B97F4A7C15ull * uint64_t( j + 1 );
+        for (int64_t i = 0; i < n; ++i) {
+            seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+            x[ i ] = real_t( int64_t( seed >> 11 ) ) / real_t( 1ull << 52 ) - 1;
+        }
+
+        // Factor T - xj I = P L U.
+        for (int64_t i = 0; i < n; ++i)
+            d[ i ] = D[ i ] - xj;
+        for (int64_t i = 0; i < n-1; ++i) {
+            dl[ i ] = E[ i ];
+            du[ i ] = E[ i ];
+            du2[ i ] = 0;
+        }
+        for (int64_t i = 0; i < n-1; ++i) {
+            if (std::abs( d[ i ] ) >= std::abs( dl[ i ] )) {
+                swap[ i ] = false;
+                if (d[ i ] != 0) {
+                    real_t fact = dl[ i ] / d[ i ];
+                    dl[ i ] = fact;
+                    d[ i+1 ] -= fact * du[ i ];
+                }
+            }
+            else {
+                swap[ i ] = true;
+                real_t fact = d[ i ] / dl[ i ];
+                d[ i ] = dl[ i ];
+                dl[ i ] = fact;
+                real_t tmp = du[ i ];
+                du[ i ] = d[ i+1 ];
+                d[ i+1 ] = tmp - fact * d[ i+1 ];
+                if (i < n-2) {
+                    du2[ i ] = du[ i+1 ];
+                    du[ i+1 ] = -fact * du[ i+1 ];
+                }
+            }
+        }
+        for (int64_t i = 0; i < n; ++i) {
+            if (std::abs( d[ i ] ) < tol)
+                d[ i ] = d[ i ] < 0 ? -tol : tol;
+        }
+
+        int nrmchk = 0;
+        for (int iter = 0; iter < max_iters; ++iter) {
+            // Scale x so the solve doesn't overflow.
+            real_t asum = 0;
+            for (int64_t i = 0; i < n; ++i)
+                asum += std::abs( x[ i ] );
+            real_t scl = n * onenrm * std::max( eps, std::abs( d[ n-1 ] ) ) / asum;
+            for (int64_t i = 0; i < n; ++i)
+                x[ i ] *= scl;
+
+            // Solve (T - xj I) x = b: forward with L, then back with U.
+            for (int64_t i = 0; i < n-1; ++i) {
+                if (swap[ i ])
+                    std::swap( x[ i ], x[ i+1 ] );
+                x[ i+1 ] -= dl[ i ] * x[ i ];
+            }
+            x[ n-1 ] /= d[ n-1 ];
+            x[ n-2 ] = (x[ n-2 ] - du[ n-2 ] * x[ n-1 ]) / d[ n-2 ];
+            for (int64_t i = n-3; i >= 0; --i) {
+                x[ i ] = (x[ i ] - du[ i ] * x[ i+1 ] - du2[ i ] * x[ i+2 ])
+                       / d[ i ];
+            }
+
+            // Orthogonalize against the previous vectors in the cluster.
+            for (int64_t k = begin; k < j; ++k) {
+                real_t const* xk = &X[ (k - begin)*ldx ];
+                real_t dot = 0;
+                for (int64_t i = 0; i < n; ++i)
+                    dot += xk[ i ] * x[ i ];
+                for (int64_t i = 0; i < n; ++i)
+                    x[ i ] -= dot * xk[ i ];
+            }
+
+            // Stop after extra iterations once the growth is sufficient.
+            real_t nrm = 0;
+            for (int64_t i = 0; i < n; ++i)
+                nrm = std::max( nrm, std::abs( x[ i ] ) );
+            if (nrm >= dtpcrt) {
+                ++nrmchk;
+                if (nrmchk > extra)
+                    break;
+            }
+        }
+
+        // Normalize, with the largest entry positive.
+        real_t sumsq = 0, amax = 0;
+        int64_t imax = 0;
+        for (int64_t i = 0; i < n; ++i) {
+            sumsq += x[ i ] * x[ i ];
+            if (std::abs( x[ i ] ) > amax) {
+                amax = std::abs( x[ i ] );
+                imax = i;
+            }
+        }
+        real_t scl = 1 / std::sqrt( sumsq );
+        if (x[ imax ] < 0)
+            scl = -scl;
+        for (int64_t i = 0; i < n; ++i)
+            x[ i ] *= scl;
+    }
+}
+
+} // namespace impl
+
+//------------------------------------------------------------------------------
+/// Computes the eigenvectors of a symmetric tridiagonal matrix
+/// corresponding to given eigenvalues, by inverse iteration,
+/// as in LAPACK stein.
+///
+/// Eigenvalues closer than 1e-3 ||T||_1 form a cluster, whose vectors are
+/// orthogonalized against each other. Each rank computes only the
+/// columns of its local tiles of Z, cluster by cluster in parallel by the
+/// OpenMP threads. A cluster crossing a tile boundary is computed
+/// by each rank that needs one of its columns. Z is most efficiently
+/// distributed by block columns over a 1-by-p grid, so each column is
+/// computed by only one rank.
+///
+//------------------------------------------------------------------------------
+/// @tparam scalar_t
+///     One of float, double, std::complex<float>, std::complex<double>.
+//------------------------------------------------------------------------------
+/// @param[in] D
+///     The n diagonal entries of the tridiagonal matrix.
+///
+/// @param[in] E
+///     The n-1 off-diagonal entries of the tridiagonal matrix.
+///
+/// @param[in] Lambda
+///     The m eigenvalues in ascending order, e.g., as output by stebz.
+///
+/// @param[out] Z
+///     The n-by-m matrix Z. On exit, column j has the real, orthonormal
+///     eigenvector for Lambda[ j ].
+///
+/// @param[in] opts
+///     Currently unused.
+///
+/// @ingroup heev_computational
+///
+template <typename scalar_t>
+void stein(
+    std::vector< blas::real_type<scalar_t> > const& D,
+    std::vector< blas::real_type<scalar_t> > const& E,
+    std::vector< blas::real_type<scalar_t> > const& Lambda,
+    Matrix<scalar_t>& Z,
+    Options const& opts )
+{
+    trace::Block trace_block("slate::stein");
+
+    using real_t = blas::real_type<scalar_t>;
+
+    int64_t n = D.size();
+    int64_t m = Lambda.size();
+    slate_assert( Z.m() == n );
+    slate_assert( Z.n() == m );
+    if (n == 0 || m == 0)
+        return;
+
+    real_t onenrm = 0;
+    for (int64_t i = 0; i < n; ++i) {
+        real_t s = std::abs( D[ i ] )
+                 + (i > 0   ? std::abs( E[ i-1 ] ) : 0)
+                 + (i < n-1 ? std::abs( E[ i   ] ) : 0);
+        onenrm = std::max( onenrm, s );
+    }
+    const real_t ortol = real_t( 1e-3 ) * onenrm;
+
+    // Columns needed locally: those of block columns with a local tile.
+    std::vector<char> need( m, false );
+    std::vector<int64_t> col_begin( Z.nt() + 1, 0 );
+    for (int64_t j = 0; j < Z.nt(); ++j) {
+        col_begin[ j+1 ] = col_begin[ j ] + Z.tileNb( j );
+        for (int64_t i = 0; i < Z.mt(); ++i) {
+            if (Z.tileIsLocal( i, j )) {
+                std::fill( need.begin() + col_begin[ j ],
+                           need.begin() + col_begin[ j+1 ], true );
+                break;
+            }
+        }
+    }
+
+    // Clusters [ cluster[ c ], cluster[ c+1 ] ), with the last needed column
+    // of each; clusters without a needed column are skipped.
+    std::vector<int64_t> cluster = { 0 };
+    for (int64_t j = 1; j < m; ++j) {
+        if (Lambda[ j ] - Lambda[ j-1 ] > ortol)
+            cluster.push_back( j );
+    }
+    cluster.push_back( m );
+    int64_t nclusters = cluster.size() - 1;
+
+    // Vectors of each cluster, up to its last needed column.
+    std::vector< std::vector<real_t> > X( nclusters );
+    std::vector<int64_t> cluster_end( nclusters, 0 );
+    for (int64_t c = 0; c < nclusters; ++c) {
+        for (int64_t j = cluster[ c ]; j < cluster[ c+1 ]; ++j) {
+            if (need[ j ])
+                cluster_end[ c ] = j + 1;
+        }
+    }
+
+    #pragma omp parallel for schedule( dynamic, 1 )
+    for (int64_t c = 0; c < nclusters; ++c) {
+        if (cluster_end[ c ] > cluster[ c ]) {
+            X[ c ].resize( n * (cluster_end[ c ] - cluster[ c ]) );
+            impl::stein_cluster( n, &D[ 0 ], &E[ 0 ], &Lambda[ 0 ],
+                                 cluster[ c ], cluster_end[ c ],
+                                 onenrm, X[ c ].data(), n );
+        }
+    }
+
+    // Copy to the local tiles of Z.
+    std::vector<int64_t> cluster_of( m );
+    for (int64_t c = 0; c < nclusters; ++c) {
+        std::fill( cluster_of.begin() + cluster[ c ],
+                   cluster_of.begin() + cluster[ c+1 ], c );
+    }
+    int64_t ii = 0;
+    for (int64_t i = 0; i < Z.mt(); ++i) {
+        for (int64_t j = 0; j < Z.nt(); ++j) {
+            if (Z.tileIsLocal( i, j )) {
+                Z.tileGetForWriting( i, j, LayoutConvert::ColMajor );
+                auto Zij = Z( i, j );
+                for (int64_t jj = 0; jj < Zij.nb(); ++jj) {
+                    int64_t col = col_begin[ j ] + jj;
+                    int64_t c = cluster_of[ col ];
+                    real_t const* x = &X[ c ][ (col - cluster[ c ]) * n ];
+                    for (int64_t i2 = 0; i2 < Zij.mb(); ++i2)
+                        Zij.at( i2, jj ) = x[ ii + i2 ];
+                }
+            }
+        }
+        ii += Z.tileMb( i );
+    }
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void stein<float>(
+    std::vector<float> const& D,
+    std::vector<float> const& E,
+    std::vector<float> const& Lambda,
+    Matrix<float>& Z,
+    Options const& opts);
+
+template
+void stein<double>(
+    std::vector<double> const& D,
+    std::vector<double> const& E,
+    std::vector<double> const& Lambda,
+    Matrix<double>& Z,
+    Options const& opts);
+
+template
+void stein< std::complex<float> >(
+    std::vector<float> const& D,
+    std::vector<float> const& E,
+    std::vector<float> const& Lambda,
+    Matrix< std::complex<float> >& Z,
+    Options const& opts);
+
+template
+void stein< std::complex<double> >(
+    std::vector<double> const& D,
+    std::vector<double> const& E,
+    std::vector<double> const& Lambda,
+    Matrix< std::complex<double> >& Z,
+    Options const& opts);
+
+} // namespace slate
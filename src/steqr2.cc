@@ -12,11 +12,72 @@
 
 namespace slate {
 
+namespace impl {
+
+//------------------------------------------------------------------------------
+/// @internal
+/// Applies a sequence of plane rotations from the right to the m-by-n
+/// matrix Z, as in LAPACK lasr with side = Right and pivot = Variable:
+/// rotation j, with cosine c[ j ] and sine s[ j ], acts on columns j and j+1,
+/// for j = 0, ..., n-2 if direct = 'F', or j = n-2, ..., 0 if direct = 'B'.
+///
+/// Rows of Z are independent, so Z is split into blocks of rows that are
+/// rotated in parallel by the OpenMP threads, each thread applying the
+/// whole chain of rotations to its block while the block is in cache.
+/// This is the O(n^2) per-sweep hot spot of steqr2.
+///
+template <typename scalar_t>
+void steqr2_lasr(
+    char direct, int64_t m, int64_t n,
+    blas::real_type<scalar_t> const* c,
+    blas::real_type<scalar_t> const* s,
+    scalar_t* Z, int64_t ldz )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    if (m <= 0 || n <= 1)
+        return;
+
+    // Rows per block; small enough to balance the load and keep two
+    // columns of a block in L1 cache, large enough to amortize
+    // the chain of rotations.
+    const int64_t mb = 256;
+    int64_t mt = ceildiv( m, mb );
+    bool forward = (direct == 'F' || direct == 'f');
+
+    #pragma omp parallel for schedule( static ) if (mt > 1)
+    for (int64_t k = 0; k < mt; ++k) {
+        int64_t i0 = k*mb;
+        int64_t ib = std::min( mb, m - i0 );
+        scalar_t* Zk = &Z[ i0 ];
+        for (int64_t jj = 0; jj < n-1; ++jj) {
+            int64_t j = forward ? jj : n-2 - jj;
+            real_t cj = c[ j ];
+            real_t sj = s[ j ];
+            if (cj == real_t( 1 ) && sj == real_t( 0 ))
+                continue;
+            scalar_t* z0 = &Zk[ j*ldz ];
+            scalar_t* z1 = &Zk[ (j+1)*ldz ];
+            for (int64_t i = 0; i < ib; ++i) {
+                scalar_t tmp = z1[ i ];
+                z1[ i ] = cj*tmp - sj*z0[ i ];
+                z0[ i ] = sj*tmp + cj*z0[ i ];
+            }
+        }
+    }
+}
+
+} // namespace impl
+
+//------------------------------------------------------------------------------
+/// Computes all eigenvalues/eigenvectorsnamespace slate {
+
 //------------------------------------------------------------------------------
 /// Computes all eigenvalues/eigenvectors of a symmetric tridiagonal matrix
 /// using the Pal-Walker-Kahan variant of the QL or QR algorithm.
 ///
-/// ATTENTION: only host computation supported for now
+/// Each rank applies the rotations to its local rows of Z, on host,
+/// with the rows of Z split over the OpenMP threads.
 ///
 /// @ingroup heev_computational
 ///
@@ -113,3 +174,37 @@ void steqr2< std::complex<double> >(
     Options const& opts);
 
 } // namespace slate
+
+//------------------------------------------------------------------------------
+// Fortran-callable rotation kernels used by slate_xsteqr2.
+extern "C" void slate_slasr(
+    const char* direct, const blas_int* m, const blas_int* n,
+    const float* c, const float* s,
+    float* z, const blas_int* ldz)
+{
+    slate::impl::steqr2_lasr( *direct, *m, *n, c, s, z, *ldz );
+}
+
+extern "C" void slate_dlasr(
+    const char* direct, const blas_int* m, const blas_int* n,
+    const double* c, const double* s,
+    double* z, const blas_int* ldz)
+{
+    slate::impl::steqr2_lasr( *direct, *m, *n, c, s, z, *ldz );
+}
+
+extern "C" void slate_clasr(
+    const char* direct, const blas_int* m, const blas_int* n,
+    const float* c, const float* s,
+    std::complex<float>* z, const blas_int* ldz)
+{
+    slate::impl::steqr2_lasr( *direct, *m, *n, c, s, z, *ldz );
+}
+
+extern "C" void slate_zlasr(
+    const char* direct, const blas_int* m, const blas_int* n,
+    const double* c, const double* s,
+    std::complex<double>* z, const blas_int* ldz)
+{
+    slate::impl::steqr2_lasr( *direct, *m, *n, c, s, z, *ldz );
+}
@@ -22,6 +22,13 @@ int MPI_Type_contiguous(int count, MPI_Datatype oldtype, MPI_Datatype* newtype)
     assert(0);
 }
 
+int MPI_Allgather(const void* sendbuf, int sendcount, MPI_Datatype sendtype,
+                  void* recvbuf, int recvcount, MPI_Datatype recvtype,
+                  MPI_Comm comm)
+{
+    assert(0);
+}
+
 int MPI_Allreduce(const void* sendbuf, void* recvbuf, int count,
                   MPI_Datatype datatype, MPI_Op op, MPI_Comm comm)
 {
@@ -64,11 +71,46 @@ int MPI_Comm_create_group(MPI_Comm comm, MPI_Group group, int tag,
     return MPI_SUCCESS;
 }
 
+int MPI_Comm_create_keyval(MPI_Comm_copy_attr_function* copy_fn,
+                           MPI_Comm_delete_attr_function* delete_fn,
+                           int* keyval, void* extra)
+{
+    return MPI_SUCCESS;
+}
+
+int MPI_Comm_delete_attr(MPI_Comm comm, int keyval)
+{
+    return MPI_SUCCESS;
+}
+
+int MPI_Comm_compare(MPI_Comm comm1, MPI_Comm comm2, int* result)
+{
+    *result = (comm1 == comm2 ? MPI_IDENT : MPI_CONGRUENT);
+    return MPI_SUCCESS;
+}
+
+int MPI_Comm_dup(MPI_Comm comm, MPI_Comm* newcomm)
+{
+    *newcomm = comm;
+    return MPI_SUCCESS;
+}
+
 int MPI_Comm_free(MPI_Comm* comm)
 {
     return MPI_SUCCESS;
 }
 
+int MPI_Comm_free_keyval(int* keyval)
+{
+    return MPI_SUCCESS;
+}
+
+int MPI_Comm_get_attr(MPI_Comm comm, int keyval, void* attr, int* flag)
+{
+    *flag = 0;
+    return MPI_SUCCESS;
+}
+
 int MPI_Comm_group(MPI_Comm comm, MPI_Group* group)
 {
     return MPI_SUCCESS;
@@ -80,6 +122,17 @@ int MPI_Comm_rank(MPI_Comm comm, int* rank)
     return MPI_SUCCESS;
 }
 
+int MPI_Comm_set_attr(MPI_Comm comm, int keyval, void* attr)
+{
+    return MPI_SUCCESS;
+}
+
+int MPI_Comm_split_type(MPI_Comm comm, int split_type, int key,
+                        MPI_Info info, MPI_Comm* newcomm)
+{
+    assert(0);
+}
+
 int MPI_Comm_size(MPI_Comm comm, int* size)
 {
     *size = 1;
@@ -92,6 +145,53 @@ MPI_Fint MPI_Comm_f2c(MPI_Comm comm)
     return 0;
 }
 
+int MPI_File_close(MPI_File* fh)
+{
+    assert(0);
+}
+
+int MPI_File_open(MPI_Comm comm, const char* filename, int amode,
+                  MPI_Info info, MPI_File* fh)
+{
+    assert(0);
+}
+
+int MPI_File_read_all(MPI_File fh, void* buf, int count,
+                      MPI_Datatype datatype, MPI_Status* status)
+{
+    assert(0);
+}
+
+int MPI_File_read_at(MPI_File fh, long long offset, void* buf, int count,
+                     MPI_Datatype datatype, MPI_Status* status)
+{
+    assert(0);
+}
+
+int MPI_File_set_size(MPI_File fh, long long size)
+{
+    assert(0);
+}
+
+int MPI_File_set_view(MPI_File fh, long long disp, MPI_Datatype etype,
+                      MPI_Datatype filetype, const char* datarep,
+                      MPI_Info info)
+{
+    assert(0);
+}
+
+int MPI_File_write_all(MPI_File fh, const void* buf, int count,
+                       MPI_Datatype datatype, MPI_Status* status)
+{
+    assert(0);
+}
+
+int MPI_File_write_at(MPI_File fh, long long offset, const void* buf,
+                      int count, MPI_Datatype datatype, MPI_Status* status)
+{
+    assert(0);
+}
+
 int MPI_Group_free(MPI_Group* group)
 {
     assert(0);
@@ -109,6 +209,13 @@ int MPI_Group_translate_ranks(MPI_Group group1, int n, const int ranks1[],
     assert(0);
 }
 
+int MPI_Iallreduce(const void* sendbuf, void* recvbuf, int count,
+                   MPI_Datatype datatype, MPI_Op op, MPI_Comm comm,
+                   MPI_Request* request)
+{
+    assert(0);
+}
+
 int MPI_Init(int* argc, char*** argv)
 {
     return MPI_SUCCESS;
@@ -126,6 +233,18 @@ int MPI_Init_thread(int* argc, char*** argv, int required, int* provided)
     return MPI_SUCCESS;
 }
 
+int MPI_Query_thread(int* provided)
+{
+    *provided = MPI_THREAD_MULTIPLE;
+    return MPI_SUCCESS;
+}
+
+int MPI_Get_count(const MPI_Status* status, MPI_Datatype datatype,
+                  int* count)
+{
+    assert(0);
+}
+
 int MPI_Irecv(void* buf, int count, MPI_Datatype datatype, int source,
               int tag, MPI_Comm comm, MPI_Request* request)
 {
@@ -138,6 +257,18 @@ int MPI_Isend(const void* buf, int count, MPI_Datatype datatype, int dest,
     assert(0);
 }
 
+int MPI_Mprobe(int source, int tag, MPI_Comm comm, MPI_Message* message,
+               MPI_Status* status)
+{
+    assert(0);
+}
+
+int MPI_Mrecv(void* buf, int count, MPI_Datatype datatype,
+              MPI_Message* message, MPI_Status* status)
+{
+    assert(0);
+}
+
 int MPI_Recv(void* buf, int count, MPI_Datatype datatype, int source,
              int tag, MPI_Comm comm, MPI_Status* status)
 {
@@ -198,16 +329,39 @@ int MPI_Sendrecv(const void* sendbuf, int sendcount, MPI_Datatype sendtype,
     assert(0);
 }
 
+int MPI_Test(MPI_Request* request, int* flag, MPI_Status* status)
+{
+    assert(0);
+}
+
+int MPI_Testsome(int incount, MPI_Request requests[], int* outcount,
+                 int indices[], MPI_Status statuses[])
+{
+    assert(0);
+}
+
 int MPI_Type_commit(MPI_Datatype* datatype)
 {
     assert(0);
 }
 
+int MPI_Type_create_hindexed(int count, const int blocklengths[],
+                             const MPI_Aint displacements[],
+                             MPI_Datatype oldtype, MPI_Datatype* newtype)
+{
+    assert(0);
+}
+
 int MPI_Type_free(MPI_Datatype* datatype)
 {
     assert(0);
 }
 
+int MPI_Type_size(MPI_Datatype datatype, int* size)
+{
+    assert(0);
+}
+
 int MPI_Type_vector(int count, int blocklength, int stride,
                     MPI_Datatype oldtype, MPI_Datatype* newtype)
 {
@@ -224,6 +378,12 @@ int MPI_Waitall(int count, MPI_Request requests[], MPI_Status statuses[])
     assert(0);
 }
 
+int MPI_Waitany(int count, MPI_Request requests[], int* index,
+                MPI_Status* status)
+{
+    assert(0);
+}
+
 int MPI_Error_string(int errorcode, char* string, int* resultlen)
 {
     assert(0);
@@ -233,6 +393,12 @@ int MPI_Finalize(void)
 {
     return MPI_SUCCESS;
 }
+
+int MPI_Finalized(int* flag)
+{
+    *flag = 0;
+    return MPI_SUCCESS;
+}
 #ifdef __cplusplus
 }
 #endif
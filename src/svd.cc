@@ -9,55 +9,352 @@
 #include "slate/TriangularBandMatrix.hh"
 #include "internal/internal.hh"
 
+#include "lapack/fortran.h"
+
 namespace slate {
 
+namespace impl {
+
 //------------------------------------------------------------------------------
-/// Distributed parallel matrix singular value decomposition.
-/// Computes all singular values and, optionally, singular vectors of a
-/// matrix A. The matrix A is preliminary reduced to
-/// bidiagonal form using a two-stage approach:
-/// First stage: reduction to upper band bidiagonal form (see ge2tb);
-/// Second stage: reduction from band to bidiagonal form (see tb2bd).
+/// @internal
+/// Computes the SVD of an n-by-n upper bidiagonal matrix, B = U Sigma VT,
+/// using LAPACK bdsdc (divide and conquer) with compq = 'I'.
+/// On exit, D has the singular values in descending order,
+/// and U and VT have the singular vectors. E is destroyed.
+/// Returns the LAPACK info.
 ///
+inline int64_t bdsdc(
+    int64_t n, float* D, float* E,
+    float* U, int64_t ldu, float* VT, int64_t ldvt )
+{
+    char uplo = 'U', compq = 'I';
+    lapack_int n_ = n, ldu_ = ldu, ldvt_ = ldvt, info_ = 0;
+    std::vector<float> work( 3*n*n + 4*n );
+    std::vector<lapack_int> iwork( 8*n );
+    float dummy[1];
+    lapack_int idummy[1];
+    LAPACK_sbdsdc( &uplo, &compq, &n_, D, E, U, &ldu_, VT, &ldvt_,
+                   dummy, idummy, &work[0], &iwork[0], &info_ );
+    return info_;
+}
+
+/// @internal
+/// @see bdsdc
+inline int64_t bdsdc(
+    int64_t n, double* D, double* E,
+    double* U, int64_t ldu, double* VT, int64_t ldvt )
+{
+    char uplo = 'U', compq = 'I';
+    lapack_int n_ = n, ldu_ = ldu, ldvt_ = ldvt, info_ = 0;
+    std::vector<double> work( 3*n*n + 4*n );
+    std::vector<lapack_int> iwork( 8*n );
+    double dummy[1];
+    lapack_int idummy[1];
+    LAPACK_dbdsdc( &uplo, &compq, &n_, D, E, U, &ldu_, VT, &ldvt_,
+                   dummy, idummy, &work[0], &iwork[0], &info_ );
+    return info_;
+}
+
 //------------------------------------------------------------------------------
-/// @tparam scalar_t
-///     One of float, double, std::complex<float>, std::complex<double>.
+/// @internal
+/// Copies the real n-by-n column-major matrix Bdata into the local tiles
+/// of B, converting to scalar_t.
+///
+template <typename scalar_t>
+void svd_copy_to_tiles(
+    blas::real_type<scalar_t> const* Bdata, int64_t ldb,
+    Matrix<scalar_t>& B )
+{
+    int64_t jj = 0;
+    for (int64_t j = 0; j < B.nt(); ++j) {
+        int64_t ii = 0;
+        for (int64_t i = 0; i < B.mt(); ++i) {
+            if (B.tileIsLocal( i, j )) {
+                B.tileGetForWriting( i, j, LayoutConvert::ColMajor );
+                auto T = B( i, j );
+                for (int64_t tj = 0; tj < T.nb(); ++tj)
+                    for (int64_t ti = 0; ti < T.mb(); ++ti)
+                        T.at( ti, tj ) = Bdata[ (ii + ti) + (jj + tj)*ldb ];
+            }
+            ii += B.tileMb( i );
+        }
+        jj += B.tileNb( j );
+    }
+}
+
 //------------------------------------------------------------------------------
-/// @param[in] A
-///     On entry, the m-by-n matrix $A$.
-///     On exit, contents are destroyed.
+/// @internal
+/// Splits eigenvectors of the 2k-by-2k Golub-Kahan tridiagonal
+/// T_GK = tridiag( [ d_1, e_1, d_2, e_2, ..., d_k ] ), with zero diagonal,
+/// into singular vectors of the k-by-k upper bidiagonal B = bidiag( d, e ).
+/// The eigenvector of T_GK for eigenvalue -sigma interleaves the singular
+/// vectors, z = [ v(1), -u(1), v(2), -u(2), ..., v(k), -u(k) ] / sqrt( 2 ),
+/// where B v = sigma u.
+/// Z, U3, and VT3 are distributed by block columns over the same 1-by-p
+/// grid with the same nb, so the split is local.
 ///
-/// @param[out] Sigma
-///     The vector Sigma of length min( m, n ).
-///     If successful, the singular values in ascending order.
+/// @param[in] Z
+///     The 2k-by-nsel eigenvectors of T_GK.
 ///
-/// @param[out] U
-///     On entry, if U is empty, does not compute the left singular vectors.
-///     Otherwise, the m-by-min_mn ("economy size") or m-by-m ("all vectors")
-///     matrix $U$ to store the left singular vectors.
-///     On exit, the left orthonormal singular vectors of the matrix A.
+/// @param[out] U3
+///     The k-by-nsel left singular vectors, if not empty.
 ///
-/// @param[out] VT
-///     On entry, if VT is empty, does not compute the right singular vectors.
-///     Otherwise, the min_mn-by-n ("economy size") or n-by-n ("all vectors")
-///     matrix $VT$ to store the right singular vectors.
-///     On exit, the right orthonormal singular vectors of the matrix A.
+/// @param[out] V3
+///     The k-by-nsel right singular vectors, if not empty.
 ///
-/// @param[in] opts
-///     Additional options, as map of name = value pairs. Possible options:
-///     - Option::InnerBlocking:
-///       Inner blocking to use for panel. Default 16.
-///     - Option::MaxPanelThreads:
-///       Number of threads to use for panel. Default omp_get_max_threads()/2.
-///     - Option::Target:
-///       Implementation to target. Possible values:
-///       - HostTask:  OpenMP tasks on CPU host [default].
-///       - HostNest:  nested OpenMP parallel for loop on CPU host.
-///       - HostBatch: batched BLAS on CPU host.
-///       - Devices:   batched BLAS on GPU device.
+template <typename scalar_t>
+void svd_split_gk(
+    Matrix<scalar_t>& Z,
+    Matrix<scalar_t>& U3,
+    Matrix<scalar_t>& V3 )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    int64_t n_gk = Z.m();
+    int64_t k = n_gk / 2;
+    bool wantu  = U3.mt() > 0;
+    bool wantvt = V3.mt() > 0;
+
+    std::vector<scalar_t> z( n_gk );
+    for (int64_t j = 0; j < Z.nt(); ++j) {
+        if (! Z.tileIsLocal( 0, j ))
+            continue;
+
+        for (int64_t i = 0; i < Z.mt(); ++i)
+            Z.tileGetForReading( i, j, LayoutConvert::ColMajor );
+        for (int64_t i = 0; i < U3.mt(); ++i)
+            U3.tileGetForWriting( i, j, LayoutConvert::ColMajor );
+        for (int64_t i = 0; i < V3.mt(); ++i)
+            V3.tileGetForWriting( i, j, LayoutConvert::ColMajor );
+
+        for (int64_t jj = 0; jj < Z.tileNb( j ); ++jj) {
+            // Gather column jj of block column j of Z.
+            int64_t ii = 0;
+            for (int64_t i = 0; i < Z.mt(); ++i) {
+                auto T = Z( i, j );
+                blas::copy( T.mb(), &T.at( 0, jj ), 1, &z[ ii ], 1 );
+                ii += T.mb();
+            }
+
+            // Normalize u and v separately, which is more accurate than
+            // scaling by sqrt( 2 ) when sigma is tiny.
+            real_t unorm = blas::nrm2( k, &z[ 1 ], 2 );
+            real_t vnorm = blas::nrm2( k, &z[ 0 ], 2 );
+            ii = 0;
+            for (int64_t i = 0; i < std::max( U3.mt(), V3.mt() ); ++i) {
+                int64_t mb = wantu ? U3.tileMb( i ) : V3.tileMb( i );
+                if (wantu) {
+                    auto T = U3( i, j );
+                    for (int64_t ti = 0; ti < mb; ++ti)
+                        T.at( ti, jj ) = -z[ 2*(ii + ti) + 1 ] / unorm;
+                }
+                if (wantvt) {
+                    auto T = V3( i, j );
+                    for (int64_t ti = 0; ti < mb; ++ti)
+                        T.at( ti, jj ) = z[ 2*(ii + ti) ] / vnorm;
+                }
+                ii += mb;
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// @internal
+/// Adds to z the null vector of the odd-order block of T_GK starting at
+/// row begin, which T_GK splits off at zero entries of E. Its odd rows
+/// E[ i-1 ] z[ i-1 ] + E[ i ] z[ i+1 ] = 0 give the even entries; the odd
+/// entries are zero. It is not normalized.
 ///
-/// @ingroup svd
+template <typename real_t>
+void svd_null_block(
+    std::vector<real_t> const& E, int64_t begin, std::vector<real_t>& z )
+{
+    const real_t big = std::sqrt( std::numeric_limits<real_t>::max() );
+    int64_t n_gk = z.size();
+
+    z[ begin ] = 1;
+    for (int64_t i = begin + 1; i < n_gk && E[ i-1 ] != 0; i += 2) {
+        z[ i+1 ] = -E[ i-1 ] * z[ i-1 ] / E[ i ];
+        real_t zmax = std::abs( z[ i+1 ] );
+        if (zmax > big) {
+            for (int64_t ii = begin; ii <= i+1; ii += 2)
+                z[ ii ] /= zmax;
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// @internal
+/// Deflates zero singular values of B, as in bdsvdx: sets columns
+/// zero_begin, ... of Z to null vectors of T_GK.
+/// T_GK, with E's negligible entries set to zero, splits into unreduced
+/// blocks; each odd-order block has one zero eigenvalue, whose eigenvector
+/// has only v entries if the block starts at an even row, and only u
+/// entries otherwise. A zero singular value takes the next block of each
+/// kind, so B v = 0 and B^H u = 0, with u and v normalized by svd_split_gk.
+/// Inverse iteration can't find these vectors: it returns some mix of
+/// blocks, where u or v can be zero.
 ///
+/// @param[in] E
+///     The 2k-1 off-diagonal entries of T_GK.
+///
+/// @param[in] null_v
+///     First rows of the odd-order blocks starting at even rows.
+///
+/// @param[in] null_u
+///     First rows of the odd-order blocks starting at odd rows.
+///
+/// @param[in] zero_begin
+///     First column of Z for a zero singular value, possibly negative.
+///     Column j uses blocks null_v[ j - zero_begin ] and
+///     null_u[ j - zero_begin ].
+///
+/// @param[in,out] Z
+///     The 2k-by-nsel eigenvectors of T_GK, distributed by block columns.
+///
+template <typename scalar_t>
+void svd_null_gk(
+    std::vector< blas::real_type<scalar_t> > const& E,
+    std::vector<int64_t> const& null_v,
+    std::vector<int64_t> const& null_u,
+    int64_t zero_begin,
+    Matrix<scalar_t>& Z )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    int64_t n_gk = Z.m();
+    std::vector<real_t> z( n_gk );
+    int64_t jj = 0;
+    for (int64_t j = 0; j < Z.nt(); ++j) {
+        if (Z.tileIsLocal( 0, j )) {
+            for (int64_t tj = 0; tj < Z.tileNb( j ); ++tj) {
+                int64_t col = jj + tj;
+                if (col < zero_begin)
+                    continue;
+
+                std::fill( z.begin(), z.end(), real_t( 0 ) );
+                svd_null_block( E, null_v[ col - zero_begin ], z );
+                svd_null_block( E, null_u[ col - zero_begin ], z );
+
+                int64_t ii = 0;
+                for (int64_t i = 0; i < Z.mt(); ++i) {
+                    Z.tileGetForWriting( i, j, LayoutConvert::ColMajor );
+                    auto T = Z( i, j );
+                    for (int64_t ti = 0; ti < T.mb(); ++ti)
+                        T.at( ti, tj ) = z[ ii + ti ];
+                    ii += T.mb();
+                }
+            }
+        }
+        jj += Z.tileNb( j );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// @internal
+/// Computes the SVD by the QDWH polar decomposition, $A = U_p H$, then the
+/// QDWH-based eigen decomposition of $H = V \Sigma V^H$, so $U = U_p V$.
+/// For m < n, it decomposes $A^H$ instead. Made of level 3 BLAS only.
+/// Only economy size vectors are computed.
+/// On exit, A is destroyed.
+///
+template <typename scalar_t>
+void svd_qdwh(
+    Matrix<scalar_t>& A,
+    std::vector< blas::real_type<scalar_t> >& Sigma,
+    Matrix<scalar_t>& U,
+    Matrix<scalar_t>& VT,
+    Options const& opts)
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // Constants
+    const scalar_t zero = 0;
+    const scalar_t one  = 1;
+    const real_t r_one  = 1;
+
+    Target target = get_target( opts, Target::HostTask );
+
+    int64_t m = A.m();
+    int64_t n = A.n();
+    int64_t min_mn = std::min( m, n );
+    int64_t max_mn = std::max( m, n );
+    int64_t nb = A.tileNb( 0 );
+    MPI_Comm mpi_comm = A.mpiComm();
+
+    bool wantu  = (U.mt() > 0);
+    bool wantvt = (VT.mt() > 0);
+    if ((wantu && U.n() != min_mn) || (wantvt && VT.m() != min_mn))
+        slate_not_implemented( "svd: MethodSVD::QDWH with all vectors" );
+
+    GridOrder order;
+    int p, q, myrow, mycol;
+    A.gridinfo( &order, &p, &q, &myrow, &mycol );
+    if (order == GridOrder::Unknown) {
+        order = GridOrder::Col;
+        slate_mpi_call(
+            MPI_Comm_size( mpi_comm, &p ) );
+        q = 1;
+    }
+
+    // Up is the tall A or a copy of the tall A^H; on exit of polar,
+    // the polar factor U_p.
+    Matrix<scalar_t> Up;
+    if (m >= n) {
+        Up = A;
+    }
+    else {
+        Up = Matrix<scalar_t>( n, m, nb, nb, order, p, q, mpi_comm );
+        Up.insertLocalTiles( target );
+        auto AH = conj_transpose( A );
+        redistribute( AH, Up, opts );
+    }
+    Matrix<scalar_t> H( min_mn, min_mn, nb, nb, order, p, q, mpi_comm );
+    H.insertLocalTiles( target );
+    polar( Up, H, opts );
+
+    // The eigenvalues of -H are -Sigma in ascending order,
+    // so Sigma is in descending order.
+    Matrix<scalar_t> V;
+    if (wantu || wantvt) {
+        V = Matrix<scalar_t>( min_mn, min_mn, nb, nb, order, p, q, mpi_comm );
+        V.insertLocalTiles( target );
+    }
+    scale( -r_one, r_one, H, opts );
+    HermitianMatrix<scalar_t> H_lower( Uplo::Lower, H );
+    Options opts_eig( opts );
+    opts_eig[ Option::MethodEig ] = MethodEig::QDWH;
+    std::vector<real_t> Lambda;
+    heev( H_lower, Lambda, V, opts_eig );
+    for (int64_t i = 0; i < min_mn; ++i) {
+        // H is semi-definite; clamp rounding errors in the zero values.
+        Sigma[ i ] = std::max( -Lambda[ i ], real_t( 0 ) );
+    }
+
+    // For m >= n, A = (U_p V) Sigma V^H;
+    // for m < n,  A = V Sigma (U_p V)^H.
+    if ((m >= n && wantu) || (m < n && wantvt)) {
+        Matrix<scalar_t> W( max_mn, min_mn, nb, nb, order, p, q, mpi_comm );
+        W.insertLocalTiles( target );
+        gemm( one, Up, V, zero, W, opts );
+        if (m >= n) {
+            redistribute( W, U, opts );
+        }
+        else {
+            auto WH = conj_transpose( W );
+            redistribute( WH, VT, opts );
+        }
+    }
+    if (m >= n && wantvt) {
+        auto VH = conj_transpose( V );
+        redistribute( VH, VT, opts );
+    }
+    else if (m < n && wantu) {
+        redistribute( V, U, opts );
+    }
+}
+
 //------------------------------------------------------------------------------
 /// Note A is passed by value, so we can transpose if needed
 /// without affecting caller.
@@ -110,8 +407,15 @@ namespace slate {
 //  back-transform approach here is required.]
 //
 //  Step 3. Bidiagonal SVD.         // Abidiag = U3 Sigma VT3
-//  U3 = Identity, VT3 = Identity
-//  bdsvd( Sigma, E, U3, VT3 )
+//  if (QR)
+//      U3 = Identity, VT3 = Identity
+//      bdsqr( Sigma, E, U3, VT3 )  // 1D distributed U3, VT3
+//  elif (DC)
+//      bdsdc( Sigma, E, U3, VT3 )  // on root, then redistribute U3, VT3
+//  else (Bisection)
+//      stebz( T_GK ), stein( T_GK ) // singular values il:iu of Golub-Kahan
+//                                  // tridiagonal, then only their vectors;
+//                                  // back-transform only those columns
 //
 //  Backtransform vectors
 //  if (want U vectors)
@@ -144,8 +448,13 @@ namespace slate {
 //      if (m << n)
 //          unmlq( A, VT )          // VT = VT * VT0
 //
+/// @internal
+/// Computes the SVD; with MethodSVD::Bisection, only the singular values
+/// il, ..., iu and their vectors. See svd and svdx.
+///
 template <typename scalar_t>
 void svd(
+    int64_t il, int64_t iu,
     Matrix<scalar_t> A,
     std::vector< blas::real_type<scalar_t> >& Sigma,
     Matrix<scalar_t>& U,
@@ -176,7 +485,8 @@ void svd(
     const auto mpi_real_type = mpi_type< blas::real_type<scalar_t> >::value;
 
     // Options
-    Target target = get_option( opts, Option::Target, Target::HostTask );
+    Target target = get_target( opts, Target::HostTask );
+    MethodSVD method = get_option( opts, Option::MethodSVD, MethodSVD::Auto );
 
     int64_t m = A.m();
     int64_t n = A.n();
@@ -186,6 +496,17 @@ void svd(
     bool wantu  = (U.mt() > 0);
     bool wantvt = (VT.mt() > 0);
     bool allvec = (m > n && U.n() == m) || (m < n && VT.m() == n);
+
+    // Divide and conquer computes both the left and right vectors of the
+    // bidiagonal, so there's no savings from it when only values are wanted.
+    if (method == MethodSVD::Auto)
+        method = (wantu || wantvt) ? MethodSVD::DC : MethodSVD::QR;
+    bool bisection = method == MethodSVD::Bisection;
+    if (bisection && allvec)
+        slate_not_implemented( "svd: MethodSVD::Bisection with all vectors" );
+    if (bisection && (il < 1 || iu < il - 1 || iu > min_mn))
+        slate_error( "svd: requires 1 <= il <= iu + 1 <= min( m, n ) + 1" );
+    bool use_dc = method == MethodSVD::DC && (wantu || wantvt);
     //printf( "wantu %d, wantvt %d, allvec %d ", wantu, wantvt, allvec );
 
     // Scale A if max element outside range (sml_num, big_num).
@@ -207,6 +528,22 @@ void svd(
         scale( scl, Anorm, A, opts );
     }
 
+    if (method == MethodSVD::QDWH) {
+        Timer t_qdwh;
+        impl::svd_qdwh( A, Sigma, U, VT, opts );
+        timers[ "svd::qdwh" ] = t_qdwh.stop();
+
+        // If matrix was scaled, then rescale singular values appropriately.
+        if (scl != 1.) {
+            lapack::lascl( lapack::MatrixType::General, izero, izero,
+                           scl, Anorm,
+                           min_mn, ione,
+                           &Sigma[0], ione );
+        }
+        timers[ "svd" ] = t_svd.stop();
+        return;
+    }
+
     // 0. If m >> n, use QR factorization to reduce matrix A to a square matrix.
     //    If n << m, use LQ factorization to reduce matrix A to a square matrix.
     // Theoretical thresholds based on flops:
@@ -238,8 +575,7 @@ void svd(
 
         // Copy R to a new matrix Ahat.
         Ahat = R_.emptyLike();
-        Ahat.insertLocalTiles( target );
-        set( zero, Ahat, opts );  // todo: only lower
+        Ahat.insertLocalTilesZero( target );
 
         TriangularMatrix<scalar_t> Ahat_tr( Uplo::Upper, Diag::NonUnit, Ahat );
         slate::copy( R, Ahat_tr, opts );
@@ -255,8 +591,7 @@ void svd(
 
         // Copy L to a new matrix Ahat.
         Ahat = L_.emptyLike();
-        Ahat.insertLocalTiles( target );
-        set( zero, Ahat, opts );  // todo: only upper
+        Ahat.insertLocalTilesZero( target );
 
         TriangularMatrix<scalar_t> Ahat_tr( Uplo::Lower, Diag::NonUnit, Ahat );
         slate::copy( L, Ahat_tr, opts );
@@ -271,11 +606,13 @@ void svd(
     ge2tb( Ahat, TU1, TV1, opts );
     timers[ "svd::ge2tb" ] = t_ge2tb.stop();
 
-    // Currently, tb2bd and bdsqr run on a single node,
-    // gathers band matrix to rank 0.
+    // Copy band, distributed by block columns over a 1D grid of all ranks.
+    int mpi_size;
+    slate_mpi_call(
+        MPI_Comm_size( A.mpiComm(), &mpi_size ) );
     TriangularBandMatrix<scalar_t> Aband( Uplo::Upper, Diag::NonUnit,
                                           min_mn, nb, nb,
-                                          1, 1, A.mpiComm() );
+                                          1, mpi_size, A.mpiComm() );
     Aband.insertLocalTiles();
 
     // Slice in case Ahat is rectangular.
@@ -288,48 +625,205 @@ void svd(
     int64_t nt = Aband.nt();
     int64_t vm = 2*nb;
     int64_t vn = nt*(nt + 1)/2*nb;
-    Matrix<scalar_t> VT2( vm, vn, vm, nb, 1, 1, A.mpiComm() );
-    Matrix<scalar_t>  U2( vm, vn, vm, nb, 1, 1, A.mpiComm() );
+    Matrix<scalar_t> VT2( vm, vn, vm, nb, 1, mpi_size, A.mpiComm() );
+    Matrix<scalar_t>  U2( vm, vn, vm, nb, 1, mpi_size, A.mpiComm() );
+    VT2.insertLocalTiles();
+    U2.insertLocalTiles();
 
     // Allocate E for super-diagonal.
     std::vector<real_t> E( min_mn - 1 );
 
-    // 2. Reduce band to bi-diagonal.
-    if (A.mpiRank() == root) {
-        VT2.insertLocalTiles();
-        U2.insertLocalTiles();
+    // 2. Reduce band to bi-diagonal,
+    // with bulge chasing pipelined over all ranks.
+    Timer t_tb2bd;
+    tb2bd( Aband, U2, VT2, opts );
+    timers[ "svd::tb2bd" ] = t_tb2bd.stop();
 
-        Timer t_tb2bd;
-        tb2bd( Aband, U2, VT2, opts );
-        timers[ "svd::tb2bd" ] = t_tb2bd.stop();
+    // Copy diagonal and super-diagonal to vectors on all ranks.
+    internal::copytb2bd( Aband, Sigma, E );
 
-        // Copy diagonal and super-diagonal to vectors.
-        internal::copytb2bd( Aband, Sigma, E );
-
-        Aband.releaseRemoteWorkspace();
-    }
+    Aband.releaseRemoteWorkspace();
 
     scalar_t dummy[1];
 
-    if (wantu || wantvt) {
-        int mpi_size;
-        slate_mpi_call(
-            MPI_Comm_size( A.mpiComm(), &mpi_size ) );
+    if (bisection) {
+        // 3. Bidiagonal SVD by bisection and inverse iteration on the
+        // Golub-Kahan tridiagonal of order 2 min_mn,
+        //     T_GK = tridiag( [ d_1, e_1, d_2, e_2, ..., d_min_mn ] ),
+        // with zero diagonal, whose eigenvalues are +-Sigma. Its smallest
+        // eigenvalues, -Sigma in ascending order, give Sigma in descending
+        // order, so singular values il:iu are eigenvalues il:iu of T_GK.
+        // Each rank finds them redundantly (see stebz).
+        Timer t_bdsvd;
+        int64_t n_gk = 2*min_mn;
+        std::vector<real_t> D_gk( n_gk, r_zero ), E_gk( n_gk - 1 );
+        for (int64_t i = 0; i < min_mn; ++i) {
+            E_gk[ 2*i ] = Sigma[ i ];
+            if (i < min_mn - 1)
+                E_gk[ 2*i + 1 ] = E[ i ];
+        }
 
-        // Bcast the Sigma and E vectors (diagonal and sup/super-diagonal).
-        slate_mpi_call(
-            MPI_Bcast( &Sigma[0], min_mn,   mpi_real_type, root, A.mpiComm() ) );
-        slate_mpi_call(
-            MPI_Bcast( &E[0],     min_mn-1, mpi_real_type, root, A.mpiComm() ) );
+        // Split T_GK at negligible entries, as in bdsvdx. Each zero
+        // singular value of B is a pair of odd-order blocks, one starting
+        // at an even (v) row and one at an odd (u) row (see svd_null_gk).
+        real_t thresh = 0;
+        for (int64_t i = 0; i < n_gk - 1; ++i)
+            thresh = max( thresh, std::abs( E_gk[ i ] ) );
+        thresh *= eps;
+        std::vector<int64_t> null_v, null_u;
+        int64_t begin = 0;
+        for (int64_t i = 0; i < n_gk; ++i) {
+            if (i < n_gk - 1 && std::abs( E_gk[ i ] ) <= thresh)
+                E_gk[ i ] = r_zero;
+            if (i == n_gk - 1 || E_gk[ i ] == r_zero) {
+                if ((i - begin) % 2 == 0) {
+                    if (begin % 2 == 0)
+                        null_v.push_back( begin );
+                    else
+                        null_u.push_back( begin );
+                }
+                begin = i + 1;
+            }
+        }
+        assert( null_v.size() == null_u.size() );
+        int64_t nzero = null_v.size();
+
+        std::vector<real_t> Lambda;
+        int64_t il_out;
+        stebz( Range::Index, r_zero, r_zero, il, iu,
+               D_gk, E_gk, Lambda, il_out, opts );
+        int64_t nsel = Lambda.size();
 
+        // Singular values min_mn - nzero, ..., min_mn - 1 (0-based) are
+        // zero; they are in columns zero_begin, ..., nsel - 1.
+        int64_t zero_begin = min_mn - nzero - (il_out - 1);
+        Sigma.resize( nsel );
+        for (int64_t j = 0; j < nsel; ++j) {
+            // Clamp rounding errors in the zero values.
+            Sigma[ j ] = j >= zero_begin ? r_zero : max( -Lambda[ j ], r_zero );
+        }
+
+        if ((wantu || wantvt) && nsel > 0) {
+            if ((wantu && U.n() < nsel) || (wantvt && VT.m() < nsel))
+                slate_error( "svd: U and VT need at least "
+                             + std::to_string( nsel ) + " singular vectors" );
+
+            // Inverse iteration for only the nsel eigenvectors of T_GK,
+            // by block columns over all ranks (see stein),
+            // with the null vectors for zero singular values set directly,
+            // then split them into the bidiagonal U3 and V3.
+            Matrix<scalar_t> Z_gk( n_gk, nsel, nb, 1, mpi_size, A.mpiComm() );
+            Z_gk.insertLocalTiles( target );
+            stein( D_gk, E_gk, Lambda, Z_gk, opts );
+            if (zero_begin < nsel)
+                impl::svd_null_gk( E_gk, null_v, null_u, zero_begin, Z_gk );
+
+            Matrix<scalar_t> U3_1d_row, V3_1d_row;
+            if (wantu) {
+                U3_1d_row = Matrix<scalar_t>(
+                    min_mn, nsel, nb, 1, mpi_size, A.mpiComm() );
+                U3_1d_row.insertLocalTiles( target );
+            }
+            if (wantvt) {
+                V3_1d_row = Matrix<scalar_t>(
+                    min_mn, nsel, nb, 1, mpi_size, A.mpiComm() );
+                V3_1d_row.insertLocalTiles( target );
+            }
+            impl::svd_split_gk( Z_gk, U3_1d_row, V3_1d_row );
+            Z_gk.clear();
+            timers[ "svd::bdsvd" ] = t_bdsvd.stop();
+
+            // Back-transform only the nsel columns, as in the cases below.
+            if (wantu) {
+                // 2b. Backtransform tb2bd: U3 = U2 * U3.
+                Timer t_unmbr_tb2bd_U;
+                unmtr_hb2st( Side::Left, Op::NoTrans, U2, U3_1d_row, opts );
+                timers[ "svd::unmbr_tb2bd_U" ] = t_unmbr_tb2bd_U.stop();
+
+                Timer t_red;
+                auto U_11 = U.slice( 0, min_mn-1, 0, nsel-1 );
+                redistribute( U3_1d_row, U_11, opts );      // U_11 = U3
+                timers[ "svd::redistribute" ] = t_red.stop();
+
+                auto Usel = U.slice( 0, m-1, 0, nsel-1 );
+                if (m > n) {
+                    auto U_21 = U.slice( n, m-1, 0, nsel-1 );
+                    slate::set( zero, U_21, opts );         // U_21 = 0
+                }
+
+                // 1b. Backtransform ge2tb: Uhat = U1 * Uhat.
+                Matrix<scalar_t> Uhat = qr_path ? U_11 : Usel;
+                Timer t_unmbr_ge2tb_U;
+                unmbr_ge2tb( Side::Left, Op::NoTrans, Ahat, TU1, Uhat, opts );
+                timers[ "svd::unmbr_ge2tb_U" ] = t_unmbr_ge2tb_U.stop();
+
+                // 0b. Backtransform geqrf: U = U0 * U.
+                Timer t_unmqr;
+                if (qr_path) {
+                    unmqr( Side::Left, Op::NoTrans, A, TQ, Usel, opts );
+                }
+                timers[ "svd::unmqr" ] = t_unmqr.stop();
+            }
+
+            if (wantvt) {
+                // 2b. Backtransform tb2bd: V = VT2 * V.
+                Timer t_unmbr_tb2bd_V;
+                unmtr_hb2st( Side::Left, Op::NoTrans, VT2, V3_1d_row, opts );
+                timers[ "svd::unmbr_tb2bd_V" ] = t_unmbr_tb2bd_V.stop();
+
+                Timer t_red;
+                auto VT_11 = VT.slice( 0, nsel-1, 0, min_mn-1 );
+                auto VT3 = conj_transpose( V3_1d_row );
+                redistribute( VT3, VT_11, opts );           // VT_11 = VT3
+                timers[ "svd::redistribute" ] += t_red.stop();
+
+                auto VTsel = VT.slice( 0, nsel-1, 0, n-1 );
+                if (n > m) {
+                    auto VT_12 = VT.slice( 0, nsel-1, m, n-1 );
+                    slate::set( zero, VT_12, opts );        // VT_12 = 0
+                }
+
+                // 1b. Backtransform ge2tb: VThat = VThat * VT1.
+                Matrix<scalar_t> VThat = lq_path ? VT_11 : VTsel;
+                Timer t_unmbr_ge2tb_V;
+                unmbr_ge2tb( Side::Right, Op::NoTrans, Ahat, TV1, VThat, opts );
+                timers[ "svd::unmbr_ge2tb_V" ] = t_unmbr_ge2tb_V.stop();
+
+                // 0b. Backtransform gelqf: VT = VT * VT0.
+                Timer t_unmlq;
+                if (lq_path) {
+                    unmlq( Side::Right, Op::NoTrans, A, TQ, VTsel, opts );
+                }
+                timers[ "svd::unmlq" ] = t_unmlq.stop();
+            }
+        }
+        else {
+            timers[ "svd::bdsvd" ] = t_bdsvd.stop();
+        }
+    }
+    else if (wantu || wantvt) {
         // Build the 1D distributed U and VT needed for bdsqr.
         // U3_1d_col  is mlocal_U-by-min_mn  on np-by-1 col grid (np = mpi_size).
         // VT3_1d_row is min_mn-by-nlocal_VT on 1-by-np row grid.
+        // For bdsdc, U3_1d_col and VT3_1d_row are instead on the
+        // 1-by-1 grid of the root, which computes them.
         int64_t nlocal_VT = 0, mlocal_U = 0, ldvt = 1, ldu = 1;
         std::vector<scalar_t> U3_1d_col_data( 1 );
         std::vector<scalar_t> VT3_1d_row_data( 1 );
         Matrix<scalar_t> U3_1d_col, VT3_1d_row;
-        if (wantu) {
+        if (use_dc) {
+            if (wantu) {
+                U3_1d_col = Matrix<scalar_t>(
+                    min_mn, min_mn, nb, 1, 1, A.mpiComm() );
+                U3_1d_col.insertLocalTiles();
+            }
+            if (wantvt) {
+                VT3_1d_row = Matrix<scalar_t>(
+                    min_mn, min_mn, nb, 1, 1, A.mpiComm() );
+                VT3_1d_row.insertLocalTiles();
+            }
+        }
+        if (wantu && ! use_dc) {
             int myrow = A.mpiRank();
             mlocal_U = num_local_rows_cols( min_mn, nb, myrow, izero, mpi_size );
             ldu = max( 1, mlocal_U );
@@ -339,7 +833,7 @@ void svd(
                     mpi_size, 1, A.mpiComm() );
             set( zero, one, U3_1d_col, opts ); // Identity
         }
-        if (wantvt) {
+        if (wantvt && ! use_dc) {
             int mycol = A.mpiRank();
             nlocal_VT = num_local_rows_cols( min_mn, nb, mycol, izero, mpi_size );
             ldvt = max( 1, min_mn );
@@ -356,11 +850,32 @@ void svd(
         // and reuse memory.
         //bdsqr<scalar_t>( jobu, jobvt, Sigma, E, Uhat, VThat, opts );
         Timer t_bdsvd;
-        lapack::bdsqr( Uplo::Upper, min_mn, nlocal_VT, mlocal_U, 0,
-                       &Sigma[0], &E[0],
-                       &VT3_1d_row_data[0], ldvt,
-                       &U3_1d_col_data[0], ldu,
-                       dummy, 1 );
+        if (use_dc) {
+            // Divide and conquer computes the real U3 and VT3 on root,
+            // using Level 3 BLAS for the merges. They are distributed
+            // below, so the back-transforms are the same as for bdsqr.
+            if (A.mpiRank() == root) {
+                std::vector<real_t> U3_data( min_mn*min_mn );
+                std::vector<real_t> VT3_data( min_mn*min_mn );
+                int64_t info = impl::bdsdc(
+                    min_mn, &Sigma[0], &E[0],
+                    &U3_data[0], min_mn, &VT3_data[0], min_mn );
+                slate_assert( info >= 0 );
+                if (wantu)
+                    impl::svd_copy_to_tiles( &U3_data[0], min_mn, U3_1d_col );
+                if (wantvt)
+                    impl::svd_copy_to_tiles( &VT3_data[0], min_mn, VT3_1d_row );
+            }
+            slate_mpi_call(
+                MPI_Bcast( &Sigma[0], min_mn, mpi_real_type, root, A.mpiComm() ) );
+        }
+        else {
+            lapack::bdsqr( Uplo::Upper, min_mn, nlocal_VT, mlocal_U, 0,
+                           &Sigma[0], &E[0],
+                           &VT3_1d_row_data[0], ldvt,
+                           &U3_1d_col_data[0], ldu,
+                           dummy, 1 );
+        }
         timers[ "svd::bdsvd" ] = t_bdsvd.stop();
 
         // Back-transform: U = U0 * U1 * U2 * U3.
@@ -369,7 +884,8 @@ void svd(
         // U2 is the output of tb2bd.
         // U3 is the output of bdsqr.
         if (wantu) {
-            // Redistribute U3 from np-by-1 col grid to 1-by-np row grid.
+            // Redistribute U3 from np-by-1 col grid (or root for bdsdc)
+            // to 1-by-np row grid.
             Matrix<scalar_t> U3_1d_row(
                 min_mn, min_mn, nb, 1, mpi_size, A.mpiComm() );
             U3_1d_row.insertLocalTiles( target );
@@ -514,13 +1030,141 @@ void svd(
         // SLATE  scale has numerator, denominator.
         lapack::lascl( lapack::MatrixType::General, izero, izero,
                        scl, Anorm,
-                       min_mn, ione,
-                       &Sigma[0], ione );
+                       Sigma.size(), ione,
+                       Sigma.data(), ione );
     }
 
     timers[ "svd" ] = t_svd.stop();
 }
 
+} // namespace impl
+
+//------------------------------------------------------------------------------
+/// Distributed parallel matrix singular value decomposition.
+/// Computes all singular values and, optionally, singular vectors of a
+/// matrix A. The matrix A is preliminary reduced to
+/// bidiagonal form using a two-stage approach:
+/// First stage: reduction to upper band bidiagonal form (see ge2tb);
+/// Second stage: reduction from band to bidiagonal form (see tb2bd).
+///
+//------------------------------------------------------------------------------
+/// @tparam scalar_t
+///     One of float, double, std::complex<float>, std::complex<double>.
+//------------------------------------------------------------------------------
+/// @param[in] A
+///     On entry, the m-by-n matrix $A$.
+///     On exit, contents are destroyed.
+///
+/// @param[out] Sigma
+///     The vector Sigma of length min( m, n ).
+///     If successful, the singular values in ascending order.
+///
+/// @param[out] U
+///     On entry, if U is empty, does not compute the left singular vectors.
+///     Otherwise, the m-by-min_mn ("economy size") or m-by-m ("all vectors")
+///     matrix $U$ to store the left singular vectors.
+///     On exit, the left orthonormal singular vectors of the matrix A.
+///
+/// @param[out] VT
+///     On entry, if VT is empty, does not compute the right singular vectors.
+///     Otherwise, the min_mn-by-n ("economy size") or n-by-n ("all vectors")
+///     matrix $VT$ to store the right singular vectors.
+///     On exit, the right orthonormal singular vectors of the matrix A.
+///
+/// @param[in] opts
+///     Additional options, as map of name = value pairs. Possible options:
+///     - Option::InnerBlocking:
+///       Inner blocking to use for panel. Default 16.
+///     - Option::MaxPanelThreads:
+///       Number of threads to use for panel. Default omp_get_max_threads()/2.
+///     - Option::MethodSVD:
+///       Bidiagonal SVD solver. Possible values:
+///       - Auto: DC if computing vectors, otherwise QR [default].
+///       - QR:   QR iteration (bdsqr), updating the distributed U and VT.
+///       - DC:   Divide and conquer (bdsdc) for the bidiagonal vectors,
+///               which are then distributed for the back-transforms.
+///       - Bisection: bisection and inverse iteration on the Golub-Kahan
+///               tridiagonal (see svdx). Computes only economy size vectors.
+///       - QDWH: QDWH polar decomposition A = U_p H, then QDWH-based
+///               eigen decomposition of H, all in level 3 BLAS.
+///               Computes only economy size vectors.
+///     - Option::Target:
+///       Implementation to target. Possible values:
+///       - HostTask:  OpenMP tasks on CPU host [default].
+///       - HostNest:  nested OpenMP parallel for loop on CPU host.
+///       - HostBatch: batched BLAS on CPU host.
+///       - Devices:   batched BLAS on GPU device.
+///
+/// @ingroup svd
+///
+template <typename scalar_t>
+void svd(
+    Matrix<scalar_t> A,
+    std::vector< blas::real_type<scalar_t> >& Sigma,
+    Matrix<scalar_t>& U,
+    Matrix<scalar_t>& VT,
+    Options const& opts)
+{
+    impl::svd( 1, std::min( A.m(), A.n() ), A, Sigma, U, VT, opts );
+}
+
+//------------------------------------------------------------------------------
+/// Distributed parallel partial singular value decomposition.
+/// Computes the singular values il, ..., iu, in descending order, and,
+/// optionally, their singular vectors of a matrix A, as in LAPACK gesvdx.
+/// As svd, but the bidiagonal SVD is solved by bisection for only the
+/// selected singular values (see stebz), then by inverse iteration for only
+/// their vectors (see stein), on the Golub-Kahan tridiagonal, and only those
+/// columns are back-transformed. This saves most of the work of the
+/// bidiagonal SVD and back-transformation when only a few singular triplets
+/// are needed, with the accuracy of a full SVD.
+///
+//------------------------------------------------------------------------------
+/// @tparam scalar_t
+///     One of float, double, std::complex<float>, std::complex<double>.
+//------------------------------------------------------------------------------
+/// @param[in] il, iu
+///     The 1-based indices of the largest and smallest singular values
+///     to find, counting from the largest;
+///     1 <= il <= iu <= min( m, n ).
+///
+/// @param[in] A
+///     On entry, the m-by-n matrix $A$.
+///     On exit, contents are destroyed.
+///
+/// @param[out] Sigma
+///     On exit, the nsel = iu - il + 1 selected singular values
+///     in descending order, resized to nsel.
+///
+/// @param[out] U
+///     On entry, if U is empty, does not compute the left singular vectors.
+///     Otherwise, the m-by-k matrix $U$, k >= nsel.
+///     On exit, the first nsel columns have the left singular vectors.
+///
+/// @param[out] VT
+///     On entry, if VT is empty, does not compute the right singular vectors.
+///     Otherwise, the k-by-n matrix $VT$, k >= nsel.
+///     On exit, the first nsel rows have the right singular vectors.
+///
+/// @param[in] opts
+///     Additional options, as for svd, except Option::MethodSVD.
+///
+/// @ingroup svd
+///
+template <typename scalar_t>
+void svdx(
+    int64_t il, int64_t iu,
+    Matrix<scalar_t> A,
+    std::vector< blas::real_type<scalar_t> >& Sigma,
+    Matrix<scalar_t>& U,
+    Matrix<scalar_t>& VT,
+    Options const& opts)
+{
+    Options opts_local( opts );
+    opts_local[ Option::MethodSVD ] = MethodSVD::Bisection;
+    impl::svd( il, iu, A, Sigma, U, VT, opts_local );
+}
+
 //------------------------------------------------------------------------------
 // Explicit instantiations.
 template
@@ -555,4 +1199,40 @@ void svd< std::complex<double> >(
      Matrix< std::complex<double> >& VT,
      Options const& opts);
 
+template
+void svdx<float>(
+     int64_t il, int64_t iu,
+     Matrix<float> A,
+     std::vector<float>& S,
+     Matrix<float>& U,
+     Matrix<float>& VT,
+     Options const& opts);
+
+template
+void svdx<double>(
+     int64_t il, int64_t iu,
+     Matrix<double> A,
+     std::vector<double>& S,
+     Matrix<double>& U,
+     Matrix<double>& VT,
+     Options const& opts);
+
+template
+void svdx< std::complex<float> >(
+     int64_t il, int64_t iu,
+     Matrix< std::complex<float> > A,
+     std::vector<float>& S,
+     Matrix< std::complex<float> >& U,
+     Matrix< std::complex<float> >& VT,
+     Options const& opts);
+
+template
+void svdx< std::complex<double> >(
+     int64_t il, int64_t iu,
+     Matrix< std::complex<double> > A,
+     std::vector<double>& S,
+     Matrix< std::complex<double> >& U,
+     Matrix< std::complex<double> >& VT,
+     Options const& opts);
+
 } // namespace slate
@@ -0,0 +1,317 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/slate.hh"
+#include "internal/internal.hh"
+
+#include <algorithm>
+#include <vector>
+
+namespace slate {
+
+namespace impl {
+
+//------------------------------------------------------------------------------
+/// @internal
+/// Fills the local tiles of Omega with independent normal (0, 1) entries
+/// (real and imaginary parts, if complex), using LAPACK larnv with a seed
+/// derived from each tile's indices, so the sketch does not depend on the
+/// number of ranks or threads.
+///
+template <typename scalar_t>
+void svd_rand_sketch( Matrix<scalar_t>& Omega, int64_t seed )
+{
+    #pragma omp parallel
+    #pragma omp master
+    {
+        for (int64_t j = 0; j < Omega.nt(); ++j) {
+            for (int64_t i = 0; i < Omega.mt(); ++i) {
+                if (Omega.tileIsLocal( i, j )) {
+                    #pragma omp task slate_omp_default_none \
+                        shared( Omega ) firstprivate( i, j, seed )
+                    {
+                        Omega.tileGetForWriting( i, j, LayoutConvert::ColMajor );
+                        auto T = Omega( i, j );
+                        int64_t iseed[4] = { (seed + i) % 4096, j % 4096,
+                                             (i + j) / 4096 % 4096, 115 };
+                        for (int64_t jj = 0; jj < T.nb(); ++jj)
+                            lapack::larnv( 3, iseed, T.mb(), &T.at( 0, jj ) );
+                    }
+                }
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// @internal
+/// Computes an orthonormal basis Q of the range of the tall matrix Y,
+/// by Householder QR, Y = Q R, forming Q explicitly. Y is overwritten.
+///
+template <typename scalar_t>
+void svd_rand_orth(
+    Matrix<scalar_t>& Y, Matrix<scalar_t>& Q, Options const& opts )
+{
+    const scalar_t zero = 0, one = 1;
+
+    TriangularFactors<scalar_t> T;
+    geqrf( Y, T, opts );
+    set( zero, one, Q, opts );
+    unmqr( Side::Left, Op::NoTrans, Y, T, Q, opts );
+}
+
+} // namespace impl
+
+//------------------------------------------------------------------------------
+/// Distributed parallel randomized truncated singular value decomposition.
+/// Computes approximations of the k largest singular values and,
+/// optionally, the corresponding singular vectors of a matrix A,
+/// \[
+///     A \approx U \Sigma V^H,
+/// \]
+/// by a randomized range finder (Halko, Martinsson, and Tropp, 2011):
+///
+/// 1. Sketch $Y = A \Omega$, with $\Omega$ an n-by-l Gaussian matrix,
+///    $l = k + p$ for oversampling p, and orthonormalize $Y = Q R$.
+/// 2. Do q power iterations, $Q = orth( A\, orth( A^H Q ) )$, which
+///    sharpen the decay of the singular values for a slowly decaying
+///    spectrum.
+/// 3. Factor $A^H Q = Q_2 R_2$, so $Q^H A = R_2^H Q_2^H$, and compute the
+///    SVD of the l-by-l matrix $R_2 = W \Sigma X^H$ on one rank.
+/// 4. Form $U = Q X$ and $V^H = W^H Q_2^H$, keeping the first k.
+///
+/// This costs $O( m n l (q + 1) )$ flops in gemm and $O( (m + n) l^2 )$ in
+/// the orthonormalizations, instead of $O( m n \min( m, n ) )$ for svd,
+/// so it suits $k \ll \min( m, n )$. The error in the singular values is
+/// bounded by $\| A - Q Q^H A \|$, which is near $\sigma_{k+1}$ when
+/// the spectrum decays; it is not accurate for a flat spectrum.
+///
+/// The tiles of A are assumed uniform. A is not modified.
+///
+//------------------------------------------------------------------------------
+/// @tparam scalar_t
+///     One of float, double, std::complex<float>, std::complex<double>.
+//------------------------------------------------------------------------------
+/// @param[in] A
+///     The m-by-n matrix $A$.
+///
+/// @param[in] k
+///     The number of singular values and vectors to compute.
+///     0 <= k <= min( m, n ).
+///
+/// @param[out] Sigma
+///     On exit, the vector Sigma of length k, with the approximate largest
+///     singular values in descending order.
+///
+/// @param[out] U
+///     On entry, if U is empty, does not compute the left singular vectors.
+///     Otherwise, the m-by-k matrix $U$, with the same tile sizes and
+///     distribution as the first k columns of a matrix distributed like A.
+///     On exit, the approximate left orthonormal singular vectors.
+///
+/// @param[out] VT
+///     On entry, if VT is empty, does not compute the right singular vectors.
+///     Otherwise, the k-by-n matrix $V^H$, with tile sizes and
+///     distribution like those of U.
+///     On exit, the approximate right orthonormal singular vectors.
+///
+/// @param[in] opts
+///     Additional options, as map of name = value pairs. Possible options:
+///     - Option::Oversampling:
+///       Number of extra sketch columns p, so l = min( k + p, min( m, n ) ).
+///       p >= 0. Default 10.
+///     - Option::PowerIterations:
+///       Number of power iterations q. q >= 0. Default 2.
+///     - Options of gemm, geqrf, and unmqr, used by each step.
+///
+/// @ingroup svd
+///
+template <typename scalar_t>
+void svd_rand(
+    Matrix<scalar_t>& A, int64_t k,
+    std::vector< blas::real_type<scalar_t> >& Sigma,
+    Matrix<scalar_t>& U,
+    Matrix<scalar_t>& VT,
+    Options const& opts )
+{
+    trace::Block trace_block( "slate::svd_rand" );
+
+    using real_t = blas::real_type<scalar_t>;
+
+    // Constants
+    const scalar_t zero = 0;
+    const scalar_t one  = 1;
+    const int root = 0;
+    const int64_t seed = 42;
+
+    const auto mpi_real_type = mpi_type<real_t>::value;
+
+    // Options
+    Target target = get_target( opts, Target::HostTask );
+    int64_t oversampling = get_option<int64_t>( opts, Option::Oversampling, 10 );
+    int64_t power_iters = get_option<int64_t>( opts, Option::PowerIterations, 2 );
+
+    int64_t m = A.m();
+    int64_t n = A.n();
+    int64_t min_mn = std::min( m, n );
+
+    if (k < 0 || k > min_mn)
+        slate_error( "svd_rand: requires 0 <= k <= min( m, n )" );
+    if (oversampling < 0)
+        slate_error( "svd_rand: Oversampling must be >= 0" );
+    if (power_iters < 0)
+        slate_error( "svd_rand: PowerIterations must be >= 0" );
+
+    bool wantu  = (U.mt() > 0);
+    bool wantvt = (VT.mt() > 0);
+    if (wantu)
+        slate_assert( U.m() == m && U.n() == k );
+    if (wantvt)
+        slate_assert( VT.m() == k && VT.n() == n );
+
+    Sigma.resize( k );
+    if (k == 0)
+        return;
+
+    int64_t l = std::min( k + oversampling, min_mn );
+    int64_t mb = A.tileMb( 0 );
+    int64_t nb = A.tileNb( 0 );
+    MPI_Comm mpi_comm = A.mpiComm();
+
+    // Sketches use A's grid, or a 1D grid if A isn't 2D block cyclic.
+    GridOrder order;
+    int p, q, myrow, mycol;
+    A.gridinfo( &order, &p, &q, &myrow, &mycol );
+    if (order == GridOrder::Unknown) {
+        order = GridOrder::Col;
+        slate_mpi_call(
+            MPI_Comm_size( mpi_comm, &p ) );
+        q = 1;
+    }
+
+    auto AH = conj_transpose( A );
+
+    // Y and Q are m-by-l, with A's row tiles;
+    // Z and Qz are n-by-l, with A's column tiles.
+    Matrix<scalar_t> Y ( m, l, mb, nb, order, p, q, mpi_comm );
+    Matrix<scalar_t> Q ( m, l, mb, nb, order, p, q, mpi_comm );
+    Matrix<scalar_t> Z ( n, l, nb, nb, order, p, q, mpi_comm );
+    Matrix<scalar_t> Qz( n, l, nb, nb, order, p, q, mpi_comm );
+    Y.insertLocalTiles( target );
+    Q.insertLocalTiles( target );
+    Z.insertLocalTiles( target );
+    Qz.insertLocalTiles( target );
+
+    // 1. Range finder: Q = orth( A Omega ), using Qz for Omega.
+    impl::svd_rand_sketch( Qz, seed );
+    gemm( one, A, Qz, zero, Y, opts );
+    impl::svd_rand_orth( Y, Q, opts );
+
+    // 2. Power iterations, orthonormalizing after each product
+    // to keep the small singular values from being lost to rounding.
+    for (int64_t iter = 0; iter < power_iters; ++iter) {
+        gemm( one, AH, Q, zero, Z, opts );
+        impl::svd_rand_orth( Z, Qz, opts );
+        gemm( one, A, Qz, zero, Y, opts );
+        impl::svd_rand_orth( Y, Q, opts );
+    }
+
+    // 3. Z = A^H Q = Q2 R2. Q2 is formed in Qz, if needed.
+    gemm( one, AH, Q, zero, Z, opts );
+    TriangularFactors<scalar_t> T;
+    geqrf( Z, T, opts );
+    if (wantvt) {
+        set( zero, one, Qz, opts );
+        unmqr( Side::Left, Op::NoTrans, Z, T, Qz, opts );
+    }
+
+    // Gather R2 as a single tile on root, and compute its SVD there.
+    // W and XH are the left and right singular vectors of R2.
+    Matrix<scalar_t> R2( l, l, l, 1, 1, mpi_comm );
+    Matrix<scalar_t> W ( l, l, l, 1, 1, mpi_comm );
+    Matrix<scalar_t> XH( l, l, l, 1, 1, mpi_comm );
+    R2.insertLocalTiles();
+    W.insertLocalTiles();
+    XH.insertLocalTiles();
+
+    auto Z_11 = Z.slice( 0, l-1, 0, l-1 );
+    redistribute( Z_11, R2, opts );
+
+    std::vector<real_t> S( l );
+    if (A.mpiRank() == root) {
+        auto R2_00 = R2( 0, 0 );
+        auto W_00  = W( 0, 0 );
+        auto XH_00 = XH( 0, 0 );
+        // Zero the Householder vectors below the diagonal.
+        if (l > 1) {
+            lapack::laset(
+                lapack::MatrixType::Lower, l-1, l-1, zero, zero,
+                &R2_00.at( 1, 0 ), R2_00.stride() );
+        }
+        int64_t info = lapack::gesdd(
+            lapack::Job::SomeVec, l, l,
+            R2_00.data(), R2_00.stride(), &S[ 0 ],
+            W_00.data(), W_00.stride(), XH_00.data(), XH_00.stride() );
+        slate_assert( info == 0 );
+    }
+    slate_mpi_call(
+        MPI_Bcast( &S[ 0 ], l, mpi_real_type, root, mpi_comm ) );
+    std::copy( S.begin(), S.begin() + k, Sigma.begin() );
+
+    // 4. Back-transform, with the small vectors distributed like Z's tiles.
+    if (wantu) {
+        // U = Q X(:, 0:k-1) = Q XH(0:k-1, :)^H.
+        Matrix<scalar_t> XH_dist( l, l, nb, nb, order, p, q, mpi_comm );
+        XH_dist.insertLocalTiles( target );
+        redistribute( XH, XH_dist, opts );
+        auto X_k = conj_transpose( XH_dist.slice( 0, k-1, 0, l-1 ) );
+        gemm( one, Q, X_k, zero, U, opts );
+    }
+    if (wantvt) {
+        // VT = W(:, 0:k-1)^H Q2^H.
+        Matrix<scalar_t> W_dist( l, l, nb, nb, order, p, q, mpi_comm );
+        W_dist.insertLocalTiles( target );
+        redistribute( W, W_dist, opts );
+        auto WH_k = conj_transpose( W_dist.slice( 0, l-1, 0, k-1 ) );
+        auto Q2H = conj_transpose( Qz );
+        gemm( one, WH_k, Q2H, zero, VT, opts );
+    }
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void svd_rand<float>(
+    Matrix<float>& A, int64_t k,
+    std::vector<float>& Sigma,
+    Matrix<float>& U,
+    Matrix<float>& VT,
+    Options const& opts);
+
+template
+void svd_rand<double>(
+    Matrix<double>& A, int64_t k,
+    std::vector<double>& Sigma,
+    Matrix<double>& U,
+    Matrix<double>& VT,
+    Options const& opts);
+
+template
+void svd_rand< std::complex<float> >(
+    Matrix< std::complex<float> >& A, int64_t k,
+    std::vector<float>& Sigma,
+    Matrix< std::complex<float> >& U,
+    Matrix< std::complex<float> >& VT,
+    Options const& opts);
+
+template
+void svd_rand< std::complex<double> >(
+    Matrix< std::complex<double> >& A, int64_t k,
+    std::vector<double>& Sigma,
+    Matrix< std::complex<double> >& U,
+    Matrix< std::complex<double> >& VT,
+    Options const& opts);
+
+} // namespace slate
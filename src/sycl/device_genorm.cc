@@ -0,0 +1,287 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/Exception.hh"
+#include "slate/internal/device.hh"
+
+#include "device_util.hh"
+
+#include <cassert>
+#include <complex>
+
+namespace slate {
+namespace device {
+
+using namespace sycl_util;
+
+//------------------------------------------------------------------------------
+/// Batched routine that computes a norm of each tile in Aarray,
+/// with one work-group of nb work-items per tile.
+///
+/// Norm::Max and Norm::Fro reduce over each sub-group with shuffles in
+/// registers, then across sub-groups in shared local memory.
+/// Norm::One and NormScope::Columns assign columns to sub-groups, whose
+/// work-items read consecutive rows, for coalesced reads, and reduce
+/// each column with a sub-group reduction.
+/// Norm::Inf assigns one row to each work-item.
+///
+/// @param[in] m
+///     Number of rows of each tile. m >= 0.
+///
+/// @param[in] n
+///     Number of columns of each tile. n >= 0.
+///
+/// @param[in] Aarray
+///     Array in GPU memory of dimension batch_count, containing pointers to tiles,
+///     where each Aarray[k] is an m-by-n matrix stored in an lda-by-n array in GPU memory.
+///
+/// @param[in] lda
+///     Leading dimension of each tile. lda >= m.
+///
+/// @param[out] values
+///     Array in GPU memory, dimension batch_count * ldv.
+///     - Norm::Max: ldv = 1.
+///         On exit, values[k] = max_{i, j} abs( A^(k)_(i, j) )
+///         for 0 <= k < batch_count.
+///
+///     - Norm::One: ldv >= n.
+///         On exit, values[k*ldv + j] = sum_{i} abs( A^(k)_(i, j) )
+///         for 0 <= k < batch_count, 0 <= j < n.
+///
+///     - Norm::Inf: ldv >= m.
+///         On exit, values[k*ldv + i] = sum_{j} abs( A^(k)_(i, j) )
+///         for 0 <= k < batch_count, 0 <= i < m.
+///
+///     - Norm::Fro: ldv = 2.
+///         On exit,
+///             values[k*2 + 0] = scale_k
+///             values[k*2 + 1] = sumsq_k
+///         where scale_k^2 sumsq_k = sum_{i,j} abs( A^(k)_(i, j) )^2
+///         for 0 <= k < batch_count.
+///
+///     - NormScope::Columns, Norm::Max: ldv >= n.
+///         On exit, values[k*ldv + j] = max_{i} abs( A^(k)_(i, j) )
+///         for 0 <= k < batch_count, 0 <= j < n.
+///
+/// @param[in] ldv
+///     Leading dimension of values array.
+///
+/// @param[in] batch_count
+///     Size of Aarray. batch_count >= 0.
+///
+/// @param[in] queue
+///     BLAS++ queue to execute in.
+///
+template <typename scalar_t>
+void genorm(
+    lapack::Norm norm, NormScope scope,
+    int64_t m, int64_t n,
+    scalar_t const* const* Aarray, int64_t lda,
+    blas::real_type<scalar_t>* values, int64_t ldv, int64_t batch_count,
+    blas::Queue &queue)
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // quick return
+    if (batch_count == 0)
+        return;
+
+    sycl::queue& stream = queue.stream();
+    sycl::nd_range<1> range( batch_count * nb, nb );
+
+    if (scope == NormScope::Matrix) {
+
+        //---------
+        // max norm
+        if (norm == lapack::Norm::Max) {
+            if (m == 0 || n == 0) {
+                blas::device_memset( values, 0, batch_count, queue );
+            }
+            else {
+                assert( ldv == 1 );
+                stream.submit( [&]( sycl::handler& cgh ) {
+                    sycl::local_accessor<real_t, 1> partial( max_sub_groups, cgh );
+                    cgh.parallel_for( range, [=]( sycl::nd_item<1> item ) {
+                        int64_t k = item.get_group_linear_id();
+                        int tid = item.get_local_linear_id();
+                        scalar_t const* tile = Aarray[ k ];
+
+                        // Each work-item finds max of rows tid, tid + nb, ....
+                        real_t max = 0;
+                        for (int64_t i = tid; i < m; i += nb) {
+                            scalar_t const* row = &tile[ i ];
+                            for (int64_t j = 0; j < n; ++j)
+                                max = max_nan( max, abs_val( row[ j*lda ] ) );
+                        }
+                        max = group_max_nan( item, max, partial );
+                        if (tid == 0)
+                            values[ k ] = max;
+                    } );
+                } );
+            }
+        }
+        //---------
+        // one norm
+        else if (norm == lapack::Norm::One) {
+            if (m == 0 || n == 0) {
+                blas::device_memset( values, 0, batch_count * n, queue );
+            }
+            else {
+                assert( ldv >= n );
+                stream.parallel_for( range, [=]( sycl::nd_item<1> item ) {
+                    int64_t k = item.get_group_linear_id();
+                    sycl::sub_group sg = item.get_sub_group();
+                    int lane      = sg.get_local_linear_id();
+                    int sg_size   = sg.get_local_linear_range();
+                    int sg_id     = sg.get_group_linear_id();
+                    int sg_count  = sg.get_group_linear_range();
+                    scalar_t const* tile = Aarray[ k ];
+
+                    // Each sub-group sums columns sg_id, sg_id + sg_count, ....
+                    for (int64_t j = sg_id; j < n; j += sg_count) {
+                        scalar_t const* col = &tile[ j*lda ];
+                        real_t sum = 0;
+                        for (int64_t i = lane; i < m; i += sg_size)
+                            sum += abs_val( col[ i ] );
+                        sum = sycl::reduce_over_group( sg, sum, sycl::plus<real_t>() );
+                        if (lane == 0)
+                            values[ k*ldv + j ] = sum;
+                    }
+                } );
+            }
+        }
+        //---------
+        // inf norm
+        else if (norm == lapack::Norm::Inf) {
+            if (m == 0 || n == 0) {
+                blas::device_memset( values, 0, batch_count * m, queue );
+            }
+            else {
+                assert( ldv >= m );
+                stream.parallel_for( range, [=]( sycl::nd_item<1> item ) {
+                    int64_t k = item.get_group_linear_id();
+                    int tid = item.get_local_linear_id();
+                    scalar_t const* tile = Aarray[ k ];
+
+                    // Each work-item sums one row.
+                    // This does coalesced reads of one column at a time.
+                    for (int64_t i = tid; i < m; i += nb) {
+                        scalar_t const* row = &tile[ i ];
+                        real_t sum = 0;
+                        for (int64_t j = 0; j < n; ++j)
+                            sum += abs_val( row[ j*lda ] );
+                        values[ k*ldv + i ] = sum;
+                    }
+                } );
+            }
+        }
+        //---------
+        // Frobenius norm
+        else if (norm == lapack::Norm::Fro) {
+            if (m == 0 || n == 0) {
+                blas::device_memset( values, 0, batch_count * 2, queue );
+            }
+            else {
+                assert( ldv == 2 );
+                stream.submit( [&]( sycl::handler& cgh ) {
+                    sycl::local_accessor<real_t, 1> partial( 2*max_sub_groups, cgh );
+                    cgh.parallel_for( range, [=]( sycl::nd_item<1> item ) {
+                        int64_t k = item.get_group_linear_id();
+                        int tid = item.get_local_linear_id();
+                        scalar_t const* tile = Aarray[ k ];
+
+                        // Each work-item finds sum-of-squares of its rows.
+                        real_t scale = 0;
+                        real_t sumsq = 1;
+                        for (int64_t i = tid; i < m; i += nb) {
+                            scalar_t const* row = &tile[ i ];
+                            for (int64_t j = 0; j < n; ++j)
+                                add_sumsq( scale, sumsq, abs_val( row[ j*lda ] ) );
+                        }
+                        group_combine_sumsq( item, scale, sumsq, partial );
+                        if (tid == 0) {
+                            values[ k*2 + 0 ] = scale;
+                            values[ k*2 + 1 ] = sumsq;
+                        }
+                    } );
+                } );
+            }
+        }
+    }
+    else if (scope == NormScope::Columns) {
+
+        if (norm == Norm::Max) {
+            if (m == 0 || n == 0) {
+                blas::device_memset( values, 0, batch_count * n, queue );
+            }
+            else {
+                assert( ldv >= n );
+                stream.parallel_for( range, [=]( sycl::nd_item<1> item ) {
+                    int64_t k = item.get_group_linear_id();
+                    sycl::sub_group sg = item.get_sub_group();
+                    int lane      = sg.get_local_linear_id();
+                    int sg_size   = sg.get_local_linear_range();
+                    int sg_id     = sg.get_group_linear_id();
+                    int sg_count  = sg.get_group_linear_range();
+                    scalar_t const* tile = Aarray[ k ];
+
+                    // Each sub-group finds max of columns sg_id, sg_id + sg_count, ....
+                    for (int64_t j = sg_id; j < n; j += sg_count) {
+                        scalar_t const* col = &tile[ j*lda ];
+                        real_t max = 0;
+                        for (int64_t i = lane; i < m; i += sg_size)
+                            max = max_nan( max, abs_val( col[ i ] ) );
+                        max = sub_group_max_nan( sg, max );
+                        if (lane == 0)
+                            values[ k*ldv + j ] = max;
+                    }
+                } );
+            }
+        }
+        else {
+            slate_not_implemented( "The norm isn't yet supported" );
+        }
+    }
+    else {
+        slate_not_implemented( "The norm scope isn't yet supported." );
+    }
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void genorm(
+    lapack::Norm norm, NormScope scope,
+    int64_t m, int64_t n,
+    float const* const* Aarray, int64_t lda,
+    float* values, int64_t ldv, int64_t batch_count,
+    blas::Queue &queue);
+
+template
+void genorm(
+    lapack::Norm norm, NormScope scope,
+    int64_t m, int64_t n,
+    double const* const* Aarray, int64_t lda,
+    double* values, int64_t ldv, int64_t batch_count,
+    blas::Queue &queue);
+
+template
+void genorm(
+    lapack::Norm norm, NormScope scope,
+    int64_t m, int64_t n,
+    std::complex<float> const* const* Aarray, int64_t lda,
+    float* values, int64_t ldv, int64_t batch_count,
+    blas::Queue &queue);
+
+template
+void genorm(
+    lapack::Norm norm, NormScope scope,
+    int64_t m, int64_t n,
+    std::complex<double> const* const* Aarray, int64_t lda,
+    double* values, int64_t ldv, int64_t batch_count,
+    blas::Queue &queue);
+
+} // namespace device
+} // namespace slate
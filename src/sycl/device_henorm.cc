@@ -0,0 +1,221 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/Exception.hh"
+#include "slate/internal/device.hh"
+
+#include "device_util.hh"
+
+#include <cassert>
+#include <complex>
+
+namespace slate {
+namespace device {
+
+using namespace sycl_util;
+
+//------------------------------------------------------------------------------
+/// Batched routine that computes a norm of each Hermitian tile in Aarray,
+/// with only the uplo triangle accessed and the diagonal assumed real,
+/// using one work-group of nb work-items per tile.
+/// Each work-item handles rows tid, tid + nb, ...; Norm::Max and Norm::Fro
+/// then reduce over sub-groups with shuffles, and across sub-groups in
+/// shared local memory.
+///
+/// @param[in] norm
+///     Norm to compute.
+///
+/// @param[in] uplo
+///     Whether each Aarray[k] is stored in the upper or lower triangle.
+///
+/// @param[in] n
+///     Number of rows and columns of each tile. n >= 0.
+///
+/// @param[in] Aarray
+///     Array in GPU memory of dimension batch_count, containing pointers to tiles,
+///     where each Aarray[k] is an n-by-n matrix stored in an lda-by-n array in GPU memory.
+///
+/// @param[in] lda
+///     Leading dimension of each tile. lda >= n.
+///
+/// @param[out] values
+///     Array in GPU memory, dimension batch_count * ldv.
+///     - Norm::Max: ldv = 1.
+///     - Norm::One, Norm::Inf: ldv >= n; values[k*ldv + j] is the sum of
+///       column j, which equals the sum of row j.
+///     - Norm::Fro: ldv = 2; values[k*2 + 0] = scale_k,
+///       values[k*2 + 1] = sumsq_k.
+///
+/// @param[in] ldv
+///     Leading dimension of values array.
+///
+/// @param[in] batch_count
+///     Size of Aarray. batch_count >= 0.
+///
+/// @param[in] queue
+///     BLAS++ queue to execute in.
+///
+template <typename scalar_t>
+void henorm(
+    lapack::Norm norm, lapack::Uplo uplo,
+    int64_t n,
+    scalar_t const* const* Aarray, int64_t lda,
+    blas::real_type<scalar_t>* values, int64_t ldv, int64_t batch_count,
+    blas::Queue &queue)
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // quick return
+    if (batch_count == 0)
+        return;
+
+    sycl::queue& stream = queue.stream();
+    sycl::nd_range<1> range( batch_count * nb, nb );
+    bool lower = (uplo == lapack::Uplo::Lower);
+
+    //---------
+    // max norm
+    if (norm == lapack::Norm::Max) {
+        if (n == 0) {
+            blas::device_memset( values, 0, batch_count, queue );
+        }
+        else {
+            assert( ldv == 1 );
+            stream.submit( [&]( sycl::handler& cgh ) {
+                sycl::local_accessor<real_t, 1> partial( max_sub_groups, cgh );
+                cgh.parallel_for( range, [=]( sycl::nd_item<1> item ) {
+                    int64_t k = item.get_group_linear_id();
+                    int tid = item.get_local_linear_id();
+                    scalar_t const* tile = Aarray[ k ];
+
+                    real_t max = 0;
+                    for (int64_t i = tid; i < n; i += nb) {
+                        scalar_t const* row = &tile[ i ];
+                        int64_t jbegin = lower ? 0 : i+1;
+                        int64_t jend   = lower ? i : n;
+                        for (int64_t j = jbegin; j < jend; ++j)  // off-diag
+                            max = max_nan( max, abs_val( row[ j*lda ] ) );
+                        max = max_nan( max, abs_val( std::real( row[ i*lda ] ) ) );
+                    }
+                    max = group_max_nan( item, max, partial );
+                    if (tid == 0)
+                        values[ k ] = max;
+                } );
+            } );
+        }
+    }
+    //---------
+    // one norm or inf norm (same values)
+    else if (norm == lapack::Norm::One || norm == lapack::Norm::Inf) {
+        if (n == 0) {
+            blas::device_memset( values, 0, batch_count * n, queue );
+        }
+        else {
+            assert( ldv >= n );
+            stream.parallel_for( range, [=]( sycl::nd_item<1> item ) {
+                int64_t k = item.get_group_linear_id();
+                int tid = item.get_local_linear_id();
+                scalar_t const* tile = Aarray[ k ];
+
+                for (int64_t idx = tid; idx < n; idx += nb) {
+                    // Sum of row idx and corresponding column idx
+                    // in the stored triangle.
+                    scalar_t const* row    = &tile[ idx ];
+                    scalar_t const* column = &tile[ lda*idx ];
+                    real_t sum = abs_val( std::real( row[ idx*lda ] ) );  // diag
+                    if (lower) {
+                        for (int64_t j = 0; j < idx; ++j)       // strictly lower row
+                            sum += abs_val( row[ j*lda ] );
+                        for (int64_t i = idx+1; i < n; ++i)     // strictly lower col
+                            sum += abs_val( column[ i ] );
+                    }
+                    else {
+                        for (int64_t j = idx+1; j < n; ++j)     // strictly upper row
+                            sum += abs_val( row[ j*lda ] );
+                        for (int64_t i = 0; i < idx; ++i)       // strictly upper col
+                            sum += abs_val( column[ i ] );
+                    }
+                    values[ k*ldv + idx ] = sum;
+                }
+            } );
+        }
+    }
+    //---------
+    // Frobenius norm
+    else if (norm == lapack::Norm::Fro) {
+        if (n == 0) {
+            blas::device_memset( values, 0, batch_count * 2, queue );
+        }
+        else {
+            assert( ldv == 2 );
+            stream.submit( [&]( sycl::handler& cgh ) {
+                sycl::local_accessor<real_t, 1> partial( 2*max_sub_groups, cgh );
+                cgh.parallel_for( range, [=]( sycl::nd_item<1> item ) {
+                    int64_t k = item.get_group_linear_id();
+                    int tid = item.get_local_linear_id();
+                    scalar_t const* tile = Aarray[ k ];
+
+                    real_t scale = 0;
+                    real_t sumsq = 1;
+                    for (int64_t i = tid; i < n; i += nb) {
+                        scalar_t const* row = &tile[ i ];
+                        int64_t jbegin = lower ? 0 : i+1;
+                        int64_t jend   = lower ? i : n;
+                        real_t scale_i = 0;
+                        real_t sumsq_i = 1;
+                        for (int64_t j = jbegin; j < jend; ++j)  // off-diag
+                            add_sumsq( scale_i, sumsq_i, abs_val( row[ j*lda ] ) );
+                        sumsq_i *= 2;  // double for symmetric entries
+                        add_sumsq( scale_i, sumsq_i,
+                                   abs_val( std::real( row[ i*lda ] ) ) );
+                        combine_sumsq( scale, sumsq, scale_i, sumsq_i );
+                    }
+                    group_combine_sumsq( item, scale, sumsq, partial );
+                    if (tid == 0) {
+                        values[ k*2 + 0 ] = scale;
+                        values[ k*2 + 1 ] = sumsq;
+                    }
+                } );
+            } );
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void henorm(
+    lapack::Norm norm, lapack::Uplo uplo,
+    int64_t n,
+    float const* const* Aarray, int64_t lda,
+    float* values, int64_t ldv, int64_t batch_count,
+    blas::Queue &queue);
+
+template
+void henorm(
+    lapack::Norm norm, lapack::Uplo uplo,
+    int64_t n,
+    double const* const* Aarray, int64_t lda,
+    double* values, int64_t ldv, int64_t batch_count,
+    blas::Queue &queue);
+
+template
+void henorm(
+    lapack::Norm norm, lapack::Uplo uplo,
+    int64_t n,
+    std::complex<float> const* const* Aarray, int64_t lda,
+    float* values, int64_t ldv, int64_t batch_count,
+    blas::Queue &queue);
+
+template
+void henorm(
+    lapack::Norm norm, lapack::Uplo uplo,
+    int64_t n,
+    std::complex<double> const* const* Aarray, int64_t lda,
+    double* values, int64_t ldv, int64_t batch_count,
+    blas::Queue &queue);
+
+} // namespace device
+} // namespace slate
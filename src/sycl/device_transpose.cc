@@ -0,0 +1,411 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/Exception.hh"
+#include "slate/internal/device.hh"
+
+#include "device_util.hh"
+
+#include <cassert>
+#include <complex>
+
+namespace slate {
+namespace device {
+
+using namespace sycl_util;
+
+/// Block size for in-place square transpose; work-groups are ib-by-ib.
+const int ib = 16;
+
+/// Rows of work-items in out-of-place transpose work-groups, which are
+/// nx-by-ty and loop over the nx columns of an nx-by-nx block.
+const int ty = 8;
+
+//------------------------------------------------------------------------------
+/// @return block size for out-of-place transpose: 32 for up to 8-byte types,
+/// 16 for complex<double>, to keep the block in shared local memory small.
+template <typename scalar_t>
+constexpr int transpose_nx()
+{
+    return sizeof( scalar_t ) > 8 ? 16 : 32;
+}
+
+//------------------------------------------------------------------------------
+/// In-place transpose of n-by-n tiles get_tile( k ), for k < batch_count.
+/// Each ib-by-ib work-group swaps block (bi, bj) with block (bj, bi),
+/// bj <= bi, through two blocks in shared local memory, padded by one
+/// column to avoid bank conflicts; work-groups above the diagonal exit.
+/// Reads and writes are coalesced along columns.
+///
+template <typename scalar_t, typename tile_func_t>
+void transpose_sqr(
+    bool is_conj,
+    int64_t n,
+    tile_func_t get_tile, int64_t lda,
+    int64_t batch_count, blas::Queue& queue)
+{
+    int64_t nt = (n + ib - 1) / ib;
+    sycl::nd_range<3> range( sycl::range<3>( batch_count, nt*ib, nt*ib ),
+                             sycl::range<3>( 1, ib, ib ) );
+
+    queue.stream().submit( [&]( sycl::handler& cgh ) {
+        sycl::local_accessor<scalar_t, 2> sA1( sycl::range<2>( ib, ib+1 ), cgh );
+        sycl::local_accessor<scalar_t, 2> sA2( sycl::range<2>( ib, ib+1 ), cgh );
+        cgh.parallel_for( range, [=]( sycl::nd_item<3> item ) {
+            int64_t bi = item.get_group( 2 );
+            int64_t bj = item.get_group( 1 );
+            if (bj > bi)
+                return;  // whole work-group, before any barrier
+
+            int ii = item.get_local_id( 2 );
+            int jj = item.get_local_id( 1 );
+            scalar_t* A = get_tile( item.get_group( 0 ) );
+
+            // (i1, j1) in block (bi, bj); (i2, j2) in block (bj, bi).
+            int64_t i1 = bi*ib + ii, j1 = bj*ib + jj;
+            int64_t i2 = bj*ib + ii, j2 = bi*ib + jj;
+            bool in1 = i1 < n && j1 < n;
+            bool in2 = i2 < n && j2 < n;
+
+            // sA1(jj, ii) = A(i1, j1), sA2(jj, ii) = A(i2, j2).
+            if (in1)
+                sA1[ jj ][ ii ] = A[ i1 + j1*lda ];
+            if (in2)
+                sA2[ jj ][ ii ] = A[ i2 + j2*lda ];
+            sycl::group_barrier( item.get_group() );
+
+            // A(i1, j1) = A(j1, i1) = sA2(ii, jj), and vice versa.
+            if (in1)
+                A[ i1 + j1*lda ] = is_conj ? conj_val( sA2[ ii ][ jj ] )
+                                           : sA2[ ii ][ jj ];
+            if (in2)
+                A[ i2 + j2*lda ] = is_conj ? conj_val( sA1[ ii ][ jj ] )
+                                           : sA1[ ii ][ jj ];
+        } );
+    } );
+}
+
+//------------------------------------------------------------------------------
+/// Out-of-place transpose, dAT = op( dA ), of m-by-n tiles
+/// get_tile( k ), get_tileT( k ), for k < batch_count.
+/// Each nx-by-ty work-group loads an nx-by-nx block of dA into shared local
+/// memory, padded by one column, then writes it to dAT. Both reads and
+/// writes are coalesced.
+///
+template <typename scalar_t, typename tile_func_t, typename tileT_func_t>
+void transpose_rect(
+    bool is_conj,
+    int64_t m, int64_t n,
+    tile_func_t  get_tile,  int64_t lda,
+    tileT_func_t get_tileT, int64_t ldat,
+    int64_t batch_count, blas::Queue& queue)
+{
+    const int nx = transpose_nx<scalar_t>();
+    int64_t mt = (m + nx - 1) / nx;
+    int64_t nt = (n + nx - 1) / nx;
+    sycl::nd_range<3> range( sycl::range<3>( batch_count, nt*ty, mt*nx ),
+                             sycl::range<3>( 1, ty, nx ) );
+
+    queue.stream().submit( [&]( sycl::handler& cgh ) {
+        sycl::local_accessor<scalar_t, 2> sA( sycl::range<2>( nx, nx+1 ), cgh );
+        cgh.parallel_for( range, [=]( sycl::nd_item<3> item ) {
+            int64_t bi = item.get_group( 2 );
+            int64_t bj = item.get_group( 1 );
+            int ii  = item.get_local_id( 2 );
+            int jj0 = item.get_local_id( 1 );
+            int64_t k = item.get_group( 0 );
+            scalar_t const* dA  = get_tile( k );
+            scalar_t*       dAT = get_tileT( k );
+
+            // sA(jj, ii) = dA(i, j).
+            for (int jj = jj0; jj < nx; jj += ty) {
+                int64_t i = bi*nx + ii;
+                int64_t j = bj*nx + jj;
+                if (i < m && j < n)
+                    sA[ jj ][ ii ] = dA[ i + j*lda ];
+            }
+            sycl::group_barrier( item.get_group() );
+
+            // dAT(j, i) = dA(i, j) = sA(ii, jj), with j = bj*nx + ii.
+            for (int jj = jj0; jj < nx; jj += ty) {
+                int64_t j = bj*nx + ii;
+                int64_t i = bi*nx + jj;
+                if (i < m && j < n)
+                    dAT[ j + i*ldat ] = is_conj ? conj_val( sA[ ii ][ jj ] )
+                                                : sA[ ii ][ jj ];
+            }
+        } );
+    } );
+}
+
+//------------------------------------------------------------------------------
+/// In-place transpose of a square n-by-n matrix A in GPU memory.
+///
+/// @param[in] is_conj
+///     Whether to conjugate-transpose.
+///
+/// @param[in] n
+///     Number of rows and columns of A. n >= 0.
+///
+/// @param[in,out] A
+///     n-by-n matrix stored in an lda-by-n array in GPU memory.
+///
+/// @param[in] lda
+///     Leading dimension of A. lda >= n.
+///
+/// @param[in] queue
+///     BLAS++ queue to execute in.
+///
+template <typename scalar_t>
+void transpose(
+    bool is_conj,
+    int64_t n,
+    scalar_t* A, int64_t lda,
+    blas::Queue& queue)
+{
+    if (n <= 1)
+        return;
+    assert( lda >= n );
+
+    transpose_sqr<scalar_t>(
+        is_conj, n, [=]( int64_t ) { return A; }, lda, 1, queue );
+}
+
+//------------------------------------------------------------------------------
+/// In-place transpose of a batch of square n-by-n matrices Aarray[k].
+///
+template <typename scalar_t>
+void transpose_batch(
+    bool is_conj,
+    int64_t n,
+    scalar_t** Aarray, int64_t lda,
+    int64_t batch_count,
+    blas::Queue& queue)
+{
+    if (batch_count <= 0 || n <= 1)
+        return;
+    assert( lda >= n );
+
+    transpose_sqr<scalar_t>(
+        is_conj, n, [=]( int64_t k ) { return Aarray[ k ]; }, lda,
+        batch_count, queue );
+}
+
+//------------------------------------------------------------------------------
+/// Out-of-place transpose of an m-by-n matrix dA into an n-by-m matrix dAT,
+/// both in GPU memory.
+///
+/// @param[in] is_conj
+///     Whether to conjugate-transpose.
+///
+/// @param[in] m
+///     Number of rows of dA. m >= 0.
+///
+/// @param[in] n
+///     Number of columns of dA. n >= 0.
+///
+/// @param[in] dA
+///     m-by-n matrix stored in an lda-by-n array in GPU memory.
+///
+/// @param[in] lda
+///     Leading dimension of dA. lda >= m.
+///
+/// @param[out] dAT
+///     n-by-m matrix stored in an ldat-by-m array in GPU memory.
+///
+/// @param[in] ldat
+///     Leading dimension of dAT. ldat >= n.
+///
+/// @param[in] queue
+///     BLAS++ queue to execute in.
+///
+template <typename scalar_t>
+void transpose(
+    bool is_conj,
+    int64_t m, int64_t n,
+    scalar_t* dA,  int64_t lda,
+    scalar_t* dAT, int64_t ldat,
+    blas::Queue& queue)
+{
+    if (m <= 0 || n <= 0)
+        return;
+    assert( lda >= m );
+    assert( ldat >= n );
+
+    transpose_rect<scalar_t>(
+        is_conj, m, n,
+        [=]( int64_t ) { return dA;  }, lda,
+        [=]( int64_t ) { return dAT; }, ldat,
+        1, queue );
+}
+
+//------------------------------------------------------------------------------
+/// Out-of-place transpose of a batch of m-by-n matrices dA_array[k]
+/// into n-by-m matrices dAT_array[k].
+///
+template <typename scalar_t>
+void transpose_batch(
+    bool is_conj,
+    int64_t m, int64_t n,
+    scalar_t** dA_array,  int64_t lda,
+    scalar_t** dAT_array, int64_t ldat,
+    int64_t batch_count,
+    blas::Queue& queue)
+{
+    if (batch_count <= 0 || m <= 0 || n <= 0)
+        return;
+    assert( lda >= m );
+    assert( ldat >= n );
+
+    transpose_rect<scalar_t>(
+        is_conj, m, n,
+        [=]( int64_t k ) { return dA_array[ k ];  }, lda,
+        [=]( int64_t k ) { return dAT_array[ k ]; }, ldat,
+        batch_count, queue );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+// Square matrix
+
+template
+void transpose(
+    bool is_conj,
+    int64_t n,
+    float* A, int64_t lda,
+    blas::Queue& queue);
+
+template
+void transpose(
+    bool is_conj,
+    int64_t n,
+    double* A, int64_t lda,
+    blas::Queue& queue);
+
+template
+void transpose(
+    bool is_conj,
+    int64_t n,
+    std::complex<float>* A, int64_t lda,
+    blas::Queue& queue);
+
+template
+void transpose(
+    bool is_conj,
+    int64_t n,
+    std::complex<double>* A, int64_t lda,
+    blas::Queue& queue);
+
+// ----------------------------------------
+// Batch of square matrices
+
+template
+void transpose_batch(
+    bool is_conj,
+    int64_t n,
+    float** Aarray, int64_t lda,
+    int64_t batch_count,
+    blas::Queue& queue);
+
+template
+void transpose_batch(
+    bool is_conj,
+    int64_t n,
+    double** Aarray, int64_t lda,
+    int64_t batch_count,
+    blas::Queue& queue);
+
+template
+void transpose_batch(
+    bool is_conj,
+    int64_t n,
+    std::complex<float>** Aarray, int64_t lda,
+    int64_t batch_count,
+    blas::Queue& queue);
+
+template
+void transpose_batch(
+    bool is_conj,
+    int64_t n,
+    std::complex<double>** Aarray, int64_t lda,
+    int64_t batch_count,
+    blas::Queue& queue);
+
+// ----------------------------------------
+// Rectangular matrix
+
+template
+void transpose(
+    bool is_conj,
+    int64_t m, int64_t n,
+    float* dA,  int64_t lda,
+    float* dAT, int64_t ldat,
+    blas::Queue& queue);
+
+template
+void transpose(
+    bool is_conj,
+    int64_t m, int64_t n,
+    double* dA,  int64_t lda,
+    double* dAT, int64_t ldat,
+    blas::Queue& queue);
+
+template
+void transpose(
+    bool is_conj,
+    int64_t m, int64_t n,
+    std::complex<float>* dA,  int64_t lda,
+    std::complex<float>* dAT, int64_t ldat,
+    blas::Queue& queue);
+
+template
+void transpose(
+    bool is_conj,
+    int64_t m, int64_t n,
+    std::complex<double>* dA,  int64_t lda,
+    std::complex<double>* dAT, int64_t ldat,
+    blas::Queue& queue);
+
+// ----------------------------------------
+// Batch of rectangular matrices
+
+template
+void transpose_batch(
+    bool is_conj,
+    int64_t m, int64_t n,
+    float** dA_array,  int64_t lda,
+    float** dAT_array, int64_t ldat,
+    int64_t batch_count,
+    blas::Queue& queue);
+
+template
+void transpose_batch(
+    bool is_conj,
+    int64_t m, int64_t n,
+    double** dA_array,  int64_t lda,
+    double** dAT_array, int64_t ldat,
+    int64_t batch_count,
+    blas::Queue& queue);
+
+template
+void transpose_batch(
+    bool is_conj,
+    int64_t m, int64_t n,
+    std::complex<float>** dA_array,  int64_t lda,
+    std::complex<float>** dAT_array, int64_t ldat,
+    int64_t batch_count,
+    blas::Queue& queue);
+
+template
+void transpose_batch(
+    bool is_conj,
+    int64_t m, int64_t n,
+    std::complex<double>** dA_array,  int64_t lda,
+    std::complex<double>** dAT_array, int64_t ldat,
+    int64_t batch_count,
+    blas::Queue& queue);
+
+} // namespace device
+} // namespace slate
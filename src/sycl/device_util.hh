@@ -0,0 +1,214 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef SLATE_SYCL_UTIL_HH
+#define SLATE_SYCL_UTIL_HH
+
+#include "blas.hh"
+
+#if __has_include( <sycl/sycl.hpp> )
+    #include <sycl/sycl.hpp>
+#else
+    #include <CL/sycl.hpp>
+#endif
+
+#include <complex>
+
+namespace slate {
+namespace device {
+
+// Helpers are in their own namespace, as the omptarget kernels, which are
+// linked into the same library, define functions with the same names.
+namespace sycl_util {
+
+/// Work-group size of the reduction kernels. It must be a multiple of
+/// the sub-group size, which is 8, 16, or 32 on Intel GPUs, so that all
+/// sub-groups are full.
+const int nb = 256;
+
+/// Maximum number of sub-groups in a work-group of nb work-items.
+const int max_sub_groups = nb / 8;
+
+//------------------------------------------------------------------------------
+/// max that propagates nan consistently:
+///     max_nan( 1,   nan ) = nan
+///     max_nan( nan, 1   ) = nan
+template <typename real_t>
+inline real_t max_nan( real_t x, real_t y )
+{
+    return (sycl::isnan( y ) || y >= x ? y : x);
+}
+
+//------------------------------------------------------------------------------
+/// Square of number.
+/// @return x^2
+template <typename scalar_t>
+inline scalar_t sqr( scalar_t x )
+{
+    return x*x;
+}
+
+//------------------------------------------------------------------------------
+/// Adds two scaled, sum-of-squares representations.
+/// On exit, scale1 and sumsq1 are updated such that:
+///     scale1^2 sumsq1 := scale1^2 sumsq1 + scale2^2 sumsq2.
+template <typename real_t>
+inline void combine_sumsq(
+    real_t& scale1, real_t& sumsq1,
+    real_t  scale2, real_t  sumsq2 )
+{
+    if (scale1 > scale2) {
+        sumsq1 = sumsq1 + sumsq2*sqr( scale2 / scale1 );
+        // scale1 stays same
+    }
+    else if (scale2 != 0) {
+        sumsq1 = sumsq1*sqr( scale1 / scale2 ) + sumsq2;
+        scale1 = scale2;
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Adds new value to scaled, sum-of-squares representation.
+/// On exit, scale and sumsq are updated such that:
+///     scale^2 sumsq := scale^2 sumsq + (absx)^2
+template <typename real_t>
+inline void add_sumsq(
+    real_t& scale, real_t& sumsq,
+    real_t absx )
+{
+    if (scale < absx) {
+        sumsq = 1 + sumsq * sqr( scale / absx );
+        scale = absx;
+    }
+    else if (scale != 0) {
+        sumsq = sumsq + sqr( absx / scale );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Absolute value on device.
+inline float abs_val( float x )
+{
+    return sycl::fabs( x );
+}
+
+inline double abs_val( double x )
+{
+    return sycl::fabs( x );
+}
+
+/// Complex absolute value, scaled per LAPACK to avoid overflow,
+/// and propagating nan.
+template <typename real_t>
+inline real_t abs_val( std::complex<real_t> x )
+{
+    real_t a = x.real();
+    real_t b = x.imag();
+    if (sycl::isnan( a ))
+        return a;
+    if (sycl::isnan( b ))
+        return b;
+    a = sycl::fabs( a );
+    b = sycl::fabs( b );
+    real_t w = sycl::fmax( a, b );
+    real_t z = sycl::fmin( a, b );
+    if (z == 0)
+        return w;
+    real_t t = z / w;
+    return w * sycl::sqrt( 1 + t*t );
+}
+
+//------------------------------------------------------------------------------
+/// Conjugate on device; identity for real types.
+template <typename real_t>
+inline real_t conj_val( real_t x )
+{
+    return x;
+}
+
+template <typename real_t>
+inline std::complex<real_t> conj_val( std::complex<real_t> x )
+{
+    return std::complex<real_t>( x.real(), -x.imag() );
+}
+
+//------------------------------------------------------------------------------
+/// @return max_nan of x over the sub-group, in all work-items,
+/// using butterfly shuffles in registers.
+template <typename real_t>
+inline real_t sub_group_max_nan( sycl::sub_group sg, real_t x )
+{
+    for (int mask = sg.get_local_linear_range() / 2; mask > 0; mask /= 2)
+        x = max_nan( x, sycl::permute_group_by_xor( sg, x, mask ) );
+    return x;
+}
+
+//------------------------------------------------------------------------------
+/// Sub-group sum-of-squares reduction, combining (scale, sumsq) of all
+/// work-items in the sub-group, with the result in all work-items.
+template <typename real_t>
+inline void sub_group_combine_sumsq(
+    sycl::sub_group sg, real_t& scale, real_t& sumsq )
+{
+    for (int mask = sg.get_local_linear_range() / 2; mask > 0; mask /= 2) {
+        real_t scale2 = sycl::permute_group_by_xor( sg, scale, mask );
+        real_t sumsq2 = sycl::permute_group_by_xor( sg, sumsq, mask );
+        combine_sumsq( scale, sumsq, scale2, sumsq2 );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// @return max_nan of x over the work-group, valid in work-item 0.
+/// Each sub-group reduces in registers, then work-item 0 reduces the
+/// sub-group results from shared local memory, which needs
+/// max_sub_groups entries.
+template <typename real_t, typename local_t>
+inline real_t group_max_nan(
+    sycl::nd_item<1> item, real_t x, local_t const& partial )
+{
+    sycl::sub_group sg = item.get_sub_group();
+    x = sub_group_max_nan( sg, x );
+    if (sg.get_local_linear_id() == 0)
+        partial[ sg.get_group_linear_id() ] = x;
+    sycl::group_barrier( item.get_group() );
+
+    if (item.get_local_linear_id() == 0) {
+        int num_sub_groups = sg.get_group_linear_range();
+        for (int s = 1; s < num_sub_groups; ++s)
+            x = max_nan( x, partial[ s ] );
+    }
+    return x;
+}
+
+//------------------------------------------------------------------------------
+/// Work-group sum-of-squares reduction, valid in work-item 0, as in
+/// group_max_nan. Shared local memory needs 2*max_sub_groups entries.
+template <typename real_t, typename local_t>
+inline void group_combine_sumsq(
+    sycl::nd_item<1> item, real_t& scale, real_t& sumsq,
+    local_t const& partial )
+{
+    sycl::sub_group sg = item.get_sub_group();
+    sub_group_combine_sumsq( sg, scale, sumsq );
+    if (sg.get_local_linear_id() == 0) {
+        int s = sg.get_group_linear_id();
+        partial[ 2*s + 0 ] = scale;
+        partial[ 2*s + 1 ] = sumsq;
+    }
+    sycl::group_barrier( item.get_group() );
+
+    if (item.get_local_linear_id() == 0) {
+        int num_sub_groups = sg.get_group_linear_range();
+        for (int s = 1; s < num_sub_groups; ++s)
+            combine_sumsq( scale, sumsq, partial[ 2*s + 0 ], partial[ 2*s + 1 ] );
+    }
+}
+
+} // namespace sycl_util
+
+} // namespace device
+} // namespace slate
+
+#endif // SLATE_SYCL_UTIL_HH
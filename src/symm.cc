@@ -51,6 +51,9 @@ void symm(
     const scalar_t one = 1.0;
     // Assumes column major
     const Layout layout = Layout::ColMajor;
+    // Diagonal tiles of A run on devices or on the host.
+    const Target target_diag = (target == Target::Devices ? Target::Devices
+                                                           : Target::HostTask);
 
     // if on right, change to left by transposing A, B, C to get
     // op(C) = op(A)*op(B)
@@ -66,7 +69,7 @@ void symm(
     assert( B.mt() == C.mt() );
     assert( B.nt() == C.nt() );
 
-    int64_t lookahead = get_option<int64_t>( opts, Option::Lookahead, 1 );
+    int64_t lookahead = get_lookahead( opts );
 
     // OpenMP needs pointer types, but vectors are exception safe
     std::vector<uint8_t> bcast_vector( A.nt() );
@@ -81,6 +84,34 @@ void symm(
         C.reserveDeviceWorkspace();
     }
 
+    // Broadcasts block col k of A to ranks owning block rows C(i, :),
+    // and block row k of B to ranks owning block cols C(:, j).
+    // Only the stored triangle is sent: A(i, k) for i >= k if lower,
+    // else A(k, i), and the transposed half from the other side of the
+    // diagonal, so each step sends exactly one list per matrix.
+    auto bcast_AB = [&]( int64_t k ) {
+        bool lower = (A.uplo() == Uplo::Lower);
+        BcastListTag bcast_list_A;
+        for (int64_t i = 0; i < A.mt(); ++i) {
+            if (lower == (i >= k)) {
+                bcast_list_A.push_back(
+                    {i, k, {C.sub( i, i, 0, C.nt()-1 )}, i} );
+            }
+            else {
+                bcast_list_A.push_back(
+                    {k, i, {C.sub( i, i, 0, C.nt()-1 )}, i} );
+            }
+        }
+        A.template listBcastMT<target>( bcast_list_A, layout );
+
+        BcastListTag bcast_list_B;
+        for (int64_t j = 0; j < B.nt(); ++j) {
+            bcast_list_B.push_back(
+                {k, j, {C.sub( 0, C.mt()-1, j, j )}, j} );
+        }
+        B.template listBcastMT<target>( bcast_list_B, layout );
+    };
+
     // set min number for omp nested active parallel regions
     slate::OmpSetMaxActiveLevels set_active_levels( MinOmpActiveLevels );
 
@@ -94,19 +125,7 @@ void symm(
             // send 1st block col of A and block row of B
             #pragma omp task depend(out:bcast[0])
             {
-                // broadcast A(i, 0) to ranks owning block row C(i, :)
-                BcastListTag bcast_list_A;
-                for (int64_t i = 0; i < A.mt(); ++i)
-                    bcast_list_A.push_back(
-                        {i, 0, {C.sub( i, i, 0, C.nt()-1 )}, i} );
-                A.template listBcastMT<target>( bcast_list_A, layout );
-
-                // broadcast B(0, j) to ranks owning block col C(:, j)
-                BcastListTag bcast_list_B;
-                for (int64_t j = 0; j < B.nt(); ++j)
-                    bcast_list_B.push_back(
-                        {0, j, {C.sub( 0, C.mt()-1, j, j )}, j} );
-                B.template listBcastMT<target>( bcast_list_B, layout );
+                bcast_AB( 0 );
             }
 
             // send next lookahead block cols of A and block rows of B
@@ -114,26 +133,7 @@ void symm(
                 #pragma omp task depend(in:bcast[k-1]) \
                                  depend(out:bcast[k])
                 {
-                    // broadcast A(k, i) or A(i, k)
-                    // to ranks owning block row C(i, :)
-                    BcastListTag bcast_list_A;
-                    for (int64_t i = 0; i < k && i < A.mt(); ++i) {
-                        bcast_list_A.push_back(
-                            {k, i, {C.sub( i, i, 0, C.nt()-1 )}, i} );
-                    }
-                    for (int64_t i = k; i < A.mt(); ++i) {
-                        bcast_list_A.push_back(
-                            {i, k, {C.sub( i, i, 0, C.nt()-1 )}, i} );
-                    }
-                    A.template listBcastMT<target>( bcast_list_A, layout );
-
-                    // broadcast B(k, j) to ranks owning block col C(0:k, j)
-                    BcastListTag bcast_list_B;
-                    for (int64_t j = 0; j < B.nt(); ++j) {
-                        bcast_list_B.push_back(
-                            {k, j, {C.sub( 0, C.mt()-1, j, j )}, j} );
-                    }
-                    B.template listBcastMT<target>( bcast_list_B, layout );
+                    bcast_AB( k );
                 }
             }
 
@@ -144,7 +144,7 @@ void symm(
                              depend(out:gemm[0])
             {
                 auto Brow_0 = B.sub( 0, 0, 0, B.nt()-1 );
-                internal::symm<Target::HostTask>(
+                internal::symm<target_diag>(
                     Side::Left,
                     alpha, A.sub( 0, 0 ),
                            std::move( Brow_0 ),
@@ -192,30 +192,7 @@ void symm(
                                      depend(in:bcast[k+lookahead-1]) \
                                      depend(out:bcast[k+lookahead])
                     {
-                        // broadcast A(k+la, i) or A(i, k+la)
-                        // to ranks owning block row C(i, :)
-                        BcastListTag bcast_list_A;
-                        for (int64_t i = 0; i < k+lookahead; ++i) {
-                            bcast_list_A.push_back(
-                                {k+lookahead, i,
-                                    {C.sub( i, i, 0, C.nt()-1 )}, i} );
-                        }
-                        for (int64_t i = k+lookahead; i < A.mt(); ++i) {
-                            bcast_list_A.push_back(
-                                {i, k+lookahead,
-                                    {C.sub( i, i, 0, C.nt()-1 )}, i} );
-                        }
-                        A.template listBcastMT<target>( bcast_list_A, layout );
-
-                        // broadcast B(k+la, j) to ranks
-                        // owning block col C(0:k+la, j)
-                        BcastListTag bcast_list_B;
-                        for (int64_t j = 0; j < B.nt(); ++j) {
-                            bcast_list_B.push_back(
-                                {k+lookahead, j,
-                                    {C.sub( 0, C.mt()-1, j, j )}, j} );
-                        }
-                        B.template listBcastMT<target>( bcast_list_B, layout );
+                        bcast_AB( k+lookahead );
                     }
                 }
 
@@ -238,7 +215,7 @@ void symm(
                     Arow_k.releaseRemoteWorkspace();
                     Arow_k.releaseLocalWorkspace();
 
-                    internal::symm<Target::HostTask>(
+                    internal::symm<target_diag>(
                         Side::Left,
                         alpha,  A.sub( k, k ),
                                 std::move( Brow_k ),
@@ -285,19 +262,7 @@ void symm(
             // send 1st block col (row) of A and block row of B
             #pragma omp task depend(out:bcast[0])
             {
-                // broadcast A(i, 0) to ranks owning block row C(i, :)
-                BcastListTag bcast_list_A;
-                for (int64_t i = 0; i < A.mt(); ++i)
-                    bcast_list_A.push_back(
-                        {0, i, {C.sub( i, i, 0, C.nt()-1 )}, i} );
-                A.template listBcastMT<target>( bcast_list_A, layout );
-
-                // broadcast B(0, j) to ranks owning block col C(:, j)
-                BcastListTag bcast_list_B;
-                for (int64_t j = 0; j < B.nt(); ++j)
-                    bcast_list_B.push_back(
-                        {0, j, {C.sub( 0, C.mt()-1, j, j )}, j} );
-                B.template listBcastMT<target>( bcast_list_B, layout );
+                bcast_AB( 0 );
             }
 
             // send next lookahead block cols of A and block rows of B
@@ -305,26 +270,7 @@ void symm(
                 #pragma omp task depend(in:bcast[k-1]) \
                                  depend(out:bcast[k])
                 {
-                    // broadcast A(k, i) or A(i, k)
-                    // to ranks owning block row C(i, :)
-                    BcastListTag bcast_list_A;
-                    for (int64_t i = 0; i < k && i < A.mt(); ++i) {
-                        bcast_list_A.push_back(
-                            {i, k, {C.sub( i, i, 0, C.nt()-1 )}, i} );
-                    }
-                    for (int64_t i = k; i < A.mt(); ++i) {
-                        bcast_list_A.push_back(
-                            {k, i, {C.sub( i, i, 0, C.nt()-1 )}, i} );
-                    }
-                    A.template listBcastMT<target>( bcast_list_A, layout );
-
-                    // broadcast B(k, j) to ranks owning block col C(0:k, j)
-                    BcastListTag bcast_list_B;
-                    for (int64_t j = 0; j < B.nt(); ++j) {
-                        bcast_list_B.push_back(
-                            {k, j, {C.sub( 0, C.mt()-1, j, j )}, j} );
-                    }
-                    B.template listBcastMT<target>( bcast_list_B, layout );
+                    bcast_AB( k );
                 }
             }
 
@@ -335,7 +281,7 @@ void symm(
                              depend(out:gemm[0])
             {
                 auto Brow_0 = B.sub( 0, 0, 0, B.nt()-1 );
-                internal::symm<Target::HostTask>(
+                internal::symm<target_diag>(
                     Side::Left,
                     alpha, A.sub( 0, 0 ),
                            std::move( Brow_0 ),
@@ -380,30 +326,7 @@ void symm(
                                      depend(in:bcast[k+lookahead-1]) \
                                      depend(out:bcast[k+lookahead])
                     {
-                        // broadcast A(k+la, i) or A(i, k+la)
-                        // to ranks owning block row C(i, :)
-                        BcastListTag bcast_list_A;
-                        for (int64_t i = 0; i < k+lookahead; ++i) {
-                            bcast_list_A.push_back(
-                                {i, k+lookahead,
-                                    {C.sub( i, i, 0, C.nt()-1 )}, i} );
-                        }
-                        for (int64_t i = k+lookahead; i < A.mt(); ++i) {
-                            bcast_list_A.push_back(
-                                {k+lookahead, i,
-                                    {C.sub( i, i, 0, C.nt()-1 )}, i} );
-                        }
-                        A.template listBcastMT<target>( bcast_list_A, layout );
-
-                        // broadcast B(k+la, j) to ranks
-                        // owning block col C(0:k+la, j)
-                        BcastListTag bcast_list_B;
-                        for (int64_t j = 0; j < B.nt(); ++j) {
-                            bcast_list_B.push_back(
-                                {k+lookahead, j,
-                                    {C.sub( 0, C.mt()-1, j, j )}, j} );
-                        }
-                        B.template listBcastMT<target>( bcast_list_B, layout );
+                        bcast_AB( k+lookahead );
                     }
                 }
 
@@ -426,7 +349,7 @@ void symm(
                     Acol_k.releaseRemoteWorkspace();
                     Acol_k.releaseLocalWorkspace();
 
-                    internal::symm<Target::HostTask>(
+                    internal::symm<target_diag>(
                         Side::Left,
                         alpha,  A.sub( k, k ),
                                 std::move( Brow_k ),
@@ -537,7 +460,7 @@ void symm(
     Options const& opts)
 {
     using internal::TargetType;
-    Target target = get_option( opts, Option::Target, Target::HostTask );
+    Target target = get_target( opts, Target::HostTask );
 
     switch (target) {
         case Target::Host:
@@ -551,6 +474,7 @@ void symm(
             impl::symm<Target::HostBatch>( side, alpha, A, B, beta, C, opts );
             break;
         case Target::Devices:
+        case Target::Hybrid:
             impl::symm<Target::Devices>( side, alpha, A, B, beta, C, opts );
             break;
     }
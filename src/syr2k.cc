@@ -40,7 +40,7 @@ void syr2k(
     const Layout layout = Layout::ColMajor;
 
     // Options
-    int64_t lookahead = get_option<int64_t>( opts, Option::Lookahead, 1 );
+    int64_t lookahead = get_lookahead( opts );
 
     // if upper, change to lower
     if (C.uplo() == Uplo::Upper)
@@ -244,7 +244,7 @@ void syr2k(scalar_t alpha, Matrix<scalar_t>& A,
            scalar_t beta,  SymmetricMatrix<scalar_t>& C,
            Options const& opts)
 {
-    Target target = get_option( opts, Option::Target, Target::HostTask );
+    Target target = get_target( opts, Target::HostTask );
 
     switch (target) {
         case Target::Host:
@@ -261,6 +261,7 @@ void syr2k(scalar_t alpha, Matrix<scalar_t>& A,
             break;
 
         case Target::Devices:
+        case Target::Hybrid:
             impl::syr2k<Target::Devices>( alpha, A, B, beta, C, opts );
             break;
     }
@@ -41,7 +41,7 @@ void syrk(
     const Layout layout = Layout::ColMajor;
 
     // Options
-    int64_t lookahead = get_option<int64_t>( opts, Option::Lookahead, 1 );
+    int64_t lookahead = get_lookahead( opts );
 
     // if upper, change to lower
     if (C.uplo() == Uplo::Upper)
@@ -216,7 +216,7 @@ void syrk(
     scalar_t beta,  SymmetricMatrix<scalar_t>& C,
     Options const& opts )
 {
-    Target target = get_option( opts, Option::Target, Target::HostTask );
+    Target target = get_target( opts, Target::HostTask );
 
     switch (target) {
         case Target::Host:
@@ -233,6 +233,7 @@ void syrk(
             break;
 
         case Target::Devices:
+        case Target::Hybrid:
             impl::syrk<Target::Devices>( alpha, A, beta, C, opts );
             break;
     }
@@ -10,7 +10,11 @@
 #include "slate/TriangularMatrix.hh"
 #include "internal/internal.hh"
 
+#include <algorithm>
 #include <atomic>
+#include <limits>
+#include <list>
+#include <set>
 
 namespace slate {
 
@@ -205,6 +209,586 @@ void tb2bd_run(
     }
 }
 
+//------------------------------------------------------------------------------
+/// @internal
+/// Copies the local tiles of the upper band of A to band storage, with room
+/// for the bulge: entry (i, j), for j - 2*band < i < j + band, is in
+/// AB[ 2*band + i + j*lda ], with lda >= 3*band - 2.
+/// AB has dimension (lda + 1)*n.
+///
+template <typename scalar_t>
+void tb2bd_get_band(
+    TriangularBandMatrix<scalar_t>& A,
+    std::vector<scalar_t>& AB, int64_t lda )
+{
+    int64_t n    = A.n();
+    int64_t nt   = A.nt();
+    int64_t band = A.bandwidth();
+    int64_t kdt  = ceildiv( band, A.tileNb( 0 ) );
+
+    AB.assign( (lda + 1)*n, scalar_t( 0 ) );
+    scalar_t* A00 = &AB[ 2*band ];
+    int64_t jj = 0;
+    for (int64_t j = 0; j < nt; ++j) {
+        int64_t i_begin = std::max( j - kdt, int64_t( 0 ) );
+        int64_t ii = 0;
+        for (int64_t i = 0; i <= j; ++i) {
+            if (i >= i_begin && A.tileIsLocal( i, j )) {
+                A.tileGetForReading( i, j, HostNum, LayoutConvert::ColMajor );
+                auto Aij = A( i, j );
+                for (int64_t c = 0; c < Aij.nb(); ++c) {
+                    for (int64_t r = 0; r < Aij.mb(); ++r) {
+                        int64_t d = jj + c - (ii + r);
+                        if (0 <= d && d <= band)
+                            A00[ ii + r + (jj + c)*lda ] = Aij( r, c );
+                    }
+                }
+            }
+            ii += A.tileMb( i );
+        }
+        jj += A.tileNb( j );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// @internal
+/// Copies band storage back to the local tiles of the upper band of A.
+/// @see tb2bd_get_band
+///
+template <typename scalar_t>
+void tb2bd_set_band(
+    TriangularBandMatrix<scalar_t>& A,
+    std::vector<scalar_t> const& AB, int64_t lda )
+{
+    int64_t nt   = A.nt();
+    int64_t band = A.bandwidth();
+    int64_t kdt  = ceildiv( band, A.tileNb( 0 ) );
+
+    scalar_t const* A00 = &AB[ 2*band ];
+    int64_t jj = 0;
+    for (int64_t j = 0; j < nt; ++j) {
+        int64_t i_begin = std::max( j - kdt, int64_t( 0 ) );
+        int64_t ii = 0;
+        for (int64_t i = 0; i <= j; ++i) {
+            if (i >= i_begin && A.tileIsLocal( i, j )) {
+                A.tileGetForWriting( i, j, HostNum, LayoutConvert::ColMajor );
+                auto Aij = A( i, j );
+                for (int64_t c = 0; c < Aij.nb(); ++c) {
+                    for (int64_t r = 0; r < Aij.mb(); ++r) {
+                        int64_t d = jj + c - (ii + r);
+                        if (0 <= d && d <= band)
+                            Aij.at( r, c ) = A00[ ii + r + (jj + c)*lda ];
+                    }
+                }
+            }
+            ii += A.tileMb( i );
+        }
+        jj += A.tileNb( j );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// @internal
+/// Applies a Householder reflector to an m-by-n block from the left,
+/// $B = H^H B$, or from the right, $B = B H$, with $H = I - \tau v v^H$,
+/// as internal::gerf does in gebr1, gebr2, and gebr3.
+/// v[0] holds tau; the reflector has v[0] = 1.
+/// Uses m + n entries of work.
+///
+template <typename scalar_t>
+void tb2bd_gerf(
+    Side side, int64_t m, int64_t n, scalar_t const* v,
+    scalar_t* B, int64_t ldb, scalar_t* work )
+{
+    const scalar_t zero = 0.0;
+    const scalar_t one  = 1.0;
+    using blas::conj;
+
+    scalar_t tau = v[ 0 ];
+    scalar_t alpha = side == Side::Left ? -conj( tau ) : -tau;
+    int64_t k = side == Side::Left ? m : n;
+    scalar_t* u = work;
+    scalar_t* w = &work[ k ];
+    u[ 0 ] = one;
+    std::copy( &v[ 1 ], &v[ k ], &u[ 1 ] );
+
+    if (side == Side::Left) {
+        // B = B - conj( tau ) u (u^H B)
+        blas::gemv( Layout::ColMajor, Op::ConjTrans, m, n,
+                    one, B, ldb, u, 1, zero, w, 1 );
+        blas::ger( Layout::ColMajor, m, n, alpha, u, 1, w, 1, B, ldb );
+    }
+    else {
+        // B = B - tau (B u) u^H
+        blas::gemv( Layout::ColMajor, Op::NoTrans, m, n,
+                    one, B, ldb, u, 1, zero, w, 1 );
+        blas::ger( Layout::ColMajor, m, n, alpha, w, 1, u, 1, B, ldb );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// @internal
+/// Does step of sweep in bidiagonal bulge chasing, the same task as
+/// tb2bd_step, on the upper band of an n-by-n matrix in band storage,
+/// with entry (i, j) in AB[ i + j*lda ].
+///
+/// @param[in,out] u
+///     Reflector from the left, as U1 in tb2bd_step: generated by step 0
+///     and diagonal blocks, and applied by off-diagonal blocks.
+///
+/// @param[in,out] v
+///     Reflector from the right, as V1 in tb2bd_step: generated by step 0
+///     and off-diagonal blocks, and applied by diagonal blocks.
+///
+template <typename scalar_t>
+void tb2bd_band_step(
+    int64_t n, int64_t band, int64_t sweep, int64_t step,
+    scalar_t* AB, int64_t lda,
+    scalar_t* u, scalar_t* v )
+{
+    using blas::conj;
+
+    int64_t task  = step == 0 ? 0 : (step + 1) % 2 + 1;
+    int64_t block = (step + 1)/2;
+    std::vector<scalar_t> work( 2*band + 1 );
+    scalar_t tau;
+
+    if (task == 0) {
+        // Zeros B[ 0, 1:n1-1 ], then B[ 2:n1, 0 ].
+        int64_t i  = sweep;
+        int64_t n1 = std::min( i + band, n - 1 ) - i;
+        scalar_t* B = &AB[ i + (i+1)*lda ];
+
+        for (int64_t e = 0; e < n1; ++e)
+            v[ e ] = conj( B[ e*lda ] );
+        lapack::larfg( n1, &v[ 0 ], &v[ 1 ], 1, &tau );
+        v[ 0 ] = tau;
+        tb2bd_gerf( Side::Right, n1 + 1, n1, v, B, lda, work.data() );
+
+        std::copy( &B[ 1 ], &B[ 1 + n1 ], u );
+        lapack::larfg( n1, &u[ 0 ], &u[ 1 ], 1, &tau );
+        u[ 0 ] = tau;
+        tb2bd_gerf( Side::Left, n1, n1, u, &B[ 1 ], lda, work.data() );
+    }
+    else if (task == 1) {
+        // Applies the reflector from the previous step from the left,
+        // then zeros B[ 0, 1:n1-1 ].
+        int64_t i = (block-1)*band + 1 + sweep;
+        int64_t j =  block   *band + 1 + sweep;
+        if (i < n && j < n) {
+            int64_t m1 = std::min( i + band - 1, n - 1 ) - i + 1;
+            int64_t n1 = std::min( j + band - 1, n - 1 ) - j + 1;
+            scalar_t* B = &AB[ i + j*lda ];
+            tb2bd_gerf( Side::Left, m1, n1, u, B, lda, work.data() );
+
+            for (int64_t e = 0; e < n1; ++e)
+                v[ e ] = conj( B[ e*lda ] );
+            lapack::larfg( n1, &v[ 0 ], &v[ 1 ], 1, &tau );
+            v[ 0 ] = tau;
+            tb2bd_gerf( Side::Right, m1, n1, v, B, lda, work.data() );
+        }
+    }
+    else {
+        // Applies the reflector from the previous step from the right,
+        // then zeros B[ 1:m1-1, 0 ].
+        int64_t i = block*band + 1 + sweep;
+        if (i < n) {
+            int64_t m1 = std::min( i + band - 1, n - 1 ) - i + 1;
+            scalar_t* B = &AB[ i + i*lda ];
+            tb2bd_gerf( Side::Right, m1, m1, v, B, lda, work.data() );
+
+            std::copy( &B[ 0 ], &B[ m1 ], u );
+            lapack::larfg( m1, &u[ 0 ], &u[ 1 ], 1, &tau );
+            u[ 0 ] = tau;
+            tb2bd_gerf( Side::Left, m1, m1, u, B, lda, work.data() );
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// @internal
+/// Implements bidiagonal bulge chasing pipelined over MPI ranks,
+/// as hb2st_pipeline does for tridiagonal bulge chasing.
+///
+/// The upper band is in band storage, with entry (i, j) in AB[ i + j*lda ],
+/// for j - 2*band < i < j + band, lda >= 3*band - 2, with room for the
+/// bulge. Column j is owned by rank col_rank( j ); entries of other columns
+/// are used only as workspace. Each step updates a block of the band and is
+/// done by the rank owning the block's first column. Steps with the same
+/// wavefront 3*sweep + step are independent and update disjoint blocks.
+/// A step that runs into the next rank's columns borrows those entries for
+/// the wavefront. Each step applies the reflector generated by the previous
+/// step of its sweep, which is sent to it from the rank generating it.
+///
+/// At the end, the reflector that tb2bd_step stores for (sweep, block)
+/// in U, for side = Left, or in V, for side = Right, is in
+/// vector( side, sweep, block ) on rank vector_rank( side, sweep, block ).
+///
+/// @param[in] vector
+///     vector( side, sweep, block ) returns a pointer to band entries to
+///     store that reflector on this rank, initially zero.
+///
+template <typename scalar_t, typename ColRank, typename Vector, typename VectorRank>
+void tb2bd_pipeline(
+    int64_t n, int64_t band,
+    scalar_t* AB, int64_t lda,
+    ColRank&& col_rank, Vector&& vector, VectorRank&& vector_rank,
+    MPI_Comm mpi_comm )
+{
+    const int tag_borrow = 0;
+    const int tag_return = 1;
+    const int tag_vector = 2;
+    const int tag_merge  = 3;
+    const auto mpi_scalar = mpi_type<scalar_t>::value;
+
+    int mpi_rank;
+    slate_mpi_call(
+        MPI_Comm_rank( mpi_comm, &mpi_rank ) );
+
+    int64_t nsweeps = n - 1;
+    auto nsteps = [&]( int64_t sweep ) {
+        return 2*ceildiv( n - 1 - sweep, band ) - 1;
+    };
+
+    // Block that step updates: rows [ row_begin, row_end )
+    // of cols [ col_begin, col_end ). Returns false for no-op steps.
+    struct Step {
+        int64_t sweep, step, row_begin, row_end, col_begin, col_end;
+        int rank, lender;
+    };
+    auto make_step = [&]( int64_t sweep, int64_t step, Step& s ) {
+        if (step >= nsteps( sweep ))
+            return false;
+        int64_t task  = step == 0 ? 0 : (step + 1) % 2 + 1;
+        int64_t block = (step + 1)/2;
+        if (task == 0) {
+            s.row_begin = sweep;
+            s.col_begin = sweep + 1;
+            s.col_end   = std::min( sweep + band, n - 1 ) + 1;
+            s.row_end   = s.col_end;
+        }
+        else {
+            int64_t i = (task == 1 ? block-1 : block)*band + 1 + sweep;
+            int64_t j = block*band + 1 + sweep;
+            if (i >= n || j >= n)
+                return false;
+            s.row_begin = i;
+            s.row_end   = std::min( i + band, n );
+            s.col_begin = j;
+            s.col_end   = std::min( j + band, n );
+        }
+        s.sweep = sweep;
+        s.step  = step;
+        s.rank  = col_rank( s.col_begin );
+        s.lender = col_rank( s.col_end - 1 );
+        return true;
+    };
+
+    // Packs or unpacks the borrowed entries of step s:
+    // the columns of the lender, which are at the end of the block.
+    auto borrowed = [&]( Step const& s, std::vector<scalar_t>& buffer,
+                         bool pack ) {
+        int64_t j0 = s.col_end - 1;
+        while (j0 > s.col_begin && col_rank( j0 - 1 ) == s.lender)
+            --j0;
+        if (pack)
+            buffer.clear();
+        int64_t e = 0;
+        for (int64_t j = j0; j < s.col_end; ++j) {
+            for (int64_t i = s.row_begin; i < s.row_end; ++i) {
+                if (pack)
+                    buffer.push_back( AB[ i + j*lda ] );
+                else
+                    AB[ i + j*lda ] = buffer[ e++ ];
+            }
+        }
+    };
+
+    // Reflectors of step s, as U1 and V1 in tb2bd_step. Step s applies
+    // its input reflector, generated by step - 1, and generates its
+    // output reflector, applied by step + 1.
+    auto u_block = [&]( Step const& s ) {
+        int64_t block = (s.step + 1)/2;
+        return s.step % 2 == 1 ? block - 1 : block;
+    };
+    auto v_block = [&]( Step const& s ) {
+        return (s.step + 1)/2;
+    };
+    auto input = [&]( Step const& s ) {
+        return s.step % 2 == 1 ? vector( Side::Left,  s.sweep, u_block( s ) )
+                               : vector( Side::Right, s.sweep, v_block( s ) );
+    };
+    auto output = [&]( Step const& s ) {
+        return s.step % 2 == 1 ? vector( Side::Right, s.sweep, v_block( s ) )
+                               : vector( Side::Left,  s.sweep, u_block( s ) );
+    };
+
+    // Sends outstanding; each is done by the end of wavefront due.
+    struct Message {
+        MPI_Request request;
+        std::vector<scalar_t> data;
+        int64_t due;
+    };
+    std::list<Message> messages;
+    auto isend = [&]( std::vector<scalar_t>&& data, int dst, int tag,
+                      int64_t due ) {
+        messages.emplace_back();
+        Message& msg = messages.back();
+        msg.data = std::move( data );
+        msg.due  = due;
+        slate_mpi_call(
+            MPI_Isend( msg.data.data(), msg.data.size(), mpi_scalar,
+                       dst, tag, mpi_comm, &msg.request ) );
+    };
+    auto recv = [&]( scalar_t* data, int64_t count, int src, int tag ) {
+        slate_mpi_call(
+            MPI_Recv( data, count, mpi_scalar, src, tag, mpi_comm,
+                      MPI_STATUS_IGNORE ) );
+    };
+    auto wait = [&]( int64_t wave ) {
+        for (auto msg = messages.begin(); msg != messages.end(); ) {
+            if (msg->due <= wave) {
+                slate_mpi_call(
+                    MPI_Wait( &msg->request, MPI_STATUS_IGNORE ) );
+                msg = messages.erase( msg );
+            }
+            else {
+                ++msg;
+            }
+        }
+    };
+
+    std::vector<Step> steps, lent;
+    std::vector< std::vector<scalar_t> > buffers;
+    std::vector<scalar_t*> u, v;
+    int64_t sweep_begin = 0;
+    for (int64_t wave = 0; sweep_begin < nsweeps; ++wave) {
+        while (sweep_begin < nsweeps
+               && wave - 3*sweep_begin >= nsteps( sweep_begin ))
+            ++sweep_begin;
+        int64_t sweep_end = std::min( wave/3 + 1, nsweeps );
+
+        // Steps of this rank, and steps borrowing from this rank.
+        steps.clear();
+        lent.clear();
+        for (int64_t sweep = sweep_begin; sweep < sweep_end; ++sweep) {
+            Step s;
+            if (make_step( sweep, wave - 3*sweep, s )) {
+                if (s.rank == mpi_rank)
+                    steps.push_back( s );
+                else if (s.lender == mpi_rank)
+                    lent.push_back( s );
+            }
+        }
+
+        // Lend entries, as updated by the previous wavefronts.
+        for (auto const& s : lent) {
+            std::vector<scalar_t> buffer;
+            borrowed( s, buffer, true );
+            isend( std::move( buffer ), s.rank, tag_borrow, wave );
+        }
+
+        // Receive reflectors and borrowed entries.
+        buffers.resize( steps.size() );
+        u.assign( steps.size(), nullptr );
+        v.assign( steps.size(), nullptr );
+        for (size_t k = 0; k < steps.size(); ++k) {
+            Step const& s = steps[ k ];
+            u[ k ] = vector( Side::Left,  s.sweep, u_block( s ) );
+            v[ k ] = vector( Side::Right, s.sweep, v_block( s ) );
+            Step prev;
+            if (s.step > 0 && make_step( s.sweep, s.step - 1, prev )
+                && prev.rank != mpi_rank)
+                recv( input( s ), band, prev.rank, tag_vector );
+            if (s.lender != mpi_rank) {
+                borrowed( s, buffers[ k ], true );
+                recv( buffers[ k ].data(), buffers[ k ].size(),
+                      s.lender, tag_borrow );
+                borrowed( s, buffers[ k ], false );
+            }
+        }
+
+        #pragma omp parallel for schedule( dynamic, 1 ) if (steps.size() > 1)
+        for (size_t k = 0; k < steps.size(); ++k) {
+            Step const& s = steps[ k ];
+            tb2bd_band_step( n, band, s.sweep, s.step, AB, lda,
+                             u[ k ], v[ k ] );
+        }
+
+        // Return borrowed entries, and send new reflectors to where
+        // they are applied, in the next wavefront.
+        for (size_t k = 0; k < steps.size(); ++k) {
+            Step const& s = steps[ k ];
+            if (s.lender != mpi_rank) {
+                borrowed( s, buffers[ k ], true );
+                isend( std::move( buffers[ k ] ), s.lender, tag_return, wave );
+            }
+            Step next;
+            if (make_step( s.sweep, s.step + 1, next )
+                && next.rank != mpi_rank) {
+                scalar_t const* x = output( s );
+                isend( std::vector<scalar_t>( x, x + band ),
+                       next.rank, tag_vector, wave + 1 );
+            }
+        }
+
+        // Get back lent entries.
+        for (auto const& s : lent) {
+            std::vector<scalar_t> buffer;
+            borrowed( s, buffer, true );
+            recv( buffer.data(), buffer.size(), s.rank, tag_return );
+            borrowed( s, buffer, false );
+        }
+        wait( wave );
+    }
+    wait( std::numeric_limits<int64_t>::max() );
+
+    // Gather reflectors to their owners, one message per group, block, and
+    // side from each other rank that generated some of them. Reflector
+    // (side, sweep, block) is generated by step 2*block for Left, and
+    // step 2*block - 1, or 0, for Right.
+    auto generator = [&]( Side side, int64_t sweep, int64_t block, Step& s ) {
+        int64_t step = side == Side::Left
+                     ? 2*block : std::max( 2*block - 1, int64_t( 0 ) );
+        return make_step( sweep, step, s );
+    };
+    int64_t ngroups = ceildiv( nsweeps, band );
+    for (int64_t group = 0; group < ngroups; ++group) {
+        int64_t s_begin = group*band;
+        int64_t s_end   = std::min( s_begin + band, nsweeps );
+        Step s;
+        for (int64_t block = 0; generator( Side::Right, s_begin, block, s );
+             ++block) {
+            for (Side side : { Side::Left, Side::Right }) {
+                int dst = vector_rank( side, s_begin, block );
+                std::vector<int> srcs;
+                std::vector<scalar_t> buffer;
+                for (int64_t sweep = s_begin; sweep < s_end; ++sweep) {
+                    if (! generator( side, sweep, block, s ))
+                        break;
+                    if (s.rank == dst)
+                        continue;
+                    if (std::find( srcs.begin(), srcs.end(), s.rank ) == srcs.end())
+                        srcs.push_back( s.rank );
+                    if (s.rank == mpi_rank) {
+                        scalar_t const* x = vector( side, sweep, block );
+                        buffer.insert( buffer.end(), x, x + band );
+                    }
+                }
+                if (! buffer.empty())
+                    isend( std::move( buffer ), dst, tag_merge, 0 );
+                if (dst == mpi_rank) {
+                    for (int src : srcs) {
+                        std::vector<int64_t> sweeps;
+                        for (int64_t sweep = s_begin; sweep < s_end; ++sweep) {
+                            if (! generator( side, sweep, block, s ))
+                                break;
+                            if (s.rank == src)
+                                sweeps.push_back( sweep );
+                        }
+                        buffer.resize( sweeps.size()*band );
+                        recv( buffer.data(), buffer.size(), src, tag_merge );
+                        for (size_t e = 0; e < sweeps.size(); ++e) {
+                            std::copy( &buffer[ e*band ], &buffer[ (e+1)*band ],
+                                       vector( side, sweeps[ e ], block ) );
+                        }
+                    }
+                }
+            }
+        }
+    }
+    wait( std::numeric_limits<int64_t>::max() );
+}
+
+//------------------------------------------------------------------------------
+/// @internal
+/// Implements bidiagonal bulge chasing of a band matrix distributed over
+/// several MPI ranks, with the tiles of each block column on one rank,
+/// e.g., on a 1-by-q grid. Each rank copies its block columns to band
+/// storage, and tb2bd_pipeline chases the bulges across the ranks.
+/// The reflectors end up in the tiles of U and V, distributed as U and V
+/// are, in the layout of tb2bd_step that unmtr_hb2st applies.
+///
+/// @return false if A is on one rank, in which case A, U, and V are
+/// unchanged.
+///
+template <typename scalar_t>
+bool tb2bd_distributed(
+    TriangularBandMatrix<scalar_t>& A,
+    Matrix<scalar_t>& U,
+    Matrix<scalar_t>& V )
+{
+    const scalar_t zero = 0.0;
+
+    int64_t n    = A.n();
+    int64_t nt   = A.nt();
+    int64_t band = A.bandwidth();
+    int64_t nb   = A.tileNb( 0 );
+
+    bool distributed = false;
+    for (int64_t j = 1; j < nt; ++j)
+        distributed = distributed || A.tileRank( j, j ) != A.tileRank( 0, 0 );
+    if (! distributed)
+        return false;
+
+    if (A.uplo() != Uplo::Upper)
+        slate_not_implemented( "tb2bd: distributed lower band matrix" );
+    slate_assert( band == nb );
+    slate_assert( U.tileMb( 0 ) == 2*band && U.tileNb( 0 ) == band );
+    slate_assert( V.tileMb( 0 ) == 2*band && V.tileNb( 0 ) == band );
+    for (int64_t j = 1; j < nt; ++j) {
+        if (A.tileRank( j-1, j ) != A.tileRank( j, j ))
+            slate_error( "tb2bd: block columns of A must be on one rank" );
+    }
+
+    // Upper band, with room for the bulge.
+    int64_t lda = 3*band;
+    std::vector<scalar_t> AB;
+    tb2bd_get_band( A, AB, lda );
+
+    auto col_rank = [&]( int64_t j ) {
+        return A.tileRank( j / nb, j / nb );
+    };
+
+    // Reflectors are stored in tiles of U and V as in tb2bd_step. Tiles of
+    // other ranks are workspace, until the reflectors go to their owner.
+    std::set<int64_t> u_workspace, v_workspace;
+    auto vector_tile = [&]( int64_t sweep, int64_t block ) {
+        int64_t k = sweep / band;
+        return k*nt - k*(k - 1)/2 + block;
+    };
+    auto vector = [&]( Side side, int64_t sweep, int64_t block ) {
+        auto& W = side == Side::Left ? U : V;
+        auto& workspace = side == Side::Left ? u_workspace : v_workspace;
+        int64_t t = vector_tile( sweep, block );
+        if (! W.tileIsLocal( 0, t ) && workspace.insert( t ).second) {
+            auto T = W.tileInsertWorkspace( 0, t );
+            lapack::laset(
+                lapack::MatrixType::General, T.mb(), T.nb(),
+                zero, zero, T.data(), T.stride() );
+        }
+        auto T = W( 0, t );
+        return &T.at( sweep % band + 1, sweep % band );
+    };
+    auto vector_rank = [&]( Side side, int64_t sweep, int64_t block ) {
+        auto& W = side == Side::Left ? U : V;
+        return W.tileRank( 0, vector_tile( sweep, block ) );
+    };
+
+    tb2bd_pipeline( n, band, &AB[ 2*band ], lda,
+                    col_rank, vector, vector_rank, A.mpiComm() );
+
+    for (int64_t t : u_workspace)
+        U.tileErase( 0, t );
+    for (int64_t t : v_workspace)
+        V.tileErase( 0, t );
+
+    // The band is now bidiagonal.
+    tb2bd_set_band( A, AB, lda );
+    A.bandwidth( 1 );
+    return true;
+}
+
 //------------------------------------------------------------------------------
 /// @internal
 /// Reduces a band matrix to a bidiagonal matrix using bulge chasing.
@@ -225,6 +809,16 @@ void tb2bd(
     set(zero, U);
     set(zero, V);
 
+    // Pipeline over the ranks if A is distributed.
+    if (tb2bd_distributed( A, U, V ))
+        return;
+
+    // A is on one rank; other ranks have nothing to do.
+    if (A.nt() == 0 || ! A.tileIsLocal( 0, 0 )) {
+        A.bandwidth( 1 );
+        return;
+    }
+
     Progress progress(diag_len-1);
     for (int64_t i = 0; i < diag_len-1; ++i)
         progress.at(i).store(-1);
@@ -314,6 +908,8 @@ void tb2bd(
 
 //------------------------------------------------------------------------------
 /// Reduces a band matrix to a bidiagonal matrix using bulge chasing.
+/// If the block columns of A are on several MPI ranks, e.g., on a 1-by-q
+/// grid, all ranks call tb2bd and the bulge chasing is pipelined over them.
 ///
 //------------------------------------------------------------------------------
 /// @tparam scalar_t
@@ -342,7 +938,7 @@ void tb2bd(
 {
     using internal::TargetType;
 
-    Target target = get_option( opts, Option::Target, Target::HostTask );
+    Target target = get_target( opts, Target::HostTask );
 
     switch (target) {
         case Target::Host:
@@ -359,6 +955,7 @@ void tb2bd(
             break;
 
         case Target::Devices:
+        case Target::Hybrid:
             impl::tb2bd<Target::Devices>( A, U, V, opts );
             break;
     }
@@ -40,7 +40,7 @@ void tbsm(
     const int priority_1 = 1;
 
     // Options
-    int64_t lookahead = get_option<int64_t>( opts, Option::Lookahead, 1 );
+    int64_t lookahead = get_lookahead( opts );
 
     // if on right, change to left by (conj)-transposing A and B to get
     // op(B) = op(A)^{-1} * op(B)
@@ -64,7 +64,11 @@ void tbsm(
     int64_t nt = B.nt();
 
     if (target == Target::Devices) {
-        B.allocateBatchArrays();
+        // The panel trsm and trailing update use queue 0,
+        // lookahead rows queues 1, ..., lookahead.
+        const int64_t batch_size_default = 0;
+        int num_queues = 1 + lookahead;
+        B.allocateBatchArrays( batch_size_default, num_queues );
         B.reserveDeviceWorkspace();
     }
 
@@ -134,7 +138,7 @@ void tbsm(
                     A.template tileBcast(k, k, B.sub(k, k, 0, nt-1), layout);
 
                     // solve A(k, k) B(k, :) = B(k, :)
-                    internal::trsm<Target::HostTask>(
+                    internal::trsm<target>(
                         Side::Left,
                         one, A.sub(k, k),
                              B.sub(k, k, 0, nt-1),
@@ -161,11 +165,12 @@ void tbsm(
                     #pragma omp task depend(in:row[k]) \
                                      depend(inout:row[i]) priority(1)
                     {
-                        internal::gemm<Target::HostTask>(
+                        int queue_ik = std::abs( i-k );
+                        internal::gemm<target>(
                             -one, A.sub(i, i, k, k),
                                   B.sub(k, k, 0, nt-1),
                             one,  B.sub(i, i, 0, nt-1),
-                            layout, priority_1 );
+                            layout, priority_1, queue_ik );
                     }
                 }
 
@@ -218,7 +223,7 @@ void tbsm(
                     A.template tileBcast(k, k, B.sub(k, k, 0, nt-1), layout);
 
                     // solve A(k, k) B(k, :) = B(k, :)
-                    internal::trsm<Target::HostTask>(
+                    internal::trsm<target>(
                         Side::Left,
                         one, A.sub(k, k),
                              B.sub(k, k, 0, nt-1),
@@ -242,11 +247,12 @@ void tbsm(
                     #pragma omp task depend(in:row[k]) \
                                      depend(inout:row[i]) priority(1)
                     {
-                        internal::gemm<Target::HostTask>(
+                        int queue_ik = std::abs( i-k );
+                        internal::gemm<target>(
                             -one, A.sub(i, i, k, k),
                                   B.sub(k, k, 0, nt-1),
                             one,  B.sub(i, i, 0, nt-1),
-                            layout, priority_1 );
+                            layout, priority_1, queue_ik );
                     }
                 }
 
@@ -327,7 +333,7 @@ void tbsm(
                     A.template tileBcast(k, k, B.sub(k, k, 0, nt-1), layout);
 
                     // solve A(k, k) B(k, :) = B(k, :)
-                    internal::trsm<Target::HostTask>(
+                    internal::trsm<target>(
                         Side::Left,
                         one, A.sub(k, k),
                              B.sub(k, k, 0, nt-1),
@@ -432,7 +438,7 @@ void tbsm(
                   Matrix<scalar_t>& B,
     Options const& opts)
 {
-    Target target = get_option( opts, Option::Target, Target::HostTask );
+    Target target = get_target( opts, Target::HostTask );
 
     switch (target) {
         case Target::Host:
@@ -449,6 +455,7 @@ void tbsm(
             break;
 
         case Target::Devices:
+        case Target::Hybrid:
             impl::tbsm<Target::Devices>( side, alpha, A, pivots, B, opts );
             break;
     }
@@ -0,0 +1,313 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/slate.hh"
+#include "internal/internal.hh"
+
+#include <limits>
+#include <map>
+#include <set>
+#include <vector>
+
+namespace slate {
+
+namespace impl {
+
+//------------------------------------------------------------------------------
+/// @internal
+/// Distributed transpose, B = A^T or B = A^H, when B's tiles are the
+/// transposes of A's tiles, i.e., B(j, i) = op( A(i, j) ).
+///
+/// Tile A(i, j) goes to the owner of B(j, i), so each pair of ranks
+/// exchanges one packed message in each direction, with no per-tile
+/// messages. On a square p-by-p grid, with the same process_2d_grid for
+/// A and B, each rank's only partner is the rank at the mirrored grid
+/// position, and ranks on the grid diagonal send nothing.
+/// Received tiles are held as workspace tiles of A; then all of B's tiles
+/// are transposed locally by internal::copy, with batched transpose
+/// kernels on devices.
+/// Generic implementation for any target.
+/// @ingroup copy_impl
+///
+template <Target target, typename scalar_t>
+void transpose_exchange(
+    bool is_conj,
+    Matrix<scalar_t>& A,
+    Matrix<scalar_t>& B,
+    Options const& opts )
+{
+    using ij_tuple = typename BaseMatrix<scalar_t>::ij_tuple;
+
+    trace::Block trace_block("slate::transpose_exchange");
+
+    MPI_Comm mpi_comm = A.mpiComm();
+    int mpi_rank = A.mpiRank();
+    int tag = 0;
+
+    // Tiles of A exchanged with each rank, in the same order on all ranks.
+    std::map< int, std::vector<ij_tuple> > send_tiles, recv_tiles;
+    for (int64_t j = 0; j < A.nt(); ++j) {
+        for (int64_t i = 0; i < A.mt(); ++i) {
+            int src = A.tileRank( i, j );
+            int dst = B.tileRank( j, i );
+            if (src == mpi_rank && dst != mpi_rank)
+                send_tiles[ dst ].push_back( { i, j } );
+            else if (dst == mpi_rank && src != mpi_rank)
+                recv_tiles[ src ].push_back( { i, j } );
+        }
+    }
+    auto count_of = [&A]( std::vector<ij_tuple> const& tiles ) {
+        int64_t count = 0;
+        for (auto& ij : tiles)
+            count += A.tileMb( std::get<0>( ij ) ) * A.tileNb( std::get<1>( ij ) );
+        slate_assert( count <= std::numeric_limits<int>::max() );
+        return count;
+    };
+
+    // Post all receives.
+    std::vector< std::vector<scalar_t> > recv_buffers;
+    std::vector<int> recv_ranks;
+    std::vector<MPI_Request> recv_requests;
+    recv_buffers.reserve( recv_tiles.size() );
+    for (auto& rank_tiles : recv_tiles) {
+        int64_t count = count_of( rank_tiles.second );
+        recv_buffers.emplace_back( count );
+        recv_ranks.push_back( rank_tiles.first );
+        internal::count( internal::Count::BytesRecv, count * sizeof(scalar_t) );
+        MPI_Request request;
+        slate_mpi_call(
+            MPI_Irecv( recv_buffers.back().data(), count,
+                       mpi_type<scalar_t>::value, rank_tiles.first, tag,
+                       mpi_comm, &request ) );
+        recv_requests.push_back( request );
+    }
+
+    // Pack tiles untransposed, column-major, and send to each partner.
+    std::vector< std::vector<scalar_t> > send_buffers;
+    std::vector<MPI_Request> send_requests;
+    send_buffers.reserve( send_tiles.size() );
+    for (auto& rank_tiles : send_tiles) {
+        send_buffers.emplace_back( count_of( rank_tiles.second ) );
+        scalar_t* buffer = send_buffers.back().data();
+        for (auto& ij : rank_tiles.second) {
+            int64_t i = std::get<0>( ij );
+            int64_t j = std::get<1>( ij );
+            A.tileGetForReading( i, j, HostNum, LayoutConvert::ColMajor );
+            auto Aij = A( i, j );
+            lapack::lacpy( lapack::MatrixType::General, Aij.mb(), Aij.nb(),
+                           Aij.data(), Aij.stride(), buffer, Aij.mb() );
+            buffer += Aij.mb() * Aij.nb();
+        }
+        internal::count_message( rank_tiles.first,
+                                 send_buffers.back().size() * sizeof(scalar_t) );
+        MPI_Request request;
+        slate_mpi_call(
+            MPI_Isend( send_buffers.back().data(), send_buffers.back().size(),
+                       mpi_type<scalar_t>::value, rank_tiles.first, tag,
+                       mpi_comm, &request ) );
+        send_requests.push_back( request );
+    }
+
+    // Unpack messages into workspace tiles of A as they arrive.
+    std::set<ij_tuple> recv_set;
+    for (size_t k = 0; k < recv_requests.size(); ++k) {
+        int index;
+        slate_mpi_call(
+            MPI_Waitany( recv_requests.size(), recv_requests.data(),
+                         &index, MPI_STATUS_IGNORE ) );
+        scalar_t const* buffer = recv_buffers[ index ].data();
+        for (auto& ij : recv_tiles[ recv_ranks[ index ] ]) {
+            int64_t i = std::get<0>( ij );
+            int64_t j = std::get<1>( ij );
+            A.tileAcquire( i, j, HostNum, Layout::ColMajor );
+            A.tileIncrementReceiveCount( i, j );
+            auto Aij = A( i, j );
+            lapack::lacpy( lapack::MatrixType::General, Aij.mb(), Aij.nb(),
+                           buffer, Aij.mb(), Aij.data(), Aij.stride() );
+            A.tileModified( i, j, HostNum, true );
+            buffer += Aij.mb() * Aij.nb();
+            recv_set.insert( ij );
+        }
+    }
+
+    // Transpose all local tiles of B.
+    if (target == Target::Devices) {
+        A.allocateBatchArrays();
+        B.allocateBatchArrays();
+        B.reserveDeviceWorkspace();
+    }
+
+    auto AT = is_conj ? conj_transpose( A ) : transpose( A );
+
+    #pragma omp parallel
+    #pragma omp master
+    {
+        internal::copy<target>( std::move( AT ), std::move( B ) );
+        #pragma omp taskwait
+        B.tileUpdateAllOrigin();
+    }
+
+    internal::waitall( send_requests );
+
+    A.releaseRemoteWorkspace( recv_set );
+    B.releaseWorkspace();
+}
+
+//------------------------------------------------------------------------------
+/// @internal
+/// Dispatches to transpose_exchange when B's tiles are the transposes of
+/// A's tiles; otherwise redistributes op(A) into B.
+/// @ingroup copy_impl
+///
+template <typename scalar_t>
+void transpose(
+    bool is_conj,
+    Matrix<scalar_t>& A,
+    Matrix<scalar_t>& B,
+    Options const& opts )
+{
+    slate_assert( B.m() == A.n() );
+    slate_assert( B.n() == A.m() );
+
+    bool mirrored = A.op() == Op::NoTrans && B.op() == Op::NoTrans
+                    && B.mt() == A.nt() && B.nt() == A.mt();
+    for (int64_t i = 0; i < B.mt() && mirrored; ++i)
+        mirrored = B.tileMb( i ) == A.tileNb( i );
+    for (int64_t j = 0; j < B.nt() && mirrored; ++j)
+        mirrored = B.tileNb( j ) == A.tileMb( j );
+
+    if (! mirrored) {
+        auto AT = is_conj ? conj_transpose( A ) : transpose( A );
+        redistribute( AT, B, opts );
+        return;
+    }
+
+    Target target = get_target( opts, Target::HostTask );
+
+    switch (target) {
+        case Target::Host:
+        case Target::HostTask:
+        default:
+            transpose_exchange<Target::HostTask>( is_conj, A, B, opts );
+            break;
+
+        case Target::Devices:
+            transpose_exchange<Target::Devices>( is_conj, A, B, opts );
+            break;
+    }
+}
+
+} // namespace impl
+
+//------------------------------------------------------------------------------
+/// Distributed transpose, B = A^T, materialized in B's distribution.
+/// Unlike redistributing the view transpose(A), tile A(i, j) goes directly
+/// to the owner of B(j, i), and each pair of ranks exchanges a single
+/// message. With the same square p-by-p process_2d_grid for A and B,
+/// each rank exchanges only with the rank at the mirrored grid position,
+/// and ranks on the grid diagonal don't communicate.
+/// If B's tiles are not the transposes of A's tiles, or A or B is
+/// transposed, this falls back to redistribute.
+/// All ranks with tiles of A or B must call it.
+//------------------------------------------------------------------------------
+/// @tparam scalar_t
+///     One of float, double, std::complex<float>, std::complex<double>.
+//------------------------------------------------------------------------------
+/// @param[in] A
+///         The m-by-n matrix A.
+///
+/// @param[out] B
+///         The n-by-m matrix B, with the same MPI communicator as A.
+///         On exit, B = A^T.
+///
+/// @param[in] opts
+///         Additional options, as map of name = value pairs. Possible options:
+///         - Option::Target:
+///           Implementation to target. Possible values:
+///           - HostTask:  OpenMP tasks on CPU host [default].
+///           - Devices:   batched transpose kernels on GPU device.
+///
+/// @ingroup copy
+///
+template <typename scalar_t>
+void transpose(
+    Matrix<scalar_t>& A,
+    Matrix<scalar_t>& B,
+    Options const& opts )
+{
+    trace::Block trace_block("slate::transpose");
+
+    impl::transpose( false, A, B, opts );
+}
+
+//------------------------------------------------------------------------------
+/// Distributed conjugate transpose, B = A^H, materialized in B's
+/// distribution. @see transpose( A, B, opts ).
+/// @ingroup copy
+///
+template <typename scalar_t>
+void conj_transpose(
+    Matrix<scalar_t>& A,
+    Matrix<scalar_t>& B,
+    Options const& opts )
+{
+    trace::Block trace_block("slate::conj_transpose");
+
+    impl::transpose( true, A, B, opts );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+// ----------------------------------------
+template
+void transpose<float>(
+    Matrix<float>& A,
+    Matrix<float>& B,
+    Options const& opts);
+
+template
+void transpose<double>(
+    Matrix<double>& A,
+    Matrix<double>& B,
+    Options const& opts);
+
+template
+void transpose< std::complex<float> >(
+    Matrix< std::complex<float> >& A,
+    Matrix< std::complex<float> >& B,
+    Options const& opts);
+
+template
+void transpose< std::complex<double> >(
+    Matrix< std::complex<double> >& A,
+    Matrix< std::complex<double> >& B,
+    Options const& opts);
+
+// ----------------------------------------
+template
+void conj_transpose<float>(
+    Matrix<float>& A,
+    Matrix<float>& B,
+    Options const& opts);
+
+template
+void conj_transpose<double>(
+    Matrix<double>& A,
+    Matrix<double>& B,
+    Options const& opts);
+
+template
+void conj_transpose< std::complex<float> >(
+    Matrix< std::complex<float> >& A,
+    Matrix< std::complex<float> >& B,
+    Options const& opts);
+
+template
+void conj_transpose< std::complex<double> >(
+    Matrix< std::complex<double> >& A,
+    Matrix< std::complex<double> >& B,
+    Options const& opts);
+
+} // namespace slate
@@ -24,7 +24,7 @@ void trmm(
     Options const& opts )
 {
     // Options
-    int64_t lookahead = get_option<int64_t>( opts, Option::Lookahead, 1 );
+    int64_t lookahead = get_lookahead( opts );
 
     if (target == Target::Devices) {
         const int64_t batch_size_default = 0; // use default batch size
@@ -116,7 +116,7 @@ void trmm(
                               Matrix<scalar_t>& B,
     Options const& opts )
 {
-    Target target = get_option( opts, Option::Target, Target::HostTask );
+    Target target = get_target( opts, Target::HostTask );
 
     switch (target) {
         case Target::Host:
@@ -133,6 +133,7 @@ void trmm(
             break;
 
         case Target::Devices:
+        case Target::Hybrid:
             impl::trmm<Target::Devices>( side, alpha, A, B, opts );
             break;
     }
@@ -4,24 +4,106 @@
 // the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
 
 #include "slate/slate.hh"
+#include "internal/internal_cost.hh"
+#include "internal/internal_small.hh"
 
 namespace slate {
 
 //------------------------------------------------------------------------------
+/// Selects trsmA or trsmB by a communication and computation cost model.
+/// For side = left, with A m-by-m and B m-by-n,
+/// trsmB keeps B in place, receives A(i, 0:i) for its block rows and the
+///     solved block rows of B for its block cols,
+///     m^2 / (2 p) + m n / q words per rank;
+/// trsmA keeps A in place, receives block rows of B, and reduces the
+///     partial updates, n (m/q + m/p) words per rank.
+/// For side = right, the model is of the transposed solve.
+/// With at most 16 right-hand sides, each block row step is latency bound,
+/// so trsmInv is selected, which sends block rows in groups of
+/// lookahead + 1.
+/// @see internal::CostModel
+///
 template <typename TA, typename TB>
-inline MethodTrsm select_algo( TA& A, TB& B, Options const& opts )
+inline MethodTrsm select_algo(
+    Side side, TA& A, TB& B, Options const& opts )
 {
-    Target target = get_option( opts, Option::Target, Target::HostTask );
+    using scalar_t = typename TA::value_type;
+
+    Target target = get_target( opts, Target::HostTask );
     int n_devices = A.num_devices();
 
-    MethodTrsm method = (B.nt() < 2 ? MethodTrsm::A : MethodTrsm::B);
+    int64_t nrhs = (side == Side::Left ? B.n()  : B.m());
+    int64_t A_mt = (side == Side::Left ? B.mt() : B.nt());
+    if (nrhs <= 16 && A_mt > get_lookahead( opts ) + 1) {
+        internal::log_method( "trsm", A, opts, "Inv",
+                              "nrhs <= 16, latency bound" );
+        return MethodTrsm::Inv;
+    }
+
+    // trsmA on devices supports only one device per rank.
+    if (target == Target::Devices && n_devices > 1) {
+        internal::log_method( "trsm", A, opts, "B",
+                              "trsmA supports only one device per rank" );
+        return MethodTrsm::B;
+    }
 
-    if (method == MethodTrsm::A && target == Target::Devices && n_devices > 1)
-        method = MethodTrsm::B;
+    internal::CostModel model = internal::cost_model( "trsm", A, opts );
+    double p = model.p, q = model.q;
+    double m  = B.m(),  n  = B.n();
+    double mt = B.mt(), nt = B.nt();
+    if (side == Side::Right) {
+        std::swap( m, n );
+        std::swap( mt, nt );
+        std::swap( p, q );
+    }
+    double ws = sizeof( scalar_t );
+    double flops = m * m * n;
 
+    double time_B = model.time(
+        std::ceil( mt/p )*mt/2 + mt*std::ceil( nt/q ),
+        ws * (m*m/(2*p) + m*n/q), flops, mt*nt );
+    double time_A = model.time(
+        std::ceil( mt/q )*nt + std::ceil( mt/p )*nt,
+        ws * n * (m/q + m/p), flops, mt*mt/2 );
+
+    MethodTrsm method = (time_A < time_B ? MethodTrsm::A : MethodTrsm::B);
+
+    internal::log_method( "trsm", A, opts, to_c_string( method ),
+                          internal::cost_reason( "A", time_A, "B", time_B ) );
     return method;
 }
 
+//------------------------------------------------------------------------------
+/// Small-problem fast path of trsm: the rank owning all tiles of A and B
+/// gathers them and calls BLAS trsm, without tasks.
+/// @see internal::small_path
+///
+template <typename scalar_t>
+void trsm_small(
+    blas::Side side,
+    scalar_t alpha, TriangularMatrix<scalar_t>& A,
+                    Matrix<scalar_t>& B,
+    int owner )
+{
+    if (B.mpiRank() != owner)
+        return;
+
+    int64_t m = B.m();
+    int64_t n = B.n();
+    int64_t na = A.n();
+    int64_t lda = std::max( na, int64_t( 1 ) );
+    int64_t ldb = std::max( m, int64_t( 1 ) );
+    std::vector<scalar_t> Adata( lda*na ), Bdata( ldb*n );
+    internal::small_gather( A, Adata.data(), lda );
+    internal::small_gather( B, Bdata.data(), ldb );
+
+    // The gathered A is op(A), with the uplo of op(A).
+    blas::trsm( Layout::ColMajor, side, A.uplo(), Op::NoTrans, A.diag(),
+                m, n, alpha, Adata.data(), lda, Bdata.data(), ldb );
+
+    internal::small_scatter( B, Bdata.data(), ldb );
+}
+
 //------------------------------------------------------------------------------
 /// Distributed parallel triangular matrix-matrix solve.
 /// Solves one of the triangular matrix equations
@@ -68,9 +150,18 @@ inline MethodTrsm select_algo( TA& A, TB& B, Options const& opts )
 ///           lookahead >= 0. Default 1.
 ///         - Option::MethodTrsm:
 ///           Select the right routine to call. Possible values:
-///           - Auto: let the routine decides [default]
+///           - Auto: let the routine decide, by a cost model of
+///             communication and computation [default]. If
+///             Option::PrintVerbose >= 1, rank 0 prints the method
+///             chosen and the estimated times.
 ///           - trsmA: select trsmA routine
 ///           - trsmB: select trsmB routine
+///           - Inv: select trsmInv routine, for B with few columns
+///         - Option::SmallTiles:
+///           With MethodTrsm::Auto and a host target, if A and B each
+///           have at most this many tiles, all on one rank, that rank
+///           calls BLAS trsm on them directly, without tasks. 0: off.
+///           Default 4.
 ///         - Option::Target:
 ///           Implementation to target. Possible values:
 ///           - HostTask:  OpenMP tasks on CPU host [default].
@@ -89,13 +180,23 @@ void trsm(blas::Side side,
     MethodTrsm method = get_option(
         opts, Option::MethodTrsm, MethodTrsm::Auto );
 
+    int owner;
+    if (method == MethodTrsm::Auto
+        && internal::small_path<scalar_t>( { &A, &B }, opts, &owner )) {
+        trsm_small( side, alpha, A, B, owner );
+        return;
+    }
+
     if (method == MethodTrsm::Auto)
-        method = select_algo( A, B, opts );
+        method = select_algo( side, A, B, opts );
 
     switch (method) {
         case MethodTrsm::A:
             trsmA( side, alpha, A, B, opts );
             break;
+        case MethodTrsm::Inv:
+            trsmInv( side, alpha, A, B, opts );
+            break;
         case MethodTrsm::Auto:
         case MethodTrsm::B:
             trsmB( side, alpha, A, B, opts );
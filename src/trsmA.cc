@@ -24,7 +24,7 @@ void trsmA(
     Options const& opts )
 {
     // Options
-    int64_t lookahead = get_option<int64_t>(opts, Option::Lookahead, 1);
+    int64_t lookahead = get_lookahead( opts );
 
     if (target == Target::Devices) {
         if (A.num_devices() > 1)
@@ -133,7 +133,7 @@ void trsmA(
                              Matrix<scalar_t>& B,
     Options const& opts )
 {
-    Target target = get_option<Target>(opts, Option::Target, Target::HostTask);
+    Target target = get_target( opts, Target::HostTask );
 
     switch (target) {
         case Target::Host:
@@ -150,6 +150,7 @@ void trsmA(
             break;
 
         case Target::Devices:
+        case Target::Hybrid:
             impl::trsmA<Target::Devices>( side, alpha, A, B, opts );
             break;
     }
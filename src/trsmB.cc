@@ -24,7 +24,7 @@ void trsmB(
     Options const& opts )
 {
     // Options
-    int64_t lookahead = get_option<int64_t>( opts, Option::Lookahead, 1 );
+    int64_t lookahead = get_lookahead( opts );
 
     if (target == Target::Devices) {
         // Allocate batch arrays = number of kernels without
@@ -129,7 +129,7 @@ void trsmB(
                               Matrix<scalar_t>& B,
     Options const& opts )
 {
-    Target target = get_option( opts, Option::Target, Target::HostTask );
+    Target target = get_target( opts, Target::HostTask );
 
     switch (target) {
         case Target::Host:
@@ -146,6 +146,7 @@ void trsmB(
             break;
 
         case Target::Devices:
+        case Target::Hybrid:
             impl::trsmB<Target::Devices>( side, alpha, A, B, opts );
             break;
     }
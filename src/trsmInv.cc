@@ -0,0 +1,502 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/slate.hh"
+#include "internal/internal.hh"
+
+namespace slate {
+
+namespace impl {
+
+//------------------------------------------------------------------------------
+/// Distributed parallel triangular solve with inverted diagonal blocks,
+/// for B with few columns.
+/// Generic implementation for any target.
+///
+/// Block rows are grouped into blocks of w = lookahead + 1 block rows.
+/// Each rank owning part of a block row of B gathers the diagonal block
+/// A(K, K) of its group K once, in one packed broadcast for all groups,
+/// and inverts it locally with LAPACK trtri. The sweep then needs two
+/// packed broadcasts per group, instead of one broadcast per block row:
+/// B(K, :) to the ranks of B(K, :), which each compute their rows of
+/// X(K, :) = inv( A(K, K) ) B(K, :) with a local gemm, and X(K, :) with
+/// A(rest, K) to the trailing block rows, updated by gemms. The number of
+/// messages on the critical path drops from O(mt) to O(mt / w).
+///
+/// The local solve, inv( A(K, K) ) B(K, :), runs on the host; the
+/// trailing gemms run on the target. As for any explicit inverse,
+/// the error grows with the condition number of the diagonal blocks.
+/// @ingroup trsm_impl
+///
+template <Target target, typename scalar_t>
+void trsmInv(
+    Side side,
+    scalar_t alpha, TriangularMatrix<scalar_t> A,
+                              Matrix<scalar_t> B,
+    Options const& opts )
+{
+    using blas::conj;
+    using BcastList = typename Matrix<scalar_t>::BcastList;
+
+    // Constants
+    const scalar_t zero = 0.0;
+    const scalar_t one  = 1.0;
+    const int priority_0 = 0;
+    const int priority_1 = 1;
+    const int queue_0 = 0;
+    const int queue_1 = 1;
+    // Assumes column major
+    const Layout layout = Layout::ColMajor;
+
+    // Options
+    int64_t lookahead = get_lookahead( opts );
+    // If A's tiles are already resident on the ranks of B (see
+    // Factorization), the off-diagonal blocks are neither broadcast
+    // nor released.
+    bool resident = get_option<Option::FactorsResident>( opts, false );
+
+    // if on right, change to left by (conj)-transposing A and B to get
+    // op(B) = op(A)^{-1} * op(B)
+    if (side == Side::Right) {
+        if (A.op() == Op::ConjTrans || B.op() == Op::ConjTrans) {
+            A = conj_transpose( A );
+            B = conj_transpose( B );
+            alpha = conj( alpha );
+        }
+        else {
+            A = transpose( A );
+            B = transpose( B );
+        }
+    }
+
+    // B is mt-by-nt, A is mt-by-mt (assuming side = left)
+    assert( A.mt() == B.mt() );
+    assert( A.nt() == B.mt() );
+
+    int64_t mt = B.mt();
+    int64_t nt = B.nt();
+    bool lower = A.uplo() == Uplo::Lower;
+    Uplo uplo = A.uplo();
+    Diag diag = A.diag();
+
+    // Group K = b has block rows kb[ b ] : kb[ b+1 ]-1.
+    int64_t w = lookahead + 1;
+    int64_t nblk = ceildiv( mt, w );
+    std::vector<int64_t> kb( nblk + 1 );
+    for (int64_t b = 0; b < nblk; ++b)
+        kb[ b ] = b*w;
+    kb[ nblk ] = mt;
+
+    // Row offset of each block row within its group.
+    std::vector<int64_t> offset( mt );
+    std::vector<int64_t> group_m( nblk, 0 );
+    for (int64_t b = 0; b < nblk; ++b) {
+        for (int64_t k = kb[ b ]; k < kb[ b+1 ]; ++k) {
+            offset[ k ] = group_m[ b ];
+            group_m[ b ] += B.tileMb( k );
+        }
+    }
+
+    // Whether this rank owns part of block rows K of B.
+    auto owns_group = [&]( int64_t b ) {
+        for (int64_t k = kb[ b ]; k < kb[ b+1 ]; ++k)
+            for (int64_t j = 0; j < nt; ++j)
+                if (B.tileIsLocal( k, j ))
+                    return true;
+        return false;
+    };
+
+    if (target == Target::Devices) {
+        // Queue 0 for the trailing update, 1 for the lookahead update.
+        const int64_t batch_size_default = 0;
+        int num_queues = 2;
+        B.allocateBatchArrays( batch_size_default, num_queues );
+        B.reserveDeviceWorkspace();
+    }
+
+    //----------------------------------------
+    // Gather the diagonal blocks A(K, K) of all groups to the ranks of
+    // B(K, :) in one packed broadcast, then invert each one locally.
+    BcastList bcast_list_D;
+    for (int64_t b = 0; b < nblk; ++b) {
+        for (int64_t l = kb[ b ]; l < kb[ b+1 ]; ++l) {
+            int64_t i_begin = lower ? l : kb[ b ];
+            int64_t i_end   = lower ? kb[ b+1 ] : l+1;
+            for (int64_t i = i_begin; i < i_end; ++i) {
+                bcast_list_D.push_back(
+                    { i, l, { B.sub( kb[ b ], kb[ b+1 ]-1, 0, nt-1 ) } } );
+            }
+        }
+    }
+    A.template listBcastPacked<Target::Host>( bcast_list_D, layout );
+
+    // Ainv[ b ] is the group_m[ b ]-by-group_m[ b ] column-major inverse
+    // of A(K, K), with zeros in its other triangle; empty if not needed.
+    std::vector< std::vector<scalar_t> > Ainv( nblk );
+    int64_t singular = 0;
+
+    #pragma omp parallel for schedule(dynamic, 1) reduction(max:singular)
+    for (int64_t b = 0; b < nblk; ++b) {
+        if (! owns_group( b ))
+            continue;
+
+        int64_t mk = group_m[ b ];
+        Ainv[ b ].assign( mk*mk, zero );
+        scalar_t* T = Ainv[ b ].data();
+        for (int64_t l = kb[ b ]; l < kb[ b+1 ]; ++l) {
+            int64_t i_begin = lower ? l : kb[ b ];
+            int64_t i_end   = lower ? kb[ b+1 ] : l+1;
+            for (int64_t i = i_begin; i < i_end; ++i) {
+                if (A.tileIsZero( i, l ))
+                    continue;
+                A.tileGetForReading( i, l, LayoutConvert( layout ) );
+                Tile<scalar_t> T_il(
+                    A.tileMb( i ), A.tileNb( l ),
+                    &T[ offset[ i ] + offset[ l ]*mk ], mk,
+                    HostNum, TileKind::UserOwned );
+                tile::gecopy( A( i, l ), T_il );
+            }
+        }
+        // Clear the other triangle of the diagonal tiles; set a unit
+        // diagonal, which trtri neither reads nor writes.
+        for (int64_t jj = 0; jj < mk; ++jj) {
+            int64_t ii_begin = lower ? 0  : jj+1;
+            int64_t ii_end   = lower ? jj : mk;
+            for (int64_t ii = ii_begin; ii < ii_end; ++ii)
+                T[ ii + jj*mk ] = zero;
+            if (diag == Diag::Unit)
+                T[ jj + jj*mk ] = one;
+        }
+        int64_t info = lapack::trtri( uplo, diag, mk, T, mk );
+        singular = std::max( singular, info );
+    }
+    // trtri leaves a singular block as is, so it can't be solved with.
+    // All ranks agree, so none is left waiting in the sweep.
+    slate_mpi_call(
+        MPI_Allreduce( MPI_IN_PLACE, &singular, 1, MPI_INT64_T, MPI_MAX,
+                       B.mpiComm() ) );
+    if (singular > 0)
+        slate_error( "trsmInv: A has a zero on its diagonal" );
+
+    if (! resident) {
+        for (int64_t b = 0; b < nblk; ++b) {
+            auto A_diag = A.sub( kb[ b ], kb[ b+1 ]-1 );
+            A_diag.releaseRemoteWorkspace();
+            A_diag.releaseLocalWorkspace();
+        }
+    }
+
+    // OpenMP needs pointer types, but vectors are exception safe
+    std::vector< uint8_t > group_vector( nblk );
+    uint8_t* group = group_vector.data();
+    SLATE_UNUSED( group ); // Used only by OpenMP
+
+    // set min number for omp nested active parallel regions
+    slate::OmpSetMaxActiveLevels set_active_levels( MinOmpActiveLevels );
+
+    #pragma omp parallel
+    #pragma omp master
+    {
+        for (int64_t s = 0; s < nblk; ++s) {
+            // Forward sweep if lower, backward sweep if upper.
+            int64_t b  = lower ? s : nblk-1 - s;
+            int64_t k0 = kb[ b ];
+            int64_t k1 = kb[ b+1 ];
+            scalar_t alph = s == 0 ? alpha : one;
+
+            // Rows updated by group b: below it if lower, above it if upper.
+            int64_t r0 = lower ? k1 : 0;
+            int64_t r1 = lower ? mt : k0;
+
+            // Lookahead group, next in the sweep, and the rest of the rows.
+            int64_t b_la = lower ? b+1 : b-1;
+            bool has_la = s+1 < nblk;
+            bool has_rest = s+2 < nblk;
+            int64_t b_rest = lower ? b+2 : b-2;
+            int64_t b_last = lower ? nblk-1 : 0;
+            int64_t la0 = 0, la1 = 0, rest0 = 0, rest1 = 0;
+            if (has_la) {
+                la0 = kb[ b_la ];
+                la1 = kb[ b_la+1 ];
+            }
+            if (has_rest) {
+                rest0 = lower ? kb[ b+2 ] : 0;
+                rest1 = lower ? mt : kb[ b-1 ];
+            }
+
+            // panel: solve the group, then send it to the trailing rows
+            #pragma omp task depend(inout:group[ b ]) priority(1) \
+                             firstprivate(b, k0, k1, r0, r1, alph)
+            {
+                // send B(K, j) to the ranks owning the rest of B(K, j)
+                BcastList bcast_list_BK;
+                for (int64_t k = k0; k < k1; ++k) {
+                    for (int64_t j = 0; j < nt; ++j) {
+                        bcast_list_BK.push_back(
+                            { k, j, { B.sub( k0, k1-1, j, j ) } } );
+                    }
+                }
+                B.template listBcastPacked<Target::Host>(
+                    bcast_list_BK, layout );
+
+                // X(K, j) = alpha inv( A(K, K) ) B(K, j), each rank
+                // computing its own tiles from a copy of B(K, j).
+                int64_t mk = group_m[ b ];
+                for (int64_t j = 0; j < nt; ++j) {
+                    bool local = false;
+                    for (int64_t k = k0; k < k1; ++k)
+                        local = local || B.tileIsLocal( k, j );
+                    if (! local)
+                        continue;
+
+                    int64_t nb = B.tileNb( j );
+                    std::vector<scalar_t> BK( mk*nb, zero );
+                    for (int64_t l = k0; l < k1; ++l) {
+                        if (B.tileIsZero( l, j ))
+                            continue;
+                        B.tileGetForReading( l, j, LayoutConvert( layout ) );
+                        Tile<scalar_t> BK_l(
+                            B.tileMb( l ), nb, &BK[ offset[ l ] ], mk,
+                            HostNum, TileKind::UserOwned );
+                        tile::gecopy( B( l, j ), BK_l );
+                    }
+                    for (int64_t k = k0; k < k1; ++k) {
+                        if (! B.tileIsLocal( k, j ))
+                            continue;
+                        int64_t mb = B.tileMb( k );
+                        std::vector<scalar_t> X( mb*nb );
+                        blas::gemm( Layout::ColMajor, Op::NoTrans, Op::NoTrans,
+                                    mb, nb, mk,
+                                    alph, &Ainv[ b ][ offset[ k ] ], mk,
+                                          BK.data(), mk,
+                                    zero, X.data(), mb );
+                        B.tileGetForWriting( k, j, LayoutConvert( layout ) );
+                        Tile<scalar_t> X_k(
+                            mb, nb, X.data(), mb,
+                            HostNum, TileKind::UserOwned );
+                        auto B_kj = B( k, j );
+                        tile::gecopy( X_k, B_kj );
+                    }
+                }
+
+                // The received copies of B(K, :) are now stale.
+                auto B_group = B.sub( k0, k1-1, 0, nt-1 );
+                B_group.releaseRemoteWorkspace();
+
+                if (r0 < r1) {
+                    // send A(i, K) to ranks owning block row B(i, :)
+                    // for the rows i updated by group K
+                    if (! resident) {
+                        BcastList bcast_list_A;
+                        for (int64_t l = k0; l < k1; ++l) {
+                            for (int64_t i = r0; i < r1; ++i) {
+                                bcast_list_A.push_back(
+                                    { i, l, { B.sub( i, i, 0, nt-1 ) } } );
+                            }
+                        }
+                        A.template listBcastPacked<target>(
+                            bcast_list_A, layout );
+                    }
+
+                    // send X(K, j) to ranks owning block col B(r0:r1-1, j)
+                    BcastList bcast_list_X;
+                    for (int64_t k = k0; k < k1; ++k) {
+                        for (int64_t j = 0; j < nt; ++j) {
+                            bcast_list_X.push_back(
+                                { k, j, { B.sub( r0, r1-1, j, j ) } } );
+                        }
+                    }
+                    B.template listBcastPacked<target>(
+                        bcast_list_X, layout );
+                }
+            }
+
+            // lookahead update of the next group,
+            // B(la, :) -= A(la, K) X(K, :)
+            if (has_la) {
+                #pragma omp task depend(in:group[ b ]) \
+                                 depend(inout:group[ b_la ]) priority(1) \
+                                 firstprivate(k0, k1, la0, la1, alph)
+                {
+                    for (int64_t l = k0; l < k1; ++l) {
+                        scalar_t beta = l == k0 ? alph : one;
+                        internal::gemm<target>(
+                            -one, A.sub( la0, la1-1, l, l ),
+                                  B.sub( l, l, 0, nt-1 ),
+                            beta, B.sub( la0, la1-1, 0, nt-1 ),
+                            layout, priority_1, queue_1 );
+                    }
+                }
+            }
+
+            // trailing update of the rest of the rows,
+            // B(rest, :) -= A(rest, K) X(K, :)
+            // Two depends are sufficient: b_rest is all that is needed
+            // by the next lookahead; b_last daisy chains the trailing updates.
+            if (has_rest) {
+                #pragma omp task depend(in:group[ b ]) \
+                                 depend(inout:group[ b_rest ]) \
+                                 depend(inout:group[ b_last ]) \
+                                 firstprivate(k0, k1, rest0, rest1, alph)
+                {
+                    for (int64_t l = k0; l < k1; ++l) {
+                        scalar_t beta = l == k0 ? alph : one;
+                        internal::gemm<target>(
+                            -one, A.sub( rest0, rest1-1, l, l ),
+                                  B.sub( l, l, 0, nt-1 ),
+                            beta, B.sub( rest0, rest1-1, 0, nt-1 ),
+                            layout, priority_0, queue_0 );
+                    }
+                }
+            }
+
+            // Erase remote or workspace tiles.
+            #pragma omp task depend(inout:group[ b ]) \
+                             firstprivate(k0, k1, r0, r1)
+            {
+                if (! resident && r0 < r1) {
+                    auto A_panel = A.sub( r0, r1-1, k0, k1-1 );
+                    A_panel.releaseRemoteWorkspace();
+                    A_panel.releaseLocalWorkspace();
+                }
+
+                auto B_panel = B.sub( k0, k1-1, 0, nt-1 );
+                B_panel.releaseRemoteWorkspace();
+
+                // Copy back modifications to tiles in the B panel
+                // before they are erased.
+                B_panel.tileUpdateAllOrigin();
+                B_panel.releaseLocalWorkspace();
+            }
+        }
+
+        #pragma omp taskwait
+        B.tileUpdateAllOrigin();
+    }
+    B.releaseWorkspace();
+}
+
+} // namespace impl
+
+//------------------------------------------------------------------------------
+/// Distributed parallel triangular matrix-matrix solve, for B with few
+/// columns, e.g., nrhs <= 16.
+/// Solves one of the triangular matrix equations
+/// \[
+///     A X = \alpha B,
+/// \]
+/// or
+/// \[
+///     X A = \alpha B,
+/// \]
+/// where alpha is a scalar, B is an m-by-n matrix and A is a unit or non-unit,
+/// upper or lower triangular matrix. The matrix X overwrites B.
+///
+/// The diagonal blocks of A, of lookahead + 1 block rows each, are
+/// inverted once, and the solve proceeds by gemm, sending the block rows
+/// of B in aggregated messages, one group at a time. Compared to trsmB,
+/// this cuts the messages on the critical path by a factor of
+/// lookahead + 1, at the cost of the inverses, each of which is computed
+/// redundantly on the ranks owning its block rows of B.
+///
+/// Complexity (in real): $m^{2} n$ flops, plus about $m w^2 nb^3 / 3$ flops
+/// for the inverses, where w = lookahead + 1.
+///
+//------------------------------------------------------------------------------
+/// @tparam scalar_t
+///         One of float, double, std::complex<float>, std::complex<double>.
+//------------------------------------------------------------------------------
+/// @param[in] side
+///         Whether A appears on the left or on the right of X:
+///         - Side::Left:  solve $A X = \alpha B$
+///         - Side::Right: solve $X A = \alpha B$
+///
+/// @param[in] alpha
+///         The scalar alpha.
+///
+/// @param[in] A
+///         - If side = left,  the m-by-m triangular matrix A;
+///         - if side = right, the n-by-n triangular matrix A.
+///
+/// @param[in,out] B
+///         On entry, the m-by-n matrix B.
+///         On exit, overwritten by the result X.
+///
+/// @param[in] opts
+///         Additional options, as map of name = value pairs. Possible options:
+///         - Option::Lookahead:
+///           Number of panels to overlap with matrix updates; the diagonal
+///           blocks have lookahead + 1 block rows.
+///           lookahead >= 0. Default 1.
+///         - Option::Target:
+///           Implementation to target. Possible values:
+///           - HostTask:  OpenMP tasks on CPU host [default].
+///           - HostNest:  nested OpenMP parallel for loop on CPU host.
+///           - HostBatch: batched BLAS on CPU host.
+///           - Devices:   batched BLAS on GPU device.
+///
+/// @ingroup trsm
+///
+template <typename scalar_t>
+void trsmInv(
+    blas::Side side,
+    scalar_t alpha, TriangularMatrix<scalar_t>& A,
+                              Matrix<scalar_t>& B,
+    Options const& opts )
+{
+    Target target = get_target( opts, Target::HostTask );
+
+    switch (target) {
+        case Target::Host:
+        case Target::HostTask:
+            impl::trsmInv<Target::HostTask>( side, alpha, A, B, opts );
+            break;
+
+        case Target::HostNest:
+            impl::trsmInv<Target::HostNest>( side, alpha, A, B, opts );
+            break;
+
+        case Target::HostBatch:
+            impl::trsmInv<Target::HostBatch>( side, alpha, A, B, opts );
+            break;
+
+        case Target::Devices:
+        case Target::Hybrid:
+            impl::trsmInv<Target::Devices>( side, alpha, A, B, opts );
+            break;
+    }
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void trsmInv<float>(
+    blas::Side side,
+    float alpha, TriangularMatrix<float>& A,
+                           Matrix<float>& B,
+    Options const& opts);
+
+template
+void trsmInv<double>(
+    blas::Side side,
+    double alpha, TriangularMatrix<double>& A,
+                            Matrix<double>& B,
+    Options const& opts);
+
+template
+void trsmInv< std::complex<float> >(
+    blas::Side side,
+    std::complex<float> alpha, TriangularMatrix< std::complex<float> >& A,
+                                         Matrix< std::complex<float> >& B,
+    Options const& opts);
+
+template
+void trsmInv< std::complex<double> >(
+    blas::Side side,
+    std::complex<double> alpha, TriangularMatrix< std::complex<double> >& A,
+                                          Matrix< std::complex<double> >& B,
+    Options const& opts);
+
+} // namespace slate
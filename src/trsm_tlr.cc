@@ -0,0 +1,219 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/slate.hh"
+#include "internal/internal.hh"
+
+#include <algorithm>
+#include <set>
+#include <vector>
+
+namespace slate {
+
+//------------------------------------------------------------------------------
+/// Distributed parallel triangular solve with a tile low-rank (TLR) factor.
+/// Solves
+/// \[
+///     op(L) X = \alpha B,
+/// \]
+/// where alpha is a scalar, X and B are n-by-nrhs matrices, L is the
+/// lower triangular TLR factor from potrf, and op(L) is L or $L^H$.
+/// The matrix X overwrites B.
+///
+/// Diagonal tiles are solved as dense tiles. The updates of B by the
+/// off-diagonal tiles are applied in low-rank form, e.g.,
+/// $B_i = B_i - U_{ik} (V_{ik}^H X_k)$, costing $O( (mb + nb) r\, nrhs )$
+/// instead of $O( mb\, nb\, nrhs )$ flops per tile of rank r; the factors,
+/// not dense tiles, are broadcast to the ranks holding $B_i$.
+///
+/// To solve $A X = B$, call trsm with Op::NoTrans, then with Op::ConjTrans.
+///
+//------------------------------------------------------------------------------
+/// @tparam scalar_t
+///         One of float, double, std::complex<float>, std::complex<double>.
+//------------------------------------------------------------------------------
+/// @param[in] op
+///         - Op::NoTrans:   solve $L X = \alpha B$;
+///         - Op::ConjTrans: solve $L^H X = \alpha B$;
+///         - Op::Trans:     solve $L^T X = \alpha B$, only for real types.
+///
+/// @param[in] alpha
+///         The scalar alpha.
+///
+/// @param[in] L
+///         The n-by-n lower triangular TLR factor, from potrf.
+///
+/// @param[in,out] B
+///         On entry, the n-by-nrhs matrix B, with the same block rows as L.
+///         On exit, overwritten by the result X.
+///
+/// @param[in] opts
+///         Additional options, as map of name = value pairs.
+///         Currently unused; the solve is done on the host.
+///
+/// @ingroup posv_computational
+///
+template <typename scalar_t>
+void trsm(
+    Op op, scalar_t alpha,
+    TLRMatrix<scalar_t>& L,
+       Matrix<scalar_t>& B,
+    Options const& opts )
+{
+    trace::Block trace_block( "slate::trsm" );
+
+    using ij_tuple = typename BaseMatrix<scalar_t>::ij_tuple;
+    using BcastListL = typename TLRMatrix<scalar_t>::BcastList;
+    using BcastListB = typename Matrix<scalar_t>::BcastList;
+
+    const scalar_t zero = 0.0, one = 1.0;
+
+    if (op == Op::Trans && is_complex<scalar_t>::value)
+        slate_not_implemented( "trsm: Op::Trans of a complex TLR factor" );
+    bool forward = op == Op::NoTrans;
+
+    slate_assert( L.nt() == B.mt() );
+    slate_assert( B.op() == Op::NoTrans );
+
+    auto& D = L.diag();
+    int64_t nt = L.nt();
+    int64_t B_nt = B.nt();
+
+    for (int64_t s = 0; s < nt; ++s) {
+        // Forward solve goes down the block rows, backward solve goes up.
+        int64_t k = forward ? s : nt-1 - s;
+        scalar_t alph = s == 0 ? alpha : one;
+
+        // Block rows of B updated by X_k.
+        int64_t i1 = forward ? k+1 : 0;
+        int64_t i2 = forward ? nt-1 : k-1;
+
+        // Solve block row k, X_k = alph op( L_kk )^{-1} B_k.
+        D.tileBcast( k, k, B.sub( k, k, 0, B_nt-1 ), Layout::ColMajor );
+        std::vector<int64_t> cols;
+        for (int64_t l = 0; l < B_nt; ++l) {
+            if (B.tileIsLocal( k, l ))
+                cols.push_back( l );
+        }
+        if (! cols.empty()) {
+            D.tileGetForReading( k, k, LayoutConvert::ColMajor );
+            auto Lkk = D( k, k );
+            #pragma omp parallel for schedule( dynamic, 1 )
+            for (size_t t = 0; t < cols.size(); ++t) {
+                int64_t l = cols[ t ];
+                B.tileGetForWriting( k, l, LayoutConvert::ColMajor );
+                auto Bkl = B( k, l );
+                blas::trsm( blas::Layout::ColMajor,
+                            Side::Left, Uplo::Lower,
+                            forward ? Op::NoTrans : Op::ConjTrans,
+                            Diag::NonUnit,
+                            Bkl.mb(), Bkl.nb(),
+                            alph, Lkk.data(), Lkk.stride(),
+                                  Bkl.data(), Bkl.stride() );
+            }
+        }
+
+        if (i1 <= i2) {
+            // Send X_k to the ranks of the block rows it updates, and
+            // the factors of L_ik (forward) or L_ki (backward)
+            // to the ranks of block row i.
+            BcastListB bcast_list_B;
+            for (int64_t l = 0; l < B_nt; ++l)
+                bcast_list_B.push_back( { k, l, { B.sub( i1, i2, l, l ) } } );
+            B.listBcast( bcast_list_B, Layout::ColMajor );
+
+            BcastListL bcast_list_L;
+            for (int64_t i = i1; i <= i2; ++i) {
+                std::set<int> ranks;
+                for (int64_t l = 0; l < B_nt; ++l)
+                    ranks.insert( B.tileRank( i, l ) );
+                if (forward)
+                    bcast_list_L.push_back( { i, k, ranks } );
+                else
+                    bcast_list_L.push_back( { k, i, ranks } );
+            }
+            L.listBcast( bcast_list_L );
+
+            // Update the local tiles, forward
+            //     B_il = alph B_il - U_ik (V_ik^H X_kl),
+            // or backward
+            //     B_il = alph B_il - V_ki (U_ki^H X_kl).
+            std::vector<ij_tuple> update;
+            for (int64_t i = i1; i <= i2; ++i) {
+                for (int64_t l = 0; l < B_nt; ++l) {
+                    if (B.tileIsLocal( i, l ))
+                        update.push_back( { i, l } );
+                }
+            }
+            #pragma omp parallel for schedule( dynamic, 1 )
+            for (size_t t = 0; t < update.size(); ++t) {
+                int64_t i = std::get<0>( update[ t ] );
+                int64_t l = std::get<1>( update[ t ] );
+                auto& Lt = forward ? L.tile( i, k ) : L.tile( k, i );
+                scalar_t const* Z = forward ? Lt.V() : Lt.U();
+                scalar_t const* Y = forward ? Lt.U() : Lt.V();
+                int64_t ldz = forward ? Lt.ldv() : Lt.ldu();
+                int64_t ldy = forward ? Lt.ldu() : Lt.ldv();
+                int64_t r = Lt.rank();
+
+                B.tileGetForReading( k, l, LayoutConvert::ColMajor );
+                B.tileGetForWriting( i, l, LayoutConvert::ColMajor );
+                auto Xkl = B( k, l );
+                auto Bil = B( i, l );
+
+                // W = Z^H X_kl, then B_il = alph B_il - Y W.
+                // With r = 0, this only scales B_il.
+                int64_t ldw = std::max( r, int64_t( 1 ) );
+                std::vector<scalar_t> W( ldw * Bil.nb() );
+                blas::gemm( blas::Layout::ColMajor, Op::ConjTrans, Op::NoTrans,
+                            r, Bil.nb(), Xkl.mb(),
+                            one,  Z, ldz,
+                                  Xkl.data(), Xkl.stride(),
+                            zero, W.data(), ldw );
+                blas::gemm( blas::Layout::ColMajor, Op::NoTrans, Op::NoTrans,
+                            Bil.mb(), Bil.nb(), r,
+                            -one, Y, ldy,
+                                  W.data(), ldw,
+                            alph, Bil.data(), Bil.stride() );
+            }
+
+            B.sub( k, k, 0, B_nt-1 ).releaseRemoteWorkspace();
+        }
+
+        L.releaseRemoteTiles();
+    }
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void trsm<float>(
+    Op op, float alpha,
+    TLRMatrix<float>& L,
+       Matrix<float>& B,
+    Options const& opts);
+
+template
+void trsm<double>(
+    Op op, double alpha,
+    TLRMatrix<double>& L,
+       Matrix<double>& B,
+    Options const& opts);
+
+template
+void trsm< std::complex<float> >(
+    Op op, std::complex<float> alpha,
+    TLRMatrix< std::complex<float> >& L,
+       Matrix< std::complex<float> >& B,
+    Options const& opts);
+
+template
+void trsm< std::complex<double> >(
+    Op op, std::complex<double> alpha,
+    TLRMatrix< std::complex<double> >& L,
+       Matrix< std::complex<double> >& B,
+    Options const& opts);
+
+} // namespace slate
@@ -16,7 +16,8 @@ namespace impl {
 //------------------------------------------------------------------------------
 /// Distributed parallel inverse of a triangular matrix.
 /// Generic implementation for any target.
-/// Panel and lookahead computed on host using Host OpenMP task.
+/// For target = Devices, the panel trsm, lookahead gemm, and diagonal block
+/// inversion also run on devices; otherwise they use Host OpenMP tasks.
 /// @ingroup trtri_impl
 ///
 template <Target target, typename scalar_t>
@@ -28,12 +29,19 @@ void trtri(
 
     const scalar_t one = 1.0;
     const int64_t priority_0 = 0;
+    const int64_t queue_0 = 0;
+    const int64_t queue_1 = 1;
+    const int64_t queue_2 = 2;
 
     // Assumes column major
     const Layout layout = Layout::ColMajor;
+    // Host targets other than HostTask lack diagonal tile routines.
+    const Target target_diag = (target == Target::Devices ? Target::Devices
+                                                           : Target::HostTask);
 
     // Options
-    int64_t lookahead = get_option<int64_t>( opts, Option::Lookahead, 1 );
+    int64_t lookahead = get_lookahead( opts );
+    bool device_stealing = get_option<Option::DeviceStealing>( opts, false );
 
     // if upper, change to lower
     if (A.uplo() == Uplo::Upper) {
@@ -52,8 +60,13 @@ void trtri(
     int tag = 0;
 
     if (target == Target::Devices) {
-        A.allocateBatchArrays();
+        // Queue 0 for the trailing update, 1 for the column trsm,
+        // 2 for the diagonal block, 3 + j for the lookahead row j.
+        const int64_t batch_size_default = 0;
+        int num_queues = 3 + lookahead;
+        A.allocateBatchArrays( batch_size_default, num_queues );
         A.reserveDeviceWorkspace();
+        A.setDeviceStealing( device_stealing );
     }
 
     // set min number for omp nested active parallel regions
@@ -70,10 +83,10 @@ void trtri(
                 A.tileBcast(0, 0, A.sub(1, A_nt-1, 0, 0), layout, tag);
 
                 // A(1:nt-1, 0) * A(0, 0)^{-H}
-                internal::trsm<Target::HostTask>(
+                internal::trsm<target>(
                     Side::Right,
                     -one, A.sub(0, 0), A.sub(1, A_nt-1, 0, 0),
-                    priority_0, layout );
+                    priority_0, layout, queue_1 );
             }
             ++tag;
 
@@ -97,7 +110,7 @@ void trtri(
         // invert A(0, 0)
         #pragma omp task depend(inout:col[0])
         {
-            internal::trtri<Target::HostTask>(A.sub(0, 0));
+            internal::trtri<target_diag>(A.sub(0, 0), priority_0, queue_2);
         }
 
         // next lookahead columns trsms
@@ -110,10 +123,10 @@ void trtri(
                 A.tileBcast(k, k, A.sub(k+1, A_nt-1, k, k), layout, tag);
 
                 // leading column trsm, A(k+1:nt-1, k) * A(k, k)^{-H}
-                internal::trsm<Target::HostTask>(
+                internal::trsm<target>(
                     Side::Right,
                     -one, A.sub(k, k), A.sub(k+1, A_nt-1, k, k),
-                    priority_0, layout );
+                    priority_0, layout, queue_1 );
 
                 // send leading column to the left
                 BcastList bcast_list_A;
@@ -142,12 +155,12 @@ void trtri(
 
                     // leading column trsm,
                     // A(k+1+la:nt-1, k+la) * A(k+la, k+la)^{-H}
-                    internal::trsm<Target::HostTask>(
+                    internal::trsm<target>(
                         Side::Right,
                         -one, A.sub(k+lookahead, k+lookahead),
                               A.sub(k+1+lookahead, A_nt-1,
                                     k+lookahead, k+lookahead),
-                        priority_0, layout );
+                        priority_0, layout, queue_1 );
 
                     // send leading column to the left
                     BcastList bcast_list_A;
@@ -173,11 +186,12 @@ void trtri(
                                  depend(inout:row[i]) firstprivate(tag)
                 {
                     // A(i, 0:k-1) += A(i, k) * A(k, 0:k-1)
-                    internal::gemm<Target::HostTask>(
+                    int64_t queue_ik = i-k+2;
+                    internal::gemm<target>(
                         one, A.sub(i, i, k, k),
                              A.sub(k, k, 0, k-1),
                         one, A.sub(i, i, 0, k-1),
-                        layout, priority_0 );
+                        layout, priority_0, queue_ik );
 
                     if (i+1 < A_nt) {
                         // send the row down
@@ -205,7 +219,7 @@ void trtri(
                         one, A.sub(k+1+lookahead, A_nt-1, k, k),
                              A.sub(k, k, 0, k-1),
                         one, A.sub(k+1+lookahead, A_nt-1, 0, k-1),
-                        layout, priority_0 );
+                        layout, priority_0, queue_0 );
                 }
 
                 if (k+2+lookahead < A_nt) {
@@ -230,13 +244,13 @@ void trtri(
                 A.tileBcast(k, k, A.sub(k, k, 0, k-1), layout, tag);
 
                 // solve A(k, k) A(k, :) = A(k, 0:k-1)
-                internal::trsm<Target::HostTask>(
+                internal::trsm<target>(
                     Side::Left,
                     one, A.sub(k, k), A.sub(k, k, 0, k-1),
-                    priority_0, layout );
+                    priority_0, layout, queue_2 );
 
                 // invert A(k, k)
-                internal::trtri<Target::HostTask>(A.sub(k, k));
+                internal::trtri<target_diag>(A.sub(k, k), priority_0, queue_2);
             }
             ++tag;
 
@@ -257,6 +271,7 @@ void trtri(
         A.tileUpdateAllOrigin();
     }
 
+    A.setDeviceStealing( false );
     A.releaseWorkspace();
 }
 
@@ -288,7 +303,13 @@ void trtri(
 ///       - HostTask:  OpenMP tasks on CPU host [default].
 ///       - HostNest:  nested OpenMP parallel for loop on CPU host.
 ///       - HostBatch: batched BLAS on CPU host.
-///       - Devices:   batched BLAS on GPU device.
+///       - Devices:   batched BLAS on GPU device, including the panel,
+///         lookahead, and diagonal block inversion.
+///     - Option::DeviceStealing:
+///       With Target::Devices and several devices per rank, whether each
+///       batched gemm update balances its local tiles across the devices,
+///       instead of updating each tile on its tileDevice (@see potrf).
+///       Default false.
 ///
 /// TODO: return value
 /// @retval 0 successful exit
@@ -302,7 +323,7 @@ void trtri(
     TriangularMatrix<scalar_t>& A,
     Options const& opts )
 {
-    Target target = get_option( opts, Option::Target, Target::HostTask );
+    Target target = get_target( opts, Target::HostTask );
 
     switch (target) {
         case Target::Host:
@@ -319,6 +340,7 @@ void trtri(
             break;
 
         case Target::Devices:
+        case Target::Hybrid:
             impl::trtri<Target::Devices>( A, opts );
             break;
     }
@@ -14,11 +14,11 @@ namespace slate {
 namespace impl {
 
 //------------------------------------------------------------------------------
-///
-/// todo: update docs: multiply not inverse.
-///
-/// Distributed parallel inverse of a triangular matrix.
+/// Distributed parallel triangular multiplication $L = L^H L$.
 /// Generic implementation for any target.
+/// For target = Devices, the leading row trmm and diagonal block
+/// multiplication also run on devices; otherwise they use Host OpenMP tasks.
+/// The broadcasts of the next lookahead rows overlap the updates.
 /// @ingroup trtrm_impl
 ///
 template <Target target, typename scalar_t>
@@ -32,9 +32,17 @@ void trtrm(
     const scalar_t one = 1.0;
     const int64_t priority_0 = 0;
     const int64_t queue_0 = 0;
+    const int64_t queue_1 = 1;
+    const int64_t queue_2 = 2;
 
     // Assumes column major
     const Layout layout = Layout::ColMajor;
+    // Host targets other than HostTask lack diagonal tile routines.
+    const Target target_diag = (target == Target::Devices ? Target::Devices
+                                                           : Target::HostTask);
+
+    // Options
+    int64_t lookahead = get_lookahead( opts );
 
     // if upper, change to lower
     if (A.uplo() == Uplo::Upper) {
@@ -48,10 +56,25 @@ void trtrm(
     SLATE_UNUSED( row ); // Used only by OpenMP
 
     if (target == Target::Devices) {
-        A.allocateBatchArrays();
+        // Queue 0 for the herk, 1 for the leading row, 2 for the diagonal.
+        const int64_t batch_size_default = 0;
+        int num_queues = 3;
+        A.allocateBatchArrays( batch_size_default, num_queues );
         A.reserveDeviceWorkspace();
     }
 
+    // send leading row k up; row k is not modified until step k
+    auto bcast_row = [&]( int64_t k ) {
+        BcastList bcast_list_A;
+        for (int64_t j = 0; j < k; ++j) {
+            // send A(k, j) up column A(j:k-1, j)
+            // and across row A(j, 0:j)
+            bcast_list_A.push_back({k, j, {A.sub(j, k-1, j, j),
+                                           A.sub(j, j, 0, j)}});
+        }
+        A.template listBcast<target>(bcast_list_A, layout, 2*k);
+    };
+
     // set min number for omp nested active parallel regions
     slate::OmpSetMaxActiveLevels set_active_levels( MinOmpActiveLevels );
 
@@ -62,26 +85,31 @@ void trtrm(
         #pragma omp task depend(inout:row[0])
         {
             // A(0, 0) = A(0, 0)^H * A(0, 0)
-            internal::trtrm<Target::HostTask>(A.sub(0, 0));
+            internal::trtrm<target_diag>(A.sub(0, 0), priority_0, queue_2);
+        }
+
+        // send the lookahead rows up
+        for (int64_t k = 1; k < lookahead+1 && k < A_nt; ++k) {
+            #pragma omp task depend(inout:row[k])
+            {
+                bcast_row( k );
+            }
         }
 
         for (int64_t k = 1; k < A_nt; ++k) {
 
-            #pragma omp task depend(inout:row[0])
-            {
-                // send leading row up
-                BcastList bcast_list_A;
-                for (int64_t j = 0; j < k; ++j) {
-                    // send A(k, j) up column A(j:k-1, j)
-                    // and across row A(j, 0:j)
-                    bcast_list_A.push_back({k, j, {A.sub(j, k-1, j, j),
-                                                   A.sub(j, j, 0, j)}});
+            // send the next leading row up, after step k-1
+            // so at most lookahead rows are in flight
+            if (k+lookahead < A_nt) {
+                #pragma omp task depend(in:row[k-1]) \
+                                 depend(inout:row[k+lookahead])
+                {
+                    bcast_row( k+lookahead );
                 }
-                A.template listBcast(bcast_list_A, layout);
             }
 
             // update tailing submatrix
-            #pragma omp task depend(inout:row[0])
+            #pragma omp task depend(inout:row[0]) depend(in:row[k])
             {
                 // A(0:k-1, 0:k-1) += A(k, 0:k-1)^H * A(k, 0:k-1)
                 auto H = HermitianMatrix<scalar_t>(A);
@@ -96,25 +124,25 @@ void trtrm(
             }
 
             // multiply the leading row by the diagonal block
-            #pragma omp task depend(inout:row[0])
+            #pragma omp task depend(inout:row[0]) depend(inout:row[k])
             {
                 // send A(k, k) across row A(k, 0:k-1)
-                A.tileBcast(k, k, A.sub(k, k, 0, k-1), layout);
+                A.tileBcast(k, k, A.sub(k, k, 0, k-1), layout, 2*k+1);
 
                 // A(k, 0:k-1) = A(k, 0:k-1) * A(k, k)^H
                 auto Akk = A.sub(k, k);
                 Akk = conj_transpose( Akk );
-                internal::trmm<Target::HostTask>(
+                internal::trmm<target>(
                     Side::Left,
                     one, std::move( Akk ), A.sub(k, k, 0, k-1),
-                    priority_0 );
+                    priority_0, queue_1 );
             }
 
             // diagonal block, L = L^H L
             #pragma omp task depend(inout:row[0]) depend(inout:row[k])
             {
                 // A(k, k) = A(k, k)^H * A(k, k)
-                internal::trtrm<Target::HostTask>(A.sub(k, k));
+                internal::trtrm<target_diag>(A.sub(k, k), priority_0, queue_2);
             }
 
             #pragma omp task depend(inout:row[k])
@@ -136,26 +164,32 @@ void trtrm(
 } // namespace impl
 
 //------------------------------------------------------------------------------
-/// Distributed parallel inverse of a triangular matrix.
+/// Distributed parallel triangular multiplication.
 ///
-/// Computes the inverse of an upper or lower triangular matrix $A$.
+/// Computes the product $L^H L$ of a lower triangular matrix $L$, or
+/// $U U^H$ of an upper triangular matrix $U$, as in LAPACK lauum.
+/// The result overwrites the triangle of $A$.
 //------------------------------------------------------------------------------
 /// @tparam scalar_t
 ///     One of float, double, std::complex<float>, std::complex<double>.
 //------------------------------------------------------------------------------
 /// @param[in,out] A
 ///     On entry, the n-by-n triangular matrix $A$.
-///     On exit, if return value = 0, the (triangular) inverse of the original
-///     matrix $A$.
+///     On exit, the lower triangle of $L^H L$ or the upper triangle
+///     of $U U^H$.
 ///
 /// @param[in] opts
 ///     Additional options, as map of name = value pairs. Possible options:
+///     - Option::Lookahead:
+///       Number of rows to broadcast ahead of the updates.
+///       lookahead >= 0. Default 1.
 ///     - Option::Target:
 ///       Implementation to target. Possible values:
 ///       - HostTask:  OpenMP tasks on CPU host [default].
 ///       - HostNest:  nested OpenMP parallel for loop on CPU host.
 ///       - HostBatch: batched BLAS on CPU host.
-///       - Devices:   batched BLAS on GPU device.
+///       - Devices:   batched BLAS on GPU device, including the leading
+///         row and diagonal blocks.
 ///
 /// TODO: return value
 /// @retval 0 successful exit
@@ -167,7 +201,7 @@ void trtrm(
     TriangularMatrix<scalar_t>& A,
     Options const& opts )
 {
-    Target target = get_option( opts, Option::Target, Target::HostTask );
+    Target target = get_target( opts, Target::HostTask );
 
     switch (target) {
         case Target::Host:
@@ -184,6 +218,7 @@ void trtrm(
             break;
 
         case Target::Devices:
+        case Target::Hybrid:
             impl::trtrm<Target::Devices>( A, opts );
             break;
     }
@@ -33,11 +33,17 @@ void unmlq(
     const Layout layout = Layout::ColMajor;
     const int64_t tag_0 = 0;
 
+    // Options
+    int64_t lookahead = get_lookahead( opts );
+
     int64_t A_mt = A.mt();
     int64_t A_nt = A.nt();
     int64_t A_min_mtnt = std::min(A_mt, A_nt);
     int64_t C_mt = C.mt();
     int64_t C_nt = C.nt();
+    // The tt reductions use tags [tag_0, tag_0 + nt) for nt tiles
+    // across C; broadcasts use the next tag, so they can overlap.
+    const int tag_bcast = tag_0 + std::max( C_mt, C_nt );
 
     if (target == Target::Devices) {
         C.allocateBatchArrays();
@@ -65,6 +71,10 @@ void unmlq(
     std::vector< uint8_t > block_vector(A_mt);
     uint8_t* block = block_vector.data();
     SLATE_UNUSED( block ); // Used only by OpenMP
+    // Broadcasts of panels are tracked separately, to overlap them.
+    std::vector< uint8_t > panel_vector(A_mt);
+    uint8_t* panel = panel_vector.data();
+    SLATE_UNUSED( panel ); // Used only by OpenMP
 
     // set min number for omp nested active parallel regions
     slate::OmpSetMaxActiveLevels set_active_levels( MinOmpActiveLevels );
@@ -105,8 +115,16 @@ void unmlq(
             std::vector< int64_t > first_indices
                             = internal::gelqf_compute_first_indices(A_panel, k);
 
-            #pragma omp task depend(inout:block[k]) \
-                             depend(in:block[lastk])
+            // Broadcast panel k while previous steps are applied, at most
+            // lookahead steps ahead, that is, after step k_wait is applied.
+            // If there is no such step, k_wait = k, which nothing before
+            // this task writes, so there is no dependency.
+            int64_t k_wait = k - (lookahead + 1)*k_step;
+            if ((k_wait - k_begin)*k_step < 0)
+                k_wait = k;
+            #pragma omp task depend(inout:panel[k]) \
+                             depend(in:panel[lastk]) \
+                             depend(in:block[k_wait]) priority(1)
             {
                 // Indices for row or col of C.
                 int64_t i0 = -1, i1 = -1, j0 = -1, j1 = -1;
@@ -134,7 +152,7 @@ void unmlq(
                     bcast_list_V.push_back(
                         {k, j, {C.sub(i0, i1, j0, j1)}});
                 }
-                A.template listBcast<target>(bcast_list_V, layout);
+                A.template listBcast<target>( bcast_list_V, layout, tag_bcast );
 
                 // Send Tlocal(j) across row C(j, 0:nt-1) or col C(0:mt-1, j).
                 if (first_indices.size() > 0) {
@@ -151,7 +169,7 @@ void unmlq(
                         bcast_list_T.push_back(
                             {k, j, {C.sub(i0, i1, j0, j1)}});
                     }
-                    Tlocal.template listBcast(bcast_list_T, layout);
+                    Tlocal.template listBcast<target>( bcast_list_T, layout, tag_bcast );
                 }
 
                 // Send Treduce(j) across row C(j, 0:nt-1) or col C(0:mt-1, j).
@@ -173,9 +191,14 @@ void unmlq(
                                 {k, j, {C.sub(i0, i1, j0, j1)}});
                         }
                     }
-                    Treduce.template listBcast(bcast_list_T, layout);
+                    Treduce.template listBcast( bcast_list_T, layout, tag_bcast );
                 }
+            }
 
+            #pragma omp task depend(inout:block[k]) \
+                             depend(in:block[lastk]) \
+                             depend(in:panel[k])
+            {
                 Matrix<scalar_t> C_trail, W_trail;
                 if (side == Side::Left) {
                     C_trail = C.sub(k, C_mt-1, 0, C_nt-1);
@@ -303,6 +326,9 @@ void unmlq(
 ///
 /// @param[in] opts
 ///     Additional options, as map of name = value pairs. Possible options:
+///     - Option::Lookahead:
+///       Number of panels to broadcast ahead of their application.
+///       lookahead >= 0. Default 1.
 ///     - Option::Target:
 ///       Implementation to target. Possible values:
 ///       - HostTask:  OpenMP tasks on CPU host [default].
@@ -320,7 +346,7 @@ void unmlq(
     Matrix<scalar_t>& C,
     Options const& opts )
 {
-    Target target = get_option( opts, Option::Target, Target::HostTask );
+    Target target = get_target( opts, Target::HostTask );
 
     switch (target) {
         case Target::Host:
@@ -337,6 +363,7 @@ void unmlq(
             break;
 
         case Target::Devices:
+        case Target::Hybrid:
             impl::unmlq<Target::Devices>( side, op, A, T, C, opts  );
             break;
     }
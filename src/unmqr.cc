@@ -33,11 +33,26 @@ void unmqr(
     const Layout layout = Layout::ColMajor;
     const int64_t tag_0 = 0;
 
+    // Options
+    int64_t lookahead = get_lookahead( opts );
+
+    // Triangle-triangle reductions run on devices or on the host.
+    const Target target_tt = (target == Target::Devices ? Target::Devices
+                                                         : Target::HostTask);
+
     int64_t A_mt = A.mt();
     int64_t A_nt = A.nt();
     int64_t A_min_mtnt = std::min(A_mt, A_nt);
     int64_t C_mt = C.mt();
     int64_t C_nt = C.nt();
+    // The tt reductions use tags [tag_0, tag_0 + nt) for nt tiles
+    // across C; broadcasts use the next tag, so they can overlap.
+    const int tag_bcast = tag_0 + std::max( C_mt, C_nt );
+
+    // Must match the tree of geqrf.
+    int64_t arity = get_option<int64_t>( opts, Option::TreeArity, 2 );
+    if (arity < 2)
+        slate_error( "unmqr: TreeArity must be >= 2" );
 
     if (is_complex<scalar_t>::value && op == Op::Trans) {
         throw Exception("Complex numbers uses Op::ConjTrans, not Op::Trans.");
@@ -69,6 +84,10 @@ void unmqr(
     std::vector< uint8_t > block_vector(A_nt);
     uint8_t* block = block_vector.data();
     SLATE_UNUSED( block ); // Used only by OpenMP
+    // Broadcasts of panels are tracked separately, to overlap them.
+    std::vector< uint8_t > panel_vector(A_nt);
+    uint8_t* panel = panel_vector.data();
+    SLATE_UNUSED( panel ); // Used only by OpenMP
 
     // set min number for omp nested active parallel regions
     slate::OmpSetMaxActiveLevels set_active_levels( MinOmpActiveLevels );
@@ -109,8 +128,16 @@ void unmqr(
             std::vector< int64_t > first_indices
                             = internal::geqrf_compute_first_indices(A_panel, k);
 
-            #pragma omp task depend(inout:block[k]) \
-                             depend(in:block[lastk])
+            // Broadcast panel k while previous steps are applied, at most
+            // lookahead steps ahead, that is, after step k_wait is applied.
+            // If there is no such step, k_wait = k, which nothing before
+            // this task writes, so there is no dependency.
+            int64_t k_wait = k - (lookahead + 1)*k_step;
+            if ((k_wait - k_begin)*k_step < 0)
+                k_wait = k;
+            #pragma omp task depend(inout:panel[k]) \
+                             depend(in:panel[lastk]) \
+                             depend(in:block[k_wait]) priority(1)
             {
                 // Indices for row or col of C.
                 int64_t i0 = -1, i1 = -1, j0 = -1, j1 = -1;
@@ -138,7 +165,7 @@ void unmqr(
                     bcast_list_V.push_back(
                         {i, k, {C.sub(i0, i1, j0, j1)}});
                 }
-                A.template listBcast<target>(bcast_list_V, layout);
+                A.template listBcast<target>( bcast_list_V, layout, tag_bcast );
 
                 // Send Tlocal(i) across row C(i, 0:nt-1) or col C(0:mt-1, i).
                 if (first_indices.size() > 0) {
@@ -155,7 +182,7 @@ void unmqr(
                         bcast_list_T.push_back(
                             {i, k, {C.sub(i0, i1, j0, j1)}});
                     }
-                    Tlocal.template listBcast(bcast_list_T, layout);
+                    Tlocal.template listBcast<target>( bcast_list_T, layout, tag_bcast );
                 }
 
                 // Send Treduce(i) across row C(i, 0:nt-1) or col C(0:mt-1, i).
@@ -177,9 +204,14 @@ void unmqr(
                                 {i, k, {C.sub(i0, i1, j0, j1)}});
                         }
                     }
-                    Treduce.template listBcast(bcast_list_T, layout);
+                    Treduce.template listBcast( bcast_list_T, layout, tag_bcast );
                 }
+            }
 
+            #pragma omp task depend(inout:block[k]) \
+                             depend(in:block[lastk]) \
+                             depend(in:panel[k])
+            {
                 Matrix<scalar_t> C_trail, W_trail;
                 if (side == Side::Left) {
                     C_trail = C.sub(k, C_mt-1, 0, C_nt-1);
@@ -195,12 +227,12 @@ void unmqr(
                 // do ttmqr then unmqr.
                 if ((side == Side::Left) == (op == Op::NoTrans)) {
                     // Apply triangle-triangle reduction reflectors.
-                    internal::ttmqr<Target::HostTask>(
+                    internal::ttmqr<target_tt>(
                                     side, op,
                                     std::move(A_panel),
                                     Treduce.sub(k, A_mt-1, k, k),
                                     std::move(C_trail),
-                                    tag_0 );
+                                    tag_0, 0, arity );
                 }
 
                 // Apply local reflectors.
@@ -216,12 +248,12 @@ void unmqr(
                 // do unmqr then ttmqr.
                 if ((side == Side::Left) != (op == Op::NoTrans)) {
                     // Apply triangle-triangle reduction reflectors.
-                    internal::ttmqr<Target::HostTask>(
+                    internal::ttmqr<target_tt>(
                                     side, op,
                                     std::move(A_panel),
                                     Treduce.sub(k, A_mt-1, k, k),
                                     std::move(C_trail),
-                                    tag_0 );
+                                    tag_0, 0, arity );
                 }
             }
             #pragma omp task depend(in:block[k])
@@ -306,6 +338,12 @@ void unmqr(
 ///
 /// @param[in] opts
 ///     Additional options, as map of name = value pairs. Possible options:
+///     - Option::Lookahead:
+///       Number of panels to broadcast ahead of their application.
+///       lookahead >= 0. Default 1.
+///     - Option::TreeArity:
+///       Arity of the reduction tree, which must be the one geqrf used.
+///       Default 2.
 ///     - Option::Target:
 ///       Implementation to target. Possible values:
 ///       - HostTask:  OpenMP tasks on CPU host [default].
@@ -323,7 +361,7 @@ void unmqr(
     Matrix<scalar_t>& C,
     Options const& opts)
 {
-    Target target = get_option( opts, Option::Target, Target::HostTask );
+    Target target = get_target( opts, Target::HostTask );
 
     switch (target) {
         case Target::Host:
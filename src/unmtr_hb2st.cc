@@ -109,7 +109,7 @@ void unmtr_hb2st(Side side, Op op,
                  Matrix<scalar_t>& C,
                  const std::map<Option, Value>& opts)
 {
-    Target target = get_option( opts, Option::Target, Target::HostTask );
+    Target target = get_target( opts, Target::HostTask );
 
     switch (target) {
         case Target::Host:
@@ -121,6 +121,7 @@ void unmtr_hb2st(Side side, Op op,
         case Target::HostBatch:
             break;
         case Target::Devices:
+        case Target::Hybrid:
             impl::unmtr_hb2st<Target::Devices>( side, op, V, C, opts);
             break;
     }
@@ -5,6 +5,7 @@
 
 #include "slate/slate.hh"
 #include "internal/internal.hh"
+#include "internal/internal_util.hh"
 #include "work/work.hh"
 
 namespace slate {
@@ -63,11 +64,14 @@ void trsm(Side side, scalar_t alpha, TriangularMatrix<scalar_t> A,
     const int priority_1 = 1;
     const int queue_0 = 0;
     const int queue_1 = 1;
-    // Assumes column major
-    const Layout layout = Layout::ColMajor;
+    // Computes on row-major A and B in place, @see native_layout.
+    const Layout layout = internal::native_layout( target, A, B );
 
     // Options
-    int64_t lookahead = get_option<int64_t>( opts, Option::Lookahead, 1 );
+    int64_t lookahead = get_lookahead( opts );
+    // If A's tiles are already resident on the ranks of B (see
+    // Factorization), they are neither broadcast nor released.
+    bool resident = get_option<Option::FactorsResident>( opts, false );
 
     // if on right, change to left by (conj)-transposing A and B to get
     // op(B) = op(A)^{-1} * op(B)
@@ -106,7 +110,8 @@ void trsm(Side side, scalar_t alpha, TriangularMatrix<scalar_t> A,
             #pragma omp task depend(inout:row[k]) priority(1)
             {
                 // send A(k, k) to ranks owning block row B(k, :)
-                A.template tileBcast(k, k, B.sub(k, k, 0, nt-1), layout);
+                if (! resident)
+                    A.template tileBcast(k, k, B.sub(k, k, 0, nt-1), layout);
 
                 // solve A(k, k) B(k, :) = alpha B(k, :)
                 internal::trsm<target>(
@@ -119,7 +124,8 @@ void trsm(Side side, scalar_t alpha, TriangularMatrix<scalar_t> A,
                 BcastList bcast_list_A;
                 for (int64_t i = k+1; i < mt; ++i)
                     bcast_list_A.push_back({i, k, {B.sub(i, i, 0, nt-1)}});
-                A.template listBcast<target>(bcast_list_A, layout);
+                if (! resident)
+                    A.template listBcast<target>(bcast_list_A, layout);
 
                 // send B(k, j=0:nt-1) to ranks owning
                 // block col B(k+1:mt-1, j)
@@ -166,9 +172,11 @@ void trsm(Side side, scalar_t alpha, TriangularMatrix<scalar_t> A,
             // Erase remote or workspace tiles.
             #pragma omp task depend(inout:row[k])
             {
-                auto A_panel = A.sub(k, mt-1, k, k);
-                A_panel.releaseRemoteWorkspace();
-                A_panel.releaseLocalWorkspace();
+                if (! resident) {
+                    auto A_panel = A.sub(k, mt-1, k, k);
+                    A_panel.releaseRemoteWorkspace();
+                    A_panel.releaseLocalWorkspace();
+                }
 
                 auto B_panel = B.sub(k, k, 0, nt-1);
                 B_panel.releaseRemoteWorkspace();
@@ -191,7 +199,8 @@ void trsm(Side side, scalar_t alpha, TriangularMatrix<scalar_t> A,
             #pragma omp task depend(inout:row[k]) priority(1)
             {
                 // send A(k, k) to ranks owning block row B(k, :)
-                A.template tileBcast(k, k, B.sub(k, k, 0, nt-1), layout);
+                if (! resident)
+                    A.template tileBcast(k, k, B.sub(k, k, 0, nt-1), layout);
 
                 // solve A(k, k) B(k, :) = alpha B(k, :)
                 internal::trsm<target>(
@@ -204,7 +213,8 @@ void trsm(Side side, scalar_t alpha, TriangularMatrix<scalar_t> A,
                 BcastList bcast_list_A;
                 for (int64_t i = 0; i < k; ++i)
                     bcast_list_A.push_back({i, k, {B.sub(i, i, 0, nt-1)}});
-                A.template listBcast<target>(bcast_list_A, layout);
+                if (! resident)
+                    A.template listBcast<target>(bcast_list_A, layout);
 
                 // send B(k, j=0:nt-1) to ranks owning block col B(0:k-1, j)
                 BcastList bcast_list_B;
@@ -247,9 +257,11 @@ void trsm(Side side, scalar_t alpha, TriangularMatrix<scalar_t> A,
             // Erase remote or workspace tiles.
             #pragma omp task depend(inout:row[k])
             {
-                auto A_panel = A.sub(0, k, k, k);
-                A_panel.releaseRemoteWorkspace();
-                A_panel.releaseLocalWorkspace();
+                if (! resident) {
+                    auto A_panel = A.sub(0, k, k, k);
+                    A_panel.releaseRemoteWorkspace();
+                    A_panel.releaseLocalWorkspace();
+                }
 
                 auto B_panel = B.sub(k, k, 0, nt-1);
                 B_panel.releaseRemoteWorkspace();
@@ -69,7 +69,7 @@ void trsmA(Side side, scalar_t alpha, TriangularMatrix<scalar_t> A,
     const int queue_0 = 0;
     const int queue_1 = 1;
 
-    int64_t lookahead = get_option<int64_t>( opts, Option::Lookahead, 1 );
+    int64_t lookahead = get_lookahead( opts );
 
     // Assumes column major
     const Layout layout = Layout::ColMajor;
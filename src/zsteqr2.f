@@ -105,7 +105,7 @@
 *     ..
 *     .. External Subroutines ..
       EXTERNAL           DLAEV2, DLARTG, DLASCL, DSTERF, XERBLA, ZLASR,
-     $                   ZSWAP
+     $                   SLATE_ZLASR, ZSWAP
 *     ..
 *     .. Intrinsic Functions ..
       INTRINSIC          ABS, MAX, SIGN, SQRT
@@ -399,7 +399,7 @@
 *        If eigenvectors are desired, then apply saved rotations.
 *
          MM = M - L + 1
-         CALL ZLASR( 'R', 'V', 'B', NR, MM, WORK( L ), WORK( N-1+L ),
+         CALL SLATE_ZLASR( 'B', NR, MM, WORK( L ), WORK( N-1+L ),
      $               Z( 1, L ), LDZ )
 *
          D( L ) = D( L ) - P
@@ -584,7 +584,7 @@
 *        If eigenvectors are desired, then apply saved rotations.
 *
          MM = L - M + 1
-         CALL ZLASR( 'R', 'V', 'F', NR, MM, WORK( M ), WORK( N-1+M ),
+         CALL SLATE_ZLASR( 'F', NR, MM, WORK( M ), WORK( N-1+M ),
      $               Z( 1, M ), LDZ )
 *
          D( L ) = D( L ) - P
@@ -8,6 +8,7 @@
 
 #include "slate/BandMatrix.hh"
 #include "slate/HermitianBandMatrix.hh"
+#include "test.hh"
 
 //------------------------------------------------------------------------------
 // Returns local index for element i, or the next element after i if this rank
@@ -267,7 +268,7 @@ slate::HermitianBandMatrix<scalar_t> HermitianBandFromScaLAPACK(
     int p, int q, MPI_Comm comm)
 {
     auto A = slate::HermitianBandMatrix<scalar_t>(
-              uplo, n, kd, nb, p, q, MPI_COMM_WORLD);
+              uplo, n, kd, nb, p, q, tester_comm());
 
     int64_t kdt = slate::ceildiv(kd, nb);
 
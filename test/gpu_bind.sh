@@ -49,7 +49,13 @@ ndev=$(( ${ndev} < 1 ? 1 : ${ndev} ))
 
 dev=$(( ${local_rank} % ${ndev} ))
 visible_devices=${idle_gpus_array[ $dev ]}
-echo "local_rank ${local_rank}, gpu_kind ${gpu_kind}, idle_gpus_array ${idle_gpus_array[*]}, ndev ${ndev}, dev ${dev}, visible_devices ${visible_devices}, rank_var ${rank_var}"
+
+# With --panel-cores, getrf reserves the first cores of the rank's affinity
+# mask for panel and communication threads. Bind each rank near its GPU,
+# e.g., mpirun --map-by ppr:1:numa --bind-to numa, so those cores are close
+# to the GPU and NIC. The cores the rank may use are printed as cpus.
+cpus=$(grep Cpus_allowed_list /proc/self/status 2> /dev/null | cut -f2)
+echo "local_rank ${local_rank}, gpu_kind ${gpu_kind}, idle_gpus_array ${idle_gpus_array[*]}, ndev ${ndev}, dev ${dev}, visible_devices ${visible_devices}, rank_var ${rank_var}, cpus ${cpus}"
 
 if [ "${gpu_kind}" == "cuda" ]; then
     export CUDA_VISIBLE_DEVICES=${visible_devices}
@@ -8,6 +8,7 @@
 
 #include "slate/slate.hh"
 #include "scalapack_wrappers.hh"
+#include "test.hh"
 
 #include <stdint.h>
 
@@ -70,7 +71,7 @@ inline void create_ScaLAPACK_context( slate::GridOrder grid_order,
     blas_int mpi_rank_ = 0, nprocs = 1;
 
     // initialize BLACS and ScaLAPACK
-    MPI_Comm_rank( MPI_COMM_WORLD, &mpi_rank );
+    MPI_Comm_rank( tester_comm(), &mpi_rank );
     Cblacs_pinfo( &mpi_rank_, &nprocs );
     slate_assert( mpi_rank_ == mpi_rank );
 
@@ -14,6 +14,7 @@ template <typename matrix_type, typename irregular_constructor_t,
           typename regular_constructor_t, typename scalapack_constructor_t>
 static TestMatrix<matrix_type> allocate_test_shared(
     bool ref_matrix, bool nonuniform_ref, int64_t m, int64_t n, Params& params,
+    bool sym_grid,
     irregular_constructor_t construct_irregular,
     regular_constructor_t construct_regular,
     scalapack_constructor_t construct_scalapack)
@@ -26,6 +27,7 @@ static TestMatrix<matrix_type> allocate_test_shared(
     slate::Origin origin = params.origin();
     slate::GridOrder grid_order = params.grid_order();
     slate::GridOrder dev_order = params.dev_order();
+    bool first_touch = params.first_touch() == 'y';
 
     // The object to be returned
     TestMatrix<matrix_type> matrix( m, n, nb, p, q, grid_order );
@@ -50,20 +52,36 @@ static TestMatrix<matrix_type> allocate_test_shared(
     int num_devices_ = blas::get_device_count();
     auto tileDevice = slate::func::device_1d_grid( dev_order, p, num_devices_ );
 
+    // Symmetric block cyclic on the p*q = r (r-1) / 2 ranks.
+    if (sym_grid) {
+        int64_t r = 2;
+        while (r*(r-1)/2 < p*q)
+            ++r;
+        if (r*(r-1)/2 != p*q) {
+            throw std::runtime_error(
+                "sym-grid requires p*q = r (r-1) / 2 ranks, e.g., 1, 3, 6, 10" );
+        }
+        tileRank = slate::func::symmetric_2d_grid( r );
+        tileDevice = slate::func::device_1d_grid( slate::GridOrder::Row, r,
+                                                  num_devices_ );
+    }
+
     // Setup matrix to test SLATE with
     if (origin != slate::Origin::ScaLAPACK) {
         // SLATE allocates CPU or GPU tiles.
         slate::Target origin_target = origin2target( origin );
-        if (nonuniform_nb || dev_order == slate::GridOrder::Col) {
+        if (nonuniform_nb || sym_grid || dev_order == slate::GridOrder::Col) {
             matrix.A = construct_irregular( tileNb, tileRank, tileDevice );
         }
         else {
             matrix.A = construct_regular( nb, grid_order, p, q );
         }
-        matrix.A.insertLocalTiles( origin_target );
+        matrix.A.insertLocalTiles( origin_target,
+                                   {{ slate::Option::HostFirstTouch, first_touch }} );
     }
     else {
         assert( !nonuniform_nb );
+        assert( !sym_grid );
         assert( dev_order == slate::GridOrder::Row );
         // Create SLATE matrix from the ScaLAPACK layouts
         matrix.A_data.resize( matrix.lld * matrix.nloc );
@@ -73,7 +91,7 @@ static TestMatrix<matrix_type> allocate_test_shared(
 
     // Setup reference matrix
     if (ref_matrix) {
-        if (nonuniform_nb && nonuniform_ref) {
+        if ((nonuniform_nb || sym_grid) && nonuniform_ref) {
             matrix.Aref = construct_irregular( tileNb, tileRank, tileDevice );
             matrix.Aref.insertLocalTiles( slate::Target::Host );
         }
@@ -114,22 +132,22 @@ TestMatrix<slate::Matrix<scalar_t>> allocate_test_Matrix(
                                     dist_func_t tileRank, dist_func_t tileDevice)
     {
         return slate::Matrix<scalar_t>( m, n, tileNb, tileNb,
-                                        tileRank, tileDevice, MPI_COMM_WORLD );
+                                        tileRank, tileDevice, tester_comm() );
     };
     auto construct_regular = [&] (int64_t nb, slate::GridOrder grid_order, int p, int q )
     {
-        return slate::Matrix<scalar_t>( m, n, nb, nb, grid_order, p, q, MPI_COMM_WORLD );
+        return slate::Matrix<scalar_t>( m, n, nb, nb, grid_order, p, q, tester_comm() );
     };
     auto construct_scalapack = [&] (scalar_t* data, int64_t lld, int64_t nb,
                                     slate::GridOrder grid_order, int p, int q )
     {
         return slate::Matrix<scalar_t>::fromScaLAPACK(
                                             m, n, data, lld, nb, nb,
-                                            grid_order, p, q, MPI_COMM_WORLD );
+                                            grid_order, p, q, tester_comm() );
     };
 
     return allocate_test_shared<slate::Matrix<scalar_t>>(
-                    ref_matrix, nonuniform_ref, m, n, params,
+                    ref_matrix, nonuniform_ref, m, n, params, false,
                      construct_irregular, construct_regular, construct_scalapack );
 }
 // Explicit instantiations.
@@ -165,21 +183,22 @@ TestMatrix<matrix_type> allocate_test_HeSyMatrix(
                                     dist_func_t tileRank, dist_func_t tileDevice)
     {
         return matrix_type( uplo, n, tileNb,
-                            tileRank, tileDevice, MPI_COMM_WORLD );
+                            tileRank, tileDevice, tester_comm() );
     };
     auto construct_regular = [&] (int64_t nb, slate::GridOrder grid_order, int p, int q )
     {
-        return matrix_type( uplo, n, nb, grid_order, p, q, MPI_COMM_WORLD );
+        return matrix_type( uplo, n, nb, grid_order, p, q, tester_comm() );
     };
     auto construct_scalapack = [&] (scalar_t* data, int64_t lld, int64_t nb,
                                     slate::GridOrder grid_order, int p, int q )
     {
         return matrix_type::fromScaLAPACK( uplo, n, data, lld, nb,
-                                           grid_order, p, q, MPI_COMM_WORLD );
+                                           grid_order, p, q, tester_comm() );
     };
 
     return allocate_test_shared<matrix_type>(
                     ref_matrix, nonuniform_ref, n, n, params,
+                    params.sym_grid() == 'y',
                      construct_irregular, construct_regular, construct_scalapack );
 }
 
@@ -299,23 +318,24 @@ TestMatrix<slate::TriangularMatrix<scalar_t>> allocate_test_TriangularMatrix(
                                     dist_func_t tileRank, dist_func_t tileDevice)
     {
         return slate::TriangularMatrix<scalar_t>( uplo, diag, n, tileNb,
-                                                  tileRank, tileDevice, MPI_COMM_WORLD );
+                                                  tileRank, tileDevice, tester_comm() );
     };
     auto construct_regular = [&] (int64_t nb, slate::GridOrder grid_order, int p, int q )
     {
         return slate::TriangularMatrix<scalar_t>( uplo, diag, n, nb,
-                                                  grid_order, p, q, MPI_COMM_WORLD );
+                                                  grid_order, p, q, tester_comm() );
     };
     auto construct_scalapack = [&] (scalar_t* data, int64_t lld, int64_t nb,
                                     slate::GridOrder grid_order, int p, int q )
     {
         return slate::TriangularMatrix<scalar_t>::fromScaLAPACK(
                                             uplo, diag, n, data, lld, nb,
-                                            grid_order, p, q, MPI_COMM_WORLD );
+                                            grid_order, p, q, tester_comm() );
     };
 
     return allocate_test_shared<slate::TriangularMatrix<scalar_t>>(
                     ref_matrix, nonuniform_ref, n, n, params,
+                    params.sym_grid() == 'y',
                      construct_irregular, construct_regular, construct_scalapack );
 }
 
@@ -368,23 +388,23 @@ TestMatrix<slate::TrapezoidMatrix<scalar_t>> allocate_test_TrapezoidMatrix(
                                     dist_func_t tileRank, dist_func_t tileDevice)
     {
         return slate::TrapezoidMatrix<scalar_t>( uplo, diag, m, n, tileNb,
-                                                  tileRank, tileDevice, MPI_COMM_WORLD );
+                                                  tileRank, tileDevice, tester_comm() );
     };
     auto construct_regular = [&] (int64_t nb, slate::GridOrder grid_order, int p, int q )
     {
         return slate::TrapezoidMatrix<scalar_t>( uplo, diag, m, n, nb,
-                                                  grid_order, p, q, MPI_COMM_WORLD );
+                                                  grid_order, p, q, tester_comm() );
     };
     auto construct_scalapack = [&] (scalar_t* data, int64_t lld, int64_t nb,
                                     slate::GridOrder grid_order, int p, int q )
     {
         return slate::TrapezoidMatrix<scalar_t>::fromScaLAPACK(
                                             uplo, diag, m, n, data, lld, nb,
-                                            grid_order, p, q, MPI_COMM_WORLD );
+                                            grid_order, p, q, tester_comm() );
     };
 
     return allocate_test_shared<slate::TrapezoidMatrix<scalar_t>>(
-                    ref_matrix, nonuniform_ref, m, n, params,
+                    ref_matrix, nonuniform_ref, m, n, params, false,
                      construct_irregular, construct_regular, construct_scalapack );
 }
 
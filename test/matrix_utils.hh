@@ -223,7 +223,7 @@ public:
         : m(m_), n(n_), nb(nb_), p(p_), q(q_), grid_order(grid_order_)
     {
         int mpi_rank, myrow, mycol;
-        MPI_Comm_rank( MPI_COMM_WORLD, &mpi_rank );
+        MPI_Comm_rank( tester_comm(), &mpi_rank );
         gridinfo( mpi_rank, grid_order, p, q, &myrow, &mycol );
         this->mloc = num_local_rows_cols( m, nb, myrow, p );
         this->nloc = num_local_rows_cols( n, nb, mycol, q );
@@ -277,6 +277,7 @@ inline void mark_params_for_test_Matrix(Params& params)
 inline void mark_params_for_test_HermitianMatrix(Params& params)
 {
     params.uplo();
+    params.sym_grid();
     mark_params_for_test_Matrix( params );
 }
 
@@ -293,6 +294,7 @@ inline void mark_params_for_test_TriangularMatrix(Params& params)
 {
     params.uplo();
     params.diag();
+    params.sym_grid();
     mark_params_for_test_Matrix( params );
 }
 
@@ -0,0 +1,497 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "record.hh"
+#include "slate/slate.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <ctime>
+#include <type_traits>
+#include <unistd.h>
+
+extern char** environ;
+
+using Field = Recorder::Field;
+
+//------------------------------------------------------------------------------
+// Conversion of parameter values to fields.
+
+//----------------------------------------
+/// Adds integer field.
+static void add( std::vector<Field>& fields, char const* name, int64_t value )
+{
+    fields.push_back( { name, std::to_string( value ), false } );
+}
+
+//----------------------------------------
+/// Adds floating-point field; NaN (no data) and inf are null.
+static void add( std::vector<Field>& fields, char const* name, double value )
+{
+    if (std::isfinite( value )) {
+        char buf[ 32 ];
+        snprintf( buf, sizeof( buf ), "%.6g", value );
+        fields.push_back( { name, buf, false } );
+    }
+    else {
+        fields.push_back( { name, "", false } );
+    }
+}
+
+//----------------------------------------
+/// Adds string field.
+static void add( std::vector<Field>& fields, char const* name,
+                 std::string const& value )
+{
+    fields.push_back( { name, value, true } );
+}
+
+//----------------------------------------
+/// Adds char field, e.g., y or n.
+static void add( std::vector<Field>& fields, char const* name, char value )
+{
+    fields.push_back( { name, std::string( 1, value ), true } );
+}
+
+//----------------------------------------
+/// Adds enum field as its one-character code, e.g., Target::Devices is D,
+/// as in the tuning database. All tester enums are char based.
+template <typename enum_t>
+static typename std::enable_if< std::is_enum< enum_t >::value >::type
+add( std::vector<Field>& fields, char const* name, enum_t value )
+{
+    add( fields, name, char( value ) );
+}
+
+//----------------------------------------
+/// Adds fields of a test matrix, prefixed by prefix.
+static void add( std::vector<Field>& fields, std::string const& prefix,
+                 MatrixParams const& matrix )
+{
+    add( fields, (prefix + ".kind" ).c_str(), matrix.kind() );
+    add( fields, (prefix + ".cond" ).c_str(), matrix.cond_request() );
+    add( fields, (prefix + ".cond_actual" ).c_str(), matrix.cond_actual() );
+    add( fields, (prefix + ".condD").c_str(), matrix.condD() );
+    add( fields, (prefix + ".seed" ).c_str(), matrix.seed() );
+}
+
+//------------------------------------------------------------------------------
+/// @return fields of the input parameters of params, in the order of the
+/// Params members.
+/// Values are read through a const reference, which, unlike the
+/// non-const accessors, does not mark parameters as used, so the
+/// tester's table keeps its columns.
+///
+static std::vector<Field> input_fields( Params const& params )
+{
+    std::vector<Field> f;
+    f.reserve( 160 );
+    add( f, "routine",   params.routine );
+    add( f, "check",     params.check() );
+    add( f, "ref",       params.ref() );
+    add( f, "scaling",   params.scaling() );
+    add( f, "tol",       params.tol() );
+    add( f, "timer_level", params.timer_level() );
+
+    add( f, "type",      params.datatype() );
+    add( f, "origin",    params.origin() );
+    add( f, "target",    params.target() );
+    add( f, "hold_local_workspace", params.hold_local_workspace() );
+    add( f, "first_touch",       params.first_touch() );
+    add( f, "bcast_packed",      params.bcast_packed() );
+    add( f, "bcast_partitioned", params.bcast_partitioned() );
+    add( f, "progress_thread",   params.progress_thread() );
+    add( f, "bcast_precision",   params.bcast_precision() );
+    add( f, "runtime",           params.runtime() );
+    add( f, "queue_priority",    params.queue_priority() );
+    add( f, "panel_target",      params.panel_target() );
+    add( f, "compute_precision", params.compute_precision() );
+    add( f, "gram_precision",    params.gram_precision() );
+    add( f, "device_stealing",   params.device_stealing() );
+    add( f, "method_cholqr",     params.method_cholqr() );
+    add( f, "method_eig",        params.method_eig() );
+    add( f, "method_gels",       params.method_gels() );
+    add( f, "method_gemm",       params.method_gemm() );
+    add( f, "method_hemm",       params.method_hemm() );
+    add( f, "method_lu",         params.method_lu() );
+    add( f, "method_svd",        params.method_svd() );
+    add( f, "method_trsm",       params.method_trsm() );
+    add( f, "grid_order",        params.grid_order() );
+    add( f, "dev_order",         params.dev_order() );
+
+    add( f, "matrix",  params.matrix );
+    add( f, "matrixB", params.matrixB );
+    add( f, "matrixC", params.matrixC );
+
+    add( f, "layout",    params.layout() );
+    add( f, "itype",     params.itype() );
+    add( f, "update_sign", params.update_sign() );
+    add( f, "jobz",      params.jobz() );
+    add( f, "jobvl",     params.jobvl() );
+    add( f, "jobvr",     params.jobvr() );
+    add( f, "jobu",      params.jobu() );
+    add( f, "jobvt",     params.jobvt() );
+    add( f, "range",     params.range() );
+    add( f, "norm",      params.norm() );
+    add( f, "scope",     params.scope() );
+    add( f, "side",      params.side() );
+    add( f, "uplo",      params.uplo() );
+    add( f, "trans",     params.trans() );
+    add( f, "transA",    params.transA() );
+    add( f, "transB",    params.transB() );
+    add( f, "diag",      params.diag() );
+    add( f, "direction", params.direction() );
+    add( f, "storev",    params.storev() );
+    add( f, "equed",     params.equed() );
+
+    add( f, "m",         params.dim().m );
+    add( f, "n",         params.dim().n );
+    add( f, "k",         params.dim().k );
+    add( f, "kd",        params.kd() );
+    add( f, "kl",        params.kl() );
+    add( f, "ku",        params.ku() );
+    add( f, "nrhs",      params.nrhs() );
+    add( f, "nb",        params.nb() );
+    add( f, "ib",        params.ib() );
+    add( f, "vl",        params.vl() );
+    add( f, "vu",        params.vu() );
+    add( f, "il",        params.il() );
+    add( f, "iu",        params.iu() );
+    add( f, "fraction_start", params.fraction_start() );
+    add( f, "fraction",  params.fraction() );
+    add( f, "alpha.re",  std::real( params.alpha() ) );
+    add( f, "alpha.im",  std::imag( params.alpha() ) );
+    add( f, "beta.re",   std::real( params.beta() ) );
+    add( f, "beta.im",   std::imag( params.beta() ) );
+    add( f, "incx",      params.incx() );
+    add( f, "incy",      params.incy() );
+
+    add( f, "p",         params.grid().m );
+    add( f, "q",         params.grid().n );
+    add( f, "lookahead", params.lookahead() );
+    add( f, "panel_threads", params.panel_threads() );
+    add( f, "panel_cores", params.panel_cores() );
+    add( f, "nonuniform_nb", params.nonuniform_nb() );
+    add( f, "sym_grid", params.sym_grid() );
+    add( f, "threshold", params.pivot_threshold() );
+    add( f, "deflate",   params.deflate() );
+    add( f, "itermax",   params.itermax() );
+    add( f, "fallback",  params.fallback() );
+    add( f, "depth",     params.depth() );
+    add( f, "layers",    params.layers() );
+    add( f, "group",     params.group() );
+    add( f, "arity",     params.tree_arity() );
+    add( f, "trailing_block", params.trailing_block() );
+    add( f, "gmres_steps", params.gmres_steps() );
+    add( f, "tail_shrink", params.tail_shrink() );
+    add( f, "equilibrate", params.equilibrate() );
+    add( f, "fused_solve", params.fused_solve() );
+    add( f, "panel_callback", params.panel_callback() );
+    add( f, "panel_sub_tile", params.panel_sub_tile() );
+    add( f, "tiles",     params.tiles() );
+    add( f, "set_size",  params.set_size() );
+    add( f, "radix",     params.radix() );
+    add( f, "gpu_aware", params.gpu_aware() );
+    add( f, "niter",     params.niter() );
+    add( f, "oversample", params.oversample() );
+    add( f, "power",     params.power_iters() );
+    add( f, "tlr_tol",   params.tlr_tol() );
+    return f;
+}
+
+//------------------------------------------------------------------------------
+/// Appends fields of the output values of params to f.
+/// @see input_fields
+///
+static void output_fields( Params const& params, std::vector<Field>& f )
+{
+    add( f, "il_out",    params.il_out() );
+    add( f, "iu_out",    params.iu_out() );
+    add( f, "value",     params.value() );
+    add( f, "value2",    params.value2() );
+    add( f, "value3",    params.value3() );
+    add( f, "error",     params.error() );
+    add( f, "error2",    params.error2() );
+    add( f, "error3",    params.error3() );
+    add( f, "error4",    params.error4() );
+    add( f, "error5",    params.error5() );
+    add( f, "ortho",     params.ortho() );
+    add( f, "ortho_U",   params.ortho_U() );
+    add( f, "ortho_V",   params.ortho_V() );
+    add( f, "time",      params.time() );
+    add( f, "gflops",    params.gflops() );
+    add( f, "gbytes",    params.gbytes() );
+    add( f, "iters",     params.iters() );
+    add( f, "time2",     params.time2() );
+    add( f, "gflops2",   params.gflops2() );
+    add( f, "gbytes2",   params.gbytes2() );
+    add( f, "time3",     params.time3() );
+    add( f, "time4",     params.time4() );
+    add( f, "time5",     params.time5() );
+    add( f, "time6",     params.time6() );
+    add( f, "time7",     params.time7() );
+    add( f, "time8",     params.time8() );
+    add( f, "time9",     params.time9() );
+    add( f, "time10",    params.time10() );
+    add( f, "time11",    params.time11() );
+    add( f, "time12",    params.time12() );
+    add( f, "time13",    params.time13() );
+    add( f, "ref_time",  params.ref_time() );
+    add( f, "ref_gflops", params.ref_gflops() );
+    add( f, "ref_gbytes", params.ref_gbytes() );
+    add( f, "ref_iters", params.ref_iters() );
+    add( f, "efficiency", params.efficiency() );
+    add( f, "joules",    params.joules() );
+    add( f, "gflops_w",  params.gflops_w() );
+    add( f, "okay",      int64_t( params.okay() ) );
+    add( f, "msg",       params.msg() );
+}
+
+//------------------------------------------------------------------------------
+/// @return key identifying the input parameters of params, except the
+/// fields named in exclude, e.g., p and q to identify the tests of one
+/// scaling study.
+///
+std::string input_key(
+    Params const& params, std::vector<std::string> const& exclude )
+{
+    std::string key;
+    for (auto& field : input_fields( params )) {
+        if (std::find( exclude.begin(), exclude.end(), field.name )
+            != exclude.end())
+            continue;
+        key += field.name + '=' + field.value + ' ';
+    }
+    return key;
+}
+
+//------------------------------------------------------------------------------
+/// @return str quoted for JSON.
+static std::string json_quote( std::string const& str )
+{
+    std::string out = "\"";
+    for (char c : str) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        }
+        else if (c == '\n') {
+            out += "\\n";
+        }
+        else if (c == '\t') {
+            out += "\\t";
+        }
+        else if ((unsigned char) c < 0x20) {
+            char buf[ 8 ];
+            snprintf( buf, sizeof( buf ), "\\u%04x", (unsigned char) c );
+            out += buf;
+        }
+        else {
+            out += c;
+        }
+    }
+    out += '"';
+    return out;
+}
+
+//------------------------------------------------------------------------------
+/// @return str quoted for CSV, if it has a comma, quote, or newline.
+static std::string csv_quote( std::string const& str )
+{
+    if (str.find_first_of( ",\"\n" ) == std::string::npos)
+        return str;
+    std::string out = "\"";
+    for (char c : str) {
+        if (c == '"')
+            out += '"';
+        out += c;
+    }
+    out += '"';
+    return out;
+}
+
+//------------------------------------------------------------------------------
+/// @return value of field formatted for JSON; empty numbers are null.
+static std::string json_value( Field const& field )
+{
+    if (field.is_string)
+        return json_quote( field.value );
+    else if (field.value.empty())
+        return "null";
+    else
+        return field.value;
+}
+
+//------------------------------------------------------------------------------
+/// Opens path for writing, truncating it, on MPI rank 0.
+///
+/// @param[in] path
+///     Output file. If it ends in .csv, writes CSV, else JSON Lines.
+///
+/// @param[in] argc, argv
+///     Tester command line, recorded in the metadata.
+///
+/// @param[in] mpi_size
+///     Number of MPI ranks, recorded in the metadata.
+///
+Recorder::Recorder( std::string const& path, int argc, char** argv,
+                    int mpi_size )
+    : file_( nullptr ),
+      csv_( ends_with( path, ".csv" ) ),
+      header_written_( false )
+{
+    int mpi_rank;
+    MPI_Comm_rank( MPI_COMM_WORLD, &mpi_rank );
+    if (mpi_rank != 0)
+        return;
+
+    file_ = fopen( path.c_str(), "w" );
+    if (file_ == nullptr)
+        throw std::runtime_error( "cannot open output file " + path );
+    write_meta( argc, argv, mpi_size );
+}
+
+//------------------------------------------------------------------------------
+Recorder::~Recorder()
+{
+    if (file_ != nullptr)
+        fclose( file_ );
+}
+
+//------------------------------------------------------------------------------
+/// Writes the metadata of the run.
+///
+void Recorder::write_meta( int argc, char** argv, int mpi_size )
+{
+    std::vector<Field> meta;
+
+    char buf[ 1024 ];
+    int version = slate::version();
+    snprintf( buf, sizeof( buf ), "%04d.%02d.%02d",
+              version / 10000, (version % 10000) / 100, version % 100 );
+    add( meta, "slate_version", std::string( buf ) );
+    add( meta, "slate_id", std::string( slate::id() ) );
+
+    std::string input;
+    for (int i = 0; i < argc; ++i) {
+        if (i > 0)
+            input += ' ';
+        input += argv[ i ];
+    }
+    add( meta, "input", input );
+
+    std::time_t now = std::time( nullptr );
+    std::strftime( buf, sizeof( buf ), "%FT%T", std::localtime( &now ) );
+    add( meta, "date", std::string( buf ) );
+
+    gethostname( buf, sizeof( buf ) );
+    buf[ sizeof( buf ) - 1 ] = '\0';
+    add( meta, "host", std::string( buf ) );
+
+    add( meta, "mpi_ranks", int64_t( mpi_size ) );
+    add( meta, "omp_threads", int64_t( omp_get_max_threads() ) );
+    add( meta, "gpu_devices", int64_t( blas::get_device_count() ) );
+    add( meta, "gpu_aware_mpi", slate::gpu_aware_mpi() ? 'y' : 'n' );
+
+    // Environment that affects performance.
+    for (char** env = environ; *env != nullptr; ++env) {
+        std::string var = *env;
+        size_t eq = var.find( '=' );
+        if (eq == std::string::npos)
+            continue;
+        std::string name = var.substr( 0, eq );
+        if (name.compare( 0, 6, "SLATE_" ) == 0
+            || name.compare( 0, 4, "OMP_" ) == 0
+            || ends_with( name, "_VISIBLE_DEVICES" )) {
+            meta.push_back( { "env." + name, var.substr( eq + 1 ), true } );
+        }
+    }
+
+    if (csv_) {
+        for (auto& field : meta)
+            fprintf( file_, "# %s: %s\n", field.name.c_str(),
+                     field.value.c_str() );
+    }
+    else {
+        fprintf( file_, "{\"meta\": {" );
+        const char* sep = "";
+        for (auto& field : meta) {
+            fprintf( file_, "%s%s: %s", sep, json_quote( field.name ).c_str(),
+                     json_value( field ).c_str() );
+            sep = ", ";
+        }
+        fprintf( file_, "}}\n" );
+    }
+    fflush( file_ );
+}
+
+//------------------------------------------------------------------------------
+/// Writes one record for the test run that just finished, before
+/// params.reset_output().
+///
+/// @param[in] params
+///     Parameters and output values of the run.
+///
+/// @param[in] repeat_index
+///     Index of the run in --repeat, 0-based.
+///
+void Recorder::record( Params& params, int repeat_index )
+{
+    if (file_ == nullptr)
+        return;
+
+    std::vector<Field> fields = input_fields( params );
+    fields.insert( fields.begin() + 1,
+                   { "repeat", std::to_string( repeat_index ), false } );
+    output_fields( params, fields );
+
+    if (csv_) {
+        // Timers differ between routines, so CSV has them in one column,
+        // as name=seconds pairs separated by semicolons.
+        std::string timers;
+        char buf[ 256 ];
+        for (auto& timer : slate::timers) {
+            if (! timers.empty())
+                timers += ';';
+            snprintf( buf, sizeof( buf ), "%s=%.6g",
+                      timer.first.c_str(), timer.second );
+            timers += buf;
+        }
+        fields.push_back( { "timers", timers, true } );
+
+        if (! header_written_) {
+            const char* sep = "";
+            for (auto& field : fields) {
+                fprintf( file_, "%s%s", sep, csv_quote( field.name ).c_str() );
+                sep = ",";
+            }
+            fprintf( file_, "\n" );
+            header_written_ = true;
+        }
+        const char* sep = "";
+        for (auto& field : fields) {
+            fprintf( file_, "%s%s", sep, csv_quote( field.value ).c_str() );
+            sep = ",";
+        }
+        fprintf( file_, "\n" );
+    }
+    else {
+        fprintf( file_, "{" );
+        for (auto& field : fields) {
+            fprintf( file_, "%s: %s, ", json_quote( field.name ).c_str(),
+                     json_value( field ).c_str() );
+        }
+        fprintf( file_, "\"timers\": {" );
+        const char* sep = "";
+        for (auto& timer : slate::timers) {
+            fprintf( file_, "%s%s: %.6g", sep,
+                     json_quote( timer.first ).c_str(), timer.second );
+            sep = ", ";
+        }
+        fprintf( file_, "}}\n" );
+    }
+    fflush( file_ );
+}
@@ -0,0 +1,60 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef SLATE_TEST_RECORD_HH
+#define SLATE_TEST_RECORD_HH
+
+#include "test.hh"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+//------------------------------------------------------------------------------
+/// Writes tester results as structured records, for tracking performance
+/// across versions, e.g., with tools/perf_compare.py.
+/// Each run of a test, including each --repeat, is one record with:
+/// all parameters, all output values (under their member names, e.g.,
+/// time2, even if the routine renamed the column), the repeat index,
+/// and the slate::timers of the run.
+///
+/// The file format is chosen by the extension of the path:
+/// - *.csv: comma-separated values, with the metadata in leading
+///   "# key: value" lines, then one header line;
+/// - otherwise: JSON Lines, one JSON object per line; the first line,
+///   {"meta": {...}}, has the metadata.
+///
+/// The metadata describe the run: SLATE version, command line, date,
+/// host, MPI ranks, OpenMP threads, GPU devices, GPU-aware MPI, and the
+/// SLATE_*, OMP_*, and *_VISIBLE_DEVICES environment variables.
+/// Only MPI rank 0 writes.
+///
+class Recorder {
+public:
+    Recorder( std::string const& path, int argc, char** argv, int mpi_size );
+    ~Recorder();
+
+    void record( Params& params, int repeat_index );
+
+    /// One field of a record; is_string selects quoting.
+    struct Field {
+        std::string name;
+        std::string value;
+        bool is_string;
+    };
+
+private:
+    void write_meta( int argc, char** argv, int mpi_size );
+
+    FILE* file_;
+    bool csv_;
+    bool header_written_;
+};
+
+//------------------------------------------------------------------------------
+std::string input_key(
+    Params const& params, std::vector<std::string> const& exclude );
+
+#endif // SLATE_TEST_RECORD_HH
@@ -363,8 +363,10 @@ if (opts.blas3):
     [ 'gbmm',  gen + dtype + la + transA + transB + mnk + ab + kl + ku + matrixBC ],
 
     [ 'gemm',  gen + dtype + la + transA + transB + mnk + ab + matrixBC + nonuniform_nb + ge_matrix ],
+    [ 'gemm',  gen + dtype_complex + la + transA + transB + mnk + ab + ' --compute-precision 3m' ],
     [ 'gemmA', gen + dtype + la + transA + transB + mnk + ab + matrixBC + nonuniform_nb + ge_matrix ],
     [ 'gemmC', gen + dtype + la + transA + transB + mnk + ab + matrixBC + nonuniform_nb + ge_matrix ],
+    [ 'gemmGrouped', gen + dtype + la + transA + transB + mnk + ab + matrixBC + ' --group 4' ],
 
     [ 'hemm',  gen + dtype         + la + side + he_matrix     + mn + ab + matrixBC ],
     # todo: hemmA GPU support
@@ -395,12 +397,17 @@ if (opts.blas3):
     [ 'trsm',  gen + dtype + la + side + tr_matrix + nonuniform_nb + transA + mn + a + matrixB ],
     [ 'trsmA', gen + dtype + la + side + tr_matrix + nonuniform_nb + transA + mn + a + matrixB ],
     [ 'trsmB', gen + dtype + la + side + tr_matrix + nonuniform_nb + transA + mn + a + matrixB ],
+    [ 'trsmInv', gen + dtype + la + side + tr_matrix + nonuniform_nb + transA + mn + a + matrixB ],
     ]
 
 # LU
 if (opts.lu):
     cmds += [
     [ 'gesv',         gen + dtype + la + n + ge_matrix + nonuniform_nb + threshold ],
+    [ 'gesv',         gen + dtype + la + n + ' --equilibrate y' ],
+    [ 'gesv',         gen + dtype + la + n + ' --fused-solve y' ],
+    [ 'gesv',         gen + dtype + la + n + ' --panel-cores 1' ],
+    [ 'gesv',         gen + dtype_complex + la + n + ' --compute-precision 3m' ],
     [ 'gesv_tntpiv',  gen + dtype + la + n + ge_matrix ],
     [ 'gesv_nopiv',   gen + dtype + la + n + ge_matrix + nonuniform_nb
                       + ' --matrix rand_dominant' ],
@@ -423,6 +430,7 @@ if (opts.lu):
     [ 'gesv_mixed',   gen + dtype_double + la + n + ge_matrix + nonuniform_nb ],
     [ 'gesv_mixed_gmres',  gen + dtype_double + la + n + ' --nrhs 1' + ge_matrix + nonuniform_nb ],
     [ 'gesv_rbt', gen + dtype + la + n + ge_matrix ],
+    [ 'gesv_handle', gen + dtype + la + n + ge_matrix ],
     ]
 
 # LU banded
@@ -439,14 +447,23 @@ if (opts.lu_band):
 if (opts.chol):
     cmds += [
     [ 'posv',  gen + dtype + la + n + he_matrix ],
+    [ 'posv',  gen + dtype + la + n + ' --equilibrate y' ],
+    [ 'posv',  gen + dtype + la + n + ' --fused-solve y' ],
+    [ 'posv',  gen + dtype + la + n + ' --panel-callback y' ],
+    [ 'posv',  gen + dtype + la + n + ' --panel-sub-tile 16' ],
+    [ 'posv',  gen + dtype_complex + la + n + ' --compute-precision 3m' ],
+    [ 'posv',  gen + dtype + la + n + ' --device-stealing y' ],
     [ 'potrf', gen + dtype + la + n + he_matrix ],
     [ 'potrs', gen + dtype + la + n + he_matrix ],
     [ 'potri', gen + dtype + la + n ],
+    [ 'potrf_tlr', gen + dtype + n + ' --uplo l --tlr-tol 1e-8,1e-4' ],
+    [ 'potrf_update', gen + dtype + la + n + uplo + ' --nrhs 1,10 --sign 1,-1' ],
     #[ 'porfs', gen + dtype + la + n + uplo ],
     #[ 'poequ', gen + dtype + la + n ],  # only diagonal elements (no uplo)
     [ 'posv_mixed', gen + dtype_double + la + n + he_matrix ],
     [ 'posv_mixed_gmres',  gen + dtype_double + la + n + ' --nrhs 1' + he_matrix ],
     [ 'trtri', gen + dtype + la + n + uplo + diag ],
+    [ 'trtri', gen + dtype + la + n + uplo + ' --device-stealing y' ],
     ]
 
 # Cholesky banded
@@ -489,6 +506,10 @@ if (opts.least_squares):
     [ 'gels',   gen + dtype + la + n + tall + trans_nc + ' --method-gels qr' ],
     # Cholesky QR needs well-conditioned problem.
     [ 'gels',   gen + dtype + la + n + tall + trans_nc + cond + ' --method-gels cholqr --matrix svd' ],
+    [ 'gels',   gen + dtype + la + n + tall + trans_nc + ' --method-gels cholqr2,cholqr3 --matrix svd --cond 1e6' ],
+    [ 'gels',   gen + dtype + la + n + tall + trans_nc + ' --method-gels cholqr --gram-precision single --matrix svd --cond 1e2' ],
+    [ 'gels',   gen + dtype + la + n + tall + ' --trans n --method-gels sketch' ],
+    [ 'gels_mixed', gen + dtype_double + la + n + tall + ' --trans n' ],
 
     # Generalized
     #[ 'gglse', gen + dtype + la + mnk ],
@@ -499,7 +520,13 @@ if (opts.least_squares):
 if (opts.qr):
     cmds += [
     [ 'cholqr', gen + dtype + la + n + tall ],  # not wide
+    [ 'cholqr', gen + dtype + la + n + tall + ' --method-cholQR herkA' ],
+    [ 'cholqr', gen + dtype + la + n + tall + ' --gram-precision single' ],
     [ 'geqrf', gen + dtype + la + mn ],
+    [ 'geqrf', gen + dtype + la + mn + ' --panel-callback y' ],
+    [ 'geqrf_add_cols',    gen + dtype + la + tall + ' --nrhs 1,10' ],
+    [ 'geqrf_delete_cols', gen + dtype + la + tall + ' --nrhs 1,10' ],
+    [ 'geqrf_add_rows',    gen + dtype + la + tall + ' --nrhs 1,10' ],
     [ 'unmqr', gen + dtype + la + mn ],
     #[ 'ggqrf', gen + dtype + la + mnk ],
     #[ 'ungqr', gen + dtype + la + mn ],  # m >= n
@@ -544,7 +571,8 @@ if (opts.syev):
         # Requires ref to check. Only QR.
         cmds += [[ 'heev', gen + dtype + la + n + ' --jobz n --ref y --method-eig qr' ]]
     if ('v' in jobz):
-        cmds += [[ 'heev', gen + dtype + la + n + ' --jobz v --method-eig qr,dc' ]]
+        cmds += [[ 'heev', gen + dtype + la + n + ' --jobz v --method-eig qr,dc,qdwh' ]]
+        cmds += [[ 'heev_mixed', gen + dtype_double + la + n + ' --jobz v --itermax 5' ]]
 
     cmds += [
     # heev uses only side=l, no-trans. side=r and trans don't yet work
@@ -601,10 +629,13 @@ if (opts.svd):
     if ('n' in jobu):
         cmds += [[ 'svd', gen + dtype + la + mn + ' --jobu n --jobvt n' + ge_matrix ]]
     if ('v' in jobu or 's' in jobu):
-        cmds += [[ 'svd', gen + dtype + la + mn + ' --jobu v --jobvt v' + ge_matrix ]]
+        cmds += [[ 'svd', gen + dtype + la + mn + ' --jobu v --jobvt v --method-svd qr,dc,bisection,qdwh' + ge_matrix ]]
     if ('a' in jobu):
         cmds += [[ 'svd', gen + dtype + la + mn + ' --jobu a --jobvt a' + ge_matrix ]]
 
+    cmds += [[ 'svd_rand', gen + dtype + mnk + ' --jobu v --jobvt v --power 0,2' ]]
+    cmds += [[ 'polar', gen + dtype + la + n + tall ]]
+
     cmds += [
     # todo: mn (wide), nb, jobu, jobvt
     [ 'ge2tb', gen + dtype + n + tall + ' --jobu v --jobvt v' ],
@@ -5,14 +5,21 @@
 
 #include <complex>
 
+#include <cmath>
 #include <iostream>
+#include <map>
+#include <memory>
 #include <stdio.h>
 #include <string.h>
 #include <unistd.h>
+#include <utility>
+#include <vector>
 
 #include "test.hh"
+#include "record.hh"
 #include "slate/slate.hh"
 #include "slate/generate_matrix.hh"
+#include "slate/internal/Energy.hh"
 
 // -----------------------------------------------------------------------------
 using testsweeper::ParamType;
@@ -44,6 +51,7 @@ using lapack::Direction,  lapack::Direction_help;
 using lapack::StoreV,     lapack::StoreV_help;
 using lapack::Equed,      lapack::Equed_help;
 
+using slate::BcastPrecision, slate::BcastPrecision_help;
 using slate::GridOrder,    slate::GridOrder_help;
 using slate::MethodCholQR, slate::MethodCholQR_help;
 using slate::MethodEig,    slate::MethodEig_help;
@@ -51,10 +59,15 @@ using slate::MethodGels,   slate::MethodGels_help;
 using slate::MethodGemm,   slate::MethodGemm_help;
 using slate::MethodHemm,   slate::MethodHemm_help;
 using slate::MethodLU,     slate::MethodLU_help;
+using slate::MethodSVD,    slate::MethodSVD_help;
 using slate::MethodTrsm,   slate::MethodTrsm_help;
 using slate::NormScope,    slate::NormScope_help;
 using slate::Origin,       slate::Origin_help;
 using slate::Target,       slate::Target_help;
+using slate::TaskRuntime,  slate::TaskRuntime_help;
+using slate::QueuePriority, slate::QueuePriority_help;
+using slate::ComputePrecision, slate::ComputePrecision_help;
+using slate::GramPrecision, slate::GramPrecision_help;
 
 const ParamType PT_Value = ParamType::Value;
 const ParamType PT_List  = ParamType::List;
@@ -88,6 +101,8 @@ enum Section {
     aux_norm,
     aux_householder,
     aux_gen,
+    comm,
+    kernel,
     num_sections,  // last
 };
 
@@ -108,6 +123,8 @@ const char* section_names[] = {
     "matrix norms",
     "auxiliary - Householder",
     "auxiliary - matrix generation",
+    "communication benchmarks",
+    "kernel benchmarks",
 };
 
 // { "", nullptr, Section::newline } entries force newline in help
@@ -117,6 +134,8 @@ std::vector< testsweeper::routines_t > routines = {
     { "gemm",               test_gemm,         Section::blas3 },
     { "gemmA",              test_gemm,         Section::blas3 },
     { "gemmC",              test_gemm,         Section::blas3 },
+    { "gemmLayered",        test_gemm,         Section::blas3 },
+    { "gemmGrouped",        test_gemm_grouped, Section::blas3 },
     { "gbmm",               test_gbmm,         Section::blas3 },
     { "",                   nullptr,           Section::newline },
 
@@ -137,6 +156,7 @@ std::vector< testsweeper::routines_t > routines = {
     { "trsm",               test_trsm,         Section::blas3 },
     { "trsmA",              test_trsm,         Section::blas3 },
     { "trsmB",              test_trsm,         Section::blas3 },
+    { "trsmInv",            test_trsm,         Section::blas3 },
     { "tbsm",               test_tbsm,         Section::blas3 },
 
     // -----
@@ -147,6 +167,7 @@ std::vector< testsweeper::routines_t > routines = {
     { "gesv_mixed",         test_gesv,         Section::gesv },
     { "gesv_mixed_gmres",   test_gesv,         Section::gesv },
     { "gesv_rbt",           test_gesv,         Section::gesv },
+    { "gesv_handle",        test_gesv_handle,  Section::gesv },
     { "gbsv",               test_gbsv,         Section::gesv },
     { "",                   nullptr,           Section::newline },
 
@@ -188,6 +209,11 @@ std::vector< testsweeper::routines_t > routines = {
 
     { "potri",              test_potri,        Section::posv },
     { "",                   nullptr,           Section::newline },
+
+    { "potrf_tlr",          test_potrf_tlr,    Section::posv },
+    { "",                   nullptr,           Section::newline },
+    { "potrf_update",       test_potrf_update, Section::posv },
+    { "",                   nullptr,           Section::newline },
     { "pocondest",          test_pocondest,    Section::posv },
 
     // -----
@@ -215,12 +241,16 @@ std::vector< testsweeper::routines_t > routines = {
     // -----
     // least squares
     { "gels",                test_gels,         Section::gels },
+    { "gels_mixed",          test_gels,         Section::gels },
     { "",                    nullptr,           Section::newline },
 
     // -----
     // QR, LQ, RQ, QL
     { "geqrf",              test_geqrf,     Section::qr },
     { "cholqr",             test_geqrf,     Section::qr },
+    { "geqrf_add_cols",     test_geqrf_update, Section::qr },
+    { "geqrf_delete_cols",  test_geqrf_update, Section::qr },
+    { "geqrf_add_rows",     test_geqrf_update, Section::qr },
     { "gelqf",              test_gelqf,     Section::qr },
     //{ "geqlf",              test_geqlf,     Section::qr },
     //{ "gerqf",              test_gerqf,     Section::qr },
@@ -242,6 +272,7 @@ std::vector< testsweeper::routines_t > routines = {
     // -----
     // symmetric/Hermitian eigenvalues
     { "heev",               test_heev,         Section::heev },
+    { "heev_mixed",         test_heev,         Section::heev },
     { "sterf",              test_sterf,        Section::heev },
     { "steqr2",             test_steqr2,       Section::heev },
     { "",                   nullptr,           Section::newline },
@@ -273,6 +304,8 @@ std::vector< testsweeper::routines_t > routines = {
     // -----
     // SVD
     { "svd",                test_svd,          Section::svd },
+    { "svd_rand",           test_svd_rand,     Section::svd },
+    { "polar",              test_polar,        Section::svd },
     { "ge2tb",              test_ge2tb,        Section::svd },
     { "tb2bd",              test_tb2bd,        Section::svd },
     { "bdsqr",              test_bdsqr,        Section::svd },
@@ -325,6 +358,38 @@ std::vector< testsweeper::routines_t > routines = {
     { "syset",              test_set,          Section::aux },
     { "heset",              test_set,          Section::aux },
     { "",                   nullptr,           Section::newline },
+
+    // -----
+    // communication benchmarks
+    { "comm_tileBcast",     test_comm,         Section::comm },
+    { "comm_listBcast",     test_comm,         Section::comm },
+    { "comm_listBcastMT",   test_comm,         Section::comm },
+    { "",                   nullptr,           Section::newline },
+
+    { "comm_listReduce",    test_comm,         Section::comm },
+    { "comm_tileIbcastToSet", test_comm,       Section::comm },
+    { "",                   nullptr,           Section::newline },
+
+    // -----
+    // tile kernel benchmarks, on the host
+    { "kernel_getrf",       test_kernel,       Section::kernel },
+    { "kernel_geqrf",       test_kernel,       Section::kernel },
+    { "kernel_householder", test_kernel,       Section::kernel },
+    { "",                   nullptr,           Section::newline },
+
+    { "kernel_tpqrt",       test_kernel,       Section::kernel },
+    { "kernel_tpmqrt",      test_kernel,       Section::kernel },
+    { "",                   nullptr,           Section::newline },
+
+    // device kernel benchmarks
+    { "kernel_genorm",      test_kernel,       Section::kernel },
+    { "kernel_transpose",   test_kernel,       Section::kernel },
+    { "kernel_gecopy",      test_kernel,       Section::kernel },
+    { "",                   nullptr,           Section::newline },
+
+    { "kernel_geadd",       test_kernel,       Section::kernel },
+    { "kernel_geset",       test_kernel,       Section::kernel },
+    { "",                   nullptr,           Section::newline },
 };
 
 // -----------------------------------------------------------------------------
@@ -343,6 +408,30 @@ Params::Params():
     ref       ( "ref",        0, PT_Value, 'n', "nyo", "run reference; sometimes check implies ref" ),
     trace     ( "trace",      0, PT_Value, 'n', "ny",  "enable/disable traces" ),
     trace_scale( "trace-scale", 0, 0, PT_Value, 1e3, 1e-3, 1e6, "horizontal scale for traces, in pixels per sec" ),
+    trace_format( "trace-format", 0, PT_Value, 's', "sjrn",
+                "trace output: s = SVG; j = JSON for Perfetto or chrome://tracing; "
+                "r = JSON, one file per rank; n = none, e.g., for --trace-analysis only" ),
+    trace_analysis( "trace-analysis", 0, PT_Value, 'n', "ny",
+                "print critical-path, idle-time, and comm/compute overlap analysis"
+                " of traced factorizations" ),
+    tune      ( "tune",       0, PT_Value, 'n', "ny",
+                "record the fastest nb, ib, lookahead, and panel-threads of each"
+                " size in the tuning database $SLATE_TUNING_DB" ),
+    scaling   ( "scaling",    0, PT_Value, 'n', "nsw",
+                "scaling study over the grids p-by-q of at most all MPI ranks:"
+                " n = none; s = strong, fixed dimensions;"
+                " w = weak, dimensions times sqrt( p*q ), i.e., fixed dimensions per rank;"
+                " prints parallel efficiency and time per phase" ),
+    peak_gflops( "peak-gflops", 0, 0, PT_Value, 0, 0, 1e9,
+                "peak Gflop/s per node, for --counters percent of peak; 0 = none" ),
+    peak_gbytes( "peak-gbytes", 0, 0, PT_Value, 0, 0, 1e9,
+                "peak Gbyte/s per node of the network and host-device links,"
+                " for --counters percent of bandwidth; 0 = none" ),
+    energy    ( "energy",     0, PT_Value, 'n', "ny",
+                "sample CPU (RAPL) and GPU (NVML, ROCm SMI) energy counters;"
+                " report joules and Gflop/s per watt of the timed region,"
+                " summed over nodes, and with --trace-analysis, joules per"
+                " trace block" ),
 
     //          name,         w, p, type, default,  min,  max, help
     tol       ( "tol",        0, 0, PT_Value,  50,    1, 1000, "tolerance (e.g., error < tol*epsilon to pass)" ),
@@ -373,6 +462,10 @@ Params::Params():
     debug_rank( "debug-rank", 0,    PT_Value,  -1,    0,  1e6,
                 "given MPI rank waits for debugger (gdb/lldb) to attach; "
                 "use MPI size for all ranks to wait" ),
+    output    ( "output",     0,    PT_Value, "",
+                "file for results with all parameters, each repeat, timers, and"
+                " run metadata: *.csv for CSV, else JSON Lines;"
+                " compare runs with tools/perf_compare.py" ),
 
     //----- routine parameters, enums
     //          name,         w, type,    default, help
@@ -381,6 +474,30 @@ Params::Params():
     target    ( "target",     6, PT_List, Target::HostTask, Target_help ),
     hold_local_workspace( "hold-local-workspace",
                               0, PT_List, 'n', "ny", "do not erase tiles in local workspace" ),
+    first_touch( "first-touch",
+                              0, PT_List, 'n', "ny", "first touch host tiles in parallel, for NUMA placement" ),
+    bcast_packed( "bcast-packed",
+                              0, PT_List, 'n', "ny", "pack tiles with the same broadcast pattern into one message" ),
+    bcast_partitioned( "bcast-partitioned",
+                              0, PT_List, 'n', "ny", "send packed panel broadcasts with MPI 4 partitioned communication" ),
+    progress_thread( "progress-thread",
+                              0, PT_List, 'n', "ny", "use a thread to drive outstanding MPI sends" ),
+    bcast_precision( "bcast-precision",
+                              0, PT_List, BcastPrecision::Native, BcastPrecision_help ),
+    counters( "counters",
+                              0, PT_List, 'n', "nym", "print per-phase performance counters; m: also messages and communication matrix" ),
+    runtime( "runtime",
+                              0, PT_List, TaskRuntime::OpenMP, TaskRuntime_help ),
+    queue_priority( "queue-priority",
+                              0, PT_List, QueuePriority::Lookahead, QueuePriority_help ),
+    panel_target( "panel-target",
+                              0, PT_List, Target::HostTask, Target_help ),
+    compute_precision( "compute-precision",
+                              0, PT_List, ComputePrecision::Native, ComputePrecision_help ),
+    gram_precision( "gram-precision",
+                              0, PT_List, GramPrecision::Native, GramPrecision_help ),
+    device_stealing( "device-stealing",
+                              0, PT_List, 'n', "ny", "balance the tiles of batched updates across the devices of a rank" ),
 
     method_cholqr( "cholQR",  6, PT_List, MethodCholQR::Auto, MethodCholQR_help ),
     method_eig   ( "eig",     3, PT_List, MethodEig::DC, MethodEig_help ),
@@ -388,6 +505,7 @@ Params::Params():
     method_gemm  ( "gemm",    4, PT_List, MethodGemm::Auto, MethodGemm_help ),
     method_hemm  ( "hemm",    4, PT_List, MethodHemm::Auto, MethodHemm_help ),
     method_lu    ( "lu",      5, PT_List, MethodLU::PartialPiv, MethodLU_help ),
+    method_svd   ( "svd",     4, PT_List, MethodSVD::Auto, MethodSVD_help ),
     method_trsm  ( "trsm",    4, PT_List, MethodTrsm::Auto, MethodTrsm_help ),
 
     grid_order( "go",         3, PT_List, GridOrder::Col, "(go) MPI grid order: c=Col, r=Row" ),
@@ -396,6 +514,7 @@ Params::Params():
     // BLAS & LAPACK options
     layout    ( "layout",     6, PT_List, Layout::ColMajor, Layout_help ),
     itype     ( "itype",      5, PT_List, 1, 1, 3, itype_help ),
+    update_sign( "sign",      4, PT_List, 1, -1, 1, "1: update, -1: downdate of the Cholesky factor (potrf_update)" ),
     jobz      ( "jobz",       5, PT_List, Job::NoVec, Job_eig_help ),
     jobvl     ( "jobvl",      5, PT_List, Job::NoVec, Job_eig_left_help ),
     jobvr     ( "jobvr",      5, PT_List, Job::NoVec, Job_eig_right_help ),
@@ -443,11 +562,15 @@ Params::Params():
 
     // SLATE options
     grid      ( "grid",       3,    PT_List,   "1x1",    0,  1e6, "MPI grid p by q dimensions" ),
-    lookahead ( "la",         2,    PT_List,       1,    0,  1e6, "(la) number of lookahead panels" ),
+    lookahead ( "la",         2,    PT_List,       1,   -1,  1e6, "(la) number of lookahead panels; -1: auto (getrf, potrf)" ),
     panel_threads( "pt",      2,    PT_List, std::max( omp_get_max_threads() / 2, 1 ),
                                                          0,  1e6, "(pt) max number of threads used in panel; default omp_num_threads / 2" ),
+    panel_cores( "panel-cores",
+                              0,    PT_List,       0,    0,  1e6, "number of cores reserved for panel and communication threads (getrf); 0: off" ),
     nonuniform_nb( "nonuniform-nb",
                               0,    PT_List, 'n', "ny", "generate matrix with nonuniform tile sizes" ),
+    sym_grid( "sym-grid",
+                              0,    PT_List, 'n', "ny", "distribute Hermitian and triangular matrices symmetric block cyclic over p*q ranks" ),
     pivot_threshold(
                 "threshold",  6, 2, PT_List, 1.0,   0.0,     1.0, "threshold for pivoting a remote row" ),
     deflate   ( "deflate",   12,    PT_List, "",
@@ -456,6 +579,32 @@ Params::Params():
     itermax   ( "itermax",    7,    PT_List, 30,     -1, 1e6, "Maximum number of iterations for refinement" ),
     fallback  ( "fallback",   0,    PT_List, 'y',  "ny",      "If refinement fails, fallback to a robust solver" ),
     depth     ( "depth",      5,    PT_List,  2,      0, 1e3, "Number of butterflies to apply" ),
+    layers    ( "layers",     6,    PT_List,  0,      0, 1e6, "Number of layers of ranks for 2.5D gemm; 0: auto" ),
+    group     ( "group",      5,    PT_List,  4,      1, 1e6, "Number of independent problems for grouped gemm" ),
+    tree_arity( "arity",      5,    PT_List,  2,      2, 1e6, "Arity of the QR reduction tree across ranks" ),
+    trailing_block( "trailing-block",
+                              0,    PT_List,  1,      1, 1e6, "block columns per trailing update task (getrf, potrf, geqrf on host)" ),
+    gmres_steps( "gmres-steps",
+                              0,    PT_List,  1,      1, 1e3, "s-step GMRES steps between reductions (gesv/posv_mixed_gmres); 1: classical" ),
+    tail_shrink( "tail-shrink",
+                              0,    PT_List,  0,      0, 1e6, "trailing block columns at which getrf finishes on a smaller grid; 0: off" ),
+    equilibrate( "equilibrate",
+                              0,    PT_List, 'n',  "ny",      "Equilibrate badly scaled systems (gesv, posv)" ),
+    fused_solve( "fused-solve",
+                              0,    PT_List, 'n',  "ny",      "Forward substitution during the factorization (gesv, posv)" ),
+    panel_callback( "panel-callback",
+                              0,    PT_List, 'n',  "ny",      "Check the callback on each final block column (potrf, posv, geqrf)" ),
+    panel_sub_tile( "panel-sub-tile",
+                              0,    PT_List,  0,      0, 1e6, "sub-tile size on which potrf factors diagonal tiles on host; 0: off" ),
+    tiles     ( "tiles",      5,    PT_List,  1,      1, 1e6, "Number of tiles sent per iteration (comm); tiles per batch (kernel)" ),
+    set_size  ( "set-size",   8,    PT_List,  0,      0, 1e6, "Number of ranks in the broadcast or reduction set, including the root; 0: all (comm)" ),
+    radix     ( "radix",      5,    PT_List,  0,      0, 1e3, "Radix of the broadcast and reduction trees; 0: each routine's default (comm)" ),
+    gpu_aware ( "gpu-aware",  9,    PT_List, slate::gpu_aware_mpi() ? 'y' : 'n',
+                                             "ny", "Whether MPI is GPU-aware; default $SLATE_GPU_AWARE_MPI (comm)" ),
+    niter     ( "niter",      5,    PT_List, 10,      1, 1e6, "Number of timed iterations, after one warmup (comm, kernel)" ),
+    oversample( "oversample", 5,    PT_List, 10,      0, 1e6, "Number of extra sketch columns for randomized SVD" ),
+    power_iters( "power",     5,    PT_List,  2,      0, 1e3, "Number of power iterations for randomized SVD" ),
+    tlr_tol   ( "tlr-tol",    9, 1, PT_List, 1e-8,    0,   1, "Tile low-rank compression tolerance, relative to ||A||_1" ),
 
     //----- output parameters
     // min, max are ignored
@@ -501,6 +650,9 @@ Params::Params():
     ref_gflops( "ref gflop/s",  12, 3, PT_Out, no_data, 0, 0, "reference Gflop/s rate" ),
     ref_gbytes( "ref gbyte/s",  12, 3, PT_Out, no_data, 0, 0, "reference Gbyte/s rate" ),
     ref_iters ( "ref iters",     5,    PT_Out, 0,       0, 0, "reference iterations to solution" ),
+    efficiency( "efficiency",   10, 3, PT_Out, no_data, 0, 0, "parallel efficiency, relative to the first grid (scaling)" ),
+    joules    ( "energy (J)",   10, 1, PT_Out, no_data, 0, 0, "energy of the timed region, all nodes (--energy)" ),
+    gflops_w  ( "gflop/s/W",    10, 3, PT_Out, no_data, 0, 0, "Gflop/s per watt (--energy)" ),
 
     // default -1 means "no check"
     //          name,         w, type, default, min, max, help
@@ -520,6 +672,7 @@ Params::Params():
     method_gemm.name("gemm", "method-gemm");
     method_hemm.name("hemm", "method-hemm");
     method_lu.name("lu", "method-lu");
+    method_svd.name("svd", "method-svd");
     method_trsm.name("trsm", "method-trsm");
 
     // change names of matrix B's params
@@ -547,11 +700,19 @@ Params::Params():
     ref();
     trace();
     trace_scale();
+    trace_format();
+    trace_analysis();
+    tune();
+    scaling();
+    peak_gflops();
+    peak_gbytes();
+    energy();
     tol();
     repeat();
     verbose();
     cache();
     debug_rank();
+    output();
     print_edgeitems();
     print_width();
     print_precision();
@@ -627,6 +788,199 @@ int print_reduce_error(
     return err_first.err;
 }
 
+// -----------------------------------------------------------------------------
+/// Records the parameters and rate of a test that passed in the tuning
+/// database, if it is the fastest so far for its routine, precision,
+/// target, size class, and grid.
+///
+void record_tuning( Params& params, slate::TuningDB& db )
+{
+    double gflops = params.gflops();
+    if (! (gflops > 0))
+        return;
+
+    slate::TuningKey key = {
+        params.routine, char( params.datatype() ), params.target(),
+        slate::TuningDB::sizeClass( std::max( params.dim.m(), params.dim.n() ) ),
+        int( params.grid.m() ), int( params.grid.n() ) };
+    slate::TuningEntry entry;
+    entry.nb            = params.nb();
+    entry.ib            = params.ib();
+    entry.lookahead     = params.lookahead();
+    entry.panel_threads = params.panel_threads();
+    entry.gflops        = gflops;
+    db.record( key, entry );
+}
+
+// -----------------------------------------------------------------------------
+/// @return whether this rank is the first of its node in comm; sets
+/// num_nodes to the number of nodes, i.e., shared-memory groups of ranks,
+/// of comm. Collective on comm.
+static bool node_leader( MPI_Comm comm, int& num_nodes )
+{
+    int mpi_rank, node_rank;
+    MPI_Comm node_comm;
+    slate_mpi_call( MPI_Comm_rank( comm, &mpi_rank ) );
+    slate_mpi_call(
+        MPI_Comm_split_type( comm, MPI_COMM_TYPE_SHARED, mpi_rank,
+                             MPI_INFO_NULL, &node_comm ) );
+    slate_mpi_call( MPI_Comm_rank( node_comm, &node_rank ) );
+    slate_mpi_call( MPI_Comm_free( &node_comm ) );
+    int is_leader = (node_rank == 0);
+    slate_mpi_call(
+        MPI_Allreduce( &is_leader, &num_nodes, 1, MPI_INT, MPI_SUM, comm ) );
+    return is_leader;
+}
+
+// -----------------------------------------------------------------------------
+/// Merges counters over tester_comm() and prints them on rank 0, then
+/// clears them. The peaks per node are multiplied by the number of nodes,
+/// the number of shared-memory groups of ranks in tester_comm().
+///
+void print_phase_counters( slate::Counters& counters, Params& params )
+{
+    MPI_Comm comm = tester_comm();
+    counters.merge( comm );
+
+    int mpi_rank, num_nodes;
+    slate_mpi_call( MPI_Comm_rank( comm, &mpi_rank ) );
+    node_leader( comm, num_nodes );
+
+    if (mpi_rank == 0) {
+        counters.print( stdout, params.peak_gflops() * num_nodes,
+                                params.peak_gbytes() * num_nodes );
+        counters.printMessages( stdout );
+    }
+    counters.clear();
+}
+
+// -----------------------------------------------------------------------------
+// Communicator of the tests; see tester_comm.
+static MPI_Comm s_tester_comm = MPI_COMM_WORLD;
+
+MPI_Comm tester_comm()
+{
+    return s_tester_comm;
+}
+
+// -----------------------------------------------------------------------------
+/// With --energy, (barrier_get_wtime, trace::now) times of the current test.
+static bool s_energy_marking = false;
+static std::vector< std::pair< double, double > > s_energy_marks;
+
+void energy_mark( double wtime )
+{
+    if (s_energy_marking)
+        s_energy_marks.push_back( { wtime, slate::trace::now() } );
+}
+
+// -----------------------------------------------------------------------------
+/// Sets params.joules() and params.gflops_w() of a test with --energy, from
+/// the average power of each node during the timed region, summed over the
+/// nodes of tester_comm(), as energy counters are per node. The timed
+/// region is the last pair of barrier_get_wtime times whose difference is
+/// params.time(); if there is none, e.g., the test times without
+/// barrier_get_wtime, it is the whole test, [start, stop).
+/// Collective on tester_comm().
+///
+void energy_efficiency( Params& params, double start, double stop )
+{
+    double time = params.time();
+    double t0 = start, t1 = stop;
+    bool found = false;
+    for (size_t b = s_energy_marks.size(); b-- > 1 && ! found && time > 0; ) {
+        for (size_t a = b; a-- > 0 && ! found; ) {
+            double span = s_energy_marks[ b ].first - s_energy_marks[ a ].first;
+            if (std::abs( span - time ) <= 1e-9 * std::max( 1.0, time )) {
+                t0 = s_energy_marks[ a ].second;
+                t1 = s_energy_marks[ b ].second;
+                found = true;
+            }
+        }
+    }
+    s_energy_marks.clear();
+
+    MPI_Comm comm = tester_comm();
+    int num_nodes;
+    bool leader = node_leader( comm, num_nodes );
+    double watts = 0, sum_watts;
+    if (leader && t1 > t0)
+        watts = slate::trace::Energy::joules( t0, t1 ) / (t1 - t0);
+    slate_mpi_call(
+        MPI_Allreduce( &watts, &sum_watts, 1, MPI_DOUBLE, MPI_SUM, comm ) );
+
+    if (sum_watts > 0) {
+        params.joules() = sum_watts * (time > 0 ? time : t1 - t0);
+        if (params.gflops() > 0)
+            params.gflops_w() = params.gflops() / sum_watts;
+    }
+}
+
+// -----------------------------------------------------------------------------
+/// Baseline of a scaling study: the first grid run with given parameters.
+struct ScalingBase {
+    int64_t nranks;
+    double time;
+    double gflops;
+};
+
+// -----------------------------------------------------------------------------
+/// Sets params.efficiency() of a test in --scaling mode, relative to the
+/// baseline, which the first test of each set of parameters (except p, q)
+/// becomes. With a Gflop/s rate, efficiency is the rate per rank relative
+/// to the baseline's, for both strong and weak scaling. Otherwise, strong
+/// scaling efficiency is (T_base P_base) / (T P), and weak scaling
+/// efficiency is T_base / T, where T is time and P is the number of ranks.
+///
+/// @param[in] key
+///     Parameters of the test, except p, q, and the repeat index, with
+///     dimensions before weak scaling.
+///
+void scaling_efficiency(
+    Params& params, std::string const& key,
+    std::map< std::string, ScalingBase >& bases )
+{
+    int64_t nranks = params.grid.m() * params.grid.n();
+    double time    = params.time();
+    double gflops  = params.gflops();
+    if (! (time > 0))
+        return;
+
+    auto iter = bases.find( key );
+    if (iter == bases.end()) {
+        bases[ key ] = { nranks, time, gflops };
+        params.efficiency() = 1.0;
+        return;
+    }
+
+    ScalingBase& base = iter->second;
+    if (gflops > 0 && base.gflops > 0)
+        params.efficiency() = (gflops / nranks) / (base.gflops / base.nranks);
+    else if (params.scaling() == 's')
+        params.efficiency() = (base.time * base.nranks) / (time * nranks);
+    else
+        params.efficiency() = base.time / time;
+}
+
+// -----------------------------------------------------------------------------
+/// Prints time of each phase in slate::timers, e.g., gesv::getrf, and its
+/// percent of the test's time, after the test's row of output.
+///
+void print_phases( double time )
+{
+    if (slate::timers.empty())
+        return;
+
+    printf( "%%   phases:" );
+    for (auto& timer : slate::timers) {
+        printf( " %s %.3f s", timer.first.c_str(), timer.second );
+        if (time > 0)
+            printf( " (%.1f%%)", 100 * timer.second / time );
+        printf( ";" );
+    }
+    printf( "\n" );
+}
+
 // -----------------------------------------------------------------------------
 int run(int argc, char** argv)
 {
@@ -753,9 +1107,44 @@ int run(int argc, char** argv)
         // to mark any new fields as used (e.g., timers).
         test_routine( params, false );
 
-        slate_assert(params.grid.m() * params.grid.n() == mpi_size);
+        // Scaling studies run on sub-grids of MPI_COMM_WORLD, where
+        // ScaLAPACK would need its own grid, so they don't check or
+        // compare with a reference.
+        bool scaling = params.scaling() != 'n';
+        if (scaling) {
+            params.check() = 'n';
+            params.ref()   = 'n';
+            params.efficiency();
+        }
+        else {
+            slate_assert(params.grid.m() * params.grid.n() == mpi_size);
+        }
 
         slate::trace::Trace::pixels_per_second(params.trace_scale());
+        slate::trace::Trace::format(
+            params.trace_format() == 's' ? slate::trace::Trace::Format::SVG
+            : params.trace_format() == 'n' ? slate::trace::Trace::Format::None
+                                           : slate::trace::Trace::Format::JSON );
+        slate::trace::Trace::per_rank( params.trace_format() == 'r' );
+        slate::trace::Trace::analysis( params.trace_analysis() == 'y' );
+
+        bool energy = params.energy() == 'y';
+        if (energy) {
+            params.joules();
+            params.gflops_w();
+            if (slate::trace::Energy::sources().empty() && print) {
+                printf( "%% --energy: no readable energy counters,"
+                        " e.g., /sys/class/powercap/intel-rapl:*/energy_uj\n" );
+            }
+            slate::trace::Energy::start();
+            s_energy_marking = true;
+        }
+
+        bool tune = params.tune() == 'y';
+        slate::TuningDB& tuning_db = slate::TuningDB::instance();
+        if (tune && tuning_db.path().empty())
+            throw std::runtime_error(
+                "--tune requires SLATE_TUNING_DB to name the database file" );
 
         // Wait for debugger to attach.
         // See https://www.open-mpi.org/faq/?category=debugging#serial-debuggers
@@ -778,9 +1167,15 @@ int run(int argc, char** argv)
         }
         slate_mpi_call( MPI_Barrier( MPI_COMM_WORLD ) );
 
+        // Structured output of results, if requested.
+        std::unique_ptr< Recorder > recorder;
+        if (! params.output().empty())
+            recorder.reset( new Recorder( params.output(), argc, argv, mpi_size ) );
+
         // run tests
         int repeat = params.repeat();
         testsweeper::DataType last_datatype = params.datatype();
+        std::map< std::string, ScalingBase > scaling_bases;
 
         if (print)
             params.header();
@@ -791,20 +1186,60 @@ int run(int argc, char** argv)
                     printf("\n");
             }
 
+            // In scaling mode, run on the first p*q ranks; for weak
+            // scaling, with dimensions times sqrt( p*q ).
+            int nranks = params.grid.m() * params.grid.n();
+            MPI_Comm sub_comm = MPI_COMM_NULL;
+            testsweeper::int3_t dim = { 0, 0, 0 };
+            std::string scaling_key;
+            if (scaling) {
+                slate_assert(nranks <= mpi_size);
+                slate_mpi_call(
+                    MPI_Comm_split( MPI_COMM_WORLD,
+                                    mpi_rank < nranks ? 0 : MPI_UNDEFINED,
+                                    mpi_rank, &sub_comm ) );
+                s_tester_comm = sub_comm;
+                scaling_key = input_key( params, { "p", "q" } );
+                if (params.dim.used()) {
+                    dim = params.dim();
+                    if (params.scaling() == 'w') {
+                        double factor = std::sqrt( double( nranks ) );
+                        params.dim() = {
+                            int64_t( std::round( dim.m * factor ) ),
+                            int64_t( std::round( dim.n * factor ) ),
+                            int64_t( std::round( dim.k * factor ) ) };
+                    }
+                }
+            }
+
             for (int iter = 0; iter < repeat; ++iter) {
+                // Drop timers of the previous run from the record.
+                slate::timers.clear();
+                double start = slate::trace::now();
                 try {
-                    test_routine(params, true);
+                    if (! scaling || sub_comm != MPI_COMM_NULL)
+                        test_routine(params, true);
                 }
                 catch (const std::exception& ex) {
                     msg = ex.what();
                 }
+                if (energy && (! scaling || sub_comm != MPI_COMM_NULL))
+                    energy_efficiency( params, start, slate::trace::now() );
                 int err = print_reduce_error(msg, mpi_rank, MPI_COMM_WORLD);
                 if (err)
                     params.okay() = false;
+                if (scaling && print)
+                    scaling_efficiency( params, scaling_key, scaling_bases );
                 if (print) {
                     params.print();
+                    if (scaling)
+                        print_phases( params.time() );
                     fflush(stdout);
                 }
+                if (tune && print && params.okay())
+                    record_tuning( params, tuning_db );
+                if (recorder)
+                    recorder->record( params, iter );
                 status += ! params.okay();
                 params.reset_output();
                 msg.clear();
@@ -812,8 +1247,26 @@ int run(int argc, char** argv)
             if (repeat > 1 && print) {
                 printf("\n");
             }
+
+            if (scaling) {
+                if (params.dim.used())
+                    params.dim() = dim;
+                s_tester_comm = MPI_COMM_WORLD;
+                if (sub_comm != MPI_COMM_NULL)
+                    slate_mpi_call( MPI_Comm_free( &sub_comm ) );
+            }
         } while (params.next());
 
+        if (energy) {
+            s_energy_marking = false;
+            slate::trace::Energy::stop();
+        }
+
+        if (tune && print) {
+            tuning_db.save( tuning_db.path() );
+            printf( "%% Saved tuning database %s\n", tuning_db.path().c_str() );
+        }
+
         if (print) {
             std::vector< std::string > sort_matrix_labels(
                     matrix_labels.size() + 1 );
@@ -97,6 +97,8 @@ inline void from_string( std::string const& str, Target* val )
     else if (str_ == "d" || str_ == "dev" || str_ == "device"
              || str_ == "devices")
         *val = Target::Devices;
+    else if (str_ == "y" || str_ == "hybrid")
+        *val = Target::Hybrid;
     else if (str_ == "h" || str_ == "host")
         *val = Target::Host;
     else
@@ -111,6 +113,7 @@ inline const char* to_c_string( Target value )
         case Target::HostNest:  return "nest";
         case Target::HostBatch: return "batch";
         case Target::Devices:   return "dev";
+        case Target::Hybrid:    return "hybrid";
         case Target::Host:      return "host";
     }
     return "?";
@@ -213,6 +216,13 @@ public:
     testsweeper::ParamChar   ref;
     testsweeper::ParamChar   trace;
     testsweeper::ParamDouble trace_scale;
+    testsweeper::ParamChar   trace_format;
+    testsweeper::ParamChar   trace_analysis;
+    testsweeper::ParamChar   tune;
+    testsweeper::ParamChar   scaling;
+    testsweeper::ParamDouble peak_gflops;
+    testsweeper::ParamDouble peak_gbytes;
+    testsweeper::ParamChar   energy;
     testsweeper::ParamDouble tol;
     testsweeper::ParamInt    repeat;
     testsweeper::ParamInt    verbose;
@@ -223,6 +233,7 @@ public:
     testsweeper::ParamInt    extended;
     testsweeper::ParamInt    cache;
     testsweeper::ParamInt    debug_rank;
+    testsweeper::ParamString output;
     std::string              routine;
 
     //----- routine parameters, enums
@@ -230,6 +241,18 @@ public:
     testsweeper::ParamEnum< slate::Origin >         origin;
     testsweeper::ParamEnum< slate::Target >         target;
     testsweeper::ParamChar                          hold_local_workspace;
+    testsweeper::ParamChar                          first_touch;
+    testsweeper::ParamChar                          bcast_packed;
+    testsweeper::ParamChar                          bcast_partitioned;
+    testsweeper::ParamChar                          progress_thread;
+    testsweeper::ParamEnum< slate::BcastPrecision > bcast_precision;
+    testsweeper::ParamChar                          counters;
+    testsweeper::ParamEnum< slate::TaskRuntime >    runtime;
+    testsweeper::ParamEnum< slate::QueuePriority >  queue_priority;
+    testsweeper::ParamEnum< slate::Target >         panel_target;
+    testsweeper::ParamEnum< slate::ComputePrecision > compute_precision;
+    testsweeper::ParamEnum< slate::GramPrecision >  gram_precision;
+    testsweeper::ParamChar                          device_stealing;
 
     testsweeper::ParamEnum< slate::MethodCholQR >   method_cholqr;
     testsweeper::ParamEnum< slate::MethodEig >      method_eig;
@@ -237,6 +260,7 @@ public:
     testsweeper::ParamEnum< slate::MethodGemm >     method_gemm;
     testsweeper::ParamEnum< slate::MethodHemm >     method_hemm;
     testsweeper::ParamEnum< slate::MethodLU >       method_lu;
+    testsweeper::ParamEnum< slate::MethodSVD >      method_svd;
     testsweeper::ParamEnum< slate::MethodTrsm >     method_trsm;
 
     testsweeper::ParamEnum< slate::GridOrder >      grid_order;
@@ -260,6 +284,7 @@ public:
     // ijob, itype are classified as enums due to their limited values.
     testsweeper::ParamEnum< blas::Layout >          layout;
     testsweeper::ParamInt                           itype;  // hegv
+    testsweeper::ParamInt                           update_sign;  // potrf_update
     testsweeper::ParamEnum< lapack::Job >           jobz;   // heev
     testsweeper::ParamEnum< lapack::Job >           jobvl;  // geev
     testsweeper::ParamEnum< lapack::Job >           jobvr;  // geev
@@ -303,12 +328,32 @@ public:
     testsweeper::ParamInt3    grid;  // p x q
     testsweeper::ParamInt     lookahead;
     testsweeper::ParamInt     panel_threads;
+    testsweeper::ParamInt     panel_cores;
     testsweeper::ParamChar    nonuniform_nb;
+    testsweeper::ParamChar    sym_grid;
     testsweeper::ParamDouble  pivot_threshold;
     testsweeper::ParamString  deflate;
     testsweeper::ParamInt     itermax;
     testsweeper::ParamChar    fallback;
     testsweeper::ParamInt     depth;
+    testsweeper::ParamInt     layers;
+    testsweeper::ParamInt     group;
+    testsweeper::ParamInt     tree_arity;
+    testsweeper::ParamInt     trailing_block;
+    testsweeper::ParamInt     gmres_steps;
+    testsweeper::ParamInt     tail_shrink;
+    testsweeper::ParamChar    equilibrate;
+    testsweeper::ParamChar    fused_solve;
+    testsweeper::ParamChar    panel_callback;
+    testsweeper::ParamInt     panel_sub_tile;
+    testsweeper::ParamInt     tiles;      // comm, kernel
+    testsweeper::ParamInt     set_size;   // comm
+    testsweeper::ParamInt     radix;      // comm
+    testsweeper::ParamChar    gpu_aware;  // comm
+    testsweeper::ParamInt     niter;      // comm, kernel
+    testsweeper::ParamInt     oversample;
+    testsweeper::ParamInt     power_iters;
+    testsweeper::ParamScientific tlr_tol;
 
     //----- output parameters
     testsweeper::ParamScientific value;
@@ -348,6 +393,9 @@ public:
     testsweeper::ParamDouble     ref_gflops;
     testsweeper::ParamDouble     ref_gbytes;
     testsweeper::ParamInt        ref_iters;
+    testsweeper::ParamDouble     efficiency;
+    testsweeper::ParamDouble     joules;
+    testsweeper::ParamDouble     gflops_w;
 
     testsweeper::ParamOkay       okay;
     testsweeper::ParamString     msg;
@@ -364,6 +412,7 @@ inline T roundup(T x, T y)
 // Level 3 BLAS
 void test_gbmm   (Params& params, bool run);
 void test_gemm   (Params& params, bool run);
+void test_gemm_grouped(Params& params, bool run);
 void test_symm   (Params& params, bool run);
 void test_syr2k  (Params& params, bool run);
 void test_syrk   (Params& params, bool run);
@@ -377,6 +426,7 @@ void test_herk   (Params& params, bool run);
 
 // LU, general
 void test_gesv       (Params& params, bool run);
+void test_gesv_handle(Params& params, bool run);
 void test_gecondest  (Params& params, bool run);
 void test_getri      (Params& params, bool run);
 void test_trtri      (Params& params, bool run);
@@ -388,6 +438,8 @@ void test_gbsv   (Params& params, bool run);
 void test_posv      (Params& params, bool run);
 void test_pocondest (Params& params, bool run);
 void test_potri     (Params& params, bool run);
+void test_potrf_tlr (Params& params, bool run);
+void test_potrf_update (Params& params, bool run);
 
 // Cholesky, band
 void test_pbsv   (Params& params, bool run);
@@ -405,6 +457,7 @@ void test_hetrs  (Params& params, bool run);
 // QR, LQ, RQ, QL
 void test_gels      (Params& params, bool run);
 void test_geqrf     (Params& params, bool run);
+void test_geqrf_update (Params& params, bool run);
 void test_gelqf     (Params& params, bool run);
 void test_unmqr     (Params& params, bool run);
 void test_trcondest (Params& params, bool run);
@@ -431,6 +484,8 @@ void test_hegst  (Params& params, bool run);
 
 // SVD
 void test_svd    (Params& params, bool run);
+void test_svd_rand(Params& params, bool run);
+void test_polar   (Params& params, bool run);
 void test_ge2tb  (Params& params, bool run);
 void test_tb2bd  (Params& params, bool run);
 void test_bdsqr  (Params& params, bool run);
@@ -452,12 +507,35 @@ void test_scale  (Params& params, bool run);
 void test_scale_row_col(Params& params, bool run);
 void test_set    (Params& params, bool run);
 
+// communication microbenchmarks
+void test_comm   (Params& params, bool run);
+
+// tile and device kernel microbenchmarks
+void test_kernel (Params& params, bool run);
+
+//------------------------------------------------------------------------------
+/// @return MPI communicator the tests run on: MPI_COMM_WORLD, or in
+/// tester --scaling mode, the ranks of the current p-by-q sub-grid.
+MPI_Comm tester_comm();
+
+//------------------------------------------------------------------------------
+/// Merges counters over tester_comm() and prints them on rank 0, with the
+/// percent of --peak-gflops and --peak-gbytes, then clears them.
+void print_phase_counters( slate::Counters& counters, Params& params );
+
+//------------------------------------------------------------------------------
+/// With --energy, records a time from barrier_get_wtime, so the energy of
+/// a test's timed region, between two such times, can be found.
+void energy_mark( double wtime );
+
 //------------------------------------------------------------------------------
 inline double barrier_get_wtime(MPI_Comm comm)
 {
     slate::trace::Block trace_block("MPI_Barrier");
     MPI_Barrier(comm);
-    return testsweeper::get_wtime();
+    double wtime = testsweeper::get_wtime();
+    energy_mark( wtime );
+    return wtime;
 }
 
 //------------------------------------------------------------------------------
@@ -114,11 +114,11 @@ void test_add_work(Params& params, bool run)
         // Run SLATE test.
         // Add B = alpha A + beta B.
         //==================================================
-        double time = barrier_get_wtime(MPI_COMM_WORLD);
+        double time = barrier_get_wtime(tester_comm());
 
         slate::add( alpha, A, beta, B, opts );
 
-        time = barrier_get_wtime(MPI_COMM_WORLD) - time;
+        time = barrier_get_wtime(tester_comm()) - time;
 
         if (trace) slate::trace::Trace::finish();
 
@@ -148,7 +148,7 @@ void test_add_work(Params& params, bool run)
             //==================================================
             // Run ScaLAPACK reference routine.
             //==================================================
-            double time = barrier_get_wtime(MPI_COMM_WORLD);
+            double time = barrier_get_wtime(tester_comm());
 
             int64_t info;
             if (uplo == slate::Uplo::General) {
@@ -163,7 +163,7 @@ void test_add_work(Params& params, bool run)
             }
             slate_assert(info == 0);
 
-            time = barrier_get_wtime(MPI_COMM_WORLD) - time;
+            time = barrier_get_wtime(tester_comm()) - time;
             params.ref_time() = time;
 
             print_matrix( "Aref_full_out", Aref_full, params );
@@ -55,7 +55,7 @@ void test_bdsqr_work(Params& params, bool run)
 
     // MPI variables
     int mpi_rank, myrow, mycol;
-    MPI_Comm_rank(MPI_COMM_WORLD, &mpi_rank);
+    MPI_Comm_rank(tester_comm(), &mpi_rank);
     gridinfo(mpi_rank, p, q, &myrow, &mycol);
 
     int64_t min_mn = std::min(m, n);
@@ -90,11 +90,11 @@ void test_bdsqr_work(Params& params, bool run)
     if (origin != slate::Origin::ScaLAPACK) {
         // SLATE allocates CPU or GPU tiles.
         if (wantu) {
-            U = slate::Matrix<scalar_t>(m, min_mn, nb, p, q, MPI_COMM_WORLD);
+            U = slate::Matrix<scalar_t>(m, min_mn, nb, p, q, tester_comm());
             U.insertLocalTiles();
         }
         if (wantvt) {
-            VT = slate::Matrix<scalar_t>(min_mn, n, nb, p, q, MPI_COMM_WORLD);
+            VT = slate::Matrix<scalar_t>(min_mn, n, nb, p, q, tester_comm());
             VT.insertLocalTiles();
         }
     }
@@ -103,12 +103,12 @@ void test_bdsqr_work(Params& params, bool run)
         if (wantu) {
             U_data.resize(lldU*nlocU);
             U = slate::Matrix<scalar_t>::fromScaLAPACK(
-                    m, min_mn, &U_data[0], lldU, nb, p, q, MPI_COMM_WORLD);
+                    m, min_mn, &U_data[0], lldU, nb, p, q, tester_comm());
         }
         if (wantvt) {
             VT_data.resize(lldVT*nlocVT);
             VT = slate::Matrix<scalar_t>::fromScaLAPACK(
-                     min_mn, n, &VT_data[0], lldVT, nb, p, q, MPI_COMM_WORLD);
+                     min_mn, n, &VT_data[0], lldVT, nb, p, q, tester_comm());
         }
     }
 
@@ -122,14 +122,14 @@ void test_bdsqr_work(Params& params, bool run)
     if (trace) slate::trace::Trace::on();
     else slate::trace::Trace::off();
 
-    double time = barrier_get_wtime(MPI_COMM_WORLD);
+    double time = barrier_get_wtime(tester_comm());
 
     //==================================================
     // Run SLATE test.
     //==================================================
     slate::bdsqr<scalar_t>(jobu, jobvt, D, E, U, VT);
 
-    params.time() = barrier_get_wtime(MPI_COMM_WORLD) - time;
+    params.time() = barrier_get_wtime(tester_comm()) - time;
 
     if (trace)
         slate::trace::Trace::finish();
@@ -154,13 +154,13 @@ void test_bdsqr_work(Params& params, bool run)
         //==================================================
         // Run LAPACK reference routine.
         //==================================================
-        time = barrier_get_wtime(MPI_COMM_WORLD);
+        time = barrier_get_wtime(tester_comm());
 
         scalar_t dummy[1];  // U, VT, C not needed for NoVec
         lapack::bdsqr(uplo, n, 0, 0, 0,
                       &Dref[0], &Eref[0], dummy, 1, dummy, 1, dummy, 1);
 
-        params.ref_time() = barrier_get_wtime(MPI_COMM_WORLD) - time;
+        params.ref_time() = barrier_get_wtime(tester_comm()) - time;
 
         if (mpi_rank == 0) {
             print_vector( "Dref_out", Dref, params );
@@ -181,7 +181,7 @@ void test_bdsqr_work(Params& params, bool run)
         //
         //==================================================
         if (wantu) {
-            slate::Matrix<scalar_t> Id(min_mn, min_mn, nb, p, q, MPI_COMM_WORLD);
+            slate::Matrix<scalar_t> Id(min_mn, min_mn, nb, p, q, tester_comm());
             Id.insertLocalTiles();
             set(zero, one, Id);
 
@@ -192,7 +192,7 @@ void test_bdsqr_work(Params& params, bool run)
         }
         // If we flip the fat matrix, then no need for Id
         if (wantvt) {
-            slate::Matrix<scalar_t> Id(n, n, nb, p, q, MPI_COMM_WORLD);
+            slate::Matrix<scalar_t> Id(n, n, nb, p, q, tester_comm());
             Id.insertLocalTiles();
             set(zero, one, Id);
 
@@ -0,0 +1,259 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/slate.hh"
+#include "test.hh"
+
+#include "test_utils.hh"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <set>
+#include <utility>
+
+//------------------------------------------------------------------------------
+/// Matrix exposing the protected tileIbcastToSet, to time it on its own.
+///
+template <typename scalar_t>
+class CommMatrix: public slate::Matrix<scalar_t> {
+public:
+    CommMatrix( slate::Matrix<scalar_t> const& A )
+        : slate::Matrix<scalar_t>( A )
+    {}
+
+    using slate::BaseMatrix<scalar_t>::tileIbcastToSet;
+};
+
+//------------------------------------------------------------------------------
+/// Communication microbenchmark of one primitive of the comm layer:
+///
+/// - comm_tileBcast:       tileBcast of each tile, one call per tile;
+/// - comm_listBcast:       listBcast of all tiles;
+/// - comm_listBcastMT:     listBcastMT of all tiles, one tag per tile;
+/// - comm_listReduce:      listReduce of all tiles;
+/// - comm_tileIbcastToSet: tileIbcastToSet of each tile, then waitall.
+///
+/// The matrix has --tiles block rows of nb-by-nb tiles and set-size block
+/// columns; block column j is on rank j. Tile (i, 0) on rank 0 is
+/// broadcast to, or reduced from, ranks 1, ..., set-size - 1.
+/// --target d uses device tiles; --gpu-aware and --radix set
+/// slate::gpu_aware_mpi and slate::bcast_radix during the run.
+///
+/// Each iteration is timed by the slowest rank, after a barrier; the
+/// tester repeats --niter iterations after one warmup iteration.
+/// Output columns, one row per parameter combination, so they can be
+/// parsed after the header line like other tester output:
+/// - time (s):  mean time of one iteration over all tiles;
+/// - lat (us):  mean time per tile;
+/// - gbyte/s:   bytes received by all ranks in the set, per second;
+/// - Mmsg/s:    tiles received by all ranks in the set, in millions
+///              per second.
+///
+template <typename scalar_t>
+void test_comm_work( Params& params, bool run )
+{
+    using slate::Target;
+
+    // get & mark input values
+    std::string routine = params.routine;
+    int64_t nb = params.nb();
+    int64_t ntiles = params.tiles();
+    int64_t set_size = params.set_size();
+    int radix = params.radix();
+    bool gpu_aware = params.gpu_aware() == 'y';
+    int64_t niter = params.niter();
+    slate::Target target = params.target();
+
+    // mark non-standard output values
+    params.time();
+    params.time2();
+    params.time2.name( "lat (us)" );
+    params.gbytes();
+    params.gflops2();
+    params.gflops2.name( "Mmsg/s" );
+
+    if (! run)
+        return;
+
+    int mpi_rank, mpi_size;
+    MPI_Comm_rank( tester_comm(), &mpi_rank );
+    MPI_Comm_size( tester_comm(), &mpi_size );
+
+    if (set_size == 0)
+        set_size = mpi_size;
+    if (set_size < 2 || set_size > mpi_size) {
+        params.msg() = "skipping: requires 2 <= set-size <= number of MPI ranks";
+        return;
+    }
+
+    int num_devices = blas::get_device_count();
+    bool on_devices = target == Target::Devices;
+    if (on_devices && num_devices == 0) {
+        params.msg() = "skipping: target devices requires a GPU";
+        return;
+    }
+
+    // Block column j is on rank j, on each rank's first device.
+    std::function< int64_t (int64_t) > tileNb = [nb]( int64_t ) {
+        return nb;
+    };
+    std::function< int (std::tuple<int64_t, int64_t>) > tileRank
+        = []( std::tuple<int64_t, int64_t> ij ) {
+            return int( std::get<1>( ij ) );
+        };
+    std::function< int (std::tuple<int64_t, int64_t>) > tileDevice
+        = []( std::tuple<int64_t, int64_t> ) {
+            return 0;
+        };
+    slate::Matrix<scalar_t> A0( ntiles*nb, set_size*nb, tileNb, tileNb,
+                                tileRank, tileDevice, tester_comm() );
+    A0.insertLocalTiles( on_devices ? Target::Devices : Target::Host );
+    CommMatrix<scalar_t> A( A0 );
+
+    const scalar_t zero = 0.0;
+    slate::Options const opts = {
+        {slate::Option::Target, on_devices ? Target::Devices : Target::HostTask}
+    };
+    slate::set( zero, zero, A, opts );
+
+    const slate::Layout layout = slate::Layout::ColMajor;
+    const int tree_radix = radix > 0 ? radix : 2;
+    std::set<int> bcast_set;
+    for (int r = 0; r < set_size; ++r)
+        bcast_set.insert( r );
+    bool in_set = mpi_rank < set_size;
+
+    // Sources of listReduce need tile (i, 0), which listReduce erases
+    // after sending it; insert it again before each iteration.
+    auto insert_sources = [&]() {
+        if (routine != "comm_listReduce" || ! in_set || mpi_rank == 0)
+            return;
+        for (int64_t i = 0; i < ntiles; ++i) {
+            auto T = A.tileInsertWorkspace( i, 0, slate::HostNum );
+            for (int64_t jj = 0; jj < T.nb(); ++jj)
+                std::fill_n( &T.at( 0, jj ), T.mb(), zero );
+            if (on_devices)
+                A.tileGetForReading( i, 0, 0, slate::LayoutConvert::None );
+        }
+    };
+
+    auto comm = [&]() {
+        if (routine == "comm_tileBcast") {
+            for (int64_t i = 0; i < ntiles; ++i) {
+                if (on_devices)
+                    A.template tileBcast<Target::Devices>(
+                        i, 0, A.sub( i, i, 1, set_size-1 ), layout, int( i ) );
+                else
+                    A.template tileBcast<Target::Host>(
+                        i, 0, A.sub( i, i, 1, set_size-1 ), layout, int( i ) );
+            }
+        }
+        else if (routine == "comm_listBcast") {
+            typename slate::BaseMatrix<scalar_t>::BcastList bcast_list;
+            for (int64_t i = 0; i < ntiles; ++i)
+                bcast_list.push_back( { i, 0, { A.sub( i, i, 1, set_size-1 ) } } );
+            if (on_devices)
+                A.template listBcast<Target::Devices>( bcast_list, layout );
+            else
+                A.template listBcast<Target::Host>( bcast_list, layout );
+        }
+        else if (routine == "comm_listBcastMT") {
+            typename slate::BaseMatrix<scalar_t>::BcastListTag bcast_list;
+            for (int64_t i = 0; i < ntiles; ++i)
+                bcast_list.push_back(
+                    { i, 0, { A.sub( i, i, 1, set_size-1 ) }, i } );
+            #pragma omp parallel
+            #pragma omp master
+            {
+                if (on_devices)
+                    A.template listBcastMT<Target::Devices>( bcast_list, layout );
+                else
+                    A.template listBcastMT<Target::Host>( bcast_list, layout );
+            }
+        }
+        else if (routine == "comm_listReduce") {
+            typename slate::BaseMatrix<scalar_t>::ReduceList reduce_list;
+            for (int64_t i = 0; i < ntiles; ++i)
+                reduce_list.push_back( { i, 0, A.sub( i, i, 0, 0 ),
+                                         { A.sub( i, i, 1, set_size-1 ) } } );
+            if (on_devices)
+                A.template listReduce<Target::Devices>( reduce_list, layout );
+            else
+                A.template listReduce<Target::Host>( reduce_list, layout );
+        }
+        else if (routine == "comm_tileIbcastToSet") {
+            if (! in_set)
+                return;
+            std::vector<MPI_Request> requests;
+            for (int64_t i = 0; i < ntiles; ++i)
+                A.tileIbcastToSet( i, 0, bcast_set, tree_radix, int( i ),
+                                   layout, requests, target );
+            slate::internal::waitall( requests );
+        }
+        else {
+            throw slate::Exception( "unknown routine: " + routine );
+        }
+    };
+
+    bool gpu_aware_save = slate::gpu_aware_mpi();
+    int radix_save = slate::bcast_radix();
+    slate::gpu_aware_mpi( gpu_aware );
+    slate::bcast_radix( radix );
+
+    // Warmup, which also allocates the receivers' workspace tiles.
+    insert_sources();
+    comm();
+
+    double time = 0;
+    for (int64_t iter = 0; iter < niter; ++iter) {
+        insert_sources();
+        double t = barrier_get_wtime( tester_comm() );
+        comm();
+        t = testsweeper::get_wtime() - t;
+        MPI_Allreduce( MPI_IN_PLACE, &t, 1, MPI_DOUBLE, MPI_MAX,
+                       tester_comm() );
+        time += t;
+    }
+    time /= niter;
+
+    slate::gpu_aware_mpi( gpu_aware_save );
+    slate::bcast_radix( radix_save );
+    A.clearWorkspace();
+
+    // Each tile is received once by each of set_size - 1 ranks.
+    double msgs  = double( ntiles ) * (set_size - 1);
+    double bytes = msgs * nb * nb * sizeof( scalar_t );
+    params.time()    = time;
+    params.time2()   = time / ntiles * 1e6;
+    params.gbytes()  = bytes / time * 1e-9;
+    params.gflops2() = msgs  / time * 1e-6;
+}
+
+// -----------------------------------------------------------------------------
+void test_comm( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Single:
+            test_comm_work<float> (params, run);
+            break;
+
+        case testsweeper::DataType::Double:
+            test_comm_work<double> (params, run);
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_comm_work<std::complex<float>> (params, run);
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_comm_work<std::complex<double>> (params, run);
+            break;
+
+        default:
+            throw std::runtime_error( "unknown datatype" );
+            break;
+    }
+}
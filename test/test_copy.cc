@@ -116,11 +116,11 @@ void test_copy_work(Params& params, bool run)
         // Run SLATE test.
         // Copy A to B.
         //==================================================
-        double time = barrier_get_wtime(MPI_COMM_WORLD);
+        double time = barrier_get_wtime(tester_comm());
 
         slate::copy( A, B, opts );
 
-        time = barrier_get_wtime(MPI_COMM_WORLD) - time;
+        time = barrier_get_wtime(tester_comm()) - time;
 
         if (trace) slate::trace::Trace::finish();
 
@@ -150,13 +150,13 @@ void test_copy_work(Params& params, bool run)
             //==================================================
             // Run ScaLAPACK reference routine.
             //==================================================
-            double time = barrier_get_wtime(MPI_COMM_WORLD);
+            double time = barrier_get_wtime(tester_comm());
 
             scalapack_placpy( to_c_string( uplo ), m, n,
                               &Aref_data[0], 1, 1, A_desc,
                               &Bref_data[0], 1, 1, B_desc );
 
-            time = barrier_get_wtime(MPI_COMM_WORLD) - time;
+            time = barrier_get_wtime(tester_comm()) - time;
             params.ref_time() = time;
 
             print_matrix( "Aref_full_out", Aref_full, params );
@@ -89,7 +89,7 @@ void test_gbmm_work(Params& params, bool run)
 
     // MPI variables
     int mpi_rank, myrow, mycol;
-    MPI_Comm_rank(MPI_COMM_WORLD, &mpi_rank);
+    MPI_Comm_rank(tester_comm(), &mpi_rank);
     gridinfo(mpi_rank, p, q, &myrow, &mycol);
 
     // Matrix A: figure out local size.
@@ -111,11 +111,11 @@ void test_gbmm_work(Params& params, bool run)
     std::vector<scalar_t> C_data(lldC*nlocC);
 
     auto A = slate::Matrix<scalar_t>::fromScaLAPACK(
-                 Am, An, &A_data[0], lldA, nb, p, q, MPI_COMM_WORLD );
+                 Am, An, &A_data[0], lldA, nb, p, q, tester_comm() );
     auto B = slate::Matrix<scalar_t>::fromScaLAPACK(
-                 Bm, Bn, &B_data[0], lldB, nb, p, q, MPI_COMM_WORLD);
+                 Bm, Bn, &B_data[0], lldB, nb, p, q, tester_comm());
     auto C = slate::Matrix<scalar_t>::fromScaLAPACK(
-                 m, n, &C_data[0], lldC, nb, p, q, MPI_COMM_WORLD);
+                 m, n, &C_data[0], lldC, nb, p, q, tester_comm());
     slate::generate_matrix(params.matrix,  A);
     slate::generate_matrix(params.matrixB, B);
     slate::generate_matrix(params.matrixC, C);
@@ -123,12 +123,12 @@ void test_gbmm_work(Params& params, bool run)
 
     // create SLATE matrices from the ScaLAPACK layouts
     auto A_band = BandFromScaLAPACK(
-                      Am, An, kl, ku, &A_data[0], lldA, nb, p, q, MPI_COMM_WORLD);
+                      Am, An, kl, ku, &A_data[0], lldA, nb, p, q, tester_comm());
 
     // If check is required, copy test data.
     slate::Matrix<scalar_t> Cref;
     if (check || ref) {
-        Cref = slate::Matrix<scalar_t>(m, n, nb, p, q, MPI_COMM_WORLD);
+        Cref = slate::Matrix<scalar_t>(m, n, nb, p, q, tester_comm());
         Cref.insertLocalTiles();
         slate::copy( C, Cref );
     }
@@ -162,7 +162,7 @@ void test_gbmm_work(Params& params, bool run)
     if (trace) slate::trace::Trace::on();
     else slate::trace::Trace::off();
 
-    double time = barrier_get_wtime(MPI_COMM_WORLD);
+    double time = barrier_get_wtime(tester_comm());
 
     //==================================================
     // Run SLATE test.
@@ -172,7 +172,7 @@ void test_gbmm_work(Params& params, bool run)
     // Using traditional BLAS/LAPACK name
     // slate::gbmm(alpha, A_band, B, beta, C, opts);
 
-    time = barrier_get_wtime(MPI_COMM_WORLD) - time;
+    time = barrier_get_wtime(tester_comm()) - time;
 
     if (trace) slate::trace::Trace::finish();
 
@@ -202,11 +202,11 @@ void test_gbmm_work(Params& params, bool run)
         //==================================================
         // Run SLATE non-band routine
         //==================================================
-        time = barrier_get_wtime(MPI_COMM_WORLD);
+        time = barrier_get_wtime(tester_comm());
 
         slate::multiply( alpha, A, B, beta, Cref, opts );
 
-        time = barrier_get_wtime(MPI_COMM_WORLD) - time;
+        time = barrier_get_wtime(tester_comm()) - time;
 
         print_matrix( "Cref_out", Cref, params );
 
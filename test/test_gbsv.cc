@@ -87,7 +87,7 @@ void test_gbsv_work(Params& params, bool run)
 
     // MPI variables
     int mpi_rank, myrow, mycol;
-    MPI_Comm_rank(MPI_COMM_WORLD, &mpi_rank);
+    MPI_Comm_rank(tester_comm(), &mpi_rank);
     gridinfo(mpi_rank, p, q, &myrow, &mycol);
 
     // Matrix B: figure out local size.
@@ -98,13 +98,13 @@ void test_gbsv_work(Params& params, bool run)
 
     // Create SLATE matrix from the ScaLAPACK layouts
     auto B = slate::Matrix<scalar_t>::fromScaLAPACK(
-                 n, nrhs, &B_data[0], lldB, nb, p, q, MPI_COMM_WORLD);
+                 n, nrhs, &B_data[0], lldB, nb, p, q, tester_comm());
 
     slate::generate_matrix(params.matrix, B);
 
     int64_t iseeds[4] = { myrow, mycol, 2, 3 };
-    auto A     = slate::BandMatrix<scalar_t>(m, n, kl, ku, nb, p, q, MPI_COMM_WORLD);
-    auto Aorig = slate::BandMatrix<scalar_t>(m, n, kl, ku, nb, p, q, MPI_COMM_WORLD);
+    auto A     = slate::BandMatrix<scalar_t>(m, n, kl, ku, nb, p, q, tester_comm());
+    auto Aorig = slate::BandMatrix<scalar_t>(m, n, kl, ku, nb, p, q, tester_comm());
     slate::Pivots pivots;
 
     int64_t klt = slate::ceildiv(kl, nb);
@@ -147,7 +147,7 @@ void test_gbsv_work(Params& params, bool run)
     // if check is required, copy test data
     slate::Matrix<scalar_t> Bref;
     if (check || ref) {
-        Bref = slate::Matrix<scalar_t>(n, nrhs, nb, p, q, MPI_COMM_WORLD);
+        Bref = slate::Matrix<scalar_t>(n, nrhs, nb, p, q, tester_comm());
         Bref.insertLocalTiles();
         slate::copy( B, Bref);
     }
@@ -172,7 +172,7 @@ void test_gbsv_work(Params& params, bool run)
         if (trace) slate::trace::Trace::on();
         else slate::trace::Trace::off();
 
-        double time = barrier_get_wtime(MPI_COMM_WORLD);
+        double time = barrier_get_wtime(tester_comm());
 
         //==================================================
         // Run SLATE test.
@@ -203,7 +203,7 @@ void test_gbsv_work(Params& params, bool run)
             // slate::gbsv(A, pivots, B, opts);
         }
 
-        time = barrier_get_wtime(MPI_COMM_WORLD) - time;
+        time = barrier_get_wtime(tester_comm()) - time;
 
         if (trace) slate::trace::Trace::finish();
 
@@ -67,7 +67,7 @@ void test_ge2tb_work(Params& params, bool run)
 
     // MPI variables
     int mpi_rank, myrow, mycol;
-    MPI_Comm_rank(MPI_COMM_WORLD, &mpi_rank);
+    MPI_Comm_rank(tester_comm(), &mpi_rank);
     gridinfo(mpi_rank, p, q, &myrow, &mycol);
 
     // Matrix A: figure out local size.
@@ -79,14 +79,14 @@ void test_ge2tb_work(Params& params, bool run)
     slate::Matrix<scalar_t> A;
     if (origin != slate::Origin::ScaLAPACK) {
         // SLATE allocates CPU or GPU tiles.
-        A = slate::Matrix<scalar_t>(m, n, nb, p, q, MPI_COMM_WORLD);
+        A = slate::Matrix<scalar_t>(m, n, nb, p, q, tester_comm());
         A.insertLocalTiles(origin2target(origin));
     }
     else {
         // Create SLATE matrices from the ScaLAPACK layouts.
         A_data.resize( lldA*nlocal );
         A = slate::Matrix<scalar_t>::fromScaLAPACK(
-                m, n, A_data.data(), lldA, nb, p, q, MPI_COMM_WORLD);
+                m, n, A_data.data(), lldA, nb, p, q, tester_comm());
     }
     slate::TriangularFactors<scalar_t> TU, TV;
 
@@ -95,21 +95,21 @@ void test_ge2tb_work(Params& params, bool run)
     print_matrix("A", A, params);
 
     // Copy test data for check.
-    slate::Matrix<scalar_t> Aref(m, n, nb, p, q, MPI_COMM_WORLD);
+    slate::Matrix<scalar_t> Aref(m, n, nb, p, q, tester_comm());
     Aref.insertLocalTiles();
     slate::copy(A, Aref);
 
     slate::Matrix<scalar_t> U, VT;
     // Create U and U1d. Set U to Identity.
     if (wantu) {
-        U = slate::Matrix<scalar_t>(m, n, nb, p, q, MPI_COMM_WORLD);
+        U = slate::Matrix<scalar_t>(m, n, nb, p, q, tester_comm());
         U.insertLocalTiles(target);
         set(zero, one, U);
     }
 
     // Create VT and V1d. Set VT to Identity.
     if (wantvt) {
-        VT = slate::Matrix<scalar_t>(n, n, nb, p, q, MPI_COMM_WORLD);
+        VT = slate::Matrix<scalar_t>(n, n, nb, p, q, tester_comm());
         VT.insertLocalTiles(target);
         set(zero, one, VT);
     }
@@ -121,14 +121,14 @@ void test_ge2tb_work(Params& params, bool run)
     if (trace) slate::trace::Trace::on();
     else slate::trace::Trace::off();
 
-    double time = barrier_get_wtime(MPI_COMM_WORLD);
+    double time = barrier_get_wtime(tester_comm());
 
     //==================================================
     // Run SLATE test.
     //==================================================
     slate::ge2tb(A, TU, TV, opts);
 
-    time = barrier_get_wtime(MPI_COMM_WORLD) - time;
+    time = barrier_get_wtime(tester_comm()) - time;
 
     if (trace) slate::trace::Trace::finish();
 
@@ -231,7 +231,7 @@ void test_ge2tb_work(Params& params, bool run)
             // Test results orthogonality of U.
             // || I - U^H U || / n < tol
             //==================================================
-            slate::Matrix<scalar_t> Iden( n, n, nb, p, q, MPI_COMM_WORLD );
+            slate::Matrix<scalar_t> Iden( n, n, nb, p, q, tester_comm() );
             Iden.insertLocalTiles(target);
             set(zero, one, Iden);
             if (wantu) {
@@ -90,7 +90,7 @@ void test_gecondest_work(Params& params, bool run)
 
     // MPI variables
     int mpi_rank, myrow, mycol;
-    MPI_Comm_rank(MPI_COMM_WORLD, &mpi_rank);
+    MPI_Comm_rank(tester_comm(), &mpi_rank);
     gridinfo( mpi_rank, grid_order, p, q, &myrow, &mycol );
 
     slate::Options const opts =  {
@@ -113,21 +113,21 @@ void test_gecondest_work(Params& params, bool run)
         // SLATE allocates CPU or GPU tiles.
         slate::Target origin_target = origin2target(origin);
         A = slate::Matrix<scalar_t>(
-                n, n,    nb, p, q, MPI_COMM_WORLD );
+                n, n,    nb, p, q, tester_comm() );
         A.insertLocalTiles(origin_target);
     }
     else {
         // Create SLATE matrix from the ScaLAPACK layouts
         A_data.resize( lldA * nlocA );
         A = slate::Matrix<scalar_t>::fromScaLAPACK(
-            n, n, &A_data[0], lldA, nb, nb, grid_order, p, q, MPI_COMM_WORLD );
+            n, n, &A_data[0], lldA, nb, nb, grid_order, p, q, tester_comm() );
     }
 
     slate::Matrix<scalar_t> Id;
     if (check) {
         slate::Target origin_target = origin2target(origin);
         Id = slate::Matrix<scalar_t>(
-                n, n,    nb, p, q, MPI_COMM_WORLD );
+                n, n,    nb, p, q, tester_comm() );
         Id.insertLocalTiles(origin_target);
     }
 
@@ -143,7 +143,7 @@ void test_gecondest_work(Params& params, bool run)
         Aref_data.resize( lldA* nlocA );
         Aref = slate::Matrix<scalar_t>::fromScaLAPACK(
                 n, n, &Aref_data[0], lldA, nb, nb,
-                grid_order, p, q, MPI_COMM_WORLD );
+                grid_order, p, q, tester_comm() );
 
         slate::copy(A, Aref);
     }
@@ -166,20 +166,20 @@ void test_gecondest_work(Params& params, bool run)
         // gecondest:  Solve AX = B, including factoring A.
         //==================================================
 
-        double time2 = barrier_get_wtime(MPI_COMM_WORLD);
+        double time2 = barrier_get_wtime(tester_comm());
         slate::lu_factor(A, pivots, opts);
         // Using traditional BLAS/LAPACK name
         // slate::getrf(A, pivots, opts);
         // compute and save timing/performance
-        time2 = barrier_get_wtime(MPI_COMM_WORLD) - time2;
+        time2 = barrier_get_wtime(tester_comm()) - time2;
         params.time2() = time2;
         params.gflops2() = gflop / time2;
 
-        double time = barrier_get_wtime(MPI_COMM_WORLD);
+        double time = barrier_get_wtime(tester_comm());
         slate_rcond = slate::lu_rcondest_using_factor( norm, A, Anorm, opts );
         // Using traditional BLAS/LAPACK name
         // slate_rcond = slate::gecondest( norm, A, Anorm, opts );
-        time = barrier_get_wtime(MPI_COMM_WORLD) - time;
+        time = barrier_get_wtime(tester_comm()) - time;
         // compute and save timing/performance
         params.time() = time;
         params.gflops() = gflop / time;
@@ -254,13 +254,13 @@ void test_gecondest_work(Params& params, bool run)
 
             // todo: ScaLAPCK pzgecon has a seg fault
 
-            double time = barrier_get_wtime(MPI_COMM_WORLD);
+            double time = barrier_get_wtime(tester_comm());
             scalapack_pgecon( to_c_string( norm ), n,
                               &Aref_data[0], 1, 1, Aref_desc,
                               &Anorm, &scl_rcond,
                               &work[0], lwork, &iwork[0], liwork, &info );
             slate_assert( info == 0 );
-            time = barrier_get_wtime(MPI_COMM_WORLD) - time;
+            time = barrier_get_wtime(tester_comm()) - time;
 
             params.ref_time() = time;
             params.ref_gflops() = gflop / time;
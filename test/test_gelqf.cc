@@ -64,7 +64,7 @@ void test_gelqf_work(Params& params, bool run)
 
     // MPI variables
     int mpi_rank, myrow, mycol;
-    MPI_Comm_rank(MPI_COMM_WORLD, &mpi_rank);
+    MPI_Comm_rank(tester_comm(), &mpi_rank);
     gridinfo(mpi_rank, p, q, &myrow, &mycol);
 
     // Matrix A: figure out local size.
@@ -77,14 +77,14 @@ void test_gelqf_work(Params& params, bool run)
     if (origin != slate::Origin::ScaLAPACK) {
         // SLATE allocates CPU or GPU tiles.
         slate::Target origin_target = origin2target(origin);
-        A = slate::Matrix<scalar_t>(m, n, nb, p, q, MPI_COMM_WORLD);
+        A = slate::Matrix<scalar_t>(m, n, nb, p, q, tester_comm());
         A.insertLocalTiles(origin_target);
     }
     else {
         // create SLATE matrices from the ScaLAPACK layouts
         A_data.resize( lldA * nlocA );
         A = slate::Matrix<scalar_t>::fromScaLAPACK(
-                m, n, &A_data[0], lldA, nb, p, q, MPI_COMM_WORLD);
+                m, n, &A_data[0], lldA, nb, p, q, tester_comm());
     }
 
     slate::generate_matrix(params.matrix, A);
@@ -99,7 +99,7 @@ void test_gelqf_work(Params& params, bool run)
     if (check || ref) {
         Aref_data.resize(lldA*nlocA);
         Aref = slate::Matrix<scalar_t>::fromScaLAPACK(
-                   m, n, &Aref_data[0], lldA, nb, p, q, MPI_COMM_WORLD);
+                   m, n, &Aref_data[0], lldA, nb, p, q, tester_comm());
         slate::copy(A, Aref);
     }
 
@@ -109,7 +109,7 @@ void test_gelqf_work(Params& params, bool run)
         if (trace) slate::trace::Trace::on();
         else slate::trace::Trace::off();
 
-        double time = barrier_get_wtime(MPI_COMM_WORLD);
+        double time = barrier_get_wtime(tester_comm());
 
         //==================================================
         // Run SLATE test.
@@ -118,7 +118,7 @@ void test_gelqf_work(Params& params, bool run)
         // Using traditional BLAS/LAPACK name
         // slate::gelqf(A, T, opts);
 
-        time = barrier_get_wtime(MPI_COMM_WORLD) - time;
+        time = barrier_get_wtime(tester_comm()) - time;
 
         if (trace) slate::trace::Trace::finish();
 
@@ -146,7 +146,7 @@ void test_gelqf_work(Params& params, bool run)
 
         std::vector<scalar_t> LQ_data(Aref_data.size(), zero);
         auto LQ = slate::Matrix<scalar_t>::fromScaLAPACK(
-                      m, n, &LQ_data[0], lldA, nb, p, q, MPI_COMM_WORLD);
+                      m, n, &LQ_data[0], lldA, nb, p, q, tester_comm());
 
         // L1 is the lower part of LQ matrix.
         slate::TrapezoidMatrix<scalar_t> L1(slate::Uplo::Lower, slate::Diag::NonUnit, LQ);
@@ -235,11 +235,11 @@ void test_gelqf_work(Params& params, bool run)
             //==================================================
             // Run ScaLAPACK reference routine.
             //==================================================
-            double time = barrier_get_wtime(MPI_COMM_WORLD);
+            double time = barrier_get_wtime(tester_comm());
             scalapack_pgelqf(m, n, &Aref_data[0], 1, 1, Aref_desc, tau.data(),
                              work.data(), lwork, &info_ref);
             slate_assert(info_ref == 0);
-            time = barrier_get_wtime(MPI_COMM_WORLD) - time;
+            time = barrier_get_wtime(tester_comm()) - time;
 
             params.ref_time() = time;
             params.ref_gflops() = gflop / time;
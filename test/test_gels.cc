@@ -39,6 +39,7 @@ void test_gels_work(Params& params, bool run)
     int64_t ib = params.ib();
     int64_t lookahead = params.lookahead();
     int64_t panel_threads = params.panel_threads();
+    int64_t tree_arity = params.tree_arity();
     bool ref_only = params.ref() == 'o';
     bool ref = params.ref() == 'y' || ref_only;
     bool check = params.check() == 'y' && ! ref_only;
@@ -49,6 +50,7 @@ void test_gels_work(Params& params, bool run)
     slate::Target target = params.target();
     slate::MethodGels method_gels = params.method_gels();
     slate::MethodCholQR method_cholqr = params.method_cholqr();
+    slate::GramPrecision gram_precision = params.gram_precision();
     bool consistent = true;
     params.matrix.mark();
     params.matrixB.mark();
@@ -64,6 +66,9 @@ void test_gels_work(Params& params, bool run)
     params.gflops();
     params.ref_time();
     params.ref_gflops();
+    bool is_cholqr = method_gels == slate::MethodGels::CholQR
+                     || method_gels == slate::MethodGels::CholQR2
+                     || method_gels == slate::MethodGels::CholQR3;
     if (timer_level >= 2 && (method_gels == slate::MethodGels::Auto
                              || method_gels == slate::MethodGels::QR)) {
         params.time2();
@@ -73,7 +78,7 @@ void test_gels_work(Params& params, bool run)
         params.time3.name( "unmqr (s)" );
         params.time4.name( "trsm (s)" );
     }
-    else if (timer_level >= 2 && method_gels == slate::MethodGels::CholQR) {
+    else if (timer_level >= 2 && is_cholqr) {
         params.time2();
         params.time3();
         params.time4();
@@ -82,16 +87,39 @@ void test_gels_work(Params& params, bool run)
         params.time4.name( "trsm (s)" );
     }
 
+    bool is_iterative = params.routine == "gels_mixed";
+
+    int64_t itermax = 0;
+    bool fallback = true;
+    if (is_iterative) {
+        params.iters();
+        fallback = params.fallback() == 'y';
+        itermax = params.itermax();
+    }
+
     if (! run)
         return;
 
+    if (is_iterative && ! std::is_same<real_t, double>::value) {
+        params.msg() = "skipping: unsupported mixed precision; must be type=d or z";
+        return;
+    }
+    if (is_iterative && (trans != slate::Op::NoTrans || m < n)) {
+        params.msg() = "skipping: gels_mixed requires trans=n and m >= n";
+        return;
+    }
+
     slate::Options const opts =  {
         {slate::Option::Lookahead, lookahead},
         {slate::Option::Target, target},
         {slate::Option::MaxPanelThreads, panel_threads},
         {slate::Option::InnerBlocking, ib},
         {slate::Option::MethodCholQR, method_cholqr},
-        {slate::Option::MethodGels, method_gels}
+        {slate::Option::GramPrecision, gram_precision},
+        {slate::Option::MethodGels, method_gels},
+        {slate::Option::TreeArity, tree_arity},
+        {slate::Option::MaxIterations, itermax},
+        {slate::Option::UseFallbackSolver, fallback}
     };
 
     // A is m-by-n, BX is max(m, n)-by-nrhs.
@@ -103,7 +131,7 @@ void test_gels_work(Params& params, bool run)
 
     // MPI variables
     int mpi_rank, myrow, mycol;
-    MPI_Comm_rank(MPI_COMM_WORLD, &mpi_rank);
+    MPI_Comm_rank(tester_comm(), &mpi_rank);
     gridinfo(mpi_rank, p, q, &myrow, &mycol);
 
     // Figure out local size.
@@ -130,13 +158,13 @@ void test_gels_work(Params& params, bool run)
     if (origin != slate::Origin::ScaLAPACK) {
         // SLATE allocates CPU or GPU tiles.
         slate::Target origin_target = origin2target(origin);
-        A = slate::Matrix<scalar_t>(m, n, nb, p, q, MPI_COMM_WORLD);
+        A = slate::Matrix<scalar_t>(m, n, nb, p, q, tester_comm());
         A.insertLocalTiles(origin_target);
 
-        X0 = slate::Matrix<scalar_t>(opAn, nrhs, nb, p, q, MPI_COMM_WORLD);
+        X0 = slate::Matrix<scalar_t>(opAn, nrhs, nb, p, q, tester_comm());
         X0.insertLocalTiles(origin_target);
 
-        BX = slate::Matrix<scalar_t>(maxmn, nrhs, nb, p, q, MPI_COMM_WORLD);
+        BX = slate::Matrix<scalar_t>(maxmn, nrhs, nb, p, q, tester_comm());
         BX.insertLocalTiles(origin_target);
     }
     else {
@@ -146,11 +174,11 @@ void test_gels_work(Params& params, bool run)
         BX_data.resize( lldBX * nlocBX );
 
         A  = slate::Matrix<scalar_t>::fromScaLAPACK(
-                 m,     n,    &A_data[0],  lldA,  nb, p, q, MPI_COMM_WORLD);
+                 m,     n,    &A_data[0],  lldA,  nb, p, q, tester_comm());
         X0 = slate::Matrix<scalar_t>::fromScaLAPACK(
-                 opAn,  nrhs, &X0_data[0], lldX0, nb, p, q, MPI_COMM_WORLD);
+                 opAn,  nrhs, &X0_data[0], lldX0, nb, p, q, tester_comm());
         BX = slate::Matrix<scalar_t>::fromScaLAPACK(
-                 maxmn, nrhs, &BX_data[0], lldBX, nb, p, q, MPI_COMM_WORLD);
+                 maxmn, nrhs, &BX_data[0], lldBX, nb, p, q, tester_comm());
     }
     // Create SLATE matrix from the ScaLAPACK layouts
     // slate::TriangularFactors<scalar_t> T;
@@ -205,11 +233,11 @@ void test_gels_work(Params& params, bool run)
     slate::Matrix<scalar_t> Aref, opAref, BXref, Bref;
     if (check || ref) {
         Aref = slate::Matrix<scalar_t>::fromScaLAPACK(
-                   m, n, &Aref_data[0], lldA, nb, p, q, MPI_COMM_WORLD);
+                   m, n, &Aref_data[0], lldA, nb, p, q, tester_comm());
         slate::copy(A, Aref);
 
         BXref = slate::Matrix<scalar_t>::fromScaLAPACK(
-                    maxmn, nrhs, &BXref_data[0], lldBX, nb, p, q, MPI_COMM_WORLD);
+                    maxmn, nrhs, &BXref_data[0], lldBX, nb, p, q, tester_comm());
         slate::copy(BX, BXref);
 
         if (opAm >= opAn) {
@@ -233,16 +261,25 @@ void test_gels_work(Params& params, bool run)
         if (trace) slate::trace::Trace::on();
         else slate::trace::Trace::off();
 
-        double time = barrier_get_wtime(MPI_COMM_WORLD);
+        double time = barrier_get_wtime(tester_comm());
 
         //==================================================
         // Run SLATE test.
         //==================================================
-        slate::least_squares_solve(opA, BX, opts);
-        // Using traditional BLAS/LAPACK name
-        // slate::gels(opA, T, BX, opts);
+        if (params.routine == "gels_mixed") {
+            if constexpr (std::is_same<real_t, double>::value) {
+                int iters = 0;
+                slate::gels_mixed( opA, BX, iters, opts );
+                params.iters() = iters;
+            }
+        }
+        else {
+            slate::least_squares_solve(opA, BX, opts);
+            // Using traditional BLAS/LAPACK name
+            // slate::gels(opA, T, BX, opts);
+        }
 
-        time = barrier_get_wtime(MPI_COMM_WORLD) - time;
+        time = barrier_get_wtime(tester_comm()) - time;
 
         if (trace) slate::trace::Trace::finish();
 
@@ -256,7 +293,7 @@ void test_gels_work(Params& params, bool run)
             params.time3() = slate::timers[ "gels::unmqr" ];
             params.time4() = slate::timers[ "gels::trsm"  ];
         }
-        else if (timer_level >= 2 && method_gels == slate::MethodGels::CholQR) {
+        else if (timer_level >= 2 && is_cholqr) {
             params.time2() = slate::timers[ "gels_cholqr::cholqr" ];
             params.time3() = slate::timers[ "gels_cholqr::gemm" ];
             params.time4() = slate::timers[ "gels_cholqr::trsm" ];
@@ -296,7 +333,7 @@ void test_gels_work(Params& params, bool run)
             //slate::scale(1, R_max, B);
 
             // RA = R^H op(A)
-            slate::Matrix<scalar_t> RA(nrhs, opAn, nb, p, q, MPI_COMM_WORLD);
+            slate::Matrix<scalar_t> RA(nrhs, opAn, nb, p, q, tester_comm());
             RA.insertLocalTiles();
             auto RT = conj_transpose( Bref );
             slate::multiply(one, RT, opA, zero, RA);
@@ -329,7 +366,7 @@ void test_gels_work(Params& params, bool run)
             // Xstart = (opAm + pad) / nb
             // padding with zero columns so X starts on nice boundary to need only local copy.
             int64_t Xstart = slate::ceildiv( slate::ceildiv( opAm, nb ), q ) * q;
-            slate::Matrix<scalar_t> D(opAn, Xstart*nb + nrhs, nb, p, q, MPI_COMM_WORLD);
+            slate::Matrix<scalar_t> D(opAn, Xstart*nb + nrhs, nb, p, q, tester_comm());
             D.insertLocalTiles();
 
             // zero D.
@@ -458,13 +495,13 @@ void test_gels_work(Params& params, bool run)
             //==================================================
             // Run ScaLAPACK reference routine.
             //==================================================
-            double time = barrier_get_wtime(MPI_COMM_WORLD);
+            double time = barrier_get_wtime(tester_comm());
             scalapack_pgels(to_c_string( trans ), m, n, nrhs,
                             &Aref_data[0],  1, 1, Aref_desc,
                             &BXref_data[0], 1, 1, BXref_desc,
                             work.data(), lwork, &info_ref);
             slate_assert(info_ref == 0);
-            time = barrier_get_wtime(MPI_COMM_WORLD) - time;
+            time = barrier_get_wtime(tester_comm()) - time;
 
             params.ref_time() = time;
             params.ref_gflops() = gflop / time;
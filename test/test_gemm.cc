@@ -35,6 +35,8 @@ void test_gemm_work(Params& params, bool run)
         params.method_gemm() = slate::MethodGemm::A;
     else if (params.routine == "gemmC")
         params.method_gemm() = slate::MethodGemm::C;
+    else if (params.routine == "gemmLayered")
+        params.method_gemm() = slate::MethodGemm::Layered;
 
     // get & mark input values
     slate::Op transA = params.transA();
@@ -51,9 +53,14 @@ void test_gemm_work(Params& params, bool run)
     bool ref = params.ref() == 'y' || ref_only;
     bool check = params.check() == 'y' && ! ref_only;
     bool trace = params.trace() == 'y';
+    bool print_counters = params.counters() != 'n';
+    bool bcast_packed = params.bcast_packed() == 'y';
     slate::Target target = params.target();
     slate::Origin origin = params.origin();
     slate::MethodGemm method_gemm = params.method_gemm();
+    slate::ComputePrecision compute_precision = params.compute_precision();
+    bool layered = method_gemm == slate::MethodGemm::Layered;
+    int64_t layers = layered ? params.layers() : 0;
     params.matrix.mark();
     params.matrixB.mark();
     params.matrixC.mark();
@@ -65,6 +72,17 @@ void test_gemm_work(Params& params, bool run)
     params.gflops();
     params.ref_time();
     params.ref_gflops();
+    if (layered) {
+        // Compare with gemmC on the same matrices.
+        params.time2();
+        params.time2.name( "gemmC (s)" );
+        params.gflops2();
+        params.gflops2.name( "gemmC gflop/s" );
+        params.value();
+        params.value.name( "speedup" );
+        params.value2();
+        params.value2.name( "mem ratio" );
+    }
 
     // Suppress norm, nrhs from output; they're only for checks.
     params.norm.width( 0 );
@@ -78,12 +96,25 @@ void test_gemm_work(Params& params, bool run)
         return;
     }
 
+    slate::Counters counters;
+    counters.logMessages( params.counters() == 'm' );
     slate::Options const opts =  {
         {slate::Option::Lookahead, lookahead},
         {slate::Option::Target, target},
         {slate::Option::MethodGemm, method_gemm},
+        {slate::Option::BcastPacked, bcast_packed},
+        {slate::Option::ComputePrecision, compute_precision},
+        {slate::Option::Layers, layers},
+        {slate::Option::Counters, print_counters ? &counters : nullptr},
     };
 
+    int mpi_size;
+    MPI_Comm_size( tester_comm(), &mpi_size );
+    if (layered && layers > 0 && mpi_size % layers != 0) {
+        params.msg() = "skipping: layers must divide the number of ranks";
+        return;
+    }
+
     // Error analysis applies in these norms.
     slate_assert(norm == Norm::One || norm == Norm::Inf || norm == Norm::Fro);
 
@@ -160,6 +191,13 @@ void test_gemm_work(Params& params, bool run)
     print_matrix( "B", B, params );
     print_matrix( "C", C, params );
 
+    // For the comparison with gemmC, a copy of the input C.
+    TestMatrix<slate::Matrix<scalar_t>> C2_alloc;
+    if (layered && ! ref_only) {
+        C2_alloc = allocate_test_Matrix<scalar_t>( false, true, Cm, Cn, params );
+        slate::copy( C, C2_alloc.A );
+    }
+
     // compute and save timing/performance
     double gflop = blas::Gflop<scalar_t>::gemm(m, n, k);
 
@@ -168,7 +206,7 @@ void test_gemm_work(Params& params, bool run)
         if (trace) slate::trace::Trace::on();
         else slate::trace::Trace::off();
 
-        double time = barrier_get_wtime(MPI_COMM_WORLD);
+        double time = barrier_get_wtime(tester_comm());
 
         //==================================================
         // Run SLATE test.
@@ -178,7 +216,7 @@ void test_gemm_work(Params& params, bool run)
         // Using traditional BLAS/LAPACK name
         // slate::gemm( alpha, A, B, beta, C, opts );
 
-        time = barrier_get_wtime(MPI_COMM_WORLD) - time;
+        time = barrier_get_wtime(tester_comm()) - time;
 
         if (trace) slate::trace::Trace::finish();
 
@@ -186,7 +224,46 @@ void test_gemm_work(Params& params, bool run)
         params.time() = time;
         params.gflops() = gflop / time;
 
+        if (print_counters)
+            print_phase_counters( counters, params );
+
         print_matrix( "C_out", C, params );
+
+        if (layered) {
+            //==================================================
+            // Run gemmC on the copy of C, for the speedup.
+            //==================================================
+            auto& C2 = C2_alloc.A;
+            slate::Options opts_C = opts;
+            opts_C[ slate::Option::MethodGemm ] = slate::MethodGemm::C;
+
+            double time2 = barrier_get_wtime( tester_comm() );
+            slate::multiply( alpha, A, B, beta, C2, opts_C );
+            time2 = barrier_get_wtime( tester_comm() ) - time2;
+
+            params.time2() = time2;
+            params.gflops2() = gflop / time2;
+            params.value() = time2 / time;
+
+            // Memory of the layered algorithm relative to A, B, and C:
+            // C is replicated on each layer, plus a reduction buffer.
+            // Uses the same choice of layers as gemmLayered.
+            int64_t c = layers;
+            if (c == 0) {
+                c = 1;
+                for (int d = 2; int64_t( d )*d*d <= mpi_size; ++d) {
+                    if (mpi_size % d == 0)
+                        c = d;
+                }
+            }
+            while (c > A.nt() || mpi_size % c != 0)
+                --c;
+            double mn = double( m ) * n;
+            double mk = double( m ) * k;
+            double kn = double( k ) * n;
+            double extra = c > 1 ? (c + 1)*mn + mk + kn : 0;
+            params.value2() = extra / (mn + mk + kn);
+        }
     }
 
     if (check && ! ref) {
@@ -204,6 +281,14 @@ void test_gemm_work(Params& params, bool run)
 
         // Allow 3*eps; complex needs 2*sqrt(2) factor; see Higham, 2002, sec. 3.6.
         real_t eps = std::numeric_limits<real_t>::epsilon();
+        // TF32 rounds single precision inputs to 11-bit significands.
+        if (compute_precision == slate::ComputePrecision::TF32
+            && std::is_same< real_t, float >::value)
+            eps = 0x1p-10;
+        // 3M's normwise bound has a larger constant; Higham, 2002, sec. 23.2.4.
+        if (compute_precision == slate::ComputePrecision::Complex3M
+            && slate::is_complex<scalar_t>::value)
+            eps *= 4;
         params.okay() = (params.error() <= 3*eps);
     }
 
@@ -242,14 +327,14 @@ void test_gemm_work(Params& params, bool run)
             //==================================================
             // Run ScaLAPACK reference routine.
             //==================================================
-            double time = barrier_get_wtime(MPI_COMM_WORLD);
+            double time = barrier_get_wtime(tester_comm());
 
             scalapack_pgemm(to_c_string( transA ), to_c_string( transB ), m, n, k, alpha,
                             &A_data[0], 1, 1, A_desc,
                             &B_data[0], 1, 1, B_desc, beta,
                             &Cref_data[0], 1, 1, Cref_desc);
 
-            time = barrier_get_wtime(MPI_COMM_WORLD) - time;
+            time = barrier_get_wtime(tester_comm()) - time;
 
             print_matrix( "Cref_out", Cref, params );
 
@@ -271,6 +356,14 @@ void test_gemm_work(Params& params, bool run)
 
             // Allow 3*eps; complex needs 2*sqrt(2) factor; see Higham, 2002, sec. 3.6.
             real_t eps = std::numeric_limits<real_t>::epsilon();
+            // TF32 rounds single precision inputs to 11-bit significands.
+            if (compute_precision == slate::ComputePrecision::TF32
+                && std::is_same< real_t, float >::value)
+                eps = 0x1p-10;
+            // 3M's normwise bound has a larger constant; Higham, 2002, sec. 23.2.4.
+            if (compute_precision == slate::ComputePrecision::Complex3M
+                && slate::is_complex<scalar_t>::value)
+                eps *= 4;
             params.okay() = (params.error() <= 3*eps);
 
             Cblacs_gridexit(ictxt);
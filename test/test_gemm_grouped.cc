@@ -0,0 +1,194 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/slate.hh"
+#include "test.hh"
+#include "blas/flops.hh"
+#include "print_matrix.hh"
+
+#include "grid_utils.hh"
+#include "matrix_utils.hh"
+#include "test_utils.hh"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+//------------------------------------------------------------------------------
+/// Tests gemmGrouped on group copies of the same gemm, against a loop of
+/// gemmC on the same matrices.
+template<typename scalar_t>
+void test_gemm_grouped_work(Params& params, bool run)
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // Constants
+    const scalar_t one = 1.0;
+
+    // get & mark input values
+    slate::Op transA = params.transA();
+    slate::Op transB = params.transB();
+    scalar_t alpha = params.alpha.get<scalar_t>();
+    scalar_t beta = params.beta.get<scalar_t>();
+    int64_t m = params.dim.m();
+    int64_t n = params.dim.n();
+    int64_t k = params.dim.k();
+    int64_t group = params.group();
+    int64_t lookahead = params.lookahead();
+    bool check = params.check() == 'y';
+    bool trace = params.trace() == 'y';
+    bool bcast_packed = params.bcast_packed() == 'y';
+    slate::Target target = params.target();
+    slate::ComputePrecision compute_precision = params.compute_precision();
+    params.matrix.mark();
+    params.matrixB.mark();
+    params.matrixC.mark();
+
+    mark_params_for_test_Matrix( params );
+
+    // mark non-standard output values
+    params.time();
+    params.gflops();
+    params.time2();
+    params.time2.name( "gemmC (s)" );
+    params.gflops2();
+    params.gflops2.name( "gemmC gflop/s" );
+    params.value();
+    params.value.name( "speedup" );
+
+    if (! run)
+        return;
+
+    // Check for common invalid combinations
+    if (is_invalid_parameters( params )) {
+        return;
+    }
+
+    slate::Options const opts =  {
+        {slate::Option::Lookahead, lookahead},
+        {slate::Option::Target, target},
+        {slate::Option::BcastPacked, bcast_packed},
+        {slate::Option::ComputePrecision, compute_precision},
+    };
+
+    // sizes of A and B
+    int64_t Am = (transA == slate::Op::NoTrans ? m : k);
+    int64_t An = (transA == slate::Op::NoTrans ? k : m);
+    int64_t Bm = (transB == slate::Op::NoTrans ? k : n);
+    int64_t Bn = (transB == slate::Op::NoTrans ? n : k);
+
+    std::vector< TestMatrix< slate::Matrix<scalar_t> > >
+        A_alloc( group ), B_alloc( group ), C_alloc( group ), C2_alloc( group );
+    std::vector< slate::Matrix<scalar_t> > A( group ), B( group ), C( group ),
+                                           C2( group );
+    for (int64_t g = 0; g < group; ++g) {
+        A_alloc[ g ] = allocate_test_Matrix<scalar_t>( false, true, Am, An, params );
+        B_alloc[ g ] = allocate_test_Matrix<scalar_t>( false, true, Bm, Bn, params );
+        C_alloc[ g ] = allocate_test_Matrix<scalar_t>( false, true, m, n, params );
+        C2_alloc[ g ] = allocate_test_Matrix<scalar_t>( false, true, m, n, params );
+        A[ g ] = A_alloc[ g ].A;
+        B[ g ] = B_alloc[ g ].A;
+        C[ g ] = C_alloc[ g ].A;
+        C2[ g ] = C2_alloc[ g ].A;
+
+        slate::generate_matrix( params.matrix, A[ g ] );
+        slate::generate_matrix( params.matrixB, B[ g ] );
+        slate::generate_matrix( params.matrixC, C[ g ] );
+        slate::copy( C[ g ], C2[ g ] );
+
+        if (transA == slate::Op::Trans)
+            A[ g ] = transpose( A[ g ] );
+        else if (transA == slate::Op::ConjTrans)
+            A[ g ] = conj_transpose( A[ g ] );
+
+        if (transB == slate::Op::Trans)
+            B[ g ] = transpose( B[ g ] );
+        else if (transB == slate::Op::ConjTrans)
+            B[ g ] = conj_transpose( B[ g ] );
+    }
+    std::vector<scalar_t> alphas( group, alpha ), betas( group, beta );
+
+    double gflop = group * blas::Gflop<scalar_t>::gemm( m, n, k );
+
+    if (trace) slate::trace::Trace::on();
+    else slate::trace::Trace::off();
+
+    double time = barrier_get_wtime( tester_comm() );
+
+    //==================================================
+    // Run SLATE test.
+    // C[ g ] = alpha A[ g ] B[ g ] + beta C[ g ].
+    //==================================================
+    slate::gemmGrouped( alphas, A, B, betas, C, opts );
+
+    time = barrier_get_wtime( tester_comm() ) - time;
+
+    if (trace) slate::trace::Trace::finish();
+
+    params.time() = time;
+    params.gflops() = gflop / time;
+
+    //==================================================
+    // Run gemmC on each problem, for the speedup.
+    //==================================================
+    double time2 = barrier_get_wtime( tester_comm() );
+    for (int64_t g = 0; g < group; ++g)
+        slate::gemmC( alpha, A[ g ], B[ g ], beta, C2[ g ], opts );
+    time2 = barrier_get_wtime( tester_comm() ) - time2;
+
+    params.time2() = time2;
+    params.gflops2() = gflop / time2;
+    params.value() = time2 / time;
+
+    if (check) {
+        // Largest relative difference from gemmC over the group.
+        real_t error = 0;
+        for (int64_t g = 0; g < group; ++g) {
+            real_t C2_norm = slate::norm( slate::Norm::One, C2[ g ], opts );
+            slate::add( -one, C2[ g ], one, C[ g ], opts );
+            real_t diff = slate::norm( slate::Norm::One, C[ g ], opts );
+            error = std::max( error, C2_norm > 0 ? diff / C2_norm : diff );
+        }
+        params.error() = error;
+
+        real_t eps = std::numeric_limits<real_t>::epsilon();
+        // TF32 rounds single precision inputs to 11-bit significands.
+        if (compute_precision == slate::ComputePrecision::TF32
+            && std::is_same< real_t, float >::value)
+            eps = 0x1p-10;
+        // 3M's normwise bound has a larger constant; Higham, 2002, sec. 23.2.4.
+        if (compute_precision == slate::ComputePrecision::Complex3M
+            && slate::is_complex<scalar_t>::value)
+            eps *= 4;
+        params.okay() = (params.error() <= 3*eps);
+    }
+}
+
+// -----------------------------------------------------------------------------
+void test_gemm_grouped(Params& params, bool run)
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Single:
+            test_gemm_grouped_work<float> (params, run);
+            break;
+
+        case testsweeper::DataType::Double:
+            test_gemm_grouped_work<double> (params, run);
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_gemm_grouped_work<std::complex<float>> (params, run);
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_gemm_grouped_work<std::complex<double>> (params, run);
+            break;
+
+        default:
+            throw std::runtime_error( "unknown datatype" );
+            break;
+    }
+}
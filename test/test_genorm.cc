@@ -102,7 +102,7 @@ void test_genorm_work(Params& params, bool run)
         // Run SLATE test.
         // Compute || A ||_norm.
         //==================================================
-        double time = barrier_get_wtime(MPI_COMM_WORLD);
+        double time = barrier_get_wtime(tester_comm());
 
         if (scope == slate::NormScope::Matrix) {
             A_norm = slate::norm(norm, A, opts);
@@ -115,7 +115,7 @@ void test_genorm_work(Params& params, bool run)
             // slate::rowNorms(norm, A, values.data(), opts);
         }
 
-        time = barrier_get_wtime(MPI_COMM_WORLD) - time;
+        time = barrier_get_wtime(tester_comm()) - time;
 
         if (trace) slate::trace::Trace::finish();
 
@@ -159,7 +159,7 @@ void test_genorm_work(Params& params, bool run)
             //==================================================
             // Run ScaLAPACK reference routine.
             //==================================================
-            double time = barrier_get_wtime(MPI_COMM_WORLD);
+            double time = barrier_get_wtime(tester_comm());
             if (scope == slate::NormScope::Matrix) {
                 A_norm_ref = scalapack_plange(
                                  to_c_string( op_norm ),
@@ -176,7 +176,7 @@ void test_genorm_work(Params& params, bool run)
             else if (scope == slate::NormScope::Rows) {
                 // todo
             }
-            time = barrier_get_wtime(MPI_COMM_WORLD) - time;
+            time = barrier_get_wtime(tester_comm()) - time;
 
             if (scope == slate::NormScope::Matrix) {
                 // difference between norms
@@ -211,6 +211,21 @@ void test_genorm_work(Params& params, bool run)
             // Allow for difference
             params.okay() = (params.error() <= tol);
 
+            if (scope == slate::NormScope::Matrix && ! ref_only) {
+                // norms() fuses the max and Frobenius norms; it should
+                // match norm().
+                slate::Norm other_norm = (norm == slate::Norm::Max
+                                          ? slate::Norm::Fro : slate::Norm::Max);
+                real_t both_norms[ 2 ];
+                slate::norms( { norm, other_norm }, A, both_norms, opts );
+                real_t norms_error = std::abs( both_norms[ 0 ] - A_norm ) / A_norm;
+                params.okay() = params.okay() && (norms_error <= 10*eps);
+                if (verbose && A.mpiRank() == 0) {
+                    printf("norms %15.8e, error %9.2e\n",
+                           both_norms[ 0 ], norms_error);
+                }
+            }
+
             //---------- extended tests
             if (extended && scope == slate::NormScope::Matrix) {
                 if (grid_order != slate::GridOrder::Col) {
@@ -38,13 +38,20 @@ void test_geqrf_work(Params& params, bool run)
     int64_t ib = params.ib();
     int64_t lookahead = params.lookahead();
     int64_t panel_threads = params.panel_threads();
+    int64_t tree_arity = params.tree_arity();
     bool ref_only = params.ref() == 'o';
     bool ref = params.ref() == 'y' || ref_only;
     bool check = params.check() == 'y' && ! ref_only;
     bool trace = params.trace() == 'y';
+    bool print_counters = params.counters() != 'n';
     slate::Origin origin = params.origin();
     slate::Target target = params.target();
     slate::MethodCholQR method_cholqr = params.method_cholqr();
+    slate::GramPrecision gram_precision = params.gram_precision();
+    slate::TaskRuntime runtime = params.runtime();
+    int64_t trailing_block = params.trailing_block();
+    slate::QueuePriority queue_priority = params.queue_priority();
+    bool panel_callback = params.panel_callback() == 'y';
     params.matrix.mark();
 
     // mark non-standard output values
@@ -52,6 +59,8 @@ void test_geqrf_work(Params& params, bool run)
     params.gflops();
     params.ref_time();
     params.ref_gflops();
+    if (params.routine == "cholqr")
+        params.ortho();
 
     if (! run)
         return;
@@ -61,17 +70,33 @@ void test_geqrf_work(Params& params, bool run)
         return;
     }
 
+    // Block columns reported final by geqrf, in order of the calls.
+    bool check_callback = panel_callback && params.routine != "cholqr";
+    std::vector<int64_t> callback_columns;
+    slate::PanelCallback callback( [&]( int64_t k ) {
+        callback_columns.push_back( k );
+    } );
+
+    slate::Counters counters;
+    counters.logMessages( params.counters() == 'm' );
     slate::Options const opts =  {
         {slate::Option::Lookahead, lookahead},
         {slate::Option::Target, target},
         {slate::Option::MaxPanelThreads, panel_threads},
         {slate::Option::InnerBlocking, ib},
-        {slate::Option::MethodCholQR, method_cholqr}
+        {slate::Option::MethodCholQR, method_cholqr},
+        {slate::Option::GramPrecision, gram_precision},
+        {slate::Option::TaskRuntime, runtime},
+        {slate::Option::QueuePriority, queue_priority},
+        {slate::Option::TreeArity, tree_arity},
+        {slate::Option::TrailingBlock, trailing_block},
+        {slate::Option::Counters, print_counters ? &counters : nullptr},
+        {slate::Option::PanelCallback, check_callback ? &callback : nullptr},
     };
 
     // MPI variables
     int mpi_rank, myrow, mycol;
-    MPI_Comm_rank(MPI_COMM_WORLD, &mpi_rank);
+    MPI_Comm_rank(tester_comm(), &mpi_rank);
     gridinfo(mpi_rank, p, q, &myrow, &mycol);
 
     // Matrix A: figure out local size.
@@ -84,13 +109,13 @@ void test_geqrf_work(Params& params, bool run)
     if (origin != slate::Origin::ScaLAPACK) {
         // SLATE allocates CPU or GPU tiles.
         slate::Target origin_target = origin2target(origin);
-        A = slate::Matrix<scalar_t>(m, n, nb, p, q, MPI_COMM_WORLD);
+        A = slate::Matrix<scalar_t>(m, n, nb, p, q, tester_comm());
         A.insertLocalTiles(origin_target);
     }
     else {
         // create SLATE matrix from the ScaLAPACK layouts
         A_data.resize( lldA * nlocA );
-        A = slate::Matrix<scalar_t>::fromScaLAPACK( m, n, &A_data[0], lldA, nb, p, q, MPI_COMM_WORLD );
+        A = slate::Matrix<scalar_t>::fromScaLAPACK( m, n, &A_data[0], lldA, nb, p, q, tester_comm() );
     }
 
     slate::generate_matrix(params.matrix, A);
@@ -110,7 +135,7 @@ void test_geqrf_work(Params& params, bool run)
         // For simplicity, always use ScaLAPACK format for Aref.
         Aref_data.resize( lldA * nlocA );
         Aref = slate::Matrix<scalar_t>::fromScaLAPACK(
-                   m, n, &Aref_data[0], lldA, nb, p, q, MPI_COMM_WORLD);
+                   m, n, &Aref_data[0], lldA, nb, p, q, tester_comm());
         slate::copy(A, Aref);
     }
 
@@ -122,7 +147,7 @@ void test_geqrf_work(Params& params, bool run)
         if (trace) slate::trace::Trace::on();
         else slate::trace::Trace::off();
 
-        double time = barrier_get_wtime(MPI_COMM_WORLD);
+        double time = barrier_get_wtime(tester_comm());
 
         //==================================================
         // Run SLATE test.
@@ -130,7 +155,7 @@ void test_geqrf_work(Params& params, bool run)
         if (params.routine == "cholqr") {
             slate::Target origin_target = origin2target( origin );
             R_chol = slate::Matrix<scalar_t>(
-                n, n, nb, p, q, MPI_COMM_WORLD );
+                n, n, nb, p, q, tester_comm() );
             R_chol.insertLocalTiles( origin_target );
 
             slate::cholqr( A, R_chol, opts );
@@ -141,7 +166,7 @@ void test_geqrf_work(Params& params, bool run)
         // Using traditional BLAS/LAPACK name
         // slate::geqrf(A, T, opts);
 
-        time = barrier_get_wtime(MPI_COMM_WORLD) - time;
+        time = barrier_get_wtime(tester_comm()) - time;
 
         if (trace) slate::trace::Trace::finish();
 
@@ -149,6 +174,9 @@ void test_geqrf_work(Params& params, bool run)
         params.time() = time;
         params.gflops() = gflop / time;
 
+        if (print_counters)
+            print_phase_counters( counters, params );
+
         print_matrix("A_factored", A, params);
         print_matrix("Tlocal",  T[0], params);
         print_matrix("Treduce", T[1], params);
@@ -166,9 +194,22 @@ void test_geqrf_work(Params& params, bool run)
 
         std::vector<scalar_t> QR_data(Aref_data.size(), zero);
         slate::Matrix<scalar_t> QR = slate::Matrix<scalar_t>::fromScaLAPACK(
-                                         m, n, &QR_data[0], lldA, nb, p, q, MPI_COMM_WORLD);
+                                         m, n, &QR_data[0], lldA, nb, p, q, tester_comm());
 
         if (params.routine == "cholqr") {
+            // Loss of orthogonality of Q, which is in A,
+            //
+            //      || I - Q^H Q ||_1
+            //     ------------------- < tol * epsilon
+            //              n
+            //
+            slate::Matrix<scalar_t> Id( n, n, nb, p, q, tester_comm() );
+            Id.insertLocalTiles();
+            slate::set( zero, one, Id );
+            auto QH = conj_transpose( A );
+            slate::gemm( -one, QH, A, one, Id );
+            params.ortho() = slate::norm( slate::Norm::One, Id ) / n;
+
             // Copy A in QR that will be overwritten by the Q matrix
             slate::copy(A, QR);
 
@@ -214,6 +255,16 @@ void test_geqrf_work(Params& params, bool run)
         params.error() = residual;
         real_t tol = params.tol() * 0.5 * std::numeric_limits<real_t>::epsilon();
         params.okay() = (params.error() <= tol);
+        if (params.routine == "cholqr")
+            params.okay() = params.okay() && (params.ortho() <= tol);
+
+        // Each block column is reported once, in order.
+        if (check_callback) {
+            bool in_order = int64_t( callback_columns.size() ) == A.nt();
+            for (size_t k = 0; k < callback_columns.size() && in_order; ++k)
+                in_order = callback_columns[ k ] == int64_t( k );
+            params.okay() = params.okay() && in_order;
+        }
     }
 
     if (ref) {
@@ -264,11 +315,11 @@ void test_geqrf_work(Params& params, bool run)
             //==================================================
             // Run ScaLAPACK reference test.
             //==================================================
-            double time = barrier_get_wtime(MPI_COMM_WORLD);
+            double time = barrier_get_wtime(tester_comm());
             scalapack_pgeqrf(m, n, &Aref_data[0], 1, 1, Aref_desc, tau.data(),
                              work.data(), lwork, &info);
             slate_assert( info == 0 );
-            time = barrier_get_wtime(MPI_COMM_WORLD) - time;
+            time = barrier_get_wtime(tester_comm()) - time;
 
             if (0) {
                 //==================================================
@@ -286,7 +337,7 @@ void test_geqrf_work(Params& params, bool run)
 
                 std::vector<scalar_t> scala_QR_data(Aref_data.size(), zero);
                 slate::Matrix<scalar_t> scala_QR = slate::Matrix<scalar_t>::fromScaLAPACK(
-                                                     m, n, &scala_QR_data[0], lldA, nb, p, q, MPI_COMM_WORLD);
+                                                     m, n, &scala_QR_data[0], lldA, nb, p, q, tester_comm());
 
                 slate::TrapezoidMatrix<scalar_t> scala_R1(slate::Uplo::Upper, slate::Diag::NonUnit, scala_QR);
 
@@ -0,0 +1,284 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/slate.hh"
+#include "test.hh"
+#include "blas/flops.hh"
+#include "lapack/flops.hh"
+#include "print_matrix.hh"
+#include "matgen.hh"
+
+#include "grid_utils.hh"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <utility>
+
+//------------------------------------------------------------------------------
+/// Returns || A^H A X - R^H R X ||_1 / (n || A ||_1^2 || X ||_1)
+/// for a random X, with R the upper triangle of the n-by-n matrix R.
+/// This doesn't depend on the signs of the rows of R.
+///
+template <typename scalar_t>
+blas::real_type<scalar_t> geqrf_update_residual(
+    Params& params,
+    slate::Matrix<scalar_t>& A,
+    slate::Matrix<scalar_t>& R,
+    slate::Options const& opts)
+{
+    const scalar_t zero = 0;
+    const scalar_t one  = 1;
+
+    int64_t n = A.n();
+    int64_t nrhs = 10;
+    int64_t nb = params.nb();
+    int p = params.grid.m();
+    int q = params.grid.n();
+
+    slate::Matrix<scalar_t> X (n,     nrhs, nb, p, q, tester_comm());
+    slate::Matrix<scalar_t> Z (n,     nrhs, nb, p, q, tester_comm());
+    slate::Matrix<scalar_t> AX(A.m(), nrhs, nb, p, q, tester_comm());
+    X.insertLocalTiles();
+    Z.insertLocalTiles();
+    AX.insertLocalTiles();
+    slate::generate_matrix( params.matrixB, X );
+    slate::copy( X, Z );
+
+    // Z = R^H R X
+    auto RT = slate::TriangularMatrix<scalar_t>(
+                  slate::Uplo::Upper, slate::Diag::NonUnit, R );
+    auto RH = conj_transpose( RT );
+    slate::trmm( slate::Side::Left, one, RT, Z, opts );
+    slate::trmm( slate::Side::Left, one, RH, Z, opts );
+
+    // Z = A^H (A X) - Z
+    auto AH = conj_transpose( A );
+    slate::gemm( one, A,  X,  zero, AX, opts );
+    slate::gemm( one, AH, AX, -one, Z,  opts );
+
+    blas::real_type<scalar_t> A_norm = slate::norm( slate::Norm::One, A );
+    blas::real_type<scalar_t> X_norm = slate::norm( slate::Norm::One, X );
+    blas::real_type<scalar_t> Z_norm = slate::norm( slate::Norm::One, Z );
+
+    return Z_norm / (n * A_norm * A_norm * X_norm);
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void test_geqrf_update_work(Params& params, bool run)
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // Constants
+    const scalar_t zero = 0;
+
+    // get & mark input values
+    int64_t m = params.dim.m();
+    int64_t n = params.dim.n();
+    int64_t k = params.nrhs();
+    int p = params.grid.m();
+    int q = params.grid.n();
+    int64_t nb = params.nb();
+    int64_t ib = params.ib();
+    int64_t lookahead = params.lookahead();
+    int64_t panel_threads = params.panel_threads();
+    bool check = params.check() == 'y';
+    bool trace = params.trace() == 'y';
+    slate::Origin origin = params.origin();
+    slate::Target target = params.target();
+    params.matrix.mark();
+    params.matrixB.mark();
+
+    // mark non-standard output values
+    params.time();
+    params.gflops();
+
+    if (! run)
+        return;
+
+    bool add_cols = params.routine == "geqrf_add_cols";
+    bool add_rows = params.routine == "geqrf_add_rows";
+    int64_t nt = (n + nb - 1) / nb;
+    if (m < n || (add_cols && m < n + k)) {
+        params.msg() = "skipping: requires m >= n (+ k to add columns)";
+        return;
+    }
+    if (! add_cols && ! add_rows && nt < 2) {
+        params.msg() = "skipping: deleting columns requires n > nb";
+        return;
+    }
+
+    slate::Options const opts =  {
+        {slate::Option::Lookahead, lookahead},
+        {slate::Option::Target, target},
+        {slate::Option::MaxPanelThreads, panel_threads},
+        {slate::Option::InnerBlocking, ib},
+    };
+
+    slate::Target origin_target = origin2target(origin);
+
+    // Factor A, keeping A0 = A.
+    slate::Matrix<scalar_t> A (m, n, nb, p, q, tester_comm());
+    slate::Matrix<scalar_t> A0(m, n, nb, p, q, tester_comm());
+    A.insertLocalTiles(origin_target);
+    A0.insertLocalTiles(origin_target);
+    slate::generate_matrix( params.matrix, A );
+    slate::copy( A, A0 );
+
+    slate::TriangularFactors<scalar_t> T;
+    slate::geqrf( A, T, opts );
+
+    print_matrix( "A_factored", A, params );
+
+    // Deleted block columns j1, ..., j2, of columns c1, ..., c2.
+    int64_t d = std::min( std::max( k / nb, int64_t( 1 ) ), nt-1 );
+    int64_t j1 = (nt - d) / 2;
+    int64_t j2 = j1 + d - 1;
+    int64_t c1 = j1*nb;
+    int64_t c2 = std::min( (j2 + 1)*nb, n ) - 1;
+
+    // Appended columns or rows, and the output of delete.
+    slate::Matrix<scalar_t> B, R;
+    slate::TriangularFactors<scalar_t> TB;
+    if (add_cols)
+        B = slate::Matrix<scalar_t>(m, k, nb, p, q, tester_comm());
+    else if (add_rows)
+        B = slate::Matrix<scalar_t>(k, n, nb, p, q, tester_comm());
+    else
+        R = slate::Matrix<scalar_t>(n, n - (c2 - c1 + 1), nb, p, q, tester_comm());
+    if (add_cols || add_rows) {
+        B.insertLocalTiles(origin_target);
+        slate::generate_matrix( params.matrixB, B );
+    }
+    else {
+        R.insertLocalTiles(origin_target);
+    }
+
+    // The updated matrix, from A0 and B.
+    int64_t m_new = add_rows ? m + k : m;
+    int64_t n_new = add_cols ? n + k : (add_rows ? n : R.n());
+    slate::Matrix<scalar_t> Anew(m_new, n_new, nb, p, q, tester_comm());
+    if (check) {
+        Anew.insertLocalTiles();
+        if (add_cols) {
+            auto Anew_A = Anew.slice( 0, m-1, 0, n-1 );
+            auto Anew_B = Anew.slice( 0, m-1, n, n+k-1 );
+            slate::redistribute( A0, Anew_A, opts );
+            slate::redistribute( B,  Anew_B, opts );
+        }
+        else if (add_rows) {
+            auto Anew_A = Anew.slice( 0, m-1, 0, n-1 );
+            auto Anew_B = Anew.slice( m, m+k-1, 0, n-1 );
+            slate::redistribute( A0, Anew_A, opts );
+            slate::redistribute( B,  Anew_B, opts );
+        }
+        else {
+            if (c1 > 0) {
+                auto A0_left   = A0.slice( 0, m-1, 0, c1-1 );
+                auto Anew_left = Anew.slice( 0, m-1, 0, c1-1 );
+                slate::redistribute( A0_left, Anew_left, opts );
+            }
+            if (c2 < n-1) {
+                auto A0_right   = A0.slice( 0, m-1, c2+1, n-1 );
+                auto Anew_right = Anew.slice( 0, m-1, c1, n_new-1 );
+                slate::redistribute( A0_right, Anew_right, opts );
+            }
+        }
+    }
+
+    double gflop;
+    if (add_cols) {
+        gflop = 2*blas::Gflop<scalar_t>::gemm( n, k, m )
+              + lapack::Gflop<scalar_t>::geqrf( m - n, k );
+    }
+    else if (add_rows) {
+        gflop = blas::Gflop<scalar_t>::gemm( n, n, k );
+    }
+    else {
+        gflop = lapack::Gflop<scalar_t>::geqrf( n - c1, n_new - c1 );
+    }
+
+    if (trace) slate::trace::Trace::on();
+    else slate::trace::Trace::off();
+
+    double time = barrier_get_wtime(tester_comm());
+
+    //==================================================
+    // Run SLATE test.
+    //==================================================
+    if (add_cols)
+        slate::geqrf_add_cols( A, T, B, TB, opts );
+    else if (add_rows)
+        slate::geqrf_add_rows( A, B, opts );
+    else
+        slate::geqrf_delete_cols( A, j1, j2, R, TB, opts );
+
+    time = barrier_get_wtime(tester_comm()) - time;
+
+    if (trace) slate::trace::Trace::finish();
+
+    // compute and save timing/performance
+    params.time() = time;
+    params.gflops() = gflop / time;
+
+    print_matrix( "A_out", A, params );
+
+    if (check) {
+        //==================================================
+        // Check || Anew^H Anew X - R^H R X || / (n || Anew ||^2 || X ||),
+        // with R gathered from the updated factors.
+        //==================================================
+        slate::Matrix<scalar_t> Rnew(n_new, n_new, nb, p, q, tester_comm());
+        Rnew.insertLocalTiles();
+        slate::set( zero, Rnew );
+        if (add_cols) {
+            auto A_R    = A.slice( 0, n-1, 0, n-1 );
+            auto B_R    = B.slice( 0, n+k-1, 0, k-1 );
+            auto Rnew_A = Rnew.slice( 0, n-1, 0, n-1 );
+            auto Rnew_B = Rnew.slice( 0, n+k-1, n, n+k-1 );
+            slate::redistribute( A_R, Rnew_A, opts );
+            slate::redistribute( B_R, Rnew_B, opts );
+        }
+        else if (add_rows) {
+            auto A_R = A.slice( 0, n-1, 0, n-1 );
+            slate::redistribute( A_R, Rnew, opts );
+        }
+        else {
+            auto R_R = R.slice( 0, n_new-1, 0, n_new-1 );
+            slate::redistribute( R_R, Rnew, opts );
+        }
+
+        params.error() = geqrf_update_residual( params, Anew, Rnew, opts );
+        real_t tol = params.tol() * std::numeric_limits<real_t>::epsilon();
+        params.okay() = (params.error() <= tol);
+    }
+}
+
+// -----------------------------------------------------------------------------
+void test_geqrf_update(Params& params, bool run)
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Single:
+            test_geqrf_update_work<float> (params, run);
+            break;
+
+        case testsweeper::DataType::Double:
+            test_geqrf_update_work<double> (params, run);
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_geqrf_update_work<std::complex<float>> (params, run);
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_geqrf_update_work<std::complex<double>> (params, run);
+            break;
+
+        default:
+            throw std::runtime_error( "unknown datatype" );
+            break;
+    }
+}
@@ -0,0 +1,165 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/slate.hh"
+#include "test.hh"
+#include "print_matrix.hh"
+
+#include "matrix_utils.hh"
+#include "test_utils.hh"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <utility>
+
+//------------------------------------------------------------------------------
+/// Tests LUFactorization: factors A once, then solves with several
+/// right-hand sides, as a time stepper does, checking the last solve.
+///
+template <typename scalar_t>
+void test_gesv_handle_work( Params& params, bool run )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // Constants
+    const scalar_t one = 1.0;
+    const int nsolves = 3;
+
+    // get & mark input values
+    int64_t n = params.dim.n();
+    int64_t nrhs = params.nrhs();
+    int64_t ib = params.ib();
+    int64_t lookahead = params.lookahead();
+    int64_t panel_threads = params.panel_threads();
+    bool check = params.check() == 'y';
+    bool trace = params.trace() == 'y';
+    slate::Target target = params.target();
+    params.matrix.mark();
+    params.matrixB.mark();
+
+    mark_params_for_test_Matrix( params );
+
+    // mark non-standard output values
+    params.time();
+    params.time.name( "getrf (s)" );
+    params.time2();
+    params.time2.name( "first getrs (s)" );
+    params.time3();
+    params.time3.name( "next getrs (s)" );
+
+    if (! run)
+        return;
+
+    // Check for common invalid combinations
+    if (is_invalid_parameters( params )) {
+        return;
+    }
+
+    slate::Options const opts =  {
+        {slate::Option::Lookahead, lookahead},
+        {slate::Option::Target, target},
+        {slate::Option::MaxPanelThreads, panel_threads},
+        {slate::Option::InnerBlocking, ib},
+    };
+
+    auto A_alloc = allocate_test_Matrix<scalar_t>( check, true, n, n, params );
+    auto B_alloc = allocate_test_Matrix<scalar_t>( true, true, n, nrhs, params );
+
+    auto& A    = A_alloc.A;
+    auto& Aref = A_alloc.Aref;
+    auto& B    = B_alloc.A;
+    auto& Bref = B_alloc.Aref;
+
+    slate::generate_matrix( params.matrix,  A );
+    slate::generate_matrix( params.matrixB, B );
+    slate::copy( B, Bref );
+    if (check)
+        slate::copy( A, Aref );
+
+    print_matrix( "A", A, params );
+    print_matrix( "B", B, params );
+
+    if (trace) slate::trace::Trace::on();
+    else slate::trace::Trace::off();
+
+    //==================================================
+    // Run SLATE test.
+    //==================================================
+    double time = barrier_get_wtime( tester_comm() );
+
+    slate::LUFactorization<scalar_t> F( A, opts );
+
+    params.time() = barrier_get_wtime( tester_comm() ) - time;
+
+    // The first solve broadcasts the factors; the next ones move only B.
+    double time_next = 0;
+    for (int s = 0; s < nsolves; ++s) {
+        slate::copy( Bref, B );
+        time = barrier_get_wtime( tester_comm() );
+
+        F.solve( B );
+
+        time = barrier_get_wtime( tester_comm() ) - time;
+        if (s == 0)
+            params.time2() = time;
+        else
+            time_next += time;
+    }
+    params.time3() = time_next / (nsolves - 1);
+
+    if (trace) slate::trace::Trace::finish();
+
+    print_matrix( "X", B, params );
+
+    if (F.info() != 0) {
+        params.msg() = "getrf info = " + std::to_string( F.info() );
+        params.okay() = false;
+    }
+    else if (check) {
+        //==================================================
+        // Test results by checking the residual
+        //
+        //           || B - AX ||_1
+        //     --------------------------- < tol * epsilon
+        //      || A ||_1 * || X ||_1 * N
+        //
+        //==================================================
+        real_t X_norm = slate::norm( slate::Norm::One, B );
+        real_t A_norm = slate::norm( slate::Norm::One, Aref );
+        slate::multiply( -one, Aref, B, one, Bref );
+        real_t R_norm = slate::norm( slate::Norm::One, Bref );
+        params.error() = R_norm / (n*A_norm*X_norm);
+
+        real_t tol = params.tol() * 0.5 * std::numeric_limits<real_t>::epsilon();
+        params.okay() = (params.error() <= tol);
+    }
+}
+
+// -----------------------------------------------------------------------------
+void test_gesv_handle( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Single:
+            test_gesv_handle_work<float>( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_gesv_handle_work<double>( params, run );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_gesv_handle_work<std::complex<float>>( params, run );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_gesv_handle_work<std::complex<double>>( params, run );
+            break;
+
+        default:
+            throw std::runtime_error( "unknown datatype" );
+            break;
+    }
+}
@@ -64,7 +64,7 @@ void test_getri_work(Params& params, bool run)
 
     // MPI variables
     int mpi_rank, myrow, mycol;
-    MPI_Comm_rank(MPI_COMM_WORLD, &mpi_rank);
+    MPI_Comm_rank(tester_comm(), &mpi_rank);
     gridinfo(mpi_rank, p, q, &myrow, &mycol);
 
     int64_t info = 0;
@@ -80,20 +80,20 @@ void test_getri_work(Params& params, bool run)
         A_data.resize( lldA * nlocA );
     }
     // todo: work-around to initialize BaseMatrix::num_devices_
-    slate::Matrix<scalar_t> A0(n, n, nb, p, q, MPI_COMM_WORLD);
+    slate::Matrix<scalar_t> A0(n, n, nb, p, q, tester_comm());
 
     // Setup SLATE matrix A based on scalapack matrix/data in A_data
     slate::Matrix<scalar_t> A;
     if (origin != slate::Origin::ScaLAPACK) {
         // SLATE allocates CPU or GPU tiles.
         slate::Target origin_target = origin2target(origin);
-        A = slate::Matrix<scalar_t>(n, n, nb, p, q, MPI_COMM_WORLD);
+        A = slate::Matrix<scalar_t>(n, n, nb, p, q, tester_comm());
         A.insertLocalTiles(origin_target);
     }
     else {
         // Create SLATE matrix from the ScaLAPACK layouts
         A = slate::Matrix<scalar_t>::fromScaLAPACK(
-                n, n, &A_data[0], lldA, nb, p, q, MPI_COMM_WORLD);
+                n, n, &A_data[0], lldA, nb, p, q, tester_comm());
     }
     slate::generate_matrix(params.matrix, A);
 
@@ -109,7 +109,7 @@ void test_getri_work(Params& params, bool run)
         // For simplicity, always use ScaLAPACK format for ref matrices.
         Aref_data.resize( lldA*nlocA );
         Aref = slate::Matrix<scalar_t>::fromScaLAPACK(
-                   n, n, &Aref_data[0], lldA, nb, p, q, MPI_COMM_WORLD);
+                   n, n, &Aref_data[0], lldA, nb, p, q, tester_comm());
         slate::copy(A, Aref);
     }
 
@@ -130,14 +130,14 @@ void test_getri_work(Params& params, bool run)
         if (origin != slate::Origin::ScaLAPACK) {
             // SLATE allocates CPU or GPU tiles.
             slate::Target origin_target = origin2target(origin);
-            C = slate::Matrix<scalar_t>(n, n, nb, p, q, MPI_COMM_WORLD);
+            C = slate::Matrix<scalar_t>(n, n, nb, p, q, tester_comm());
             C.insertLocalTiles(origin_target);
             slate::copy( A, C );
         }
         else {
             // Create SLATE matrix from the ScaLAPACK layouts
             C = slate::Matrix<scalar_t>::fromScaLAPACK(
-                    n, n, &Cchk_data[0], lldA, nb, p, q, MPI_COMM_WORLD);
+                    n, n, &Cchk_data[0], lldA, nb, p, q, tester_comm());
         }
     }
 
@@ -150,7 +150,7 @@ void test_getri_work(Params& params, bool run)
         if (trace) slate::trace::Trace::on();
         else slate::trace::Trace::off();
 
-        double time = barrier_get_wtime(MPI_COMM_WORLD);
+        double time = barrier_get_wtime(tester_comm());
 
         //==================================================
         // Run SLATE test.
@@ -179,7 +179,7 @@ void test_getri_work(Params& params, bool run)
             // slate::getri(A, pivots, C, opts);
         }
 
-        time = barrier_get_wtime(MPI_COMM_WORLD) - time;
+        time = barrier_get_wtime(tester_comm()) - time;
 
         if (trace) slate::trace::Trace::finish();
 
@@ -49,7 +49,7 @@ void test_hb2st_work(Params& params, bool run)
 
     // MPI variables
     int mpi_rank, myrow, mycol;
-    MPI_Comm_rank(MPI_COMM_WORLD, &mpi_rank);
+    MPI_Comm_rank(tester_comm(), &mpi_rank);
     gridinfo(mpi_rank, p, q, &myrow, &mycol);
 
     int64_t lda = n;
@@ -80,12 +80,12 @@ void test_hb2st_work(Params& params, bool run)
     }
 
     auto Afull = slate::HermitianMatrix<scalar_t>::fromLAPACK(
-        uplo, n, &Afull_data[0], lda, nb, p, q, MPI_COMM_WORLD);
+        uplo, n, &Afull_data[0], lda, nb, p, q, tester_comm());
 
     // Copy band of Afull, currently to rank 0.
     auto Aband = slate::HermitianBandMatrix<scalar_t>(
         uplo, n, band, nb,
-        1, 1, MPI_COMM_WORLD);
+        1, 1, tester_comm());
     Aband.insertLocalTiles();
     Aband.he2hbGather( Afull );
 
@@ -100,7 +100,7 @@ void test_hb2st_work(Params& params, bool run)
     int64_t vm = 2*nb;
     int64_t nt = Afull.nt();
     int64_t vn = nt*(nt + 1)/2*nb;
-    slate::Matrix<scalar_t> V(vm, vn, vm, nb, 1, 1, MPI_COMM_WORLD);
+    slate::Matrix<scalar_t> V(vm, vn, vm, nb, 1, 1, tester_comm());
     V.insertLocalTiles();
 
     std::vector<real_t> Lambda1(n);
@@ -117,7 +117,7 @@ void test_hb2st_work(Params& params, bool run)
     if (trace) slate::trace::Trace::on();
     else slate::trace::Trace::off();
 
-    double time = barrier_get_wtime(MPI_COMM_WORLD);
+    double time = barrier_get_wtime(tester_comm());
 
     //==================================================
     // Run SLATE test.
@@ -127,7 +127,7 @@ void test_hb2st_work(Params& params, bool run)
         slate::hb2st(Aband, V);
     }
 
-    time = barrier_get_wtime(MPI_COMM_WORLD) - time;
+    time = barrier_get_wtime(tester_comm()) - time;
     params.time() = time;
 
     if (trace) slate::trace::Trace::finish();
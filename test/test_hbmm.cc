@@ -85,7 +85,7 @@ void test_hbmm_work(Params& params, bool run)
 
     // MPI variables
     int mpi_rank, myrow, mycol;
-    MPI_Comm_rank(MPI_COMM_WORLD, &mpi_rank);
+    MPI_Comm_rank(tester_comm(), &mpi_rank);
     gridinfo(mpi_rank, p, q, &myrow, &mycol);
 
     // Matrix A: figure out local size.
@@ -108,11 +108,11 @@ void test_hbmm_work(Params& params, bool run)
 
     // create SLATE matrices from the ScaLAPACK layouts
     auto Aref = slate::HermitianMatrix<scalar_t>::fromScaLAPACK(
-                    uplo, An, &A_data[0], lldA, nb, p, q, MPI_COMM_WORLD );
+                    uplo, An, &A_data[0], lldA, nb, p, q, tester_comm() );
     auto B = slate::Matrix<scalar_t>::fromScaLAPACK(
-                 Bm, Bn, &B_data[0], lldB, nb, p, q, MPI_COMM_WORLD);
+                 Bm, Bn, &B_data[0], lldB, nb, p, q, tester_comm());
     auto C = slate::Matrix<scalar_t>::fromScaLAPACK(
-                 Cm, Cn, &C_data[0], lldC, nb, p, q, MPI_COMM_WORLD);
+                 Cm, Cn, &C_data[0], lldC, nb, p, q, tester_comm());
 
     slate::generate_matrix( params.matrix, Aref );
     slate::generate_matrix( params.matrixB, B );
@@ -120,12 +120,12 @@ void test_hbmm_work(Params& params, bool run)
     zeroOutsideBand(uplo, &A_data[0], An, kd, nb, myrow, mycol, p, q, lldA);
 
     auto A_band = HermitianBandFromScaLAPACK(
-                      uplo, An, kd, &A_data[0], lldA, nb, p, q, MPI_COMM_WORLD);
+                      uplo, An, kd, &A_data[0], lldA, nb, p, q, tester_comm());
 
     // if check is required, copy test data and create a descriptor for it
     slate::Matrix<scalar_t> Cref;
     if (check || ref) {
-        Cref = slate::Matrix<scalar_t>(m, n, nb, p, q, MPI_COMM_WORLD);
+        Cref = slate::Matrix<scalar_t>(m, n, nb, p, q, tester_comm());
         Cref.insertLocalTiles();
         slate::copy( C, Cref );
     }
@@ -145,7 +145,7 @@ void test_hbmm_work(Params& params, bool run)
     if (trace) slate::trace::Trace::on();
     else slate::trace::Trace::off();
 
-    double time = barrier_get_wtime(MPI_COMM_WORLD);
+    double time = barrier_get_wtime(tester_comm());
 
     //==================================================
     // Run SLATE test.
@@ -161,7 +161,7 @@ void test_hbmm_work(Params& params, bool run)
     // Using traditional BLAS/LAPACK name
     // slate::hbmm(side, alpha, A_band, B, beta, C, opts);
 
-    time = barrier_get_wtime(MPI_COMM_WORLD) - time;
+    time = barrier_get_wtime(tester_comm()) - time;
 
     if (trace) slate::trace::Trace::finish();
 
@@ -183,14 +183,14 @@ void test_hbmm_work(Params& params, bool run)
         real_t B_norm = slate::norm( norm, B );
         real_t Cref_norm = slate::norm( norm, Cref );
 
-        time = barrier_get_wtime(MPI_COMM_WORLD);
+        time = barrier_get_wtime(tester_comm());
         if (side == slate::Side::Left)
             slate::multiply( alpha, Aref, B, beta, Cref, opts );
         else if (side == slate::Side::Right)
             slate::multiply( alpha, B, Aref, beta, Cref, opts );
         else
             throw slate::Exception("unknown side");
-        time = barrier_get_wtime(MPI_COMM_WORLD) - time;
+        time = barrier_get_wtime(tester_comm()) - time;
 
         // get differences Cref = Cref - C
         slate::add( -one, C, one, Cref );
@@ -55,7 +55,7 @@ void test_hbnorm_work(Params& params, bool run)
 
     // MPI variables
     int mpi_rank, myrow, mycol;
-    MPI_Comm_rank(MPI_COMM_WORLD, &mpi_rank);
+    MPI_Comm_rank(tester_comm(), &mpi_rank);
     gridinfo(mpi_rank, p, q, &myrow, &mycol);
 
     // Matrix A: figure out local size.
@@ -75,14 +75,14 @@ void test_hbnorm_work(Params& params, bool run)
     // Create SLATE matrix from the ScaLAPACK layout.
     // TODO: data origin on GPU
     auto A = HermitianBandFromScaLAPACK(
-                 uplo, n, kd, &A_data[0], lldA, nb, p, q, MPI_COMM_WORLD);
+                 uplo, n, kd, &A_data[0], lldA, nb, p, q, tester_comm());
 
     print_matrix("A", A, params);
 
     if (trace) slate::trace::Trace::on();
     else slate::trace::Trace::off();
 
-    double time = barrier_get_wtime(MPI_COMM_WORLD);
+    double time = barrier_get_wtime(tester_comm());
 
     //==================================================
     // Run SLATE test.
@@ -92,7 +92,7 @@ void test_hbnorm_work(Params& params, bool run)
         {slate::Option::Target, target}
     });
 
-    time = barrier_get_wtime(MPI_COMM_WORLD) - time;
+    time = barrier_get_wtime(tester_comm()) - time;
 
     if (trace) slate::trace::Trace::finish();
 
@@ -133,11 +133,11 @@ void test_hbnorm_work(Params& params, bool run)
             //==================================================
             // Run ScaLAPACK reference routine.
             //==================================================
-            time = barrier_get_wtime(MPI_COMM_WORLD);
+            time = barrier_get_wtime(tester_comm());
             real_t A_norm_ref = scalapack_planhe(
                                     to_c_string( norm ), to_c_string( A.uplo() ),
                                     n, &A_data[0], 1, 1, A_desc, &worklanhe[0]);
-            time = barrier_get_wtime(MPI_COMM_WORLD) - time;
+            time = barrier_get_wtime(tester_comm()) - time;
 
             //A_norm_ref = lapack::lanhe(
             //    norm, A.uplo(),
@@ -56,7 +56,7 @@ void test_he2hb_work(Params& params, bool run)
 
     // MPI variables
     int mpi_rank, myrow, mycol;
-    MPI_Comm_rank(MPI_COMM_WORLD, &mpi_rank);
+    MPI_Comm_rank(tester_comm(), &mpi_rank);
     gridinfo(mpi_rank, p, q, &myrow, &mycol);
 
     // Skip invalid or unimplemented options.
@@ -78,14 +78,14 @@ void test_he2hb_work(Params& params, bool run)
     slate::HermitianMatrix<scalar_t> A;
     if (origin != slate::Origin::ScaLAPACK) {
         // SLATE allocates CPU or GPU tiles.
-        A = slate::HermitianMatrix<scalar_t>(uplo, n, nb, p, q, MPI_COMM_WORLD);
+        A = slate::HermitianMatrix<scalar_t>(uplo, n, nb, p, q, tester_comm());
         A.insertLocalTiles(origin2target(origin));
     }
     else {
         // Create SLATE matrices from the ScaLAPACK layouts.
         A_data.resize( lldA*nlocal );
         A = slate::HermitianMatrix<scalar_t>::fromScaLAPACK(
-                uplo, n, A_data.data(), lldA, nb, p, q, MPI_COMM_WORLD);
+                uplo, n, A_data.data(), lldA, nb, p, q, tester_comm());
     }
     slate::TriangularFactors<scalar_t> T;
 
@@ -94,7 +94,7 @@ void test_he2hb_work(Params& params, bool run)
     print_matrix("A", A, params);
 
     // Copy test data for check.
-    slate::HermitianMatrix<scalar_t> Aref(uplo, n, nb, p, q, MPI_COMM_WORLD);
+    slate::HermitianMatrix<scalar_t> Aref(uplo, n, nb, p, q, tester_comm());
     Aref.insertLocalTiles();
     slate::copy(A, Aref);
 
@@ -105,14 +105,14 @@ void test_he2hb_work(Params& params, bool run)
     if (trace) slate::trace::Trace::on();
     else slate::trace::Trace::off();
 
-    double time = barrier_get_wtime(MPI_COMM_WORLD);
+    double time = barrier_get_wtime(tester_comm());
 
     //==================================================
     // Run SLATE test.
     //==================================================
     slate::he2hb(A, T, opts);
 
-    time = barrier_get_wtime(MPI_COMM_WORLD) - time;
+    time = barrier_get_wtime(tester_comm()) - time;
 
     if (trace) slate::trace::Trace::finish();
 
@@ -137,7 +137,7 @@ void test_he2hb_work(Params& params, bool run)
         // Norm of original matrix: || A ||_1
         real_t A_norm = slate::norm(slate::Norm::One, Aref);
 
-        slate::Matrix<scalar_t> B(n, n, nb, p, q, MPI_COMM_WORLD);
+        slate::Matrix<scalar_t> B(n, n, nb, p, q, tester_comm());
         B.insertLocalTiles();
         copy_he2gb( A, B );
         print_matrix("B", B, params);
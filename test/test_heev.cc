@@ -51,6 +51,16 @@ void test_heev_work(Params& params, bool run)
     slate::MethodEig method_eig = params.method_eig();
     params.matrix.mark();
 
+    // Bisection finds a subset of eigenvalues, selected by [vl, vu]
+    // or by [il, iu], which may be set by fraction_start and fraction.
+    bool subset = method_eig == slate::MethodEig::Bisection;
+    real_t vl = params.vl();
+    real_t vu = params.vu();
+    int64_t il = params.il();
+    int64_t iu = params.iu();
+    double fraction_start = params.fraction_start();
+    double fraction = params.fraction();
+
     // mark non-standard output values
     params.time();
     params.ref_time();
@@ -59,6 +69,10 @@ void test_heev_work(Params& params, bool run)
     params.error.name( "value err" );
     params.error2.name( "back err" );
     params.ortho.name( "Z orth." );
+    if (subset) {
+        params.il_out();
+        params.iu_out();
+    }
     if (timer_level >= 2) {
         params.time2();
         params.time3();
@@ -72,22 +86,64 @@ void test_heev_work(Params& params, bool run)
         params.time6.name( "unmtr_he2hb (s)" );
     }
 
+    bool is_iterative = params.routine == "heev_mixed";
+
+    int64_t itermax = 0;
+    bool fallback = true;
+    if (is_iterative) {
+        params.iters();
+        fallback = params.fallback() == 'y';
+        itermax = params.itermax();
+    }
+
     if (! run)
         return;
 
+    if (is_iterative && ! std::is_same<real_t, double>::value) {
+        params.msg() = "skipping: unsupported mixed precision; must be type=d or z";
+        return;
+    }
+    if (is_iterative && (jobz != slate::Job::Vec || subset)) {
+        params.msg() = "skipping: heev_mixed requires jobz=v and all eigenvalues";
+        return;
+    }
+
     slate::Options const opts = {
         {slate::Option::Lookahead, lookahead},
         {slate::Option::Target, target},
         {slate::Option::MaxPanelThreads, panel_threads},
         {slate::Option::InnerBlocking, ib},
         {slate::Option::MethodEig, method_eig},
+        {slate::Option::MaxIterations, itermax},
+        {slate::Option::UseFallbackSolver, fallback},
     };
 
     // MPI variables
     int mpi_rank, myrow, mycol;
-    MPI_Comm_rank(MPI_COMM_WORLD, &mpi_rank);
+    MPI_Comm_rank(tester_comm(), &mpi_rank);
     gridinfo(mpi_rank, p, q, &myrow, &mycol);
 
+    slate::Range range = slate::Range::All;
+    if (subset) {
+        const real_t inf = std::numeric_limits<real_t>::infinity();
+        if (vl > -inf || vu < inf) {
+            range = slate::Range::Value;
+        }
+        else {
+            range = slate::Range::Index;
+            if (fraction_start > 0 || fraction < 1) {
+                il = 1 + int64_t( fraction_start * n );
+                iu = il - 1 + int64_t( fraction * n );
+            }
+            if (iu == -1)
+                iu = n;
+            il = std::min( il, n + 1 );
+            iu = std::max( std::min( iu, n ), il - 1 );
+            params.il_out() = il;
+            params.iu_out() = iu;
+        }
+    }
+
     // Skip invalid or unimplemented options.
     if (uplo == slate::Uplo::Upper) {
         params.msg() = "skipping: Uplo::Upper isn't supported.";
@@ -121,22 +177,23 @@ void test_heev_work(Params& params, bool run)
     if (origin != slate::Origin::ScaLAPACK) {
         // SLATE allocates CPU or GPU tiles.
         slate::Target origin_target = origin2target(origin);
-        A = slate::HermitianMatrix<scalar_t>(uplo, n, nb, p, q, MPI_COMM_WORLD);
+        A = slate::HermitianMatrix<scalar_t>(uplo, n, nb, p, q, tester_comm());
         A.insertLocalTiles(origin_target);
     }
     else {
         // create SLATE matrices from the ScaLAPACK layouts
         A_data.resize( lldA * nlocA );
         A = slate::HermitianMatrix<scalar_t>::fromScaLAPACK(
-                uplo, n, &A_data[0], lldA, nb, p, q, MPI_COMM_WORLD);
+                uplo, n, &A_data[0], lldA, nb, p, q, tester_comm());
     }
 
-    slate::generate_matrix( params.matrix, A );
+    slate::Options matgen_opts = {{slate::Option::Target, target}};
+    slate::generate_matrix( params.matrix, A, matgen_opts );
 
     // Z is currently used for ScaLAPACK heev call and can also be used
     // for SLATE heev call when slate::eig_vals takes Z
     auto Z = slate::Matrix<scalar_t>::fromScaLAPACK(
-                 n, n, &Z_data[0], lldZ, nb, p, q, MPI_COMM_WORLD);
+                 n, n, &Z_data[0], lldZ, nb, p, q, tester_comm());
 
     if (verbose >= 1) {
         printf( "%% A %6lld-by-%6lld\n", llong( A.m() ), llong( A.n() ) );
@@ -153,9 +210,9 @@ void test_heev_work(Params& params, bool run)
         Aref_data.resize( lldA * nlocA );
         Lambda_ref.resize( Lambda.size() );
         Aref = slate::HermitianMatrix<scalar_t>::fromScaLAPACK(
-                   uplo, n, &Aref_data[0], lldA, nb, p, q, MPI_COMM_WORLD);
+                   uplo, n, &Aref_data[0], lldA, nb, p, q, tester_comm());
         Aref_gen = slate::Matrix<scalar_t>::fromScaLAPACK(
-                   n, n, &Aref_data[0], lldA, nb, p, q, MPI_COMM_WORLD);
+                   n, n, &Aref_data[0], lldA, nb, p, q, tester_comm());
         slate::copy( A, Aref );
     }
 
@@ -164,12 +221,25 @@ void test_heev_work(Params& params, bool run)
         if (trace) slate::trace::Trace::on();
         else slate::trace::Trace::off();
 
-        double time = barrier_get_wtime(MPI_COMM_WORLD);
+        double time = barrier_get_wtime(tester_comm());
 
         //==================================================
         // Run SLATE test.
         //==================================================
-        if (jobz == slate::Job::NoVec) {
+        if (subset) {
+            if (jobz == slate::Job::NoVec)
+                slate::heevx( range, vl, vu, il, iu, A, Lambda, opts );
+            else
+                slate::heevx( range, vl, vu, il, iu, A, Lambda, Z, opts );
+        }
+        else if (is_iterative) {
+            if constexpr (std::is_same<real_t, double>::value) {
+                int iters = 0;
+                slate::heev_mixed( A, Lambda, Z, iters, opts );
+                params.iters() = iters;
+            }
+        }
+        else if (jobz == slate::Job::NoVec) {
             slate::eig_vals( A, Lambda, opts );
             // Or slate::eig( A, Lambda, opts );
             // Using traditional BLAS/LAPACK name
@@ -181,7 +251,7 @@ void test_heev_work(Params& params, bool run)
             // slate::heev( A, Lambda, Z, opts );
         }
 
-        time = barrier_get_wtime(MPI_COMM_WORLD) - time;
+        time = barrier_get_wtime(tester_comm()) - time;
 
         if (trace) slate::trace::Trace::finish();
 
@@ -195,7 +265,72 @@ void test_heev_work(Params& params, bool run)
             params.time6() = slate::timers[ "heev::unmtr_he2hb" ];
         }
 
-        if (check && jobz == slate::Job::Vec) {
+        // Number of eigenvalues found, and Zm with their eigenvectors.
+        int64_t m = Lambda.size();
+
+        if (check && jobz == slate::Job::Vec && subset && m > 0) {
+            //==================================================
+            // Test results by checking backwards error
+            //
+            //      || A Zm - Zm Lambda ||_1
+            //     -------------------------- < tol * epsilon
+            //            || A ||_1 * N
+            //
+            // and orthogonality
+            //
+            //      || I - Zm^H Zm ||_1
+            //     --------------------- < tol * epsilon
+            //              N
+            //
+            // for the m-column Zm.
+            //==================================================
+            auto Zm = Z.slice( 0, n-1, 0, m-1 );
+
+            // Compute R = Zm Lambda.
+            auto R = Zm.emptyLike();
+            R.insertLocalTiles();
+            slate::copy( Zm, R );
+
+            int64_t mt = R.mt();
+            int64_t nt = R.nt();
+            int64_t jj = 0;
+            for (int64_t j = 0; j < nt; ++j) {
+                #pragma omp parallel for slate_omp_default_none \
+                    firstprivate( mt, j, jj ) shared( R, Lambda )
+                for (int64_t i = 0; i < mt; ++i) {
+                    if (R.tileIsLocal( i, j )) {
+                        auto T = R( i, j );
+                        scalar_t* T_data = T.data();
+                        int64_t ldt = T.stride();
+                        int64_t mb  = T.mb();
+                        int64_t nb2  = T.nb();
+                        for (int64_t tj = 0; tj < nb2; ++tj)
+                            for (int64_t ti = 0; ti < mb; ++ti)
+                                T_data[ ti + tj*ldt ] *= Lambda[ jj + tj ];
+                    }
+                }
+                jj += R.tileNb( j );
+            }
+
+            // Restore A.
+            copy( Aref, A );
+
+            // R = A Zm - Zm Lambda
+            slate::hemm( slate::Side::Left, one, A, Zm, -one, R );
+            real_t Anorm = slate::norm( slate::Norm::One, A );
+            params.error2() = slate::norm( slate::Norm::One, R ) / (Anorm * n);
+            params.okay() = (params.error2() <= tol);
+
+            // I - Zm^H Zm
+            slate::Matrix<scalar_t> Im( m, m, nb, p, q, tester_comm() );
+            Im.insertLocalTiles();
+            slate::set( zero, one, Im );
+            auto ZmH = conj_transpose( Zm );
+            slate::gemm( -one, ZmH, Zm, one, Im );
+            params.ortho() = slate::norm( slate::Norm::One, Im ) / n;
+            params.okay() = params.okay() && (params.ortho() <= tol);
+        }
+        else if (check && jobz == slate::Job::Vec && ! subset) {
             //==================================================
             // Test results by checking backwards error
             //
@@ -333,7 +468,7 @@ void test_heev_work(Params& params, bool run)
             //==================================================
             // Run ScaLAPACK reference routine.
             //==================================================
-            double time = barrier_get_wtime(MPI_COMM_WORLD);
+            double time = barrier_get_wtime(tester_comm());
             if (method_eig == slate::MethodEig::DC && jobz == slate::Job::Vec) {
                 scalapack_pheevd(to_c_string( jobz ), to_c_string( uplo ), n,
                                 &Aref_data[0], 1, 1, A_desc,
@@ -350,18 +485,38 @@ void test_heev_work(Params& params, bool run)
                                 &work[0], lwork, &rwork[0], lrwork, &info_tst);
             }
             slate_assert(info_tst == 0);
-            time = barrier_get_wtime(MPI_COMM_WORLD) - time;
+            time = barrier_get_wtime(tester_comm()) - time;
 
             params.ref_time() = time;
 
             if (! ref_only) {
-                // Reference Scalapack was run, check reference against test
-                // Perform a local operation to get differences Lambda = Lambda - Lambda_ref
-                blas::axpy( n, -1.0, &Lambda_ref[0], 1, &Lambda[0], 1 );
-
-                // Relative forward error: || Lambda_ref - Lambda || / || Lambda_ref ||.
-                params.error() = blas::asum( n, &Lambda[0], 1 )
-                    / blas::asum( n, &Lambda_ref[0], 1 );
+                // Reference Scalapack was run, check reference against test.
+                // For a subset, compare with Lambda_ref[ il-1 : il-1+m ].
+                int64_t m = Lambda.size();
+                int64_t offset = 0;
+                if (range == slate::Range::Index) {
+                    offset = il - 1;
+                }
+                else if (range == slate::Range::Value) {
+                    while (offset < n && Lambda_ref[ offset ] <= vl)
+                        ++offset;
+                    params.il_out() = offset + 1;
+                    params.iu_out() = offset + m;
+                }
+                if (offset + m > n) {
+                    params.msg() = "subset size mismatch";
+                    params.okay() = false;
+                }
+                else if (m > 0) {
+                    // Perform a local operation to get differences
+                    // Lambda = Lambda - Lambda_ref
+                    blas::axpy( m, -1.0, &Lambda_ref[ offset ], 1, &Lambda[0], 1 );
+
+                    // Relative forward error:
+                    // || Lambda_ref - Lambda || / || Lambda_ref ||.
+                    params.error() = blas::asum( m, &Lambda[0], 1 )
+                        / blas::asum( m, &Lambda_ref[ offset ], 1 );
+                }
 
                 params.okay() = params.okay() && (params.error() <= tol);
             }
@@ -66,14 +66,14 @@ void test_hegst_work(Params& params, bool run)
     if (origin != slate::Origin::ScaLAPACK) { // todo
         // SLATE allocates CPU or GPU tiles.
         // A = slate::HermitianMatrix<scalar_t>(
-        //                          uplo, n, nb, p, q, MPI_COMM_WORLD);
+        //                          uplo, n, nb, p, q, tester_comm());
         // A.insertLocalTiles(origin2target(origin));
         assert(false);
     }
 
     // MPI variables
     int mpi_rank, myrow, mycol;
-    MPI_Comm_rank(MPI_COMM_WORLD, &mpi_rank);
+    MPI_Comm_rank(tester_comm(), &mpi_rank);
     gridinfo(mpi_rank, p, q, &myrow, &mycol);
 
     // Matrix A, B: figure out local size.
@@ -84,7 +84,7 @@ void test_hegst_work(Params& params, bool run)
     // Matrix A
     std::vector<scalar_t> A_data(lld*nlocal);
     auto A = slate::HermitianMatrix<scalar_t>::fromScaLAPACK(
-                 uplo, n, A_data.data(), lld, nb, p, q, MPI_COMM_WORLD);
+                 uplo, n, A_data.data(), lld, nb, p, q, tester_comm());
     real_t A_norm;
 
     slate::generate_matrix( params.matrix, A );
@@ -94,7 +94,7 @@ void test_hegst_work(Params& params, bool run)
     // Matrix Aref
     std::vector<scalar_t> Aref_data(lld*nlocal);
     auto Aref = slate::HermitianMatrix<scalar_t>::fromScaLAPACK(
-                    uplo, n, Aref_data.data(), lld, nb, p, q, MPI_COMM_WORLD);
+                    uplo, n, Aref_data.data(), lld, nb, p, q, tester_comm());
 
     slate::copy( A, Aref );
     print_matrix("Aref", Aref, params);
@@ -102,7 +102,7 @@ void test_hegst_work(Params& params, bool run)
     // Matrix B
     std::vector<scalar_t> B_data(lld*nlocal);
     auto B = slate::HermitianMatrix<scalar_t>::fromScaLAPACK(
-                 uplo, n, B_data.data(), lld, nb, p, q, MPI_COMM_WORLD);
+                 uplo, n, B_data.data(), lld, nb, p, q, tester_comm());
 
     slate::generate_matrix( params.matrixB, B );
 
@@ -120,13 +120,13 @@ void test_hegst_work(Params& params, bool run)
         if (trace) slate::trace::Trace::on();
         else slate::trace::Trace::off();
 
-        double time = barrier_get_wtime(MPI_COMM_WORLD);
+        double time = barrier_get_wtime(tester_comm());
 
         //==================================================
         // Run SLATE test.
         //==================================================
         slate::hegst(itype, A, B, opts);
-        time = barrier_get_wtime(MPI_COMM_WORLD) - time;
+        time = barrier_get_wtime(tester_comm()) - time;
 
         if (trace) slate::trace::Trace::finish();
 
@@ -162,7 +162,7 @@ void test_hegst_work(Params& params, bool run)
             //==================================================
             // Run ScaLAPACK reference routine.
             //==================================================
-            double time = barrier_get_wtime(MPI_COMM_WORLD);
+            double time = barrier_get_wtime(tester_comm());
 
             scalapack_phegst(itype, to_c_string( uplo ), n,
                              Aref_data.data(), 1, 1, A_desc,
@@ -170,7 +170,7 @@ void test_hegst_work(Params& params, bool run)
                              &scale, &info);
             slate_assert(info == 0);
 
-            time = barrier_get_wtime(MPI_COMM_WORLD) - time;
+            time = barrier_get_wtime(tester_comm()) - time;
 
             params.ref_time() = time;
             // params.ref_gflops() = gflop / time;
@@ -85,7 +85,7 @@ void test_hegv_work(Params& params, bool run)
     }
 
     // MPI variables
-    MPI_Comm mpi_comm = MPI_COMM_WORLD;
+    MPI_Comm mpi_comm = tester_comm();
     int mpi_rank, myrow, mycol;
     MPI_Comm_rank(mpi_comm, &mpi_rank);
     gridinfo(mpi_rank, p, q, &myrow, &mycol);
@@ -82,7 +82,7 @@ void test_henorm_work(Params& params, bool run)
     if (trace) slate::trace::Trace::on();
     else slate::trace::Trace::off();
 
-    double time = barrier_get_wtime(MPI_COMM_WORLD);
+    double time = barrier_get_wtime(tester_comm());
 
     //==================================================
     // Run SLATE test.
@@ -90,7 +90,7 @@ void test_henorm_work(Params& params, bool run)
     //==================================================
     real_t A_norm = slate::norm(norm, A, opts);
 
-    time = barrier_get_wtime(MPI_COMM_WORLD) - time;
+    time = barrier_get_wtime(tester_comm()) - time;
 
     if (trace) slate::trace::Trace::finish();
 
@@ -125,11 +125,11 @@ void test_henorm_work(Params& params, bool run)
             //==================================================
             // Run ScaLAPACK reference routine.
             //==================================================
-            time = barrier_get_wtime(MPI_COMM_WORLD);
+            time = barrier_get_wtime(tester_comm());
             real_t A_norm_ref = scalapack_planhe(
                                     to_c_string( norm ), to_c_string( A.uplo() ),
                                     n, &A_data[0], 1, 1, A_desc, &worklanhe[0]);
-            time = barrier_get_wtime(MPI_COMM_WORLD) - time;
+            time = barrier_get_wtime(tester_comm()) - time;
 
             // difference between norms
             real_t error = std::abs(A_norm - A_norm_ref) / A_norm_ref;
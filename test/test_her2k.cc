@@ -165,7 +165,7 @@ void test_her2k_work(Params& params, bool run)
         slate::multiply( alpha, opA, Z, one, Y, opts );
     }
 
-    double time = barrier_get_wtime(MPI_COMM_WORLD);
+    double time = barrier_get_wtime(tester_comm());
 
     //==================================================
     // Run SLATE test.
@@ -175,7 +175,7 @@ void test_her2k_work(Params& params, bool run)
     // Using traditional BLAS/LAPACK name
     // slate::her2k(alpha, A, B, beta, C, opts);
 
-    time = barrier_get_wtime(MPI_COMM_WORLD) - time;
+    time = barrier_get_wtime(tester_comm()) - time;
 
     print_matrix( "C_out", C, params );
 
@@ -236,12 +236,12 @@ void test_her2k_work(Params& params, bool run)
             //==================================================
             // Run ScaLAPACK reference routine.
             //==================================================
-            time = barrier_get_wtime(MPI_COMM_WORLD);
+            time = barrier_get_wtime(tester_comm());
             scalapack_pher2k(to_c_string( uplo ), to_c_string( trans ), n, k, alpha,
                              &A_data[0], 1, 1, A_desc,
                              &B_data[0], 1, 1, B_desc, beta,
                              &Cref_data[0], 1, 1, Cref_desc);
-            time = barrier_get_wtime(MPI_COMM_WORLD) - time;
+            time = barrier_get_wtime(tester_comm()) - time;
 
             print_matrix( "Cref_out", Cref, params );
 
@@ -64,10 +64,6 @@ void test_hesv_work(Params& params, bool run)
         params.msg() = "skipping: currently only origin=scalapack is supported";
         return;
     }
-    if (target == slate::Target::Devices) {
-        params.msg() = "skipping: currently target=devices is not supported";
-        return;
-    }
     if (n % nb != 0) {
         params.msg() = "skipping: currently only (n %% nb == 0) is supported";
         return;
@@ -85,7 +81,7 @@ void test_hesv_work(Params& params, bool run)
 
     // MPI variables
     int mpi_rank, myrow, mycol;
-    MPI_Comm_rank(MPI_COMM_WORLD, &mpi_rank);
+    MPI_Comm_rank(tester_comm(), &mpi_rank);
     gridinfo(mpi_rank, p, q, &myrow, &mycol);
 
     int64_t info = 0;
@@ -105,9 +101,9 @@ void test_hesv_work(Params& params, bool run)
     //---------------------
     // Create SLATE matrix from the ScaLAPACK layouts
     auto A = slate::HermitianMatrix<scalar_t>::fromScaLAPACK(
-                 uplo, n, &A_data[0], lldA, nb, p, q, MPI_COMM_WORLD);
+                 uplo, n, &A_data[0], lldA, nb, p, q, tester_comm());
     auto B = slate::Matrix<scalar_t>::fromScaLAPACK(
-                 n, nrhs, &B_data[0], lldB, nb, p, q, MPI_COMM_WORLD);
+                 n, nrhs, &B_data[0], lldB, nb, p, q, tester_comm());
     real_t A_norm, X_norm;
 
     slate::generate_matrix( params.matrix, A );
@@ -123,11 +119,11 @@ void test_hesv_work(Params& params, bool run)
     int64_t kl = nb;
     int64_t ku = nb;
     slate::Pivots pivots2;
-    auto T = slate::BandMatrix<scalar_t>(n, n, kl, ku, nb, p, q, MPI_COMM_WORLD);
+    auto T = slate::BandMatrix<scalar_t>(n, n, kl, ku, nb, p, q, tester_comm());
 
     //---------------------
     // auxiliary matrices
-    auto H = slate::Matrix<scalar_t>(n, n, nb, p, q, MPI_COMM_WORLD);
+    auto H = slate::Matrix<scalar_t>(n, n, nb, p, q, tester_comm());
 
     //---------------------
     // right-hand-side and solution vectors
@@ -141,12 +137,12 @@ void test_hesv_work(Params& params, bool run)
     if (check) {
         Aref_data.resize( A_data.size() );
         Aref = slate::HermitianMatrix<scalar_t>::fromScaLAPACK(
-                   uplo, n, &Aref_data[0], lldA, nb, p, q, MPI_COMM_WORLD);
+                   uplo, n, &Aref_data[0], lldA, nb, p, q, tester_comm());
         slate::copy( A, Aref );
 
         Bref_data.resize( B_data.size() );
         Bref = slate::Matrix<scalar_t>::fromScaLAPACK(
-                   n, nrhs, &Bref_data[0], lldB, nb, p, q, MPI_COMM_WORLD);
+                   n, nrhs, &Bref_data[0], lldB, nb, p, q, tester_comm());
         slate::copy( B, Bref );
     }
 
@@ -167,7 +163,7 @@ void test_hesv_work(Params& params, bool run)
     if (trace) slate::trace::Trace::on();
     else slate::trace::Trace::off();
 
-    double time = barrier_get_wtime(MPI_COMM_WORLD);
+    double time = barrier_get_wtime(tester_comm());
 
     if (params.routine == "hetrf") {
         info = slate::indefinite_factor( A, pivots, T, pivots2, H, opts );
@@ -185,7 +181,7 @@ void test_hesv_work(Params& params, bool run)
         // slate::hesv(A, pivots, T, pivots2, H, B, opts);
     }
 
-    time = barrier_get_wtime(MPI_COMM_WORLD) - time;
+    time = barrier_get_wtime(tester_comm()) - time;
 
     if (trace) slate::trace::Trace::finish();
 
@@ -0,0 +1,429 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/slate.hh"
+#include "test.hh"
+
+#include "internal/Tile_getrf.hh"
+#include "internal/Tile_geqrf.hh"
+#include "internal/Tile_householder_reflection_generator.hh"
+#include "internal/Tile_tpqrt.hh"
+#include "internal/Tile_tpmqrt.hh"
+#include "slate/internal/device.hh"
+
+#include "blas/flops.hh"
+#include "lapack/flops.hh"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <vector>
+
+//------------------------------------------------------------------------------
+/// @return factor of the flops of a complex operation over a real one:
+/// 4 for complex scalar_t (6 multiplies and 2 adds per complex multiply-add),
+/// else 1.
+///
+template <typename scalar_t>
+double complex_flops_factor()
+{
+    return blas::is_complex<scalar_t>::value ? 4.0 : 1.0;
+}
+
+//------------------------------------------------------------------------------
+/// @return mean time of one call of kernel, over niter calls after one
+/// warmup call. setup, if given, runs before each call, untimed, e.g., to
+/// restore a factored panel; sync, if given, waits for the kernel to finish,
+/// e.g., queue.sync().
+///
+double time_kernel(
+    int64_t niter,
+    std::function< void () > const& kernel,
+    std::function< void () > const& setup = nullptr,
+    std::function< void () > const& sync  = nullptr )
+{
+    if (setup)
+        setup();
+    kernel();
+    if (sync)
+        sync();
+
+    double time = 0;
+    for (int64_t iter = 0; iter < niter; ++iter) {
+        if (setup)
+            setup();
+        double t = testsweeper::get_wtime();
+        kernel();
+        if (sync)
+            sync();
+        time += testsweeper::get_wtime() - t;
+    }
+    return time / niter;
+}
+
+//------------------------------------------------------------------------------
+/// Microbenchmark of the host panel kernels, on one rank:
+///
+/// - kernel_getrf:       tile::getrf, LU of an m-by-nb panel of nb-by-nb tiles;
+/// - kernel_geqrf:       tile::geqrf, QR of the panel;
+/// - kernel_householder: tile::householder_reflection_generator, the
+///                       unblocked Householder reflections of the panel;
+/// - kernel_tpqrt:       tile::tpqrt, QR of two nb-by-nb upper triangles;
+/// - kernel_tpmqrt:      tile::tpmqrt, applying tpqrt's reflectors from the
+///                       left to two nb-by-n tiles.
+///
+/// The panel kernels run on --pt threads, up to one per tile, with inner
+/// blocking --ib. Flops are those of LAPACK's getrf and geqrf of the panel;
+/// tpqrt factors 2/3 nb^3 flops (real; without T) and tpmqrt applies
+/// 2 nb^2 n. Output: time (s) of one call, and Gflop/s.
+///
+template <typename scalar_t>
+void test_kernel_host( Params& params, bool run )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // get & mark input values
+    std::string routine = params.routine;
+    int64_t m = params.dim.m();
+    int64_t n = params.dim.n();
+    int64_t nb = params.nb();
+    int64_t ib = params.ib();
+    int64_t panel_threads = params.panel_threads();
+    int64_t niter = params.niter();
+
+    // mark non-standard output values
+    params.time();
+    params.gflops();
+
+    if (! run)
+        return;
+
+    if (routine == "kernel_tpqrt" || routine == "kernel_tpmqrt")
+        m = nb;
+    if (m < nb || nb <= 0) {
+        params.msg() = "skipping: requires m >= nb > 0";
+        return;
+    }
+
+    int64_t idist = 3;
+    int64_t iseed[4] = { 0, 1, 2, 3 };
+    double flop = 0;
+    double time = 0;
+
+    if (routine == "kernel_tpqrt" || routine == "kernel_tpmqrt") {
+        // A1 and A2 are upper triangular nb-by-nb, as in ttqrt;
+        // C1 and C2 are nb-by-n.
+        int64_t ldn = std::max( n, int64_t( 1 ) );
+        std::vector<scalar_t> A1_data( nb*nb ), A2_data( nb*nb ),
+                              A1_orig( nb*nb ), A2_orig( nb*nb ),
+                              T_data( ib*nb ),
+                              C1_data( nb*ldn ), C2_data( nb*ldn );
+        lapack::larnv( idist, iseed, A1_orig.size(), A1_orig.data() );
+        lapack::larnv( idist, iseed, A2_orig.size(), A2_orig.data() );
+        lapack::larnv( idist, iseed, C1_data.size(), C1_data.data() );
+        lapack::larnv( idist, iseed, C2_data.size(), C2_data.data() );
+        for (int64_t j = 0; j < nb; ++j) {
+            for (int64_t i = j+1; i < nb; ++i) {
+                A1_orig[ i + j*nb ] = 0;
+                A2_orig[ i + j*nb ] = 0;
+            }
+        }
+        slate::Tile<scalar_t> A1( nb, nb, A1_data.data(), nb, slate::HostNum,
+                                  slate::TileKind::UserOwned );
+        slate::Tile<scalar_t> A2( nb, nb, A2_data.data(), nb, slate::HostNum,
+                                  slate::TileKind::UserOwned );
+        slate::Tile<scalar_t> T( ib, nb, T_data.data(), ib, slate::HostNum,
+                                 slate::TileKind::UserOwned );
+        slate::Tile<scalar_t> C1( nb, n, C1_data.data(), nb, slate::HostNum,
+                                  slate::TileKind::UserOwned );
+        slate::Tile<scalar_t> C2( nb, n, C2_data.data(), nb, slate::HostNum,
+                                  slate::TileKind::UserOwned );
+
+        auto restore = [&]() {
+            A1_data = A1_orig;
+            A2_data = A2_orig;
+        };
+        if (routine == "kernel_tpqrt") {
+            time = time_kernel( niter,
+                [&]() { slate::tile::tpqrt( nb, A1, A2, T ); },
+                restore );
+            flop = 2./3 * nb * nb * nb * 1e-9;
+        }
+        else {
+            restore();
+            slate::tile::tpqrt( nb, A1, A2, T );
+            time = time_kernel( niter, [&]() {
+                slate::tile::tpmqrt( blas::Side::Left, blas::Op::ConjTrans,
+                                     nb, A2, T, C1, C2 );
+            } );
+            flop = 2. * nb * nb * n * 1e-9;
+        }
+        flop *= complex_flops_factor<scalar_t>();
+    }
+    else {
+        // Panel of mt tiles, nb-by-nb except the last one.
+        int64_t mt = slate::ceildiv( m, nb );
+        int64_t diag_len = nb;
+        std::vector<scalar_t> data( mt*nb*nb ), orig( mt*nb*nb );
+        lapack::larnv( idist, iseed, orig.size(), orig.data() );
+
+        std::vector< slate::Tile<scalar_t> > tiles;
+        std::vector<int64_t> tile_indices;
+        for (int64_t i = 0; i < mt; ++i) {
+            int64_t mb = std::min( nb, m - i*nb );
+            tiles.push_back( slate::Tile<scalar_t>(
+                mb, nb, &data[ i*nb*nb ], mb, slate::HostNum,
+                slate::TileKind::UserOwned ) );
+            tile_indices.push_back( i );
+        }
+        int thread_size = std::min( panel_threads, mt );
+        auto restore = [&]() {
+            data = orig;
+        };
+
+        slate::ThreadBarrier thread_barrier;
+        if (routine == "kernel_getrf") {
+            std::vector<scalar_t> max_value( thread_size );
+            std::vector<int64_t> max_index( thread_size );
+            std::vector<int64_t> max_offset( thread_size );
+            std::vector<scalar_t> top_block( ib*nb );
+            std::vector< slate::internal::AuxPivot<scalar_t> > aux_pivot( diag_len );
+            int64_t info = 0;
+            time = time_kernel( niter, [&]() {
+                #pragma omp parallel for num_threads( thread_size )
+                for (int thread_rank = 0; thread_rank < thread_size;
+                     ++thread_rank) {
+                    slate::tile::getrf(
+                        diag_len, ib, tiles, tile_indices, aux_pivot,
+                        0, 0, MPI_COMM_SELF,
+                        thread_rank, thread_size, thread_barrier,
+                        max_value, max_index, max_offset, top_block,
+                        real_t( 1.0 ), &info );
+                }
+            }, restore );
+            flop = lapack::Gflop<scalar_t>::getrf( m, nb );
+        }
+        else if (routine == "kernel_geqrf"
+                 || routine == "kernel_householder") {
+            bool blocked = routine == "kernel_geqrf";
+            int64_t T_mb = blocked ? ib : nb;
+            std::vector<scalar_t> T_data( T_mb*nb );
+            slate::Tile<scalar_t> T( T_mb, nb, T_data.data(), T_mb,
+                                     slate::HostNum,
+                                     slate::TileKind::UserOwned );
+            std::vector<real_t> scale( thread_size );
+            std::vector<real_t> sumsq( thread_size );
+            real_t xnorm;
+            std::vector< std::vector<scalar_t> > W( thread_size );
+            time = time_kernel( niter, [&]() {
+                #pragma omp parallel num_threads( thread_size )
+                {
+                    int thread_rank = omp_get_thread_num();
+                    W.at( thread_rank ).resize( ib*nb );
+                    if (blocked) {
+                        slate::tile::geqrf(
+                            ib, tiles, tile_indices, T,
+                            thread_rank, thread_size, thread_barrier,
+                            scale, sumsq, xnorm, W );
+                    }
+                    else {
+                        slate::tile::householder_reflection_generator(
+                            tiles, tile_indices, T,
+                            thread_rank, thread_size, thread_barrier,
+                            scale, sumsq, xnorm, W );
+                    }
+                }
+            }, restore );
+            flop = lapack::Gflop<scalar_t>::geqrf( m, nb );
+        }
+        else {
+            throw slate::Exception( "unknown routine: " + routine );
+        }
+    }
+
+    params.time()   = time;
+    params.gflops() = flop / time;
+}
+
+//------------------------------------------------------------------------------
+/// Microbenchmark of the batched device kernels, on device 0 of each rank:
+///
+/// - kernel_genorm:    device::genorm with --norm, of each tile;
+/// - kernel_transpose: device::transpose_batch, out of place;
+/// - kernel_gecopy:    device::gecopy;
+/// - kernel_geadd:     device::geadd, B = alpha A + beta B;
+/// - kernel_geset:     device::geset.
+///
+/// Each call runs on a batch of --tiles m-by-n tiles. Output: time (s) of
+/// one call, and Gbyte/s of the tiles read and written.
+///
+template <typename scalar_t>
+void test_kernel_device( Params& params, bool run )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // get & mark input values
+    std::string routine = params.routine;
+    int64_t m = params.dim.m();
+    int64_t n = params.dim.n();
+    int64_t batch_count = params.tiles();
+    int64_t niter = params.niter();
+    lapack::Norm norm = lapack::Norm::One;
+    if (routine == "kernel_genorm")
+        norm = params.norm();
+
+    // mark non-standard output values
+    params.time();
+    params.gbytes();
+
+    if (! run)
+        return;
+
+    if (blas::get_device_count() == 0) {
+        params.msg() = "skipping: requires a GPU";
+        return;
+    }
+
+    blas::Queue queue( 0 );
+    int64_t lda = std::max( m, int64_t( 1 ) );
+    int64_t ldat = std::max( n, int64_t( 1 ) );
+    int64_t tile_size = std::max( lda*n, ldat*m );
+
+    std::vector<scalar_t> A_data( tile_size * batch_count );
+    int64_t idist = 3;
+    int64_t iseed[4] = { 0, 1, 2, 3 };
+    lapack::larnv( idist, iseed, A_data.size(), A_data.data() );
+
+    scalar_t* dA = blas::device_malloc<scalar_t>( A_data.size(), queue );
+    scalar_t* dB = blas::device_malloc<scalar_t>( A_data.size(), queue );
+    blas::device_memcpy<scalar_t>( dA, A_data.data(), A_data.size(), queue );
+
+    std::vector<scalar_t*> A_array( batch_count ), B_array( batch_count );
+    for (int64_t i = 0; i < batch_count; ++i) {
+        A_array[ i ] = dA + i*tile_size;
+        B_array[ i ] = dB + i*tile_size;
+    }
+    scalar_t** dA_array = blas::device_malloc<scalar_t*>( batch_count, queue );
+    scalar_t** dB_array = blas::device_malloc<scalar_t*>( batch_count, queue );
+    blas::device_memcpy<scalar_t*>( dA_array, A_array.data(), batch_count, queue );
+    blas::device_memcpy<scalar_t*>( dB_array, B_array.data(), batch_count, queue );
+
+    int64_t ldv = 1;
+    if (norm == lapack::Norm::One)
+        ldv = n;
+    else if (norm == lapack::Norm::Inf)
+        ldv = m;
+    else if (norm == lapack::Norm::Fro)
+        ldv = 2;
+    real_t* dvalues = blas::device_malloc<real_t>( ldv * batch_count, queue );
+
+    // Bytes read and written of one tile.
+    double tile_bytes = double( m ) * n * sizeof( scalar_t );
+    double bytes = 0;
+    std::function< void () > kernel;
+    if (routine == "kernel_genorm") {
+        kernel = [&]() {
+            slate::device::genorm(
+                norm, slate::NormScope::Matrix, m, n,
+                (scalar_t const* const*) dA_array, lda,
+                dvalues, ldv, batch_count, queue );
+        };
+        bytes = tile_bytes;
+    }
+    else if (routine == "kernel_transpose") {
+        kernel = [&]() {
+            slate::device::transpose_batch(
+                false, m, n, dA_array, lda, dB_array, ldat,
+                batch_count, queue );
+        };
+        bytes = 2 * tile_bytes;
+    }
+    else if (routine == "kernel_gecopy") {
+        kernel = [&]() {
+            slate::device::gecopy(
+                m, n, (scalar_t const* const*) dA_array, lda,
+                dB_array, lda, batch_count, queue );
+        };
+        bytes = 2 * tile_bytes;
+    }
+    else if (routine == "kernel_geadd") {
+        scalar_t alpha = 0.5, beta = 2.0;
+        kernel = [&, alpha, beta]() {
+            slate::device::batch::geadd(
+                m, n, alpha, dA_array, lda, beta, dB_array, lda,
+                batch_count, queue );
+        };
+        bytes = 3 * tile_bytes;
+    }
+    else if (routine == "kernel_geset") {
+        scalar_t offdiag = 0.0, diag = 1.0;
+        kernel = [&, offdiag, diag]() {
+            slate::device::batch::geset(
+                m, n, offdiag, diag, dB_array, lda, batch_count, queue );
+        };
+        bytes = tile_bytes;
+    }
+
+    double time = 0;
+    if (kernel) {
+        time = time_kernel( niter, kernel, nullptr,
+                            [&]() { queue.sync(); } );
+    }
+
+    blas::device_free( dvalues, queue );
+    blas::device_free( dA_array, queue );
+    blas::device_free( dB_array, queue );
+    blas::device_free( dA, queue );
+    blas::device_free( dB, queue );
+
+    if (! kernel)
+        throw slate::Exception( "unknown routine: " + routine );
+
+    params.time()   = time;
+    params.gbytes() = bytes * batch_count / time * 1e-9;
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void test_kernel_work( Params& params, bool run )
+{
+    if (params.routine == "kernel_getrf"
+        || params.routine == "kernel_geqrf"
+        || params.routine == "kernel_householder"
+        || params.routine == "kernel_tpqrt"
+        || params.routine == "kernel_tpmqrt") {
+        test_kernel_host<scalar_t>( params, run );
+    }
+    else {
+        test_kernel_device<scalar_t>( params, run );
+    }
+}
+
+// -----------------------------------------------------------------------------
+void test_kernel( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Single:
+            test_kernel_work<float> (params, run);
+            break;
+
+        case testsweeper::DataType::Double:
+            test_kernel_work<double> (params, run);
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_kernel_work<std::complex<float>> (params, run);
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_kernel_work<std::complex<double>> (params, run);
+            break;
+
+        default:
+            throw std::runtime_error( "unknown datatype" );
+            break;
+    }
+}
@@ -64,7 +64,7 @@ void test_pbsv_work(Params& params, bool run)
 
     // MPI variables
     int mpi_rank, myrow, mycol;
-    MPI_Comm_rank(MPI_COMM_WORLD, &mpi_rank);
+    MPI_Comm_rank(tester_comm(), &mpi_rank);
     gridinfo(mpi_rank, p, q, &myrow, &mycol);
 
     // Matrix B: figure out local size.
@@ -75,15 +75,15 @@ void test_pbsv_work(Params& params, bool run)
 
     // Create SLATE matrix from the ScaLAPACK layouts
     auto B = slate::Matrix<scalar_t>::fromScaLAPACK(
-                 n, nrhs, &B_data[0], lldB, nb, p, q, MPI_COMM_WORLD);
+                 n, nrhs, &B_data[0], lldB, nb, p, q, tester_comm());
 
     slate::generate_matrix(params.matrix, B);
 
     int64_t iseeds[4] = { myrow, mycol, 2, 3 };
     auto A = slate::HermitianBandMatrix<scalar_t>(
-                 uplo, n, kd, nb, p, q, MPI_COMM_WORLD);
+                 uplo, n, kd, nb, p, q, tester_comm());
     auto Aorig = slate::HermitianBandMatrix<scalar_t>(
-                     uplo, n, kd, nb, p, q, MPI_COMM_WORLD);
+                     uplo, n, kd, nb, p, q, tester_comm());
 
     int64_t kdt = slate::ceildiv(kd, nb);
     int64_t jj = 0;
@@ -137,7 +137,7 @@ void test_pbsv_work(Params& params, bool run)
     // if check is required, copy test data and create a descriptor for it
     slate::Matrix<scalar_t> Bref;
     if (check || ref) {
-        Bref = slate::Matrix<scalar_t>(n, nrhs, nb, p, q, MPI_COMM_WORLD);
+        Bref = slate::Matrix<scalar_t>(n, nrhs, nb, p, q, tester_comm());
         Bref.insertLocalTiles();
         slate::copy( B, Bref );
     }
@@ -161,7 +161,7 @@ void test_pbsv_work(Params& params, bool run)
         if (trace) slate::trace::Trace::on();
         else slate::trace::Trace::off();
 
-        double time = barrier_get_wtime(MPI_COMM_WORLD);
+        double time = barrier_get_wtime(tester_comm());
 
         //==================================================
         // Run SLATE test.
@@ -186,7 +186,7 @@ void test_pbsv_work(Params& params, bool run)
             // slate::pbsv(A, B, opts);
         }
 
-        time = barrier_get_wtime(MPI_COMM_WORLD) - time;
+        time = barrier_get_wtime(tester_comm()) - time;
 
         if (trace)
             slate::trace::Trace::finish();
@@ -87,7 +87,7 @@ void test_pocondest_work(Params& params, bool run)
 
     // MPI variables
     int mpi_rank, myrow, mycol;
-    MPI_Comm_rank(MPI_COMM_WORLD, &mpi_rank);
+    MPI_Comm_rank(tester_comm(), &mpi_rank);
     gridinfo( mpi_rank, grid_order, p, q, &myrow, &mycol );
 
     slate::Options const opts =  {
@@ -109,21 +109,21 @@ void test_pocondest_work(Params& params, bool run)
         // SLATE allocates CPU or GPU tiles.
         slate::Target origin_target = origin2target(origin);
         A = slate::HermitianMatrix<scalar_t>(
-                uplo, n, nb, p, q, MPI_COMM_WORLD );
+                uplo, n, nb, p, q, tester_comm() );
         A.insertLocalTiles(origin_target);
     }
     else {
         // Create SLATE matrix from the ScaLAPACK layouts
         A_data.resize( lldA * nlocA );
         A = slate::HermitianMatrix<scalar_t>::fromScaLAPACK(
-            uplo, n, &A_data[0], lldA, nb, grid_order, p, q, MPI_COMM_WORLD );
+            uplo, n, &A_data[0], lldA, nb, grid_order, p, q, tester_comm() );
     }
 
     slate::Matrix<scalar_t> Id;
     if (check) {
         slate::Target origin_target = origin2target(origin);
         Id = slate::Matrix<scalar_t>(
-                n, n,    nb, p, q, MPI_COMM_WORLD );
+                n, n,    nb, p, q, tester_comm() );
         Id.insertLocalTiles(origin_target);
     }
 
@@ -137,7 +137,7 @@ void test_pocondest_work(Params& params, bool run)
         Aref_data.resize( lldA* nlocA );
         Aref = slate::HermitianMatrix<scalar_t>::fromScaLAPACK(
                 uplo, n, &Aref_data[0], lldA, nb,
-                grid_order, p, q, MPI_COMM_WORLD );
+                grid_order, p, q, tester_comm() );
 
         slate::copy(A, Aref);
     }
@@ -160,20 +160,20 @@ void test_pocondest_work(Params& params, bool run)
         // pocondest:  Solve AX = B, including factoring A.
         //==================================================
 
-        double time2 = barrier_get_wtime(MPI_COMM_WORLD);
+        double time2 = barrier_get_wtime(tester_comm());
         slate::chol_factor(A, opts);
         // Using traditional BLAS/LAPACK name
         // slate::potrf(A, opts);
         // compute and save timing/performance
-        time2 = barrier_get_wtime(MPI_COMM_WORLD) - time2;
+        time2 = barrier_get_wtime(tester_comm()) - time2;
         params.time2() = time2;
         params.gflops2() = gflop / time2;
 
-        double time = barrier_get_wtime(MPI_COMM_WORLD);
+        double time = barrier_get_wtime(tester_comm());
         slate_rcond = slate::chol_rcondest_using_factor( norm, A, Anorm, opts );
         // Using traditional BLAS/LAPACK name
         // slate_rcond = slate::pocondest( norm, A, Anorm, opts );
-        time = barrier_get_wtime(MPI_COMM_WORLD) - time;
+        time = barrier_get_wtime(tester_comm()) - time;
         // compute and save timing/performance
         params.time() = time;
         params.gflops() = gflop / time;
@@ -245,13 +245,13 @@ void test_pocondest_work(Params& params, bool run)
 
             // todo: ScaLAPCK pzpocon has a seg fault
 
-            double time = barrier_get_wtime(MPI_COMM_WORLD);
+            double time = barrier_get_wtime(tester_comm());
             scalapack_ppocon( to_c_string( uplo ), n,
                               &Aref_data[0], 1, 1, Aref_desc,
                               &Anorm, &scl_rcond,
                               &work[0], lwork, &iwork[0], liwork, &info );
             slate_assert( info == 0 );
-            time = barrier_get_wtime(MPI_COMM_WORLD) - time;
+            time = barrier_get_wtime(tester_comm()) - time;
 
             params.ref_time() = time;
             params.ref_gflops() = gflop / time;
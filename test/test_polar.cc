@@ -0,0 +1,153 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/slate.hh"
+#include "test.hh"
+#include "print_matrix.hh"
+
+#include "matrix_utils.hh"
+#include "test_utils.hh"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <utility>
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void test_polar_work( Params& params, bool run )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // Constants
+    const scalar_t zero = 0;
+    const scalar_t one  = 1;
+
+    // get & mark input values
+    int64_t m = params.dim.m();
+    int64_t n = params.dim.n();
+    int64_t ib = params.ib();
+    int64_t panel_threads = params.panel_threads();
+    int64_t lookahead = params.lookahead();
+    bool check = params.check() == 'y';
+    bool trace = params.trace() == 'y';
+    slate::Target target = params.target();
+    params.matrix.mark();
+
+    mark_params_for_test_Matrix( params );
+    params.nonuniform_nb.used( false );
+
+    params.time();
+    params.ortho_U();
+    params.error.name( "A - U H" );
+
+    if (! run)
+        return;
+
+    // Check for common invalid combinations
+    if (is_invalid_parameters( params )) {
+        return;
+    }
+
+    if (m < n) {
+        params.msg() = "skipping: requires m >= n";
+        return;
+    }
+
+    slate::Options const opts =  {
+        {slate::Option::Lookahead, lookahead},
+        {slate::Option::Target, target},
+        {slate::Option::MaxPanelThreads, panel_threads},
+        {slate::Option::InnerBlocking, ib},
+    };
+
+    auto A_alloc = allocate_test_Matrix<scalar_t>( check, true, m, n, params );
+    auto H_alloc = allocate_test_Matrix<scalar_t>( false, true, n, n, params );
+
+    auto& A = A_alloc.A;
+    auto& H = H_alloc.A;
+
+    slate::generate_matrix( params.matrix, A );
+    print_matrix( "A", A, params );
+
+    if (check)
+        slate::copy( A, A_alloc.Aref );
+
+    if (trace) slate::trace::Trace::on();
+    else slate::trace::Trace::off();
+
+    double time = barrier_get_wtime( tester_comm() );
+
+    //==================================================
+    // Run SLATE test.
+    // On exit, A is overwritten by U_p.
+    //==================================================
+    slate::polar( A, H, opts );
+
+    params.time() = barrier_get_wtime( tester_comm() ) - time;
+
+    if (trace) slate::trace::Trace::finish();
+
+    print_matrix( "U", A, params );
+    print_matrix( "H", H, params );
+
+    if (check) {
+        real_t tol = params.tol() * std::numeric_limits<real_t>::epsilon();
+        auto& Aref = A_alloc.Aref;
+        auto UH = conj_transpose( A );
+
+        //==================================================
+        // Test results by checking orthogonality of U
+        //
+        //      || I - U^H U ||_1
+        //     ------------------- < tol * epsilon
+        //              n
+        //==================================================
+        auto R_alloc = allocate_test_Matrix<scalar_t>( false, true, n, n, params );
+        auto& R = R_alloc.A;
+        slate::set( zero, one, R );
+        slate::gemm( -one, UH, A, one, R );
+        params.ortho_U() = slate::norm( slate::Norm::One, R ) / n;
+
+        //==================================================
+        // Test results by checking the backward error
+        //
+        //      || A - U H ||_1
+        //     ----------------- < tol * epsilon
+        //      || A ||_1  n
+        //==================================================
+        real_t A_norm = slate::norm( slate::Norm::One, Aref );
+        slate::gemm( -one, A, H, one, Aref );
+        params.error() = slate::norm( slate::Norm::One, Aref ) / (A_norm * n);
+
+        params.okay() = (params.error() <= tol) && (params.ortho_U() <= tol);
+    }
+}
+
+// -----------------------------------------------------------------------------
+void test_polar( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Single:
+            test_polar_work<float>( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_polar_work<double>( params, run );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_polar_work<std::complex<float>>( params, run );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_polar_work<std::complex<double>>( params, run );
+            break;
+
+        default:
+            throw std::runtime_error( "unknown datatype" );
+            break;
+    }
+}
@@ -40,7 +40,18 @@ void test_posv_work(Params& params, bool run)
     bool ref = params.ref() == 'y' || ref_only;
     bool check = params.check() == 'y' && ! ref_only;
     bool trace = params.trace() == 'y';
+    bool print_counters = params.counters() != 'n';
     bool hold_local_workspace = params.hold_local_workspace() == 'y';
+    bool bcast_packed = params.bcast_packed() == 'y';
+    bool bcast_partitioned = params.bcast_partitioned() == 'y';
+    bool progress_thread = params.progress_thread() == 'y';
+    slate::BcastPrecision bcast_precision = params.bcast_precision();
+    slate::TaskRuntime runtime = params.runtime();
+    int64_t trailing_block = params.trailing_block();
+    int64_t gmres_steps = params.gmres_steps();
+    slate::QueuePriority queue_priority = params.queue_priority();
+    slate::ComputePrecision compute_precision = params.compute_precision();
+    bool device_stealing = params.device_stealing() == 'y';
     int verbose = params.verbose();
     int timer_level = params.timer_level();
     slate::Origin origin = params.origin();
@@ -49,6 +60,10 @@ void test_posv_work(Params& params, bool run)
     params.matrixB.mark();
     slate::MethodTrsm method_trsm = params.method_trsm();
     slate::MethodHemm method_hemm = params.method_hemm();
+    bool equilibrate = params.equilibrate() == 'y';
+    bool fused_solve = params.fused_solve() == 'y';
+    bool panel_callback = params.panel_callback() == 'y';
+    int64_t panel_sub_tile = params.panel_sub_tile();
 
     mark_params_for_test_HermitianMatrix( params );
     mark_params_for_test_Matrix( params );
@@ -130,14 +145,38 @@ void test_posv_work(Params& params, bool run)
         return;
     }
 
+    // Block columns reported final by potrf, in order of the calls.
+    bool check_callback = panel_callback && ! is_iterative;
+    std::vector<int64_t> callback_columns;
+    slate::PanelCallback callback( [&]( int64_t k ) {
+        callback_columns.push_back( k );
+    } );
+
+    slate::Counters counters;
+    counters.logMessages( params.counters() == 'm' );
     slate::Options const opts =  {
         {slate::Option::Lookahead, lookahead},
         {slate::Option::Target, target},
         {slate::Option::HoldLocalWorkspace, hold_local_workspace},
+        {slate::Option::BcastPacked, bcast_packed},
+        {slate::Option::BcastPartitioned, bcast_partitioned},
+        {slate::Option::ProgressThread, progress_thread},
+        {slate::Option::BcastPrecision, bcast_precision},
+        {slate::Option::Counters, print_counters ? &counters : nullptr},
+        {slate::Option::TaskRuntime, runtime},
+        {slate::Option::TrailingBlock, trailing_block},
+        {slate::Option::GMRESSteps, gmres_steps},
+        {slate::Option::QueuePriority, queue_priority},
+        {slate::Option::ComputePrecision, compute_precision},
+        {slate::Option::DeviceStealing, device_stealing},
         {slate::Option::MethodTrsm, method_trsm},
         {slate::Option::MethodHemm, method_hemm},
         {slate::Option::MaxIterations, itermax},
         {slate::Option::UseFallbackSolver, fallback},
+        {slate::Option::Equilibrate, equilibrate},
+        {slate::Option::FusedSolve, fused_solve},
+        {slate::Option::PanelCallback, check_callback ? &callback : nullptr},
+        {slate::Option::PanelSubTile, panel_sub_tile},
     };
 
     if ((params.routine == "posv_mixed" || params.routine == "posv_mixed_gmres")
@@ -204,7 +243,7 @@ void test_posv_work(Params& params, bool run)
         // potrf: Factor A = LL^H or A = U^H U.
         // posv:  Solve AX = B, including factoring A.
         //==================================================
-        double time = barrier_get_wtime(MPI_COMM_WORLD);
+        double time = barrier_get_wtime(tester_comm());
 
         if (params.routine == "potrf" || params.routine == "potrs") {
             // Factor matrix A.
@@ -231,11 +270,14 @@ void test_posv_work(Params& params, bool run)
                 params.iters() = iters;
             }
         }
-        time = barrier_get_wtime(MPI_COMM_WORLD) - time;
+        time = barrier_get_wtime(tester_comm()) - time;
         // compute and save timing/performance
         params.time() = time;
         params.gflops() = gflop / time;
 
+        if (print_counters)
+            print_phase_counters( counters, params );
+
         if (timer_level >= 2 && params.routine == "posv") {
             params.time2() = slate::timers[ "posv::potrf" ];
             params.time3() = slate::timers[ "posv::potrs" ];
@@ -265,7 +307,7 @@ void test_posv_work(Params& params, bool run)
         // potrs: Solve AX = B, after factoring A above.
         //==================================================
         if (do_potrs && info == 0) {
-            double time2 = barrier_get_wtime(MPI_COMM_WORLD);
+            double time2 = barrier_get_wtime(tester_comm());
 
             if ((check && params.routine == "potrf")
                 || params.routine == "potrs")
@@ -277,7 +319,7 @@ void test_posv_work(Params& params, bool run)
             else {
                 slate_error("Unknown routine!");
             }
-            time2 = barrier_get_wtime(MPI_COMM_WORLD) - time2;
+            time2 = barrier_get_wtime(tester_comm()) - time2;
             // compute and save timing/performance
             params.time2() = time2;
             params.gflops2() = lapack::Gflop<scalar_t>::potrs(n, nrhs) / time2;
@@ -338,10 +380,27 @@ void test_posv_work(Params& params, bool run)
         double residual = R_norm / (n*A_norm*X_norm);
         params.error() = residual;
 
-        real_t tol = params.tol() * 0.5 * std::numeric_limits<real_t>::epsilon();
+        real_t eps = std::numeric_limits<real_t>::epsilon();
+        // TF32 rounds single precision gemm inputs to 11-bit significands.
+        if (compute_precision == slate::ComputePrecision::TF32
+            && std::is_same< real_t, float >::value)
+            eps = 0x1p-10;
+        // 3M's normwise bound has a larger constant; Higham, 2002, sec. 23.2.4.
+        if (compute_precision == slate::ComputePrecision::Complex3M
+            && slate::is_complex<scalar_t>::value)
+            eps *= 4;
+        real_t tol = params.tol() * 0.5 * eps;
         params.okay() = (params.error() <= tol);
         if (is_iterative)
             params.okay() = params.okay() && params.iters() >= 0;
+
+        // Each block column is reported once, in order.
+        if (check_callback) {
+            bool in_order = int64_t( callback_columns.size() ) == A.nt();
+            for (size_t k = 0; k < callback_columns.size() && in_order; ++k)
+                in_order = callback_columns[ k ] == int64_t( k );
+            params.okay() = params.okay() && in_order;
+        }
     }
 
     if (ref) {
@@ -371,7 +430,7 @@ void test_posv_work(Params& params, bool run)
             //==================================================
             // Run ScaLAPACK reference routine.
             //==================================================
-            double time = barrier_get_wtime(MPI_COMM_WORLD);
+            double time = barrier_get_wtime(tester_comm());
             if (params.routine == "potrf") {
                 scalapack_ppotrf( to_c_string( uplo ), n,
                                   &Aref_data[0], 1, 1, Aref_desc, &info );
@@ -387,7 +446,7 @@ void test_posv_work(Params& params, bool run)
                                  &Bref_data[0], 1, 1, Bref_desc, &info );
             }
             slate_assert(info == 0);
-            time = barrier_get_wtime(MPI_COMM_WORLD) - time;
+            time = barrier_get_wtime(tester_comm()) - time;
 
             params.ref_time() = time;
             params.ref_gflops() = gflop / time;
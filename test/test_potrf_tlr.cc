@@ -0,0 +1,193 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/slate.hh"
+#include "test.hh"
+#include "print_matrix.hh"
+
+#include "matrix_utils.hh"
+#include "test_utils.hh"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <utility>
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void test_potrf_tlr_work( Params& params, bool run )
+{
+    using real_t = blas::real_type<scalar_t>;
+    using slate::ceildiv;
+
+    // Constants
+    const scalar_t zero = 0;
+    const scalar_t one  = 1;
+
+    // get & mark input values
+    slate::Uplo uplo = params.uplo();
+    int64_t n = params.dim.n();
+    int64_t nrhs = params.nrhs();
+    int64_t nb = params.nb();
+    real_t tlr_tol = params.tlr_tol();
+    bool check = params.check() == 'y';
+    bool trace = params.trace() == 'y';
+    params.matrixB.mark();
+
+    mark_params_for_test_HermitianMatrix( params );
+    mark_params_for_test_Matrix( params );
+
+    // mark non-standard output values
+    params.time();
+    params.time2();
+    params.time2.name( "trsm (s)" );
+    params.error2();
+    params.error2.name( "gemm error" );
+
+    if (! run)
+        return;
+
+    // Check for common invalid combinations
+    if (is_invalid_parameters( params )) {
+        return;
+    }
+
+    if (uplo != slate::Uplo::Lower) {
+        params.msg() = "skipping: requires uplo = lower";
+        return;
+    }
+
+    slate::Options const opts;
+
+    auto A_alloc = allocate_test_HermitianMatrix<scalar_t>( false, true, n, params );
+    auto B_alloc = allocate_test_Matrix<scalar_t>( false, true, n, nrhs, params );
+    auto X_alloc = allocate_test_Matrix<scalar_t>( false, true, n, nrhs, params );
+
+    auto& A = A_alloc.A;
+    auto& B = B_alloc.A;
+    auto& X = X_alloc.A;
+
+    // Data-sparse matrix: Gaussian covariance kernel of points on a line,
+    // with length scale 0.1, plus a unit nugget on the diagonal.
+    // Its off-diagonal tiles have low numerical rank.
+    std::function< scalar_t (int64_t, int64_t) > kernel =
+        [n]( int64_t i, int64_t j ) {
+            real_t d = real_t( i - j ) / n / 0.1;
+            return scalar_t( std::exp( -d*d / 2 ) + (i == j ? 1 : 0) );
+        };
+    slate::set( kernel, A );
+    slate::generate_matrix( params.matrixB, B );
+    print_matrix( "A", A, params );
+    print_matrix( "B", B, params );
+
+    real_t A_norm = slate::norm( slate::Norm::One, A );
+    real_t B_norm = slate::norm( slate::Norm::One, B );
+
+    if (trace) slate::trace::Trace::on();
+    else slate::trace::Trace::off();
+
+    //==================================================
+    // Run SLATE test: compress, then check the TLR gemm.
+    //==================================================
+    double time = barrier_get_wtime( tester_comm() );
+
+    slate::TLRMatrix<scalar_t> T( A, tlr_tol * A_norm );
+    slate::compress( A, T, opts );
+
+    double time_compress = barrier_get_wtime( tester_comm() ) - time;
+
+    int64_t max_rank = T.maxRank();
+
+    if (check) {
+        //==================================================
+        // Test the multiply, with C = A B in TLR form:
+        //
+        //      || A B - C ||_1
+        //     ----------------- < tol * epsilon + nt^2 * tlr_tol
+        //     || A ||_1 || B ||_1
+        //==================================================
+        auto C_alloc = allocate_test_Matrix<scalar_t>( false, true, n, nrhs, params );
+        auto& C = C_alloc.A;
+        slate::gemm( one, T, B, zero, C, opts );
+        slate::hemm( slate::Side::Left, -one, A, B, one, C, opts );
+        params.error2() = slate::norm( slate::Norm::One, C ) / (A_norm * B_norm);
+    }
+
+    //==================================================
+    // Run SLATE test: factor, then solve A X = B.
+    //==================================================
+    time = barrier_get_wtime( tester_comm() );
+
+    int64_t info = slate::potrf( T, opts );
+
+    params.time() = time_compress + barrier_get_wtime( tester_comm() ) - time;
+
+    slate::copy( B, X, opts );
+    time = barrier_get_wtime( tester_comm() );
+
+    slate::trsm( slate::Op::NoTrans,   one, T, X, opts );
+    slate::trsm( slate::Op::ConjTrans, one, T, X, opts );
+
+    params.time2() = barrier_get_wtime( tester_comm() ) - time;
+
+    if (trace) slate::trace::Trace::finish();
+
+    params.msg() = "max rank " + std::to_string( max_rank );
+    if (info != 0) {
+        params.msg() += ", potrf info = " + std::to_string( info );
+    }
+
+    print_matrix( "X", X, params );
+
+    if (check) {
+        //==================================================
+        // Test results by checking the residual
+        //
+        //      || B - A X ||_1
+        //     ----------------- < tol * epsilon + nt^2 * tlr_tol
+        //     || A ||_1 || X ||_1
+        //
+        // The compression error is at most tlr_tol ||A||_1 per tile,
+        // and potrf recompresses each tile up to nt times.
+        //==================================================
+        real_t X_norm = slate::norm( slate::Norm::One, X );
+        slate::hemm( slate::Side::Left, -one, A, X, one, B, opts );
+        params.error() = slate::norm( slate::Norm::One, B ) / (A_norm * X_norm);
+
+        int64_t nt = ceildiv( n, nb );
+        real_t eps = std::numeric_limits<real_t>::epsilon();
+        real_t tol = params.tol() * eps + nt * nt * tlr_tol;
+        params.okay() = (info == 0)
+                        && (params.error() <= tol)
+                        && (params.error2() <= tol);
+    }
+}
+
+// -----------------------------------------------------------------------------
+void test_potrf_tlr( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Single:
+            test_potrf_tlr_work<float>( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_potrf_tlr_work<double>( params, run );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_potrf_tlr_work<std::complex<float>>( params, run );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_potrf_tlr_work<std::complex<double>>( params, run );
+            break;
+
+        default:
+            throw std::runtime_error( "unknown datatype" );
+            break;
+    }
+}
@@ -0,0 +1,179 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/slate.hh"
+#include "test.hh"
+#include "blas/flops.hh"
+#include "lapack/flops.hh"
+#include "print_matrix.hh"
+#include "matgen.hh"
+
+#include "grid_utils.hh"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <utility>
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void test_potrf_update_work(Params& params, bool run)
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // Constants
+    const scalar_t one  = 1;
+
+    // get & mark input values
+    slate::Uplo uplo = params.uplo();
+    int64_t n = params.dim.n();
+    int64_t k = params.nrhs();
+    int sign = params.update_sign();
+    int p = params.grid.m();
+    int q = params.grid.n();
+    int64_t nb = params.nb();
+    int64_t lookahead = params.lookahead();
+    bool check = params.check() == 'y';
+    bool trace = params.trace() == 'y';
+    slate::Origin origin = params.origin();
+    slate::Target target = params.target();
+    params.matrix.mark();
+    params.matrixB.mark();
+
+    // mark non-standard output values
+    params.time();
+    params.gflops();
+
+    if (! run) {
+        params.matrix.kind.set_default( "rand_dominant" );
+        return;
+    }
+
+    slate::Options const opts =  {
+        {slate::Option::Lookahead, lookahead},
+        {slate::Option::Target, target}
+    };
+
+    slate::Target origin_target = origin2target(origin);
+
+    // A0 is Hermitian positive definite; A1 = A0 + V V^H.
+    slate::HermitianMatrix<scalar_t> A0(uplo, n, nb, p, q, tester_comm());
+    slate::HermitianMatrix<scalar_t> A1(uplo, n, nb, p, q, tester_comm());
+    slate::Matrix<scalar_t> V(n, k, nb, p, q, tester_comm());
+    A0.insertLocalTiles(origin_target);
+    A1.insertLocalTiles(origin_target);
+    V.insertLocalTiles(origin_target);
+
+    slate::generate_matrix(params.matrix, A0);
+    slate::generate_matrix(params.matrixB, V);
+
+    slate::copy( A0, A1 );
+    slate::herk( real_t( 1.0 ), V, real_t( 1.0 ), A1, opts );
+
+    // Update the factor of A0 to that of A1, or downdate that of A1 to
+    // that of A0.
+    auto& A_start  = sign > 0 ? A0 : A1;
+    auto& A_target = sign > 0 ? A1 : A0;
+
+    slate::HermitianMatrix<scalar_t> L(uplo, n, nb, p, q, tester_comm());
+    L.insertLocalTiles(origin_target);
+    slate::copy( A_start, L );
+    slate::potrf( L, opts );
+
+    print_matrix( "L", L, params );
+    print_matrix( "V", V, params );
+
+    // 2 k n^2 flops for the rotations, counted as a rank-k update.
+    double gflop = blas::Gflop<scalar_t>::herk( n, k );
+
+    if (trace) slate::trace::Trace::on();
+    else slate::trace::Trace::off();
+
+    double time = barrier_get_wtime(tester_comm());
+
+    //==================================================
+    // Run SLATE test.
+    //==================================================
+    int64_t info = slate::potrf_update( L, V, sign, opts );
+
+    time = barrier_get_wtime(tester_comm()) - time;
+
+    if (trace) slate::trace::Trace::finish();
+
+    if (info != 0) {
+        char buf[ 80 ];
+        snprintf( buf, sizeof(buf), "info = %lld", llong( info ) );
+        params.msg() = buf;
+    }
+
+    // compute and save timing/performance
+    params.time() = time;
+    params.gflops() = gflop / time;
+
+    print_matrix( "L_out", L, params );
+
+    if (check) {
+        //==================================================
+        // Check || A_target X - L L^H X || / (n || A_target || || X ||)
+        // for a random X.
+        //==================================================
+        int64_t nrhs = 10;
+        slate::Matrix<scalar_t> X(n, nrhs, nb, p, q, tester_comm());
+        slate::Matrix<scalar_t> Y(n, nrhs, nb, p, q, tester_comm());
+        X.insertLocalTiles(origin_target);
+        Y.insertLocalTiles(origin_target);
+        slate::generate_matrix( params.matrixB, X );
+        slate::copy( X, Y );
+
+        // Y = L L^H X, or U^H U X.
+        auto T = slate::TriangularMatrix<scalar_t>( slate::Diag::NonUnit, L );
+        auto TH = conj_transpose( T );
+        if (uplo == slate::Uplo::Lower) {
+            slate::trmm( slate::Side::Left, one, TH, Y, opts );
+            slate::trmm( slate::Side::Left, one, T,  Y, opts );
+        }
+        else {
+            slate::trmm( slate::Side::Left, one, T,  Y, opts );
+            slate::trmm( slate::Side::Left, one, TH, Y, opts );
+        }
+
+        // Y = A_target X - Y
+        slate::multiply( one, A_target, X, -one, Y, opts );
+
+        real_t A_norm = slate::norm( slate::Norm::One, A_target );
+        real_t X_norm = slate::norm( slate::Norm::One, X );
+        real_t Y_norm = slate::norm( slate::Norm::One, Y );
+
+        params.error() = Y_norm / (n * A_norm * X_norm);
+        real_t tol = params.tol() * std::numeric_limits<real_t>::epsilon();
+        params.okay() = (params.error() <= tol) && info == 0;
+    }
+}
+
+// -----------------------------------------------------------------------------
+void test_potrf_update(Params& params, bool run)
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Single:
+            test_potrf_update_work<float> (params, run);
+            break;
+
+        case testsweeper::DataType::Double:
+            test_potrf_update_work<double> (params, run);
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_potrf_update_work<std::complex<float>> (params, run);
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_potrf_update_work<std::complex<double>> (params, run);
+            break;
+
+        default:
+            throw std::runtime_error( "unknown datatype" );
+            break;
+    }
+}
@@ -70,7 +70,7 @@ void test_potri_work(Params& params, bool run)
 
     // MPI variables
     int mpi_rank, myrow, mycol;
-    MPI_Comm_rank(MPI_COMM_WORLD, &mpi_rank);
+    MPI_Comm_rank(tester_comm(), &mpi_rank);
     gridinfo(mpi_rank, p, q, &myrow, &mycol);
 
     // Matrix A: figure out local size.
@@ -85,19 +85,19 @@ void test_potri_work(Params& params, bool run)
     }
 
     // todo: work-around to initialize BaseMatrix::num_devices_
-    slate::HermitianMatrix<scalar_t> A0(uplo, n, nb, p, q, MPI_COMM_WORLD);
+    slate::HermitianMatrix<scalar_t> A0(uplo, n, nb, p, q, tester_comm());
 
     slate::HermitianMatrix<scalar_t> A;
     if (origin == slate::Origin::Devices) {
         // SLATE allocates CPU or GPU tiles.
         slate::Target origin_target = origin2target(origin);
-        A = slate::HermitianMatrix<scalar_t>(uplo, n, nb, p, q, MPI_COMM_WORLD);
+        A = slate::HermitianMatrix<scalar_t>(uplo, n, nb, p, q, tester_comm());
         A.insertLocalTiles(origin_target);
     }
     else {
         // Create SLATE matrix from the ScaLAPACK layouts
         A = slate::HermitianMatrix<scalar_t>::fromScaLAPACK(
-                uplo, n, &A_data[0], lldA, nb, p, q, MPI_COMM_WORLD);
+                uplo, n, &A_data[0], lldA, nb, p, q, tester_comm());
     }
 
     slate::generate_matrix(params.matrix, A);
@@ -108,7 +108,7 @@ void test_potri_work(Params& params, bool run)
     if (check || ref) {
         Aref_data.resize( lldA * nlocA );
         Aref = slate::HermitianMatrix<scalar_t>::fromScaLAPACK(
-                   uplo, n, &Aref_data[0], lldA, nb, p, q, MPI_COMM_WORLD);
+                   uplo, n, &Aref_data[0], lldA, nb, p, q, tester_comm());
         slate::copy( A, Aref );
     }
 
@@ -125,7 +125,7 @@ void test_potri_work(Params& params, bool run)
         if (trace) slate::trace::Trace::on();
         else slate::trace::Trace::off();
 
-        double time = barrier_get_wtime(MPI_COMM_WORLD);
+        double time = barrier_get_wtime(tester_comm());
 
         //==================================================
         // Run SLATE test.
@@ -137,7 +137,7 @@ void test_potri_work(Params& params, bool run)
         // slate::potrf(A, opts);
         // slate::potri(A, opts);
 
-        time = barrier_get_wtime(MPI_COMM_WORLD) - time;
+        time = barrier_get_wtime(tester_comm()) - time;
 
         if (trace) slate::trace::Trace::finish();
 
@@ -154,8 +154,8 @@ void test_potri_work(Params& params, bool run)
         // Check || X - A^{-1} A X || / (n || X ||) < tol
         //==================================================
         slate::Matrix<scalar_t> X, Y;
-        X = slate::Matrix<scalar_t>( n, nrhs, nb, p, q, MPI_COMM_WORLD);
-        Y = slate::Matrix<scalar_t>( n, nrhs, nb, p, q, MPI_COMM_WORLD);
+        X = slate::Matrix<scalar_t>( n, nrhs, nb, p, q, tester_comm());
+        Y = slate::Matrix<scalar_t>( n, nrhs, nb, p, q, tester_comm());
         slate::Target origin_target = origin2target(origin);
         X.insertLocalTiles(origin_target);
         Y.insertLocalTiles(origin_target);
@@ -105,11 +105,11 @@ void test_scale_work(Params& params, bool run)
         // Run SLATE test.
         // Scale A by alpha/beta.
         //==================================================
-        double time = barrier_get_wtime(MPI_COMM_WORLD);
+        double time = barrier_get_wtime(tester_comm());
 
         slate::scale( alpha, beta, A, opts );
 
-        time = barrier_get_wtime(MPI_COMM_WORLD) - time;
+        time = barrier_get_wtime(tester_comm()) - time;
 
         if (trace) slate::trace::Trace::finish();
 
@@ -136,14 +136,14 @@ void test_scale_work(Params& params, bool run)
             //==================================================
             // Run ScaLAPACK reference routine.
             //==================================================
-            double time = barrier_get_wtime(MPI_COMM_WORLD);
+            double time = barrier_get_wtime(tester_comm());
 
             int64_t info;
             scalapack_plascl( to_c_string( uplo ), alpha, beta, m, n,
                               &Aref_data[0], 1, 1, A_desc, &info );
             slate_assert(info == 0);
 
-            time = barrier_get_wtime(MPI_COMM_WORLD) - time;
+            time = barrier_get_wtime(tester_comm()) - time;
             params.ref_time() = time;
 
             print_matrix( "Aref_full_out", Aref_full, params );
@@ -79,7 +79,7 @@ void test_scale_row_col_work( Params& params, bool run )
 
     // MPI variables
     int mpi_rank;
-    MPI_Comm_rank( MPI_COMM_WORLD, &mpi_rank );
+    MPI_Comm_rank( tester_comm(), &mpi_rank );
 
     auto A_alloc = allocate_test_Matrix<scalar_t>( check || ref, false, m, n, params );
 
@@ -128,11 +128,11 @@ void test_scale_row_col_work( Params& params, bool run )
         //       = diag(R) A,         for equed = Row,
         //       =         A diag(C)  for equed = Col.
         //==================================================
-        double time = barrier_get_wtime( MPI_COMM_WORLD );
+        double time = barrier_get_wtime( tester_comm() );
 
         slate::scale_row_col( equed, R, C, A, opts );
 
-        time = barrier_get_wtime( MPI_COMM_WORLD ) - time;
+        time = barrier_get_wtime( tester_comm() ) - time;
 
         if (trace) slate::trace::Trace::finish();
 
@@ -188,7 +188,7 @@ void test_scale_row_col_work( Params& params, bool run )
             //==================================================
             // Run ScaLAPACK reference routine.
             //==================================================
-            double time = barrier_get_wtime( MPI_COMM_WORLD );
+            double time = barrier_get_wtime( tester_comm() );
 
             // Use rowcnd = 0.0 to force row scaling, 1.0 to avoid row scaling.
             real_t rowcnd = 1.0;
@@ -205,7 +205,7 @@ void test_scale_row_col_work( Params& params, bool run )
                               Rlocal.data(), Clocal.data(),
                               rowcnd, colcnd, A_max, &equed_out );
 
-            time = barrier_get_wtime( MPI_COMM_WORLD ) - time;
+            time = barrier_get_wtime( tester_comm() ) - time;
             params.ref_time() = time;
 
 // TODO:
@@ -105,11 +105,11 @@ void test_set_work(Params& params, bool run)
         // Set A to alpha on off-diagonal entries,
         //           beta on the diagonal entries.
         //==================================================
-        double time = barrier_get_wtime(MPI_COMM_WORLD);
+        double time = barrier_get_wtime(tester_comm());
 
         slate::set( alpha, beta, A, opts );
 
-        time = barrier_get_wtime(MPI_COMM_WORLD) - time;
+        time = barrier_get_wtime(tester_comm()) - time;
 
         if (trace) slate::trace::Trace::finish();
 
@@ -136,12 +136,12 @@ void test_set_work(Params& params, bool run)
             //==================================================
             // Run ScaLAPACK reference routine.
             //==================================================
-            double time = barrier_get_wtime(MPI_COMM_WORLD);
+            double time = barrier_get_wtime(tester_comm());
 
             scalapack_plaset( to_c_string( uplo ), m, n, alpha, beta,
                               &Aref_data[0], 1, 1, A_desc );
 
-            time = barrier_get_wtime(MPI_COMM_WORLD) - time;
+            time = barrier_get_wtime(tester_comm()) - time;
             params.ref_time() = time;
 
             print_matrix( "Aref_full_out", Aref_full, params );
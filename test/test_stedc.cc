@@ -70,7 +70,7 @@ void test_stedc_work( Params& params, bool run )
 
     // MPI variables
     int mpi_rank, myrow, mycol;
-    MPI_Comm_rank( MPI_COMM_WORLD, &mpi_rank );
+    MPI_Comm_rank( tester_comm(), &mpi_rank );
     gridinfo( mpi_rank, p, q, &myrow, &mycol );
 
     // Initialize the diagonal and subdiagonal
@@ -104,20 +104,20 @@ void test_stedc_work( Params& params, bool run )
 
     if (origin != slate::Origin::ScaLAPACK) {
         Z = slate::Matrix<scalar_t>(
-                n, n, nb, p, q, MPI_COMM_WORLD);
+                n, n, nb, p, q, tester_comm());
         Z.insertLocalTiles( origin2target( origin ) );
     }
     else {
         Z_data.resize( lldZ*nlocZ );
         Z = slate::Matrix<scalar_t>::fromScaLAPACK(
-                n, n, &Z_data[0], lldZ, nb, p, q, MPI_COMM_WORLD );
+                n, n, &Z_data[0], lldZ, nb, p, q, tester_comm() );
     }
     set( nan_, nan_, Z );
 
     if (ref) {
         Zref_data.resize( lldZ*nlocZ );
         Zref = slate::Matrix<scalar_t>::fromScaLAPACK(
-                   n, n, &Zref_data[0], lldZ, nb, p, q, MPI_COMM_WORLD );
+                   n, n, &Zref_data[0], lldZ, nb, p, q, tester_comm() );
         // undocumented, ScaLAPACK seems to require Z = Identity on input,
         // and pdsyevd sets it that way. Otherwise, deflated eigvecs
         // have entries as set here (say, -1).
@@ -132,14 +132,14 @@ void test_stedc_work( Params& params, bool run )
     if (trace)
         slate::trace::Trace::on();
 
-    double time = barrier_get_wtime( MPI_COMM_WORLD );
+    double time = barrier_get_wtime( tester_comm() );
 
     //==================================================
     // Run SLATE test.
     //==================================================
     slate::stedc( D, E, Z, opts );
 
-    params.time() = barrier_get_wtime( MPI_COMM_WORLD ) - time;
+    params.time() = barrier_get_wtime( tester_comm() ) - time;
 
     if (trace)
         slate::trace::Trace::finish();
@@ -158,7 +158,7 @@ void test_stedc_work( Params& params, bool run )
         //           n
         //
         //==================================================
-        slate::Matrix<scalar_t> R( n, n, nb, p, q, MPI_COMM_WORLD );
+        slate::Matrix<scalar_t> R( n, n, nb, p, q, tester_comm() );
         R.insertLocalTiles();
         slate::set( zero, one, R, opts );
         auto ZT = conj_transpose( Z );
@@ -200,7 +200,7 @@ void test_stedc_work( Params& params, bool run )
             jj += R.tileNb( j );
         }
         print_matrix( "R", R, params );
-        slate::Matrix<scalar_t> Z_Lambda( n, n, nb, p, q, MPI_COMM_WORLD );
+        slate::Matrix<scalar_t> Z_Lambda( n, n, nb, p, q, tester_comm() );
         Z_Lambda.insertLocalTiles();
         slate::copy( Z, Z_Lambda, opts );
         slate::scale_row_col( slate::Equed::Col, D, D, Z_Lambda, opts );
@@ -263,7 +263,7 @@ void test_stedc_work( Params& params, bool run )
             //==================================================
             // Run ScaLAPACK reference routine.
             //==================================================
-            time = barrier_get_wtime( MPI_COMM_WORLD );
+            time = barrier_get_wtime( tester_comm() );
 
             //print_matrix( "Zref_in", Zref, params );
             //print_vector( "Dref_in", Dref, params );
@@ -276,7 +276,7 @@ void test_stedc_work( Params& params, bool run )
             //printf( "done scalapack_pstedc, info=%d\n", info );
             slate_assert( info == 0 );
 
-            params.ref_time() = barrier_get_wtime( MPI_COMM_WORLD ) - time;
+            params.ref_time() = barrier_get_wtime( tester_comm() ) - time;
 
             if (mpi_rank == 0) {
                 print_vector( "Dref_out", Dref, params );
@@ -85,8 +85,8 @@ void test_stedc_deflate_work( Params& params, bool run )
 
     // MPI variables
     int mpi_rank, mpi_size, myrow, mycol;
-    MPI_Comm_rank( MPI_COMM_WORLD, &mpi_rank );
-    MPI_Comm_size( MPI_COMM_WORLD, &mpi_size );
+    MPI_Comm_rank( tester_comm(), &mpi_rank );
+    MPI_Comm_size( tester_comm(), &mpi_size );
     gridinfo( mpi_rank, p, q, &myrow, &mycol );
 
     if (verbose >= 1 && mpi_rank == 0)
@@ -101,19 +101,19 @@ void test_stedc_deflate_work( Params& params, bool run )
     slate::Matrix<scalar_t> Q, Qtype;
     if (origin != slate::Origin::ScaLAPACK) {
         Q = slate::Matrix<scalar_t>(
-                n, n, nb, p, q, MPI_COMM_WORLD);
+                n, n, nb, p, q, tester_comm());
         Q.insertLocalTiles( origin2target( origin ) );
         Qtype = slate::Matrix<scalar_t>(
-                   n, n, nb, p, q, MPI_COMM_WORLD);
+                   n, n, nb, p, q, tester_comm());
         Qtype.insertLocalTiles( origin2target( origin ) );
     }
     else {
         Q_data.resize( lldQ*nlocQ );
         Qtype_data.resize( lldQ*nlocQ );
         Q    = slate::Matrix<scalar_t>::fromScaLAPACK(
-                   n, n, &Q_data[0],    lldQ, nb, p, q, MPI_COMM_WORLD );
+                   n, n, &Q_data[0],    lldQ, nb, p, q, tester_comm() );
         Qtype = slate::Matrix<scalar_t>::fromScaLAPACK(
-                   n, n, &Qtype_data[0], lldQ, nb, p, q, MPI_COMM_WORLD );
+                   n, n, &Qtype_data[0], lldQ, nb, p, q, tester_comm() );
     }
     slate::set( zero, Q, opts );
     int64_t nt = Q.nt();
@@ -235,9 +235,9 @@ void test_stedc_deflate_work( Params& params, bool run )
         Qref_data.resize( lldQ*nlocQ );
         Qtype_ref_data.resize( lldQ*nlocQ, nan("") );
         Qref     = slate::Matrix<scalar_t>::fromScaLAPACK(
-                       n, n, &Qref_data[0],     lldQ, nb, p, q, MPI_COMM_WORLD );
+                       n, n, &Qref_data[0],     lldQ, nb, p, q, tester_comm() );
         Qtype_ref = slate::Matrix<scalar_t>::fromScaLAPACK(
-                       n, n, &Qtype_ref_data[0], lldQ, nb, p, q, MPI_COMM_WORLD );
+                       n, n, &Qtype_ref_data[0], lldQ, nb, p, q, tester_comm() );
         copy( Q, Qref );
         Dref = D;
         zref = z;
@@ -268,7 +268,7 @@ void test_stedc_deflate_work( Params& params, bool run )
     if (trace)
         slate::trace::Trace::on();
 
-    double time = barrier_get_wtime( MPI_COMM_WORLD );
+    double time = barrier_get_wtime( tester_comm() );
 
     if (verbose >= 1 && mpi_rank == 0)
         printf( "%%-------------------- SLATE run\n" );
@@ -284,7 +284,7 @@ void test_stedc_deflate_work( Params& params, bool run )
     int64_t nU123 = std::max( Qt12_end, Qt23_end )
                   - std::min( Qt12_begin, Qt23_begin );
 
-    params.time() = barrier_get_wtime( MPI_COMM_WORLD ) - time;
+    params.time() = barrier_get_wtime( tester_comm() ) - time;
 
     if (trace)
         slate::trace::Trace::finish();
@@ -331,7 +331,7 @@ void test_stedc_deflate_work( Params& params, bool run )
             //==================================================
             // Run ScaLAPACK reference routine.
             //==================================================
-            time = barrier_get_wtime( MPI_COMM_WORLD );
+            time = barrier_get_wtime( tester_comm() );
 
             scalapack_plaed2(
                 ictxt, &nsecular_ref, n, n1, nb,
@@ -345,7 +345,7 @@ void test_stedc_deflate_work( Params& params, bool run )
                 &pcols_ref[0], &coltype_ref[0], &nU123_ref,
                 &nQt12_ref, &nQt23_ref, &Qt12_begin_ref, &Qt23_begin_ref );
 
-            params.ref_time() = barrier_get_wtime( MPI_COMM_WORLD ) - time;
+            params.ref_time() = barrier_get_wtime( tester_comm() ) - time;
 
             // convert to 1-based
             for (int j = 0; j < n; ++j) {
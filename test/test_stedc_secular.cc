@@ -78,7 +78,7 @@ void test_stedc_secular_work( Params& params, bool run )
 
     // MPI variables
     int mpi_rank, myrow, mycol;
-    MPI_Comm_rank( MPI_COMM_WORLD, &mpi_rank );
+    MPI_Comm_rank( tester_comm(), &mpi_rank );
     gridinfo( mpi_rank, p, q, &myrow, &mycol );
 
     // Matrix U: figure out local size.
@@ -90,13 +90,13 @@ void test_stedc_secular_work( Params& params, bool run )
     slate::Matrix<scalar_t> U;
     if (origin != slate::Origin::ScaLAPACK) {
         U = slate::Matrix<scalar_t>(
-                n, n, nb, p, q, MPI_COMM_WORLD);
+                n, n, nb, p, q, tester_comm());
         U.insertLocalTiles( origin2target( origin ) );
     }
     else {
         U_data.resize( lldU*nlocU );
         U = slate::Matrix<scalar_t>::fromScaLAPACK(
-                n, n, &U_data[0], lldU, nb, p, q, MPI_COMM_WORLD );
+                n, n, &U_data[0], lldU, nb, p, q, tester_comm() );
     }
     slate::set( nan_, U, opts );
 
@@ -116,7 +116,7 @@ void test_stedc_secular_work( Params& params, bool run )
         Lambda_ref.resize( n );
         Uref_data.resize( lldU*nlocU );
         Uref = slate::Matrix<scalar_t>::fromScaLAPACK(
-                   n, n, &Uref_data[0], lldU, nb, p, q, MPI_COMM_WORLD );
+                   n, n, &Uref_data[0], lldU, nb, p, q, tester_comm() );
     }
 
     // Set itype to identity permutation, 0..n-1.
@@ -164,7 +164,7 @@ void test_stedc_secular_work( Params& params, bool run )
     if (trace)
         slate::trace::Trace::on();
 
-    double time = barrier_get_wtime( MPI_COMM_WORLD );
+    double time = barrier_get_wtime( tester_comm() );
 
     //==================================================
     // Run SLATE test.
@@ -173,7 +173,7 @@ void test_stedc_secular_work( Params& params, bool run )
                           &D[0], &z[0], &Lambda[0],
                           U, &itype[0], opts );
 
-    params.time() = barrier_get_wtime( MPI_COMM_WORLD ) - time;
+    params.time() = barrier_get_wtime( tester_comm() ) - time;
 
     if (trace)
         slate::trace::Trace::finish();
@@ -185,7 +185,7 @@ void test_stedc_secular_work( Params& params, bool run )
             print_vector( "Lambda", Lambda, params );
         }
         print_matrix( "U", U, params );
-        MPI_Barrier( MPI_COMM_WORLD );
+        MPI_Barrier( tester_comm() );
     }
 
     if (ref) {
@@ -240,7 +240,7 @@ void test_stedc_secular_work( Params& params, bool run )
             //==================================================
             // Run ScaLAPACK reference routine.
             //==================================================
-            time = barrier_get_wtime( MPI_COMM_WORLD );
+            time = barrier_get_wtime( tester_comm() );
 
             scalapack_plaed3(
                 ictxt, nsecular, n, nb,
@@ -251,7 +251,7 @@ void test_stedc_secular_work( Params& params, bool run )
                 &ct_count_ref[0], q, &info );
             assert( info == 0 );
 
-            params.ref_time() = barrier_get_wtime( MPI_COMM_WORLD ) - time;
+            params.ref_time() = barrier_get_wtime( tester_comm() ) - time;
 
             if (verbose >= 1 && mpi_rank == 0) {
                 print_vector( "D      ", D, params );
@@ -287,7 +287,7 @@ void test_stedc_secular_work( Params& params, bool run )
                              / blas::nrm2( n, &Lambda_ref[0], 1 );
 
             // orthogonality error = || U^H U - I || / n
-            slate::Matrix<scalar_t> R( n, n, nb, p, q, MPI_COMM_WORLD );
+            slate::Matrix<scalar_t> R( n, n, nb, p, q, tester_comm() );
             R.insertLocalTiles();
             slate::set( zero, one, R, opts );  // R = Identity
             auto UH = conj_transpose( U );
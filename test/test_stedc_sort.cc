@@ -61,7 +61,7 @@ void test_stedc_sort_work( Params& params, bool run )
 
     // MPI variables
     int mpi_rank, myrow, mycol;
-    MPI_Comm_rank( MPI_COMM_WORLD, &mpi_rank );
+    MPI_Comm_rank( tester_comm(), &mpi_rank );
     gridinfo( mpi_rank, p, q, &myrow, &mycol );
 
     // Initialize eigenvalues.
@@ -81,13 +81,13 @@ void test_stedc_sort_work( Params& params, bool run )
     std::vector<scalar_t> Z_data, Zref_data;
     if (origin != slate::Origin::ScaLAPACK) {
         Z = slate::Matrix<scalar_t>(
-                n, n, nb, p, q, MPI_COMM_WORLD);
+                n, n, nb, p, q, tester_comm());
         Z.insertLocalTiles( origin2target( origin ) );
     }
     else {
         Z_data.resize( lldZ*nlocZ );
         Z = slate::Matrix<scalar_t>::fromScaLAPACK(
-                n, n, &Z_data[0], lldZ, nb, p, q, MPI_COMM_WORLD );
+                n, n, &Z_data[0], lldZ, nb, p, q, tester_comm() );
     }
     slate::generate_matrix( params.matrix, Z );
 
@@ -110,7 +110,7 @@ void test_stedc_sort_work( Params& params, bool run )
     if (ref) {
         Zref_data.resize( lldZ*nlocZ );
         Zref = slate::Matrix<scalar_t>::fromScaLAPACK(
-                   n, n, &Zref_data[0], lldZ, nb, p, q, MPI_COMM_WORLD );
+                   n, n, &Zref_data[0], lldZ, nb, p, q, tester_comm() );
         slate::copy( Z, Zref, opts );
     }
 
@@ -126,14 +126,14 @@ void test_stedc_sort_work( Params& params, bool run )
     if (trace)
         slate::trace::Trace::on();
 
-    double time = barrier_get_wtime( MPI_COMM_WORLD );
+    double time = barrier_get_wtime( tester_comm() );
 
     //==================================================
     // Run SLATE test.
     //==================================================
     slate::stedc_sort( D, Z, Zout, opts );
 
-    params.time() = barrier_get_wtime( MPI_COMM_WORLD ) - time;
+    params.time() = barrier_get_wtime( tester_comm() ) - time;
 
     if (trace)
         slate::trace::Trace::finish();
@@ -171,14 +171,14 @@ void test_stedc_sort_work( Params& params, bool run )
             //==================================================
             // Run ScaLAPACK reference routine.
             //==================================================
-            time = barrier_get_wtime( MPI_COMM_WORLD );
+            time = barrier_get_wtime( tester_comm() );
 
             scalapack_plasrt( "i", n, &Dref[0],
                               &Zref_data[0], 1, 1, Zref_desc,
                               &work[0], lwork, &iwork[0], liwork, &info );
             slate_assert( info == 0 );
 
-            params.ref_time() = barrier_get_wtime( MPI_COMM_WORLD ) - time;
+            params.ref_time() = barrier_get_wtime( tester_comm() ) - time;
 
             if (mpi_rank == 0) {
                 print_vector( "Dref_out", Dref, params );
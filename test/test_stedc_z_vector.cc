@@ -57,7 +57,7 @@ void test_stedc_z_vector_work( Params& params, bool run )
 
     // MPI variables
     int mpi_rank, myrow, mycol;
-    MPI_Comm_rank( MPI_COMM_WORLD, &mpi_rank );
+    MPI_Comm_rank( tester_comm(), &mpi_rank );
     gridinfo( mpi_rank, p, q, &myrow, &mycol );
 
     // Matrix Q: figure out local size.
@@ -69,13 +69,13 @@ void test_stedc_z_vector_work( Params& params, bool run )
     slate::Matrix<scalar_t> Q;
     if (origin != slate::Origin::ScaLAPACK) {
         Q = slate::Matrix<scalar_t>(
-                n, n, nb, p, q, MPI_COMM_WORLD);
+                n, n, nb, p, q, tester_comm());
         Q.insertLocalTiles( origin2target( origin ) );
     }
     else {
         Q_data.resize( lldQ*nlocQ );
         Q = slate::Matrix<scalar_t>::fromScaLAPACK(
-                n, n, &Q_data[0], lldQ, nb, p, q, MPI_COMM_WORLD );
+                n, n, &Q_data[0], lldQ, nb, p, q, tester_comm() );
     }
     slate::set( zero, Q, opts );
     int64_t nt = Q.nt();
@@ -94,7 +94,7 @@ void test_stedc_z_vector_work( Params& params, bool run )
     if (check || ref) {
         Qref_data.resize( lldQ*nlocQ );
         Qref = slate::Matrix<scalar_t>::fromScaLAPACK(
-                   n, n, &Qref_data[0], lldQ, nb, p, q, MPI_COMM_WORLD );
+                   n, n, &Qref_data[0], lldQ, nb, p, q, tester_comm() );
         copy( Q, Qref );
     }
 
@@ -104,14 +104,14 @@ void test_stedc_z_vector_work( Params& params, bool run )
     if (trace)
         slate::trace::Trace::on();
 
-    double time = barrier_get_wtime( MPI_COMM_WORLD );
+    double time = barrier_get_wtime( tester_comm() );
 
     //==================================================
     // Run SLATE test.
     //==================================================
     slate::stedc_z_vector( Q, z, opts );
 
-    params.time() = barrier_get_wtime( MPI_COMM_WORLD ) - time;
+    params.time() = barrier_get_wtime( tester_comm() ) - time;
 
     if (trace)
         slate::trace::Trace::finish();
@@ -151,13 +151,13 @@ void test_stedc_z_vector_work( Params& params, bool run )
             //==================================================
             // Run ScaLAPACK reference routine.
             //==================================================
-            time = barrier_get_wtime( MPI_COMM_WORLD );
+            time = barrier_get_wtime( tester_comm() );
 
             scalapack_plaedz( n, n1, 1,
                               &Qref_data[0], 1, 1, lldQ, Q_desc,
                               &zref[0], &work[0] );
 
-            params.ref_time() = barrier_get_wtime( MPI_COMM_WORLD ) - time;
+            params.ref_time() = barrier_get_wtime( tester_comm() ) - time;
 
             if (mpi_rank == 0) {
                 print_vector( "zref_out", zref, params );
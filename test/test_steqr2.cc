@@ -53,7 +53,7 @@ void test_steqr2_work(Params& params, bool run)
 
     // MPI variables
     int mpi_rank, myrow, mycol;
-    MPI_Comm_rank(MPI_COMM_WORLD, &mpi_rank);
+    MPI_Comm_rank(tester_comm(), &mpi_rank);
     gridinfo(mpi_rank, p, q, &myrow, &mycol);
 
     // Matrix Z: figure out local size.
@@ -79,7 +79,7 @@ void test_steqr2_work(Params& params, bool run)
 
     slate::Matrix<scalar_t> A; // To check the orth of the eigenvectors
     if (check) {
-        A = slate::Matrix<scalar_t>(n, n, nb, p, q, MPI_COMM_WORLD);
+        A = slate::Matrix<scalar_t>(n, n, nb, p, q, tester_comm());
         A.insertLocalTiles();
     }
 
@@ -87,7 +87,7 @@ void test_steqr2_work(Params& params, bool run)
     if (origin != slate::Origin::ScaLAPACK) {
         if (wantz) {
             Z = slate::Matrix<scalar_t>(
-                    n, n, nb, p, q, MPI_COMM_WORLD);
+                    n, n, nb, p, q, tester_comm());
             Z.insertLocalTiles(origin2target(origin));
         }
     }
@@ -95,13 +95,13 @@ void test_steqr2_work(Params& params, bool run)
         if (wantz) {
             Z_data.resize(lldZ*nlocZ);
             Z = slate::Matrix<scalar_t>::fromScaLAPACK(
-                    n, n, &Z_data[0], lldZ, nb, p, q, MPI_COMM_WORLD);
+                    n, n, &Z_data[0], lldZ, nb, p, q, tester_comm());
         }
     }
     if (trace) slate::trace::Trace::on();
     else slate::trace::Trace::off();
 
-    double time = barrier_get_wtime(MPI_COMM_WORLD);
+    double time = barrier_get_wtime(tester_comm());
 
     //==================================================
     // Run SLATE test.
@@ -109,7 +109,7 @@ void test_steqr2_work(Params& params, bool run)
     //slate::sterf(D, E);
     steqr2(jobz, D, E, Z);
 
-    params.time() = barrier_get_wtime(MPI_COMM_WORLD) - time;
+    params.time() = barrier_get_wtime(tester_comm()) - time;
 
     if (trace)
         slate::trace::Trace::finish();
@@ -128,11 +128,11 @@ void test_steqr2_work(Params& params, bool run)
         //==================================================
         // Run LAPACK reference routine.
         //==================================================
-        time = barrier_get_wtime(MPI_COMM_WORLD);
+        time = barrier_get_wtime(tester_comm());
 
         lapack::sterf(n, &Dref[0], &Eref[0]);
 
-        params.ref_time() = barrier_get_wtime(MPI_COMM_WORLD) - time;
+        params.ref_time() = barrier_get_wtime(tester_comm()) - time;
 
         if (mpi_rank == 0) {
             print_vector( "Dref_out", Dref, params );
@@ -42,7 +42,7 @@ void test_sterf_work(Params& params, bool run)
 
     // MPI variables
     int mpi_rank, myrow, mycol;
-    MPI_Comm_rank(MPI_COMM_WORLD, &mpi_rank);
+    MPI_Comm_rank(tester_comm(), &mpi_rank);
     gridinfo(mpi_rank, p, q, &myrow, &mycol);
 
     std::vector<real_t> D(n), E(n - 1);
@@ -65,14 +65,14 @@ void test_sterf_work(Params& params, bool run)
     if (trace) slate::trace::Trace::on();
     else slate::trace::Trace::off();
 
-    double time = barrier_get_wtime(MPI_COMM_WORLD);
+    double time = barrier_get_wtime(tester_comm());
 
     //==================================================
     // Run SLATE test.
     //==================================================
     slate::sterf(D, E);
 
-    params.time() = barrier_get_wtime(MPI_COMM_WORLD) - time;
+    params.time() = barrier_get_wtime(tester_comm()) - time;
 
     if (trace)
         slate::trace::Trace::finish();
@@ -85,14 +85,14 @@ void test_sterf_work(Params& params, bool run)
         //==================================================
         // Test results
         //==================================================
-        time = barrier_get_wtime(MPI_COMM_WORLD);
+        time = barrier_get_wtime(tester_comm());
 
         //==================================================
         // Run LAPACK reference routine.
         //==================================================
         lapack::sterf(n, &Dref[0], &Eref[0]);
 
-        params.ref_time() = barrier_get_wtime(MPI_COMM_WORLD) - time;
+        params.ref_time() = barrier_get_wtime(tester_comm()) - time;
 
         if (mpi_rank == 0) {
             print_vector( "Dref_out", Dref, params );
@@ -47,6 +47,7 @@ void test_svd_work( Params& params, bool run )
     int timer_level = params.timer_level();
     slate::Origin origin = params.origin();
     slate::Target target = params.target();
+    slate::MethodSVD method_svd = params.method_svd();
     params.matrix.mark();
 
     mark_params_for_test_Matrix( params );
@@ -102,13 +103,14 @@ void test_svd_work( Params& params, bool run )
 
     // MPI variables
     int mpi_rank;
-    MPI_Comm_rank( MPI_COMM_WORLD, &mpi_rank );
+    MPI_Comm_rank( tester_comm(), &mpi_rank );
 
     slate::Options const opts =  {
         {slate::Option::Lookahead, lookahead},
         {slate::Option::Target, target},
         {slate::Option::MaxPanelThreads, panel_threads},
-        {slate::Option::InnerBlocking, ib}
+        {slate::Option::InnerBlocking, ib},
+        {slate::Option::MethodSVD, method_svd},
     };
 
     bool wantu  = (jobu  == slate::Job::Vec
@@ -152,7 +154,8 @@ void test_svd_work( Params& params, bool run )
     //params.matrix.kind.set_default("svd");
     //params.matrix.cond.set_default(1.e16);
 
-    slate::generate_matrix( params.matrix, A);
+    slate::Options matgen_opts = {{slate::Option::Target, target}};
+    slate::generate_matrix( params.matrix, A, matgen_opts );
     print_matrix( "A",  A, params );
 
     std::vector<real_t> Sigma_ref;
@@ -166,7 +169,7 @@ void test_svd_work( Params& params, bool run )
         if (trace) slate::trace::Trace::on();
         else slate::trace::Trace::off();
 
-        double time = barrier_get_wtime(MPI_COMM_WORLD);
+        double time = barrier_get_wtime(tester_comm());
 
         //==================================================
         // Run SLATE test.
@@ -178,7 +181,7 @@ void test_svd_work( Params& params, bool run )
             slate::svd_vals( A, Sigma, opts );
         }
 
-        time = barrier_get_wtime(MPI_COMM_WORLD) - time;
+        time = barrier_get_wtime(tester_comm()) - time;
 
         if (trace) slate::trace::Trace::finish();
 
@@ -342,7 +345,7 @@ void test_svd_work( Params& params, bool run )
             //==================================================
             // Run ScaLAPACK reference routine.
             //==================================================
-            double time = barrier_get_wtime(MPI_COMM_WORLD);
+            double time = barrier_get_wtime(tester_comm());
             scalapack_pgesvd(
                 jobu_str, jobvt_str, m, n,
                 &Aref_data[0],  1, 1, A_desc, &Sigma_ref[0],
@@ -350,7 +353,7 @@ void test_svd_work( Params& params, bool run )
                 &VT_data[0], 1, 1, VT_desc,
                 &work[0], lwork, &rwork[0], &info_ref );
             slate_assert(info_ref == 0);
-            time = barrier_get_wtime(MPI_COMM_WORLD) - time;
+            time = barrier_get_wtime(tester_comm()) - time;
 
             params.ref_time() = time;
 
@@ -0,0 +1,222 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/slate.hh"
+#include "test.hh"
+#include "print_matrix.hh"
+
+#include "matrix_utils.hh"
+#include "test_utils.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <utility>
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void test_svd_rand_work( Params& params, bool run )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // Constants
+    const scalar_t zero = 0;
+    const scalar_t one  = 1;
+
+    // get & mark input values
+    lapack::Job jobu = params.jobu();
+    lapack::Job jobvt = params.jobvt();
+    int64_t m = params.dim.m();
+    int64_t n = params.dim.n();
+    int64_t k = params.dim.k();
+    int64_t oversample = params.oversample();
+    int64_t power_iters = params.power_iters();
+    int64_t ib = params.ib();
+    int64_t panel_threads = params.panel_threads();
+    int64_t lookahead = params.lookahead();
+    bool ref_only = params.ref() == 'o';
+    bool check = params.check() == 'y' && ! ref_only;
+    bool trace = params.trace() == 'y';
+    slate::Target target = params.target();
+    params.matrix.mark();
+
+    mark_params_for_test_Matrix( params );
+    params.nonuniform_nb.used( false );
+
+    params.time();
+    params.ref_time();
+    params.ortho_U();
+    params.ortho_V();
+    params.error.name( "S - Sref" );
+    params.ref_time.name( "svd (s)" );
+
+    if (! run) {
+        // The randomized SVD needs a decaying spectrum to be accurate.
+        params.matrix.kind.set_default( "svd_geo" );
+        return;
+    }
+
+    // Check for common invalid combinations
+    if (is_invalid_parameters( params )) {
+        return;
+    }
+
+    int64_t min_mn = std::min( m, n );
+    if (k > min_mn) {
+        params.msg() = "skipping: requires k <= min( m, n )";
+        return;
+    }
+
+    slate::Options const opts =  {
+        {slate::Option::Lookahead, lookahead},
+        {slate::Option::Target, target},
+        {slate::Option::MaxPanelThreads, panel_threads},
+        {slate::Option::InnerBlocking, ib},
+        {slate::Option::Oversampling, oversample},
+        {slate::Option::PowerIterations, power_iters},
+    };
+
+    bool wantu  = jobu  != slate::Job::NoVec;
+    bool wantvt = jobvt != slate::Job::NoVec;
+
+    std::vector<real_t> Sigma( k );
+
+    auto A_alloc = allocate_test_Matrix<scalar_t>( check, true, m, n, params );
+    auto U_alloc = allocate_test_Matrix<scalar_t>(
+        false, true, (wantu ? m : 0), (wantu ? k : 0), params );
+    auto VT_alloc = allocate_test_Matrix<scalar_t>(
+        false, true, (wantvt ? k : 0), (wantvt ? n : 0), params );
+
+    auto& A  = A_alloc.A;
+    auto& U  = U_alloc.A;
+    auto& VT = VT_alloc.A;
+
+    real_t tol = params.tol() * 0.5 * std::numeric_limits<real_t>::epsilon();
+
+    slate::generate_matrix( params.matrix, A );
+    print_matrix( "A", A, params );
+
+    if (check)
+        slate::copy( A, A_alloc.Aref );
+
+    if (! ref_only) {
+        if (trace) slate::trace::Trace::on();
+        else slate::trace::Trace::off();
+
+        double time = barrier_get_wtime( tester_comm() );
+
+        //==================================================
+        // Run SLATE test.
+        //==================================================
+        slate::svd_rand( A, k, Sigma, U, VT, opts );
+
+        time = barrier_get_wtime( tester_comm() ) - time;
+
+        if (trace) slate::trace::Trace::finish();
+
+        params.time() = time;
+
+        if (A.mpiRank() == 0)
+            print_vector( "Sigma", Sigma, params );
+        if (wantu)
+            print_matrix( "U", U, params );
+        if (wantvt)
+            print_matrix( "VT", VT, params );
+    }
+
+    if (check) {
+        params.okay() = true;
+
+        auto R_alloc = allocate_test_Matrix<scalar_t>( false, true, k, k, params );
+        auto& R = R_alloc.A;
+
+        if (wantu) {
+            //==================================================
+            // Test results by checking orthogonality of U
+            //
+            //      || I - U^H U ||_1
+            //     ------------------- < tol * epsilon
+            //              k
+            //==================================================
+            slate::set( zero, one, R );
+            auto UH = conj_transpose( U );
+            slate::gemm( -one, UH, U, one, R );
+            params.ortho_U() = slate::norm( slate::Norm::One, R ) / k;
+            params.okay() = params.okay() && (params.ortho_U() <= tol);
+        }
+
+        if (wantvt) {
+            //==================================================
+            // Test results by checking orthogonality of V
+            //
+            //      || I - V^H V ||_1
+            //     ------------------- < tol * epsilon
+            //              k
+            //==================================================
+            slate::set( zero, one, R );
+            auto V = conj_transpose( VT );
+            slate::gemm( -one, VT, V, one, R );
+            params.ortho_V() = slate::norm( slate::Norm::One, R ) / k;
+            params.okay() = params.okay() && (params.ortho_V() <= tol);
+        }
+
+        //==================================================
+        // Compare with the singular values from svd.
+        // The error is bounded by || A - Q Q^H A ||, which is near
+        // sigma_{k+1} for a decaying spectrum, so check
+        //
+        //      max_i | Sigma_i - Sigma_ref_i |
+        //     --------------------------------- < 10 sigma_{k+1} / sigma_1
+        //                 sigma_1                   + tol * epsilon
+        //==================================================
+        std::vector<real_t> Sigma_ref( min_mn );
+        double time = barrier_get_wtime( tester_comm() );
+        slate::svd_vals( A_alloc.Aref, Sigma_ref, opts );
+        params.ref_time() = barrier_get_wtime( tester_comm() ) - time;
+        std::sort( Sigma_ref.begin(), Sigma_ref.end(), std::greater<real_t>() );
+
+        real_t max_diff = 0;
+        for (int64_t i = 0; i < k; ++i)
+            max_diff = std::max( max_diff, std::abs( Sigma[ i ] - Sigma_ref[ i ] ) );
+        real_t sigma_1 = Sigma_ref[ 0 ];
+        real_t sigma_k1 = k < min_mn ? Sigma_ref[ k ] : 0;
+        if (sigma_1 > 0) {
+            params.error() = max_diff / sigma_1;
+            params.okay() = params.okay()
+                && (params.error() <= 10 * sigma_k1 / sigma_1 + tol);
+        }
+        else {
+            params.error() = max_diff;
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+void test_svd_rand( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Single:
+            test_svd_rand_work<float>( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_svd_rand_work<double>( params, run );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_svd_rand_work<std::complex<float>>( params, run );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_svd_rand_work<std::complex<double>>( params, run );
+            break;
+
+        default:
+            throw std::runtime_error( "unknown datatype" );
+            break;
+    }
+}
@@ -141,7 +141,7 @@ void test_syrk_work(Params& params, bool run)
         slate::multiply( alpha, opA, Z, one, Y, opts );
     }
 
-    double time = barrier_get_wtime( MPI_COMM_WORLD );
+    double time = barrier_get_wtime( tester_comm() );
 
     //==================================================
     // Run SLATE test.
@@ -151,7 +151,7 @@ void test_syrk_work(Params& params, bool run)
     // Using traditional BLAS/LAPACK name
     // slate::syrk(alpha, A, beta, C, opts);
 
-    time = barrier_get_wtime( MPI_COMM_WORLD ) - time;
+    time = barrier_get_wtime( tester_comm() ) - time;
 
     if (trace) slate::trace::Trace::finish();
 
@@ -208,11 +208,11 @@ void test_syrk_work(Params& params, bool run)
             //==================================================
             // Run ScaLAPACK reference routine.
             //==================================================
-            time = barrier_get_wtime( MPI_COMM_WORLD );
+            time = barrier_get_wtime( tester_comm() );
             scalapack_psyrk(to_c_string( uplo ), to_c_string( transA ), n, k, alpha,
                             &A_data[0], 1, 1, A_desc, beta,
                             &Cref_data[0], 1, 1, Cref_desc);
-            time = barrier_get_wtime( MPI_COMM_WORLD ) - time;
+            time = barrier_get_wtime( tester_comm() ) - time;
 
             // get differences C = C - Cref
             slate::add(-one, Cref, one, C);
@@ -68,7 +68,7 @@ void test_tb2bd_work(Params& params, bool run)
 
     // MPI variables
     int mpi_rank, myrow, mycol;
-    MPI_Comm_rank(MPI_COMM_WORLD, &mpi_rank);
+    MPI_Comm_rank(tester_comm(), &mpi_rank);
     gridinfo(mpi_rank, p, q, &myrow, &mycol);
 
     int64_t lda = n;
@@ -93,12 +93,12 @@ void test_tb2bd_work(Params& params, bool run)
     }
 
     auto Afull = slate::Matrix<scalar_t>::fromLAPACK(
-        n, n, &Afull_data[0], lda, nb, p, q, MPI_COMM_WORLD);
+        n, n, &Afull_data[0], lda, nb, p, q, tester_comm());
 
     // Copy band of Afull, currently to rank 0.
     auto Aband = slate::TriangularBandMatrix<scalar_t>(
         slate::Uplo::Upper, slate::Diag::NonUnit, n, ku, nb,
-        1, 1, MPI_COMM_WORLD);
+        1, 1, tester_comm());
     Aband.insertLocalTiles();
     Aband.ge2tbGather( Afull );
 
@@ -109,20 +109,20 @@ void test_tb2bd_work(Params& params, bool run)
     slate::Matrix<scalar_t> U, U1d, VT, V1d;
     // Create U and U1d. Set U to Identity.
     if (wantu) {
-        U = slate::Matrix<scalar_t>(n, n, nb, p, q, MPI_COMM_WORLD);
+        U = slate::Matrix<scalar_t>(n, n, nb, p, q, tester_comm());
         U.insertLocalTiles(origin_target);
         set(zero, one, U);
-        U1d = slate::Matrix<scalar_t>(U.m(), U.n(), U.tileNb(0), 1, p*q, MPI_COMM_WORLD);
+        U1d = slate::Matrix<scalar_t>(U.m(), U.n(), U.tileNb(0), 1, p*q, tester_comm());
         U1d.insertLocalTiles(origin_target);
     }
 
     // Create VT and V1d. Set VT to Identity.
     if (wantvt) {
-        VT = slate::Matrix<scalar_t>(n, n, nb, p, q, MPI_COMM_WORLD);
+        VT = slate::Matrix<scalar_t>(n, n, nb, p, q, tester_comm());
         VT.insertLocalTiles(origin_target);
         set(zero, one, VT);
         // 1-d V matrix
-        V1d = slate::Matrix<scalar_t>(VT.m(), VT.n(), VT.tileNb(0), 1, p*q, MPI_COMM_WORLD);
+        V1d = slate::Matrix<scalar_t>(VT.m(), VT.n(), VT.tileNb(0), 1, p*q, tester_comm());
         V1d.insertLocalTiles(origin_target);
     }
 
@@ -133,8 +133,8 @@ void test_tb2bd_work(Params& params, bool run)
     int64_t vm = 2*nb;
     int64_t nt = Afull.nt();
     int64_t vn = nt*(nt + 1)/2*nb;
-    slate::Matrix<scalar_t> V2(vm, vn, vm, nb, 1, 1, MPI_COMM_WORLD);
-    slate::Matrix<scalar_t> U2(vm, vn, vm, nb, 1, 1, MPI_COMM_WORLD);
+    slate::Matrix<scalar_t> V2(vm, vn, vm, nb, 1, 1, tester_comm());
+    slate::Matrix<scalar_t> U2(vm, vn, vm, nb, 1, 1, tester_comm());
 
     if (check && mpi_rank == 0) {
         //==================================================
@@ -151,7 +151,7 @@ void test_tb2bd_work(Params& params, bool run)
     if (trace) slate::trace::Trace::on();
     else slate::trace::Trace::off();
 
-    double time = barrier_get_wtime(MPI_COMM_WORLD);
+    double time = barrier_get_wtime(tester_comm());
 
     //==================================================
     // Run SLATE test.
@@ -163,7 +163,7 @@ void test_tb2bd_work(Params& params, bool run)
         slate::tb2bd(Aband, U2, V2);
     }
 
-    time = barrier_get_wtime(MPI_COMM_WORLD) - time;
+    time = barrier_get_wtime(tester_comm()) - time;
     params.time() = time;
 
     if (trace) slate::trace::Trace::finish();
@@ -219,8 +219,8 @@ void test_tb2bd_work(Params& params, bool run)
             // Copy diagonal & super-diagonal.
             // todo: we can use the following three lines to copy E and D to all ranks.:
             //slate::internal::copytb2bd(Aband, Sigma, E);
-            //MPI_Bcast( &Sigma[0], n, mpi_real_type, 0, MPI_COMM_WORLD );
-            //MPI_Bcast( &E[0], n-1, mpi_real_type, 0, MPI_COMM_WORLD );
+            //MPI_Bcast( &Sigma[0], n, mpi_real_type, 0, tester_comm() );
+            //MPI_Bcast( &E[0], n-1, mpi_real_type, 0, tester_comm() );
             int64_t D_index = 0;
             int64_t E_index = 0;
             for (int64_t i = 0; i < std::min(Aband.mt(), Aband.nt()); ++i) {
@@ -265,7 +265,7 @@ void test_tb2bd_work(Params& params, bool run)
             // Test results orthogonality of U.
             // || I - U^H U || / n < tol
             //==================================================
-            slate::Matrix<scalar_t> Iden( n, n, nb, p, q, MPI_COMM_WORLD );
+            slate::Matrix<scalar_t> Iden( n, n, nb, p, q, tester_comm() );
             Iden.insertLocalTiles(origin_target);
             set(zero, one, Iden);
             if (wantu) {
@@ -88,7 +88,7 @@ void test_tbsm_work(Params& params, bool run)
 
     // MPI variables
     int mpi_rank, myrow, mycol;
-    MPI_Comm_rank(MPI_COMM_WORLD, &mpi_rank);
+    MPI_Comm_rank(tester_comm(), &mpi_rank);
     gridinfo(mpi_rank, p, q, &myrow, &mycol);
 
     // Matrix A: figure out local size.
@@ -105,17 +105,17 @@ void test_tbsm_work(Params& params, bool run)
 
     // create SLATE matrices from the ScaLAPACK layouts
     auto Aref = slate::Matrix<scalar_t>::fromScaLAPACK(
-                    Am, An, &A_data[0], lldA, nb, p, q, MPI_COMM_WORLD );
+                    Am, An, &A_data[0], lldA, nb, p, q, tester_comm() );
 
     slate::generate_matrix(params.matrix, Aref);
     zeroOutsideBand(&A_data[0], Am, An, kd, kd, nb, nb, myrow, mycol, p, q, mlocA);
 
     auto Aband = BandFromScaLAPACK(
-                     Am, An, kd, kd, &A_data[0], lldA, nb, p, q, MPI_COMM_WORLD);
+                     Am, An, kd, kd, &A_data[0], lldA, nb, p, q, tester_comm());
 
     auto A = slate::TriangularBandMatrix<scalar_t>(uplo, diag, Aband);
     auto B = slate::Matrix<scalar_t>::fromScaLAPACK(
-                 Bm, Bn, &B_data[0], lldB, nb, p, q, MPI_COMM_WORLD);
+                 Bm, Bn, &B_data[0], lldB, nb, p, q, tester_comm());
     slate::Pivots pivots;
 
     slate::generate_matrix(params.matrixB, B);
@@ -168,7 +168,7 @@ void test_tbsm_work(Params& params, bool run)
     if (trace) slate::trace::Trace::on();
     else slate::trace::Trace::off();
 
-    double time = barrier_get_wtime(MPI_COMM_WORLD);
+    double time = barrier_get_wtime(tester_comm());
 
     //==================================================
     // Run SLATE test.
@@ -183,7 +183,7 @@ void test_tbsm_work(Params& params, bool run)
     // Using traditional BLAS/LAPACK name
     // slate::tbsm(side, alpha, A, pivots, B, opts);
 
-    time = barrier_get_wtime(MPI_COMM_WORLD) - time;
+    time = barrier_get_wtime(tester_comm()) - time;
 
     if (trace) slate::trace::Trace::finish();
 
@@ -234,18 +234,18 @@ void test_tbsm_work(Params& params, bool run)
             real_t B_orig_norm = scalapack_plange(to_c_string( norm ), Bm, Bn, &B_data[0], 1, 1, B_desc, &worklange[0]);
 
             auto Bref = slate::Matrix<scalar_t>::fromScaLAPACK(
-                        Bm, Bn, &Bref_data[0], lldB, nb, p, q, MPI_COMM_WORLD);
+                        Bm, Bn, &Bref_data[0], lldB, nb, p, q, tester_comm());
             print_matrix("Bref", Bref, params);
             //==================================================
             // Run ScaLAPACK reference routine.
             // Note this is on a FULL matrix, so ignore reference performance!
             //==================================================
-            time = barrier_get_wtime(MPI_COMM_WORLD);
+            time = barrier_get_wtime(tester_comm());
             scalapack_ptrsm(to_c_string( side ), to_c_string( uplo ), to_c_string( transA ), to_c_string( diag ),
                             m, n, alpha,
                             &A_data[0], 1, 1, A_desc,
                             &Bref_data[0], 1, 1, Bref_desc);
-            time = barrier_get_wtime(MPI_COMM_WORLD) - time;
+            time = barrier_get_wtime(tester_comm()) - time;
 
             print_matrix( "Bref_out", Bref, params );
 
@@ -81,7 +81,7 @@ void test_trcondest_work(Params& params, bool run)
 
     // MPI variables
     int mpi_rank, myrow, mycol;
-    MPI_Comm_rank(MPI_COMM_WORLD, &mpi_rank);
+    MPI_Comm_rank(tester_comm(), &mpi_rank);
     gridinfo( mpi_rank, grid_order, p, q, &myrow, &mycol );
 
     slate::Options const opts =  {
@@ -102,14 +102,14 @@ void test_trcondest_work(Params& params, bool run)
         // SLATE allocates CPU or GPU tiles.
         slate::Target origin_target = origin2target(origin);
         A = slate::Matrix<scalar_t>(
-                m, n,    nb, p, q, MPI_COMM_WORLD );
+                m, n,    nb, p, q, tester_comm() );
         A.insertLocalTiles(origin_target);
     }
     else {
         // Create SLATE matrix from the ScaLAPACK layouts
         A_data.resize( lldA * nlocA );
         A = slate::Matrix<scalar_t>::fromScaLAPACK(
-            m, n, &A_data[0], lldA, nb, nb, grid_order, p, q, MPI_COMM_WORLD );
+            m, n, &A_data[0], lldA, nb, nb, grid_order, p, q, tester_comm() );
     }
 
     slate::generate_matrix(params.matrix,  A);
@@ -124,7 +124,7 @@ void test_trcondest_work(Params& params, bool run)
         Aref_data.resize( lldA* nlocA );
         Aref = slate::Matrix<scalar_t>::fromScaLAPACK(
                 m, n, &Aref_data[0], lldA, nb, nb,
-                grid_order, p, q, MPI_COMM_WORLD );
+                grid_order, p, q, tester_comm() );
 
         slate::copy(A, Aref);
     }
@@ -149,7 +149,7 @@ void test_trcondest_work(Params& params, bool run)
         // slate::geqrf(A, T, opts);
         // compute and save timing/performance
 
-        double time = barrier_get_wtime(MPI_COMM_WORLD);
+        double time = barrier_get_wtime(tester_comm());
         auto R  = slate::TriangularMatrix<scalar_t>(
             slate::Uplo::Upper, slate::Diag::NonUnit, A );
 
@@ -157,7 +157,7 @@ void test_trcondest_work(Params& params, bool run)
         slate_rcond = slate::triangular_rcondest( norm, R, Rnorm, opts );
         // Using traditional BLAS/LAPACK name
         // slate_rcond = slate::trcondest( norm, R, Rnorm, opts );
-        time = barrier_get_wtime(MPI_COMM_WORLD) - time;
+        time = barrier_get_wtime(tester_comm()) - time;
         // compute and save timing/performance
         params.time() = time;
         params.gflops() = gflop / time;
@@ -240,13 +240,13 @@ void test_trcondest_work(Params& params, bool run)
             std::vector<scalar_t> work_trcon(lwork_trcon);
             std::vector<blas_int> iwork( liwork );
 
-            double time = barrier_get_wtime(MPI_COMM_WORLD);
+            double time = barrier_get_wtime(tester_comm());
             scalapack_ptrcon( to_c_string( norm ), to_c_string( uplo ), to_c_string( diag ), n,
                               &Aref_data[0], 1, 1, Aref_desc,
                               &scl_rcond, &work_trcon[0], lwork, &iwork[0], liwork,
                               info_ref_trcon);
             slate_assert(info_ref_trcon == 0);
-            time = barrier_get_wtime(MPI_COMM_WORLD) - time;
+            time = barrier_get_wtime(tester_comm()) - time;
 
             params.ref_time() = time;
             params.ref_gflops() = gflop / time;
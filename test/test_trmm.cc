@@ -158,7 +158,7 @@ void test_trmm_work(Params& params, bool run)
     if (trace) slate::trace::Trace::on();
     else slate::trace::Trace::off();
 
-    double time = barrier_get_wtime(MPI_COMM_WORLD);
+    double time = barrier_get_wtime(tester_comm());
 
     //==================================================
     // Run SLATE test.
@@ -173,7 +173,7 @@ void test_trmm_work(Params& params, bool run)
     // Using traditional BLAS/LAPACK name
     // slate::trmm(side, alpha, A, B, opts);
 
-    time = barrier_get_wtime(MPI_COMM_WORLD) - time;
+    time = barrier_get_wtime(tester_comm()) - time;
 
     if (trace) slate::trace::Trace::finish();
 
@@ -230,12 +230,12 @@ void test_trmm_work(Params& params, bool run)
             //==================================================
             // Run ScaLAPACK reference routine.
             //==================================================
-            time = barrier_get_wtime(MPI_COMM_WORLD);
+            time = barrier_get_wtime(tester_comm());
             scalapack_ptrmm(to_c_string( side ), to_c_string( uplo ), to_c_string( transA ), to_c_string( diag ),
                             m, n, alpha,
                             &A_data[0], 1, 1, A_desc,
                             &Bref_data[0], 1, 1, Bref_desc);
-            time = barrier_get_wtime(MPI_COMM_WORLD) - time;
+            time = barrier_get_wtime(tester_comm()) - time;
 
             // get differences B = B - Bref
             slate::add(-one, Bref, one, B);
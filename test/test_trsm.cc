@@ -36,6 +36,8 @@ void test_trsm_work(Params& params, bool run)
         params.method_trsm() = slate::MethodTrsm::A;
     else if (params.routine == "trsmB")
         params.method_trsm() = slate::MethodTrsm::B;
+    else if (params.routine == "trsmInv")
+        params.method_trsm() = slate::MethodTrsm::Inv;
 
     // get & mark input values
     slate::Side side = params.side();
@@ -130,7 +132,7 @@ void test_trsm_work(Params& params, bool run)
     if (trace) slate::trace::Trace::on();
     else slate::trace::Trace::off();
 
-    double time = barrier_get_wtime(MPI_COMM_WORLD);
+    double time = barrier_get_wtime(tester_comm());
 
     //==================================================
     // Run SLATE test.
@@ -147,7 +149,7 @@ void test_trsm_work(Params& params, bool run)
     // Using traditional BLAS/LAPACK name
     // slate::trsm(side, alpha, A, B, opts);
 
-    time = barrier_get_wtime(MPI_COMM_WORLD) - time;
+    time = barrier_get_wtime(tester_comm()) - time;
 
     if (trace) slate::trace::Trace::finish();
 
@@ -208,12 +210,12 @@ void test_trsm_work(Params& params, bool run)
             //==================================================
             // Run ScaLAPACK reference routine.
             //==================================================
-            time = barrier_get_wtime(MPI_COMM_WORLD);
+            time = barrier_get_wtime(tester_comm());
             scalapack_ptrsm(to_c_string( side ), to_c_string( uplo ), to_c_string( transA ), to_c_string( diag ),
                             m, n, alpha,
                             &A_data[0], 1, 1, A_desc,
                             &Bref_data[0], 1, 1, Bref_desc);
-            time = barrier_get_wtime(MPI_COMM_WORLD) - time;
+            time = barrier_get_wtime(tester_comm()) - time;
 
             print_matrix( "Bref", Bref, params );
 
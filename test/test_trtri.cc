@@ -42,6 +42,7 @@ void test_trtri_work(Params& params, bool run)
     bool trace = params.trace() == 'y';
     slate::Origin origin = params.origin();
     slate::Target target = params.target();
+    bool device_stealing = params.device_stealing() == 'y';
     params.matrix.mark();
 
     // mark non-standard output values
@@ -59,12 +60,13 @@ void test_trtri_work(Params& params, bool run)
 
     slate::Options const opts =  {
         {slate::Option::Lookahead, lookahead},
-        {slate::Option::Target, target}
+        {slate::Option::Target, target},
+        {slate::Option::DeviceStealing, device_stealing},
     };
 
     // MPI variables
     int mpi_rank, myrow, mycol;
-    MPI_Comm_rank(MPI_COMM_WORLD, &mpi_rank);
+    MPI_Comm_rank(tester_comm(), &mpi_rank);
     gridinfo(mpi_rank, p, q, &myrow, &mycol);
 
     // Matrix A: figure out local size.
@@ -74,13 +76,13 @@ void test_trtri_work(Params& params, bool run)
     std::vector<scalar_t> A_data(lldA*nlocA);
 
     // todo: work-around to initialize BaseMatrix::num_devices_
-    slate::Matrix<scalar_t> A0(n, n, nb, p, q, MPI_COMM_WORLD);
+    slate::Matrix<scalar_t> A0(n, n, nb, p, q, tester_comm());
 
     // Cholesky factor of AH to get a well conditioned triangular matrix
     // Even when we replace the diagonal with unit diagonal,
     // it seems to still be well conditioned.
     auto AH = slate::HermitianMatrix<scalar_t>::fromScaLAPACK(
-                  uplo, n, &A_data[0], lldA, nb, p, q, MPI_COMM_WORLD);
+                  uplo, n, &A_data[0], lldA, nb, p, q, tester_comm());
     print_matrix( "AH", AH, params );
 
     slate::generate_matrix(params.matrix, AH);
@@ -117,7 +119,7 @@ void test_trtri_work(Params& params, bool run)
     slate::Matrix<scalar_t> C;
     if (check) {
         C = slate::Matrix<scalar_t>::fromScaLAPACK(
-                n, n, &Cchk_data[0], lldA, nb, p, q, MPI_COMM_WORLD);
+                n, n, &Cchk_data[0], lldA, nb, p, q, tester_comm());
     }
 
     // trtri flop count
@@ -128,7 +130,7 @@ void test_trtri_work(Params& params, bool run)
         if (trace) slate::trace::Trace::on();
         else slate::trace::Trace::off();
 
-        double time = barrier_get_wtime(MPI_COMM_WORLD);
+        double time = barrier_get_wtime(tester_comm());
 
         //==================================================
         // Run SLATE test.
@@ -136,7 +138,7 @@ void test_trtri_work(Params& params, bool run)
         // invert and measure time
         slate::trtri(A, opts);
 
-        time = barrier_get_wtime(MPI_COMM_WORLD) - time;
+        time = barrier_get_wtime(tester_comm()) - time;
 
         if (trace) slate::trace::Trace::finish();
 
@@ -188,7 +190,7 @@ void test_trtri_work(Params& params, bool run)
             // Setup full nxn SLATE matrix in Aref on CPU pointing to ScaLAPACK
             // data in Aref_data
             auto Aref = slate::Matrix<scalar_t>::fromScaLAPACK(
-                            n, n, &Aref_data[0], lldA, nb, p, q, MPI_COMM_WORLD);
+                            n, n, &Aref_data[0], lldA, nb, p, q, tester_comm());
             print_matrix( "Aref_", Aref, params );
 
             // Zero out unused opposite lower/upper triangle.
@@ -39,6 +39,7 @@ void test_unmqr_work(Params& params, bool run)
     int64_t ib = params.ib();
     int64_t lookahead = params.lookahead();
     int64_t panel_threads = params.panel_threads();
+    int64_t tree_arity = params.tree_arity();
     bool check = params.check() == 'y';
     bool trace = params.trace() == 'y';
     slate::Origin origin = params.origin();
@@ -61,12 +62,13 @@ void test_unmqr_work(Params& params, bool run)
         {slate::Option::Lookahead, lookahead},
         {slate::Option::Target, target},
         {slate::Option::MaxPanelThreads, panel_threads},
-        {slate::Option::InnerBlocking, ib}
+        {slate::Option::InnerBlocking, ib},
+        {slate::Option::TreeArity, tree_arity}
     };
 
     // MPI variables
     int mpi_rank, myrow, mycol;
-    MPI_Comm_rank(MPI_COMM_WORLD, &mpi_rank);
+    MPI_Comm_rank(tester_comm(), &mpi_rank);
     gridinfo(mpi_rank, p, q, &myrow, &mycol);
 
     // Matrix A: figure out local size.
@@ -79,13 +81,13 @@ void test_unmqr_work(Params& params, bool run)
     if (origin != slate::Origin::ScaLAPACK) {
         // SLATE allocates CPU or GPU tiles.
         slate::Target origin_target = origin2target(origin);
-        A = slate::Matrix<scalar_t>(m, n, nb, p, q, MPI_COMM_WORLD);
+        A = slate::Matrix<scalar_t>(m, n, nb, p, q, tester_comm());
         A.insertLocalTiles(origin_target);
     }
     else {
         // create SLATE matrix from the ScaLAPACK layouts
         A_data.resize( lldA * nlocA );
-        A = slate::Matrix<scalar_t>::fromScaLAPACK( m, n, &A_data[0], lldA, nb, p, q, MPI_COMM_WORLD );
+        A = slate::Matrix<scalar_t>::fromScaLAPACK( m, n, &A_data[0], lldA, nb, p, q, tester_comm() );
     }
 
     slate::generate_matrix(params.matrix, A);
@@ -106,17 +108,17 @@ void test_unmqr_work(Params& params, bool run)
     // For simplicity, always use ScaLAPACK format for Aref.
     Aref_data.resize( lldA * nlocA );
     Aref = slate::Matrix<scalar_t>::fromScaLAPACK(
-               m, n, &Aref_data[0], lldA, nb, p, q, MPI_COMM_WORLD);
+               m, n, &Aref_data[0], lldA, nb, p, q, tester_comm());
     slate::copy(A, Aref);
 
 
-    double time_qr = barrier_get_wtime(MPI_COMM_WORLD);
+    double time_qr = barrier_get_wtime(tester_comm());
 
     slate::qr_factor(A, T, opts);
     // Using traditional BLAS/LAPACK name
     // slate::geqrf(A, T, opts);
 
-    time_qr = barrier_get_wtime(MPI_COMM_WORLD) - time_qr;
+    time_qr = barrier_get_wtime(tester_comm()) - time_qr;
 
     double gflops_qr = lapack::Gflop<scalar_t>::geqrf(m, n);
 
@@ -142,7 +144,7 @@ void test_unmqr_work(Params& params, bool run)
 
     std::vector<scalar_t> QR_data(Aref_data.size(), zero);
     slate::Matrix<scalar_t> QR = slate::Matrix<scalar_t>::fromScaLAPACK(
-                                     m, n, &QR_data[0], lldA, nb, p, q, MPI_COMM_WORLD);
+                                     m, n, &QR_data[0], lldA, nb, p, q, tester_comm());
 
     // R1 is the upper part of QR matrix.
     slate::TrapezoidMatrix<scalar_t> R1(slate::Uplo::Upper, slate::Diag::NonUnit, QR);
@@ -154,7 +156,7 @@ void test_unmqr_work(Params& params, bool run)
 
     if (trace) slate::trace::Trace::on();
 
-    double time_unmqr = barrier_get_wtime(MPI_COMM_WORLD);
+    double time_unmqr = barrier_get_wtime(tester_comm());
 
     //==================================================
     // Run SLATE test.
@@ -167,7 +169,7 @@ void test_unmqr_work(Params& params, bool run)
     // slate::unmqr(
     //     slate::Side::Left, slate::Op::NoTrans, A, T, QR, opts);
 
-    time_unmqr = barrier_get_wtime(MPI_COMM_WORLD) - time_unmqr;
+    time_unmqr = barrier_get_wtime(tester_comm()) - time_unmqr;
 
     if (trace) slate::trace::Trace::finish();
 
@@ -66,7 +66,7 @@ void test_unmtr_hb2st_work(Params& params, bool run)
 
     // MPI variables
     int mpi_rank, myrow, mycol;
-    MPI_Comm_rank(MPI_COMM_WORLD, &mpi_rank);
+    MPI_Comm_rank(tester_comm(), &mpi_rank);
     gridinfo(mpi_rank, p, q, &myrow, &mycol);
 
     int64_t lda = n;
@@ -97,12 +97,12 @@ void test_unmtr_hb2st_work(Params& params, bool run)
 
     slate::Target origin_target = origin2target(origin);
     auto Afull = slate::HermitianMatrix<scalar_t>::fromLAPACK( // todo: fromScaLAPACK
-                     uplo, n, &Afull_data[0], lda, nb, p, q, MPI_COMM_WORLD);
+                     uplo, n, &Afull_data[0], lda, nb, p, q, tester_comm());
 
     // Copy band of Afull, currently to rank 0.
     auto Aband = slate::HermitianBandMatrix<scalar_t>(
                      uplo, n, band, nb,
-                     1, 1, MPI_COMM_WORLD);
+                     1, 1, tester_comm());
     Aband.insertLocalTiles(origin_target);
     Aband.he2hbGather( Afull );
 
@@ -114,7 +114,7 @@ void test_unmtr_hb2st_work(Params& params, bool run)
     int64_t vm = 2*nb;
     int64_t nt = Afull.nt();
     int64_t vn = nt*(nt + 1)/2*nb;
-    slate::Matrix<scalar_t> V(vm, vn, vm, nb, 1, 1, MPI_COMM_WORLD);
+    slate::Matrix<scalar_t> V(vm, vn, vm, nb, 1, 1, tester_comm());
     V.insertLocalTiles(origin_target);
     //--------------------
 
@@ -125,7 +125,7 @@ void test_unmtr_hb2st_work(Params& params, bool run)
     print_matrix( "V", V, params );
 
     // Set Q = Identity. Use 1D column cyclic.
-    slate::Matrix<scalar_t> Q(n, n, nb, 1, p*q, MPI_COMM_WORLD);
+    slate::Matrix<scalar_t> Q(n, n, nb, 1, p*q, tester_comm());
     Q.insertLocalTiles(origin_target);
     set(zero, one, Q);
     print_matrix( "Q0", Q, params );
@@ -135,13 +135,13 @@ void test_unmtr_hb2st_work(Params& params, bool run)
     else
         slate::trace::Trace::off();
 
-    double time = barrier_get_wtime(MPI_COMM_WORLD);
+    double time = barrier_get_wtime(tester_comm());
 
     //==================================================
     // Run SLATE test.
     //==================================================
     slate::unmtr_hb2st(slate::Side::Left, slate::Op::NoTrans, V, Q, opts);
-    time = barrier_get_wtime(MPI_COMM_WORLD) - time;
+    time = barrier_get_wtime(tester_comm()) - time;
 
     if (trace)
         slate::trace::Trace::finish();
@@ -160,7 +160,7 @@ void test_unmtr_hb2st_work(Params& params, bool run)
         // || I - Q^H Q || / n < tol
         // || A - Q S Q^H || / (n || A ||) < tol  // todo
         //==================================================
-        slate::Matrix<scalar_t> R( n, n, nb, 1, 1, MPI_COMM_WORLD );
+        slate::Matrix<scalar_t> R( n, n, nb, 1, 1, tester_comm() );
         R.insertLocalTiles();
         set(zero, one, R);
         print_matrix( "R0", R, params );
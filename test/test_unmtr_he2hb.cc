@@ -53,7 +53,7 @@ void test_unmtr_he2hb_work(Params& params, bool run)
 
     // MPI variables
     int mpi_rank, myrow, mycol;
-    MPI_Comm_rank(MPI_COMM_WORLD, &mpi_rank);
+    MPI_Comm_rank(tester_comm(), &mpi_rank);
     gridinfo(mpi_rank, p, q, &myrow, &mycol);
 
     // Skip invalid or unimplemented options.
@@ -75,14 +75,14 @@ void test_unmtr_he2hb_work(Params& params, bool run)
     slate::HermitianMatrix<scalar_t> A;
     if (origin != slate::Origin::ScaLAPACK) {
         slate::Target origin_target = origin2target(origin);
-        A = slate::HermitianMatrix<scalar_t>(uplo, n, nb, p, q, MPI_COMM_WORLD);
+        A = slate::HermitianMatrix<scalar_t>(uplo, n, nb, p, q, tester_comm());
         A.insertLocalTiles(origin_target);
     }
     else {
         // Create SLATE matrices from the ScaLAPACK layouts.
         A_data.resize( lldA*nlocal );
         A = slate::HermitianMatrix<scalar_t>::fromScaLAPACK(
-                uplo, n, A_data.data(), lldA, nb, p, q, MPI_COMM_WORLD);
+                uplo, n, A_data.data(), lldA, nb, p, q, tester_comm());
     }
 
     slate::generate_matrix(params.matrix, A);
@@ -95,7 +95,7 @@ void test_unmtr_he2hb_work(Params& params, bool run)
         if ((side == slate::Side::Left  && trans == slate::Op::NoTrans) ||
             (side == slate::Side::Right && trans != slate::Op::NoTrans)) {
             Aref = slate::HermitianMatrix<scalar_t>(
-                       uplo, n, nb, p, q, MPI_COMM_WORLD);
+                       uplo, n, nb, p, q, tester_comm());
 
             Aref.insertLocalTiles();
             slate::copy(A, Aref);
@@ -108,7 +108,7 @@ void test_unmtr_he2hb_work(Params& params, bool run)
     slate::Matrix<scalar_t> Afull;
     if ((side == slate::Side::Left  && trans != slate::Op::NoTrans) ||
         (side == slate::Side::Right && trans == slate::Op::NoTrans)) {
-        Afull = slate::Matrix<scalar_t>(n, n, nb, p, q, MPI_COMM_WORLD);
+        Afull = slate::Matrix<scalar_t>(n, n, nb, p, q, tester_comm());
 
         Afull.insertLocalTiles();
         copy_he2ge( A, Afull );
@@ -125,7 +125,7 @@ void test_unmtr_he2hb_work(Params& params, bool run)
     print_matrix("T_reduce",   T[1], params);
 
     // Matrix B
-    slate::Matrix< scalar_t > B(n, n, nb, p, q, MPI_COMM_WORLD);
+    slate::Matrix< scalar_t > B(n, n, nb, p, q, tester_comm());
 
     B.insertLocalTiles();
     copy_he2gb( A, B );
@@ -138,7 +138,7 @@ void test_unmtr_he2hb_work(Params& params, bool run)
     if (trace) slate::trace::Trace::on();
     else slate::trace::Trace::off();
 
-    double time = barrier_get_wtime(MPI_COMM_WORLD);
+    double time = barrier_get_wtime(tester_comm());
 
     //==================================================
     // Run SLATE test.
@@ -152,7 +152,7 @@ void test_unmtr_he2hb_work(Params& params, bool run)
         slate::unmtr_he2hb(side, trans, A, T, Afull, opts);
     }
 
-    time = barrier_get_wtime(MPI_COMM_WORLD) - time;
+    time = barrier_get_wtime(tester_comm()) - time;
 
     if (trace) slate::trace::Trace::finish();
 
@@ -99,11 +99,13 @@ for e in enums:
     file_cc.write('        default: throw Exception("unknown %s");' % var)
     file_cc.write('\n    }\n}\n')
 
-file_hh.write('Options options2cpp( slate_Options opts );\n')
-file_cc.write('Options options2cpp( slate_Options opts )\n')
+# Returns a reference, so wrappers don't copy the options map every call.
+file_hh.write('Options const& options2cpp( slate_Options opts );\n')
+file_cc.write('Options const& options2cpp( slate_Options opts )\n')
 file_cc.write('{\n')
+file_cc.write('    static const Options empty_opts;\n')
 file_cc.write('    if (opts == nullptr) {\n')
-file_cc.write('        return { };\n')
+file_cc.write('        return empty_opts;\n')
 file_cc.write('    }\n')
 file_cc.write('    else {\n')
 file_cc.write('        return *static_cast<slate::Options*>( opts );\n')
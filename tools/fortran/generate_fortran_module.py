@@ -116,6 +116,10 @@ types_dict = {
     "slate_MethodLU":                  ("character(kind=c_char)"),
     "slate_MethodTrsm":                ("character(kind=c_char)"),
     "slate_MethodSVD":                 ("character(kind=c_char)"),
+    "slate_BcastPrecision":            ("character(kind=c_char)"),
+    "slate_TaskRuntime":               ("character(kind=c_char)"),
+    "slate_QueuePriority":             ("character(kind=c_char)"),
+    "slate_ComputePrecision":          ("character(kind=c_char)"),
 
     "slate_TileKind":                  ("integer(kind=c_int)"),
     "MPI_Comm":                        ("integer(kind=c_int)"),
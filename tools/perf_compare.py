@@ -0,0 +1,288 @@
+#!/usr/bin/env python3
+#
+# Compares tester results from `tester --output file` against a baseline,
+# and flags statistically significant slowdowns.
+#
+# Usage:
+#     tools/perf_compare.py [options] baseline.jsonl current.jsonl
+#
+# Files are JSON Lines or CSV (*.csv), as written by `tester --output`.
+# Records are grouped by their input parameters (all fields except outputs
+# and the repeat index), so several repeats (`tester --repeat 5`) of one
+# test give a sample of times. For each group in both files, the mean
+# times are compared with a one-sided Welch t-test. A group is flagged if
+# it is slower by more than --threshold and the p-value is < --alpha.
+# With one run on either side, no test is possible and only the
+# threshold applies.
+#
+# Exit status is 1 if any group is flagged, else 0.
+#
+# Examples:
+#     tester --repeat 5 --output base.jsonl --dim 2000:10000:2000 gesv
+#     (update SLATE)
+#     tester --repeat 5 --output new.jsonl  --dim 2000:10000:2000 gesv
+#     tools/perf_compare.py base.jsonl new.jsonl
+#     tools/perf_compare.py --metric time --metric timers.gesv::getrf \
+#                           base.jsonl new.jsonl
+
+import argparse
+import csv
+import json
+import math
+import sys
+
+# Fields that are outputs of a run, not part of its key.
+output_fields = set( [
+    'repeat', 'il_out', 'iu_out',
+    'value', 'value2', 'value3',
+    'error', 'error2', 'error3', 'error4', 'error5',
+    'ortho', 'ortho_U', 'ortho_V',
+    'time', 'gflops', 'gbytes', 'iters',
+    'time2', 'gflops2', 'gbytes2',
+    'time3', 'time4', 'time5', 'time6', 'time7', 'time8', 'time9',
+    'time10', 'time11', 'time12', 'time13',
+    'ref_time', 'ref_gflops', 'ref_gbytes', 'ref_iters', 'efficiency',
+    'joules', 'gflops_w',
+    'okay', 'msg', 'timers',
+    'matrix.cond_actual', 'matrixB.cond_actual', 'matrixC.cond_actual',
+] )
+
+#-------------------------------------------------------------------------------
+def read_records( path ):
+    '''
+    Returns list of records (dicts) in path, skipping metadata.
+    In CSV, numbers are converted to float and timers to a dict.
+    '''
+    records = []
+    with open( path ) as f:
+        if (path.endswith( '.csv' )):
+            lines = [ line for line in f if not line.startswith( '#' ) ]
+            for row in csv.DictReader( lines ):
+                rec = {}
+                for (name, value) in row.items():
+                    if (name == 'timers'):
+                        timers = {}
+                        for pair in filter( None, value.split( ';' ) ):
+                            (key, val) = pair.rsplit( '=', 1 )
+                            timers[ key ] = float( val )
+                        rec[ name ] = timers
+                    else:
+                        try:
+                            rec[ name ] = float( value ) if value != '' else None
+                        except ValueError:
+                            rec[ name ] = value
+                records.append( rec )
+        else:
+            for line in f:
+                line = line.strip()
+                if (not line):
+                    continue
+                rec = json.loads( line )
+                if ('meta' in rec):
+                    continue
+                records.append( rec )
+    return records
+# end
+
+#-------------------------------------------------------------------------------
+def record_key( rec ):
+    '''
+    Returns hashable key of a record's input parameters.
+    Integral floats from CSV are printed as ints, to match JSON.
+    '''
+    def string( value ):
+        if (isinstance( value, float ) and value.is_integer()):
+            return str( int( value ) )
+        return str( value )
+    return tuple( sorted( (name, string( value ))
+                          for (name, value) in rec.items()
+                          if name not in output_fields ) )
+# end
+
+#-------------------------------------------------------------------------------
+def metric_value( rec, metric ):
+    '''
+    Returns value of metric in record, e.g., time or timers.gesv::getrf,
+    or None if missing.
+    '''
+    if (metric.startswith( 'timers.' )):
+        return rec.get( 'timers', {} ).get( metric[ len( 'timers.' ): ] )
+    return rec.get( metric )
+# end
+
+#-------------------------------------------------------------------------------
+def betacf( a, b, x ):
+    '''
+    Continued fraction for the incomplete beta function (Numerical Recipes).
+    '''
+    tiny = 1e-300
+    qab = a + b
+    qap = a + 1
+    qam = a - 1
+    c = 1.0
+    d = 1 - qab * x / qap
+    if (abs( d ) < tiny):
+        d = tiny
+    d = 1 / d
+    h = d
+    for m in range( 1, 300 ):
+        m2 = 2*m
+        aa = m * (b - m) * x / ((qam + m2) * (a + m2))
+        d = 1 + aa*d
+        if (abs( d ) < tiny):
+            d = tiny
+        c = 1 + aa/c
+        if (abs( c ) < tiny):
+            c = tiny
+        d = 1 / d
+        h *= d*c
+        aa = -(a + m) * (qab + m) * x / ((a + m2) * (qap + m2))
+        d = 1 + aa*d
+        if (abs( d ) < tiny):
+            d = tiny
+        c = 1 + aa/c
+        if (abs( c ) < tiny):
+            c = tiny
+        d = 1 / d
+        delta = d*c
+        h *= delta
+        if (abs( delta - 1 ) < 1e-12):
+            break
+    return h
+# end
+
+#-------------------------------------------------------------------------------
+def betai( a, b, x ):
+    '''
+    Returns regularized incomplete beta function I_x( a, b ).
+    '''
+    if (x <= 0):
+        return 0.0
+    if (x >= 1):
+        return 1.0
+    lbeta = math.lgamma( a + b ) - math.lgamma( a ) - math.lgamma( b )
+    bt = math.exp( lbeta + a*math.log( x ) + b*math.log( 1 - x ) )
+    if (x < (a + 1) / (a + b + 2)):
+        return bt * betacf( a, b, x ) / a
+    else:
+        return 1 - bt * betacf( b, a, 1 - x ) / b
+# end
+
+#-------------------------------------------------------------------------------
+def welch_slower( base, cur ):
+    '''
+    Returns one-sided p-value that mean( cur ) > mean( base ),
+    with Welch's t-test, or None if either sample has < 2 values.
+    '''
+    n1 = len( base )
+    n2 = len( cur )
+    if (n1 < 2 or n2 < 2):
+        return None
+    m1 = sum( base ) / n1
+    m2 = sum( cur  ) / n2
+    v1 = sum( (x - m1)**2 for x in base ) / (n1 - 1)
+    v2 = sum( (x - m2)**2 for x in cur  ) / (n2 - 1)
+    se2 = v1/n1 + v2/n2
+    if (se2 == 0):
+        return 0.0 if m2 > m1 else 1.0
+    t = (m2 - m1) / math.sqrt( se2 )
+    df = se2**2 / ((v1/n1)**2 / (n1 - 1) + (v2/n2)**2 / (n2 - 1))
+    # P( T > t ) for Student t with df degrees of freedom.
+    tail = 0.5 * betai( df/2, 0.5, df / (df + t*t) )
+    return tail if t > 0 else 1 - tail
+# end
+
+#-------------------------------------------------------------------------------
+def key_label( key ):
+    '''
+    Returns short label of a key, with the fields that differ between
+    groups, given as globals by main.
+    '''
+    d = dict( key )
+    return ' '.join( name + '=' + d[ name ] for name in label_fields
+                     if name in d )
+# end
+
+#-------------------------------------------------------------------------------
+def main():
+    global label_fields
+
+    parser = argparse.ArgumentParser(
+        description='Flag significant slowdowns of tester results'
+                    ' (tester --output) against a baseline.' )
+    parser.add_argument( '--alpha', type=float, default=0.05,
+                         help='significance level of the t-test (default 0.05)' )
+    parser.add_argument( '--threshold', type=float, default=0.05,
+                         help='minimum relative slowdown to flag (default 0.05 = 5%%)' )
+    parser.add_argument( '--metric', action='append',
+                         help='metric to compare, lower is better: time (default),'
+                              ' ref_time, time2, ..., or timers.<name>;'
+                              ' may be repeated' )
+    parser.add_argument( '-v', '--verbose', action='store_true',
+                         help='print all groups, not only flagged ones' )
+    parser.add_argument( 'baseline', help='baseline results' )
+    parser.add_argument( 'current',  help='current results' )
+    opts = parser.parse_args()
+    metrics = opts.metric or [ 'time' ]
+
+    base = read_records( opts.baseline )
+    cur  = read_records( opts.current  )
+
+    # Sample of each metric for each group, skipping failed runs.
+    def group( records ):
+        groups = {}
+        for rec in records:
+            if (rec.get( 'okay' ) == 0):
+                continue
+            groups.setdefault( record_key( rec ), [] ).append( rec )
+        return groups
+    base_groups = group( base )
+    cur_groups  = group( cur  )
+    keys = [ key for key in cur_groups if key in base_groups ]
+
+    # Label groups by the fields whose values differ between them.
+    values = {}
+    for key in keys:
+        for (name, value) in key:
+            values.setdefault( name, set() ).add( value )
+    label_fields = [ name for (name, vals) in values.items() if len( vals ) > 1 ]
+    if (not label_fields):
+        label_fields = [ 'routine' ]
+
+    print( '%-11s %-50s %12s %12s %8s %8s  %s'
+           % ('metric', 'test', 'baseline', 'current', 'change', 'p-value', 'status') )
+    nflagged = 0
+    for key in keys:
+        for metric in metrics:
+            b = [ v for v in (metric_value( r, metric ) for r in base_groups[ key ])
+                  if v is not None ]
+            c = [ v for v in (metric_value( r, metric ) for r in cur_groups[ key ])
+                  if v is not None ]
+            if (not b or not c):
+                continue
+            mb = sum( b ) / len( b )
+            mc = sum( c ) / len( c )
+            change = (mc / mb - 1) if mb > 0 else 0
+            p = welch_slower( b, c )
+            slow = change > opts.threshold and (p is None or p < opts.alpha)
+            if (slow):
+                nflagged += 1
+            if (slow or opts.verbose):
+                print( '%-11s %-50s %12.4g %12.4g %+7.1f%% %8s  %s'
+                       % (metric, key_label( key ), mb, mc, 100*change,
+                          '-' if p is None else '%.3g' % p,
+                          ('SLOWER' if p is not None else 'SLOWER (n<2)')
+                          if slow else 'ok') )
+
+    missing = len( base_groups ) - len( keys )
+    print( '\n%d of %d tests in both files; %d baseline tests not in current.'
+           % (len( keys ), len( cur_groups ), missing) )
+    if (nflagged > 0):
+        print( '%d significant slowdowns.' % nflagged )
+        return 1
+    print( 'No significant slowdowns.' )
+    return 0
+# end
+
+if (__name__ == '__main__'):
+    sys.exit( main() )
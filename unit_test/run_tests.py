@@ -62,26 +62,41 @@ opts = parser.parse_args()
 # ------------------------------------------------------------------------------
 cmds = [
     'test_BandMatrix',
+    'test_DeviceGraph',
+    'test_Expression',
     'test_HermitianMatrix',
+    'test_Hybrid',
+    'test_InfoRequest',
     'test_LockGuard',
+    'test_Lookahead',
     'test_OmpSetMaxActiveLevels',
     'test_Matrix',
+    'test_MatrixStorage',
     'test_Memory',
+    'test_MpiGuard',
     'test_SymmetricMatrix',
+    'test_TaskGraph',
+    'test_ThreadBarrier',
     'test_TrapezoidMatrix',
     'test_TriangularBandMatrix',
     'test_TriangularMatrix',
+    'test_Tuning',
     'test_Tile',
     'test_Tile_kernels',
+    'test_async',
     #'test_c_api',  # only if c_api was compiled
     'test_func',
     'test_geadd',
     'test_gecopy',
     'test_geset',
     'test_internal_blas',
+    'test_io',
     'test_lq',
     'test_norm',
+    'test_plan',
     'test_qr',
+    'test_redistribute',
+    'test_small',
     'test_util',
 ]
 
@@ -0,0 +1,99 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/DeviceGraph.hh"
+#include "slate/internal/device.hh"
+#include "slate/Exception.hh"
+
+#include "unit_test.hh"
+
+#include <vector>
+
+namespace test {
+
+int num_devices = 0;
+
+//------------------------------------------------------------------------------
+/// A new graph is empty; clearing it is harmless.
+void test_empty()
+{
+    slate::DeviceGraph graph;
+    test_assert( graph.empty() );
+    test_assert( graph.numUpdates() == 0 );
+    graph.clear();
+    test_assert( graph.empty() );
+}
+
+//------------------------------------------------------------------------------
+/// Captures geset, checks nothing ran until launch, then recaptures with a
+/// new pointer, which updates the graph in place.
+void test_capture_launch()
+{
+    if (num_devices == 0)
+        test_skip( "requires num_devices > 0" );
+
+    int64_t m = 20, n = 30, lda = m;
+    int device = 0;
+    blas::Queue queue( device );
+
+    double* A_dev = blas::device_malloc<double>( lda*n, queue );
+    double* B_dev = blas::device_malloc<double>( lda*n, queue );
+    std::vector<double> A( lda*n, 0.0 );
+    blas::device_memcpy<double>( A_dev, A.data(), lda*n, queue );
+    blas::device_memcpy<double>( B_dev, A.data(), lda*n, queue );
+    queue.sync();
+
+    slate::DeviceGraph graph;
+    graph.capture( queue, [&] {
+        slate::device::geset( m, n, 1.0, 2.0, A_dev, lda, queue );
+    });
+    test_assert( ! graph.empty() );
+    test_assert( graph.numUpdates() == 0 );
+
+    // Capturing doesn't run the work.
+    blas::device_memcpy<double>( A.data(), A_dev, lda*n, queue );
+    queue.sync();
+    test_assert( A[ 0 ] == 0.0 );
+
+    for (int rep = 0; rep < 3; ++rep)
+        graph.launch( queue );
+    blas::device_memcpy<double>( A.data(), A_dev, lda*n, queue );
+    queue.sync();
+    test_assert( A[ 0 ] == 2.0 );
+    test_assert( A[ 1 ] == 1.0 );
+
+    // Same topology, new pointer: updated in place.
+    graph.capture( queue, [&] {
+        slate::device::geset( m, n, 3.0, 4.0, B_dev, lda, queue );
+    });
+    test_assert( graph.numUpdates() == 1 );
+    graph.launch( queue );
+    blas::device_memcpy<double>( A.data(), B_dev, lda*n, queue );
+    queue.sync();
+    test_assert( A[ 0 ] == 4.0 );
+    test_assert( A[ 1 ] == 3.0 );
+
+    graph.clear();
+    test_assert( graph.empty() );
+    blas::device_free( A_dev, queue );
+    blas::device_free( B_dev, queue );
+}
+
+//------------------------------------------------------------------------------
+/// Runs all tests. Called by unit test main().
+void run_tests()
+{
+    run_test(test_empty,          "DeviceGraph empty");
+    run_test(test_capture_launch, "DeviceGraph capture, launch");
+}
+
+}  // namespace test
+
+//------------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+    test::num_devices = blas::get_device_count();
+    return unit_test_main();  // which calls run_tests()
+}
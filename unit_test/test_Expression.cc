@@ -0,0 +1,202 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/slate.hh"
+
+#include "unit_test.hh"
+#include "util_matrix.hh"
+
+#include <cstdio>
+#include <limits>
+
+namespace test {
+
+//------------------------------------------------------------------------------
+// global variables
+int m, n, k, nb, p, q;
+int mpi_rank;
+int mpi_size;
+MPI_Comm mpi_comm;
+int verbose = 0;
+
+//------------------------------------------------------------------------------
+/// @return an m-by-n matrix with random entries.
+slate::Matrix<double> random_matrix( int64_t mm, int64_t nn, int64_t seed )
+{
+    slate::Matrix<double> A( mm, nn, nb, p, q, mpi_comm );
+    A.insertLocalTiles();
+    for (int64_t j = 0; j < A.nt(); ++j) {
+        for (int64_t i = 0; i < A.mt(); ++i) {
+            if (A.tileIsLocal( i, j )) {
+                auto T = A( i, j );
+                int64_t iseed[4] = { seed, i % 4096, j % 4096, 1 };
+                for (int64_t tj = 0; tj < T.nb(); ++tj)
+                    lapack::larnv( 2, iseed, T.mb(), &T.at( 0, tj ) );
+            }
+        }
+    }
+    return A;
+}
+
+//------------------------------------------------------------------------------
+/// @return a copy of A.
+slate::Matrix<double> copy_of( slate::Matrix<double>& A )
+{
+    auto B = A.emptyLike();
+    B.insertLocalTiles();
+    slate::copy( A, B );
+    return B;
+}
+
+//------------------------------------------------------------------------------
+/// Checks that || X - Y ||_max is within rounding.
+void check_equal( slate::Matrix<double>& X, slate::Matrix<double>& Y )
+{
+    double X_norm = slate::norm( slate::Norm::Max, X );
+    slate::add( -1.0, X, 1.0, Y );
+    double diff = slate::norm( slate::Norm::Max, Y );
+    double eps = std::numeric_limits<double>::epsilon();
+    test_assert( diff <= 10 * k * eps * X_norm );
+}
+
+//------------------------------------------------------------------------------
+/// Element-wise operations after a gemm on other matrices run in one pass,
+/// with the same result as separate calls.
+void test_expression_elementwise()
+{
+    const double alpha = 1.5, beta = -0.5, s = 0.25;
+
+    auto A = random_matrix( m, k, 1 );
+    auto B = random_matrix( k, n, 2 );
+    auto C = random_matrix( m, n, 3 );
+    auto E = random_matrix( m, n, 4 );
+    auto C_ref = copy_of( C );
+    auto D     = C.emptyLike();
+    auto D_ref = C.emptyLike();
+    D.insertLocalTiles();
+    D_ref.insertLocalTiles();
+
+    // C = alpha A B + beta C; D = C + E; D = s D.
+    slate::gemm( alpha, A, B, beta, C_ref );
+    slate::copy( C_ref, D_ref );
+    slate::add( 1.0, E, 1.0, D_ref );
+    slate::scale( s, D_ref );
+
+    slate::Expression<double> expr;
+    expr.gemm( alpha, A, B, beta, C )
+        .copy( C, D )
+        .add( 1.0, E, 1.0, D )
+        .scale( s, D );
+    test_assert( expr.size() == 4 );
+    expr.execute();
+    test_assert( expr.size() == 0 );
+
+    check_equal( C_ref, C );
+    check_equal( D_ref, D );
+}
+
+//------------------------------------------------------------------------------
+/// Scaling and adding to a gemm's output are folded into the gemm,
+/// with the same result as separate calls.
+void test_expression_epilogue()
+{
+    const double alpha = 2.0, beta = 0.5, a = -1.0, b = 3.0, s = 0.125;
+
+    auto A = random_matrix( m, k, 5 );
+    auto B = random_matrix( k, n, 6 );
+    auto C = random_matrix( m, n, 7 );
+    auto E = random_matrix( m, n, 8 );
+    auto C_ref = copy_of( C );
+
+    // C = alpha A B + beta C; C = a E + b C; C = s C; C = C + C.
+    slate::gemm( alpha, A, B, beta, C_ref );
+    slate::add( a, E, b, C_ref );
+    slate::scale( s, C_ref );
+    slate::add( 1.0, C_ref, 1.0, C_ref );
+
+    slate::Expression<double> expr;
+    expr.gemm( alpha, A, B, beta, C )
+        .add( a, E, b, C )
+        .scale( s, C )
+        .add( 1.0, C, 1.0, C );
+    expr.execute();
+
+    check_equal( C_ref, C );
+}
+
+//------------------------------------------------------------------------------
+/// Views of the same tiles are the same view; sub-matrices are not.
+void test_same_view()
+{
+    auto A = random_matrix( m, n, 9 );
+    auto A2 = A;
+    auto B = A.emptyLike();
+    test_assert( A.sameView( A2 ) );
+    test_assert( ! A.sameView( B ) );
+    test_assert( ! A.sameView( transpose( A2 ) ) );
+    if (A.mt() > 1)
+        test_assert( ! A.sameView( A.sub( 1, A.mt()-1, 0, A.nt()-1 ) ) );
+}
+
+//==============================================================================
+/// Runs all tests. Called by unit test main().
+void run_tests()
+{
+    run_test(test_expression_elementwise, "Expression element-wise", mpi_comm);
+    run_test(test_expression_epilogue,    "Expression gemm epilogue", mpi_comm);
+    run_test(test_same_view,              "BaseMatrix::sameView",     mpi_comm);
+}
+
+}  // namespace test
+
+//------------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+    using namespace test;  // for globals mpi_rank, etc.
+
+    MPI_Init(&argc, &argv);
+
+    mpi_comm = MPI_COMM_WORLD;
+
+    MPI_Comm_rank(mpi_comm, &mpi_rank);
+    MPI_Comm_size(mpi_comm, &mpi_size);
+
+    // globals
+    m  = 100;
+    n  = 80;
+    k  = 60;
+    nb = 16;
+    init_process_grid(mpi_size, &p, &q);
+
+    // parse command line
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "-m" && i+1 < argc)
+            m = atoi( argv[++i] );
+        else if (arg == "-n" && i+1 < argc)
+            n = atoi( argv[++i] );
+        else if (arg == "-k" && i+1 < argc)
+            k = atoi( argv[++i] );
+        else if (arg == "-nb" && i+1 < argc)
+            nb = atoi( argv[++i] );
+        else if (arg == "-p" && i+1 < argc)
+            p = atoi( argv[++i] );
+        else if (arg == "-q" && i+1 < argc)
+            q = atoi( argv[++i] );
+        else {
+            printf( "unknown argument: %s\n", argv[i] );
+            return 1;
+        }
+    }
+    if (mpi_rank == 0) {
+        printf("Usage: %s [-m %d] [-n %d] [-k %d] [-nb %d] [-p %d] [-q %d]\n",
+               argv[0], m, n, k, nb, p, q);
+    }
+
+    int err = unit_test_main(mpi_comm);  // which calls run_tests()
+
+    MPI_Finalize();
+    return err;
+}
@@ -0,0 +1,123 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/internal/Hybrid.hh"
+#include "slate/types.hh"
+#include "slate/Exception.hh"
+
+#include "unit_test.hh"
+
+#include <vector>
+
+using slate::internal::HybridSplit;
+
+namespace test {
+
+//------------------------------------------------------------------------------
+/// Disabled, all columns go to the devices, regardless of times.
+void test_disabled()
+{
+    HybridSplit hybrid( false );
+    test_assert( ! hybrid.enabled() );
+    hybrid.done( 1.0, 1.0, 1.0, 1.0 );
+    std::vector<double> flops( 5, 1.0 );
+    test_assert( hybrid.split( flops ) == 5 );
+    test_assert( hybrid.hostFraction() == 0 );
+}
+
+//------------------------------------------------------------------------------
+/// Until both rates are measured, the host gets the last column.
+void test_default()
+{
+    HybridSplit hybrid( true );
+    test_assert( hybrid.enabled() );
+    std::vector<double> flops( 5, 1.0 );
+    test_assert( hybrid.split( flops ) == 4 );
+
+    // One column: nothing to split.
+    std::vector<double> one( 1, 1.0 );
+    test_assert( hybrid.split( one ) == 1 );
+
+    // Only the device rate measured.
+    hybrid.done( 0.0, 0.0, 4.0, 1.0 );
+    test_assert( hybrid.split( flops ) == 4 );
+    test_assert( hybrid.hostFraction() == 0 );
+}
+
+//------------------------------------------------------------------------------
+/// The split balances the times from the measured rates.
+void test_balance()
+{
+    HybridSplit hybrid( true );
+    // Device 3 times as fast as host.
+    hybrid.done( 1.0, 1.0, 3.0, 1.0 );
+    test_assert( hybrid.hostFraction() == 0.25 );
+
+    // 8 equal columns: host gets 2, devices 6.
+    std::vector<double> flops( 8, 1.0 );
+    test_assert( hybrid.split( flops ) == 6 );
+
+    // Host as fast as devices: half each.
+    HybridSplit equal( true );
+    equal.done( 1.0, 1.0, 1.0, 1.0 );
+    test_assert( equal.split( flops ) == 4 );
+
+    // Host much slower: no columns, since one column on the host
+    // would take longer than all of them on the devices.
+    HybridSplit slow( true );
+    slow.done( 1.0, 100.0, 1.0, 1.0 );
+    test_assert( slow.split( flops ) == 8 );
+
+    // Decreasing column flops, as in the lower triangle of potrf:
+    // the host's last columns are cheaper, so it gets more of them.
+    std::vector<double> tri = { 8, 7, 6, 5, 4, 3, 2, 1 };
+    test_assert( hybrid.split( tri ) == 5 );
+}
+
+//------------------------------------------------------------------------------
+/// Rates are averaged with the previous step's.
+void test_average()
+{
+    HybridSplit hybrid( true );
+    hybrid.done( 1.0, 1.0, 1.0, 1.0 );
+    // New host rate 3 averaged with 1 gives 2; device stays 1.
+    hybrid.done( 3.0, 1.0, 0.0, 0.0 );
+    test_assert( hybrid.hostFraction() == 2.0 / 3.0 );
+}
+
+//------------------------------------------------------------------------------
+/// Routines without a hybrid implementation run Hybrid as Devices.
+void test_get_target()
+{
+    slate::Options opts;
+    test_assert( slate::get_target( opts ) == slate::Target::HostTask );
+
+    opts = { { slate::Option::Target, slate::Target::Hybrid } };
+    test_assert( slate::get_target( opts ) == slate::Target::Devices );
+    test_assert( slate::get_option<slate::Option::Target>(
+                     opts, slate::Target::HostTask ) == slate::Target::Hybrid );
+
+    opts = { { slate::Option::Target, slate::Target::HostNest } };
+    test_assert( slate::get_target( opts ) == slate::Target::HostNest );
+}
+
+//------------------------------------------------------------------------------
+/// Runs all tests. Called by unit test main().
+void run_tests()
+{
+    run_test(test_disabled,   "HybridSplit disabled");
+    run_test(test_default,    "HybridSplit default");
+    run_test(test_balance,    "HybridSplit balance");
+    run_test(test_average,    "HybridSplit average");
+    run_test(test_get_target, "get_target");
+}
+
+}  // namespace test
+
+//------------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+    return unit_test_main();  // which calls run_tests()
+}
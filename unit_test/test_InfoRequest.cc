@@ -0,0 +1,153 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/InfoRequest.hh"
+#include "slate/GrowthStats.hh"
+#include "slate/Exception.hh"
+#include "slate/types.hh"
+#include "internal/internal.hh"
+
+#include "unit_test.hh"
+
+namespace test {
+
+//------------------------------------------------------------------------------
+// global variables
+int mpi_rank, mpi_size;
+MPI_Comm mpi_comm;
+
+//------------------------------------------------------------------------------
+/// A request that was never started has info 0.
+void test_InfoRequest_none()
+{
+    slate::InfoRequest request;
+    test_assert( ! request.pending() );
+    test_assert( request.test() );
+    test_assert( request.wait() == 0 );
+}
+
+//------------------------------------------------------------------------------
+/// wait() gives the smallest non-zero info over the ranks, as reduce_info.
+void test_InfoRequest_wait()
+{
+    // Odd ranks report an error at 10 + rank; the smallest is at rank 1.
+    int64_t info = mpi_rank % 2 == 1 ? 10 + mpi_rank : 0;
+    int64_t expect = mpi_size > 1 ? 11 : 0;
+
+    slate::InfoRequest request;
+    request.start( info, mpi_comm );
+    test_assert( request.pending() );
+    test_assert( request.wait() == expect );
+    test_assert( ! request.pending() );
+    test_assert( request.wait() == expect );
+
+    // Reusable after wait; test() eventually completes it.
+    request.start( 0, mpi_comm );
+    while (! request.test()) {}
+    test_assert( ! request.pending() );
+    test_assert( request.wait() == 0 );
+
+    // The blocking reduction agrees.
+    int64_t info2 = info;
+    slate::internal::reduce_info( &info2, mpi_comm );
+    test_assert( info2 == expect );
+}
+
+//------------------------------------------------------------------------------
+/// Starting a pending request throws.
+void test_InfoRequest_pending()
+{
+    slate::InfoRequest request;
+    request.start( 0, mpi_comm );
+    test_assert_throw( request.start( 0, mpi_comm ), slate::Exception );
+    test_assert( request.wait() == 0 );
+}
+
+//------------------------------------------------------------------------------
+/// With Option::InfoRequest, reduce_info leaves this rank's info and
+/// starts the request; wait_info completes it.
+void test_InfoRequest_option()
+{
+    int64_t local = mpi_rank == mpi_size - 1 ? 7 : 0;
+
+    slate::InfoRequest request;
+    slate::Options opts = {{ slate::Option::InfoRequest, &request }};
+    int64_t info = local;
+    slate::internal::reduce_info( &info, mpi_comm, opts );
+    test_assert( info == local );
+    test_assert( request.pending() );
+    test_assert( slate::internal::wait_info( info, opts ) == 7 );
+    test_assert( ! request.pending() );
+
+    // Without a pending request, wait_info returns info as is.
+    test_assert( slate::internal::wait_info( 3, opts ) == 3 );
+    test_assert( slate::internal::wait_info( 3, slate::Options() ) == 3 );
+}
+
+//------------------------------------------------------------------------------
+/// With Option::GrowthStats, the growth maxima are reduced with info,
+/// by both the blocking reduction and the request.
+void test_InfoRequest_growth()
+{
+    int64_t local = mpi_rank == 0 ? 0 : 5 + mpi_rank;
+    int64_t expect = mpi_size > 1 ? 6 : 0;
+    double max_A = 1 + mpi_rank;
+    double max_U = 10 * (mpi_size - mpi_rank);
+
+    slate::GrowthStats growth;
+    growth.updateA( max_A );
+    growth.updateU( max_U );
+    growth.updateU( 0.5 );
+    test_assert( growth.maxA() == max_A );
+    test_assert( growth.maxU() == max_U );
+
+    int64_t info = local;
+    slate::internal::reduce_info( &info, mpi_comm, &growth );
+    test_assert( info == expect );
+    test_assert( growth.maxA() == mpi_size );
+    test_assert( growth.maxU() == 10 * mpi_size );
+    test_assert( growth.growth() == 10 );
+
+    growth.set( max_A, max_U );
+    slate::InfoRequest request;
+    slate::Options opts = {{ slate::Option::InfoRequest, &request },
+                           { slate::Option::GrowthStats, &growth }};
+    info = local;
+    slate::internal::reduce_info( &info, mpi_comm, opts );
+    test_assert( info == local );
+    test_assert( request.wait() == expect );
+    test_assert( growth.maxA() == mpi_size );
+    test_assert( growth.maxU() == 10 * mpi_size );
+
+    growth.reset();
+    test_assert( growth.growth() == 0 );
+}
+
+//------------------------------------------------------------------------------
+/// Runs all tests. Called by unit test main().
+void run_tests()
+{
+    run_test( test_InfoRequest_none,    "InfoRequest, not started" );
+    run_test( test_InfoRequest_wait,    "InfoRequest::wait" );
+    run_test( test_InfoRequest_pending, "InfoRequest::start, pending" );
+    run_test( test_InfoRequest_option,  "Option::InfoRequest" );
+    run_test( test_InfoRequest_growth,  "Option::GrowthStats" );
+}
+
+}  // namespace test
+
+//------------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+    using namespace test;
+
+    MPI_Init( &argc, &argv );
+    mpi_comm = MPI_COMM_WORLD;
+    MPI_Comm_rank( mpi_comm, &mpi_rank );
+    MPI_Comm_size( mpi_comm, &mpi_size );
+    int err = unit_test_main( mpi_comm );  // which calls run_tests()
+    MPI_Finalize();
+    return err;
+}
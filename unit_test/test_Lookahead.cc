@@ -0,0 +1,117 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/internal/Lookahead.hh"
+#include "slate/types.hh"
+#include "slate/Exception.hh"
+
+#include "unit_test.hh"
+
+using slate::internal::AdaptiveLookahead;
+
+namespace test {
+
+//------------------------------------------------------------------------------
+/// A fixed lookahead is used for every step, regardless of times.
+void test_fixed()
+{
+    AdaptiveLookahead la( 2, 8 );
+    test_assert( ! la.isAuto() );
+    test_assert( la.max() == 2 );
+    la.panelDone( 0, 1.0, 100.0 );
+    la.updateDone( 1.0, 1.0 );
+    for (int k = 0; k < 10; ++k)
+        test_assert( la.step( k, 1.0, 1.0 ) == 2 );
+
+    AdaptiveLookahead la0( 0, 8 );
+    test_assert( la0.max() == 0 );
+    test_assert( la0.step( 0, 1.0, 1.0 ) == 0 );
+}
+
+//------------------------------------------------------------------------------
+/// Auto starts at 1 until both times are measured.
+void test_auto_default()
+{
+    AdaptiveLookahead la( slate::LookaheadAuto, 4 );
+    test_assert( la.isAuto() );
+    test_assert( la.max() == 4 );
+    test_assert( la.step( 0, 1.0, 1.0 ) == 1 );
+    la.panelDone( 0, 1.0, 1.0 );
+    test_assert( la.step( 1, 1.0, 1.0 ) == 1 );
+}
+
+//------------------------------------------------------------------------------
+/// Auto grows by 1 per step as the panel time exceeds the update time,
+/// up to max, and shrinks by 1 per step when the update time dominates.
+void test_auto_adapt()
+{
+    AdaptiveLookahead la( slate::LookaheadAuto, 4 );
+    // 1 second per flop for both panel and update.
+    la.panelDone( 0, 1.0, 1.0 );
+    la.updateDone( 1.0, 1.0 );
+
+    // Update dominates: depth 1.
+    test_assert( la.step( 1, 1.0, 100.0 ) == 1 );
+
+    // Panel dominates: target 1 + 10, limited to +1 per step, then max.
+    test_assert( la.step( 2, 10.0, 1.0 ) == 2 );
+    test_assert( la.step( 3, 10.0, 1.0 ) == 3 );
+    test_assert( la.step( 4, 10.0, 1.0 ) == 4 );
+    test_assert( la.step( 5, 10.0, 1.0 ) == 4 );
+
+    // Update dominates again: shrinks by 1 per step.
+    test_assert( la.step( 6, 1.0, 100.0 ) == 3 );
+    test_assert( la.step( 7, 1.0, 100.0 ) == 2 );
+    test_assert( la.step( 8, 1.0, 100.0 ) == 1 );
+    test_assert( la.step( 9, 1.0, 100.0 ) == 1 );
+
+    // Panel time 2.5 times update time: 1 + 2.
+    test_assert( la.step( 10, 2.5, 1.0 ) == 2 );
+    test_assert( la.step( 11, 2.5, 1.0 ) == 3 );
+    test_assert( la.step( 12, 2.5, 1.0 ) == 3 );
+}
+
+//------------------------------------------------------------------------------
+/// Routines with fixed lookahead take Auto as the default.
+void test_get_lookahead()
+{
+    slate::Options opts;
+    test_assert( slate::get_lookahead( opts ) == 1 );
+
+    opts = { { slate::Option::Lookahead, 3 } };
+    test_assert( slate::get_lookahead( opts ) == 3 );
+
+    opts = { { slate::Option::Lookahead, slate::LookaheadAuto } };
+    test_assert( slate::get_lookahead( opts ) == 1 );
+    test_assert( slate::get_lookahead( opts, 2 ) == 2 );
+}
+
+//------------------------------------------------------------------------------
+/// Invalid values throw.
+void test_invalid()
+{
+    test_assert_throw( AdaptiveLookahead( -2, 4 ), slate::Exception );
+    test_assert_throw( AdaptiveLookahead( slate::LookaheadAuto, 0 ),
+                       slate::Exception );
+}
+
+//------------------------------------------------------------------------------
+/// Runs all tests. Called by unit test main().
+void run_tests()
+{
+    run_test(test_fixed,         "AdaptiveLookahead fixed");
+    run_test(test_auto_default,  "AdaptiveLookahead auto default");
+    run_test(test_auto_adapt,    "AdaptiveLookahead auto adapt");
+    run_test(test_get_lookahead, "get_lookahead");
+    run_test(test_invalid,       "AdaptiveLookahead invalid");
+}
+
+}  // namespace test
+
+//------------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+    return unit_test_main();  // which calls run_tests()
+}
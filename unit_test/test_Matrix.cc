@@ -3,12 +3,19 @@
 // This program is free software: you can redistribute it and/or modify it under
 // the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
 
+#include "slate/slate.hh"
 #include "slate/Matrix.hh"
 #include "slate/internal/util.hh"
 
 #include "unit_test.hh"
 #include "util_matrix.hh"
 
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <unistd.h>
+
 using slate::ceildiv;
 using slate::roundup;
 using slate::GridOrder;
@@ -446,6 +453,74 @@ void test_Matrix_fromDevices()
         delete dev_queues[dev];
 }
 
+//------------------------------------------------------------------------------
+/// Test Matrix::fromScaLAPACKDevice, in column- and row-major layouts,
+/// and fromScaLAPACKDeviceBatch.
+void test_Matrix_fromScaLAPACKDevice()
+{
+    if (num_devices == 0) {
+        test_skip("requires num_devices > 0");
+    }
+
+    int mtiles, mtiles_local, m_local, lda;
+    int ntiles, ntiles_local, n_local;
+    get_2d_cyclic_dimensions(
+        m, n, mb, nb,
+        mtiles, mtiles_local, m_local,
+        ntiles, ntiles_local, n_local, lda );
+
+    // Use the last device, to check that tiles are not on device 0.
+    int dev = num_devices - 1;
+    blas::Queue queue( dev );
+
+    // Row-major leading dimension is the local number of columns.
+    int lda_row = std::max( n_local, 1 );
+    int64_t len = std::max( lda * n_local, lda_row * m_local );
+    len = std::max( len, int64_t( 1 ) );
+    int64_t batch_count = 2;
+    double* Ad = blas::device_malloc<double>( batch_count * len, queue );
+    assert( Ad != nullptr );
+
+    for (auto layout : { slate::Layout::ColMajor, slate::Layout::RowMajor }) {
+        int ld = layout == slate::Layout::ColMajor ? lda : lda_row;
+        auto batch = slate::Matrix<double>::fromScaLAPACKDeviceBatch(
+            batch_count, len, m, n, Ad, ld, mb, nb,
+            slate::GridOrder::Col, p, q, mpi_comm, dev, layout );
+        test_assert( int64_t( batch.size() ) == batch_count );
+
+        for (int64_t k = 0; k < batch_count; ++k) {
+            auto& A = batch[ k ];
+            test_assert( A.mt() == mtiles );
+            test_assert( A.nt() == ntiles );
+            test_assert( A.layout() == layout );
+            test_assert( A.origin() == slate::Target::Devices );
+
+            for (int j = 0; j < A.nt(); ++j) {
+                for (int i = 0; i < A.mt(); ++i) {
+                    test_assert( A.tileDevice( i, j ) == dev );
+                    if (! A.tileIsLocal( i, j ))
+                        continue;
+
+                    int ii = int( i/p )*mb;
+                    int jj = int( j/q )*nb;
+                    int offset = layout == slate::Layout::ColMajor
+                               ? ii + jj*ld
+                               : ii*ld + jj;
+                    auto T = A( i, j, dev );
+                    test_assert( T.data()   == &Ad[ k*len + offset ] );
+                    test_assert( T.stride() == ld );
+                    test_assert( T.layout() == layout );
+                    test_assert( T.device() == dev );
+                    test_assert( T.origin() );
+                    test_assert( ! A.tileExists( i, j, HostNum ) );
+                }
+            }
+        }
+    }
+
+    blas::device_free( Ad, queue );
+}
+
 //==============================================================================
 // Methods
 
@@ -1038,6 +1113,339 @@ void test_Matrix_insertLocalTiles()
     }
 }
 
+//------------------------------------------------------------------------------
+/// Tests insertLocalTiles with Option::HostFirstTouch, which zeros tiles.
+void test_Matrix_insertLocalTiles_firstTouch()
+{
+    slate::Matrix<double> A(m, n, mb, nb, p, q, mpi_comm);
+
+    A.insertLocalTiles( slate::Target::Host,
+                        {{ slate::Option::HostFirstTouch, true }} );
+    for (int j = 0; j < A.nt(); ++j) {
+        for (int i = 0; i < A.mt(); ++i) {
+            if (A.tileIsLocal(i, j)) {
+                auto T = A(i, j);
+                test_assert(T.mb() == A.tileMb(i));
+                test_assert(T.nb() == A.tileNb(j));
+                test_assert(T.origin());
+                for (int jj = 0; jj < T.nb(); ++jj)
+                    for (int ii = 0; ii < T.mb(); ++ii)
+                        test_assert( T(ii, jj) == 0.0 );
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Tests insertLocalTilesZero, which allocates and zeros tiles on first
+/// access, except when the caller overwrites them.
+void test_Matrix_insertLocalTilesZero()
+{
+    slate::Matrix<double> A(m, n, mb, nb, p, q, mpi_comm);
+
+    A.insertLocalTilesZero();
+    for (int j = 0; j < A.nt(); ++j) {
+        for (int i = 0; i < A.mt(); ++i) {
+            if (A.tileIsLocal(i, j)) {
+                test_assert( ! A.tileExists( i, j ) );
+                test_assert( A.tileIsLazyZero( i, j ) );
+            }
+            else {
+                test_assert( ! A.tileIsLazyZero( i, j ) );
+            }
+        }
+    }
+
+    // Tiles are allocated and zeroed on first access.
+    for (int j = 0; j < A.nt(); ++j) {
+        for (int i = 0; i < A.mt(); ++i) {
+            if (A.tileIsLocal(i, j) && (i + j) % 2 == 0) {
+                A.tileGetForReading( i, j, slate::LayoutConvert::None );
+                test_assert( A.tileExists( i, j ) );
+                test_assert( ! A.tileIsLazyZero( i, j ) );
+                auto T = A(i, j);
+                test_assert(T.mb() == A.tileMb(i));
+                test_assert(T.nb() == A.tileNb(j));
+                test_assert(T.origin());
+                for (int jj = 0; jj < T.nb(); ++jj)
+                    for (int ii = 0; ii < T.mb(); ++ii)
+                        test_assert( T(ii, jj) == 0.0 );
+            }
+        }
+    }
+
+    // operator() allocates the rest; tileMaterialize is then a no-op.
+    for (int j = 0; j < A.nt(); ++j) {
+        for (int i = 0; i < A.mt(); ++i) {
+            if (A.tileIsLocal(i, j)) {
+                auto T = A(i, j);
+                test_assert( T(0, 0) == 0.0 );
+                A.tileMaterialize( i, j );
+                test_assert( ! A.tileIsLazyZero( i, j ) );
+            }
+        }
+    }
+
+    // With zero tiles tracked, all tiles are marked as zero.
+    slate::Matrix<double> B(m, n, mb, nb, p, q, mpi_comm);
+    B.trackZeroTiles( true );
+    B.insertLocalTilesZero();
+    for (int j = 0; j < B.nt(); ++j)
+        for (int i = 0; i < B.mt(); ++i)
+            test_assert( B.tileIsZero( i, j ) );
+}
+
+//------------------------------------------------------------------------------
+/// Tests snapshot, which shares tiles until either matrix writes them.
+void test_Matrix_snapshot()
+{
+    // Local tiles to write, if any.
+    std::vector< std::pair<int64_t, int64_t> > local;
+
+    auto value = []( int64_t i, int64_t j, int64_t ii, int64_t jj ) {
+        return double( 1000*i + 100*j + 10*ii + jj );
+    };
+
+    slate::Matrix<double> B;
+    {
+        slate::Matrix<double> A(m, n, mb, nb, p, q, mpi_comm);
+        A.insertLocalTiles();
+        for (int j = 0; j < A.nt(); ++j) {
+            for (int i = 0; i < A.mt(); ++i) {
+                if (A.tileIsLocal(i, j)) {
+                    local.push_back( { i, j } );
+                    auto T = A(i, j);
+                    for (int jj = 0; jj < T.nb(); ++jj)
+                        for (int ii = 0; ii < T.mb(); ++ii)
+                            T.at(ii, jj) = value( i, j, ii, jj );
+                }
+            }
+        }
+
+        B = A.snapshot();
+        test_assert( B.m() == A.m() );
+        test_assert( B.n() == A.n() );
+        for (auto ij : local) {
+            test_assert( B.tileIsCowShared( ij.first, ij.second ) );
+            test_assert( B( ij.first, ij.second ).data()
+                         == A( ij.first, ij.second ).data() );
+        }
+
+        // Writing A copies the tile for B first.
+        if (local.size() > 0) {
+            int64_t i = local[ 0 ].first, j = local[ 0 ].second;
+            A.tileGetForWriting( i, j, slate::LayoutConvert::None );
+            A(i, j).at(0, 0) = -1.0;
+            test_assert( ! B.tileIsCowShared( i, j ) );
+            test_assert( B(i, j).data() != A(i, j).data() );
+            test_assert( B(i, j)(0, 0) == value( i, j, 0, 0 ) );
+        }
+
+        // Writing B copies its tile; A is unchanged.
+        if (local.size() > 1) {
+            int64_t i = local[ 1 ].first, j = local[ 1 ].second;
+            B.tileGetForWriting( i, j, slate::LayoutConvert::None );
+            B(i, j).at(0, 0) = -2.0;
+            test_assert( ! B.tileIsCowShared( i, j ) );
+            test_assert( A(i, j)(0, 0) == value( i, j, 0, 0 ) );
+        }
+        for (size_t t = 2; t < local.size(); ++t)
+            test_assert( B.tileIsCowShared( local[ t ].first, local[ t ].second ) );
+    }
+
+    // Destroying A gives B its own copies of the tiles still shared.
+    for (size_t t = 0; t < local.size(); ++t) {
+        int64_t i = local[ t ].first, j = local[ t ].second;
+        test_assert( ! B.tileIsCowShared( i, j ) );
+        auto T = B(i, j);
+        for (int jj = 0; jj < T.nb(); ++jj) {
+            for (int ii = 0; ii < T.mb(); ++ii) {
+                if (t == 1 && ii == 0 && jj == 0)
+                    test_assert( T(ii, jj) == -2.0 );
+                else
+                    test_assert( T(ii, jj) == value( i, j, ii, jj ) );
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Tests insertLocalTiles with Option::HostTileArena, which puts local tiles
+/// in one arena with the same layout as a ScaLAPACK local matrix.
+void test_Matrix_insertLocalTiles_arena()
+{
+    slate::Matrix<double> A(m, n, nb, p, q, mpi_comm);
+
+    A.insertLocalTiles( slate::Target::Host,
+                        {{ slate::Option::HostTileArena, true },
+                         { slate::Option::HostFirstTouch, true }} );
+
+    double* data = A.arenaData();
+    int64_t lld = A.arenaStride();
+    int64_t mloc = 0;
+    for (int i = 0; i < A.mt(); ++i)
+        if (i % p == mpi_rank % p)
+            mloc += A.tileMb(i);
+    test_assert( lld == std::max( mloc, int64_t( 1 ) ) );
+
+    for (int j = 0; j < A.nt(); ++j) {
+        for (int i = 0; i < A.mt(); ++i) {
+            if (A.tileIsLocal(i, j)) {
+                test_assert( data != nullptr );
+                auto T = A(i, j);
+                test_assert(T.mb() == A.tileMb(i));
+                test_assert(T.nb() == A.tileNb(j));
+                test_assert(T.stride() == lld);
+                test_assert(T.origin());
+                test_assert(T.kind() == slate::TileKind::UserOwned);
+                // local block (i/p, j/q), as in a ScaLAPACK local matrix
+                test_assert(T.data() == &data[ (i/p)*nb + (j/q)*nb*lld ]);
+                for (int jj = 0; jj < T.nb(); ++jj)
+                    for (int ii = 0; ii < T.mb(); ++ii)
+                        test_assert( T(ii, jj) == 0.0 );
+            }
+        }
+    }
+
+    // a second arena is not allowed
+    test_assert_throw_std(
+        A.insertLocalTiles( slate::Target::Host,
+                            {{ slate::Option::HostTileArena, true }} ) );
+}
+
+//------------------------------------------------------------------------------
+/// Tests inserting local tiles in a memory-mapped file, and that the data
+/// persists in the file when it is mapped again.
+void test_Matrix_insertLocalTilesMapped()
+{
+    std::string filename = "test_Matrix_mapped." + std::to_string( getpid() );
+
+    {
+        slate::Matrix<double> A(m, n, mb, nb, p, q, mpi_comm);
+        A.insertLocalTilesMapped( filename );
+        A.prefetchMapped();
+        for (int j = 0; j < A.nt(); ++j) {
+            for (int i = 0; i < A.mt(); ++i) {
+                if (A.tileIsLocal(i, j)) {
+                    auto T = A(i, j);
+                    test_assert(T.kind() == slate::TileKind::FileMapped);
+                    test_assert(T.mb() == A.tileMb(i));
+                    test_assert(T.nb() == A.tileNb(j));
+                    test_assert(T.stride() == A.tileMb(i));
+                    test_assert(A.tileState(i, j) == slate::MOSI::Shared);
+                    for (int jj = 0; jj < T.nb(); ++jj)
+                        for (int ii = 0; ii < T.mb(); ++ii)
+                            T.at(ii, jj) = i + j*1000 + ii*1e-3 + jj*1e-6;
+                    A.tileFlushMapped(i, j);
+                }
+            }
+        }
+        A.syncMapped();
+    }
+
+    // Map again and read back.
+    {
+        slate::Matrix<double> A(m, n, mb, nb, p, q, mpi_comm);
+        A.insertLocalTilesMapped( filename );
+        for (int j = 0; j < A.nt(); ++j) {
+            for (int i = 0; i < A.mt(); ++i) {
+                if (A.tileIsLocal(i, j)) {
+                    auto T = A(i, j);
+                    for (int jj = 0; jj < T.nb(); ++jj)
+                        for (int ii = 0; ii < T.mb(); ++ii)
+                            test_assert( T(ii, jj)
+                                         == i + j*1000 + ii*1e-3 + jj*1e-6 );
+                }
+            }
+        }
+    }
+
+    std::remove( (filename + "." + std::to_string( mpi_rank )).c_str() );
+}
+
+//------------------------------------------------------------------------------
+/// Tests concurrent tile lookups and MOSI queries from many threads,
+/// and reports lookup throughput as the number of threads increases
+/// (with -v). Since the tiles map is sharded, lookups of different tiles
+/// should not serialize on a single lock.
+void test_Matrix_tileLookup_threads()
+{
+    int64_t nb_ = 8;
+    int64_t mt = 64, nt = 64;
+    slate::Matrix<double> A( mt*nb_, nt*nb_, nb_, p, q, mpi_comm );
+    A.insertLocalTiles();
+
+    int64_t num_local = 0;
+    for (int64_t j = 0; j < A.nt(); ++j)
+        for (int64_t i = 0; i < A.mt(); ++i)
+            num_local += A.tileIsLocal( i, j );
+
+    int max_threads = omp_get_max_threads();
+    int64_t repeat = 20;
+    double time_1 = 0;
+    for (int nthreads = 1; nthreads <= max_threads; nthreads *= 2) {
+        int64_t found = 0;
+        double time = omp_get_wtime();
+        #pragma omp parallel for num_threads( nthreads ) collapse( 2 ) \
+                    reduction( +: found ) schedule( static )
+        for (int64_t j = 0; j < A.nt(); ++j) {
+            for (int64_t i = 0; i < A.mt(); ++i) {
+                if (A.tileIsLocal( i, j )) {
+                    for (int64_t r = 0; r < repeat; ++r) {
+                        if (A.tileExists( i, j )
+                            && A.tileState( i, j ) != slate::MOSI::Invalid
+                            && ! A.tileOnHold( i, j )) {
+                            ++found;
+                        }
+                    }
+                }
+            }
+        }
+        time = omp_get_wtime() - time;
+        test_assert( found == num_local * repeat );
+
+        if (nthreads == 1)
+            time_1 = time;
+        if (verbose && mpi_rank == 0) {
+            double rate = 3 * found / time;  // 3 lookups per iteration
+            printf( "\n    threads %3d, %10.3e lookups/sec, speedup %6.2f",
+                    nthreads, rate, time_1 / time );
+        }
+    }
+    if (verbose && mpi_rank == 0)
+        printf( "\n" );
+}
+
+//------------------------------------------------------------------------------
+/// Tests tileLocalRows matches tileIsLocal and tileDevice, on the full
+/// matrix and on a submatrix, whose local rows share the cached list.
+void test_Matrix_tileLocalRows()
+{
+    slate::Matrix<double> A( m, n, nb, p, q, mpi_comm );
+    int64_t i1 = std::min( int64_t( 1 ), A.mt()-1 );
+    int64_t j1 = std::min( int64_t( 1 ), A.nt()-1 );
+    auto Asub = A.sub( i1, A.mt()-1, j1, A.nt()-1 );
+
+    for (auto* M : { &A, &Asub }) {
+        for (int device = slate::HostNum; device < num_devices; ++device) {
+            for (int64_t j = 0; j < M->nt(); ++j) {
+                // Two ranges, so the second extends the cached list.
+                int64_t ihalf = M->mt() / 2;
+                std::vector<int64_t> rows;
+                M->tileLocalRows( j, 0, ihalf, device, rows );
+                M->tileLocalRows( j, ihalf, M->mt(), device, rows );
+
+                std::vector<int64_t> expect;
+                for (int64_t i = 0; i < M->mt(); ++i) {
+                    if (M->tileIsLocal( i, j ) && M->tileDevice( i, j ) == device)
+                        expect.push_back( i );
+                }
+                test_assert( rows == expect );
+            }
+        }
+    }
+}
+
 //------------------------------------------------------------------------------
 /// Tests Matrix(), mt, nt, op, insertLocalTiles on devices.
 void test_Matrix_insertLocalTiles_dev()
@@ -1125,6 +1533,115 @@ void test_Matrix_allocateBatchArrays()
     }
 }
 
+//------------------------------------------------------------------------------
+/// Test batchArrayUpload skips uploading unchanged batch arrays.
+///
+void test_Matrix_batchArrayUpload()
+{
+    if (num_devices == 0) {
+        test_skip("requires num_devices > 0");
+    }
+
+    auto A = slate::Matrix<double>( m, n, nb, p, q, mpi_comm );
+    A.insertLocalTiles();
+
+    const int64_t batch_size = 4;
+    A.allocateBatchArrays( batch_size );
+
+    std::vector<double> data( 2*batch_size );
+    for (int device = 0; device < num_devices; ++device) {
+        blas::Queue* queue = A.comm_queue( device );
+        double** array_host = A.array_host( device );
+        for (int64_t k = 0; k < batch_size; ++k)
+            array_host[ k ] = &data[ k ];
+
+        // first upload copies; same again is skipped
+        test_assert(   A.batchArrayUpload( device, 0, array_host, batch_size, *queue ) );
+        test_assert( ! A.batchArrayUpload( device, 0, array_host, batch_size, *queue ) );
+        test_assert( ! A.batchArrayUpload( device, 0, array_host, 2, *queue ) );
+
+        // changed entry copies
+        array_host[ 1 ] = &data[ batch_size ];
+        test_assert(   A.batchArrayUpload( device, 0, array_host, batch_size, *queue ) );
+
+        // device holds the latest pointers
+        std::vector<double*> check( batch_size );
+        blas::device_memcpy<double*>(
+            check.data(), A.array_device( device ), batch_size,
+            blas::MemcpyKind::DeviceToHost, *queue );
+        queue->sync();
+        for (int64_t k = 0; k < batch_size; ++k)
+            test_assert( check[ k ] == array_host[ k ] );
+
+        // entries past a gap are not recorded, so are uploaded each time
+        test_assert( A.batchArrayUpload( device, 0, array_host, 1, *queue,
+                                         2*batch_size ) );
+        test_assert( A.batchArrayUpload( device, 0, array_host, 1, *queue,
+                                         2*batch_size ) );
+    }
+
+    // reallocating forgets uploads
+    A.clearBatchArrays();
+    A.allocateBatchArrays( batch_size );
+    for (int device = 0; device < num_devices; ++device) {
+        double** array_host = A.array_host( device );
+        for (int64_t k = 0; k < batch_size; ++k)
+            array_host[ k ] = &data[ k ];
+        test_assert( A.batchArrayUpload( device, 0, array_host, batch_size,
+                                         *A.comm_queue( device ) ) );
+    }
+    A.clearBatchArrays();
+}
+
+//------------------------------------------------------------------------------
+/// Test memoryStats and resetMemoryPeak, which count batch arrays and
+/// workspace.
+///
+void test_Matrix_memoryStats()
+{
+    if (num_devices == 0) {
+        test_skip("requires num_devices > 0");
+    }
+
+    auto A = slate::Matrix<double>( m, n, nb, p, q, mpi_comm );
+
+    for (int device = 0; device < num_devices; ++device) {
+        test_assert( A.memoryStats( device ).current() == 0 );
+    }
+
+    // batch arrays of 20 entries, 3 arrays each, on host and each device
+    size_t batch_bytes = sizeof(double*) * 20 * 3;
+    A.allocateBatchArrays( 20 );
+    test_assert( A.memoryStats( HostNum ).external == num_devices * batch_bytes );
+    for (int device = 0; device < num_devices; ++device) {
+        slate::MemoryStats stats = A.memoryStats( device );
+        test_assert( stats.external  == batch_bytes );
+        test_assert( stats.current() == batch_bytes );
+        test_assert( stats.peak      == batch_bytes );
+    }
+
+    // device workspace is reserved memory
+    A.reserveDeviceWorkspace();
+    size_t tile_bytes = sizeof(double) * nb * nb;
+    for (int device = 0; device < num_devices; ++device) {
+        slate::MemoryStats stats = A.memoryStats( device );
+        test_assert( stats.reserved == A.getMaxDeviceTiles() * tile_bytes );
+        test_assert( stats.peak     == stats.current() );
+    }
+
+    // clearing lowers current use, but not the peak until reset
+    A.clearWorkspace();
+    A.clearBatchArrays();
+    for (int device = 0; device < num_devices; ++device) {
+        slate::MemoryStats stats = A.memoryStats( device );
+        test_assert( stats.current() == 0 );
+        test_assert( stats.peak >= batch_bytes );
+
+        A.resetMemoryPeak( device );
+        test_assert( A.memoryStats( device ).peak == 0 );
+    }
+}
+
 //==============================================================================
 // Sub-matrices
 
@@ -1590,6 +2107,44 @@ void test_Matrix_sub_Matrix()
     }
 }
 
+//------------------------------------------------------------------------------
+/// Tests dropStorageOwnership: a non-owning view and its sub-matrices
+/// share the tiles of the original, without owning the storage.
+void test_Matrix_sub_nonowning()
+{
+    int lda = roundup(m, mb);
+    std::vector<double> Ad( lda*n );
+    auto A = slate::Matrix<double>::fromLAPACK(
+        m, n, Ad.data(), lda, mb, nb, p, q, mpi_comm );
+    test_assert( A.ownsStorage() );
+
+    auto V = A;
+    V.dropStorageOwnership();
+    test_assert( ! V.ownsStorage() );
+    test_assert( A.ownsStorage() );
+
+    int i1 = rand() % A.mt();
+    int i2 = rand() % A.mt();
+    int j1 = rand() % A.nt();
+    int j2 = rand() % A.nt();
+    if (i1 > i2)
+        std::swap(i1, i2);
+    if (j1 > j2)
+        std::swap(j1, j2);
+
+    auto Vsub = V.sub(i1, i2, j1, j2);
+    test_assert( ! Vsub.ownsStorage() );
+    test_assert(Vsub.mt() == i2 - i1 + 1);
+    test_assert(Vsub.nt() == j2 - j1 + 1);
+    for (int j = 0; j < Vsub.nt(); ++j) {
+        for (int i = 0; i < Vsub.mt(); ++i) {
+            if (Vsub.tileIsLocal(i, j)) {
+                test_assert(Vsub(i, j).data() == A(i + i1, j + j1).data());
+            }
+        }
+    }
+}
+
 //==============================================================================
 // Communication
 
@@ -1635,6 +2190,67 @@ void test_tileSend_tileRecv()
     }
 }
 
+//------------------------------------------------------------------------------
+/// Test that a tile valid only on a device is sent and received on the
+/// device with GPU-aware MPI, and through host memory otherwise, as counted
+/// by hostStagedBytes.
+void test_tileSend_gpu_aware()
+{
+    if (num_devices == 0) {
+        test_skip("requires num_devices > 0");
+    }
+    if (mpi_size <= 1) {
+        test_skip("requires mpi_size > 1");
+    }
+
+    int lda = roundup(m, nb);
+    std::vector<double> Ad( lda*n );
+
+    auto A = slate::Matrix<double>::fromLAPACK(
+        m, n, Ad.data(), lda, nb, p, q, mpi_comm );
+
+    bool gpu_aware_save = slate::gpu_aware_mpi();
+    int64_t tile_bytes = A.tileMb( 0 ) * A.tileNb( 0 ) * sizeof(double);
+    int src = A.tileRank( 0, 0 );
+    int dst = (src + 1) % mpi_size;
+    int device = A.tileDevice( 0, 0 );
+
+    for (bool gpu_aware : { false, true }) {
+        slate::gpu_aware_mpi( gpu_aware );
+        slate::internal::resetHostStagedBytes();
+        double value = 1000. + gpu_aware;
+
+        if (mpi_rank == src) {
+            // Leave the only valid instance on the device.
+            A.tileGetForWriting( 0, 0, slate::LayoutConvert::None );
+            A( 0, 0 ).at( 0, 0 ) = value;
+            A.tileGetForWriting( 0, 0, device, slate::LayoutConvert::None );
+            test_assert( A.tileState( 0, 0 ) == slate::MOSI::Invalid );
+
+            A.tileSend( 0, 0, dst );
+            test_assert( slate::internal::hostStagedBytes()
+                         == (gpu_aware ? 0 : tile_bytes) );
+            test_assert( (A.tileState( 0, 0 ) == slate::MOSI::Invalid)
+                         == gpu_aware );
+        }
+        else if (mpi_rank == dst) {
+            MPI_Request request;
+            A.tileIrecv<slate::Target::Devices>( 0, 0, src, A.layout(), 0,
+                                                 &request );
+            MPI_Wait( &request, MPI_STATUS_IGNORE );
+            test_assert( slate::internal::hostStagedBytes()
+                         == (gpu_aware ? 0 : tile_bytes) );
+            test_assert( A.tileExists( 0, 0, device ) == gpu_aware );
+
+            A.tileGetForReading( 0, 0, slate::LayoutConvert::None );
+            test_assert( A( 0, 0 )( 0, 0 ) == value );
+            A.tileErase( 0, 0, slate::AllDevices );
+        }
+    }
+
+    slate::gpu_aware_mpi( gpu_aware_save );
+}
+
 //------------------------------------------------------------------------------
 void test_releaseRemoteWorkspace()
 {
@@ -1703,15 +2319,63 @@ void test_releaseRemoteWorkspace()
     test_assert_all_ranks( A.tileExists( 0, 0 ) == is_rank_0, mpi_comm );
 }
 
-
-//==============================================================================
-// tile MOSI & Layout conversion
-
 //------------------------------------------------------------------------------
-/// compare tiles data.
-void test_Tile_compare_layout(slate::Tile<double> const& Atile,
-                              slate::Tile<double> const& Btile,
-                              bool same_layout)
+/// Test that tileGetRemote fetches every remote tile through the RMA window,
+/// with the owners not taking part.
+void test_Matrix_rma()
+{
+    int lda = roundup(m, mb);
+    std::vector<double> Ad( lda*n );
+    auto A = slate::Matrix<double>::fromLAPACK(
+        m, n, Ad.data(), lda, mb, nb, p, q, mpi_comm );
+
+    for (int j = 0; j < A.nt(); ++j) {
+        for (int i = 0; i < A.mt(); ++i) {
+            if (A.tileIsLocal(i, j)) {
+                auto T = A(i, j);
+                T.at(0, 0) = i + j/1000.;
+                T.at(T.mb()-1, T.nb()-1) = -(i + j/1000.);
+            }
+        }
+    }
+
+    A.rmaOpen();
+    test_assert( A.rmaActive() );
+
+    // Fetch tiles in reverse order, unlike any send/recv pattern.
+    for (int j = A.nt()-1; j >= 0; --j) {
+        for (int i = A.mt()-1; i >= 0; --i) {
+            A.tileGetRemote(i, j);
+            auto T = A(i, j);
+            test_assert( T(0, 0) == i + j/1000. );
+            test_assert( T(T.mb()-1, T.nb()-1) == -(i + j/1000.) );
+        }
+    }
+
+    // Sub-matrices share the window.
+    if (A.mt() > 1 && A.nt() > 1) {
+        auto B = A.sub(1, A.mt()-1, 1, A.nt()-1);
+        test_assert( B.rmaActive() );
+        if (! B.tileIsLocal(0, 0)) {
+            A.tileErase(1, 1);
+            B.tileGetRemote(0, 0);
+            test_assert( B(0, 0)(0, 0) == 1 + 1/1000. );
+        }
+    }
+
+    A.rmaClose();
+    test_assert( ! A.rmaActive() );
+}
+
+
+//==============================================================================
+// tile MOSI & Layout conversion
+
+//------------------------------------------------------------------------------
+/// compare tiles data.
+void test_Tile_compare_layout(slate::Tile<double> const& Atile,
+                              slate::Tile<double> const& Btile,
+                              bool same_layout)
 {
     test_assert( (Atile.layout() == Btile.layout()) == same_layout );
 
@@ -1883,6 +2547,639 @@ void test_Matrix_MOSI()
     }
 }
 
+//------------------------------------------------------------------------------
+/// Test using device memory as an LRU tile cache.
+/// Modified tiles must be written back to host when evicted.
+void test_Matrix_tileCache()
+{
+    if (num_devices == 0) {
+        test_skip("requires num_devices > 0");
+    }
+
+    int lda = roundup(m, nb);
+    std::vector<double> Ad( lda*n );
+
+    int64_t iseed[4] = { 0, 1, 2, 3 };
+    lapack::larnv( 1, iseed, Ad.size(), Ad.data() );
+
+    auto A = slate::Matrix<double>::fromLAPACK(
+        m, n, Ad.data(), lda, nb, p, q, mpi_comm );
+
+    const int cache_tiles = 2;
+    const int device = 0;
+    A.enableTileCache( cache_tiles );
+
+    // Write to every local tile on device, marking its (0, 0) element.
+    int64_t num_local = 0;
+    for (int j = 0; j < A.nt(); ++j) {
+        for (int i = 0; i < A.mt(); ++i) {
+            if (A.tileIsLocal(i, j)) {
+                A.tileGetForWriting( i, j, device, slate::LayoutConvert::None );
+                double mark = -(i + j*A.mt()) - 1;
+                blas::device_copy_vector( 1, &mark, 1, A(i, j, device).data(), 1,
+                                          *A.comm_queue( device ) );
+                A.comm_queue( device )->sync();
+                ++num_local;
+
+                int64_t on_device = 0;
+                for (int jj = 0; jj < A.nt(); ++jj)
+                    for (int ii = 0; ii < A.mt(); ++ii)
+                        on_device += A.tileExists( ii, jj, device );
+                test_assert( on_device <= cache_tiles );
+            }
+        }
+    }
+
+    slate::TileCacheStats stats = A.tileCacheStats( device );
+    int64_t evicted = std::max( num_local - cache_tiles, int64_t( 0 ) );
+    test_assert( stats.hits       == 0 );
+    test_assert( stats.misses     == num_local );
+    test_assert( stats.evictions  == evicted );
+    test_assert( stats.writebacks == evicted );
+
+    // Reading a cached tile again is a hit.
+    if (num_local > 0) {
+        for (int j = A.nt()-1; j >= 0; --j) {
+            for (int i = A.mt()-1; i >= 0; --i) {
+                if (A.tileIsLocal(i, j) && A.tileExists( i, j, device )) {
+                    A.tileGetForReading( i, j, device, slate::LayoutConvert::None );
+                    test_assert( A.tileCacheStats( device ).hits == 1 );
+                    i = -1;
+                    j = -1;
+                }
+            }
+        }
+    }
+
+    // Host has every mark, whether written back or copied now.
+    A.tileUpdateAllOrigin();
+    for (int j = 0; j < A.nt(); ++j) {
+        for (int i = 0; i < A.mt(); ++i) {
+            if (A.tileIsLocal(i, j)) {
+                double mark = -(i + j*A.mt()) - 1;
+                test_assert( A(i, j)(0, 0) == mark );
+            }
+        }
+    }
+
+    A.disableTileCache();
+    A.releaseWorkspace();
+}
+
+//------------------------------------------------------------------------------
+/// Test evicting device tiles during gemm with lookahead, whose tasks use
+/// tiles on the device concurrently. Tiles in use by kernels must not be
+/// evicted, so the result matches gemm on host.
+void test_Matrix_tileCache_gemm()
+{
+    if (num_devices == 0) {
+        test_skip("requires num_devices > 0");
+    }
+
+    auto random = [&]( int64_t mm, int64_t nn, int64_t seed ) {
+        slate::Matrix<double> X( mm, nn, nb, p, q, mpi_comm );
+        X.insertLocalTiles();
+        for (int64_t j = 0; j < X.nt(); ++j) {
+            for (int64_t i = 0; i < X.mt(); ++i) {
+                if (X.tileIsLocal( i, j )) {
+                    auto T = X( i, j );
+                    int64_t iseed[4] = { seed, i % 4096, j % 4096, 1 };
+                    for (int64_t tj = 0; tj < T.nb(); ++tj)
+                        lapack::larnv( 2, iseed, T.mb(), &T.at( 0, tj ) );
+                }
+            }
+        }
+        return X;
+    };
+    auto A = random( m, n, 1 );
+    auto B = random( n, n, 2 );
+    auto C = random( m, n, 3 );
+    auto C_ref = C.emptyLike();
+    C_ref.insertLocalTiles();
+    slate::copy( C, C_ref );
+
+    slate::gemm( 1.0, A, B, 0.5, C_ref );
+
+    const int64_t cache_tiles = 4;
+    slate::gemm( 1.0, A, B, 0.5, C, {
+        { slate::Option::Target, slate::Target::Devices },
+        { slate::Option::MethodGemm, slate::MethodGemm::C },
+        { slate::Option::Lookahead, 2 },
+        { slate::Option::DeviceCacheTiles, cache_tiles },
+    } );
+
+    int64_t evictions = 0;
+    for (int device = 0; device < num_devices; ++device) {
+        evictions += A.tileCacheStats( device ).evictions
+                   + B.tileCacheStats( device ).evictions
+                   + C.tileCacheStats( device ).evictions;
+    }
+    int64_t local_tiles = 0;
+    for (int64_t j = 0; j < C.nt(); ++j)
+        for (int64_t i = 0; i < C.mt(); ++i)
+            local_tiles += C.tileIsLocal( i, j );
+    if (local_tiles > num_devices * cache_tiles)
+        test_assert( evictions > 0 );
+
+    double C_norm = slate::norm( slate::Norm::Max, C_ref );
+    slate::add( -1.0, C_ref, 1.0, C );
+    double diff = slate::norm( slate::Norm::Max, C );
+    double eps = std::numeric_limits<double>::epsilon();
+    test_assert( diff <= 10 * n * eps * C_norm );
+}
+
+//------------------------------------------------------------------------------
+/// Tests MOSI coherence counters: hits, copies each way, and invalidations.
+/// Requires SLATE compiled with SLATE_COHERENCE_COUNTERS.
+void test_Matrix_coherenceStats()
+{
+#if ! defined( SLATE_COHERENCE_COUNTERS )
+    test_skip("requires SLATE_COHERENCE_COUNTERS");
+#endif
+
+    int lda = roundup(m, nb);
+    std::vector<double> Ad( lda*n );
+
+    int64_t iseed[4] = { 0, 1, 2, 3 };
+    lapack::larnv( 1, iseed, Ad.size(), Ad.data() );
+
+    auto A = slate::Matrix<double>::fromLAPACK(
+        m, n, Ad.data(), lda, nb, p, q, mpi_comm );
+
+    // Origin tiles are valid on host, so reading them there is a hit.
+    int64_t num_local = 0;
+    for (int j = 0; j < A.nt(); ++j) {
+        for (int i = 0; i < A.mt(); ++i) {
+            if (A.tileIsLocal(i, j)) {
+                A.tileGetForReading( i, j, slate::HostNum,
+                                     slate::LayoutConvert::None );
+                ++num_local;
+            }
+        }
+    }
+    slate::CoherenceStats stats = A.coherenceStats();
+    test_assert( stats.hits          == num_local );
+    test_assert( stats.to_device     == 0 );
+    test_assert( stats.to_host       == 0 );
+    test_assert( stats.invalidations == 0 );
+
+    if (num_devices > 0) {
+        // Writing on device copies each tile there and invalidates host;
+        // reading on host copies it back.
+        A.coherenceResetStats();
+        for (int j = 0; j < A.nt(); ++j) {
+            for (int i = 0; i < A.mt(); ++i) {
+                if (A.tileIsLocal(i, j)) {
+                    A.tileGetForWriting( i, j, A.tileDevice( i, j ),
+                                         slate::LayoutConvert::None );
+                    A.tileGetForReading( i, j, slate::HostNum,
+                                         slate::LayoutConvert::None );
+                }
+            }
+        }
+        stats = A.coherenceStats();
+        test_assert( stats.hits          == 0 );
+        test_assert( stats.to_device     == num_local );
+        test_assert( stats.to_host       == num_local );
+        test_assert( stats.invalidations == num_local );
+        A.releaseWorkspace();
+    }
+
+    A.coherenceResetStats();
+    test_assert( A.coherenceStats().hits == 0 );
+}
+
+//------------------------------------------------------------------------------
+/// Tests tileGetForReadingAsync and tilePrefetch: copies are queued and
+/// complete after waiting on the token.
+void test_Matrix_tileGetForReadingAsync()
+{
+    if (num_devices == 0) {
+        test_skip("requires num_devices > 0");
+    }
+
+    int lda = roundup(m, nb);
+    std::vector<double> Ad( lda*n );
+
+    int64_t iseed[4] = { 0, 1, 2, 3 };
+    lapack::larnv( 1, iseed, Ad.size(), Ad.data() );
+
+    auto A = slate::Matrix<double>::fromLAPACK(
+        m, n, Ad.data(), lda, nb, p, q, mpi_comm );
+
+    for (int device = 0; device < num_devices; ++device) {
+        std::set< std::tuple<int64_t, int64_t> > tile_set;
+        for (int j = 0; j < A.nt(); ++j) {
+            for (int i = 0; i < A.mt(); ++i) {
+                if (A.tileIsLocal(i, j) && A.tileDevice(i, j) == device)
+                    tile_set.insert( { i, j } );
+            }
+        }
+
+        slate::TileGetToken token = (device % 2 == 0
+            ? A.tileGetForReadingAsync( tile_set, device, slate::LayoutConvert::None )
+            : A.tilePrefetch( tile_set, device ));
+        test_assert( token.pending() );
+        token.wait();
+        test_assert( ! token.pending() );
+        token.wait();  // no-op
+
+        for (auto ij : tile_set) {
+            int64_t i = std::get<0>( ij );
+            int64_t j = std::get<1>( ij );
+            test_assert( A.tileExists( i, j, device ) );
+            test_assert( A.tileState( i, j, device ) == slate::MOSI::Shared );
+
+            auto T = A( i, j, device );
+            std::vector<double> Td( T.mb() * T.nb() );
+            blas::device_memcpy_2d<double>(
+                Td.data(), T.mb(), T.data(), T.stride(), T.mb(), T.nb(),
+                blas::MemcpyKind::DeviceToHost, *A.comm_queue( device ) );
+            A.comm_queue( device )->sync();
+
+            auto H = A( i, j );
+            for (int jj = 0; jj < T.nb(); ++jj)
+                for (int ii = 0; ii < T.mb(); ++ii)
+                    test_assert( Td[ ii + jj*T.mb() ] == H( ii, jj ) );
+        }
+    }
+
+    // host token is already complete
+    if (A.tileIsLocal( 0, 0 )) {
+        slate::TileGetToken token = A.tileGetForReadingAsync(
+            0, 0, HostNum, slate::LayoutConvert::None );
+        test_assert( ! token.pending() );
+    }
+
+    A.releaseWorkspace();
+}
+
+//------------------------------------------------------------------------------
+/// Test listBcastPacked sends block column 0 across the block rows, and
+/// received tiles match the original data.
+void test_Matrix_listBcastPacked()
+{
+    int lda = roundup(m, nb);
+    std::vector<double> Ad( lda*n );
+
+    // Same data on all ranks, to check received tiles.
+    int64_t iseed[4] = { 0, 1, 2, 3 };
+    lapack::larnv( 1, iseed, Ad.size(), Ad.data() );
+
+    auto A = slate::Matrix<double>::fromLAPACK(
+        m, n, Ad.data(), lda, nb, p, q, mpi_comm );
+
+    for (int k = 0; k < std::min( int64_t( 2 ), A.nt() ); ++k) {
+        // Even k uses BcastList, odd k uses BcastListTag.
+        slate::Matrix<double>::BcastList bcast_list;
+        slate::Matrix<double>::BcastListTag bcast_list_tag;
+        for (int i = 0; i < A.mt(); ++i) {
+            bcast_list.push_back( { i, k, { A.sub( i, i, 0, A.nt()-1 ) } } );
+            bcast_list_tag.push_back( { i, k, { A.sub( i, i, 0, A.nt()-1 ) }, i } );
+        }
+        if (k % 2 == 0)
+            A.listBcastPacked( bcast_list, slate::Layout::ColMajor );
+        else
+            A.listBcastPacked( bcast_list_tag, slate::Layout::ColMajor );
+
+        for (int i = 0; i < A.mt(); ++i) {
+            bool in_row = false;
+            for (int j = 0; j < A.nt(); ++j)
+                in_row = in_row || A.tileIsLocal( i, j );
+            if (! in_row)
+                continue;
+
+            test_assert( A.tileExists( i, k ) );
+            auto T = A( i, k );
+            for (int jj = 0; jj < T.nb(); ++jj)
+                for (int ii = 0; ii < T.mb(); ++ii)
+                    test_assert( T( ii, jj ) == Ad[ i*nb + ii + (k*nb + jj)*lda ] );
+        }
+    }
+
+    if (num_devices > 0) {
+        int k = A.nt() - 1;
+        slate::Matrix<double>::BcastList bcast_list;
+        for (int i = 0; i < A.mt(); ++i)
+            bcast_list.push_back( { i, k, { A.sub( i, i, 0, A.nt()-1 ) } } );
+        A.listBcastPacked<slate::Target::Devices>(
+            bcast_list, slate::Layout::ColMajor );
+
+        for (int i = 0; i < A.mt(); ++i) {
+            for (int j = 0; j < A.nt(); ++j) {
+                if (A.tileIsLocal( i, j ))
+                    test_assert( A.tileExists( i, k, A.tileDevice( i, j ) ) );
+            }
+        }
+    }
+
+    A.releaseWorkspace();
+}
+
+//------------------------------------------------------------------------------
+/// Test listBcast of root tiles valid only on devices without GPU-aware MPI,
+/// which stages them through host buffers.
+void test_Matrix_listBcast_staged()
+{
+    if (num_devices == 0) {
+        test_skip("requires num_devices > 0");
+    }
+
+    int lda = roundup(m, nb);
+    std::vector<double> Ad( lda*n );
+
+    // Same data on all ranks, to check received tiles.
+    int64_t iseed[4] = { 0, 1, 2, 3 };
+    lapack::larnv( 1, iseed, Ad.size(), Ad.data() );
+
+    auto A = slate::Matrix<double>::fromLAPACK(
+        m, n, Ad.data(), lda, nb, p, q, mpi_comm );
+
+    bool gpu_aware_save = slate::gpu_aware_mpi();
+    slate::gpu_aware_mpi( false );
+
+    // Leave the only valid instances of block column k on the devices.
+    int k = 0;
+    int64_t staged_bytes = 0;
+    for (int i = 0; i < A.mt(); ++i) {
+        if (A.tileIsLocal( i, k )) {
+            A.tileGetForWriting( i, k, A.tileDevice( i, k ),
+                                 slate::LayoutConvert::None );
+            test_assert( A.tileState( i, k ) == slate::MOSI::Invalid );
+            bool has_dst = false;
+            for (int j = 0; j < A.nt(); ++j)
+                has_dst = has_dst || A.tileRank( i, j ) != mpi_rank;
+            if (has_dst)
+                staged_bytes += A.tileMb( i ) * A.tileNb( k ) * sizeof(double);
+        }
+    }
+
+    slate::internal::resetHostStagedBytes();
+    slate::Matrix<double>::BcastList bcast_list;
+    for (int i = 0; i < A.mt(); ++i)
+        bcast_list.push_back( { i, k, { A.sub( i, i, 0, A.nt()-1 ) } } );
+    A.listBcast( bcast_list, slate::Layout::ColMajor );
+
+    for (int i = 0; i < A.mt(); ++i) {
+        bool in_row = false;
+        for (int j = 0; j < A.nt(); ++j)
+            in_row = in_row || A.tileIsLocal( i, j );
+        if (! in_row)
+            continue;
+
+        if (A.tileIsLocal( i, k )) {
+            // The host instance stays invalid; the tile was staged.
+            test_assert( A.tileState( i, k ) == slate::MOSI::Invalid );
+            A.tileGetForReading( i, k, slate::LayoutConvert::None );
+        }
+        auto T = A( i, k );
+        for (int jj = 0; jj < T.nb(); ++jj)
+            for (int ii = 0; ii < T.mb(); ++ii)
+                test_assert( T( ii, jj ) == Ad[ i*nb + ii + (k*nb + jj)*lda ] );
+    }
+    test_assert( slate::internal::hostStagedBytes() == staged_bytes );
+
+    slate::gpu_aware_mpi( gpu_aware_save );
+    A.releaseWorkspace();
+}
+
+//------------------------------------------------------------------------------
+/// Test a workspace session keeps broadcast tiles across releaseWorkspace,
+/// serves a later broadcast of them, and releases them when it ends.
+void test_Matrix_workspaceSession()
+{
+    int lda = roundup(m, nb);
+    std::vector<double> Ad( lda*n );
+
+    // Same data on all ranks, to check received tiles.
+    int64_t iseed[4] = { 0, 1, 2, 3 };
+    lapack::larnv( 1, iseed, Ad.size(), Ad.data() );
+
+    auto A = slate::Matrix<double>::fromLAPACK(
+        m, n, Ad.data(), lda, nb, p, q, mpi_comm );
+
+    test_assert( ! A.workspaceSessionActive() );
+    A.beginWorkspaceSession();
+    A.beginWorkspaceSession();  // nested
+    test_assert( A.workspaceSessionActive() );
+
+    // Twice: the second broadcast is served by the kept tiles.
+    for (int pass = 0; pass < 2; ++pass) {
+        slate::Matrix<double>::BcastList bcast_list;
+        for (int i = 0; i < A.mt(); ++i)
+            bcast_list.push_back( { i, 0, { A.sub( i, i, 0, A.nt()-1 ) } } );
+        A.listBcast( bcast_list, slate::Layout::ColMajor );
+        A.releaseWorkspace();
+
+        for (int i = 0; i < A.mt(); ++i) {
+            bool in_row = false;
+            for (int j = 0; j < A.nt(); ++j)
+                in_row = in_row || A.tileIsLocal( i, j );
+            if (! in_row)
+                continue;
+
+            test_assert( A.tileExists( i, 0 ) );
+            auto T = A( i, 0 );
+            for (int jj = 0; jj < T.nb(); ++jj)
+                for (int ii = 0; ii < T.mb(); ++ii)
+                    test_assert( T( ii, jj ) == Ad[ i*nb + ii + jj*lda ] );
+        }
+    }
+
+    A.endWorkspaceSession();
+    test_assert( A.workspaceSessionActive() );
+    A.endWorkspaceSession();
+    test_assert( ! A.workspaceSessionActive() );
+
+    // Remote tiles are released when the outermost session ends.
+    for (int i = 0; i < A.mt(); ++i) {
+        if (! A.tileIsLocal( i, 0 ))
+            test_assert( ! A.tileExists( i, 0 ) );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Test structurally zero tiles: marking through views, and skipping them
+/// in listBcast.
+void test_Matrix_zeroTiles()
+{
+    int lda = roundup(m, nb);
+    std::vector<double> Ad( lda*n, 0.0 );
+    auto A = slate::Matrix<double>::fromLAPACK(
+        m, n, Ad.data(), lda, nb, p, q, mpi_comm );
+
+    test_assert( ! A.zeroTilesTracked() );
+    test_assert( ! A.tileIsZero( 0, 0 ) );
+
+    if (A.mt() < 2 || A.nt() < 2) {
+        test_skip( "requires mt, nt >= 2" );
+    }
+
+    // Marking a tile enables tracking, shared by views.
+    A.tileSetZero( 1, 0 );
+    test_assert( A.zeroTilesTracked() );
+    test_assert( A.tileIsZero( 1, 0 ) );
+    test_assert( ! A.tileIsZero( 0, 1 ) );
+
+    auto AT = transpose( A );
+    test_assert( AT.zeroTilesTracked() );
+    test_assert( AT.tileIsZero( 0, 1 ) );
+
+    auto Asub = A.sub( 1, A.mt()-1, 0, 0 );
+    test_assert( Asub.tileIsZero( 0, 0 ) );
+
+    // Send column 0 across the rows; zero tile (1, 0) is not sent.
+    slate::Matrix<double>::BcastList bcast_list;
+    for (int i = 0; i < A.mt(); ++i)
+        bcast_list.push_back( { i, 0, { A.sub( i, i, 0, A.nt()-1 ) } } );
+    A.listBcast( bcast_list, slate::Layout::ColMajor );
+
+    for (int i = 0; i < A.mt(); ++i) {
+        bool in_row = false;
+        for (int j = 0; j < A.nt(); ++j)
+            in_row = in_row || A.tileIsLocal( i, j );
+        if (! in_row || A.tileIsLocal( i, 0 ))
+            continue;
+
+        if (A.tileIsZero( i, 0 ))
+            test_assert( ! A.tileExists( i, 0 ) );
+        else
+            test_assert( A.tileExists( i, 0 ) );
+    }
+    A.releaseRemoteWorkspace();
+
+    A.tileSetZero( 1, 0, false );
+    test_assert( ! A.tileIsZero( 1, 0 ) );
+    test_assert( A.zeroTilesTracked() );
+
+    // Disabling tracking forgets zero tiles.
+    A.tileSetZero( 0, 1 );
+    A.trackZeroTiles( false );
+    test_assert( ! A.zeroTilesTracked() );
+    test_assert( ! A.tileIsZero( 0, 1 ) );
+}
+
+//------------------------------------------------------------------------------
+/// Test listBcastPacked with tiles sent in lower precision.
+void test_Matrix_listBcastPacked_precision()
+{
+    // bfloat16 rounds to nearest even, with 7 fraction bits.
+    double x[] = { 1 + 0x1p-8, 1 + 3*0x1p-8, -2 - 0x1p-7 - 0x1p-10, 0x1p-130 };
+    double y[] = { 1,          1 + 0x1p-6,   -2 - 0x1p-6,           0x1p-130 };
+    uint16_t wire[ 4 ];
+    double z[ 4 ];
+    slate::internal::wirePack( slate::BcastPrecision::BFloat16, 2, 2,
+                               x, 2, wire );
+    slate::internal::wireUnpack( slate::BcastPrecision::BFloat16, 2, 2,
+                                 wire, z, 2 );
+    for (int i = 0; i < 4; ++i)
+        test_assert( z[ i ] == y[ i ] );
+
+    // Half rounds to nearest even, with 10 fraction bits, and has
+    // subnormals below 2^-14 and overflows above 65504.
+    double xh[] = { 1 + 0x1p-11, 1 + 3*0x1p-11, 3*0x1p-26, 65520 };
+    double yh[] = { 1,           1 + 0x1p-9,    0x1p-24,   INFINITY };
+    slate::internal::wirePack( slate::BcastPrecision::Half, 2, 2,
+                               xh, 2, wire );
+    slate::internal::wireUnpack( slate::BcastPrecision::Half, 2, 2,
+                                 wire, z, 2 );
+    for (int i = 0; i < 4; ++i)
+        test_assert( z[ i ] == yh[ i ] );
+
+    int lda = roundup(m, nb);
+    std::vector<double> Ad( lda*n );
+
+    // Same data on all ranks, to check received tiles.
+    int64_t iseed[4] = { 0, 1, 2, 3 };
+    lapack::larnv( 1, iseed, Ad.size(), Ad.data() );
+
+    for (auto precision : { slate::BcastPrecision::Single,
+                            slate::BcastPrecision::BFloat16,
+                            slate::BcastPrecision::Half }) {
+        auto A = slate::Matrix<double>::fromLAPACK(
+            m, n, Ad.data(), lda, nb, p, q, mpi_comm );
+
+        int k = 0;
+        slate::Matrix<double>::BcastList bcast_list;
+        for (int i = 0; i < A.mt(); ++i)
+            bcast_list.push_back( { i, k, { A.sub( i, i, 0, A.nt()-1 ) } } );
+        A.listBcastPacked( bcast_list, slate::Layout::ColMajor, 0, false,
+                           precision );
+
+        for (int i = 0; i < A.mt(); ++i) {
+            bool in_row = false;
+            for (int j = 0; j < A.nt(); ++j)
+                in_row = in_row || A.tileIsLocal( i, j );
+            if (! in_row)
+                continue;
+
+            // Root keeps its tile; receivers get rounded copies.
+            auto T = A( i, k );
+            for (int jj = 0; jj < T.nb(); ++jj) {
+                for (int ii = 0; ii < T.mb(); ++ii) {
+                    double a = Ad[ i*nb + ii + (k*nb + jj)*lda ];
+                    double t = T( ii, jj );
+                    if (A.tileIsLocal( i, k ))
+                        test_assert( t == a );
+                    else if (precision == slate::BcastPrecision::Single)
+                        test_assert( t == double( float( a ) ) );
+                    else if (precision == slate::BcastPrecision::Half) {
+                        // larnv dist 1 is in [0, 1), so no overflow.
+                        test_assert( std::abs( t - a ) <= 0x1p-11 );
+                    }
+                    else {
+                        float tf = float( t );
+                        uint32_t bits;
+                        std::memcpy( &bits, &tf, sizeof(bits) );
+                        test_assert( (bits & 0xffff) == 0 );
+                        test_assert( std::abs( t - a ) <= 0x1p-8 * std::abs( a ) );
+                    }
+                }
+            }
+        }
+        A.releaseWorkspace();
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Test tileBcast of tiles large enough to be sent as pipelined segments.
+void test_Matrix_tileBcast_pipelined()
+{
+    // 8 MiB tiles, sent in 1 MiB segments.
+    int64_t nb_ = 1024;
+    int64_t m_ = 2*nb_, n_ = 2*nb_;
+    int64_t lda = m_;
+    std::vector<double> Ad( lda*n_ );
+
+    // Same data on all ranks, to check received tiles.
+    int64_t iseed[4] = { 0, 1, 2, 3 };
+    lapack::larnv( 1, iseed, Ad.size(), Ad.data() );
+
+    auto A = slate::Matrix<double>::fromLAPACK(
+        m_, n_, Ad.data(), lda, nb_, p, q, mpi_comm );
+
+    // Send each tile to all ranks owning tiles of A.
+    std::set<int> ranks;
+    A.getRanks( &ranks );
+    bool in_ranks = ranks.count( mpi_rank ) > 0;
+
+    for (int64_t j = 0; j < A.nt(); ++j) {
+        for (int64_t i = 0; i < A.mt(); ++i) {
+            A.tileBcast( i, j, A, slate::Layout::ColMajor );
+            if (! in_ranks)
+                continue;
+
+            test_assert( A.tileExists( i, j ) );
+            auto T = A( i, j );
+            for (int64_t jj = 0; jj < T.nb(); ++jj)
+                for (int64_t ii = 0; ii < T.mb(); ++ii)
+                    test_assert( T( ii, jj ) == Ad[ i*nb_ + ii + (j*nb_ + jj)*lda ] );
+        }
+    }
+
+    A.releaseWorkspace();
+}
+
 //------------------------------------------------------------------------------
 /// Test tileLayoutConvert.
 void test_Matrix_tileLayoutConvert()
@@ -2076,6 +3373,64 @@ void test_Matrix_tileReduceFromSet()
     }
 }
 
+//------------------------------------------------------------------------------
+/// Test tileReduceFromSet on tiles valid only on a device. With GPU-aware
+/// MPI, the reduction is done on the device, without host staging.
+void test_Matrix_tileReduceFromSet_dev()
+{
+    if (num_devices == 0) {
+        test_skip("requires num_devices > 0");
+    }
+
+    int lda = roundup(m, nb);
+    std::vector<double> Ad( lda*n );
+
+    auto A = slate::Matrix<double>::fromLAPACK(
+        m, n, Ad.data(), lda, nb, p, q, mpi_comm );
+
+    bool gpu_aware_save = slate::gpu_aware_mpi();
+    int64_t tile_bytes = A.tileMb( 0 ) * A.tileNb( 0 ) * sizeof(double);
+    int root = A.tileRank( 0, 0 );
+    int device = A.tileDevice( 0, 0 );
+
+    std::set<int> all_ranks;
+    for (int rank = 0; rank < mpi_size; ++rank)
+        all_ranks.insert( rank );
+    double sol_value = mpi_size*(mpi_size - 1)/2;
+
+    for (bool gpu_aware : { false, true }) {
+        slate::gpu_aware_mpi( gpu_aware );
+        slate::internal::resetHostStagedBytes();
+
+        if (! A.tileIsLocal( 0, 0 ))
+            A.tileInsert( 0, 0 );
+        A.tileGetForWriting( 0, 0, slate::LayoutConvert::None );
+        A( 0, 0 ).set( mpi_rank );
+        A.tileGetForWriting( 0, 0, device, slate::LayoutConvert::None );
+
+        std::set<int> reduce_set = all_ranks;
+        A.tileReduceFromSet( 0, 0, root, reduce_set, 2, 0, A.layout() );
+
+        if (mpi_size > 1) {
+            test_assert( slate::internal::hostStagedBytes()
+                         == (gpu_aware ? 0 : tile_bytes) );
+        }
+
+        if (mpi_rank == root) {
+            A.tileGetForReading( 0, 0, slate::LayoutConvert::None );
+            auto T = A( 0, 0 );
+            for (int64_t jj = 0; jj < T.nb(); ++jj)
+                for (int64_t ii = 0; ii < T.mb(); ++ii)
+                    test_assert( T( ii, jj ) == sol_value );
+        }
+        else {
+            A.tileErase( 0, 0, slate::AllDevices );
+        }
+    }
+
+    slate::gpu_aware_mpi( gpu_aware_save );
+}
+
 //==============================================================================
 // todo
 // BaseMatrix
@@ -2118,6 +3473,7 @@ void run_tests()
     run_test(test_Matrix_fromScaLAPACK,      "Matrix::fromScaLAPACK",      mpi_comm);
     run_test(test_Matrix_fromScaLAPACK_rect, "Matrix::fromScaLAPACK_rect", mpi_comm);
     run_test(test_Matrix_fromDevices,        "Matrix::fromDevices",        mpi_comm);
+    run_test(test_Matrix_fromScaLAPACKDevice, "Matrix::fromScaLAPACKDevice", mpi_comm);
 
     if (mpi_rank == 0)
         printf("\nMethods\n");
@@ -2131,10 +3487,30 @@ void run_tests()
     run_test(test_Matrix_tileInsert_data,      "Matrix::tileInsert(i, j, dev, data, lda)", mpi_comm);
     run_test(test_Matrix_tileErase,            "Matrix::tileErase",                        mpi_comm);
     run_test(test_Matrix_tileReduceFromSet,    "Matrix::tileReduceFromSet(i, j, set,...)", mpi_comm);
+    run_test(test_Matrix_tileReduceFromSet_dev, "Matrix::tileReduceFromSet(on_devices)",   mpi_comm);
     run_test(test_Matrix_insertLocalTiles,     "Matrix::insertLocalTiles()",               mpi_comm);
     run_test(test_Matrix_insertLocalTiles_dev, "Matrix::insertLocalTiles(on_devices)",     mpi_comm);
+    run_test(test_Matrix_insertLocalTiles_firstTouch, "Matrix::insertLocalTiles(first touch)", mpi_comm);
+    run_test(test_Matrix_insertLocalTiles_arena, "Matrix::insertLocalTiles(arena)",       mpi_comm);
+    run_test(test_Matrix_insertLocalTilesZero, "Matrix::insertLocalTilesZero",             mpi_comm);
+    run_test(test_Matrix_snapshot,             "Matrix::snapshot",                         mpi_comm);
+    run_test(test_Matrix_insertLocalTilesMapped, "Matrix::insertLocalTilesMapped",         mpi_comm);
+    run_test(test_Matrix_tileLookup_threads,   "Matrix::tileExists, tileState (threads)",  mpi_comm);
+    run_test(test_Matrix_tileLocalRows,        "Matrix::tileLocalRows",                    mpi_comm);
     run_test(test_Matrix_allocateBatchArrays,  "Matrix::allocateBatchArrays",              mpi_comm);
+    run_test(test_Matrix_batchArrayUpload,     "Matrix::batchArrayUpload",                 mpi_comm);
+    run_test(test_Matrix_memoryStats,          "Matrix::memoryStats",                      mpi_comm);
     run_test(test_Matrix_MOSI,                 "Matrix::tileMOSI",                         mpi_comm);
+    run_test(test_Matrix_tileCache,            "Matrix::enableTileCache",                  mpi_comm);
+    run_test(test_Matrix_tileCache_gemm,       "Matrix::enableTileCache in gemm",          mpi_comm);
+    run_test(test_Matrix_coherenceStats,       "Matrix::coherenceStats",                   mpi_comm);
+    run_test(test_Matrix_tileGetForReadingAsync, "Matrix::tileGetForReadingAsync",       mpi_comm);
+    run_test(test_Matrix_listBcastPacked,    "Matrix::listBcastPacked",    mpi_comm);
+    run_test(test_Matrix_listBcast_staged,   "Matrix::listBcast staged",   mpi_comm);
+    run_test(test_Matrix_zeroTiles,          "Matrix::tileSetZero",        mpi_comm);
+    run_test(test_Matrix_workspaceSession,   "Matrix::beginWorkspaceSession", mpi_comm);
+    run_test(test_Matrix_listBcastPacked_precision, "Matrix::listBcastPacked precision", mpi_comm);
+    run_test(test_Matrix_tileBcast_pipelined, "Matrix::tileBcast pipelined", mpi_comm);
     run_test(test_Matrix_tileLayoutConvert,    "Matrix::tileLayoutConvert",                mpi_comm);
 
     if (mpi_rank == 0)
@@ -2143,11 +3519,14 @@ void run_tests()
     run_test(test_Matrix_sub_trans,           "Matrix::sub(A^T)", mpi_comm);
     run_test(slate::Debug::test_Matrix_slice, "Matrix::slice",    mpi_comm);
     run_test(test_Matrix_sub_Matrix,          "Matrix(orig, i1, i2, j1, j2)", mpi_comm);
+    run_test(test_Matrix_sub_nonowning,       "Matrix::dropStorageOwnership", mpi_comm);
 
     if (mpi_rank == 0)
         printf("\nCommunication\n");
     run_test(test_tileSend_tileRecv, "tileSend, tileRecv", mpi_comm);
+    run_test(test_tileSend_gpu_aware, "tileSend, tileIrecv (GPU-aware MPI)", mpi_comm);
     run_test(test_releaseRemoteWorkspace, "releaseRemoteWorkspace", mpi_comm);
+    run_test(test_Matrix_rma,        "rmaOpen, tileGetRemote", mpi_comm);
 }
 
 }  // namespace test
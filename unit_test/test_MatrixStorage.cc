@@ -0,0 +1,435 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/Matrix.hh"
+
+#include "unit_test.hh"
+
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <vector>
+
+using slate::HostNum;
+using slate::LayoutConvert;
+using slate::MOSI;
+
+namespace test {
+
+//------------------------------------------------------------------------------
+// global variables
+int64_t mt, nb;
+int reps;
+int num_devices = 0;
+bool g_bench = false;
+
+//------------------------------------------------------------------------------
+/// Thread counts benchmarked: 1, 2, 4, ..., up to omp_get_max_threads.
+std::vector<int> thread_counts()
+{
+    std::vector<int> counts;
+    int max_threads = omp_get_max_threads();
+    for (int t = 1; t < max_threads; t *= 2)
+        counts.push_back( t );
+    counts.push_back( max_threads );
+    return counts;
+}
+
+//------------------------------------------------------------------------------
+/// @return seconds per call of op( i, j ), applied reps times to each of
+/// the mt-by-mt tiles. With a static schedule, each thread gets the same
+/// tiles in every rep, so threads never share a tile.
+template <typename op_t>
+double time_op( int num_threads, op_t op )
+{
+    int64_t ntiles = mt*mt;
+    double time = omp_get_wtime();
+    #pragma omp parallel num_threads( num_threads )
+    for (int rep = 0; rep < reps; ++rep) {
+        #pragma omp for schedule( static ) nowait
+        for (int64_t ij = 0; ij < ntiles; ++ij)
+            op( ij % mt, ij / mt );
+    }
+    time = omp_get_wtime() - time;
+    return time / (ntiles * reps);
+}
+
+//------------------------------------------------------------------------------
+void print_header()
+{
+    printf( "\n    %-44s %10s", "operation", "lat (us)" );
+    for (int t : thread_counts())
+        printf( "  Mop/s t=%-3d", t );
+    printf( "\n" );
+}
+
+//------------------------------------------------------------------------------
+/// Prints one row: latency of op on one thread, and throughput for each
+/// thread count. Only with --bench.
+template <typename op_t>
+void bench( const char* name, op_t op )
+{
+    if (! g_bench)
+        return;
+
+    // Warmup, e.g., to fill the memory pool.
+    time_op( 1, op );
+
+    printf( "    %-44s", name );
+    for (int t : thread_counts()) {
+        double time = time_op( t, op );
+        if (t == 1)
+            printf( " %10.3f", time * 1e6 );
+        printf( "  %12.3f", 1e-6 / time );
+    }
+    printf( "\n" );
+}
+
+//------------------------------------------------------------------------------
+/// Returns mt*nb-by-mt*nb matrix with local host tiles.
+slate::Matrix<double> local_matrix()
+{
+    slate::Matrix<double> A( mt*nb, mt*nb, nb, 1, 1, MPI_COMM_SELF );
+    A.insertLocalTiles();
+    return A;
+}
+
+//------------------------------------------------------------------------------
+/// Returns mt*nb-by-mt*nb matrix with all tiles on rank 1, which doesn't
+/// exist in MPI_COMM_SELF. All tiles are remote, and can exist only as
+/// workspace, like tiles received in a broadcast.
+slate::Matrix<double> remote_matrix()
+{
+    int64_t nb_ = nb;
+    std::function< int64_t (int64_t) > tileNb = [nb_]( int64_t ) {
+        return nb_;
+    };
+    std::function< int (std::tuple<int64_t, int64_t>) > tileRank
+        = []( std::tuple<int64_t, int64_t> ) {
+            return 1;
+        };
+    std::function< int (std::tuple<int64_t, int64_t>) > tileDevice
+        = []( std::tuple<int64_t, int64_t> ) {
+            return 0;
+        };
+    return slate::Matrix<double>( mt*nb, mt*nb, tileNb, tileNb,
+                                  tileRank, tileDevice, MPI_COMM_SELF );
+}
+
+//------------------------------------------------------------------------------
+/// Tests and times tileGetForReading and tileGetForWriting of host tiles
+/// that are already valid on host: the lookup and locking cost, with no
+/// MOSI transition or data movement.
+void test_tileGet_host()
+{
+    auto A = local_matrix();
+
+    auto get_read = [&]( int64_t i, int64_t j ) {
+        A.tileGetForReading( i, j, HostNum, LayoutConvert::None );
+    };
+    auto get_write = [&]( int64_t i, int64_t j ) {
+        A.tileGetForWriting( i, j, HostNum, LayoutConvert::None );
+    };
+
+    get_write( 0, 0 );
+    test_assert( A.tileState( 0, 0 ) == MOSI::Modified );
+    get_read( 0, 0 );
+    test_assert( A.tileState( 0, 0 ) == MOSI::Modified );
+
+    if (g_bench)
+        print_header();
+    bench( "tileGetForReading (host)", get_read );
+    bench( "tileGetForWriting (host)", get_write );
+    // Asserts can't throw out of the parallel region; count errors instead.
+    std::atomic<int> errors( 0 );
+    bench( "tileGetForReading + A( i, j ) (host)",
+           [&]( int64_t i, int64_t j ) {
+               A.tileGetForReading( i, j, HostNum, LayoutConvert::None );
+               auto T = A( i, j );
+               if (T.data() == nullptr)
+                   ++errors;
+           } );
+    test_assert( errors.load() == 0 );
+}
+
+//------------------------------------------------------------------------------
+/// Tests and times the OnHold transition: tileGetAndHold, then
+/// tileUnsetHold, of host tiles. Bookkeeping only.
+void test_hold_host()
+{
+    auto A = local_matrix();
+
+    auto hold = [&]( int64_t i, int64_t j ) {
+        A.tileGetAndHold( i, j, HostNum, LayoutConvert::None );
+        A.tileUnsetHold( i, j, HostNum );
+    };
+
+    A.tileGetAndHold( 0, 0, HostNum, LayoutConvert::None );
+    test_assert( A.tileOnHold( 0, 0 ) );
+    A.tileUnsetHold( 0, 0 );
+    test_assert( ! A.tileOnHold( 0, 0 ) );
+
+    if (g_bench)
+        print_header();
+    bench( "tileGetAndHold + tileUnsetHold (host)", hold );
+}
+
+//------------------------------------------------------------------------------
+/// Tests and times inserting, then releasing, one host workspace tile,
+/// with tileInsertWorkspace or tileAcquire: the tile map insert and erase,
+/// and the memory pool alloc and free.
+void test_workspace_host()
+{
+    auto B = remote_matrix();
+    B.reserveHostWorkspace( mt*mt );
+
+    auto insert_release = [&]( int64_t i, int64_t j ) {
+        B.tileInsertWorkspace( i, j, HostNum );
+        B.tileRelease( i, j, HostNum );
+    };
+    auto acquire_release = [&]( int64_t i, int64_t j ) {
+        B.tileAcquire( i, j, HostNum, slate::Layout::ColMajor );
+        B.tileRelease( i, j, HostNum );
+    };
+
+    B.tileInsertWorkspace( 0, 0, HostNum );
+    test_assert( B.tileExists( 0, 0, HostNum ) );
+    B.tileRelease( 0, 0, HostNum );
+    test_assert( ! B.tileExists( 0, 0, HostNum ) );
+
+    B.tileAcquire( 0, 0, HostNum, slate::Layout::ColMajor );
+    test_assert( B.tileExists( 0, 0, HostNum ) );
+    B.tileRelease( 0, 0, HostNum );
+    test_assert( ! B.tileExists( 0, 0, HostNum ) );
+
+    if (g_bench)
+        print_header();
+    bench( "tileInsertWorkspace + tileRelease (host)", insert_release );
+    bench( "tileAcquire + tileRelease (host)", acquire_release );
+}
+
+//------------------------------------------------------------------------------
+/// Tests and times tileInsertWorkspace of all tiles, then one
+/// releaseWorkspace, as at the end of a routine. releaseWorkspace is
+/// serial; its time is per tile. Since releaseWorkspace also frees the
+/// memory pool's blocks, each insert pass allocates them again.
+void test_releaseWorkspace()
+{
+    auto B = remote_matrix();
+
+    auto insert = [&]( int64_t i, int64_t j ) {
+        B.tileInsertWorkspace( i, j, HostNum );
+    };
+
+    for (int64_t j = 0; j < mt; ++j)
+        for (int64_t i = 0; i < mt; ++i)
+            insert( i, j );
+    B.releaseWorkspace();
+    for (int64_t j = 0; j < mt; ++j)
+        for (int64_t i = 0; i < mt; ++i)
+            test_assert( ! B.tileExists( i, j, HostNum ) );
+
+    if (! g_bench)
+        return;
+
+    // One insert per tile per pass: a second insert would find the tile.
+    std::vector<double> insert_time;
+    double release_time = 0;
+    for (int t : thread_counts()) {
+        double time = 0;
+        for (int rep = 0; rep < reps; ++rep) {
+            double t0 = omp_get_wtime();
+            #pragma omp parallel for num_threads( t ) schedule( static )
+            for (int64_t ij = 0; ij < mt*mt; ++ij)
+                insert( ij % mt, ij / mt );
+            double t1 = omp_get_wtime();
+            B.releaseWorkspace();
+            time += t1 - t0;
+            if (t == 1)
+                release_time += omp_get_wtime() - t1;
+        }
+        insert_time.push_back( time / (reps * mt*mt) );
+    }
+    release_time /= reps * mt*mt;
+
+    print_header();
+    printf( "    %-44s %10.3f", "tileInsertWorkspace (host), all tiles",
+            insert_time[ 0 ] * 1e6 );
+    for (double time : insert_time)
+        printf( "  %12.3f", 1e-6 / time );
+    printf( "\n    %-44s %10.3f  %12.3f\n", "releaseWorkspace (serial), per tile",
+            release_time * 1e6, 1e-6 / release_time );
+}
+
+//------------------------------------------------------------------------------
+/// Tests and times tileGetForReading of tiles that have a valid, Shared
+/// copy on their device: the lookup and locking cost for device tiles,
+/// with no copy.
+void test_tileGet_device()
+{
+    if (num_devices == 0)
+        test_skip( "no GPU devices available" );
+
+    auto A = local_matrix();
+    for (int64_t j = 0; j < mt; ++j)
+        for (int64_t i = 0; i < mt; ++i)
+            A.tileGetForReading( i, j, A.tileDevice( i, j ),
+                                 LayoutConvert::None );
+
+    int dev = A.tileDevice( 0, 0 );
+    test_assert( A.tileState( 0, 0, dev ) == MOSI::Shared );
+    test_assert( A.tileState( 0, 0, HostNum ) == MOSI::Shared );
+
+    if (g_bench)
+        print_header();
+    bench( "tileGetForReading (device, valid)",
+           [&]( int64_t i, int64_t j ) {
+               A.tileGetForReading( i, j, A.tileDevice( i, j ),
+                                    LayoutConvert::None );
+           } );
+}
+
+//------------------------------------------------------------------------------
+/// Tests and times MOSI transitions between host and device.
+/// tileModified( device ) and tileModified( host ), permissively, switch
+/// which instance is Modified, with no copy: bookkeeping only.
+/// tileGetForWriting on device, then on host, copies the tile both ways,
+/// so its time includes two nb-by-nb transfers.
+void test_mosi_device()
+{
+    if (num_devices == 0)
+        test_skip( "no GPU devices available" );
+
+    auto A = local_matrix();
+    for (int64_t j = 0; j < mt; ++j)
+        for (int64_t i = 0; i < mt; ++i)
+            A.tileGetForReading( i, j, A.tileDevice( i, j ),
+                                 LayoutConvert::None );
+
+    auto modified = [&]( int64_t i, int64_t j ) {
+        A.tileModified( i, j, A.tileDevice( i, j ), true );
+        A.tileModified( i, j, HostNum, true );
+    };
+    auto get_write = [&]( int64_t i, int64_t j ) {
+        A.tileGetForWriting( i, j, A.tileDevice( i, j ), LayoutConvert::None );
+        A.tileGetForWriting( i, j, HostNum, LayoutConvert::None );
+    };
+
+    int dev = A.tileDevice( 0, 0 );
+    A.tileModified( 0, 0, dev, true );
+    test_assert( A.tileState( 0, 0, dev ) == MOSI::Modified );
+    test_assert( A.tileState( 0, 0, HostNum ) == MOSI::Invalid );
+    A.tileGetForWriting( 0, 0, HostNum, LayoutConvert::None );
+    test_assert( A.tileState( 0, 0, HostNum ) == MOSI::Modified );
+    test_assert( A.tileState( 0, 0, dev ) == MOSI::Invalid );
+
+    if (g_bench)
+        print_header();
+    bench( "tileModified device <-> host (no copy)", modified );
+    bench( "tileGetForWriting device <-> host (copies)", get_write );
+}
+
+//------------------------------------------------------------------------------
+/// Tests and times inserting, then releasing, one device workspace tile:
+/// tileAcquire of a local tile's device instance, and tileInsertWorkspace
+/// of a remote tile.
+void test_workspace_device()
+{
+    if (num_devices == 0)
+        test_skip( "no GPU devices available" );
+
+    auto A = local_matrix();
+    auto B = remote_matrix();
+    A.reserveDeviceWorkspace();
+    B.reserveDeviceWorkspace();
+
+    auto acquire_release = [&]( int64_t i, int64_t j ) {
+        int dev = A.tileDevice( i, j );
+        A.tileAcquire( i, j, dev, slate::Layout::ColMajor );
+        A.tileRelease( i, j, dev );
+    };
+    auto insert_release = [&]( int64_t i, int64_t j ) {
+        B.tileInsertWorkspace( i, j, 0 );
+        B.tileRelease( i, j, 0 );
+    };
+
+    int dev = A.tileDevice( 0, 0 );
+    A.tileAcquire( 0, 0, dev, slate::Layout::ColMajor );
+    test_assert( A.tileExists( 0, 0, dev ) );
+    A.tileRelease( 0, 0, dev );
+    test_assert( ! A.tileExists( 0, 0, dev ) );
+    test_assert( A.tileExists( 0, 0, HostNum ) );
+
+    insert_release( 0, 0 );
+    test_assert( ! B.tileExists( 0, 0, 0 ) );
+
+    if (g_bench)
+        print_header();
+    bench( "tileAcquire + tileRelease (device)", acquire_release );
+    bench( "tileInsertWorkspace + tileRelease (device)", insert_release );
+}
+
+//------------------------------------------------------------------------------
+/// Runs all tests. Called by unit test main().
+void run_tests()
+{
+    run_test(test_tileGet_host,     "tileGet (host)");
+    run_test(test_hold_host,        "tileGetAndHold (host)");
+    run_test(test_workspace_host,   "workspace tiles (host)");
+    run_test(test_releaseWorkspace, "releaseWorkspace");
+    run_test(test_tileGet_device,   "tileGet (device)");
+    run_test(test_mosi_device,      "MOSI transitions (device)");
+    run_test(test_workspace_device, "workspace tiles (device)");
+}
+
+}  // namespace test
+
+//------------------------------------------------------------------------------
+/// Tile bookkeeping overhead of BaseMatrix and MatrixStorage.
+/// Without --bench, checks each operation once. With --bench, prints per-call
+/// latency on one thread and throughput for 1, 2, 4, ..., all threads.
+/// Options: --bench, -mt tiles (per dimension), -nb block size, -reps.
+int main(int argc, char** argv)
+{
+    using namespace test;  // for globals mt, nb, etc.
+
+    MPI_Init(&argc, &argv);
+
+    num_devices = blas::get_device_count();
+
+    // globals
+    mt   = 32;
+    nb   = 64;
+    reps = 10;
+
+    // parse command line
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--bench")
+            g_bench = true;
+        else if (arg == "-mt" && i+1 < argc)
+            mt = atoi( argv[++i] );
+        else if (arg == "-nb" && i+1 < argc)
+            nb = atoi( argv[++i] );
+        else if (arg == "-reps" && i+1 < argc)
+            reps = atoi( argv[++i] );
+        else {
+            printf( "unknown argument: %s\n"
+                    "usage: %s [--bench] [-mt tiles] [-nb nb] [-reps reps]\n",
+                    argv[i], argv[0] );
+            return 1;
+        }
+    }
+
+    printf( "mt %lld, nb %lld, reps %d, threads %d, num_devices %d\n",
+            llong( mt ), llong( nb ), reps, omp_get_max_threads(),
+            num_devices );
+
+    int err = unit_test_main(MPI_COMM_SELF);  // which calls run_tests()
+
+    MPI_Finalize();
+    return err;
+}
@@ -40,17 +40,53 @@ void test_addHostBlocks()
 
     const int cnt = 5;
     mem.addHostBlocks(cnt);
-    // Memory class no longer reserves CPU blocks, it allocates on-the-fly.
-    //test_assert( int( mem.available( HostNum ) ) == cnt );
-    //test_assert( int( mem.capacity(  HostNum ) ) == cnt );
-    test_assert( int( mem.available( HostNum ) ) == 0 );
-    test_assert( int( mem.capacity(  HostNum ) ) == 0 );
+    test_assert( int( mem.available( HostNum ) ) == cnt );
+    test_assert( int( mem.capacity(  HostNum ) ) == cnt );
+    test_assert( ! mem.host_pinned() );
 
     // Devices still 0.
     for (int dev = 0; dev < mem.num_devices_; ++dev) {
         test_assert(int(mem.available(dev)) == 0);
         test_assert(int(mem.capacity (dev)) == 0);
     }
+
+    mem.addHostBlocks(cnt);
+    test_assert( int( mem.available( HostNum ) ) == 2*cnt );
+    test_assert( int( mem.capacity(  HostNum ) ) == 2*cnt );
+
+    mem.clearHostBlocks();
+}
+
+//------------------------------------------------------------------------------
+/// Tests reserving pinned host blocks, using a device queue.
+void test_addHostBlocks_pinned()
+{
+    slate::Memory mem(sizeof(double) * nb * nb);
+    if (mem.num_devices_ == 0) {
+        test_skip("no GPU devices available");
+    }
+
+    blas::Queue queue( 0 );
+
+    const int cnt = 5;
+    mem.addHostBlocks(cnt, &queue);
+    test_assert( int( mem.available( HostNum ) ) == cnt );
+    test_assert( int( mem.capacity(  HostNum ) ) == cnt );
+    test_assert( mem.host_pinned() );
+
+    double* hx = (double*) mem.alloc( HostNum, sizeof(double) * nb * nb, nullptr );
+    test_assert( hx != nullptr );
+    test_assert( int( mem.available( HostNum ) ) == cnt-1 );
+    for (int j = 0; j < nb*nb; ++j) {
+        hx[j] = j;
+    }
+    mem.free( hx, HostNum );
+    test_assert( int( mem.available( HostNum ) ) == cnt );
+
+    mem.clearHostBlocks(&queue);
+    test_assert( int( mem.available( HostNum ) ) == 0 );
+    test_assert( int( mem.capacity(  HostNum ) ) == 0 );
+    test_assert( ! mem.host_pinned() );
 }
 
 //------------------------------------------------------------------------------
@@ -103,16 +139,15 @@ void test_alloc_host()
     mem.addHostBlocks(cnt);
 
     // Allocate 2*cnt blocks.
-    // First cnt blocks come from reserve, next cnt blocks malloc'd 1-by-1.
+    // First cnt blocks come from reserve, next cnt blocks allocated
+    // on-the-fly, outside the pool.
     double* hx[ 2*cnt ];
     for (int i = 0; i < 2*cnt; ++i) {
         hx[i] = (double*) mem.alloc( HostNum, sizeof(double) * nb * nb, nullptr );
         test_assert(hx[i] != nullptr);
-        // Memory class no longer reserves CPU blocks, it allocates on-the-fly.
-        //test_assert( int( mem.available( HostNum ) ) == max( cnt-(i+1), 0 ) );
-        //test_assert( int( mem.capacity(  HostNum ) ) == max( cnt, i+1 ) );
-        test_assert( int( mem.available( HostNum ) ) == 0 );
-        test_assert( int( mem.capacity(  HostNum ) ) == 0 );
+        test_assert( int( mem.available( HostNum ) ) == max( cnt-(i+1), 0 ) );
+        test_assert( int( mem.capacity(  HostNum ) ) == cnt );
+        test_assert( int( mem.allocated( HostNum ) ) == i+1 );
 
         // Touch memory to verify it is valid.
         for (int j = 0; j < nb*nb; ++j) {
@@ -120,26 +155,44 @@ void test_alloc_host()
         }
     }
 
-    // Free some.
+    // Free some from the pool.
     int some = cnt/2;
     for (int i = 0; i < some; ++i) {
         mem.free( hx[i], HostNum );
         hx[i] = nullptr;
-        //test_assert( int( mem.available( HostNum ) ) == i+1 );
-        //test_assert( int( mem.capacity(  HostNum ) ) == 2*cnt );
-        test_assert( int( mem.available( HostNum ) ) == 0 );
-        test_assert( int( mem.capacity(  HostNum ) ) == 0 );
+        test_assert( int( mem.available( HostNum ) ) == i+1 );
+        test_assert( int( mem.capacity(  HostNum ) ) == cnt );
+    }
+
+    // Free ones allocated on-the-fly; these don't return to the pool.
+    for (int i = cnt; i < 2*cnt; ++i) {
+        mem.free( hx[i], HostNum );
+        hx[i] = nullptr;
+        test_assert( int( mem.available( HostNum ) ) == some );
+        test_assert( int( mem.capacity(  HostNum ) ) == cnt );
     }
 
     // Re-alloc some.
     for (int i = 0; i < some; ++i) {
         hx[i] = (double*) mem.alloc( HostNum, sizeof(double) * nb * nb, nullptr);
         test_assert(hx[i] != nullptr);
-        //test_assert( int( mem.available( HostNum ) ) == some - ( i+1 ) );
-        //test_assert( int( mem.capacity(  HostNum ) ) == 2*cnt );
-        test_assert( int( mem.available( HostNum ) ) == 0 );
-        test_assert( int( mem.capacity(  HostNum ) ) == 0 );
+        test_assert( int( mem.available( HostNum ) ) == some - ( i+1 ) );
+        test_assert( int( mem.capacity(  HostNum ) ) == cnt );
+    }
+
+    // Requests larger than a block are always allocated on-the-fly.
+    double* big = (double*) mem.alloc( HostNum, 2 * sizeof(double) * nb * nb, nullptr );
+    test_assert( big != nullptr );
+    test_assert( int( mem.allocated( HostNum ) ) == cnt+1 );
+    mem.free( big, HostNum );
+
+    for (int i = 0; i < cnt; ++i) {
+        mem.free( hx[i], HostNum );
     }
+    test_assert( int( mem.available( HostNum ) ) == cnt );
+    test_assert( int( mem.allocated( HostNum ) ) == 0 );
+
+    mem.clearHostBlocks();
 }
 
 //------------------------------------------------------------------------------
@@ -215,19 +268,21 @@ void test_clearHostBlocks()
 
     const int cnt = 5;
     mem.addHostBlocks(cnt);
-    //test_assert( int( mem.available( HostNum ) ) == cnt );
-    //test_assert( int( mem.capacity(  HostNum ) ) == cnt );
-    test_assert( int( mem.available( HostNum ) ) == 0 );
-    test_assert( int( mem.capacity(  HostNum ) ) == 0 );
+    test_assert( int( mem.available( HostNum ) ) == cnt );
+    test_assert( int( mem.capacity(  HostNum ) ) == cnt );
 
-    // Allocate 2*cnt blocks.
+    // Allocate and free 2*cnt blocks.
+    void* hx[ 2*cnt ];
     for (int i = 0; i < 2*cnt; ++i) {
-        mem.alloc( HostNum, sizeof(double) * nb * nb, nullptr );
+        hx[i] = mem.alloc( HostNum, sizeof(double) * nb * nb, nullptr );
     }
 
     test_assert( int( mem.available( HostNum ) ) == 0 );
-    //test_assert( int( mem.capacity(  HostNum ) ) == 2*cnt );
-    test_assert( int( mem.capacity(  HostNum ) ) == 0 );
+    test_assert( int( mem.capacity(  HostNum ) ) == cnt );
+
+    for (int i = 0; i < 2*cnt; ++i) {
+        mem.free( hx[i], HostNum );
+    }
 
     mem.clearHostBlocks();
 
@@ -281,17 +336,173 @@ void test_clearDeviceBlocks()
         delete dev_queues[dev];
 }
 
+//------------------------------------------------------------------------------
+/// Tests size classes. Doesn't allocate memory.
+void test_size_classes()
+{
+    size_t block_size = sizeof(double) * nb * nb;
+    slate::Memory mem( block_size );
+
+    test_assert( mem.num_size_classes() >= 1 );
+    test_assert( mem.class_size( 0 ) == block_size );
+    for (int k = 1; k < mem.num_size_classes(); ++k) {
+        // halves, aligned
+        test_assert( mem.class_size( k ) <= mem.class_size( k-1 ) / 2 );
+        test_assert( mem.class_size( k ) % 256 == 0 );
+    }
+
+    // full and near-full blocks are in class 0
+    test_assert( mem.size_class( block_size ) == 0 );
+    test_assert( mem.size_class( block_size - 1 ) == 0 );
+
+    // each class is the smallest that fits
+    for (int k = 0; k < mem.num_size_classes(); ++k) {
+        size_t size = mem.class_size( k );
+        test_assert( mem.size_class( size ) == k );
+        test_assert( mem.size_class( 1 ) == mem.num_size_classes() - 1 );
+        if (k + 1 < mem.num_size_classes())
+            test_assert( mem.size_class( mem.class_size( k+1 ) + 1 ) == k );
+    }
+
+    // requests larger than a block are errors
+    test_assert_throw( mem.size_class( block_size + 1 ), slate::Exception );
+}
+
+//------------------------------------------------------------------------------
+/// Tests allocating and freeing device blocks of smaller size classes,
+/// and the pool statistics.
+void test_alloc_device_size_classes()
+{
+    size_t block_size = sizeof(double) * nb * nb;
+    slate::Memory mem( block_size );
+    if (mem.num_devices_ == 0) {
+        test_skip("no GPU devices available");
+    }
+    if (mem.num_size_classes() < 2) {
+        test_skip("nb too small for multiple size classes");
+    }
+
+    // device specific queues
+    std::vector< blas::Queue* > dev_queues(mem.num_devices_);
+    for (int dev = 0; dev < mem.num_devices_; ++dev)
+        dev_queues[ dev ] = new blas::Queue( dev );
+
+    int k = mem.num_size_classes() - 1;
+    size_t size = mem.class_size( k );
+    int per_slab = block_size / size;
+    for (int dev = 0; dev < mem.num_devices_; ++dev) {
+        // Allocate one slab's worth of small blocks: one device malloc.
+        std::vector<void*> dx( per_slab );
+        for (int i = 0; i < per_slab; ++i) {
+            dx[i] = mem.alloc( dev, size - 8, dev_queues[dev] );
+            test_assert( dx[i] != nullptr );
+            test_assert( int( mem.allocated( dev ) ) == i+1 );
+        }
+        slate::MemoryStats stats = mem.stats( dev );
+        test_assert( stats.num_mallocs == 1 );
+        test_assert( stats.reserved  == block_size );
+        test_assert( stats.in_use    == per_slab * size );
+        test_assert( stats.requested == per_slab * (size - 8) );
+        test_assert( stats.internalFragmentation() > 0 );
+
+        // Small blocks don't count against full-size blocks.
+        test_assert( int( mem.available( dev ) ) == 0 );
+        test_assert( int( mem.capacity(  dev ) ) == 0 );
+
+        // Free and re-alloc; served from the pool without malloc.
+        for (int i = 0; i < per_slab; ++i)
+            mem.free( dx[i], dev );
+        test_assert( int( mem.allocated( dev ) ) == 0 );
+        test_assert( mem.stats( dev ).in_use == 0 );
+        test_assert( mem.stats( dev ).externalFragmentation() == 1.0 );
+
+        for (int i = 0; i < per_slab; ++i)
+            dx[i] = mem.alloc( dev, size, dev_queues[dev] );
+        test_assert( mem.stats( dev ).num_mallocs == 1 );
+
+        for (int i = 0; i < per_slab; ++i)
+            mem.free( dx[i], dev );
+    }
+
+    // deallocate/clear memory before the slate::Memory destructer
+    mem.clearHostBlocks();
+    for (int dev = 0; dev < mem.num_devices_; ++dev) {
+        mem.clearDeviceBlocks(dev, dev_queues[dev] );
+        test_assert( mem.stats( dev ).reserved == 0 );
+    }
+
+    // free the device specific queues
+    for (int dev = 0; dev < mem.num_devices_; ++dev)
+        delete dev_queues[dev];
+}
+
+//------------------------------------------------------------------------------
+/// Tests current and peak memory statistics, per Memory object and in total.
+void test_stats_peak()
+{
+    size_t block_size = sizeof(double) * nb * nb;
+    slate::Memory mem( block_size );
+
+    slate::Memory::resetTotalPeak( HostNum );
+    slate::MemoryStats total0 = slate::Memory::totalStats( HostNum );
+
+    const int cnt = 4;
+    mem.addHostBlocks( cnt );
+    test_assert( mem.stats( HostNum ).reserved == cnt * block_size );
+    test_assert( mem.stats( HostNum ).peak     == cnt * block_size );
+
+    // Pool blocks plus one on-the-fly block and external bytes.
+    std::vector<void*> hx( cnt+1 );
+    for (int i = 0; i < cnt+1; ++i)
+        hx[i] = mem.alloc( HostNum, block_size, nullptr );
+    mem.addExternal( HostNum, 100 );
+
+    slate::MemoryStats stats = mem.stats( HostNum );
+    test_assert( stats.reserved    == (cnt+1) * block_size );
+    test_assert( stats.in_use      == (cnt+1) * block_size );
+    test_assert( stats.external    == 100 );
+    test_assert( stats.current()   == (cnt+1) * block_size + 100 );
+    test_assert( stats.peak        == stats.current() );
+    test_assert( stats.peak_in_use == stats.in_use + 100 );
+
+    slate::MemoryStats total = slate::Memory::totalStats( HostNum );
+    test_assert( total.peak - total0.current() == stats.peak );
+
+    // Freeing lowers current use, but not the peak.
+    for (int i = 0; i < cnt+1; ++i)
+        mem.free( hx[i], HostNum );
+    mem.removeExternal( HostNum, 100 );
+    stats = mem.stats( HostNum );
+    test_assert( stats.current() == cnt * block_size );
+    test_assert( stats.in_use    == 0 );
+    test_assert( stats.peak      == (cnt+1) * block_size + 100 );
+
+    mem.resetPeak( HostNum );
+    stats = mem.stats( HostNum );
+    test_assert( stats.peak        == cnt * block_size );
+    test_assert( stats.peak_in_use == 0 );
+
+    mem.clearHostBlocks();
+    test_assert( mem.stats( HostNum ).current() == 0 );
+    test_assert( slate::Memory::totalStats( HostNum ).current()
+                 == total0.current() );
+}
+
 //------------------------------------------------------------------------------
 /// Runs all tests. Called by unit test main().
 void run_tests()
 {
     run_test(test_Memory,            "Memory()");
     run_test(test_addHostBlocks,     "addHostBlocks");
+    run_test(test_addHostBlocks_pinned, "addHostBlocks (pinned)");
     run_test(test_addDeviceBlocks,   "addDeviceBlocks");
     run_test(test_alloc_host,        "alloc and free (alloc_host)");
     run_test(test_alloc_device,      "alloc and free (alloc_device)");
     run_test(test_clearHostBlocks,   "clearHostBlocks");
     run_test(test_clearDeviceBlocks, "clearDeviceBlocks");
+    run_test(test_size_classes,      "size_class");
+    run_test(test_alloc_device_size_classes, "alloc and free (size classes)");
+    run_test(test_stats_peak,        "stats and peak");
 }
 
 }  // namespace test
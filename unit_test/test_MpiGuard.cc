@@ -0,0 +1,164 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/Matrix.hh"
+#include "slate/internal/mpi.hh"
+#include "slate/internal/openmp.hh"
+
+#include "unit_test.hh"
+
+#include <cstring>
+#include <vector>
+
+using slate::internal::MpiGuard;
+using slate::internal::mpiSerialized;
+
+namespace test {
+
+int mpi_rank, mpi_size;
+MPI_Comm mpi_comm;
+bool g_bench = false;
+
+//------------------------------------------------------------------------------
+/// Calls can be made concurrent only with MPI_THREAD_MULTIPLE.
+void test_mpiSerialized()
+{
+    int provided = 0;
+    MPI_Query_thread( &provided );
+    bool multiple = provided >= MPI_THREAD_MULTIPLE;
+
+    bool orig = mpiSerialized();
+    test_assert( mpiSerialized( 1 ) );
+    test_assert( mpiSerialized() );
+    test_assert( mpiSerialized( 0 ) == ! multiple );
+    test_assert( mpiSerialized() == ! multiple );
+    mpiSerialized( orig );
+}
+
+//------------------------------------------------------------------------------
+/// When serialized, MpiGuard scopes exclude each other.
+void test_MpiGuard()
+{
+    bool orig = mpiSerialized();
+    mpiSerialized( 1 );
+
+    int sum = 0;
+    int n = 1000;
+    #pragma omp parallel for num_threads( 4 ) shared( sum )
+    for (int i = 1; i <= n; ++i) {
+        MpiGuard mpi_guard;
+        // Race, unless the guard serializes.
+        int x = sum;
+        sum = x + i;
+    }
+    test_assert( sum == n*(n + 1)/2 );
+
+    mpiSerialized( orig );
+}
+
+//------------------------------------------------------------------------------
+/// @return seconds to broadcast every tile of A to all ranks,
+/// with num_threads threads each broadcasting whole tiles concurrently.
+double time_bcast( slate::Matrix<double>& A, int num_threads )
+{
+    int64_t mt = A.mt(), nt = A.nt();
+    MPI_Barrier( mpi_comm );
+    double time = omp_get_wtime();
+
+    #pragma omp parallel for collapse( 2 ) schedule( dynamic, 1 ) \
+        num_threads( num_threads )
+    for (int64_t j = 0; j < nt; ++j) {
+        for (int64_t i = 0; i < mt; ++i) {
+            // Unique tag per tile, so concurrent broadcasts match.
+            int tag = int( i + j*mt );
+            A.tileBcast( i, j, A, slate::Layout::ColMajor, tag );
+        }
+    }
+
+    MPI_Barrier( mpi_comm );
+    time = omp_get_wtime() - time;
+    A.releaseWorkspace();
+    return time;
+}
+
+//------------------------------------------------------------------------------
+/// Prints the message rate of concurrent tileBcast, which uses
+/// tileIbcastToSet, for thread counts up to the max, with MPI calls
+/// serialized and concurrent. Run with --bench, on >= 2 ranks.
+void test_bcast_rate()
+{
+    if (! g_bench)
+        test_skip( "run with --bench" );
+    if (mpi_size < 2)
+        test_skip( "requires mpi_size >= 2" );
+
+    // Small tiles, so the rate is limited by messages, not bandwidth.
+    int64_t nb = 16, mt = 64, nt = 64;
+    int64_t m = nb*mt, n = nb*nt;
+    auto A = slate::Matrix<double>( m, n, nb, 1, mpi_size, mpi_comm );
+    A.insertLocalTiles();
+
+    // Each tile is received by mpi_size - 1 ranks.
+    double messages = double( mt ) * nt * (mpi_size - 1);
+    int provided = 0;
+    MPI_Query_thread( &provided );
+    bool orig = mpiSerialized();
+
+    if (mpi_rank == 0) {
+        printf( "\n    %7s  %16s  %16s\n",
+                "threads", "serial (msg/s)", "multiple (msg/s)" );
+    }
+    int max_threads = omp_get_max_threads();
+    for (int num_threads = 1; num_threads <= max_threads; num_threads *= 2) {
+        mpiSerialized( 1 );
+        double serial = time_bcast( A, num_threads );
+        double multiple = 0;
+        if (provided >= MPI_THREAD_MULTIPLE) {
+            mpiSerialized( 0 );
+            multiple = time_bcast( A, num_threads );
+        }
+        if (mpi_rank == 0) {
+            printf( "    %7d  %16.0f  %16.0f\n", num_threads,
+                    messages / serial,
+                    multiple > 0 ? messages / multiple : 0. );
+        }
+    }
+    mpiSerialized( orig );
+}
+
+//------------------------------------------------------------------------------
+/// Runs all tests. Called by unit test main().
+void run_tests()
+{
+    if (mpi_rank == 0) {
+        run_test(test_mpiSerialized, "mpiSerialized");
+        run_test(test_MpiGuard,      "MpiGuard");
+    }
+    run_test(test_bcast_rate, "tileBcast message rate", mpi_comm);
+}
+
+}  // namespace test
+
+//------------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+    using namespace test;
+
+    int provided = 0;
+    MPI_Init_thread( &argc, &argv, MPI_THREAD_MULTIPLE, &provided );
+    mpi_comm = MPI_COMM_WORLD;
+    MPI_Comm_rank( mpi_comm, &mpi_rank );
+    MPI_Comm_size( mpi_comm, &mpi_size );
+
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp( argv[ i ], "--bench" ) == 0)
+            g_bench = true;
+    }
+
+    int err = unit_test_main( mpi_comm );  // which calls run_tests()
+
+    MPI_Finalize();
+    return err;
+}
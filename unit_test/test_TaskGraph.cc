@@ -0,0 +1,210 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/internal/TaskGraph.hh"
+#include "slate/internal/openmp.hh"
+#include "slate/Exception.hh"
+
+#include "unit_test.hh"
+
+#include <unistd.h>
+
+using slate::internal::TaskGraph;
+
+namespace test {
+
+//------------------------------------------------------------------------------
+/// Tasks writing the same key run in submission order, one at a time.
+void test_inout()
+{
+    int n = 20;
+    std::vector<int> order;
+    std::atomic<int> running( 0 );
+    bool overlap = false;
+
+    TaskGraph graph;
+    graph.run( [&]( TaskGraph& g ) {
+        for (int i = 0; i < n; ++i) {
+            g.add( 0, {}, { { 0, 0, 0 } }, [&, i] {
+                if (running.fetch_add( 1 ) != 0)
+                    overlap = true;
+                usleep( 100 );
+                order.push_back( i );
+                running.fetch_sub( 1 );
+            });
+        }
+    });
+
+    test_assert( graph.num_tasks() == n );
+    test_assert( ! overlap );
+    test_assert( int( order.size() ) == n );
+    for (int i = 0; i < n; ++i)
+        test_assert( order[ i ] == i );
+}
+
+//------------------------------------------------------------------------------
+/// Readers run after the writer before them, and before the next writer.
+void test_in()
+{
+    int n = 20;
+    int value = 0;
+    std::atomic<int> sum( 0 );
+    int final_sum = -1;
+
+    TaskGraph graph;
+    graph.run( [&]( TaskGraph& g ) {
+        g.add( 0, {}, { { 0, 0, 0 } }, [&] {
+            usleep( 1000 );
+            value = 1;
+        });
+        for (int i = 0; i < n; ++i) {
+            g.add( 0, { { 0, 0, 0 } }, {}, [&] {
+                usleep( 100 );
+                sum += value;
+            });
+        }
+        g.add( 0, {}, { { 0, 0, 0 } }, [&] {
+            final_sum = sum;
+            value = 2;
+        });
+    });
+
+    test_assert( final_sum == n );
+    test_assert( value == 2 );
+}
+
+//------------------------------------------------------------------------------
+/// Independent chains, e.g., tiles of a later step, don't wait on each other.
+void test_independent()
+{
+    int n = 10;
+    std::vector<int> a, b;
+
+    TaskGraph graph;
+    graph.run( [&]( TaskGraph& g ) {
+        for (int i = 0; i < n; ++i) {
+            g.add( 0, {}, { { 'A', 0, 0 } }, [&, i] { a.push_back( i ); } );
+            g.add( 0, {}, { { 'A', 1, 0 } }, [&, i] { b.push_back( i ); } );
+        }
+    });
+
+    test_assert( int( a.size() ) == n );
+    test_assert( int( b.size() ) == n );
+    for (int i = 0; i < n; ++i) {
+        test_assert( a[ i ] == i );
+        test_assert( b[ i ] == i );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// With one thread, ready tasks run by priority, then submission order.
+void test_priority()
+{
+    std::vector<int> order;
+    int num_threads = omp_get_max_threads();
+    omp_set_num_threads( 1 );
+
+    TaskGraph graph;
+    graph.run( [&]( TaskGraph& g ) {
+        g.add( 0, {}, {}, [&] { order.push_back( 0 ); } );
+        g.add( 2, {}, {}, [&] { order.push_back( 1 ); } );
+        g.add( 1, {}, {}, [&] { order.push_back( 2 ); } );
+        g.add( 2, {}, {}, [&] { order.push_back( 3 ); } );
+    });
+    omp_set_num_threads( num_threads );
+
+    test_assert( order.size() == 4 );
+    test_assert( order[ 0 ] == 1 );
+    test_assert( order[ 1 ] == 3 );
+    test_assert( order[ 2 ] == 2 );
+    test_assert( order[ 3 ] == 0 );
+}
+
+//------------------------------------------------------------------------------
+/// Many small tasks on a few keys, so tasks finish while others are added.
+void test_many()
+{
+    int n = 10000;
+    std::vector<int> sums( 4, 0 );
+
+    TaskGraph graph;
+    graph.run( [&]( TaskGraph& g ) {
+        for (int i = 0; i < n; ++i) {
+            g.add( 0, {}, { { 0, i % 4, 0 } }, [&, i] { sums[ i % 4 ] += 1; } );
+        }
+    });
+
+    test_assert( graph.num_tasks() == n );
+    for (int k = 0; k < 4; ++k)
+        test_assert( sums[ k ] == n/4 );
+}
+
+//------------------------------------------------------------------------------
+/// Task bodies can use OpenMP tasks, as internal routines do.
+void test_omp_tasks()
+{
+    int n = 10, m = 10;
+    std::atomic<int> sum( 0 );
+    std::vector<int> sums;
+
+    TaskGraph graph;
+    graph.run( [&]( TaskGraph& g ) {
+        for (int i = 0; i < n; ++i) {
+            g.add( 0, {}, { { 0, 0, 0 } }, [&] {
+                #pragma omp taskgroup
+                for (int j = 0; j < m; ++j) {
+                    #pragma omp task shared( sum )
+                    {
+                        usleep( 10 );
+                        sum += 1;
+                    }
+                }
+                sums.push_back( sum );
+            });
+        }
+    });
+
+    test_assert( int( sums.size() ) == n );
+    for (int i = 0; i < n; ++i)
+        test_assert( sums[ i ] == (i + 1)*m );
+}
+
+//------------------------------------------------------------------------------
+/// An exception in a task is rethrown by run; later tasks are skipped.
+void test_exception()
+{
+    int count = 0;
+    TaskGraph graph;
+    test_assert_throw(
+        graph.run( [&]( TaskGraph& g ) {
+            g.add( 0, {}, { { 0, 0, 0 } }, [&] {
+                slate_error( "task failed" );
+            });
+            g.add( 0, {}, { { 0, 0, 0 } }, [&] { count += 1; } );
+        }),
+        slate::Exception );
+    test_assert( count == 0 );
+}
+
+//------------------------------------------------------------------------------
+/// Runs all tests. Called by unit test main().
+void run_tests()
+{
+    run_test(test_inout,       "TaskGraph inout");
+    run_test(test_in,          "TaskGraph in");
+    run_test(test_independent, "TaskGraph independent keys");
+    run_test(test_priority,    "TaskGraph priority");
+    run_test(test_many,        "TaskGraph many tasks");
+    run_test(test_omp_tasks,   "TaskGraph OpenMP tasks");
+    run_test(test_exception,   "TaskGraph exception");
+}
+
+}  // namespace test
+
+//------------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+    return unit_test_main();  // which calls run_tests()
+}
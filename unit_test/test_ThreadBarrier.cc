@@ -0,0 +1,152 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/internal/util.hh"
+#include "slate/internal/openmp.hh"
+
+#include "unit_test.hh"
+
+#include <cstring>
+#include <thread>
+#include <vector>
+
+using slate::ThreadBarrier;
+
+namespace test {
+
+bool g_bench = false;
+
+//------------------------------------------------------------------------------
+/// Pure spin barrier, the previous ThreadBarrier, for comparison.
+class SpinBarrier {
+public:
+    void wait( int size )
+    {
+        int passed_old = passed_;
+        if (count_.fetch_add( 1 ) == size - 1) {
+            count_.store( 0 );
+            ++passed_;
+        }
+        else
+            while (passed_ == passed_old) {}
+    }
+
+private:
+    std::atomic<int> count_ { 0 };
+    std::atomic<int> passed_ { 0 };
+};
+
+//------------------------------------------------------------------------------
+/// In each phase, every thread writes its entry, then after the barrier,
+/// checks all entries; a second barrier keeps the next phase's writes
+/// from racing the checks.
+void check_phases( int spin_count, int num_threads )
+{
+    ThreadBarrier barrier( spin_count );
+    int num_phases = 50;
+    std::vector<int> data( num_threads, -1 );
+    std::atomic<int> errors( 0 );
+
+    #pragma omp parallel num_threads( num_threads ) \
+        shared( barrier, data, errors )
+    {
+        int size = omp_get_num_threads();
+        int rank = omp_get_thread_num();
+        for (int phase = 0; phase < num_phases; ++phase) {
+            data[ rank ] = phase;
+            barrier.wait( size );
+            for (int i = 0; i < size; ++i) {
+                if (data[ i ] != phase)
+                    ++errors;
+            }
+            barrier.wait( size );
+        }
+    }
+    test_assert( errors.load() == 0 );
+}
+
+//------------------------------------------------------------------------------
+void test_spin()
+{
+    check_phases( ThreadBarrier::default_spin_count, 4 );
+}
+
+//------------------------------------------------------------------------------
+/// spin_count 0 goes straight to the yield and futex path.
+void test_sleep()
+{
+    check_phases( 0, 4 );
+}
+
+//------------------------------------------------------------------------------
+/// More threads than cores: the pure spin barrier may take a time slice
+/// per wait; ThreadBarrier must not.
+void test_oversubscribed()
+{
+    int cores = std::max( 1u, std::thread::hardware_concurrency() );
+    check_phases( ThreadBarrier::default_spin_count, 2*cores );
+}
+
+//------------------------------------------------------------------------------
+/// @return seconds per wait of barrier_t with num_threads.
+template <typename barrier_t>
+double time_barrier( int num_threads, int reps )
+{
+    barrier_t barrier;
+    double time = 0;
+    #pragma omp parallel num_threads( num_threads ) shared( barrier, time )
+    {
+        int size = omp_get_num_threads();
+        barrier.wait( size );
+        double t = omp_get_wtime();
+        for (int i = 0; i < reps; ++i)
+            barrier.wait( size );
+        #pragma omp master
+        time = (omp_get_wtime() - t) / reps;
+    }
+    return time;
+}
+
+//------------------------------------------------------------------------------
+/// Prints time per wait of SpinBarrier and ThreadBarrier for thread counts
+/// up to 2 per core. Run with --bench.
+void test_bench()
+{
+    if (! g_bench)
+        test_skip( "run with --bench" );
+
+    int cores = std::max( 1u, std::thread::hardware_concurrency() );
+    printf( "\n    %7s  %14s  %14s\n", "threads", "spin (us)", "hybrid (us)" );
+    for (int num_threads = 1; num_threads <= 2*cores; num_threads *= 2) {
+        // Oversubscribed, the spin barrier takes a time slice per wait.
+        int reps = num_threads > cores ? 100 : 10000;
+        double spin   = time_barrier< SpinBarrier   >( num_threads, reps );
+        double hybrid = time_barrier< ThreadBarrier >( num_threads, reps );
+        printf( "    %7d  %14.3f  %14.3f\n",
+                num_threads, spin * 1e6, hybrid * 1e6 );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Runs all tests. Called by unit test main().
+void run_tests()
+{
+    run_test(test_spin,           "ThreadBarrier spin");
+    run_test(test_sleep,          "ThreadBarrier sleep");
+    run_test(test_oversubscribed, "ThreadBarrier oversubscribed");
+    run_test(test_bench,          "ThreadBarrier benchmark");
+}
+
+}  // namespace test
+
+//------------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp( argv[ i ], "--bench" ) == 0)
+            test::g_bench = true;
+    }
+    return unit_test_main();  // which calls run_tests()
+}
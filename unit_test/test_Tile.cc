@@ -9,6 +9,8 @@
 
 #include "unit_test.hh"
 
+#include <algorithm>
+
 using slate::roundup;
 
 namespace test {
@@ -584,6 +586,185 @@ void test_send_recv_ss()
     test_send_recv(32, 32);
 }
 
+//------------------------------------------------------------------------------
+/// Tests isendSegment() and irecvSegment() between MPI ranks, sending the
+/// tile in uneven segments.
+/// src/dst lda is rounded up to multiple of align_src/dst, respectively.
+void test_send_recv_segments(int align_src, int align_dst)
+{
+    if (mpi_size == 1) {
+        test_skip("requires MPI comm size > 1");
+    }
+
+    const int m = 20;
+    const int n = 30;
+    const int num_segments = 7;
+    // even is src, odd is dst
+    int lda = roundup(m, (mpi_rank % 2 == 0 ? align_src : align_dst));
+    double* data = new double[ lda * n ];
+    assert(data != nullptr);
+    slate::Tile<double> A(m, n, data, lda, -1, slate::TileKind::UserOwned);
+    setup_data(A);
+
+    int r = int(mpi_rank / 2) * 2;
+    if (r+1 < mpi_size) {
+        // send from r to r+1
+        std::vector<MPI_Request> requests( num_segments );
+        for (int s = 0; s < num_segments; ++s) {
+            if (r == mpi_rank) {
+                A.isendSegment( r+1, MPI_COMM_WORLD, 0, s, num_segments,
+                                &requests[ s ] );
+            }
+            else {
+                A.irecvSegment( r, MPI_COMM_WORLD, A.layout(), 0,
+                                s, num_segments, &requests[ s ] );
+            }
+        }
+        MPI_Waitall( num_segments, requests.data(), MPI_STATUSES_IGNORE );
+        verify_data(A, r);
+    }
+    else {
+        verify_data(A, mpi_rank);
+    }
+
+    delete[] data;
+}
+
+// contiguous => contiguous
+void test_send_recv_segments_cc()
+{
+    test_send_recv_segments(1, 1);
+}
+
+// strided => strided
+void test_send_recv_segments_ss()
+{
+    test_send_recv_segments(32, 32);
+}
+
+//------------------------------------------------------------------------------
+/// Tests compress() and decompress(), lossless: exact for random data,
+/// which is sent raw, and shorter for a tile with many zeros.
+void test_compress_lossless()
+{
+    const int m = 20;
+    const int n = 30;
+    const int lda = 32;
+    std::vector<double> Adata( lda*n ), Bdata( lda*n, 0. );
+    slate::Tile<double> A( m, n, Adata.data(), lda, -1,
+                           slate::TileKind::UserOwned );
+    slate::Tile<double> B( m, n, Bdata.data(), lda, -1,
+                           slate::TileKind::UserOwned );
+    for (int j = 0; j < n; ++j)
+        for (int i = 0; i < m; ++i)
+            A.at( i, j ) = std::rand() / double( RAND_MAX ) - 0.5;
+
+    std::vector<char> message;
+    A.compress( slate::Compression::Lossless, 0, message );
+    test_assert( int64_t( message.size() ) <= int64_t( m*n*sizeof(double) ) );
+    B.decompress( message, A.layout() );
+    for (int j = 0; j < n; ++j)
+        for (int i = 0; i < m; ++i)
+            test_assert( B( i, j ) == A( i, j ) );
+
+    // Upper triangle of zeros.
+    for (int j = 0; j < n; ++j)
+        for (int i = 0; i < std::min( j, m ); ++i)
+            A.at( i, j ) = 0;
+    A.compress( slate::Compression::Lossless, 0, message );
+    test_assert( int64_t( message.size() ) < int64_t( m*n*sizeof(double) ) );
+    B.decompress( message, A.layout() );
+    for (int j = 0; j < n; ++j)
+        for (int i = 0; i < m; ++i)
+            test_assert( B( i, j ) == A( i, j ) );
+}
+
+//------------------------------------------------------------------------------
+/// Tests compress() and decompress(), error-bounded: each real and
+/// imaginary part within relative tol, and the message shorter.
+void test_compress_error_bounded()
+{
+    using scalar_t = std::complex<double>;
+    const int m = 20;
+    const int n = 30;
+    const int lda = 32;
+    const double tol = 1e-6;
+    std::vector<scalar_t> Adata( lda*n ), Bdata( lda*n );
+    slate::Tile<scalar_t> A( m, n, Adata.data(), lda, -1,
+                             slate::TileKind::UserOwned );
+    slate::Tile<scalar_t> B( m, n, Bdata.data(), lda, -1,
+                             slate::TileKind::UserOwned );
+    for (int j = 0; j < n; ++j) {
+        for (int i = 0; i < m; ++i) {
+            A.at( i, j ) = scalar_t( std::rand() / double( RAND_MAX ) - 0.5,
+                                     std::rand() / double( RAND_MAX ) * 1e3 );
+        }
+    }
+
+    std::vector<char> message;
+    A.compress( slate::Compression::ErrorBounded, tol, message );
+    test_assert( int64_t( message.size() ) < int64_t( m*n*sizeof(scalar_t) ) );
+    B.decompress( message, A.layout() );
+    for (int j = 0; j < n; ++j) {
+        for (int i = 0; i < m; ++i) {
+            test_assert( std::abs( real( B( i, j ) ) - real( A( i, j ) ) )
+                         <= tol * std::abs( real( A( i, j ) ) ) );
+            test_assert( std::abs( imag( B( i, j ) ) - imag( A( i, j ) ) )
+                         <= tol * std::abs( imag( A( i, j ) ) ) );
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Tests sendCompressed() and recvCompressed() between MPI ranks.
+/// src/dst lda is rounded up to multiple of align_src/dst, respectively.
+void test_send_recv_compressed(int align_src, int align_dst)
+{
+    if (mpi_size == 1) {
+        test_skip("requires MPI comm size > 1");
+    }
+
+    const int m = 20;
+    const int n = 30;
+    // even is src, odd is dst
+    int lda = roundup(m, (mpi_rank % 2 == 0 ? align_src : align_dst));
+    double* data = new double[ lda * n ];
+    assert(data != nullptr);
+    slate::Tile<double> A(m, n, data, lda, -1, slate::TileKind::UserOwned);
+    setup_data(A);
+
+    int r = int(mpi_rank / 2) * 2;
+    if (r+1 < mpi_size) {
+        // send from r to r+1
+        if (r == mpi_rank) {
+            A.sendCompressed( r+1, MPI_COMM_WORLD, 0,
+                              slate::Compression::Lossless );
+        }
+        else {
+            std::vector<char> message;
+            A.recvCompressed( r, MPI_COMM_WORLD, A.layout(), 0, message );
+        }
+        verify_data(A, r);
+    }
+    else {
+        verify_data(A, mpi_rank);
+    }
+
+    delete[] data;
+}
+
+// contiguous => strided
+void test_send_recv_compressed_cs()
+{
+    test_send_recv_compressed(1, 32);
+}
+
+// strided => contiguous
+void test_send_recv_compressed_sc()
+{
+    test_send_recv_compressed(32, 1);
+}
+
 //------------------------------------------------------------------------------
 /// Tests bcast() between MPI ranks.
 /// src/dst lda is rounded up to multiple of align_src/dst, respectively.
@@ -636,6 +817,28 @@ void test_bcast_ss()
     test_bcast(32, 32);
 }
 
+//------------------------------------------------------------------------------
+/// Tests bcast() of strided tiles packed in a contiguous buffer,
+/// and that the vector types of the unpacked bcast are cached.
+void test_bcast_packed()
+{
+    bool pack = slate::internal::mpiPackTiles();
+
+    slate::internal::mpiPackTiles( 1 );
+    test_bcast(1, 32);
+    test_bcast(32, 1);
+    test_bcast(32, 32);
+
+    slate::internal::mpiPackTiles( 0 );
+    test_bcast(32, 32);
+    int64_t size = slate::internal::vectorTypeCacheSize();
+    test_assert(size > 0);
+    test_bcast(32, 32);
+    test_assert(slate::internal::vectorTypeCacheSize() == size);
+
+    slate::internal::mpiPackTiles( pack );
+}
+
 //------------------------------------------------------------------------------
 /// Tests copyData().
 /// host/device lda is rounded up to multiple of align_host/dev, respectively.
@@ -714,6 +917,59 @@ void test_copyData_ss()
     test_copyData(32, 32);
 }
 
+//------------------------------------------------------------------------------
+/// Tests copyData between two devices, which goes peer-to-peer when the
+/// devices have peer access, and the order of sources for tileGet.
+void test_copyData_peer()
+{
+    if (num_devices < 2) {
+        test_skip("requires num_devices >= 2");
+    }
+
+    const int m = 20;
+    const int n = 30;
+    int lda = m;
+    double* dataA = new double[ lda * n ];
+    double* dataB = new double[ lda * n ];
+    slate::Tile<double> A(m, n, dataA, lda, -1, slate::TileKind::UserOwned);
+    slate::Tile<double> B(m, n, dataB, lda, -1, slate::TileKind::UserOwned);
+    setup_data(A);
+    setup_data(B);
+    clear_data(B);
+
+    blas::Queue queue0( 0 );
+    blas::Queue queue1( 1 );
+
+    double* Adata_dev = blas::device_malloc<double>(lda * n, queue0);
+    test_assert(Adata_dev != nullptr);
+    double* Bdata_dev = blas::device_malloc<double>(lda * n, queue1);
+    test_assert(Bdata_dev != nullptr);
+
+    slate::Tile<double> dA(m, n, Adata_dev, lda, 0, slate::TileKind::UserOwned);
+    slate::Tile<double> dB(m, n, Bdata_dev, lda, 1, slate::TileKind::UserOwned);
+
+    // copy H2D on device 0, D2D to device 1, D2H, then verify
+    A.copyData(&dA, queue0);
+    dA.copyData(&dB, queue1);
+    dB.copyData(&B, queue1);
+    verify_data(B, mpi_rank);
+
+    // Sources exclude the destination, and include the host for devices.
+    auto const& order = slate::internal::peer_source_order( 1 );
+    test_assert( int( order.size() ) == num_devices );
+    test_assert( std::find( order.begin(), order.end(), 1 ) == order.end() );
+    test_assert( std::find( order.begin(), order.end(), slate::HostNum )
+                 != order.end() );
+    if (slate::internal::peer_access( 0, 1 ))
+        test_assert( order[ 0 ] != slate::HostNum );
+
+    blas::device_free(Adata_dev, queue0);
+    blas::device_free(Bdata_dev, queue1);
+
+    delete[] dataA;
+    delete[] dataB;
+}
+
 //------------------------------------------------------------------------------
 /// Tests slate::print( "label", Tile )
 template <typename scalar_t>
@@ -812,12 +1068,21 @@ void run_tests()
         run_test(
             test_copyData_ss,
             "copyData: (H2D, D2D, D2H, H2H) strided => strided");
+        run_test(
+            test_copyData_peer,
+            "copyData: device to device (peer)");
         run_test(
             test_print_double,
             "print, double");
         run_test(
             test_print_complex,
             "print, complex");
+        run_test(
+            test_compress_lossless,
+            "compress, lossless");
+        run_test(
+            test_compress_error_bounded,
+            "compress, error-bounded, complex");
     }
     run_test(
         test_send_recv_cc,
@@ -831,6 +1096,18 @@ void run_tests()
     run_test(
         test_send_recv_ss,
         "send and recv, strided => strided",       MPI_COMM_WORLD);
+    run_test(
+        test_send_recv_segments_cc,
+        "send and recv segments, contiguous => contiguous", MPI_COMM_WORLD);
+    run_test(
+        test_send_recv_segments_ss,
+        "send and recv segments, strided => strided",       MPI_COMM_WORLD);
+    run_test(
+        test_send_recv_compressed_cs,
+        "send and recv compressed, contiguous => strided", MPI_COMM_WORLD);
+    run_test(
+        test_send_recv_compressed_sc,
+        "send and recv compressed, strided => contiguous", MPI_COMM_WORLD);
     run_test(
         test_bcast_cc,
         "bcast, contiguous => contiguous",         MPI_COMM_WORLD);
@@ -843,6 +1120,9 @@ void run_tests()
     run_test(
         test_bcast_ss,
         "bcast, strided => strided",               MPI_COMM_WORLD);
+    run_test(
+        test_bcast_packed,
+        "bcast, packed; cached vector types",     MPI_COMM_WORLD);
 }
 
 }  // namespace test
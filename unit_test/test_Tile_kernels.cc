@@ -135,7 +135,7 @@ void test_assert_equal(
 
 //------------------------------------------------------------------------------
 template <typename scalar_t>
-void test_gemm()
+void test_gemm( slate::ComputePrecision precision )
 {
     using blas::real;
     using blas::imag;
@@ -216,7 +216,7 @@ void test_gemm()
 
         // run test
         try {
-            slate::tile::gemm( alpha, A, B, beta, C );
+            slate::tile::gemm( alpha, A, B, beta, C, precision );
 
             // It should throw error if and only if
             // C is complex and
@@ -251,16 +251,30 @@ void test_gemm()
         //    print( "Chat_ref", m, n, opCref.data(), ldopc );
         //}
 
-        test_assert_equal( C, opCref.data(), ldopc, 3*sqrt(k)*eps, 3*sqrt(k)*eps );
+        // 3M's normwise bound has a larger constant; Higham, 2002, sec. 23.2.4.
+        real_t tol = 3*sqrt(k)*eps;
+        if (precision == slate::ComputePrecision::Complex3M)
+            tol *= 4;
+        test_assert_equal( C, opCref.data(), ldopc, tol, tol );
     }}}
 }
 
 void test_gemm()
 {
-    test_gemm< float  >();
-    test_gemm< double >();
-    test_gemm< std::complex<float>  >();
-    test_gemm< std::complex<double> >();
+    test_gemm< float  >( slate::ComputePrecision::Native );
+    test_gemm< double >( slate::ComputePrecision::Native );
+    test_gemm< std::complex<float>  >( slate::ComputePrecision::Native );
+    test_gemm< std::complex<double> >( slate::ComputePrecision::Native );
+}
+
+//------------------------------------------------------------------------------
+// 3M algorithm; real types use the real gemm.
+void test_gemm3m()
+{
+    test_gemm< float  >( slate::ComputePrecision::Complex3M );
+    test_gemm< double >( slate::ComputePrecision::Complex3M );
+    test_gemm< std::complex<float>  >( slate::ComputePrecision::Complex3M );
+    test_gemm< std::complex<double> >( slate::ComputePrecision::Complex3M );
 }
 
 //------------------------------------------------------------------------------
@@ -750,6 +764,113 @@ void test_potrf()
     test_potrf< std::complex<double> >();
 }
 
+//------------------------------------------------------------------------------
+/// Tests potrf, herk, and trsm on row-major tiles against the same
+/// operations on column-major copies.
+template <typename scalar_t>
+void test_row_major()
+{
+    using real_t = blas::real_type<scalar_t>;
+    real_t eps = std::numeric_limits< real_t >::epsilon();
+    const scalar_t one = 1.0;
+    int64_t iseed[4] = { 0, 1, 2, 3 };
+
+    int n = 30, k = 20;
+    int lda = n + 1;
+
+    // Row-major copy of column-major X, also with leading dimension lda.
+    auto row_major = [lda]( std::vector< scalar_t > const& X, int m, int nn ) {
+        std::vector< scalar_t > R( X.size() );
+        for (int j = 0; j < nn; ++j)
+            for (int i = 0; i < m; ++i)
+                R[ j + i*lda ] = X[ i + j*lda ];
+        return R;
+    };
+
+    for (int iu = 0; iu < 2; ++iu) {
+        blas::Uplo uplo = uplos[iu];
+        if (verbose)
+            printf( "row major( uplo=%c )\n", char(uplo) );
+
+        // Hermitian positive definite A.
+        std::vector< scalar_t > Adata( lda*n ), W( lda*n );
+        lapack::larnv( 1, iseed, W.size(), W.data() );
+        blas::gemm( blas::Layout::ColMajor, blas::Op::NoTrans,
+                    blas::Op::ConjTrans, n, n, n,
+                    one, W.data(), lda, W.data(), lda,
+                    0.0, Adata.data(), lda );
+        for (int j = 0; j < n; ++j)
+            Adata[ j + j*lda ] += n;
+        std::vector< scalar_t > Bdata( lda*k ), Cdata( lda*k );
+        lapack::larnv( 1, iseed, Bdata.size(), Bdata.data() );
+        lapack::larnv( 1, iseed, Cdata.size(), Cdata.data() );
+
+        std::vector< scalar_t > Arow = row_major( Adata, n, n );
+        std::vector< scalar_t > Brow = row_major( Bdata, n, k );
+        std::vector< scalar_t > Crow = row_major( Cdata, n, k );
+
+        slate::Tile< scalar_t > A( n, n, Adata.data(), lda, HostNum,
+                                   slate::TileKind::UserOwned );
+        slate::Tile< scalar_t > AR( n, n, Arow.data(), lda, HostNum,
+                                    slate::TileKind::UserOwned,
+                                    blas::Layout::RowMajor );
+        slate::Tile< scalar_t > B( n, k, Bdata.data(), lda, HostNum,
+                                   slate::TileKind::UserOwned );
+        slate::Tile< scalar_t > BR( n, k, Brow.data(), lda, HostNum,
+                                    slate::TileKind::UserOwned,
+                                    blas::Layout::RowMajor );
+        slate::Tile< scalar_t > C( n, k, Cdata.data(), lda, HostNum,
+                                   slate::TileKind::UserOwned );
+        slate::Tile< scalar_t > CR( n, k, Crow.data(), lda, HostNum,
+                                    slate::TileKind::UserOwned,
+                                    blas::Layout::RowMajor );
+        A.uplo( uplo );
+        AR.uplo( uplo );
+
+        // A = C C^H + A, then factor A = L L^H, then B = L^{-1} B.
+        slate::tile::herk( 1.0, C, 1.0, A );
+        slate::tile::herk( 1.0, CR, 1.0, AR );
+        for (int j = 0; j < n; ++j) {
+            Adata[ j + j*lda ] += n;
+            Arow[ j + j*lda ] += n;
+        }
+        test_assert( slate::tile::potrf( A ) == 0 );
+        test_assert( slate::tile::potrf( AR ) == 0 );
+        auto TA = A, TAR = AR;
+        slate::tile::trsm( blas::Side::Left, blas::Diag::NonUnit,
+                           one, TA, B );
+        slate::tile::trsm( blas::Side::Left, blas::Diag::NonUnit,
+                           one, TAR, BR );
+
+        // Compare the triangle of A and all of B.
+        real_t err_A = 0, err_B = 0;
+        for (int j = 0; j < n; ++j) {
+            for (int i = 0; i < n; ++i) {
+                if (uplo == blas::Uplo::Lower ? i >= j : i <= j) {
+                    err_A = std::max( err_A, std::abs( Adata[ i + j*lda ]
+                                                       - Arow[ j + i*lda ] ) );
+                }
+            }
+        }
+        for (int j = 0; j < k; ++j) {
+            for (int i = 0; i < n; ++i) {
+                err_B = std::max( err_B, std::abs( Bdata[ i + j*lda ]
+                                                   - Brow[ j + i*lda ] ) );
+            }
+        }
+        test_assert( err_A <= 10*n*eps*n );
+        test_assert( err_B <= 10*n*eps*n );
+    }
+}
+
+void test_row_major()
+{
+    test_row_major< float  >();
+    test_row_major< double >();
+    test_row_major< std::complex<float>  >();
+    test_row_major< std::complex<double> >();
+}
+
 //------------------------------------------------------------------------------
 template <typename scalar_t>
 void test_genorm()
@@ -1237,6 +1358,190 @@ void test_deepConjTranspose()
     }
 }
 
+//------------------------------------------------------------------------------
+/// Tests host copy with precision conversion, gecopy( A, B ), and fused
+/// convert-and-scale, gecopy( alpha, A, B ), and reports their bandwidth.
+template <typename src_scalar_t, typename dst_scalar_t>
+void test_host_gecopy_work(int m, int n, int lda, int repeat)
+{
+    using blas::real;
+    using real_t = blas::real_type<dst_scalar_t>;
+    if (verbose)
+        printf( "%s< %s, %s >( m=%4d, n=%4d, lda=%4d )\n", __func__,
+                type_name<src_scalar_t>().c_str(),
+                type_name<dst_scalar_t>().c_str(), m, n, lda );
+
+    std::vector<src_scalar_t> Adata( lda*n );
+    std::vector<dst_scalar_t> Bdata( lda*n );
+
+    int64_t idist = 3;
+    int64_t iseed[4] = { 1, 2, 3, 5 };
+    lapack::larnv( idist, iseed, Adata.size(), Adata.data() );
+
+    slate::Tile< src_scalar_t > A( m, n, Adata.data(), lda, HostNum,
+                                   slate::TileKind::UserOwned );
+    slate::Tile< dst_scalar_t > B( m, n, Bdata.data(), lda, HostNum,
+                                   slate::TileKind::UserOwned );
+    double gbytes = double( m ) * n
+                  * (sizeof( src_scalar_t ) + sizeof( dst_scalar_t )) * 1e-9;
+
+    //-----------------------------------------
+    // copy
+    for (int r = 0; r < repeat; ++r) {
+        double time = omp_get_wtime();
+        slate::tile::gecopy( A, B );
+        time = omp_get_wtime() - time;
+        if (verbose)
+            printf( "    gecopy         time %.6f, GB/s (read & write) %.4f\n",
+                    time, gbytes / time );
+    }
+    for (int j = 0; j < n; ++j)
+        for (int i = 0; i < m; ++i)
+            test_assert( B(i, j) == dst_scalar_t( A(i, j) ) );
+
+    //-----------------------------------------
+    // copy and scale
+    dst_scalar_t alpha = 1.5;
+    for (int r = 0; r < repeat; ++r) {
+        double time = omp_get_wtime();
+        slate::tile::gecopy( alpha, A, B );
+        time = omp_get_wtime() - time;
+        if (verbose)
+            printf( "    gecopy(alpha)  time %.6f, GB/s (read & write) %.4f\n",
+                    time, gbytes / time );
+    }
+    real_t eps = std::numeric_limits<real_t>::epsilon();
+    for (int j = 0; j < n; ++j) {
+        for (int i = 0; i < m; ++i) {
+            dst_scalar_t ref = alpha * dst_scalar_t( A(i, j) );
+            test_assert( std::abs( B(i, j) - ref ) <= 3*eps*std::abs( ref ) );
+        }
+    }
+
+    //-----------------------------------------
+    // copy transposed view into transposed view, and conj into non-conj
+    if (m == n) {
+        auto AT = transpose( A );
+        auto BT = transpose( B );
+        slate::tile::gecopy( AT, BT );
+        for (int j = 0; j < n; ++j)
+            for (int i = 0; i < m; ++i)
+                test_assert( B(i, j) == dst_scalar_t( A(i, j) ) );
+
+        auto AH = conj_transpose( A );
+        slate::tile::gecopy( AH, BT );
+        for (int j = 0; j < n; ++j)
+            for (int i = 0; i < m; ++i)
+                test_assert( B(i, j) == dst_scalar_t( blas::conj( A(i, j) ) ) );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Tests host add, Y = alpha X + beta Y, and reports its bandwidth.
+template <typename scalar_t>
+void test_host_add_work(int m, int n, int lda, int repeat)
+{
+    using real_t = blas::real_type<scalar_t>;
+    if (verbose)
+        printf( "%s< %s >( m=%4d, n=%4d, lda=%4d )\n", __func__,
+                type_name<scalar_t>().c_str(), m, n, lda );
+
+    std::vector<scalar_t> Xdata( lda*n ), Ydata( lda*n ), Yref( lda*n );
+
+    int64_t idist = 3;
+    int64_t iseed[4] = { 1, 2, 3, 5 };
+    lapack::larnv( idist, iseed, Xdata.size(), Xdata.data() );
+    lapack::larnv( idist, iseed, Ydata.size(), Ydata.data() );
+
+    slate::Tile< scalar_t > X( m, n, Xdata.data(), lda, HostNum,
+                               slate::TileKind::UserOwned );
+    slate::Tile< scalar_t > Y( m, n, Ydata.data(), lda, HostNum,
+                               slate::TileKind::UserOwned );
+    double gbytes = double( m ) * n * sizeof( scalar_t ) * 1e-9;
+    real_t eps = std::numeric_limits<real_t>::epsilon();
+
+    // alpha and beta are powers of 2, so the results don't depend on
+    // the order of operations.
+    scalar_t alpha = 0.5, beta = 2.0;
+    for (int r = 0; r < repeat; ++r) {
+        Yref = Ydata;
+        double time = omp_get_wtime();
+        slate::tile::add( alpha, X, beta, Y );
+        time = omp_get_wtime() - time;
+        if (verbose)
+            printf( "    add            time %.6f, GB/s (read & write) %.4f\n",
+                    time, 3 * gbytes / time );
+    }
+    for (int j = 0; j < n; ++j) {
+        for (int i = 0; i < m; ++i) {
+            scalar_t ref = alpha * Xdata[ i + j*lda ] + beta * Yref[ i + j*lda ];
+            test_assert( std::abs( Y(i, j) - ref ) <= 3*eps*std::abs( ref ) );
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Tests host add with precision conversion, Y = alpha X_lo + beta Y.
+template <typename src_scalar_t, typename dst_scalar_t>
+void test_host_geadd_mixed_work(int m, int n, int lda)
+{
+    using real_t = blas::real_type<dst_scalar_t>;
+    if (verbose)
+        printf( "%s< %s, %s >( m=%4d, n=%4d, lda=%4d )\n", __func__,
+                type_name<src_scalar_t>().c_str(),
+                type_name<dst_scalar_t>().c_str(), m, n, lda );
+
+    std::vector<src_scalar_t> Xdata( lda*n );
+    std::vector<dst_scalar_t> Ydata( lda*n ), Yref( lda*n );
+
+    int64_t idist = 3;
+    int64_t iseed[4] = { 1, 2, 3, 5 };
+    lapack::larnv( idist, iseed, Xdata.size(), Xdata.data() );
+    lapack::larnv( idist, iseed, Ydata.size(), Ydata.data() );
+    Yref = Ydata;
+
+    slate::Tile< src_scalar_t > X( m, n, Xdata.data(), lda, HostNum,
+                                   slate::TileKind::UserOwned );
+    slate::Tile< dst_scalar_t > Y( m, n, Ydata.data(), lda, HostNum,
+                                   slate::TileKind::UserOwned );
+    real_t eps = std::numeric_limits<real_t>::epsilon();
+
+    dst_scalar_t alpha = 0.5, beta = 2.0;
+    slate::tile::geadd( alpha, X, beta, Y );
+    for (int j = 0; j < n; ++j) {
+        for (int i = 0; i < m; ++i) {
+            dst_scalar_t ref = alpha * dst_scalar_t( Xdata[ i + j*lda ] )
+                             + beta * Yref[ i + j*lda ];
+            test_assert( std::abs( Y(i, j) - ref ) <= 3*eps*std::abs( ref ) );
+        }
+    }
+}
+
+void test_host_kernels()
+{
+    // Contiguous tiles take the flat loops, padded tiles the column loops.
+    int repeat = verbose ? 3 : 1;
+    for (int n : { 32, 512 }) {
+        for (int lda : { n, n + 3 }) {
+            test_host_gecopy_work< double, float  >( n, n, lda, repeat );
+            test_host_gecopy_work< float,  double >( n, n, lda, repeat );
+            test_host_gecopy_work< std::complex<double>, std::complex<float>  >(
+                n, n, lda, repeat );
+            test_host_gecopy_work< std::complex<float>,  std::complex<double> >(
+                n, n, lda, repeat );
+
+            test_host_add_work< float  >( n, n, lda, repeat );
+            test_host_add_work< double >( n, n, lda, repeat );
+            test_host_add_work< std::complex<float>  >( n, n, lda, repeat );
+            test_host_add_work< std::complex<double> >( n, n, lda, repeat );
+
+            test_host_geadd_mixed_work< float, double >( n, n, lda );
+            test_host_geadd_mixed_work< std::complex<float>,
+                                        std::complex<double> >( n, n, lda );
+        }
+    }
+}
+
 //------------------------------------------------------------------------------
 enum class Section {
     newline = 0,  // zero flag forces newline
@@ -1260,6 +1565,7 @@ typedef struct {
 //------------------------------------------------------------------------------
 std::vector< routines_t > routines = {
     { "gemm",   test_gemm,   Section::blas_section },
+    { "gemm3m", test_gemm3m, Section::blas_section },
     { "syrk",   test_syrk,   Section::blas_section },
     { "herk",   test_herk,   Section::blas_section },
     { "trsm",   test_trsm,   Section::blas_section },
@@ -1269,6 +1575,7 @@ std::vector< routines_t > routines = {
     { "",       nullptr,     Section::newline      },
 
     { "potrf",  test_potrf,  Section::factor       },
+    { "row_major", test_row_major, Section::factor    },
     { "",       nullptr,     Section::newline      },
 
     { "convert_layout",        test_convert_layout,        Section::convert },
@@ -1277,6 +1584,7 @@ std::vector< routines_t > routines = {
 
     { "deepTranspose",         test_deepTranspose,         Section::copy },
     { "deepConjTranspose",     test_deepConjTranspose,     Section::copy },
+    { "host_kernels",          test_host_kernels,          Section::copy },
     { "",                      nullptr,                    Section::newline },
 };
 
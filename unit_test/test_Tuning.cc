@@ -0,0 +1,172 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/Tuning.hh"
+#include "slate/Exception.hh"
+
+#include "unit_test.hh"
+
+#include <cstdio>
+#include <fstream>
+#include <unistd.h>
+
+using slate::TuningDB;
+using slate::TuningKey;
+using slate::TuningEntry;
+using slate::Option;
+using slate::Target;
+
+namespace test {
+
+//------------------------------------------------------------------------------
+void test_sizeClass()
+{
+    test_assert( TuningDB::sizeClass( 0 ) == 0 );
+    test_assert( TuningDB::sizeClass( 1 ) == 0 );
+    test_assert( TuningDB::sizeClass( 2 ) == 1 );
+    test_assert( TuningDB::sizeClass( 1023 ) == 9 );
+    test_assert( TuningDB::sizeClass( 1024 ) == 10 );
+    test_assert( TuningDB::sizeClass( 2047 ) == 10 );
+}
+
+//------------------------------------------------------------------------------
+/// record keeps the fastest entry of each key.
+void test_record()
+{
+    TuningDB db;
+    TuningKey key = { "getrf", 'd', Target::HostTask, 10, 2, 2 };
+    TuningEntry entry;
+    test_assert( db.empty() );
+    test_assert( ! db.lookup( key, &entry ) );
+
+    entry.nb = 256;
+    entry.gflops = 100;
+    test_assert( db.record( key, entry ) );
+
+    entry.nb = 128;
+    entry.gflops = 50;
+    test_assert( ! db.record( key, entry ) );
+
+    TuningEntry found;
+    test_assert( db.lookup( key, &found ) );
+    test_assert( found.nb == 256 );
+    test_assert( found.gflops == 100 );
+
+    entry.nb = 384;
+    entry.gflops = 200;
+    test_assert( db.record( key, entry ) );
+    test_assert( db.lookup( key, &found ) );
+    test_assert( found.nb == 384 );
+
+    // Other keys are separate.
+    TuningKey key2 = key;
+    key2.p = 1;
+    key2.q = 4;
+    test_assert( ! db.lookup( key2, &found ) );
+    key2 = key;
+    key2.precision = 'z';
+    test_assert( ! db.lookup( key2, &found ) );
+
+    db.clear();
+    test_assert( db.empty() );
+}
+
+//------------------------------------------------------------------------------
+/// save and load round trip; load skips comments and malformed lines.
+void test_save_load()
+{
+    char path[] = "/tmp/slate_tuning_XXXXXX";
+    int fd = mkstemp( path );
+    test_assert( fd >= 0 );
+    close( fd );
+
+    TuningDB db;
+    TuningKey key1 = { "getrf", 'd', Target::HostTask, 12, 2, 2 };
+    TuningKey key2 = { "potrf", 's', Target::Devices,  14, 1, 4 };
+    TuningEntry entry1, entry2;
+    entry1.nb = 256;
+    entry1.ib = 32;
+    entry1.lookahead = 2;
+    entry1.panel_threads = 4;
+    entry1.gflops = 123.5;
+    entry2.nb = 1024;
+    entry2.lookahead = slate::LookaheadAuto;
+    entry2.gflops = 4567;
+    db.record( key1, entry1 );
+    db.record( key2, entry2 );
+    db.save( path );
+
+    // Append junk, which load should skip.
+    {
+        std::ofstream file( path, std::ios::app );
+        file << "# comment\n" << "getrf d T not numbers\n" << "\n";
+    }
+
+    TuningDB db2;
+    db2.load( path );
+    TuningEntry found;
+    test_assert( db2.lookup( key1, &found ) );
+    test_assert( found.nb == 256 );
+    test_assert( found.ib == 32 );
+    test_assert( found.lookahead == 2 );
+    test_assert( found.panel_threads == 4 );
+    test_assert( found.gflops == 123.5 );
+    test_assert( db2.lookup( key2, &found ) );
+    test_assert( found.nb == 1024 );
+    test_assert( found.ib == 0 );
+    test_assert( found.lookahead == slate::LookaheadAuto );
+
+    remove( path );
+
+    // A missing file is empty.
+    TuningDB db3;
+    db3.load( path );
+    test_assert( db3.empty() );
+}
+
+//------------------------------------------------------------------------------
+/// tunedOptions adds only the options the caller didn't set.
+void test_tunedOptions()
+{
+    TuningDB db;
+    TuningKey key = { "potrf", 'd', Target::HostTask, 11, 1, 1 };
+    TuningEntry entry;
+    entry.nb = 192;
+    entry.ib = 48;
+    entry.lookahead = 3;
+    entry.gflops = 10;
+    db.record( key, entry );
+
+    slate::Options opts = { { Option::Lookahead, 1 } };
+    slate::Options tuned = db.tunedOptions( key, opts );
+    test_assert( slate::get_option<Option::Lookahead>( tuned, 0 ) == 1 );
+    test_assert( slate::get_option<Option::InnerBlocking>( tuned, 0 ) == 48 );
+    test_assert( slate::get_option<Option::BlockSize>( tuned, 0 ) == 192 );
+    // panel_threads not tuned
+    test_assert( tuned.count( Option::MaxPanelThreads ) == 0 );
+
+    // No entry: unchanged.
+    key.size_class = 12;
+    tuned = db.tunedOptions( key, opts );
+    test_assert( tuned.size() == 1 );
+}
+
+//------------------------------------------------------------------------------
+/// Runs all tests. Called by unit test main().
+void run_tests()
+{
+    run_test(test_sizeClass,    "TuningDB sizeClass");
+    run_test(test_record,       "TuningDB record");
+    run_test(test_save_load,    "TuningDB save, load");
+    run_test(test_tunedOptions, "TuningDB tunedOptions");
+}
+
+}  // namespace test
+
+//------------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+    return unit_test_main();  // which calls run_tests()
+}
@@ -0,0 +1,96 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/slate.hh"
+
+#include "unit_test.hh"
+
+#include <atomic>
+#include <thread>
+
+namespace test {
+
+//------------------------------------------------------------------------------
+/// Calls on different communicators run concurrently and share threads.
+void test_launch()
+{
+    MPI_Comm comm2;
+    MPI_Comm_dup( MPI_COMM_SELF, &comm2 );
+
+    int max_threads = omp_get_max_threads();
+    std::atomic<int> go( 0 );
+
+    auto f1 = slate::async::launch( MPI_COMM_SELF, [&] {
+        // Wait for the second call, so both are in flight.
+        while (go.load() == 0)
+            std::this_thread::yield();
+        return omp_get_max_threads();
+    });
+    auto f2 = slate::async::launch( comm2, [&] {
+        go.store( 1 );
+        return omp_get_max_threads();
+    });
+
+    int threads1 = f1.get();
+    int threads2 = f2.get();
+    test_assert( threads1 == max_threads );
+    test_assert( threads2 == std::max( 1, max_threads / 2 ) );
+
+    MPI_Comm_free( &comm2 );
+}
+
+//------------------------------------------------------------------------------
+/// A second call on a communicator in flight throws; once the first
+/// finishes, the communicator can be used again.
+void test_same_comm()
+{
+    std::atomic<int> go( 0 );
+    auto f1 = slate::async::launch( MPI_COMM_SELF, [&] {
+        while (go.load() == 0)
+            std::this_thread::yield();
+    });
+    test_assert_throw(
+        slate::async::launch( MPI_COMM_SELF, [] {} ),
+        slate::Exception );
+    go.store( 1 );
+    f1.get();
+
+    auto f2 = slate::async::launch( MPI_COMM_SELF, [] { return 42; } );
+    test_assert( f2.get() == 42 );
+}
+
+//------------------------------------------------------------------------------
+/// Exceptions are rethrown by get, and release the communicator.
+void test_exception()
+{
+    auto f1 = slate::async::launch( MPI_COMM_SELF, [] {
+        slate_error( "test" );
+    });
+    test_assert_throw( f1.get(), slate::Exception );
+
+    auto f2 = slate::async::launch( MPI_COMM_SELF, [] { return 1; } );
+    test_assert( f2.get() == 1 );
+}
+
+//------------------------------------------------------------------------------
+/// Runs all tests. Called by unit test main().
+void run_tests()
+{
+    run_test(test_launch,    "async::launch");
+    run_test(test_same_comm, "async::launch same communicator");
+    run_test(test_exception, "async::launch exception");
+}
+
+}  // namespace test
+
+//------------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+    int provided = 0;
+    MPI_Init_thread( &argc, &argv, MPI_THREAD_MULTIPLE, &provided );
+    int err = unit_test_main();  // which calls run_tests()
+    MPI_Finalize();
+    return err;
+}
@@ -14,6 +14,7 @@ void test_enums()
     assert( slate_TileKind_Workspace  == int( slate::TileKind::Workspace  ) );
     assert( slate_TileKind_SlateOwned == int( slate::TileKind::SlateOwned ) );
     assert( slate_TileKind_UserOwned  == int( slate::TileKind::UserOwned  ) );
+    assert( slate_TileKind_FileMapped == int( slate::TileKind::FileMapped ) );
 
     //----------
     assert( slate_Target_Host      == int( slate::Target::Host      ) );
@@ -21,11 +22,13 @@ void test_enums()
     assert( slate_Target_HostNest  == int( slate::Target::HostNest  ) );
     assert( slate_Target_HostBatch == int( slate::Target::HostBatch ) );
     assert( slate_Target_Devices   == int( slate::Target::Devices   ) );
+    assert( slate_Target_Hybrid    == int( slate::Target::Hybrid    ) );
 
 
     //----------
     assert( slate_MethodEig_QR == int( slate::MethodEig::QR ) );
     assert( slate_MethodEig_DC == int( slate::MethodEig::DC ) );
+    assert( slate_MethodEig_QDWH == int( slate::MethodEig::QDWH ) );
 
     //----------
     assert( slate_Option_ChunkSize           == int( slate::Option::ChunkSize           ) );
@@ -41,7 +44,28 @@ void test_enums()
     assert( slate_Option_PrintEdgeItems      == int( slate::Option::PrintEdgeItems      ) );
     assert( slate_Option_PrintWidth          == int( slate::Option::PrintWidth          ) );
     assert( slate_Option_PrintPrecision      == int( slate::Option::PrintPrecision      ) );
+    assert( slate_Option_PrintBinary         == int( slate::Option::PrintBinary         ) );
     assert( slate_Option_PivotThreshold      == int( slate::Option::PivotThreshold      ) );
+    assert( slate_Option_HostWorkspaceTiles  == int( slate::Option::HostWorkspaceTiles  ) );
+    assert( slate_Option_DeviceCacheTiles    == int( slate::Option::DeviceCacheTiles    ) );
+    assert( slate_Option_HostFirstTouch      == int( slate::Option::HostFirstTouch      ) );
+    assert( slate_Option_HostTileArena       == int( slate::Option::HostTileArena       ) );
+    assert( slate_Option_BcastPacked         == int( slate::Option::BcastPacked         ) );
+    assert( slate_Option_ProgressThread      == int( slate::Option::ProgressThread      ) );
+    assert( slate_Option_BcastPrecision      == int( slate::Option::BcastPrecision      ) );
+    assert( slate_Option_Counters            == int( slate::Option::Counters            ) );
+    assert( slate_Option_TaskRuntime         == int( slate::Option::TaskRuntime         ) );
+    assert( slate_Option_MaxLookahead        == int( slate::Option::MaxLookahead        ) );
+    assert( slate_Option_QueuePriority       == int( slate::Option::QueuePriority       ) );
+    assert( slate_Option_PanelTarget         == int( slate::Option::PanelTarget         ) );
+    assert( slate_Option_ComputePrecision    == int( slate::Option::ComputePrecision    ) );
+    assert( slate_Option_Layers              == int( slate::Option::Layers              ) );
+    assert( slate_Option_TreeArity           == int( slate::Option::TreeArity           ) );
+    assert( slate_Option_Oversampling        == int( slate::Option::Oversampling        ) );
+    assert( slate_Option_PowerIterations     == int( slate::Option::PowerIterations     ) );
+    assert( slate_Option_FactorsResident     == int( slate::Option::FactorsResident     ) );
+    assert( slate_Option_EstimateColumns     == int( slate::Option::EstimateColumns     ) );
+    assert( slate_Option_Checkpoint          == int( slate::Option::Checkpoint          ) );
 
     assert( slate_Option_MethodCholQR        == int( slate::Option::MethodCholQR        ) );
     assert( slate_Option_MethodEig           == int( slate::Option::MethodEig           ) );
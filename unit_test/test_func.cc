@@ -225,6 +225,274 @@ void test_device_1d_grid()
     }
 }
 
+//------------------------------------------------------------------------------
+void test_symmetric_2d_grid()
+{
+    for (int64_t r = 2; r <= 8; ++r) {
+        int size = int( r*(r-1)/2 );
+        auto grid = slate::func::symmetric_2d_grid( r );
+
+        for (int64_t i = 0; i < 10*r; ++i) {
+            for (int64_t j = 0; j < 10*r; ++j) {
+                int rank = grid( {i, j} );
+                test_assert( 0 <= rank && rank < size );
+                // mirrored tiles are on the same rank
+                test_assert( rank == grid( {j, i} ) );
+                // periodic off the diagonal
+                if (i % r != j % r)
+                    test_assert( rank == grid( {i % r, j % r} ) );
+            }
+            // the diagonal tile is on a rank of the pattern row
+            bool found = false;
+            for (int64_t b = 0; b < r; ++b) {
+                if (b != i % r && grid( {i % r, b} ) == grid( {i, i} ))
+                    found = true;
+            }
+            test_assert( found );
+        }
+
+        // each triangle of the pattern has one tile per rank
+        std::vector<int> count( size, 0 );
+        for (int64_t a = 0; a < r; ++a) {
+            for (int64_t b = 0; b < a; ++b)
+                ++count[ grid( {a, b} ) ];
+        }
+        for (int rank = 0; rank < size; ++rank)
+            test_assert( count[ rank ] == 1 );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Models the load of potrf on the lower triangle of an nt-by-nt tile
+/// matrix distributed by grid: the flop imbalance, max over ranks / mean,
+/// in units of nb^3, and the max over ranks of the number of panel tiles
+/// received.
+void potrf_load(
+    int64_t nt, int size,
+    std::function<int (std::tuple<int64_t, int64_t>)> grid,
+    double* imbalance, int64_t* max_recv )
+{
+    std::vector<double> flops( size, 0.0 );
+    std::vector<int64_t> recv( size, 0 );
+    for (int64_t j = 0; j < nt; ++j) {
+        // herk or gemm per previous step, then potrf or trsm
+        flops[ grid( {j, j} ) ] += j + 1.0/3;
+        for (int64_t i = j+1; i < nt; ++i)
+            flops[ grid( {i, j} ) ] += 2*j + 1;
+    }
+    for (int64_t k = 0; k < nt; ++k) {
+        // A(i, j) needs the panel tiles A(i, k) and A(j, k)
+        std::vector< std::vector<bool> > needs(
+            size, std::vector<bool>( nt, false ) );
+        for (int64_t j = k+1; j < nt; ++j) {
+            for (int64_t i = j; i < nt; ++i) {
+                int rank = grid( {i, j} );
+                needs[ rank ][ i ] = true;
+                needs[ rank ][ j ] = true;
+            }
+        }
+        for (int rank = 0; rank < size; ++rank) {
+            for (int64_t i = k+1; i < nt; ++i) {
+                if (needs[ rank ][ i ] && grid( {i, k} ) != rank)
+                    ++recv[ rank ];
+            }
+        }
+    }
+    double sum = 0, max = 0;
+    for (int rank = 0; rank < size; ++rank) {
+        sum += flops[ rank ];
+        max = std::max( max, flops[ rank ] );
+    }
+    *imbalance = max / (sum / size);
+    *max_recv = *std::max_element( recv.begin(), recv.end() );
+}
+
+//------------------------------------------------------------------------------
+/// Compares potrf with symmetric_2d_grid to process_2d_grid on as many
+/// ranks: symmetric block cyclic receives fewer panel tiles, at a flop
+/// imbalance that vanishes as nt grows.
+void test_symmetric_2d_grid_load()
+{
+    struct Case { int64_t r; int p, q; };
+    for (Case c : { Case{ 4, 2, 3 }, Case{ 5, 2, 5 },
+                    Case{ 6, 3, 5 }, Case{ 8, 4, 7 } }) {
+        int size = c.p * c.q;
+        test_assert( size == c.r*(c.r-1)/2 );
+        for (int64_t nt : { 12*c.r, 48*c.r }) {
+            double imbalance_2d, imbalance_sym;
+            int64_t recv_2d, recv_sym;
+            potrf_load( nt, size,
+                        slate::func::process_2d_grid(
+                            slate::GridOrder::Col, c.p, c.q ),
+                        &imbalance_2d, &recv_2d );
+            potrf_load( nt, size, slate::func::symmetric_2d_grid( c.r ),
+                        &imbalance_sym, &recv_sym );
+            if (verbose) {
+                printf( "\n%2d ranks, nt %4lld: 2d %d x %d imbalance %.3f"
+                        " recv %6lld, symmetric r %lld imbalance %.3f"
+                        " recv %6lld",
+                        size, llong( nt ), c.p, c.q, imbalance_2d,
+                        llong( recv_2d ), llong( c.r ), imbalance_sym,
+                        llong( recv_sym ) );
+            }
+            test_assert( recv_sym < recv_2d );
+            test_assert( imbalance_sym < (nt > 12*c.r ? 1.05 : 1.2) );
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+void test_weighted_1d_grid()
+{
+    // Equal weights match device_1d_grid.
+    auto equal = slate::func::weighted_1d_grid( slate::GridOrder::Col, 3,
+                                                { 1, 1, 1, 1 } );
+    auto ref = slate::func::device_1d_grid( slate::GridOrder::Col, 3, 4 );
+    for (int64_t i = 0; i < 60; ++i) {
+        for (int64_t j = 0; j < 5; ++j)
+            test_assert( equal( {i, j} ) == ref( {i, j} ) );
+    }
+
+    // Each member gets its weight of blocks per period, spread out.
+    std::vector<int64_t> weights = { 2, 1, 0, 3 };
+    auto grid_row = slate::func::weighted_1d_grid( slate::GridOrder::Row, 2,
+                                                   weights );
+    std::vector<int64_t> count( weights.size(), 0 );
+    int64_t period = 6;
+    for (int64_t j = 0; j < 2*period*10; ++j) {
+        int d = grid_row( {7, j} );
+        test_assert( 0 <= d && d < int( weights.size() ) );
+        count[ d ] += 1;
+        // same member for each block of block_size columns
+        test_assert( d == grid_row( {0, 2*(j/2)} ) );
+        test_assert( d == grid_row( {0, j + 2*period} ) );
+    }
+    for (size_t d = 0; d < weights.size(); ++d)
+        test_assert( count[ d ] == 2*10*weights[ d ] );
+
+    // The heaviest member never gets more than 2 blocks in a row.
+    auto pattern = slate::func::weighted_pattern( weights );
+    test_assert( int64_t( pattern.size() ) == period );
+    for (int64_t k = 0; k < period; ++k) {
+        test_assert( ! (pattern[ k ] == 3
+                        && pattern[ (k+1) % period ] == 3
+                        && pattern[ (k+2) % period ] == 3) );
+    }
+}
+
+//------------------------------------------------------------------------------
+void test_weighted_2d_grid()
+{
+    // Equal weights match process_2d_grid.
+    for (auto order : { slate::GridOrder::Col, slate::GridOrder::Row }) {
+        auto equal = slate::func::weighted_2d_grid( order, { 1, 1, 1, 1 },
+                                                    { 1, 1, 1, 1, 1 } );
+        auto ref = slate::func::process_2d_grid( order, 4, 5 );
+        for (int64_t i = 0; i < 40; ++i) {
+            for (int64_t j = 0; j < 40; ++j)
+                test_assert( equal( {i, j} ) == ref( {i, j} ) );
+        }
+    }
+
+    // Process row r gets p_weights[ r ] of every 3 block rows.
+    auto grid = slate::func::weighted_2d_grid( slate::GridOrder::Col,
+                                               { 2, 1 }, { 1, 1, 1 } );
+    std::vector<int64_t> count( 6, 0 );
+    for (int64_t i = 0; i < 30; ++i) {
+        for (int64_t j = 0; j < 30; ++j)
+            count[ grid( {i, j} ) ] += 1;
+    }
+    for (int rank = 0; rank < 6; ++rank)
+        test_assert( count[ rank ] == (rank % 2 == 0 ? 200 : 100) );
+}
+
+//------------------------------------------------------------------------------
+void test_weights_from_rates()
+{
+    using weights_t = std::vector<int64_t>;
+    test_assert( slate::func::weights_from_rates( { 10.0, 10.0 } )
+                 == weights_t( { 1, 1 } ) );
+    test_assert( slate::func::weights_from_rates( { 19.5, 10.0, 9.8 } )
+                 == weights_t( { 2, 1, 1 } ) );
+    test_assert( slate::func::weights_from_rates( { 3.0, 1.0 }, 4 )
+                 == weights_t( { 4, 1 } ) );
+    test_assert( slate::func::weights_from_rates( { 100.0, 1.0 }, 4 )
+                 == weights_t( { 4, 1 } ) );
+}
+
+//------------------------------------------------------------------------------
+/// Checks that process rows or columns of the selected grid stay on one node.
+///
+/// @return true if every process row (row_node) or column (!row_node)
+/// of the p-by-q grid maps to ranks on a single node.
+bool grid_stays_on_node(
+    std::function<int( slate::func::ij_tuple )> const& grid,
+    std::vector<int> const& nodes, int p, int q, bool row_node )
+{
+    int outer = row_node ? p : q;
+    int inner = row_node ? q : p;
+    for (int a = 0; a < outer; ++a) {
+        for (int b = 1; b < inner; ++b) {
+            int r0 = row_node ? grid( { a, 0 } ) : grid( { 0, a } );
+            int rb = row_node ? grid( { a, b } ) : grid( { b, a } );
+            if (nodes[ r0 ] != nodes[ rb ])
+                return false;
+        }
+    }
+    return true;
+}
+
+//------------------------------------------------------------------------------
+void test_topology_grid()
+{
+    int64_t nb = 256;
+    int64_t n = 100*nb;
+    slate::GridOrder order;
+    int p, q;
+
+    // A single node gives the usual column-major near-square grid.
+    std::vector<int> one_node( 8, 0 );
+    auto grid = slate::func::topology_grid(
+        "getrf", n, n, nb, one_node, &order, &p, &q );
+    test_assert( order == slate::GridOrder::Col );
+    test_assert( p == 2 && q == 4 );
+    for (int i = 0; i < p; ++i)
+        for (int j = 0; j < q; ++j)
+            test_assert( grid( { i, j } ) == i + j*p );
+
+    // Tall-skinny matrices use a single process column.
+    slate::func::topology_grid(
+        "getrf", n, nb, nb, one_node, &order, &p, &q );
+    test_assert( p == 8 && q == 1 );
+
+    // Two nodes with consecutive ranks, and with round-robin placement.
+    std::vector< std::vector<int> > layouts = {
+        { 0, 0, 0, 0, 4, 4, 4, 4 },
+        { 0, 1, 0, 1, 0, 1, 0, 1 },
+    };
+    for (auto& nodes : layouts) {
+        for (auto routine : { "getrf", "potrf", "gemm" }) {
+            grid = slate::func::topology_grid(
+                routine, n, n, nb, nodes, &order, &p, &q );
+            test_assert( p*q == int( nodes.size() ) );
+
+            // Every rank appears exactly once.
+            std::vector<int> seen( nodes.size(), 0 );
+            for (int i = 0; i < p; ++i)
+                for (int j = 0; j < q; ++j)
+                    ++seen[ grid( { i, j } ) ];
+            for (int count : seen)
+                test_assert( count == 1 );
+
+            // The pattern repeats with period p-by-q.
+            test_assert( grid( { p, q } ) == grid( { 0, 0 } ) );
+
+            test_assert( grid_stays_on_node( grid, nodes, p, q, true )
+                         || grid_stays_on_node( grid, nodes, p, q, false ) );
+        }
+    }
+}
+
 //------------------------------------------------------------------------------
 void test_grid_transpose()
 {
@@ -410,6 +678,13 @@ void run_tests()
     run_test( test_process_1d_grid,   "test_process_1d_grid" );
     run_test( test_device_2d_grid,    "test_device_2d_grid" );
     run_test( test_device_1d_grid,    "test_device_1d_grid" );
+    run_test( test_symmetric_2d_grid, "test_symmetric_2d_grid" );
+    run_test( test_symmetric_2d_grid_load,
+              "test_symmetric_2d_grid_load" );
+    run_test( test_weighted_1d_grid,  "test_weighted_1d_grid" );
+    run_test( test_weighted_2d_grid,  "test_weighted_2d_grid" );
+    run_test( test_weights_from_rates, "test_weights_from_rates" );
+    run_test( test_topology_grid,     "test_topology_grid" );
     run_test( test_grid_transpose,    "test_transpose_grid" );
     run_test( test_is_2d_cyclic_grid, "test_is_2d_cyclic_grid" );
 }
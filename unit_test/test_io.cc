@@ -0,0 +1,306 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/slate.hh"
+
+#include "unit_test.hh"
+#include "util_matrix.hh"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace test {
+
+//------------------------------------------------------------------------------
+// global variables
+int m, n, nb, p, q;
+int mpi_rank;
+int mpi_size;
+MPI_Comm mpi_comm;
+int num_devices = 0;
+int verbose = 0;
+
+//------------------------------------------------------------------------------
+/// Checks that the local tiles of B are f(i, j) for global indices (i, j).
+template <typename func_t>
+void test_io_check(slate::Matrix<double>& B, func_t f)
+{
+    int64_t jj = 0;
+    for (int64_t j = 0; j < B.nt(); ++j) {
+        int64_t ii = 0;
+        for (int64_t i = 0; i < B.mt(); ++i) {
+            if (B.tileIsLocal( i, j )) {
+                B.tileGetForReading( i, j, slate::LayoutConvert::None );
+                auto T = B( i, j );
+                for (int64_t tj = 0; tj < T.nb(); ++tj)
+                    for (int64_t ti = 0; ti < T.mb(); ++ti)
+                        test_assert( T( ti, tj ) == f( ii + ti, jj + tj ) );
+            }
+            ii += B.tileMb( i );
+        }
+        jj += B.tileNb( j );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Test write and read, including reading into a different process grid
+/// and tile size, and writing a transposed matrix.
+void test_io()
+{
+    int64_t lda = m;
+    std::vector<double> Ad( lda*n );
+    int64_t iseed[4] = { 0, 1, 2, 3 };
+    lapack::larnv( 1, iseed, Ad.size(), Ad.data() );
+
+    auto A = slate::Matrix<double>::fromLAPACK(
+        m, n, Ad.data(), lda, nb, p, q, mpi_comm );
+    auto A_ij = [&]( int64_t i, int64_t j ) { return Ad[ i + j*lda ]; };
+    auto A_ji = [&]( int64_t i, int64_t j ) { return Ad[ j + i*lda ]; };
+    int64_t nb2 = nb + 3;
+    std::string filename = "test_io.slate";
+
+    slate::write( filename, A );
+
+    // Same tiles and grid, read in place.
+    slate::Matrix<double> B( m, n, nb, p, q, mpi_comm );
+    B.insertLocalTiles();
+    slate::read( filename, B );
+    test_io_check( B, A_ij );
+
+    // Different tile size and grid, redistributed on read.
+    slate::Matrix<double> C( m, n, nb2, 1, mpi_size, mpi_comm );
+    C.insertLocalTiles();
+    slate::read( filename, C );
+    test_io_check( C, A_ij );
+
+    // Wrong dimensions.
+    slate::Matrix<double> D( n, m, nb, p, q, mpi_comm );
+    D.insertLocalTiles();
+    if (m != n)
+        test_assert_throw( slate::read( filename, D ), slate::Exception );
+
+    // Transposed A is written as A^T.
+    auto AT = transpose( A );
+    slate::write( filename, AT );
+    slate::read( filename, D );
+    test_io_check( D, A_ji );
+
+    MPI_Barrier( mpi_comm );
+    if (mpi_rank == 0)
+        std::remove( filename.c_str() );
+}
+
+//------------------------------------------------------------------------------
+/// @return whether steps 0, ..., nsteps-1 of pivots a and b are the same.
+bool pivots_equal(slate::Pivots const& a, slate::Pivots const& b, size_t nsteps)
+{
+    if (a.size() < nsteps || b.size() < nsteps)
+        return false;
+    for (size_t k = 0; k < nsteps; ++k) {
+        if (a[ k ].size() != b[ k ].size())
+            return false;
+        for (size_t i = 0; i < a[ k ].size(); ++i) {
+            if (a[ k ][ i ] != b[ k ][ i ])
+                return false;
+        }
+    }
+    return true;
+}
+
+//------------------------------------------------------------------------------
+/// Test Checkpoint: getrf with checkpoints matches getrf without, save and
+/// restore round trip, and getrf restarts from a checkpoint.
+void test_checkpoint()
+{
+    int64_t lda = m;
+    std::vector<double> Ad( lda*n );
+    int64_t iseed[4] = { 0, 1, 2, 3 };
+    lapack::larnv( 1, iseed, Ad.size(), Ad.data() );
+    auto A_ij = [&]( int64_t i, int64_t j ) { return Ad[ i + j*lda ]; };
+    std::string filename = "test_checkpoint.slate";
+    auto meta_exists = [&]() {
+        FILE* file = std::fopen( (filename + ".meta").c_str(), "rb" );
+        if (file != nullptr)
+            std::fclose( file );
+        return file != nullptr;
+    };
+
+    // Reference factorization.
+    std::vector<double> LUd( Ad );
+    auto LU = slate::Matrix<double>::fromLAPACK(
+        m, n, LUd.data(), lda, nb, p, q, mpi_comm );
+    slate::Pivots pivots;
+    slate::getrf( LU, pivots );
+    auto LU_ij = [&]( int64_t i, int64_t j ) { return LUd[ i + j*lda ]; };
+
+    // Checkpoints every 2 steps don't change the factorization,
+    // and are removed at the end.
+    {
+        std::vector<double> Bd( Ad );
+        auto B = slate::Matrix<double>::fromLAPACK(
+            m, n, Bd.data(), lda, nb, p, q, mpi_comm );
+        slate::Checkpoint checkpoint( filename, 2 );
+        slate::Pivots pivots_B;
+        slate::getrf( B, pivots_B,
+                      {{ slate::Option::Checkpoint, &checkpoint }} );
+        test_io_check( B, LU_ij );
+        test_assert( pivots_equal( pivots_B, pivots, pivots.size() ) );
+        MPI_Barrier( mpi_comm );
+        test_assert( ! meta_exists() );
+    }
+
+    // Save and restore round trip.
+    {
+        auto A = slate::Matrix<double>::fromLAPACK(
+            m, n, Ad.data(), lda, nb, p, q, mpi_comm );
+        slate::Checkpoint checkpoint( filename, 0 );
+        checkpoint.save( A, &pivots, 1, 0 );
+        checkpoint.wait();
+
+        slate::Matrix<double> B( m, n, nb, p, q, mpi_comm );
+        B.insertLocalTiles();
+        slate::Pivots pivots_B( pivots.size() );
+        int64_t info = -1;
+        int64_t k = checkpoint.restore( B, &pivots_B, &info );
+        test_assert( k == 1 );
+        test_assert( info == 0 );
+        test_assert( pivots_equal( pivots_B, pivots, 1 ) );
+        test_io_check( B, A_ij );
+        checkpoint.remove( mpi_comm );
+    }
+
+    // getrf restarts from a checkpoint before step 0, ignoring the
+    // initial values of the matrix.
+    {
+        auto A = slate::Matrix<double>::fromLAPACK(
+            m, n, Ad.data(), lda, nb, p, q, mpi_comm );
+        slate::Checkpoint checkpoint( filename, 0 );
+        slate::Pivots pivots_none;
+        checkpoint.save( A, &pivots_none, 0, 0 );
+        checkpoint.wait();
+
+        std::vector<double> Bd( lda*n, 0.0 );
+        auto B = slate::Matrix<double>::fromLAPACK(
+            m, n, Bd.data(), lda, nb, p, q, mpi_comm );
+        slate::Pivots pivots_B;
+        slate::getrf( B, pivots_B,
+                      {{ slate::Option::Checkpoint, &checkpoint }} );
+        test_io_check( B, LU_ij );
+        test_assert( pivots_equal( pivots_B, pivots, pivots.size() ) );
+        MPI_Barrier( mpi_comm );
+        test_assert( ! meta_exists() );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Test dump: each rank's binary file has its local tiles.
+void test_dump()
+{
+    int64_t lda = m;
+    std::vector<double> Ad( lda*n );
+    int64_t iseed[4] = { 0, 1, 2, 3 };
+    lapack::larnv( 1, iseed, Ad.size(), Ad.data() );
+    auto A = slate::Matrix<double>::fromLAPACK(
+        m, n, Ad.data(), lda, nb, p, q, mpi_comm );
+    std::string prefix = "test_dump";
+
+    slate::dump( "A", A, prefix, {{ slate::Option::PrintBinary, true }} );
+
+    std::string filename = prefix + "." + std::to_string( mpi_rank );
+    FILE* file = std::fopen( filename.c_str(), "rb" );
+    test_assert( file != nullptr );
+    int64_t ntiles = 0;
+    int64_t record[ 6 ];
+    std::vector<double> T;
+    while (std::fread( record, sizeof( record ), 1, file ) == 1) {
+        int64_t i = record[ 0 ], j = record[ 1 ];
+        int64_t ii = record[ 2 ], jj = record[ 3 ];
+        int64_t mb = record[ 4 ], nb_ = record[ 5 ];
+        test_assert( A.tileIsLocal( i, j ) );
+        test_assert( mb == A.tileMb( i ) && nb_ == A.tileNb( j ) );
+        T.resize( mb*nb_ );
+        test_assert( std::fread( T.data(), sizeof( double ), T.size(), file )
+                     == T.size() );
+        for (int64_t tj = 0; tj < nb_; ++tj)
+            for (int64_t ti = 0; ti < mb; ++ti)
+                test_assert( T[ ti + tj*mb ] == Ad[ ii + ti + (jj + tj)*lda ] );
+        ++ntiles;
+    }
+    std::fclose( file );
+
+    int64_t nlocal = 0;
+    for (int64_t j = 0; j < A.nt(); ++j)
+        for (int64_t i = 0; i < A.mt(); ++i)
+            if (A.tileIsLocal( i, j ))
+                ++nlocal;
+    test_assert( ntiles == nlocal );
+
+    std::remove( filename.c_str() );
+    MPI_Barrier( mpi_comm );
+    if (mpi_rank == 0)
+        std::remove( (prefix + ".index").c_str() );
+}
+
+//==============================================================================
+/// Runs all tests. Called by unit test main().
+void run_tests()
+{
+    run_test(test_io, "write, read", mpi_comm);
+    run_test(test_checkpoint, "Checkpoint", mpi_comm);
+    run_test(test_dump, "dump", mpi_comm);
+}
+
+}  // namespace test
+
+//------------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+    using namespace test;  // for globals mpi_rank, etc.
+
+    MPI_Init(&argc, &argv);
+
+    mpi_comm = MPI_COMM_WORLD;
+
+    MPI_Comm_rank(mpi_comm, &mpi_rank);
+    MPI_Comm_size(mpi_comm, &mpi_size);
+
+    num_devices = blas::get_device_count();
+
+    // globals
+    m  = 200;
+    n  = 100;
+    nb = 16;
+    init_process_grid(mpi_size, &p, &q);
+
+    // parse command line
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "-m" && i+1 < argc)
+            m = atoi( argv[++i] );
+        else if (arg == "-n" && i+1 < argc)
+            n = atoi( argv[++i] );
+        else if (arg == "-nb" && i+1 < argc)
+            nb = atoi( argv[++i] );
+        else if (arg == "-p" && i+1 < argc)
+            p = atoi( argv[++i] );
+        else if (arg == "-q" && i+1 < argc)
+            q = atoi( argv[++i] );
+        else {
+            printf( "unknown argument: %s\n", argv[i] );
+            return 1;
+        }
+    }
+    if (mpi_rank == 0) {
+        printf("Usage: %s [-m %d] [-n %d] [-nb %d] [-p %d] [-q %d]\n"
+               "num_devices = %d\n",
+               argv[0], m, n, nb, p, q, num_devices);
+    }
+
+    int err = unit_test_main(mpi_comm);  // which calls run_tests()
+
+    MPI_Finalize();
+    return err;
+}
@@ -0,0 +1,108 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/plan.hh"
+#include "slate/func.hh"
+
+#include "unit_test.hh"
+
+#include <functional>
+
+using slate::GridOrder;
+
+namespace test {
+
+//------------------------------------------------------------------------------
+// global variables
+MPI_Comm mpi_comm;
+
+// 4-by-4 tiles with nb = 8 on a 2-by-2 grid; this rank owns the tiles
+// of rank 0, i.e., (even, even), as if it were rank 0 of 4.
+const int64_t n  = 32;
+const int64_t nb = 8;
+
+std::function<int64_t (int64_t)> tileNb = slate::func::uniform_blocksize( n, nb );
+std::function<int (slate::func::ij_tuple)> tileRank
+    = slate::func::process_2d_grid( GridOrder::Col, 2, 2 );
+std::function<int (slate::func::ij_tuple)> tileDevice
+    = slate::func::device_1d_grid( GridOrder::Col, 1, 1 );
+
+//------------------------------------------------------------------------------
+/// getrf receives the panel tile (2, 1) and the top row tile (1, 2) at
+/// step 1; the other steps use only local tiles.
+void test_plan_getrf()
+{
+    slate::Matrix<double> A( n, n, tileNb, tileNb, tileRank, tileDevice,
+                             mpi_comm );
+    slate::Options opts = {
+        { slate::Option::Target, slate::Target::HostTask },
+        { slate::Option::Lookahead, 1 },
+    };
+    slate::plan::Workspace ws = slate::plan::getrf( A, opts );
+    test_assert( ws.host_tiles == 2 );
+    test_assert( ws.tile_bytes == int64_t( nb*nb*sizeof(double) ) );
+    test_assert( ws.num_batch_arrays == 0 );
+    test_assert( ws.host_extra_bytes == int64_t( n*sizeof(slate::Pivot) ) );
+    test_assert( ws.hostBytes() == 2*ws.tile_bytes + ws.host_extra_bytes );
+
+    // HostWorkspaceTiles reserves at least as many.
+    opts[ slate::Option::HostWorkspaceTiles ] = int64_t( 5 );
+    ws = slate::plan::getrf( A, opts );
+    test_assert( ws.host_tiles == 5 );
+}
+
+//------------------------------------------------------------------------------
+/// potrf receives only the panel tile (2, 1) at step 1, for either uplo.
+void test_plan_potrf()
+{
+    slate::Options opts = {
+        { slate::Option::Target, slate::Target::HostTask },
+        { slate::Option::Lookahead, 1 },
+    };
+    for (auto uplo : { slate::Uplo::Lower, slate::Uplo::Upper }) {
+        slate::HermitianMatrix<double> A( uplo, n, tileNb, tileRank,
+                                          tileDevice, mpi_comm );
+        slate::plan::Workspace ws = slate::plan::potrf( A, opts );
+        test_assert( ws.host_tiles == 1 );
+        test_assert( ws.host_extra_bytes == 0 );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// geqrf plans the same broadcasts as getrf, without pivots.
+void test_plan_geqrf()
+{
+    slate::Matrix<double> A( n, n, tileNb, tileNb, tileRank, tileDevice,
+                             mpi_comm );
+    slate::Options opts = {
+        { slate::Option::Target, slate::Target::HostTask },
+    };
+    slate::plan::Workspace ws = slate::plan::geqrf( A, opts );
+    test_assert( ws.host_tiles == 2 );
+    test_assert( ws.host_extra_bytes == 0 );
+}
+
+//------------------------------------------------------------------------------
+/// Runs all tests. Called by unit test main().
+void run_tests()
+{
+    run_test( test_plan_getrf, "plan::getrf" );
+    run_test( test_plan_potrf, "plan::potrf" );
+    run_test( test_plan_geqrf, "plan::geqrf" );
+}
+
+}  // namespace test
+
+//------------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+    using namespace test;
+
+    MPI_Init( &argc, &argv );
+    mpi_comm = MPI_COMM_WORLD;
+    int err = unit_test_main( mpi_comm );  // which calls run_tests()
+    MPI_Finalize();
+    return err;
+}
@@ -0,0 +1,192 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/slate.hh"
+
+#include "unit_test.hh"
+#include "util_matrix.hh"
+
+#include <cstdio>
+#include <vector>
+
+namespace test {
+
+//------------------------------------------------------------------------------
+// global variables
+int m, n, nb, p, q;
+int mpi_rank;
+int mpi_size;
+MPI_Comm mpi_comm;
+int num_devices = 0;
+int verbose = 0;
+
+//------------------------------------------------------------------------------
+/// Checks that the local tiles of B are f(i, j) for global indices (i, j).
+template <typename func_t>
+void test_redistribute_check(slate::Matrix<double>& B, func_t f)
+{
+    int64_t jj = 0;
+    for (int64_t j = 0; j < B.nt(); ++j) {
+        int64_t ii = 0;
+        for (int64_t i = 0; i < B.mt(); ++i) {
+            if (B.tileIsLocal( i, j )) {
+                B.tileGetForReading( i, j, slate::LayoutConvert::None );
+                auto T = B( i, j );
+                for (int64_t tj = 0; tj < T.nb(); ++tj)
+                    for (int64_t ti = 0; ti < T.mb(); ++ti)
+                        test_assert( T( ti, tj ) == f( ii + ti, jj + tj ) );
+            }
+            ii += B.tileMb( i );
+        }
+        jj += B.tileNb( j );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Test redistribute between different tile sizes, process grids, and ops.
+void test_redistribute()
+{
+    int64_t lda = m;
+    std::vector<double> Ad( lda*n );
+    int64_t iseed[4] = { 0, 1, 2, 3 };
+    lapack::larnv( 1, iseed, Ad.size(), Ad.data() );
+
+    auto A = slate::Matrix<double>::fromLAPACK(
+        m, n, Ad.data(), lda, nb, p, q, mpi_comm );
+    auto A_ij = [&]( int64_t i, int64_t j ) { return Ad[ i + j*lda ]; };
+    auto A_ji = [&]( int64_t i, int64_t j ) { return Ad[ j + i*lda ]; };
+    int64_t nb2 = nb + 3;
+
+    // Different tile size, 1D column grid.
+    slate::Matrix<double> B( m, n, nb2, 1, mpi_size, mpi_comm );
+    B.insertLocalTiles();
+    slate::redistribute( A, B );
+    test_redistribute_check( B, A_ij );
+
+    // Transposed A and B.
+    auto AT = transpose( A );
+    slate::Matrix<double> BT0( m, n, nb2, mpi_size, 1, mpi_comm );
+    BT0.insertLocalTiles();
+    auto BT = transpose( BT0 );
+    slate::redistribute( AT, BT );
+    test_redistribute_check( BT0, A_ij );
+
+    // Only B transposed: BH0 = A^H.
+    slate::Matrix<double> BH0( n, m, nb2, q, p, mpi_comm );
+    BH0.insertLocalTiles();
+    auto BH = conj_transpose( BH0 );
+    slate::redistribute( A, BH );
+    test_redistribute_check( BH0, A_ji );
+
+    // Same tiles, tile by tile with GPU-aware MPI.
+    bool gpu_aware_save = slate::gpu_aware_mpi();
+    slate::gpu_aware_mpi( true );
+    slate::Matrix<double> C( m, n, nb, q, p, mpi_comm );
+    C.insertLocalTiles();
+    slate::redistribute( A, C );
+    test_redistribute_check( C, A_ij );
+    slate::gpu_aware_mpi( gpu_aware_save );
+}
+
+//------------------------------------------------------------------------------
+/// Test transpose and conj_transpose, with B on the same and the mirrored
+/// process grid, and with other tile sizes, which uses redistribute.
+void test_transpose()
+{
+    int64_t lda = m;
+    std::vector<double> Ad( lda*n );
+    int64_t iseed[4] = { 0, 1, 2, 3 };
+    lapack::larnv( 1, iseed, Ad.size(), Ad.data() );
+
+    auto A = slate::Matrix<double>::fromLAPACK(
+        m, n, Ad.data(), lda, nb, p, q, mpi_comm );
+    auto A_ji = [&]( int64_t i, int64_t j ) { return Ad[ j + i*lda ]; };
+
+    // Same process grid; on a square grid, ranks pair with their mirror.
+    slate::Matrix<double> B( n, m, nb, p, q, mpi_comm );
+    B.insertLocalTiles();
+    slate::transpose( A, B );
+    test_redistribute_check( B, A_ji );
+
+    // Mirrored process grid: all tiles are local.
+    slate::Matrix<double> BH( n, m, nb, q, p, mpi_comm );
+    BH.insertLocalTiles();
+    slate::conj_transpose( A, BH );
+    test_redistribute_check( BH, A_ji );
+
+    // Different tile size.
+    slate::Matrix<double> B2( n, m, nb + 3, p, q, mpi_comm );
+    B2.insertLocalTiles();
+    slate::transpose( A, B2 );
+    test_redistribute_check( B2, A_ji );
+
+    if (num_devices > 0) {
+        slate::Matrix<double> BD( n, m, nb, p, q, mpi_comm );
+        BD.insertLocalTiles( slate::Target::Devices );
+        slate::transpose( A, BD, { { slate::Option::Target,
+                                     slate::Target::Devices } } );
+        test_redistribute_check( BD, A_ji );
+    }
+}
+
+//==============================================================================
+/// Runs all tests. Called by unit test main().
+void run_tests()
+{
+    run_test(test_redistribute, "redistribute", mpi_comm);
+    run_test(test_transpose,    "transpose",    mpi_comm);
+}
+
+}  // namespace test
+
+//------------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+    using namespace test;  // for globals mpi_rank, etc.
+
+    MPI_Init(&argc, &argv);
+
+    mpi_comm = MPI_COMM_WORLD;
+
+    MPI_Comm_rank(mpi_comm, &mpi_rank);
+    MPI_Comm_size(mpi_comm, &mpi_size);
+
+    num_devices = blas::get_device_count();
+
+    // globals
+    m  = 200;
+    n  = 100;
+    nb = 16;
+    init_process_grid(mpi_size, &p, &q);
+
+    // parse command line
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "-m" && i+1 < argc)
+            m = atoi( argv[++i] );
+        else if (arg == "-n" && i+1 < argc)
+            n = atoi( argv[++i] );
+        else if (arg == "-nb" && i+1 < argc)
+            nb = atoi( argv[++i] );
+        else if (arg == "-p" && i+1 < argc)
+            p = atoi( argv[++i] );
+        else if (arg == "-q" && i+1 < argc)
+            q = atoi( argv[++i] );
+        else {
+            printf( "unknown argument: %s\n", argv[i] );
+            return 1;
+        }
+    }
+    if (mpi_rank == 0) {
+        printf("Usage: %s [-m %d] [-n %d] [-nb %d] [-p %d] [-q %d]\n"
+               "num_devices = %d\n",
+               argv[0], m, n, nb, p, q, num_devices);
+    }
+
+    int err = unit_test_main(mpi_comm);  // which calls run_tests()
+
+    MPI_Finalize();
+    return err;
+}
@@ -0,0 +1,355 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/slate.hh"
+#include "internal/internal_small.hh"
+
+#include "unit_test.hh"
+
+#include <cmath>
+#include <complex>
+#include <cstdio>
+#include <limits>
+
+namespace test {
+
+//------------------------------------------------------------------------------
+// global variables
+int n, nb;
+int mpi_rank;
+int mpi_size;
+MPI_Comm mpi_comm;
+int verbose = 0;
+
+//------------------------------------------------------------------------------
+/// @return an m-by-n matrix with all tiles on rank 0, so the small-problem
+/// fast path can be taken on any number of ranks. Entries are random,
+/// plus diag on the diagonal, which is real.
+template <typename scalar_t>
+slate::Matrix<scalar_t> owned_matrix(
+    int64_t mm, int64_t nn, int64_t seed, double diag = 0 )
+{
+    std::function< int64_t (int64_t) >
+        tileMb = slate::func::uniform_blocksize( mm, nb );
+    std::function< int64_t (int64_t) >
+        tileNb = slate::func::uniform_blocksize( nn, nb );
+    std::function< int (slate::func::ij_tuple) >
+        tileRank = []( slate::func::ij_tuple ) { return 0; };
+    std::function< int (slate::func::ij_tuple) >
+        tileDevice = []( slate::func::ij_tuple ) { return 0; };
+
+    slate::Matrix<scalar_t> A(
+        mm, nn, tileMb, tileNb, tileRank, tileDevice, mpi_comm );
+    A.insertLocalTiles();
+    for (int64_t j = 0; j < A.nt(); ++j) {
+        for (int64_t i = 0; i < A.mt(); ++i) {
+            if (A.tileIsLocal( i, j )) {
+                auto T = A( i, j );
+                int64_t iseed[4] = { seed, i % 4096, j % 4096, 1 };
+                for (int64_t tj = 0; tj < T.nb(); ++tj)
+                    lapack::larnv( 2, iseed, T.mb(), &T.at( 0, tj ) );
+                if (i == j) {
+                    for (int64_t tj = 0; tj < std::min( T.mb(), T.nb() ); ++tj)
+                        T.at( tj, tj ) = std::real( T( tj, tj ) ) + diag;
+                }
+            }
+        }
+    }
+    return A;
+}
+
+//------------------------------------------------------------------------------
+/// @return a copy of A.
+template <typename scalar_t>
+slate::Matrix<scalar_t> copy_of( slate::Matrix<scalar_t>& A )
+{
+    auto B = A.emptyLike();
+    B.insertLocalTiles();
+    slate::copy( A, B );
+    return B;
+}
+
+//------------------------------------------------------------------------------
+/// @return options taking the small-problem fast path, or not, for
+/// matrices of up to max_tiles tiles.
+slate::Options small_opts( bool small, int64_t max_tiles )
+{
+    return { { slate::Option::SmallTiles,
+               small ? max_tiles : int64_t( 0 ) } };
+}
+
+//------------------------------------------------------------------------------
+/// Checks that || X - Y ||_max is within rounding of || X ||_max.
+/// Overwrites Y.
+template <typename scalar_t>
+void check_equal( slate::Matrix<scalar_t>& X, slate::Matrix<scalar_t>& Y )
+{
+    using real_t = blas::real_type<scalar_t>;
+    const scalar_t one = 1.0;
+
+    real_t X_norm = slate::norm( slate::Norm::Max, X );
+    slate::add( -one, X, one, Y );
+    real_t diff = slate::norm( slate::Norm::Max, Y );
+    real_t eps = std::numeric_limits<real_t>::epsilon();
+    if (verbose)
+        printf( "rank %d, diff %.2e, norm %.2e\n", mpi_rank, diff, X_norm );
+    test_assert( diff <= 50 * n * eps * X_norm );
+}
+
+//------------------------------------------------------------------------------
+/// Checks that pivots of the small-problem path and of the task path are
+/// the same, on all ranks.
+void check_pivots( slate::Pivots& pivots, slate::Pivots& pivots_ref )
+{
+    test_assert( pivots.size() == pivots_ref.size() );
+    for (size_t k = 0; k < pivots.size(); ++k) {
+        test_assert( pivots[ k ].size() == pivots_ref[ k ].size() );
+        for (size_t i = 0; i < pivots[ k ].size(); ++i) {
+            test_assert( pivots[ k ][ i ].tileIndex()
+                         == pivots_ref[ k ][ i ].tileIndex() );
+            test_assert( pivots[ k ][ i ].elementOffset()
+                         == pivots_ref[ k ][ i ].elementOffset() );
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// potrf with SmallTiles on has the same factor and info as with it off.
+/// Upper factors the conjugate-transpose, which the scatter conjugates back.
+template <typename scalar_t, slate::Uplo uplo>
+void test_small_potrf()
+{
+    auto A = owned_matrix<scalar_t>( n, n, 1, 2*n );
+    auto A_ref = copy_of( A );
+    slate::HermitianMatrix<scalar_t> H( uplo, A );
+    slate::HermitianMatrix<scalar_t> H_ref( uplo, A_ref );
+
+    auto opts_on  = small_opts( true,  A.mt() * A.nt() );
+    auto opts_off = small_opts( false, A.mt() * A.nt() );
+    int owner;
+    test_assert( slate::internal::small_path<scalar_t>(
+                     { &H }, opts_on, &owner ) );
+    test_assert( owner == 0 );
+    test_assert( ! slate::internal::small_path<scalar_t>(
+                     { &H }, opts_off, &owner ) );
+
+    int64_t info     = slate::potrf( H,     opts_on  );
+    int64_t info_ref = slate::potrf( H_ref, opts_off );
+    test_assert( info == 0 );
+    test_assert( info == info_ref );
+
+    // Neither path touches the opposite triangle, so compare whole matrices.
+    check_equal( A_ref, A );
+}
+
+//------------------------------------------------------------------------------
+/// potrf of a matrix that isn't positive definite has the same info with
+/// SmallTiles on and off.
+template <typename scalar_t, slate::Uplo uplo>
+void test_small_potrf_indefinite()
+{
+    // Leading minor of order j0 + 1 is negative in the second tile column.
+    int64_t j0 = std::min( nb + 1, n - 1 );
+    auto A = owned_matrix<scalar_t>( n, n, 2, 2*n );
+    int64_t k0 = j0 / nb;
+    if (A.tileIsLocal( k0, k0 )) {
+        auto T = A( k0, k0 );
+        T.at( j0 % nb, j0 % nb ) = -2*n;
+    }
+    auto A_ref = copy_of( A );
+    slate::HermitianMatrix<scalar_t> H( uplo, A );
+    slate::HermitianMatrix<scalar_t> H_ref( uplo, A_ref );
+
+    int64_t info     = slate::potrf( H,     small_opts( true,  A.mt() * A.nt() ) );
+    int64_t info_ref = slate::potrf( H_ref, small_opts( false, A.mt() * A.nt() ) );
+    test_assert( info == j0 + 1 );
+    test_assert( info == info_ref );
+}
+
+//------------------------------------------------------------------------------
+/// getrf with SmallTiles on has the same LU factors, pivots, and info as
+/// with it off. If rank_deficient, column j0 is zero, so U(j0, j0) = 0.
+template <typename scalar_t, bool rank_deficient>
+void test_small_getrf_mn( int64_t mm, int64_t nn )
+{
+    auto A = owned_matrix<scalar_t>( mm, nn, 3 );
+    int64_t j0 = std::min( int64_t( nb + 1 ), nn - 1 );
+    if (rank_deficient) {
+        int64_t k0 = j0 / nb;
+        for (int64_t i = 0; i < A.mt(); ++i) {
+            if (A.tileIsLocal( i, k0 )) {
+                auto T = A( i, k0 );
+                for (int64_t r = 0; r < T.mb(); ++r)
+                    T.at( r, j0 % nb ) = 0;
+            }
+        }
+    }
+    auto A_ref = copy_of( A );
+
+    auto opts_on  = small_opts( true,  A.mt() * A.nt() );
+    auto opts_off = small_opts( false, A.mt() * A.nt() );
+    int owner;
+    test_assert( slate::internal::small_path<scalar_t>(
+                     { &A }, opts_on, &owner ) );
+
+    slate::Pivots pivots, pivots_ref;
+    int64_t info     = slate::getrf( A,     pivots,     opts_on  );
+    int64_t info_ref = slate::getrf( A_ref, pivots_ref, opts_off );
+    if (rank_deficient)
+        test_assert( info == j0 + 1 );
+    else
+        test_assert( info == 0 );
+    test_assert( info == info_ref );
+
+    check_pivots( pivots, pivots_ref );
+    check_equal( A_ref, A );
+}
+
+template <typename scalar_t, bool rank_deficient>
+void test_small_getrf()
+{
+    // Square, tall, and wide, with a partial last tile.
+    test_small_getrf_mn<scalar_t, rank_deficient>( n, n );
+    test_small_getrf_mn<scalar_t, rank_deficient>( n + nb/2, n );
+    test_small_getrf_mn<scalar_t, rank_deficient>( n, n + nb/2 );
+}
+
+//------------------------------------------------------------------------------
+/// gemm with SmallTiles on has the same result as with it off,
+/// with A and B plain and conjugate-transposed.
+template <typename scalar_t>
+void test_small_gemm()
+{
+    const scalar_t alpha = 1.5, beta = -0.5;
+    int64_t k = n - nb/2;
+
+    for (int op = 0; op < 2; ++op) {
+        auto A0 = op == 0 ? owned_matrix<scalar_t>( n, k, 4 )
+                          : owned_matrix<scalar_t>( k, n, 4 );
+        auto B0 = op == 0 ? owned_matrix<scalar_t>( k, n, 5 )
+                          : owned_matrix<scalar_t>( n, k, 5 );
+        auto A = op == 0 ? A0 : conj_transpose( A0 );
+        auto B = op == 0 ? B0 : conj_transpose( B0 );
+        auto C = owned_matrix<scalar_t>( n, n, 6 );
+        auto C_ref = copy_of( C );
+
+        int64_t max_tiles = std::max( A.mt() * A.nt(), C.mt() * C.nt() );
+        slate::gemm( alpha, A, B, beta, C,     small_opts( true,  max_tiles ) );
+        slate::gemm( alpha, A, B, beta, C_ref, small_opts( false, max_tiles ) );
+        check_equal( C_ref, C );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// trsm with SmallTiles on has the same solution as with it off,
+/// on the left and right, with A lower, upper, and conjugate-transposed.
+template <typename scalar_t>
+void test_small_trsm()
+{
+    const scalar_t alpha = 2.0;
+
+    for (auto side : { slate::Side::Left, slate::Side::Right }) {
+        for (int op = 0; op < 3; ++op) {
+            // Diagonally dominant, for a well-conditioned solve.
+            auto A0 = owned_matrix<scalar_t>( n, n, 7, 2*n );
+            auto uplo = op == 1 ? slate::Uplo::Upper : slate::Uplo::Lower;
+            slate::TriangularMatrix<scalar_t> T(
+                uplo, slate::Diag::NonUnit, A0 );
+            auto A = op == 2 ? conj_transpose( T ) : T;
+
+            auto B = side == slate::Side::Left
+                   ? owned_matrix<scalar_t>( n, n - nb/2, 8 )
+                   : owned_matrix<scalar_t>( n - nb/2, n, 8 );
+            auto B_ref = copy_of( B );
+
+            int64_t max_tiles = std::max( A.mt() * A.nt(), B.mt() * B.nt() );
+            slate::trsm( side, alpha, A, B,     small_opts( true,  max_tiles ) );
+            slate::trsm( side, alpha, A, B_ref, small_opts( false, max_tiles ) );
+            check_equal( B_ref, B );
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Runs all tests. Called by unit test main().
+void run_tests()
+{
+    using slate::Uplo;
+    using std::complex;
+
+    run_test(test_small_potrf< double, Uplo::Lower >,
+             "potrf Lower, double", mpi_comm);
+    run_test(test_small_potrf< double, Uplo::Upper >,
+             "potrf Upper, double", mpi_comm);
+    run_test(test_small_potrf< complex<double>, Uplo::Lower >,
+             "potrf Lower, complex<double>", mpi_comm);
+    run_test(test_small_potrf< complex<double>, Uplo::Upper >,
+             "potrf Upper, complex<double>", mpi_comm);
+    run_test(test_small_potrf_indefinite< double, Uplo::Lower >,
+             "potrf indefinite Lower, double", mpi_comm);
+    run_test(test_small_potrf_indefinite< complex<double>, Uplo::Upper >,
+             "potrf indefinite Upper, complex<double>", mpi_comm);
+
+    run_test(test_small_getrf< double, false >,
+             "getrf, double", mpi_comm);
+    run_test(test_small_getrf< complex<double>, false >,
+             "getrf, complex<double>", mpi_comm);
+    run_test(test_small_getrf< double, true >,
+             "getrf rank-deficient, double", mpi_comm);
+    run_test(test_small_getrf< complex<double>, true >,
+             "getrf rank-deficient, complex<double>", mpi_comm);
+
+    run_test(test_small_gemm< double >,
+             "gemm, double", mpi_comm);
+    run_test(test_small_gemm< complex<double> >,
+             "gemm ConjTrans, complex<double>", mpi_comm);
+
+    run_test(test_small_trsm< double >,
+             "trsm, double", mpi_comm);
+    run_test(test_small_trsm< complex<double> >,
+             "trsm ConjTrans, complex<double>", mpi_comm);
+}
+
+}  // namespace test
+
+//------------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+    using namespace test;  // for globals mpi_rank, etc.
+
+    MPI_Init(&argc, &argv);
+
+    mpi_comm = MPI_COMM_WORLD;
+
+    MPI_Comm_rank(mpi_comm, &mpi_rank);
+    MPI_Comm_size(mpi_comm, &mpi_size);
+
+    // globals; n = 2 nb gives 4 tiles, the default Option::SmallTiles.
+    n  = 32;
+    nb = 16;
+
+    // parse command line
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "-n" && i+1 < argc)
+            n = atoi( argv[++i] );
+        else if (arg == "-nb" && i+1 < argc)
+            nb = atoi( argv[++i] );
+        else if (arg == "-v")
+            verbose = 1;
+        else {
+            printf( "unknown argument: %s\n", argv[i] );
+            return 1;
+        }
+    }
+    if (mpi_rank == 0) {
+        printf("Usage: %s [-n %d] [-nb %d] [-v]\n", argv[0], n, nb);
+    }
+
+    int err = unit_test_main(mpi_comm);  // which calls run_tests()
+
+    MPI_Finalize();
+    return err;
+}
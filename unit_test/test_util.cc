@@ -4,6 +4,7 @@
 // the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
 
 #include "slate/slate.hh"
+#include "slate/internal/comm.hh"
 
 #include "unit_test.hh"
 
@@ -30,6 +31,207 @@ void test_gpu_aware_mpi()
     test_assert( ! slate::gpu_aware_mpi() );
 }
 
+//------------------------------------------------------------------------------
+/// Tests that commFromSet returns the cached communicator for a repeated set,
+/// and that the cache is freed with its parent communicator.
+void test_commFromSet_cache()
+{
+    MPI_Comm mpi_comm;
+    MPI_Group mpi_group;
+    MPI_Comm_dup( MPI_COMM_WORLD, &mpi_comm );
+    MPI_Comm_group( mpi_comm, &mpi_group );
+
+    // Even ranks, with the highest even rank as root.
+    std::set<int> even;
+    for (int rank = 0; rank < mpi_size; rank += 2)
+        even.insert( rank );
+    int root = *even.rbegin();
+
+    if (mpi_rank % 2 == 0) {
+        int out_rank1, out_rank2;
+        MPI_Comm comm1 = slate::internal::commFromSet(
+            even, mpi_comm, mpi_group, root, out_rank1 );
+        MPI_Comm comm2 = slate::internal::commFromSet(
+            even, mpi_comm, mpi_group, root, out_rank2 );
+        test_assert( comm1 == comm2 );
+        test_assert( out_rank1 == int( even.size() ) - 1 );
+        test_assert( out_rank2 == out_rank1 );
+
+        int rank, size;
+        MPI_Comm_rank( comm1, &rank );
+        MPI_Comm_size( comm1, &size );
+        test_assert( rank == mpi_rank / 2 );
+        test_assert( size == int( even.size() ) );
+    }
+
+    // All ranks, translating rank 0.
+    std::set<int> all;
+    for (int rank = 0; rank < mpi_size; ++rank)
+        all.insert( rank );
+    int out_rank;
+    MPI_Comm comm3 = slate::internal::commFromSet(
+        all, mpi_comm, mpi_group, 0, out_rank );
+    test_assert( out_rank == 0 );
+    MPI_Comm comm4 = slate::internal::commFromSet(
+        all, mpi_comm, mpi_group, 0, out_rank );
+    test_assert( comm3 == comm4 );
+
+    // Frees the cached communicators.
+    MPI_Group_free( &mpi_group );
+    MPI_Comm_free( &mpi_comm );
+}
+
+//------------------------------------------------------------------------------
+/// Tests that topoBcastPattern builds a tree rooted at 0, where each rank
+/// receives once and only the first rank of each node (its leader)
+/// receives from another node.
+void test_topoBcastPattern()
+{
+    std::vector<int> nodes = { 5, 5, 1, 1, 1, 2, 5, 3, 3, 1, 5, 5, 5 };
+    int size = nodes.size();
+
+    for (int radix : { 2, 4 }) {
+        std::vector<int> parent( size, -1 );
+        std::vector< std::list<int> > children( size );
+        for (int rank = 0; rank < size; ++rank) {
+            std::list<int> recv_from, send_to;
+            slate::internal::topoBcastPattern(
+                nodes, rank, radix, recv_from, send_to );
+            test_assert( recv_from.size() == (rank == 0 ? 0 : 1) );
+            if (rank != 0)
+                parent[ rank ] = recv_from.front();
+            children[ rank ] = send_to;
+        }
+
+        for (int rank = 0; rank < size; ++rank) {
+            // Consistent with the children's parents.
+            for (int child : children[ rank ])
+                test_assert( parent[ child ] == rank );
+
+            // Reaches the root.
+            int r = rank, hops = 0;
+            while (r != 0 && hops < size) {
+                r = parent[ r ];
+                ++hops;
+            }
+            test_assert( r == 0 );
+
+            // Inter-node messages go only to leaders.
+            if (rank != 0 && nodes[ parent[ rank ] ] != nodes[ rank ]) {
+                for (int r2 = 0; r2 < rank; ++r2)
+                    test_assert( nodes[ r2 ] != nodes[ rank ] );
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Tests that waitall completes requests both with and without the MPI
+/// progress thread, which is reference counted.
+void test_progressThread()
+{
+    int provided;
+    MPI_Query_thread( &provided );
+    if (provided < MPI_THREAD_MULTIPLE) {
+        test_skip( "requires MPI_THREAD_MULTIPLE" );
+    }
+
+    // 8 MiB messages, large enough for rendezvous, around a ring.
+    int count = 1024*1024;
+    int next = (mpi_rank + 1) % mpi_size;
+    int prev = (mpi_rank + mpi_size - 1) % mpi_size;
+    std::vector<double> send( count, mpi_rank ), recv( count, -1 );
+
+    for (int threads : { 0, 1, 2 }) {
+        for (int t = 0; t < threads; ++t)
+            slate::internal::progressStart();
+        test_assert( slate::internal::progressActive() == (threads > 0) );
+
+        std::fill( recv.begin(), recv.end(), -1 );
+        std::vector<MPI_Request> requests( 3, MPI_REQUEST_NULL );
+        MPI_Irecv( recv.data(), count, MPI_DOUBLE, prev, threads,
+                   MPI_COMM_WORLD, &requests[ 0 ] );
+        MPI_Isend( send.data(), count, MPI_DOUBLE, next, threads,
+                   MPI_COMM_WORLD, &requests[ 2 ] );
+        slate::internal::waitall( requests );
+        for (auto request : requests)
+            test_assert( request == MPI_REQUEST_NULL );
+        test_assert( recv[ 0 ] == prev && recv[ count-1 ] == prev );
+
+        for (int t = 0; t < threads; ++t) {
+            test_assert( slate::internal::progressActive() );
+            slate::internal::progressStop();
+        }
+        test_assert( ! slate::internal::progressActive() );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Tests that ResolvedOptions gives the same values as get_option.
+void test_ResolvedOptions()
+{
+    using slate::Option;
+    slate::Counters* counters = reinterpret_cast<slate::Counters*>( 0x1000 );
+    slate::Options opts = {
+        { Option::Lookahead,      3 },
+        { Option::Target,         slate::Target::Devices },
+        { Option::PivotThreshold, 0.5 },
+        { Option::ProgressThread, true },
+        { Option::Counters,       counters },
+        { Option::MethodSVD,      slate::MethodSVD::DC },
+    };
+    slate::ResolvedOptions const ropts( opts );
+
+    test_assert( ropts.isSet( Option::Lookahead ) );
+    test_assert( ! ropts.isSet( Option::InnerBlocking ) );
+    test_assert( ropts.get<Option::Lookahead>( 1 ) == 3 );
+    test_assert( ropts.get<Option::InnerBlocking>( 16 ) == 16 );
+    test_assert( ropts.get<Option::Target>( slate::Target::HostTask )
+                 == slate::Target::Devices );
+    test_assert( ropts.get<Option::PivotThreshold>( 1.0 ) == 0.5 );
+    test_assert( ropts.get<Option::ProgressThread>( false ) );
+    test_assert( ropts.get<Option::Counters>( nullptr ) == counters );
+    test_assert( ropts.get<Option::MethodSVD>( slate::MethodSVD::QR )
+                 == slate::MethodSVD::DC );
+    test_assert( ropts.get<Option::MethodSVD>( slate::MethodSVD::QR )
+                 == slate::get_option<Option::MethodSVD>(
+                        opts, slate::MethodSVD::QR ) );
+}
+
+//------------------------------------------------------------------------------
+/// Tests that Counters logs messages only while a phase with
+/// logMessages is counted, and their sizes and destinations.
+void test_Counters_messages()
+{
+    slate::Counters counters;
+    slate::internal::count_message( 0, 100 );
+    {
+        slate::internal::CounterPhase phase( &counters, "phase" );
+        slate::internal::count_message( 0, 1000 );
+        slate::internal::count_message( 0, 1 );
+    }
+    test_assert( counters.phases().at( "phase" ).messages_sent == 2 );
+    test_assert( counters.phases().at( "phase" ).bytes_sent == 1001 );
+    test_assert( counters.bytesTo().empty() );
+
+    counters.clear();
+    counters.logMessages( true );
+    {
+        slate::internal::CounterPhase phase( &counters, "phase" );
+        slate::internal::count_message( 0, 1000 );
+        slate::internal::count_message( 0, 1 );
+    }
+    slate::internal::count_message( 0, 100 );
+    counters.merge( MPI_COMM_SELF );
+
+    auto const& hist = counters.sizeHistogram();
+    test_assert( hist[ 0 ] == 1 );  // 1 byte
+    test_assert( hist[ 9 ] == 1 );  // 1000 bytes, in [ 512, 1024 )
+    test_assert( counters.bytesTo().at( 0 ) == 1001 );
+    test_assert( counters.commMatrix().size() == 1 );
+    test_assert( counters.commMatrix()[ 0 ] == 1001 );
+}
+
 //------------------------------------------------------------------------------
 /// Runs all tests. Called by unit test main().
 void run_tests()
@@ -37,7 +239,17 @@ void run_tests()
     if (mpi_rank == 0) {
         run_test(
             test_gpu_aware_mpi, "gpu_aware_mpi()");
+        run_test(
+            test_topoBcastPattern, "topoBcastPattern");
+        run_test(
+            test_ResolvedOptions, "ResolvedOptions");
+        run_test(
+            test_Counters_messages, "Counters messages");
     }
+    run_test(
+        test_commFromSet_cache, "commFromSet cache", MPI_COMM_WORLD);
+    run_test(
+        test_progressThread, "progressThread, waitall", MPI_COMM_WORLD);
 }
 
 }  // namespace test
@@ -47,7 +259,8 @@ int main( int argc, char** argv )
 {
     using namespace test;  // for globals mpi_rank, etc.
 
-    MPI_Init( &argc, &argv );
+    int provided;
+    MPI_Init_thread( &argc, &argv, MPI_THREAD_MULTIPLE, &provided );
     MPI_Comm_rank( MPI_COMM_WORLD, &mpi_rank );
     MPI_Comm_size( MPI_COMM_WORLD, &mpi_size );
 